@@ -15,6 +15,8 @@
  */
 
 #include "conversion.h"
+#include <pybind11/numpy.h>
+#include <velox/vector/FlatVector.h>
 #include <velox/vector/arrow/Abi.h>
 #include <velox/vector/arrow/Bridge.h>
 #include "context.h"
@@ -23,6 +25,150 @@ namespace facebook::velox::py {
 
 namespace py = pybind11;
 
+namespace {
+
+// Keeps a Python object alive while Velox buffers point into its memory. The
+// last copy may be destroyed on a thread that does not hold the GIL.
+struct PyObjectReleaser {
+  explicit PyObjectReleaser(py::object object)
+      : object_(new py::object(std::move(object)), [](py::object* object) {
+          py::gil_scoped_acquire gil;
+          delete object;
+        }) {}
+
+  void addRef() const {}
+  void release() const {}
+
+ private:
+  const std::shared_ptr<py::object> object_;
+};
+
+template <TypeKind kind>
+VectorPtr numpyToFlatVector(
+    const py::array& array,
+    facebook::velox::memory::MemoryPool* pool) {
+  using NativeType = typename TypeTraits<kind>::NativeType;
+  auto values = BufferView<PyObjectReleaser>::create(
+      static_cast<const uint8_t*>(array.data()),
+      array.nbytes(),
+      PyObjectReleaser(array));
+  return std::make_shared<FlatVector<NativeType>>(
+      pool,
+      fromKindToScalerType(kind),
+      nullptr,
+      array.size(),
+      std::move(values),
+      std::vector<BufferPtr>{});
+}
+
+// NumPy stores booleans in bytes and Velox in bits, so these are copied.
+VectorPtr numpyToBoolVector(
+    const py::array_t<bool>& array,
+    facebook::velox::memory::MemoryPool* pool) {
+  auto result = BaseVector::create<FlatVector<bool>>(
+      BOOLEAN(), array.size(), pool);
+  const auto* data = array.data();
+  for (vector_size_t i = 0; i < array.size(); ++i) {
+    result->set(i, data[i]);
+  }
+  return result;
+}
+
+// Wraps the memory of a 1-dimensional C-contiguous array in a flat vector
+// without copying. The vector holds a reference to the array.
+VectorPtr numpyToVector(
+    const py::array& array,
+    facebook::velox::memory::MemoryPool* pool) {
+  if (array.ndim() != 1) {
+    throw py::value_error("Only 1-dimensional arrays can be converted");
+  }
+  if (!(array.flags() & py::array::c_style)) {
+    throw py::value_error(
+        "Only contiguous arrays can be converted without copying, use "
+        "numpy.ascontiguousarray()");
+  }
+  if (array.size() > std::numeric_limits<vector_size_t>::max()) {
+    throw py::value_error("Array is too large for a Velox vector");
+  }
+  const auto dtype = array.dtype();
+  if (dtype.equal(py::dtype::of<bool>())) {
+    return numpyToBoolVector(py::array_t<bool>::ensure(array), pool);
+  }
+  if (dtype.equal(py::dtype::of<int8_t>())) {
+    return numpyToFlatVector<TypeKind::TINYINT>(array, pool);
+  }
+  if (dtype.equal(py::dtype::of<int16_t>())) {
+    return numpyToFlatVector<TypeKind::SMALLINT>(array, pool);
+  }
+  if (dtype.equal(py::dtype::of<int32_t>())) {
+    return numpyToFlatVector<TypeKind::INTEGER>(array, pool);
+  }
+  if (dtype.equal(py::dtype::of<int64_t>())) {
+    return numpyToFlatVector<TypeKind::BIGINT>(array, pool);
+  }
+  if (dtype.equal(py::dtype::of<float>())) {
+    return numpyToFlatVector<TypeKind::REAL>(array, pool);
+  }
+  if (dtype.equal(py::dtype::of<double>())) {
+    return numpyToFlatVector<TypeKind::DOUBLE>(array, pool);
+  }
+  throw py::type_error(
+      "Unsupported NumPy dtype " + py::str(dtype).cast<std::string>());
+}
+
+template <TypeKind kind>
+py::array flatVectorToNumpy(const VectorPtr& vector) {
+  using NativeType = typename TypeTraits<kind>::NativeType;
+  const auto* values = vector->asFlatVector<NativeType>()->rawValues();
+  py::capsule owner(new VectorPtr(vector), [](void* owned) {
+    delete static_cast<VectorPtr*>(owned);
+  });
+  py::array result = py::array_t<NativeType>(
+      {static_cast<py::ssize_t>(vector->size())},
+      {static_cast<py::ssize_t>(sizeof(NativeType))},
+      values,
+      owner);
+  // Velox vectors may share their buffers, so they must not be modified.
+  result.attr("setflags")(py::arg("write") = false);
+  return result;
+}
+
+// Returns a read-only array over the values of a flat vector of fixed width
+// numbers without nulls. The array holds a reference to the vector.
+py::array vectorToNumpy(const VectorPtr& vector) {
+  if (vector->encoding() != VectorEncoding::Simple::FLAT) {
+    throw py::value_error(
+        "Only flat vectors can be converted without copying, use "
+        "export_to_arrow()");
+  }
+  if (vector->mayHaveNulls() &&
+      BaseVector::countNulls(vector->nulls(), vector->size()) > 0) {
+    throw py::value_error(
+        "Vectors with nulls can not be converted to NumPy, use "
+        "export_to_arrow()");
+  }
+  switch (vector->typeKind()) {
+    case TypeKind::TINYINT:
+      return flatVectorToNumpy<TypeKind::TINYINT>(vector);
+    case TypeKind::SMALLINT:
+      return flatVectorToNumpy<TypeKind::SMALLINT>(vector);
+    case TypeKind::INTEGER:
+      return flatVectorToNumpy<TypeKind::INTEGER>(vector);
+    case TypeKind::BIGINT:
+      return flatVectorToNumpy<TypeKind::BIGINT>(vector);
+    case TypeKind::REAL:
+      return flatVectorToNumpy<TypeKind::REAL>(vector);
+    case TypeKind::DOUBLE:
+      return flatVectorToNumpy<TypeKind::DOUBLE>(vector);
+    default:
+      throw py::type_error(
+          "Unsupported type for NumPy conversion: " +
+          vector->type()->toString());
+  }
+}
+
+} // namespace
+
 void addConversionBindings(py::module& m, bool asModuleLocalDefinitions) {
   m.def("export_to_arrow", [](VectorPtr& inputVector) {
     auto arrowArray = std::make_unique<ArrowArray>();
@@ -48,5 +194,20 @@ void addConversionBindings(py::module& m, bool asModuleLocalDefinitions) {
     auto pool_ = PyVeloxContext::getSingletonInstance().pool();
     return importFromArrowAsOwner(*arrowSchema, *arrowArray, pool_);
   });
+
+  m.def(
+      "from_numpy",
+      [](const py::array& array) {
+        return numpyToVector(
+            array, PyVeloxContext::getSingletonInstance().pool());
+      },
+      "Wraps a 1-dimensional NumPy array of numbers in a flat vector without "
+      "copying. Boolean arrays are copied");
+
+  m.def(
+      "to_numpy",
+      &vectorToNumpy,
+      "Returns a read-only NumPy array over the values of a flat vector of "
+      "numbers without nulls, without copying");
 }
 } // namespace facebook::velox::py
@@ -22,7 +22,8 @@ namespace facebook::velox::py {
 
 namespace py = pybind11;
 
-/// Adds bindings for arrow-velox conversion functions to module m.
+/// Adds bindings for arrow-velox and numpy-velox conversion functions to
+/// module m.
 ///
 /// @param m Module to add bindings to.
 /// @param asModuleLocalDefinitions If true then these bindings are only
@@ -222,12 +222,18 @@ static VectorPtr evaluateExpression(
   RowVectorPtr rowVector = std::make_shared<RowVector>(
       pool, rowType, BufferPtr{nullptr}, numRows, inputs);
   core::TypedExprPtr typed = core::Expressions::inferTypes(expr, rowType, pool);
-  exec::ExprSet set({typed}, PyVeloxContext::getSingletonInstance().execCtx());
-  exec::EvalCtx evalCtx(
-      PyVeloxContext::getSingletonInstance().execCtx(), &set, rowVector.get());
+  // The GIL is released during evaluation, so concurrent calls must not share
+  // the vector pool of an ExecCtx.
+  core::ExecCtx execCtx(pool, PyVeloxContext::getSingletonInstance().queryCtx());
+  exec::ExprSet set({typed}, &execCtx);
+  exec::EvalCtx evalCtx(&execCtx, &set, rowVector.get());
   SelectivityVector rows(numRows);
   std::vector<VectorPtr> result;
-  set.eval(rows, evalCtx, result);
+  {
+    // Lets other Python threads run while the expression is evaluated.
+    py::gil_scoped_release release;
+    set.eval(rows, evalCtx, result);
+  }
   return result[0];
 }
 
@@ -12,6 +12,7 @@
 # See the License for the specific language governing permissions and
 # limitations under the License.
 
+import numpy as np
 import pyarrow as pa
 import pyvelox.pyvelox as pv
 import unittest
@@ -351,3 +352,55 @@ class TestVeloxVector(unittest.TestCase):
                 self.assertTrue(velox_vector.dtype(), expected_type)
                 for i in range(0, len(data)):
                     self.assertEqual(velox_vector[i], data[i])
+
+    def test_from_numpy(self):
+        test_cases = [
+            (np.array([1, 2, 3], dtype=np.int8), pv.TinyintType()),
+            (np.array([1, 2, 3], dtype=np.int16), pv.SmallintType()),
+            (np.array([1, 2, 3], dtype=np.int32), pv.IntegerType()),
+            (np.array([1, 2, 3], dtype=np.int64), pv.BigintType()),
+            (np.array([1.5, 2.5], dtype=np.float32), pv.RealType()),
+            (np.array([1.5, 2.5], dtype=np.float64), pv.DoubleType()),
+            (np.array([True, False, True]), pv.BooleanType()),
+        ]
+        for array, expected_type in test_cases:
+            with self.subTest(array=array):
+                vector = pv.from_numpy(array)
+                self.assertEqual(vector.size(), len(array))
+                self.assertEqual(vector.dtype(), expected_type)
+                for i in range(0, len(array)):
+                    self.assertEqual(vector[i], array[i])
+
+        with self.assertRaises(ValueError):
+            pv.from_numpy(np.zeros((2, 2)))
+        with self.assertRaises(ValueError):
+            pv.from_numpy(np.arange(10)[::2])
+        with self.assertRaises(TypeError):
+            pv.from_numpy(np.array(["a", "b"]))
+
+    def test_numpy_zero_copy(self):
+        array = np.arange(10, dtype=np.int64)
+        vector = pv.from_numpy(array)
+        array[3] = 100
+        self.assertEqual(vector[3], 100)
+
+        # The vector keeps the array alive.
+        del array
+        self.assertEqual(vector[9], 9)
+
+        result = pv.to_numpy(vector)
+        self.assertFalse(result.flags.writeable)
+        self.assertEqual(result[3], 100)
+        del vector
+        self.assertEqual(result.tolist(), [0, 1, 2, 100, 4, 5, 6, 7, 8, 9])
+
+    def test_to_numpy(self):
+        vector = pv.from_list([1.5, 2.5, 3.5])
+        self.assertListEqual(pv.to_numpy(vector).tolist(), [1.5, 2.5, 3.5])
+
+        with self.assertRaises(ValueError):
+            pv.to_numpy(pv.from_list([1, None, 3]))
+        with self.assertRaises(ValueError):
+            pv.to_numpy(pv.constant_vector(1, 10))
+        with self.assertRaises(TypeError):
+            pv.to_numpy(pv.from_list(["a", "b"]))
@@ -172,6 +172,7 @@ setup(
         "typing",
         "tabulate",
         "typing-inspect",
+        "numpy",
         "pyarrow",
     ],
     extras_require={"tests": ["pyarrow"]},
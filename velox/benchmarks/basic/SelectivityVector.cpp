@@ -108,6 +108,14 @@ class SelectivityVectorBenchmark
     return run(rows99PerCent_);
   }
 
+  size_t runNoThrowAll() {
+    return runNoThrow(rowsAll_);
+  }
+
+  size_t runNoThrow99PerCent() {
+    return runNoThrow(rows99PerCent_);
+  }
+
  private:
   size_t run(const SelectivityVector& rows) {
     const int64_t* flatBuffer = flatVector_->values()->as<int64_t>();
@@ -118,6 +126,17 @@ class SelectivityVectorBenchmark
     return vectorSize_;
   }
 
+  // Same as run() with the per-row error handling of vector functions.
+  size_t runNoThrow(const SelectivityVector& rows) {
+    const int64_t* flatBuffer = flatVector_->values()->as<int64_t>();
+    size_t sum = 0;
+    exec::EvalCtx evalCtx(&execCtx_);
+    evalCtx.applyToSelectedNoThrow(
+        rows, [&flatBuffer, &sum](auto row) { sum += flatBuffer[row]; });
+    folly::doNotOptimizeAway(sum);
+    return vectorSize_;
+  }
+
   const size_t vectorSize_;
   VectorPtr flatVector_;
 
@@ -161,6 +180,14 @@ BENCHMARK(sumSelectivity1PerCent) {
   run([] { benchmark->runSelectivity1PerCent(); });
 }
 
+BENCHMARK(sumNoThrowAll) {
+  run([] { benchmark->runNoThrowAll(); });
+}
+
+BENCHMARK(sumNoThrow99PerCent) {
+  run([] { benchmark->runNoThrow99PerCent(); });
+}
+
 } // namespace
 
 int main(int argc, char* argv[]) {
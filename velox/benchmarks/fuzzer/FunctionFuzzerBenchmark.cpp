@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <random>
+
+#include <folly/String.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include "velox/common/time/Timer.h"
+#include "velox/expression/tests/ArgumentTypeFuzzer.h"
+#include "velox/functions/FunctionRegistry.h"
+#include "velox/functions/lib/benchmarks/FunctionBenchmarkBase.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+
+DEFINE_int64(seed, 1, "Seed for the argument types and the input data");
+DEFINE_int32(vector_size, 10'000, "Rows in each input batch");
+DEFINE_int32(iterations, 20, "Times each expression is evaluated");
+DEFINE_string(
+    only,
+    "",
+    "Comma separated function names to benchmark. Benchmarks all registered "
+    "functions if empty");
+DEFINE_int32(
+    signatures_per_function,
+    2,
+    "Maximum number of signatures benchmarked per function");
+DEFINE_double(
+    outlier_ratio,
+    10,
+    "Flags calls that cost more per row than this many times the median of "
+    "the calls with the same return type class and input encoding");
+
+/// Samples a call for each signature of each registered scalar function.
+/// Generic signatures get random argument types from ArgumentTypeFuzzer and
+/// the inputs come from VectorFuzzer. Every call is benchmarked over flat
+/// inputs without and with nulls, over dictionary encoded inputs and over
+/// constant inputs. Calls that fail on the fuzzed data are benchmarked under
+/// try(). Prints the cost per row of each call and flags the calls that are
+/// much slower than other calls returning the same class of type.
+
+using namespace facebook::velox;
+
+namespace {
+
+enum class Encoding { kFlat, kFlatWithNulls, kDictionary, kConstant };
+
+const char* encodingName(Encoding encoding) {
+  switch (encoding) {
+    case Encoding::kFlat:
+      return "flat";
+    case Encoding::kFlatWithNulls:
+      return "nulls";
+    case Encoding::kDictionary:
+      return "dictionary";
+    case Encoding::kConstant:
+      return "constant";
+  }
+  VELOX_UNREACHABLE();
+}
+
+// Groups return types by the kind of work they imply. Calls are compared
+// within a class only.
+std::string typeClass(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+      return "boolean";
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::HUGEINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+      return "numeric";
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return "string";
+    case TypeKind::TIMESTAMP:
+      return "timestamp";
+    default:
+      return "complex";
+  }
+}
+
+struct CallCost {
+  std::string call;
+  std::string typeClass;
+  Encoding encoding;
+  bool underTry;
+  double nanosPerRow;
+};
+
+class FunctionFuzzerBenchmark : public functions::test::FunctionBenchmarkBase {
+ public:
+  FunctionFuzzerBenchmark() : rng_(FLAGS_seed) {}
+
+  void run() {
+    std::unordered_set<std::string> only;
+    if (!FLAGS_only.empty()) {
+      folly::splitTo<std::string>(
+          ',', FLAGS_only, std::inserter(only, only.begin()), true);
+    }
+    const auto signatures = getFunctionSignatures();
+    std::map<std::string, std::vector<const exec::FunctionSignature*>> sorted(
+        signatures.begin(), signatures.end());
+    for (const auto& [name, functionSignatures] : sorted) {
+      if (!only.empty() && only.count(name) == 0) {
+        continue;
+      }
+      auto count = 0;
+      for (const auto* signature : functionSignatures) {
+        if (count >= FLAGS_signatures_per_function) {
+          break;
+        }
+        if (benchmarkSignature(name, *signature)) {
+          ++count;
+        }
+      }
+    }
+    report();
+  }
+
+ private:
+  // Returns false if the signature can not be benchmarked, e.g. because it
+  // takes lambdas.
+  bool benchmarkSignature(
+      const std::string& name,
+      const exec::FunctionSignature& signature) {
+    for (const auto& argument : signature.argumentTypes()) {
+      if (argument.baseName() == "function") {
+        return false;
+      }
+    }
+    test::ArgumentTypeFuzzer typeFuzzer(signature, rng_);
+    if (!typeFuzzer.fuzzArgumentTypes(2)) {
+      return false;
+    }
+    const auto& argTypes = typeFuzzer.argumentTypes();
+    const auto returnType = resolveFunction(name, argTypes);
+    if (!returnType) {
+      return false;
+    }
+
+    std::vector<std::string> names;
+    std::vector<core::TypedExprPtr> inputs;
+    std::vector<std::string> typeNames;
+    for (auto i = 0; i < argTypes.size(); ++i) {
+      names.push_back(fmt::format("c{}", i));
+      inputs.push_back(
+          std::make_shared<core::FieldAccessTypedExpr>(argTypes[i], names[i]));
+      typeNames.push_back(argTypes[i]->toString());
+    }
+    const auto call = fmt::format("{}({})", name, folly::join(", ", typeNames));
+    auto expr = std::make_shared<core::CallTypedExpr>(
+        returnType, std::move(inputs), name);
+    auto tryExpr = std::make_shared<core::CallTypedExpr>(
+        returnType, std::vector<core::TypedExprPtr>{expr}, "try");
+    const auto rowType = ROW(std::move(names), std::vector<TypePtr>(argTypes));
+
+    for (auto encoding :
+         {Encoding::kFlat,
+          Encoding::kFlatWithNulls,
+          Encoding::kDictionary,
+          Encoding::kConstant}) {
+      const auto input = makeInput(rowType, encoding);
+      try {
+        exec::ExprSet exprSet({expr}, &execCtx_);
+        evaluate(exprSet, input);
+        costs_.push_back(
+            {call,
+             typeClass(returnType),
+             encoding,
+             false,
+             measure(exprSet, input)});
+        continue;
+      } catch (const std::exception&) {
+      }
+      try {
+        exec::ExprSet exprSet({tryExpr}, &execCtx_);
+        costs_.push_back(
+            {call,
+             typeClass(returnType),
+             encoding,
+             true,
+             measure(exprSet, input)});
+      } catch (const std::exception& e) {
+        LOG(INFO) << call << " failed on " << encodingName(encoding)
+                  << " input: " << e.what();
+      }
+    }
+    return true;
+  }
+
+  RowVectorPtr makeInput(const RowTypePtr& rowType, Encoding encoding) {
+    VectorFuzzer::Options options;
+    options.vectorSize = FLAGS_vector_size;
+    options.nullRatio = encoding == Encoding::kFlatWithNulls ? 0.1 : 0;
+    VectorFuzzer fuzzer(options, pool(), rng_());
+    std::vector<VectorPtr> children;
+    for (const auto& type : rowType->children()) {
+      switch (encoding) {
+        case Encoding::kFlat:
+        case Encoding::kFlatWithNulls:
+          children.push_back(fuzzer.fuzzFlat(type));
+          break;
+        case Encoding::kDictionary:
+          children.push_back(fuzzer.fuzzDictionary(
+              fuzzer.fuzzFlat(type, FLAGS_vector_size / 10 + 1),
+              FLAGS_vector_size));
+          break;
+        case Encoding::kConstant:
+          children.push_back(fuzzer.fuzzConstant(type));
+          break;
+      }
+    }
+    return std::make_shared<RowVector>(
+        pool(), rowType, nullptr, FLAGS_vector_size, std::move(children));
+  }
+
+  double measure(exec::ExprSet& exprSet, const RowVectorPtr& input) {
+    uint64_t nanos = 0;
+    {
+      NanosecondTimer timer(&nanos);
+      for (auto i = 0; i < FLAGS_iterations; ++i) {
+        evaluate(exprSet, input);
+      }
+    }
+    return static_cast<double>(nanos) / FLAGS_iterations / input->size();
+  }
+
+  void report() {
+    std::sort(
+        costs_.begin(), costs_.end(), [](const auto& left, const auto& right) {
+          return left.nanosPerRow > right.nanosPerRow;
+        });
+
+    // Median cost per row for each type class and encoding.
+    std::map<std::pair<std::string, Encoding>, std::vector<double>> groups;
+    for (const auto& cost : costs_) {
+      groups[{cost.typeClass, cost.encoding}].push_back(cost.nanosPerRow);
+    }
+    std::map<std::pair<std::string, Encoding>, double> medians;
+    for (auto& [key, values] : groups) {
+      std::sort(values.begin(), values.end());
+      medians[key] = values[values.size() / 2];
+    }
+
+    std::vector<const CallCost*> outliers;
+    for (const auto& cost : costs_) {
+      const auto median = medians[{cost.typeClass, cost.encoding}];
+      const bool outlier = cost.nanosPerRow > median * FLAGS_outlier_ratio;
+      if (outlier) {
+        outliers.push_back(&cost);
+      }
+      std::cout << fmt::format(
+                       "{:>10.1f} ns/row {:<10} {:<9} {}{}{}",
+                       cost.nanosPerRow,
+                       encodingName(cost.encoding),
+                       cost.typeClass,
+                       cost.call,
+                       cost.underTry ? " under try" : "",
+                       outlier ? " <- outlier" : "")
+                << std::endl;
+    }
+
+    std::cout << std::endl
+              << outliers.size() << " calls cost more than "
+              << FLAGS_outlier_ratio
+              << "x the median of their type class and encoding:" << std::endl;
+    for (const auto* cost : outliers) {
+      std::cout << fmt::format(
+                       "  {} on {}: {:.1f} ns/row, median {:.1f}",
+                       cost->call,
+                       encodingName(cost->encoding),
+                       cost->nanosPerRow,
+                       medians[{cost->typeClass, cost->encoding}])
+                << std::endl;
+    }
+  }
+
+  std::mt19937 rng_;
+  std::vector<CallCost> costs_;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  functions::prestosql::registerAllScalarFunctions();
+  FunctionFuzzerBenchmark benchmark;
+  benchmark.run();
+  return 0;
+}
@@ -0,0 +1,492 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <filesystem>
+
+#include <folly/Random.h>
+#include <folly/String.h>
+#include <folly/executors/IOThreadPoolExecutor.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/memory/MmapAllocator.h"
+#include "velox/common/time/Timer.h"
+#include "velox/connectors/hive/HiveConnector.h"
+#include "velox/dwio/common/FileSink.h"
+#include "velox/dwio/dwrf/writer/Writer.h"
+#include "velox/dwio/parquet/writer/Writer.h"
+#include "velox/exec/tests/utils/HiveConnectorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/parse/TypeResolver.h"
+
+DEFINE_int32(num_rows, 4'000'000, "Number of rows in each generated file");
+DEFINE_int32(
+    num_columns,
+    17,
+    "Number of columns. c0 is the filter column. The others cycle through "
+    "sequential bigint, low cardinality bigint, uniform double and low "
+    "cardinality varchar");
+DEFINE_string(
+    formats,
+    "dwrf:dictionary,dwrf:direct,parquet:dictionary,parquet:plain,"
+    "parquet:delta",
+    "Comma separated <format>:<encoding> pairs to write and scan");
+DEFINE_string(
+    selectivities,
+    "1,10,50,100",
+    "Comma separated percentages of rows passing the filter on c0");
+DEFINE_string(
+    projections,
+    "1,4,16",
+    "Comma separated numbers of columns besides c0 to project");
+DEFINE_int32(num_drivers, 4, "Number of drivers");
+DEFINE_int32(num_splits_per_file, 8, "Number of splits per file");
+DEFINE_int32(num_repeats, 3, "Times to run each configuration");
+DEFINE_int32(
+    cache_mb,
+    0,
+    "If non-0, scans through an in-process data cache of this size. Each "
+    "configuration then runs once on a cleared (cold) and once on a filled "
+    "(warm) cache");
+DEFINE_int32(num_io_threads, 8, "Threads for speculative IO");
+
+/// Writes DWRF and Parquet files with the same data under different column
+/// encodings and scans them with TableScan over a matrix of filter
+/// selectivities and projection widths. For each configuration, reports rows
+/// per second, the bytes read from storage and from the cache and the CPU
+/// time of the scan, which is dominated by decoding.
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+namespace {
+
+constexpr int32_t kBatchSize = 10'000;
+// Values of c0 are uniform in [0, kFilterRange).
+constexpr int64_t kFilterRange = 1'000'000;
+
+struct ScanFile {
+  std::string name;
+  std::string path;
+  dwio::common::FileFormat format;
+};
+
+struct ScanStats {
+  uint64_t wallNanos{0};
+  uint64_t cpuNanos{0};
+  uint64_t outputRows{0};
+  uint64_t storageReadBytes{0};
+  uint64_t ramReadBytes{0};
+
+  void add(const ScanStats& other) {
+    wallNanos += other.wallNanos;
+    cpuNanos += other.cpuNanos;
+    outputRows += other.outputRows;
+    storageReadBytes += other.storageReadBytes;
+    ramReadBytes += other.ramReadBytes;
+  }
+};
+
+std::vector<int32_t> parseInts(const std::string& flag) {
+  std::vector<int32_t> values;
+  folly::split(',', flag, values, true);
+  return values;
+}
+
+class ScanBenchmark {
+ public:
+  void initialize() {
+    if (FLAGS_cache_mb > 0) {
+      memory::MmapAllocator::Options options;
+      options.capacity = static_cast<uint64_t>(FLAGS_cache_mb) << 20;
+      allocator_ = std::make_shared<memory::MmapAllocator>(options);
+      cache_ = cache::AsyncDataCache::create(allocator_.get());
+      cache::AsyncDataCache::setInstance(cache_.get());
+      memory::MemoryAllocator::setDefaultInstance(allocator_.get());
+    }
+    functions::prestosql::registerAllScalarFunctions();
+    aggregate::prestosql::registerAllAggregateFunctions();
+    parse::registerTypeResolver();
+    filesystems::registerLocalFileSystem();
+
+    ioExecutor_ =
+        std::make_unique<folly::IOThreadPoolExecutor>(FLAGS_num_io_threads);
+    auto hiveConnector =
+        connector::getConnectorFactory(
+            connector::hive::HiveConnectorFactory::kHiveConnectorName)
+            ->newConnector(kHiveConnectorId, nullptr, ioExecutor_.get());
+    connector::registerConnector(hiveConnector);
+
+    rootPool_ = memory::defaultMemoryManager().addRootPool("ScanBenchmark");
+    pool_ = rootPool_->addLeafChild("ScanBenchmark");
+    directory_ = TempDirectoryPath::create();
+  }
+
+  void shutdown() {
+    connector::unregisterConnector(kHiveConnectorId);
+    if (cache_) {
+      cache_->shutdown();
+    }
+  }
+
+  void writeFiles() {
+    const auto batches = makeData();
+    std::vector<std::string> specs;
+    folly::split(',', FLAGS_formats, specs, true);
+    for (const auto& spec : specs) {
+      std::string format;
+      std::string encoding;
+      VELOX_USER_CHECK(
+          folly::split(':', spec, format, encoding),
+          "Expected <format>:<encoding> in --formats: {}",
+          spec);
+      ScanFile file{
+          spec,
+          fmt::format("{}/{}_{}", directory_->path, format, encoding),
+          dwio::common::toFileFormat(format)};
+      if (file.format == dwio::common::FileFormat::DWRF) {
+        writeDwrf(file.path, encoding, batches);
+      } else if (file.format == dwio::common::FileFormat::PARQUET) {
+        writeParquet(file.path, encoding, batches);
+      } else {
+        VELOX_USER_FAIL("Unsupported format in --formats: {}", format);
+      }
+      std::cout << fmt::format(
+                       "{}: {}",
+                       file.name,
+                       succinctBytes(std::filesystem::file_size(file.path)))
+                << std::endl;
+      files_.push_back(std::move(file));
+    }
+  }
+
+  void run() {
+    std::cout << fmt::format(
+                     "{:<20} {:>6} {:>5} {:>5} {:>10} {:>12} {:>10} {:>10} "
+                     "{:>10}",
+                     "file",
+                     "cache",
+                     "sel%",
+                     "cols",
+                     "time",
+                     "rows/s",
+                     "storage",
+                     "ram",
+                     "scan cpu")
+              << std::endl;
+    for (const auto& file : files_) {
+      for (auto selectivity : parseInts(FLAGS_selectivities)) {
+        for (auto width : parseInts(FLAGS_projections)) {
+          const auto plan = makePlan(selectivity, width);
+          if (!cache_) {
+            report(file, "none", selectivity, width, runRepeats(file, plan));
+            continue;
+          }
+          report(
+              file, "cold", selectivity, width, runRepeats(file, plan, true));
+          report(file, "warm", selectivity, width, runRepeats(file, plan));
+        }
+      }
+    }
+  }
+
+ private:
+  std::vector<RowVectorPtr> makeData() {
+    std::vector<std::string> names;
+    std::vector<TypePtr> types;
+    for (auto i = 0; i < FLAGS_num_columns; ++i) {
+      names.push_back(fmt::format("c{}", i));
+      types.push_back(columnType(i));
+    }
+    rowType_ = ROW(std::move(names), std::move(types));
+
+    folly::Random::DefaultGenerator rng(1);
+    std::vector<RowVectorPtr> batches;
+    for (int32_t row = 0; row < FLAGS_num_rows; row += kBatchSize) {
+      const auto size = std::min(kBatchSize, FLAGS_num_rows - row);
+      std::vector<VectorPtr> children;
+      for (auto i = 0; i < FLAGS_num_columns; ++i) {
+        children.push_back(makeColumn(i, row, size, rng));
+      }
+      batches.push_back(std::make_shared<RowVector>(
+          pool_.get(), rowType_, nullptr, size, std::move(children)));
+    }
+    return batches;
+  }
+
+  static TypePtr columnType(int32_t column) {
+    if (column == 0) {
+      return BIGINT();
+    }
+    switch (column % 4) {
+      case 2:
+        return DOUBLE();
+      case 3:
+        return VARCHAR();
+      default:
+        return BIGINT();
+    }
+  }
+
+  VectorPtr makeColumn(
+      int32_t column,
+      int32_t firstRow,
+      vector_size_t size,
+      folly::Random::DefaultGenerator& rng) {
+    auto vector = BaseVector::create(columnType(column), size, pool_.get());
+    if (column == 0) {
+      auto* flat = vector->asFlatVector<int64_t>();
+      for (auto i = 0; i < size; ++i) {
+        flat->set(i, folly::Random::rand64(kFilterRange, rng));
+      }
+      return vector;
+    }
+    switch (column % 4) {
+      case 0: {
+        // Sequential, suits delta encodings.
+        auto* flat = vector->asFlatVector<int64_t>();
+        for (auto i = 0; i < size; ++i) {
+          flat->set(i, firstRow + i);
+        }
+        break;
+      }
+      case 1: {
+        // Low cardinality, suits dictionaries.
+        auto* flat = vector->asFlatVector<int64_t>();
+        for (auto i = 0; i < size; ++i) {
+          flat->set(i, folly::Random::rand64(1'000, rng));
+        }
+        break;
+      }
+      case 2: {
+        auto* flat = vector->asFlatVector<double>();
+        for (auto i = 0; i < size; ++i) {
+          flat->set(i, folly::Random::randDouble01(rng));
+        }
+        break;
+      }
+      case 3: {
+        auto* flat = vector->asFlatVector<StringView>();
+        for (auto i = 0; i < size; ++i) {
+          const auto value = fmt::format(
+              "value_with_some_prefix_{}", folly::Random::rand32(500, rng));
+          flat->set(i, StringView(value));
+        }
+        break;
+      }
+    }
+    return vector;
+  }
+
+  void writeDwrf(
+      const std::string& path,
+      const std::string& encoding,
+      const std::vector<RowVectorPtr>& batches) {
+    auto config = std::make_shared<dwrf::Config>();
+    if (encoding == "direct") {
+      config->set(dwrf::Config::DICTIONARY_NUMERIC_KEY_SIZE_THRESHOLD, 0.0f);
+      config->set(dwrf::Config::DICTIONARY_STRING_KEY_SIZE_THRESHOLD, 0.0f);
+    } else {
+      VELOX_USER_CHECK_EQ(encoding, "dictionary", "Unknown DWRF encoding");
+      config->set(dwrf::Config::DICTIONARY_NUMERIC_KEY_SIZE_THRESHOLD, 1.0f);
+      config->set(dwrf::Config::DICTIONARY_STRING_KEY_SIZE_THRESHOLD, 1.0f);
+    }
+    dwrf::WriterOptions options;
+    options.config = config;
+    options.schema = rowType_;
+    auto writerPool = rootPool_->addAggregateChild("ScanBenchmark.Writer");
+    options.memoryPool = writerPool.get();
+    dwrf::Writer writer{
+        std::make_unique<dwio::common::WriteFileSink>(
+            std::make_unique<LocalWriteFile>(path, true, false), path),
+        options};
+    for (const auto& batch : batches) {
+      writer.write(batch);
+    }
+    writer.close();
+  }
+
+  void writeParquet(
+      const std::string& path,
+      const std::string& encoding,
+      const std::vector<RowVectorPtr>& batches) {
+    facebook::velox::parquet::WriterOptions options;
+    if (encoding == "plain" || encoding == "delta") {
+      options.enableDictionary = false;
+    } else {
+      VELOX_USER_CHECK_EQ(encoding, "dictionary", "Unknown Parquet encoding");
+    }
+    if (encoding == "delta") {
+      using facebook::velox::parquet::PageEncoding;
+      for (auto i = 0; i < rowType_->size(); ++i) {
+        auto& columnEncoding = options.columnEncodings[rowType_->nameOf(i)];
+        switch (rowType_->childAt(i)->kind()) {
+          case TypeKind::BIGINT:
+            columnEncoding = PageEncoding::kDeltaBinaryPacked;
+            break;
+          case TypeKind::VARCHAR:
+            columnEncoding = PageEncoding::kDeltaLengthByteArray;
+            break;
+          default:
+            columnEncoding = PageEncoding::kByteStreamSplit;
+            break;
+        }
+      }
+    }
+    options.memoryPool = rootPool_.get();
+    facebook::velox::parquet::Writer writer(
+        std::make_unique<dwio::common::WriteFileSink>(
+            std::make_unique<LocalWriteFile>(path, true, false), path),
+        options);
+    for (const auto& batch : batches) {
+      writer.write(batch);
+    }
+    writer.close();
+  }
+
+  // Scans c1..c<width> of the rows where c0 passes a filter that selects
+  // 'selectivity' percent of the rows. The aggregation makes the scan load
+  // every projected value.
+  core::PlanNodePtr makePlan(int32_t selectivity, int32_t width) {
+    width = std::min(width, FLAGS_num_columns - 1);
+    std::vector<std::string> names;
+    std::vector<TypePtr> types;
+    std::vector<std::string> aggregates{"count(1)"};
+    for (auto i = 1; i <= width; ++i) {
+      names.push_back(rowType_->nameOf(i));
+      types.push_back(rowType_->childAt(i));
+      aggregates.push_back(fmt::format("max({})", rowType_->nameOf(i)));
+    }
+    std::vector<std::string> filters;
+    if (selectivity < 100) {
+      filters.push_back(
+          fmt::format("c0 < {}", kFilterRange * selectivity / 100));
+    }
+    return PlanBuilder()
+        .tableScan(
+            ROW(std::move(names), std::move(types)), filters, "", rowType_)
+        .singleAggregation({}, aggregates)
+        .planNode();
+  }
+
+  // Runs 'plan' over 'file' --num_repeats times. Clears the cache before
+  // each run if 'clearCache' is true.
+  ScanStats runRepeats(
+      const ScanFile& file,
+      const core::PlanNodePtr& plan,
+      bool clearCache = false) {
+    ScanStats total;
+    for (auto i = 0; i < FLAGS_num_repeats; ++i) {
+      if (clearCache) {
+        cache_->clear();
+      }
+      total.add(runOnce(file, plan));
+    }
+    return total;
+  }
+
+  ScanStats runOnce(const ScanFile& file, const core::PlanNodePtr& plan) {
+    CursorParameters params;
+    params.planNode = plan;
+    params.maxDrivers = FLAGS_num_drivers;
+    bool noMoreSplits = false;
+    auto addSplits = [&](Task* task) {
+      if (noMoreSplits) {
+        return;
+      }
+      for (const auto& split : HiveConnectorTestBase::makeHiveConnectorSplits(
+               file.path, FLAGS_num_splits_per_file, file.format)) {
+        task->addSplit("0", Split(split));
+      }
+      task->noMoreSplits("0");
+      noMoreSplits = true;
+    };
+
+    ScanStats stats;
+    std::unique_ptr<TaskCursor> cursor;
+    {
+      NanosecondTimer timer(&stats.wallNanos);
+      cursor = readCursor(params, addSplits, 60'000'000).first;
+    }
+    for (const auto& pipeline : cursor->task()->taskStats().pipelineStats) {
+      for (const auto& op : pipeline.operatorStats) {
+        if (op.operatorType != "TableScan") {
+          continue;
+        }
+        stats.cpuNanos += op.getOutputTiming.cpuNanos;
+        stats.outputRows += op.outputPositions;
+        auto counter = [&](const char* name) -> uint64_t {
+          auto it = op.runtimeStats.find(name);
+          return it == op.runtimeStats.end() ? 0 : it->second.sum;
+        };
+        stats.storageReadBytes += counter("storageReadBytes");
+        stats.ramReadBytes += counter("ramReadBytes");
+      }
+    }
+    return stats;
+  }
+
+  void report(
+      const ScanFile& file,
+      const char* cache,
+      int32_t selectivity,
+      int32_t width,
+      const ScanStats& stats) {
+    const auto repeats = FLAGS_num_repeats;
+    const auto seconds = stats.wallNanos / 1.0e9;
+    std::cout << fmt::format(
+                     "{:<20} {:>6} {:>5} {:>5} {:>10} {:>12.0f} {:>10} {:>10} "
+                     "{:>10}",
+                     file.name,
+                     cache,
+                     selectivity,
+                     std::min(width, FLAGS_num_columns - 1),
+                     succinctNanos(stats.wallNanos / repeats),
+                     static_cast<double>(FLAGS_num_rows) * repeats / seconds,
+                     succinctBytes(stats.storageReadBytes / repeats),
+                     succinctBytes(stats.ramReadBytes / repeats),
+                     succinctNanos(stats.cpuNanos / repeats))
+              << std::endl;
+  }
+
+  std::shared_ptr<memory::MemoryAllocator> allocator_;
+  std::shared_ptr<cache::AsyncDataCache> cache_;
+  std::unique_ptr<folly::IOThreadPoolExecutor> ioExecutor_;
+  std::shared_ptr<memory::MemoryPool> rootPool_;
+  std::shared_ptr<memory::MemoryPool> pool_;
+  std::shared_ptr<TempDirectoryPath> directory_;
+  RowTypePtr rowType_;
+  std::vector<ScanFile> files_;
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  ScanBenchmark benchmark;
+  benchmark.initialize();
+  benchmark.writeFiles();
+  benchmark.run();
+  benchmark.shutdown();
+  return 0;
+}
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/benchmarks/tpch/BenchmarkResults.h"
+
+#include <cmath>
+#include <limits>
+
+#include <fmt/format.h>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/exec/PlanNodeStats.h"
+
+namespace facebook::velox {
+namespace {
+
+struct Sample {
+  double mean{0};
+  double variance{0};
+  int32_t count{0};
+};
+
+// Returns the mean and the sample variance of 'field' of the runs in 'runs'
+// that have it. 'path' leads from a run to the object that has 'field'.
+Sample sample(
+    const folly::dynamic& runs,
+    const std::vector<std::string>& path,
+    const std::string& field) {
+  std::vector<double> values;
+  for (const auto& run : runs) {
+    const folly::dynamic* object = &run;
+    for (const auto& key : path) {
+      object = object->get_ptr(key);
+      if (object == nullptr) {
+        break;
+      }
+    }
+    if (object == nullptr || object->count(field) == 0) {
+      continue;
+    }
+    values.push_back((*object)[field].asDouble());
+  }
+  Sample result;
+  result.count = values.size();
+  if (values.empty()) {
+    return result;
+  }
+  for (auto value : values) {
+    result.mean += value;
+  }
+  result.mean /= values.size();
+  if (values.size() > 1) {
+    for (auto value : values) {
+      result.variance += (value - result.mean) * (value - result.mean);
+    }
+    result.variance /= values.size() - 1;
+  }
+  return result;
+}
+
+// Welch's t statistic of the difference of the means of 'current' and
+// 'baseline'. Infinite if both have no variance and the means differ.
+double welchT(const Sample& baseline, const Sample& current) {
+  const auto error = std::sqrt(
+      baseline.variance / baseline.count + current.variance / current.count);
+  const auto difference = current.mean - baseline.mean;
+  if (error == 0) {
+    if (difference == 0) {
+      return 0;
+    }
+    return std::copysign(std::numeric_limits<double>::infinity(), difference);
+  }
+  return difference / error;
+}
+
+void compare(
+    const std::string& name,
+    const folly::dynamic& baselineRuns,
+    const folly::dynamic& currentRuns,
+    const std::vector<std::string>& path,
+    const std::string& field,
+    double minChangePct,
+    double minT,
+    std::vector<Regression>& regressions) {
+  const auto baseline = sample(baselineRuns, path, field);
+  const auto current = sample(currentRuns, path, field);
+  if (baseline.count == 0 || current.count == 0) {
+    return;
+  }
+  if (current.mean <= baseline.mean * (1 + minChangePct / 100)) {
+    return;
+  }
+  const auto t = welchT(baseline, current);
+  if (t > minT) {
+    regressions.push_back({name, baseline.mean, current.mean, t});
+  }
+}
+
+} // namespace
+
+folly::dynamic runToJson(uint64_t wallNanos, const exec::TaskStats& stats) {
+  folly::dynamic operators = folly::dynamic::object;
+  uint64_t cpuNanos = 0;
+  for (const auto& [nodeId, nodeStats] : exec::toPlanStats(stats)) {
+    for (const auto& [operatorType, opStats] : nodeStats.operatorStats) {
+      folly::dynamic customStats = folly::dynamic::object;
+      for (const auto& [statName, metric] : opStats->customStats) {
+        customStats[statName] = metric.sum;
+      }
+      folly::dynamic op = folly::dynamic::object;
+      op["cpuNanos"] = opStats->cpuWallTiming.cpuNanos;
+      op["wallNanos"] = opStats->cpuWallTiming.wallNanos;
+      op["inputRows"] = opStats->inputRows;
+      op["outputRows"] = opStats->outputRows;
+      op["rawInputBytes"] = opStats->rawInputBytes;
+      op["blockedWallNanos"] = opStats->blockedWallNanos;
+      op["peakMemoryBytes"] = opStats->peakMemoryBytes;
+      op["spilledBytes"] = opStats->spilledBytes;
+      op["spilledRows"] = opStats->spilledRows;
+      op["customStats"] = std::move(customStats);
+      operators[fmt::format("{}.{}", nodeId, operatorType)] = std::move(op);
+      cpuNanos += opStats->cpuWallTiming.cpuNanos;
+    }
+  }
+  folly::dynamic run = folly::dynamic::object;
+  run["wallNanos"] = wallNanos;
+  run["cpuNanos"] = cpuNanos;
+  run["operators"] = std::move(operators);
+  return run;
+}
+
+std::string Regression::toString() const {
+  return fmt::format(
+      "{}: {} -> {} (+{:.1f}%, t={:.2f})",
+      metric,
+      succinctNanos(static_cast<uint64_t>(baselineMean)),
+      succinctNanos(static_cast<uint64_t>(mean)),
+      100 * (mean - baselineMean) / baselineMean,
+      t);
+}
+
+std::vector<Regression> findRegressions(
+    const folly::dynamic& baseline,
+    const folly::dynamic& current,
+    double minChangePct,
+    double minT) {
+  std::vector<Regression> regressions;
+  for (const auto& [query, currentRuns] : current.items()) {
+    const auto* baselineRuns = baseline.get_ptr(query);
+    if (baselineRuns == nullptr || currentRuns.empty()) {
+      continue;
+    }
+    const auto name = query.asString();
+    for (const auto* field : {"wallNanos", "cpuNanos"}) {
+      compare(
+          fmt::format("{}.{}", name, field),
+          *baselineRuns,
+          currentRuns,
+          {},
+          field,
+          minChangePct,
+          minT,
+          regressions);
+    }
+    for (const auto& [op, _] : currentRuns[0]["operators"].items()) {
+      const auto key = op.asString();
+      compare(
+          fmt::format("{}.{}.cpuNanos", name, key),
+          *baselineRuns,
+          currentRuns,
+          {"operators", key},
+          "cpuNanos",
+          minChangePct,
+          minT,
+          regressions);
+    }
+  }
+  return regressions;
+}
+
+} // namespace facebook::velox
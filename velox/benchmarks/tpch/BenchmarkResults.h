@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/dynamic.h>
+
+#include "velox/exec/TaskStats.h"
+
+namespace facebook::velox {
+
+/// Returns the measurements of one run of a query as JSON:
+///
+///   {"wallNanos": ..., "cpuNanos": ..., "operators": {
+///     "<plan node id>.<operator type>": {"cpuNanos": ..., "wallNanos": ...,
+///       "inputRows": ..., "outputRows": ..., "rawInputBytes": ...,
+///       "blockedWallNanos": ..., "peakMemoryBytes": ..., "spilledBytes": ...,
+///       "spilledRows": ..., "customStats": {"<name>": <sum>, ...}}, ...}}
+///
+/// 'customStats' has the runtime stats of the operator, e.g. the cache and IO
+/// counters of table scans and the hardware counters sampled with
+/// 'operator_perf_counter_sample_interval'.
+folly::dynamic runToJson(uint64_t wallNanos, const exec::TaskStats& stats);
+
+/// A metric whose mean over the runs of a query increased significantly
+/// against the baseline.
+struct Regression {
+  /// Query name followed by "wallNanos", "cpuNanos" or
+  /// "<operator key>.cpuNanos".
+  std::string metric;
+  double baselineMean;
+  double mean;
+  /// Welch's t statistic of the difference of the means.
+  double t;
+
+  std::string toString() const;
+};
+
+/// Compares the runs in 'current' against the runs in 'baseline'. Both map
+/// query names to arrays of runToJson() results. Compares the wall and CPU
+/// time of each query and the CPU time of each operator present in both.
+/// Reports a metric when its mean grew by more than 'minChangePct' percent
+/// and by more than 'minT' in Welch's t statistic. Metrics with a single run
+/// on both sides have no variance and are judged by 'minChangePct' alone.
+std::vector<Regression> findRegressions(
+    const folly::dynamic& baseline,
+    const folly::dynamic& current,
+    double minChangePct,
+    double minT);
+
+} // namespace facebook::velox
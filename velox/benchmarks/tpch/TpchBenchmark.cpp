@@ -19,12 +19,17 @@
 #include <sys/time.h>
 
 #include <folly/Benchmark.h>
+#include <folly/FileUtil.h>
+#include <folly/String.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/init/Init.h>
+#include <folly/json.h>
 #include <gflags/gflags.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <fstream>
 
+#include "velox/benchmarks/tpch/BenchmarkResults.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/memory/MmapAllocator.h"
@@ -182,6 +187,37 @@ DEFINE_int32(
     "prefetch. 1 means prefetch the next row group before decoding "
     "the current one");
 
+DEFINE_string(
+    suite_queries,
+    "",
+    "Comma separated TPC-H query numbers. If non-empty, runs each query "
+    "--num_repeats times, writes the per-operator stats of each run to "
+    "--suite_output and compares them to --suite_baseline");
+DEFINE_string(
+    suite_output,
+    "tpch_results.json",
+    "File for the results of --suite_queries");
+DEFINE_string(
+    suite_baseline,
+    "",
+    "Results of an earlier run of --suite_queries to compare against. The "
+    "benchmark exits with 1 if a query or operator regressed");
+DEFINE_double(
+    regression_min_change_pct,
+    5,
+    "Minimum increase in percent of the mean time of a query or operator "
+    "over --suite_baseline to report");
+DEFINE_double(
+    regression_min_t,
+    3,
+    "Minimum Welch's t statistic of the increase of the mean time over "
+    "--suite_baseline to report");
+DEFINE_int32(
+    perf_counter_sample_interval,
+    0,
+    "If non-0, samples hardware counters around one in every this many "
+    "operator calls. See operator_perf_counter_sample_interval");
+
 struct RunStats {
   std::map<std::string, std::string> flags;
   int64_t micros{0};
@@ -250,6 +286,8 @@ class TpchBenchmark {
 
     ioExecutor_ =
         std::make_unique<folly::IOThreadPoolExecutor>(FLAGS_num_io_threads);
+    queryExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        std::thread::hardware_concurrency());
 
     // Add new values into the hive configuration...
     auto configurationValues = std::unordered_map<std::string, std::string>();
@@ -274,13 +312,21 @@ class TpchBenchmark {
   }
 
   std::pair<std::unique_ptr<TaskCursor>, std::vector<RowVectorPtr>> run(
-      const TpchPlan& tpchPlan) {
+      const TpchPlan& tpchPlan,
+      int32_t numRepeats = FLAGS_num_repeats) {
     int32_t repeat = 0;
     try {
       for (;;) {
         CursorParameters params;
         params.maxDrivers = FLAGS_num_drivers;
         params.planNode = tpchPlan.plan;
+        if (FLAGS_perf_counter_sample_interval > 0) {
+          params.queryCtx = std::make_shared<core::QueryCtx>(
+              queryExecutor_.get(),
+              std::unordered_map<std::string, std::string>{
+                  {core::QueryConfig::kOperatorPerfCounterSampleInterval,
+                   std::to_string(FLAGS_perf_counter_sample_interval)}});
+        }
         const int numSplitsPerFile = FLAGS_num_splits_per_file;
 
         bool noMoreSplits = false;
@@ -302,7 +348,7 @@ class TpchBenchmark {
         };
         auto result = readCursor(params, addSplits);
         ensureTaskCompletion(result.first->task().get());
-        if (++repeat >= FLAGS_num_repeats) {
+        if (++repeat >= numRepeats) {
           return result;
         }
       }
@@ -355,6 +401,56 @@ class TpchBenchmark {
     }
   }
 
+  // Runs each of --suite_queries --num_repeats times and writes the stats of
+  // each run to --suite_output. Returns the number of regressions against
+  // --suite_baseline.
+  int32_t runSuite() {
+    std::vector<std::string> queries;
+    folly::split(',', FLAGS_suite_queries, queries, true);
+    folly::dynamic results = folly::dynamic::object;
+    for (const auto& query : queries) {
+      const auto queryPlan =
+          queryBuilder->getQueryPlan(folly::to<int32_t>(query));
+      folly::dynamic runs = folly::dynamic::array;
+      for (auto i = 0; i < FLAGS_num_repeats; ++i) {
+        uint64_t micros = 0;
+        std::unique_ptr<TaskCursor> cursor;
+        {
+          MicrosecondTimer timer(&micros);
+          cursor = run(queryPlan, 1).first;
+        }
+        if (!cursor) {
+          LOG(ERROR) << "Query q" << query << " terminated with error";
+          break;
+        }
+        runs.push_back(runToJson(micros * 1'000, cursor->task()->taskStats()));
+      }
+      std::cout << "q" << query << ": " << runs.size() << " runs" << std::endl;
+      results["q" + query] = std::move(runs);
+    }
+    folly::writeFile(folly::toPrettyJson(results), FLAGS_suite_output.c_str());
+
+    if (FLAGS_suite_baseline.empty()) {
+      return 0;
+    }
+    std::string baseline;
+    if (!folly::readFile(FLAGS_suite_baseline.c_str(), baseline)) {
+      LOG(ERROR) << "Failed to read " << FLAGS_suite_baseline;
+      return 0;
+    }
+    const auto regressions = findRegressions(
+        folly::parseJson(baseline),
+        results,
+        FLAGS_regression_min_change_pct,
+        FLAGS_regression_min_t);
+    std::cout << regressions.size() << " regressions against "
+              << FLAGS_suite_baseline << std::endl;
+    for (const auto& regression : regressions) {
+      std::cout << regression.toString() << std::endl;
+    }
+    return regressions.size();
+  }
+
   void readCombinations() {
     std::ifstream file(FLAGS_test_flags_file);
     std::string line;
@@ -471,6 +567,8 @@ class TpchBenchmark {
 
   std::unique_ptr<folly::IOThreadPoolExecutor> ioExecutor_;
   std::unique_ptr<folly::IOThreadPoolExecutor> cacheExecutor_;
+  // Runs the queries with a QueryCtx of their own.
+  std::unique_ptr<folly::CPUThreadPoolExecutor> queryExecutor_;
   std::shared_ptr<memory::MemoryAllocator> allocator_;
   std::shared_ptr<cache::AsyncDataCache> cache_;
   // Parameter combinations to try. Each element specifies a flag and possible
@@ -582,7 +680,10 @@ int tpchBenchmarkMain() {
   queryBuilder =
       std::make_shared<TpchQueryBuilder>(toFileFormat(FLAGS_data_format));
   queryBuilder->initialize(FLAGS_data_path);
-  if (FLAGS_test_flags_file.empty()) {
+  int32_t numRegressions = 0;
+  if (!FLAGS_suite_queries.empty()) {
+    numRegressions = benchmark.runSuite();
+  } else if (FLAGS_test_flags_file.empty()) {
     RunStats ignore;
     benchmark.runMain(std::cout, ignore);
   } else {
@@ -590,5 +691,5 @@ int tpchBenchmarkMain() {
   }
   benchmark.shutdown();
   queryBuilder.reset();
-  return 0;
+  return numRegressions > 0 ? 1 : 0;
 }
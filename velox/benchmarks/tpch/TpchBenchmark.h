@@ -15,4 +15,4 @@
  */
 #pragma once
 
-void tpchBenchmarkMain();
+int tpchBenchmarkMain();
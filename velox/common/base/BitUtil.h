@@ -743,6 +743,19 @@ inline uint64_t hashMix(const uint64_t upper, const uint64_t lower) noexcept {
   return b;
 }
 
+// Batch form of hashMix(): sets 'upper[i]' to hashMix(upper[i], lower[i]) for
+// 'size' consecutive positions. The loop has no branches and no loop-carried
+// dependency so that it is vectorized where 64 bit multiplies are available.
+#if defined(FOLLY_DISABLE_UNDEFINED_BEHAVIOR_SANITIZER)
+FOLLY_DISABLE_UNDEFINED_BEHAVIOR_SANITIZER("unsigned-integer-overflow")
+#endif
+inline void
+hashMix(uint64_t* upper, const uint64_t* lower, int32_t size) noexcept {
+  for (auto i = 0; i < size; ++i) {
+    upper[i] = hashMix(upper[i], lower[i]);
+  }
+}
+
 // Order-independent way to reduce multiple 64 bit hashes into a
 // single hash. Copied from folly/hash/Hash.h because this is not
 // defined in some versions of folly.
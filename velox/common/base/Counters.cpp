@@ -24,6 +24,37 @@ void registerVeloxCounters() {
   // P50, P90, P99, and P100.
   REPORT_ADD_HISTOGRAM_EXPORT_PERCENTILE(
       kCounterHiveFileHandleGenerateLatencyMs, 10, 0, 100000, 50, 90, 99, 100);
+
+  // Count the hits and misses of the Hive file handle cache.
+  REPORT_ADD_STAT_EXPORT_TYPE(
+      kCounterHiveFileHandleCacheHits, StatType::COUNT);
+  REPORT_ADD_STAT_EXPORT_TYPE(
+      kCounterHiveFileHandleCacheMisses, StatType::COUNT);
+
+  // Track cache lookup latency in range of [0, 100us] and reports P50, P90,
+  // P99, and P100.
+  REPORT_ADD_HISTOGRAM_EXPORT_PERCENTILE(
+      kCounterCacheLookupLatencyNs, 100, 0, 100000, 50, 90, 99, 100);
+
+  // Track SSD cache read latency in range of [0, 100ms] and reports P50, P90,
+  // P99, and P100.
+  REPORT_ADD_HISTOGRAM_EXPORT_PERCENTILE(
+      kCounterSsdCacheReadLatencyUs, 100, 0, 100000, 50, 90, 99, 100);
+
+  // Track exchange page fetch latency in range of [0, 100s] and reports P50,
+  // P90, P99, and P100.
+  REPORT_ADD_HISTOGRAM_EXPORT_PERCENTILE(
+      kCounterExchangePageFetchLatencyMs, 10, 0, 100000, 50, 90, 99, 100);
+
+  // Track spill write latency in range of [0, 1s] and reports P50, P90, P99,
+  // and P100.
+  REPORT_ADD_HISTOGRAM_EXPORT_PERCENTILE(
+      kCounterSpillWriteLatencyUs, 1000, 0, 1000000, 50, 90, 99, 100);
+
+  // Track arbitration wait latency in range of [0, 100s] and reports P50, P90,
+  // P99, and P100.
+  REPORT_ADD_HISTOGRAM_EXPORT_PERCENTILE(
+      kCounterArbitrationWaitLatencyMs, 100, 0, 100000, 50, 90, 99, 100);
 }
 
 } // namespace facebook::velox
@@ -25,4 +25,35 @@ void registerVeloxCounters();
 
 constexpr folly::StringPiece kCounterHiveFileHandleGenerateLatencyMs{
     "velox.hive_file_handle_generate_latency_ms"};
+
+/// The number of Hive file handle lookups that found the file open in the
+/// handle cache and that had to open the file.
+constexpr folly::StringPiece kCounterHiveFileHandleCacheHits{
+    "velox.hive_file_handle_cache_hits"};
+constexpr folly::StringPiece kCounterHiveFileHandleCacheMisses{
+    "velox.hive_file_handle_cache_misses"};
+
+/// Latency of AsyncDataCache lookups. Only one in
+/// kCacheLookupLatencySampleInterval lookups per thread is timed.
+constexpr folly::StringPiece kCounterCacheLookupLatencyNs{
+    "velox.cache_lookup_latency_ns"};
+
+constexpr int32_t kCacheLookupLatencySampleInterval{64};
+
+constexpr folly::StringPiece kCounterSsdCacheReadLatencyUs{
+    "velox.ssd_cache_read_latency_us"};
+
+/// Time from requesting data from an exchange source to receiving the
+/// response.
+constexpr folly::StringPiece kCounterExchangePageFetchLatencyMs{
+    "velox.exchange_page_fetch_latency_ms"};
+
+/// Time to write a serialized spill batch to the spill file.
+constexpr folly::StringPiece kCounterSpillWriteLatencyUs{
+    "velox.spill_write_latency_us"};
+
+/// Time a memory arbitration request waits for the ongoing arbitration to
+/// finish.
+constexpr folly::StringPiece kCounterArbitrationWaitLatencyMs{
+    "velox.arbitration_wait_latency_ms"};
 } // namespace facebook::velox
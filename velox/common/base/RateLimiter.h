@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox {
+
+/// Token bucket rate limiter shared by threads consuming a common resource,
+/// e.g. the disk bandwidth of spill writes from one query. Tokens refill at
+/// 'ratePerSec' up to 'burst'. A caller may borrow beyond the available
+/// tokens and then sleeps off the debt, so a single large request is never
+/// starved by smaller ones.
+class RateLimiter {
+ public:
+  RateLimiter(uint64_t ratePerSec, uint64_t burst)
+      : ratePerSec_(ratePerSec),
+        burst_(std::max<uint64_t>(burst, 1)),
+        tokens_(burst_),
+        lastRefill_(std::chrono::steady_clock::now()) {
+    VELOX_CHECK_GT(ratePerSec_, 0);
+  }
+
+  /// Takes 'count' tokens and blocks the calling thread until the tokens
+  /// borrowed beyond the available ones have been refilled. Returns the time
+  /// waited in microseconds.
+  uint64_t acquire(uint64_t count) {
+    uint64_t waitUs{0};
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      const auto now = std::chrono::steady_clock::now();
+      const auto elapsedUs =
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              now - lastRefill_)
+              .count();
+      lastRefill_ = now;
+      tokens_ = std::min<double>(
+          burst_, tokens_ + elapsedUs * (ratePerSec_ / 1'000'000.0));
+      tokens_ -= count;
+      if (tokens_ < 0) {
+        waitUs = -tokens_ * 1'000'000 / ratePerSec_;
+        totalWaitUs_ += waitUs;
+      }
+    }
+    if (waitUs > 0) {
+      std::this_thread::sleep_for(std::chrono::microseconds(waitUs));
+    }
+    return waitUs;
+  }
+
+  uint64_t ratePerSec() const {
+    return ratePerSec_;
+  }
+
+  /// Returns the total time in microseconds callers have been throttled.
+  uint64_t totalWaitUs() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return totalWaitUs_;
+  }
+
+ private:
+  const uint64_t ratePerSec_;
+  const uint64_t burst_;
+
+  mutable std::mutex mutex_;
+  double tokens_;
+  std::chrono::steady_clock::time_point lastRefill_;
+  uint64_t totalWaitUs_{0};
+};
+
+} // namespace facebook::velox
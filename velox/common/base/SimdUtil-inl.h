@@ -107,6 +107,15 @@ struct BitMask<T, A, 2> {
   }
 #endif
 
+#if XSIMD_WITH_NEON64
+  static int toBitMask(xsimd::batch_bool<T, A> mask, const xsimd::neon64&) {
+    // NEON has no movemask. Keeps the bit of each lane and sums the lanes.
+    alignas(A::alignment()) static const uint16_t kBits[] = {
+        1, 2, 4, 8, 16, 32, 64, 128};
+    return vaddvq_u16(vandq_u16(mask, vld1q_u16(kBits)));
+  }
+#endif
+
   static int toBitMask(xsimd::batch_bool<T, A> mask, const xsimd::generic&) {
     return genericToBitMask(mask);
   }
@@ -128,6 +137,13 @@ struct BitMask<T, A, 4> {
   }
 #endif
 
+#if XSIMD_WITH_NEON64
+  static int toBitMask(xsimd::batch_bool<T, A> mask, const xsimd::neon64&) {
+    alignas(A::alignment()) static const uint32_t kBits[] = {1, 2, 4, 8};
+    return vaddvq_u32(vandq_u32(mask, vld1q_u32(kBits)));
+  }
+#endif
+
   static int toBitMask(xsimd::batch_bool<T, A> mask, const xsimd::generic&) {
     return genericToBitMask(mask);
   }
@@ -154,6 +170,13 @@ struct BitMask<T, A, 8> {
   }
 #endif
 
+#if XSIMD_WITH_NEON64
+  static int toBitMask(xsimd::batch_bool<T, A> mask, const xsimd::neon64&) {
+    alignas(A::alignment()) static const uint64_t kBits[] = {1, 2};
+    return vaddvq_u64(vandq_u64(mask, vld1q_u64(kBits)));
+  }
+#endif
+
   static int toBitMask(xsimd::batch_bool<T, A> mask, const xsimd::generic&) {
     return genericToBitMask(mask);
   }
@@ -176,6 +199,11 @@ int32_t indicesOfSetBits(
   if (end <= begin) {
     return 0;
   }
+#ifdef VELOX_SIMD_RUNTIME_AVX512
+  if (end - begin >= detail::kMinAvx512IndicesBits && detail::useAvx512()) {
+    return detail::indicesOfSetBitsAvx512(bits, begin, end, result);
+  }
+#endif
   int32_t row = begin & ~63;
   auto originalResult = result;
   int32_t endWord = bits::roundUp(end, 64) / 64;
@@ -775,6 +803,22 @@ struct Permute<T, A, 4> {
         _mm_permutevar_ps(reinterpret_cast<__m128>(data.data), idx));
   }
 #endif
+
+#if XSIMD_WITH_NEON64
+  static xsimd::batch<T, A> apply(
+      xsimd::batch<T, A> data,
+      xsimd::batch<int32_t, A> idx,
+      const xsimd::neon64&) {
+    // Turns each lane index into the indices of its 4 bytes for a table
+    // lookup.
+    auto bytes = vmlaq_n_u32(
+        vdupq_n_u32(0x03020100), vreinterpretq_u32_s32(idx), 0x04040404);
+    return reinterpret_cast<typename xsimd::batch<T, A>::register_type>(
+        vqtbl1q_u8(
+            reinterpret_cast<uint8x16_t>(data.data),
+            vreinterpretq_u8_u32(bytes)));
+  }
+#endif
 };
 
 } // namespace detail
@@ -1020,6 +1064,21 @@ struct Filter<T, A, 2> {
     return ans;
   }
 #endif
+
+#if XSIMD_WITH_NEON64
+  static xsimd::batch<T, A>
+  apply(xsimd::batch<T, A> data, int mask, const xsimd::neon64&) {
+    const auto* lanes = byteSetBits[mask];
+    auto lanes16 = vcombine_u16(
+        vmovn_u32(vreinterpretq_u32_s32(vld1q_s32(lanes))),
+        vmovn_u32(vreinterpretq_u32_s32(vld1q_s32(lanes + 4))));
+    auto bytes = vmlaq_n_u16(vdupq_n_u16(0x0100), lanes16, 0x0202);
+    return reinterpret_cast<typename xsimd::batch<T, A>::register_type>(
+        vqtbl1q_u8(
+            reinterpret_cast<uint8x16_t>(data.data),
+            vreinterpretq_u8_u16(bytes)));
+  }
+#endif
 };
 
 template <typename T, typename A>
@@ -1053,6 +1112,19 @@ struct Filter<T, A, 8> {
             reinterpret_cast<__m256i>(data.data), vindex));
   }
 #endif
+
+#if XSIMD_WITH_NEON64
+  static xsimd::batch<T, A>
+  apply(xsimd::batch<T, A> data, int mask, const xsimd::neon64&) {
+    if (mask != 2) {
+      // The selected lanes are already first.
+      return data;
+    }
+    auto lanes = reinterpret_cast<uint64x2_t>(data.data);
+    return reinterpret_cast<typename xsimd::batch<T, A>::register_type>(
+        vdupq_laneq_u64(lanes, 1));
+  }
+#endif
 };
 
 template <typename A>
@@ -1374,4 +1446,28 @@ inline bool memEqualUnsafe(const void* x, const void* y, int32_t size) {
   return true;
 }
 
+template <typename T, typename A>
+void setEqualBits(
+    const T* values,
+    int32_t size,
+    T value,
+    uint64_t* result,
+    const A&) {
+  using Batch = xsimd::batch<T, A>;
+  constexpr int32_t kBatch = Batch::size;
+  static_assert(64 % kBatch == 0, "A batch must not span two words");
+  const auto valueBatch = Batch::broadcast(value);
+  int32_t i = 0;
+  for (; i + kBatch <= size; i += kBatch) {
+    const uint64_t mask =
+        toBitMask(Batch::load_unaligned(values + i) == valueBatch);
+    result[i / 64] |= mask << (i % 64);
+  }
+  for (; i < size; ++i) {
+    if (values[i] == value) {
+      bits::setBit(result, i);
+    }
+  }
+}
+
 } // namespace facebook::velox::simd
@@ -16,6 +16,11 @@
 
 #include "velox/common/base/SimdUtil.h"
 #include <folly/Preprocessor.h>
+#include "velox/common/process/ProcessBase.h"
+
+#ifdef VELOX_SIMD_RUNTIME_AVX512
+#include <immintrin.h>
+#endif
 
 namespace facebook::velox::simd {
 
@@ -24,6 +29,47 @@ namespace detail {
 alignas(kPadding) int32_t byteSetBits[256][8];
 alignas(kPadding) int32_t permute4x64Indices[16][8];
 
+#ifdef VELOX_SIMD_RUNTIME_AVX512
+bool useAvx512() {
+  return process::hasAvx512();
+}
+
+__attribute__((target("avx512f"))) int32_t indicesOfSetBitsAvx512(
+    const uint64_t* bits,
+    int32_t begin,
+    int32_t end,
+    int32_t* indices) {
+  const auto lanes = _mm512_setr_epi32(
+      0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+  auto* start = indices;
+  const int32_t firstWord = begin / 64;
+  const int32_t endWord = bits::roundUp(end, 64) / 64;
+  for (auto wordIndex = firstWord; wordIndex < endWord; ++wordIndex) {
+    uint64_t word = bits[wordIndex];
+    if (wordIndex == firstWord && begin != firstWord * 64) {
+      word &= bits::highMask(64 - (begin - firstWord * 64));
+    }
+    if (wordIndex == endWord - 1 && end - wordIndex * 64 < 64) {
+      word &= bits::lowMask(end - wordIndex * 64);
+    }
+    // Compresses the row numbers of the set bits of each 16 bits of 'word'
+    // and stores as many lanes as there are set bits.
+    for (auto row = wordIndex * 64; word != 0; word >>= 16, row += 16) {
+      const __mmask16 mask = word;
+      if (mask == 0) {
+        continue;
+      }
+      const auto rows = _mm512_maskz_compress_epi32(
+          mask, _mm512_add_epi32(lanes, _mm512_set1_epi32(row)));
+      const auto numSet = __builtin_popcount(mask);
+      _mm512_mask_storeu_epi32(indices, bits::lowMask(numSet), rows);
+      indices += numSet;
+    }
+  }
+  return indices - start;
+}
+#endif
+
 } // namespace detail
 
 namespace {
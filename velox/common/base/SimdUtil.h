@@ -23,6 +23,13 @@
 #include <folly/Likely.h>
 #include <xsimd/xsimd.hpp>
 
+// Defined when the build does not target AVX-512 but can compile functions
+// for it. These are selected at runtime if the machine has AVX-512.
+#if defined(__x86_64__) && !defined(__AVX512F__) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define VELOX_SIMD_RUNTIME_AVX512 1
+#endif
+
 namespace facebook::velox::simd {
 
 // Return width of the widest store.
@@ -57,7 +64,24 @@ int32_t indicesOfSetBits(
 
 namespace detail {
 extern int32_t byteSetBits[256][8];
-}
+
+#ifdef VELOX_SIMD_RUNTIME_AVX512
+// Ranges of at least this many bits go to indicesOfSetBitsAvx512() if
+// useAvx512() is true.
+constexpr int32_t kMinAvx512IndicesBits = 512;
+
+// True if the machine has AVX-512 and it is not disabled by flag.
+bool useAvx512();
+
+// indicesOfSetBits() with AVX-512 compress. Must only be called if
+// useAvx512() is true.
+int32_t indicesOfSetBitsAvx512(
+    const uint64_t* bits,
+    int32_t begin,
+    int32_t end,
+    int32_t* indices);
+#endif
+} // namespace detail
 
 // Offsets of set bits in a byte. For example, for byte 42 it returns
 // {1, 3, 5, 3, 4, 5, 6, 7}, because 42 has bits 1, 3 and 5 set. The
@@ -430,6 +454,17 @@ xsimd::batch<T, A> reinterpretBatch(xsimd::batch<U, A>, const A& = {});
 template <typename A = xsimd::default_arch>
 inline bool memEqualUnsafe(const void* x, const void* y, int32_t size);
 
+// Sets bit i of 'result' if 'values[i]' is equal to 'value', for i in [0,
+// 'size'). Leaves the other bits unchanged. T is an integer of up to 8 bytes
+// or a floating point type.
+template <typename T, typename A = xsimd::default_arch>
+void setEqualBits(
+    const T* values,
+    int32_t size,
+    T value,
+    uint64_t* result,
+    const A& = {});
+
 } // namespace facebook::velox::simd
 
 #include "velox/common/base/SimdUtil-inl.h"
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <folly/Likely.h>
+
+namespace facebook::velox {
+
+/// Outcome of an operation that reports a user error without throwing. An OK
+/// status is a null pointer, so returning one costs no more than returning a
+/// bool. Lets functions fail on bad input rows without the cost of unwinding,
+/// which dominates when many rows fail under TRY.
+class [[nodiscard]] Status {
+ public:
+  Status() = default;
+
+  static Status OK() {
+    return Status();
+  }
+
+  static Status UserError(std::string message) {
+    return Status(std::make_unique<std::string>(std::move(message)));
+  }
+
+  bool ok() const {
+    return LIKELY(message_ == nullptr);
+  }
+
+  /// Returns the message of a failed status.
+  const std::string& message() const {
+    return *message_;
+  }
+
+ private:
+  explicit Status(std::unique_ptr<std::string> message)
+      : message_(std::move(message)) {}
+
+  std::unique_ptr<std::string> message_;
+};
+
+} // namespace facebook::velox
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/common/base/RateLimiter.h"
+
+using namespace facebook::velox;
+
+TEST(RateLimiterTest, burst) {
+  RateLimiter limiter(1 << 20, 1 << 20);
+  // The initial burst is served without waiting.
+  EXPECT_EQ(limiter.acquire(1 << 20), 0);
+  EXPECT_EQ(limiter.totalWaitUs(), 0);
+}
+
+TEST(RateLimiterTest, throttle) {
+  constexpr uint64_t kRate = 1 << 20;
+  RateLimiter limiter(kRate, kRate / 4);
+  const auto start = std::chrono::steady_clock::now();
+  uint64_t waitUs{0};
+  for (int i = 0; i < 4; ++i) {
+    waitUs += limiter.acquire(kRate / 4);
+  }
+  const auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(
+                             std::chrono::steady_clock::now() - start)
+                             .count();
+  // The first quarter comes from the burst and the rest is throttled at
+  // 'kRate'.
+  EXPECT_GE(waitUs, 600'000);
+  EXPECT_GE(elapsedUs, 600'000);
+  EXPECT_EQ(limiter.totalWaitUs(), waitUs);
+}
+
+TEST(RateLimiterTest, invalidRate) {
+  EXPECT_THROW(RateLimiter(0, 1), VeloxRuntimeError);
+}
@@ -16,9 +16,13 @@
 
 #include "velox/common/base/SimdUtil.h"
 #include <folly/Random.h>
+#include <folly/ScopeGuard.h>
+#include <gflags/gflags.h>
 
 #include <gtest/gtest.h>
 
+DECLARE_bool(avx512);
+
 using namespace facebook::velox;
 
 namespace {
@@ -127,6 +131,16 @@ TEST_F(SimdUtilTest, bitIndices) {
   testIndices(999);
 }
 
+TEST_F(SimdUtilTest, bitIndicesWithoutAvx512) {
+  // Covers the kernel of the build target on machines with AVX-512.
+  FLAGS_avx512 = false;
+  SCOPE_EXIT {
+    FLAGS_avx512 = true;
+  };
+  testIndices(10);
+  testIndices(500);
+}
+
 TEST_F(SimdUtilTest, gather32) {
   int32_t indices8[8] = {7, 6, 5, 4, 3, 2, 1, 0};
   int32_t indices6[8] = {7, 6, 5, 4, 3, 2, 1 << 31, 1 << 31};
@@ -399,4 +413,29 @@ TEST_F(SimdUtilTest, memEqual) {
   EXPECT_FALSE(simd::memEqualUnsafe(&data.x[1], &data.y[1], 67));
 }
 
+template <typename T>
+void testSetEqualBits() {
+  constexpr int32_t kSize = 203;
+  std::vector<T> values(kSize);
+  for (auto i = 0; i < kSize; ++i) {
+    values[i] = i % 7;
+  }
+  std::vector<uint64_t> result(bits::nwords(kSize), 0);
+  // A set bit stays set.
+  bits::setBit(result.data(), 1);
+  simd::setEqualBits<T>(values.data(), kSize, 3, result.data());
+  for (auto i = 0; i < kSize; ++i) {
+    EXPECT_EQ(bits::isBitSet(result.data(), i), i == 1 || i % 7 == 3) << i;
+  }
+}
+
+TEST_F(SimdUtilTest, setEqualBits) {
+  testSetEqualBits<int8_t>();
+  testSetEqualBits<int16_t>();
+  testSetEqualBits<int32_t>();
+  testSetEqualBits<int64_t>();
+  testSetEqualBits<float>();
+  testSetEqualBits<double>();
+}
+
 } // namespace
@@ -15,6 +15,7 @@
  */
 
 #include "velox/common/base/StatsReporter.h"
+#include "velox/common/base/Counters.h"
 #include <folly/Singleton.h>
 #include <folly/init/Init.h>
 #include <gtest/gtest.h>
@@ -121,6 +122,27 @@ TEST_F(StatsReporterTest, trivialReporter) {
   EXPECT_EQ(100, reporter->counterMap["key4"]);
 };
 
+TEST_F(StatsReporterTest, veloxCounters) {
+  auto reporter = std::dynamic_pointer_cast<TestReporter>(
+      folly::Singleton<BaseStatsReporter>::try_get());
+  registerVeloxCounters();
+
+  const std::vector<int32_t> expected = {50, 90, 99, 100};
+  for (const auto& key :
+       {kCounterHiveFileHandleGenerateLatencyMs,
+        kCounterCacheLookupLatencyNs,
+        kCounterSsdCacheReadLatencyUs,
+        kCounterExchangePageFetchLatencyMs,
+        kCounterSpillWriteLatencyUs,
+        kCounterArbitrationWaitLatencyMs}) {
+    EXPECT_EQ(expected, reporter->histogramPercentilesMap[key.str()]) << key;
+  }
+  for (const auto& key :
+       {kCounterHiveFileHandleCacheHits, kCounterHiveFileHandleCacheMisses}) {
+    EXPECT_EQ(StatType::COUNT, reporter->statTypeMap[key.str()]) << key;
+  }
+}
+
 // Registering to folly Singleton with intended reporter type
 folly::Singleton<BaseStatsReporter> reporter([]() {
   return new TestReporter();
@@ -19,8 +19,17 @@
 #include "velox/common/caching/SsdCache.h"
 
 #include <folly/executors/QueuedImmediateExecutor.h>
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/caching/FileIds.h"
+#include "velox/common/time/Timer.h"
+
+DEFINE_bool(
+    velox_cache_admission_filter,
+    false,
+    "Admit new cache entries for rarely accessed keys on probation so that "
+    "they are evicted before entries with a higher access frequency");
 
 namespace facebook::velox::cache {
 
@@ -44,6 +53,7 @@ void AsyncDataCacheEntry::setExclusiveToShared() {
     // Enter the shard's mutex to make sure a promise is not being added during
     // the move.
     promise = std::move(promise_);
+    shard_->addGroupBytesLocked(this);
   }
   if (promise != nullptr) {
     promise->setValue(true);
@@ -56,9 +66,13 @@ void AsyncDataCacheEntry::setExclusiveToShared() {
     hook(*this);
   }
 
-  if ((ssdFile_ == nullptr) && (shard_->cache()->ssdCache() != nullptr)) {
+  // Decompressed blocks are not file contents and are not saved to SSD.
+  if ((ssdFile_ == nullptr) && (shard_->cache()->ssdCache() != nullptr) &&
+      !isDecompressedOffset(key_.offset)) {
     auto* ssdCache = shard_->cache()->ssdCache();
     assert(ssdCache); // for lint only.
+    retentionWeight_ =
+        ssdCache->groupStats().retentionWeight(groupId_, trackingId_);
     if (ssdCache->groupStats().shouldSaveToSsd(groupId_, trackingId_)) {
       ssdSaveable_ = true;
       shard_->cache()->possibleSsdSave(size_);
@@ -98,7 +112,12 @@ void AsyncDataCacheEntry::initialize(FileCacheKey key) {
   VELOX_CHECK(isExclusive());
   setSsdFile(nullptr, 0);
   key_ = std::move(key);
+  retentionWeight_ = 1;
+  groupId_ = 0;
   auto* cache = shard_->cache();
+  if (isDecompressedOffset(key_.offset)) {
+    cache->incrementDecompressedBytes(size_);
+  }
   ClockTimer t(shard_->allocClocks());
   if (size_ < AsyncDataCacheEntry::kTinyDataSize) {
     tinyData_.resize(size_);
@@ -154,8 +173,12 @@ CachePin CacheShard::findOrCreate(
     folly::SemiFuture<bool>* wait) {
   AsyncDataCacheEntry* entryToInit = nullptr;
   {
-    std::lock_guard<std::mutex> l(mutex_);
+    auto l = lockForLookup();
     ++eventCounter_;
+    int32_t frequency = 0;
+    if (admissionFilter_) {
+      frequency = frequencies_.increment(std::hash<RawFileCacheKey>()(key));
+    }
     auto it = entryMap_.find(key);
     if (it != entryMap_.end()) {
       auto* found = it->second;
@@ -176,6 +199,10 @@ CachePin CacheShard::findOrCreate(
         } else {
           ++numHit_;
           hitBytes_ += found->size();
+          if (found->isProbation_) {
+            ++numProbationHit_;
+            found->isProbation_ = false;
+          }
         }
         ++found->numPins_;
         CachePin pin;
@@ -192,6 +219,9 @@ CachePin CacheShard::findOrCreate(
           << " requested size " << size;
       // The old entry is superseded. Possible readers of the old entry still
       // retain a valid read pin.
+      if (isDecompressedOffset(found->key_.offset)) {
+        cache_->incrementDecompressedBytes(-found->size());
+      }
       found->key_.fileNum.clear();
     }
 
@@ -199,6 +229,12 @@ CachePin CacheShard::findOrCreate(
     // Initialize the members that must be set inside 'mutex_'.
     newEntry->numPins_ = AsyncDataCacheEntry::kExclusive;
     newEntry->promise_ = nullptr;
+    // A key seen for the first time in the window of 'frequencies_' is not
+    // known to be reused.
+    newEntry->isProbation_ = admissionFilter_ && frequency <= 1;
+    if (newEntry->isProbation_) {
+      ++numProbation_;
+    }
     entryToInit = newEntry.get();
     entryMap_[key] = newEntry.get();
     if (emptySlots_.empty()) {
@@ -209,6 +245,11 @@ CachePin CacheShard::findOrCreate(
       entries_[index] = std::move(newEntry);
     }
     ++numNew_;
+    if (admissionFilter_) {
+      // The sketch also counts keys that are no longer cached, so it is kept
+      // larger than the number of entries.
+      frequencies_.ensureCapacity(entries_.size() * 4);
+    }
     // Inside the shard mutex.
     VELOX_CHECK_EQ(entryToInit->size_, 0);
     entryToInit->size_ = size;
@@ -218,7 +259,7 @@ CachePin CacheShard::findOrCreate(
 }
 
 bool CacheShard::exists(RawFileCacheKey key) const {
-  std::lock_guard<std::mutex> l(mutex_);
+  auto l = lockForLookup();
   auto it = entryMap_.find(key);
   if (it != entryMap_.end()) {
     it->second->touch();
@@ -227,6 +268,56 @@ bool CacheShard::exists(RawFileCacheKey key) const {
   return false;
 }
 
+void CacheShard::setGroupReservation(uint64_t groupId, uint64_t bytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (bytes == 0) {
+    groups_.erase(groupId);
+    return;
+  }
+  groups_[groupId].reservation = bytes;
+}
+
+void CacheShard::addGroupBytesLocked(AsyncDataCacheEntry* entry) {
+  if (groups_.empty() || entry->groupCounted_) {
+    return;
+  }
+  auto it = groups_.find(entry->groupId_);
+  if (it != groups_.end()) {
+    it->second.bytes += entry->size_;
+    entry->groupCounted_ = true;
+  }
+}
+
+void CacheShard::removeGroupBytesLocked(AsyncDataCacheEntry* entry) {
+  if (!entry->groupCounted_) {
+    return;
+  }
+  entry->groupCounted_ = false;
+  auto it = groups_.find(entry->groupId_);
+  if (it != groups_.end()) {
+    it->second.bytes -= entry->size_;
+  }
+}
+
+bool CacheShard::isReservedLocked(const AsyncDataCacheEntry& entry) const {
+  if (!entry.groupCounted_) {
+    return false;
+  }
+  auto it = groups_.find(entry.groupId_);
+  return it != groups_.end() &&
+      it->second.bytes - entry.size_ <
+      static_cast<int64_t>(it->second.reservation);
+}
+
+std::unique_lock<std::mutex> CacheShard::lockForLookup() const {
+  std::unique_lock<std::mutex> l(mutex_, std::try_to_lock);
+  if (!l.owns_lock()) {
+    l.lock();
+    ++numLookupWaits_;
+  }
+  return l;
+}
+
 CachePin CacheShard::initEntry(
     RawFileCacheKey key,
     AsyncDataCacheEntry* entry) {
@@ -308,6 +399,7 @@ std::unique_ptr<folly::SharedPromise<bool>> CacheShard::removeEntry(
 }
 
 void CacheShard::removeEntryLocked(AsyncDataCacheEntry* entry) {
+  removeGroupBytesLocked(entry);
   if (!entry->key_.fileNum.hasValue()) {
     return;
   }
@@ -315,6 +407,9 @@ void CacheShard::removeEntryLocked(AsyncDataCacheEntry* entry) {
       RawFileCacheKey{entry->key_.fileNum.id(), entry->key_.offset});
   VELOX_CHECK(it != entryMap_.end());
   entryMap_.erase(it);
+  if (isDecompressedOffset(entry->key_.offset)) {
+    cache_->incrementDecompressedBytes(-entry->size_);
+  }
   entry->key_.fileNum.clear();
   entry->setSsdFile(nullptr, 0);
   if (entry->isPrefetch()) {
@@ -378,7 +473,8 @@ void CacheShard::evict(
       int32_t score = 0;
       if (candidate->numPins_ == 0 &&
           (!candidate->key_.fileNum.hasValue() || evictAllUnpinned ||
-           (score = candidate->score(now)) >= evictionThreshold_)) {
+           ((score = candidate->score(now)) >= evictionThreshold_ &&
+            !isReservedLocked(*candidate)))) {
         if (skipSsdSaveable && candidate->ssdSaveable_ && !evictAllUnpinned) {
           ++evictSaveableSkipped;
           continue;
@@ -400,6 +496,9 @@ void CacheShard::evict(
         candidate->tinyData_.clear();
         candidate->tinyData_.shrink_to_fit();
         candidate->size_ = 0;
+        if (candidate->isProbation_) {
+          ++numProbationEvict_;
+        }
         tryAddFreeEntry(std::move(*iter));
         ++numEvict_;
         if (score) {
@@ -492,6 +591,13 @@ void CacheShard::updateStats(CacheStats& stats) {
   stats.numEvictChecks += numEvictChecks_;
   stats.numWaitExclusive += numWaitExclusive_;
   stats.sumEvictScore += sumEvictScore_;
+  stats.numProbation += numProbation_;
+  stats.numProbationHit += numProbationHit_;
+  stats.numProbationEvict += numProbationEvict_;
+  stats.numLookupWaits += numLookupWaits_;
+  for (const auto& [groupId, usage] : groups_) {
+    stats.groupBytes[groupId] += usage.bytes;
+  }
   stats.allocClocks += allocClocks_;
 }
 
@@ -570,7 +676,20 @@ CachePin AsyncDataCache::findOrCreate(
     uint64_t size,
     folly::SemiFuture<bool>* wait) {
   const int shard = std::hash<RawFileCacheKey>()(key) & (kShardMask);
-  return shards_[shard]->findOrCreate(key, size, wait);
+  // Lookups are too frequent to time and report each one.
+  thread_local int32_t numLookups = 0;
+  if (FOLLY_LIKELY(++numLookups < kCacheLookupLatencySampleInterval)) {
+    return shards_[shard]->findOrCreate(key, size, wait);
+  }
+  numLookups = 0;
+  uint64_t lookupTimeNs{0};
+  CachePin pin;
+  {
+    NanosecondTimer timer(&lookupTimeNs);
+    pin = shards_[shard]->findOrCreate(key, size, wait);
+  }
+  REPORT_ADD_HISTOGRAM_VALUE(kCounterCacheLookupLatencyNs, lookupTimeNs);
+  return pin;
 }
 
 bool AsyncDataCache::exists(RawFileCacheKey key) const {
@@ -742,6 +861,13 @@ CacheStats AsyncDataCache::refreshStats() const {
   return stats;
 }
 
+void AsyncDataCache::setGroupReservation(uint64_t groupId, uint64_t bytes) {
+  // Keys hash evenly to the shards.
+  for (auto& shard : shards_) {
+    shard->setGroupReservation(groupId, (bytes + kNumShards - 1) / kNumShards);
+  }
+}
+
 void AsyncDataCache::clear() {
   for (auto& shard : shards_) {
     memory::Allocation acquired;
@@ -786,9 +912,18 @@ std::string CacheStats::toString() const {
       // Cache prefetch stats.
       << "Prefetch entries: " << numPrefetch
       << " bytes: " << succinctBytes(prefetchBytes)
-      << "\n"
-      // Cache timing stats.
-      << "Alloc Megaclocks " << (allocClocks >> 20);
+      << "\n";
+  if (numProbation > 0) {
+    // Admission filter stats.
+    out << "Probation entries: " << numProbation
+        << " hit: " << numProbationHit << " eviction: " << numProbationEvict
+        << "\n";
+  }
+  if (numLookupWaits > 0) {
+    out << "Shard lookup waits: " << numLookupWaits << "\n";
+  }
+  // Cache timing stats.
+  out << "Alloc Megaclocks " << (allocClocks >> 20);
   return out.str();
 }
 
@@ -27,11 +27,16 @@
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SelectivityInfo.h"
 #include "velox/common/caching/FileGroupStats.h"
+#include "velox/common/caching/FrequencySketch.h"
 #include "velox/common/caching/ScanTracker.h"
 #include "velox/common/caching/StringIdMap.h"
 #include "velox/common/file/File.h"
 #include "velox/common/memory/MemoryAllocator.h"
 
+#include <gflags/gflags.h>
+
+DECLARE_bool(velox_cache_admission_filter);
+
 namespace facebook::velox::cache {
 
 #define VELOX_CACHE_LOG_PREFIX "[CACHE] "
@@ -110,6 +115,15 @@ struct RawFileCacheKey {
     return offset == other.offset && fileNum == other.fileNum;
   }
 };
+
+/// Set in the offset of a cache key to denote the decompressed contents of
+/// the compression block that starts at the rest of the offset, instead of
+/// the raw bytes of the file. See AsyncDataCache::setMaxDecompressedPct().
+constexpr uint64_t kDecompressedOffsetBit = 1ULL << 63;
+
+inline bool isDecompressedOffset(uint64_t offset) {
+  return (offset & kDecompressedOffsetBit) != 0;
+}
 } // namespace facebook::velox::cache
 
 namespace std {
@@ -188,8 +202,26 @@ class AsyncDataCacheEntry {
     accessStats_.touch();
   }
 
+  // Returns the retention score from the access stats. An entry on probation
+  // is evictable unless it was prefetched and not yet hit. The score is
+  // scaled by the retention weight of the entry's file group.
   int32_t score(AccessTime now) const {
-    return accessStats_.score(now, size_);
+    if (isProbation_ && !isPrefetch_) {
+      return std::numeric_limits<int32_t>::max();
+    }
+    const auto score = accessStats_.score(now, size_);
+    if (retentionWeight_ == 1) {
+      return score;
+    }
+    return std::min<int64_t>(
+        static_cast<int64_t>(score) * retentionWeight_,
+        std::numeric_limits<int32_t>::max());
+  }
+
+  // True if 'this' was admitted with a low access frequency and has not been
+  // hit since. See CacheShard.
+  bool isProbation() const {
+    return isProbation_;
   }
 
   bool isShared() const {
@@ -306,6 +338,17 @@ class AsyncDataCacheEntry {
   // Tracking id. Used for deciding if this should be written to SSD.
   TrackingId trackingId_;
 
+  // Set if the access frequency of the key was low when 'this' was created.
+  // Cleared on the first hit. Set and cleared inside the shard mutex.
+  bool isProbation_{false};
+
+  // Multiplier of score() from FileGroupStats::retentionWeight().
+  int32_t retentionWeight_{1};
+
+  // True if 'size_' is counted in the usage of a file group with a
+  // reservation. Set and cleared inside the shard mutex.
+  bool groupCounted_{false};
+
   // SSD file from which this was loaded or nullptr if not backed by
   // SsdFile. Used to avoid re-adding items that already come from
   // SSD. The exact file and offset are needed to include uses in RAM
@@ -509,6 +552,19 @@ struct CacheStats {
   // Sum of scores of evicted entries. This serves to infer an average
   // lifetime for entries in cache.
   int64_t sumEvictScore{0};
+  // Number of new entries admitted on probation by the admission filter, i.e.
+  // with a low recent access frequency of their key.
+  int64_t numProbation{0};
+  // Number of hits on entries on probation. Such entries are no longer on
+  // probation after the hit.
+  int64_t numProbationHit{0};
+  // Number of entries evicted while on probation.
+  int64_t numProbationEvict{0};
+  // Number of lookups that waited for the mutex of their shard.
+  int64_t numLookupWaits{0};
+  // Bytes cached for each file group with a reservation. See
+  // AsyncDataCache::setGroupReservation().
+  folly::F14FastMap<uint64_t, int64_t> groupBytes;
 
   std::shared_ptr<SsdCacheStats> ssdStats = nullptr;
 
@@ -566,6 +622,14 @@ class CacheShard {
   // Adds the stats of 'this' to 'stats'.
   void updateStats(CacheStats& stats);
 
+  // Sets the bytes of file group 'groupId' that eviction keeps in 'this'. 0
+  // removes the reservation.
+  void setGroupReservation(uint64_t groupId, uint64_t bytes);
+
+  // Counts the size of 'entry' in the usage of its file group if the group
+  // has a reservation. Called inside 'mutex_' when 'entry' becomes shared.
+  void addGroupBytesLocked(AsyncDataCacheEntry* entry);
+
   // Appends a batch of non-saved SSD saveable entries in 'this' to
   // 'pins'. This may have to be called several times since this keeps
   // limits on the batch to write at one time. The saveable entries
@@ -585,6 +649,12 @@ class CacheShard {
 
   void removeEntryLocked(AsyncDataCacheEntry* entry);
 
+  void removeGroupBytesLocked(AsyncDataCacheEntry* entry);
+
+  // Returns true if evicting 'entry' would take its file group below its
+  // reservation.
+  bool isReservedLocked(const AsyncDataCacheEntry& entry) const;
+
   // Returns an unused entry if found.
   //
   // TODO: consider to pass a size hint so as to select the a free entry which
@@ -595,6 +665,9 @@ class CacheShard {
 
   void freeAllocations(std::vector<memory::Allocation>& allocations);
 
+  // Locks 'mutex_' for a lookup. Counts the lookups that have to wait.
+  std::unique_lock<std::mutex> lockForLookup() const;
+
   void tryAddFreeEntry(std::unique_ptr<AsyncDataCacheEntry>&& entry);
 
   AsyncDataCache* const cache_;
@@ -631,6 +704,29 @@ class CacheShard {
   // Sum of evict scores. This divided by 'numEvict_' correlates to
   // time data stays in cache.
   uint64_t sumEvictScore_{0};
+
+  // If true, new entries for keys with a low access frequency in
+  // 'frequencies_' are admitted on probation. These are evicted first, so that
+  // a scan of data that is not reused does not evict data that is.
+  const bool admissionFilter_{FLAGS_velox_cache_admission_filter};
+  // Access frequencies of keys looked up in 'this', including keys that are
+  // not or no longer cached.
+  FrequencySketch frequencies_;
+  // Count of entries admitted on probation.
+  uint64_t numProbation_{0};
+  // Count of hits on entries on probation.
+  uint64_t numProbationHit_{0};
+  // Count of entries evicted on probation.
+  uint64_t numProbationEvict_{0};
+  // Count of lookups that found 'mutex_' held by another thread.
+  mutable uint64_t numLookupWaits_{0};
+
+  struct GroupUsage {
+    uint64_t reservation{0};
+    int64_t bytes{0};
+  };
+  // Reservation and cached bytes of the file groups with a reservation.
+  folly::F14FastMap<uint64_t, GroupUsage> groups_;
   // Tracker of time spent in allocating/freeing MemoryAllocator space
   // for backing cached data.
   std::atomic<uint64_t> allocClocks_{0};
@@ -729,6 +825,40 @@ class AsyncDataCache : public memory::Cache {
     return verifyHook_;
   }
 
+  /// Sets the percentage of the cache capacity that may be taken by
+  /// decompressed blocks of compressed file streams. Hot compressed data is
+  /// then decompressed once instead of on every scan. 0, the default,
+  /// disables caching of decompressed blocks.
+  void setMaxDecompressedPct(int32_t pct) {
+    VELOX_CHECK_GE(pct, 0);
+    VELOX_CHECK_LE(pct, 100);
+    maxDecompressedPct_ = pct;
+  }
+
+  /// Keeps at least 'bytes' of the entries of file group 'groupId' in memory
+  /// when evicting, so that a group keeps its working set while other groups
+  /// scan large data. Emergency eviction to free memory for allocations
+  /// ignores the reservation. Entries loaded before the call are not counted.
+  /// 0 removes the reservation. See CacheStats::groupBytes for the usage.
+  void setGroupReservation(uint64_t groupId, uint64_t bytes);
+
+  /// Returns true if a decompressed block of 'bytes' fits in the share of
+  /// the capacity set by setMaxDecompressedPct().
+  bool canCacheDecompressed(uint64_t bytes) const {
+    return maxDecompressedPct_ > 0 &&
+        decompressedBytes_ + bytes <=
+        allocator_->capacity() / 100 * maxDecompressedPct_;
+  }
+
+  /// Returns the bytes in entries with a decompressed offset.
+  int64_t decompressedBytes() const {
+    return decompressedBytes_;
+  }
+
+  void incrementDecompressedBytes(int64_t bytes) {
+    decompressedBytes_ += bytes;
+  }
+
   // Looks up a pin for each in 'keys' and skips all loading or
   // loaded pins. Calls processPin for each exclusive
   // pin. processPin must move its argument if it wants to use it
@@ -759,7 +889,9 @@ class AsyncDataCache : public memory::Cache {
   }
 
  private:
-  static constexpr int32_t kNumShards = 4; // Must be power of 2.
+  // Spreads concurrent lookups over enough mutexes to scale with the threads
+  // of a scan.
+  static constexpr int32_t kNumShards = 16; // Must be power of 2.
   static constexpr int32_t kShardMask = kNumShards - 1;
 
   // True if 'acquired' has more pages than 'numPages' or allocator has space
@@ -794,6 +926,12 @@ class AsyncDataCache : public memory::Cache {
   CacheStats stats_;
 
   std::function<void(const AsyncDataCacheEntry&)> verifyHook_;
+
+  // Percentage of the capacity that may hold decompressed blocks.
+  tsan_atomic<int32_t> maxDecompressedPct_{0};
+
+  // Bytes in entries for decompressed blocks. See isDecompressedOffset().
+  std::atomic<int64_t> decompressedBytes_{0};
   // Count of skipped saves to 'ssdCache_' due to 'ssdCache_' being
   // busy with write.
   tsan_atomic<int32_t> numSkippedSaves_{0};
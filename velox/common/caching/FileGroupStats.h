@@ -48,6 +48,14 @@ class FileGroupStats {
     return true;
   }
 
+  // Returns a multiplier for the memory cache eviction score of data of
+  // 'groupId' and 'trackingId'. Data of groups with little expected reuse gets
+  // a higher weight so that it is evicted before data of often reused groups.
+  int32_t retentionWeight(uint64_t /*groupId*/, TrackingId /*trackingId*/)
+      const {
+    return 1;
+  }
+
   // Updates the SSD selection criteria. 'ssdsize' is the capacity,
   // 'decayPct' gives by how much old accesses are discounted.
   void updateSsdFilter(uint64_t /*ssdSize*/, int32_t /*decayPct*/ = 0) {}
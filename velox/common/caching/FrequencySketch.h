@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace facebook::velox::cache {
+
+// Approximate access counts of cache keys in a recent window, kept in a
+// count-min sketch of 4 bit counters. All counters are halved when the number
+// of increments reaches 10x the width, so that the counts reflect recent
+// accesses. Used for TinyLFU style admission in CacheShard. Not thread safe,
+// synchronization is the caller's responsibility.
+class FrequencySketch {
+ public:
+  static constexpr int32_t kMaxCount = 15;
+
+  explicit FrequencySketch(int32_t width = kMinWidth) {
+    resize(width);
+  }
+
+  // Grows the sketch to keep accuracy when tracking 'numKeys' distinct keys.
+  // Growing resets the counts.
+  void ensureCapacity(uint64_t numKeys) {
+    if (numKeys > width_) {
+      resize(numKeys);
+    }
+  }
+
+  // Counts an access to the key with 'hash' and returns the estimated number
+  // of accesses including this one.
+  int32_t increment(uint64_t hash);
+
+  // Returns the estimated number of accesses of the key with 'hash'.
+  int32_t estimate(uint64_t hash) const;
+
+  uint64_t width() const {
+    return width_;
+  }
+
+ private:
+  static constexpr int32_t kMinWidth = 1024;
+  static constexpr int32_t kDepth = 4;
+
+  void resize(uint64_t width);
+
+  // Returns the index in 'counters_' of the counter for 'hash' in 'row'.
+  uint64_t index(uint64_t hash, int32_t row) const;
+
+  // Halves all counts.
+  void age();
+
+  // Number of counters in each row. A power of 2.
+  uint64_t width_{0};
+
+  // kDepth rows of 'width_' counters.
+  std::vector<uint8_t> counters_;
+
+  // Increments since the last age().
+  uint64_t numIncrements_{0};
+
+  // Number of increments between age() calls.
+  uint64_t sampleSize_{0};
+};
+
+} // namespace facebook::velox::cache
@@ -168,6 +168,12 @@ class ScanTracker {
     return data_[id];
   }
 
+  // Returns the sum of the references and reads of all streams.
+  TrackingData totalTrackingData() {
+    std::lock_guard<std::mutex> l(mutex_);
+    return sum_;
+  }
+
   std::string_view id() const {
     return id_;
   }
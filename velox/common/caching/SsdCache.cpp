@@ -31,7 +31,8 @@ SsdCache::SsdCache(
     int32_t numShards,
     folly::Executor* executor,
     int64_t checkpointIntervalBytes,
-    bool disableFileCow)
+    bool disableFileCow,
+    bool checksumEnabled)
     : filePrefix_(filePrefix),
       numShards_(numShards),
       groupStats_(std::make_unique<FileGroupStats>()),
@@ -56,7 +57,9 @@ SsdCache::SsdCache(
         i,
         fileMaxRegions,
         checkpointIntervalBytes / numShards,
-        disableFileCow));
+        disableFileCow,
+        nullptr,
+        checksumEnabled));
   }
 }
 
@@ -150,6 +153,10 @@ std::string SsdCache::toString() const {
   out << "Ssd cache IO: Write " << (data.bytesWritten >> 20) << "MB read "
       << (data.bytesRead >> 20) << "MB Size " << (capacity >> 30)
       << "GB Occupied " << (data.bytesCached >> 30) << "GB";
+  if (data.entriesRecovered > 0) {
+    out << " Recovered from checkpoint " << (data.bytesRecovered >> 20)
+        << "MB ";
+  }
   out << (data.entriesCached >> 10) << "K entries.";
   out << "\nGroupStats: " << groupStats_->toString(capacity);
   return out.str();
@@ -16,11 +16,16 @@
 
 #include "velox/common/caching/SsdFile.h"
 #include <folly/Executor.h>
+#include <folly/hash/Checksum.h>
 #include <folly/portability/SysUio.h>
 #include "velox/common/base/AsyncSource.h"
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/caching/FileIds.h"
 #include "velox/common/caching/SsdCache.h"
+#include "velox/common/file/IoUringReadFile.h"
+#include "velox/common/time/Timer.h"
 
 #include <fcntl.h>
 #ifdef linux
@@ -79,6 +84,24 @@ void addEntryToIovecs(AsyncDataCacheEntry& entry, std::vector<iovec>& iovecs) {
     };
   }
 }
+
+// Returns the CRC32C of the data of 'entry'.
+uint32_t checksumEntry(const AsyncDataCacheEntry& entry) {
+  if (entry.tinyData() != nullptr) {
+    return folly::crc32c(
+        reinterpret_cast<const uint8_t*>(entry.tinyData()), entry.size());
+  }
+  const auto& data = entry.data();
+  uint32_t checksum = ~0U;
+  int64_t bytesLeft = entry.size();
+  for (auto i = 0; i < data.numRuns() && bytesLeft > 0; ++i) {
+    auto run = data.runAt(i);
+    const auto bytes = std::min<int64_t>(bytesLeft, run.numBytes());
+    checksum = folly::crc32c(run.data<uint8_t>(), bytes, checksum);
+    bytesLeft -= bytes;
+  }
+  return checksum;
+}
 } // namespace
 
 SsdPin::SsdPin(SsdFile& file, SsdRun run) : file_(&file), run_(run) {
@@ -122,12 +145,14 @@ SsdFile::SsdFile(
     int32_t maxRegions,
     int64_t checkpointIntervalBytes,
     bool disableFileCow,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    bool checksumEnabled)
     : fileName_(filename),
       maxRegions_(maxRegions),
       shardId_(shardId),
       checkpointIntervalBytes_(checkpointIntervalBytes),
-      executor_(executor) {
+      executor_(executor),
+      checksumEnabled_(checksumEnabled) {
   int32_t oDirect = 0;
 #ifdef linux
   oDirect = FLAGS_ssd_odirect ? O_DIRECT : 0;
@@ -148,7 +173,11 @@ SsdFile::SsdFile(
     disableCow(fd_);
   }
 
+#ifdef VELOX_ENABLE_IO_URING
+  readFile_ = std::make_unique<IoUringReadFile>(fd_);
+#else
   readFile_ = std::make_unique<LocalReadFile>(fd_);
+#endif
   uint64_t size = lseek(fd_, 0, SEEK_END);
   numRegions_ = size / kRegionSize;
   if (numRegions_ > maxRegions_) {
@@ -209,6 +238,7 @@ bool SsdFile::erase(RawFileCacheKey key) {
   if (it == entries_.end()) {
     return false;
   }
+  unverifiedOffsets_.erase(it->second.offset());
   entries_.erase(it);
   return true;
 }
@@ -239,7 +269,11 @@ CoalesceIoStats SsdFile::load(
 
   // Do coalesced IO for the pins. For short payloads, the break-even between
   // discrete pread calls and a single preadv that discards gaps is ~25K per
-  // gap. For longer payloads this is ~50-100K.
+  // gap. For longer payloads this is ~50-100K. If the file reads
+  // asynchronously, all the coalesced reads are issued before waiting for any
+  // of them.
+  const bool async = readFile_->hasPreadvAsync();
+  std::vector<folly::SemiFuture<uint64_t>> reads;
   auto stats = readPins(
       pins,
       payloadTotal / pins.size() < 10000 ? 25000 : 50000,
@@ -253,8 +287,24 @@ CoalesceIoStats SsdFile::load(
           int32_t /*end*/,
           uint64_t offset,
           const std::vector<folly::Range<char*>>& buffers) {
-        read(offset, buffers);
+        if (async) {
+          reads.push_back(readFile_->preadvAsync(offset, buffers));
+        } else {
+          read(offset, buffers);
+        }
       });
+  if (!reads.empty()) {
+    auto results = folly::collectAll(std::move(reads)).get();
+    for (auto& result : results) {
+      if (result.hasException()) {
+        ++stats_.readSsdErrors;
+        result.exception().throw_exception();
+      }
+    }
+  }
+  if (checksumEnabled_) {
+    verifyRecoveredEntries(ssdPins, pins);
+  }
 
   for (auto i = 0; i < ssdPins.size(); ++i) {
     pins[i].checkedEntry()->setSsdFile(this, ssdPins[i].run().offset());
@@ -262,10 +312,64 @@ CoalesceIoStats SsdFile::load(
   return stats;
 }
 
+void SsdFile::verifyRecoveredEntries(
+    const std::vector<SsdPin>& ssdPins,
+    const std::vector<CachePin>& pins) {
+  std::vector<int32_t> toVerify;
+  {
+    std::shared_lock<std::shared_mutex> l(mutex_);
+    if (unverifiedOffsets_.empty()) {
+      return;
+    }
+    for (auto i = 0; i < ssdPins.size(); ++i) {
+      // The checksum is of the whole run, so only a read of the whole run can
+      // be checked.
+      const auto run = ssdPins[i].run();
+      if (pins[i].checkedEntry()->size() == run.size() &&
+          unverifiedOffsets_.count(run.offset()) != 0) {
+        toVerify.push_back(i);
+      }
+    }
+  }
+  if (toVerify.empty()) {
+    return;
+  }
+
+  std::vector<int32_t> corrupt;
+  for (auto i : toVerify) {
+    if (checksumEntry(*pins[i].checkedEntry()) != ssdPins[i].run().checksum()) {
+      corrupt.push_back(i);
+    }
+  }
+
+  std::lock_guard<std::shared_mutex> l(mutex_);
+  for (auto i : toVerify) {
+    unverifiedOffsets_.erase(ssdPins[i].run().offset());
+  }
+  if (corrupt.empty()) {
+    return;
+  }
+  for (auto i : corrupt) {
+    const auto* entry = pins[i].checkedEntry();
+    entries_.erase(FileCacheKey{
+        entry->key().fileNum, static_cast<uint64_t>(entry->offset())});
+  }
+  stats_.readSsdCorruptions += corrupt.size();
+  VELOX_FAIL(
+      "IOERR: Checksum mismatch for {} SSD cache entries recovered from checkpoint, first {}",
+      corrupt.size(),
+      ssdPins[corrupt[0]].toString());
+}
+
 void SsdFile::read(
     uint64_t offset,
     const std::vector<folly::Range<char*>>& buffers) {
-  readFile_->preadv(offset, buffers);
+  uint64_t readTimeUs{0};
+  {
+    MicrosecondTimer timer(&readTimeUs);
+    readFile_->preadv(offset, buffers);
+  }
+  REPORT_ADD_HISTOGRAM_VALUE(kCounterSsdCacheReadLatencyUs, readTimeUs);
 }
 
 std::optional<std::pair<uint64_t, int32_t>> SsdFile::getSpace(
@@ -343,6 +447,7 @@ void SsdFile::clearRegionEntriesLocked(const std::vector<int32_t>& regions) {
   while (it != entries_.end()) {
     const auto region = regionIndex(it->second.offset());
     if (regionSet.count(region) != 0) {
+      unverifiedOffsets_.erase(it->second.offset());
       it = entries_.erase(it);
     } else {
       ++it;
@@ -379,6 +484,7 @@ void SsdFile::write(std::vector<CachePin>& pins) {
     int32_t numWritten = 0;
     int32_t bytes = 0;
     std::vector<iovec> iovecs;
+    std::vector<uint32_t> checksums;
     for (auto i = storeIndex; i < pins.size(); ++i) {
       auto* entry = pins[i].checkedEntry();
       const auto entrySize = entry->size();
@@ -386,6 +492,9 @@ void SsdFile::write(std::vector<CachePin>& pins) {
         break;
       }
       addEntryToIovecs(*entry, iovecs);
+      if (checksumEnabled_) {
+        checksums.push_back(checksumEntry(*entry));
+      }
       bytes += entrySize;
       ++numWritten;
     }
@@ -412,7 +521,8 @@ void SsdFile::write(std::vector<CachePin>& pins) {
         const auto size = entry->size();
         FileCacheKey key = {
             entry->key().fileNum, static_cast<uint64_t>(entry->offset())};
-        entries_[std::move(key)] = SsdRun(offset, size);
+        entries_[std::move(key)] = SsdRun(
+            offset, size, checksumEnabled_ ? checksums[i - storeIndex] : 0);
         if (FLAGS_ssd_verify_write) {
           verifyWrite(*entry, SsdRun(offset, size));
         }
@@ -496,11 +606,15 @@ void SsdFile::updateStats(SsdCacheStats& stats) const {
   stats.writeCheckpointErrors += stats_.writeCheckpointErrors;
   stats.readSsdErrors += stats_.readSsdErrors;
   stats.readCheckpointErrors += stats_.readCheckpointErrors;
+  stats.readSsdCorruptions += stats_.readSsdCorruptions;
+  stats.entriesRecovered += stats_.entriesRecovered;
+  stats.bytesRecovered += stats_.bytesRecovered;
 }
 
 void SsdFile::clear() {
   std::lock_guard<std::shared_mutex> l(mutex_);
   entries_.clear();
+  unverifiedOffsets_.clear();
   std::fill(regionSizes_.begin(), regionSizes_.end(), 0);
   writableRegions_.resize(numRegions_);
   std::iota(writableRegions_.begin(), writableRegions_.end(), 0);
@@ -615,7 +729,7 @@ void SsdFile::checkpoint(bool force) {
     // regionScores from the 'tracker_',
     // {fileId, fileName} pairs,
     // kMapMarker,
-    // {fileId, offset, SSdRun} triples,
+    // {fileId, offset, SSdRun, checksum} quadruples,
     // kEndMarker.
     state.write(kCheckpointMagic, sizeof(int32_t));
     state.write(asChar(&maxRegions_), sizeof(maxRegions_));
@@ -644,6 +758,8 @@ void SsdFile::checkpoint(bool force) {
       state.write(asChar(&pair.first.offset), sizeof(pair.first.offset));
       auto offsetAndSize = pair.second.bits();
       state.write(asChar(&offsetAndSize), sizeof(offsetAndSize));
+      auto checksum = pair.second.checksum();
+      state.write(asChar(&checksum), sizeof(checksum));
     }
 
     // NOTE: we need to ensure cache file data sync update completes before
@@ -718,6 +834,10 @@ void SsdFile::initializeCheckpoint() {
       VELOX_SSD_CACHE_LOG(ERROR) << "Error recovering from checkpoint "
                                  << e.what() << ": Starting without checkpoint";
       entries_.clear();
+      unverifiedOffsets_.clear();
+      std::fill(regionSizes_.begin(), regionSizes_.end(), 0);
+      stats_.entriesRecovered = 0;
+      stats_.bytesRecovered = 0;
       deleteCheckpoint(true);
     } catch (const std::exception& e) {
     }
@@ -753,7 +873,8 @@ T readNumber(std::ifstream& stream) {
 void SsdFile::readCheckpoint(std::ifstream& state) {
   char magic[4];
   state.read(magic, sizeof(magic));
-  VELOX_CHECK_EQ(strncmp(magic, kCheckpointMagic, 4), 0);
+  const bool hasChecksums = strncmp(magic, kCheckpointMagic, 4) == 0;
+  VELOX_CHECK(hasChecksums || strncmp(magic, kCheckpointMagicV1, 4) == 0);
   const auto maxRegions = readNumber<int32_t>(state);
   VELOX_CHECK_EQ(
       maxRegions,
@@ -771,7 +892,9 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
     std::string name;
     name.resize(readNumber<int32_t>(state));
     state.read(name.data(), name.size());
-    auto lease = StringIdLease(fileIds(), name);
+    // Keeps the id of the previous process if possible since the shard is
+    // chosen by the id.
+    auto lease = StringIdLease(fileIds(), id, name);
     idMap[id] = std::move(lease);
   }
 
@@ -783,21 +906,37 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
   for (auto region : evicted) {
     evictedMap.insert(region);
   }
+  int32_t numDropped = 0;
   for (;;) {
     const uint64_t fileNum = readNumber<uint64_t>(state);
     if (fileNum == kCheckpointEndMarker) {
       break;
     }
     const uint64_t offset = readNumber<uint64_t>(state);
-    const auto run = SsdRun(readNumber<uint64_t>(state));
+    const auto bits = readNumber<uint64_t>(state);
+    const auto checksum = hasChecksums ? readNumber<uint32_t>(state) : 0;
+    const auto run = SsdRun(bits, checksum);
     // Check that the recovered entry does not fall in an evicted region.
-    if (evictedMap.find(regionIndex(run.offset())) == evictedMap.end()) {
-      // The file may have a different id on restore.
-      auto it = idMap.find(fileNum);
-      VELOX_CHECK(it != idMap.end());
-      FileCacheKey key{it->second, offset};
-      entries_[std::move(key)] = run;
+    if (evictedMap.find(regionIndex(run.offset())) != evictedMap.end()) {
+      continue;
+    }
+    auto it = idMap.find(fileNum);
+    VELOX_CHECK(it != idMap.end());
+    // The file got a different id on restore if the name was already known.
+    // The entries of the file could then be in a different shard than the one
+    // that would look them up, so they are dropped.
+    if (it->second.id() != fileNum) {
+      ++numDropped;
+      continue;
     }
+    FileCacheKey key{it->second, offset};
+    entries_[std::move(key)] = run;
+    if (run.checksum() != 0) {
+      unverifiedOffsets_.insert(run.offset());
+    }
+    const auto region = regionIndex(run.offset());
+    regionSizes_[region] = std::max<uint64_t>(
+        regionSizes_[region], run.offset() + run.size() - region * kRegionSize);
   }
   // The state is successfully read. Install the access frequency scores and
   // evicted regions.
@@ -808,12 +947,20 @@ void SsdFile::readCheckpoint(std::ifstream& state) {
     writableRegions_.push_back(region);
   }
   tracker_.setRegionScores(scores);
+  stats_.entriesRecovered = entries_.size();
+  uint64_t bytesRecovered = 0;
+  for (const auto& [key, run] : entries_) {
+    bytesRecovered += run.size();
+  }
+  stats_.bytesRecovered = bytesRecovered;
   VELOX_SSD_CACHE_LOG(INFO) << fmt::format(
-      "Starting shard {} from checkpoint with {} entries, {} regions with {} free.",
+      "Starting shard {} from checkpoint with {} entries of {}, {} regions with {} free, {} entries dropped.",
       shardId_,
       entries_.size(),
+      succinctBytes(bytesRecovered),
       numRegions_,
-      writableRegions_.size());
+      writableRegions_.size(),
+      numDropped);
 }
 
 } // namespace facebook::velox::cache
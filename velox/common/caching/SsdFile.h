@@ -20,6 +20,7 @@
 #include "velox/common/caching/SsdFileTracker.h"
 #include "velox/common/file/File.h"
 
+#include <folly/container/F14Set.h>
 #include <gflags/gflags.h>
 
 DECLARE_bool(ssd_odirect);
@@ -42,16 +43,24 @@ class SsdRun {
     VELOX_CHECK_LT(size - 1, 1 << kSizeBits);
   }
 
-  SsdRun(uint64_t bits) : bits_(bits) {}
+  SsdRun(uint64_t offset, uint32_t size, uint32_t checksum)
+      : SsdRun(offset, size) {
+    checksum_ = checksum;
+  }
+
+  SsdRun(uint64_t bits, uint32_t checksum = 0)
+      : bits_(bits), checksum_(checksum) {}
 
   SsdRun(const SsdRun& other) = default;
   SsdRun(SsdRun&& other) = default;
 
   void operator=(const SsdRun& other) {
     bits_ = other.bits_;
+    checksum_ = other.checksum_;
   }
   void operator=(SsdRun&& other) {
     bits_ = other.bits_;
+    checksum_ = other.checksum_;
   }
 
   uint64_t offset() const {
@@ -67,8 +76,14 @@ class SsdRun {
     return bits_;
   }
 
+  // Returns the CRC32C of the data or 0 if no checksum was computed.
+  uint32_t checksum() const {
+    return checksum_;
+  }
+
  private:
   uint64_t bits_;
+  uint32_t checksum_{0};
 };
 
 // Represents an SsdFile entry that is planned for load or being
@@ -144,6 +159,9 @@ struct SsdCacheStats {
     writeCheckpointErrors = tsanAtomicValue(other.writeCheckpointErrors);
     readSsdErrors = tsanAtomicValue(other.readSsdErrors);
     readCheckpointErrors = tsanAtomicValue(other.readCheckpointErrors);
+    readSsdCorruptions = tsanAtomicValue(other.readSsdCorruptions);
+    entriesRecovered = tsanAtomicValue(other.entriesRecovered);
+    bytesRecovered = tsanAtomicValue(other.bytesRecovered);
   }
 
   tsan_atomic<uint64_t> entriesWritten{0};
@@ -163,6 +181,13 @@ struct SsdCacheStats {
   tsan_atomic<uint32_t> writeCheckpointErrors{0};
   tsan_atomic<uint32_t> readSsdErrors{0};
   tsan_atomic<uint32_t> readCheckpointErrors{0};
+  // Count of entries whose checksum did not match on the first read after
+  // recovery from checkpoint.
+  tsan_atomic<uint32_t> readSsdCorruptions{0};
+
+  // Entries and bytes restored from checkpoint at startup.
+  tsan_atomic<uint64_t> entriesRecovered{0};
+  tsan_atomic<uint64_t> bytesRecovered{0};
 };
 
 // A shard of SsdCache. Corresponds to one file on SSD.  The data
@@ -178,14 +203,18 @@ class SsdFile {
   static constexpr uint64_t kRegionSize = 1 << 26; // 64MB
 
   // Constructs a cache backed by filename. Discards any previous
-  // contents of filename.
+  // contents of filename unless 'checkpointInternalBytes' is non-0 and there
+  // is a valid checkpoint. If 'checksumEnabled' is true, a checksum is kept for
+  // each entry and the entries recovered from a checkpoint are verified on
+  // their first read.
   SsdFile(
       const std::string& filename,
       int32_t shardId,
       int32_t maxRegions,
       int64_t checkpointInternalBytes = 0,
       bool disableFileCow = false,
-      folly::Executor* executor = nullptr);
+      folly::Executor* executor = nullptr,
+      bool checksumEnabled = false);
 
   // Adds entries of  'pins'  to this file. 'pins' must be in read mode and
   // those pins that are successfully added to SSD are marked as being on SSD.
@@ -256,8 +285,10 @@ class SsdFile {
 
  private:
   // 4 first bytes of a checkpoint file. Allows distinguishing between format
-  // versions.
-  static constexpr const char* kCheckpointMagic = "CPT1";
+  // versions. Version 2 adds a checksum to each entry. Version 1 checkpoints
+  // are still recovered from, with no checksums.
+  static constexpr const char* kCheckpointMagic = "CPT2";
+  static constexpr const char* kCheckpointMagicV1 = "CPT1";
   // Magic number separating file names from cache entry data in checkpoint
   // file.
   static constexpr int64_t kCheckpointMapMarker = 0xfffffffffffffffe;
@@ -286,7 +317,15 @@ class SsdFile {
   // added to 'writableRegions_'. Returns true if regions could be cleared.
   bool growOrEvictLocked();
 
-  // Reads the backing file with ReadFile::preadv().
+  // Verifies the checksums of the entries in 'pins' that were recovered from
+  // checkpoint and not yet read. Erases the entries that do not match and
+  // throws.
+  void verifyRecoveredEntries(
+      const std::vector<SsdPin>& ssdPins,
+      const std::vector<CachePin>& pins);
+
+  // Reads the backing file with ReadFile::preadv(). load() uses
+  // ReadFile::preadvAsync() instead if the backing file supports it.
   void read(uint64_t offset, const std::vector<folly::Range<char*>>& buffers);
 
   // Verifies that 'entry' has the data at 'run'.
@@ -384,6 +423,13 @@ class SsdFile {
 
   // True if there was an error with checkpoint and the checkpoint was deleted.
   bool checkpointDeleted_{false};
+
+  // True if checksums are computed on write and verified for recovered entries.
+  const bool checksumEnabled_;
+
+  // Offsets of the entries recovered from checkpoint with a checksum that have
+  // not been verified by a read.
+  folly::F14FastSet<uint64_t> unverifiedOffsets_;
 };
 
 } // namespace facebook::velox::cache
@@ -84,4 +84,24 @@ uint64_t StringIdMap::makeId(std::string_view string) {
   return lastId_;
 }
 
+uint64_t StringIdMap::recoverId(uint64_t id, std::string_view string) {
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (id != kNoId && stringToId_.find(string) == stringToId_.end() &&
+        idToString_.find(id) == idToString_.end()) {
+      Entry entry;
+      entry.string = std::string(string);
+      entry.id = id;
+      entry.numInUse = 1;
+      pinnedSize_ += entry.string.size();
+      auto& entryInTable = idToString_[id] = std::move(entry);
+      stringToId_[entryInTable.string] = id;
+      // New ids are assigned after the recovered ones.
+      lastId_ = std::max(lastId_, id);
+      return id;
+    }
+  }
+  return makeId(string);
+}
+
 } // namespace facebook::velox
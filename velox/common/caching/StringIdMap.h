@@ -48,6 +48,11 @@ class StringIdMap {
   // new id if none exists. must be released with release() when no longer used.
   uint64_t makeId(std::string_view string);
 
+  // Returns the id for 'string' and increments its use count like makeId().
+  // If 'string' has no id and 'id' is not in use, the new mapping gets 'id'.
+  // Used for recovering the ids of a previous process from a checkpoint.
+  uint64_t recoverId(uint64_t id, std::string_view string);
+
   // Decrements the use count of id and may free the associated memory if no
   // uses remain.
   void release(uint64_t id);
@@ -86,6 +91,11 @@ class StringIdLease {
   StringIdLease(StringIdMap& ids, std::string_view string)
       : ids_(&ids), id_(ids_->makeId(string)) {}
 
+  // Makes a lease for 'string', preferring 'id' if 'string' has no id. See
+  // StringIdMap::recoverId().
+  StringIdLease(StringIdMap& ids, uint64_t id, std::string_view string)
+      : ids_(&ids), id_(ids_->recoverId(id, string)) {}
+
   // Makes a new lease for an id that already references a string.
   StringIdLease(StringIdMap& ids, uint64_t id) : ids_(&ids), id_(id) {
     ids_->addReference(id_);
@@ -685,6 +685,98 @@ TEST_F(AsyncDataCacheTest, outOfCapacity) {
   clearAllocations(allocations);
 }
 
+TEST_F(AsyncDataCacheTest, admissionFilter) {
+  constexpr int64_t kMaxBytes = 64 << 20;
+  constexpr int32_t kSize = 64 << 10;
+  constexpr int32_t kNumHot = 50;
+  constexpr uint64_t kScanOffset = 1UL << 40;
+  FLAGS_velox_cache_admission_filter = true;
+  initializeCache(kMaxBytes);
+  const auto load = [&](uint64_t offset) {
+    auto pin = cache_->findOrCreate(
+        RawFileCacheKey{filenames_[0].id(), offset}, kSize, nullptr);
+    ASSERT_FALSE(pin.empty());
+    if (pin.entry()->isExclusive()) {
+      pin.entry()->setExclusiveToShared();
+    }
+  };
+
+  // The hot entries are read twice and are no longer on probation after the
+  // second read.
+  for (auto i = 0; i < 2 * kNumHot; ++i) {
+    load((i % kNumHot) * kSize);
+  }
+  auto stats = cache_->refreshStats();
+  ASSERT_EQ(kNumHot, stats.numProbation);
+  ASSERT_EQ(kNumHot, stats.numProbationHit);
+
+  // A scan of 4x the capacity reads each entry once. The scanned entries evict
+  // each other and do not evict the hot entries.
+  constexpr int32_t kNumScanned = 4 * kMaxBytes / kSize;
+  for (auto i = 0; i < kNumScanned; ++i) {
+    load(kScanOffset + i * kSize);
+  }
+  for (auto i = 0; i < kNumHot; ++i) {
+    ASSERT_TRUE(cache_->exists(RawFileCacheKey{filenames_[0].id(), i * kSize}))
+        << i;
+  }
+  stats = cache_->refreshStats();
+  // A few scanned keys can get a higher estimated frequency from collisions in
+  // the frequency sketch.
+  ASSERT_GE(kNumHot + kNumScanned, stats.numProbation);
+  ASSERT_LT(kNumHot + kNumScanned * 9 / 10, stats.numProbation);
+  ASSERT_EQ(kNumHot, stats.numProbationHit);
+  ASSERT_LT(0, stats.numProbationEvict);
+  ASSERT_NE(stats.toString().find("Probation entries: "), std::string::npos);
+  FLAGS_velox_cache_admission_filter = false;
+}
+
+TEST_F(AsyncDataCacheTest, groupReservation) {
+  constexpr int64_t kMaxBytes = 64 << 20;
+  constexpr int32_t kSize = 64 << 10;
+  constexpr int32_t kNumReserved = 128;
+  constexpr uint64_t kReservedGroup = 1;
+  constexpr uint64_t kScanGroup = 2;
+  constexpr uint64_t kScanOffset = 1UL << 40;
+  initializeCache(kMaxBytes);
+  // The reservation is twice the size of the group so that the skew of the
+  // entries over the shards does not matter.
+  cache_->setGroupReservation(kReservedGroup, 2 * kNumReserved * kSize);
+  const auto load = [&](uint64_t offset, uint64_t groupId) {
+    auto pin = cache_->findOrCreate(
+        RawFileCacheKey{filenames_[0].id(), offset}, kSize, nullptr);
+    ASSERT_FALSE(pin.empty());
+    if (pin.entry()->isExclusive()) {
+      pin.entry()->setGroupId(groupId);
+      pin.entry()->setExclusiveToShared();
+    }
+  };
+
+  for (auto i = 0; i < kNumReserved; ++i) {
+    load(i * kSize, kReservedGroup);
+  }
+  ASSERT_EQ(
+      kNumReserved * kSize, cache_->refreshStats().groupBytes[kReservedGroup]);
+
+  // A scan of 4x the capacity in another group does not evict the reserved
+  // entries.
+  constexpr int32_t kNumScanned = 4 * kMaxBytes / kSize;
+  for (auto i = 0; i < kNumScanned; ++i) {
+    load(kScanOffset + i * kSize, kScanGroup);
+  }
+  for (auto i = 0; i < kNumReserved; ++i) {
+    ASSERT_TRUE(cache_->exists(RawFileCacheKey{filenames_[0].id(), i * kSize}))
+        << i;
+  }
+  auto stats = cache_->refreshStats();
+  ASSERT_EQ(kNumReserved * kSize, stats.groupBytes[kReservedGroup]);
+  ASSERT_EQ(0, stats.groupBytes.count(kScanGroup));
+
+  // Clearing the cache evicts the reserved entries.
+  cache_->clear();
+  ASSERT_EQ(0, cache_->refreshStats().groupBytes[kReservedGroup]);
+}
+
 namespace {
 // Cuts off the last 1/10th of file at 'path'.
 void corruptFile(const std::string& path) {
@@ -807,6 +899,9 @@ TEST_F(AsyncDataCacheTest, cacheStats) {
       "Cache access miss: 2041 hit: 46 hit bytes: 1.34KB eviction: 463 eviction checks: 348\n"
       "Prefetch entries: 30 bytes: 100B\n"
       "Alloc Megaclocks 0");
+  stats.numLookupWaits = 7;
+  ASSERT_NE(
+      stats.toString().find("Shard lookup waits: 7\n"), std::string::npos);
 
   constexpr uint64_t kRamBytes = 32 << 20;
   constexpr uint64_t kSsdBytes = 512UL << 20;
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "velox/common/caching/FrequencySketch.h"
+#include "velox/common/base/BitUtil.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox;
+using namespace facebook::velox::cache;
+
+TEST(FrequencySketchTest, basic) {
+  FrequencySketch sketch;
+  const auto hash = [](uint64_t key) { return bits::hashMix(key, 1); };
+  for (auto i = 0; i < 5; ++i) {
+    EXPECT_EQ(i + 1, sketch.increment(hash(1)));
+  }
+  EXPECT_EQ(5, sketch.estimate(hash(1)));
+  EXPECT_EQ(0, sketch.estimate(hash(2)));
+
+  // Counts saturate.
+  for (auto i = 0; i < 20; ++i) {
+    sketch.increment(hash(3));
+  }
+  EXPECT_EQ(FrequencySketch::kMaxCount, sketch.estimate(hash(3)));
+}
+
+TEST(FrequencySketchTest, collisions) {
+  FrequencySketch sketch;
+  const auto hash = [](uint64_t key) { return bits::hashMix(key, 1); };
+  // Keys seen once mostly do not get higher counts from collisions when there
+  // are fewer keys than counters.
+  const int32_t numKeys = sketch.width() / 2;
+  int32_t numOverestimated = 0;
+  for (auto i = 0; i < numKeys; ++i) {
+    if (sketch.increment(hash(i)) > 1) {
+      ++numOverestimated;
+    }
+  }
+  EXPECT_LT(numOverestimated, numKeys / 20);
+}
+
+TEST(FrequencySketchTest, aging) {
+  FrequencySketch sketch;
+  const auto hash = [](uint64_t key) { return bits::hashMix(key, 1); };
+  for (auto i = 0; i < 8; ++i) {
+    sketch.increment(hash(0));
+  }
+  // The counts are halved after 10 increments per counter.
+  const auto numIncrements = sketch.width() * 10;
+  for (auto i = 8; i < numIncrements - 1; ++i) {
+    sketch.increment(hash(1));
+  }
+  EXPECT_EQ(8, sketch.estimate(hash(0)));
+  sketch.increment(hash(1));
+  EXPECT_EQ(4, sketch.estimate(hash(0)));
+  EXPECT_EQ(FrequencySketch::kMaxCount / 2, sketch.estimate(hash(1)));
+}
+
+TEST(FrequencySketchTest, ensureCapacity) {
+  FrequencySketch sketch;
+  const auto width = sketch.width();
+  sketch.increment(1);
+  sketch.ensureCapacity(width);
+  EXPECT_EQ(width, sketch.width());
+  EXPECT_EQ(1, sketch.estimate(1));
+  sketch.ensureCapacity(width + 1);
+  EXPECT_EQ(2 * width, sketch.width());
+  EXPECT_EQ(0, sketch.estimate(1));
+}
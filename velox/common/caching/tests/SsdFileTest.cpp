@@ -15,9 +15,11 @@
  */
 
 #include "velox/common/caching/FileIds.h"
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/caching/SsdCache.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 
+#include <fcntl.h>
 #include <folly/executors/QueuedImmediateExecutor.h>
 #include <glog/logging.h>
 #include <gtest/gtest.h>
@@ -53,20 +55,28 @@ class SsdFileTest : public testing::Test {
   void initializeCache(
       int64_t maxBytes,
       int64_t ssdBytes = 0,
-      bool setNoCowFlag = false) {
+      bool setNoCowFlag = false,
+      int64_t checkpointIntervalBytes = 0,
+      bool checksumEnabled = false) {
     // tmpfs does not support O_DIRECT, so turn this off for testing.
     FLAGS_ssd_odirect = false;
     cache_ = AsyncDataCache::create(MemoryAllocator::getInstance());
 
     fileName_ = StringIdLease(fileIds(), "fileInStorage");
 
-    tempDirectory_ = exec::test::TempDirectoryPath::create();
+    // Make a new tempDirectory only if one is not already set. The second
+    // creation of the file must find the checkpoint of the previous one.
+    if (tempDirectory_ == nullptr) {
+      tempDirectory_ = exec::test::TempDirectoryPath::create();
+    }
     ssdFile_ = std::make_unique<SsdFile>(
         fmt::format("{}/ssdtest", tempDirectory_->path),
         0, // shardId
         bits::roundUp(ssdBytes, SsdFile::kRegionSize) / SsdFile::kRegionSize,
-        0, // checkpointInternalBytes
-        setNoCowFlag);
+        checkpointIntervalBytes,
+        setNoCowFlag,
+        nullptr, // executor
+        checksumEnabled);
   }
 
   static void initializeContents(int64_t sequence, memory::Allocation& alloc) {
@@ -299,6 +309,83 @@ TEST_F(SsdFileTest, writeAndRead) {
   }
 }
 
+TEST_F(SsdFileTest, recoverFromCheckpoint) {
+  constexpr int64_t kSsdSize = 4 * SsdFile::kRegionSize;
+  initializeCache(128 * kMB, kSsdSize, false, kSsdSize, true);
+  std::vector<TestEntry> allEntries;
+  for (auto startOffset = 0; startOffset < 2 * SsdFile::kRegionSize;
+       startOffset += SsdFile::kRegionSize) {
+    auto pins =
+        makePins(fileName_.id(), startOffset, 4096, 2048 * 1025, 62 * kMB);
+    ssdFile_->write(pins);
+    for (auto& pin : pins) {
+      ASSERT_EQ(ssdFile_.get(), pin.entry()->ssdFile());
+      allEntries.emplace_back(
+          pin.entry()->key(), pin.entry()->ssdOffset(), pin.entry()->size());
+    }
+  }
+  uint64_t bytesWritten = 0;
+  for (const auto& entry : allEntries) {
+    bytesWritten += entry.size;
+  }
+  ssdFile_->checkpoint(true);
+
+  // Corrupts the data of the last entry.
+  const auto& corrupted = allEntries.back();
+  {
+    auto fd = ::open(
+        fmt::format("{}/ssdtest", tempDirectory_->path).c_str(), O_WRONLY);
+    ASSERT_GE(fd, 0);
+    const std::string garbage(16, 'x');
+    ASSERT_EQ(
+        static_cast<ssize_t>(garbage.size()),
+        ::pwrite(fd, garbage.data(), garbage.size(), corrupted.ssdOffset));
+    ::close(fd);
+  }
+
+  // Restarts from the checkpoint with an empty memory cache.
+  ssdFile_.reset();
+  initializeCache(128 * kMB, kSsdSize, false, kSsdSize, true);
+  SsdCacheStats stats;
+  ssdFile_->updateStats(stats);
+  ASSERT_EQ(allEntries.size(), stats.entriesRecovered);
+  ASSERT_EQ(bytesWritten, stats.bytesRecovered);
+  ASSERT_EQ(bytesWritten, stats.bytesCached);
+
+  // The intact entries are read and verified.
+  for (auto startOffset = 0; startOffset < 2 * SsdFile::kRegionSize;
+       startOffset += SsdFile::kRegionSize) {
+    auto pins =
+        makePins(fileName_.id(), startOffset, 4096, 2048 * 1025, 62 * kMB);
+    if (startOffset == 0) {
+      readAndCheckPins(pins);
+      continue;
+    }
+    ASSERT_EQ(pins.back().entry()->offset(), corrupted.key.offset);
+    pins.pop_back();
+    readAndCheckPins(pins);
+  }
+
+  // The corrupted entry fails the read and is dropped.
+  std::vector<CachePin> pins;
+  pins.push_back(cache_->findOrCreate(
+      RawFileCacheKey{fileName_.id(), corrupted.key.offset},
+      corrupted.size,
+      nullptr));
+  std::vector<SsdPin> ssdPins;
+  ssdPins.push_back(ssdFile_->find(
+      RawFileCacheKey{fileName_.id(), corrupted.key.offset}));
+  ASSERT_FALSE(ssdPins.back().empty());
+  VELOX_ASSERT_THROW(ssdFile_->load(ssdPins, pins), "Checksum mismatch");
+  ssdPins.clear();
+  stats = SsdCacheStats();
+  ssdFile_->updateStats(stats);
+  ASSERT_EQ(1, stats.readSsdCorruptions);
+  ASSERT_TRUE(ssdFile_
+                  ->find(RawFileCacheKey{fileName_.id(), corrupted.key.offset})
+                  .empty());
+}
+
 #ifdef VELOX_SSD_FILE_TEST_SET_NO_COW_FLAG
 TEST_F(SsdFileTest, disabledCow) {
   constexpr int64_t kSsdSize = 16 * SsdFile::kRegionSize;
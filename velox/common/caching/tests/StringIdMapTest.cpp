@@ -53,3 +53,21 @@ TEST(StringIdMapTest, rehash) {
     EXPECT_EQ(ids[i].id(), StringIdLease(map, name).id());
   }
 }
+
+TEST(StringIdMapTest, recoverId) {
+  StringIdMap map;
+  StringIdLease lease1(map, "file_1");
+  // A free id is reused for a new string.
+  StringIdLease lease2(map, 100, "file_2");
+  EXPECT_EQ(100, lease2.id());
+  // A known string keeps its id.
+  StringIdLease lease3(map, 200, "file_1");
+  EXPECT_EQ(lease1.id(), lease3.id());
+  // An id in use is not reused for another string.
+  StringIdLease lease4(map, 100, "file_3");
+  EXPECT_NE(100, lease4.id());
+  EXPECT_NE(lease1.id(), lease4.id());
+  // New ids do not collide with the recovered ones.
+  StringIdLease lease5(map, "file_4");
+  EXPECT_GT(lease5.id(), 100);
+}
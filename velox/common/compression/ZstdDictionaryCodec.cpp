@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/compression/ZstdDictionaryCodec.h"
+
+#include <limits>
+
+#include <zdict.h>
+#include <zstd.h>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::common {
+
+ZstdDictionaryCodec::ZstdDictionaryCodec(
+    uint64_t sampleBytes,
+    uint64_t dictionaryBytes,
+    int level)
+    : folly::io::Codec(folly::io::CodecType::ZSTD, level),
+      sampleBytes_(sampleBytes),
+      dictionaryBytes_(dictionaryBytes),
+      level_(level),
+      cctx_(ZSTD_createCCtx()),
+      dctx_(ZSTD_createDCtx()) {
+  VELOX_CHECK_NOT_NULL(cctx_);
+  VELOX_CHECK_NOT_NULL(dctx_);
+}
+
+ZstdDictionaryCodec::~ZstdDictionaryCodec() {
+  ZSTD_freeCDict(cdict_);
+  ZSTD_freeDDict(ddict_);
+  ZSTD_freeCCtx(cctx_);
+  ZSTD_freeDCtx(dctx_);
+}
+
+bool ZstdDictionaryCodec::hasDictionary() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return cdict_ != nullptr;
+}
+
+uint64_t ZstdDictionaryCodec::doMaxUncompressedLength() const {
+  return std::numeric_limits<int32_t>::max();
+}
+
+uint64_t ZstdDictionaryCodec::doMaxCompressedLength(
+    uint64_t uncompressedLength) const {
+  return ZSTD_compressBound(uncompressedLength);
+}
+
+std::unique_ptr<folly::IOBuf> ZstdDictionaryCodec::doCompress(
+    const folly::IOBuf* data) {
+  auto input = data->cloneCoalescedAsValue();
+  auto output = folly::IOBuf::create(ZSTD_compressBound(input.length()));
+  std::lock_guard<std::mutex> l(mutex_);
+  if (!trained_) {
+    addSampleLocked(folly::ByteRange(input.data(), input.length()));
+  }
+  size_t size;
+  if (cdict_ != nullptr) {
+    size = ZSTD_compress_usingCDict(
+        cctx_,
+        output->writableData(),
+        output->capacity(),
+        input.data(),
+        input.length(),
+        cdict_);
+  } else {
+    size = ZSTD_compressCCtx(
+        cctx_,
+        output->writableData(),
+        output->capacity(),
+        input.data(),
+        input.length(),
+        level_);
+  }
+  VELOX_CHECK(!ZSTD_isError(size), "ZSTD error: {}", ZSTD_getErrorName(size));
+  output->append(size);
+  return output;
+}
+
+std::unique_ptr<folly::IOBuf> ZstdDictionaryCodec::doUncompress(
+    const folly::IOBuf* data,
+    folly::Optional<uint64_t> uncompressedLength) {
+  auto input = data->cloneCoalescedAsValue();
+  uint64_t length;
+  if (uncompressedLength.has_value()) {
+    length = uncompressedLength.value();
+  } else {
+    length = ZSTD_getFrameContentSize(input.data(), input.length());
+    VELOX_CHECK(
+        length != ZSTD_CONTENTSIZE_UNKNOWN && length != ZSTD_CONTENTSIZE_ERROR,
+        "Cannot determine the uncompressed size of a ZSTD frame");
+  }
+  auto output = folly::IOBuf::create(length);
+  const auto dictionaryId =
+      ZSTD_getDictID_fromFrame(input.data(), input.length());
+  std::lock_guard<std::mutex> l(mutex_);
+  size_t size;
+  if (dictionaryId != 0) {
+    VELOX_CHECK(
+        ddict_ != nullptr && ZSTD_getDictID_fromDDict(ddict_) == dictionaryId,
+        "ZSTD frame uses dictionary {} unknown to this codec",
+        dictionaryId);
+    size = ZSTD_decompress_usingDDict(
+        dctx_,
+        output->writableData(),
+        length,
+        input.data(),
+        input.length(),
+        ddict_);
+  } else {
+    size = ZSTD_decompressDCtx(
+        dctx_, output->writableData(), length, input.data(), input.length());
+  }
+  VELOX_CHECK(!ZSTD_isError(size), "ZSTD error: {}", ZSTD_getErrorName(size));
+  VELOX_CHECK_EQ(size, length);
+  output->append(size);
+  return output;
+}
+
+void ZstdDictionaryCodec::addSampleLocked(folly::ByteRange data) {
+  const auto size =
+      std::min<uint64_t>(data.size(), sampleBytes_ - samples_.size());
+  samples_.append(reinterpret_cast<const char*>(data.data()), size);
+  sampleSizes_.push_back(size);
+  if (samples_.size() >= sampleBytes_) {
+    trainLocked();
+  }
+}
+
+void ZstdDictionaryCodec::trainLocked() {
+  trained_ = true;
+  std::string dictionary(dictionaryBytes_, '\0');
+  const auto size = ZDICT_trainFromBuffer(
+      dictionary.data(),
+      dictionary.size(),
+      samples_.data(),
+      sampleSizes_.data(),
+      sampleSizes_.size());
+  samples_ = std::string();
+  sampleSizes_ = std::vector<size_t>();
+  if (ZDICT_isError(size)) {
+    return;
+  }
+  // Both dictionaries copy 'dictionary'.
+  cdict_ = ZSTD_createCDict(dictionary.data(), size, level_);
+  ddict_ = ZSTD_createDDict(dictionary.data(), size);
+  if (cdict_ == nullptr || ddict_ == nullptr) {
+    ZSTD_freeCDict(cdict_);
+    ZSTD_freeDDict(ddict_);
+    cdict_ = nullptr;
+    ddict_ = nullptr;
+  }
+}
+
+} // namespace facebook::velox::common
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <folly/compression/Compression.h>
+
+struct ZSTD_CCtx_s;
+struct ZSTD_DCtx_s;
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+namespace facebook::velox::common {
+
+/// ZSTD codec that trains a dictionary from the first buffers it compresses
+/// and compresses the later buffers with it. Small buffers, e.g. the pages of
+/// a spill run, compress independently and poorly with plain ZSTD since each
+/// repeats the patterns of its neighbors. A shared dictionary captures these
+/// patterns once.
+///
+/// The buffers compressed before training are plain ZSTD frames. Frames
+/// carry the id of their dictionary, so uncompress() handles both kinds. The
+/// dictionary only lives in 'this', so the buffers must be uncompressed by
+/// the same instance that compressed them. If training fails, e.g. because
+/// the samples are too few, the codec keeps compressing without a dictionary.
+///
+/// Thread-safe.
+class ZstdDictionaryCodec : public folly::io::Codec {
+ public:
+  /// Total size of the buffers sampled for training.
+  static constexpr uint64_t kDefaultSampleBytes = 1 << 20;
+  /// Maximum size of the trained dictionary.
+  static constexpr uint64_t kDefaultDictionaryBytes = 16 << 10;
+
+  explicit ZstdDictionaryCodec(
+      uint64_t sampleBytes = kDefaultSampleBytes,
+      uint64_t dictionaryBytes = kDefaultDictionaryBytes,
+      int level = 1);
+
+  ~ZstdDictionaryCodec() override;
+
+  /// Returns true if the later buffers are compressed with a dictionary.
+  bool hasDictionary() const;
+
+ private:
+  uint64_t doMaxUncompressedLength() const override;
+
+  uint64_t doMaxCompressedLength(uint64_t uncompressedLength) const override;
+
+  std::unique_ptr<folly::IOBuf> doCompress(const folly::IOBuf* data) override;
+
+  std::unique_ptr<folly::IOBuf> doUncompress(
+      const folly::IOBuf* data,
+      folly::Optional<uint64_t> uncompressedLength) override;
+
+  // Adds the start of 'data' to the samples and trains the dictionary once
+  // the samples reach 'sampleBytes_'.
+  void addSampleLocked(folly::ByteRange data);
+
+  void trainLocked();
+
+  const uint64_t sampleBytes_;
+  const uint64_t dictionaryBytes_;
+  const int level_;
+
+  mutable std::mutex mutex_;
+  // The samples back to back and their sizes. Cleared after training.
+  std::string samples_;
+  std::vector<size_t> sampleSizes_;
+  // True after the first training attempt.
+  bool trained_{false};
+  ZSTD_CCtx_s* cctx_{nullptr};
+  ZSTD_DCtx_s* dctx_{nullptr};
+  // Set if training succeeded.
+  ZSTD_CDict_s* cdict_{nullptr};
+  ZSTD_DDict_s* ddict_{nullptr};
+};
+
+} // namespace facebook::velox::common
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/compression/Compression.h"
+#include "velox/common/compression/ZstdDictionaryCodec.h"
+
+namespace facebook::velox::common {
+namespace {
+
+// Returns a small page of records that resemble the records of the other
+// pages.
+std::string makePage(int32_t page) {
+  static const char* kSegments[] = {
+      "AUTOMOBILE", "BUILDING", "FURNITURE", "HOUSEHOLD", "MACHINERY"};
+  std::string result;
+  for (auto i = 0; i < 8; ++i) {
+    const auto key = page * 8 + i;
+    result += fmt::format(
+        "{{\"custkey\": {}, \"name\": \"Customer#{:09}\", \"mktsegment\": "
+        "\"{}\", \"acctbal\": {}.{:02}}}\n",
+        key,
+        key,
+        kSegments[(key * 7) % 5],
+        (key * 7919) % 10000,
+        key % 100);
+  }
+  return result;
+}
+
+std::string toString(const folly::IOBuf& buffer) {
+  return buffer.cloneCoalescedAsValue().moveToFbString().toStdString();
+}
+
+TEST(ZstdDictionaryCodecTest, roundTrip) {
+  ZstdDictionaryCodec codec(256 << 10, 4 << 10);
+  auto plainCodec = compressionKindToCodec(CompressionKind_ZSTD);
+  std::vector<std::unique_ptr<folly::IOBuf>> compressed;
+  uint64_t compressedBytes = 0;
+  uint64_t plainBytes = 0;
+  for (auto i = 0; i < 2'000; ++i) {
+    const auto page = makePage(i);
+    auto data = folly::IOBuf::copyBuffer(page);
+    compressed.push_back(codec.compress(data.get()));
+    if (codec.hasDictionary()) {
+      compressedBytes += compressed.back()->computeChainDataLength();
+      plainBytes += plainCodec->compress(data.get())->computeChainDataLength();
+    }
+  }
+  ASSERT_TRUE(codec.hasDictionary());
+  EXPECT_LT(compressedBytes, plainBytes);
+
+  // Pages from before and after training uncompress alike.
+  for (auto i = 0; i < compressed.size(); ++i) {
+    EXPECT_EQ(makePage(i), toString(*codec.uncompress(compressed[i].get())));
+  }
+
+  // Another instance does not have the dictionary.
+  ZstdDictionaryCodec otherCodec;
+  VELOX_ASSERT_THROW(
+      otherCodec.uncompress(compressed.back().get()),
+      "unknown to this codec");
+}
+
+TEST(ZstdDictionaryCodecTest, noTraining) {
+  ZstdDictionaryCodec codec;
+  std::vector<std::unique_ptr<folly::IOBuf>> compressed;
+  for (auto i = 0; i < 10; ++i) {
+    auto data = folly::IOBuf::copyBuffer(makePage(i));
+    compressed.push_back(codec.compress(data.get()));
+  }
+  ASSERT_FALSE(codec.hasDictionary());
+  auto plainCodec = compressionKindToCodec(CompressionKind_ZSTD);
+  for (auto i = 0; i < compressed.size(); ++i) {
+    EXPECT_EQ(makePage(i), toString(*codec.uncompress(compressed[i].get())));
+    EXPECT_EQ(
+        makePage(i), toString(*plainCodec->uncompress(compressed[i].get())));
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::common
@@ -31,7 +31,8 @@ SpillConfig::SpillConfig(
     bool _aggregationSpillAll,
     int32_t _maxSpillLevel,
     int32_t _testSpillPct,
-    const std::string& _compressionKind)
+    const std::string& _compressionKind,
+    RateLimiter* _writeRateLimiter)
     : filePath(_filePath),
       maxFileSize(
           _maxFileSize == 0 ? std::numeric_limits<int64_t>::max()
@@ -47,7 +48,8 @@ SpillConfig::SpillConfig(
       aggregationSpillAll(_aggregationSpillAll),
       maxSpillLevel(_maxSpillLevel),
       testSpillPct(_testSpillPct),
-      compressionKind(common::stringToCompressionKind(_compressionKind)) {
+      compressionKind(common::stringToCompressionKind(_compressionKind)),
+      writeRateLimiter(_writeRateLimiter) {
   VELOX_USER_CHECK_GE(
       spillableReservationGrowthPct,
       minSpillableReservationPct,
@@ -18,6 +18,7 @@
 #include <string.h>
 
 #include <folly/executors/CPUThreadPoolExecutor.h>
+#include "velox/common/base/RateLimiter.h"
 #include "velox/common/compression/Compression.h"
 
 namespace facebook::velox::common {
@@ -37,7 +38,8 @@ struct SpillConfig {
       bool _aggregationSpillAll,
       int32_t _maxSpillLevel,
       int32_t _testSpillPct,
-      const std::string& _compressionKind);
+      const std::string& _compressionKind,
+      RateLimiter* _writeRateLimiter = nullptr);
 
   /// Returns the hash join spilling level with given 'startBitOffset'.
   ///
@@ -110,5 +112,9 @@ struct SpillConfig {
 
   /// CompressionKind when spilling, CompressionKind_NONE means no compression.
   common::CompressionKind compressionKind;
+
+  /// Throttles the spill file writes if not null. It is shared by all the
+  /// spillers of a query.
+  RateLimiter* writeRateLimiter; // Not owned.
 };
 } // namespace facebook::velox::common
@@ -23,6 +23,7 @@
 #include <stdexcept>
 
 #include <fcntl.h>
+#include <folly/FileUtil.h>
 #include <folly/portability/SysUio.h>
 
 namespace facebook::velox {
@@ -263,6 +264,38 @@ void LocalWriteFile::append(std::string_view data) {
       data.size());
 }
 
+void LocalWriteFile::appendv(const folly::IOBuf& data) {
+  VELOX_CHECK(!closed_, "file is closed");
+  // Writes the buffered bytes first, so that the ranges go after them.
+  VELOX_CHECK_EQ(
+      fflush(file_),
+      0,
+      "fflush failed in LocalWriteFile::appendv: {}.",
+      folly::errnoStr(errno));
+  auto iovecs = data.getIov();
+  const auto fd = fileno(file_);
+  for (size_t i = 0; i < iovecs.size(); i += IOV_MAX) {
+    const auto numIovecs = std::min<size_t>(IOV_MAX, iovecs.size() - i);
+    size_t bytes = 0;
+    for (auto j = i; j < i + numIovecs; ++j) {
+      bytes += iovecs[j].iov_len;
+    }
+    const auto written = folly::writevFull(fd, &iovecs[i], numIovecs);
+    VELOX_CHECK_EQ(
+        written,
+        static_cast<ssize_t>(bytes),
+        "writev failure in LocalWriteFile::appendv: {}.",
+        folly::errnoStr(errno));
+  }
+  // Moves the position of 'file_', which may be cached, past the written
+  // bytes.
+  VELOX_CHECK_EQ(
+      fseek(file_, 0, SEEK_END),
+      0,
+      "fseek failed in LocalWriteFile::appendv: {}.",
+      folly::errnoStr(errno));
+}
+
 void LocalWriteFile::flush() {
   VELOX_CHECK(!closed_, "file is closed");
   auto ret = fflush(file_);
@@ -35,6 +35,7 @@
 
 #include <folly/Range.h>
 #include <folly/futures/Future.h>
+#include <folly/io/IOBuf.h>
 
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/file/Region.h"
@@ -143,6 +144,16 @@ class WriteFile {
   // Appends data to the end of the file.
   virtual void append(std::string_view data) = 0;
 
+  // Appends the ranges of 'data' to the end of the file. Lets a file write a
+  // chain with one vectored write instead of copying each range into its
+  // buffer. Appends the ranges one by one by default.
+  virtual void appendv(const folly::IOBuf& data) {
+    for (auto range : data) {
+      append(std::string_view(
+          reinterpret_cast<const char*>(range.data()), range.size()));
+    }
+  }
+
   // Flushes any local buffers, i.e. ensures the backing medium received
   // all data that has been appended.
   virtual void flush() = 0;
@@ -257,6 +268,10 @@ class LocalReadFile final : public ReadFile {
     return 10 << 20;
   }
 
+  int32_t fd() const {
+    return fd_;
+  }
+
  private:
   void preadInternal(uint64_t offset, uint64_t length, char* FOLLY_NONNULL pos)
       const;
@@ -277,6 +292,7 @@ class LocalWriteFile final : public WriteFile {
   ~LocalWriteFile();
 
   void append(std::string_view data) final;
+  void appendv(const folly::IOBuf& data) final;
   void flush() final;
   void close() final;
   uint64_t size() const final;
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/HedgedReadFile.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <folly/futures/Future.h>
+
+namespace facebook::velox {
+
+HedgedReadPolicy::HedgedReadPolicy(folly::Executor* executor, Options options)
+    : executor_(executor), options_(options) {
+  VELOX_CHECK_NOT_NULL(executor_);
+  VELOX_CHECK(
+      options_.percentile > 0 && options_.percentile <= 1,
+      "Hedged read percentile must be in (0, 1]: {}",
+      options_.percentile);
+  VELOX_CHECK_GE(options_.maxHedgeRatio, 0);
+  latencies_.reserve(kWindowSize);
+}
+
+std::optional<std::chrono::microseconds> HedgedReadPolicy::hedgeDelay() const {
+  const auto delay = delayMicros_.load();
+  if (delay < 0) {
+    return std::nullopt;
+  }
+  return std::chrono::microseconds(delay);
+}
+
+void HedgedReadPolicy::recordLatency(std::chrono::microseconds latency) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (latencies_.size() < kWindowSize) {
+    latencies_.push_back(latency.count());
+  } else {
+    latencies_[numLatencies_ % kWindowSize] = latency.count();
+  }
+  ++numLatencies_;
+  if (numLatencies_ < options_.minSamples ||
+      (delayMicros_ >= 0 && numLatencies_ % kUpdateInterval != 0)) {
+    return;
+  }
+  auto sorted = latencies_;
+  const auto index = std::min<size_t>(
+      sorted.size() - 1, options_.percentile * sorted.size());
+  std::nth_element(sorted.begin(), sorted.begin() + index, sorted.end());
+  delayMicros_ = std::max<int64_t>(options_.minDelay.count(), sorted[index]);
+}
+
+bool HedgedReadPolicy::tryHedge() {
+  auto numHedges = numHedges_.load();
+  do {
+    if (numHedges + 1 > options_.maxHedgeRatio * numReads_) {
+      return false;
+    }
+  } while (!numHedges_.compare_exchange_weak(numHedges, numHedges + 1));
+  return true;
+}
+
+namespace {
+
+// The outcome of a read into a private buffer.
+struct PrivateRead {
+  // The return value of ReadFile::preadv().
+  uint64_t size{0};
+  // The bytes of the buffers without the gaps.
+  std::string data;
+};
+
+uint64_t timedPreadv(
+    const ReadFile& file,
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    HedgedReadPolicy& policy) {
+  const auto start = std::chrono::steady_clock::now();
+  const auto size = file.preadv(offset, buffers);
+  policy.recordLatency(std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start));
+  return size;
+}
+
+// Reads the ranges of 'buffers' into a private buffer. 'buffers' only gives
+// the layout of the read and is not written.
+PrivateRead readPrivate(
+    const ReadFile& file,
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers,
+    HedgedReadPolicy& policy) {
+  PrivateRead read;
+  uint64_t numBytes = 0;
+  for (const auto& buffer : buffers) {
+    if (buffer.data() != nullptr) {
+      numBytes += buffer.size();
+    }
+  }
+  read.data.resize(numBytes);
+  std::vector<folly::Range<char*>> ranges;
+  ranges.reserve(buffers.size());
+  auto* position = read.data.data();
+  for (const auto& buffer : buffers) {
+    if (buffer.data() == nullptr) {
+      ranges.emplace_back(nullptr, buffer.size());
+    } else {
+      ranges.emplace_back(position, buffer.size());
+      position += buffer.size();
+    }
+  }
+  read.size = timedPreadv(file, offset, ranges, policy);
+  return read;
+}
+
+uint64_t copyToBuffers(
+    const PrivateRead& read,
+    const std::vector<folly::Range<char*>>& buffers) {
+  const auto* position = read.data.data();
+  for (const auto& buffer : buffers) {
+    if (buffer.data() != nullptr) {
+      std::memcpy(buffer.data(), position, buffer.size());
+      position += buffer.size();
+    }
+  }
+  return read.size;
+}
+
+} // namespace
+
+HedgedReadFile::HedgedReadFile(
+    std::shared_ptr<ReadFile> file,
+    std::shared_ptr<HedgedReadPolicy> policy,
+    std::shared_ptr<io::IoStatistics> ioStats)
+    : file_(std::move(file)),
+      policy_(std::move(policy)),
+      ioStats_(std::move(ioStats)) {
+  VELOX_CHECK_NOT_NULL(file_);
+  VELOX_CHECK_NOT_NULL(policy_);
+  VELOX_CHECK_NOT_NULL(ioStats_);
+}
+
+std::string_view
+HedgedReadFile::pread(uint64_t offset, uint64_t length, void* buf) const {
+  preadv(offset, {folly::Range<char*>(static_cast<char*>(buf), length)});
+  return {static_cast<char*>(buf), length};
+}
+
+std::string HedgedReadFile::pread(uint64_t offset, uint64_t length) const {
+  std::string result(length, 0);
+  preadv(offset, {folly::Range<char*>(result.data(), length)});
+  return result;
+}
+
+uint64_t HedgedReadFile::preadv(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  policy_->recordRead();
+  const auto delay = policy_->hedgeDelay();
+  if (!delay.has_value()) {
+    return timedPreadv(*file_, offset, buffers, *policy_);
+  }
+
+  // The reads on the executor keep the file and policy alive since the
+  // losing read completes after this returns.
+  auto started = std::make_shared<std::atomic<bool>>(false);
+  auto primary = folly::via(
+      policy_->executor(),
+      [file = file_, policy = policy_, offset, buffers, started]() {
+        if (started->exchange(true)) {
+          return PrivateRead{};
+        }
+        return readPrivate(*file, offset, buffers, *policy);
+      });
+  primary.wait(*delay);
+  if (primary.isReady()) {
+    return copyToBuffers(std::move(primary).get(), buffers);
+  }
+  // If the executor has not started the read, the wait is in its queue and
+  // not in storage. The read runs here then and is not hedged.
+  if (!started->exchange(true)) {
+    return timedPreadv(*file_, offset, buffers, *policy_);
+  }
+  if (!policy_->tryHedge()) {
+    return copyToBuffers(std::move(primary).get(), buffers);
+  }
+
+  uint64_t numBytes = 0;
+  for (const auto& buffer : buffers) {
+    if (buffer.data() != nullptr) {
+      numBytes += buffer.size();
+    }
+  }
+  ioStats_->hedgedRead().increment(numBytes);
+  std::vector<folly::Future<PrivateRead>> reads;
+  reads.push_back(std::move(primary));
+  reads.push_back(folly::via(
+      policy_->executor(),
+      [file = file_, policy = policy_, offset, buffers]() {
+        return readPrivate(*file, offset, buffers, *policy);
+      }));
+  // Fails only if both reads fail.
+  auto [index, read] =
+      folly::collectAnyWithoutException(std::move(reads)).get();
+  if (index == 1) {
+    ioStats_->hedgeWin().increment(numBytes);
+  }
+  return copyToBuffers(read, buffers);
+}
+
+} // namespace facebook::velox
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+
+#include <folly/Executor.h>
+
+#include "velox/common/file/File.h"
+#include "velox/common/io/IoStatistics.h"
+
+namespace facebook::velox {
+
+/// Decides when a read is hedged, i.e. duplicated because it takes longer
+/// than most reads. Shared by the files of a storage system, e.g. per
+/// connector, so that the latencies of all their reads make up the
+/// distribution.
+class HedgedReadPolicy {
+ public:
+  struct Options {
+    /// A read is hedged after taking longer than this percentile of the
+    /// latencies of recent reads.
+    double percentile{0.95};
+
+    /// Maximum number of hedges as a fraction of the reads.
+    double maxHedgeRatio{0.05};
+
+    /// Reads are not hedged before this many latencies are known.
+    int32_t minSamples{100};
+
+    /// A read is never hedged before taking this long.
+    std::chrono::microseconds minDelay{1'000};
+  };
+
+  /// Runs the reads that may be hedged on 'executor'.
+  HedgedReadPolicy(folly::Executor* executor, Options options);
+
+  folly::Executor* executor() const {
+    return executor_;
+  }
+
+  /// Returns how long to wait for a read before hedging it or std::nullopt if
+  /// too few latencies are known.
+  std::optional<std::chrono::microseconds> hedgeDelay() const;
+
+  /// Adds the latency of a completed read to the distribution.
+  void recordLatency(std::chrono::microseconds latency);
+
+  /// Counts a read towards the budget of hedges.
+  void recordRead() {
+    ++numReads_;
+  }
+
+  /// Returns true and counts a hedge if the budget allows one more.
+  bool tryHedge();
+
+ private:
+  // Number of latencies in the window the percentile is taken over.
+  static constexpr int32_t kWindowSize = 1'024;
+
+  // The percentile is recomputed after this many latencies.
+  static constexpr int32_t kUpdateInterval = 64;
+
+  folly::Executor* const executor_;
+  const Options options_;
+
+  std::mutex mutex_;
+  // The recent latencies in micros, a ring buffer of up to 'kWindowSize'.
+  std::vector<int64_t> latencies_;
+  int64_t numLatencies_{0};
+
+  // The current hedge delay in micros, -1 until 'minSamples' are known.
+  std::atomic<int64_t> delayMicros_{-1};
+  std::atomic<uint64_t> numReads_{0};
+  std::atomic<uint64_t> numHedges_{0};
+};
+
+/// Wraps a file of a storage system with a long latency tail, e.g. an
+/// object store. A read runs on the executor of 'policy'. If it has not
+/// completed after HedgedReadPolicy::hedgeDelay(), the same read is issued
+/// again and the first to complete is returned. Each read goes to a private
+/// buffer so that the abandoned one can complete after returning. The hedges
+/// are counted in IoStatistics::hedgedRead() and the hedges completing first
+/// in IoStatistics::hedgeWin().
+class HedgedReadFile : public ReadFile {
+ public:
+  HedgedReadFile(
+      std::shared_ptr<ReadFile> file,
+      std::shared_ptr<HedgedReadPolicy> policy,
+      std::shared_ptr<io::IoStatistics> ioStats);
+
+  std::string_view pread(uint64_t offset, uint64_t length, void* buf)
+      const override;
+
+  std::string pread(uint64_t offset, uint64_t length) const override;
+
+  uint64_t preadv(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override;
+
+  bool shouldCoalesce() const override {
+    return file_->shouldCoalesce();
+  }
+
+  uint64_t size() const override {
+    return file_->size();
+  }
+
+  uint64_t memoryUsage() const override {
+    return file_->memoryUsage();
+  }
+
+  uint64_t bytesRead() const override {
+    return file_->bytesRead();
+  }
+
+  void resetBytesRead() override {
+    file_->resetBytesRead();
+  }
+
+  std::string getName() const override {
+    return file_->getName();
+  }
+
+  uint64_t getNaturalReadSize() const override {
+    return file_->getNaturalReadSize();
+  }
+
+ private:
+  const std::shared_ptr<ReadFile> file_;
+  const std::shared_ptr<HedgedReadPolicy> policy_;
+  const std::shared_ptr<io::IoStatistics> ioStats_;
+};
+
+} // namespace facebook::velox
@@ -0,0 +1,214 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef VELOX_ENABLE_IO_URING
+
+#include "velox/common/file/IoUringReadFile.h"
+
+#include <folly/String.h>
+#include <folly/portability/SysUio.h>
+#include <glog/logging.h>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox {
+
+namespace {
+constexpr uint32_t kDefaultQueueDepth = 256;
+
+// Returns an exception for a failed read to set on the promise of the read.
+folly::exception_wrapper makeReadError(
+    int32_t fd,
+    uint64_t offset,
+    int32_t result) {
+  try {
+    if (result < 0) {
+      VELOX_FAIL(
+          "io_uring read failure, fd {} offset {}: {}",
+          fd,
+          offset,
+          folly::errnoStr(-result));
+    }
+    VELOX_FAIL(
+        "io_uring read failure, fd {} offset {}: unexpected end of file",
+        fd,
+        offset);
+  } catch (const std::exception&) {
+    return folly::exception_wrapper(std::current_exception());
+  }
+}
+} // namespace
+
+IoUring::IoUring(uint32_t queueDepth) {
+  const auto rc = io_uring_queue_init(queueDepth, &ring_, 0);
+  VELOX_CHECK_EQ(rc, 0, "io_uring_queue_init failure: {}", folly::errnoStr(-rc));
+  completionThread_ = std::thread([this]() { completionLoop(); });
+}
+
+IoUring::~IoUring() {
+  {
+    // A nop with no request stops the completion thread after all the
+    // previously submitted reads complete.
+    std::lock_guard<std::mutex> l(mutex_);
+    auto* sqe = getSqeLocked();
+    io_uring_prep_nop(sqe);
+    io_uring_sqe_set_data(sqe, nullptr);
+    VELOX_CHECK_GE(io_uring_submit(&ring_), 0);
+  }
+  completionThread_.join();
+  io_uring_queue_exit(&ring_);
+}
+
+// static
+IoUring& IoUring::instance() {
+  static IoUring ring(kDefaultQueueDepth);
+  return ring;
+}
+
+folly::SemiFuture<uint64_t> IoUring::preadv(
+    int32_t fd,
+    uint64_t offset,
+    std::vector<struct iovec> iovecs) {
+  auto* request = new Request{fd, offset, std::move(iovecs)};
+  auto future = request->promise.getSemiFuture();
+  if (request->iovecs.empty()) {
+    request->promise.setValue(0);
+    delete request;
+    return future;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  submitLocked(request);
+  return future;
+}
+
+struct io_uring_sqe* IoUring::getSqeLocked() {
+  for (;;) {
+    auto* sqe = io_uring_get_sqe(&ring_);
+    if (sqe != nullptr) {
+      return sqe;
+    }
+    const auto rc = io_uring_submit(&ring_);
+    VELOX_CHECK_GE(rc, 0, "io_uring_submit failure: {}", folly::errnoStr(-rc));
+  }
+}
+
+void IoUring::submitLocked(Request* request) {
+  auto* sqe = getSqeLocked();
+  const auto numIovecs = std::min<size_t>(
+      request->iovecs.size() - request->nextIovec, IOV_MAX);
+  io_uring_prep_readv(
+      sqe,
+      request->fd,
+      request->iovecs.data() + request->nextIovec,
+      numIovecs,
+      request->offset);
+  io_uring_sqe_set_data(sqe, request);
+  const auto rc = io_uring_submit(&ring_);
+  VELOX_CHECK_GE(rc, 0, "io_uring_submit failure: {}", folly::errnoStr(-rc));
+}
+
+bool IoUring::complete(Request* request, int32_t result) {
+  if (result <= 0) {
+    request->promise.setException(
+        makeReadError(request->fd, request->offset, result));
+    return true;
+  }
+  request->bytesRead += result;
+  request->offset += result;
+  // Skips the completely filled iovecs and trims the partially filled one.
+  size_t remaining = result;
+  auto& iovecs = request->iovecs;
+  while (request->nextIovec < iovecs.size() &&
+         iovecs[request->nextIovec].iov_len <= remaining) {
+    remaining -= iovecs[request->nextIovec].iov_len;
+    ++request->nextIovec;
+  }
+  if (request->nextIovec == iovecs.size()) {
+    request->promise.setValue(request->bytesRead);
+    return true;
+  }
+  auto& iovec = iovecs[request->nextIovec];
+  iovec.iov_base = static_cast<char*>(iovec.iov_base) + remaining;
+  iovec.iov_len -= remaining;
+  return false;
+}
+
+void IoUring::completionLoop() {
+  for (;;) {
+    struct io_uring_cqe* cqe;
+    const auto rc = io_uring_wait_cqe(&ring_, &cqe);
+    if (rc == -EINTR) {
+      continue;
+    }
+    VELOX_CHECK_EQ(
+        rc, 0, "io_uring_wait_cqe failure: {}", folly::errnoStr(-rc));
+    auto* request = static_cast<Request*>(io_uring_cqe_get_data(cqe));
+    const auto result = cqe->res;
+    io_uring_cqe_seen(&ring_, cqe);
+    if (request == nullptr) {
+      return;
+    }
+    if (complete(request, result)) {
+      delete request;
+      continue;
+    }
+    try {
+      std::lock_guard<std::mutex> l(mutex_);
+      submitLocked(request);
+    } catch (const std::exception&) {
+      request->promise.setException(
+          folly::exception_wrapper(std::current_exception()));
+      delete request;
+    }
+  }
+}
+
+IoUringReadFile::IoUringReadFile(std::string_view path) : file_(path) {}
+
+IoUringReadFile::IoUringReadFile(int32_t fd) : file_(fd) {}
+
+folly::SemiFuture<uint64_t> IoUringReadFile::preadvAsync(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  // The skipped ranges are read into a shared buffer as in
+  // LocalReadFile::preadv(). Its content is never used and may be written
+  // by concurrent reads.
+  static std::vector<char> droppedBytes(16 * 1024);
+  std::vector<struct iovec> iovecs;
+  iovecs.reserve(buffers.size());
+  for (const auto& range : buffers) {
+    if (range.data() != nullptr) {
+      iovecs.push_back({range.data(), range.size()});
+      continue;
+    }
+    auto skipSize = range.size();
+    while (skipSize > 0) {
+      const auto bytes = std::min<size_t>(droppedBytes.size(), skipSize);
+      iovecs.push_back({droppedBytes.data(), bytes});
+      skipSize -= bytes;
+    }
+  }
+  try {
+    return IoUring::instance().preadv(file_.fd(), offset, std::move(iovecs));
+  } catch (const std::exception&) {
+    return folly::makeSemiFuture<uint64_t>(
+        folly::exception_wrapper(std::current_exception()));
+  }
+}
+
+} // namespace facebook::velox
+
+#endif // VELOX_ENABLE_IO_URING
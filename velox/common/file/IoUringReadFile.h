@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#ifdef VELOX_ENABLE_IO_URING
+
+#include <liburing.h>
+
+#include <mutex>
+#include <thread>
+
+#include "velox/common/file/File.h"
+
+namespace facebook::velox {
+
+/// A submission and completion queue pair shared by all the io_uring backed
+/// files. Reads are submitted by the calling thread and completed by a
+/// dedicated thread that fulfills the future of each read.
+class IoUring {
+ public:
+  explicit IoUring(uint32_t queueDepth);
+
+  ~IoUring();
+
+  /// Returns the process wide instance.
+  static IoUring& instance();
+
+  /// Reads starting at 'offset' of 'fd' into 'iovecs' and returns the number
+  /// of bytes read. Short reads are resubmitted until all 'iovecs' are filled.
+  /// Hitting the end of file before that fails the read.
+  folly::SemiFuture<uint64_t>
+  preadv(int32_t fd, uint64_t offset, std::vector<struct iovec> iovecs);
+
+ private:
+  struct Request {
+    int32_t fd;
+    // File offset of the next byte to read.
+    uint64_t offset;
+    std::vector<struct iovec> iovecs;
+    // Index of the first iovec in 'iovecs' that is not completely filled.
+    size_t nextIovec{0};
+    uint64_t bytesRead{0};
+    folly::Promise<uint64_t> promise;
+  };
+
+  // Submits the unread part of 'request'. Must be called with 'mutex_' held.
+  void submitLocked(Request* request);
+
+  // Returns a free submission queue entry. Submits the pending entries to make
+  // space if the queue is full. Must be called with 'mutex_' held.
+  struct io_uring_sqe* getSqeLocked();
+
+  // Waits for completions until the stop entry is completed.
+  void completionLoop();
+
+  // Handles the completion of 'request' with 'result' as in readv(). Returns
+  // true if 'request' is done.
+  bool complete(Request* request, int32_t result);
+
+  // Serializes the submissions. The completions are only reaped by
+  // 'completionThread_'.
+  std::mutex mutex_;
+  struct io_uring ring_;
+  std::thread completionThread_;
+};
+
+/// A local file that reads asynchronously with io_uring in preadvAsync(). The
+/// synchronous reads are done by LocalReadFile.
+class IoUringReadFile final : public ReadFile {
+ public:
+  explicit IoUringReadFile(std::string_view path);
+
+  /// Takes the ownership of 'fd' as LocalReadFile does.
+  explicit IoUringReadFile(int32_t fd);
+
+  std::string_view
+  pread(uint64_t offset, uint64_t length, void* FOLLY_NONNULL buf) const final {
+    return file_.pread(offset, length, buf);
+  }
+
+  uint64_t preadv(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final {
+    return file_.preadv(offset, buffers);
+  }
+
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
+  bool hasPreadvAsync() const final {
+    return true;
+  }
+
+  uint64_t size() const final {
+    return file_.size();
+  }
+
+  uint64_t memoryUsage() const final {
+    return file_.memoryUsage();
+  }
+
+  bool shouldCoalesce() const final {
+    return false;
+  }
+
+  std::string getName() const final {
+    return file_.getName();
+  }
+
+  uint64_t getNaturalReadSize() const final {
+    return file_.getNaturalReadSize();
+  }
+
+  uint64_t bytesRead() const final {
+    return file_.bytesRead();
+  }
+
+  void resetBytesRead() final {
+    file_.resetBytesRead();
+  }
+
+ private:
+  LocalReadFile file_;
+};
+
+} // namespace facebook::velox
+
+#endif // VELOX_ENABLE_IO_URING
@@ -16,8 +16,10 @@
 
 #include <fcntl.h>
 
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
+#include "velox/common/file/IoUringReadFile.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/exec/tests/utils/TempFilePath.h"
 
@@ -126,6 +128,70 @@ TEST(LocalFile, writeAndRead) {
   readData(&readFile);
 }
 
+TEST(LocalFile, appendv) {
+  auto tempFile = ::exec::test::TempFilePath::create();
+  const auto& filename = tempFile->path.c_str();
+  remove(filename);
+  {
+    LocalWriteFile writeFile(filename);
+    writeFile.append("aaaaa");
+    auto iobuf = folly::IOBuf::copyBuffer("bbbbb");
+    iobuf->appendChain(folly::IOBuf::copyBuffer(std::string(kOneMB, 'c')));
+    writeFile.appendv(*iobuf);
+    ASSERT_EQ(writeFile.size(), 10 + kOneMB);
+    // Buffered appends go after the chain.
+    writeFile.append("ddddd");
+    ASSERT_EQ(writeFile.size(), 15 + kOneMB);
+  }
+  LocalReadFile readFile(filename);
+  readData(&readFile);
+}
+
+#ifdef VELOX_ENABLE_IO_URING
+TEST(IoUringFile, preadvAsync) {
+  auto tempFile = ::exec::test::TempFilePath::create();
+  const auto& filename = tempFile->path.c_str();
+  remove(filename);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  IoUringReadFile readFile(filename);
+  ASSERT_TRUE(readFile.hasPreadvAsync());
+  readData(&readFile);
+
+  // aaaaa bbbbb c*1MB ddddd
+  char head[12];
+  std::string middle(kOneMB / 2, 0);
+  char tail[7];
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(head, sizeof(head)),
+      folly::Range<char*>(nullptr, (char*)(uint64_t)1000),
+      folly::Range<char*>(middle.data(), middle.size()),
+      folly::Range<char*>(
+          nullptr,
+          (char*)(uint64_t)(15 + kOneMB - 1000 - sizeof(head) - middle.size() - sizeof(tail))),
+      folly::Range<char*>(tail, sizeof(tail))};
+  std::vector<folly::SemiFuture<uint64_t>> reads;
+  for (auto i = 0; i < 10; ++i) {
+    reads.push_back(readFile.preadvAsync(0, buffers));
+  }
+  for (auto& read : reads) {
+    ASSERT_EQ(15 + kOneMB, std::move(read).get());
+  }
+  ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbbcc");
+  ASSERT_EQ(middle, std::string(kOneMB / 2, 'c'));
+  ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ccddddd");
+
+  // Reading past the end of file fails.
+  char past[10];
+  VELOX_ASSERT_THROW(
+      readFile.preadvAsync(10 + kOneMB, {folly::Range<char*>(past, 10)})
+          .get(),
+      "unexpected end of file");
+}
+#endif
+
 TEST(LocalFile, viaRegistry) {
   filesystems::registerLocalFileSystem();
   auto tempFile = ::exec::test::TempFilePath::create();
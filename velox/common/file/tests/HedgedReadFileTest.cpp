@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/file/HedgedReadFile.h"
+
+#include <thread>
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+
+#include "gtest/gtest.h"
+
+using namespace facebook::velox;
+
+namespace {
+
+// A file whose next read can be made to stall.
+class SlowReadFile : public InMemoryReadFile {
+ public:
+  explicit SlowReadFile(std::string data) : InMemoryReadFile(std::move(data)) {}
+
+  std::string_view pread(uint64_t offset, uint64_t length, void* buf)
+      const override {
+    if (slowNext_.exchange(false)) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    }
+    return InMemoryReadFile::pread(offset, length, buf);
+  }
+
+  void setSlowNext() {
+    slowNext_ = true;
+  }
+
+ private:
+  mutable std::atomic<bool> slowNext_{false};
+};
+
+class HedgedReadFileTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    for (auto i = 0; i < 1'000; ++i) {
+      data_.push_back('a' + i % 26);
+    }
+    slowFile_ = std::make_shared<SlowReadFile>(data_);
+    ioStats_ = std::make_shared<io::IoStatistics>();
+  }
+
+  std::shared_ptr<HedgedReadFile> makeFile(double maxHedgeRatio) {
+    HedgedReadPolicy::Options options;
+    options.percentile = 0.5;
+    options.maxHedgeRatio = maxHedgeRatio;
+    options.minSamples = 10;
+    options.minDelay = std::chrono::milliseconds(10);
+    auto policy = std::make_shared<HedgedReadPolicy>(executor_.get(), options);
+    return std::make_shared<HedgedReadFile>(slowFile_, policy, ioStats_);
+  }
+
+  // Reads [100, 150) and [200, 250) with a gap in between and checks the
+  // result.
+  void checkRead(const ReadFile& file) {
+    std::string first(50, '\0');
+    std::string second(50, '\0');
+    const auto size = file.preadv(
+        100,
+        {folly::Range<char*>(first.data(), first.size()),
+         folly::Range<char*>(nullptr, 50),
+         folly::Range<char*>(second.data(), second.size())});
+    EXPECT_EQ(size, 150);
+    EXPECT_EQ(first, data_.substr(100, 50));
+    EXPECT_EQ(second, data_.substr(200, 50));
+  }
+
+  std::string data_;
+  std::shared_ptr<SlowReadFile> slowFile_;
+  std::shared_ptr<io::IoStatistics> ioStats_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor_{
+      std::make_unique<folly::CPUThreadPoolExecutor>(4)};
+};
+
+TEST_F(HedgedReadFileTest, policy) {
+  HedgedReadPolicy::Options options;
+  options.percentile = 0.9;
+  options.maxHedgeRatio = 0.1;
+  options.minSamples = 10;
+  options.minDelay = std::chrono::microseconds(0);
+  HedgedReadPolicy policy(executor_.get(), options);
+  for (auto i = 1; i < 10; ++i) {
+    policy.recordLatency(std::chrono::microseconds(i * 10));
+  }
+  EXPECT_FALSE(policy.hedgeDelay().has_value());
+  policy.recordLatency(std::chrono::microseconds(100));
+  EXPECT_EQ(policy.hedgeDelay()->count(), 100);
+
+  // One hedge per 10 reads.
+  EXPECT_FALSE(policy.tryHedge());
+  for (auto i = 0; i < 10; ++i) {
+    policy.recordRead();
+  }
+  EXPECT_TRUE(policy.tryHedge());
+  EXPECT_FALSE(policy.tryHedge());
+}
+
+TEST_F(HedgedReadFileTest, hedgeSlowRead) {
+  auto file = makeFile(1);
+  for (auto i = 0; i < 20; ++i) {
+    checkRead(*file);
+  }
+  EXPECT_EQ(ioStats_->hedgedRead().count(), 0);
+
+  slowFile_->setSlowNext();
+  const auto start = std::chrono::steady_clock::now();
+  checkRead(*file);
+  EXPECT_LT(
+      std::chrono::steady_clock::now() - start, std::chrono::milliseconds(400));
+  EXPECT_EQ(ioStats_->hedgedRead().count(), 1);
+  EXPECT_EQ(ioStats_->hedgedRead().sum(), 100);
+  EXPECT_EQ(ioStats_->hedgeWin().count(), 1);
+}
+
+TEST_F(HedgedReadFileTest, budget) {
+  auto file = makeFile(0);
+  for (auto i = 0; i < 20; ++i) {
+    checkRead(*file);
+  }
+  slowFile_->setSlowNext();
+  checkRead(*file);
+  EXPECT_EQ(ioStats_->hedgedRead().count(), 0);
+  EXPECT_EQ(ioStats_->hedgeWin().count(), 0);
+}
+
+TEST_F(HedgedReadFileTest, pread) {
+  auto file = makeFile(1);
+  EXPECT_EQ(file->size(), data_.size());
+  EXPECT_EQ(file->pread(10, 20), data_.substr(10, 20));
+  char buffer[5];
+  EXPECT_EQ(file->pread(30, 5, buffer), data_.substr(30, 5));
+}
+
+} // namespace
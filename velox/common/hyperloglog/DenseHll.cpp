@@ -143,6 +143,23 @@ void DenseHll::insertHash(uint64_t hash) {
   insert(index, value);
 }
 
+void DenseHll::insertHashes(folly::Range<const uint64_t*> hashes) {
+  constexpr size_t kBatchSize = 64;
+  int32_t indices[kBatchSize];
+  int8_t values[kBatchSize];
+  for (size_t start = 0; start < hashes.size(); start += kBatchSize) {
+    const auto count = std::min(kBatchSize, hashes.size() - start);
+    for (size_t i = 0; i < count; ++i) {
+      const auto hash = hashes[start + i];
+      indices[i] = computeIndex(hash, indexBitLength_);
+      values[i] = numberOfLeadingZeros(hash, indexBitLength_) + 1;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      insert(indices[i], values[i]);
+    }
+  }
+}
+
 void DenseHll::insert(int32_t index, int8_t value) {
   auto delta = value - baseline_;
   auto oldDelta = getDelta(index);
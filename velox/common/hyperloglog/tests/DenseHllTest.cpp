@@ -153,6 +153,33 @@ TEST_P(DenseHllTest, highCardinality) {
   ASSERT_EQ(denseHll.cardinality(), DenseHll::cardinality(serialized.data()));
 }
 
+TEST_P(DenseHllTest, insertHashes) {
+  int8_t indexBitLength = GetParam();
+
+  std::vector<uint64_t> hashes;
+  for (int i = 0; i < 100'000; i++) {
+    hashes.push_back(hashOne(i % 7'919));
+  }
+
+  DenseHll expected{indexBitLength, &allocator_};
+  for (auto hash : hashes) {
+    expected.insertHash(hash);
+  }
+
+  DenseHll denseHll{indexBitLength, &allocator_};
+  // Insert in uneven batches to cover partial batches.
+  for (size_t start = 0; start < hashes.size(); start += 1'000) {
+    auto end = std::min(hashes.size(), start + 1'000);
+    denseHll.insertHashes(folly::Range<const uint64_t*>(
+        hashes.data() + start, hashes.data() + end - 13));
+    denseHll.insertHashes(folly::Range<const uint64_t*>(
+        hashes.data() + end - 13, hashes.data() + end));
+  }
+
+  ASSERT_EQ(expected.cardinality(), denseHll.cardinality());
+  ASSERT_EQ(serialize(expected), serialize(denseHll));
+}
+
 namespace {
 template <typename T>
 std::vector<T> sequence(T start, T end) {
@@ -99,6 +99,14 @@ class IoStatistics {
     return queryThreadIoLatency_;
   }
 
+  IoCounter& hedgedRead() {
+    return hedgedRead_;
+  }
+
+  IoCounter& hedgeWin() {
+    return hedgeWin_;
+  }
+
   void incOperationCounters(
       const std::string& operation,
       const uint64_t resourceThrottleCount,
@@ -139,6 +147,12 @@ class IoStatistics {
   // issued IO or for an in-progress read-ahead to finish.
   IoCounter queryThreadIoLatency_;
 
+  // Duplicates of slow storage reads issued by HedgedReadFile.
+  IoCounter hedgedRead_;
+
+  // Hedged reads that completed before the read they duplicate.
+  IoCounter hedgeWin_;
+
   std::unordered_map<std::string, OperationCounters> operationStats_;
   mutable std::mutex operationStatsMutex_;
 };
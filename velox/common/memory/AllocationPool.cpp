@@ -39,6 +39,17 @@ folly::Range<char*> AllocationPool::rangeAt(int32_t index) const {
   VELOX_FAIL("Out of range index for rangeAt(): {}", index);
 }
 
+int64_t AllocationPool::maybeFreeRange(int32_t index) {
+  if (index >= allocations_.size() ||
+      allocations_[index].runAt(0).data<char>() == startOfRun_) {
+    return 0;
+  }
+  const auto bytes = allocations_[index].byteSize();
+  allocations_.erase(allocations_.begin() + index);
+  usedBytes_ -= bytes;
+  return bytes;
+}
+
 void AllocationPool::clear() {
   allocations_.clear();
   largeAllocations_.clear();
@@ -55,6 +55,11 @@ class AllocationPool {
   /// distance from start to first byte after last allocation.
   folly::Range<char*> rangeAt(int32_t index) const;
 
+  /// Frees the indexth range if it is a non-contiguous run other than the one
+  /// allocations are made from. Returns the number of bytes freed or 0 if the
+  /// range cannot be freed. The ranges after 'index' shift down by one.
+  int64_t maybeFreeRange(int32_t index);
+
   int64_t currentOffset() const {
     return currentOffset_;
   }
@@ -216,7 +216,7 @@ void ByteStream::flush(OutputStream* out) {
     if (isBits_ && isReverseBitOrder_ && !isReversed_) {
       bits::reverseBits(ranges_[i].buffer, bytes);
     }
-    out->write(reinterpret_cast<char*>(ranges_[i].buffer), bytes);
+    out->writeStable(reinterpret_cast<char*>(ranges_[i].buffer), bytes);
   }
   if (isBits_ && isReverseBitOrder_) {
     isReversed_ = true;
@@ -310,33 +310,102 @@ void freeFunc(void* /*data*/, void* userData) {
 }
 } // namespace
 
+void IOBufOutputStream::write(const char* s, std::streamsize count) {
+  out_->appendStringPiece(folly::StringPiece(s, count));
+  position_ += count;
+  if (listener_) {
+    listener_->onWrite(s, count);
+  }
+}
+
+void IOBufOutputStream::writeStable(const char* s, std::streamsize count) {
+  const auto end = out_->size();
+  // Bytes written after a seek back overwrite, so they are copied.
+  if (!referenceStableWrites_ || count < kMinReferencedBytes ||
+      position_ != end + referencedBytes_) {
+    write(s, count);
+    return;
+  }
+  references_.push_back({static_cast<int64_t>(end), s, count});
+  referencedBytes_ += count;
+  position_ += count;
+  if (listener_) {
+    listener_->onWrite(s, count);
+  }
+}
+
+int64_t IOBufOutputStream::outOffset(int64_t pos) const {
+  // The referenced bytes before 'pos'.
+  int64_t skipped = 0;
+  for (const auto& reference : references_) {
+    const auto referenceStart = reference.offset + skipped;
+    if (pos <= referenceStart) {
+      break;
+    }
+    VELOX_CHECK_GE(
+        pos,
+        referenceStart + reference.size,
+        "Cannot seek into referenced bytes: {}",
+        pos);
+    skipped += reference.size;
+  }
+  return pos - skipped;
+}
+
 std::unique_ptr<folly::IOBuf> IOBufOutputStream::getIOBuf(
     const std::function<void()>& releaseFn) {
-  // Make an IOBuf for each range. The IOBufs keep shared ownership of
-  // 'arena_'.
+  // Make an IOBuf for each range of 'out_' and for each referenced range. The
+  // IOBufs keep shared ownership of 'arena_' or 'stableOwner_'.
   std::unique_ptr<folly::IOBuf> iobuf;
-  auto& ranges = out_->ranges();
-  for (auto& range : ranges) {
-    auto numValues =
-        &range == &ranges.back() ? out_->lastRangeEnd() : range.size;
-    auto userData = newFreeData(arena_, releaseFn);
+  auto append = [&](const std::shared_ptr<StreamArena>& owner,
+                    const char* data,
+                    int64_t size) {
+    if (size == 0) {
+      return;
+    }
+    auto userData = newFreeData(owner, releaseFn);
     auto newBuf = folly::IOBuf::takeOwnership(
-        reinterpret_cast<char*>(range.buffer), numValues, freeFunc, userData);
+        const_cast<char*>(data), size, freeFunc, userData);
     if (iobuf) {
       iobuf->prev()->appendChain(std::move(newBuf));
     } else {
       iobuf = std::move(newBuf);
     }
+  };
+
+  auto reference = references_.begin();
+  int64_t offset = 0;
+  auto& ranges = out_->ranges();
+  for (auto& range : ranges) {
+    const int64_t numValues =
+        &range == &ranges.back() ? out_->lastRangeEnd() : range.size;
+    const auto* data = reinterpret_cast<const char*>(range.buffer);
+    int64_t begin = 0;
+    // Splits the range at the offsets of the references that go inside it.
+    // References at the end of the range go before the next range.
+    while (reference != references_.end() &&
+           reference->offset - offset < numValues) {
+      const auto split = reference->offset - offset;
+      append(arena_, data + begin, split - begin);
+      append(stableOwner_, reference->data, reference->size);
+      begin = split;
+      ++reference;
+    }
+    append(arena_, data + begin, numValues - begin);
+    offset += numValues;
+  }
+  for (; reference != references_.end(); ++reference) {
+    append(stableOwner_, reference->data, reference->size);
   }
   return iobuf;
 }
-
 std::streampos IOBufOutputStream::tellp() const {
-  return out_->tellp();
+  return position_;
 }
 
 void IOBufOutputStream::seekp(std::streampos pos) {
-  out_->seekp(pos);
+  out_->seekp(outOffset(pos));
+  position_ = pos;
 }
 
 } // namespace facebook::velox
@@ -50,6 +50,13 @@ class OutputStream {
 
   virtual void write(const char* s, std::streamsize count) = 0;
 
+  /// Like write() for bytes that stay valid and unchanged while the output of
+  /// 'this' is used, e.g. the arena ranges of a ByteStream that is flushed.
+  /// Lets a stream reference the bytes instead of copying them.
+  virtual void writeStable(const char* s, std::streamsize count) {
+    write(s, count);
+  }
+
   virtual std::streampos tellp() const = 0;
 
   virtual void seekp(std::streampos pos) = 0;
@@ -301,15 +308,28 @@ class IOBufOutputStream : public OutputStream {
     out_->startWrite(initialSize);
   }
 
-  void write(const char* s, std::streamsize count) override {
-    out_->appendStringPiece(folly::StringPiece(s, count));
-    if (listener_) {
-      listener_->onWrite(s, count);
-    }
+  /// Stable writes of at least this many bytes are referenced instead of
+  /// copied once referenceStableWrites() is called. Smaller ones are cheaper
+  /// to copy than to chain.
+  static constexpr int32_t kMinReferencedBytes = 512;
+
+  void write(const char* s, std::streamsize count) override;
+
+  void writeStable(const char* s, std::streamsize count) override;
+
+  /// Makes writeStable() reference the written bytes instead of copying them,
+  /// so that e.g. a flushed VectorStreamGroup becomes an IOBuf chain over its
+  /// own arena ranges. The IOBufs of getIOBuf() share ownership of 'owner',
+  /// which must own the referenced bytes. 'owner' may be nullptr if the
+  /// caller keeps the bytes alive for as long as these IOBufs.
+  void referenceStableWrites(std::shared_ptr<StreamArena> owner) {
+    referenceStableWrites_ = true;
+    stableOwner_ = std::move(owner);
   }
 
   std::streampos tellp() const override;
 
+  /// Seeks to 'pos', which must not be inside referenced bytes.
   void seekp(std::streampos pos) override;
 
   /// 'releaseFn' is executed on iobuf destruction if not null.
@@ -317,8 +337,28 @@ class IOBufOutputStream : public OutputStream {
       const std::function<void()>& releaseFn = nullptr);
 
  private:
+  // Bytes referenced by a stable write.
+  struct Reference {
+    // Offset in 'out_' where the bytes go.
+    int64_t offset;
+    const char* data;
+    int64_t size;
+  };
+
+  // Returns the offset in 'out_' of stream position 'pos'.
+  int64_t outOffset(int64_t pos) const;
+
   std::shared_ptr<StreamArena> arena_;
   std::unique_ptr<ByteStream> out_;
+  bool referenceStableWrites_{false};
+  std::shared_ptr<StreamArena> stableOwner_;
+  // In order of 'offset'.
+  std::vector<Reference> references_;
+  // Sum of the sizes of 'references_'.
+  int64_t referencedBytes_{0};
+  // The stream position, i.e. the offset in 'out_' plus the referenced bytes
+  // before it.
+  int64_t position_{0};
 };
 
 } // namespace facebook::velox
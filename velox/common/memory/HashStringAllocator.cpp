@@ -219,6 +219,36 @@ HashStringAllocator::finishWrite(ByteStream& stream, int32_t numReserveBytes) {
   return {startPosition_, currentPosition};
 }
 
+int64_t HashStringAllocator::freeEmptyArenas() {
+  VELOX_CHECK_NULL(
+      currentHeader_,
+      "Do not call freeEmptyArenas() when a write is in progress");
+  int64_t freedBytes = 0;
+  // Goes backwards since freeing a range shifts the ranges after it.
+  for (auto i = pool_.numRanges() - 1; i >= 0; --i) {
+    auto range = pool_.rangeAt(i);
+    // Huge page sized ranges may hold several arenas and can't be partially
+    // freed. The current range is kept for the next allocations.
+    if (range.size() >= memory::AllocationTraits::kHugePageSize ||
+        pool_.isInCurrentRange(range.data())) {
+      continue;
+    }
+    auto* header = reinterpret_cast<Header*>(range.data());
+    if (!header->isFree() || header->next() != nullptr) {
+      continue;
+    }
+    const auto available = header->size() + sizeof(Header);
+    removeFromFreeList(header);
+    const auto bytes = pool_.maybeFreeRange(i);
+    VELOX_CHECK_GT(bytes, 0);
+    --numFree_;
+    freeBytes_ -= available;
+    cumulativeBytes_ -= sizeof(Header);
+    freedBytes += bytes;
+  }
+  return freedBytes;
+}
+
 void HashStringAllocator::newSlab() {
   constexpr int32_t kSimdPadding = simd::kPadding - sizeof(Header);
   const int64_t needed = pool_.allocatedBytes() >= pool_.hugePageThreshold()
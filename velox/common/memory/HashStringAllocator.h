@@ -327,6 +327,12 @@ class HashStringAllocator : public StreamArena {
   // Frees all memory associated with 'this' and leaves 'this' ready for reuse.
   void clear();
 
+  // Returns the memory of arenas that consist of a single free block back to
+  // the pool. Arenas in huge page backed ranges and the arena allocations are
+  // currently made from are kept. Returns the number of bytes freed. Must not
+  // be called while a write is in progress.
+  int64_t freeEmptyArenas();
+
   memory::MemoryPool* FOLLY_NONNULL pool() const {
     return pool_.pool();
   }
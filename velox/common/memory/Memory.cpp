@@ -214,6 +214,15 @@ std::string MemoryManager::toString() const {
   return out.str();
 }
 
+std::string MemoryManager::allocationProfile() const {
+  std::stringstream out;
+  out << defaultRoot_->allocationProfile();
+  for (const auto& pool : getAlivePools()) {
+    out << pool->allocationProfile();
+  }
+  return out.str();
+}
+
 std::vector<std::shared_ptr<MemoryPool>> MemoryManager::getAlivePools() const {
   std::vector<std::shared_ptr<MemoryPool>> pools;
   folly::SharedMutex::ReadHolder guard{mutex_};
@@ -193,6 +193,10 @@ class MemoryManager {
   /// Returns debug string of this memory manager.
   std::string toString() const;
 
+  /// Returns the sampled allocation profiles of all the alive memory pools.
+  /// See MemoryPool::Options::allocationSampleBytes.
+  std::string allocationProfile() const;
+
   /// Returns the memory manger's internal default root memory pool for testing
   /// purpose.
   MemoryPool& testingDefaultRoot() const {
@@ -25,6 +25,7 @@
 #include "velox/common/memory/Memory.h"
 
 DECLARE_bool(velox_memory_use_hugepages);
+DECLARE_uint64(velox_memory_hugepage_min_bytes);
 
 namespace facebook::velox::memory {
 
@@ -335,7 +336,8 @@ void MemoryAllocator::useHugePages(
     const ContiguousAllocation& data,
     bool enable) {
 #ifdef linux
-  if (!FLAGS_velox_memory_use_hugepages) {
+  if (!FLAGS_velox_memory_use_hugepages ||
+      data.maxSize() < FLAGS_velox_memory_hugepage_min_bytes) {
     return;
   }
   auto maybeRange = data.hugePageRange();
@@ -314,6 +314,15 @@ class MemoryReclaimer {
   /// error exposure.
   virtual void abort(MemoryPool* pool, const std::exception_ptr& error);
 
+  /// Returns the memory arbitration priority of the associated memory pool.
+  /// The memory arbitrator reclaims memory from and aborts the root memory
+  /// pools with lower priority first. For example, a latency sensitive query
+  /// can set a higher priority than the batch queries running on the same
+  /// node so that the latter are spilled or aborted first.
+  virtual int32_t priority() const {
+    return 0;
+  }
+
  protected:
   MemoryReclaimer() = default;
 };
@@ -143,6 +143,10 @@ std::string capacityToString(int64_t capacity) {
   if (FOLLY_UNLIKELY(debugEnabled_)) { \
     recordFreeDbg(__VA_ARGS__);        \
   }
+#define SAMPLE_ALLOC(bytes)                          \
+  if (FOLLY_UNLIKELY(allocationSampleBytes_ > 0)) { \
+    sampleAllocation(bytes);                        \
+  }
 #define DEBUG_LEAK_CHECK()             \
   if (FOLLY_UNLIKELY(debugEnabled_)) { \
     leakCheckDbg();                    \
@@ -202,10 +206,13 @@ MemoryPool::MemoryPool(
       trackUsage_(options.trackUsage),
       threadSafe_(options.threadSafe),
       checkUsageLeak_(options.checkUsageLeak),
-      debugEnabled_(options.debugEnabled) {
+      debugEnabled_(options.debugEnabled),
+      reservationSlackBytes_(options.reservationSlackBytes),
+      allocationSampleBytes_(options.allocationSampleBytes) {
   VELOX_CHECK(!isRoot() || !isLeaf());
   VELOX_CHECK_GT(
       maxCapacity_, 0, "Memory pool {} max capacity can't be zero", name_);
+  VELOX_CHECK_GE(reservationSlackBytes_, 0);
   MemoryAllocator::alignmentCheck(0, alignment_);
 }
 
@@ -392,6 +399,12 @@ MemoryPoolImpl::~MemoryPoolImpl() {
   if (parent_ != nullptr) {
     toImpl(parent_)->dropChild(this);
   }
+  if (isLeaf() && reservationSlackBytes_ > 0 && usedReservationBytes_ == 0 &&
+      minReservationBytes_ == 0 && reservationBytes_ > 0) {
+    // Returns the reservation slack kept on free to the parent.
+    toImpl(parent_)->decrementReservation(reservationBytes_);
+    reservationBytes_ = 0;
+  }
   if (checkUsageLeak_) {
     VELOX_CHECK(
         (usedReservationBytes_ == 0) && (reservationBytes_ == 0) &&
@@ -436,6 +449,7 @@ void* MemoryPoolImpl::allocate(int64_t size) {
         toString()));
   }
   DEBUG_RECORD_ALLOC(buffer, size);
+  SAMPLE_ALLOC(size);
   return buffer;
 }
 
@@ -455,6 +469,7 @@ void* MemoryPoolImpl::allocateZeroFilled(int64_t numEntries, int64_t sizeEach) {
         toString()));
   }
   DEBUG_RECORD_ALLOC(buffer, size);
+  SAMPLE_ALLOC(size);
   return buffer;
 }
 
@@ -474,6 +489,7 @@ void* MemoryPoolImpl::reallocate(void* p, int64_t size, int64_t newSize) {
         toString()));
   }
   DEBUG_RECORD_ALLOC(newP, newSize);
+  SAMPLE_ALLOC(newSize);
   if (p != nullptr) {
     ::memcpy(newP, p, std::min(size, newSize));
     free(p, size);
@@ -518,6 +534,7 @@ void MemoryPoolImpl::allocateNonContiguous(
         "{} failed with {} pages from {}", __FUNCTION__, numPages, toString()));
   }
   DEBUG_RECORD_ALLOC(out);
+  SAMPLE_ALLOC(out.byteSize());
   VELOX_CHECK(!out.empty());
   VELOX_CHECK_NULL(out.pool());
   out.setPool(this);
@@ -566,6 +583,7 @@ void MemoryPoolImpl::allocateContiguous(
         "{} failed with {} pages from {}", __FUNCTION__, numPages, toString()));
   }
   DEBUG_RECORD_ALLOC(out);
+  SAMPLE_ALLOC(out.size());
   VELOX_CHECK(!out.empty());
   VELOX_CHECK_NULL(out.pool());
   out.setPool(this);
@@ -628,7 +646,9 @@ std::shared_ptr<MemoryPool> MemoryPoolImpl::genChild(
           .trackUsage = trackUsage_,
           .threadSafe = threadSafe,
           .checkUsageLeak = checkUsageLeak_,
-          .debugEnabled = debugEnabled_});
+          .debugEnabled = debugEnabled_,
+          .reservationSlackBytes = reservationSlackBytes_,
+          .allocationSampleBytes = allocationSampleBytes_});
 }
 
 bool MemoryPoolImpl::maybeReserve(uint64_t increment) {
@@ -816,7 +836,7 @@ void MemoryPoolImpl::releaseThreadSafe(uint64_t size, bool releaseOnly) {
     int64_t newQuantized;
     if (FOLLY_UNLIKELY(releaseOnly)) {
       VELOX_DCHECK_EQ(size, 0);
-      if (minReservationBytes_ == 0) {
+      if (minReservationBytes_ == 0 && reservationSlackBytes_ == 0) {
         return;
       }
       newQuantized = quantizedSize(usedReservationBytes_);
@@ -825,7 +845,7 @@ void MemoryPoolImpl::releaseThreadSafe(uint64_t size, bool releaseOnly) {
       usedReservationBytes_ -= size;
       const int64_t newCap =
           std::max(minReservationBytes_, usedReservationBytes_);
-      newQuantized = quantizedSize(newCap);
+      newQuantized = quantizedSize(newCap) + reservationSlackBytes_;
     }
     freeable = reservationBytes_ - newQuantized;
     if (freeable > 0) {
@@ -884,6 +904,36 @@ std::string MemoryPoolImpl::treeMemoryUsage() const {
   return out.str();
 }
 
+std::string MemoryPoolImpl::allocationProfile() const {
+  std::stringstream out;
+  appendAllocationProfile("", out);
+  return out.str();
+}
+
+void MemoryPoolImpl::appendAllocationProfile(
+    const std::string& parentPath,
+    std::stringstream& out) const {
+  const auto path =
+      parentPath.empty() ? name_ : fmt::format("{}/{}", parentPath, name_);
+  std::vector<std::pair<std::string, AllocationSite>> sites;
+  {
+    std::lock_guard<std::mutex> l(allocationSitesMutex_);
+    sites.assign(allocationSites_.begin(), allocationSites_.end());
+  }
+  std::sort(sites.begin(), sites.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.second.sampledBytes > rhs.second.sampledBytes;
+  });
+  for (const auto& [callStack, site] : sites) {
+    out << "======== " << path << ": " << succinctBytes(site.sampledBytes)
+        << " in " << site.numSamples << " samples ========\n"
+        << callStack << "\n";
+  }
+  visitChildren([&](MemoryPool* child) {
+    toImpl(child)->appendAllocationProfile(path, out);
+    return true;
+  });
+}
+
 uint64_t MemoryPoolImpl::freeBytes() const {
   if (parent_ != nullptr) {
     return parent_->freeBytes();
@@ -1096,6 +1146,21 @@ void MemoryPoolImpl::recordGrowDbg(const void* addr, uint64_t newSize) {
   allocResult->second.size = newSize;
 }
 
+void MemoryPoolImpl::sampleAllocation(uint64_t bytes) {
+  VELOX_CHECK_GT(allocationSampleBytes_, 0);
+  const uint64_t prevBytes = sampleCounterBytes_.fetch_add(bytes);
+  const uint64_t numSamples = (prevBytes + bytes) / allocationSampleBytes_ -
+      prevBytes / allocationSampleBytes_;
+  if (numSamples == 0) {
+    return;
+  }
+  auto stackTrace = process::StackTrace().toString();
+  std::lock_guard<std::mutex> l(allocationSitesMutex_);
+  auto& site = allocationSites_[std::move(stackTrace)];
+  site.numSamples += numSamples;
+  site.sampledBytes += numSamples * allocationSampleBytes_;
+}
+
 void MemoryPoolImpl::leakCheckDbg() {
   VELOX_CHECK(debugEnabled_);
   if (debugAllocRecords_.empty()) {
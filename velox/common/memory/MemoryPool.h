@@ -32,6 +32,8 @@
 
 DECLARE_bool(velox_memory_leak_check_enabled);
 DECLARE_bool(velox_memory_pool_debug_enabled);
+DECLARE_int64(velox_memory_pool_reservation_slack_bytes);
+DECLARE_uint64(velox_memory_pool_allocation_sample_bytes);
 
 namespace facebook::velox::memory {
 #define VELOX_MEM_POOL_CAP_EXCEEDED(errorMessage)                   \
@@ -160,6 +162,26 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
     /// If true, tracks the allocation and free call stacks to detect the source
     /// of memory leak for testing purpose.
     bool debugEnabled{FLAGS_velox_memory_pool_debug_enabled};
+
+    /// Specifies the amount of unused memory reservation a leaf memory pool
+    /// keeps on free on top of its quantized reservation instead of returning
+    /// it to the parent. This avoids updating the shared parent pools on every
+    /// allocation when the usage of a hot leaf pool goes back and forth across
+    /// a reservation quantum boundary. The kept reservation is returned by
+    /// release() and on pool destruction (use zero to disable).
+    ///
+    /// NOTE: this applies to all the child memory pools created from this one.
+    int64_t reservationSlackBytes{
+        FLAGS_velox_memory_pool_reservation_slack_bytes};
+
+    /// If non-zero, records the call stack of about one allocation per this
+    /// many allocated bytes and aggregates the samples by call site. This is
+    /// cheap enough to leave on in production with a large sample interval
+    /// and is dumped by allocationProfile() (use zero to disable).
+    ///
+    /// NOTE: this applies to all the child memory pools created from this one.
+    uint64_t allocationSampleBytes{
+        FLAGS_velox_memory_pool_allocation_sample_bytes};
   };
 
   /// Constructs a named memory pool with specified 'name', 'parent' and 'kind'.
@@ -476,6 +498,11 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   /// MemoryPoolImpl::treeMemoryUsage()
   virtual std::string treeMemoryUsage() const = 0;
 
+  /// Returns the sampled allocation profile of this memory pool and its
+  /// children aggregated by pool path and call site, largest first. Empty if
+  /// allocation sampling is disabled. See Options::allocationSampleBytes.
+  virtual std::string allocationProfile() const = 0;
+
   /// Indicates if this is a leaf memory pool or not.
   FOLLY_ALWAYS_INLINE bool isLeaf() const {
     return kind_ == Kind::kLeaf;
@@ -524,6 +551,8 @@ class MemoryPool : public std::enable_shared_from_this<MemoryPool> {
   const bool threadSafe_;
   const bool checkUsageLeak_;
   const bool debugEnabled_;
+  const int64_t reservationSlackBytes_;
+  const uint64_t allocationSampleBytes_;
 
   /// Indicates if the memory pool has been aborted by the memory arbitrator or
   /// not.
@@ -670,6 +699,8 @@ class MemoryPoolImpl : public MemoryPool {
   //     op.0.0.0.Values usage 0B peak 0B
   std::string treeMemoryUsage() const override;
 
+  std::string allocationProfile() const override;
+
   Stats stats() const override;
 
   void testingSetCapacity(int64_t bytes);
@@ -688,6 +719,20 @@ class MemoryPoolImpl : public MemoryPool {
     return debugAllocRecords_;
   }
 
+  /// Aggregated allocation samples from one call site.
+  struct AllocationSite {
+    uint64_t numSamples{0};
+    /// The allocated bytes represented by the samples.
+    uint64_t sampledBytes{0};
+  };
+
+  /// Returns the allocation samples of this memory pool keyed by call stack.
+  std::unordered_map<std::string, AllocationSite> testingAllocationSites()
+      const {
+    std::lock_guard<std::mutex> l(allocationSitesMutex_);
+    return allocationSites_;
+  }
+
   static void setDebugPoolNameRegex(const std::string& regex) {
     debugPoolNameRegex() = regex;
   }
@@ -842,7 +887,7 @@ class MemoryPoolImpl : public MemoryPool {
     int64_t newQuantized;
     if (FOLLY_UNLIKELY(releaseOnly)) {
       VELOX_DCHECK_EQ(size, 0);
-      if (minReservationBytes_ == 0) {
+      if (minReservationBytes_ == 0 && reservationSlackBytes_ == 0) {
         return;
       }
       newQuantized = quantizedSize(usedReservationBytes_);
@@ -851,7 +896,7 @@ class MemoryPoolImpl : public MemoryPool {
       usedReservationBytes_ -= size;
       const int64_t newCap =
           std::max(minReservationBytes_, usedReservationBytes_);
-      newQuantized = quantizedSize(newCap);
+      newQuantized = quantizedSize(newCap) + reservationSlackBytes_;
     }
 
     const int64_t freeable = reservationBytes_ - newQuantized;
@@ -949,6 +994,17 @@ class MemoryPoolImpl : public MemoryPool {
   // pool is enabled.
   void leakCheckDbg();
 
+  // Invoked on an allocation of 'bytes' to record its call stack in
+  // 'allocationSites_' each time the allocated bytes cross a multiple of
+  // 'allocationSampleBytes_'.
+  void sampleAllocation(uint64_t bytes);
+
+  // Appends the allocation profile of this memory pool and its children to
+  // 'out'. 'parentPath' is the path of the parent pool from the root.
+  void appendAllocationProfile(
+      const std::string& parentPath,
+      std::stringstream& out) const;
+
   MemoryManager* const manager_;
   MemoryAllocator* const allocator_;
   const DestructionCallback destructionCb_;
@@ -1011,6 +1067,15 @@ class MemoryPoolImpl : public MemoryPool {
 
   // Map from address to 'AllocationRecord'.
   std::unordered_map<uint64_t, AllocationRecord> debugAllocRecords_;
+
+  // The cumulative allocated bytes counted for allocation sampling.
+  std::atomic<uint64_t> sampleCounterBytes_{0};
+
+  // Mutex for 'allocationSites_'.
+  mutable std::mutex allocationSitesMutex_;
+
+  // Map from call stack to the aggregated allocation samples taken there.
+  std::unordered_map<std::string, AllocationSite> allocationSites_;
 };
 
 /// An Allocator backed by a memory pool for STL containers.
@@ -17,14 +17,90 @@
 #include "velox/common/memory/MmapAllocator.h"
 
 #include <sys/mman.h>
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 #include "velox/common/base/Portability.h"
 #include "velox/common/memory/Memory.h"
 
+DECLARE_bool(velox_memory_use_hugepages);
+DECLARE_uint64(velox_memory_hugepage_min_bytes);
+
 namespace facebook::velox::memory {
+namespace {
+// Maps 'bytes' of anonymous memory. If huge pages are enabled and 'bytes' is
+// at least 'velox_memory_hugepage_min_bytes', the mapping starts at a huge page
+// boundary, so that all 2MB ranges of it can be backed by huge pages instead
+// of losing a partial huge page at either end. Returns nullptr on failure.
+void* mmapAnonymous(size_t bytes) {
+  const bool alignToHugePage = FLAGS_velox_memory_use_hugepages &&
+      bytes >= AllocationTraits::kHugePageSize &&
+      bytes >= FLAGS_velox_memory_hugepage_min_bytes;
+  const size_t mapBytes =
+      alignToHugePage ? bytes + AllocationTraits::kHugePageSize : bytes;
+  void* data = ::mmap(
+      nullptr,
+      mapBytes,
+      PROT_READ | PROT_WRITE,
+      MAP_PRIVATE | MAP_ANONYMOUS,
+      -1,
+      0);
+  if (data == MAP_FAILED) {
+    return nullptr;
+  }
+  if (!alignToHugePage) {
+    return data;
+  }
+  // Trim the unaligned head and the excess tail of the over-sized mapping.
+  auto* begin = reinterpret_cast<char*>(data);
+  auto* alignedBegin = reinterpret_cast<char*>(bits::roundUp(
+      reinterpret_cast<uintptr_t>(begin), AllocationTraits::kHugePageSize));
+  const size_t headBytes = alignedBegin - begin;
+  if (headBytes > 0) {
+    ::munmap(begin, headBytes);
+  }
+  const size_t tailBytes = AllocationTraits::kHugePageSize - headBytes;
+  if (tailBytes > 0) {
+    ::munmap(alignedBegin + bytes, tailBytes);
+  }
+  return alignedBegin;
+}
+
+// Sets a preferred NUMA node policy for the pages in ['ptr', 'ptr' + 'bytes').
+// Pages are not touched, so the policy takes effect when they are first
+// faulted in. Failure is not fatal: the memory is then placed by the default
+// policy of the process.
+void preferNumaNode(void* ptr, size_t bytes, int32_t numaNode) {
+  if (numaNode < 0) {
+    return;
+  }
+#if defined(__linux__) && defined(SYS_mbind)
+  // MPOL_PREFERRED from <linux/mempolicy.h>, which is not always installed.
+  constexpr int kMpolPreferred = 1;
+  constexpr int32_t kMaskBits = 8 * sizeof(uint64_t);
+  if (numaNode >= kMaskBits) {
+    VELOX_MEM_LOG(WARNING) << "NUMA node " << numaNode
+                           << " is out of range for mbind";
+    return;
+  }
+  const uint64_t nodeMask = 1UL << numaNode;
+  if (::syscall(
+          SYS_mbind, ptr, bytes, kMpolPreferred, &nodeMask, kMaskBits + 1, 0) !=
+      0) {
+    VELOX_MEM_LOG_EVERY_MS(WARNING, 1'000)
+        << "mbind to NUMA node " << numaNode
+        << " failed: " << folly::errnoStr(errno);
+  }
+#endif
+}
+} // namespace
+
 MmapAllocator::MmapAllocator(const Options& options)
     : kind_(MemoryAllocator::Kind::kMmap),
       useMmapArena_(options.useMmapArena),
+      numaNode_(options.numaNode),
       maxMallocBytes_(options.maxMallocBytes),
       mallocReservedBytes_(
           maxMallocBytes_ == 0
@@ -34,7 +110,8 @@ MmapAllocator::MmapAllocator(const Options& options)
           AllocationTraits::numPages(options.capacity - mallocReservedBytes_),
           64 * sizeClassSizes_.back())) {
   for (const auto& size : sizeClassSizes_) {
-    sizeClasses_.push_back(std::make_unique<SizeClass>(capacity_ / size, size));
+    sizeClasses_.push_back(
+        std::make_unique<SizeClass>(capacity_ / size, size, numaNode_));
   }
 
   if (useMmapArena_) {
@@ -360,16 +437,12 @@ bool MmapAllocator::allocateContiguousImpl(
       std::lock_guard<std::mutex> l(arenaMutex_);
       data = managedArenas_->allocate(AllocationTraits::pageBytes(maxPages));
     } else {
-      data = ::mmap(
-          nullptr,
-          AllocationTraits::pageBytes(maxPages),
-          PROT_READ | PROT_WRITE,
-          MAP_PRIVATE | MAP_ANONYMOUS,
-          -1,
-          0);
+      data = mmapAnonymous(AllocationTraits::pageBytes(maxPages));
+      if (data != nullptr) {
+        preferNumaNode(data, AllocationTraits::pageBytes(maxPages), numaNode_);
+      }
     }
   }
-  // TODO: add handling of MAP_FAILED.
   if (data == nullptr) {
     VELOX_MEM_LOG(ERROR) << "Mmap failed with " << numPages
                          << " pages, use MmapArena "
@@ -540,7 +613,10 @@ MachinePageCount MmapAllocator::adviseAway(MachinePageCount target) {
   return numAway;
 }
 
-MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
+MmapAllocator::SizeClass::SizeClass(
+    size_t capacity,
+    MachinePageCount unitSize,
+    int32_t numaNode)
     : capacity_(capacity),
       unitSize_(unitSize),
       byteSize_(AllocationTraits::pageBytes(capacity_ * unitSize_)),
@@ -568,6 +644,7 @@ MmapAllocator::SizeClass::SizeClass(size_t capacity, MachinePageCount unitSize)
         folly::errnoStr(errno),
         unitSize_);
   }
+  preferNumaNode(ptr, byteSize_, numaNode);
   address_ = reinterpret_cast<uint8_t*>(ptr);
 }
 
@@ -988,7 +1065,11 @@ std::string MmapAllocator::toString() const {
   out << "Memory Allocator[" << kindString(kind_) << " capacity "
       << ((capacity_ == kMaxMemory) ? "UNLIMITED" : succinctBytes(capacity_))
       << " allocated pages " << numAllocated_ << " mapped pages " << numMapped_
-      << " external mapped pages " << numExternalMapped_ << std::endl;
+      << " external mapped pages " << numExternalMapped_;
+  if (numaNode_ >= 0) {
+    out << " numa node " << numaNode_;
+  }
+  out << std::endl;
   for (auto& sizeClass : sizeClasses_) {
     out << sizeClass->toString() << std::endl;
   }
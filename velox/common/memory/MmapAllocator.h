@@ -75,6 +75,14 @@ class MmapAllocator : public MemoryAllocator {
     /// and 'smallAllocationReservePct' will be automatically set to 0
     /// disregarding any passed in value.
     int32_t maxMallocBytes = 3072;
+
+    /// If not negative, the size class address ranges and the mmaps made for
+    /// large allocations prefer physical memory from this NUMA node. This is
+    /// used to run one allocator per socket so that the cache and hash tables
+    /// of a socket's workers stay node-local. The policy is a preference: if
+    /// the node has no free memory, the kernel falls back to other nodes.
+    /// Ignored on platforms without mbind().
+    int32_t numaNode = -1;
   };
 
   explicit MmapAllocator(const Options& options);
@@ -123,6 +131,12 @@ class MmapAllocator : public MemoryAllocator {
     return maxMallocBytes_;
   }
 
+  /// Returns the preferred NUMA node for the memory of 'this' or -1 if not
+  /// bound to a node.
+  int32_t numaNode() const {
+    return numaNode_;
+  }
+
   size_t mallocReservedBytes() const {
     return mallocReservedBytes_;
   }
@@ -162,7 +176,10 @@ class MmapAllocator : public MemoryAllocator {
   // 'unitSize_' machine pages.
   class SizeClass {
    public:
-    SizeClass(size_t capacity, MachinePageCount unitSize);
+    SizeClass(
+        size_t capacity,
+        MachinePageCount unitSize,
+        int32_t numaNode = -1);
 
     ~SizeClass();
 
@@ -377,6 +394,9 @@ class MmapAllocator : public MemoryAllocator {
   // issued for each such allocation.
   const bool useMmapArena_;
 
+  // Preferred NUMA node for mapped memory, -1 if none.
+  const int32_t numaNode_;
+
   // Serializes moving capacity between size classes
   std::mutex sizeClassBalanceMutex_;
 
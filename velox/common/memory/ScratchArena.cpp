@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/memory/ScratchArena.h"
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::memory {
+
+ScratchArena::~ScratchArena() {
+  for (auto& chunk : chunks_) {
+    pool_->free(chunk.data, chunk.size);
+  }
+}
+
+void* ScratchArena::allocate(int64_t bytes) {
+  VELOX_CHECK_GE(bytes, 0);
+  bytes = bits::roundUp(std::max<int64_t>(bytes, 1), kAlignment);
+  if (currentChunk_ >= chunks_.size() ||
+      currentOffset_ + bytes > chunks_[currentChunk_].size) {
+    nextChunk(bytes);
+  }
+  auto* result = chunks_[currentChunk_].data + currentOffset_;
+  currentOffset_ += bytes;
+  return result;
+}
+
+void ScratchArena::nextChunk(int64_t bytes) {
+  if (currentChunk_ < chunks_.size() && currentOffset_ > 0) {
+    ++currentChunk_;
+  }
+  currentOffset_ = 0;
+  if (currentChunk_ < chunks_.size() &&
+      chunks_[currentChunk_].size >= bytes) {
+    return;
+  }
+  // There is no retained chunk to reuse or it is too small. A too small
+  // chunk is kept after the new one.
+  const int64_t size = std::max(kChunkSize, bytes);
+  chunks_.insert(
+      chunks_.begin() + currentChunk_,
+      Chunk{reinterpret_cast<char*>(pool_->allocate(size)), size});
+  retainedBytes_ += size;
+}
+
+void ScratchArena::rewind(const Mark& mark) {
+  if (mark.chunk > currentChunk_ ||
+      (mark.chunk == currentChunk_ && mark.offset > currentOffset_)) {
+    // An earlier mark has been rewound to already.
+    return;
+  }
+  currentChunk_ = mark.chunk;
+  currentOffset_ = mark.offset;
+  if (currentChunk_ != 0 || currentOffset_ != 0) {
+    return;
+  }
+  while (retainedBytes_ > kMaxRetainedBytes && !chunks_.empty()) {
+    auto& chunk = chunks_.back();
+    pool_->free(chunk.data, chunk.size);
+    retainedBytes_ -= chunk.size;
+    chunks_.pop_back();
+  }
+}
+
+} // namespace facebook::velox::memory
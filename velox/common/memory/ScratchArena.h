@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <type_traits>
+#include <vector>
+
+#include "velox/common/memory/MemoryPool.h"
+
+namespace facebook::velox::memory {
+
+/// A bump pointer allocator for short lived scratch memory such as the
+/// temporary index arrays and flags used while processing one batch. The
+/// memory is taken from 'pool' in chunks which are kept across rewinds, so
+/// that steady state allocation does no memory pool accounting and no free
+/// list bookkeeping. Allocations are not freed individually. Instead, a user
+/// takes a mark() before allocating and rewinds to it when done. Nested users
+/// release their memory in stack order. Not thread-safe.
+class ScratchArena {
+ public:
+  /// The alignment of each allocation.
+  static constexpr int64_t kAlignment = 16;
+
+  /// The position of the next allocation. See mark() and rewind().
+  struct Mark {
+    int32_t chunk{0};
+    int64_t offset{0};
+  };
+
+  explicit ScratchArena(MemoryPool* pool) : pool_(pool) {}
+
+  ~ScratchArena();
+
+  ScratchArena(const ScratchArena&) = delete;
+  ScratchArena& operator=(const ScratchArena&) = delete;
+
+  /// Returns 'bytes' of uninitialized memory. The memory stays valid until
+  /// rewind() to a mark taken before this call or destruction of 'this'.
+  void* allocate(int64_t bytes);
+
+  /// Returns uninitialized space for 'numElements' of T.
+  template <typename T>
+  T* allocate(int64_t numElements) {
+    static_assert(std::is_trivially_destructible_v<T>);
+    static_assert(alignof(T) <= kAlignment);
+    return reinterpret_cast<T*>(allocate(numElements * sizeof(T)));
+  }
+
+  Mark mark() const {
+    return {currentChunk_, currentOffset_};
+  }
+
+  /// Makes the memory allocated after 'mark' available for reuse. Does nothing
+  /// if 'mark' is past the current position, i.e. an earlier mark has been
+  /// rewound to already. When rewinding to the start, frees the chunks in
+  /// excess of kMaxRetainedBytes back to the memory pool.
+  void rewind(const Mark& mark);
+
+  /// Returns the bytes held from the memory pool.
+  int64_t retainedBytes() const {
+    return retainedBytes_;
+  }
+
+ private:
+  static constexpr int64_t kChunkSize = 64 << 10;
+  static constexpr int64_t kMaxRetainedBytes = 1 << 20;
+
+  struct Chunk {
+    char* data;
+    int64_t size;
+  };
+
+  // Makes a chunk with at least 'bytes' the current one. Reuses the next
+  // retained chunk if it is large enough.
+  void nextChunk(int64_t bytes);
+
+  MemoryPool* const pool_;
+  std::vector<Chunk> chunks_;
+
+  // Index of the chunk in 'chunks_' allocations are made from.
+  int32_t currentChunk_{0};
+
+  // Offset of the first unused byte in the current chunk.
+  int64_t currentOffset_{0};
+
+  int64_t retainedBytes_{0};
+};
+
+} // namespace facebook::velox::memory
@@ -16,7 +16,9 @@
 
 #include "velox/common/memory/SharedArbitrator.h"
 
+#include "velox/common/base/Counters.h"
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/common/time/Timer.h"
 
@@ -67,11 +69,13 @@ SharedArbitrator::SharedArbitrator(const MemoryArbitrator::Config& config)
 
 std::string SharedArbitrator::Candidate::toString() const {
   return fmt::format(
-      "CANDIDATE[{} RECLAIMABLE[{}] RECLAIMABLE_BYTES[{}] FREE_BYTES[{}]]",
+      "CANDIDATE[{} RECLAIMABLE[{}] RECLAIMABLE_BYTES[{}] FREE_BYTES[{}] "
+      "PRIORITY[{}]]",
       pool->root()->name(),
       reclaimable,
       succinctBytes(reclaimableBytes),
-      succinctBytes(freeBytes));
+      succinctBytes(freeBytes),
+      priority);
 }
 
 void SharedArbitrator::sortCandidatesByFreeCapacity(
@@ -100,6 +104,10 @@ void SharedArbitrator::sortCandidatesByReclaimableMemory(
         if (!rhs.reclaimable) {
           return true;
         }
+        // Reclaims from the lower priority candidates first.
+        if (lhs.priority != rhs.priority) {
+          return lhs.priority < rhs.priority;
+        }
         return lhs.reclaimableBytes > rhs.reclaimableBytes;
       });
 
@@ -116,15 +124,21 @@ SharedArbitrator::findCandidateWithLargestCapacity(
   VELOX_CHECK(!candidates.empty());
   int32_t candidateIdx{-1};
   int64_t maxCapacity{-1};
+  int32_t minPriority{0};
   for (int32_t i = 0; i < candidates.size(); ++i) {
     const bool isCandidate = candidates[i].pool == requestor;
     // For capacity comparison, the requestor's capacity should include both its
     // current capacity and the capacity growth.
     const int64_t capacity =
         candidates[i].pool->capacity() + (isCandidate ? targetBytes : 0);
-    if (i == 0) {
-      candidateIdx = 0;
+    const int32_t priority = candidates[i].priority;
+    if (i == 0 || priority < minPriority) {
+      candidateIdx = i;
       maxCapacity = capacity;
+      minPriority = priority;
+      continue;
+    }
+    if (priority > minPriority) {
       continue;
     }
     if (capacity < maxCapacity) {
@@ -176,8 +190,13 @@ std::vector<SharedArbitrator::Candidate> SharedArbitrator::getCandidateStats(
   for (const auto& pool : pools) {
     uint64_t reclaimableBytes;
     const bool reclaimable = pool->reclaimableBytes(reclaimableBytes);
+    const auto* reclaimer = pool->reclaimer();
     candidates.push_back(
-        {reclaimable, reclaimableBytes, pool->freeBytes(), pool.get()});
+        {reclaimable,
+         reclaimableBytes,
+         pool->freeBytes(),
+         pool.get(),
+         reclaimer == nullptr ? 0 : reclaimer->priority()});
   }
   return candidates;
 }
@@ -562,6 +581,8 @@ void SharedArbitrator::startArbitration(MemoryPool* requestor) {
       waitPromise.wait();
     }
     queueTimeUs_ += waitTimeUs;
+    REPORT_ADD_HISTOGRAM_VALUE(
+        kCounterArbitrationWaitLatencyMs, waitTimeUs / 1'000);
   }
 }
 
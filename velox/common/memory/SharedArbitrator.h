@@ -68,6 +68,8 @@ class SharedArbitrator : public MemoryArbitrator {
     uint64_t reclaimableBytes{0};
     uint64_t freeBytes{0};
     MemoryPool* pool;
+    // The arbitration priority from the memory pool's reclaimer.
+    int32_t priority{0};
 
     std::string toString() const;
   };
@@ -111,9 +113,9 @@ class SharedArbitrator : public MemoryArbitrator {
 
   void sortCandidatesByFreeCapacity(std::vector<Candidate>& candidates) const;
 
-  // Finds the candidate with the largest capacity. For 'requestor', the
-  // capacity for comparison including its current capacity and the capacity to
-  // grow.
+  // Finds the candidate with the largest capacity among the ones with the
+  // lowest priority. For 'requestor', the capacity for comparison including its
+  // current capacity and the capacity to grow.
   const Candidate& findCandidateWithLargestCapacity(
       MemoryPool* requestor,
       uint64_t targetBytes,
@@ -159,7 +161,8 @@ class SharedArbitrator : public MemoryArbitrator {
   void abort(MemoryPool* pool, const std::exception_ptr& error);
 
   // Invoked to handle the memory arbitration failure to abort the memory pool
-  // with the largest capacity to free up memory. The function returns true on
+  // with the largest capacity among the ones with the lowest priority to free
+  // up memory. The function returns true on
   // success and false if the requestor itself has been selected as the victim.
   // We don't abort the requestor itself but just fails the arbitration to let
   // the user decide to either proceed with the query or fail it.
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/common/memory/ByteStream.h"
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/common/memory/MmapAllocator.h"
 
@@ -100,6 +101,45 @@ TEST_F(ByteStreamTest, outputStream) {
   EXPECT_EQ(0, mmapAllocator_->numAllocated());
 }
 
+
+TEST_F(ByteStreamTest, referenceStableWrites) {
+  std::shared_ptr<StreamArena> source = newArena();
+  ByteStream stable(source.get());
+  stable.startWrite(10000);
+  std::string data(10000, 'x');
+  stable.appendStringPiece(folly::StringPiece(data.data(), data.size()));
+
+  auto out = std::make_unique<IOBufOutputStream>(*pool_);
+  out->referenceStableWrites(source);
+  std::stringstream referenceSStream;
+  OStreamOutputStream reference(&referenceSStream);
+  for (auto* stream : std::vector<OutputStream*>{out.get(), &reference}) {
+    stream->write("header", 6);
+    stable.flush(stream);
+    // Small stable writes are copied.
+    stream->writeStable("tail", 4);
+    stable.flush(stream);
+    // Overwrites the header after seeking back.
+    stream->seekp(0);
+    stream->write("HEAD", 4);
+    stream->seekp(20'010);
+  }
+  ASSERT_EQ(reference.tellp(), out->tellp());
+  VELOX_ASSERT_THROW(out->seekp(100), "Cannot seek into referenced bytes");
+
+  auto iobuf = out->getIOBuf();
+  // The flushed ranges are referenced in place.
+  bool referenced = false;
+  for (const auto& range : *iobuf) {
+    referenced |= range.data() == stable.ranges()[0].buffer;
+  }
+  ASSERT_TRUE(referenced);
+
+  // 'iobuf' keeps the source alive.
+  out.reset();
+  source.reset();
+  ASSERT_EQ(referenceSStream.str(), iobuf->moveToFbString().toStdString());
+}
 TEST_F(ByteStreamTest, resetInput) {
   uint8_t* const kFakeBuffer = reinterpret_cast<uint8_t*>(this);
   std::vector<ByteRange> byteRanges;
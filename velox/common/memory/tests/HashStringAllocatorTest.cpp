@@ -153,6 +153,42 @@ TEST_F(HashStringAllocatorTest, allocate) {
   EXPECT_LE(allocator_->retainedSize() - allocator_->freeSpace(), 250);
 }
 
+TEST_F(HashStringAllocatorTest, freeEmptyArenas) {
+  std::vector<HSA::Header*> headers;
+  // Fill a few 64KB arenas while staying under the huge page threshold.
+  for (auto i = 0; i < 150; ++i) {
+    headers.push_back(allocate(1'000));
+  }
+  // Nothing is free yet.
+  EXPECT_EQ(0, allocator_->freeEmptyArenas());
+  const auto retainedSize = allocator_->retainedSize();
+  const auto poolBytes = pool_->currentBytes();
+  for (auto* header : headers) {
+    allocator_->free(header);
+  }
+  headers.clear();
+  allocator_->checkConsistency();
+
+  // All but the arena allocations are made from are returned.
+  const auto freedBytes = allocator_->freeEmptyArenas();
+  EXPECT_GT(freedBytes, 0);
+  EXPECT_EQ(0, freedBytes % (16 * memory::AllocationTraits::kPageSize));
+  EXPECT_EQ(retainedSize - freedBytes, allocator_->retainedSize());
+  EXPECT_EQ(poolBytes - freedBytes, pool_->currentBytes());
+  EXPECT_TRUE(allocator_->isEmpty());
+  EXPECT_EQ(0, allocator_->freeEmptyArenas());
+
+  // 'allocator_' stays usable after returning arenas.
+  for (auto i = 0; i < 150; ++i) {
+    headers.push_back(allocate(1'000));
+  }
+  allocator_->checkConsistency();
+  for (auto* header : headers) {
+    allocator_->free(header);
+  }
+  EXPECT_TRUE(allocator_->isEmpty());
+}
+
 TEST_F(HashStringAllocatorTest, allocateLarge) {
   // Verify that allocate() can handle sizes larger than the largest class size
   // supported by memory allocators, that is, 256 pages.
@@ -31,6 +31,7 @@
 #include <gtest/gtest.h>
 
 DECLARE_int32(velox_memory_pool_mb);
+DECLARE_uint64(velox_memory_hugepage_min_bytes);
 
 using namespace facebook::velox::common::testutil;
 
@@ -464,6 +465,72 @@ TEST_P(MemoryAllocatorTest, mmapAllocatorInit) {
   }
 }
 
+TEST_P(MemoryAllocatorTest, mmapAllocatorNumaNode) {
+  if (!useMmap_) {
+    return;
+  }
+  EXPECT_EQ(MmapAllocator::Options{}.numaNode, -1);
+  MmapAllocator::Options options;
+  options.capacity = kCapacityBytes;
+  options.numaNode = 0;
+  auto mmapAllocator = std::make_shared<MmapAllocator>(options);
+  EXPECT_EQ(mmapAllocator->numaNode(), 0);
+  EXPECT_NE(mmapAllocator->toString().find("numa node 0"), std::string::npos);
+
+  // Binding is a preference, so allocations from size classes and large
+  // contiguous allocations behave as without a node.
+  Allocation allocation;
+  ASSERT_TRUE(mmapAllocator->allocateNonContiguous(100, allocation));
+  ContiguousAllocation contiguous;
+  const auto numLargePages = mmapAllocator->largestSizeClass() * 2;
+  ASSERT_TRUE(mmapAllocator->allocateContiguous(
+      numLargePages, nullptr, contiguous));
+  std::memset(contiguous.data(), 1, contiguous.size());
+  for (int32_t i = 0; i < allocation.numRuns(); ++i) {
+    auto run = allocation.runAt(i);
+    std::memset(run.data(), 1, run.numBytes());
+  }
+  EXPECT_TRUE(mmapAllocator->checkConsistency());
+  mmapAllocator->freeNonContiguous(allocation);
+  mmapAllocator->freeContiguous(contiguous);
+  EXPECT_EQ(mmapAllocator->numAllocated(), 0);
+}
+
+TEST_P(MemoryAllocatorTest, contiguousHugePageAlignment) {
+  if (!useMmap_) {
+    return;
+  }
+  MmapAllocator::Options options;
+  options.capacity = kCapacityBytes;
+  auto mmapAllocator = std::make_shared<MmapAllocator>(options);
+  const auto numLargePages =
+      AllocationTraits::numPages(3 * AllocationTraits::kHugePageSize);
+  {
+    ContiguousAllocation allocation;
+    ASSERT_TRUE(
+        mmapAllocator->allocateContiguous(numLargePages, nullptr, allocation));
+    EXPECT_EQ(
+        reinterpret_cast<uintptr_t>(allocation.data()) %
+            AllocationTraits::kHugePageSize,
+        0);
+    // The whole allocation is covered by huge pages.
+    EXPECT_EQ(allocation.hugePageRange().value().size(), allocation.maxSize());
+    mmapAllocator->freeContiguous(allocation);
+  }
+  {
+    gflags::FlagSaver flagSaver;
+    FLAGS_velox_memory_hugepage_min_bytes =
+        4 * AllocationTraits::kHugePageSize;
+    ContiguousAllocation allocation;
+    // Mapping below the threshold is not aligned but must still be usable.
+    ASSERT_TRUE(
+        mmapAllocator->allocateContiguous(numLargePages, nullptr, allocation));
+    std::memset(allocation.data(), 1, allocation.size());
+    mmapAllocator->freeContiguous(allocation);
+  }
+  EXPECT_EQ(mmapAllocator->numAllocated(), 0);
+}
+
 TEST_P(MemoryAllocatorTest, allocationPool) {
   const size_t kNumLargeAllocPages = instance_->largestSizeClass() * 2;
   const size_t kLarge = kNumLargeAllocPages * AllocationTraits::kPageSize;
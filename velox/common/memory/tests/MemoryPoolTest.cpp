@@ -28,6 +28,8 @@
 DECLARE_bool(velox_memory_leak_check_enabled);
 DECLARE_bool(velox_memory_pool_debug_enabled);
 DECLARE_int32(velox_memory_num_shared_leaf_pools);
+DECLARE_int64(velox_memory_pool_reservation_slack_bytes);
+DECLARE_uint64(velox_memory_pool_allocation_sample_bytes);
 
 using namespace ::testing;
 using namespace facebook::velox::cache;
@@ -3055,6 +3057,89 @@ TEST_P(MemoryPoolTest, memoryUsageUpdateCheck) {
   ASSERT_EQ(child1->stats().numShrinks, 0);
 }
 
+TEST_P(MemoryPoolTest, reservationSlack) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_velox_memory_pool_reservation_slack_bytes = 2 * MB;
+  auto manager = getMemoryManager();
+  auto root = manager->addRootPool("reservationSlack", kMaxMemory);
+  auto child = root->addLeafChild("child", isLeafThreadSafe_);
+
+  void* small = child->allocate(1024);
+  ASSERT_EQ(child->reservedBytes(), MB);
+  void* large = child->allocate(MB);
+  ASSERT_EQ(child->reservedBytes(), 2 * MB);
+  ASSERT_EQ(root->currentBytes(), 2 * MB);
+
+  // Frees keep up to the slack in the leaf pool without updating the root.
+  child->free(large, MB);
+  ASSERT_EQ(child->currentBytes(), 1024);
+  ASSERT_EQ(child->reservedBytes(), 2 * MB);
+  ASSERT_EQ(root->currentBytes(), 2 * MB);
+  large = child->allocate(MB);
+  ASSERT_EQ(child->reservedBytes(), 2 * MB);
+  child->free(large, MB);
+  child->free(small, 1024);
+  ASSERT_EQ(child->currentBytes(), 0);
+  ASSERT_EQ(child->reservedBytes(), 2 * MB);
+  ASSERT_EQ(root->currentBytes(), 2 * MB);
+
+  // Explicit release returns the slack.
+  child->release();
+  ASSERT_EQ(child->reservedBytes(), 0);
+  ASSERT_EQ(root->currentBytes(), 0);
+
+  // Pool destruction returns the slack.
+  child->free(child->allocate(MB), MB);
+  ASSERT_EQ(root->currentBytes(), MB);
+  child.reset();
+  ASSERT_EQ(root->currentBytes(), 0);
+}
+
+TEST_P(MemoryPoolTest, allocationProfile) {
+  auto manager = getMemoryManager();
+  {
+    auto root = manager->addRootPool("noSampling", kMaxMemory);
+    auto child = root->addLeafChild("child", isLeafThreadSafe_);
+    child->free(child->allocate(MB), MB);
+    ASSERT_TRUE(root->allocationProfile().empty());
+  }
+
+  gflags::FlagSaver flagSaver;
+  FLAGS_velox_memory_pool_allocation_sample_bytes = 64 * KB;
+  auto root = manager->addRootPool("sampling", kMaxMemory);
+  auto child = root->addLeafChild("child", isLeafThreadSafe_);
+  auto* childImpl = static_cast<MemoryPoolImpl*>(child.get());
+
+  // Allocations smaller than the sample interval are sampled once per
+  // interval.
+  for (int i = 0; i < 15; ++i) {
+    child->free(child->allocate(4 * KB), 4 * KB);
+  }
+  ASSERT_TRUE(childImpl->testingAllocationSites().empty());
+  child->free(child->allocate(4 * KB), 4 * KB);
+  auto sites = childImpl->testingAllocationSites();
+  ASSERT_EQ(sites.size(), 1);
+  ASSERT_EQ(sites.begin()->second.numSamples, 1);
+  ASSERT_EQ(sites.begin()->second.sampledBytes, 64 * KB);
+
+  // A large allocation accounts for all the intervals it covers.
+  child->free(child->allocate(MB), MB);
+  uint64_t numSamples{0};
+  uint64_t sampledBytes{0};
+  for (const auto& [callStack, site] : childImpl->testingAllocationSites()) {
+    ASSERT_FALSE(callStack.empty());
+    numSamples += site.numSamples;
+    sampledBytes += site.sampledBytes;
+  }
+  ASSERT_EQ(numSamples, 17);
+  ASSERT_EQ(sampledBytes, 64 * KB + MB);
+
+  const auto profile = root->allocationProfile();
+  ASSERT_NE(profile.find("sampling/child: "), std::string::npos) << profile;
+  ASSERT_NE(
+      manager->allocationProfile().find("sampling/child: "), std::string::npos);
+}
+
 TEST_P(MemoryPoolTest, maybeReserve) {
   constexpr int64_t kMaxSize = 1 << 30; // 1GB
   setupMemory({.capacity = kMaxSize});
@@ -66,11 +66,17 @@ class MockTask : public std::enable_shared_from_this<MockTask> {
 
   class MemoryReclaimer : public memory::MemoryReclaimer {
    public:
-    MemoryReclaimer(const std::shared_ptr<MockTask>& task) : task_(task) {}
+    MemoryReclaimer(const std::shared_ptr<MockTask>& task, int32_t priority)
+        : task_(task), priority_(priority) {}
 
     static std::unique_ptr<MemoryReclaimer> create(
-        const std::shared_ptr<MockTask>& task) {
-      return std::make_unique<MemoryReclaimer>(task);
+        const std::shared_ptr<MockTask>& task,
+        int32_t priority = 0) {
+      return std::make_unique<MemoryReclaimer>(task, priority);
+    }
+
+    int32_t priority() const override {
+      return priority_;
     }
 
     void abort(MemoryPool* pool, const std::exception_ptr& error) override {
@@ -84,13 +90,17 @@ class MockTask : public std::enable_shared_from_this<MockTask> {
 
    private:
     std::weak_ptr<MockTask> task_;
+    const int32_t priority_;
   };
 
-  void initTaskPool(MemoryManager* manager, uint64_t capacity) {
+  void initTaskPool(
+      MemoryManager* manager,
+      uint64_t capacity,
+      int32_t priority = 0) {
     root_ = manager->addRootPool(
         fmt::format("RootPool-{}", poolId_++),
         capacity,
-        MemoryReclaimer::create(shared_from_this()));
+        MemoryReclaimer::create(shared_from_this(), priority));
   }
 
   MemoryPool* pool() const {
@@ -424,9 +434,11 @@ class MockSharedArbitrationTest : public testing::Test {
     arbitrator_ = static_cast<SharedArbitrator*>(manager_->arbitrator());
   }
 
-  std::shared_ptr<MockTask> addTask(int64_t capacity = kMaxMemory) {
+  std::shared_ptr<MockTask> addTask(
+      int64_t capacity = kMaxMemory,
+      int32_t priority = 0) {
     auto task = std::make_shared<MockTask>();
-    task->initTaskPool(manager_.get(), capacity);
+    task->initTaskPool(manager_.get(), capacity, priority);
     return task;
   }
 
@@ -1868,6 +1880,73 @@ TEST_F(MockSharedArbitrationTest, arbitrationFailure) {
   }
 }
 
+TEST_F(MockSharedArbitrationTest, abortByPriority) {
+  const int64_t maxCapacity = 128 * MB;
+  struct {
+    int32_t requestorPriority;
+    int32_t otherPriority;
+    bool expectedOtherAborted;
+
+    std::string debugString() const {
+      return fmt::format(
+          "requestorPriority {} otherPriority {} expectedOtherAborted {}",
+          requestorPriority,
+          otherPriority,
+          expectedOtherAborted);
+    }
+  } testSettings[] = {{0, 0, true}, {1, 0, true}, {0, 1, false}};
+
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(testData.debugString());
+    setupMemory(maxCapacity, 0, 1 * MB);
+    auto requestorTask = addTask(kMaxMemory, testData.requestorPriority);
+    auto* requestorOp = addMemoryOp(requestorTask, false);
+    requestorOp->allocate(32 * MB);
+    auto otherTask = addTask(kMaxMemory, testData.otherPriority);
+    auto* otherOp = addMemoryOp(otherTask, false);
+    otherOp->allocate(96 * MB);
+
+    // The larger query is only aborted if it doesn't have a higher priority
+    // than the requestor.
+    if (testData.expectedOtherAborted) {
+      requestorOp->allocate(32 * MB);
+      ASSERT_TRUE(otherOp->pool()->aborted());
+    } else {
+      VELOX_ASSERT_THROW(requestorOp->allocate(32 * MB), "");
+      ASSERT_FALSE(otherOp->pool()->aborted());
+    }
+    ASSERT_FALSE(requestorOp->pool()->aborted());
+  }
+}
+
+DEBUG_ONLY_TEST_F(MockSharedArbitrationTest, reclaimByPriority) {
+  SCOPED_TESTVALUE_SET(
+      "facebook::velox::memory::SharedArbitrator::sortCandidatesByReclaimableMemory",
+      std::function<void(const std::vector<SharedArbitrator::Candidate>*)>(
+          ([&](const std::vector<SharedArbitrator::Candidate>* candidates) {
+            for (int i = 1; i < candidates->size(); ++i) {
+              ASSERT_LE(
+                  (*candidates)[i - 1].priority, (*candidates)[i].priority);
+            }
+          })));
+  const uint64_t memCapacity = 128 * MB;
+  setupMemory(memCapacity, 0, 8 * MB);
+  auto highPriorityTask = addTask(kMaxMemory, 1);
+  auto* highPriorityOp = addMemoryOp(highPriorityTask);
+  highPriorityOp->allocate(64 * MB);
+  auto lowPriorityTask = addTask(kMaxMemory, 0);
+  auto* lowPriorityOp = addMemoryOp(lowPriorityTask);
+  lowPriorityOp->allocate(32 * MB);
+  auto* arbitrateOp = addMemoryOp(nullptr, false);
+  arbitrateOp->allocate(32 * MB);
+
+  // The smaller, low priority query is reclaimed before the larger one.
+  arbitrateOp->allocate(16 * MB);
+  ASSERT_GT(lowPriorityOp->reclaimer()->stats().numReclaims, 0);
+  ASSERT_EQ(highPriorityOp->reclaimer()->stats().numReclaims, 0);
+  ASSERT_EQ(highPriorityOp->capacity(), 64 * MB);
+}
+
 TEST_F(MockSharedArbitrationTest, concurrentArbitrations) {
   const int numTasks = 10;
   const int numOpsPerTask = 5;
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/common/memory/ScratchArena.h"
+#include "velox/common/memory/Memory.h"
+
+#include <gtest/gtest.h>
+#include <cstring>
+
+using namespace facebook::velox;
+using namespace facebook::velox::memory;
+
+class ScratchArenaTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    pool_ = addDefaultLeafMemoryPool();
+  }
+
+  std::shared_ptr<MemoryPool> pool_;
+};
+
+TEST_F(ScratchArenaTest, allocateAndRewind) {
+  ScratchArena arena(pool_.get());
+  ASSERT_EQ(arena.retainedBytes(), 0);
+  const auto start = arena.mark();
+
+  auto* first = arena.allocate<int32_t>(10);
+  auto* second = arena.allocate<int32_t>(10);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(first) % ScratchArena::kAlignment, 0);
+  ASSERT_EQ(reinterpret_cast<uintptr_t>(second) % ScratchArena::kAlignment, 0);
+  ASSERT_GE(
+      reinterpret_cast<char*>(second), reinterpret_cast<char*>(first + 10));
+  const auto retained = arena.retainedBytes();
+  ASSERT_GT(retained, 0);
+  ASSERT_EQ(pool_->currentBytes(), retained);
+
+  // Nested users reuse the memory in stack order.
+  const auto nested = arena.mark();
+  auto* third = arena.allocate<int64_t>(100);
+  arena.rewind(nested);
+  ASSERT_EQ(arena.allocate<int64_t>(100), third);
+
+  // Rewinding to a mark that is no longer valid is a no-op.
+  arena.rewind(start);
+  arena.rewind(nested);
+  ASSERT_EQ(arena.allocate<int32_t>(10), first);
+  ASSERT_EQ(arena.retainedBytes(), retained);
+  ASSERT_EQ(pool_->currentBytes(), retained);
+}
+
+TEST_F(ScratchArenaTest, largeAllocations) {
+  ScratchArena arena(pool_.get());
+  const auto start = arena.mark();
+  auto* small = reinterpret_cast<char*>(arena.allocate(100));
+  // Larger than a chunk.
+  auto* large = reinterpret_cast<char*>(arena.allocate(1 << 20));
+  std::memset(large, 1, 1 << 20);
+  std::memset(small, 1, 100);
+  ASSERT_GT(arena.retainedBytes(), 1 << 20);
+
+  // The chunks are kept up to a limit on rewind to the start.
+  arena.rewind(start);
+  ASSERT_LE(arena.retainedBytes(), 1 << 20);
+  ASSERT_EQ(pool_->currentBytes(), arena.retainedBytes());
+  for (int i = 0; i < 100; ++i) {
+    arena.allocate(10 << 10);
+  }
+  arena.rewind(start);
+  ASSERT_LE(arena.retainedBytes(), 1 << 20);
+  ASSERT_EQ(pool_->currentBytes(), arena.retainedBytes());
+}
+
+TEST_F(ScratchArenaTest, destruction) {
+  {
+    ScratchArena arena(pool_.get());
+    arena.allocate(1 << 20);
+    arena.allocate(100);
+    ASSERT_GT(pool_->currentBytes(), 0);
+  }
+  ASSERT_EQ(pool_->currentBytes(), 0);
+}
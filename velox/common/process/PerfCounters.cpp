@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/PerfCounters.h"
+
+#include <fmt/format.h>
+#include <memory>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+namespace facebook::velox::process {
+
+std::string PerfCounterValues::toString() const {
+  return fmt::format(
+      "cycles: {}, instructions: {}, llcMisses: {}, branchMisses: {}",
+      cycles,
+      instructions,
+      llcMisses,
+      branchMisses);
+}
+
+// static
+ThreadPerfCounters* ThreadPerfCounters::get() {
+  // Tries once per thread. 'counters' stays null if open fails.
+  thread_local std::unique_ptr<ThreadPerfCounters> counters;
+  thread_local bool initialized = false;
+  if (!initialized) {
+    initialized = true;
+    std::unique_ptr<ThreadPerfCounters> newCounters(new ThreadPerfCounters());
+    if (newCounters->open()) {
+      counters = std::move(newCounters);
+    }
+  }
+  return counters.get();
+}
+
+#ifdef __linux__
+namespace {
+int openEvent(uint32_t type, uint64_t config, int groupFd) {
+  struct perf_event_attr attr;
+  memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = type;
+  attr.config = config;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+  attr.disabled = groupFd == -1 ? 1 : 0;
+  // Counts the calling thread on any CPU.
+  return syscall(__NR_perf_event_open, &attr, 0, -1, groupFd, 0);
+}
+} // namespace
+
+bool ThreadPerfCounters::open() {
+  fds_[0] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, -1);
+  if (fds_[0] == -1) {
+    return false;
+  }
+  fds_[1] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, fds_[0]);
+  fds_[2] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, fds_[0]);
+  fds_[3] = openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES, fds_[0]);
+  ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+  ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  return true;
+}
+
+ThreadPerfCounters::~ThreadPerfCounters() {
+  for (auto fd : fds_) {
+    if (fd != -1) {
+      close(fd);
+    }
+  }
+}
+
+PerfCounterValues ThreadPerfCounters::read() const {
+  // PERF_FORMAT_GROUP layout: the number of events followed by their values
+  // in the order the events were opened. Events that failed to open are not
+  // in the group and their values stay 0.
+  uint64_t buffer[1 + 4] = {};
+  if (::read(fds_[0], buffer, sizeof(buffer)) <= 0) {
+    return {};
+  }
+  uint64_t* values[4];
+  PerfCounterValues result;
+  values[0] = &result.cycles;
+  values[1] = &result.instructions;
+  values[2] = &result.llcMisses;
+  values[3] = &result.branchMisses;
+  uint64_t next = 0;
+  for (int32_t i = 0; i < 4 && next < buffer[0]; ++i) {
+    if (fds_[i] != -1) {
+      *values[i] = buffer[1 + next++];
+    }
+  }
+  return result;
+}
+#else
+bool ThreadPerfCounters::open() {
+  return false;
+}
+
+ThreadPerfCounters::~ThreadPerfCounters() = default;
+
+PerfCounterValues ThreadPerfCounters::read() const {
+  return {};
+}
+#endif
+
+} // namespace facebook::velox::process
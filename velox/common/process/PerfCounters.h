@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace facebook::velox::process {
+
+/// Values of the hardware counters of a thread. See ThreadPerfCounters.
+struct PerfCounterValues {
+  uint64_t cycles{0};
+  uint64_t instructions{0};
+  uint64_t llcMisses{0};
+  uint64_t branchMisses{0};
+
+  PerfCounterValues operator-(const PerfCounterValues& other) const {
+    return {
+        cycles - other.cycles,
+        instructions - other.instructions,
+        llcMisses - other.llcMisses,
+        branchMisses - other.branchMisses};
+  }
+
+  std::string toString() const;
+};
+
+/// Counts CPU cycles, instructions, last level cache misses and branch misses
+/// of the calling thread in user space using a perf_event group. Each thread
+/// opens its group on first use. The counters are unavailable on non-Linux
+/// systems and where perf_event_open is not permitted, e.g. with
+/// kernel.perf_event_paranoid above 2 or in containers without
+/// CAP_PERFMON.
+class ThreadPerfCounters {
+ public:
+  /// Returns the counters of the calling thread or nullptr if they can not be
+  /// opened.
+  static ThreadPerfCounters* get();
+
+  ~ThreadPerfCounters();
+
+  /// Returns the current values. Costs one read system call.
+  PerfCounterValues read() const;
+
+ private:
+  ThreadPerfCounters() = default;
+
+  // Opens the counter group. Returns false if the leader can not be opened.
+  bool open();
+
+  // File descriptors of the leader (cycles) and the other events.
+  int fds_[4]{-1, -1, -1, -1};
+};
+
+} // namespace facebook::velox::process
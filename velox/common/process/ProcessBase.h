@@ -63,6 +63,11 @@ bool hasAvx2();
 // flag.
 bool hasBmi2();
 
+// True if the machine has AVX-512 Foundation instructions and these are not
+// disabled by flag. Unlike hasAvx2(), this does not depend on the target of
+// the build: the callers select functions compiled for AVX-512 at runtime.
+bool hasAvx512();
+
 } // namespace process
 } // namespace velox
 } // namespace facebook
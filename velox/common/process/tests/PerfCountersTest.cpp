@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/process/PerfCounters.h"
+#include <gtest/gtest.h>
+#include <thread>
+
+using namespace facebook::velox::process;
+
+TEST(PerfCountersTest, basic) {
+  auto* counters = ThreadPerfCounters::get();
+  if (counters == nullptr) {
+    GTEST_SKIP() << "perf events are not available";
+  }
+  // The same thread gets the same counters.
+  ASSERT_EQ(counters, ThreadPerfCounters::get());
+
+  const auto start = counters->read();
+  volatile uint64_t sum = 0;
+  for (auto i = 0; i < 1'000'000; ++i) {
+    sum += i;
+  }
+  const auto delta = counters->read() - start;
+  EXPECT_GT(delta.cycles, 0);
+  EXPECT_GT(delta.instructions, 1'000'000);
+
+  // Other threads get their own counters.
+  ThreadPerfCounters* otherCounters = nullptr;
+  std::thread([&]() { otherCounters = ThreadPerfCounters::get(); }).join();
+  EXPECT_NE(counters, otherCounters);
+}
@@ -110,6 +110,19 @@ std::shared_ptr<cache::ScanTracker> Connector::getTracker(
   });
 }
 
+// static
+std::shared_ptr<cache::ScanTracker> Connector::findTracker(
+    const std::string& scanId) {
+  return trackers_.withRLock(
+      [&](const auto& trackers) -> std::shared_ptr<cache::ScanTracker> {
+        auto it = trackers.find(scanId);
+        if (it == trackers.end()) {
+          return nullptr;
+        }
+        return it->second.lock();
+      });
+}
+
 std::string commitStrategyToString(CommitStrategy commitStrategy) {
   switch (commitStrategy) {
     case CommitStrategy::kNoCommit:
@@ -45,6 +45,10 @@ struct ConnectorSplit {
 
   std::unique_ptr<AsyncSource<DataSource>> dataSource;
 
+  // Estimated bytes read by the preload of 'dataSource'. Reserved from the
+  // preload budget of the TableScan until a driver takes the split.
+  uint64_t preloadBytes{0};
+
   explicit ConnectorSplit(const std::string& _connectorId)
       : connectorId(_connectorId) {}
 
@@ -53,6 +57,30 @@ struct ConnectorSplit {
   virtual std::string toString() const {
     return fmt::format("[split: {}]", connectorId);
   }
+
+  // Returns the size in bytes of the data covered by the split or 0 if not
+  // known.
+  virtual uint64_t size() const {
+    return 0;
+  }
+
+  // Returns a key that is the same for splits that read the same data source,
+  // e.g. ranges of the same file, or an empty string if there is no such
+  // relation. Task gives a driver a split with the key of its previous split
+  // when it can, so that reads of a file stay sequential on one driver.
+  virtual std::string affinityKey() const {
+    return "";
+  }
+
+  // Returns a key that identifies the data the split reads, or an empty
+  // string if the split is not cacheable. Splits with the same key must read
+  // the same data, so the key must change when the data does, e.g. by
+  // including a version or modification time of the file. Table scans cache
+  // their output per split under this key. See
+  // QueryConfig::kFragmentResultCacheEnabled.
+  virtual std::string cacheKey() const {
+    return "";
+  }
 };
 
 class ColumnHandle : public ISerializable {
@@ -160,6 +188,24 @@ class DataSink {
   virtual std::vector<std::string> close(bool success) = 0;
 };
 
+/// An aggregate over the rows of a split that pass the filters of a scan. A
+/// DataSource may compute these from file statistics instead of reading the
+/// split, see DataSource::aggregateFromStatistics().
+struct StatisticsAggregate {
+  enum class Kind {
+    /// count(*) if 'column' is empty, count('column') otherwise.
+    kCount,
+    kMin,
+    kMax,
+    kNullCount,
+  };
+
+  Kind kind;
+
+  /// Name of a column of the DataSource output type. Empty for count(*).
+  std::string column;
+};
+
 class DataSource {
  public:
   static constexpr int64_t kUnknownRowSize = -1;
@@ -221,6 +267,19 @@ class DataSource {
   virtual int64_t estimatedRowSize() {
     return kUnknownRowSize;
   }
+
+  // Returns the values of 'aggregates' over the rows of the split added by
+  // addSplit() that pass the filters, computed from file statistics without
+  // reading column data. There is one value per aggregate: BIGINT for counts
+  // and the column type for min and max, null if no row passes. The split is
+  // fully processed when this returns a value. Returns std::nullopt, without
+  // consuming the split, if statistics cannot answer all of 'aggregates', e.g.
+  // if the filters pass only part of the rows. The caller then reads the split
+  // with next().
+  virtual std::optional<std::vector<variant>> aggregateFromStatistics(
+      const std::vector<StatisticsAggregate>& /*aggregates*/) {
+    return std::nullopt;
+  }
 };
 
 /// Collection of context data for use in a DataSource or DataSink. One instance
@@ -384,6 +443,11 @@ class Connector {
       const std::string& scanId,
       int32_t loadQuantum);
 
+  // Returns the ScanTracker for 'scanId' or nullptr if no scan has created
+  // one.
+  static std::shared_ptr<cache::ScanTracker> findTracker(
+      const std::string& scanId);
+
   virtual folly::Executor* FOLLY_NULLABLE executor() const {
     return nullptr;
   }
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/connectors/hive/FileStatisticsIndex.h"
+
+namespace facebook::velox::connector::hive {
+
+std::shared_ptr<const FileStatistics> FileStatisticsIndex::find(
+    const std::string& path) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto statistics = cache_.get(path);
+  return statistics.has_value() ? statistics.value() : nullptr;
+}
+
+void FileStatisticsIndex::add(
+    const std::string& path,
+    std::shared_ptr<const FileStatistics> statistics) {
+  std::lock_guard<std::mutex> l(mutex_);
+  cache_.add(path, std::move(statistics));
+}
+
+void FileStatisticsIndex::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  cache_.clear();
+}
+
+SimpleLRUCacheStats FileStatisticsIndex::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return cache_.getStats();
+}
+
+} // namespace facebook::velox::connector::hive
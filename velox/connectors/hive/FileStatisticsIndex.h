@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <mutex>
+
+#include "velox/common/caching/SimpleLRUCache.h"
+#include "velox/dwio/common/Statistics.h"
+#include "velox/type/Type.h"
+
+namespace facebook::velox::connector::hive {
+
+/// File level statistics of the top level columns of a file.
+struct FileStatistics {
+  RowTypePtr rowType;
+  uint64_t numRows{0};
+  /// Statistics of the children of 'rowType'. nullptr if not known.
+  std::vector<std::shared_ptr<dwio::common::ColumnStatistics>> columns;
+};
+
+/// Index of FileStatistics by file path. Filled with the statistics of the
+/// files the Hive connector opens, or by the embedding system, e.g. from a
+/// statistics sidecar of the table. A split whose file statistics are indexed
+/// and cannot match the filters of a scan is skipped without opening the
+/// file. The index is keyed by path only, so files must not be replaced in
+/// place while their statistics are indexed. Thread-safe.
+class FileStatisticsIndex {
+ public:
+  /// 'maxFiles' is the number of files with indexed statistics.
+  explicit FileStatisticsIndex(size_t maxFiles) : cache_(maxFiles) {}
+
+  /// Returns the statistics of 'path' or nullptr if not indexed.
+  std::shared_ptr<const FileStatistics> find(const std::string& path);
+
+  /// Indexes 'statistics' of 'path'. Keeps the existing statistics if 'path'
+  /// is already indexed.
+  void add(
+      const std::string& path,
+      std::shared_ptr<const FileStatistics> statistics);
+
+  void clear();
+
+  SimpleLRUCacheStats stats() const;
+
+ private:
+  mutable std::mutex mutex_;
+  SimpleLRUCache<std::string, std::shared_ptr<const FileStatistics>> cache_;
+};
+
+} // namespace facebook::velox::connector::hive
@@ -66,6 +66,11 @@ uint32_t HiveConfig::maxPartitionsPerWriters(const Config* config) {
   return config->get<uint32_t>(kMaxPartitionsPerWriters, 100);
 }
 
+// static
+uint64_t HiveConfig::maxPartitionWritersBufferedBytes(const Config* config) {
+  return config->get<uint64_t>(kMaxPartitionWritersBufferedBytes, 0);
+}
+
 // static
 bool HiveConfig::immutablePartitions(const Config* config) {
   return config->get<bool>(kImmutablePartitions, false);
@@ -125,6 +130,16 @@ std::string HiveConfig::s3IAMRoleSessionName(const Config* config) {
   return config->get(kS3IamRoleSessionName, std::string("velox-session"));
 }
 
+// static
+int32_t HiveConfig::s3MaxAsyncReads(const Config* config) {
+  return config->get<int32_t>(kS3MaxAsyncReads, 64);
+}
+
+// static
+uint64_t HiveConfig::s3ReadPartSize(const Config* config) {
+  return config->get<uint64_t>(kS3ReadPartSize, 8UL << 20);
+}
+
 // static
 std::string HiveConfig::gcsEndpoint(const Config* config) {
   return config->get<std::string>(kGCSEndpoint, std::string(""));
@@ -165,4 +180,19 @@ int32_t HiveConfig::numCacheFileHandles(const Config* config) {
   return config->get<int32_t>(kNumCacheFileHandles, 20'000);
 }
 
+// static.
+int32_t HiveConfig::numIndexedFileStatistics(const Config* config) {
+  return config->get<int32_t>(kNumIndexedFileStatistics, 0);
+}
+
+// static.
+double HiveConfig::hedgedReadPercentile(const Config* config) {
+  return config->get<double>(kHedgedReadPercentile, 0);
+}
+
+// static.
+double HiveConfig::maxHedgedReadRatio(const Config* config) {
+  return config->get<double>(kMaxHedgedReadRatio, 0.05);
+}
+
 } // namespace facebook::velox::connector::hive
@@ -44,6 +44,12 @@ class HiveConfig {
   static constexpr const char* kMaxPartitionsPerWriters =
       "max_partitions_per_writers";
 
+  /// Maximum estimated bytes of input buffered across all the open partition
+  /// writers of a single table writer instance. Once exceeded, the writers
+  /// holding the most buffered input are flushed. 0 means no limit.
+  static constexpr const char* kMaxPartitionWritersBufferedBytes =
+      "max_partition_writers_buffered_bytes";
+
   /// Whether new data can be inserted into an unpartition table.
   /// Velox currently does not support appending data to existing partitions.
   static constexpr const char* kImmutablePartitions =
@@ -81,6 +87,14 @@ class HiveConfig {
   static constexpr const char* kS3IamRoleSessionName =
       "hive.s3.iam-role-session-name";
 
+  /// Maximum number of asynchronous reads in flight per S3 file system. 0
+  /// reads synchronously on the calling thread.
+  static constexpr const char* kS3MaxAsyncReads = "hive.s3.max-async-reads";
+
+  /// Maximum size of a single GET request for a range of an S3 object. Larger
+  /// ranges are read by multiple requests.
+  static constexpr const char* kS3ReadPartSize = "hive.s3.read-part-size";
+
   // The GCS storage endpoint server.
   static constexpr const char* kGCSEndpoint = "hive.gcs.endpoint";
 
@@ -107,11 +121,28 @@ class HiveConfig {
   /// Maximum number of entries in the file handle cache.
   static constexpr const char* kNumCacheFileHandles = "num_cached_file_handles";
 
+  /// Maximum number of files whose column statistics are indexed by path to
+  /// skip splits that cannot match the filters without opening the files. 0
+  /// disables the index. Must only be enabled if files are not replaced in
+  /// place.
+  static constexpr const char* kNumIndexedFileStatistics =
+      "num_indexed_file_statistics";
+
+  /// A storage read taking longer than this percentile of the latencies of
+  /// recent reads is issued again and the first to complete is used. Reads
+  /// are hedged on the IO executor of the connector. 0 disables hedging.
+  static constexpr const char* kHedgedReadPercentile = "hedged_read_percentile";
+
+  /// Maximum number of hedged reads as a fraction of all the storage reads.
+  static constexpr const char* kMaxHedgedReadRatio = "max_hedged_read_ratio";
+
   static InsertExistingPartitionsBehavior insertExistingPartitionsBehavior(
       const Config* config);
 
   static uint32_t maxPartitionsPerWriters(const Config* config);
 
+  static uint64_t maxPartitionWritersBufferedBytes(const Config* config);
+
   static bool immutablePartitions(const Config* config);
 
   static bool s3UseVirtualAddressing(const Config* config);
@@ -132,6 +163,10 @@ class HiveConfig {
 
   static std::string s3IAMRoleSessionName(const Config* config);
 
+  static int32_t s3MaxAsyncReads(const Config* config);
+
+  static uint64_t s3ReadPartSize(const Config* config);
+
   static std::string gcsEndpoint(const Config* config);
 
   static std::string gcsScheme(const Config* config);
@@ -147,6 +182,12 @@ class HiveConfig {
   static int32_t maxCoalescedDistanceBytes(const Config* config);
 
   static int32_t numCacheFileHandles(const Config* config);
+
+  static int32_t numIndexedFileStatistics(const Config* config);
+
+  static double hedgedReadPercentile(const Config* config);
+
+  static double maxHedgedReadRatio(const Config* config);
 };
 
 } // namespace facebook::velox::connector::hive
@@ -31,6 +31,7 @@
 #ifdef VELOX_ENABLE_S3
 #include "velox/connectors/hive/storage_adapters/s3fs/RegisterS3FileSystem.h" // @manual
 #endif
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/dwrf/reader/DwrfReader.h"
 #include "velox/dwio/dwrf/writer/Writer.h"
 // Meta's buck build system needs this check.
@@ -41,6 +42,7 @@
 #include "velox/expression/FieldReference.h"
 
 #include <boost/lexical_cast.hpp>
+#include <folly/futures/Future.h>
 #include <memory>
 
 using namespace facebook::velox::exec;
@@ -63,11 +65,58 @@ HiveConnector::HiveConnector(
               numCachedFileHandles(properties.get())),
           std::make_unique<FileHandleGenerator>(properties)),
       executor_(executor) {
+  if (properties) {
+    const auto numIndexedFiles =
+        HiveConfig::numIndexedFileStatistics(properties.get());
+    if (numIndexedFiles > 0) {
+      statisticsIndex_ = std::make_unique<FileStatisticsIndex>(numIndexedFiles);
+    }
+    const auto hedgedReadPercentile =
+        HiveConfig::hedgedReadPercentile(properties.get());
+    if (hedgedReadPercentile > 0 && executor_ != nullptr) {
+      HedgedReadPolicy::Options options;
+      options.percentile = hedgedReadPercentile;
+      options.maxHedgeRatio = HiveConfig::maxHedgedReadRatio(properties.get());
+      hedgedReadPolicy_ =
+          std::make_shared<HedgedReadPolicy>(executor_, options);
+    }
+  }
   LOG(INFO) << "Hive connector " << connectorId() << " created with maximum of "
             << numCachedFileHandles(properties.get())
             << " cached file handles.";
 }
 
+int32_t HiveConnector::warmFileHandles(
+    const std::vector<std::string>& filePaths) {
+  std::atomic<int32_t> numOpened{0};
+  auto open = [&](const std::string& filePath) {
+    try {
+      if (!fileHandleFactory_.generate(filePath).first) {
+        ++numOpened;
+      }
+    } catch (const std::exception& e) {
+      LOG(WARNING) << "Hive connector " << connectorId()
+                   << " failed to warm the file handle of " << filePath << ": "
+                   << e.what();
+    }
+  };
+  if (executor_ == nullptr) {
+    for (const auto& filePath : filePaths) {
+      open(filePath);
+    }
+    return numOpened;
+  }
+  std::vector<folly::SemiFuture<folly::Unit>> futures;
+  futures.reserve(filePaths.size());
+  for (const auto& filePath : filePaths) {
+    futures.push_back(
+        folly::via(executor_, [&open, &filePath]() { open(filePath); })
+            .semi());
+  }
+  folly::collectAll(std::move(futures)).wait();
+  return numOpened;
+}
+
 std::unique_ptr<DataSource> HiveConnector::createDataSource(
     const RowTypePtr& outputType,
     const std::shared_ptr<ConnectorTableHandle>& tableHandle,
@@ -85,6 +134,7 @@ std::unique_ptr<DataSource> HiveConnector::createDataSource(
           connectorQueryCtx->config()));
   options.setUseColumnNamesForColumnMapping(
       HiveConfig::isOrcUseColumnNames(connectorQueryCtx->config()));
+  options.setFileMetadataCache(dwio::common::FileMetadataCache::getInstance());
 
   return std::make_unique<HiveDataSource>(
       outputType,
@@ -95,7 +145,9 @@ std::unique_ptr<DataSource> HiveConnector::createDataSource(
       connectorQueryCtx->cache(),
       connectorQueryCtx->scanId(),
       executor_,
-      options);
+      options,
+      statisticsIndex_.get(),
+      hedgedReadPolicy_);
 }
 
 std::unique_ptr<DataSink> HiveConnector::createDataSink(
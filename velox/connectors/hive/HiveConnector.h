@@ -15,8 +15,10 @@
  */
 #pragma once
 
+#include "velox/common/file/HedgedReadFile.h"
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/FileHandle.h"
+#include "velox/connectors/hive/FileStatisticsIndex.h"
 #include "velox/core/PlanNode.h"
 
 namespace facebook::velox::dwio::common {
@@ -69,9 +71,28 @@ class HiveConnector : public Connector {
     return fileHandleFactory_.clearCache();
   }
 
+  // Opens 'filePaths' and adds their handles to the file handle cache, e.g.
+  // for the hot files at startup. This also creates and connects the clients
+  // of their file systems, so that the first queries do not pay for either.
+  // The files are opened in parallel on 'executor_' if set. Files that fail to
+  // open are logged and skipped. Returns the number of files opened, i.e. not
+  // already in the cache.
+  int32_t warmFileHandles(const std::vector<std::string>& filePaths);
+
+  // Returns the index of file statistics used to skip splits without opening
+  // their files, or nullptr if 'num_indexed_file_statistics' is 0. The
+  // embedding system may add statistics it has from other sources.
+  FileStatisticsIndex* FOLLY_NULLABLE fileStatisticsIndex() const {
+    return statisticsIndex_.get();
+  }
+
  protected:
   FileHandleFactory fileHandleFactory_;
+  std::unique_ptr<FileStatisticsIndex> statisticsIndex_;
   folly::Executor* FOLLY_NULLABLE executor_;
+  // Decides which storage reads are hedged. nullptr if hedging is disabled or
+  // there is no 'executor_'.
+  std::shared_ptr<HedgedReadPolicy> hedgedReadPolicy_;
 };
 
 class HiveConnectorFactory : public ConnectorFactory {
@@ -15,8 +15,10 @@
  */
 #pragma once
 
+#include <map>
 #include <optional>
 #include <unordered_map>
+#include <folly/hash/Hash.h>
 #include "velox/connectors/Connector.h"
 #include "velox/dwio/common/Options.h"
 
@@ -33,6 +35,11 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
   std::unordered_map<std::string, std::string> customSplitInfo;
   std::shared_ptr<std::string> extraFileInfo;
   std::unordered_map<std::string, std::string> serdeParameters;
+  /// Sorted positions of the deleted rows of the file, e.g. from the
+  /// positional delete files of an Iceberg data file. The reader skips these
+  /// rows before decoding the columns. May be shared between the splits of the
+  /// file.
+  std::shared_ptr<const std::vector<int64_t>> deletedRows;
 
   HiveConnectorSplit(
       const std::string& connectorId,
@@ -69,10 +76,64 @@ struct HiveConnectorSplit : public connector::ConnectorSplit {
     return fmt::format("Hive: {} {} - {}", filePath, start, length);
   }
 
+  uint64_t size() const override {
+    return length == std::numeric_limits<uint64_t>::max() ? 0 : length;
+  }
+
+  std::string affinityKey() const override {
+    return filePath;
+  }
+
+  /// Includes everything that determines the rows of the split. The file is
+  /// assumed not to change under the same path and 'customSplitInfo'. A
+  /// scheduler that rewrites files in place must put the modification time of
+  /// the file into 'customSplitInfo'.
+  std::string cacheKey() const override {
+    auto key = fmt::format(
+        "{}\n{}\n{}\n{}\n{}",
+        filePath,
+        dwio::common::toString(fileFormat),
+        start,
+        length,
+        tableBucketNumber.has_value() ? tableBucketNumber.value() : -1);
+    const auto appendSorted = [&](const auto& map) {
+      std::map<std::string, std::string> sorted;
+      for (const auto& [name, value] : map) {
+        sorted[name] = toValueString(value);
+      }
+      for (const auto& [name, value] : sorted) {
+        key.append(fmt::format("\n{}={}", name, value));
+      }
+      key.push_back('\n');
+    };
+    appendSorted(partitionKeys);
+    appendSorted(customSplitInfo);
+    appendSorted(serdeParameters);
+    if (extraFileInfo != nullptr) {
+      key.append(*extraFileInfo);
+    }
+    if (deletedRows != nullptr && !deletedRows->empty()) {
+      key.append(fmt::format(
+          "\ndeleted={}:{:x}",
+          deletedRows->size(),
+          folly::hash::hash_range(deletedRows->begin(), deletedRows->end())));
+    }
+    return key;
+  }
+
   std::string getFileName() const {
     auto i = filePath.rfind('/');
     return i == std::string::npos ? filePath : filePath.substr(i + 1);
   }
+
+ private:
+  static std::string toValueString(const std::optional<std::string>& value) {
+    return value.has_value() ? "'" + value.value() + "'" : "null";
+  }
+
+  static const std::string& toValueString(const std::string& value) {
+    return value;
+  }
 };
 
 } // namespace facebook::velox::connector::hive
@@ -283,6 +283,8 @@ HiveDataSink::HiveDataSink(
       connectorProperties_(connectorProperties),
       maxOpenWriters_(
           HiveConfig::maxPartitionsPerWriters(connectorQueryCtx_->config())),
+      maxBufferedBytes_(HiveConfig::maxPartitionWritersBufferedBytes(
+          connectorQueryCtx_->config())),
       partitionChannels_(getPartitionChannels(insertTableHandle_)),
       partitionIdGenerator_(
           !partitionChannels_.empty() ? std::make_unique<PartitionIdGenerator>(
@@ -341,8 +343,8 @@ void HiveDataSink::appendData(RowVectorPtr input) {
   // Write to unpartitioned table.
   if (!isPartitioned()) {
     const auto index = ensureWriter(HiveWriterId::unpartitionedId());
-    writers_[index]->write(input);
-    writerInfo_[index]->numWrittenRows += input->size();
+    write(index, input);
+    maybeFlushWriters();
     return;
   }
 
@@ -358,8 +360,8 @@ void HiveDataSink::appendData(RowVectorPtr input) {
   // be zero.
   if (!isBucketed() && partitionIdGenerator_->numPartitions() == 1) {
     const auto index = ensureWriter(HiveWriterId{0});
-    writers_[index]->write(input);
-    writerInfo_[index]->numWrittenRows += input->size();
+    write(index, input);
+    maybeFlushWriters();
     return;
   }
 
@@ -374,8 +376,49 @@ void HiveDataSink::appendData(RowVectorPtr input) {
     RowVectorPtr writerInput = partitionSize == input->size()
         ? input
         : exec::wrap(partitionSize, partitionRows_[index], input);
-    writers_[index]->write(writerInput);
-    writerInfo_[index]->numWrittenRows += partitionSize;
+    write(index, writerInput);
+  }
+  maybeFlushWriters();
+}
+
+void HiveDataSink::write(size_t index, const RowVectorPtr& input) {
+  writers_[index]->write(input);
+  writerInfo_[index]->numWrittenRows += input->size();
+  // A sorting writer buffers its input in a spillable sort buffer and writes
+  // nothing out before close, so there is nothing to flush.
+  if (maxBufferedBytes_ == 0 || !sortColumnIndices_.empty()) {
+    return;
+  }
+  const auto inputBytes = input->estimateFlatSize();
+  writerInfo_[index]->numBufferedBytes += inputBytes;
+  numBufferedBytes_ += inputBytes;
+}
+
+void HiveDataSink::maybeFlushWriters() {
+  if (maxBufferedBytes_ == 0 || numBufferedBytes_ <= maxBufferedBytes_) {
+    return;
+  }
+  // Flush the writers holding the most buffered input first until the total
+  // drops below half of the limit. This cuts stripes of the largest open
+  // partitions and leaves the small ones buffering towards a full stripe.
+  std::vector<uint32_t> indices;
+  indices.reserve(writers_.size());
+  for (uint32_t i = 0; i < writers_.size(); ++i) {
+    if (writerInfo_[i]->numBufferedBytes > 0) {
+      indices.push_back(i);
+    }
+  }
+  std::sort(indices.begin(), indices.end(), [&](uint32_t lhs, uint32_t rhs) {
+    return writerInfo_[lhs]->numBufferedBytes >
+        writerInfo_[rhs]->numBufferedBytes;
+  });
+  for (const auto index : indices) {
+    if (numBufferedBytes_ <= maxBufferedBytes_ / 2) {
+      break;
+    }
+    writers_[index]->flush();
+    numBufferedBytes_ -= writerInfo_[index]->numBufferedBytes;
+    writerInfo_[index]->numBufferedBytes = 0;
   }
 }
 
@@ -547,32 +590,57 @@ void HiveDataSink::splitInputRowsAndEnsureWriters() {
   }
   std::fill(partitionSizes_.begin(), partitionSizes_.end(), 0);
 
+  // Resolves the writer of each row and counts the rows of each writer. The
+  // writer is looked up in 'writerIndexTable_' by partition and bucket id.
+  // 'writerIndexMap_' is only consulted for the first row of a new writer.
   const auto numRows = partitionIds_.size();
+  const uint32_t numBuckets = isBucketed() ? bucketCount_ : 1;
+  rowWriterIndices_.resize(numRows);
   for (auto row = 0; row < numRows; ++row) {
     VELOX_CHECK_LT(partitionIds_[row], std::numeric_limits<uint32_t>::max());
     const uint32_t partitionId = static_cast<uint32_t>(partitionIds_[row]);
-    const auto id = isBucketed() ? HiveWriterId{partitionId, bucketIds_[row]}
-                                 : HiveWriterId{partitionId};
-    const uint32_t index = ensureWriter(id);
-    VELOX_DCHECK_LT(index, partitionSizes_.size());
-    VELOX_DCHECK_EQ(partitionSizes_.size(), partitionRows_.size());
-    VELOX_DCHECK_EQ(partitionRows_.size(), rawPartitionRows_.size());
-    if (FOLLY_UNLIKELY(partitionRows_[index] == nullptr) ||
-        (partitionRows_[index]->capacity() < numRows * sizeof(vector_size_t))) {
-      partitionRows_[index] =
-          allocateIndices(numRows, connectorQueryCtx_->memoryPool());
-      rawPartitionRows_[index] =
-          partitionRows_[index]->asMutable<vector_size_t>();
+    const uint32_t bucketId = isBucketed() ? bucketIds_[row] : 0;
+    const uint64_t slot = static_cast<uint64_t>(partitionId) * numBuckets +
+        bucketId;
+    if (FOLLY_UNLIKELY(slot >= writerIndexTable_.size())) {
+      writerIndexTable_.resize(
+          std::max<uint64_t>(slot + 1, 2 * writerIndexTable_.size()),
+          kNoWriter);
+    }
+    auto& index = writerIndexTable_[slot];
+    if (FOLLY_UNLIKELY(index == kNoWriter)) {
+      index = ensureWriter(
+          isBucketed() ? HiveWriterId{partitionId, bucketId}
+                       : HiveWriterId{partitionId});
     }
-    rawPartitionRows_[index][partitionSizes_[index]] = row;
+    VELOX_DCHECK_LT(index, partitionSizes_.size());
+    rowWriterIndices_[row] = index;
     ++partitionSizes_[index];
   }
 
+  // Sizes the row buffers of the writers and resets the sizes to serve as
+  // write positions for the scatter below.
+  VELOX_DCHECK_EQ(partitionSizes_.size(), partitionRows_.size());
+  VELOX_DCHECK_EQ(partitionRows_.size(), rawPartitionRows_.size());
   for (uint32_t i = 0; i < partitionSizes_.size(); ++i) {
-    if (partitionSizes_[i] != 0) {
-      VELOX_CHECK_NOT_NULL(partitionRows_[i]);
-      partitionRows_[i]->setSize(partitionSizes_[i] * sizeof(vector_size_t));
+    const auto partitionSize = partitionSizes_[i];
+    if (partitionSize == 0) {
+      continue;
+    }
+    if (FOLLY_UNLIKELY(partitionRows_[i] == nullptr) ||
+        (partitionRows_[i]->capacity() <
+         partitionSize * sizeof(vector_size_t))) {
+      partitionRows_[i] =
+          allocateIndices(partitionSize, connectorQueryCtx_->memoryPool());
+      rawPartitionRows_[i] = partitionRows_[i]->asMutable<vector_size_t>();
     }
+    partitionRows_[i]->setSize(partitionSize * sizeof(vector_size_t));
+    partitionSizes_[i] = 0;
+  }
+
+  for (auto row = 0; row < numRows; ++row) {
+    const auto index = rowWriterIndices_[row];
+    rawPartitionRows_[index][partitionSizes_[index]++] = row;
   }
 }
 
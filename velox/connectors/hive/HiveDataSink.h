@@ -344,6 +344,9 @@ struct HiveWriterInfo {
 
   const HiveWriterParameters writerParameters;
   int64_t numWrittenRows = 0;
+  // The estimated bytes of input written since the last flush of this writer.
+  // Only tracked if the buffered bytes limit is set.
+  uint64_t numBufferedBytes = 0;
 };
 
 /// Identifies a hive writer.
@@ -438,6 +441,13 @@ class HiveDataSink : public DataSink {
   // the newly created writer in 'writers_'.
   uint32_t appendWriter(const HiveWriterId& id);
 
+  // Writes 'input' to the writer at 'index' and updates its stats.
+  void write(size_t index, const RowVectorPtr& input);
+
+  // Flushes the writers with the most buffered input if the total buffered
+  // input of all writers exceeds 'maxBufferedBytes_'.
+  void maybeFlushWriters();
+
   std::unique_ptr<facebook::velox::dwio::common::Writer>
   maybeCreateBucketSortWriter(
       std::unique_ptr<facebook::velox::dwio::common::Writer> writer);
@@ -479,6 +489,9 @@ class HiveDataSink : public DataSink {
   const CommitStrategy commitStrategy_;
   const std::shared_ptr<const Config> connectorProperties_;
   const uint32_t maxOpenWriters_;
+  // The max estimated bytes of input buffered across all writers before the
+  // largest ones are flushed. 0 means no limit.
+  const uint64_t maxBufferedBytes_;
   const std::vector<column_index_t> partitionChannels_;
   const std::unique_ptr<PartitionIdGenerator> partitionIdGenerator_;
   const int32_t bucketCount_{0};
@@ -493,6 +506,9 @@ class HiveDataSink : public DataSink {
   bool aborted_{false};
 
   uint32_t numSpillRuns_{0};
+  // The estimated bytes of input buffered across all writers since their last
+  // flush.
+  uint64_t numBufferedBytes_{0};
   tsan_atomic<bool> nonReclaimableSection_{false};
 
   // The map from writer id to the writer index in 'writers_' and 'writerInfo_'.
@@ -516,6 +532,15 @@ class HiveDataSink : public DataSink {
 
   // Reusable buffers for bucket id calculations.
   std::vector<uint32_t> bucketIds_;
+
+  // Marks a partition and bucket without a writer in 'writerIndexTable_'.
+  static constexpr uint32_t kNoWriter = std::numeric_limits<uint32_t>::max();
+  // The writer indices by partitionId * bucketCount_ + bucketId, or by
+  // partitionId if not bucketed. Partition ids are dense, so this replaces the
+  // per-row lookup in 'writerIndexMap_'.
+  std::vector<uint32_t> writerIndexTable_;
+  // The writer index of each row of the current input.
+  raw_vector<uint32_t> rowWriterIndices_;
 };
 
 } // namespace facebook::velox::connector::hive
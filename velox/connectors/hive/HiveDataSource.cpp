@@ -16,9 +16,12 @@
 
 #include "velox/connectors/hive/HiveDataSource.h"
 
+#include <numeric>
 #include <string>
 #include <unordered_map>
 
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
 #include "velox/dwio/common/CachedBufferedInput.h"
 #include "velox/dwio/common/ReaderFactory.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
@@ -294,6 +297,56 @@ const std::string& getColumnName(const common::Subfield& subfield) {
   return field->name();
 }
 
+// Evaluates the remaining filter in the reader, among the filters on single
+// columns. Owns its compiled filter since the ScanSpec may move to another
+// data source of the same scan.
+class RemainingFilterFunction : public common::FilterFunction {
+ public:
+  RemainingFilterFunction(
+      std::unique_ptr<exec::ExprSet> exprSet,
+      core::ExpressionEvaluator* expressionEvaluator,
+      memory::MemoryPool* pool)
+      : exprSet_(std::move(exprSet)),
+        expressionEvaluator_(expressionEvaluator),
+        pool_(pool) {
+    std::vector<std::string> names;
+    std::vector<TypePtr> types;
+    for (auto& field : exprSet_->expr(0)->distinctFields()) {
+      names.push_back(field->field());
+      types.push_back(field->type());
+    }
+    inputType_ = ROW(std::move(names), std::move(types));
+  }
+
+  const RowTypePtr& inputType() const override {
+    return inputType_;
+  }
+
+  void filter(const RowVectorPtr& input, raw_vector<vector_size_t>& passed)
+      override {
+    rows_.resize(input->size());
+    expressionEvaluator_->evaluate(exprSet_.get(), rows_, *input, result_);
+    const auto numPassed =
+        exec::processFilterResults(result_, rows_, filterEvalCtx_, pool_);
+    passed.resize(numPassed);
+    if (numPassed == input->size()) {
+      std::iota(passed.begin(), passed.end(), 0);
+    } else if (numPassed > 0) {
+      auto* indices = filterEvalCtx_.selectedIndices->as<vector_size_t>();
+      std::copy(indices, indices + numPassed, passed.begin());
+    }
+  }
+
+ private:
+  const std::unique_ptr<exec::ExprSet> exprSet_;
+  core::ExpressionEvaluator* const expressionEvaluator_;
+  memory::MemoryPool* const pool_;
+  RowTypePtr inputType_;
+  SelectivityVector rows_;
+  VectorPtr result_;
+  exec::FilterEvalCtx filterEvalCtx_;
+};
+
 } // namespace
 
 core::TypedExprPtr HiveDataSource::extractFiltersFromRemainingFilter(
@@ -357,8 +410,12 @@ HiveDataSource::HiveDataSource(
     cache::AsyncDataCache* cache,
     const std::string& scanId,
     folly::Executor* executor,
-    const dwio::common::ReaderOptions& options)
+    const dwio::common::ReaderOptions& options,
+    FileStatisticsIndex* statisticsIndex,
+    std::shared_ptr<HedgedReadPolicy> hedgedReadPolicy)
     : fileHandleFactory_(fileHandleFactory),
+      statisticsIndex_(statisticsIndex),
+      hedgedReadPolicy_(std::move(hedgedReadPolicy)),
       readerOpts_(options),
       pool_(&options.getMemoryPool()),
       outputType_(outputType),
@@ -466,6 +523,13 @@ HiveDataSource::HiveDataSource(
   if (remainingFilter) {
     metadataFilter_ = std::make_shared<common::MetadataFilter>(
         *scanSpec_, *remainingFilter, expressionEvaluator_);
+    // Readers that support it evaluate the remaining filter after reading
+    // only the columns it depends on, so that the other columns are read
+    // only for the passing rows.
+    scanSpec_->setFilterFunction(std::make_shared<RemainingFilterFunction>(
+        expressionEvaluator_->compile(remainingFilter),
+        expressionEvaluator_,
+        pool_));
   }
 
   readerOpts_.setFileSchema(hiveTableHandle_->dataColumns());
@@ -546,19 +610,37 @@ void HiveDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
     readerOpts_.setFileFormat(split_->fileFormat);
   }
 
-  auto fileHandle = fileHandleFactory_->generate(split_->filePath).second;
-  auto input = createBufferedInput(*fileHandle, readerOpts_);
-
   if (splitReader_) {
     splitReader_.reset();
   }
   splitReader_ = createSplitReader();
+
+  std::shared_ptr<const FileStatistics> statistics;
+  if (statisticsIndex_) {
+    statistics = statisticsIndex_->find(split_->filePath);
+    if (statistics && splitReader_->skipSplit(*statistics, runtimeStats_)) {
+      return;
+    }
+  }
+
+  auto [cached, fileHandle] = fileHandleFactory_->generate(split_->filePath);
+  if (cached) {
+    REPORT_ADD_STAT_VALUE(kCounterHiveFileHandleCacheHits);
+  } else {
+    REPORT_ADD_STAT_VALUE(kCounterHiveFileHandleCacheMisses);
+  }
+  auto input = createBufferedInput(*fileHandle, readerOpts_);
   splitReader_->prepareSplit(
       hiveTableHandle_,
       readerOpts_,
       std::move(input),
       metadataFilter_,
       runtimeStats_);
+  if (statisticsIndex_ && !statistics) {
+    if (auto fileStatistics = splitReader_->fileStatistics()) {
+      statisticsIndex_->add(split_->filePath, std::move(fileStatistics));
+    }
+  }
 }
 
 std::optional<RowVectorPtr> HiveDataSource::next(
@@ -598,7 +680,7 @@ std::optional<RowVectorPtr> HiveDataSource::next(
     // or it passes on all rows, leave this as null and let exec::wrap skip
     // wrapping the results.
     BufferPtr remainingIndices;
-    if (remainingFilterExprSet_) {
+    if (remainingFilterExprSet_ && !splitReader_->appliesFilterFunction()) {
       rowsRemaining = evaluateRemainingFilter(rowVector);
       VELOX_CHECK_LE(rowsRemaining, rowsScanned);
       if (rowsRemaining == 0) {
@@ -677,7 +759,12 @@ std::unordered_map<std::string, RuntimeCounter> HiveDataSource::runtimeStats() {
         RuntimeCounter(
             ioStats_->rawOverreadBytes(), RuntimeCounter::Unit::kBytes)},
        {"queryThreadIoLatency",
-        RuntimeCounter(ioStats_->queryThreadIoLatency().count())}});
+        RuntimeCounter(ioStats_->queryThreadIoLatency().count())},
+       {"numHedgedRead", RuntimeCounter(ioStats_->hedgedRead().count())},
+       {"hedgedReadBytes",
+        RuntimeCounter(
+            ioStats_->hedgedRead().sum(), RuntimeCounter::Unit::kBytes)},
+       {"numHedgeWin", RuntimeCounter(ioStats_->hedgeWin().count())}});
   return res;
 }
 
@@ -783,9 +870,15 @@ std::unique_ptr<dwio::common::BufferedInput>
 HiveDataSource::createBufferedInput(
     const FileHandle& fileHandle,
     const dwio::common::ReaderOptions& readerOpts) {
+  std::shared_ptr<ReadFile> file = fileHandle.file;
+  if (hedgedReadPolicy_) {
+    // The hedges are counted in the IO statistics of the query.
+    file = std::make_shared<HedgedReadFile>(
+        std::move(file), hedgedReadPolicy_, ioStats_);
+  }
   if (cache_) {
     return std::make_unique<dwio::common::CachedBufferedInput>(
-        fileHandle.file,
+        std::move(file),
         dwio::common::MetricsLog::voidLog(),
         fileHandle.uuid.id(),
         cache_,
@@ -796,7 +889,7 @@ HiveDataSource::createBufferedInput(
         readerOpts);
   }
   return std::make_unique<dwio::common::BufferedInput>(
-      fileHandle.file,
+      std::move(file),
       readerOpts.getMemoryPool(),
       dwio::common::MetricsLog::voidLog(),
       ioStats_.get());
@@ -811,6 +904,30 @@ vector_size_t HiveDataSource::evaluateRemainingFilter(RowVectorPtr& rowVector) {
       filterResult_, filterRows_, filterEvalCtx_, pool_);
 }
 
+std::optional<std::vector<variant>> HiveDataSource::aggregateFromStatistics(
+    const std::vector<StatisticsAggregate>& aggregates) {
+  VELOX_CHECK(split_ != nullptr, "No split to process. Call addSplit first.");
+  if (remainingFilterExprSet_) {
+    return std::nullopt;
+  }
+  // Refer to the columns by their names in the file.
+  std::vector<StatisticsAggregate> readerAggregates;
+  readerAggregates.reserve(aggregates.size());
+  for (const auto& aggregate : aggregates) {
+    auto& readerAggregate = readerAggregates.emplace_back(aggregate);
+    if (!aggregate.column.empty()) {
+      readerAggregate.column = readerOutputType_->nameOf(
+          outputType_->getChildIdx(aggregate.column));
+    }
+  }
+  auto result = splitReader_->aggregateFromStatistics(readerAggregates);
+  if (result.has_value()) {
+    ++runtimeStats_.statisticsAnsweredSplits;
+    resetSplit();
+  }
+  return result;
+}
+
 void HiveDataSource::resetSplit() {
   split_.reset();
   splitReader_->resetSplit();
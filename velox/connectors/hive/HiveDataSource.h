@@ -15,9 +15,11 @@
  */
 #pragma once
 
+#include "velox/common/file/HedgedReadFile.h"
 #include "velox/common/io/IoStatistics.h"
 #include "velox/connectors/Connector.h"
 #include "velox/connectors/hive/FileHandle.h"
+#include "velox/connectors/hive/FileStatisticsIndex.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/connectors/hive/SplitReader.h"
 #include "velox/connectors/hive/TableHandle.h"
@@ -42,7 +44,9 @@ class HiveDataSource : public DataSource {
       cache::AsyncDataCache* cache,
       const std::string& scanId,
       folly::Executor* executor,
-      const dwio::common::ReaderOptions& options);
+      const dwio::common::ReaderOptions& options,
+      FileStatisticsIndex* statisticsIndex = nullptr,
+      std::shared_ptr<HedgedReadPolicy> hedgedReadPolicy = nullptr);
 
   void addSplit(std::shared_ptr<ConnectorSplit> split) override;
 
@@ -71,6 +75,11 @@ class HiveDataSource : public DataSource {
 
   int64_t estimatedRowSize() override;
 
+  /// Answers 'aggregates' from file level statistics if the split covers a
+  /// whole file and there is no remaining filter.
+  std::optional<std::vector<variant>> aggregateFromStatistics(
+      const std::vector<StatisticsAggregate>& aggregates) override;
+
   // Internal API, made public to be accessible in unit tests.  Do not use in
   // other places.
   static std::shared_ptr<common::ScanSpec> makeScanSpec(
@@ -99,6 +108,11 @@ class HiveDataSource : public DataSource {
 
   std::shared_ptr<HiveConnectorSplit> split_;
   FileHandleFactory* fileHandleFactory_;
+  // Statistics of files by path for skipping splits without opening the
+  // file. nullptr if not enabled.
+  FileStatisticsIndex* const statisticsIndex_;
+  // Hedges the storage reads of the splits. nullptr if not enabled.
+  const std::shared_ptr<HedgedReadPolicy> hedgedReadPolicy_;
   dwio::common::ReaderOptions readerOpts_;
   std::shared_ptr<common::ScanSpec> scanSpec_;
   memory::MemoryPool* pool_;
@@ -75,25 +75,46 @@ void PartitionIdGenerator::run(
   // TODO Optimize common use case where all records belong to the same
   // partition. VectorHashers keep track of the number of unique values, hence,
   // we can find out if there is only one unique value for each partition key.
+  if (!denseIds_.empty()) {
+    for (auto i = 0; i < numRows; ++i) {
+      const auto valueId = result[i];
+      VELOX_DCHECK_LT(valueId, denseIds_.size());
+      const auto partitionId = denseIds_[valueId];
+      result[i] = FOLLY_LIKELY(partitionId != kNoPartition)
+          ? partitionId
+          : addPartition(valueId, input, i);
+    }
+    return;
+  }
+
   for (auto i = 0; i < numRows; ++i) {
     auto valueId = result[i];
     auto it = partitionIds_.find(valueId);
     if (it != partitionIds_.end()) {
       result[i] = it->second;
     } else {
-      uint64_t nextPartitionId = partitionIds_.size();
-      VELOX_USER_CHECK_LT(
-          nextPartitionId,
-          maxPartitions_,
-          "Exceeded limit of {} distinct partitions.",
-          maxPartitions_);
+      result[i] = addPartition(valueId, input, i);
+    }
+  }
+}
 
-      partitionIds_.emplace(valueId, nextPartitionId);
-      savePartitionValues(nextPartitionId, input, i);
+uint64_t PartitionIdGenerator::addPartition(
+    uint64_t valueId,
+    const RowVectorPtr& input,
+    vector_size_t row) {
+  uint64_t nextPartitionId = partitionIds_.size();
+  VELOX_USER_CHECK_LT(
+      nextPartitionId,
+      maxPartitions_,
+      "Exceeded limit of {} distinct partitions.",
+      maxPartitions_);
 
-      result[i] = nextPartitionId;
-    }
+  partitionIds_.emplace(valueId, nextPartitionId);
+  if (!denseIds_.empty()) {
+    denseIds_[valueId] = nextPartitionId;
   }
+  savePartitionValues(nextPartitionId, input, row);
+  return nextPartitionId;
 }
 
 std::string PartitionIdGenerator::partitionName(uint64_t partitionId) const {
@@ -137,10 +158,17 @@ void PartitionIdGenerator::computeValueIds(
     VELOX_CHECK(ok);
   }
 
-  updateValueToPartitionIdMapping();
+  updateValueToPartitionIdMapping(multiplier);
 }
 
-void PartitionIdGenerator::updateValueToPartitionIdMapping() {
+void PartitionIdGenerator::updateValueToPartitionIdMapping(
+    uint64_t numValueIds) {
+  if (numValueIds <= kMaxDenseValueIds) {
+    denseIds_.assign(numValueIds, kNoPartition);
+  } else {
+    denseIds_.clear();
+  }
+
   if (partitionIds_.empty()) {
     return;
   }
@@ -160,6 +188,9 @@ void PartitionIdGenerator::updateValueToPartitionIdMapping() {
 
   for (auto i = 0; i < numPartitions; ++i) {
     partitionIds_.emplace(newValueIds[i], i);
+    if (!denseIds_.empty()) {
+      denseIds_[newValueIds[i]] = i;
+    }
   }
 }
 
@@ -55,6 +55,12 @@ class PartitionIdGenerator {
  private:
   static constexpr const int32_t kHasherReservePct = 20;
 
+  // Value ids below this are mapped to partition ids through 'denseIds_'.
+  static constexpr uint64_t kMaxDenseValueIds = 64 << 10;
+
+  // Marks a value id without a partition in 'denseIds_'.
+  static constexpr uint32_t kNoPartition = std::numeric_limits<uint32_t>::max();
+
   // Computes value IDs using VectorHashers for all rows in 'input'.
   void computeValueIds(
       const RowVectorPtr& input,
@@ -63,8 +69,16 @@ class PartitionIdGenerator {
   // In case of rehash (when value IDs produced by VectorHashers change), we
   // update value id for pre-existing partitions while keeping partition ids.
   // This method rebuilds 'partitionIds_' by re-calculating the value ids using
-  // updated 'hashers_'.
-  void updateValueToPartitionIdMapping();
+  // updated 'hashers_'. 'numValueIds' is the number of distinct value ids of
+  // the updated 'hashers_'.
+  void updateValueToPartitionIdMapping(uint64_t numValueIds);
+
+  // Assigns the next partition id to 'valueId' and saves the partition values
+  // of 'row'. Returns the partition id.
+  uint64_t addPartition(
+      uint64_t valueId,
+      const RowVectorPtr& input,
+      vector_size_t row);
 
   // Copies partition values of 'row' from 'input' into 'partitionId' row in
   // 'partitionValues_'.
@@ -82,6 +96,11 @@ class PartitionIdGenerator {
   // A mapping from value ID produced by VectorHashers to a partition ID.
   std::unordered_map<uint64_t, uint64_t> partitionIds_;
 
+  // The partition IDs indexed by value ID if there are at most
+  // kMaxDenseValueIds value IDs, e.g. for low cardinality partition keys.
+  // Empty otherwise. Spares the lookup in 'partitionIds_' for each row.
+  std::vector<uint32_t> denseIds_;
+
   // A vector holding unique partition key values. One row per partition. Row
   // numbers match partition IDs.
   RowVectorPtr partitionValues_;
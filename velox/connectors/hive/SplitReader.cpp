@@ -16,6 +16,7 @@
 
 #include "velox/connectors/hive/SplitReader.h"
 
+#include "velox/connectors/hive/FileStatisticsIndex.h"
 #include "velox/connectors/hive/HiveConnectorSplit.h"
 #include "velox/connectors/hive/TableHandle.h"
 #include "velox/dwio/common/ReaderFactory.h"
@@ -51,21 +52,25 @@ bool applyPartitionFilter(
   }
 }
 
+// Returns false if no row of a file with 'statistics' can pass the filters
+// of 'scanSpec'. 'getStatistics' returns the statistics of the file column at
+// an index of 'statistics.rowType' if they are not in 'statistics.columns'.
 bool testFilters(
     common::ScanSpec* scanSpec,
-    dwio::common::Reader* reader,
+    const FileStatistics& statistics,
+    const std::function<std::shared_ptr<dwio::common::ColumnStatistics>(
+        uint32_t)>& getStatistics,
     const std::string& filePath,
     const std::unordered_map<std::string, std::optional<std::string>>&
         partitionKey,
     std::unordered_map<std::string, std::shared_ptr<HiveColumnHandle>>&
         partitionKeysHandle) {
-  auto totalRows = reader->numberOfRows();
-  const auto& fileTypeWithId = reader->typeWithId();
-  const auto& rowType = reader->rowType();
+  const auto& rowType = statistics.rowType;
   for (const auto& child : scanSpec->children()) {
     if (child->filter()) {
       const auto& name = child->fieldName();
-      if (!rowType->containsChild(name)) {
+      auto index = rowType->getChildIdxIfExists(name);
+      if (!index.has_value()) {
         // If missing column is partition key.
         auto iter = partitionKey.find(name);
         if (iter != partitionKey.end() && iter->second.has_value()) {
@@ -80,14 +85,18 @@ bool testFilters(
           return false;
         }
       } else {
-        const auto& typeWithId = fileTypeWithId->childByName(name);
-        auto columnStats = reader->columnStatistics(typeWithId->id());
+        auto columnStats = index.value() < statistics.columns.size()
+            ? statistics.columns[index.value()]
+            : nullptr;
+        if (!columnStats && getStatistics) {
+          columnStats = getStatistics(index.value());
+        }
         if (columnStats != nullptr &&
             !testFilter(
                 child->filter(),
                 columnStats.get(),
-                totalRows.value(),
-                typeWithId->type())) {
+                statistics.numRows,
+                rowType->childAt(index.value()))) {
           VLOG(1) << "Skipping " << filePath
                   << " based on stats and filter for column "
                   << child->fieldName();
@@ -116,6 +125,71 @@ velox::variant convertFromString(const std::optional<std::string>& value) {
   return velox::variant(ToKind);
 }
 
+// Returns the minimum or the maximum of a column with 'stats' as a value of
+// 'type'. Returns std::nullopt if 'stats' do not have it.
+std::optional<velox::variant> statisticsBound(
+    const dwio::common::ColumnStatistics& stats,
+    const TypePtr& type,
+    bool isMin) {
+  if (type->isDecimal()) {
+    return std::nullopt;
+  }
+  switch (type->kind()) {
+    case TypeKind::BIGINT:
+    case TypeKind::INTEGER:
+    case TypeKind::SMALLINT:
+    case TypeKind::TINYINT: {
+      auto* intStats =
+          dynamic_cast<const dwio::common::IntegerColumnStatistics*>(&stats);
+      if (!intStats) {
+        return std::nullopt;
+      }
+      const auto value =
+          isMin ? intStats->getMinimum() : intStats->getMaximum();
+      if (!value.has_value()) {
+        return std::nullopt;
+      }
+      switch (type->kind()) {
+        case TypeKind::INTEGER:
+          return velox::variant(static_cast<int32_t>(value.value()));
+        case TypeKind::SMALLINT:
+          return velox::variant(static_cast<int16_t>(value.value()));
+        case TypeKind::TINYINT:
+          return velox::variant(static_cast<int8_t>(value.value()));
+        default:
+          return velox::variant(value.value());
+      }
+    }
+    case TypeKind::BOOLEAN: {
+      auto* boolStats =
+          dynamic_cast<const dwio::common::BooleanColumnStatistics*>(&stats);
+      if (!boolStats || !boolStats->getTrueCount().has_value() ||
+          !boolStats->getFalseCount().has_value()) {
+        return std::nullopt;
+      }
+      return velox::variant(
+          isMin ? boolStats->getFalseCount().value() == 0
+                : boolStats->getTrueCount().value() > 0);
+    }
+    case TypeKind::VARCHAR: {
+      auto* stringStats =
+          dynamic_cast<const dwio::common::StringColumnStatistics*>(&stats);
+      if (!stringStats) {
+        return std::nullopt;
+      }
+      const auto& value =
+          isMin ? stringStats->getMinimum() : stringStats->getMaximum();
+      if (!value.has_value()) {
+        return std::nullopt;
+      }
+      return velox::variant(value.value());
+    }
+    default:
+      // Floating point statistics do not tell about NaNs.
+      return std::nullopt;
+  }
+}
+
 } // namespace
 
 std::unique_ptr<SplitReader> SplitReader::create(
@@ -149,6 +223,12 @@ void SplitReader::prepareSplit(
     std::unique_ptr<dwio::common::BufferedInput> baseFileInput,
     std::shared_ptr<common::MetadataFilter> metadataFilter,
     dwio::common::RuntimeStatistics& runtimeStats) {
+  coversFile_ = hiveSplit_->start == 0 &&
+      hiveSplit_->length >= baseFileInput->getReadFile()->size();
+  deletedRows_ = nullptr;
+  if (hiveSplit_->deletedRows && !hiveSplit_->deletedRows->empty()) {
+    deletedRows_ = hiveSplit_->deletedRows;
+  }
   baseReader_ = dwio::common::getReaderFactory(readerOptions.getFileFormat())
                     ->createReader(std::move(baseFileInput), readerOptions);
 
@@ -161,9 +241,18 @@ void SplitReader::prepareSplit(
 
   // Check filters and see if the whole split can be skipped. Note that this
   // doesn't apply to Hudi tables.
+  FileStatistics statistics;
+  statistics.rowType = baseReader_->rowType();
+  statistics.numRows = baseReader_->numberOfRows().value_or(0);
+  const auto& fileTypeWithId = baseReader_->typeWithId();
   if (!testFilters(
           scanSpec_.get(),
-          baseReader_.get(),
+          statistics,
+          [&](uint32_t index) {
+            return std::shared_ptr<dwio::common::ColumnStatistics>(
+                baseReader_->columnStatistics(
+                    fileTypeWithId->childAt(index)->id()));
+          },
           hiveSplit_->filePath,
           hiveSplit_->partitionKeys,
           partitionKeys_)) {
@@ -193,6 +282,179 @@ void SplitReader::prepareSplit(
   baseRowReader_ = baseReader_->createRowReader(rowReaderOpts_);
 }
 
+bool SplitReader::skipSplit(
+    const FileStatistics& statistics,
+    dwio::common::RuntimeStatistics& runtimeStats) {
+  if (statistics.numRows > 0 &&
+      testFilters(
+          scanSpec_.get(),
+          statistics,
+          nullptr,
+          hiveSplit_->filePath,
+          hiveSplit_->partitionKeys,
+          partitionKeys_)) {
+    return false;
+  }
+  emptySplit_ = true;
+  ++runtimeStats.skippedSplits;
+  runtimeStats.skippedSplitBytes += hiveSplit_->length;
+  return true;
+}
+
+std::shared_ptr<const FileStatistics> SplitReader::fileStatistics() const {
+  VELOX_CHECK_NOT_NULL(baseReader_);
+  const auto numRows = baseReader_->numberOfRows();
+  if (!numRows.has_value()) {
+    return nullptr;
+  }
+  auto statistics = std::make_shared<FileStatistics>();
+  statistics->rowType = baseReader_->rowType();
+  statistics->numRows = numRows.value();
+  const auto& fileTypeWithId = baseReader_->typeWithId();
+  statistics->columns.resize(statistics->rowType->size());
+  for (auto i = 0; i < statistics->rowType->size(); ++i) {
+    statistics->columns[i] =
+        baseReader_->columnStatistics(fileTypeWithId->childAt(i)->id());
+  }
+  return statistics;
+}
+
+std::optional<std::vector<velox::variant>> SplitReader::aggregateFromStatistics(
+    const std::vector<StatisticsAggregate>& aggregates) const {
+  using Kind = StatisticsAggregate::Kind;
+  auto noRowsResult = [&]() {
+    std::vector<velox::variant> result;
+    for (const auto& aggregate : aggregates) {
+      if (aggregate.kind == Kind::kCount ||
+          aggregate.kind == Kind::kNullCount) {
+        result.emplace_back(static_cast<int64_t>(0));
+      } else {
+        result.push_back(velox::variant::null(
+            readerOutputType_->findChild(aggregate.column)->kind()));
+      }
+    }
+    return result;
+  };
+  if (emptySplit_) {
+    return noRowsResult();
+  }
+  const auto numRows = baseReader_->numberOfRows();
+  if (!coversFile_ || rowReaderOpts_.getSkipRows() || !numRows.has_value() ||
+      deletedRows_ != nullptr) {
+    return std::nullopt;
+  }
+
+  const auto& fileType = baseReader_->rowType();
+  const auto& fileTypeWithId = baseReader_->typeWithId();
+  auto columnStatistics = [&](uint32_t index) {
+    return baseReader_->columnStatistics(fileTypeWithId->childAt(index)->id());
+  };
+
+  // The filters must pass all or none of the rows.
+  for (const auto& child : scanSpec_->children()) {
+    if (!child->hasFilter()) {
+      continue;
+    }
+    auto* filter = child->filter();
+    if (!filter) {
+      // Filters on subfields.
+      return std::nullopt;
+    }
+    const auto& name = child->fieldName();
+    auto partitionIt = hiveSplit_->partitionKeys.find(name);
+    if (partitionIt != hiveSplit_->partitionKeys.end()) {
+      const bool passes = partitionIt->second.has_value()
+          ? applyPartitionFilter(
+                partitionKeys_.at(name)->dataType()->kind(),
+                partitionIt->second.value(),
+                filter)
+          : filter->testNull();
+      if (!passes) {
+        return noRowsResult();
+      }
+      continue;
+    }
+    if (name == kPath || name == kBucket) {
+      return std::nullopt;
+    }
+    auto index = fileType->getChildIdxIfExists(name);
+    if (!index.has_value()) {
+      // Column is missing and all null.
+      if (!filter->testNull()) {
+        return noRowsResult();
+      }
+      continue;
+    }
+    auto stats = columnStatistics(index.value());
+    if (!stats ||
+        !testFilterAllPass(
+            filter, stats.get(), numRows.value(), fileType->childAt(*index))) {
+      return std::nullopt;
+    }
+  }
+
+  std::vector<velox::variant> result;
+  result.reserve(aggregates.size());
+  for (const auto& aggregate : aggregates) {
+    if (aggregate.column.empty()) {
+      VELOX_CHECK(aggregate.kind == Kind::kCount, "Aggregate needs a column");
+      result.emplace_back(static_cast<int64_t>(numRows.value()));
+      continue;
+    }
+    const auto& name = aggregate.column;
+    const auto& type = readerOutputType_->findChild(name);
+    // Number of non-null values and the minimum and maximum of the column.
+    uint64_t numValues = 0;
+    std::optional<velox::variant> min;
+    std::optional<velox::variant> max;
+    auto partitionIt = hiveSplit_->partitionKeys.find(name);
+    if (partitionIt != hiveSplit_->partitionKeys.end()) {
+      if (partitionIt->second.has_value()) {
+        numValues = numRows.value();
+        min = VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+            convertFromString, type->kind(), partitionIt->second);
+        max = min;
+      }
+    } else if (name == kPath || name == kBucket) {
+      return std::nullopt;
+    } else if (auto index = fileType->getChildIdxIfExists(name)) {
+      auto stats = columnStatistics(index.value());
+      if (!stats || !stats->getNumberOfValues().has_value()) {
+        return std::nullopt;
+      }
+      numValues = stats->getNumberOfValues().value();
+      const auto& columnType = fileType->childAt(index.value());
+      if (numValues > 0 && type->kind() == columnType->kind()) {
+        min = statisticsBound(*stats, type, true);
+        max = statisticsBound(*stats, type, false);
+      }
+    }
+
+    switch (aggregate.kind) {
+      case Kind::kCount:
+        result.emplace_back(static_cast<int64_t>(numValues));
+        break;
+      case Kind::kNullCount:
+        result.emplace_back(static_cast<int64_t>(numRows.value() - numValues));
+        break;
+      case Kind::kMin:
+      case Kind::kMax: {
+        if (numValues == 0) {
+          result.push_back(velox::variant::null(type->kind()));
+          break;
+        }
+        auto& bound = aggregate.kind == Kind::kMin ? min : max;
+        if (!bound.has_value()) {
+          return std::nullopt;
+        }
+        result.push_back(std::move(bound.value()));
+        break;
+      }
+    }
+  }
+  return result;
+}
+
 std::vector<TypePtr> SplitReader::adaptColumns(
     const RowTypePtr& fileType,
     const std::shared_ptr<const velox::RowType>& tableSchema) {
@@ -243,7 +505,27 @@ std::vector<TypePtr> SplitReader::adaptColumns(
 }
 
 uint64_t SplitReader::next(int64_t size, VectorPtr& output) {
-  return baseRowReader_->next(size, output);
+  if (deletedRows_ == nullptr) {
+    return baseRowReader_->next(size, output);
+  }
+  const auto rowNumber = baseRowReader_->nextRowNumber();
+  if (rowNumber == dwio::common::RowReader::kAtEnd) {
+    return 0;
+  }
+  // Marks the deleted rows among the rows the next read scans.
+  const auto readSize = baseRowReader_->nextReadSize(size);
+  auto it = std::lower_bound(
+      deletedRows_->begin(), deletedRows_->end(), rowNumber);
+  if (it == deletedRows_->end() || *it >= rowNumber + readSize) {
+    return baseRowReader_->next(size, output);
+  }
+  deletedRowsInBatch_.assign(bits::nwords(readSize), 0);
+  for (; it != deletedRows_->end() && *it < rowNumber + readSize; ++it) {
+    bits::setBit(deletedRowsInBatch_.data(), *it - rowNumber);
+  }
+  dwio::common::Mutation mutation;
+  mutation.deletedRows = deletedRowsInBatch_.data();
+  return baseRowReader_->next(size, output, &mutation);
 }
 
 void SplitReader::resetFilterCaches() {
@@ -283,6 +565,10 @@ bool SplitReader::allPrefetchIssued() const {
   return baseRowReader_ && baseRowReader_->allPrefetchIssued();
 }
 
+bool SplitReader::appliesFilterFunction() const {
+  return baseRowReader_ && baseRowReader_->appliesFilterFunction();
+}
+
 void SplitReader::setConstantValue(
     common::ScanSpec* spec,
     const TypePtr& type,
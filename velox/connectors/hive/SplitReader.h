@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/connectors/Connector.h"
 #include "velox/dwio/common/Reader.h"
 #include "velox/type/Type.h"
 
@@ -28,6 +29,7 @@ namespace facebook::velox::connector::hive {
 constexpr const char* kPath = "$path";
 constexpr const char* kBucket = "$bucket";
 
+struct FileStatistics;
 struct HiveConnectorSplit;
 class HiveTableHandle;
 class HiveColumnHandle;
@@ -62,6 +64,25 @@ class SplitReader {
       std::shared_ptr<common::MetadataFilter> metadataFilter,
       dwio::common::RuntimeStatistics& runtimeStats);
 
+  /// Returns true and marks the split as empty if no row of a file with
+  /// 'statistics' can pass the filters. Used to skip the split without opening
+  /// the file.
+  bool skipSplit(
+      const FileStatistics& statistics,
+      dwio::common::RuntimeStatistics& runtimeStats);
+
+  /// Returns the statistics of the file opened by prepareSplit() or nullptr
+  /// if the file does not know its number of rows.
+  std::shared_ptr<const FileStatistics> fileStatistics() const;
+
+  /// Returns the values of 'aggregates' computed from the statistics of the
+  /// file if the split covers the whole file and the filters pass either all
+  /// or none of its rows. The columns of 'aggregates' are names in
+  /// 'readerOutputType_'. Returns std::nullopt otherwise. See
+  /// DataSource::aggregateFromStatistics().
+  std::optional<std::vector<variant>> aggregateFromStatistics(
+      const std::vector<StatisticsAggregate>& aggregates) const;
+
   virtual uint64_t next(int64_t size, VectorPtr& output);
 
   void resetFilterCaches();
@@ -76,6 +97,10 @@ class SplitReader {
 
   bool allPrefetchIssued() const;
 
+  /// Returns true if the reader of the split applies the filter function of
+  /// the ScanSpec. See RowReader::appliesFilterFunction().
+  bool appliesFilterFunction() const;
+
   std::string toString() const;
 
  protected:
@@ -115,6 +140,13 @@ class SplitReader {
       const RowTypePtr& rowType);
 
   bool emptySplit_;
+  // True if the split reads all the rows of the file, so that file statistics
+  // describe the rows of the split.
+  bool coversFile_{false};
+  // HiveConnectorSplit::deletedRows if not empty.
+  std::shared_ptr<const std::vector<int64_t>> deletedRows_;
+  // Bits for the deleted rows of the batch of next().
+  std::vector<uint64_t> deletedRowsInBatch_;
 };
 
 } // namespace facebook::velox::connector::hive
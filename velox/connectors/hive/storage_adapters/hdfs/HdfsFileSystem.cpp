@@ -25,11 +25,24 @@ std::string_view HdfsFileSystem::kScheme("hdfs://");
 
 class HdfsFileSystem::Impl {
  public:
-  // Keep config here for possible use in the future.
   explicit Impl(const Config* config, const HdfsServiceEndpoint& endpoint) {
     auto builder = hdfsNewBuilder();
     hdfsBuilderSetNameNode(builder, endpoint.host.c_str());
     hdfsBuilderSetNameNodePort(builder, atoi(endpoint.port.data()));
+    folly::Optional<std::string> domainSocketPath;
+    if (config != nullptr &&
+        config->get<bool>("hive.hdfs.short-circuit-read", false)) {
+      // libhdfs3 reads the blocks on the local datanode from the block files
+      // the datanode passes over the domain socket. It falls back to remote
+      // reads for the other blocks and if a local read fails.
+      domainSocketPath = config->get("hive.hdfs.domain-socket-path");
+      VELOX_USER_CHECK(
+          domainSocketPath.hasValue() && !domainSocketPath->empty(),
+          "hive.hdfs.domain-socket-path is required for HDFS short-circuit reads");
+      hdfsBuilderConfSetStr(builder, "dfs.client.read.shortcircuit", "true");
+      hdfsBuilderConfSetStr(
+          builder, "dfs.domain.socket.path", domainSocketPath->c_str());
+    }
     hdfsClient_ = hdfsBuilderConnect(builder);
     VELOX_CHECK_NOT_NULL(
         hdfsClient_,
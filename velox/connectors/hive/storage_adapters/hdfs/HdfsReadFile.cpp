@@ -42,6 +42,10 @@ void HdfsReadFile::preadInternal(uint64_t offset, uint64_t length, char* pos)
     file_->open(hdfsClient_, filePath_);
   }
   file_->seek(offset);
+  readFully(length, pos);
+}
+
+void HdfsReadFile::readFully(uint64_t length, char* pos) const {
   uint64_t totalBytesRead = 0;
   while (totalBytesRead < length) {
     auto bytesRead = file_->read(pos, length - totalBytesRead);
@@ -63,6 +67,35 @@ std::string HdfsReadFile::pread(uint64_t offset, uint64_t length) const {
   return result;
 }
 
+uint64_t HdfsReadFile::preadv(
+    uint64_t offset,
+    const std::vector<folly::Range<char*>>& buffers) const {
+  const auto fileSize = size();
+  if (offset >= fileSize) {
+    return 0;
+  }
+  if (!file_->handle_) {
+    file_->open(hdfsClient_, filePath_);
+  }
+  auto position = offset;
+  bool seek = true;
+  for (const auto& buffer : buffers) {
+    const auto length = std::min<uint64_t>(buffer.size(), fileSize - position);
+    // Skips the gaps of a coalesced read.
+    if (buffer.data() == nullptr) {
+      seek = true;
+    } else if (length > 0) {
+      if (seek) {
+        file_->seek(position);
+        seek = false;
+      }
+      readFully(length, buffer.data());
+    }
+    position += length;
+  }
+  return position - offset;
+}
+
 uint64_t HdfsReadFile::size() const {
   return fileInfo_->mSize;
 }
@@ -68,6 +68,12 @@ class HdfsReadFile final : public ReadFile {
 
   std::string pread(uint64_t offset, uint64_t length) const final;
 
+  /// Reads the ranges with one seek per gap straight into 'buffers', e.g. the
+  /// entries of the cache for a coalesced read of CachedBufferedInput.
+  uint64_t preadv(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const final;
+
   uint64_t size() const final;
 
   uint64_t memoryUsage() const final;
@@ -84,6 +90,8 @@ class HdfsReadFile final : public ReadFile {
 
  private:
   void preadInternal(uint64_t offset, uint64_t length, char* pos) const;
+  // Reads 'length' bytes at the position of 'file_' into 'pos'.
+  void readFully(uint64_t length, char* pos) const;
   void checkFileReadParameters(uint64_t offset, uint64_t length) const;
 
   hdfsFS hdfsClient_;
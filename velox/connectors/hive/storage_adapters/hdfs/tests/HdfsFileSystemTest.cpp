@@ -209,6 +209,46 @@ TEST_F(HdfsFileSystemTest, fallbackToUseConfig) {
   readData(readFile.get());
 }
 
+TEST_F(HdfsFileSystemTest, preadv) {
+  auto memConfig = std::make_shared<const core::MemConfig>(configurationValues);
+  auto hdfsFileSystem =
+      filesystems::getFileSystem(fullDestinationPath, memConfig);
+  auto readFile = hdfsFileSystem->openFileForRead(fullDestinationPath);
+  std::string first(8, '\0');
+  std::string second(10, '\0');
+  // Skips a gap and reads past the end of the file.
+  ASSERT_EQ(
+      readFile->preadv(
+          2,
+          {folly::Range<char*>(first.data(), first.size()),
+           folly::Range<char*>(nullptr, kOneMB),
+           folly::Range<char*>(second.data(), second.size())}),
+      13 + kOneMB);
+  ASSERT_EQ(first, "aaabbbbb");
+  ASSERT_EQ(second.substr(0, 5), "ddddd");
+  ASSERT_EQ(
+      readFile->preadv(15 + kOneMB, {folly::Range<char*>(nullptr, 1)}), 0);
+}
+
+TEST_F(HdfsFileSystemTest, shortCircuitRead) {
+  auto config = configurationValues;
+  config["hive.hdfs.short-circuit-read"] = "true";
+  auto memConfig = std::make_shared<const core::MemConfig>(config);
+  const auto endpoint = filesystems::HdfsFileSystem::getServiceEndpoint(
+      simpleDestinationPath, memConfig.get());
+  VELOX_ASSERT_THROW(
+      std::make_shared<filesystems::HdfsFileSystem>(memConfig, endpoint),
+      "hive.hdfs.domain-socket-path is required for HDFS short-circuit reads");
+
+  // The mini cluster has no domain socket, so the reads fall back to remote
+  // reads.
+  config["hive.hdfs.domain-socket-path"] = "/tmp/does/not/exist";
+  memConfig = std::make_shared<const core::MemConfig>(config);
+  filesystems::HdfsFileSystem hdfsFileSystem(memConfig, endpoint);
+  auto readFile = hdfsFileSystem.openFileForRead(simpleDestinationPath);
+  readData(readFile.get());
+}
+
 TEST_F(HdfsFileSystemTest, oneFsInstanceForOneEndpoint) {
   auto hdfsFileSystem1 =
       filesystems::getFileSystem(fullDestinationPath, nullptr);
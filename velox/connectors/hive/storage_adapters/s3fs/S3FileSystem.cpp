@@ -16,6 +16,7 @@
 
 #include "velox/connectors/hive/storage_adapters/s3fs/S3FileSystem.h"
 #include "velox/common/file/File.h"
+#include "velox/common/time/Timer.h"
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3Util.h"
 #include "velox/connectors/hive/storage_adapters/s3fs/S3WriteFile.h"
@@ -23,8 +24,11 @@
 #include "velox/dwio/common/DataBuffer.h"
 
 #include <fmt/format.h>
+#include <folly/futures/Future.h>
 #include <glog/logging.h>
+#include <algorithm>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 
 #include <aws/core/Aws.h>
@@ -32,6 +36,7 @@
 #include <aws/core/http/HttpResponse.h>
 #include <aws/core/utils/logging/ConsoleLogSystem.h>
 #include <aws/core/utils/stream/PreallocatedStreamBuf.h>
+#include <aws/core/utils/threading/Executor.h>
 #include <aws/identity-management/auth/STSAssumeRoleCredentialsProvider.h>
 #include <aws/s3/S3Client.h>
 #include <aws/s3/model/CompleteMultipartUploadRequest.h>
@@ -69,11 +74,81 @@ Aws::IOStreamFactory AwsWriteableStreamFactory(void* data, int64_t nbytes) {
   return [=]() { return Aws::New<StringViewStream>("", data, nbytes); };
 }
 
+// Estimates the latency and bandwidth of the GET requests of a file system
+// from the completed requests and counts the bytes read. A request of 'bytes'
+// is modeled to take latency + bytes / bandwidth. Gaps between ranges are read
+// when reading them takes less time than the latency of a separate request.
+class S3ReadCostModel {
+ public:
+  explicit S3ReadCostModel(uint64_t partSize) : partSize_(partSize) {}
+
+  // Largest request. Larger spans are read by parallel requests.
+  uint64_t partSize() const {
+    return partSize_;
+  }
+
+  // Returns the largest gap between ranges that is read by one request.
+  uint64_t maxGap() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return std::clamp<uint64_t>(
+        latencyUs_ * bytesPerUs_, kMinGap, std::min(kMaxGap, partSize_));
+  }
+
+  // Records a completed request of 'bytes' that took 'micros'.
+  void recordRequest(uint64_t bytes, uint64_t micros) {
+    std::lock_guard<std::mutex> l(mutex_);
+    ++stats_.numRequests;
+    stats_.bytesRead += bytes;
+    if (bytes <= kSmallRequest) {
+      // Small requests measure the latency.
+      const double latency =
+          std::max<double>(1, micros - bytes / bytesPerUs_);
+      latencyUs_ += (latency - latencyUs_) * kWeight;
+    } else if (bytes >= kLargeRequest && micros > latencyUs_) {
+      // Large requests measure the bandwidth.
+      const double bandwidth = bytes / (micros - latencyUs_);
+      bytesPerUs_ += (bandwidth - bytesPerUs_) * kWeight;
+    }
+  }
+
+  void recordGaps(uint64_t gapBytesRead, uint64_t gapBytesSkipped) {
+    std::lock_guard<std::mutex> l(mutex_);
+    stats_.gapBytesRead += gapBytesRead;
+    stats_.gapBytesSkipped += gapBytesSkipped;
+  }
+
+  filesystems::S3ReadStats stats() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return stats_;
+  }
+
+ private:
+  static constexpr uint64_t kMinGap = 8 << 10;
+  static constexpr uint64_t kMaxGap = 16 << 20;
+  static constexpr uint64_t kSmallRequest = 256 << 10;
+  static constexpr uint64_t kLargeRequest = 4 << 20;
+  // Weight of a new measurement in the moving averages.
+  static constexpr double kWeight = 0.125;
+
+  const uint64_t partSize_;
+  mutable std::mutex mutex_;
+  // Initial estimates of 20ms and 50MB/s read gaps of up to 1MB.
+  double latencyUs_{20'000};
+  double bytesPerUs_{50};
+  filesystems::S3ReadStats stats_;
+};
+
 // TODO: Implement retry on failure.
 class S3ReadFile final : public ReadFile {
  public:
-  S3ReadFile(const std::string& path, Aws::S3::S3Client* client)
-      : client_(client) {
+  S3ReadFile(
+      const std::string& path,
+      Aws::S3::S3Client* client,
+      std::shared_ptr<S3ReadCostModel> costModel,
+      bool asyncReads = false)
+      : client_(client),
+        costModel_(std::move(costModel)),
+        asyncReads_(asyncReads) {
     getBucketAndKeyFromS3Path(path, bucket_, key_);
   }
 
@@ -98,14 +173,13 @@ class S3ReadFile final : public ReadFile {
 
   std::string_view pread(uint64_t offset, uint64_t length, void* buffer)
       const override {
-    preadInternal(offset, length, static_cast<char*>(buffer));
+    preadv(offset, {folly::Range<char*>(static_cast<char*>(buffer), length)});
     return {static_cast<char*>(buffer), length};
   }
 
   std::string pread(uint64_t offset, uint64_t length) const override {
     std::string result(length, 0);
-    char* position = result.data();
-    preadInternal(offset, length, position);
+    preadv(offset, {folly::Range<char*>(result.data(), length)});
     return result;
   }
 
@@ -116,25 +190,54 @@ class S3ReadFile final : public ReadFile {
     // between. This call must populate the ranges (except gap ranges)
     // sequentially starting from 'offset'. AWS S3 GetObject does not support
     // multi-range. AWS S3 also charges by number of read requests and not size.
-    // The idea here is to use a single read spanning all the ranges and then
-    // populate individual ranges. We pre-allocate a buffer to support this.
-    size_t length = 0;
-    for (const auto range : buffers) {
-      length += range.size();
+    // Ranges separated by small gaps are read by a single request, larger
+    // gaps separate requests and spans over the part size are split. The
+    // requests run in parallel if the client is asynchronous.
+    if (asyncReads_) {
+      return preadvAsync(offset, buffers).get();
     }
-    // TODO: allocate from a memory pool
-    std::string result(length, 0);
-    preadInternal(offset, length, static_cast<char*>(result.data()));
-    size_t resultOffset = 0;
-    for (auto range : buffers) {
-      if (range.data()) {
-        memcpy(range.data(), &(result.data()[resultOffset]), range.size());
-      }
-      resultOffset += range.size();
+    uint64_t length = 0;
+    for (auto& request : planRequests(offset, buffers, length)) {
+      read(request);
     }
     return length;
   }
 
+  // Issues the GetObject requests with the asynchronous S3 client. The
+  // requests run on the executor of the client, which bounds the number of
+  // requests in flight per file system. 'buffers' must stay live until the
+  // returned future is realized.
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    if (!asyncReads_) {
+      return ReadFile::preadvAsync(offset, buffers);
+    }
+    uint64_t length = 0;
+    auto requests = planRequests(offset, buffers, length);
+    if (requests.size() == 1) {
+      return readAsync(std::move(requests[0])).deferValue([length](auto) {
+        return length;
+      });
+    }
+    std::vector<folly::SemiFuture<uint64_t>> reads;
+    reads.reserve(requests.size());
+    for (auto& request : requests) {
+      reads.push_back(readAsync(std::move(request)));
+    }
+    return folly::collectAll(std::move(reads))
+        .deferValue([length](std::vector<folly::Try<uint64_t>>&& results) {
+          for (auto& result : results) {
+            result.value();
+          }
+          return length;
+        });
+  }
+
+  bool hasPreadvAsync() const override {
+    return asyncReads_;
+  }
+
   uint64_t size() const override {
     return length_;
   }
@@ -158,13 +261,145 @@ class S3ReadFile final : public ReadFile {
   }
 
  private:
-  // The assumption here is that "position" has space for at least "length"
-  // bytes.
-  void preadInternal(uint64_t offset, uint64_t length, char* position) const {
-    // Read the desired range of bytes.
-    Aws::S3::Model::GetObjectRequest request;
-    Aws::S3::Model::GetObjectResult result;
+  // A GET of a contiguous span of the file. 'buffers' cover the span and have
+  // nullptr data for the gaps that are read and discarded.
+  struct ReadRequest {
+    uint64_t offset;
+    uint64_t length{0};
+    std::vector<folly::Range<char*>> buffers;
+  };
+
+  // State of a read by readAsync() that is shared with the completion
+  // handler.
+  struct AsyncRead {
+    // The ranges to fill from 'data' if the read is not in place.
+    std::vector<folly::Range<char*>> buffers;
+    std::string data;
+    folly::Promise<uint64_t> promise;
+  };
+
+  // Splits the ranges of 'buffers' starting at 'offset' into requests. Sets
+  // 'length' to the total size of 'buffers'.
+  std::vector<ReadRequest> planRequests(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers,
+      uint64_t& length) const {
+    const uint64_t partSize = costModel_->partSize();
+    const uint64_t maxGap = costModel_->maxGap();
+    std::vector<ReadRequest> requests;
+    uint64_t position = offset;
+    // Bytes skipped since the last range.
+    uint64_t gap = 0;
+    uint64_t gapBytesRead = 0;
+    uint64_t gapBytesSkipped = 0;
+    for (auto range : buffers) {
+      if (range.data() == nullptr) {
+        gap += range.size();
+        position += range.size();
+        continue;
+      }
+      bool newRequest = requests.empty();
+      if (!newRequest && gap > 0) {
+        if (gap <= maxGap && requests.back().length + gap < partSize) {
+          requests.back().buffers.emplace_back(nullptr, gap);
+          requests.back().length += gap;
+          gapBytesRead += gap;
+        } else {
+          newRequest = true;
+          gapBytesSkipped += gap;
+        }
+      }
+      gap = 0;
+      char* data = range.data();
+      uint64_t size = range.size();
+      while (size > 0) {
+        if (newRequest || requests.back().length >= partSize) {
+          requests.push_back(ReadRequest{position});
+          newRequest = false;
+        }
+        auto& request = requests.back();
+        const auto numBytes = std::min(size, partSize - request.length);
+        request.buffers.emplace_back(data, numBytes);
+        request.length += numBytes;
+        data += numBytes;
+        size -= numBytes;
+        position += numBytes;
+      }
+    }
+    length = position + gap - offset;
+    costModel_->recordGaps(gapBytesRead, gapBytesSkipped);
+    return requests;
+  }
 
+  // Copies the ranges of 'buffers' from 'data'.
+  static void copyRanges(
+      const std::vector<folly::Range<char*>>& buffers,
+      const char* data) {
+    size_t resultOffset = 0;
+    for (auto range : buffers) {
+      if (range.data()) {
+        memcpy(range.data(), data + resultOffset, range.size());
+      }
+      resultOffset += range.size();
+    }
+  }
+
+  void read(const ReadRequest& request) const {
+    if (request.buffers.size() == 1) {
+      preadInternal(request.offset, request.length, request.buffers[0].data());
+      return;
+    }
+    // TODO: allocate from a memory pool
+    std::string result(request.length, 0);
+    preadInternal(request.offset, request.length, result.data());
+    copyRanges(request.buffers, result.data());
+  }
+
+  folly::SemiFuture<uint64_t> readAsync(ReadRequest request) const {
+    // A single range is read in place. Ranges with gaps are read into a
+    // temporary buffer and copied after the read.
+    auto read = std::make_shared<AsyncRead>();
+    char* position;
+    if (request.buffers.size() == 1) {
+      position = request.buffers[0].data();
+    } else {
+      read->buffers = std::move(request.buffers);
+      read->data.resize(request.length);
+      position = read->data.data();
+    }
+    auto [promise, future] = folly::makePromiseContract<uint64_t>();
+    read->promise = std::move(promise);
+    client_->GetObjectAsync(
+        makeRequest(request.offset, request.length, position),
+        [read,
+         length = request.length,
+         costModel = costModel_,
+         startUs = getCurrentTimeMicro(),
+         bucket = bucket_,
+         key = key_](
+            const auto* /*client*/,
+            const auto& /*request*/,
+            auto&& outcome,
+            const auto& /*context*/) {
+          try {
+            VELOX_CHECK_AWS_OUTCOME(
+                outcome, "Failed to get S3 object", bucket, key);
+            costModel->recordRequest(length, getCurrentTimeMicro() - startUs);
+            copyRanges(read->buffers, read->data.data());
+            read->promise.setValue(length);
+          } catch (const std::exception&) {
+            read->promise.setException(
+                folly::exception_wrapper(std::current_exception()));
+          }
+        });
+    return std::move(future);
+  }
+
+  // Makes a request for 'length' bytes at 'offset'. The assumption here is
+  // that "position" has space for at least "length" bytes.
+  Aws::S3::Model::GetObjectRequest
+  makeRequest(uint64_t offset, uint64_t length, char* position) const {
+    Aws::S3::Model::GetObjectRequest request;
     request.SetBucket(awsString(bucket_));
     request.SetKey(awsString(key_));
     std::stringstream ss;
@@ -172,11 +407,20 @@ class S3ReadFile final : public ReadFile {
     request.SetRange(awsString(ss.str()));
     request.SetResponseStreamFactory(
         AwsWriteableStreamFactory(position, length));
-    auto outcome = client_->GetObject(request);
+    return request;
+  }
+
+  void preadInternal(uint64_t offset, uint64_t length, char* position) const {
+    // Read the desired range of bytes.
+    const auto startUs = getCurrentTimeMicro();
+    auto outcome = client_->GetObject(makeRequest(offset, length, position));
     VELOX_CHECK_AWS_OUTCOME(outcome, "Failed to get S3 object", bucket_, key_);
+    costModel_->recordRequest(length, getCurrentTimeMicro() - startUs);
   }
 
   Aws::S3::S3Client* client_;
+  const std::shared_ptr<S3ReadCostModel> costModel_;
+  const bool asyncReads_;
   std::string bucket_;
   std::string key_;
   int64_t length_ = -1;
@@ -511,6 +755,19 @@ class S3FileSystem::Impl {
     Aws::Client::ClientConfiguration clientConfig;
     clientConfig.endpointOverride = HiveConfig::s3Endpoint(config_);
 
+    // Asynchronous reads run on a pool of 'maxAsyncReads' threads, which
+    // bounds the requests in flight for the file system.
+    costModel_ = std::make_shared<S3ReadCostModel>(
+        HiveConfig::s3ReadPartSize(config_));
+    maxAsyncReads_ = HiveConfig::s3MaxAsyncReads(config_);
+    if (maxAsyncReads_ > 0) {
+      clientConfig.executor =
+          std::make_shared<Aws::Utils::Threading::PooledThreadExecutor>(
+              maxAsyncReads_);
+      clientConfig.maxConnections =
+          std::max<uint32_t>(clientConfig.maxConnections, maxAsyncReads_);
+    }
+
     if (HiveConfig::s3UseSSL(config_)) {
       clientConfig.scheme = Aws::Http::Scheme::HTTPS;
     } else {
@@ -602,6 +859,15 @@ class S3FileSystem::Impl {
     return client_.get();
   }
 
+  // Returns true if files are read with the asynchronous S3 client.
+  bool asyncReads() const {
+    return maxAsyncReads_ > 0;
+  }
+
+  const std::shared_ptr<S3ReadCostModel>& costModel() const {
+    return costModel_;
+  }
+
   std::string getLogLevelName() const {
     return getAwsInstance()->getLogLevelName();
   }
@@ -609,6 +875,8 @@ class S3FileSystem::Impl {
  private:
   const Config* config_;
   std::shared_ptr<Aws::S3::S3Client> client_;
+  int32_t maxAsyncReads_{0};
+  std::shared_ptr<S3ReadCostModel> costModel_;
 };
 
 S3FileSystem::S3FileSystem(std::shared_ptr<const Config> config)
@@ -620,11 +888,16 @@ std::string S3FileSystem::getLogLevelName() const {
   return impl_->getLogLevelName();
 }
 
+S3ReadStats S3FileSystem::readStats() const {
+  return impl_->costModel()->stats();
+}
+
 std::unique_ptr<ReadFile> S3FileSystem::openFileForRead(
     std::string_view path,
     const FileOptions& /*unused*/) {
   const auto file = s3Path(path);
-  auto s3file = std::make_unique<S3ReadFile>(file, impl_->s3Client());
+  auto s3file = std::make_unique<S3ReadFile>(
+      file, impl_->s3Client(), impl_->costModel(), impl_->asyncReads());
   s3file->initialize();
   return s3file;
 }
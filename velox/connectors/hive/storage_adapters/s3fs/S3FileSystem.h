@@ -24,6 +24,21 @@ bool initializeS3(const Config* config);
 
 void finalizeS3();
 
+/// Counters of the GET requests made by the files of a S3FileSystem.
+struct S3ReadStats {
+  uint64_t numRequests{0};
+
+  /// Bytes returned by the requests, including gaps.
+  uint64_t bytesRead{0};
+
+  /// Bytes in gaps between requested ranges that were read and discarded
+  /// because a separate request would have cost more.
+  uint64_t gapBytesRead{0};
+
+  /// Bytes in gaps between requested ranges that were not read.
+  uint64_t gapBytesSkipped{0};
+};
+
 /// Implementation of S3 filesystem and file interface.
 /// We provide a registration method for read and write files so the appropriate
 /// type of file can be constructed based on a filename.
@@ -70,6 +85,9 @@ class S3FileSystem : public FileSystem {
 
   std::string getLogLevelName() const;
 
+  /// Returns the counters of the reads of the files opened by 'this'.
+  S3ReadStats readStats() const;
+
  protected:
   class Impl;
   std::shared_ptr<Impl> impl_;
@@ -109,6 +109,118 @@ TEST_F(S3FileSystemTest, invalidCredentialsConfig) {
   }
 }
 
+TEST_F(S3FileSystemTest, readAsync) {
+  const char* bucketName = "data-async";
+  const char* file = "test.txt";
+  const std::string filename = localPath(bucketName) + "/" + file;
+  const std::string s3File = s3URI(bucketName, file);
+  addBucket(bucketName);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  {
+    filesystems::S3FileSystem s3fs(
+        minioServer_->hiveConfig({{"hive.s3.max-async-reads", "0"}}));
+    auto readFile = s3fs.openFileForRead(s3File);
+    ASSERT_FALSE(readFile->hasPreadvAsync());
+  }
+  filesystems::S3FileSystem s3fs(
+      minioServer_->hiveConfig({{"hive.s3.max-async-reads", "4"}}));
+  auto readFile = s3fs.openFileForRead(s3File);
+  ASSERT_TRUE(readFile->hasPreadvAsync());
+
+  char head[10];
+  char tail[5];
+  std::vector<folly::Range<char*>> buffers = {
+      folly::Range<char*>(head, sizeof(head)),
+      folly::Range<char*>(nullptr, kOneMB),
+      folly::Range<char*>(tail, sizeof(tail))};
+  std::vector<std::string> singles(8, std::string(5, 0));
+  std::vector<folly::SemiFuture<uint64_t>> reads;
+  reads.push_back(readFile->preadvAsync(0, buffers));
+  // More reads than the executor threads wait in its queue.
+  for (auto& single : singles) {
+    reads.push_back(readFile->preadvAsync(
+        10 + kOneMB, {folly::Range<char*>(single.data(), single.size())}));
+  }
+  auto results = folly::collectAll(std::move(reads)).get();
+  ASSERT_EQ(15 + kOneMB, results[0].value());
+  for (size_t i = 1; i < results.size(); ++i) {
+    ASSERT_EQ(5, results[i].value());
+  }
+  ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbb");
+  ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ddddd");
+  for (const auto& single : singles) {
+    ASSERT_EQ(single, "ddddd");
+  }
+
+  VELOX_ASSERT_THROW(
+      readFile->preadvAsync(20 + kOneMB, {folly::Range<char*>(tail, 5)})
+          .get(),
+      "Failed to get S3 object");
+}
+
+TEST_F(S3FileSystemTest, readPlanning) {
+  const char* bucketName = "data-planning";
+  const char* file = "test.txt";
+  const std::string filename = localPath(bucketName) + "/" + file;
+  const std::string s3File = s3URI(bucketName, file);
+  addBucket(bucketName);
+  {
+    LocalWriteFile writeFile(filename);
+    writeData(&writeFile);
+  }
+  constexpr uint64_t kPartSize = 256 << 10;
+  filesystems::S3FileSystem s3fs(minioServer_->hiveConfig(
+      {{"hive.s3.max-async-reads", "0"},
+       {"hive.s3.read-part-size", std::to_string(kPartSize)}}));
+  auto readFile = s3fs.openFileForRead(s3File);
+
+  // A small gap is read by the request of the surrounding ranges.
+  char a[5];
+  char b[5];
+  ASSERT_EQ(
+      10 + 5,
+      readFile->preadv(
+          0,
+          {folly::Range<char*>(a, sizeof(a)),
+           folly::Range<char*>(nullptr, 5),
+           folly::Range<char*>(b, sizeof(b))}));
+  ASSERT_EQ(std::string_view(a, sizeof(a)), "aaaaa");
+  ASSERT_EQ(std::string_view(b, sizeof(b)), "ccccc");
+  auto stats = s3fs.readStats();
+  ASSERT_EQ(stats.numRequests, 1);
+  ASSERT_EQ(stats.bytesRead, 15);
+  ASSERT_EQ(stats.gapBytesRead, 5);
+  ASSERT_EQ(stats.gapBytesSkipped, 0);
+
+  // A gap over the part size separates the requests.
+  char head[10];
+  char tail[5];
+  ASSERT_EQ(
+      15 + kOneMB,
+      readFile->preadv(
+          0,
+          {folly::Range<char*>(head, sizeof(head)),
+           folly::Range<char*>(nullptr, kOneMB),
+           folly::Range<char*>(tail, sizeof(tail))}));
+  ASSERT_EQ(std::string_view(head, sizeof(head)), "aaaaabbbbb");
+  ASSERT_EQ(std::string_view(tail, sizeof(tail)), "ddddd");
+  stats = s3fs.readStats();
+  ASSERT_EQ(stats.numRequests, 3);
+  ASSERT_EQ(stats.bytesRead, 15 + 15);
+  ASSERT_EQ(stats.gapBytesRead, 5);
+  ASSERT_EQ(stats.gapBytesSkipped, kOneMB);
+
+  // A range over the part size is read by multiple requests.
+  const auto data = readFile->pread(10, kOneMB);
+  ASSERT_EQ(data, std::string(kOneMB, 'c'));
+  stats = s3fs.readStats();
+  ASSERT_EQ(stats.numRequests, 3 + kOneMB / kPartSize);
+  ASSERT_EQ(stats.bytesRead, 30 + kOneMB);
+}
+
 TEST_F(S3FileSystemTest, missingFile) {
   const char* bucketName = "data1";
   const char* file = "i-do-not-exist.txt";
@@ -14,12 +14,14 @@
  * limitations under the License.
  */
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <gtest/gtest.h>
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 
 #include "velox/connectors/hive/HiveConfig.h"
 #include "velox/connectors/hive/HiveConnector.h"
 #include "velox/connectors/hive/HiveDataSource.h"
+#include "velox/core/Config.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
 
 namespace facebook::velox::connector::hive {
@@ -398,5 +400,116 @@ TEST_F(HiveConnectorTest, extractFiltersFromRemainingFilter) {
       remaining->toString(), "not(lt(ROW[\"c2\"],cast 0 as DECIMAL(20, 0)))");
 }
 
+TEST_F(HiveConnectorTest, aggregateFromStatistics) {
+  auto filePath = TempFilePath::create();
+  auto fileType = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  writeToFile(
+      filePath->path,
+      makeRowVector(
+          fileType->names(),
+          {makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+           makeFlatVector<std::string>(
+               1'000,
+               [](auto row) { return fmt::format("s{}", row % 10); },
+               [](auto row) { return row % 4 == 0; })}));
+
+  auto outputType = ROW({"c0", "c1", "ds"}, {BIGINT(), VARCHAR(), VARCHAR()});
+  auto assignments = allRegularColumns(fileType);
+  assignments["ds"] = partitionKey("ds", VARCHAR());
+  core::MemConfig config;
+  ConnectorQueryCtx connectorQueryCtx(
+      pool_.get(),
+      pool_.get(),
+      nullptr,
+      &config,
+      nullptr,
+      nullptr,
+      nullptr,
+      "query.HiveConnectorTest",
+      "task.HiveConnectorTest",
+      "planNodeId.HiveConnectorTest",
+      0);
+  using Kind = StatisticsAggregate::Kind;
+  const std::vector<StatisticsAggregate> aggregates = {
+      {Kind::kCount, ""},
+      {Kind::kMin, "c0"},
+      {Kind::kMax, "c0"},
+      {Kind::kNullCount, "c1"},
+      {Kind::kMin, "c1"},
+      {Kind::kMax, "ds"},
+  };
+  auto aggregate = [&](SubfieldFilters filters) {
+    auto dataSource = getConnector(kHiveConnectorId)
+                          ->createDataSource(
+                              outputType,
+                              makeTableHandle(std::move(filters)),
+                              assignments,
+                              &connectorQueryCtx);
+    dataSource->addSplit(HiveConnectorSplitBuilder(filePath->path)
+                             .partitionKey("ds", "2023-01-01")
+                             .build());
+    return dataSource->aggregateFromStatistics(aggregates);
+  };
+
+  const std::vector<variant> allRows = {
+      variant(static_cast<int64_t>(1'000)),
+      variant(static_cast<int64_t>(0)),
+      variant(static_cast<int64_t>(999)),
+      variant(static_cast<int64_t>(250)),
+      variant("s0"),
+      variant("2023-01-01"),
+  };
+  EXPECT_EQ(aggregate({}), allRows);
+  // The filter passes all rows.
+  EXPECT_EQ(
+      aggregate(SubfieldFiltersBuilder()
+                    .add("c0", exec::greaterThanOrEqual(0))
+                    .build()),
+      allRows);
+  // The filter passes no row.
+  const std::vector<variant> noRows = {
+      variant(static_cast<int64_t>(0)),
+      variant::null(TypeKind::BIGINT),
+      variant::null(TypeKind::BIGINT),
+      variant(static_cast<int64_t>(0)),
+      variant::null(TypeKind::VARCHAR),
+      variant::null(TypeKind::VARCHAR),
+  };
+  EXPECT_EQ(
+      aggregate(
+          SubfieldFiltersBuilder().add("c0", exec::lessThan(0)).build()),
+      noRows);
+  // The filters pass some rows and the data must be read.
+  EXPECT_FALSE(aggregate(SubfieldFiltersBuilder()
+                             .add("c0", exec::greaterThanOrEqual(500))
+                             .build())
+                   .has_value());
+  EXPECT_FALSE(
+      aggregate(SubfieldFiltersBuilder().add("c1", exec::isNotNull()).build())
+          .has_value());
+}
+
+TEST_F(HiveConnectorTest, warmFileHandles) {
+  auto files = makeFilePaths(3);
+  std::vector<std::string> filePaths;
+  for (const auto& file : files) {
+    filePaths.push_back(file->path);
+  }
+  filePaths.push_back("/path/that/does/not/exist");
+
+  auto executor = std::make_unique<folly::CPUThreadPoolExecutor>(4);
+  for (auto* connectorExecutor :
+       std::vector<folly::Executor*>{nullptr, executor.get()}) {
+    HiveConnector connector("warm", nullptr, connectorExecutor);
+    ASSERT_EQ(connector.warmFileHandles(filePaths), 3);
+    ASSERT_EQ(connector.fileHandleCacheStats().curSize, 3);
+    ASSERT_EQ(connector.fileHandleCacheStats().numHits, 0);
+
+    // The handles are now cached.
+    ASSERT_EQ(connector.warmFileHandles(filePaths), 0);
+    ASSERT_EQ(connector.fileHandleCacheStats().numHits, 3);
+  }
+}
+
 } // namespace
 } // namespace facebook::velox::connector::hive
@@ -20,6 +20,7 @@
 #include <folly/init/Init.h>
 #include "velox/common/base/Fs.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/connectors/hive/HiveConfig.h"
 #include "velox/core/Config.h"
 #include "velox/dwio/common/Options.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
@@ -44,11 +45,21 @@ class HiveDataSinkTest : public exec::test::HiveConnectorTestBase {
     rowType_ =
         ROW({"c0", "c1", "c2", "c3", "c4", "c5"},
             {BIGINT(), INTEGER(), SMALLINT(), REAL(), DOUBLE(), VARCHAR()});
+    setConnectorQueryContext(connectorConfig_.get());
+
+    auto hiveConnector =
+        connector::getConnectorFactory(
+            connector::hive::HiveConnectorFactory::kHiveConnectorName)
+            ->newConnector(kHiveConnectorId, nullptr);
+    connector::registerConnector(std::move(hiveConnector));
+  }
+
+  void setConnectorQueryContext(const Config* config) {
     connectorQueryCtx_ = std::make_unique<connector::ConnectorQueryCtx>(
         opPool_.get(),
         connectorPool_.get(),
         nullptr,
-        connectorConfig_.get(),
+        config,
         nullptr,
         nullptr,
         nullptr,
@@ -56,12 +67,6 @@ class HiveDataSinkTest : public exec::test::HiveConnectorTestBase {
         "task.HiveDataSinkTest",
         "planNodeId.HiveDataSinkTest",
         0);
-
-    auto hiveConnector =
-        connector::getConnectorFactory(
-            connector::hive::HiveConnectorFactory::kHiveConnectorName)
-            ->newConnector(kHiveConnectorId, nullptr);
-    connector::registerConnector(std::move(hiveConnector));
   }
 
   std::shared_ptr<connector::hive::HiveInsertTableHandle>
@@ -416,6 +421,41 @@ TEST_F(HiveDataSinkTest, basic) {
   verifyWrittenData(outputDirectory->path);
 }
 
+TEST_F(HiveDataSinkTest, maxBufferedBytes) {
+  const int numBatches = 10;
+  VectorFuzzer::Options options;
+  options.vectorSize = 500;
+  VectorFuzzer fuzzer(options, pool());
+  std::vector<RowVectorPtr> vectors;
+  for (int i = 0; i < numBatches; ++i) {
+    vectors.push_back(fuzzer.fuzzRow(rowType_));
+  }
+  createDuckDbTable(vectors);
+
+  const std::shared_ptr<const Config> limitConfig =
+      std::make_shared<core::MemConfig>(
+          std::unordered_map<std::string, std::string>{
+              {HiveConfig::kMaxPartitionWritersBufferedBytes, "1024"}});
+  std::vector<int64_t> bytesBeforeClose;
+  for (const auto* config : {connectorConfig_.get(), limitConfig.get()}) {
+    SCOPED_TRACE(fmt::format(
+        "maxBufferedBytes: {}",
+        HiveConfig::maxPartitionWritersBufferedBytes(config)));
+    setConnectorQueryContext(config);
+    const auto outputDirectory = TempDirectoryPath::create();
+    auto dataSink = createDataSink(rowType_, outputDirectory->path);
+    for (const auto& vector : vectors) {
+      dataSink->appendData(vector);
+    }
+    bytesBeforeClose.push_back(dataSink->getCompletedBytes());
+    ASSERT_EQ(dataSink->close(true).size(), 1);
+    verifyWrittenData(outputDirectory->path);
+  }
+  // With the limit set, the writer flushes a stripe after each input so most
+  // of the data is already written out before close.
+  ASSERT_GT(bytesBeforeClose[1], bytesBeforeClose[0]);
+}
+
 TEST_F(HiveDataSinkTest, close) {
   for (bool empty : {true, false}) {
     SCOPED_TRACE(fmt::format("Data sink is empty: {}", empty));
@@ -75,6 +75,32 @@ TEST_F(PartitionIdGeneratorTest, consecutiveIdsMultipleKeys) {
       numPartitions - 1);
 }
 
+TEST_F(PartitionIdGeneratorTest, manyValueIds) {
+  // The three keys have 200 distinct values each, so the combined value ids
+  // are too many to be mapped through a dense table.
+  const auto numPartitions = 200;
+  PartitionIdGenerator idGenerator(
+      ROW({BIGINT(), BIGINT(), BIGINT()}), {0, 1, 2}, numPartitions, pool());
+
+  auto makeInput = [&](vector_size_t size, int64_t offset) {
+    auto values = makeFlatVector<int64_t>(
+        size, [&](auto row) { return (row + offset) % numPartitions; });
+    return makeRowVector({values, values, values});
+  };
+
+  raw_vector<uint64_t> ids;
+  idGenerator.run(makeInput(numPartitions, 0), ids);
+  for (auto i = 0; i < numPartitions; ++i) {
+    ASSERT_EQ(ids[i], i);
+  }
+
+  idGenerator.run(makeInput(1'000, 7), ids);
+  for (auto i = 0; i < ids.size(); ++i) {
+    ASSERT_EQ(ids[i], (i + 7) % numPartitions);
+  }
+  ASSERT_EQ(idGenerator.numPartitions(), numPartitions);
+}
+
 TEST_F(PartitionIdGeneratorTest, stableIdsSingleKey) {
   PartitionIdGenerator idGenerator(ROW({BIGINT()}), {0}, 100, pool());
 
@@ -71,7 +71,11 @@ TpchDataSource::TpchDataSource(
       tpchTableHandle, "TableHandle must be an instance of TpchTableHandle");
   tpchTable_ = tpchTableHandle->getTable();
   scaleFactor_ = tpchTableHandle->getScaleFactor();
-  tpchTableRowCount_ = getRowCount(tpchTable_, scaleFactor_);
+  // Lineitem rows are generated for a range of orders, so its splits and
+  // batches are ranges of orders.
+  tpchTableRowCount_ = getRowCount(
+      tpchTable_ == Table::TBL_LINEITEM ? Table::TBL_ORDERS : tpchTable_,
+      scaleFactor_);
 
   auto tpchTableSchema = getTableSchema(tpchTableHandle->getTable());
   VELOX_CHECK_NOT_NULL(tpchTableSchema, "TpchSchema can't be null.");
@@ -132,8 +136,9 @@ void TpchDataSource::addSplit(std::shared_ptr<ConnectorSplit> split) {
   size_t partSize =
       std::ceil((double)tpchTableRowCount_ / (double)currentSplit_->totalParts);
 
-  splitOffset_ = partSize * currentSplit_->partNumber;
-  splitEnd_ = splitOffset_ + partSize;
+  splitOffset_ = std::min<uint64_t>(
+      partSize * currentSplit_->partNumber, tpchTableRowCount_);
+  splitEnd_ = std::min<uint64_t>(splitOffset_ + partSize, tpchTableRowCount_);
 }
 
 std::optional<RowVectorPtr> TpchDataSource::next(
@@ -142,6 +147,10 @@ std::optional<RowVectorPtr> TpchDataSource::next(
   VELOX_CHECK_NOT_NULL(
       currentSplit_, "No split to process. Call addSplit() first.");
 
+  // An order has four lineitems on average.
+  if (tpchTable_ == Table::TBL_LINEITEM) {
+    size = std::max<uint64_t>(1, size / 4);
+  }
   size_t maxRows = std::min(size, (splitEnd_ - splitOffset_));
   auto outputVector =
       getTpchData(tpchTable_, maxRows, splitOffset_, scaleFactor_, pool_);
@@ -106,6 +106,7 @@ class TpchDataSource : public DataSource {
 
   velox::tpch::Table tpchTable_;
   double scaleFactor_{1.0};
+  // Row count of the table, or of orders for lineitem.
   size_t tpchTableRowCount_{0};
   RowTypePtr outputType_;
 
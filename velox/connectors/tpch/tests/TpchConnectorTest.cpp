@@ -191,6 +191,30 @@ TEST_F(TpchConnectorTest, lineitemTinyRowCount) {
   EXPECT_EQ(60'175, output->childAt(0)->asFlatVector<int64_t>()->valueAt(0));
 }
 
+// Lineitem splits are ranges of orders. Many splits must return the same rows
+// as one.
+TEST_F(TpchConnectorTest, lineitemMultipleSplits) {
+  auto plan = PlanBuilder()
+                  .tableScan(
+                      Table::TBL_LINEITEM,
+                      {"l_orderkey", "l_linenumber", "l_shipdate"},
+                      0.01)
+                  .orderBy({"l_orderkey", "l_linenumber"}, false)
+                  .planNode();
+
+  auto fullResult = getResults(plan, {makeTpchSplit()});
+  EXPECT_EQ(60'175, fullResult->size());
+
+  for (size_t totalParts : {3, 16, 100}) {
+    std::vector<exec::Split> splits;
+    for (size_t i = 0; i < totalParts; ++i) {
+      splits.emplace_back(makeTpchSplit(totalParts, i));
+    }
+    auto output = getResults(plan, std::move(splits));
+    test::assertEqualVectors(fullResult, output);
+  }
+}
+
 TEST_F(TpchConnectorTest, unknownColumn) {
   EXPECT_THROW(
       {
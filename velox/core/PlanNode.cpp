@@ -923,11 +923,17 @@ void HashJoinNode::addDetails(std::stringstream& stream) const {
   if (nullAware_) {
     stream << ", null aware";
   }
+  if (buildCacheKey_.has_value()) {
+    stream << ", build cache key: " << buildCacheKey_.value();
+  }
 }
 
 folly::dynamic HashJoinNode::serialize() const {
   auto obj = serializeBase();
   obj["nullAware"] = nullAware_;
+  if (buildCacheKey_.has_value()) {
+    obj["buildCacheKey"] = buildCacheKey_.value();
+  }
   return obj;
 }
 
@@ -947,6 +953,11 @@ PlanNodePtr HashJoinNode::create(const folly::dynamic& obj, void* context) {
 
   auto outputType = deserializeRowType(obj["outputType"]);
 
+  std::optional<std::string> buildCacheKey;
+  if (obj.count("buildCacheKey")) {
+    buildCacheKey = obj["buildCacheKey"].asString();
+  }
+
   return std::make_shared<HashJoinNode>(
       deserializePlanNodeId(obj),
       joinTypeFromName(obj["joinType"].asString()),
@@ -956,7 +967,8 @@ PlanNodePtr HashJoinNode::create(const folly::dynamic& obj, void* context) {
       filter,
       sources[0],
       sources[1],
-      outputType);
+      outputType,
+      std::move(buildCacheKey));
 }
 
 folly::dynamic MergeJoinNode::serialize() const {
@@ -1709,12 +1721,16 @@ void LocalPartitionNode::addDetails(std::stringstream& stream) const {
   if (type_ != Type::kGather) {
     stream << " " << partitionFunctionSpec_->toString();
   }
+  if (scaleWriter_) {
+    stream << " scaleWriter";
+  }
 }
 
 folly::dynamic LocalPartitionNode::serialize() const {
   auto obj = PlanNode::serialize();
   obj["type"] = typeName(type_);
   obj["partitionFunctionSpec"] = partitionFunctionSpec_->serialize();
+  obj["scaleWriter"] = scaleWriter_;
   return obj;
 }
 
@@ -1727,7 +1743,8 @@ PlanNodePtr LocalPartitionNode::create(
       typeFromName(obj["type"].asString()),
       ISerializable::deserialize<PartitionFunctionSpec>(
           obj["partitionFunctionSpec"]),
-      deserializeSources(obj, context));
+      deserializeSources(obj, context),
+      obj.getDefault("scaleWriter", false).asBool());
 }
 
 // static
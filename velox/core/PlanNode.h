@@ -985,11 +985,16 @@ class LocalMergeNode : public PlanNode {
 /// Calculates partition number for each row of the specified vector.
 class PartitionFunction {
  public:
+  /// Partition number of a row that goes to all partitions, e.g. a build side
+  /// row with a heavy-hitter join key.
+  static constexpr uint32_t kAllPartitions =
+      std::numeric_limits<uint32_t>::max();
+
   virtual ~PartitionFunction() = default;
 
   /// @param input RowVector to split into partitions.
   /// @param [out] partitions Computed partition numbers for each row in
-  /// 'input'.
+  /// 'input'. May contain kAllPartitions for rows to replicate.
   /// @return Returns partition number in case all rows of 'input' are assigned
   /// to the same partition. In this case 'partitions' vector is left unchanged.
   /// Used to optimize round-robin partitioning in local exchange.
@@ -1055,11 +1060,13 @@ class LocalPartitionNode : public PlanNode {
       const PlanNodeId& id,
       Type type,
       PartitionFunctionSpecPtr partitionFunctionSpec,
-      std::vector<PlanNodePtr> sources)
+      std::vector<PlanNodePtr> sources,
+      bool scaleWriter = false)
       : PlanNode(id),
         type_{type},
         sources_{std::move(sources)},
-        partitionFunctionSpec_{std::move(partitionFunctionSpec)} {
+        partitionFunctionSpec_{std::move(partitionFunctionSpec)},
+        scaleWriter_{scaleWriter} {
     VELOX_USER_CHECK_GT(
         sources_.size(),
         0,
@@ -1067,6 +1074,10 @@ class LocalPartitionNode : public PlanNode {
 
     VELOX_USER_CHECK_NOT_NULL(partitionFunctionSpec_);
 
+    VELOX_USER_CHECK(
+        !scaleWriter_ || type_ == Type::kRepartition,
+        "Scale writer local partitioning requires a repartition exchange");
+
     for (auto i = 1; i < sources_.size(); ++i) {
       VELOX_USER_CHECK(
           *sources_[i]->outputType() == *sources_[0]->outputType(),
@@ -1102,6 +1113,16 @@ class LocalPartitionNode : public PlanNode {
     return *partitionFunctionSpec_;
   }
 
+  /// True if the exchange feeds table writers and distributes its input
+  /// round-robin over a growing subset of the consumers instead of
+  /// partitioning it with 'partitionFunctionSpec'. The exchange starts with
+  /// one active writer and activates another one when the active writers do
+  /// not keep up with the input, so that small inserts write few files and
+  /// large ones use all writers.
+  bool scaleWriter() const {
+    return scaleWriter_;
+  }
+
   std::string_view name() const override {
     return "LocalPartition";
   }
@@ -1116,6 +1137,7 @@ class LocalPartitionNode : public PlanNode {
   const Type type_;
   const std::vector<PlanNodePtr> sources_;
   const PartitionFunctionSpecPtr partitionFunctionSpec_;
+  const bool scaleWriter_;
 };
 
 class PartitionedOutputNode : public PlanNode {
@@ -1490,6 +1512,12 @@ class AbstractJoinNode : public PlanNode {
 /// 'nullAware' boolean applies to semi and anti joins. When true, the join
 /// semantic is IN / NOT IN. When false, the join semantic is EXISTS / NOT
 /// EXISTS.
+///
+/// 'buildCacheKey' opts the join into sharing its hash table with later tasks
+/// through exec::HashTableCache. The key must identify the rows of the build
+/// side: the table, its snapshot or set of splits, and the filters applied to
+/// it. The join keys and the build side columns are added to the key by
+/// HashBuild.
 class HashJoinNode : public AbstractJoinNode {
  public:
   HashJoinNode(
@@ -1501,7 +1529,8 @@ class HashJoinNode : public AbstractJoinNode {
       TypedExprPtr filter,
       PlanNodePtr left,
       PlanNodePtr right,
-      RowTypePtr outputType)
+      RowTypePtr outputType,
+      std::optional<std::string> buildCacheKey = std::nullopt)
       : AbstractJoinNode(
             id,
             joinType,
@@ -1511,7 +1540,8 @@ class HashJoinNode : public AbstractJoinNode {
             std::move(left),
             std::move(right),
             std::move(outputType)),
-        nullAware_{nullAware} {
+        nullAware_{nullAware},
+        buildCacheKey_{std::move(buildCacheKey)} {
     if (nullAware) {
       VELOX_USER_CHECK(
           isNullAwareSupported(joinType),
@@ -1544,6 +1574,10 @@ class HashJoinNode : public AbstractJoinNode {
     return nullAware_;
   }
 
+  const std::optional<std::string>& buildCacheKey() const {
+    return buildCacheKey_;
+  }
+
   folly::dynamic serialize() const override;
 
   static PlanNodePtr create(const folly::dynamic& obj, void* context);
@@ -1552,6 +1586,7 @@ class HashJoinNode : public AbstractJoinNode {
   void addDetails(std::stringstream& stream) const override;
 
   const bool nullAware_;
+  const std::optional<std::string> buildCacheKey_;
 };
 
 /// Represents inner/outer/semi/anti merge joins. Translates to an
@@ -1580,6 +1615,10 @@ class MergeJoinNode : public AbstractJoinNode {
             std::move(right),
             std::move(outputType)) {}
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return queryConfig.mergeJoinSpillEnabled();
+  }
+
   std::string_view name() const override {
     return "MergeJoin";
   }
@@ -2112,6 +2151,12 @@ class WindowNode : public PlanNode {
     return inputsSorted_;
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    // NOTE: only the sort based window build holds all the input in memory.
+    // The streaming window build only buffers the current partition.
+    return !inputsSorted_ && queryConfig.windowSpillEnabled();
+  }
+
   std::string_view name() const override {
     return "Window";
   }
@@ -2177,6 +2222,11 @@ class RowNumberNode : public PlanNode {
     return outputType_->size() > sources_[0]->outputType()->size();
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    // NOTE: without partitioning keys there is no state to spill.
+    return !partitionKeys_.empty() && queryConfig.rowNumberSpillEnabled();
+  }
+
   std::string_view name() const override {
     return "RowNumber";
   }
@@ -2219,6 +2269,10 @@ class MarkDistinctNode : public PlanNode {
     return outputType_;
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return queryConfig.markDistinctSpillEnabled();
+  }
+
   std::string_view name() const override {
     return "MarkDistinct";
   }
@@ -2297,6 +2351,10 @@ class TopNRowNumberNode : public PlanNode {
     return outputType_->size() > sources_[0]->outputType()->size();
   }
 
+  bool canSpill(const QueryConfig& queryConfig) const override {
+    return queryConfig.topNRowNumberSpillEnabled();
+  }
+
   std::string_view name() const override {
     return "TopNRowNumber";
   }
@@ -92,6 +92,19 @@ class QueryConfig {
   static constexpr const char* kOperatorTrackCpuUsage =
       "track_operator_cpu_usage";
 
+  /// If non-zero, reads the hardware counters (cycles, instructions, last
+  /// level cache misses and branch misses) around one in every this many
+  /// getOutput(), addInput() and noMoreInput() calls of each driver and adds
+  /// the differences to the runtime stats of the operator. 0 disables the
+  /// sampling. Has no effect where perf events are not available.
+  static constexpr const char* kOperatorPerfCounterSampleInterval =
+      "operator_perf_counter_sample_interval";
+
+  /// The number of trace events each task keeps in its ring buffer. The events
+  /// cover the times Drivers spend on thread, in the executor queue, blocked
+  /// and reclaiming memory. See Task::toChromeTrace(). 0 disables tracing.
+  static constexpr const char* kTaskTraceBufferSize = "task_trace_buffer_size";
+
   /// Flags used to configure the CAST operator:
 
   /// This flag makes the Row conversion to by applied in a way that the casting
@@ -123,11 +136,30 @@ class QueryConfig {
   static constexpr const char* kMaxLocalExchangeBufferSize =
       "max_local_exchange_buffer_size";
 
+  /// Minimum number of bytes a scale-writer local exchange routes to each
+  /// active table writer before it activates another writer. Keeps small
+  /// inserts from writing many small files.
+  static constexpr const char* kScaleWriterMinProcessedBytes =
+      "scale_writer_min_processed_bytes";
+
   /// Maximum size in bytes to accumulate in ExchangeQueue. Enforced
   /// approximately, not strictly.
   static constexpr const char* kMaxExchangeBufferSize =
       "exchange.max_buffer_size";
 
+  /// The number of average size pages an exchange client asks a source for in
+  /// one request. A larger window lets a source return several pages per
+  /// round trip, which helps latency bound remote exchanges. Requests still
+  /// stay within the free space of the exchange buffer.
+  static constexpr const char* kExchangeRequestWindowPages =
+      "exchange.request_window_pages";
+
+  /// If true, the Exchange operator deserializes the columns of a received page
+  /// on first access. Columns that a downstream filter or join never reads for
+  /// any row of the page are then never materialized.
+  static constexpr const char* kExchangeLazyDeserialization =
+      "exchange.lazy_deserialization";
+
   static constexpr const char* kMaxPartialAggregationMemory =
       "max_partial_aggregation_memory";
 
@@ -140,9 +172,56 @@ class QueryConfig {
   static constexpr const char* kAbandonPartialAggregationMinPct =
       "abandon_partial_aggregation_min_pct";
 
+  /// If greater than zero, a partial aggregation that has been abandoned
+  /// re-checks its reduction after passing through this many rows. The check
+  /// counts the unique grouping keys of the next input batch and resumes
+  /// partial aggregation if fewer than abandon_partial_aggregation_min_pct
+  /// percent of its rows are unique. 0 keeps an abandoned aggregation
+  /// abandoned.
+  static constexpr const char* kPartialAggregationReenableIntervalRows =
+      "partial_aggregation_reenable_interval_rows";
+
+  /// If true, a final grouping aggregation that runs on multiple drivers
+  /// splits its groups into hash partitions. All drivers of the pipeline add
+  /// their input to per-partition grouping sets and, after all input has been
+  /// received, each driver merges and produces the output of a disjoint subset
+  /// of the partitions. This removes the need for a local exchange on the
+  /// grouping keys before the final aggregation. Disables spilling of the
+  /// final aggregation.
+  static constexpr const char* kPartitionedFinalAggregationEnabled =
+      "partitioned_final_aggregation_enabled";
+
+  /// If true, a final order by may run on multiple drivers. Each driver sorts
+  /// its own input and, after all drivers have received all input, the last
+  /// driver to finish merges the sorted runs of all drivers and produces the
+  /// output. Disables spilling of the order by.
+  static constexpr const char* kParallelOrderByEnabled =
+      "parallel_order_by_enabled";
+
   static constexpr const char* kMaxPartitionedOutputBufferSize =
       "max_page_partitioning_buffer_size";
 
+  /// Compression codec of the pages sent by PartitionedOutput and received by
+  /// Exchange. Both ends of an exchange must use the same codec.
+  static constexpr const char* kShuffleCompressionKind =
+      "shuffle_compression_codec";
+
+  /// If true, PartitionedOutput hands its pages over as vectors instead of
+  /// serializing them. This saves the serialization and deserialization when
+  /// all consumers run in the same process and fetch the pages, e.g. with
+  /// InProcessExchangeSource. Pages holding vectors cannot be sent over the
+  /// network.
+  static constexpr const char* kShuffleInProcessVectors =
+      "shuffle_in_process_vectors";
+
+  /// If true, PartitionedOutput with at least this many destinations buffers
+  /// the partitioned row numbers of its input batches in one shared arena and
+  /// serializes the pages of each destination only when the arena is flushed,
+  /// instead of keeping a serialization buffer open per destination. Used to
+  /// reduce buffer memory for high fan-out shuffles. 0 disables the mode.
+  static constexpr const char* kPartitionedOutputCompactMinDestinations =
+      "partitioned_output_compact_min_destinations";
+
   /// Preferred size of batches in bytes to be returned by operators from
   /// Operator::getOutput. It is used when an estimate of average row size is
   /// known. Otherwise kPreferredOutputBatchRows is used.
@@ -162,11 +241,27 @@ class QueryConfig {
   /// output rows.
   static constexpr const char* kMaxOutputBatchRows = "max_output_batch_rows";
 
+  /// If true, an operator that has no estimate of its average row size sizes
+  /// its output batches from the average size of the rows it has produced so
+  /// far, so that batches of wide rows stay within
+  /// kPreferredOutputBatchBytes and batches of narrow rows grow up to
+  /// kMaxOutputBatchRows. The chosen batch sizes are reported in the
+  /// 'outputBatchRows' runtime stat.
+  static constexpr const char* kAdaptiveOutputBatchRows =
+      "adaptive_output_batch_rows";
+
   /// If false, the 'group by' code is forced to use generic hash mode
   /// hashtable.
   static constexpr const char* kHashAdaptivityEnabled =
       "hash_adaptivity_enabled";
 
+  /// If true, the final 'group by' deduplicates the inputs of each distinct
+  /// aggregate through a hash table on the grouping keys and the aggregate
+  /// inputs, and feeds only the first occurrence of each value to a regular
+  /// accumulator, instead of keeping a set of values per group.
+  static constexpr const char* kDistinctAggregationHashDedupEnabled =
+      "distinct_aggregation_hash_dedup_enabled";
+
   /// If true, the conjunction expression can reorder inputs based on the time
   /// taken to calculate them.
   static constexpr const char* kAdaptiveFilterReorderingEnabled =
@@ -182,9 +277,36 @@ class QueryConfig {
   /// Join spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kJoinSpillEnabled = "join_spill_enabled";
 
+  /// Broadcast output buffer spilling flag, only applies if "spill_enabled"
+  /// flag is set. If true, a full broadcast output buffer writes its oldest
+  /// pages to disk instead of blocking the producers. The pages are read back
+  /// for each destination that fetches them, so that slow destinations do not
+  /// pin the broadcast data in memory.
+  static constexpr const char* kBroadcastSpillEnabled =
+      "broadcast_spill_enabled";
+
   /// OrderBy spilling flag, only applies if "spill_enabled" flag is set.
   static constexpr const char* kOrderBySpillEnabled = "order_by_spill_enabled";
 
+  /// Window spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kWindowSpillEnabled = "window_spill_enabled";
+
+  /// RowNumber spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kRowNumberSpillEnabled =
+      "row_number_spill_enabled";
+
+  /// TopNRowNumber spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kTopNRowNumberSpillEnabled =
+      "topn_row_number_spill_enabled";
+
+  /// MarkDistinct spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kMarkDistinctSpillEnabled =
+      "mark_distinct_spill_enabled";
+
+  /// MergeJoin spilling flag, only applies if "spill_enabled" flag is set.
+  static constexpr const char* kMergeJoinSpillEnabled =
+      "merge_join_spill_enabled";
+
   /// The max memory that a final aggregation can use before spilling. If it 0,
   /// then there is no limit.
   static constexpr const char* kAggregationSpillMemoryThreshold =
@@ -200,6 +322,11 @@ class QueryConfig {
   static constexpr const char* kOrderBySpillMemoryThreshold =
       "order_by_spill_memory_threshold";
 
+  /// The max memory that a window can use before spilling. If it 0, then
+  /// there is no limit.
+  static constexpr const char* kWindowSpillMemoryThreshold =
+      "window_spill_memory_threshold";
+
   static constexpr const char* kTestingSpillPct = "testing.spill_pct";
 
   /// The max allowed spilling level with zero being the initial spilling level.
@@ -211,6 +338,14 @@ class QueryConfig {
   /// io and cpu resources.
   static constexpr const char* kMaxSpillLevel = "max_spill_level";
 
+  /// The size threshold of a restored hash join build spill partition above
+  /// which the partition is repartitioned straight into the next spill level
+  /// instead of first building a hash table from it that is likely to spill
+  /// again. Only applies if the next spill level is within kMaxSpillLevel. If
+  /// it is zero, then restored partitions are always built first.
+  static constexpr const char* kJoinSpillRepartitionBytes =
+      "join_spill_repartition_bytes";
+
   /// The max allowed spill file size. If it is zero, then there is no limit.
   static constexpr const char* kMaxSpillFileSize = "max_spill_file_size";
 
@@ -233,6 +368,13 @@ class QueryConfig {
   static constexpr const char* kSpillWriteBufferSize =
       "spill_write_buffer_size";
 
+  /// The max disk write bandwidth in bytes per second shared by all the spill
+  /// writes of a query. This prevents a spilling query from saturating the
+  /// disk shared with other queries and the SSD cache. If it is zero, then
+  /// spill writes are not throttled.
+  static constexpr const char* kSpillWriteBytesPerSec =
+      "spill_write_bytes_per_sec";
+
   static constexpr const char* kSpillStartPartitionBit =
       "spiller_start_partition_bit";
 
@@ -287,11 +429,104 @@ class QueryConfig {
   static constexpr const char* kHashProbeFinishEarlyOnEmptyBuild =
       "hash_probe_finish_early_on_empty_build";
 
+  /// The max size in bytes of a Bloom filter built over the values of a hash
+  /// join key on the build side. These filters are pushed down into the probe
+  /// side table scan when the join keys cannot be represented by an exact
+  /// dynamic filter, e.g. string keys or keys with many distinct values. The
+  /// filters take 2 bytes per distinct build side key. No Bloom filter is built
+  /// if it would exceed this size. 0 disables the Bloom filter pushdown.
+  static constexpr const char* kHashProbeBloomFilterPushdownMaxSize =
+      "hash_probe_bloom_filter_pushdown_max_size";
+
   /// The minimum number of table rows that can trigger the parallel hash join
   /// table build.
   static constexpr const char* kMinTableRowsForParallelJoinBuild =
       "min_table_rows_for_parallel_join_build";
 
+  /// The max estimated bytes of the splits that the drivers of a table scan
+  /// of a task preload ahead of reading them. The estimate is the split size
+  /// scaled by the fraction of the referenced data the scan has read so far.
+  /// Splits of unknown size count as 0 bytes. 0 means no limit besides the
+  /// number of preloaded splits per driver.
+  static constexpr const char* kMaxSplitPreloadBytes =
+      "max_split_preload_bytes";
+
+  /// The max wall time in milliseconds a driver of this query runs on an
+  /// executor thread before it yields and goes to the end of the executor
+  /// queue, letting other drivers run. 0 means a driver stays on thread until
+  /// it blocks or finishes.
+  static constexpr const char* kDriverCpuTimeSliceLimitMs =
+      "driver_cpu_time_slice_limit_ms";
+
+  /// The relative CPU share of this query. The driver time slice of the query
+  /// is 'driver_cpu_time_slice_limit_ms' scaled by this value divided by
+  /// kDefaultQueryCpuShares, so that a query with twice the shares gets twice
+  /// the time on thread per turn in the executor queue.
+  static constexpr const char* kQueryCpuShares = "query_cpu_shares";
+
+  static constexpr uint32_t kDefaultQueryCpuShares = 100;
+
+  /// The number of threads the drivers of a task should use. When more drivers
+  /// of a task are on thread than this, a table scan driver that spends most
+  /// of its time on CPU retires at its next split boundary and leaves the
+  /// remaining splits to the other drivers of its pipeline. Drivers that wait
+  /// for IO are left alone since they do not hold threads. 0 disables
+  /// retiring.
+  static constexpr const char* kMaxRunningDriversPerTask =
+      "max_running_drivers_per_task";
+
+  /// If true, a table scan driver prefers the queued split that reads the
+  /// same file as its previous split over older splits, so that the reads of
+  /// a file stay sequential and coalesce on one driver. Splits whose preload
+  /// is done are still taken first.
+  static constexpr const char* kSplitFileAffinity = "split_file_affinity";
+
+  /// If true, the build side columns of the output of a hash join are
+  /// LazyVectors that copy the values out of the hash table on first access
+  /// and only for the accessed rows. This saves copying wide build side
+  /// columns for joined rows that a later filter or limit drops. Does not
+  /// apply to joins that can spill.
+  static constexpr const char* kHashProbeLazyBuildColumns =
+      "hash_probe_lazy_build_columns";
+
+  /// Hash join output batches with fewer rows than this are copied into a
+  /// batch that collects the output of several probe input batches until it
+  /// has this many rows. Selective joins otherwise produce many small batches
+  /// of dictionary vectors. 0 disables the coalescing.
+  static constexpr const char* kHashProbeMinOutputBatchRows =
+      "hash_probe_min_output_batch_rows";
+
+  /// If greater than 0, an inner hash join without filter that cannot spill
+  /// swaps its build and probe sides if its build side input is more than
+  /// this many times larger than its whole probe side input. Both sides
+  /// buffer their input until the swap is decided. The probe side is then
+  /// built into the hash table and the build side input is probed against it.
+  static constexpr const char* kHashJoinSwapSidesRatio =
+      "hash_join_swap_sides_ratio";
+
+  /// The sides of a hash join are not swapped if its probe side input is
+  /// larger than this many bytes. Bounds the probe side input buffered until
+  /// the swap is decided.
+  static constexpr const char* kHashJoinSwapMaxProbeBytes =
+      "hash_join_swap_max_probe_bytes";
+
+  /// If true, table scans cache their output per split in the process-wide
+  /// AsyncDataCache and its SSD cache, and replay the cached output of a split
+  /// when a later scan with the same table handle, columns and filters reads
+  /// it. Only splits that define ConnectorSplit::cacheKey() are cached. The
+  /// scans must be deterministic, e.g. have no remaining filter calling
+  /// rand().
+  static constexpr const char* kFragmentResultCacheEnabled =
+      "fragment_result_cache_enabled";
+
+  /// The memory in bytes a split group of a task in grouped execution is
+  /// expected to use. When set, a queued split group is started only if the
+  /// memory of the task plus this budget fits into the budget of all
+  /// concurrent split groups. Otherwise the group waits for a running group to
+  /// finish. One split group always runs. 0 disables the check.
+  static constexpr const char* kSplitGroupMemoryBudget =
+      "split_group_memory_budget";
+
   /// If set to true, then during execution of tasks, the output vectors of
   /// every operator are validated for consistency. This is an expensive check
   /// so should only be used for debugging. It can help debug issues where
@@ -308,6 +543,12 @@ class QueryConfig {
   static constexpr const char* kEnableExpressionEvaluationCache =
       "enable_expression_evaluation_cache";
 
+  /// The max memory in bytes that the vector pool of an operator keeps in
+  /// recyclable vectors. Only applies if the expression evaluation cache is
+  /// enabled.
+  static constexpr const char* kVectorPoolMaxRetainedBytes =
+      "vector_pool_max_retained_bytes";
+
   uint64_t queryMaxMemoryPerNode() const {
     return toCapacity(
         get<std::string>(kQueryMaxMemoryPerNode, "0B"), CapacityUnit::BYTE);
@@ -331,6 +572,18 @@ class QueryConfig {
     return get<int32_t>(kAbandonPartialAggregationMinPct, 80);
   }
 
+  int64_t partialAggregationReenableIntervalRows() const {
+    return get<int64_t>(kPartialAggregationReenableIntervalRows, 0);
+  }
+
+  bool partitionedFinalAggregationEnabled() const {
+    return get<bool>(kPartitionedFinalAggregationEnabled, false);
+  }
+
+  bool parallelOrderByEnabled() const {
+    return get<bool>(kParallelOrderByEnabled, false);
+  }
+
   uint64_t aggregationSpillMemoryThreshold() const {
     static constexpr uint64_t kDefault = 0;
     return get<uint64_t>(kAggregationSpillMemoryThreshold, kDefault);
@@ -346,6 +599,11 @@ class QueryConfig {
     return get<uint64_t>(kOrderBySpillMemoryThreshold, kDefault);
   }
 
+  uint64_t windowSpillMemoryThreshold() const {
+    static constexpr uint64_t kDefault = 0;
+    return get<uint64_t>(kWindowSpillMemoryThreshold, kDefault);
+  }
+
   // Returns the target size for a Task's buffered output. The
   // producer Drivers are blocked when the buffered size exceeds
   // this. The Drivers are resumed when the buffered size goes below
@@ -355,16 +613,41 @@ class QueryConfig {
     return get<uint64_t>(kMaxPartitionedOutputBufferSize, kDefault);
   }
 
+  std::string shuffleCompressionKind() const {
+    return get<std::string>(kShuffleCompressionKind, "none");
+  }
+
+  uint32_t partitionedOutputCompactMinDestinations() const {
+    return get<uint32_t>(kPartitionedOutputCompactMinDestinations, 0);
+  }
+
+  bool shuffleInProcessVectors() const {
+    return get<bool>(kShuffleInProcessVectors, false);
+  }
+
   uint64_t maxLocalExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxLocalExchangeBufferSize, kDefault);
   }
 
+  uint64_t scaleWriterMinProcessedBytes() const {
+    static constexpr uint64_t kDefault = 128UL << 20;
+    return get<uint64_t>(kScaleWriterMinProcessedBytes, kDefault);
+  }
+
   uint64_t maxExchangeBufferSize() const {
     static constexpr uint64_t kDefault = 32UL << 20;
     return get<uint64_t>(kMaxExchangeBufferSize, kDefault);
   }
 
+  int32_t exchangeRequestWindowPages() const {
+    return std::max<int32_t>(1, get<int32_t>(kExchangeRequestWindowPages, 1));
+  }
+
+  bool exchangeLazyDeserialization() const {
+    return get<bool>(kExchangeLazyDeserialization, false);
+  }
+
   uint64_t preferredOutputBatchBytes() const {
     static constexpr uint64_t kDefault = 10UL << 20;
     return get<uint64_t>(kPreferredOutputBatchBytes, kDefault);
@@ -378,10 +661,18 @@ class QueryConfig {
     return get<uint32_t>(kMaxOutputBatchRows, 10'000);
   }
 
+  bool adaptiveOutputBatchRows() const {
+    return get<bool>(kAdaptiveOutputBatchRows, false);
+  }
+
   bool hashAdaptivityEnabled() const {
     return get<bool>(kHashAdaptivityEnabled, true);
   }
 
+  bool distinctAggregationHashDedupEnabled() const {
+    return get<bool>(kDistinctAggregationHashDedupEnabled, false);
+  }
+
   uint32_t writeStrideSize() const {
     static constexpr uint32_t kDefault = 100'000;
     return kDefault;
@@ -449,12 +740,48 @@ class QueryConfig {
     return get<bool>(kJoinSpillEnabled, true);
   }
 
+  /// Returns 'is broadcast output buffer spilling enabled' flag. Must also
+  /// check the spillEnabled()!
+  bool broadcastSpillEnabled() const {
+    return get<bool>(kBroadcastSpillEnabled, false);
+  }
+
   /// Returns 'is orderby spilling enabled' flag. Must also check the
   /// spillEnabled()!
   bool orderBySpillEnabled() const {
     return get<bool>(kOrderBySpillEnabled, true);
   }
 
+  /// Returns 'is window spilling enabled' flag. Must also check the
+  /// spillEnabled()!
+  bool windowSpillEnabled() const {
+    return get<bool>(kWindowSpillEnabled, true);
+  }
+
+  /// Returns 'is row number spilling enabled' flag. Must also check the
+  /// spillEnabled()!
+  bool rowNumberSpillEnabled() const {
+    return get<bool>(kRowNumberSpillEnabled, true);
+  }
+
+  /// Returns 'is topN row number spilling enabled' flag. Must also check the
+  /// spillEnabled()!
+  bool topNRowNumberSpillEnabled() const {
+    return get<bool>(kTopNRowNumberSpillEnabled, true);
+  }
+
+  /// Returns 'is mark distinct spilling enabled' flag. Must also check the
+  /// spillEnabled()!
+  bool markDistinctSpillEnabled() const {
+    return get<bool>(kMarkDistinctSpillEnabled, true);
+  }
+
+  /// Returns 'is merge join spilling enabled' flag. Must also check the
+  /// spillEnabled()!
+  bool mergeJoinSpillEnabled() const {
+    return get<bool>(kMergeJoinSpillEnabled, true);
+  }
+
   // Returns a percentage of aggregation or join input batches that
   // will be forced to spill for testing. 0 means no extra spilling.
   int32_t testingSpillPct() const {
@@ -502,6 +829,10 @@ class QueryConfig {
     return get<bool>(kAggregationSpillAll, true);
   }
 
+  uint64_t joinSpillRepartitionBytes() const {
+    return get<uint64_t>(kJoinSpillRepartitionBytes, 0);
+  }
+
   uint64_t maxSpillFileSize() const {
     constexpr uint64_t kDefaultMaxFileSize = 0;
     return get<uint64_t>(kMaxSpillFileSize, kDefaultMaxFileSize);
@@ -521,6 +852,10 @@ class QueryConfig {
     return get<uint64_t>(kSpillWriteBufferSize, 1L << 20);
   }
 
+  uint64_t spillWriteBytesPerSec() const {
+    return get<uint64_t>(kSpillWriteBytesPerSec, 0);
+  }
+
   /// Returns the minimal available spillable memory reservation in percentage
   /// of the current memory usage. Suppose the current memory usage size of M,
   /// available memory reservation size of N and min reservation percentage of
@@ -582,6 +917,14 @@ class QueryConfig {
     return get<bool>(kOperatorTrackCpuUsage, true);
   }
 
+  uint32_t operatorPerfCounterSampleInterval() const {
+    return get<uint32_t>(kOperatorPerfCounterSampleInterval, 0);
+  }
+
+  uint32_t taskTraceBufferSize() const {
+    return get<uint32_t>(kTaskTraceBufferSize, 0);
+  }
+
   uint32_t taskWriterCount() const {
     return get<uint32_t>(kTaskWriterCount, 4);
   }
@@ -595,10 +938,59 @@ class QueryConfig {
     return get<bool>(kHashProbeFinishEarlyOnEmptyBuild, true);
   }
 
+  uint64_t hashProbeBloomFilterPushdownMaxSize() const {
+    return get<uint64_t>(kHashProbeBloomFilterPushdownMaxSize, 0);
+  }
+
   uint32_t minTableRowsForParallelJoinBuild() const {
     return get<uint32_t>(kMinTableRowsForParallelJoinBuild, 1'000);
   }
 
+  uint64_t maxSplitPreloadBytes() const {
+    return get<uint64_t>(kMaxSplitPreloadBytes, 0);
+  }
+
+  uint64_t driverCpuTimeSliceLimitMs() const {
+    return get<uint64_t>(kDriverCpuTimeSliceLimitMs, 0);
+  }
+
+  uint32_t queryCpuShares() const {
+    return get<uint32_t>(kQueryCpuShares, kDefaultQueryCpuShares);
+  }
+
+  uint32_t maxRunningDriversPerTask() const {
+    return get<uint32_t>(kMaxRunningDriversPerTask, 0);
+  }
+
+  bool splitFileAffinity() const {
+    return get<bool>(kSplitFileAffinity, false);
+  }
+
+  bool hashProbeLazyBuildColumns() const {
+    return get<bool>(kHashProbeLazyBuildColumns, false);
+  }
+
+  uint32_t hashProbeMinOutputBatchRows() const {
+    return get<uint32_t>(kHashProbeMinOutputBatchRows, 0);
+  }
+
+  double hashJoinSwapSidesRatio() const {
+    return get<double>(kHashJoinSwapSidesRatio, 0);
+  }
+
+  uint64_t hashJoinSwapMaxProbeBytes() const {
+    static constexpr uint64_t kDefault = 64L << 20;
+    return get<uint64_t>(kHashJoinSwapMaxProbeBytes, kDefault);
+  }
+
+  bool fragmentResultCacheEnabled() const {
+    return get<bool>(kFragmentResultCacheEnabled, false);
+  }
+
+  uint64_t splitGroupMemoryBudget() const {
+    return get<uint64_t>(kSplitGroupMemoryBudget, 0);
+  }
+
   bool validateOutputFromOperators() const {
     return get<bool>(kValidateOutputFromOperators, false);
   }
@@ -607,6 +999,11 @@ class QueryConfig {
     return get<bool>(kEnableExpressionEvaluationCache, true);
   }
 
+  uint64_t vectorPoolMaxRetainedBytes() const {
+    static constexpr uint64_t kDefault = 16L << 20;
+    return get<uint64_t>(kVectorPoolMaxRetainedBytes, kDefault);
+  }
+
   template <typename T>
   T get(const std::string& key, const T& defaultValue) const {
     return config_->get<T>(key, defaultValue);
@@ -24,14 +24,16 @@ QueryCtx::QueryCtx(
     cache::AsyncDataCache* cache,
     std::shared_ptr<memory::MemoryPool> pool,
     std::shared_ptr<folly::Executor> spillExecutor,
-    const std::string& queryId)
+    const std::string& queryId,
+    std::shared_ptr<folly::Executor> arbitrationExecutor)
     : queryId_(queryId),
       connectorConfigs_(connectorConfigs),
       cache_(cache),
       pool_(std::move(pool)),
       executor_(executor),
       queryConfig_{std::move(queryConfigValues)},
-      spillExecutor_(std::move(spillExecutor)) {
+      spillExecutor_(std::move(spillExecutor)),
+      arbitrationExecutor_(std::move(arbitrationExecutor)) {
   initPool(queryId);
 }
 
@@ -42,14 +44,16 @@ QueryCtx::QueryCtx(
     cache::AsyncDataCache* cache,
     std::shared_ptr<memory::MemoryPool> pool,
     std::shared_ptr<folly::Executor> spillExecutor,
-    const std::string& queryId)
+    const std::string& queryId,
+    std::shared_ptr<folly::Executor> arbitrationExecutor)
     : queryId_(queryId),
       connectorConfigs_(connectorConfigs),
       cache_(cache),
       pool_(std::move(pool)),
       executor_(executor),
       queryConfig_{std::move(queryConfig)},
-      spillExecutor_(std::move(spillExecutor)) {
+      spillExecutor_(std::move(spillExecutor)),
+      arbitrationExecutor_(std::move(arbitrationExecutor)) {
   initPool(queryId);
 }
 
@@ -69,6 +73,18 @@ QueryCtx::QueryCtx(
   initPool(queryId);
 }
 
+RateLimiter* QueryCtx::spillWriteRateLimiter() const {
+  std::call_once(spillWriteRateLimiterOnce_, [&]() {
+    const auto bytesPerSec = queryConfig_.spillWriteBytesPerSec();
+    if (bytesPerSec > 0) {
+      // Allow bursts of up to one second worth of writes.
+      spillWriteRateLimiter_ =
+          std::make_unique<RateLimiter>(bytesPerSec, bytesPerSec);
+    }
+  });
+  return spillWriteRateLimiter_.get();
+}
+
 /*static*/ std::string QueryCtx::generatePoolName(const std::string& queryId) {
   // We attach a monotonically increasing sequence number to ensure the pool
   // name is unique.
@@ -17,8 +17,10 @@
 
 #include <folly/Executor.h>
 #include <folly/executors/CPUThreadPoolExecutor.h>
+#include "velox/common/base/RateLimiter.h"
 #include "velox/common/caching/AsyncDataCache.h"
 #include "velox/common/memory/Memory.h"
+#include "velox/common/memory/ScratchArena.h"
 #include "velox/core/QueryConfig.h"
 #include "velox/vector/DecodedVector.h"
 #include "velox/vector/VectorPool.h"
@@ -44,7 +46,8 @@ class QueryCtx {
       cache::AsyncDataCache* cache = cache::AsyncDataCache::getInstance(),
       std::shared_ptr<memory::MemoryPool> pool = nullptr,
       std::shared_ptr<folly::Executor> spillExecutor = nullptr,
-      const std::string& queryId = "");
+      const std::string& queryId = "",
+      std::shared_ptr<folly::Executor> arbitrationExecutor = nullptr);
 
   QueryCtx(
       folly::Executor* executor = nullptr,
@@ -54,7 +57,8 @@ class QueryCtx {
       cache::AsyncDataCache* cache = cache::AsyncDataCache::getInstance(),
       std::shared_ptr<memory::MemoryPool> pool = nullptr,
       std::shared_ptr<folly::Executor> spillExecutor = nullptr,
-      const std::string& queryId = "");
+      const std::string& queryId = "",
+      std::shared_ptr<folly::Executor> arbitrationExecutor = nullptr);
 
   /// Constructor to block the destruction of executor while this
   /// object is alive.
@@ -120,6 +124,18 @@ class QueryCtx {
     return spillExecutor_.get();
   }
 
+  /// Returns the executor to run memory reservations from operators that can
+  /// yield their driver thread while waiting for memory arbitration, or null
+  /// if these reservations run synchronously on the driver thread.
+  folly::Executor* arbitrationExecutor() const {
+    return arbitrationExecutor_.get();
+  }
+
+  /// Returns the rate limiter shared by all the spill writes of this query,
+  /// or null if 'spill_write_bytes_per_sec' is not set. The limiter is created
+  /// on first use from the query config at that time.
+  RateLimiter* spillWriteRateLimiter() const;
+
   const std::string& queryId() const {
     return queryId_;
   }
@@ -151,6 +167,10 @@ class QueryCtx {
   folly::Executor::KeepAlive<> executorKeepalive_;
   QueryConfig queryConfig_;
   std::shared_ptr<folly::Executor> spillExecutor_;
+  std::shared_ptr<folly::Executor> arbitrationExecutor_;
+
+  mutable std::once_flag spillWriteRateLimiterOnce_;
+  mutable std::unique_ptr<RateLimiter> spillWriteRateLimiter_;
 };
 
 // Represents the state of one thread of query execution.
@@ -163,8 +183,14 @@ class ExecCtx {
             !queryCtx ||
             queryCtx->queryConfig().isExpressionEvaluationCacheEnabled()),
         vectorPool_(
-            exprEvalCacheEnabled_ ? std::make_unique<VectorPool>(pool)
-                                  : nullptr) {}
+            exprEvalCacheEnabled_
+                ? std::make_unique<VectorPool>(
+                      pool,
+                      queryCtx ? queryCtx->queryConfig()
+                                     .vectorPoolMaxRetainedBytes()
+                               : VectorPool::kDefaultMaxRetainedBytes)
+                : nullptr),
+        scratchArena_(pool) {}
 
   velox::memory::MemoryPool* pool() const {
     return pool_;
@@ -268,6 +294,12 @@ class ExecCtx {
     return exprEvalCacheEnabled_;
   }
 
+  /// Returns the arena for temporary memory used while processing one batch.
+  /// See exec::EvalCtx::allocateScratch().
+  memory::ScratchArena& scratchArena() {
+    return scratchArena_;
+  }
+
  private:
   // Pool for all Buffers for this thread.
   memory::MemoryPool* const pool_;
@@ -280,6 +312,9 @@ class ExecCtx {
   // and operators.
   std::vector<std::unique_ptr<SelectivityVector>> selectivityVectorPool_;
   std::unique_ptr<VectorPool> vectorPool_;
+  // Bump pointer arena for temporary buffers of expression evaluation. Each
+  // EvalCtx rewinds it on destruction.
+  memory::ScratchArena scratchArena_;
 };
 
 } // namespace facebook::velox::core
@@ -19,6 +19,7 @@
 #include <folly/Likely.h>
 
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/base/Status.h"
 #include "velox/core/CoreTypeSystem.h"
 #include "velox/core/Metaprogramming.h"
 #include "velox/core/QueryConfig.h"
@@ -458,6 +459,8 @@ template <typename Fun, typename Exec, typename TReturn, typename... TArgs>
 class UDFHolder final
     : public core::SimpleFunctionMetadata<Fun, TReturn, TArgs...> {
   Fun instance_;
+  // The error of the last call() that failed with a Status.
+  Status status_;
 
  public:
   using udf_struct_t = Fun;
@@ -489,21 +492,25 @@ class UDFHolder final
   DECLARE_METHOD_RESOLVER(callNullable_method_resolver, callNullable);
   DECLARE_METHOD_RESOLVER(callNullFree_method_resolver, callNullFree);
   DECLARE_METHOD_RESOLVER(callAscii_method_resolver, callAscii);
+  DECLARE_METHOD_RESOLVER(callBatch_method_resolver, callBatch);
   DECLARE_METHOD_RESOLVER(initialize_method_resolver, initialize);
 
   // Check which flavor of the call() method is provided by the UDF object. UDFs
   // are required to provide at least one of the following methods:
   //
-  // - bool|void call(...)
+  // - bool|void|Status call(...)
   // - bool|void callNullable(...)
   // - bool|void callNullFree(...)
   //
   // Each of these methods can return either bool or void. Returning void means
-  // that the UDF is assumed never to return null values.
+  // that the UDF is assumed never to return null values. call() may also
+  // return Status to report a user error on a row without throwing. Under
+  // TRY the row becomes null without the cost of unwinding an exception.
   //
   // Optionally, UDFs can also provide the following methods:
   //
   // - bool|void callAscii(...)
+  // - void callBatch(...)
   // - void initialize(...)
 
   // call():
@@ -519,11 +526,19 @@ class UDFHolder final
       void,
       exec_return_type,
       const exec_arg_type<TArgs>&...>::value;
-  static constexpr bool udf_has_call =
-      udf_has_call_return_bool | udf_has_call_return_void;
+  static constexpr bool udf_has_call_return_status = util::has_method<
+      Fun,
+      call_method_resolver,
+      Status,
+      exec_return_type,
+      const exec_arg_type<TArgs>&...>::value;
+  static constexpr bool udf_has_call = udf_has_call_return_bool |
+      udf_has_call_return_void | udf_has_call_return_status;
   static_assert(
-      !(udf_has_call_return_bool && udf_has_call_return_void),
-      "Provided call() methods need to return either void OR bool.");
+      udf_has_call_return_bool + udf_has_call_return_void +
+              udf_has_call_return_status <=
+          1,
+      "Provided call() methods need to return either void OR bool OR Status.");
 
   // callNullable():
   static constexpr bool udf_has_callNullable_return_bool = util::has_method<
@@ -588,6 +603,23 @@ class UDFHolder final
         (udf_has_callAscii_return_void && udf_has_call_return_bool)),
       "The return type for callAscii() must match the return type for call().");
 
+  // callBatch():
+  // Batch flavor of call() for fixed-width types. Computes 'size' results
+  // from 'size' values of each argument:
+  //
+  //   void callBatch(TReturn* out, const TArgs*... args, int32_t size)
+  //
+  // Used instead of call() when all rows are selected and all arguments are
+  // flat or constant without nulls. Must produce the same results as call()
+  // and must not throw.
+  static constexpr bool udf_has_callBatch = util::has_method<
+      Fun,
+      callBatch_method_resolver,
+      void,
+      exec_return_type*,
+      const exec_arg_type<TArgs>*...,
+      int32_t>::value;
+
   // initialize():
   static constexpr bool udf_has_initialize = util::has_method<
       Fun,
@@ -619,8 +651,8 @@ class UDFHolder final
   // them return bool). This is only false if all the call methods provided for
   // a function return void.
   static constexpr bool can_produce_null_output = udf_has_call_return_bool |
-      udf_has_callNullable_return_bool | udf_has_callNullFree_return_bool |
-      udf_has_callAscii_return_bool;
+      udf_has_call_return_status | udf_has_callNullable_return_bool |
+      udf_has_callNullFree_return_bool | udf_has_callAscii_return_bool;
 
   // This is true when callNullFree is implemented, but not call or
   // callNullable. In this case if any input is NULL or any complex type in
@@ -714,6 +746,24 @@ class UDFHolder final
     }
   }
 
+  FOLLY_ALWAYS_INLINE void callBatch(
+      exec_return_type* out,
+      const exec_arg_type<TArgs>*... args,
+      int32_t size) {
+    if constexpr (udf_has_callBatch) {
+      instance_.callBatch(out, args..., size);
+    } else {
+      VELOX_UNREACHABLE(
+          "callBatch should never be called if the UDF does not implement callBatch.");
+    }
+  }
+
+  // Returns the error of the last call() that returned false and resets it.
+  // The error is OK if call() returned null without an error.
+  Status takeStatus() {
+    return std::move(status_);
+  }
+
   // Helper functions to handle void vs bool return type.
 
   FOLLY_ALWAYS_INLINE bool callImpl(
@@ -722,6 +772,13 @@ class UDFHolder final
     static_assert(udf_has_call);
     if constexpr (udf_has_call_return_bool) {
       return instance_.call(out, args...);
+    } else if constexpr (udf_has_call_return_status) {
+      auto status = instance_.call(out, args...);
+      if (UNLIKELY(!status.ok())) {
+        status_ = std::move(status);
+        return false;
+      }
+      return true;
     } else {
       instance_.call(out, args...);
       return true;
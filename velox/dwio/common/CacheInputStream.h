@@ -96,6 +96,19 @@ class CacheInputStream : public SeekableInputStream {
     noRetention_ = true;
   }
 
+  cache::AsyncDataCache* cache() const {
+    return cache_;
+  }
+
+  uint64_t fileNum() const {
+    return fileNum_;
+  }
+
+  /// Returns the file offset of 'position', a value of ByteCount().
+  uint64_t fileOffset(uint64_t position) const {
+    return region_.offset + position;
+  }
+
  private:
   // Ensures that the current position is covered by 'pin_'.
   void loadPosition();
@@ -396,11 +396,16 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
           if (isPrefetch) {
             pin.checkedEntry()->setPrefetch(true);
           }
+          pin.checkedEntry()->setGroupId(groupId_);
           pins.push_back(std::move(pin));
         });
     if (pins.empty()) {
       return pins;
     }
+    // If the file reads asynchronously, all the coalesced reads are issued
+    // before waiting for any of them.
+    const bool async = input_->hasReadAsync();
+    std::vector<folly::SemiFuture<uint64_t>> reads;
     auto stats = cache::readPins(
         pins,
         maxCoalesceDistance_,
@@ -411,8 +416,22 @@ class DwioCoalescedLoad : public DwioCoalescedLoadBase {
             int32_t /*end*/,
             uint64_t offset,
             const std::vector<folly::Range<char*>>& buffers) {
-          input_->read(buffers, offset, LogType::FILE);
+          if (async) {
+            reads.push_back(input_->readAsync(buffers, offset, LogType::FILE));
+          } else {
+            input_->read(buffers, offset, LogType::FILE);
+          }
         });
+    if (!reads.empty()) {
+      // Waits for all reads before throwing so that no read is in flight
+      // into the pins when they are freed.
+      auto results = folly::collectAll(std::move(reads)).get();
+      for (auto& result : results) {
+        if (result.hasException()) {
+          result.exception().throw_exception();
+        }
+      }
+    }
     updateStats(stats, isPrefetch, false);
     return pins;
   }
@@ -441,6 +460,7 @@ class SsdLoad : public DwioCoalescedLoadBase {
           if (isPrefetch) {
             pin.checkedEntry()->setPrefetch(true);
           }
+          pin.checkedEntry()->setGroupId(groupId_);
           pins.push_back(std::move(pin));
           ssdPins.push_back(std::move(requests_[index].ssdPin));
         });
@@ -76,6 +76,24 @@ void ColumnLoader::loadInternal(
   }
 
   structReader_->advanceFieldReader(fieldReader_, offset);
+  raw_vector<vector_size_t> shiftedRows;
+  if (!incomingNulls && fieldReader_->isTopLevel()) {
+    // With a selective filter the rows to load may start several row groups
+    // past 'offset'. Seek directly to the row group of the first row instead
+    // of decoding the values before it, and read the rows relative to the
+    // start of that row group.
+    structReader_->advanceFieldReader(fieldReader_, offset + effectiveRows[0]);
+    const auto readOffset = fieldReader_->readOffset();
+    if (readOffset > offset) {
+      const auto delta = readOffset - offset;
+      shiftedRows.resize(effectiveRows.size());
+      for (auto i = 0; i < effectiveRows.size(); ++i) {
+        shiftedRows[i] = effectiveRows[i] - delta;
+      }
+      effectiveRows = RowSet(shiftedRows);
+      offset = readOffset;
+    }
+  }
   fieldReader_->scanSpec()->setValueHook(hook);
   fieldReader_->read(offset, effectiveRows, incomingNulls);
   if (fieldReader_->fileType().type()->kind() == TypeKind::ROW) {
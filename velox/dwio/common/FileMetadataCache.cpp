@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+#include "velox/common/base/BitUtil.h"
+
+namespace facebook::velox::dwio::common {
+
+namespace {
+FileMetadataCache** instancePtr() {
+  static FileMetadataCache* cache{nullptr};
+  return &cache;
+}
+} // namespace
+
+// static
+FileMetadataCache* FileMetadataCache::getInstance() {
+  return *instancePtr();
+}
+
+// static
+void FileMetadataCache::setInstance(FileMetadataCache* cache) {
+  *instancePtr() = cache;
+}
+
+size_t FileMetadataCache::KeyHasher::operator()(const Key& key) const {
+  return bits::hashMix(
+      bits::hashMix(
+          std::hash<std::string>()(key.fileName),
+          std::hash<uint64_t>()(key.fileSize)),
+      static_cast<size_t>(key.format));
+}
+
+std::shared_ptr<const void> FileMetadataCache::findInternal(
+    const std::string& fileName,
+    uint64_t fileSize,
+    FileFormat format) {
+  std::lock_guard<std::mutex> l(mutex_);
+  ++stats_.numLookups;
+  auto it = index_.find(Key{fileName, fileSize, format});
+  if (it == index_.end()) {
+    return nullptr;
+  }
+  ++stats_.numHits;
+  entries_.splice(entries_.begin(), entries_, it->second);
+  return it->second->metadata;
+}
+
+void FileMetadataCache::insert(
+    const std::string& fileName,
+    uint64_t fileSize,
+    FileFormat format,
+    std::shared_ptr<const void> metadata,
+    uint64_t bytes) {
+  if (bytes > maxBytes_) {
+    return;
+  }
+  Key key{fileName, fileSize, format};
+  std::lock_guard<std::mutex> l(mutex_);
+  if (index_.count(key) > 0) {
+    // Another reader of the same file inserted first.
+    return;
+  }
+  while (stats_.bytes + bytes > maxBytes_) {
+    auto& last = entries_.back();
+    stats_.bytes -= last.bytes;
+    index_.erase(last.key);
+    entries_.pop_back();
+    ++stats_.numEvictions;
+  }
+  entries_.push_front(Entry{key, std::move(metadata), bytes});
+  index_[std::move(key)] = entries_.begin();
+  stats_.bytes += bytes;
+}
+
+void FileMetadataCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  index_.clear();
+  entries_.clear();
+  stats_.bytes = 0;
+}
+
+FileMetadataCache::Stats FileMetadataCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto stats = stats_;
+  stats.numEntries = entries_.size();
+  return stats;
+}
+
+} // namespace facebook::velox::dwio::common
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "velox/dwio/common/Options.h"
+
+namespace facebook::velox::dwio::common {
+
+/// Process-wide cache of parsed file footers, so that readers of splits of a
+/// file that was read before skip reading and decoding the footer. Entries
+/// are keyed by file name, file size and format. The size is the version
+/// check, since ReadFile does not expose a modification time, so a file that
+/// is replaced at the same name must change size to be re-read. The values
+/// are format specific and immutable. The cache is memory-accounted: each
+/// entry is given an estimated size and the least recently used entries are
+/// evicted to stay within 'maxBytes'. Thread-safe.
+class FileMetadataCache {
+ public:
+  struct Stats {
+    uint64_t numEntries{0};
+    uint64_t bytes{0};
+    uint64_t numHits{0};
+    uint64_t numLookups{0};
+    uint64_t numEvictions{0};
+  };
+
+  explicit FileMetadataCache(uint64_t maxBytes) : maxBytes_(maxBytes) {}
+
+  /// Returns the process-wide cache or nullptr if none is set.
+  static FileMetadataCache* getInstance();
+
+  static void setInstance(FileMetadataCache* cache);
+
+  /// Returns the metadata of 'fileName' of 'fileSize' bytes in 'format' or
+  /// nullptr if not cached. 'T' must be the type that was inserted for
+  /// 'format'.
+  template <typename T>
+  std::shared_ptr<const T>
+  find(const std::string& fileName, uint64_t fileSize, FileFormat format) {
+    return std::static_pointer_cast<const T>(
+        findInternal(fileName, fileSize, format));
+  }
+
+  /// Adds the metadata of a file. 'bytes' is the estimated memory footprint of
+  /// 'metadata'. Metadata larger than the capacity is not cached.
+  void insert(
+      const std::string& fileName,
+      uint64_t fileSize,
+      FileFormat format,
+      std::shared_ptr<const void> metadata,
+      uint64_t bytes);
+
+  void clear();
+
+  Stats stats() const;
+
+ private:
+  struct Key {
+    std::string fileName;
+    uint64_t fileSize;
+    FileFormat format;
+
+    bool operator==(const Key& other) const {
+      return fileSize == other.fileSize && format == other.format &&
+          fileName == other.fileName;
+    }
+  };
+
+  struct KeyHasher {
+    size_t operator()(const Key& key) const;
+  };
+
+  struct Entry {
+    Key key;
+    std::shared_ptr<const void> metadata;
+    uint64_t bytes;
+  };
+
+  std::shared_ptr<const void>
+  findInternal(const std::string& fileName, uint64_t fileSize, FileFormat);
+
+  const uint64_t maxBytes_;
+  mutable std::mutex mutex_;
+  // Entries from the most to the least recently used.
+  std::list<Entry> entries_;
+  folly::F14FastMap<Key, std::list<Entry>::iterator, KeyHasher> index_;
+  Stats stats_;
+};
+
+} // namespace facebook::velox::dwio::common
@@ -36,6 +36,8 @@ namespace velox {
 namespace dwio {
 namespace common {
 
+class FileMetadataCache;
+
 enum class FileFormat {
   UNKNOWN = 0,
   DWRF = 1, // DWRF
@@ -335,7 +337,7 @@ class RowReaderOptions {
     skipRows_ = skipRows;
   }
 
-  bool getSkipRows() const {
+  uint64_t getSkipRows() const {
     return skipRows_;
   }
 
@@ -359,6 +361,7 @@ class ReaderOptions : public io::ReaderOptions {
   bool fileColumnNamesReadAsLowerCase{false};
   bool useColumnNamesForColumnMapping_{false};
   std::shared_ptr<folly::Executor> ioExecutor_;
+  FileMetadataCache* fileMetadataCache_{nullptr};
 
  public:
   static constexpr uint64_t kDefaultDirectorySizeGuess = 1024 * 1024; // 1MB
@@ -386,6 +389,7 @@ class ReaderOptions : public io::ReaderOptions {
     filePreloadThreshold = other.filePreloadThreshold;
     fileColumnNamesReadAsLowerCase = other.fileColumnNamesReadAsLowerCase;
     useColumnNamesForColumnMapping_ = other.useColumnNamesForColumnMapping_;
+    fileMetadataCache_ = other.fileMetadataCache_;
     return *this;
   }
 
@@ -399,8 +403,8 @@ class ReaderOptions : public io::ReaderOptions {
         directorySizeGuess(other.directorySizeGuess),
         filePreloadThreshold(other.filePreloadThreshold),
         fileColumnNamesReadAsLowerCase(other.fileColumnNamesReadAsLowerCase),
-        useColumnNamesForColumnMapping_(other.useColumnNamesForColumnMapping_) {
-  }
+        useColumnNamesForColumnMapping_(other.useColumnNamesForColumnMapping_),
+        fileMetadataCache_(other.fileMetadataCache_) {}
 
   /**
    * Set the format of the file, such as "rc" or "dwrf".  The
@@ -469,6 +473,14 @@ class ReaderOptions : public io::ReaderOptions {
     return *this;
   }
 
+  /// Sets the cache of parsed file footers. The readers look up the footer by
+  /// the name of the ReadFile, so this must only be set if the names identify
+  /// the files.
+  ReaderOptions& setFileMetadataCache(FileMetadataCache* cache) {
+    fileMetadataCache_ = cache;
+    return *this;
+  }
+
   /**
    * Get the desired tail location.
    * @return if not set, return the maximum long.
@@ -523,6 +535,10 @@ class ReaderOptions : public io::ReaderOptions {
   bool isUseColumnNamesForColumnMapping() const {
     return useColumnNamesForColumnMapping_;
   }
+
+  FileMetadataCache* getFileMetadataCache() const {
+    return fileMetadataCache_;
+  }
 };
 
 struct WriterOptions {
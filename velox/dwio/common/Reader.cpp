@@ -16,6 +16,8 @@
 
 #include "velox/dwio/common/Reader.h"
 
+#include "velox/vector/FlatVector.h"
+
 namespace facebook::velox::dwio::common {
 
 using namespace velox::common;
@@ -52,16 +54,46 @@ bool filterRow(const BaseVector& vector, Filter& filter, vector_size_t index) {
   }
 }
 
+// Tests the non-null values of a flat string vector a batch at a time.
+void filterFlatStrings(
+    const BaseVector& vector,
+    const Filter& filter,
+    uint64_t* result) {
+  const auto size = vector.size();
+  const auto* values =
+      vector.asUnchecked<FlatVector<StringView>>()->rawValues();
+  const auto* rawNulls = vector.rawNulls();
+  if (!rawNulls) {
+    filter.testStringViews(values, size, result);
+    return;
+  }
+  std::vector<uint64_t> nonNullPassed(result, result + bits::nwords(size));
+  bits::andBits(nonNullPassed.data(), rawNulls, 0, size);
+  filter.testStringViews(values, size, nonNullPassed.data());
+  if (filter.testNull()) {
+    bits::andWithNegatedBits(result, rawNulls, 0, size);
+  } else {
+    bits::fillBits(result, 0, size, false);
+  }
+  bits::orBits(result, nonNullPassed.data(), 0, size);
+}
+
 void applyFilter(
     const BaseVector& vector,
     const ScanSpec& spec,
     uint64_t* result) {
   if (spec.filter()) {
-    bits::forEachSetBit(result, 0, vector.size(), [&](auto i) {
-      if (!filterRow(vector, *spec.filter(), i)) {
-        bits::clearBit(result, i);
-      }
-    });
+    if (vector.encoding() == VectorEncoding::Simple::FLAT &&
+        (vector.typeKind() == TypeKind::VARCHAR ||
+         vector.typeKind() == TypeKind::VARBINARY)) {
+      filterFlatStrings(vector, *spec.filter(), result);
+    } else {
+      bits::forEachSetBit(result, 0, vector.size(), [&](auto i) {
+        if (!filterRow(vector, *spec.filter(), i)) {
+          bits::clearBit(result, i);
+        }
+      });
+    }
   }
   if (!vector.type()->isRow()) {
     // Filter on MAP or ARRAY children are pruning, and won't affect correctness
@@ -105,6 +105,12 @@ class RowReader {
     return false;
   }
 
+  // Returns true if the rows returned by next() pass the filter function of
+  // the top level ScanSpec. Otherwise the caller must apply it to the result.
+  virtual bool appliesFilterFunction() const {
+    return false;
+  }
+
   enum class FetchResult {
     kFetched, // This function did the fetch
     kInProgress, // Another thread already started the IO
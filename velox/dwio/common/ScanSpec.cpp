@@ -32,6 +32,9 @@ ScanSpec& ScanSpec::operator=(const ScanSpec& other) {
     filter_ = other.filter_;
     metadataFilters_ = other.metadataFilters_;
     selectivity_ = other.selectivity_;
+    filterFunction_ = other.filterFunction_;
+    filterFunctionSelectivity_ = other.filterFunctionSelectivity_;
+    filterFunctionAfterFilters_ = other.filterFunctionAfterFilters_;
     enableFilterReorder_ = other.enableFilterReorder_;
     children_ = other.children_;
     stableChildren_ = other.stableChildren_;
@@ -139,7 +142,7 @@ bool ScanSpec::hasFilter() const {
   if (hasFilter_.has_value()) {
     return hasFilter_.value();
   }
-  if (!isConstant() && filter_) {
+  if ((!isConstant() && filter_) || filterFunction_) {
     hasFilter_ = true;
     return true;
   }
@@ -178,6 +181,8 @@ void ScanSpec::moveAdaptationFrom(ScanSpec& other) {
     VELOX_CHECK(found);
   }
   children_ = std::move(newChildren);
+  filterFunctionSelectivity_ = other.filterFunctionSelectivity_;
+  filterFunctionAfterFilters_ = other.filterFunctionAfterFilters_;
   stableChildren_.clear();
   for (auto& otherChild : other.stableChildren_) {
     auto child = childByName(otherChild->fieldName_);
@@ -369,6 +374,92 @@ bool testFilter(
   return true;
 }
 
+bool testFilterAllPass(
+    common::Filter* filter,
+    dwio::common::ColumnStatistics* stats,
+    uint64_t totalRows,
+    const TypePtr& type) {
+  const auto numValues = stats->getNumberOfValues();
+  if (!numValues.has_value()) {
+    return false;
+  }
+  if (numValues.value() < totalRows && !filter->testNull()) {
+    return false;
+  }
+  if (numValues.value() == 0) {
+    // Column is all null.
+    return true;
+  }
+  if (filter->kind() == common::FilterKind::kAlwaysTrue ||
+      filter->kind() == common::FilterKind::kIsNotNull) {
+    return true;
+  }
+  if (type->isDecimal()) {
+    return false;
+  }
+  switch (type->kind()) {
+    case TypeKind::BIGINT:
+    case TypeKind::INTEGER:
+    case TypeKind::SMALLINT:
+    case TypeKind::TINYINT: {
+      auto intStats =
+          dynamic_cast<dwio::common::IntegerColumnStatistics*>(stats);
+      if (!intStats || !intStats->getMinimum().has_value() ||
+          !intStats->getMaximum().has_value()) {
+        return false;
+      }
+      const auto min = intStats->getMinimum().value();
+      const auto max = intStats->getMaximum().value();
+      if (min == max) {
+        return filter->testInt64(min);
+      }
+      if (filter->kind() == common::FilterKind::kBigintRange) {
+        auto* range = static_cast<common::BigintRange*>(filter);
+        return min >= range->lower() && max <= range->upper();
+      }
+      return false;
+    }
+    case TypeKind::BOOLEAN: {
+      auto boolStats =
+          dynamic_cast<dwio::common::BooleanColumnStatistics*>(stats);
+      if (!boolStats || !boolStats->getTrueCount().has_value() ||
+          !boolStats->getFalseCount().has_value()) {
+        return false;
+      }
+      return (boolStats->getTrueCount().value() == 0 ||
+              filter->testBool(true)) &&
+          (boolStats->getFalseCount().value() == 0 || filter->testBool(false));
+    }
+    case TypeKind::VARCHAR: {
+      auto stringStats =
+          dynamic_cast<dwio::common::StringColumnStatistics*>(stats);
+      if (!stringStats || !stringStats->getMinimum().has_value() ||
+          !stringStats->getMaximum().has_value()) {
+        return false;
+      }
+      const auto& min = stringStats->getMinimum().value();
+      const auto& max = stringStats->getMaximum().value();
+      if (min == max) {
+        return filter->testBytes(min.data(), min.size());
+      }
+      if (filter->kind() == common::FilterKind::kBytesRange) {
+        auto* range = static_cast<common::BytesRange*>(filter);
+        const bool lowerPasses = range->lowerUnbounded() ||
+            (range->lowerExclusive() ? min > range->lower()
+                                     : min >= range->lower());
+        const bool upperPasses = range->upperUnbounded() ||
+            (range->upperExclusive() ? max < range->upper()
+                                     : max <= range->upper());
+        return lowerPasses && upperPasses;
+      }
+      return false;
+    }
+    default:
+      // Floating point statistics do not tell about NaNs.
+      return false;
+  }
+}
+
 ScanSpec& ScanSpec::getChildByChannel(column_index_t channel) {
   for (auto& child : children_) {
     if (child->channel_ == channel) {
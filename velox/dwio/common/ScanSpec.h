@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/common/base/RawVector.h"
 #include "velox/common/base/SelectivityInfo.h"
 #include "velox/dwio/common/MetadataFilter.h"
 #include "velox/type/Filter.h"
@@ -33,6 +34,23 @@ class ColumnStatistics;
 }
 namespace common {
 
+/// A filter on more than one field of a struct, e.g. 'a + b > c', that cannot
+/// be decomposed into filters on single fields. See
+/// ScanSpec::setFilterFunction().
+class FilterFunction {
+ public:
+  virtual ~FilterFunction() = default;
+
+  /// The names and types of the fields the filter depends on.
+  virtual const RowTypePtr& inputType() const = 0;
+
+  /// Sets 'passed' to the indices of the rows of 'input' that pass. 'input'
+  /// has the fields of inputType().
+  virtual void filter(
+      const RowVectorPtr& input,
+      raw_vector<vector_size_t>& passed) = 0;
+};
+
 // Describes the filtering and value extraction for a
 // SelectiveColumnReader. This is owned by the TableScan Operator and
 // is passed to SelectiveColumnReaders at construction.  This is
@@ -77,6 +95,36 @@ class ScanSpec {
 
   void addFilter(const Filter&);
 
+  /// Sets a filter on multiple fields of the struct described by 'this'. The
+  /// reader evaluates it among the filters of the children, before the first
+  /// child without filter or earlier if it drops rows faster than the
+  /// filters of the children after it, so that the children read after it
+  /// are read only for the passing rows. Readers that do not support this
+  /// return false from RowReader::appliesFilterFunction().
+  void setFilterFunction(std::shared_ptr<FilterFunction> filterFunction) {
+    filterFunction_ = std::move(filterFunction);
+    hasFilter_.reset();
+  }
+
+  FilterFunction* filterFunction() const {
+    return filterFunction_.get();
+  }
+
+  SelectivityInfo& filterFunctionSelectivity() {
+    return filterFunctionSelectivity_;
+  }
+
+  // True if the filter function must be evaluated after the filters of the
+  // children. Set when evaluating it before them failed, since the failing
+  // rows may be dropped by those filters.
+  bool filterFunctionAfterFilters() const {
+    return filterFunctionAfterFilters_;
+  }
+
+  void setFilterFunctionAfterFilters() {
+    filterFunctionAfterFilters_ = true;
+  }
+
   void setMaxArrayElementsCount(vector_size_t count) {
     maxArrayElementsCount_ = count;
   }
@@ -256,6 +304,17 @@ class ScanSpec {
     makeFlat_ = makeFlat;
   }
 
+  // If non-0, scalar values of this field that have no nulls and an average
+  // run length of at least this many rows are returned as a run-end encoded
+  // (SEQUENCE) vector instead of a flat vector.
+  vector_size_t minRunLength() const {
+    return minRunLength_;
+  }
+
+  void setMinRunLength(vector_size_t minRunLength) {
+    minRunLength_ = minRunLength;
+  }
+
   // True if this or a descendant has a filter that will affect the number of
   // output rows.  Note that filter on map keys and array indices is not
   // counted, as they do not change the number of container output rows.
@@ -354,6 +413,8 @@ class ScanSpec {
   // True if a string dictionary or flat map in this field should be
   // returned as flat.
   bool makeFlat_ = false;
+  // See minRunLength().
+  vector_size_t minRunLength_ = 0;
   std::shared_ptr<common::Filter> filter_;
 
   // Filters that will be only used for row group filtering based on metadata.
@@ -365,6 +426,11 @@ class ScanSpec {
       metadataFilters_;
 
   SelectivityInfo selectivity_;
+
+  std::shared_ptr<FilterFunction> filterFunction_;
+  SelectivityInfo filterFunctionSelectivity_;
+  bool filterFunctionAfterFilters_ = false;
+
   // Sort children by filtering efficiency.
   bool enableFilterReorder_ = true;
 
@@ -410,6 +476,14 @@ bool testFilter(
     uint64_t totalRows,
     const TypePtr& type);
 
+// Returns true if all values in a range defined by stats pass the filter.
+// False if some value may not pass or if 'stats' are not enough to tell.
+bool testFilterAllPass(
+    common::Filter* filter,
+    dwio::common::ColumnStatistics* stats,
+    uint64_t totalRows,
+    const TypePtr& type);
+
 } // namespace common
 } // namespace velox
 } // namespace facebook
@@ -482,6 +482,13 @@ class SelectiveColumnReader {
       const TypePtr& type,
       bool isFinal = false);
 
+  // Sets '*result' to a run-end encoded vector over the first 'numValues_'
+  // elements of 'values_' if these have no nulls and their runs are at least
+  // scanSpec_->minRunLength() long on average. Returns false and leaves
+  // '*result' unchanged otherwise.
+  template <typename T>
+  bool makeRunEndEncoded(const TypePtr& type, VectorPtr* FOLLY_NONNULL result);
+
   template <typename T, typename TVector>
   void compactScalarValues(RowSet rows, bool isFinal);
 
@@ -26,6 +26,7 @@
 #include "velox/vector/ConstantVector.h"
 #include "velox/vector/DictionaryVector.h"
 #include "velox/vector/FlatVector.h"
+#include "velox/vector/SequenceVector.h"
 
 #include <numeric>
 
@@ -134,6 +135,10 @@ void SelectiveColumnReader::getFlatValues(
     upcastScalarValues<T, TVector>(rows);
   }
   valueSize_ = sizeof(TVector);
+  if (scanSpec_->minRunLength() > 0 &&
+      makeRunEndEncoded<TVector>(type, result)) {
+    return;
+  }
   *result = std::make_shared<FlatVector<TVector>>(
       &memoryPool_,
       type,
@@ -143,6 +148,50 @@ void SelectiveColumnReader::getFlatValues(
       std::move(stringBuffers_));
 }
 
+template <typename T>
+bool SelectiveColumnReader::makeRunEndEncoded(
+    const TypePtr& type,
+    VectorPtr* result) {
+  if (resultNulls() || numValues_ == 0 || !values_) {
+    return false;
+  }
+  const auto* rawValues = reinterpret_cast<const T*>(rawValues_);
+  const vector_size_t maxRuns = numValues_ / scanSpec_->minRunLength();
+  vector_size_t numRuns = 1;
+  for (auto i = 1; i < numValues_; ++i) {
+    if (rawValues[i] != rawValues[i - 1] && ++numRuns > maxRuns) {
+      return false;
+    }
+  }
+  if (numRuns > maxRuns) {
+    return false;
+  }
+  auto runValues = AlignedBuffer::allocate<T>(numRuns, &memoryPool_);
+  auto lengths = AlignedBuffer::allocate<vector_size_t>(numRuns, &memoryPool_);
+  auto* rawRunValues = runValues->asMutable<T>();
+  auto* rawLengths = lengths->asMutable<vector_size_t>();
+  vector_size_t run = 0;
+  vector_size_t runStart = 0;
+  for (auto i = 1; i <= numValues_; ++i) {
+    if (i == numValues_ || rawValues[i] != rawValues[runStart]) {
+      rawRunValues[run] = rawValues[runStart];
+      rawLengths[run++] = i - runStart;
+      runStart = i;
+    }
+  }
+  *result = BaseVector::wrapInSequence(
+      std::move(lengths),
+      numValues_,
+      std::make_shared<FlatVector<T>>(
+          &memoryPool_,
+          type,
+          BufferPtr(nullptr),
+          numRuns,
+          std::move(runValues),
+          std::move(stringBuffers_)));
+  return true;
+}
+
 template <>
 void SelectiveColumnReader::getFlatValues<int8_t, bool>(
     RowSet rows,
@@ -96,6 +96,7 @@ void SelectiveStructColumnReaderBase::read(
     const uint64_t* incomingNulls) {
   numReads_ = scanSpec_->newRead();
   prepareRead<char>(offset, rows, incomingNulls);
+  filterFunctionInputsRead_ = false;
   RowSet activeRows = rows;
   if (hasMutation_) {
     // We handle the mutation after prepareRead so that output rows and format
@@ -132,15 +133,52 @@ void SelectiveStructColumnReaderBase::read(
     activeRows = outputRows_;
   }
 
+  auto* filterFunction = scanSpec_->filterFunction();
+  bool filterFunctionDone = filterFunction == nullptr;
+  // The filter function can only be evaluated after the filters of its
+  // inputs.
+  int32_t numFilteredInputsLeft = 0;
+  if (filterFunction) {
+    if (filterFunctionInputs_.empty()) {
+      for (auto& name : filterFunction->inputType()->names()) {
+        auto* inputSpec = scanSpec_->childByName(name);
+        VELOX_CHECK_NOT_NULL(
+            inputSpec, "No field for filter function input {}", name);
+        filterFunctionInputs_.push_back(inputSpec);
+      }
+    }
+    for (auto* inputSpec : filterFunctionInputs_) {
+      if (inputSpec->hasFilter() && !isChildConstant(*inputSpec)) {
+        ++numFilteredInputsLeft;
+      }
+    }
+  }
+
   auto& childSpecs = scanSpec_->children();
   VELOX_CHECK(!childSpecs.empty());
   for (size_t i = 0; i < childSpecs.size(); ++i) {
     auto& childSpec = childSpecs[i];
+    if (!filterFunctionDone &&
+        (!childSpec->hasFilter() ||
+         (numFilteredInputsLeft == 0 && filterFunctionFirst(*childSpec)))) {
+      filterFunctionDone = applyFilterFunction(
+          offset, activeRows, structNulls, childSpec->hasFilter());
+      if (activeRows.empty()) {
+        break;
+      }
+    }
     if (isChildConstant(*childSpec)) {
       continue;
     }
     auto fieldIndex = childSpec->subscript();
     auto reader = children_.at(fieldIndex);
+    const bool isFilterFunctionInput =
+        filterFunction && filterFunctionInputIndex(*childSpec) >= 0;
+    if (isFilterFunctionInput && filterFunctionInputsRead_ &&
+        !childSpec->hasFilter()) {
+      // Read with the other inputs of the filter function.
+      continue;
+    }
     if (reader->isTopLevel() && childSpec->projectOut() &&
         !childSpec->hasFilter() && !childSpec->extractValues()) {
       // Will make a LazyVector.
@@ -163,10 +201,17 @@ void SelectiveStructColumnReaderBase::read(
       if (activeRows.empty()) {
         break;
       }
+      if (isFilterFunctionInput) {
+        --numFilteredInputsLeft;
+      }
     } else {
       reader->read(offset, activeRows, structNulls);
     }
   }
+  if (!filterFunctionDone && !activeRows.empty()) {
+    // All the children have filters.
+    applyFilterFunction(offset, activeRows, structNulls, false);
+  }
 
   // If this adds nulls, the field readers will miss a value for each null added
   // here.
@@ -335,6 +380,9 @@ void SelectiveStructColumnReaderBase::getValues(
     resultRow->clearNulls(0, rows.size());
   }
   bool lazyPrepared = false;
+  // The positions of 'rows' in the values of the filter function inputs.
+  BufferPtr inputIndices;
+  bool inputIndicesMade = false;
   for (auto& childSpec : scanSpec_->children()) {
     if (!childSpec->projectOut()) {
       continue;
@@ -352,6 +400,17 @@ void SelectiveStructColumnReaderBase::getValues(
       setNullField(rows.size(), childResult);
       continue;
     }
+    if (filterFunctionInputsRead_) {
+      auto input = filterFunctionInputIndex(*childSpec);
+      if (input >= 0) {
+        if (!inputIndicesMade) {
+          inputIndices = filterFunctionIndices(rows);
+          inputIndicesMade = true;
+        }
+        childResult = filterFunctionInput(input, rows.size(), inputIndices);
+        continue;
+      }
+    }
     if (childSpec->extractValues() || childSpec->hasFilter() ||
         !children_[index]->isTopLevel()) {
       children_[index]->getValues(rows, &childResult);
@@ -381,4 +440,137 @@ void SelectiveStructColumnReaderBase::getValues(
   resultRow->updateContainsLazyNotLoaded();
 }
 
+bool SelectiveStructColumnReaderBase::filterFunctionFirst(
+    velox::common::ScanSpec& childSpec) {
+  if (scanSpec_->filterFunctionAfterFilters()) {
+    return false;
+  }
+  auto& selectivity = scanSpec_->filterFunctionSelectivity();
+  auto& childSelectivity = childSpec.selectivity();
+  return selectivity.numIn() > 0 && childSelectivity.numIn() > 0 &&
+      selectivity.timeToDropValue() < childSelectivity.timeToDropValue();
+}
+
+bool SelectiveStructColumnReaderBase::applyFilterFunction(
+    vector_size_t offset,
+    RowSet& rows,
+    const uint64_t* structNulls,
+    bool beforeFilters) {
+  auto& selectivity = scanSpec_->filterFunctionSelectivity();
+  SelectivityTimer timer(selectivity, rows.size());
+  if (!filterFunctionInputsRead_) {
+    readFilterFunctionInputs(offset, rows, structNulls);
+  }
+  std::vector<VectorPtr> inputs(filterFunctionInputs_.size());
+  auto indices = filterFunctionIndices(rows);
+  for (auto i = 0; i < inputs.size(); ++i) {
+    inputs[i] = filterFunctionInput(i, rows.size(), indices);
+  }
+  auto* filterFunction = scanSpec_->filterFunction();
+  auto input = std::make_shared<RowVector>(
+      &memoryPool_,
+      filterFunction->inputType(),
+      nullptr,
+      rows.size(),
+      std::move(inputs));
+  try {
+    filterFunction->filter(input, filterFunctionPassed_);
+  } catch (const VeloxException&) {
+    if (!beforeFilters) {
+      throw;
+    }
+    // The failing rows may not pass the filters of the children. These
+    // filters go first from now on.
+    scanSpec_->setFilterFunctionAfterFilters();
+    return false;
+  }
+  filterFunctionRows_.resize(filterFunctionPassed_.size());
+  for (auto i = 0; i < filterFunctionPassed_.size(); ++i) {
+    filterFunctionRows_[i] = rows[filterFunctionPassed_[i]];
+  }
+  rows = filterFunctionRows_;
+  selectivity.addOutput(rows.size());
+  return true;
+}
+
+void SelectiveStructColumnReaderBase::readFilterFunctionInputs(
+    vector_size_t offset,
+    RowSet rows,
+    const uint64_t* structNulls) {
+  filterFunctionInputRows_.resize(rows.size());
+  std::copy(rows.begin(), rows.end(), filterFunctionInputRows_.begin());
+  auto& inputType = *scanSpec_->filterFunction()->inputType();
+  filterFunctionValues_.resize(filterFunctionInputs_.size());
+  for (auto i = 0; i < filterFunctionInputs_.size(); ++i) {
+    auto* inputSpec = filterFunctionInputs_[i];
+    auto& values = filterFunctionValues_[i];
+    values = nullptr;
+    if (isChildConstant(*inputSpec) ||
+        inputSpec->subscript() == kConstantChildSpecSubscript) {
+      continue;
+    }
+    auto* reader = children_.at(inputSpec->subscript());
+    if (!inputSpec->hasFilter()) {
+      advanceFieldReader(reader, offset);
+      reader->read(offset, rows, structNulls);
+    }
+    const auto& type = inputType.childAt(i);
+    if (type->isRow()) {
+      std::vector<VectorPtr> children(type->size());
+      fillRowVectorChildren(memoryPool_, type->asRow(), children);
+      values = std::make_shared<RowVector>(
+          &memoryPool_, type, nullptr, 0, std::move(children));
+    }
+    reader->getValues(rows, &values);
+  }
+  filterFunctionInputsRead_ = true;
+}
+
+int32_t SelectiveStructColumnReaderBase::filterFunctionInputIndex(
+    const velox::common::ScanSpec& childSpec) const {
+  for (auto i = 0; i < filterFunctionInputs_.size(); ++i) {
+    if (filterFunctionInputs_[i] == &childSpec) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+BufferPtr SelectiveStructColumnReaderBase::filterFunctionIndices(RowSet rows) {
+  if (rows.size() == filterFunctionInputRows_.size()) {
+    return nullptr;
+  }
+  auto indices = allocateIndices(rows.size(), &memoryPool_);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  vector_size_t position = 0;
+  for (auto i = 0; i < rows.size(); ++i) {
+    while (filterFunctionInputRows_[position] < rows[i]) {
+      ++position;
+    }
+    rawIndices[i] = position;
+  }
+  return indices;
+}
+
+VectorPtr SelectiveStructColumnReaderBase::filterFunctionInput(
+    int32_t index,
+    vector_size_t size,
+    BufferPtr indices) {
+  auto* inputSpec = filterFunctionInputs_[index];
+  const auto& values = filterFunctionValues_[index];
+  if (!values) {
+    if (inputSpec->isConstant()) {
+      return BaseVector::wrapInConstant(size, 0, inputSpec->constantValue());
+    }
+    return BaseVector::createNullConstant(
+        scanSpec_->filterFunction()->inputType()->childAt(index),
+        size,
+        &memoryPool_);
+  }
+  if (!indices) {
+    return values;
+  }
+  return BaseVector::wrapInDictionary(nullptr, std::move(indices), size, values);
+}
+
 } // namespace facebook::velox::dwio::common
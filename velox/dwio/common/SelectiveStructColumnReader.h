@@ -155,6 +155,63 @@ class SelectiveStructColumnReaderBase : public SelectiveColumnReader {
   // Whether or not this is the root Struct that represents entire rows of the
   // table.
   const bool isRoot_;
+
+ private:
+  // Returns true if the filter function of 'scanSpec_' should be evaluated
+  // before the filter of 'childSpec'.
+  bool filterFunctionFirst(velox::common::ScanSpec& childSpec);
+
+  // Evaluates the filter function of 'scanSpec_' on 'rows' and sets 'rows' to
+  // the passing rows. Reads the inputs of the filter function first if not
+  // read yet. If 'beforeFilters' is true and the evaluation fails, leaves
+  // 'rows' unchanged and returns false so that the filter function is
+  // evaluated again after the filters of the children.
+  bool applyFilterFunction(
+      vector_size_t offset,
+      RowSet& rows,
+      const uint64_t* structNulls,
+      bool beforeFilters);
+
+  // Reads the children the filter function depends on for 'rows' and takes
+  // their values. The children with filters must be read already.
+  void readFilterFunctionInputs(
+      vector_size_t offset,
+      RowSet rows,
+      const uint64_t* structNulls);
+
+  // Returns the index of 'childSpec' in 'filterFunctionInputs_' or -1.
+  int32_t filterFunctionInputIndex(
+      const velox::common::ScanSpec& childSpec) const;
+
+  // Returns the positions of 'rows' in 'filterFunctionInputRows_' or nullptr
+  // if 'rows' are all of 'filterFunctionInputRows_'.
+  BufferPtr filterFunctionIndices(RowSet rows);
+
+  // Returns the values of the 'index'th input of the filter function for
+  // 'size' rows at 'indices' of 'filterFunctionInputRows_'.
+  VectorPtr
+  filterFunctionInput(int32_t index, vector_size_t size, BufferPtr indices);
+
+  // The children the filter function of 'scanSpec_' depends on, in the order
+  // of its input type.
+  std::vector<velox::common::ScanSpec*> filterFunctionInputs_;
+
+  // True if the inputs of the filter function are read in the current read().
+  // These are then not read again and their values come from
+  // 'filterFunctionValues_'.
+  bool filterFunctionInputsRead_{false};
+
+  // The rows the inputs of the filter function are read for.
+  raw_vector<vector_size_t> filterFunctionInputRows_;
+
+  // The values of the inputs of the filter function for
+  // 'filterFunctionInputRows_'. nullptr for constant inputs.
+  std::vector<VectorPtr> filterFunctionValues_;
+
+  // The indices of the rows passing the filter function and their row
+  // numbers.
+  raw_vector<vector_size_t> filterFunctionPassed_;
+  raw_vector<vector_size_t> filterFunctionRows_;
 };
 
 struct SelectiveStructColumnReader : SelectiveStructColumnReaderBase {
@@ -535,6 +535,17 @@ struct RuntimeStatistics {
   // Number of strides (row groups) skipped based on statistics.
   int64_t skippedStrides{0};
 
+  // Number of rows in pages skipped based on page level statistics.
+  int64_t skippedPageRows{0};
+
+  // Number of strides (row groups) skipped based on Bloom filters. These are
+  // also counted in 'skippedStrides'.
+  int64_t skippedBloomFilterStrides{0};
+
+  // Number of splits whose aggregates were computed from file statistics
+  // without reading the data.
+  int64_t statisticsAnsweredSplits{0};
+
   ColumnReaderStatistics columnReaderStatistics;
 
   std::unordered_map<std::string, RuntimeCounter> toMap() {
@@ -543,6 +554,10 @@ struct RuntimeStatistics {
         {"skippedSplitBytes",
          RuntimeCounter(skippedSplitBytes, RuntimeCounter::Unit::kBytes)},
         {"skippedStrides", RuntimeCounter(skippedStrides)},
+        {"skippedPageRows", RuntimeCounter(skippedPageRows)},
+        {"skippedBloomFilterStrides",
+         RuntimeCounter(skippedBloomFilterStrides)},
+        {"statisticsAnsweredSplits", RuntimeCounter(statisticsAnsweredSplits)},
         {"flattenStringDictionaryValues",
          RuntimeCounter(columnReaderStatistics.flattenStringDictionaryValues)}};
   }
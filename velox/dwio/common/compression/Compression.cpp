@@ -20,6 +20,7 @@
 #include "velox/dwio/common/compression/PagedInputStream.h"
 #include "velox/dwio/common/compression/PagedOutputStream.h"
 
+#include <folly/Synchronized.h>
 #include <folly/logging/xlog.h>
 #include <lz4.h>
 #include <snappy.h>
@@ -459,8 +460,63 @@ bool ZlibDecompressionStream::readOrSkip(const void** data, int32_t* size) {
   return true;
 }
 
+struct CodecFactories {
+  CompressorFactory compressorFactory;
+  DecompressorFactory decompressorFactory;
+};
+
+using CodecFactoriesMap = std::unordered_map<CompressionKind, CodecFactories>;
+
+folly::Synchronized<CodecFactoriesMap>& codecFactories() {
+  static folly::Synchronized<CodecFactoriesMap> factories;
+  return factories;
+}
+
+std::unique_ptr<Compressor> makeRegisteredCompressor(
+    CompressionKind kind,
+    const CompressionOptions& options) {
+  CompressorFactory factory;
+  codecFactories().withRLock([&](const auto& factories) {
+    if (auto it = factories.find(kind); it != factories.end()) {
+      factory = it->second.compressorFactory;
+    }
+  });
+  return factory ? factory(options) : nullptr;
+}
+
+std::unique_ptr<Decompressor> makeRegisteredDecompressor(
+    CompressionKind kind,
+    uint64_t blockSize,
+    const CompressionOptions& options,
+    const std::string& streamDebugInfo) {
+  DecompressorFactory factory;
+  codecFactories().withRLock([&](const auto& factories) {
+    if (auto it = factories.find(kind); it != factories.end()) {
+      factory = it->second.decompressorFactory;
+    }
+  });
+  return factory ? factory(blockSize, options, streamDebugInfo) : nullptr;
+}
+
 } // namespace
 
+void registerCodecFactories(
+    CompressionKind kind,
+    CompressorFactory compressorFactory,
+    DecompressorFactory decompressorFactory) {
+  VELOX_CHECK(
+      kind != CompressionKind::CompressionKind_NONE,
+      "Cannot register codec factories for no compression");
+  codecFactories().wlock()->insert_or_assign(
+      kind,
+      CodecFactories{
+          std::move(compressorFactory), std::move(decompressorFactory)});
+}
+
+void unregisterCodecFactories(CompressionKind kind) {
+  codecFactories().wlock()->erase(kind);
+}
+
 std::unique_ptr<BufferedOutputStream> createCompressor(
     CompressionKind kind,
     CompressionBufferPool& bufferPool,
@@ -469,6 +525,18 @@ std::unique_ptr<BufferedOutputStream> createCompressor(
     const CompressionOptions& options,
     const Encrypter* encrypter) {
   std::unique_ptr<Compressor> compressor;
+  if (kind != CompressionKind::CompressionKind_NONE) {
+    compressor = makeRegisteredCompressor(kind, options);
+  }
+  if (compressor != nullptr) {
+    return std::make_unique<PagedOutputStream>(
+        bufferPool,
+        bufferHolder,
+        options.compressionThreshold,
+        pageHeaderSize,
+        std::move(compressor),
+        encrypter);
+  }
   switch (kind) {
     case CompressionKind::CompressionKind_NONE:
       if (!encrypter) {
@@ -519,6 +587,20 @@ std::unique_ptr<dwio::common::SeekableInputStream> createDecompressor(
     bool useRawDecompression,
     size_t compressedLength) {
   std::unique_ptr<Decompressor> decompressor;
+  if (kind != CompressionKind::CompressionKind_NONE) {
+    decompressor =
+        makeRegisteredDecompressor(kind, blockSize, options, streamDebugInfo);
+  }
+  if (decompressor != nullptr) {
+    return std::make_unique<PagedInputStream>(
+        std::move(input),
+        pool,
+        std::move(decompressor),
+        decrypter,
+        streamDebugInfo,
+        useRawDecompression,
+        compressedLength);
+  }
   switch (static_cast<int64_t>(kind)) {
     case CompressionKind::CompressionKind_NONE:
       if (!decrypter) {
@@ -87,6 +87,30 @@ struct CompressionOptions {
   uint32_t compressionThreshold;
 };
 
+/// Creates a Compressor to use instead of the built-in software codec, e.g.
+/// one that offloads to a hardware accelerator. Returns nullptr to use the
+/// software codec, e.g. when no device is available. A returned Compressor
+/// is expected to fall back to software by itself when its device is busy.
+using CompressorFactory = std::function<std::unique_ptr<Compressor>(
+    const CompressionOptions& options)>;
+
+/// Like CompressorFactory for Decompressor.
+using DecompressorFactory = std::function<std::unique_ptr<Decompressor>(
+    uint64_t blockSize,
+    const CompressionOptions& options,
+    const std::string& streamDebugInfo)>;
+
+/// Registers the factories that createCompressor() and createDecompressor()
+/// try first for 'kind'. Either factory may be nullptr. Replaces any factories
+/// registered for 'kind' before.
+void registerCodecFactories(
+    facebook::velox::common::CompressionKind kind,
+    CompressorFactory compressorFactory,
+    DecompressorFactory decompressorFactory);
+
+/// Removes the factories registered for 'kind', if any.
+void unregisterCodecFactories(facebook::velox::common::CompressionKind kind);
+
 /**
  * Create a decompressor for the given compression kind.
  * @param kind The compression type to implement
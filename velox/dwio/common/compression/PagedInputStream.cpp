@@ -16,8 +16,30 @@
 
 #include "velox/dwio/common/compression/PagedInputStream.h"
 
+#include "velox/dwio/common/CacheInputStream.h"
+
 namespace facebook::velox::dwio::common::compression {
 
+namespace {
+// Calls 'func(data, offset, size)' for each contiguous range of the data of
+// 'entry'. 'offset' is the position of 'data' in the entry.
+template <typename Func>
+void forEachRange(cache::AsyncDataCacheEntry& entry, Func func) {
+  if (entry.tinyData() != nullptr) {
+    func(entry.tinyData(), 0, entry.size());
+    return;
+  }
+  auto& allocation = entry.data();
+  uint64_t offset = 0;
+  for (auto i = 0; i < allocation.numRuns() && offset < entry.size(); ++i) {
+    auto run = allocation.runAt(i);
+    const auto size = std::min<uint64_t>(run.numBytes(), entry.size() - offset);
+    func(run.data<char>(), offset, size);
+    offset += size;
+  }
+}
+} // namespace
+
 void PagedInputStream::prepareOutputBuffer(uint64_t uncompressedLength) {
   if (!outputBuffer_ || uncompressedLength > outputBuffer_->capacity()) {
     outputBuffer_ = std::make_unique<dwio::common::DataBuffer<char>>(
@@ -186,11 +208,9 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
       outputBufferPtr_ = nullptr;
     } else {
       prepareOutputBuffer(decompressedLength);
-      outputBufferLength_ = decompressor_->decompress(
-          input,
-          remainingLength_,
-          outputBuffer_->data(),
-          outputBuffer_->capacity());
+      outputBufferLength_ = exact
+          ? decompressOrLoad(input, decompressedLength)
+          : decompress(input);
       if (data) {
         *data = outputBuffer_->data();
       }
@@ -212,6 +232,63 @@ bool PagedInputStream::readOrSkip(const void** data, int32_t* size) {
   return true;
 }
 
+size_t PagedInputStream::decompress(const char* input) {
+  return decompressor_->decompress(
+      input,
+      remainingLength_,
+      outputBuffer_->data(),
+      outputBuffer_->capacity());
+}
+
+size_t PagedInputStream::decompressOrLoad(
+    const char* input,
+    uint64_t decompressedLength) {
+  auto* cacheInput = dynamic_cast<CacheInputStream*>(input_.get());
+  // Decrypted data is not kept in the cache.
+  if (cacheInput == nullptr || cacheInput->cache() == nullptr || decrypter_) {
+    return decompress(input);
+  }
+  auto* cache = cacheInput->cache();
+  const cache::RawFileCacheKey key{
+      cacheInput->fileNum(),
+      cacheInput->fileOffset(lastHeaderOffset_) |
+          cache::kDecompressedOffsetBit};
+  if (!cache->canCacheDecompressed(decompressedLength) && !cache->exists(key)) {
+    return decompress(input);
+  }
+  cache::CachePin pin;
+  try {
+    pin = cache->findOrCreate(key, decompressedLength);
+  } catch (const VeloxRuntimeError& e) {
+    if (e.errorCode() != error_code::kNoCacheSpace) {
+      throw;
+    }
+    return decompress(input);
+  }
+  if (pin.empty()) {
+    // Another stream is decompressing the same block.
+    return decompress(input);
+  }
+  auto* entry = pin.checkedEntry();
+  if (entry->isShared()) {
+    VELOX_CHECK_EQ(entry->size(), decompressedLength);
+    forEachRange(*entry, [&](const char* data, uint64_t offset, uint64_t size) {
+      std::memcpy(outputBuffer_->data() + offset, data, size);
+    });
+    return decompressedLength;
+  }
+  const auto length = decompress(input);
+  if (length != decompressedLength) {
+    // Dropping the exclusive pin removes the entry.
+    return length;
+  }
+  forEachRange(*entry, [&](char* data, uint64_t offset, uint64_t size) {
+    std::memcpy(data, outputBuffer_->data() + offset, size);
+  });
+  entry->setExclusiveToShared();
+  return length;
+}
+
 void PagedInputStream::BackUp(int32_t count) {
   if (pendingSkip_ > 0) {
     auto len = std::min<int64_t>(count, pendingSkip_);
@@ -106,6 +106,15 @@ class PagedInputStream : public dwio::common::SeekableInputStream {
 
   void prepareOutputBuffer(uint64_t uncompressedLength);
 
+  // Decompresses the block at 'input' into 'outputBuffer_'. Returns the
+  // decompressed size.
+  size_t decompress(const char* input);
+
+  // Like decompress() for a block of known 'decompressedLength'. If 'input_'
+  // reads from an AsyncDataCache that keeps decompressed blocks, copies the
+  // block from the cache on hit and adds it to the cache on miss.
+  size_t decompressOrLoad(const char* input, uint64_t decompressedLength);
+
   void readBuffer(bool failOnEof);
 
   uint32_t readByte(bool failOnEof);
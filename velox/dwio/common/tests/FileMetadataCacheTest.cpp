@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/common/FileMetadataCache.h"
+
+#include <gtest/gtest.h>
+
+using namespace facebook::velox::dwio::common;
+
+TEST(FileMetadataCacheTest, findAndEvict) {
+  FileMetadataCache cache(100);
+  auto makeValue = [](int32_t value) {
+    return std::make_shared<const int32_t>(value);
+  };
+  cache.insert("a", 10, FileFormat::DWRF, makeValue(1), 40);
+  cache.insert("b", 10, FileFormat::DWRF, makeValue(2), 40);
+
+  ASSERT_EQ(*cache.find<int32_t>("a", 10, FileFormat::DWRF), 1);
+  // A different size or format is a different file.
+  ASSERT_EQ(cache.find<int32_t>("a", 11, FileFormat::DWRF), nullptr);
+  ASSERT_EQ(cache.find<int32_t>("a", 10, FileFormat::ORC), nullptr);
+
+  // 'b' is the least recently used and is evicted.
+  cache.insert("c", 10, FileFormat::DWRF, makeValue(3), 40);
+  ASSERT_EQ(cache.find<int32_t>("b", 10, FileFormat::DWRF), nullptr);
+  ASSERT_EQ(*cache.find<int32_t>("a", 10, FileFormat::DWRF), 1);
+  ASSERT_EQ(*cache.find<int32_t>("c", 10, FileFormat::DWRF), 3);
+
+  // Entries over the capacity are not cached.
+  cache.insert("d", 10, FileFormat::DWRF, makeValue(4), 101);
+  ASSERT_EQ(cache.find<int32_t>("d", 10, FileFormat::DWRF), nullptr);
+
+  auto stats = cache.stats();
+  ASSERT_EQ(stats.numEntries, 2);
+  ASSERT_EQ(stats.bytes, 80);
+  ASSERT_EQ(stats.numEvictions, 1);
+  ASSERT_EQ(stats.numLookups, 7);
+  ASSERT_EQ(stats.numHits, 3);
+
+  cache.clear();
+  ASSERT_EQ(cache.find<int32_t>("a", 10, FileFormat::DWRF), nullptr);
+  ASSERT_EQ(cache.stats().bytes, 0);
+}
@@ -93,6 +93,14 @@ Config::Entry<float> Config::ENTROPY_KEY_STRING_SIZE_THRESHOLD{
     "hive.exec.orc.entropy.key.string.size.threshold",
     0.9f};
 
+Config::Entry<bool> Config::DICTIONARY_STRING_PER_STRIPE{
+    "hive.exec.orc.dictionary.string.per.stripe",
+    false};
+
+Config::Entry<uint32_t> Config::DICTIONARY_STRING_SAMPLE_ROWS{
+    "hive.exec.orc.dictionary.string.sample.rows",
+    10'000};
+
 Config::Entry<uint32_t> Config::ENTROPY_STRING_MIN_SAMPLES{
     "hive.exec.orc.entropy.string.min.samples",
     100};
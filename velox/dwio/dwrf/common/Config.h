@@ -51,6 +51,14 @@ class Config : public common::ConfigBase<Config> {
   static Entry<uint32_t> ENTROPY_STRING_MIN_SAMPLES;
   static Entry<float> ENTROPY_STRING_DICT_SAMPLE_FRACTION;
   static Entry<uint32_t> ENTROPY_STRING_THRESHOLD;
+  /// Re-evaluates dictionary versus direct encoding of string columns on
+  /// every stripe instead of only on the first one. A stripe written with
+  /// direct encoding samples its first values to decide whether the next
+  /// stripe tries dictionary encoding again.
+  static Entry<bool> DICTIONARY_STRING_PER_STRIPE;
+  /// Number of values sampled from a direct encoded stripe when re-evaluating
+  /// string encodings per stripe.
+  static Entry<uint32_t> DICTIONARY_STRING_SAMPLE_ROWS;
   static Entry<uint32_t> STRING_STATS_LIMIT;
   static Entry<bool> FLATTEN_MAP;
   static Entry<bool> MAP_FLAT_DISABLE_DICT_ENCODING;
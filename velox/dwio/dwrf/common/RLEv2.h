@@ -23,6 +23,8 @@
 #include "velox/dwio/common/IntDecoder.h"
 #include "velox/dwio/common/exception/Exception.h"
 
+#include <folly/Bits.h>
+
 #include <vector>
 
 namespace facebook::velox::dwrf {
@@ -162,6 +164,53 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
   }
 
   int64_t readLongBE(uint64_t bsz);
+
+  // Bulk unpacks 'fb' bit wide big-endian values into the non-null
+  // positions of 'data' in [begin, end) with one unaligned 64 bit load per
+  // value, for as long as the load stays inside the current buffer. The
+  // reader must be at a byte boundary. Leaves curByte and bitsLeft as the
+  // bit at a time loop in readLongs would. Adds the number of values read
+  // to 'numRead' and returns the first position not decoded.
+  uint64_t readLongsAligned(
+      int64_t* data,
+      uint64_t begin,
+      uint64_t end,
+      uint64_t fb,
+      const uint64_t* nulls,
+      uint64_t& numRead) {
+    // A value starting at any bit of a byte must fit in one 64 bit word.
+    if (fb > 56 && fb != 64) {
+      return begin;
+    }
+    const char* buffer = dwio::common::IntDecoder<isSigned>::bufferStart;
+    const uint64_t available =
+        dwio::common::IntDecoder<isSigned>::bufferEnd - buffer;
+    const uint64_t mask = fb == 64 ? ~0ULL : (1ULL << fb) - 1;
+    uint64_t bitOffset = 0;
+    uint64_t i = begin;
+    for (; i < end; ++i) {
+      if (nulls && bits::isBitNull(nulls, i)) {
+        continue;
+      }
+      const uint64_t byteOffset = bitOffset >> 3;
+      if (byteOffset + sizeof(uint64_t) > available) {
+        break;
+      }
+      const uint64_t word = folly::Endian::big(
+          folly::loadUnaligned<uint64_t>(buffer + byteOffset));
+      data[i] =
+          static_cast<int64_t>((word >> (64 - fb - (bitOffset & 7))) & mask);
+      bitOffset += fb;
+      ++numRead;
+    }
+    dwio::common::IntDecoder<isSigned>::bufferStart += bitOffset >> 3;
+    if (bitOffset & 7) {
+      curByte = readByte();
+      bitsLeft = 8 - (bitOffset & 7);
+    }
+    return i;
+  }
+
   uint64_t readLongs(
       int64_t* data,
       uint64_t offset,
@@ -169,9 +218,12 @@ class RleDecoderV2 : public dwio::common::IntDecoder<isSigned> {
       uint64_t fb,
       const uint64_t* nulls = nullptr) {
     uint64_t ret = 0;
+    uint64_t i = offset;
+    if (bitsLeft == 0) {
+      i = readLongsAligned(data, offset, offset + len, fb, nulls, ret);
+    }
 
-    // TODO: unroll to improve performance
-    for (uint64_t i = offset; i < (offset + len); i++) {
+    for (; i < (offset + len); i++) {
       // skip null positions
       if (nulls && bits::isBitNull(nulls, i)) {
         continue;
@@ -102,6 +102,11 @@ class DwrfRowReader : public StrideIndexProvider,
     return true;
   }
 
+  // Only the selective readers used with a ScanSpec apply filters.
+  bool appliesFilterFunction() const override {
+    return options_.getScanSpec() != nullptr;
+  }
+
   // Returns the skipped strides for 'stripe'. Used for testing.
   std::optional<std::vector<uint64_t>> stridesToSkip(uint32_t stripe) const {
     auto it = stripeStridesToSkip_.find(stripe);
@@ -144,6 +149,8 @@ class DwrfRowReader : public StrideIndexProvider,
   uint64_t rowsInCurrentStripe;
   uint64_t strideIndex_;
   std::shared_ptr<StripeDictionaryCache> stripeDictionaryCache_;
+  // Shares identical string dictionaries between stripes.
+  StringDictionaryCache stringDictionaryCache_;
   dwio::common::RowReaderOptions options_;
 
   struct PrefetchedStripeState {
@@ -18,6 +18,7 @@
 
 #include <fmt/format.h>
 
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/exception/Exception.h"
 
 namespace facebook::velox::dwrf {
@@ -31,6 +32,17 @@ using dwio::common::encryption::DecrypterFactory;
 using encryption::DecryptionHandler;
 using memory::MemoryPool;
 
+namespace {
+std::unique_ptr<PostScript> copyPostScript(const PostScript& postScript) {
+  if (postScript.format() == DwrfFormat::kDwrf) {
+    return std::make_unique<PostScript>(
+        proto::PostScript(*postScript.getDwrfPtr()));
+  }
+  return std::make_unique<PostScript>(
+      proto::orc::PostScript(*postScript.getOrcPtr()));
+}
+} // namespace
+
 FooterStatisticsImpl::FooterStatisticsImpl(
     const ReaderBase& reader,
     const StatsContext& statsContext) {
@@ -93,19 +105,98 @@ ReaderBase::ReaderBase(
     uint64_t directorySizeGuess,
     uint64_t filePreloadThreshold,
     FileFormat fileFormat,
-    bool fileColumnNamesReadAsLowerCase)
+    bool fileColumnNamesReadAsLowerCase,
+    dwio::common::FileMetadataCache* fileMetadataCache)
     : pool_{pool},
       arena_(std::make_unique<google::protobuf::Arena>()),
       decryptorFactory_(decryptorFactory),
       directorySizeGuess_(directorySizeGuess),
       filePreloadThreshold_(filePreloadThreshold),
       input_(std::move(input)) {
-  // read last bytes into buffer to get PostScript
-  // If file is small, load the entire file.
-  // TODO: make a config
   fileLength_ = input_->getReadFile()->size();
   DWIO_ENSURE(fileLength_ > 0, "ORC file is empty");
 
+  const auto fileName = input_->getReadFile()->getName();
+  if (fileMetadataCache) {
+    fileTail_ =
+        fileMetadataCache->find<FileTail>(fileName, fileLength_, fileFormat);
+  }
+  // The bytes at the end of the file that are loaded.
+  uint64_t readSize = 0;
+  if (fileTail_) {
+    postScript_ = copyPostScript(*fileTail_->postScript);
+    footer_ = std::make_unique<FooterWrapper>(*fileTail_->footer);
+    psLength_ = fileTail_->psLength;
+  } else {
+    auto tail = std::make_shared<FileTail>();
+    readSize = readTail(fileFormat, *tail);
+    if (fileMetadataCache) {
+      tail->postScript = copyPostScript(*postScript_);
+      const auto footerBytes = footer_->format() == DwrfFormat::kDwrf
+          ? footer_->getDwrfPtr()->SpaceUsedLong()
+          : footer_->getOrcPtr()->SpaceUsedLong();
+      fileMetadataCache->insert(
+          fileName,
+          fileLength_,
+          fileFormat,
+          tail,
+          sizeof(FileTail) + footerBytes);
+    }
+    fileTail_ = std::move(tail);
+  }
+
+  const uint64_t footerSize = postScript_->footerLength();
+  const uint64_t cacheSize =
+      postScript_->hasCacheSize() ? postScript_->cacheSize() : 0;
+  const uint64_t tailSize = 1 + psLength_ + footerSize + cacheSize;
+  if (cacheSize > 0 && tailSize > readSize) {
+    input_->enqueue({fileLength_ - tailSize, cacheSize, "footer"});
+    input_->load(LogType::FOOTER);
+  }
+
+  schema_ = std::dynamic_pointer_cast<const RowType>(
+      convertType(*footer_, 0, fileColumnNamesReadAsLowerCase));
+  DWIO_ENSURE_NOT_NULL(schema_, "invalid schema");
+
+  // load stripe index/footer cache
+  if (cacheSize > 0) {
+    DWIO_ENSURE_EQ(format(), DwrfFormat::kDwrf);
+    if (input_->shouldPrefetchStripes()) {
+      cache_ = std::make_unique<StripeMetadataCache>(
+          postScript_->cacheMode(),
+          *footer_,
+          input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER));
+      input_->load(LogType::FOOTER);
+    } else {
+      auto cacheBuffer =
+          std::make_shared<dwio::common::DataBuffer<char>>(pool, cacheSize);
+      input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER)
+          ->readFully(cacheBuffer->data(), cacheSize);
+      cache_ = std::make_unique<StripeMetadataCache>(
+          postScript_->cacheMode(), *footer_, std::move(cacheBuffer));
+    }
+  }
+  if (!cache_ && input_->shouldPrefetchStripes()) {
+    auto numStripes = getFooter().stripesSize();
+    for (auto i = 0; i < numStripes; i++) {
+      const auto stripe = getFooter().stripes(i);
+      input_->enqueue(
+          {stripe.offset() + stripe.indexLength() + stripe.dataLength(),
+           stripe.footerLength(),
+           "stripe_footer"});
+    }
+    if (numStripes) {
+      input_->load(LogType::FOOTER);
+    }
+  }
+  // initialize file decrypter
+  handler_ = DecryptionHandler::create(*footer_, decryptorFactory_.get());
+}
+
+uint64_t ReaderBase::readTail(FileFormat fileFormat, FileTail& tail) {
+  // read last bytes into buffer to get PostScript
+  // If file is small, load the entire file.
+  // TODO: make a config
   auto preloadFile = fileLength_ <= filePreloadThreshold_;
   uint64_t readSize =
       preloadFile ? fileLength_ : std::min(fileLength_, directorySizeGuess_);
@@ -162,63 +253,29 @@ ReaderBase::ReaderBase(
   if (tailSize > readSize) {
     input_->enqueue({fileLength_ - tailSize, tailSize, "footer"});
     input_->load(LogType::FOOTER);
+    readSize = tailSize;
   }
 
   auto footerStream = input_->read(
       fileLength_ - psLength_ - footerSize - 1, footerSize, LogType::FOOTER);
   if (fileFormat == FileFormat::DWRF) {
     auto footer =
-        google::protobuf::Arena::CreateMessage<proto::Footer>(arena_.get());
+        google::protobuf::Arena::CreateMessage<proto::Footer>(&tail.arena);
     ProtoUtils::readProtoInto<proto::Footer>(
         createDecompressedStream(std::move(footerStream), "File Footer"),
         footer);
     footer_ = std::make_unique<FooterWrapper>(footer);
   } else {
-    auto footer = google::protobuf::Arena::CreateMessage<proto::orc::Footer>(
-        arena_.get());
+    auto footer =
+        google::protobuf::Arena::CreateMessage<proto::orc::Footer>(&tail.arena);
     ProtoUtils::readProtoInto<proto::orc::Footer>(
         createDecompressedStream(std::move(footerStream), "File Footer"),
         footer);
     footer_ = std::make_unique<FooterWrapper>(footer);
   }
-
-  schema_ = std::dynamic_pointer_cast<const RowType>(
-      convertType(*footer_, 0, fileColumnNamesReadAsLowerCase));
-  DWIO_ENSURE_NOT_NULL(schema_, "invalid schema");
-
-  // load stripe index/footer cache
-  if (cacheSize > 0) {
-    DWIO_ENSURE_EQ(format(), DwrfFormat::kDwrf);
-    if (input_->shouldPrefetchStripes()) {
-      cache_ = std::make_unique<StripeMetadataCache>(
-          postScript_->cacheMode(),
-          *footer_,
-          input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER));
-      input_->load(LogType::FOOTER);
-    } else {
-      auto cacheBuffer =
-          std::make_shared<dwio::common::DataBuffer<char>>(pool, cacheSize);
-      input_->read(fileLength_ - tailSize, cacheSize, LogType::FOOTER)
-          ->readFully(cacheBuffer->data(), cacheSize);
-      cache_ = std::make_unique<StripeMetadataCache>(
-          postScript_->cacheMode(), *footer_, std::move(cacheBuffer));
-    }
-  }
-  if (!cache_ && input_->shouldPrefetchStripes()) {
-    auto numStripes = getFooter().stripesSize();
-    for (auto i = 0; i < numStripes; i++) {
-      const auto stripe = getFooter().stripes(i);
-      input_->enqueue(
-          {stripe.offset() + stripe.indexLength() + stripe.dataLength(),
-           stripe.footerLength(),
-           "stripe_footer"});
-    }
-    if (numStripes) {
-      input_->load(LogType::FOOTER);
-    }
-  }
-  // initialize file decrypter
-  handler_ = DecryptionHandler::create(*footer_, decryptorFactory_.get());
+  tail.footer = std::make_unique<FooterWrapper>(*footer_);
+  tail.psLength = psLength_;
+  return readSize;
 }
 
 std::vector<uint64_t> ReaderBase::getRowsPerStripe() const {
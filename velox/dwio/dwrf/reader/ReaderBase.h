@@ -31,6 +31,16 @@ namespace facebook::velox::dwrf {
 
 class ReaderBase;
 
+// The post script and footer of a file. Shared by the readers of the file
+// through the FileMetadataCache.
+struct FileTail {
+  // Owns the footer.
+  google::protobuf::Arena arena;
+  std::unique_ptr<PostScript> postScript;
+  std::unique_ptr<FooterWrapper> footer;
+  uint64_t psLength{0};
+};
+
 class FooterStatisticsImpl : public dwio::common::Statistics {
  private:
   std::vector<std::unique_ptr<dwio::common::ColumnStatistics>> colStats_;
@@ -70,7 +80,8 @@ class ReaderBase {
       uint64_t filePreloadThreshold =
           dwio::common::ReaderOptions::kDefaultFilePreloadThreshold,
       dwio::common::FileFormat fileFormat = dwio::common::FileFormat::DWRF,
-      bool fileColumnNamesReadAsLowerCase = false);
+      bool fileColumnNamesReadAsLowerCase = false,
+      dwio::common::FileMetadataCache* fileMetadataCache = nullptr);
 
   ReaderBase(
       memory::MemoryPool& pool,
@@ -232,6 +243,10 @@ class ReaderBase {
   }
 
  private:
+  // Reads the post script and footer into 'tail'. Returns the number of
+  // bytes at the end of the file that are loaded.
+  uint64_t readTail(dwio::common::FileFormat fileFormat, FileTail& tail);
+
   static std::shared_ptr<const Type> convertType(
       const FooterWrapper& footer,
       uint32_t index = 0,
@@ -241,6 +256,8 @@ class ReaderBase {
   std::unique_ptr<google::protobuf::Arena> arena_;
   std::unique_ptr<PostScript> postScript_;
   std::unique_ptr<FooterWrapper> footer_ = nullptr;
+  // Keeps the footer live if it is shared through the FileMetadataCache.
+  std::shared_ptr<const FileTail> fileTail_;
   std::unique_ptr<StripeMetadataCache> cache_;
   // Keeps factory alive for possibly async prefetch.
   std::shared_ptr<dwio::common::encryption::DecrypterFactory> decryptorFactory_;
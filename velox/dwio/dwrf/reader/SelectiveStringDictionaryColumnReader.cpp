@@ -27,11 +27,13 @@ SelectiveStringDictionaryColumnReader::SelectiveStringDictionaryColumnReader(
     DwrfParams& params,
     common::ScanSpec& scanSpec)
     : SelectiveColumnReader(nodeType->type(), params, scanSpec, nodeType),
+      stringDictionaryCache_(params.stripeStreams().stringDictionaryCache()),
+      encodingKey_{fileType_->id(), params.flatMapContext().sequence},
       lastStrideIndex_(-1),
       provider_(params.stripeStreams().getStrideIndexProvider()),
       statistics_(params.runtimeStatistics()) {
   auto& stripe = params.stripeStreams();
-  EncodingKey encodingKey{fileType_->id(), params.flatMapContext().sequence};
+  const auto& encodingKey = encodingKey_;
   version_ = convertRleVersion(stripe.getEncoding(encodingKey).kind());
   scanState_.dictionary.numValues =
       stripe.getEncoding(encodingKey).dictionarysize();
@@ -152,7 +154,14 @@ void SelectiveStringDictionaryColumnReader::loadStrideDictionary() {
         *strideDictStream_, *strideDictLengthDecoder_, scanState_.dictionary2);
   }
   lastStrideIndex_ = nextStride;
-  dictionaryValues_ = nullptr;
+  // Keep the base vector over the stripe dictionary while there are no stride
+  // dictionary values. Expression results memoized on the base vector are then
+  // reused across row groups instead of being recomputed for each.
+  if (scanState_.dictionary2.numValues > 0 ||
+      (dictionaryValues_ &&
+       dictionaryValues_->size() != scanState_.dictionary.numValues)) {
+    dictionaryValues_ = nullptr;
+  }
 
   if (scanSpec_->hasFilter()) {
     scanState_.filterCache.resize(
@@ -189,6 +198,8 @@ void SelectiveStringDictionaryColumnReader::makeDictionaryBaseVector() {
         values,
         std::vector<BufferPtr>{
             scanState_.dictionary.strings, scanState_.dictionary2.strings});
+  } else if (sharedDictionaryValues_) {
+    dictionaryValues_ = sharedDictionaryValues_;
   } else {
     dictionaryValues_ = std::make_shared<FlatVector<StringView>>(
         &memoryPool_,
@@ -326,6 +337,23 @@ void SelectiveStringDictionaryColumnReader::getValues(
       &memoryPool_, resultNulls(), numValues_, dictionaryValues_, values_);
 }
 
+void SelectiveStringDictionaryColumnReader::shareDictionary() {
+  auto dictionary = std::make_shared<FlatVector<StringView>>(
+      &memoryPool_,
+      fileType_->type(),
+      BufferPtr(nullptr),
+      scanState_.dictionary.numValues,
+      scanState_.dictionary.values,
+      std::vector<BufferPtr>{scanState_.dictionary.strings});
+  sharedDictionaryValues_ = std::static_pointer_cast<FlatVector<StringView>>(
+      stringDictionaryCache_->share(encodingKey_, dictionary));
+  if (sharedDictionaryValues_ != dictionary) {
+    // Decode against the shared buffers and release the ones just loaded.
+    scanState_.dictionary.values = sharedDictionaryValues_->values();
+    scanState_.dictionary.strings = sharedDictionaryValues_->stringBuffers()[0];
+  }
+}
+
 void SelectiveStringDictionaryColumnReader::ensureInitialized() {
   if (LIKELY(initialized_)) {
     return;
@@ -334,6 +362,9 @@ void SelectiveStringDictionaryColumnReader::ensureInitialized() {
   Timer timer;
 
   loadDictionary(*blobStream_, *lengthDecoder_, scanState_.dictionary);
+  if (stringDictionaryCache_ && scanState_.dictionary.numValues > 0) {
+    shareDictionary();
+  }
 
   if (scanSpec_->hasFilter()) {
     scanState_.filterCache.resize(scanState_.dictionary.numValues);
@@ -19,6 +19,7 @@
 #include "velox/dwio/common/SelectiveColumnReaderInternal.h"
 #include "velox/dwio/dwrf/common/DecoderUtil.h"
 #include "velox/dwio/dwrf/reader/DwrfData.h"
+#include "velox/dwio/dwrf/reader/StripeDictionaryCache.h"
 
 namespace facebook::velox::dwrf {
 
@@ -82,6 +83,10 @@ class SelectiveStringDictionaryColumnReader
       dwio::common::DictionaryValues& values);
   void ensureInitialized();
 
+  // Replaces the just loaded stripe dictionary with an equal one from
+  // 'stringDictionaryCache_' if there is one.
+  void shareDictionary();
+
   void makeFlat(VectorPtr* result);
 
   std::unique_ptr<dwio::common::IntDecoder</*isSigned*/ false>> dictIndex_;
@@ -92,6 +97,14 @@ class SelectiveStringDictionaryColumnReader
 
   FlatVectorPtr<StringView> dictionaryValues_;
 
+  // Shares the stripe dictionary with earlier stripes of the same row reader
+  // when the contents are equal. Null if sharing is not enabled.
+  StringDictionaryCache* const stringDictionaryCache_;
+  const EncodingKey encodingKey_;
+  // The stripe dictionary as returned by 'stringDictionaryCache_'. Used as
+  // the base of results when there is no stride dictionary.
+  FlatVectorPtr<StringView> sharedDictionaryValues_;
+
   int64_t lastStrideIndex_;
   size_t positionOffset_;
   size_t strideDictSizeOffset_;
@@ -16,6 +16,8 @@
 
 #include "velox/dwio/dwrf/reader/StripeDictionaryCache.h"
 
+#include "velox/vector/FlatVector.h"
+
 namespace facebook::velox::dwrf {
 StripeDictionaryCache::DictionaryEntry::DictionaryEntry(
     folly::Function<BufferPtr(velox::memory::MemoryPool*)>&& dictGen)
@@ -45,4 +47,49 @@ BufferPtr StripeDictionaryCache::getIntDictionary(const EncodingKey& ek) {
   return intDictionaryFactories_.at(ek)->getDictionaryBuffer(pool_);
 }
 
+namespace {
+uint64_t hashStrings(const FlatVector<StringView>& strings) {
+  uint64_t hash = strings.size();
+  const auto* values = strings.rawValues();
+  for (auto i = 0; i < strings.size(); ++i) {
+    hash = bits::hashMix(
+        hash, folly::hasher<std::string_view>()(std::string_view(values[i])));
+  }
+  return hash;
+}
+
+bool equalStrings(
+    const FlatVector<StringView>& left,
+    const FlatVector<StringView>& right) {
+  if (left.size() != right.size()) {
+    return false;
+  }
+  const auto* leftValues = left.rawValues();
+  const auto* rightValues = right.rawValues();
+  for (auto i = 0; i < left.size(); ++i) {
+    if (leftValues[i] != rightValues[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+VectorPtr StringDictionaryCache::share(
+    const EncodingKey& ek,
+    const VectorPtr& dictionary) {
+  const auto* strings = dictionary->asFlatVector<StringView>();
+  VELOX_CHECK_NOT_NULL(strings);
+  const auto hash = hashStrings(*strings);
+  std::lock_guard<std::mutex> l(mutex_);
+  auto it = entries_.find(ek);
+  if (it != entries_.end() && it->second.hash == hash &&
+      equalStrings(
+          *strings, *it->second.dictionary->asFlatVector<StringView>())) {
+    return it->second.dictionary;
+  }
+  entries_.insert_or_assign(ek, Entry{hash, dictionary});
+  return dictionary;
+}
+
 } // namespace facebook::velox::dwrf
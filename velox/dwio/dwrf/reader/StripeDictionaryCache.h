@@ -17,6 +17,9 @@
 #pragma once
 
 #include <folly/Function.h>
+#include <folly/container/F14Map.h>
+
+#include <mutex>
 
 #include "velox/common/base/GTestMacros.h"
 #include "velox/dwio/common/IntDecoder.h"
@@ -61,4 +64,25 @@ class StripeDictionaryCache {
   VELOX_FRIEND_TEST(TestStripeDictionaryCache, RegisterDictionary);
 };
 
+/// Shares string dictionaries between the stripes read by a row reader. A
+/// stripe whose dictionary for a column has the same contents as the last
+/// one seen for the column gets the same base vector, so that consumers
+/// caching by dictionary identity keep their work across stripes.
+class StringDictionaryCache {
+ public:
+  /// Returns the cached base vector for 'ek' if it has the same strings as
+  /// 'dictionary'. Otherwise caches and returns 'dictionary'.
+  VectorPtr share(const EncodingKey& ek, const VectorPtr& dictionary);
+
+ private:
+  struct Entry {
+    uint64_t hash;
+    VectorPtr dictionary;
+  };
+
+  // Serializes access from stripes prefetched on other threads.
+  std::mutex mutex_;
+  folly::F14FastMap<EncodingKey, Entry, EncodingKeyHash> entries_;
+};
+
 } // namespace facebook::velox::dwrf
@@ -221,6 +221,10 @@ void StripeStreamsImpl::loadStreams() {
       }
     }
   }
+
+  for (const auto& item : streams_) {
+    nodeStreams_[item.first.encodingKey().node()].push_back(item.first);
+  }
 }
 
 std::unique_ptr<dwio::common::SeekableInputStream>
@@ -312,15 +316,14 @@ std::unique_ptr<dwio::common::SeekableInputStream> StripeStreamsImpl::getStream(
 uint32_t StripeStreamsImpl::visitStreamsOfNode(
     uint32_t node,
     std::function<void(const StreamInformation&)> visitor) const {
-  uint32_t count = 0;
-  for (auto& item : streams_) {
-    if (item.first.encodingKey().node() == node) {
-      visitor(item.second);
-      ++count;
-    }
+  auto it = nodeStreams_.find(node);
+  if (it == nodeStreams_.end()) {
+    return 0;
   }
-
-  return count;
+  for (const auto& id : it->second) {
+    visitor(streams_.at(id));
+  }
+  return it->second.size();
 }
 
 bool StripeStreamsImpl::getUseVInts(const DwrfStreamIdentifier& si) const {
@@ -138,6 +138,12 @@ class StripeStreams {
 
   virtual std::shared_ptr<StripeDictionaryCache> getStripeDictionaryCache() = 0;
 
+  /// Returns the cache that shares string dictionaries between the stripes
+  /// of a row reader, or nullptr if dictionaries are not shared.
+  virtual StringDictionaryCache* stringDictionaryCache() const {
+    return nullptr;
+  }
+
   /**
    * visit all streams of given node and execute visitor logic
    * return number of streams visited
@@ -244,6 +250,12 @@ class StripeStreamsImpl : public StripeStreamsBase {
   folly::F14FastMap<EncodingKey, uint32_t, EncodingKeyHash> encodings_;
   folly::F14FastMap<EncodingKey, proto::ColumnEncoding, EncodingKeyHash>
       decryptedEncodings_;
+  // Streams in 'streams_' grouped by node. Flat maps with many keys have
+  // many streams per node, so visitStreamsOfNode() must not scan all of the
+  // stripe's streams for each flat map reader.
+  folly::F14FastMap<uint32_t, std::vector<DwrfStreamIdentifier>>
+      nodeStreams_;
+  StringDictionaryCache* stringDictionaryCache_{nullptr};
 
  public:
   static constexpr int64_t kUnknownStripeRows = -1;
@@ -361,6 +373,14 @@ class StripeStreamsImpl : public StripeStreamsBase {
     return readState_->readerBase->getFooter().rowIndexStride();
   }
 
+  StringDictionaryCache* stringDictionaryCache() const override {
+    return stringDictionaryCache_;
+  }
+
+  void setStringDictionaryCache(StringDictionaryCache* cache) {
+    stringDictionaryCache_ = cache;
+  }
+
  private:
   const StreamInformation& getStreamInfo(
       const DwrfStreamIdentifier& si,
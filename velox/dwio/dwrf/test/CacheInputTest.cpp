@@ -18,15 +18,18 @@
 #include <folly/container/F14Map.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
 #include "velox/common/caching/FileIds.h"
+#include "velox/common/file/File.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/common/io/IoStatistics.h"
 #include "velox/common/io/Options.h"
 #include "velox/common/memory/MmapAllocator.h"
 #include "velox/dwio/common/CachedBufferedInput.h"
 #include "velox/dwio/dwrf/common/Common.h"
+#include "velox/dwio/dwrf/common/Compression.h"
 #include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 #include <gtest/gtest.h>
+#include <zstd.h>
 
 using namespace facebook::velox;
 using namespace facebook::velox::dwio;
@@ -85,10 +88,32 @@ class TestReadFile : public ReadFile {
     VELOX_NYI();
   }
 
+  folly::SemiFuture<uint64_t> preadvAsync(
+      uint64_t offset,
+      const std::vector<folly::Range<char*>>& buffers) const override {
+    ++numAsyncReads_;
+    return ReadFile::preadvAsync(offset, buffers);
+  }
+
+  bool hasPreadvAsync() const override {
+    return async_;
+  }
+
+  // Makes 'this' report that preadvAsync() is asynchronous.
+  void setAsync(bool async) {
+    async_ = async;
+  }
+
+  int64_t numAsyncReads() const {
+    return numAsyncReads_;
+  }
+
  private:
   const uint64_t seed_;
   const uint64_t length_;
   IoStatisticsPtr ioStats_;
+  bool async_{false};
+  mutable std::atomic<int64_t> numAsyncReads_{0};
 };
 
 class CacheTest : public testing::Test {
@@ -506,6 +531,83 @@ TEST_F(CacheTest, window) {
   EXPECT_EQ(kMB, ioStats_->rawBytesRead() - previousRead);
 }
 
+TEST_F(CacheTest, decompressedBlocks) {
+  constexpr int32_t kBlockSize = 100'000;
+  initializeCache(64 << 20);
+  // The file does not have the contents checked by checkEntry().
+  cache_->setVerifyHook(nullptr);
+  cache_->setMaxDecompressedPct(10);
+
+  // Two ZSTD blocks, each after a 3 byte DWRF compression header.
+  std::vector<std::string> blocks;
+  std::string contents;
+  for (auto i = 0; i < 2; ++i) {
+    std::string block(kBlockSize, 0);
+    for (auto j = 0; j < kBlockSize; ++j) {
+      block[j] = 'a' + (j / (i + 7)) % 26;
+    }
+    std::string compressed(ZSTD_compressBound(kBlockSize), 0);
+    const auto size = ZSTD_compress(
+        compressed.data(), compressed.size(), block.data(), kBlockSize, 1);
+    ASSERT_FALSE(ZSTD_isError(size));
+    const uint32_t header = size << 1;
+    contents.push_back(header & 0xff);
+    contents.push_back((header >> 8) & 0xff);
+    contents.push_back((header >> 16) & 0xff);
+    contents.append(compressed.data(), size);
+    blocks.push_back(std::move(block));
+  }
+  auto file = std::make_shared<InMemoryReadFile>(contents);
+  StringIdLease fileId(fileIds(), "test_decompressed_blocks");
+  auto tracker = std::make_shared<ScanTracker>(
+      "testTracker",
+      nullptr,
+      io::ReaderOptions::kDefaultLoadQuantum,
+      groupStats_);
+
+  auto readAll = [&]() {
+    auto input = std::make_unique<CachedBufferedInput>(
+        file,
+        MetricsLog::voidLog(),
+        fileId.id(),
+        cache_.get(),
+        tracker,
+        0,
+        ioStats_,
+        executor_.get(),
+        io::ReaderOptions(pool_.get()));
+    auto stream = dwrf::createDecompressor(
+        facebook::velox::common::CompressionKind_ZSTD,
+        input->read(0, contents.size(), LogType::TEST),
+        kBlockSize,
+        *pool_,
+        "decompressedBlocks");
+    const void* buffer;
+    int32_t size;
+    for (const auto& block : blocks) {
+      ASSERT_TRUE(stream->Next(&buffer, &size));
+      ASSERT_EQ(
+          std::string_view(static_cast<const char*>(buffer), size), block);
+    }
+    ASSERT_FALSE(stream->Next(&buffer, &size));
+  };
+
+  readAll();
+  EXPECT_EQ(cache_->decompressedBytes(), 2 * kBlockSize);
+  const auto numHits = cache_->refreshStats().numHit;
+  readAll();
+  EXPECT_EQ(cache_->decompressedBytes(), 2 * kBlockSize);
+  // Both decompressed blocks are hits.
+  EXPECT_GE(cache_->refreshStats().numHit, numHits + 2);
+
+  // Blocks are not added past the share of the capacity for them.
+  cache_->clear();
+  EXPECT_EQ(cache_->decompressedBytes(), 0);
+  cache_->setMaxDecompressedPct(0);
+  readAll();
+  EXPECT_EQ(cache_->decompressedBytes(), 0);
+}
+
 TEST_F(CacheTest, bufferedInput) {
   // Size 160 MB. Frequent evictions and not everything fits in prefetch window.
   initializeCache(160 << 20);
@@ -514,6 +616,16 @@ TEST_F(CacheTest, bufferedInput) {
   readLoop("testfile2", 30, 70, 70, 20, 4, ioStats_);
 }
 
+TEST_F(CacheTest, asyncReads) {
+  initializeCache(160 << 20);
+  uint64_t fileId;
+  uint64_t groupId;
+  auto file = inputByPath("asyncfile", fileId, groupId);
+  file->setAsync(true);
+  readLoop("asyncfile", 30, 70, 10, 20, 4, ioStats_);
+  EXPECT_LT(0, file->numAsyncReads());
+}
+
 // Calibrates the data read for a densely and sparsely read stripe of
 // test data. Fills the SSD cache with test data. Reads 2x cache size
 // worth of data and checks that the cache population settles to a
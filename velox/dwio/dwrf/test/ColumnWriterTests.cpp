@@ -4093,6 +4093,76 @@ TEST(ColumnWriterTests, StringColumnWriterAbandonLowValueDictionaries) {
   }
 }
 
+TEST(ColumnWriterTests, StringColumnWriterPerStripeEncoding) {
+  constexpr size_t kSize = 1'000;
+  auto pool = addDefaultLeafMemoryPool();
+  auto makeBatch = [&](size_t numDistinct) {
+    auto vector = BaseVector::create<FlatVector<StringView>>(
+        VARCHAR(), kSize, pool.get());
+    for (size_t i = 0; i < kSize; ++i) {
+      // The values are short enough to be inlined in the StringView.
+      vector->set(i, StringView(folly::to<std::string>(i % numDistinct)));
+    }
+    return vector;
+  };
+  // Unique values are not fit for dictionary encoding, values with few
+  // distinct keys are.
+  const std::vector<size_t> numDistincts = {kSize, 10, 10, kSize, 10};
+
+  for (const bool perStripe : {false, true}) {
+    SCOPED_TRACE(fmt::format("perStripe: {}", perStripe));
+    auto config = std::make_shared<Config>();
+    config->set(Config::DICTIONARY_STRING_PER_STRIPE, perStripe);
+    WriterContext context{config, defaultMemoryManager().addRootPool()};
+    auto typeWithId = TypeWithId::create(VARCHAR(), 1);
+    auto columnWriter = BaseColumnWriter::create(context, *typeWithId);
+    // Without per stripe encoding the direct encoding chosen on the first
+    // stripe is kept. Otherwise a direct stripe with repeated values makes
+    // the next stripe try dictionary encoding again.
+    const std::vector<proto::ColumnEncoding_Kind> expectedKinds = perStripe
+        ? std::vector<proto::ColumnEncoding_Kind>{
+              proto::ColumnEncoding_Kind_DIRECT,
+              proto::ColumnEncoding_Kind_DIRECT,
+              proto::ColumnEncoding_Kind_DICTIONARY,
+              proto::ColumnEncoding_Kind_DIRECT,
+              proto::ColumnEncoding_Kind_DIRECT}
+        : std::vector<proto::ColumnEncoding_Kind>(
+              numDistincts.size(), proto::ColumnEncoding_Kind_DIRECT);
+
+    for (size_t i = 0; i < numDistincts.size(); ++i) {
+      auto batch = makeBatch(numDistincts[i]);
+      columnWriter->write(batch, common::Ranges::of(0, kSize));
+      columnWriter->createIndexEntry();
+      proto::StripeFooter stripeFooter;
+      columnWriter->flush(
+          [&stripeFooter](uint32_t /* unused */) -> proto::ColumnEncoding& {
+            return *stripeFooter.add_encoding();
+          });
+
+      auto rowType = ROW({{"string_column", VARCHAR()}});
+      TestStripeStreams streams(context, stripeFooter, rowType, pool.get());
+      ASSERT_EQ(expectedKinds[i], streams.getEncoding(EncodingKey{1}).kind());
+
+      auto reqType = TypeWithId::create(rowType)->childAt(0);
+      memory::AllocationPool allocPool(pool.get());
+      StreamLabels labels(allocPool);
+      auto columnReader =
+          ColumnReader::build(reqType, reqType, streams, labels);
+      EXPECT_CALL(streams.getMockStrideIndexProvider(), getStrideIndex())
+          .Times(::testing::AtMost(1))
+          .WillOnce(Return(0));
+      VectorPtr result;
+      columnReader->next(kSize, result);
+      ASSERT_EQ(kSize, result->size());
+      for (size_t row = 0; row < kSize; ++row) {
+        ASSERT_TRUE(batch->equalValueAt(result.get(), row, row));
+      }
+      context.nextStripe();
+      columnWriter->reset();
+    }
+  }
+}
+
 TEST(ColumnWriterTests, IntDictWriterDirectValueOverflow) {
   auto config = std::make_shared<Config>();
   auto pool = addDefaultLeafMemoryPool();
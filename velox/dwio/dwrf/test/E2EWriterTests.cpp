@@ -15,6 +15,7 @@
  */
 
 #include <folly/Random.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <random>
 #include "velox/dwio/common/Options.h"
 #include "velox/dwio/common/Statistics.h"
@@ -815,6 +816,58 @@ TEST_F(E2EWriterTests, PartialStride) {
   ASSERT_EQ(true, reader->columnStatistics(1)->hasNull().value());
 }
 
+TEST_F(E2EWriterTests, parallelEncoding) {
+  HiveTypeParser parser;
+  auto type = parser.parse(
+      "struct<"
+      "int_val:int,"
+      "long_val:bigint,"
+      "double_val:double,"
+      "string_val:string,"
+      "array_val:array<float>,"
+      "map_val:map<int,double>,"
+      "flat_map_val:map<bigint,double>," /* this is column 6 */
+      "struct_val:struct<a:float,b:double>"
+      ">");
+
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::ROW_INDEX_STRIDE, static_cast<uint32_t>(1000));
+  config->set(dwrf::Config::FLATTEN_MAP, true);
+  config->set(dwrf::Config::MAP_FLAT_COLS, {6});
+
+  std::vector<VectorPtr> batches;
+  for (size_t i = 0; i < 4; ++i) {
+    batches.push_back(
+        BatchMaker::createBatch(type, 1'100, *leafPool_, nullptr, i));
+  }
+
+  // Encoding the columns in parallel produces the same file as encoding them
+  // on the calling thread.
+  auto writeFile = [&](std::shared_ptr<folly::Executor> executor) {
+    auto sink = std::make_unique<MemorySink>(
+        8 * 1024 * 1024,
+        dwio::common::FileSink::Options{.pool = leafPool_.get()});
+    auto* sinkPtr = sink.get();
+    dwrf::WriterOptions options;
+    options.config = config;
+    options.schema = type;
+    options.memoryPool = rootPool_.get();
+    options.encodingExecutor = std::move(executor);
+    dwrf::Writer writer{std::move(sink), options};
+    for (const auto& batch : batches) {
+      writer.write(batch);
+    }
+    writer.close();
+    return std::string(sinkPtr->data(), sinkPtr->size());
+  };
+
+  const auto expected = writeFile(nullptr);
+  const auto actual =
+      writeFile(std::make_shared<folly::CPUThreadPoolExecutor>(4));
+  ASSERT_EQ(expected.size(), actual.size());
+  ASSERT_TRUE(expected == actual);
+}
+
 TEST_F(E2EWriterTests, OversizeRows) {
   auto pool = facebook::velox::memory::addDefaultLeafMemoryPool();
 
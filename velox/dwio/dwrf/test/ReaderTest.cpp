@@ -2716,3 +2716,167 @@ TEST(TestReader, readStringDictionaryAsFlat) {
   rowReader->updateRuntimeStats(stats);
   ASSERT_EQ(stats.columnReaderStatistics.flattenStringDictionaryValues, 1);
 }
+
+TEST(TestReader, stringDictionaryBaseAcrossRowGroups) {
+  auto* pool = getDefaultPool().get();
+  VectorMaker maker(pool);
+  // 10 row groups of 100 rows. Only row group 3 has a value that is written
+  // to the stride dictionary.
+  auto batch = maker.rowVector({maker.flatVector<std::string>(
+      1'000,
+      [](auto i) {
+        return i == 350 ? std::string("unique") : fmt::format("s{}", i % 5);
+      })});
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::ROW_INDEX_STRIDE, 100u);
+  auto [writer, reader] = createWriterReader(
+      {batch},
+      *pool,
+      config,
+      E2EWriterTestUtil::simpleFlushPolicyFactory(false));
+  auto rowType = reader->rowType();
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addAllChildFields(*rowType);
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(spec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  std::vector<const BaseVector*> bases;
+  std::vector<VectorPtr> results;
+  auto actual = BaseVector::create(rowType, 0, pool);
+  while (rowReader->next(100, actual) > 0) {
+    auto c0 = BaseVector::loadedVectorShared(
+        actual->as<RowVector>()->childAt(0));
+    ASSERT_EQ(c0->encoding(), VectorEncoding::Simple::DICTIONARY);
+    bases.push_back(c0->valueVector().get());
+    // Keep the results alive so that the addresses of the bases are unique.
+    results.push_back(c0);
+    actual = BaseVector::create(rowType, 0, pool);
+  }
+  ASSERT_EQ(bases.size(), 10);
+  ASSERT_EQ(bases[0], bases[1]);
+  ASSERT_EQ(bases[0], bases[2]);
+  ASSERT_NE(bases[2], bases[3]);
+  ASSERT_NE(bases[3], bases[4]);
+  for (auto i = 5; i < 10; ++i) {
+    ASSERT_EQ(bases[4], bases[i]);
+  }
+}
+
+TEST(TestReader, stringDictionaryBaseAcrossStripes) {
+  auto* pool = getDefaultPool().get();
+  VectorMaker maker(pool);
+  std::vector<VectorPtr> batches;
+  for (auto i = 0; i < 4; ++i) {
+    // The last stripe has a different dictionary.
+    batches.push_back(maker.rowVector({maker.flatVector<std::string>(
+        100, [&](auto j) { return fmt::format("s{}_{}", i / 3, j % 5); })}));
+  }
+  // Do not flush before the first batch so that the dictionary encoding is
+  // kept, then write each batch to its own stripe.
+  auto flushPolicyFactory = []() {
+    return std::make_unique<LambdaFlushPolicy>(
+        [first = true]() mutable { return !std::exchange(first, false); });
+  };
+  auto [writer, reader] = createWriterReader(
+      batches, *pool, std::make_shared<dwrf::Config>(), flushPolicyFactory);
+  ASSERT_EQ(reader->getNumberOfStripes(), 4);
+  auto rowType = reader->rowType();
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addAllChildFields(*rowType);
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(spec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  std::vector<const BaseVector*> bases;
+  std::vector<VectorPtr> results;
+  auto actual = BaseVector::create(rowType, 0, pool);
+  while (rowReader->next(100, actual) > 0) {
+    auto c0 = BaseVector::loadedVectorShared(
+        actual->as<RowVector>()->childAt(0));
+    ASSERT_EQ(c0->encoding(), VectorEncoding::Simple::DICTIONARY);
+    bases.push_back(c0->valueVector().get());
+    results.push_back(c0);
+    actual = BaseVector::create(rowType, 0, pool);
+  }
+  ASSERT_EQ(bases.size(), 4);
+  ASSERT_EQ(bases[0], bases[1]);
+  ASSERT_EQ(bases[0], bases[2]);
+  ASSERT_NE(bases[2], bases[3]);
+  for (auto i = 0; i < 4; ++i) {
+    ASSERT_EQ(
+        results[i]->asUnchecked<SimpleVector<StringView>>()->valueAt(0).str(),
+        fmt::format("s{}_0", i / 3));
+  }
+}
+
+TEST(TestReader, runEndEncodedResult) {
+  auto* pool = getDefaultPool().get();
+  VectorMaker maker(pool);
+  auto batch = maker.rowVector({
+      maker.flatVector<int64_t>(1000, [](auto i) { return i / 100; }),
+      maker.flatVector<int64_t>(1000, [](auto i) { return i % 7; }),
+  });
+  auto [writer, reader] = createWriterReader({batch}, *pool);
+  auto rowType = reader->rowType();
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addAllChildFields(*rowType);
+  spec->childByName("c0")->setMinRunLength(10);
+  spec->childByName("c1")->setMinRunLength(10);
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(spec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  auto actual = BaseVector::create(rowType, 0, pool);
+  ASSERT_EQ(rowReader->next(1000, actual), 1000);
+  auto* rows = actual->as<RowVector>();
+  auto c0 = BaseVector::loadedVectorShared(rows->childAt(0));
+  auto c1 = BaseVector::loadedVectorShared(rows->childAt(1));
+  // Long runs are returned as runs, short runs stay flat.
+  ASSERT_EQ(c0->encoding(), VectorEncoding::Simple::SEQUENCE);
+  ASSERT_EQ(c0->valueVector()->size(), 10);
+  ASSERT_EQ(c1->encoding(), VectorEncoding::Simple::FLAT);
+  for (auto i = 0; i < batch->size(); ++i) {
+    ASSERT_TRUE(batch->equalValueAt(actual.get(), i, i)) << "at " << i;
+  }
+}
+
+TEST(TestReader, loadLazyColumnsPastSkippedRowGroups) {
+  auto* pool = getDefaultPool().get();
+  VectorMaker maker(pool);
+  constexpr vector_size_t kSize = 1'000;
+  auto batch = maker.rowVector({
+      maker.flatVector<int64_t>(kSize, folly::identity),
+      maker.flatVector<int64_t>(kSize, [](auto i) { return i * 10; }),
+      maker.flatVector<std::string>(
+          kSize, [](auto i) { return fmt::format("s{}", i % 7); }),
+      maker.rowVector({maker.flatVector<int32_t>(kSize, folly::identity)}),
+  });
+  auto config = std::make_shared<dwrf::Config>();
+  config->set(dwrf::Config::ROW_INDEX_STRIDE, 100u);
+  auto [writer, reader] = createWriterReader({batch}, *pool, config);
+  auto schema = asRowType(batch->type());
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addAllChildFields(*schema);
+  // The surviving rows start in the third row group. The lazy columns are
+  // positioned at that row group without decoding the rows before it.
+  spec->childByName("c0")->setFilter(
+      common::createBigintValues({250, 251, 777}, false));
+  RowReaderOptions rowReaderOpts;
+  rowReaderOpts.setScanSpec(spec);
+  auto rowReader = reader->createRowReader(rowReaderOpts);
+  auto actual = BaseVector::create(schema, 0, pool);
+  ASSERT_EQ(rowReader->next(kSize, actual), kSize);
+  auto expected = maker.rowVector({
+      maker.flatVector<int64_t>({250, 251, 777}),
+      maker.flatVector<int64_t>({2'500, 2'510, 7'770}),
+      maker.flatVector<std::string>({"s5", "s6", "s0"}),
+      maker.rowVector({maker.flatVector<int32_t>({250, 251, 777})}),
+  });
+  ASSERT_EQ(actual->size(), expected->size());
+  auto* actualRow = actual->loadedVector()->as<RowVector>();
+  for (auto i = 0; i < expected->childrenSize(); ++i) {
+    auto* child = actualRow->childAt(i)->loadedVector();
+    for (auto row = 0; row < expected->size(); ++row) {
+      ASSERT_TRUE(expected->childAt(i)->equalValueAt(child, row, row))
+          << "Mismatch in c" << i << " at " << row;
+    }
+  }
+}
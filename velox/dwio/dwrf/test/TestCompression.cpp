@@ -23,6 +23,7 @@
 
 #include <folly/Random.h>
 #include <gtest/gtest.h>
+#include <zstd.h>
 
 #include <algorithm>
 
@@ -467,3 +468,128 @@ TEST(CompressionOptionsTest, testCompressionOptions) {
   EXPECT_EQ(options.format.zstd.compressionLevel, 7);
   EXPECT_EQ(options.compressionThreshold, 256);
 }
+
+namespace {
+// Stands in for an accelerated codec. Uses software zstd and counts calls.
+class CountingZstdCompressor : public Compressor {
+ public:
+  CountingZstdCompressor(int32_t level, int32_t& numCalls)
+      : Compressor(level), numCalls_(numCalls) {}
+
+  uint64_t compress(const void* src, void* dest, uint64_t length) override {
+    ++numCalls_;
+    const auto size = ZSTD_compress(dest, length, src, length, level_);
+    return ZSTD_isError(size) ? length : size;
+  }
+
+ private:
+  int32_t& numCalls_;
+};
+
+class CountingZstdDecompressor : public Decompressor {
+ public:
+  CountingZstdDecompressor(
+      uint64_t blockSize,
+      const std::string& streamDebugInfo,
+      int32_t& numCalls)
+      : Decompressor(blockSize, streamDebugInfo), numCalls_(numCalls) {}
+
+  uint64_t decompress(
+      const char* src,
+      uint64_t srcLength,
+      char* dest,
+      uint64_t destLength) override {
+    ++numCalls_;
+    const auto size = ZSTD_decompress(dest, destLength, src, srcLength);
+    VELOX_CHECK(!ZSTD_isError(size), ZSTD_getErrorName(size));
+    return size;
+  }
+
+ private:
+  int32_t& numCalls_;
+};
+} // namespace
+
+TEST(CodecFactoriesTest, registeredCodecs) {
+  auto pool = addDefaultLeafMemoryPool();
+  constexpr uint64_t kBlock = 1024;
+  constexpr size_t kDataSize = 64 * 1024;
+  std::vector<char> testData(kDataSize);
+  generateRandomData(testData.data(), kDataSize, true);
+
+  int32_t numCompress = 0;
+  int32_t numDecompress = 0;
+  bool available = true;
+  registerCodecFactories(
+      CompressionKind_ZSTD,
+      [&](const CompressionOptions& options) -> std::unique_ptr<Compressor> {
+        if (!available) {
+          return nullptr;
+        }
+        return std::make_unique<CountingZstdCompressor>(
+            options.format.zstd.compressionLevel, numCompress);
+      },
+      [&](uint64_t blockSize,
+          const CompressionOptions& /*options*/,
+          const std::string& streamDebugInfo)
+          -> std::unique_ptr<Decompressor> {
+        if (!available) {
+          return nullptr;
+        }
+        return std::make_unique<CountingZstdDecompressor>(
+            blockSize, streamDebugInfo, numDecompress);
+      });
+
+  {
+    MemorySink memSink(DEFAULT_MEM_STREAM_SIZE, {.pool = pool.get()});
+    compressAndVerify(
+        CompressionKind_ZSTD,
+        memSink,
+        kBlock,
+        *pool,
+        testData.data(),
+        kDataSize,
+        nullptr);
+    decompressAndVerify(
+        memSink,
+        CompressionKind_ZSTD,
+        kBlock,
+        testData.data(),
+        kDataSize,
+        *pool,
+        nullptr);
+    EXPECT_GT(numCompress, 0);
+    EXPECT_GT(numDecompress, 0);
+  }
+
+  // Factories that decline fall back to the software codec.
+  available = false;
+  numCompress = 0;
+  numDecompress = 0;
+  {
+    MemorySink memSink(DEFAULT_MEM_STREAM_SIZE, {.pool = pool.get()});
+    compressAndVerify(
+        CompressionKind_ZSTD,
+        memSink,
+        kBlock,
+        *pool,
+        testData.data(),
+        kDataSize,
+        nullptr);
+    decompressAndVerify(
+        memSink,
+        CompressionKind_ZSTD,
+        kBlock,
+        testData.data(),
+        kDataSize,
+        *pool,
+        nullptr);
+    EXPECT_EQ(numCompress, 0);
+    EXPECT_EQ(numDecompress, 0);
+  }
+  unregisterCodecFactories(CompressionKind_ZSTD);
+
+  VELOX_ASSERT_THROW(
+      registerCodecFactories(CompressionKind_NONE, nullptr, nullptr),
+      "Cannot register codec factories for no compression");
+}
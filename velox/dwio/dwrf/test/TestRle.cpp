@@ -666,6 +666,90 @@ TEST(RLEv2, bitsLeftByPreviousStream) {
   }
 };
 
+TEST(RLEv2, directAllBitWidths) {
+  auto pool = memory::addDefaultLeafMemoryPool();
+  const uint32_t widths[] = {1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11,
+                             12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22,
+                             23, 24, 26, 28, 30, 32, 40, 48, 56, 64};
+  const uint64_t count = 300;
+  std::vector<uint64_t> nulls(bits::nwords(2 * count));
+  for (auto i = 0; i < 2 * count; ++i) {
+    bits::setNull(nulls.data(), i, i % 3 == 1);
+  }
+  for (uint32_t code = 0; code < 32; ++code) {
+    const uint32_t width = widths[code];
+    const uint64_t mask = width == 64 ? ~0ULL : (1ULL << width) - 1;
+    // Two DIRECT runs of 'count' / 2 values, bit packed big-endian.
+    std::vector<uint64_t> values;
+    std::vector<unsigned char> bytes;
+    for (auto run = 0; run < 2; ++run) {
+      const uint64_t length = count / 2;
+      bytes.push_back(0x40 | (code << 1) | ((length - 1) >> 8));
+      bytes.push_back((length - 1) & 0xff);
+      uint64_t current = 0;
+      int32_t numBits = 0;
+      for (auto i = 0; i < length; ++i) {
+        const uint64_t value =
+            (0x9E3779B97F4A7C15ULL * (values.size() + 1)) & mask;
+        values.push_back(value);
+        for (int32_t bit = width - 1; bit >= 0; --bit) {
+          current = (current << 1) | ((value >> bit) & 1);
+          if (++numBits == 8) {
+            bytes.push_back(current);
+            current = 0;
+            numBits = 0;
+          }
+        }
+      }
+      if (numBits > 0) {
+        bytes.push_back(current << (8 - numBits));
+      }
+    }
+
+    for (auto blockSize : {0, 7, 64}) {
+      for (auto withNulls : {false, true}) {
+        auto rle = createRleDecoder<false>(
+            std::make_unique<dwio::common::SeekableArrayInputStream>(
+                bytes.data(), bytes.size(), blockSize),
+            RleVersion_2,
+            *pool,
+            true /* doesn't matter */,
+            dwio::common::INT_BYTE_SIZE /* doesn't matter */);
+        // With nulls, the non-null positions of 2 * 'count' rows consume
+        // the encoded values in order.
+        const uint64_t numRows = withNulls ? count * 3 / 2 : count;
+        std::vector<int64_t> data(numRows);
+        uint64_t numRead = 0;
+        while (numRead < numRows) {
+          const uint64_t batch = std::min<uint64_t>(37, numRows - numRead);
+          std::vector<uint64_t> batchNulls(bits::nwords(batch));
+          for (auto i = 0; i < batch; ++i) {
+            bits::setNull(
+                batchNulls.data(),
+                i,
+                bits::isBitNull(nulls.data(), numRead + i));
+          }
+          rle->next(
+              data.data() + numRead,
+              batch,
+              withNulls ? batchNulls.data() : nullptr);
+          numRead += batch;
+        }
+        uint64_t valueIndex = 0;
+        for (auto i = 0; i < numRows; ++i) {
+          if (withNulls && bits::isBitNull(nulls.data(), i)) {
+            continue;
+          }
+          ASSERT_EQ(values[valueIndex++], static_cast<uint64_t>(data[i]))
+              << "width " << width << ", row " << i << ", block size "
+              << blockSize;
+        }
+        ASSERT_EQ(count, valueIndex);
+      }
+    }
+  }
+}
+
 TEST(RLEv1, simpleTest) {
   auto pool = memory::addDefaultLeafMemoryPool();
   const unsigned char buffer[] = {
@@ -212,6 +212,57 @@ TEST(StripeStream, filterSequences) {
   }
 }
 
+TEST(StripeStream, visitStreamsOfNode) {
+  auto pool = addDefaultLeafMemoryPool();
+  google::protobuf::Arena arena;
+  auto footer = google::protobuf::Arena::CreateMessage<proto::Footer>(&arena);
+  footer->set_rowindexstride(100);
+  auto type = HiveTypeParser().parse("struct<a:map<int,float>>");
+  ProtoUtils::writeType(*type, *footer);
+  auto is = std::make_unique<RecordingInputStream>();
+  auto readerBase = std::make_shared<ReaderBase>(
+      *pool,
+      std::make_unique<BufferedInput>(std::move(is), *pool),
+      std::make_unique<PostScript>(proto::PostScript{}),
+      footer,
+      nullptr);
+  ColumnSelector cs{readerBase->getSchema()};
+
+  auto stripeFooter =
+      google::protobuf::Arena::CreateMessage<proto::StripeFooter>(&arena);
+  std::vector<std::tuple<uint64_t, StreamKind, uint64_t>> ss{
+      std::make_tuple(1, StreamKind::StreamKind_PRESENT, 0),
+      std::make_tuple(2, StreamKind::StreamKind_DATA, 0),
+      std::make_tuple(3, StreamKind::StreamKind_IN_MAP, 1),
+      std::make_tuple(3, StreamKind::StreamKind_DATA, 1),
+      std::make_tuple(3, StreamKind::StreamKind_IN_MAP, 2),
+      std::make_tuple(3, StreamKind::StreamKind_DATA, 2),
+      std::make_tuple(3, StreamKind::StreamKind_IN_MAP, 3)};
+  for (const auto& s : ss) {
+    auto&& stream = stripeFooter->add_streams();
+    stream->set_node(std::get<0>(s));
+    stream->set_kind(static_cast<proto::Stream_Kind>(std::get<1>(s)));
+    stream->set_length(100);
+    stream->set_sequence(std::get<2>(s));
+  }
+
+  StripeReaderBase stripeReader{readerBase, stripeFooter};
+  auto streams = createAndLoadStripeStreams(stripeReader, cs);
+  std::vector<uint32_t> sequences;
+  EXPECT_EQ(
+      streams.visitStreamsOfNode(
+          3,
+          [&](const StreamInformation& stream) {
+            EXPECT_EQ(stream.getNode(), 3);
+            sequences.push_back(stream.getSequence());
+          }),
+      5);
+  std::sort(sequences.begin(), sequences.end());
+  EXPECT_EQ(sequences, (std::vector<uint32_t>{1, 1, 2, 2, 3}));
+  EXPECT_EQ(streams.visitStreamsOfNode(1, [](const auto&) {}), 1);
+  EXPECT_EQ(streams.visitStreamsOfNode(0, [](const auto&) {}), 0);
+}
+
 TEST(StripeStream, zeroLength) {
   auto pool = addDefaultLeafMemoryPool();
   google::protobuf::Arena arena;
@@ -15,6 +15,7 @@
  */
 
 #include "velox/dwio/dwrf/writer/ColumnWriter.h"
+#include <folly/futures/Future.h>
 #include <velox/dwio/common/exception/Exception.h>
 #include "velox/dwio/common/ChainedBuffer.h"
 #include "velox/dwio/dwrf/common/EncoderUtil.h"
@@ -35,7 +36,12 @@ namespace facebook::velox::dwrf {
 WriterContext::LocalDecodedVector BaseColumnWriter::decode(
     const VectorPtr& slice,
     const common::Ranges& ranges) {
-  auto& selected = context_.getSharedSelectivityVector(slice->size());
+  // Columns written in parallel on the encoding executor can not share the
+  // selectivity vector of the context.
+  std::optional<SelectivityVector> localSelected;
+  auto& selected = context_.encodingExecutor() != nullptr
+      ? localSelected.emplace(slice->size())
+      : context_.getSharedSelectivityVector(slice->size());
   // initialize
   selected.clearAll();
   for (auto& range : ranges.getRanges()) {
@@ -775,7 +781,8 @@ uint64_t TimestampColumnWriter::write(
 // The string writer class that tries to use dictionary encoding to write
 // the given string values. If dictionary encoding is determined to be
 // inefficient for the column, we would write the column with direct encoding
-// instead.
+// instead. The choice is made on the first stripe and kept for the file unless
+// DICTIONARY_STRING_PER_STRIPE is set, in which case it is made per stripe.
 class StringColumnWriter : public BaseColumnWriter {
  public:
   StringColumnWriter(
@@ -804,6 +811,11 @@ class StringColumnWriter : public BaseColumnWriter {
             getConfig(Config::ENTROPY_STRING_DICT_SAMPLE_FRACTION),
             getConfig(Config::ENTROPY_STRING_THRESHOLD)},
         sort_{getConfig(Config::DICTIONARY_SORT_KEYS)},
+        perStripeEncoding_{getConfig(Config::DICTIONARY_STRING_PER_STRIPE)},
+        numSampleRows_{getConfig(Config::DICTIONARY_STRING_SAMPLE_ROWS)},
+        sampleEncoder_{
+            getMemoryPool(MemoryUsageCategory::DICTIONARY),
+            getMemoryPool(MemoryUsageCategory::GENERAL)},
         useDictionaryEncoding_{useDictionaryEncoding()},
         strideOffsets_{getMemoryPool(MemoryUsageCategory::GENERAL)} {
     DWIO_ENSURE(firstStripe_);
@@ -816,6 +828,13 @@ class StringColumnWriter : public BaseColumnWriter {
   uint64_t write(const VectorPtr& slice, const common::Ranges& ranges) override;
 
   void reset() override {
+    if (retryDictionary_) {
+      // The streams are empty at the start of a stripe, so the direct
+      // encoding streams can be replaced.
+      retryDictionary_ = false;
+      releaseStreamWriters();
+      useDictionaryEncoding_ = true;
+    }
     // Lots of decisions regarding the presence of streams are made at flush
     // time. We would defer recording all stream positions till then, and
     // only record position for PRESENT stream upon construction.
@@ -871,7 +890,13 @@ class StringColumnWriter : public BaseColumnWriter {
     } else {
       dataDirect_->flush();
       dataDirectLength_->flush();
+      // Tries dictionary encoding again on the next stripe if the values
+      // sampled from this stripe are fit for it.
+      retryDictionary_ = numSampledRows_ > 0 && useDictionaryEncoding() &&
+          encodingSelector_.useDictionary(sampleEncoder_, numSampledRows_);
     }
+    sampleEncoder_.clear();
+    numSampledRows_ = 0;
 
     // Start the new stripe.
     firstStripe_ = false;
@@ -930,9 +955,7 @@ class StringColumnWriter : public BaseColumnWriter {
   }
 
   bool tryAbandonDictionaries(bool force) override {
-    // TODO: hopefully not required in the future, but need to solve the problem
-    // of replacing/deleting streams.
-    if (!useDictionaryEncoding_ || !firstStripe_) {
+    if (!useDictionaryEncoding_ || (!firstStripe_ && !perStripeEncoding_)) {
       return false;
     }
 
@@ -941,6 +964,9 @@ class StringColumnWriter : public BaseColumnWriter {
       return false;
     }
 
+    // The dictionary encoding streams of a previous stripe are empty until
+    // they are populated at flush.
+    releaseStreamWriters();
     initStreamWriters(useDictionaryEncoding_);
     // Record direct encoding stream starting position.
     recordDirectEncodingStreamPositions(0);
@@ -1017,6 +1043,28 @@ class StringColumnWriter : public BaseColumnWriter {
     ensureValidStreamWriters(dictEncoding);
   }
 
+  // Destroys the stream writers of the current encoding and removes their
+  // streams, so that the streams of the other encoding can be created. The
+  // streams must be empty.
+  void releaseStreamWriters() {
+    auto release = [&](auto& writer, StreamKind kind) {
+      if (writer) {
+        writer.reset();
+        removeStream(kind);
+      }
+    };
+    release(data_, StreamKind::StreamKind_DATA);
+    release(dictionaryData_, StreamKind::StreamKind_DICTIONARY_DATA);
+    release(dictionaryDataLength_, StreamKind::StreamKind_LENGTH);
+    release(inDictionary_, StreamKind::StreamKind_IN_DICTIONARY);
+    release(strideDictionaryData_, StreamKind::StreamKind_STRIDE_DICTIONARY);
+    release(
+        strideDictionaryDataLength_,
+        StreamKind::StreamKind_STRIDE_DICTIONARY_LENGTH);
+    release(dataDirect_, StreamKind::StreamKind_DATA);
+    release(dataDirectLength_, StreamKind::StreamKind_LENGTH);
+  }
+
   // NOTE: This should be called *before* clearing the rows_ buffer.
   bool shouldKeepDictionary() const {
     return rows_.size() != 0 &&
@@ -1078,10 +1126,19 @@ class StringColumnWriter : public BaseColumnWriter {
   size_t finalDictionarySize_;
   EntropyEncodingSelector encodingSelector_;
   const bool sort_;
+  const bool perStripeEncoding_;
+  const uint32_t numSampleRows_;
+  // Distinct values of the first 'numSampleRows_' values of a direct encoded
+  // stripe if 'perStripeEncoding_' is set.
+  StringDictionaryEncoder sampleEncoder_;
+  uint32_t numSampledRows_{0};
   // This value could change if we are writing with low memory mode or if we
   // determine with the first stripe that the data is not fit for dictionary
   // encoding.
   bool useDictionaryEncoding_;
+  // True if the next stripe starts with dictionary encoding after a direct
+  // encoded stripe.
+  bool retryDictionary_{false};
   bool firstStripe_{true};
   DataBuffer<size_t> strideOffsets_;
 };
@@ -1153,6 +1210,7 @@ uint64_t StringColumnWriter::writeDirect(
   lengths.reserve(ranges.size());
 
   uint64_t rawSize = 0;
+  const bool sample = perStripeEncoding_ && numSampledRows_ < numSampleRows_;
   auto processRow = [&](size_t pos) {
     auto sp = decodedVector.valueAt<StringView>(pos);
     auto size = sp.size();
@@ -1160,6 +1218,10 @@ uint64_t StringColumnWriter::writeDirect(
     statsBuilder.addValues(sp);
     rawSize += size;
     lengths.unsafeAppend(size);
+    if (sample && numSampledRows_ < numSampleRows_) {
+      sampleEncoder_.addKey(sp, 0);
+      ++numSampledRows_;
+    }
   };
 
   uint64_t nullCount = 0;
@@ -1604,6 +1666,12 @@ class StructColumnWriter : public BaseColumnWriter {
       const RowVector* rowSlice,
       const common::Ranges& ranges,
       uint64_t nullCount);
+
+  // Writes the top-level columns of the root in parallel on the encoding
+  // executor of the context. Returns the total raw size.
+  uint64_t writeChildrenInParallel(
+      const RowVector* rowSlice,
+      const common::Ranges& ranges);
 };
 
 uint64_t StructColumnWriter::writeChildrenAndStats(
@@ -1612,8 +1680,14 @@ uint64_t StructColumnWriter::writeChildrenAndStats(
     uint64_t nullCount) {
   uint64_t rawSize = 0;
   if (ranges.size() > 0) {
-    for (size_t i = 0; i < children_.size(); ++i) {
-      rawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
+    if (isRoot() && context_.encodingExecutor() != nullptr &&
+        children_.size() > 1 &&
+        !context_.getEncryptionHandler().isEncrypted()) {
+      rawSize = writeChildrenInParallel(rowSlice, ranges);
+    } else {
+      for (size_t i = 0; i < children_.size(); ++i) {
+        rawSize += children_.at(i)->write(rowSlice->childAt(i), ranges);
+      }
     }
   }
   if (nullCount) {
@@ -1625,6 +1699,49 @@ uint64_t StructColumnWriter::writeChildrenAndStats(
   return rawSize;
 }
 
+uint64_t StructColumnWriter::writeChildrenInParallel(
+    const RowVector* rowSlice,
+    const common::Ranges& ranges) {
+  auto* executor = context_.encodingExecutor();
+  std::vector<folly::Future<uint64_t>> futures;
+  std::vector<size_t> localChildren;
+  for (size_t i = 0; i < children_.size(); ++i) {
+    if (!children_[i]->supportsParallelWrite() || localChildren.empty()) {
+      // This thread writes the columns that can not run in parallel and one
+      // of the others.
+      localChildren.push_back(i);
+      continue;
+    }
+    futures.push_back(folly::via(executor, [this, rowSlice, &ranges, i]() {
+      return children_[i]->write(rowSlice->childAt(i), ranges);
+    }));
+  }
+
+  uint64_t rawSize = 0;
+  std::exception_ptr error;
+  try {
+    for (auto i : localChildren) {
+      rawSize += children_[i]->write(rowSlice->childAt(i), ranges);
+    }
+  } catch (...) {
+    error = std::current_exception();
+  }
+  // All tasks must finish before returning because they reference the input.
+  for (auto& result : folly::collectAll(std::move(futures)).get()) {
+    if (result.hasException()) {
+      if (!error) {
+        error = result.exception().to_exception_ptr();
+      }
+    } else {
+      rawSize += result.value();
+    }
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  return rawSize;
+}
+
 uint64_t StructColumnWriter::write(
     const VectorPtr& slice,
     const common::Ranges& ranges) {
@@ -54,6 +54,12 @@ class ColumnWriter {
 
   virtual bool tryAbandonDictionaries(bool force) = 0;
 
+  /// Returns true if write() only changes state owned by this writer, so that
+  /// it may run in parallel with the writers of other top-level columns.
+  virtual bool supportsParallelWrite() const {
+    return true;
+  }
+
  protected:
   ColumnWriter(
       WriterContext& context,
@@ -234,6 +240,14 @@ class BaseColumnWriter : public ColumnWriter {
     suppressStream(kind, sequence_);
   }
 
+  // Removes the stream of 'kind', whose writer must have been destroyed.
+  void removeStream(StreamKind kind) {
+    const DwrfStreamIdentifier stream{id_, sequence_, type_.column(), kind};
+    context_.removeStreams([&](const DwrfStreamIdentifier& identifier) {
+      return identifier == stream;
+    });
+  }
+
   template <typename T>
   T getConfig(const Config::Entry<T>& config) const {
     return context_.getConfig(config);
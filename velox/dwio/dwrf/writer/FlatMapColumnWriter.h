@@ -270,6 +270,12 @@ class FlatMapColumnWriter : public BaseColumnWriter {
   uint64_t writeFileStats(std::function<proto::ColumnStatistics&(uint32_t)>
                               statsFactory) const override;
 
+  // Value writers and their streams are created in the writer context when
+  // new keys are seen.
+  bool supportsParallelWrite() const override {
+    return false;
+  }
+
  private:
   using KeyType = typename TypeTraits<K>::NativeType;
 
@@ -47,6 +47,10 @@ struct WriterOptions {
       WriterContext& context,
       const velox::dwio::common::TypeWithId& type)>
       columnWriterFactory;
+  /// Optional executor on which the top-level columns of each written batch
+  /// are encoded and compressed in parallel. write() waits for the columns to
+  /// finish, so this should not be the executor that runs the caller.
+  std::shared_ptr<folly::Executor> encodingExecutor;
 };
 
 class Writer : public dwio::common::Writer {
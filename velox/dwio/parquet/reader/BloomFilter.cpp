@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/BloomFilter.h"
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+#include <thrift/transport/TBufferTransports.h> //@manual
+#include "velox/common/base/BitUtil.h"
+#include "velox/dwio/common/StreamUtil.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+#define XXH_INLINE_ALL
+#include <xxhash.h>
+
+namespace facebook::velox::parquet {
+
+namespace {
+// Odd constants that select the bit of each word of a block.
+constexpr uint32_t kSalt[8] = {
+    0x47b6137bU,
+    0x44974d91U,
+    0x8824ad5bU,
+    0xa2b7289dU,
+    0x705495c7U,
+    0x2df1424bU,
+    0x9efc4947U,
+    0x5c6bfb31U};
+
+inline uint32_t bitOfWord(uint32_t key, int32_t word) {
+  return 1U << ((key * kSalt[word]) >> 27);
+}
+} // namespace
+
+BloomFilter::BloomFilter(int32_t numBytes) {
+  VELOX_CHECK(
+      numBytes > 0 && numBytes % kBytesPerBlock == 0,
+      "Invalid Bloom filter size {}",
+      numBytes);
+  bitset_.resize(numBytes / sizeof(uint32_t));
+}
+
+// static
+std::unique_ptr<BloomFilter> BloomFilter::read(
+    dwio::common::BufferedInput& input,
+    uint64_t offset) {
+  const uint64_t fileSize = input.getReadFile()->size();
+  VELOX_CHECK_LT(offset, fileSize, "Bloom filter is past the end of the file");
+  PageIndexBuffer buffer;
+  buffer.read(
+      input, {offset, std::min<uint64_t>(kMaxHeaderSize, fileSize - offset)});
+
+  thrift::BloomFilterHeader header;
+  auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+      buffer.data.data(), buffer.data.size());
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>
+      protocol(transport);
+  const uint64_t headerSize = header.read(&protocol);
+  if (!header.algorithm.__isset.BLOCK || !header.hash.__isset.XXHASH ||
+      !header.compression.__isset.UNCOMPRESSED) {
+    return nullptr;
+  }
+  VELOX_CHECK_LE(
+      header.numBytes, kMaxBytes, "Bloom filter of {} bytes", header.numBytes);
+  VELOX_CHECK_LE(
+      offset + headerSize + header.numBytes,
+      fileSize,
+      "Bloom filter is past the end of the file");
+
+  auto bloomFilter = std::make_unique<BloomFilter>(header.numBytes);
+  auto* bitset = reinterpret_cast<char*>(bloomFilter->bitset_.data());
+  const uint64_t numBuffered =
+      std::min<uint64_t>(header.numBytes, buffer.data.size() - headerSize);
+  memcpy(bitset, buffer.data.data() + headerSize, numBuffered);
+  if (numBuffered < header.numBytes) {
+    const uint64_t numLeft = header.numBytes - numBuffered;
+    auto stream = input.read(
+        offset + headerSize + numBuffered,
+        numLeft,
+        dwio::common::LogType::STRIPE_INDEX);
+    const char* bufferStart = nullptr;
+    const char* bufferEnd = nullptr;
+    dwio::common::readBytes(
+        numLeft, stream.get(), bitset + numBuffered, bufferStart, bufferEnd);
+  }
+  return bloomFilter;
+}
+
+// static
+int32_t BloomFilter::optimalNumBytes(uint64_t numDistinct, double fpp) {
+  VELOX_CHECK(fpp > 0 && fpp < 1, "Invalid Bloom filter fpp {}", fpp);
+  // Each value sets one bit in each of the 8 words of a block.
+  const double numBits =
+      -8.0 * numDistinct / std::log(1 - std::pow(fpp, 1.0 / 8));
+  const uint64_t numBytes = std::clamp<double>(
+      std::ceil(numBits / 8), kBytesPerBlock, kMaxBytes);
+  return std::min<uint64_t>(bits::nextPowerOfTwo(numBytes), kMaxBytes);
+}
+
+std::string BloomFilter::serialize() const {
+  thrift::BloomFilterHeader header;
+  header.__set_numBytes(bitset_.size() * sizeof(uint32_t));
+  header.algorithm.__set_BLOCK(thrift::SplitBlockAlgorithm());
+  header.hash.__set_XXHASH(thrift::XxHash());
+  header.compression.__set_UNCOMPRESSED(thrift::Uncompressed());
+  auto buffer = std::make_shared<apache::thrift::transport::TMemoryBuffer>();
+  apache::thrift::protocol::TCompactProtocol protocol(buffer);
+  header.write(&protocol);
+  std::string data = buffer->getBufferAsString();
+  data.append(
+      reinterpret_cast<const char*>(bitset_.data()), header.numBytes);
+  return data;
+}
+
+void BloomFilter::insertHash(uint64_t hash) {
+  const uint64_t numBlocks = bitset_.size() / kWordsPerBlock;
+  auto* block = &bitset_[((hash >> 32) * numBlocks >> 32) * kWordsPerBlock];
+  const uint32_t key = hash;
+  for (auto i = 0; i < kWordsPerBlock; ++i) {
+    block[i] |= bitOfWord(key, i);
+  }
+}
+
+bool BloomFilter::findHash(uint64_t hash) const {
+  const uint64_t numBlocks = bitset_.size() / kWordsPerBlock;
+  const auto* block =
+      &bitset_[((hash >> 32) * numBlocks >> 32) * kWordsPerBlock];
+  const uint32_t key = hash;
+  for (auto i = 0; i < kWordsPerBlock; ++i) {
+    if (!(block[i] & bitOfWord(key, i))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// static
+uint64_t BloomFilter::hash(int32_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// static
+uint64_t BloomFilter::hash(int64_t value) {
+  return XXH64(&value, sizeof(value), 0);
+}
+
+// static
+uint64_t BloomFilter::hash(std::string_view value) {
+  return XXH64(value.data(), value.size(), 0);
+}
+
+bool BloomFilter::mayContain(int64_t value, thrift::Type::type parquetType)
+    const {
+  if (parquetType == thrift::Type::INT32) {
+    if (value < std::numeric_limits<int32_t>::min() ||
+        value > std::numeric_limits<int32_t>::max()) {
+      return false;
+    }
+    return findHash(hash(static_cast<int32_t>(value)));
+  }
+  return findHash(hash(value));
+}
+
+bool BloomFilter::mayMatch(
+    const common::Filter& filter,
+    thrift::Type::type parquetType) const {
+  const bool isInteger =
+      parquetType == thrift::Type::INT32 || parquetType == thrift::Type::INT64;
+  const bool isString = parquetType == thrift::Type::BYTE_ARRAY;
+  switch (filter.kind()) {
+    case common::FilterKind::kBigintRange: {
+      auto& range = static_cast<const common::BigintRange&>(filter);
+      if (!isInteger || !range.isSingleValue()) {
+        return true;
+      }
+      return mayContain(range.lower(), parquetType);
+    }
+    case common::FilterKind::kBigintValuesUsingHashTable: {
+      if (!isInteger) {
+        return true;
+      }
+      auto& values =
+          static_cast<const common::BigintValuesUsingHashTable&>(filter)
+              .values();
+      return std::any_of(values.begin(), values.end(), [&](int64_t value) {
+        return mayContain(value, parquetType);
+      });
+    }
+    case common::FilterKind::kBigintValuesUsingBitmask: {
+      if (!isInteger) {
+        return true;
+      }
+      auto values =
+          static_cast<const common::BigintValuesUsingBitmask&>(filter)
+              .values();
+      return std::any_of(values.begin(), values.end(), [&](int64_t value) {
+        return mayContain(value, parquetType);
+      });
+    }
+    case common::FilterKind::kBytesRange: {
+      auto& range = static_cast<const common::BytesRange&>(filter);
+      if (!isString || !range.isSingleValue()) {
+        return true;
+      }
+      return findHash(hash(std::string_view(range.lower())));
+    }
+    case common::FilterKind::kBytesValues: {
+      if (!isString) {
+        return true;
+      }
+      auto& values = static_cast<const common::BytesValues&>(filter).values();
+      return std::any_of(
+          values.begin(), values.end(), [&](const std::string& value) {
+            return findHash(hash(std::string_view(value)));
+          });
+    }
+    default:
+      return true;
+  }
+}
+
+} // namespace facebook::velox::parquet
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/type/Filter.h"
+
+namespace facebook::velox::parquet {
+
+/// Split block Bloom filter of a ColumnChunk as specified by the Parquet
+/// format. The bitset is a sequence of 32 byte blocks of eight 32 bit words.
+/// A value is hashed with XXH64 over its plain encoding. The upper 32 bits of
+/// the hash select the block and the lower 32 bits select one bit in each word
+/// of the block.
+class BloomFilter {
+ public:
+  static constexpr int32_t kBytesPerBlock = 32;
+
+  /// Upper bound for the size of a serialized BloomFilterHeader. The header
+  /// is read together with this many bytes of the bitset.
+  static constexpr int32_t kMaxHeaderSize = 256;
+
+  /// Largest bitset accepted from a file.
+  static constexpr int32_t kMaxBytes = 128 << 20;
+
+  /// Makes an empty filter of 'numBytes', which must be a positive multiple
+  /// of kBytesPerBlock.
+  explicit BloomFilter(int32_t numBytes);
+
+  /// Reads the BloomFilterHeader and the bitset at 'offset' in the file of
+  /// 'input'. Returns nullptr if the filter uses an algorithm, hash or
+  /// compression that is not supported.
+  static std::unique_ptr<BloomFilter> read(
+      dwio::common::BufferedInput& input,
+      uint64_t offset);
+
+  /// Returns the size in bytes of a filter of 'numDistinct' values with a
+  /// false positive probability of at most about 'fpp'. The size is a power of
+  /// two between kBytesPerBlock and kMaxBytes.
+  static int32_t optimalNumBytes(uint64_t numDistinct, double fpp);
+
+  /// Returns the BloomFilterHeader followed by the bitset in the layout read
+  /// by read().
+  std::string serialize() const;
+
+  void insertHash(uint64_t hash);
+
+  bool findHash(uint64_t hash) const;
+
+  /// Hashes of the plain encodings of values of the physical types.
+  static uint64_t hash(int32_t value);
+  static uint64_t hash(int64_t value);
+  static uint64_t hash(std::string_view value);
+
+  /// Returns false if no non-null value that passes 'filter' is in 'this'.
+  /// Only equality and IN filters on integers and strings can be tested, all
+  /// other filters return true. 'parquetType' is the physical type of the
+  /// column, which decides how the values of 'filter' are encoded for
+  /// hashing.
+  bool mayMatch(const common::Filter& filter, thrift::Type::type parquetType)
+      const;
+
+  /// The bitset in the layout of the file.
+  const std::vector<uint32_t>& bitset() const {
+    return bitset_;
+  }
+
+ private:
+  static constexpr int32_t kWordsPerBlock = 8;
+
+  bool mayContain(int64_t value, thrift::Type::type parquetType) const;
+
+  std::vector<uint32_t> bitset_;
+};
+
+} // namespace facebook::velox::parquet
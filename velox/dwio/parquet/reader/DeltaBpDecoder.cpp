@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/dwio/common/BitPackDecoder.h"
+
+namespace facebook::velox::parquet {
+
+namespace {
+// Unpacks 'numValues' little endian bit fields of 'bitWidth' bits, which is
+// more than what unpack<uint32_t> handles.
+void unpackWide(
+    const uint8_t* input,
+    uint64_t numValues,
+    uint8_t bitWidth,
+    uint64_t* result) {
+  uint64_t bitOffset = 0;
+  for (uint64_t i = 0; i < numValues; ++i) {
+    uint64_t value = 0;
+    int32_t numBits = 0;
+    while (numBits < bitWidth) {
+      const int32_t bitInByte = bitOffset & 7;
+      const int32_t numTaken = std::min(8 - bitInByte, bitWidth - numBits);
+      const uint64_t bits =
+          (input[bitOffset >> 3] >> bitInByte) & ((1U << numTaken) - 1);
+      value |= bits << numBits;
+      numBits += numTaken;
+      bitOffset += numTaken;
+    }
+    result[i] = value;
+  }
+}
+} // namespace
+
+DeltaBpDecoder::DeltaBpDecoder(const char* start, const char* end)
+    : bufferStart_(start), bufferEnd_(end) {
+  valuesPerBlock_ = readVarint();
+  miniBlocksPerBlock_ = readVarint();
+  numValues_ = readVarint();
+  lastValue_ = readZigZag();
+  VELOX_CHECK(
+      valuesPerBlock_ > 0 && valuesPerBlock_ % 128 == 0 &&
+          valuesPerBlock_ <= (1 << 20),
+      "Invalid DELTA_BINARY_PACKED block size {}",
+      valuesPerBlock_);
+  VELOX_CHECK(
+      miniBlocksPerBlock_ > 0 && valuesPerBlock_ % miniBlocksPerBlock_ == 0,
+      "Invalid DELTA_BINARY_PACKED miniblock count {}",
+      miniBlocksPerBlock_);
+  valuesPerMiniBlock_ = valuesPerBlock_ / miniBlocksPerBlock_;
+  VELOX_CHECK_EQ(
+      valuesPerMiniBlock_ % 32,
+      0,
+      "Invalid DELTA_BINARY_PACKED miniblock size {}",
+      valuesPerMiniBlock_);
+  VELOX_CHECK_GE(numValues_, 0);
+  valuesLeft_ = numValues_;
+  bitWidths_.resize(miniBlocksPerBlock_);
+  nextMiniBlock_ = miniBlocksPerBlock_;
+  deltas_.resize(valuesPerMiniBlock_);
+  nextDelta_ = valuesPerMiniBlock_;
+}
+
+uint64_t DeltaBpDecoder::readVarint() {
+  uint64_t value = 0;
+  for (int32_t shift = 0; shift < 64; shift += 7) {
+    VELOX_CHECK_LT(
+        bufferStart_, bufferEnd_, "DELTA_BINARY_PACKED data is truncated");
+    const uint8_t byte = *bufferStart_++;
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if (!(byte & 0x80)) {
+      return value;
+    }
+  }
+  VELOX_FAIL("Invalid varint in DELTA_BINARY_PACKED data");
+}
+
+int64_t DeltaBpDecoder::readZigZag() {
+  const uint64_t value = readVarint();
+  return static_cast<int64_t>((value >> 1) ^ -(value & 1));
+}
+
+void DeltaBpDecoder::readBlockHeader() {
+  minDelta_ = readZigZag();
+  VELOX_CHECK_LE(
+      miniBlocksPerBlock_,
+      bufferEnd_ - bufferStart_,
+      "DELTA_BINARY_PACKED data is truncated");
+  memcpy(bitWidths_.data(), bufferStart_, miniBlocksPerBlock_);
+  bufferStart_ += miniBlocksPerBlock_;
+  nextMiniBlock_ = 0;
+}
+
+void DeltaBpDecoder::readMiniBlock() {
+  if (nextMiniBlock_ == miniBlocksPerBlock_) {
+    readBlockHeader();
+  }
+  const uint8_t bitWidth = bitWidths_[nextMiniBlock_++];
+  VELOX_CHECK_LE(bitWidth, 64, "Invalid DELTA_BINARY_PACKED bit width");
+  nextDelta_ = 0;
+  if (bitWidth == 0) {
+    std::fill(deltas_.begin(), deltas_.end(), 0);
+    return;
+  }
+  const uint64_t numBytes = bitWidth * valuesPerMiniBlock_ / 8;
+  auto* input = reinterpret_cast<const uint8_t*>(bufferStart_);
+  const uint64_t numAvailable = bufferEnd_ - bufferStart_;
+  if (numBytes > numAvailable) {
+    // The last miniblock may be written without padding to its full size.
+    padded_.assign(numBytes, 0);
+    memcpy(padded_.data(), bufferStart_, numAvailable);
+    input = padded_.data();
+    bufferStart_ = bufferEnd_;
+  } else {
+    bufferStart_ += numBytes;
+  }
+  if (bitWidth > 32) {
+    unpackWide(input, valuesPerMiniBlock_, bitWidth, deltas_.data());
+    return;
+  }
+  unpacked_.resize(valuesPerMiniBlock_);
+  auto* unpacked = unpacked_.data();
+  dwio::common::unpack<uint32_t>(
+      input, numBytes, valuesPerMiniBlock_, bitWidth, unpacked);
+  std::copy(unpacked_.begin(), unpacked_.end(), deltas_.begin());
+}
+
+template <typename T>
+void DeltaBpDecoder::readValues(int64_t count, T* values) {
+  VELOX_CHECK_LE(
+      count, valuesLeft_, "Reading past the end of DELTA_BINARY_PACKED data");
+  valuesLeft_ -= count;
+  if (count > 0 && !firstValueRead_) {
+    *values++ = static_cast<T>(lastValue_);
+    firstValueRead_ = true;
+    --count;
+  }
+  while (count > 0) {
+    if (nextDelta_ == valuesPerMiniBlock_) {
+      readMiniBlock();
+    }
+    const auto numDeltas =
+        std::min<uint64_t>(count, valuesPerMiniBlock_ - nextDelta_);
+    const auto* deltas = deltas_.data() + nextDelta_;
+    auto value = lastValue_;
+    for (uint64_t i = 0; i < numDeltas; ++i) {
+      value += minDelta_ + deltas[i];
+      values[i] = static_cast<T>(value);
+    }
+    lastValue_ = value;
+    nextDelta_ += numDeltas;
+    values += numDeltas;
+    count -= numDeltas;
+  }
+}
+
+template void DeltaBpDecoder::readValues(int64_t count, int32_t* values);
+template void DeltaBpDecoder::readValues(int64_t count, int64_t* values);
+
+} // namespace facebook::velox::parquet
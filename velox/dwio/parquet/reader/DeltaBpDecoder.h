@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace facebook::velox::parquet {
+
+/// Decoder for the DELTA_BINARY_PACKED encoding of Parquet. The encoded data
+/// starts with a header of ULEB128 encoded block size, number of miniblocks
+/// per block, total number of values and the zigzag encoded first value. Each
+/// block follows with the zigzag encoded minimum delta, one byte of bit width
+/// for each miniblock and the bit packed deltas of the miniblocks. The
+/// arithmetic wraps around, so that decoding int32 values with 64 bit
+/// arithmetic and truncating gives the values written with 32 bit arithmetic.
+class DeltaBpDecoder {
+ public:
+  DeltaBpDecoder(const char* start, const char* end);
+
+  /// Number of values in the encoded data.
+  int64_t numValues() const {
+    return numValues_;
+  }
+
+  /// Decodes the next 'count' values into 'values'. T is int32_t or int64_t.
+  template <typename T>
+  void readValues(int64_t count, T* values);
+
+  /// Returns the first byte after the values decoded so far. After decoding
+  /// all values, this is the end of the encoded data.
+  const char* bufferStart() const {
+    return bufferStart_;
+  }
+
+ private:
+  uint64_t readVarint();
+
+  int64_t readZigZag();
+
+  // Reads the minimum delta and the bit widths of the next block.
+  void readBlockHeader();
+
+  // Unpacks the deltas of the next miniblock into 'deltas_'.
+  void readMiniBlock();
+
+  const char* bufferStart_;
+  const char* const bufferEnd_;
+
+  uint64_t valuesPerBlock_;
+  uint64_t miniBlocksPerBlock_;
+  uint64_t valuesPerMiniBlock_;
+  int64_t numValues_;
+
+  // Number of values left to decode, including the first value.
+  int64_t valuesLeft_;
+
+  // The last decoded value.
+  uint64_t lastValue_;
+
+  // True if the first value, which is in the header, is decoded.
+  bool firstValueRead_{false};
+
+  // Minimum delta of the current block.
+  uint64_t minDelta_{0};
+
+  // Bit widths of the miniblocks of the current block.
+  std::vector<uint8_t> bitWidths_;
+
+  // Index of the next miniblock in the current block. Equal to
+  // 'miniBlocksPerBlock_' when the block is consumed.
+  uint64_t nextMiniBlock_;
+
+  // Deltas of the current miniblock, before adding 'minDelta_'.
+  std::vector<uint64_t> deltas_;
+
+  // Index of the next delta in 'deltas_' to use.
+  uint64_t nextDelta_;
+
+  // Scratch for unpacking miniblocks of at most 32 bits.
+  std::vector<uint32_t> unpacked_;
+
+  // Zero padded copy of a miniblock truncated at the end of the data.
+  std::vector<uint8_t> padded_;
+};
+
+} // namespace facebook::velox::parquet
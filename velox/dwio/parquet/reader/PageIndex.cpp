@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/PageIndex.h"
+#include "velox/dwio/common/StreamUtil.h"
+
+namespace facebook::velox::parquet {
+
+RowRanges intersectRowRanges(const RowRanges& left, const RowRanges& right) {
+  RowRanges result;
+  auto leftIt = left.begin();
+  auto rightIt = right.begin();
+  while (leftIt != left.end() && rightIt != right.end()) {
+    auto begin = std::max(leftIt->begin, rightIt->begin);
+    auto end = std::min(leftIt->end, rightIt->end);
+    if (begin < end) {
+      result.push_back({begin, end});
+    }
+    if (leftIt->end < rightIt->end) {
+      ++leftIt;
+    } else {
+      ++rightIt;
+    }
+  }
+  return result;
+}
+
+void PageIndexBuffer::read(
+    dwio::common::BufferedInput& input,
+    const common::Region& region) {
+  offset = region.offset;
+  data.resize(region.length);
+  auto stream = input.read(
+      region.offset, region.length, dwio::common::LogType::STRIPE_INDEX);
+  const char* bufferStart = nullptr;
+  const char* bufferEnd = nullptr;
+  dwio::common::readBytes(
+      region.length, stream.get(), data.data(), bufferStart, bufferEnd);
+}
+
+std::string_view PageIndexBuffer::get(const common::Region& region) const {
+  VELOX_CHECK(
+      region.offset >= offset &&
+          region.offset + region.length <= offset + data.size(),
+      "Page index region {}:{} is not in the buffer at {}:{}",
+      region.offset,
+      region.length,
+      offset,
+      data.size());
+  return std::string_view(data.data() + region.offset - offset, region.length);
+}
+
+PageRangesInputStream::PageRangesInputStream(std::vector<Range> ranges)
+    : ranges_(std::move(ranges)) {
+  for (auto i = 1; i < ranges_.size(); ++i) {
+    VELOX_CHECK_GE(
+        ranges_[i].offset, ranges_[i - 1].offset + ranges_[i - 1].length);
+  }
+}
+
+bool PageRangesInputStream::Next(const void** data, int32_t* size) {
+  while (current_ < ranges_.size()) {
+    auto& range = ranges_[current_];
+    VELOX_CHECK_GE(
+        position_,
+        range.offset,
+        "Reading bytes of a ColumnChunk that are not loaded");
+    if (position_ < range.offset + range.length &&
+        range.stream->Next(data, size)) {
+      position_ += *size;
+      return true;
+    }
+    ++current_;
+  }
+  return false;
+}
+
+void PageRangesInputStream::BackUp(int32_t count) {
+  VELOX_CHECK_LT(current_, ranges_.size());
+  ranges_[current_].stream->BackUp(count);
+  position_ -= count;
+}
+
+bool PageRangesInputStream::Skip(int32_t count) {
+  auto target = position_ + count;
+  for (; current_ < ranges_.size(); ++current_) {
+    auto& range = ranges_[current_];
+    if (target < range.offset + range.length) {
+      // 'target' is in 'range' or in the gap before it.
+      if (target > range.offset) {
+        range.stream->Skip(target - std::max(position_, range.offset));
+      }
+      position_ = target;
+      return true;
+    }
+  }
+  position_ = target;
+  return !ranges_.empty() &&
+      target == ranges_.back().offset + ranges_.back().length;
+}
+
+google::protobuf::int64 PageRangesInputStream::ByteCount() const {
+  return position_;
+}
+
+void PageRangesInputStream::seekToPosition(
+    dwio::common::PositionProvider& /*position*/) {
+  VELOX_UNSUPPORTED("PageRangesInputStream does not support seeking");
+}
+
+std::string PageRangesInputStream::getName() const {
+  return fmt::format(
+      "PageRangesInputStream {} ranges, position {}",
+      ranges_.size(),
+      position_);
+}
+
+size_t PageRangesInputStream::positionSize() {
+  // Only the offset from the start of the ColumnChunk.
+  return 1;
+}
+
+} // namespace facebook::velox::parquet
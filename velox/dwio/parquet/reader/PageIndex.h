@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+#include "velox/common/file/Region.h"
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/SeekableInputStream.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/dwio/parquet/thrift/ThriftTransport.h"
+
+namespace facebook::velox::parquet {
+
+/// A range of top level rows of a row group, from 'begin' to 'end',
+/// exclusive.
+struct RowRange {
+  int64_t begin;
+  int64_t end;
+
+  bool operator==(const RowRange& other) const {
+    return begin == other.begin && end == other.end;
+  }
+};
+
+/// Sorted, non-overlapping and non-adjacent ranges of rows.
+using RowRanges = std::vector<RowRange>;
+
+/// Returns the rows that are in both 'left' and 'right'.
+RowRanges intersectRowRanges(const RowRanges& left, const RowRanges& right);
+
+/// The page index of a ColumnChunk. The OffsetIndex has the location and the
+/// first row of each data page. The optional ColumnIndex has the min and max
+/// values and the null counts of each data page.
+struct PageIndex {
+  thrift::OffsetIndex offsetIndex;
+  std::optional<thrift::ColumnIndex> columnIndex;
+};
+
+/// Bytes of the file starting at 'offset'. The page indices of the columns of
+/// a row group are next to each other, so that the OffsetIndexes and the
+/// ColumnIndexes of a row group are each read with one IO.
+struct PageIndexBuffer {
+  uint64_t offset{0};
+  std::vector<char> data;
+
+  /// Reads the bytes of 'region' from 'input' into 'this'.
+  void read(dwio::common::BufferedInput& input, const common::Region& region);
+
+  /// Returns the bytes of 'region', which must be inside 'this'.
+  std::string_view get(const common::Region& region) const;
+};
+
+/// Deserializes 'value' from Thrift compact protocol encoded 'data'.
+template <typename T>
+void readThrift(std::string_view data, T& value) {
+  auto transport = std::make_shared<thrift::ThriftBufferedTransport>(
+      data.data(), data.size());
+  apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>
+      protocol(transport);
+  value.read(&protocol);
+}
+
+/// Presents separately loaded ranges of a ColumnChunk as one stream over the
+/// whole chunk. The bytes between the ranges are not loaded and can only be
+/// skipped over. Used for reading the data pages left after filtering with
+/// the page index.
+class PageRangesInputStream : public dwio::common::SeekableInputStream {
+ public:
+  struct Range {
+    // Offset of the range from the start of the ColumnChunk.
+    int64_t offset;
+    int64_t length;
+    std::unique_ptr<dwio::common::SeekableInputStream> stream;
+  };
+
+  explicit PageRangesInputStream(std::vector<Range> ranges);
+
+  bool Next(const void** data, int32_t* size) override;
+
+  void BackUp(int32_t count) override;
+
+  bool Skip(int32_t count) override;
+
+  google::protobuf::int64 ByteCount() const override;
+
+  void seekToPosition(dwio::common::PositionProvider& position) override;
+
+  std::string getName() const override;
+
+  size_t positionSize() override;
+
+ private:
+  std::vector<Range> ranges_;
+
+  // Index of the range in 'ranges_' being read.
+  int32_t current_{0};
+
+  // Offset of the next byte to read from the start of the ColumnChunk.
+  int64_t position_{0};
+};
+
+} // namespace facebook::velox::parquet
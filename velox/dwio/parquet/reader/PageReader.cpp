@@ -18,6 +18,7 @@
 #include "velox/common/compression/LzoDecompressor.h"
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/common/ColumnVisitors.h"
+#include "velox/dwio/parquet/reader/DeltaBpDecoder.h"
 #include "velox/dwio/parquet/reader/NestedStructureDecoder.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
 #include "velox/vector/FlatVector.h"
@@ -39,6 +40,9 @@ void PageReader::seekToPage(int64_t row) {
   // 'rowOfPage_' is the row number of the first row of the next page.
   rowOfPage_ += numRowsInPage_;
   for (;;) {
+    if (row != kRepDefOnly) {
+      skipToPageOfRow(row);
+    }
     auto dataStart = pageStart_;
     if (chunkSize_ <= pageStart_) {
       // This may happen if seeking to exactly end of row group.
@@ -77,6 +81,42 @@ void PageReader::seekToPage(int64_t row) {
   }
 }
 
+void PageReader::setPageLocations(
+    std::vector<thrift::PageLocation> pageLocations,
+    int64_t chunkOffset) {
+  VELOX_CHECK_EQ(maxRepeat_, 0);
+  pageLocations_ = std::move(pageLocations);
+  chunkOffset_ = chunkOffset;
+}
+
+void PageReader::skipToPageOfRow(int64_t row) {
+  // The dictionary page, if any, is before the first data page and must be
+  // read first.
+  if (pageLocations_.empty() ||
+      static_cast<int64_t>(pageStart_) <
+          pageLocations_[0].offset - chunkOffset_) {
+    return;
+  }
+  auto it = std::upper_bound(
+      pageLocations_.begin(),
+      pageLocations_.end(),
+      row,
+      [](int64_t target, const thrift::PageLocation& location) {
+        return target < location.first_row_index;
+      });
+  VELOX_CHECK(it != pageLocations_.begin());
+  --it;
+  uint64_t pageOffset = it->offset - chunkOffset_;
+  if (pageOffset <= pageStart_) {
+    return;
+  }
+  dwio::common::skipBytes(
+      pageOffset - pageStart_, inputStream_.get(), bufferStart_, bufferEnd_);
+  pageStart_ = pageOffset;
+  rowOfPage_ = it->first_row_index;
+  numRowsInPage_ = 0;
+}
+
 PageHeader PageReader::readPageHeader() {
   if (bufferEnd_ == bufferStart_) {
     const void* buffer;
@@ -721,38 +761,218 @@ void PageReader::makeDecoder() {
     case Encoding::PLAIN_DICTIONARY:
       dictionaryIdDecoder_ = std::make_unique<RleBpDataDecoder>(
           pageData_ + 1, pageData_ + encodedDataSize_, pageData_[0]);
-      break;
+      return;
     case Encoding::PLAIN:
-      switch (parquetType) {
-        case thrift::Type::BOOLEAN:
-          booleanDecoder_ = std::make_unique<BooleanDecoder>(
-              pageData_, pageData_ + encodedDataSize_);
-          break;
-        case thrift::Type::BYTE_ARRAY:
-          stringDecoder_ = std::make_unique<StringDecoder>(
-              pageData_, pageData_ + encodedDataSize_);
-          break;
-        case thrift::Type::FIXED_LEN_BYTE_ARRAY:
-          directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
-              std::make_unique<dwio::common::SeekableArrayInputStream>(
-                  pageData_, encodedDataSize_),
-              false,
-              type_->typeLength_,
-              true);
-          break;
-        default: {
-          directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
-              std::make_unique<dwio::common::SeekableArrayInputStream>(
-                  pageData_, encodedDataSize_),
-              false,
-              parquetTypeBytes(type_->parquetType_.value()));
-        }
-      }
       break;
+    // The encodings below are decoded into PLAIN, so that the PLAIN decoders
+    // apply the filters and extract the values.
     case Encoding::DELTA_BINARY_PACKED:
+      decodeDeltaBinaryPacked();
+      break;
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+    case Encoding::DELTA_BYTE_ARRAY:
+      decodeDeltaByteArray();
+      break;
+    case Encoding::BYTE_STREAM_SPLIT:
+      decodeByteStreamSplit();
+      break;
     default:
       VELOX_UNSUPPORTED("Encoding not supported yet: {}", encoding_);
   }
+  switch (parquetType) {
+    case thrift::Type::BOOLEAN:
+      booleanDecoder_ = std::make_unique<BooleanDecoder>(
+          pageData_, pageData_ + encodedDataSize_);
+      break;
+    case thrift::Type::BYTE_ARRAY:
+      stringDecoder_ = std::make_unique<StringDecoder>(
+          pageData_, pageData_ + encodedDataSize_);
+      break;
+    case thrift::Type::FIXED_LEN_BYTE_ARRAY:
+      directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+          std::make_unique<dwio::common::SeekableArrayInputStream>(
+              pageData_, encodedDataSize_),
+          false,
+          type_->typeLength_,
+          true);
+      break;
+    default: {
+      directDecoder_ = std::make_unique<dwio::common::DirectDecoder<true>>(
+          std::make_unique<dwio::common::SeekableArrayInputStream>(
+              pageData_, encodedDataSize_),
+          false,
+          parquetTypeBytes(type_->parquetType_.value()));
+    }
+  }
+}
+
+void PageReader::decodeDeltaBinaryPacked() {
+  auto parquetType = type_->parquetType_.value();
+  VELOX_CHECK(
+      parquetType == thrift::Type::INT32 || parquetType == thrift::Type::INT64,
+      "DELTA_BINARY_PACKED is only valid for INT32 and INT64, not {}",
+      parquetType);
+  DeltaBpDecoder decoder(pageData_, pageData_ + encodedDataSize_);
+  const auto numValues = decoder.numValues();
+  VELOX_CHECK_LE(numValues, numRepDefsInPage_, "Too many values in page");
+  const auto numBytes = numValues * parquetTypeBytes(parquetType);
+  dwio::common::ensureCapacity<char>(decodedPage_, numBytes, &pool_);
+  if (parquetType == thrift::Type::INT32) {
+    decoder.readValues(numValues, decodedPage_->asMutable<int32_t>());
+  } else {
+    decoder.readValues(numValues, decodedPage_->asMutable<int64_t>());
+  }
+  pageData_ = decodedPage_->as<char>();
+  encodedDataSize_ = numBytes;
+}
+
+void PageReader::decodeDeltaByteArray() {
+  auto parquetType = type_->parquetType_.value();
+  const bool isFixedLength = parquetType == thrift::Type::FIXED_LEN_BYTE_ARRAY;
+  VELOX_CHECK(
+      parquetType == thrift::Type::BYTE_ARRAY ||
+          (isFixedLength && encoding_ == Encoding::DELTA_BYTE_ARRAY),
+      "{} is not valid for {}",
+      encoding_,
+      parquetType);
+  const char* data = pageData_;
+  const char* end = pageData_ + encodedDataSize_;
+
+  // DELTA_BYTE_ARRAY has the lengths of the prefixes shared with the previous
+  // value and then the suffixes in DELTA_LENGTH_BYTE_ARRAY.
+  std::vector<int32_t> prefixLengths;
+  if (encoding_ == Encoding::DELTA_BYTE_ARRAY) {
+    DeltaBpDecoder prefixDecoder(data, end);
+    VELOX_CHECK_LE(
+        prefixDecoder.numValues(), numRepDefsInPage_, "Too many values");
+    prefixLengths.resize(prefixDecoder.numValues());
+    prefixDecoder.readValues(prefixLengths.size(), prefixLengths.data());
+    data = prefixDecoder.bufferStart();
+  }
+  DeltaBpDecoder lengthDecoder(data, end);
+  const auto numValues = lengthDecoder.numValues();
+  VELOX_CHECK_LE(numValues, numRepDefsInPage_, "Too many values in page");
+  if (encoding_ == Encoding::DELTA_BYTE_ARRAY) {
+    VELOX_CHECK_EQ(numValues, static_cast<int64_t>(prefixLengths.size()));
+  }
+  std::vector<int32_t> lengths(numValues);
+  lengthDecoder.readValues(numValues, lengths.data());
+  const char* suffixes = lengthDecoder.bufferStart();
+
+  // Values in PLAIN are preceded by their length unless fixed length.
+  const int32_t lengthSize = isFixedLength ? 0 : sizeof(int32_t);
+  uint64_t numBytes = 0;
+  uint64_t numSuffixBytes = 0;
+  int32_t previousLength = 0;
+  for (auto i = 0; i < numValues; ++i) {
+    const int32_t prefixLength = prefixLengths.empty() ? 0 : prefixLengths[i];
+    VELOX_CHECK(
+        lengths[i] >= 0 && prefixLength >= 0 &&
+            prefixLength <= previousLength,
+        "Invalid {} lengths",
+        encoding_);
+    const int32_t length = prefixLength + lengths[i];
+    if (isFixedLength) {
+      VELOX_CHECK_EQ(length, type_->typeLength_);
+    }
+    numBytes += lengthSize + length;
+    numSuffixBytes += lengths[i];
+    previousLength = length;
+  }
+  VELOX_CHECK_LE(
+      numSuffixBytes,
+      static_cast<uint64_t>(end - suffixes),
+      "{} is truncated",
+      encoding_);
+  VELOX_CHECK_LE(
+      numBytes, static_cast<uint64_t>(std::numeric_limits<int32_t>::max()));
+
+  dwio::common::ensureCapacity<char>(decodedPage_, numBytes, &pool_);
+  char* output = decodedPage_->asMutable<char>();
+  const char* previous = nullptr;
+  for (auto i = 0; i < numValues; ++i) {
+    const int32_t prefixLength = prefixLengths.empty() ? 0 : prefixLengths[i];
+    const int32_t length = prefixLength + lengths[i];
+    if (!isFixedLength) {
+      memcpy(output, &length, sizeof(int32_t));
+      output += sizeof(int32_t);
+    }
+    if (prefixLength) {
+      memcpy(output, previous, prefixLength);
+    }
+    memcpy(output + prefixLength, suffixes, lengths[i]);
+    suffixes += lengths[i];
+    previous = output;
+    output += length;
+  }
+  pageData_ = decodedPage_->as<char>();
+  encodedDataSize_ = numBytes;
+}
+
+namespace {
+// Interleaves 'kWidth' streams of 'numValues' bytes each, starting at
+// 'input', into 'numValues' values of 'kWidth' bytes. The stream 'i' has the
+// byte 'i' of each value. A fixed width lets the compiler unroll and
+// vectorize the loops.
+template <int32_t kWidth>
+void mergeByteStreams(const char* input, int64_t numValues, char* output) {
+  constexpr int64_t kBatch = 64;
+  int64_t i = 0;
+  for (; i + kBatch <= numValues; i += kBatch) {
+    for (auto stream = 0; stream < kWidth; ++stream) {
+      const char* bytes = input + stream * numValues + i;
+      for (auto j = 0; j < kBatch; ++j) {
+        output[(i + j) * kWidth + stream] = bytes[j];
+      }
+    }
+  }
+  for (; i < numValues; ++i) {
+    for (auto stream = 0; stream < kWidth; ++stream) {
+      output[i * kWidth + stream] = input[stream * numValues + i];
+    }
+  }
+}
+
+void mergeByteStreams(
+    const char* input,
+    int64_t numValues,
+    int32_t width,
+    char* output) {
+  for (int64_t i = 0; i < numValues; ++i) {
+    for (auto stream = 0; stream < width; ++stream) {
+      output[i * width + stream] = input[stream * numValues + i];
+    }
+  }
+}
+} // namespace
+
+void PageReader::decodeByteStreamSplit() {
+  auto parquetType = type_->parquetType_.value();
+  VELOX_CHECK(
+      parquetType != thrift::Type::BOOLEAN &&
+          parquetType != thrift::Type::BYTE_ARRAY,
+      "BYTE_STREAM_SPLIT is not valid for {}",
+      parquetType);
+  const int32_t width = parquetType == thrift::Type::FIXED_LEN_BYTE_ARRAY
+      ? type_->typeLength_
+      : parquetTypeBytes(parquetType);
+  VELOX_CHECK_GT(width, 0);
+  VELOX_CHECK_EQ(
+      encodedDataSize_ % width, 0, "Invalid BYTE_STREAM_SPLIT page size");
+  const int64_t numValues = encodedDataSize_ / width;
+  dwio::common::ensureCapacity<char>(decodedPage_, encodedDataSize_, &pool_);
+  auto* output = decodedPage_->asMutable<char>();
+  switch (width) {
+    case 4:
+      mergeByteStreams<4>(pageData_, numValues, output);
+      break;
+    case 8:
+      mergeByteStreams<8>(pageData_, numValues, output);
+      break;
+    default:
+      mergeByteStreams(pageData_, numValues, width, output);
+  }
+  pageData_ = decodedPage_->as<char>();
 }
 
 void PageReader::skip(int64_t numRows) {
@@ -171,6 +171,16 @@ class PageReader {
   // bufferEnd_ to the corresponding positions.
   thrift::PageHeader readPageHeader();
 
+  /// Sets the locations of the data pages from the OffsetIndex of the
+  /// ColumnChunk. 'chunkOffset' is the file offset of the start of the
+  /// chunk. Seeking to a row then goes directly to the page containing it,
+  /// without reading the headers or bytes of the pages in between. The skipped
+  /// pages do not need to be loaded in the input stream. Only for columns that
+  /// are not repeated, where page rows are top level rows.
+  void setPageLocations(
+      std::vector<thrift::PageLocation> pageLocations,
+      int64_t chunkOffset);
+
  private:
   // Indicates that we only want the repdefs for the next page. Used when
   // prereading repdefs with seekToPage.
@@ -205,6 +215,11 @@ class PageReader {
   // allowed for non-top level columns.
   void seekToPage(int64_t row);
 
+  // If 'pageLocations_' is set, moves to the start of the data page containing
+  // 'row' if the page is after the current position. Does nothing before the
+  // dictionary page, if any, is read.
+  void skipToPageOfRow(int64_t row);
+
   // Preloads the repdefs for the column chunk. To avoid preloading,
   // would need a way too clone the input stream so that one stream
   // reads ahead for repdefs and the other tracks the data. This is
@@ -227,6 +242,13 @@ class PageReader {
   void prepareDictionary(const thrift::PageHeader& pageHeader);
   void makeDecoder();
 
+  // Decode the data of a page in DELTA_BINARY_PACKED, DELTA_LENGTH_BYTE_ARRAY,
+  // DELTA_BYTE_ARRAY or BYTE_STREAM_SPLIT into PLAIN in 'decodedPage_' and
+  // point 'pageData_' and 'encodedDataSize_' to the result.
+  void decodeDeltaBinaryPacked();
+  void decodeDeltaByteArray();
+  void decodeByteStreamSplit();
+
   // For a non-top level leaf, reads the defs and sets 'leafNulls_' and
   // 'numRowsInPage_' accordingly. This is used for non-top level leaves when
   // 'hasChunkRepDefs_' is false.
@@ -449,6 +471,10 @@ class PageReader {
   // decompressed data for the page. Rep-def-data in V1, data alone in V2.
   BufferPtr decompressedData_;
 
+  // Values of the page decoded into PLAIN for encodings that do not have
+  // their own decoder.
+  BufferPtr decodedPage_;
+
   // First byte of decompressed encoded data. Contains the encoded data as a
   // contiguous run of bytes.
   const char* FOLLY_NULLABLE pageData_{nullptr};
@@ -463,6 +489,13 @@ class PageReader {
   // Offset of first byte after current page' header.
   uint64_t pageDataStart_{0};
 
+  // Locations of the data pages from the OffsetIndex. Empty if not known.
+  std::vector<thrift::PageLocation> pageLocations_;
+
+  // File offset of the start of the ColumnChunk. The offsets in
+  // 'pageLocations_' are relative to the file.
+  int64_t chunkOffset_{0};
+
   // Number of bytes starting at pageData_ for current encoded data.
   int32_t encodedDataSize_{0};
 
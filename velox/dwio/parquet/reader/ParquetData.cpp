@@ -15,6 +15,7 @@
  */
 
 #include "velox/dwio/parquet/reader/ParquetData.h"
+#include "velox/dwio/parquet/reader/BloomFilter.h"
 #include "velox/dwio/parquet/reader/Statistics.h"
 
 namespace facebook::velox::parquet {
@@ -23,10 +24,25 @@ using thrift::RowGroup;
 
 std::unique_ptr<dwio::common::FormatData> ParquetParams::toFormatData(
     const std::shared_ptr<const dwio::common::TypeWithId>& type,
-    const common::ScanSpec& /*scanSpec*/) {
-  return std::make_unique<ParquetData>(type, metaData_.row_groups, pool());
+    const common::ScanSpec& scanSpec) {
+  return std::make_unique<ParquetData>(
+      type, metaData_.row_groups, scanSpec, pool());
 }
 
+namespace {
+// Returns the file offset of the first page of 'metaData'.
+uint64_t chunkReadOffset(const thrift::ColumnMetaData& metaData) {
+  uint64_t offset = metaData.data_page_offset;
+  if (metaData.__isset.dictionary_page_offset &&
+      metaData.dictionary_page_offset >= 4) {
+    // this assumes the data pages follow the dict pages directly.
+    offset = metaData.dictionary_page_offset;
+  }
+  VELOX_CHECK_GE(offset, 0);
+  return offset;
+}
+} // namespace
+
 void ParquetData::filterRowGroups(
     const common::ScanSpec& scanSpec,
     uint64_t /*rowsPerRowGroup*/,
@@ -82,9 +98,53 @@ bool ParquetData::rowGroupMatches(
   return true;
 }
 
-void ParquetData::enqueueRowGroup(
+bool ParquetData::bloomFilterMatches(
     uint32_t index,
     dwio::common::BufferedInput& input) {
+  auto* filter = scanSpec_.filter();
+  // Nulls are not in the Bloom filter.
+  if (!filter || filter->testNull() || !type_->parquetType_.has_value()) {
+    return true;
+  }
+  auto& chunk = rowGroups_[index].columns[type_->column()];
+  if (!chunk.__isset.meta_data ||
+      !chunk.meta_data.__isset.bloom_filter_offset) {
+    return true;
+  }
+  // The values of the filter are hashed in the plain encoding of the physical
+  // type. TINYINT and SMALLINT are skipped since they may have been written
+  // as unsigned values.
+  auto physicalType = *type_->parquetType_;
+  const auto& type = type_->type();
+  switch (physicalType) {
+    case thrift::Type::INT32:
+      if (type->kind() != TypeKind::INTEGER) {
+        return true;
+      }
+      break;
+    case thrift::Type::INT64:
+      if (type->kind() != TypeKind::BIGINT || type->isDecimal()) {
+        return true;
+      }
+      break;
+    case thrift::Type::BYTE_ARRAY:
+      if (type->kind() != TypeKind::VARCHAR &&
+          type->kind() != TypeKind::VARBINARY) {
+        return true;
+      }
+      break;
+    default:
+      return true;
+  }
+  auto bloomFilter =
+      BloomFilter::read(input, chunk.meta_data.bloom_filter_offset);
+  return !bloomFilter || bloomFilter->mayMatch(*filter, physicalType);
+}
+
+void ParquetData::enqueueRowGroup(
+    uint32_t index,
+    dwio::common::BufferedInput& input,
+    const RowRanges* rowRanges) {
   auto& chunk = rowGroups_[index].columns[type_->column()];
   streams_.resize(rowGroups_.size());
   VELOX_CHECK(
@@ -92,21 +152,144 @@ void ParquetData::enqueueRowGroup(
       "ColumnMetaData does not exist for schema Id ",
       type_->column());
   auto& metaData = chunk.meta_data;
-
-  uint64_t chunkReadOffset = metaData.data_page_offset;
-  if (metaData.__isset.dictionary_page_offset &&
-      metaData.dictionary_page_offset >= 4) {
-    // this assumes the data pages follow the dict pages directly.
-    chunkReadOffset = metaData.dictionary_page_offset;
+  auto chunkOffset = chunkReadOffset(metaData);
+  if (rowRanges && maxRepeat_ == 0 && pageIndices_.count(index)) {
+    streams_[index] = enqueuePages(index, chunkOffset, *rowRanges, input);
+    return;
   }
-  VELOX_CHECK_GE(chunkReadOffset, 0);
 
   uint64_t readSize = (metaData.codec == thrift::CompressionCodec::UNCOMPRESSED)
       ? metaData.total_uncompressed_size
       : metaData.total_compressed_size;
 
   auto id = dwio::common::StreamIdentifier(type_->column());
-  streams_[index] = input.enqueue({chunkReadOffset, readSize}, &id);
+  streams_[index] = input.enqueue({chunkOffset, readSize}, &id);
+}
+
+std::unique_ptr<dwio::common::SeekableInputStream> ParquetData::enqueuePages(
+    uint32_t index,
+    uint64_t chunkOffset,
+    const RowRanges& rowRanges,
+    dwio::common::BufferedInput& input) {
+  auto& locations = pageIndices_[index].offsetIndex.page_locations;
+  auto numRows = rowGroups_[index].num_rows;
+  std::vector<PageRangesInputStream::Range> ranges;
+  auto addRange = [&](int64_t offset, int64_t length) {
+    if (!ranges.empty() &&
+        ranges.back().offset + ranges.back().length == offset) {
+      ranges.back().length += length;
+    } else {
+      ranges.push_back({offset, length, nullptr});
+    }
+  };
+  if (!locations.empty() &&
+      static_cast<uint64_t>(locations[0].offset) > chunkOffset) {
+    // The dictionary page.
+    addRange(0, locations[0].offset - chunkOffset);
+  }
+  auto rowRange = rowRanges.begin();
+  for (auto i = 0; i < locations.size(); ++i) {
+    auto firstRow = locations[i].first_row_index;
+    auto endRow =
+        i + 1 < locations.size() ? locations[i + 1].first_row_index : numRows;
+    while (rowRange != rowRanges.end() && rowRange->end <= firstRow) {
+      ++rowRange;
+    }
+    if (rowRange == rowRanges.end()) {
+      break;
+    }
+    if (rowRange->begin < endRow) {
+      addRange(
+          locations[i].offset - chunkOffset, locations[i].compressed_page_size);
+    }
+  }
+  auto id = dwio::common::StreamIdentifier(type_->column());
+  for (auto& range : ranges) {
+    range.stream =
+        input.enqueue({chunkOffset + range.offset, range.length}, &id);
+  }
+  return std::make_unique<PageRangesInputStream>(std::move(ranges));
+}
+
+std::pair<common::Region, common::Region> ParquetData::getPageIndexRegions(
+    uint32_t index) const {
+  auto& chunk = rowGroups_[index].columns[type_->column()];
+  common::Region offsetIndex;
+  common::Region columnIndex;
+  if (chunk.__isset.offset_index_offset && chunk.__isset.offset_index_length) {
+    offsetIndex = {
+        static_cast<uint64_t>(chunk.offset_index_offset),
+        static_cast<uint64_t>(chunk.offset_index_length)};
+  }
+  if (chunk.__isset.column_index_offset && chunk.__isset.column_index_length) {
+    columnIndex = {
+        static_cast<uint64_t>(chunk.column_index_offset),
+        static_cast<uint64_t>(chunk.column_index_length)};
+  }
+  return {offsetIndex, columnIndex};
+}
+
+void ParquetData::loadPageIndex(
+    uint32_t index,
+    const PageIndexBuffer& offsetIndexes,
+    const PageIndexBuffer& columnIndexes) {
+  auto [offsetIndexRegion, columnIndexRegion] = getPageIndexRegions(index);
+  if (!offsetIndexRegion.length) {
+    return;
+  }
+  PageIndex pageIndex;
+  readThrift(offsetIndexes.get(offsetIndexRegion), pageIndex.offsetIndex);
+  if (columnIndexRegion.length && scanSpec_.filter()) {
+    pageIndex.columnIndex.emplace();
+    readThrift(columnIndexes.get(columnIndexRegion), *pageIndex.columnIndex);
+  }
+  pageIndices_[index] = std::move(pageIndex);
+}
+
+std::optional<RowRanges> ParquetData::filterPages(uint32_t index) const {
+  auto filter = scanSpec_.filter();
+  auto it = pageIndices_.find(index);
+  if (!filter || it == pageIndices_.end() || !it->second.columnIndex) {
+    return std::nullopt;
+  }
+  auto& locations = it->second.offsetIndex.page_locations;
+  auto& columnIndex = *it->second.columnIndex;
+  VELOX_CHECK_EQ(locations.size(), columnIndex.null_pages.size());
+  auto type = type_->type();
+  auto numRows = rowGroups_[index].num_rows;
+  RowRanges ranges;
+  for (auto i = 0; i < locations.size(); ++i) {
+    auto firstRow = locations[i].first_row_index;
+    auto endRow =
+        i + 1 < locations.size() ? locations[i + 1].first_row_index : numRows;
+    auto numRowsInPage = endRow - firstRow;
+    // The min and max values of the page have the same encoding as the ones
+    // in the ColumnChunk statistics.
+    thrift::Statistics pageStats;
+    if (columnIndex.null_pages[i]) {
+      pageStats.__set_null_count(numRowsInPage);
+    } else {
+      if (columnIndex.__isset.null_counts) {
+        pageStats.__set_null_count(columnIndex.null_counts[i]);
+      }
+      pageStats.__set_min_value(columnIndex.min_values[i]);
+      pageStats.__set_max_value(columnIndex.max_values[i]);
+    }
+    auto columnStats =
+        buildColumnStatisticsFromThrift(pageStats, *type, numRowsInPage);
+    if (!testFilter(filter, columnStats.get(), numRowsInPage, type)) {
+      continue;
+    }
+    if (!ranges.empty() && ranges.back().end == firstRow) {
+      ranges.back().end = endRow;
+    } else {
+      ranges.push_back({firstRow, endRow});
+    }
+  }
+  if (ranges.size() == 1 && ranges[0] == RowRange{0, numRows}) {
+    return std::nullopt;
+  }
+  return ranges;
 }
 
 dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
@@ -120,6 +303,15 @@ dwio::common::PositionProvider ParquetData::seekToRowGroup(uint32_t index) {
       type_,
       metadata.codec,
       metadata.total_compressed_size);
+  auto it = pageIndices_.find(index);
+  if (it != pageIndices_.end()) {
+    if (maxRepeat_ == 0) {
+      reader_->setPageLocations(
+          std::move(it->second.offsetIndex.page_locations),
+          chunkReadOffset(metadata));
+    }
+    pageIndices_.erase(it);
+  }
   return dwio::common::PositionProvider(empty);
 }
 
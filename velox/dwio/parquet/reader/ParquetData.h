@@ -21,6 +21,7 @@
 #include "velox/dwio/common/BufferUtil.h"
 #include "velox/dwio/common/BufferedInput.h"
 #include "velox/dwio/common/ScanSpec.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 #include "velox/dwio/parquet/reader/PageReader.h"
 #include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
 #include "velox/dwio/parquet/thrift/ThriftTransport.h"
@@ -47,16 +48,44 @@ class ParquetData : public dwio::common::FormatData {
   ParquetData(
       const std::shared_ptr<const dwio::common::TypeWithId>& type,
       const std::vector<thrift::RowGroup>& rowGroups,
+      const common::ScanSpec& scanSpec,
       memory::MemoryPool& pool)
       : pool_(pool),
         type_(std::static_pointer_cast<const ParquetTypeWithId>(type)),
         rowGroups_(rowGroups),
+        scanSpec_(scanSpec),
         maxDefine_(type_->maxDefine_),
         maxRepeat_(type_->maxRepeat_),
         rowsInRowGroup_(-1) {}
 
-  /// Prepares to read data for 'index'th row group.
-  void enqueueRowGroup(uint32_t index, dwio::common::BufferedInput& input);
+  /// Prepares to read data for 'index'th row group. If 'rowRanges' is given
+  /// and the page index of the column is loaded, only the data pages with
+  /// rows in 'rowRanges' and the dictionary page are enqueued.
+  void enqueueRowGroup(
+      uint32_t index,
+      dwio::common::BufferedInput& input,
+      const RowRanges* rowRanges = nullptr);
+
+  /// Returns the file regions of the OffsetIndex and the ColumnIndex of the
+  /// column in 'index'th row group. A region has zero length if the index is
+  /// not in the file.
+  std::pair<common::Region, common::Region> getPageIndexRegions(
+      uint32_t index) const;
+
+  /// Parses the page index of the column in 'index'th row group from
+  /// 'offsetIndexes' and 'columnIndexes', which hold the regions returned by
+  /// getPageIndexRegions(). The ColumnIndex is only parsed if the column has
+  /// a filter.
+  void loadPageIndex(
+      uint32_t index,
+      const PageIndexBuffer& offsetIndexes,
+      const PageIndexBuffer& columnIndexes);
+
+  /// Returns the ranges of rows in 'index'th row group that may pass the
+  /// filter of the column according to the ColumnIndex. Returns std::nullopt
+  /// if the column has no filter, no ColumnIndex is loaded or no page is
+  /// filtered out.
+  std::optional<RowRanges> filterPages(uint32_t index) const;
 
   /// Positions 'this' at 'index'th row group. loadRowGroup must be called
   /// first. The returned PositionProvider is empty and should not be used.
@@ -69,6 +98,12 @@ class ParquetData : public dwio::common::FormatData {
       const dwio::common::StatsContext& writerContext,
       FilterRowGroupsResult&) override;
 
+  /// Returns false if the Bloom filter of the column in 'index'th row group
+  /// shows that no value passes the filter of the column. Reads the Bloom
+  /// filter from 'input' if the filter tests for equality with one or a list
+  /// of values and the column has a Bloom filter. Returns true otherwise.
+  bool bloomFilterMatches(uint32_t index, dwio::common::BufferedInput& input);
+
   PageReader* FOLLY_NONNULL reader() const {
     return reader_.get();
   }
@@ -183,10 +218,20 @@ class ParquetData : public dwio::common::FormatData {
   /// stats in 'rowGroup'.
   bool rowGroupMatches(uint32_t rowGroupId, common::Filter* filter);
 
+  // Enqueues the dictionary page and the data pages with rows in 'rowRanges'
+  // of the chunk starting at 'chunkOffset'. The returned stream covers the
+  // whole chunk but only the enqueued pages can be read from it.
+  std::unique_ptr<dwio::common::SeekableInputStream> enqueuePages(
+      uint32_t index,
+      uint64_t chunkOffset,
+      const RowRanges& rowRanges,
+      dwio::common::BufferedInput& input);
+
  protected:
   memory::MemoryPool& pool_;
   std::shared_ptr<const ParquetTypeWithId> type_;
   const std::vector<thrift::RowGroup>& rowGroups_;
+  const common::ScanSpec& scanSpec_;
   // Streams for this column in each of 'rowGroups_'. Will be created on or
   // ahead of first use, not at construction.
   std::vector<std::unique_ptr<dwio::common::SeekableInputStream>> streams_;
@@ -196,6 +241,10 @@ class ParquetData : public dwio::common::FormatData {
   int64_t rowsInRowGroup_;
   std::unique_ptr<PageReader> reader_;
 
+  // Page indices of the column by row group. Filled by loadPageIndex() and
+  // handed to 'reader_' in seekToRowGroup().
+  std::unordered_map<uint32_t, PageIndex> pageIndices_;
+
   // Nulls derived from leaf repdefs for non-leaf readers.
   BufferPtr presetNulls_;
 
@@ -16,6 +16,7 @@
 
 #include "velox/dwio/parquet/reader/ParquetReader.h"
 #include <thrift/protocol/TCompactProtocol.h> //@manual
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/common/MetricsLog.h"
 #include "velox/dwio/common/TypeUtils.h"
 #include "velox/dwio/parquet/reader/StructColumnReader.h"
@@ -110,7 +111,8 @@ class ReaderBase {
   const dwio::common::ReaderOptions options_;
   std::shared_ptr<velox::dwio::common::BufferedInput> input_;
   uint64_t fileLength_;
-  std::unique_ptr<thrift::FileMetaData> fileMetaData_;
+  // Possibly shared with other readers through the FileMetadataCache.
+  std::shared_ptr<const thrift::FileMetaData> fileMetaData_;
   RowTypePtr schema_;
   std::shared_ptr<const dwio::common::TypeWithId> schemaWithId_;
 
@@ -138,6 +140,16 @@ ReaderBase::ReaderBase(
 }
 
 void ReaderBase::loadFileMetaData() {
+  auto* metadataCache = options_.getFileMetadataCache();
+  const auto& fileName = input_->getReadFile()->getName();
+  if (metadataCache) {
+    fileMetaData_ = metadataCache->find<thrift::FileMetaData>(
+        fileName, fileLength_, dwio::common::FileFormat::PARQUET);
+    if (fileMetaData_) {
+      return;
+    }
+  }
+
   bool preloadFile =
       fileLength_ <= std::max(filePreloadThreshold_, directorySizeGuess_);
   uint64_t readSize = preloadFile ? fileLength_ : directorySizeGuess_;
@@ -184,8 +196,20 @@ void ReaderBase::loadFileMetaData() {
   auto thriftProtocol = std::make_unique<
       apache::thrift::protocol::TCompactProtocolT<thrift::ThriftTransport>>(
       thriftTransport);
-  fileMetaData_ = std::make_unique<thrift::FileMetaData>();
-  fileMetaData_->read(thriftProtocol.get());
+  auto fileMetaData = std::make_shared<thrift::FileMetaData>();
+  fileMetaData->read(thriftProtocol.get());
+  fileMetaData_ = fileMetaData;
+  if (metadataCache) {
+    // The decoded thrift objects take a few times the size of the compact
+    // encoding.
+    constexpr int32_t kDecodedSizeFactor = 4;
+    metadataCache->insert(
+        fileName,
+        fileLength_,
+        dwio::common::FileFormat::PARQUET,
+        fileMetaData_,
+        kDecodedSizeFactor * footerLength);
+  }
 }
 
 void ReaderBase::initializeSchema() {
@@ -684,6 +708,12 @@ void ParquetRowReader::filterRowGroups() {
     if (rowGroupInRange) {
       if (i < res.totalCount && bits::isBitSet(res.filterResult.data(), i)) {
         ++skippedRowGroups_;
+      } else if (!static_cast<StructColumnReader&>(*columnReader_)
+                      .bloomFiltersMatch(i, readerBase_->bufferedInput())) {
+        // Bloom filters are only read for the row groups left after
+        // filtering with the stats.
+        ++skippedRowGroups_;
+        ++skippedBloomFilterRowGroups_;
       } else {
         rowGroupIds_.push_back(i);
         firstRowOfRowGroup_.push_back(rowNumber);
@@ -694,9 +724,15 @@ void ParquetRowReader::filterRowGroups() {
 }
 
 int64_t ParquetRowReader::nextRowNumber() {
-  if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
-      !advanceToNextRowGroup()) {
-    return kAtEnd;
+  for (;;) {
+    if (currentRowInGroup_ >= rowsInCurrentRowGroup_ &&
+        !advanceToNextRowGroup()) {
+      return kAtEnd;
+    }
+    skipFilteredRows();
+    if (currentRowInGroup_ < rowsInCurrentRowGroup_) {
+      break;
+    }
   }
   return firstRowOfRowGroup_[nextRowGroupIdsIdx_ - 1] + currentRowInGroup_;
 }
@@ -706,7 +742,38 @@ int64_t ParquetRowReader::nextReadSize(uint64_t size) {
   if (nextRowNumber() == kAtEnd) {
     return kAtEnd;
   }
-  return std::min(size, rowsInCurrentRowGroup_ - currentRowInGroup_);
+  return std::min(size, rowsLeftInRange());
+}
+
+void ParquetRowReader::skipFilteredRows() {
+  if (!rowRanges_) {
+    return;
+  }
+  auto& ranges = *rowRanges_;
+  while (nextRowRange_ < ranges.size() &&
+         ranges[nextRowRange_].end <= currentRowInGroup_) {
+    ++nextRowRange_;
+  }
+  uint64_t nextRow = nextRowRange_ < ranges.size()
+      ? std::max<uint64_t>(currentRowInGroup_, ranges[nextRowRange_].begin)
+      : rowsInCurrentRowGroup_;
+  if (nextRow == currentRowInGroup_) {
+    return;
+  }
+  skippedPageRows_ += nextRow - currentRowInGroup_;
+  currentRowInGroup_ = nextRow;
+  if (currentRowInGroup_ < rowsInCurrentRowGroup_) {
+    // The next read starts at the new offset and the column readers skip to
+    // it. Pages with only skipped rows are not loaded.
+    columnReader_->setReadOffset(currentRowInGroup_);
+  }
+}
+
+uint64_t ParquetRowReader::rowsLeftInRange() const {
+  if (rowRanges_ && nextRowRange_ < rowRanges_->size()) {
+    return (*rowRanges_)[nextRowRange_].end - currentRowInGroup_;
+  }
+  return rowsInCurrentRowGroup_ - currentRowInGroup_;
 }
 
 uint64_t ParquetRowReader::next(
@@ -739,12 +806,17 @@ bool ParquetRowReader::advanceToNextRowGroup() {
   currentRowInGroup_ = 0;
   nextRowGroupIdsIdx_++;
   columnReader_->seekToRowGroup(nextRowGroupIndex);
+  rowRanges_ = static_cast<StructColumnReader&>(*columnReader_)
+                   .moveRowRanges(nextRowGroupIndex);
+  nextRowRange_ = 0;
   return true;
 }
 
 void ParquetRowReader::updateRuntimeStats(
     dwio::common::RuntimeStatistics& stats) const {
   stats.skippedStrides += skippedRowGroups_;
+  stats.skippedPageRows += skippedPageRows_;
+  stats.skippedBloomFilterStrides += skippedBloomFilterRowGroups_;
 }
 
 void ParquetRowReader::resetFilterCaches() {
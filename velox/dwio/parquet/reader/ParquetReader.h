@@ -20,6 +20,7 @@
 #include "velox/dwio/common/Reader.h"
 #include "velox/dwio/common/ReaderFactory.h"
 #include "velox/dwio/common/SelectiveColumnReader.h"
+#include "velox/dwio/parquet/reader/PageIndex.h"
 #include "velox/dwio/parquet/reader/ParquetTypeWithId.h"
 #include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
 
@@ -64,6 +65,10 @@ class ParquetRowReader : public dwio::common::RowReader {
     return true;
   }
 
+  bool appliesFilterFunction() const override {
+    return true;
+  }
+
   // Checks if the specific row group is buffered.
   // Returns false if the row group is not loaded into buffer
   // or the buffered data has been evicted.
@@ -78,6 +83,15 @@ class ParquetRowReader : public dwio::common::RowReader {
   // by filterRowGroups().
   bool advanceToNextRowGroup();
 
+  // Moves past the rows of the current row group that are before the next
+  // range in 'rowRanges_'. The column readers skip these rows on their next
+  // read.
+  void skipFilteredRows();
+
+  // Returns the number of rows left to read in the current row group before
+  // the next filtered out rows.
+  uint64_t rowsLeftInRange() const;
+
   memory::MemoryPool& pool_;
   const std::shared_ptr<ReaderBase> readerBase_;
   const dwio::common::RowReaderOptions options_;
@@ -93,9 +107,22 @@ class ParquetRowReader : public dwio::common::RowReader {
   uint64_t rowsInCurrentRowGroup_;
   uint64_t currentRowInGroup_;
 
-  // Number of row groups skipped based on stats.
+  // Number of row groups skipped based on stats and Bloom filters.
   int32_t skippedRowGroups_{0};
 
+  // Number of row groups skipped based on Bloom filters.
+  int32_t skippedBloomFilterRowGroups_{0};
+
+  // Rows to read in the current row group after filtering pages with the
+  // page index. std::nullopt if all rows are read.
+  std::optional<RowRanges> rowRanges_;
+
+  // Index of the first range in 'rowRanges_' not entirely read.
+  size_t nextRowRange_{0};
+
+  // Number of rows skipped based on the page index.
+  int64_t skippedPageRows_{0};
+
   std::unique_ptr<dwio::common::SelectiveColumnReader> columnReader_;
 
   RowTypePtr requestedType_;
@@ -39,6 +39,9 @@ StructColumnReader::StructColumnReader(
     childSpecs[i]->setSubscript(children_.size() - 1);
   }
   auto type = reinterpret_cast<const ParquetTypeWithId*>(fileType_.get());
+  if (type->parent() && children_.empty()) {
+    addRepDefChild(params);
+  }
   if (type->parent()) {
     levelMode_ = reinterpret_cast<const ParquetTypeWithId*>(fileType_.get())
                      ->makeLevelInfo(levelInfo_);
@@ -63,6 +66,28 @@ StructColumnReader::StructColumnReader(
   }
 }
 
+void StructColumnReader::addRepDefChild(ParquetParams& params) {
+  VELOX_CHECK_GT(fileType_->size(), 0);
+  // Takes the primitive child with the narrowest values, else the first child.
+  int32_t best = 0;
+  for (auto i = 0; i < fileType_->size(); ++i) {
+    auto kind = fileType_->childAt(i)->type()->kind();
+    auto bestKind = fileType_->childAt(best)->type()->kind();
+    if (fileType_->childAt(i)->type()->isPrimitiveType() &&
+        (!fileType_->childAt(best)->type()->isPrimitiveType() ||
+         kind < bestKind)) {
+      best = i;
+    }
+  }
+  auto& name = fileType_->type()->asRow().nameOf(best);
+  repDefSpec_ = std::make_unique<common::ScanSpec>(name);
+  repDefSpec_->setProjectOut(false);
+  repDefSpec_->addAllChildFields(*fileType_->childAt(best)->type());
+  // The child is only read as stored in the file.
+  addChild(ParquetColumnReader::build(
+      fileType_->childAt(best), fileType_->childAt(best), params, *repDefSpec_));
+}
+
 dwio::common::SelectiveColumnReader* FOLLY_NONNULL
 StructColumnReader::findBestLeaf() {
   SelectiveColumnReader* best = nullptr;
@@ -99,16 +124,115 @@ void StructColumnReader::read(
 std::shared_ptr<dwio::common::BufferedInput> StructColumnReader::loadRowGroup(
     uint32_t index,
     const std::shared_ptr<dwio::common::BufferedInput>& input) {
+  auto rowRanges = filterPages(index, *input);
+  if (rowRanges) {
+    rowRanges_[index] = std::move(*rowRanges);
+  }
+  auto it = rowRanges_.find(index);
+  const RowRanges* ranges = it == rowRanges_.end() ? nullptr : &it->second;
   if (isRowGroupBuffered(index, *input)) {
-    enqueueRowGroup(index, *input);
+    enqueueRowGroup(index, *input, ranges);
     return input;
   }
   auto newInput = input->clone();
-  enqueueRowGroup(index, *newInput);
+  enqueueRowGroup(index, *newInput, ranges);
   newInput->load(dwio::common::LogType::STRIPE);
   return newInput;
 }
 
+bool StructColumnReader::bloomFiltersMatch(
+    uint32_t index,
+    dwio::common::BufferedInput& input) {
+  for (auto& child : children_) {
+    auto kind = child->fileType().type()->kind();
+    if (kind == TypeKind::ROW) {
+      if (!static_cast<StructColumnReader*>(child)->bloomFiltersMatch(
+              index, input)) {
+        return false;
+      }
+    } else if (kind == TypeKind::ARRAY || kind == TypeKind::MAP) {
+      continue;
+    } else if (
+        child->scanSpec()->filter() &&
+        !child->formatData().as<ParquetData>().bloomFilterMatches(
+            index, input)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::optional<RowRanges> StructColumnReader::moveRowRanges(uint32_t index) {
+  auto it = rowRanges_.find(index);
+  if (it == rowRanges_.end()) {
+    return std::nullopt;
+  }
+  auto rowRanges = std::move(it->second);
+  rowRanges_.erase(it);
+  return rowRanges;
+}
+
+std::optional<RowRanges> StructColumnReader::filterPages(
+    uint32_t index,
+    dwio::common::BufferedInput& input) {
+  std::vector<ParquetData*> leaves;
+  bool hasFilter = false;
+  for (auto& child : children_) {
+    auto kind = child->fileType().type()->kind();
+    if (kind == TypeKind::ROW || kind == TypeKind::ARRAY ||
+        kind == TypeKind::MAP) {
+      return std::nullopt;
+    }
+    leaves.push_back(&child->formatData().as<ParquetData>());
+    hasFilter |= child->scanSpec()->filter() != nullptr;
+  }
+  if (!hasFilter) {
+    return std::nullopt;
+  }
+
+  // The page indices of the columns of a row group are next to each other.
+  // Reads the OffsetIndexes of all columns and the ColumnIndexes of the
+  // filtered columns in one IO each.
+  uint64_t offsetIndexesBegin = std::numeric_limits<uint64_t>::max();
+  uint64_t offsetIndexesEnd = 0;
+  uint64_t columnIndexesBegin = std::numeric_limits<uint64_t>::max();
+  uint64_t columnIndexesEnd = 0;
+  for (auto i = 0; i < leaves.size(); ++i) {
+    auto [offsetIndex, columnIndex] = leaves[i]->getPageIndexRegions(index);
+    if (offsetIndex.length) {
+      offsetIndexesBegin = std::min(offsetIndexesBegin, offsetIndex.offset);
+      offsetIndexesEnd =
+          std::max(offsetIndexesEnd, offsetIndex.offset + offsetIndex.length);
+    }
+    if (columnIndex.length && children_[i]->scanSpec()->filter()) {
+      columnIndexesBegin = std::min(columnIndexesBegin, columnIndex.offset);
+      columnIndexesEnd =
+          std::max(columnIndexesEnd, columnIndex.offset + columnIndex.length);
+    }
+  }
+  if (!offsetIndexesEnd || !columnIndexesEnd) {
+    return std::nullopt;
+  }
+  PageIndexBuffer offsetIndexes;
+  offsetIndexes.read(
+      input, {offsetIndexesBegin, offsetIndexesEnd - offsetIndexesBegin});
+  PageIndexBuffer columnIndexes;
+  columnIndexes.read(
+      input, {columnIndexesBegin, columnIndexesEnd - columnIndexesBegin});
+
+  std::optional<RowRanges> rowRanges;
+  for (auto* leaf : leaves) {
+    leaf->loadPageIndex(index, offsetIndexes, columnIndexes);
+    auto leafRanges = leaf->filterPages(index);
+    if (!leafRanges) {
+      continue;
+    }
+    rowRanges = rowRanges ? intersectRowRanges(*rowRanges, *leafRanges)
+                          : std::move(*leafRanges);
+  }
+  return rowRanges;
+}
+
 bool StructColumnReader::isRowGroupBuffered(
     uint32_t index,
     dwio::common::BufferedInput& input) {
@@ -119,7 +243,8 @@ bool StructColumnReader::isRowGroupBuffered(
 
 void StructColumnReader::enqueueRowGroup(
     uint32_t index,
-    dwio::common::BufferedInput& input) {
+    dwio::common::BufferedInput& input,
+    const RowRanges* rowRanges) {
   for (auto& child : children_) {
     if (auto structChild = dynamic_cast<StructColumnReader*>(child)) {
       structChild->enqueueRowGroup(index, input);
@@ -128,7 +253,8 @@ void StructColumnReader::enqueueRowGroup(
     } else if (auto mapChild = dynamic_cast<MapColumnReader*>(child)) {
       mapChild->enqueueRowGroup(index, input);
     } else {
-      child->formatData().as<ParquetData>().enqueueRowGroup(index, input);
+      child->formatData().as<ParquetData>().enqueueRowGroup(
+          index, input, rowRanges);
     }
   }
 }
@@ -41,6 +41,16 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
       uint32_t index,
       const std::shared_ptr<dwio::common::BufferedInput>& input);
 
+  /// Returns false if the Bloom filters of the columns in 'index'th row group
+  /// show that no row passes the filters. The Bloom filters of the columns
+  /// with equality and IN filters are read from 'input'.
+  bool bloomFiltersMatch(uint32_t index, dwio::common::BufferedInput& input);
+
+  /// Returns the ranges of rows of 'index'th row group that are left to read
+  /// after filtering the pages with the page index and forgets them. Returns
+  /// std::nullopt if all rows need to be read. Valid after loadRowGroup().
+  std::optional<RowRanges> moveRowRanges(uint32_t index);
+
   // No-op in Parquet. All readers switch row groups at the same time, there is
   // no on-demand skipping to a new row group.
   void advanceFieldReader(
@@ -70,7 +80,24 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
  private:
   dwio::common::SelectiveColumnReader* findBestLeaf();
 
-  void enqueueRowGroup(uint32_t index, dwio::common::BufferedInput& input);
+  // Adds a reader for one child of a nested struct whose fields are all
+  // pruned or constant. The child is not read into the result but gives the
+  // nulls of 'this' and keeps the enclosing lists and maps in sync.
+  void addRepDefChild(ParquetParams& params);
+
+  void enqueueRowGroup(
+      uint32_t index,
+      dwio::common::BufferedInput& input,
+      const RowRanges* rowRanges = nullptr);
+
+  // Reads the page indices of the columns of 'index'th row group and returns
+  // the rows that may pass the filters of all columns. Returns std::nullopt if
+  // no pages can be filtered out. Only done for the root when all its
+  // children are primitive columns, so that rows can be skipped without
+  // keeping repdefs of nested columns in sync.
+  std::optional<RowRanges> filterPages(
+      uint32_t index,
+      dwio::common::BufferedInput& input);
 
   bool isRowGroupBuffered(uint32_t index, dwio::common::BufferedInput& input);
 
@@ -85,6 +112,14 @@ class StructColumnReader : public dwio::common::SelectiveStructColumnReader {
   // The level information for extracting nulls for 'this' from the
   // repdefs in a leaf PageReader.
   ::parquet::internal::LevelInfo levelInfo_;
+
+  // ScanSpec of the child added by addRepDefChild(). Not in the children of
+  // 'scanSpec_', so the child is not read for values.
+  std::unique_ptr<common::ScanSpec> repDefSpec_;
+
+  // Rows left to read by row group after filtering pages. Only set for row
+  // groups where pages are filtered out.
+  std::unordered_map<uint32_t, RowRanges> rowRanges_;
 };
 
 } // namespace facebook::velox::parquet
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/reader/BloomFilter.h"
+
+#include <gtest/gtest.h>
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+#include <thrift/transport/TBufferTransports.h> //@manual
+#include "velox/common/file/File.h"
+#include "velox/common/memory/Memory.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::common;
+using namespace facebook::velox::parquet;
+
+class BloomFilterTest : public testing::Test {
+ protected:
+  // Returns a file with 'prefix' followed by 'bloomFilter' in the layout of
+  // a Parquet file.
+  static std::string serialize(
+      const BloomFilter& bloomFilter,
+      const std::string& prefix) {
+    thrift::BloomFilterHeader header;
+    header.__set_numBytes(bloomFilter.bitset().size() * sizeof(uint32_t));
+    header.algorithm.__set_BLOCK(thrift::SplitBlockAlgorithm());
+    header.hash.__set_XXHASH(thrift::XxHash());
+    header.compression.__set_UNCOMPRESSED(thrift::Uncompressed());
+    auto buffer = std::make_shared<apache::thrift::transport::TMemoryBuffer>();
+    apache::thrift::protocol::TCompactProtocol protocol(buffer);
+    header.write(&protocol);
+    std::string data = prefix + buffer->getBufferAsString();
+    data.append(
+        reinterpret_cast<const char*>(bloomFilter.bitset().data()),
+        header.numBytes);
+    return data;
+  }
+
+  std::unique_ptr<BloomFilter> read(const std::string& data, uint64_t offset) {
+    dwio::common::BufferedInput input(
+        std::make_shared<InMemoryReadFile>(data), *pool_);
+    return BloomFilter::read(input, offset);
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_{
+      memory::addDefaultLeafMemoryPool()};
+};
+
+TEST_F(BloomFilterTest, insertAndFind) {
+  BloomFilter bloomFilter(1024);
+  for (int64_t i = 0; i < 1000; ++i) {
+    bloomFilter.insertHash(BloomFilter::hash(i * 7));
+  }
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(bloomFilter.findHash(BloomFilter::hash(i * 7)));
+    numFalsePositives += bloomFilter.findHash(BloomFilter::hash(i * 7 + 1));
+  }
+  // About 8 bits per value give a false positive rate of a few percent.
+  EXPECT_LT(numFalsePositives, 100);
+}
+
+TEST_F(BloomFilterTest, mayMatchIntegers) {
+  BloomFilter bigints(1024);
+  BloomFilter ints(1024);
+  for (int64_t i = 0; i < 100; ++i) {
+    bigints.insertHash(BloomFilter::hash(i * 1'000));
+    ints.insertHash(BloomFilter::hash(static_cast<int32_t>(i * 1'000)));
+  }
+  auto bigint = thrift::Type::INT64;
+  auto integer = thrift::Type::INT32;
+
+  EXPECT_TRUE(bigints.mayMatch(BigintRange(5'000, 5'000, false), bigint));
+  EXPECT_FALSE(bigints.mayMatch(BigintRange(5'001, 5'001, false), bigint));
+  EXPECT_TRUE(ints.mayMatch(BigintRange(5'000, 5'000, false), integer));
+  EXPECT_FALSE(ints.mayMatch(BigintRange(5'001, 5'001, false), integer));
+  // Values that do not fit the physical type are not in the file.
+  constexpr int64_t kLarge = 1L << 40;
+  EXPECT_FALSE(ints.mayMatch(BigintRange(kLarge, kLarge, false), integer));
+  // Ranges cannot be tested.
+  EXPECT_TRUE(bigints.mayMatch(BigintRange(5'001, 5'002, false), bigint));
+
+  EXPECT_TRUE(bigints.mayMatch(
+      *createBigintValues({1, 3, 5, 99'000, 1234567}, false), bigint));
+  EXPECT_FALSE(bigints.mayMatch(
+      *createBigintValues({1, 3, 5, 1234567}, false), bigint));
+  EXPECT_TRUE(
+      ints.mayMatch(*createBigintValues({1, 3, 5, 7, 3'000}, false), integer));
+  EXPECT_FALSE(
+      ints.mayMatch(*createBigintValues({1, 3, 5, 7}, false), integer));
+
+  // Integer filters do not apply to other physical types.
+  EXPECT_TRUE(bigints.mayMatch(
+      BigintRange(5'001, 5'001, false), thrift::Type::BYTE_ARRAY));
+}
+
+TEST_F(BloomFilterTest, mayMatchStrings) {
+  BloomFilter bloomFilter(256);
+  for (auto i = 0; i < 20; ++i) {
+    auto value = fmt::format("id-{}", i);
+    bloomFilter.insertHash(BloomFilter::hash(std::string_view(value)));
+  }
+  auto string = thrift::Type::BYTE_ARRAY;
+
+  EXPECT_TRUE(bloomFilter.mayMatch(
+      BytesRange("id-7", false, false, "id-7", false, false, false), string));
+  EXPECT_FALSE(bloomFilter.mayMatch(
+      BytesRange("id-70", false, false, "id-70", false, false, false),
+      string));
+  EXPECT_TRUE(bloomFilter.mayMatch(
+      BytesRange("id-70", false, false, "id-80", false, false, false),
+      string));
+  EXPECT_TRUE(
+      bloomFilter.mayMatch(BytesValues({"a", "b", "id-19"}, false), string));
+  EXPECT_FALSE(
+      bloomFilter.mayMatch(BytesValues({"a", "b", "id-20"}, false), string));
+}
+
+TEST_F(BloomFilterTest, read) {
+  // A small filter is read with its header and a large one needs a second
+  // read for the rest of the bitset.
+  for (auto numBytes : {32, 64 << 10}) {
+    SCOPED_TRACE(fmt::format("numBytes: {}", numBytes));
+    BloomFilter bloomFilter(numBytes);
+    for (int64_t i = 0; i < 100; ++i) {
+      bloomFilter.insertHash(BloomFilter::hash(i));
+    }
+    std::string prefix(1'000, 'x');
+    auto data = serialize(bloomFilter, prefix);
+    auto copy = read(data, prefix.size());
+    ASSERT_TRUE(copy != nullptr);
+    EXPECT_EQ(bloomFilter.bitset(), copy->bitset());
+    for (int64_t i = 0; i < 100; ++i) {
+      EXPECT_TRUE(copy->findHash(BloomFilter::hash(i)));
+    }
+  }
+}
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/dwio/common/tests/E2EFilterTestBase.h"
 #include "velox/dwio/parquet/reader/ParquetReader.h"
 #include "velox/dwio/parquet/writer/Writer.h"
@@ -237,6 +238,52 @@ TEST_F(E2EFilterTest, integerDictionary) {
       20);
 }
 
+TEST_F(E2EFilterTest, pageIndex) {
+  options_.enableDictionary = false;
+  options_.dataPageSize = 1024;
+  options_.enablePageIndex = true;
+
+  // Ascending values give the pages disjoint ranges of values, so that range
+  // filters on 'int_val' skip pages.
+  auto makeSorted = [&]() {
+    int32_t value = 0;
+    for (auto i = 0; i < batchCount_; ++i) {
+      std::vector<int32_t> values(batchSize_);
+      std::iota(values.begin(), values.end(), value);
+      value += batchSize_;
+      useSuppliedValues<int32_t>("int_val", i, values);
+    }
+  };
+  testWithTypes(
+      "int_val:int,"
+      "long_val:bigint,"
+      "string_val:string",
+      makeSorted,
+      false,
+      {"int_val", "long_val", "string_val"},
+      20);
+
+  auto batches = makeDataset(makeSorted, false);
+  writeToMemory(rowType_, batches, false);
+  auto spec = filterGenerator_->makeScanSpec(SubfieldFilters{});
+  spec->childByName("int_val")->setFilter(
+      std::make_unique<BigintRange>(10'000, 10'100, false));
+  std::vector<uint64_t> hitRows;
+  for (auto i = 0; i < batches.size(); ++i) {
+    auto values = batches[i]->childAt(0)->as<FlatVector<int32_t>>();
+    for (auto row = 0; row < values->size(); ++row) {
+      if (!values->isNullAt(row) && values->valueAt(row) >= 10'000 &&
+          values->valueAt(row) <= 10'100) {
+        hitRows.push_back(batchPosition(i, row));
+      }
+    }
+  }
+  ASSERT_EQ(hitRows.size(), 101);
+  uint64_t time = 0;
+  readWithFilter(spec, MutationSpec{}, batches, hitRows, time, false);
+  EXPECT_LT(0, runtimeStats_.skippedPageRows);
+}
+
 TEST_F(E2EFilterTest, floatAndDoubleDirect) {
   options_.enableDictionary = false;
   options_.dataPageSize = 4 * 1024;
@@ -430,6 +477,39 @@ TEST_F(E2EFilterTest, stringDirect) {
       20);
 }
 
+TEST_F(E2EFilterTest, nonPlainEncodings) {
+  options_.enableDictionary = false;
+  options_.dataPageSize = 4 * 1024;
+  options_.columnEncodings = {
+      {"int_val", PageEncoding::kDeltaBinaryPacked},
+      {"long_val", PageEncoding::kDeltaBinaryPacked},
+      {"float_val", PageEncoding::kByteStreamSplit},
+      {"double_val", PageEncoding::kByteStreamSplit},
+      {"string_val", PageEncoding::kDeltaLengthByteArray},
+      {"string_val_2", PageEncoding::kDeltaByteArray},
+  };
+
+  testWithTypes(
+      "int_val:int,"
+      "long_val:bigint,"
+      "float_val:float,"
+      "double_val:double,"
+      "string_val:string,"
+      "string_val_2:string",
+      [&]() {
+        makeStringUnique("string_val");
+        makeStringUnique("string_val_2");
+      },
+      false,
+      {"int_val",
+       "long_val",
+       "float_val",
+       "double_val",
+       "string_val",
+       "string_val_2"},
+      20);
+}
+
 TEST_F(E2EFilterTest, stringDictionary) {
   testWithTypes(
       "string_val:string,"
@@ -615,6 +695,119 @@ TEST_F(E2EFilterTest, combineRowGroup) {
   EXPECT_EQ(parquetReader.numberOfRows(), 5);
 }
 
+TEST_F(E2EFilterTest, nativeWriter) {
+  options_.useNativeWriter = true;
+  options_.dataPageSize = 4 * 1024;
+  options_.dictionaryPageSizeLimit = 20'000;
+  options_.columnEncodings = {{"long_val", PageEncoding::kDeltaBinaryPacked}};
+
+  testWithTypes(
+      "boolean_val:boolean,"
+      "tinyint_val:tinyint,"
+      "short_val:smallint,"
+      "int_val:int,"
+      "long_val:bigint,"
+      "float_val:float,"
+      "double_val:double,"
+      "date_val:date,"
+      "string_val:string,"
+      "string_val_2:string",
+      [&]() {
+        makeIntDistribution<int32_t>(
+            "int_val",
+            10, // min
+            100, // max
+            22, // repeats
+            19, // rareFrequency
+            -9999, // rareMin
+            100000000, // rareMax
+            true); // keepNulls
+        makeStringDistribution("string_val", 100, true, false);
+        // Exceeds the dictionary size limit.
+        makeStringUnique("string_val_2");
+      },
+      false,
+      {"tinyint_val",
+       "short_val",
+       "int_val",
+       "long_val",
+       "float_val",
+       "double_val",
+       "date_val",
+       "string_val",
+       "string_val_2"},
+      20);
+}
+
+TEST_F(E2EFilterTest, nativeWriterCompression) {
+  for (const auto compression :
+       {common::CompressionKind_SNAPPY,
+        common::CompressionKind_ZSTD,
+        common::CompressionKind_GZIP}) {
+    if (!facebook::velox::parquet::Writer::isCodecAvailable(compression)) {
+      continue;
+    }
+    options_.useNativeWriter = true;
+    options_.dataPageSize = 4 * 1024;
+    options_.compression = compression;
+
+    testWithTypes(
+        "int_val:int,"
+        "long_val:bigint,"
+        "string_val:string",
+        [&]() { makeStringDistribution("string_val", 100, true, false); },
+        false,
+        {"int_val", "long_val", "string_val"},
+        3);
+  }
+}
+
+TEST_F(E2EFilterTest, nativeWriterBloomFilter) {
+  options_.useNativeWriter = true;
+  options_.bloomFilterColumns = {"long_val", "string_val"};
+
+  // Even ascending values give the row groups disjoint ranges. An odd value
+  // is inside the range of one row group but not in its Bloom filter.
+  auto makeEven = [&]() {
+    int64_t value = 0;
+    for (auto i = 0; i < batchCount_; ++i) {
+      std::vector<int64_t> values(batchSize_);
+      for (auto& element : values) {
+        element = value;
+        value += 2;
+      }
+      useSuppliedValues<int64_t>("long_val", i, values);
+    }
+  };
+  testWithTypes(
+      "long_val:bigint,"
+      "string_val:string",
+      [&]() {
+        makeEven();
+        makeStringDistribution("string_val", 100, true, false);
+      },
+      false,
+      {"long_val", "string_val"},
+      20);
+
+  auto batches = makeDataset(makeEven, false);
+  writeToMemory(rowType_, batches, false);
+  auto spec = filterGenerator_->makeScanSpec(SubfieldFilters{});
+  spec->childByName("long_val")
+      ->setFilter(std::make_unique<BigintRange>(1'001, 1'001, false));
+  uint64_t time = 0;
+  readWithFilter(spec, MutationSpec{}, batches, {}, time, false);
+  EXPECT_LT(0, runtimeStats_.skippedBloomFilterStrides);
+
+  options_.bloomFilterColumns = {"double_val"};
+  rowType_ = ROW({"double_val"}, {DOUBLE()});
+  batches = {std::static_pointer_cast<RowVector>(
+      test::BatchMaker::createBatch(rowType_, 10, *leafPool_, nullptr, 0))};
+  VELOX_ASSERT_THROW(
+      writeToMemory(rowType_, batches, false),
+      "Bloom filters are only written for integer and string columns");
+}
+
 // Define main so that gflags get processed.
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
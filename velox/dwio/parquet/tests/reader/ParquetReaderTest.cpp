@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 
+#include "velox/dwio/common/FileMetadataCache.h"
 #include "velox/dwio/parquet/reader/ParquetReader.h"
 #include "velox/dwio/parquet/tests/ParquetReaderTestBase.h"
 #include "velox/expression/ExprToSubfieldFilter.h"
@@ -86,6 +87,30 @@ TEST_F(ParquetReaderTest, parseSample) {
   assertReadExpected(sampleSchema(), *rowReader, expected, *pool_);
 }
 
+TEST_F(ParquetReaderTest, fileMetadataCache) {
+  const std::string sample(getExampleFilePath("sample.parquet"));
+  FileMetadataCache cache(1 << 20);
+  facebook::velox::dwio::common::ReaderOptions readerOptions{defaultPool.get()};
+  readerOptions.setFileMetadataCache(&cache);
+
+  // The second reader of the file takes the footer from the cache.
+  for (auto i = 0; i < 2; ++i) {
+    ParquetReader reader = createReader(sample, readerOptions);
+    EXPECT_EQ(reader.numberOfRows(), 20ULL);
+    auto rowReaderOpts = getReaderOpts(sampleSchema());
+    rowReaderOpts.setScanSpec(makeScanSpec(sampleSchema()));
+    auto rowReader = reader.createRowReader(rowReaderOpts);
+    auto expected = vectorMaker_->rowVector(
+        {rangeVector<int64_t>(20, 1), rangeVector<double>(20, 1)});
+    assertReadExpected(sampleSchema(), *rowReader, expected, *pool_);
+  }
+  const auto stats = cache.stats();
+  EXPECT_EQ(stats.numEntries, 1);
+  EXPECT_EQ(stats.numLookups, 2);
+  EXPECT_EQ(stats.numHits, 1);
+  EXPECT_GT(stats.bytes, 0);
+}
+
 TEST_F(ParquetReaderTest, parseSampleRange1) {
   const std::string sample(getExampleFilePath("sample.parquet"));
 
@@ -340,6 +365,34 @@ TEST_F(ParquetReaderTest, projectNoColumns) {
   ASSERT_FALSE(rowReader->next(kBatchSize, result));
 }
 
+TEST_F(ParquetReaderTest, projectNoStructFields) {
+  // row_map_array.parquet holds one row of type (ROW(BIGINT c0, MAP(VARCHAR,
+  // ARRAY(INTEGER)) c1) c). The fields of 'c' are all pruned, so the nulls of
+  // 'c' come from the repdefs of one of its columns.
+  auto rowType = ROW(
+      {"c"}, {ROW({"c0", "c1"}, {BIGINT(), MAP(VARCHAR(), ARRAY(INTEGER()))})});
+  facebook::velox::dwio::common::ReaderOptions readerOpts{defaultPool.get()};
+  ParquetReader reader =
+      createReader(getExampleFilePath("row_map_array.parquet"), readerOpts);
+  auto scanSpec = makeScanSpec(rowType);
+  auto* c = scanSpec->childByName("c");
+  c->childByName("c0")->setConstantValue(
+      BaseVector::createNullConstant(BIGINT(), 1, pool_.get()));
+  c->childByName("c1")->setConstantValue(BaseVector::createNullConstant(
+      MAP(VARCHAR(), ARRAY(INTEGER())), 1, pool_.get()));
+  auto rowReaderOpts = getReaderOpts(rowType);
+  rowReaderOpts.setScanSpec(scanSpec);
+  auto rowReader = reader.createRowReader(rowReaderOpts);
+  auto expected = vectorMaker_->rowVector(
+      {"c"},
+      {vectorMaker_->rowVector(
+          {"c0", "c1"},
+          {BaseVector::createNullConstant(BIGINT(), 1, pool_.get()),
+           BaseVector::createNullConstant(
+               MAP(VARCHAR(), ARRAY(INTEGER())), 1, pool_.get())})});
+  assertReadExpected(rowType, *rowReader, expected, *pool_);
+}
+
 TEST_F(ParquetReaderTest, parseIntDecimal) {
   // decimal_dict.parquet two columns (a: DECIMAL(7,2), b: DECIMAL(14,2)) and
   // 6 rows.
@@ -0,0 +1,799 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/parquet/writer/ColumnWriter.h"
+
+#include <folly/container/F14Map.h>
+#include <folly/container/F14Set.h>
+#include <thrift/protocol/TCompactProtocol.h> //@manual
+#include <thrift/transport/TBufferTransports.h> //@manual
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/dwio/common/DataBuffer.h"
+#include "velox/vector/DecodedVector.h"
+
+namespace facebook::velox::parquet {
+
+using dwio::common::DataBuffer;
+
+std::string serializeThrift(const apache::thrift::TBase& object) {
+  auto buffer = std::make_shared<apache::thrift::transport::TMemoryBuffer>();
+  apache::thrift::protocol::TCompactProtocol protocol(buffer);
+  object.write(&protocol);
+  return buffer->getBufferAsString();
+}
+
+namespace {
+
+// Rows appended between checks of the page and dictionary sizes.
+constexpr vector_size_t kRowsPerCheck = 1'024;
+
+// Upper bound for the groups of 8 values in one bit packed run.
+constexpr int32_t kMaxBitPackedGroups = 63;
+
+// Layout of the blocks of DELTA_BINARY_PACKED pages.
+constexpr int32_t kDeltaBlockSize = 128;
+constexpr int32_t kDeltaMiniBlocks = 4;
+constexpr int32_t kDeltaMiniBlockSize = kDeltaBlockSize / kDeltaMiniBlocks;
+
+template <typename T>
+void clearBuffer(DataBuffer<T>& buffer) {
+  if (buffer.size() > 0) {
+    buffer.resize(0);
+  }
+}
+
+void appendBytes(DataBuffer<char>& buffer, const void* data, uint64_t size) {
+  buffer.extend(size);
+  buffer.unsafeAppend(reinterpret_cast<const char*>(data), size);
+}
+
+void appendVarint(DataBuffer<char>& buffer, uint64_t value) {
+  while (value >= 0x80) {
+    buffer.append(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  buffer.append(static_cast<char>(value));
+}
+
+void appendZigZag(DataBuffer<char>& buffer, int64_t value) {
+  appendVarint(
+      buffer,
+      (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+}
+
+int32_t bitWidth(uint64_t value) {
+  return value == 0 ? 0 : 64 - __builtin_clzll(value);
+}
+
+// Appends 'numValues' little endian bit fields of 'bitWidth' bits.
+template <typename T>
+void appendBitPacked(
+    DataBuffer<char>& buffer,
+    const T* values,
+    int32_t numValues,
+    int32_t bitWidth) {
+  const uint64_t numBytes = bits::nbytes(numValues * bitWidth);
+  if (numBytes == 0) {
+    return;
+  }
+  const auto start = buffer.size();
+  buffer.extend(numBytes);
+  buffer.resize(start + numBytes);
+  auto* output = reinterpret_cast<uint8_t*>(buffer.data() + start);
+  uint64_t bitOffset = 0;
+  for (auto i = 0; i < numValues; ++i) {
+    uint64_t value = values[i];
+    int32_t numBits = 0;
+    while (numBits < bitWidth) {
+      const int32_t bitInByte = bitOffset & 7;
+      const int32_t numTaken = std::min(8 - bitInByte, bitWidth - numBits);
+      output[bitOffset >> 3] |=
+          static_cast<uint8_t>((value & ((1UL << numTaken) - 1)) << bitInByte);
+      value >>= numTaken;
+      numBits += numTaken;
+      bitOffset += numTaken;
+    }
+  }
+}
+
+// Returns the number of values equal to values[begin] in [begin, end).
+template <typename T>
+int32_t runLength(const T* values, int32_t begin, int32_t end) {
+  auto i = begin + 1;
+  while (i < end && values[i] == values[begin]) {
+    ++i;
+  }
+  return i - begin;
+}
+
+// Appends 'values' in the RLE / bit packing hybrid encoding of 'bitWidth'
+// bits. Runs of at least 8 equal values are RLE encoded and the values in
+// between are bit packed in groups of 8.
+template <typename T>
+void appendRleBp(
+    DataBuffer<char>& buffer,
+    const T* values,
+    int32_t numValues,
+    int32_t bitWidth) {
+  const int32_t valueBytes = bits::nbytes(bitWidth);
+  int32_t i = 0;
+  while (i < numValues) {
+    const auto length = runLength(values, i, numValues);
+    if (length >= 8) {
+      appendVarint(buffer, static_cast<uint64_t>(length) << 1);
+      const uint64_t value = values[i];
+      appendBytes(buffer, &value, valueBytes);
+      i += length;
+      continue;
+    }
+    const auto begin = i;
+    int32_t numGroups = 0;
+    do {
+      i = std::min(i + 8, numValues);
+      ++numGroups;
+    } while (i < numValues && numGroups < kMaxBitPackedGroups &&
+             runLength(values, i, std::min(i + 8, numValues)) < 8);
+    appendVarint(buffer, (static_cast<uint64_t>(numGroups) << 1) | 1);
+    const auto start = buffer.size();
+    appendBitPacked(buffer, values + begin, i - begin, bitWidth);
+    // Only the last group may be partial. It is padded to 8 values.
+    const uint64_t groupBytes = numGroups * bitWidth;
+    buffer.extend(groupBytes - (buffer.size() - start));
+    buffer.resize(start + groupBytes);
+  }
+}
+
+// Appends 'values' in the DELTA_BINARY_PACKED encoding with blocks of 128
+// values in 4 miniblocks. The deltas wrap around like in the decoder.
+template <typename T>
+void appendDeltaBinaryPacked(
+    DataBuffer<char>& buffer,
+    const T* values,
+    int32_t numValues) {
+  appendVarint(buffer, kDeltaBlockSize);
+  appendVarint(buffer, kDeltaMiniBlocks);
+  appendVarint(buffer, numValues);
+  appendZigZag(buffer, numValues > 0 ? values[0] : 0);
+  uint64_t deltas[kDeltaBlockSize];
+  for (int32_t i = 1; i < numValues; i += kDeltaBlockSize) {
+    const int32_t numDeltas = std::min(kDeltaBlockSize, numValues - i);
+    int64_t minDelta = std::numeric_limits<int64_t>::max();
+    for (auto j = 0; j < numDeltas; ++j) {
+      deltas[j] = static_cast<uint64_t>(static_cast<int64_t>(values[i + j])) -
+          static_cast<uint64_t>(static_cast<int64_t>(values[i + j - 1]));
+      minDelta = std::min(minDelta, static_cast<int64_t>(deltas[j]));
+    }
+    // The unused deltas of the last block are padded with zeros.
+    std::fill(
+        deltas + numDeltas,
+        deltas + kDeltaBlockSize,
+        static_cast<uint64_t>(minDelta));
+    uint8_t bitWidths[kDeltaMiniBlocks];
+    for (auto miniBlock = 0; miniBlock < kDeltaMiniBlocks; ++miniBlock) {
+      uint64_t bitsSet = 0;
+      for (auto j = miniBlock * kDeltaMiniBlockSize;
+           j < (miniBlock + 1) * kDeltaMiniBlockSize;
+           ++j) {
+        deltas[j] -= static_cast<uint64_t>(minDelta);
+        bitsSet |= deltas[j];
+      }
+      bitWidths[miniBlock] = bitWidth(bitsSet);
+    }
+    appendZigZag(buffer, minDelta);
+    appendBytes(buffer, bitWidths, kDeltaMiniBlocks);
+    const auto numMiniBlocks =
+        (numDeltas + kDeltaMiniBlockSize - 1) / kDeltaMiniBlockSize;
+    for (auto miniBlock = 0; miniBlock < numMiniBlocks; ++miniBlock) {
+      appendBitPacked(
+          buffer,
+          deltas + miniBlock * kDeltaMiniBlockSize,
+          kDeltaMiniBlockSize,
+          bitWidths[miniBlock]);
+    }
+  }
+}
+
+thrift::CompressionCodec::type toThriftCodec(
+    common::CompressionKind compression) {
+  switch (compression) {
+    case common::CompressionKind_NONE:
+      return thrift::CompressionCodec::UNCOMPRESSED;
+    case common::CompressionKind_SNAPPY:
+      return thrift::CompressionCodec::SNAPPY;
+    case common::CompressionKind_GZIP:
+      return thrift::CompressionCodec::GZIP;
+    case common::CompressionKind_ZSTD:
+      return thrift::CompressionCodec::ZSTD;
+    default:
+      VELOX_UNSUPPORTED(
+          "Unsupported compression for the native Parquet writer: {}",
+          compression);
+  }
+}
+
+// Writes a column of the Velox type with the C++ type TInput in the Parquet
+// physical type with the C++ type T. T is bool, int32_t, int64_t, float,
+// double or StringView.
+template <typename TInput, typename T>
+class FlatColumnWriter : public ColumnWriter {
+ public:
+  FlatColumnWriter(
+      const std::string& name,
+      const TypePtr& type,
+      const WriterOptions& options,
+      arrow::util::Codec* codec,
+      memory::MemoryPool& pool)
+      : name_(name),
+        type_(type),
+        dataPageSize_(options.dataPageSize),
+        dictionaryPageSizeLimit_(options.dictionaryPageSizeLimit),
+        enableDictionary_(
+            options.enableDictionary && !std::is_same_v<T, bool>),
+        deltaEncoded_(
+            encoding(options, name) == PageEncoding::kDeltaBinaryPacked),
+        codec_(codec),
+        codecType_(toThriftCodec(options.compression)),
+        bloomFilterFpp_(
+            options.bloomFilterColumns.count(name) ? options.bloomFilterFpp
+                                                   : 0),
+        definitionLevels_(pool),
+        dictionaryIds_(pool),
+        values_(pool),
+        dictionary_(pool),
+        pages_(pool),
+        page_(pool),
+        compressed_(pool),
+        useDictionary_(enableDictionary_) {
+    VELOX_USER_CHECK(
+        bloomFilterFpp_ == 0 || kHasBloomFilter,
+        "Bloom filters are only written for integer and string columns: {}",
+        name);
+  }
+
+  static PageEncoding encoding(
+      const WriterOptions& options,
+      const std::string& name) {
+    auto it = options.columnEncodings.find(name);
+    return it == options.columnEncodings.end() ? PageEncoding::kPlain
+                                               : it->second;
+  }
+
+  thrift::SchemaElement schemaElement() const override {
+    thrift::SchemaElement element;
+    element.__set_name(name_);
+    element.__set_type(parquetType());
+    element.__set_repetition_type(thrift::FieldRepetitionType::OPTIONAL);
+    switch (type_->kind()) {
+      case TypeKind::TINYINT:
+        element.__set_converted_type(thrift::ConvertedType::INT_8);
+        break;
+      case TypeKind::SMALLINT:
+        element.__set_converted_type(thrift::ConvertedType::INT_16);
+        break;
+      case TypeKind::INTEGER:
+        if (type_->isDate()) {
+          element.__set_converted_type(thrift::ConvertedType::DATE);
+        }
+        break;
+      case TypeKind::VARCHAR:
+        element.__set_converted_type(thrift::ConvertedType::UTF8);
+        break;
+      default:
+        break;
+    }
+    return element;
+  }
+
+  void write(const VectorPtr& data) override {
+    decoded_.decode(*data);
+    const auto numRows = data->size();
+    // Values of a dictionary vector are looked up in 'dictionaryMap_' once
+    // per batch.
+    bool useBaseIds = useDictionary_ && !decoded_.isIdentityMapping() &&
+        !decoded_.isConstantMapping() && decoded_.base()->size() <= numRows;
+    if (useBaseIds) {
+      baseIds_.assign(decoded_.base()->size(), kNoId);
+    }
+    for (vector_size_t begin = 0; begin < numRows; begin += kRowsPerCheck) {
+      const auto end = std::min(begin + kRowsPerCheck, numRows);
+      for (auto row = begin; row < end; ++row) {
+        if (decoded_.isNullAt(row)) {
+          definitionLevels_.append(0);
+          ++numPageNulls_;
+          continue;
+        }
+        definitionLevels_.append(1);
+        const auto value = static_cast<T>(decoded_.valueAt<TInput>(row));
+        if (!useDictionary_) {
+          updateStats(value);
+          addBloomFilterHash(value);
+          appendPlain(values_, value);
+          continue;
+        }
+        if (!useBaseIds) {
+          dictionaryIds_.append(dictionaryId(value));
+          continue;
+        }
+        auto& id = baseIds_[decoded_.index(row)];
+        if (id == kNoId) {
+          id = dictionaryId(value);
+        }
+        dictionaryIds_.append(id);
+      }
+      if (useDictionary_ && dictionary_.size() > dictionaryPageSizeLimit_) {
+        // The pages after the dictionary is full are not dictionary encoded.
+        finishPage();
+        useDictionary_ = false;
+        useBaseIds = false;
+      } else if (pageBytes() >= dataPageSize_) {
+        finishPage();
+      }
+    }
+  }
+
+  uint64_t bufferedBytes() const override {
+    return pages_.size() + dictionary_.size() + pageBytes();
+  }
+
+  thrift::ColumnChunk flush(int64_t offset, ::arrow::io::OutputStream& output)
+      override {
+    finishPage();
+    thrift::ColumnMetaData metaData;
+    int64_t dataPageOffset = offset;
+    if (numDictionaryValues_ > 0) {
+      thrift::DictionaryPageHeader dictionaryHeader;
+      dictionaryHeader.__set_num_values(numDictionaryValues_);
+      dictionaryHeader.__set_encoding(thrift::Encoding::PLAIN);
+      thrift::PageHeader header;
+      header.__set_type(thrift::PageType::DICTIONARY_PAGE);
+      header.__set_dictionary_page_header(dictionaryHeader);
+      clearBuffer(page_);
+      appendPage(header, dictionary_, page_);
+      writeBuffer(page_, output);
+      encodings_.insert(thrift::Encoding::PLAIN);
+      metaData.__set_dictionary_page_offset(offset);
+      dataPageOffset += page_.size();
+    }
+    writeBuffer(pages_, output);
+
+    metaData.__set_type(parquetType());
+    metaData.__set_encodings(std::vector<thrift::Encoding::type>(
+        encodings_.begin(), encodings_.end()));
+    metaData.__set_path_in_schema({name_});
+    metaData.__set_codec(codecType_);
+    metaData.__set_num_values(numChunkValues_);
+    metaData.__set_total_uncompressed_size(uncompressedBytes_);
+    metaData.__set_total_compressed_size(
+        dataPageOffset - offset + pages_.size());
+    metaData.__set_data_page_offset(dataPageOffset);
+    metaData.__set_statistics(statistics());
+    thrift::ColumnChunk chunk;
+    chunk.__set_file_offset(offset);
+    chunk.__set_meta_data(metaData);
+    finishBloomFilter();
+    resetChunk();
+    return chunk;
+  }
+
+  std::unique_ptr<BloomFilter> takeBloomFilter() override {
+    return std::move(bloomFilter_);
+  }
+
+ private:
+  static constexpr int32_t kNoId = -1;
+
+  // Key of a value in 'dictionaryMap_'. Floating point values are keyed by
+  // their bits so that NaNs and negative zeros are kept.
+  using Key = std::conditional_t<
+      std::is_same_v<T, StringView>,
+      std::string,
+      std::conditional_t<
+          std::is_same_v<T, float>,
+          uint32_t,
+          std::conditional_t<std::is_same_v<T, double>, uint64_t, T>>>;
+
+  // Bloom filters hash the plain encoding of INT32, INT64 and BYTE_ARRAY
+  // values.
+  static constexpr bool kHasBloomFilter = std::is_same_v<T, int32_t> ||
+      std::is_same_v<T, int64_t> || std::is_same_v<T, StringView>;
+
+  using StatsType =
+      std::conditional_t<std::is_same_v<T, StringView>, std::string, T>;
+
+  static thrift::Type::type parquetType() {
+    if constexpr (std::is_same_v<T, bool>) {
+      return thrift::Type::BOOLEAN;
+    } else if constexpr (std::is_same_v<T, int32_t>) {
+      return thrift::Type::INT32;
+    } else if constexpr (std::is_same_v<T, int64_t>) {
+      return thrift::Type::INT64;
+    } else if constexpr (std::is_same_v<T, float>) {
+      return thrift::Type::FLOAT;
+    } else if constexpr (std::is_same_v<T, double>) {
+      return thrift::Type::DOUBLE;
+    } else {
+      return thrift::Type::BYTE_ARRAY;
+    }
+  }
+
+  // Appends the PLAIN encoding of 'value'. Booleans take a byte each and are
+  // bit packed when the page is finished.
+  static void appendPlain(DataBuffer<char>& buffer, T value) {
+    if constexpr (std::is_same_v<T, StringView>) {
+      const uint32_t length = value.size();
+      appendBytes(buffer, &length, sizeof(length));
+      appendBytes(buffer, value.data(), length);
+    } else if constexpr (std::is_same_v<T, bool>) {
+      buffer.append(value ? 1 : 0);
+    } else {
+      appendBytes(buffer, &value, sizeof(T));
+    }
+  }
+
+  static auto dictionaryKey(T value) {
+    if constexpr (std::is_same_v<T, StringView>) {
+      return std::string_view(value.data(), value.size());
+    } else if constexpr (std::is_floating_point_v<T>) {
+      Key key;
+      memcpy(&key, &value, sizeof(key));
+      return key;
+    } else {
+      return value;
+    }
+  }
+
+  // Returns the id of 'value' in the dictionary of the column chunk and adds
+  // 'value' if it is new.
+  int32_t dictionaryId(T value) {
+    const auto key = dictionaryKey(value);
+    auto it = dictionaryMap_.find(key);
+    if (it != dictionaryMap_.end()) {
+      return it->second;
+    }
+    const int32_t id = numDictionaryValues_++;
+    dictionaryMap_.emplace(Key(key), id);
+    appendPlain(dictionary_, value);
+    updateStats(value);
+    addBloomFilterHash(value);
+    return id;
+  }
+
+  void updateStats(T value) {
+    if constexpr (std::is_floating_point_v<T>) {
+      if (std::isnan(value)) {
+        // The order of NaNs is not defined, so no min and max are written.
+        hasNaN_ = true;
+        return;
+      }
+    }
+    if constexpr (std::is_same_v<T, StringView>) {
+      const std::string_view view(value.data(), value.size());
+      if (!hasMinMax_ || view < std::string_view(min_)) {
+        min_.assign(view);
+      }
+      if (!hasMinMax_ || view > std::string_view(max_)) {
+        max_.assign(view);
+      }
+    } else {
+      min_ = hasMinMax_ ? std::min(min_, value) : value;
+      max_ = hasMinMax_ ? std::max(max_, value) : value;
+    }
+    hasMinMax_ = true;
+  }
+
+  void addBloomFilterHash(T value) {
+    if constexpr (kHasBloomFilter) {
+      if (bloomFilterFpp_ == 0) {
+        return;
+      }
+      if constexpr (std::is_same_v<T, StringView>) {
+        bloomFilterHashes_.insert(
+            BloomFilter::hash(std::string_view(value.data(), value.size())));
+      } else {
+        bloomFilterHashes_.insert(BloomFilter::hash(value));
+      }
+    }
+  }
+
+  // Makes 'bloomFilter_' from the hashes of the distinct values of the column
+  // chunk. The filter is sized for the number of distinct values.
+  void finishBloomFilter() {
+    if (bloomFilterFpp_ == 0) {
+      return;
+    }
+    bloomFilter_ = std::make_unique<BloomFilter>(BloomFilter::optimalNumBytes(
+        bloomFilterHashes_.size(), bloomFilterFpp_));
+    for (const auto hash : bloomFilterHashes_) {
+      bloomFilter_->insertHash(hash);
+    }
+    bloomFilterHashes_.clear();
+  }
+
+  static std::string encodeStat(const StatsType& value) {
+    if constexpr (std::is_same_v<T, StringView>) {
+      return value;
+    } else {
+      return std::string(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+  }
+
+  thrift::Statistics statistics() const {
+    thrift::Statistics stats;
+    stats.__set_null_count(numChunkNulls_);
+    if (hasMinMax_ && !hasNaN_) {
+      stats.__set_min_value(encodeStat(min_));
+      stats.__set_max_value(encodeStat(max_));
+    }
+    return stats;
+  }
+
+  uint64_t pageBytes() const {
+    const uint64_t levelBytes = definitionLevels_.size() / 8;
+    if (useDictionary_) {
+      return levelBytes + dictionaryIds_.size() * dictionaryBitWidth() / 8;
+    }
+    return levelBytes + values_.size();
+  }
+
+  int32_t dictionaryBitWidth() const {
+    return std::max(1, bitWidth(std::max(numDictionaryValues_ - 1, 0)));
+  }
+
+  // Appends the values of the current page in the encoding for pages that are
+  // not dictionary encoded and returns the encoding.
+  thrift::Encoding::type appendValues() {
+    if constexpr (std::is_same_v<T, bool>) {
+      appendBitPacked(
+          page_,
+          reinterpret_cast<const uint8_t*>(values_.data()),
+          values_.size(),
+          1);
+    } else if constexpr (std::is_integral_v<T>) {
+      if (deltaEncoded_) {
+        appendDeltaBinaryPacked(
+            page_,
+            reinterpret_cast<const T*>(values_.data()),
+            values_.size() / sizeof(T));
+        return thrift::Encoding::DELTA_BINARY_PACKED;
+      }
+      appendBytes(page_, values_.data(), values_.size());
+    } else {
+      appendBytes(page_, values_.data(), values_.size());
+    }
+    return thrift::Encoding::PLAIN;
+  }
+
+  // Encodes the pending values into a data page in 'pages_'.
+  void finishPage() {
+    const auto numRows = definitionLevels_.size();
+    if (numRows == 0) {
+      return;
+    }
+    clearBuffer(page_);
+    // V1 data pages start with the byte length of the definition levels.
+    const uint32_t placeholder = 0;
+    appendBytes(page_, &placeholder, sizeof(placeholder));
+    appendRleBp(page_, definitionLevels_.data(), numRows, 1);
+    const uint32_t levelsSize = page_.size() - sizeof(uint32_t);
+    memcpy(page_.data(), &levelsSize, sizeof(levelsSize));
+
+    thrift::Encoding::type encoding;
+    if (useDictionary_ && dictionaryIds_.size() > 0) {
+      const auto bitWidth = dictionaryBitWidth();
+      page_.append(static_cast<char>(bitWidth));
+      appendRleBp(
+          page_, dictionaryIds_.data(), dictionaryIds_.size(), bitWidth);
+      encoding = thrift::Encoding::RLE_DICTIONARY;
+    } else {
+      encoding = appendValues();
+    }
+
+    thrift::DataPageHeader dataHeader;
+    dataHeader.__set_num_values(numRows);
+    dataHeader.__set_encoding(encoding);
+    dataHeader.__set_definition_level_encoding(thrift::Encoding::RLE);
+    dataHeader.__set_repetition_level_encoding(thrift::Encoding::RLE);
+    thrift::PageHeader header;
+    header.__set_type(thrift::PageType::DATA_PAGE);
+    header.__set_data_page_header(dataHeader);
+    appendPage(header, page_, pages_);
+
+    encodings_.insert(encoding);
+    encodings_.insert(thrift::Encoding::RLE);
+    numChunkValues_ += numRows;
+    numChunkNulls_ += numPageNulls_;
+    numPageNulls_ = 0;
+    clearBuffer(definitionLevels_);
+    clearBuffer(dictionaryIds_);
+    clearBuffer(values_);
+  }
+
+  // Compresses 'body' and appends it to 'output' after 'header'.
+  void appendPage(
+      thrift::PageHeader& header,
+      const DataBuffer<char>& body,
+      DataBuffer<char>& output) {
+    const char* data = body.data();
+    int64_t size = body.size();
+    header.__set_uncompressed_page_size(size);
+    if (codec_ != nullptr) {
+      const auto* input = reinterpret_cast<const uint8_t*>(data);
+      const auto maxSize = codec_->MaxCompressedLen(size, input);
+      compressed_.reserve(maxSize);
+      auto result = codec_->Compress(
+          size,
+          input,
+          maxSize,
+          reinterpret_cast<uint8_t*>(compressed_.data()));
+      VELOX_CHECK(
+          result.ok(),
+          "Failed to compress a Parquet page: {}",
+          result.status().ToString());
+      data = compressed_.data();
+      size = result.ValueOrDie();
+    }
+    header.__set_compressed_page_size(size);
+    const auto serialized = serializeThrift(header);
+    appendBytes(output, serialized.data(), serialized.size());
+    appendBytes(output, data, size);
+    uncompressedBytes_ += serialized.size() + body.size();
+  }
+
+  static void writeBuffer(
+      const DataBuffer<char>& buffer,
+      ::arrow::io::OutputStream& output) {
+    const auto status = output.Write(buffer.data(), buffer.size());
+    VELOX_CHECK(
+        status.ok(), "Failed to write a column chunk: {}", status.ToString());
+  }
+
+  void resetChunk() {
+    dictionaryMap_.clear();
+    numDictionaryValues_ = 0;
+    clearBuffer(dictionary_);
+    clearBuffer(pages_);
+    encodings_.clear();
+    numChunkValues_ = 0;
+    numChunkNulls_ = 0;
+    uncompressedBytes_ = 0;
+    hasMinMax_ = false;
+    hasNaN_ = false;
+    useDictionary_ = enableDictionary_;
+  }
+
+  const std::string name_;
+  const TypePtr type_;
+  const int64_t dataPageSize_;
+  const int64_t dictionaryPageSizeLimit_;
+  const bool enableDictionary_;
+  const bool deltaEncoded_;
+  arrow::util::Codec* const codec_;
+  const thrift::CompressionCodec::type codecType_;
+  // The false positive probability of the Bloom filter, 0 if the column has
+  // no Bloom filter.
+  const double bloomFilterFpp_;
+
+  DecodedVector decoded_;
+
+  // Dictionary ids of the distinct values of the base of a dictionary encoded
+  // input, kNoId for the values not seen yet.
+  std::vector<int32_t> baseIds_;
+
+  // Pending rows of the current page. The definition level is 0 for null and
+  // 1 for non-null rows. The non-null values are in 'dictionaryIds_' when the
+  // page is dictionary encoded and PLAIN encoded in 'values_' otherwise.
+  DataBuffer<uint8_t> definitionLevels_;
+  DataBuffer<int32_t> dictionaryIds_;
+  DataBuffer<char> values_;
+  int64_t numPageNulls_{0};
+
+  // The dictionary of the column chunk, PLAIN encoded in 'dictionary_'.
+  folly::F14FastMap<Key, int32_t> dictionaryMap_;
+  DataBuffer<char> dictionary_;
+  int32_t numDictionaryValues_{0};
+
+  // Encoded data pages of the column chunk with their headers.
+  DataBuffer<char> pages_;
+
+  // Scratch for encoding and compressing a page.
+  DataBuffer<char> page_;
+  DataBuffer<char> compressed_;
+
+  // True while the values are added to the dictionary.
+  bool useDictionary_;
+
+  std::set<thrift::Encoding::type> encodings_;
+  int64_t numChunkValues_{0};
+  int64_t numChunkNulls_{0};
+  int64_t uncompressedBytes_{0};
+
+  bool hasMinMax_{false};
+  bool hasNaN_{false};
+  StatsType min_{};
+  StatsType max_{};
+
+  // Hashes of the distinct values of the column chunk for the Bloom filter.
+  folly::F14FastSet<uint64_t> bloomFilterHashes_;
+  std::unique_ptr<BloomFilter> bloomFilter_;
+};
+
+} // namespace
+
+// static
+bool ColumnWriter::isSupported(const TypePtr& type, PageEncoding encoding) {
+  const bool isIntegerEncoding = encoding == PageEncoding::kPlain ||
+      encoding == PageEncoding::kDeltaBinaryPacked;
+  switch (type->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+      return isIntegerEncoding;
+    case TypeKind::INTEGER:
+      return isIntegerEncoding && !type->isIntervalYearMonth();
+    case TypeKind::BIGINT:
+      return isIntegerEncoding && !type->isDecimal() &&
+          !type->isIntervalDayTime();
+    case TypeKind::BOOLEAN:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return encoding == PageEncoding::kPlain;
+    default:
+      return false;
+  }
+}
+
+// static
+std::unique_ptr<ColumnWriter> ColumnWriter::create(
+    const std::string& name,
+    const TypePtr& type,
+    const WriterOptions& options,
+    arrow::util::Codec* codec,
+    memory::MemoryPool& pool) {
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+      return std::make_unique<FlatColumnWriter<bool, bool>>(
+          name, type, options, codec, pool);
+    case TypeKind::TINYINT:
+      return std::make_unique<FlatColumnWriter<int8_t, int32_t>>(
+          name, type, options, codec, pool);
+    case TypeKind::SMALLINT:
+      return std::make_unique<FlatColumnWriter<int16_t, int32_t>>(
+          name, type, options, codec, pool);
+    case TypeKind::INTEGER:
+      return std::make_unique<FlatColumnWriter<int32_t, int32_t>>(
+          name, type, options, codec, pool);
+    case TypeKind::BIGINT:
+      return std::make_unique<FlatColumnWriter<int64_t, int64_t>>(
+          name, type, options, codec, pool);
+    case TypeKind::REAL:
+      return std::make_unique<FlatColumnWriter<float, float>>(
+          name, type, options, codec, pool);
+    case TypeKind::DOUBLE:
+      return std::make_unique<FlatColumnWriter<double, double>>(
+          name, type, options, codec, pool);
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return std::make_unique<FlatColumnWriter<StringView, StringView>>(
+          name, type, options, codec, pool);
+    default:
+      VELOX_UNSUPPORTED(
+          "Native Parquet writer does not support {}", type->toString());
+  }
+}
+
+} // namespace facebook::velox::parquet
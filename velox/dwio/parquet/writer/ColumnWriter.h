@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <arrow/io/interfaces.h>
+
+#include "velox/dwio/parquet/reader/BloomFilter.h"
+#include "velox/dwio/parquet/thrift/ParquetThriftTypes.h"
+#include "velox/dwio/parquet/writer/Writer.h"
+#include "velox/dwio/parquet/writer/arrow/util/Compression.h"
+#include "velox/vector/BaseVector.h"
+
+namespace facebook::velox::parquet {
+
+/// Serializes 'object' with the compact protocol used by Parquet metadata.
+std::string serializeThrift(const apache::thrift::TBase& object);
+
+/// Writes the column chunks of one top level column of a flat schema directly
+/// from Velox vectors, without converting to Arrow. The values are dictionary
+/// encoded until the dictionary exceeds 'dictionaryPageSizeLimit', after which
+/// the remaining pages of the column chunk are PLAIN or DELTA_BINARY_PACKED
+/// encoded. Pages are V1 data pages with RLE encoded definition levels and are
+/// buffered in memory of 'pool' until flush(). A Bloom filter of the distinct
+/// values of each column chunk is built if the column is in
+/// WriterOptions::bloomFilterColumns.
+class ColumnWriter {
+ public:
+  virtual ~ColumnWriter() = default;
+
+  /// Returns true if columns of 'type' with 'encoding' for the pages that are
+  /// not dictionary encoded can be written by a ColumnWriter.
+  static bool isSupported(const TypePtr& type, PageEncoding encoding);
+
+  /// Makes a writer of the column 'name' of 'type'. 'codec' compresses the
+  /// pages and is nullptr for uncompressed pages. 'codec' and 'pool' must
+  /// outlive the writer.
+  static std::unique_ptr<ColumnWriter> create(
+      const std::string& name,
+      const TypePtr& type,
+      const WriterOptions& options,
+      arrow::util::Codec* codec,
+      memory::MemoryPool& pool);
+
+  /// Returns the element of the Parquet schema for the column.
+  virtual thrift::SchemaElement schemaElement() const = 0;
+
+  /// Appends all rows of 'data' to the current column chunk.
+  virtual void write(const VectorPtr& data) = 0;
+
+  /// Returns the bytes of the encoded pages and of the pending values of the
+  /// current column chunk.
+  virtual uint64_t bufferedBytes() const = 0;
+
+  /// Writes the current column chunk to 'output', where it starts at
+  /// 'offset' in the file, and starts a new empty column chunk. Returns the
+  /// metadata of the written column chunk.
+  virtual thrift::ColumnChunk flush(
+      int64_t offset,
+      ::arrow::io::OutputStream& output) = 0;
+
+  /// Returns the Bloom filter of the column chunk written by the last flush()
+  /// or nullptr if the column has no Bloom filter.
+  virtual std::unique_ptr<BloomFilter> takeBloomFilter() = 0;
+};
+
+} // namespace facebook::velox::parquet
@@ -21,6 +21,7 @@
 #include <arrow/table.h>
 
 #include "velox/dwio/parquet/writer/Writer.h"
+#include "velox/dwio/parquet/writer/ColumnWriter.h"
 #include "velox/dwio/parquet/writer/arrow/Properties.h"
 #include "velox/dwio/parquet/writer/arrow/Writer.h"
 
@@ -28,6 +29,7 @@ namespace facebook::velox::parquet {
 
 using facebook::velox::parquet::arrow::ArrowWriterProperties;
 using facebook::velox::parquet::arrow::Compression;
+using facebook::velox::parquet::arrow::Encoding;
 using facebook::velox::parquet::arrow::WriterProperties;
 using facebook::velox::parquet::arrow::arrow::FileWriter;
 
@@ -105,6 +107,22 @@ struct ArrowContext {
   std::vector<std::vector<std::shared_ptr<::arrow::Array>>> stagingChunks;
 };
 
+struct NativeContext {
+  explicit NativeContext(const WriterOptions& options) : options(options) {}
+
+  const WriterOptions options;
+  std::unique_ptr<arrow::util::Codec> codec;
+  std::vector<std::unique_ptr<ColumnWriter>> columns;
+  thrift::FileMetaData fileMetaData;
+  uint64_t stagingRows = 0;
+  int64_t stagingBytes = 0;
+};
+
+namespace {
+constexpr char kParquetMagic[] = "PAR1";
+constexpr int32_t kParquetMagicSize = 4;
+} // namespace
+
 Compression::type getArrowParquetCompression(
     common::CompressionKind compression) {
   if (compression == common::CompressionKind_SNAPPY) {
@@ -122,6 +140,22 @@ Compression::type getArrowParquetCompression(
   }
 }
 
+Encoding::type getArrowParquetEncoding(PageEncoding encoding) {
+  switch (encoding) {
+    case PageEncoding::kPlain:
+      return Encoding::PLAIN;
+    case PageEncoding::kDeltaBinaryPacked:
+      return Encoding::DELTA_BINARY_PACKED;
+    case PageEncoding::kDeltaLengthByteArray:
+      return Encoding::DELTA_LENGTH_BYTE_ARRAY;
+    case PageEncoding::kDeltaByteArray:
+      return Encoding::DELTA_BYTE_ARRAY;
+    case PageEncoding::kByteStreamSplit:
+      return Encoding::BYTE_STREAM_SPLIT;
+  }
+  VELOX_UNREACHABLE();
+}
+
 std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
     const parquet::WriterOptions& options,
     const std::unique_ptr<DefaultFlushPolicy>& flushPolicy) {
@@ -130,6 +164,12 @@ std::shared_ptr<WriterProperties> getArrowParquetWriterOptions(
   if (!options.enableDictionary) {
     properties = properties->disable_dictionary();
   }
+  if (options.enablePageIndex) {
+    properties = properties->enable_write_page_index();
+  }
+  for (const auto& [path, encoding] : options.columnEncodings) {
+    properties = properties->encoding(path, getArrowParquetEncoding(encoding));
+  }
   properties =
       properties->compression(getArrowParquetCompression(options.compression));
   properties = properties->data_pagesize(options.dataPageSize);
@@ -149,6 +189,12 @@ Writer::Writer(
           *generalPool_,
           options.bufferGrowRatio)),
       arrowContext_(std::make_shared<ArrowContext>()) {
+  VELOX_USER_CHECK(
+      options.useNativeWriter || options.bloomFilterColumns.empty(),
+      "Bloom filters are only written by the native Parquet writer");
+  if (options.useNativeWriter) {
+    nativeContext_ = std::make_shared<NativeContext>(options);
+  }
   if (options.flushPolicyFactory) {
     flushPolicy_ = options.flushPolicyFactory();
   } else {
@@ -169,6 +215,10 @@ Writer::Writer(
               folly::to<std::string>(folly::Random::rand64())))} {}
 
 void Writer::flush() {
+  if (nativeContext_) {
+    flushNative();
+    return;
+  }
   if (arrowContext_->stagingRows > 0) {
     if (!arrowContext_->writer) {
       auto arrowProperties = ArrowWriterProperties::Builder().build();
@@ -223,6 +273,17 @@ dwio::common::StripeProgress getStripeProgress(
  * This method assumes each input `ColumnarBatch` have same schema.
  */
 void Writer::write(const VectorPtr& data) {
+  if (nativeContext_ && nativeContext_->columns.empty() &&
+      !initNativeWriter(asRowType(data->type()))) {
+    VELOX_USER_CHECK(
+        nativeContext_->options.bloomFilterColumns.empty(),
+        "Bloom filters are only written by the native Parquet writer");
+    nativeContext_.reset();
+  }
+  if (nativeContext_) {
+    writeNative(data);
+    return;
+  }
   ArrowArray array;
   ArrowSchema schema;
   exportToArrow(data, array, generalPool_.get());
@@ -253,16 +314,140 @@ void Writer::write(const VectorPtr& data) {
   arrowContext_->stagingBytes += bytes;
 }
 
+bool Writer::initNativeWriter(const RowTypePtr& type) {
+  const auto& options = nativeContext_->options;
+  if (type == nullptr || type->size() == 0 || options.enablePageIndex) {
+    return false;
+  }
+  switch (options.compression) {
+    case common::CompressionKind_NONE:
+    case common::CompressionKind_SNAPPY:
+    case common::CompressionKind_GZIP:
+    case common::CompressionKind_ZSTD:
+      break;
+    default:
+      return false;
+  }
+  for (auto i = 0; i < type->size(); ++i) {
+    auto it = options.columnEncodings.find(type->nameOf(i));
+    const auto encoding = it == options.columnEncodings.end()
+        ? PageEncoding::kPlain
+        : it->second;
+    if (!ColumnWriter::isSupported(type->childAt(i), encoding)) {
+      return false;
+    }
+  }
+
+  if (options.compression != common::CompressionKind_NONE) {
+    PARQUET_ASSIGN_OR_THROW(
+        nativeContext_->codec,
+        arrow::util::Codec::Create(
+            getArrowParquetCompression(options.compression)));
+  }
+  auto& fileMetaData = nativeContext_->fileMetaData;
+  fileMetaData.__set_version(1);
+  fileMetaData.__set_created_by("velox");
+  thrift::SchemaElement root;
+  root.__set_name("schema");
+  root.__set_num_children(type->size());
+  fileMetaData.schema.push_back(root);
+  for (auto i = 0; i < type->size(); ++i) {
+    nativeContext_->columns.push_back(ColumnWriter::create(
+        type->nameOf(i),
+        type->childAt(i),
+        options,
+        nativeContext_->codec.get(),
+        *generalPool_));
+    fileMetaData.schema.push_back(
+        nativeContext_->columns.back()->schemaElement());
+  }
+  PARQUET_THROW_NOT_OK(stream_->Write(kParquetMagic, kParquetMagicSize));
+  return true;
+}
+
+void Writer::writeNative(const VectorPtr& data) {
+  auto& context = *nativeContext_;
+  if (flushPolicy_->shouldFlush(
+          getStripeProgress(context.stagingRows, context.stagingBytes))) {
+    flushNative();
+  }
+  const auto* row = data->as<RowVector>();
+  VELOX_CHECK_NOT_NULL(row, "Parquet writer expects a RowVector");
+  for (auto i = 0; i < context.columns.size(); ++i) {
+    context.columns[i]->write(row->childAt(i));
+  }
+  context.stagingRows += data->size();
+  context.stagingBytes += data->estimateFlatSize();
+}
+
+void Writer::flushNative() {
+  auto& context = *nativeContext_;
+  if (context.stagingRows == 0) {
+    return;
+  }
+  PARQUET_ASSIGN_OR_THROW(int64_t offset, stream_->Tell());
+  thrift::RowGroup rowGroup;
+  rowGroup.__set_file_offset(offset);
+  int64_t totalBytes = 0;
+  int64_t totalCompressedBytes = 0;
+  for (auto& column : context.columns) {
+    auto chunk = column->flush(offset, *stream_);
+    offset += chunk.meta_data.total_compressed_size;
+    totalBytes += chunk.meta_data.total_uncompressed_size;
+    totalCompressedBytes += chunk.meta_data.total_compressed_size;
+    rowGroup.columns.push_back(std::move(chunk));
+  }
+  // The Bloom filters of the row group follow its column chunks.
+  for (auto i = 0; i < context.columns.size(); ++i) {
+    auto bloomFilter = context.columns[i]->takeBloomFilter();
+    if (bloomFilter == nullptr) {
+      continue;
+    }
+    PARQUET_ASSIGN_OR_THROW(int64_t bloomFilterOffset, stream_->Tell());
+    const auto serialized = bloomFilter->serialize();
+    PARQUET_THROW_NOT_OK(stream_->Write(serialized.data(), serialized.size()));
+    rowGroup.columns[i].meta_data.__set_bloom_filter_offset(bloomFilterOffset);
+  }
+  rowGroup.__set_total_byte_size(totalBytes);
+  rowGroup.__set_total_compressed_size(totalCompressedBytes);
+  rowGroup.__set_num_rows(context.stagingRows);
+  context.fileMetaData.row_groups.push_back(std::move(rowGroup));
+  context.fileMetaData.num_rows += context.stagingRows;
+  PARQUET_THROW_NOT_OK(stream_->Flush());
+  context.stagingRows = 0;
+  context.stagingBytes = 0;
+}
+
+void Writer::closeNative() {
+  flushNative();
+  if (!nativeContext_->columns.empty()) {
+    const auto footer = serializeThrift(nativeContext_->fileMetaData);
+    const uint32_t footerSize = footer.size();
+    PARQUET_THROW_NOT_OK(stream_->Write(footer.data(), footer.size()));
+    PARQUET_THROW_NOT_OK(stream_->Write(&footerSize, sizeof(footerSize)));
+    PARQUET_THROW_NOT_OK(stream_->Write(kParquetMagic, kParquetMagicSize));
+  }
+  PARQUET_THROW_NOT_OK(stream_->Close());
+}
+
 bool Writer::isCodecAvailable(common::CompressionKind compression) {
   return arrow::util::Codec::IsAvailable(
       getArrowParquetCompression(compression));
 }
 
 void Writer::newRowGroup(int32_t numRows) {
+  if (nativeContext_) {
+    flushNative();
+    return;
+  }
   PARQUET_THROW_NOT_OK(arrowContext_->writer->NewRowGroup(numRows));
 }
 
 void Writer::close() {
+  if (nativeContext_) {
+    closeNative();
+    return;
+  }
   flush();
 
   if (arrowContext_->writer) {
@@ -277,6 +462,7 @@ void Writer::close() {
 void Writer::abort() {
   stream_->abort();
   arrowContext_.reset();
+  nativeContext_.reset();
 }
 
 parquet::WriterOptions getParquetOptions(
@@ -16,6 +16,8 @@
 
 #pragma once
 
+#include <unordered_set>
+
 #include "velox/common/compression/Compression.h"
 #include "velox/dwio/common/DataBuffer.h"
 #include "velox/dwio/common/FileSink.h"
@@ -31,6 +33,8 @@ class ArrowDataBufferSink;
 
 struct ArrowContext;
 
+struct NativeContext;
+
 class DefaultFlushPolicy : public dwio::common::FlushPolicy {
  public:
   DefaultFlushPolicy()
@@ -81,15 +85,45 @@ class LambdaFlushPolicy : public DefaultFlushPolicy {
   std::function<bool()> lambda_;
 };
 
+/// Encodings of the data pages that are not dictionary encoded.
+enum class PageEncoding {
+  kPlain,
+  // INT32 and INT64 columns.
+  kDeltaBinaryPacked,
+  // BYTE_ARRAY columns.
+  kDeltaLengthByteArray,
+  // BYTE_ARRAY and FIXED_LEN_BYTE_ARRAY columns.
+  kDeltaByteArray,
+  // FLOAT and DOUBLE columns.
+  kByteStreamSplit,
+};
+
 struct WriterOptions {
   bool enableDictionary = true;
   int64_t dataPageSize = 1'024 * 1'024;
   int64_t dictionaryPageSizeLimit = 1'024 * 1'024;
+  // Writes the ColumnIndex and OffsetIndex of the data pages, which let
+  // readers skip pages based on filters.
+  bool enablePageIndex = false;
+  // Encodings by dot separated column path, e.g. "a.b", for the pages that are
+  // not dictionary encoded. Columns not listed are PLAIN encoded.
+  std::unordered_map<std::string, PageEncoding> columnEncodings;
+  // Top level columns for which a split block Bloom filter is written per
+  // column chunk. Only integer and string columns of the native writer are
+  // supported.
+  std::unordered_set<std::string> bloomFilterColumns;
+  // The false positive probability the Bloom filters are sized for.
+  double bloomFilterFpp = 0.01;
   // Growth ratio passed to ArrowDataBufferSink. The default value is a
   // heuristic borrowed from
   // folly/FBVector(https://github.com/facebook/folly/blob/main/folly/docs/FBVector.md#memory-handling).
   double bufferGrowRatio = 1.5;
   common::CompressionKind compression = common::CompressionKind_NONE;
+  // Encodes the pages directly from Velox vectors instead of converting them
+  // to Arrow. Applies to schemas of top level boolean, integer, floating
+  // point, string, binary and date columns without page index. Other schemas
+  // use the Arrow writer.
+  bool useNativeWriter = false;
   velox::memory::MemoryPool* memoryPool;
   // The default factory allows the writer to construct the default flush
   // policy with the configs in its ctor.
@@ -132,6 +166,15 @@ class Writer : public dwio::common::Writer {
   void abort() override;
 
  private:
+  // Returns true if 'type' is written with the native column writers.
+  bool initNativeWriter(const RowTypePtr& type);
+
+  void writeNative(const VectorPtr& data);
+
+  void flushNative();
+
+  void closeNative();
+
   // Pool for 'stream_'.
   std::shared_ptr<memory::MemoryPool> pool_;
   std::shared_ptr<memory::MemoryPool> generalPool_;
@@ -141,6 +184,10 @@ class Writer : public dwio::common::Writer {
 
   std::shared_ptr<ArrowContext> arrowContext_;
 
+  // Set if the native writer is requested. Reset on the first write if the
+  // schema is not supported.
+  std::shared_ptr<NativeContext> nativeContext_;
+
   std::unique_ptr<DefaultFlushPolicy> flushPolicy_;
 };
 
@@ -0,0 +1,686 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/text/TextReader.h"
+
+#include <strings.h>
+#include <cctype>
+#include <charconv>
+
+#include <folly/Conv.h>
+
+#if __has_include("simdjson/singleheader/simdjson.h")
+#include "simdjson/singleheader/simdjson.h"
+#else
+#include "simdjson.h"
+#endif
+
+#include "velox/common/base/AsyncSource.h"
+#include "velox/common/base/SimdUtil.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::text {
+
+using dwio::common::FileFormat;
+
+namespace {
+
+// Bytes read from the file at a time.
+constexpr uint64_t kReadSize = 1 << 20;
+
+// Bytes after the data of a buffer. simdjson reads up to this many bytes past
+// the end of a line.
+constexpr uint64_t kPadding = simdjson::SIMDJSON_PADDING;
+
+// Returns the first position of 'byte' in [begin, end) or 'end'.
+const char* findByte(const char* begin, const char* end, char byte) {
+  using Batch = xsimd::batch<uint8_t>;
+  const auto target = Batch::broadcast(static_cast<uint8_t>(byte));
+  auto* position = begin;
+  for (; position + Batch::size <= end; position += Batch::size) {
+    const auto bits = simd::toBitMask(
+        target ==
+        Batch::load_unaligned(reinterpret_cast<const uint8_t*>(position)));
+    if (bits) {
+      return position + __builtin_ctzll(bits);
+    }
+  }
+  for (; position < end; ++position) {
+    if (*position == byte) {
+      return position;
+    }
+  }
+  return end;
+}
+
+// Parses 'size' bytes at 'data' into 'value'. Returns false if these are not
+// a value of type T.
+template <typename T>
+bool parseValue(const char* data, int32_t size, T& value) {
+  if constexpr (std::is_same_v<T, bool>) {
+    if (size == 4 && strncasecmp(data, "true", 4) == 0) {
+      value = true;
+      return true;
+    }
+    if (size == 5 && strncasecmp(data, "false", 5) == 0) {
+      value = false;
+      return true;
+    }
+    return false;
+  } else if constexpr (std::is_integral_v<T>) {
+    if (size > 1 && data[0] == '+') {
+      ++data;
+      --size;
+    }
+    const auto* end = data + size;
+    const auto result = std::from_chars(data, end, value);
+    return result.ec == std::errc() && result.ptr == end;
+  } else if constexpr (std::is_floating_point_v<T>) {
+    const auto result = folly::tryTo<T>(folly::StringPiece(data, size));
+    if (result.hasError()) {
+      return false;
+    }
+    value = result.value();
+    return true;
+  } else {
+    value = StringView(data, size);
+    return true;
+  }
+}
+
+void checkColumnType(const TypePtr& type, const std::string& name) {
+  if (type->isDate() || type->isDecimal() || type->isIntervalDayTime()) {
+    VELOX_NYI(
+        "Text reader does not support column {} of type {}",
+        name,
+        type->toString());
+  }
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return;
+    default:
+      VELOX_NYI(
+          "Text reader does not support column {} of type {}",
+          name,
+          type->toString());
+  }
+}
+
+RowTypePtr checkedFileSchema(
+    FileFormat format,
+    const dwio::common::ReaderOptions& options) {
+  VELOX_CHECK(
+      format == FileFormat::TEXT || format == FileFormat::JSON,
+      "Text reader does not read {} files",
+      dwio::common::toString(format));
+  VELOX_USER_CHECK_NOT_NULL(
+      options.getFileSchema(),
+      "Reading a {} file requires the file schema",
+      dwio::common::toString(format));
+  return options.getFileSchema();
+}
+
+} // namespace
+
+TextReader::TextReader(
+    FileFormat format,
+    std::unique_ptr<dwio::common::BufferedInput> input,
+    const dwio::common::ReaderOptions& options)
+    : input_(std::move(input)),
+      format_(format),
+      serDeOptions_(options.getSerDeOptions()),
+      rowType_(checkedFileSchema(format, options)),
+      typeWithId_(dwio::common::TypeWithId::create(rowType_)),
+      pool_(options.getMemoryPool()) {}
+
+std::unique_ptr<dwio::common::RowReader> TextReader::createRowReader(
+    const dwio::common::RowReaderOptions& options) const {
+  return std::make_unique<TextRowReader>(
+      input_->getReadFile(), format_, serDeOptions_, rowType_, options, pool_);
+}
+
+TextRowReader::TextRowReader(
+    std::shared_ptr<ReadFile> file,
+    FileFormat format,
+    const dwio::common::SerDeOptions& serDeOptions,
+    RowTypePtr rowType,
+    const dwio::common::RowReaderOptions& options,
+    memory::MemoryPool& pool)
+    : file_(std::move(file)),
+      fileSize_(file_->size()),
+      format_(format),
+      serDeOptions_(serDeOptions),
+      rowType_(std::move(rowType)),
+      scanSpec_(options.getScanSpec()),
+      executor_(options.getDecodingExecutor()),
+      pool_(pool),
+      start_(options.getOffset()),
+      end_(options.getLimit()),
+      skipRows_(options.getSkipRows()) {
+  VELOX_CHECK_NOT_NULL(scanSpec_, "Text reader requires a ScanSpec");
+  std::vector<Column> otherColumns;
+  for (const auto& childSpec : scanSpec_->children()) {
+    if (childSpec->isConstant() ||
+        (!childSpec->filter() && !childSpec->projectOut())) {
+      continue;
+    }
+    const auto fileIndex = rowType_->getChildIdx(childSpec->fieldName());
+    checkColumnType(rowType_->childAt(fileIndex), childSpec->fieldName());
+    if (childSpec->filter()) {
+      columns_.push_back({childSpec.get(), fileIndex, 0});
+    } else {
+      otherColumns.push_back({childSpec.get(), fileIndex, 0});
+    }
+  }
+  numFilterColumns_ = columns_.size();
+  columns_.insert(columns_.end(), otherColumns.begin(), otherColumns.end());
+  for (auto i = 0; i < columns_.size(); ++i) {
+    auto& column = columns_[i];
+    column.slot = i;
+    if (format_ == FileFormat::TEXT) {
+      if (fieldSlots_.size() <= column.fileIndex) {
+        fieldSlots_.resize(column.fileIndex + 1, -1);
+      }
+      fieldSlots_[column.fileIndex] = i;
+    } else {
+      jsonSlots_[rowType_->nameOf(column.fileIndex)] = i;
+    }
+  }
+}
+
+void TextRowReader::initialize() {
+  initialized_ = true;
+  data_ = AlignedBuffer::allocate<char>(kReadSize + kPadding, &pool_);
+  if (start_ >= end_ || start_ >= fileSize_) {
+    atEnd_ = true;
+    return;
+  }
+  if (start_ > 0) {
+    // The line that ends at or after 'start_' - 1 belongs to the previous
+    // split.
+    dataOffset_ = start_ - 1;
+    if (!skipLine()) {
+      atEnd_ = true;
+    }
+    return;
+  }
+  for (uint64_t i = 0; i < skipRows_; ++i) {
+    if (!skipLine()) {
+      atEnd_ = true;
+      return;
+    }
+  }
+}
+
+bool TextRowReader::readMore() {
+  const auto readOffset = dataOffset_ + dataSize_;
+  if (readOffset >= fileSize_) {
+    return false;
+  }
+  const auto readSize = std::min(kReadSize, fileSize_ - readOffset);
+  if (dataSize_ + readSize + kPadding > data_->capacity()) {
+    auto newData = AlignedBuffer::allocate<char>(
+        2 * (dataSize_ + readSize) + kPadding, &pool_);
+    ::memcpy(newData->asMutable<char>(), data_->as<char>(), dataSize_);
+    data_ = std::move(newData);
+  }
+  file_->pread(readOffset, readSize, data_->asMutable<char>() + dataSize_);
+  dataSize_ += readSize;
+  return true;
+}
+
+bool TextRowReader::skipLine() {
+  for (;;) {
+    const auto* data = data_->as<char>();
+    const auto* newline = findByte(data + position_, data + dataSize_, '\n');
+    if (newline < data + dataSize_) {
+      position_ = newline - data + 1;
+      return true;
+    }
+    position_ = dataSize_;
+    if (!readMore()) {
+      return false;
+    }
+  }
+}
+
+bool TextRowReader::hasLine() {
+  if (!initialized_) {
+    initialize();
+  }
+  if (atEnd_) {
+    return false;
+  }
+  if (dataOffset_ + position_ >= end_ ||
+      (position_ == dataSize_ && !readMore())) {
+    atEnd_ = true;
+  }
+  return !atEnd_;
+}
+
+bool TextRowReader::readLines(uint64_t maxRows) {
+  lineBegins_.clear();
+  lineEnds_.clear();
+  if (!hasLine()) {
+    return false;
+  }
+  // Moves the unread bytes to a new buffer. The strings of the previous batch
+  // reference the old one.
+  const auto numUnread = dataSize_ - position_;
+  auto newData = AlignedBuffer::allocate<char>(
+      std::max(numUnread, kReadSize) + kPadding, &pool_);
+  ::memcpy(
+      newData->asMutable<char>(), data_->as<char>() + position_, numUnread);
+  data_ = std::move(newData);
+  dataOffset_ += position_;
+  dataSize_ = numUnread;
+  position_ = 0;
+
+  // Position from which to look for the end of the current line.
+  uint64_t scanPosition = 0;
+  while (lineBegins_.size() < maxRows && hasLine()) {
+    const auto* data = data_->as<char>();
+    const auto* newline = findByte(
+        data + std::max(position_, scanPosition), data + dataSize_, '\n');
+    if (newline == data + dataSize_) {
+      scanPosition = dataSize_;
+      if (readMore()) {
+        continue;
+      }
+    }
+    uint64_t lineEnd = newline - data;
+    if (lineEnd > position_ && data[lineEnd - 1] == '\r') {
+      --lineEnd;
+    }
+    lineBegins_.push_back(position_);
+    lineEnds_.push_back(lineEnd);
+    position_ = std::min<uint64_t>(newline - data + 1, dataSize_);
+  }
+  return !lineBegins_.empty();
+}
+
+void TextRowReader::splitTextFields() {
+  const auto numRows = lineBegins_.size();
+  const auto numColumns = columns_.size();
+  fields_.assign(numRows * numColumns, Field{});
+  if (numColumns == 0) {
+    return;
+  }
+  const int32_t maxField = fieldSlots_.size() - 1;
+  const int32_t lastField = rowType_->size() - 1;
+  const char delimiter = serDeOptions_.separators[0];
+  const auto& nullString = serDeOptions_.nullString;
+  const int32_t nullSize = nullString.size();
+  auto* data = data_->asMutable<char>();
+  for (auto row = 0; row < numRows; ++row) {
+    if (serDeOptions_.isEscaped) {
+      splitEscapedLine(row, data + lineBegins_[row], data + lineEnds_[row]);
+      continue;
+    }
+    const auto* begin = data + lineBegins_[row];
+    const auto* end = data + lineEnds_[row];
+    auto* fields = fields_.data() + row * numColumns;
+    for (auto field = 0; field <= maxField; ++field) {
+      const auto* fieldEnd =
+          field == lastField && serDeOptions_.lastColumnTakesRest
+          ? end
+          : findByte(begin, end, delimiter);
+      const auto slot = fieldSlots_[field];
+      const int32_t size = fieldEnd - begin;
+      if (slot >= 0 &&
+          (size != nullSize ||
+           ::memcmp(begin, nullString.data(), nullSize) != 0)) {
+        fields[slot] = Field{begin, size};
+      }
+      if (fieldEnd == end) {
+        break;
+      }
+      begin = fieldEnd + 1;
+    }
+  }
+}
+
+void TextRowReader::splitEscapedLine(int32_t row, char* begin, char* end) {
+  auto* fields = fields_.data() + row * columns_.size();
+  const int32_t maxField = fieldSlots_.size() - 1;
+  const int32_t lastField = rowType_->size() - 1;
+  const char delimiter = serDeOptions_.separators[0];
+  const char escape = serDeOptions_.escapeChar;
+  const auto& nullString = serDeOptions_.nullString;
+  const int32_t nullSize = nullString.size();
+  // Unescapes the fields in place. The unescaped bytes are written at 'out',
+  // which never passes 'position'.
+  auto* position = begin;
+  auto* out = begin;
+  for (auto field = 0;; ++field) {
+    // Hive compares the null string before unescaping.
+    const bool isNull = end - position >= nullSize &&
+        ::memcmp(position, nullString.data(), nullSize) == 0 &&
+        (position + nullSize == end || position[nullSize] == delimiter);
+    auto* fieldBegin = out;
+    if (isNull) {
+      position += nullSize;
+    } else {
+      const bool takesRest =
+          field == lastField && serDeOptions_.lastColumnTakesRest;
+      while (position < end && (takesRest || *position != delimiter)) {
+        if (*position == escape && position + 1 < end) {
+          ++position;
+        }
+        *out++ = *position++;
+      }
+    }
+    const auto slot = fieldSlots_[field];
+    if (slot >= 0 && !isNull) {
+      fields[slot] = Field{fieldBegin, static_cast<int32_t>(out - fieldBegin)};
+    }
+    if (position == end || field == maxField) {
+      return;
+    }
+    ++position;
+  }
+}
+
+void TextRowReader::parseJsonFields() {
+  const auto numRows = lineBegins_.size();
+  const auto numColumns = columns_.size();
+  fields_.assign(numRows * numColumns, Field{});
+  if (numColumns == 0) {
+    return;
+  }
+  // The unescaped strings are no longer than the lines.
+  jsonStrings_ = AlignedBuffer::allocate<char>(
+      lineEnds_.back() - lineBegins_.front(), &pool_);
+  auto* strings = jsonStrings_->asMutable<char>();
+  thread_local simdjson::ondemand::parser parser;
+  const auto* data = data_->as<char>();
+  const auto capacity = data_->capacity();
+  for (auto row = 0; row < numRows; ++row) {
+    auto* fields = fields_.data() + row * numColumns;
+    const auto begin = lineBegins_[row];
+    simdjson::ondemand::document document;
+    simdjson::ondemand::object object;
+    if (parser
+            .iterate(data + begin, lineEnds_[row] - begin, capacity - begin)
+            .get(document) ||
+        document.get_object().get(object)) {
+      continue;
+    }
+    for (auto field : object) {
+      std::string_view key;
+      if (field.unescaped_key().get(key)) {
+        break;
+      }
+      auto it = jsonSlots_.find(key);
+      if (it == jsonSlots_.end()) {
+        continue;
+      }
+      simdjson::ondemand::value value;
+      simdjson::ondemand::json_type type;
+      if (field.value().get(value) || value.type().get(type)) {
+        break;
+      }
+      // Null, object and array values read as null.
+      if (type == simdjson::ondemand::json_type::string) {
+        std::string_view string;
+        if (value.get_string().get(string)) {
+          break;
+        }
+        ::memcpy(strings, string.data(), string.size());
+        fields[it->second] =
+            Field{strings, static_cast<int32_t>(string.size())};
+        strings += string.size();
+      } else if (
+          type == simdjson::ondemand::json_type::number ||
+          type == simdjson::ondemand::json_type::boolean) {
+        auto token = value.raw_json_token();
+        while (!token.empty() && std::isspace(token.back()) != 0) {
+          token.remove_suffix(1);
+        }
+        fields[it->second] =
+            Field{token.data(), static_cast<int32_t>(token.size())};
+      }
+    }
+  }
+}
+
+template <TypeKind kKind>
+void TextRowReader::parseColumnTyped(
+    const Column& column,
+    folly::Range<const vector_size_t*> rows,
+    uint64_t* passed,
+    VectorPtr& result) {
+  using T = typename TypeTraits<kKind>::NativeType;
+  const auto numColumns = columns_.size();
+  const auto* filter = column.spec->filter();
+  const vector_size_t size = passed ? lineBegins_.size() : rows.size();
+  result =
+      BaseVector::create(rowType_->childAt(column.fileIndex), size, &pool_);
+  auto* flat = result->asUnchecked<FlatVector<T>>();
+  if (rows.size() < size) {
+    // The rows that are not parsed are null.
+    bits::fillBits(flat->mutableRawNulls(), 0, size, bits::kNull);
+  }
+  for (auto i = 0; i < rows.size(); ++i) {
+    const auto row = rows[i];
+    const auto index = passed ? row : i;
+    const auto& field = fields_[row * numColumns + column.slot];
+    T value;
+    if (field.data == nullptr || !parseValue(field.data, field.size, value)) {
+      flat->setNull(index, true);
+      if (passed && !filter->testNull()) {
+        bits::clearBit(passed, row);
+      }
+      continue;
+    }
+    if constexpr (std::is_same_v<T, StringView>) {
+      flat->setNoCopy(index, value);
+    } else {
+      flat->set(index, value);
+    }
+    if (passed && !common::applyFilter(*filter, value)) {
+      bits::clearBit(passed, row);
+    }
+  }
+  if constexpr (std::is_same_v<T, StringView>) {
+    flat->addStringBuffer(data_);
+    if (jsonStrings_) {
+      flat->addStringBuffer(jsonStrings_);
+    }
+  }
+}
+
+void TextRowReader::parseColumn(
+    const Column& column,
+    folly::Range<const vector_size_t*> rows,
+    uint64_t* passed,
+    VectorPtr& result) {
+  switch (rowType_->childAt(column.fileIndex)->kind()) {
+    case TypeKind::BOOLEAN:
+      return parseColumnTyped<TypeKind::BOOLEAN>(column, rows, passed, result);
+    case TypeKind::TINYINT:
+      return parseColumnTyped<TypeKind::TINYINT>(column, rows, passed, result);
+    case TypeKind::SMALLINT:
+      return parseColumnTyped<TypeKind::SMALLINT>(
+          column, rows, passed, result);
+    case TypeKind::INTEGER:
+      return parseColumnTyped<TypeKind::INTEGER>(column, rows, passed, result);
+    case TypeKind::BIGINT:
+      return parseColumnTyped<TypeKind::BIGINT>(column, rows, passed, result);
+    case TypeKind::REAL:
+      return parseColumnTyped<TypeKind::REAL>(column, rows, passed, result);
+    case TypeKind::DOUBLE:
+      return parseColumnTyped<TypeKind::DOUBLE>(column, rows, passed, result);
+    case TypeKind::VARCHAR:
+      return parseColumnTyped<TypeKind::VARCHAR>(column, rows, passed, result);
+    case TypeKind::VARBINARY:
+      return parseColumnTyped<TypeKind::VARBINARY>(
+          column, rows, passed, result);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+uint64_t TextRowReader::next(
+    uint64_t size,
+    VectorPtr& result,
+    const dwio::common::Mutation* mutation) {
+  if (!readLines(size)) {
+    return 0;
+  }
+  const vector_size_t numRows = lineBegins_.size();
+  rowNumber_ += numRows;
+  if (format_ == FileFormat::TEXT) {
+    splitTextFields();
+  } else {
+    parseJsonFields();
+  }
+
+  std::vector<uint64_t> passed(bits::nwords(numRows), ~0ULL);
+  if (mutation && mutation->deletedRows) {
+    bits::andWithNegatedBits(
+        passed.data(), mutation->deletedRows, 0, numRows);
+  }
+  raw_vector<vector_size_t> rows(numRows);
+  auto updateRows = [&]() {
+    rows.resize(numRows);
+    rows.resize(
+        simd::indicesOfSetBits(passed.data(), 0, numRows, rows.data()));
+  };
+  std::vector<VectorPtr> values(columns_.size());
+  for (auto i = 0; i < numFilterColumns_; ++i) {
+    updateRows();
+    parseColumn(columns_[i], rows, passed.data(), values[i]);
+  }
+  updateRows();
+  const vector_size_t numPassed = rows.size();
+
+  const auto numOtherColumns = columns_.size() - numFilterColumns_;
+  if (numPassed > 0 && executor_ && numOtherColumns > 1) {
+    folly::Range<const vector_size_t*> passedRows(rows.data(), numPassed);
+    std::vector<std::shared_ptr<AsyncSource<bool>>> parses;
+    for (auto i = numFilterColumns_; i < columns_.size(); ++i) {
+      parses.push_back(std::make_shared<AsyncSource<bool>>(
+          [this, i, passedRows, &values]() {
+            parseColumn(columns_[i], passedRows, nullptr, values[i]);
+            return std::make_unique<bool>(true);
+          }));
+      executor_->add([parse = parses.back()]() { parse->prepare(); });
+    }
+    // Waits for all parses before rethrowing the first error since these
+    // reference 'rows' and 'values'.
+    std::exception_ptr error;
+    for (auto& parse : parses) {
+      try {
+        parse->move();
+      } catch (const std::exception&) {
+        if (!error) {
+          error = std::current_exception();
+        }
+      }
+    }
+    if (error) {
+      std::rethrow_exception(error);
+    }
+  } else if (numPassed > 0) {
+    for (auto i = numFilterColumns_; i < columns_.size(); ++i) {
+      parseColumn(columns_[i], rows, nullptr, values[i]);
+    }
+  }
+
+  // Places the projected columns at their channels like projectColumns().
+  column_index_t numChannels = 0;
+  for (const auto& childSpec : scanSpec_->children()) {
+    if (childSpec->projectOut()) {
+      numChannels = std::max(numChannels, childSpec->channel() + 1);
+    }
+  }
+  std::vector<std::string> names(numChannels);
+  std::vector<TypePtr> types(numChannels);
+  std::vector<VectorPtr> children(numChannels);
+  for (const auto& childSpec : scanSpec_->children()) {
+    if (childSpec->isConstant() && childSpec->projectOut()) {
+      const auto channel = childSpec->channel();
+      names[channel] = childSpec->fieldName();
+      types[channel] = childSpec->constantValue()->type();
+      children[channel] = BaseVector::wrapInConstant(
+          numPassed, 0, childSpec->constantValue());
+    }
+  }
+  BufferPtr indices;
+  if (numPassed > 0 && numPassed < numRows) {
+    indices = allocateIndices(numPassed, &pool_);
+    ::memcpy(
+        indices->asMutable<vector_size_t>(),
+        rows.data(),
+        numPassed * sizeof(vector_size_t));
+  }
+  for (auto i = 0; i < columns_.size(); ++i) {
+    const auto* spec = columns_[i].spec;
+    if (!spec->projectOut()) {
+      continue;
+    }
+    const auto channel = spec->channel();
+    names[channel] = spec->fieldName();
+    types[channel] = rowType_->childAt(columns_[i].fileIndex);
+    if (numPassed == 0) {
+      continue;
+    }
+    // The filter columns have a value for each row of the batch.
+    children[channel] = i < numFilterColumns_ && indices
+        ? BaseVector::wrapInDictionary(
+              nullptr, indices, numPassed, std::move(values[i]))
+        : std::move(values[i]);
+  }
+  auto rowType = ROW(std::move(names), std::move(types));
+  if (numPassed == 0) {
+    result = RowVector::createEmpty(rowType, &pool_);
+  } else {
+    result = std::make_shared<RowVector>(
+        &pool_, rowType, nullptr, numPassed, std::move(children));
+  }
+  return numRows;
+}
+
+int64_t TextRowReader::nextRowNumber() {
+  return hasLine() ? rowNumber_ : kAtEnd;
+}
+
+int64_t TextRowReader::nextReadSize(uint64_t size) {
+  return hasLine() ? size : kAtEnd;
+}
+
+void registerTextReaderFactory() {
+  dwio::common::registerReaderFactory(
+      std::make_shared<TextReaderFactory>(FileFormat::TEXT));
+  dwio::common::registerReaderFactory(
+      std::make_shared<TextReaderFactory>(FileFormat::JSON));
+}
+
+void unregisterTextReaderFactory() {
+  dwio::common::unregisterReaderFactory(FileFormat::TEXT);
+  dwio::common::unregisterReaderFactory(FileFormat::JSON);
+}
+
+} // namespace facebook::velox::text
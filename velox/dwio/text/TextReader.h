@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+
+#include "velox/common/base/RawVector.h"
+#include "velox/common/file/File.h"
+#include "velox/dwio/common/BufferedInput.h"
+#include "velox/dwio/common/Reader.h"
+#include "velox/dwio/common/ReaderFactory.h"
+#include "velox/dwio/common/ScanSpec.h"
+
+namespace facebook::velox::text {
+
+/// Reads delimited text (FileFormat::TEXT) and JSON lines (FileFormat::JSON)
+/// files. These carry no schema, so the columns come from
+/// ReaderOptions::getFileSchema(). Text fields are separated by
+/// SerDeOptions::separators[0], SerDeOptions::nullString reads as null and,
+/// if SerDeOptions::isEscaped, SerDeOptions::escapeChar escapes the next
+/// byte. A JSON line holds an object whose fields match the columns by name.
+/// Like in Hive, values that do not parse as the type of their column and
+/// missing fields read as null.
+///
+/// Supports the columns of types BOOLEAN, TINYINT, SMALLINT, INTEGER, BIGINT,
+/// REAL, DOUBLE, VARCHAR and VARBINARY.
+class TextReader : public dwio::common::Reader {
+ public:
+  TextReader(
+      dwio::common::FileFormat format,
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      const dwio::common::ReaderOptions& options);
+
+  /// The number of rows is only known after reading the file.
+  std::optional<uint64_t> numberOfRows() const override {
+    return std::nullopt;
+  }
+
+  std::unique_ptr<dwio::common::ColumnStatistics> columnStatistics(
+      uint32_t /*index*/) const override {
+    return nullptr;
+  }
+
+  const RowTypePtr& rowType() const override {
+    return rowType_;
+  }
+
+  const std::shared_ptr<const dwio::common::TypeWithId>& typeWithId()
+      const override {
+    return typeWithId_;
+  }
+
+  std::unique_ptr<dwio::common::RowReader> createRowReader(
+      const dwio::common::RowReaderOptions& options = {}) const override;
+
+ private:
+  const std::unique_ptr<dwio::common::BufferedInput> input_;
+  const dwio::common::FileFormat format_;
+  const dwio::common::SerDeOptions serDeOptions_;
+  const RowTypePtr rowType_;
+  const std::shared_ptr<const dwio::common::TypeWithId> typeWithId_;
+  memory::MemoryPool& pool_;
+};
+
+/// Reads the lines of a text or JSON lines file that start in the range of
+/// RowReaderOptions. Like Hadoop's LineRecordReader, a split starting past
+/// the start of the file skips its first partial line, and the last line
+/// starting before the end of the split is read to its end.
+///
+/// A batch finds the line ends and, for text, the field delimiters with SIMD
+/// scans. The columns with filters in the ScanSpec are then parsed and
+/// filtered one at a time, each on the rows passing the previous ones. The
+/// other columns are parsed only for the rows passing all filters, in
+/// parallel on RowReaderOptions::getDecodingExecutor() if set. String values
+/// reference the read buffer without copying.
+class TextRowReader : public dwio::common::RowReader {
+ public:
+  TextRowReader(
+      std::shared_ptr<ReadFile> file,
+      dwio::common::FileFormat format,
+      const dwio::common::SerDeOptions& serDeOptions,
+      RowTypePtr rowType,
+      const dwio::common::RowReaderOptions& options,
+      memory::MemoryPool& pool);
+
+  uint64_t next(
+      uint64_t size,
+      VectorPtr& result,
+      const dwio::common::Mutation* mutation = nullptr) override;
+
+  /// Returns the number of rows read from the split so far. The row numbers
+  /// of a text file are only known relative to the start of the split.
+  int64_t nextRowNumber() override;
+
+  /// Returns 'size' unless at the end of the split. The number of lines left
+  /// is only known after reading them.
+  int64_t nextReadSize(uint64_t size) override;
+
+  void updateRuntimeStats(
+      dwio::common::RuntimeStatistics& /*stats*/) const override {}
+
+  void resetFilterCaches() override {}
+
+  std::optional<size_t> estimatedRowSize() const override {
+    return std::nullopt;
+  }
+
+ private:
+  // The start and size of a field. 'data' is nullptr for a null or missing
+  // field.
+  struct Field {
+    const char* data{nullptr};
+    int32_t size{0};
+  };
+
+  // A non-constant column read from the file.
+  struct Column {
+    const common::ScanSpec* spec;
+    // Index of the column in 'rowType_'.
+    column_index_t fileIndex;
+    // Index of the column in each row of 'fields_'.
+    int32_t slot;
+  };
+
+  // Reads up to 'maxRows' lines into 'lineBegins_' and 'lineEnds_'. Starts a
+  // new buffer for the batch. Returns false at the end of the split.
+  bool readLines(uint64_t maxRows);
+
+  // Positions at the first line of the split and skips the header lines.
+  void initialize();
+
+  // Returns true if a line of the split is left.
+  bool hasLine();
+
+  // Advances past the next line end. Returns false if there is no line left.
+  bool skipLine();
+
+  // Reads more of the file after the end of 'data_', growing 'data_' if
+  // full. Returns false at the end of the file.
+  bool readMore();
+
+  // Fills 'fields_' from the lines of the batch.
+  void splitTextFields();
+  void splitEscapedLine(int32_t row, char* begin, char* end);
+  void parseJsonFields();
+
+  // Parses 'column' for 'rows' into 'result'. If 'passed' is set, applies the
+  // filter of 'column', clears the bits of the failing rows in 'passed' and
+  // sets the values at the row numbers. Otherwise sets values 0, 1, ... for
+  // 'rows'.
+  void parseColumn(
+      const Column& column,
+      folly::Range<const vector_size_t*> rows,
+      uint64_t* passed,
+      VectorPtr& result);
+
+  template <TypeKind kKind>
+  void parseColumnTyped(
+      const Column& column,
+      folly::Range<const vector_size_t*> rows,
+      uint64_t* passed,
+      VectorPtr& result);
+
+  const std::shared_ptr<ReadFile> file_;
+  const uint64_t fileSize_;
+  const dwio::common::FileFormat format_;
+  const dwio::common::SerDeOptions serDeOptions_;
+  const RowTypePtr rowType_;
+  const std::shared_ptr<common::ScanSpec> scanSpec_;
+  const std::shared_ptr<folly::Executor> executor_;
+  memory::MemoryPool& pool_;
+  // The split range. Lines starting in [start_, end_) belong to the split.
+  const uint64_t start_;
+  const uint64_t end_;
+  const uint64_t skipRows_;
+
+  // Filter columns first, then the other projected columns.
+  std::vector<Column> columns_;
+  int32_t numFilterColumns_{0};
+  // Slot of each text field in a row of 'fields_' or -1 if not read.
+  std::vector<int32_t> fieldSlots_;
+  // Column name to slot for JSON lines.
+  folly::F14FastMap<std::string_view, int32_t> jsonSlots_;
+
+  // The bytes of the file from 'dataOffset_' on. A batch starts a new buffer
+  // since its string values reference the buffer.
+  BufferPtr data_;
+  uint64_t dataOffset_{0};
+  uint64_t dataSize_{0};
+  // Position of the next line in 'data_'.
+  uint64_t position_{0};
+  bool initialized_{false};
+  bool atEnd_{false};
+  int64_t rowNumber_{0};
+
+  // Offsets of the lines of the batch in 'data_'.
+  raw_vector<int32_t> lineBegins_;
+  raw_vector<int32_t> lineEnds_;
+  // The fields of the batch, 'columns_.size()' per row.
+  std::vector<Field> fields_;
+  // The unescaped JSON strings of the batch.
+  BufferPtr jsonStrings_;
+};
+
+class TextReaderFactory : public dwio::common::ReaderFactory {
+ public:
+  explicit TextReaderFactory(dwio::common::FileFormat format)
+      : ReaderFactory(format) {}
+
+  std::unique_ptr<dwio::common::Reader> createReader(
+      std::unique_ptr<dwio::common::BufferedInput> input,
+      const dwio::common::ReaderOptions& options) override {
+    return std::make_unique<TextReader>(
+        fileFormat(), std::move(input), options);
+  }
+};
+
+/// Registers the readers of FileFormat::TEXT and FileFormat::JSON.
+void registerTextReaderFactory();
+
+void unregisterTextReaderFactory();
+
+} // namespace facebook::velox::text
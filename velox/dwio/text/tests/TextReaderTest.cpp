@@ -0,0 +1,337 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/dwio/text/TextReader.h"
+
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/TempFilePath.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::text {
+namespace {
+
+using dwio::common::FileFormat;
+
+class TextReaderTest : public testing::Test, public test::VectorTestBase {
+ protected:
+  void SetUp() override {
+    registerTextReaderFactory();
+  }
+
+  void TearDown() override {
+    unregisterTextReaderFactory();
+  }
+
+  void writeFile(const std::string& content) {
+    file_ = exec::test::TempFilePath::create();
+    remove(file_->path.c_str());
+    LocalWriteFile writeFile(file_->path);
+    writeFile.append(content);
+  }
+
+  std::unique_ptr<dwio::common::Reader> makeReader(
+      FileFormat format,
+      const RowTypePtr& schema,
+      const dwio::common::SerDeOptions& serDeOptions = {}) {
+    dwio::common::ReaderOptions options(pool());
+    options.setFileSchema(schema);
+    options.setSerDeOptions(serDeOptions);
+    return dwio::common::getReaderFactory(format)->createReader(
+        std::make_unique<dwio::common::BufferedInput>(
+            std::make_shared<LocalReadFile>(file_->path), *pool()),
+        options);
+  }
+
+  static std::shared_ptr<common::ScanSpec> makeScanSpec(
+      const RowTypePtr& type) {
+    auto spec = std::make_shared<common::ScanSpec>("<root>");
+    spec->addAllChildFields(*type);
+    return spec;
+  }
+
+  // Reads the rows of 'reader' in batches of 'batchSize' and returns these
+  // in one vector or nullptr if there are none.
+  RowVectorPtr readAll(
+      dwio::common::RowReader& reader,
+      uint64_t batchSize = 1'000) {
+    RowVectorPtr result;
+    VectorPtr batch;
+    while (reader.next(batchSize, batch) > 0) {
+      if (result == nullptr) {
+        result = std::static_pointer_cast<RowVector>(
+            BaseVector::create(batch->type(), 0, pool()));
+      }
+      const auto offset = result->size();
+      result->resize(offset + batch->size());
+      result->copy(batch.get(), offset, 0, batch->size());
+    }
+    EXPECT_EQ(reader.nextRowNumber(), dwio::common::RowReader::kAtEnd);
+    return result;
+  }
+
+  RowVectorPtr read(
+      FileFormat format,
+      const RowTypePtr& schema,
+      const std::shared_ptr<common::ScanSpec>& spec,
+      const dwio::common::SerDeOptions& serDeOptions = {}) {
+    auto reader = makeReader(format, schema, serDeOptions);
+    dwio::common::RowReaderOptions options;
+    options.setScanSpec(spec);
+    auto rowReader = reader->createRowReader(options);
+    return readAll(*rowReader);
+  }
+
+  std::shared_ptr<exec::test::TempFilePath> file_;
+};
+
+TEST_F(TextReaderTest, text) {
+  writeFile(
+      "1,a,1.5,true\n"
+      "\\N,bb,\\N,false\n"
+      "x,,2.5e3,t\n"
+      "4,a longer string value\r\n"
+      "5,e,-0.5,FALSE,extra\n"
+      "+6,f,7,true");
+  auto schema = ROW(
+      {"c0", "c1", "c2", "c3"}, {BIGINT(), VARCHAR(), DOUBLE(), BOOLEAN()});
+  auto result = read(
+      FileFormat::TEXT,
+      schema,
+      makeScanSpec(schema),
+      dwio::common::SerDeOptions(','));
+  auto expected = makeRowVector({
+      makeNullableFlatVector<int64_t>(
+          {1, std::nullopt, std::nullopt, 4, 5, 6}),
+      makeFlatVector<std::string>(
+          {"a", "bb", "", "a longer string value", "e", "f"}),
+      makeNullableFlatVector<double>(
+          {1.5, std::nullopt, 2500, std::nullopt, -0.5, 7}),
+      makeNullableFlatVector<bool>(
+          {true, false, std::nullopt, std::nullopt, false, true}),
+  });
+  test::assertEqualVectors(expected, result);
+}
+
+TEST_F(TextReaderTest, escaped) {
+  // The null string is compared before unescaping, so the escaped
+  // backslash in the last line makes a string value.
+  writeFile(
+      "a\\,b,1\n"
+      "\\N,2\n"
+      "\\\\N,3\n");
+  auto schema = ROW({"c0", "c1"}, {VARCHAR(), INTEGER()});
+  dwio::common::SerDeOptions serDeOptions(',', '\2', '\3', '\\', true);
+  auto result =
+      read(FileFormat::TEXT, schema, makeScanSpec(schema), serDeOptions);
+  auto expected = makeRowVector({
+      makeNullableFlatVector<std::string>({"a,b", std::nullopt, "\\N"}),
+      makeFlatVector<int32_t>({1, 2, 3}),
+  });
+  test::assertEqualVectors(expected, result);
+}
+
+TEST_F(TextReaderTest, filter) {
+  std::string content;
+  for (auto i = 0; i < 1'000; ++i) {
+    content +=
+        fmt::format("{}\1s{}\1{}\n", i, i % 7, i % 3 == 0 ? "\\N" : "x");
+  }
+  writeFile(content);
+  auto schema = ROW({"c0", "c1", "c2"}, {BIGINT(), VARCHAR(), VARCHAR()});
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addField("c1", 0);
+  spec->addField("c0", 1)->setFilter(
+      std::make_unique<common::BigintRange>(100, 199, false));
+  spec->getOrCreateChild(common::Subfield("c2"))
+      ->setFilter(std::make_unique<common::IsNull>());
+  spec->addField("p", 2)->setConstantValue(
+      BaseVector::createConstant(VARCHAR(), "p", 1, pool()));
+  auto result = read(FileFormat::TEXT, schema, spec);
+
+  std::vector<std::string> c1;
+  std::vector<int64_t> c0;
+  for (auto i = 100; i < 200; ++i) {
+    if (i % 3 == 0) {
+      c1.push_back(fmt::format("s{}", i % 7));
+      c0.push_back(i);
+    }
+  }
+  auto expected = makeRowVector(
+      {"c1", "c0", "p"},
+      {
+          makeFlatVector<std::string>(c1),
+          makeFlatVector<int64_t>(c0),
+          makeConstant(StringView("p"), c0.size()),
+      });
+  test::assertEqualVectors(expected, result);
+}
+
+TEST_F(TextReaderTest, splits) {
+  std::string content;
+  std::vector<int64_t> values;
+  for (auto i = 0; i < 200; ++i) {
+    // Lines of varying length so that the splits start inside lines and at
+    // line starts.
+    content += fmt::format("{},{}\n", i, std::string(i % 13, 'x'));
+    values.push_back(i);
+  }
+  writeFile(content);
+  auto schema = ROW({"c0", "c1"}, {BIGINT(), VARCHAR()});
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addField("c0", 0);
+  dwio::common::SerDeOptions serDeOptions(',');
+  for (auto splitSize : {1, 7, 64, 1'000, 100'000}) {
+    SCOPED_TRACE(fmt::format("splitSize {}", splitSize));
+    std::vector<int64_t> actual;
+    for (uint64_t start = 0; start < content.size(); start += splitSize) {
+      auto reader = makeReader(FileFormat::TEXT, schema, serDeOptions);
+      dwio::common::RowReaderOptions options;
+      options.setScanSpec(spec);
+      options.range(start, splitSize);
+      auto rowReader = reader->createRowReader(options);
+      auto result = readAll(*rowReader, 10);
+      if (result == nullptr) {
+        continue;
+      }
+      auto* c0 = result->childAt(0)->asFlatVector<int64_t>();
+      for (auto i = 0; i < result->size(); ++i) {
+        actual.push_back(c0->valueAt(i));
+      }
+    }
+    EXPECT_EQ(actual, values);
+  }
+}
+
+TEST_F(TextReaderTest, skipRows) {
+  writeFile("c0\nname\n1\n2\n");
+  auto schema = ROW({"c0"}, {INTEGER()});
+  auto reader = makeReader(FileFormat::TEXT, schema);
+  dwio::common::RowReaderOptions options;
+  options.setScanSpec(makeScanSpec(schema));
+  options.setSkipRows(2);
+  auto rowReader = reader->createRowReader(options);
+  test::assertEqualVectors(
+      makeRowVector({makeFlatVector<int32_t>({1, 2})}), readAll(*rowReader));
+}
+
+TEST_F(TextReaderTest, mutation) {
+  writeFile("0\n1\n2\n3\n4\n");
+  auto schema = ROW({"c0"}, {INTEGER()});
+  auto reader = makeReader(FileFormat::TEXT, schema);
+  dwio::common::RowReaderOptions options;
+  options.setScanSpec(makeScanSpec(schema));
+  auto rowReader = reader->createRowReader(options);
+  std::vector<uint64_t> deletedRows(1);
+  bits::setBit(deletedRows.data(), 1);
+  bits::setBit(deletedRows.data(), 4);
+  dwio::common::Mutation mutation{deletedRows.data()};
+  ASSERT_EQ(rowReader->nextReadSize(10), 10);
+  VectorPtr batch;
+  ASSERT_EQ(rowReader->next(10, batch, &mutation), 5);
+  test::assertEqualVectors(
+      makeRowVector({makeFlatVector<int32_t>({0, 2, 3})}), batch);
+  ASSERT_EQ(rowReader->nextReadSize(10), dwio::common::RowReader::kAtEnd);
+}
+
+TEST_F(TextReaderTest, jsonLines) {
+  writeFile(
+      "{\"a\": 1, \"b\": \"x\\ty\", \"c\": true}\n"
+      "{\"b\": \"long string with \\\"quotes\\\"\", \"a\": null, "
+      "\"d\": [1, 2]}\n"
+      "{\"a\": \"3\", \"c\": {\"nested\": 1}, \"b\": 2.5 }\n"
+      "not json\n"
+      "{\"a\": 5, \"c\": false}");
+  auto schema = ROW({"a", "b", "c"}, {BIGINT(), VARCHAR(), BOOLEAN()});
+  auto result = read(FileFormat::JSON, schema, makeScanSpec(schema));
+  auto expected = makeRowVector({
+      makeNullableFlatVector<int64_t>(
+          {1, std::nullopt, 3, std::nullopt, 5}),
+      makeNullableFlatVector<std::string>(
+          {"x\ty",
+           "long string with \"quotes\"",
+           "2.5",
+           std::nullopt,
+           std::nullopt}),
+      makeNullableFlatVector<bool>(
+          {true, std::nullopt, std::nullopt, std::nullopt, false}),
+  });
+  test::assertEqualVectors(expected, result);
+}
+
+TEST_F(TextReaderTest, jsonLinesFilter) {
+  std::string content;
+  for (auto i = 0; i < 500; ++i) {
+    content += fmt::format("{{\"s\": \"v{}\", \"n\": {}}}\n", i, i);
+  }
+  writeFile(content);
+  auto schema = ROW({"n", "s"}, {INTEGER(), VARCHAR()});
+  auto spec = std::make_shared<common::ScanSpec>("<root>");
+  spec->addField("s", 0);
+  spec->addField("n", 1)->setFilter(
+      std::make_unique<common::BigintRange>(490, 1'000, false));
+  auto result = read(FileFormat::JSON, schema, spec);
+  auto expected = makeRowVector({
+      makeFlatVector<std::string>(
+          10, [](auto row) { return fmt::format("v{}", 490 + row); }),
+      makeFlatVector<int32_t>(10, [](auto row) { return 490 + row; }),
+  });
+  test::assertEqualVectors(expected, result);
+}
+
+TEST_F(TextReaderTest, parallelParse) {
+  std::string content;
+  for (auto i = 0; i < 10'000; ++i) {
+    content += fmt::format("{},{},{},s{}\n", i, i * 2, i * 0.5, i);
+  }
+  writeFile(content);
+  auto schema = ROW(
+      {"c0", "c1", "c2", "c3"}, {INTEGER(), BIGINT(), DOUBLE(), VARCHAR()});
+  auto spec = makeScanSpec(schema);
+  spec->childByName("c0")->setFilter(
+      std::make_unique<common::BigintRange>(0, 9'999, false));
+  auto reader =
+      makeReader(FileFormat::TEXT, schema, dwio::common::SerDeOptions(','));
+  dwio::common::RowReaderOptions options;
+  options.setScanSpec(spec);
+  options.setDecodingExecutor(
+      std::make_shared<folly::CPUThreadPoolExecutor>(4));
+  auto rowReader = reader->createRowReader(options);
+  auto expected = makeRowVector({
+      makeFlatVector<int32_t>(10'000, [](auto row) { return row; }),
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row * 2; }),
+      makeFlatVector<double>(10'000, [](auto row) { return row * 0.5; }),
+      makeFlatVector<std::string>(
+          10'000, [](auto row) { return fmt::format("s{}", row); }),
+  });
+  test::assertEqualVectors(expected, readAll(*rowReader, 1'024));
+}
+
+TEST_F(TextReaderTest, unsupportedType) {
+  writeFile("1\n");
+  auto schema = ROW({"c0"}, {ARRAY(BIGINT())});
+  auto reader = makeReader(FileFormat::TEXT, schema);
+  dwio::common::RowReaderOptions options;
+  options.setScanSpec(makeScanSpec(schema));
+  VELOX_ASSERT_THROW(
+      reader->createRowReader(options),
+      "Text reader does not support column c0 of type ARRAY<BIGINT>");
+}
+
+} // namespace
+} // namespace facebook::velox::text
@@ -168,6 +168,34 @@ class Aggregate {
       const std::vector<VectorPtr>& args,
       bool mayPushdown) = 0;
 
+  // Same as addRawInput() but also provides a dense id for the group of each
+  // row. Used when the grouping keys map to a small array of groups, e.g. a
+  // hash table in array mode. Fixed-width accumulators may override this to
+  // reduce the input into a per-batch array indexed by group id and update
+  // each distinct group once instead of scattering one update per row.
+  // @param groupIds Dense group ids aligned with 'groups'. Rows with the same
+  // id belong to the same group.
+  // @param numGroupIds Upper bound of the ids in 'groupIds'.
+  virtual void addDenseRawInput(
+      char** groups,
+      const uint64_t* /*groupIds*/,
+      int32_t /*numGroupIds*/,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) {
+    addRawInput(groups, rows, args, false);
+  }
+
+  // Same as addIntermediateResults() but also provides dense group ids. See
+  // addDenseRawInput().
+  virtual void addDenseIntermediateResults(
+      char** groups,
+      const uint64_t* /*groupIds*/,
+      int32_t /*numGroupIds*/,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) {
+    addIntermediateResults(groups, rows, args, false);
+  }
+
   // Updates the single partial accumulator from raw input data for global
   // aggregation.
   // @param group Pointer to the start of the group row.
@@ -25,10 +25,29 @@ namespace facebook::velox::exec {
 
 namespace {
 
+// Returns true if the values of 'type' are fixed width, including all the
+// children of a ROW type.
+bool isFixedWidthType(const TypePtr& type) {
+  if (type->kind() == TypeKind::ROW) {
+    for (const auto& child : type->asRow().children()) {
+      if (!isFixedWidthType(child)) {
+        return false;
+      }
+    }
+    return true;
+  }
+  return type->isFixedWidth();
+}
+
 // A generic way to compute any aggregation used as a window function.
 // Creates an Aggregate function object for the window function invocation.
 // At each row, computes the aggregation across all rows from the frameStart
 // to frameEnd boundaries at that row using singleGroup.
+//
+// Sliding frames with a large number of rows are computed using a segment
+// tree of intermediate results if the aggregate has fixed width accumulators
+// and intermediate results. Each row then combines O(log(partition size))
+// intermediate results instead of aggregating all its frame rows.
 class AggregateWindowFunction : public exec::WindowFunction {
  public:
   AggregateWindowFunction(
@@ -97,6 +116,11 @@ class AggregateWindowFunction : public exec::WindowFunction {
     // Constructing a vector of a single result value used for copying from
     // the aggregate to the final result.
     aggregateResultVector_ = BaseVector::create(resultType, 1, pool_);
+
+    auto intermediateType = exec::Aggregate::intermediateType(name, argTypes_);
+    if (aggregate_->isFixedSize() && isFixedWidthType(intermediateType)) {
+      intermediateType_ = intermediateType;
+    }
   }
 
   ~AggregateWindowFunction() {
@@ -112,6 +136,7 @@ class AggregateWindowFunction : public exec::WindowFunction {
     partition_ = partition;
 
     previousFrameMetadata_.reset();
+    segmentTree_.clear();
   }
 
   void apply(
@@ -159,6 +184,9 @@ class AggregateWindowFunction : public exec::WindowFunction {
           rawFrameEnds,
           resultOffset,
           result);
+    } else if (useSegmentTree(frameMetadata)) {
+      segmentTreeAggregation(
+          validRows, rawFrameStarts, rawFrameEnds, resultOffset, result);
     } else {
       fillArgVectors(frameMetadata.firstRow, frameMetadata.lastRow);
       simpleAggregation(
@@ -189,8 +217,18 @@ class AggregateWindowFunction : public exec::WindowFunction {
 
     // Resume incremental aggregation from the prior block.
     bool usePreviousAggregate;
+
+    // Number of valid frames in the block.
+    vector_size_t numFrames;
+
+    // Total number of rows in the valid frames of the block.
+    int64_t numFrameRows;
   };
 
+  // Minimum average number of rows in the frames of a block to compute them
+  // using the segment tree.
+  static constexpr int64_t kSegmentTreeMinFrameSize = 32;
+
   bool handleAllEmptyFrames(
       const SelectivityVector& validRows,
       vector_size_t resultOffset,
@@ -224,7 +262,11 @@ class AggregateWindowFunction : public exec::WindowFunction {
     vector_size_t prevFrameEnds = lastRow;
 
     bool incrementalAggregation = true;
+    vector_size_t numFrames = 0;
+    int64_t numFrameRows = 0;
     validRows.applyToSelected([&](auto i) {
+      ++numFrames;
+      numFrameRows += rawFrameEnds[i] - rawFrameStarts[i] + 1;
       firstRow = std::min(firstRow, rawFrameStarts[i]);
       lastRow = std::max(lastRow, rawFrameEnds[i]);
 
@@ -250,7 +292,19 @@ class AggregateWindowFunction : public exec::WindowFunction {
       }
     }
 
-    return {firstRow, lastRow, incrementalAggregation, usePreviousAggregate};
+    return {
+        firstRow,
+        lastRow,
+        incrementalAggregation,
+        usePreviousAggregate,
+        numFrames,
+        numFrameRows};
+  }
+
+  bool useSegmentTree(const FrameMetadata& frameMetadata) const {
+    return intermediateType_ != nullptr &&
+        frameMetadata.numFrameRows >=
+        kSegmentTreeMinFrameSize * frameMetadata.numFrames;
   }
 
   void fillArgVectors(vector_size_t firstRow, vector_size_t lastRow) {
@@ -311,6 +365,134 @@ class AggregateWindowFunction : public exec::WindowFunction {
     setNullEmptyFramesResults(validRows, resultOffset, result);
   }
 
+  // Builds the segment tree over all the rows of the current partition.
+  // Level 0 holds the intermediate result of each row and each node of level
+  // 'i' combines the nodes '2 * j' and '2 * j + 1' of level 'i - 1'. The top
+  // level has a single node.
+  void buildSegmentTree() {
+    VELOX_CHECK(segmentTree_.empty());
+    const auto numRows = partition_->numRows();
+
+    std::vector<VectorPtr> args(argIndices_.size());
+    for (int i = 0; i < argIndices_.size(); i++) {
+      if (argIndices_[i] == kConstantChannel) {
+        args[i] = BaseVector::wrapInConstant(numRows, 0, argVectors_[i]);
+      } else {
+        args[i] = BaseVector::create(argTypes_[i], numRows, pool_);
+        partition_->extractColumn(argIndices_[i], 0, numRows, 0, args[i]);
+      }
+    }
+
+    // Group rows with the same layout as the single group row, one for each
+    // node of the level being built.
+    const auto groupRowSize = bits::roundUp(
+        singleGroupRowSize_, aggregate_->accumulatorAlignmentSize());
+    auto groupsBuffer =
+        AlignedBuffer::allocate<char>(numRows * groupRowSize, pool_);
+    auto* rawGroups = groupsBuffer->asMutable<char>();
+    std::vector<char*> groups(numRows);
+    std::vector<vector_size_t> groupIndices(numRows);
+    for (auto i = 0; i < numRows; ++i) {
+      groups[i] = rawGroups + i * groupRowSize;
+      groupIndices[i] = i;
+    }
+    std::vector<char*> childGroups(numRows);
+
+    vector_size_t numNodes = numRows;
+    for (;;) {
+      aggregate_->clear();
+      aggregate_->initializeNewGroups(
+          groups.data(), folly::Range(groupIndices.data(), numNodes));
+      if (segmentTree_.empty()) {
+        aggregate_->addRawInput(
+            groups.data(), SelectivityVector(numRows), args, false);
+      } else {
+        const auto& children = segmentTree_.back();
+        for (auto i = 0; i < children->size(); ++i) {
+          childGroups[i] = groups[i / 2];
+        }
+        aggregate_->addIntermediateResults(
+            childGroups.data(),
+            SelectivityVector(children->size()),
+            {children},
+            false);
+      }
+
+      auto level = BaseVector::create(intermediateType_, numNodes, pool_);
+      aggregate_->extractAccumulators(groups.data(), numNodes, &level);
+      aggregate_->destroy(folly::Range(groups.data(), numNodes));
+      segmentTree_.push_back(std::move(level));
+      if (numNodes == 1) {
+        break;
+      }
+      numNodes = (numNodes + 1) / 2;
+    }
+
+    segmentTreeNodes_ =
+        BaseVector::create(intermediateType_, 2 * segmentTree_.size(), pool_);
+    segmentTreeRows_.resize(segmentTreeNodes_->size());
+  }
+
+  void segmentTreeAggregation(
+      const SelectivityVector& validRows,
+      const vector_size_t* frameStartsVector,
+      const vector_size_t* frameEndsVector,
+      vector_size_t resultOffset,
+      const VectorPtr& result) {
+    if (segmentTree_.empty()) {
+      buildSegmentTree();
+    }
+    static auto kSingleGroup = std::vector<vector_size_t>{0};
+
+    // The nodes covering the right end of a frame are found from right to
+    // left. They are collected here to add them in row order after the nodes
+    // covering the left end of the frame.
+    std::vector<std::pair<int32_t, vector_size_t>> rightNodes;
+    rightNodes.reserve(segmentTree_.size());
+
+    validRows.applyToSelected([&](auto i) {
+      // Copies the nodes covering the frame into 'segmentTreeNodes_' in row
+      // order, so that order sensitive aggregates see the rows in order.
+      vector_size_t numNodes = 0;
+      rightNodes.clear();
+      vector_size_t begin = frameStartsVector[i];
+      vector_size_t end = frameEndsVector[i] + 1;
+      for (int32_t level = 0; begin < end; ++level) {
+        if (begin & 1) {
+          segmentTreeNodes_->copy(
+              segmentTree_[level].get(), numNodes++, begin++, 1);
+        }
+        if (end & 1) {
+          rightNodes.emplace_back(level, --end);
+        }
+        begin >>= 1;
+        end >>= 1;
+      }
+      for (auto it = rightNodes.rbegin(); it != rightNodes.rend(); ++it) {
+        segmentTreeNodes_->copy(
+            segmentTree_[it->first].get(), numNodes++, it->second, 1);
+      }
+
+      segmentTreeRows_.clearAll();
+      segmentTreeRows_.setValidRange(0, numNodes, true);
+      segmentTreeRows_.updateBounds();
+
+      aggregate_->clear();
+      aggregate_->initializeNewGroups(&rawSingleGroupRow_, kSingleGroup);
+      aggregateInitialized_ = true;
+
+      BaseVector::prepareForReuse(aggregateResultVector_, 1);
+      aggregate_->addSingleGroupIntermediateResults(
+          rawSingleGroupRow_, segmentTreeRows_, {segmentTreeNodes_}, false);
+      aggregate_->extractValues(
+          &rawSingleGroupRow_, 1, &aggregateResultVector_);
+      result->copy(aggregateResultVector_.get(), resultOffset + i, 0, 1);
+    });
+
+    // Set null values for empty (non valid) frames in the output block.
+    setNullEmptyFramesResults(validRows, resultOffset, result);
+  }
+
   void simpleAggregation(
       const SelectivityVector& validRows,
       vector_size_t minFrame,
@@ -327,9 +509,8 @@ class AggregateWindowFunction : public exec::WindowFunction {
       // This is a very naive algorithm.
       // It evaluates the entire aggregation for each row by iterating over
       // input rows from frameStart to frameEnd in the SelectivityVector.
-      // TODO : Try to re-use previous computations by advancing and retracting
-      // the aggregation based on the frame changes with each row. This would
-      // require adding new APIs to the Aggregate framework.
+      // Large frames of aggregates with fixed width intermediate results are
+      // computed by segmentTreeAggregation() instead.
       aggregate_->clear();
       aggregate_->initializeNewGroups(&rawSingleGroupRow_, kSingleGroup);
       aggregateInitialized_ = true;
@@ -374,6 +555,19 @@ class AggregateWindowFunction : public exec::WindowFunction {
   // Stores metadata about the previous output block of the partition
   // to optimize aggregate computation and reading argument vectors.
   std::optional<FrameMetadata> previousFrameMetadata_;
+
+  // Type of the intermediate results of the aggregate. Null if the segment
+  // tree can't be used for the aggregate.
+  TypePtr intermediateType_;
+
+  // The levels of the segment tree over the current partition rows. Built
+  // lazily by the first block that uses it and cleared on resetPartition().
+  std::vector<VectorPtr> segmentTree_;
+
+  // The segment tree nodes covering the frame of the current row and the
+  // rows selecting them.
+  VectorPtr segmentTreeNodes_;
+  SelectivityVector segmentTreeRows_;
 };
 
 } // namespace
@@ -0,0 +1,230 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/ArrowStreamSink.h"
+
+#include <cerrno>
+
+namespace facebook::velox::exec {
+
+namespace {
+// Private data of an exported ArrowArrayStream.
+struct StreamHolder {
+  std::shared_ptr<ArrowStreamSink> sink;
+  std::string lastError;
+};
+
+// Private data of an exported ArrowArray. Wraps the array exported by the
+// bridge and keeps the sink alive until the array is released.
+struct ArrayHolder {
+  ArrowArray array;
+  std::shared_ptr<ArrowStreamSink> sink;
+};
+
+void releaseArray(ArrowArray* array) {
+  if (!array || !array->release) {
+    return;
+  }
+  auto* holder = static_cast<ArrayHolder*>(array->private_data);
+  holder->array.release(&holder->array);
+  delete holder;
+  array->release = nullptr;
+  array->private_data = nullptr;
+}
+
+StreamHolder* streamHolder(ArrowArrayStream* stream) {
+  return static_cast<StreamHolder*>(stream->private_data);
+}
+} // namespace
+
+ArrowStreamSink::~ArrowStreamSink() {
+  close();
+}
+
+Consumer ArrowStreamSink::consumer() {
+  return [weakSink = weak_from_this()](
+             RowVectorPtr vector, ContinueFuture* future) {
+    if (auto sink = weakSink.lock()) {
+      return sink->enqueue(std::move(vector), future);
+    }
+    // The stream has been released. Drop the output.
+    return BlockingReason::kNotBlocked;
+  };
+}
+
+void ArrowStreamSink::setTask(
+    std::shared_ptr<Task> task,
+    int32_t numProducers) {
+  std::lock_guard<std::mutex> l(mutex_);
+  task_ = std::move(task);
+  numProducers_ = numProducers;
+  if (consumerBlocked_) {
+    consumerBlocked_ = false;
+    consumerPromise_.setValue();
+  }
+}
+
+BlockingReason ArrowStreamSink::enqueue(
+    RowVectorPtr vector,
+    ContinueFuture* future) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (!vector) {
+    ++numProducersFinished_;
+  } else if (!closed_) {
+    const auto bytes = vector->retainedSize();
+    queue_.push_back({std::move(vector), bytes});
+    bufferedBytes_ += bytes;
+  }
+  if (consumerBlocked_) {
+    consumerBlocked_ = false;
+    consumerPromise_.setValue();
+  }
+  if (closed_ || bufferedBytes_ <= maxBufferedBytes_) {
+    return BlockingReason::kNotBlocked;
+  }
+  auto [promise, unblockFuture] =
+      makeVeloxContinuePromiseContract("ArrowStreamSink::enqueue");
+  producerPromises_.push_back(std::move(promise));
+  *future = std::move(unblockFuture);
+  return BlockingReason::kWaitForConsumer;
+}
+
+RowVectorPtr ArrowStreamSink::next() {
+  for (;;) {
+    RowVectorPtr vector;
+    std::vector<ContinuePromise> mayContinue;
+    std::shared_ptr<Task> task;
+    ContinueFuture consumerFuture;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      task = task_;
+      if (!queue_.empty()) {
+        auto entry = std::move(queue_.front());
+        queue_.pop_front();
+        bufferedBytes_ -= entry.bytes;
+        vector = std::move(entry.vector);
+        if (bufferedBytes_ < maxBufferedBytes_ / 2) {
+          mayContinue = std::move(producerPromises_);
+        }
+      } else if (
+          closed_ ||
+          (numProducers_.has_value() &&
+           numProducersFinished_ >= numProducers_.value())) {
+        atEnd_ = true;
+      } else {
+        consumerBlocked_ = true;
+        consumerPromise_ = ContinuePromise("ArrowStreamSink::next");
+        consumerFuture = consumerPromise_.getSemiFuture();
+      }
+    }
+    // Outside of 'mutex_'.
+    for (auto& promise : mayContinue) {
+      promise.setValue();
+    }
+    if (task && task->error()) {
+      std::rethrow_exception(task->error());
+    }
+    if (vector || atEnd_) {
+      return vector;
+    }
+    consumerFuture.wait();
+  }
+}
+
+void ArrowStreamSink::close() {
+  std::vector<ContinuePromise> promises;
+  std::shared_ptr<Task> task;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    if (closed_) {
+      return;
+    }
+    closed_ = true;
+    queue_.clear();
+    bufferedBytes_ = 0;
+    promises = std::move(producerPromises_);
+    if (!atEnd_) {
+      task = task_;
+    }
+  }
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  if (task && task->isRunning()) {
+    task->requestCancel();
+  }
+}
+
+void ArrowStreamSink::exportNext(ArrowArray& out) {
+  auto vector = next();
+  if (!vector) {
+    // End of stream.
+    out.release = nullptr;
+    return;
+  }
+  auto holder = std::make_unique<ArrayHolder>();
+  velox::exportToArrow(vector, holder->array, pool_.get(), options_);
+  holder->sink = shared_from_this();
+  out = holder->array;
+  out.private_data = holder.release();
+  out.release = releaseArray;
+}
+
+// static
+void ArrowStreamSink::exportToArrow(
+    const std::shared_ptr<ArrowStreamSink>& sink,
+    ArrowArrayStream& stream) {
+  stream.get_schema = [](ArrowArrayStream* stream, ArrowSchema* out) {
+    auto* holder = streamHolder(stream);
+    try {
+      velox::exportToArrow(
+          BaseVector::create(
+              holder->sink->outputType_, 0, holder->sink->pool_.get()),
+          *out,
+          holder->sink->options_);
+      return 0;
+    } catch (const std::exception& e) {
+      holder->lastError = e.what();
+      return EINVAL;
+    }
+  };
+  stream.get_next = [](ArrowArrayStream* stream, ArrowArray* out) {
+    auto* holder = streamHolder(stream);
+    try {
+      holder->sink->exportNext(*out);
+      return 0;
+    } catch (const std::exception& e) {
+      holder->lastError = e.what();
+      return EIO;
+    }
+  };
+  stream.get_last_error = [](ArrowArrayStream* stream) -> const char* {
+    auto* holder = streamHolder(stream);
+    return holder->lastError.empty() ? nullptr : holder->lastError.c_str();
+  };
+  stream.release = [](ArrowArrayStream* stream) {
+    if (!stream || !stream->release) {
+      return;
+    }
+    auto* holder = streamHolder(stream);
+    holder->sink->close();
+    delete holder;
+    stream->release = nullptr;
+    stream->private_data = nullptr;
+  };
+  stream.private_data = new StreamHolder{sink, {}};
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <deque>
+
+#include "velox/exec/Task.h"
+#include "velox/vector/arrow/Abi.h"
+#include "velox/vector/arrow/Bridge.h"
+
+namespace facebook::velox::exec {
+
+/// Exposes the output of a Task as an ArrowArrayStream. This is the
+/// counterpart of the ArrowStream source operator.
+///
+/// consumer() is passed to Task::create(). Output batches are queued as is and
+/// exported with the Arrow bridge when the stream consumer asks for them, so
+/// no copy is made beyond what the Arrow layout requires. Producers are
+/// blocked while more than 'maxBufferedBytes' are queued.
+///
+/// Example usage:
+///
+///   auto sink = std::make_shared<ArrowStreamSink>(outputType);
+///   auto task = Task::create(id, plan, 0, queryCtx, sink->consumer());
+///   Task::start(task, maxDrivers);
+///   sink->setTask(task, task->numOutputDrivers());
+///   ArrowArrayStream stream;
+///   ArrowStreamSink::exportToArrow(sink, stream);
+///
+/// The stream and every array it returns keep the sink and the task alive, as
+/// the exported vectors are allocated from the memory pools of the task.
+/// Releasing the stream before the end cancels the task.
+class ArrowStreamSink : public std::enable_shared_from_this<ArrowStreamSink> {
+ public:
+  explicit ArrowStreamSink(
+      RowTypePtr outputType,
+      uint64_t maxBufferedBytes = 32 << 20,
+      ArrowOptions options = {})
+      : pool_(memory::addDefaultLeafMemoryPool()),
+        outputType_(std::move(outputType)),
+        maxBufferedBytes_(maxBufferedBytes),
+        options_(options) {}
+
+  ~ArrowStreamSink();
+
+  /// Returns the consumer to pass to Task::create(). Holds a weak reference to
+  /// 'this'.
+  Consumer consumer();
+
+  /// Sets the task that produces the output and the number of its drivers that
+  /// feed the consumer. The stream ends when all of these have finished.
+  void setTask(std::shared_ptr<Task> task, int32_t numProducers);
+
+  /// Returns the next output batch. Blocks until there is one. Returns nullptr
+  /// at the end of the output. Throws the error of the task if it failed.
+  RowVectorPtr next();
+
+  /// Stops accepting batches, unblocks producers and cancels the task if it
+  /// has not finished.
+  void close();
+
+  /// Exports 'sink' as an ArrowArrayStream.
+  static void exportToArrow(
+      const std::shared_ptr<ArrowStreamSink>& sink,
+      ArrowArrayStream& stream);
+
+ private:
+  struct Entry {
+    RowVectorPtr vector;
+    uint64_t bytes;
+  };
+
+  BlockingReason enqueue(RowVectorPtr vector, ContinueFuture* future);
+
+  // Exports the next batch to 'out'. Marks 'out' released at the end.
+  void exportNext(ArrowArray& out);
+
+  // Used for allocations made by the export. Owned by the sink, as the
+  // exported arrays keep the sink alive.
+  const std::shared_ptr<memory::MemoryPool> pool_;
+  const RowTypePtr outputType_;
+  const uint64_t maxBufferedBytes_;
+  const ArrowOptions options_;
+
+  std::mutex mutex_;
+  // Declared before 'queue_' so that the queued vectors are freed before the
+  // pools of the task.
+  std::shared_ptr<Task> task_;
+  std::deque<Entry> queue_;
+  std::optional<int32_t> numProducers_;
+  int32_t numProducersFinished_{0};
+  uint64_t bufferedBytes_{0};
+  std::vector<ContinuePromise> producerPromises_;
+  bool consumerBlocked_{false};
+  ContinuePromise consumerPromise_;
+  bool atEnd_{false};
+  bool closed_{false};
+};
+
+} // namespace facebook::velox::exec
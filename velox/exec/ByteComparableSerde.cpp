@@ -0,0 +1,614 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/ByteComparableSerde.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "velox/common/base/Exceptions.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+
+// Markers before each field of a row and each element of an array. The end
+// of an array sorts before any element so that an array sorts after its
+// prefixes. A null sorts after any value.
+constexpr char kEnd = 0;
+constexpr char kValue = 1;
+constexpr char kNull = 2;
+
+// A string ends with a zero byte followed by kEnd. A zero byte inside a
+// string is written as a zero byte followed by kEscapedZero.
+constexpr char kEscapedZero = static_cast<char>(0xff);
+
+template <typename T>
+struct UnsignedOf {
+  using type = std::make_unsigned_t<T>;
+};
+
+template <>
+struct UnsignedOf<int128_t> {
+  using type = uint128_t;
+};
+
+template <typename U>
+void appendBigEndian(U value, std::string& out) {
+  for (int32_t shift = (sizeof(U) - 1) * 8; shift >= 0; shift -= 8) {
+    out.push_back(static_cast<char>(value >> shift));
+  }
+}
+
+template <typename U>
+U readBigEndian(const char*& data) {
+  U value = 0;
+  for (auto i = 0; i < sizeof(U); ++i) {
+    value = (value << 8) | static_cast<uint8_t>(data[i]);
+  }
+  data += sizeof(U);
+  return value;
+}
+
+// Floating point values are written as their bits with the sign bit flipped
+// for positive values and all bits flipped for negative ones. NaNs are
+// written as the same NaN, which sorts after infinity, and -0.0 as 0.0.
+template <typename T>
+using FloatBits = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+
+template <typename T>
+void serializeScalar(T value, std::string& out) {
+  if constexpr (std::is_same_v<T, bool>) {
+    out.push_back(value ? 1 : 0);
+  } else if constexpr (std::is_floating_point_v<T>) {
+    using U = FloatBits<T>;
+    constexpr U kSign = U(1) << (sizeof(U) * 8 - 1);
+    if (std::isnan(value)) {
+      value = std::numeric_limits<T>::quiet_NaN();
+    } else if (value == 0) {
+      value = 0;
+    }
+    U bits;
+    std::memcpy(&bits, &value, sizeof(T));
+    appendBigEndian<U>((bits & kSign) ? ~bits : bits | kSign, out);
+  } else if constexpr (std::is_same_v<T, Timestamp>) {
+    serializeScalar<int64_t>(value.getSeconds(), out);
+    appendBigEndian<uint64_t>(value.getNanos(), out);
+  } else {
+    using U = typename UnsignedOf<T>::type;
+    constexpr U kSign = U(1) << (sizeof(U) * 8 - 1);
+    appendBigEndian<U>(static_cast<U>(value) ^ kSign, out);
+  }
+}
+
+template <typename T>
+T deserializeScalar(const char*& data) {
+  if constexpr (std::is_same_v<T, bool>) {
+    return *data++ != 0;
+  } else if constexpr (std::is_floating_point_v<T>) {
+    using U = FloatBits<T>;
+    constexpr U kSign = U(1) << (sizeof(U) * 8 - 1);
+    auto bits = readBigEndian<U>(data);
+    bits = (bits & kSign) ? bits ^ kSign : ~bits;
+    T value;
+    std::memcpy(&value, &bits, sizeof(T));
+    return value;
+  } else if constexpr (std::is_same_v<T, Timestamp>) {
+    auto seconds = deserializeScalar<int64_t>(data);
+    return Timestamp(seconds, readBigEndian<uint64_t>(data));
+  } else {
+    using U = typename UnsignedOf<T>::type;
+    constexpr U kSign = U(1) << (sizeof(U) * 8 - 1);
+    return static_cast<T>(readBigEndian<U>(data) ^ kSign);
+  }
+}
+
+void serializeString(StringView value, std::string& out) {
+  const auto* data = value.data();
+  for (auto i = 0; i < value.size(); ++i) {
+    out.push_back(data[i]);
+    if (data[i] == 0) {
+      out.push_back(kEscapedZero);
+    }
+  }
+  out.push_back(0);
+  out.push_back(kEnd);
+}
+
+// Returns the number of bytes of the serialized string at 'data', including
+// the terminator.
+int32_t serializedStringSize(const char* data) {
+  int32_t size = 0;
+  for (;;) {
+    if (data[size] == 0) {
+      if (data[size + 1] == kEnd) {
+        return size + 2;
+      }
+      size += 2;
+    } else {
+      ++size;
+    }
+  }
+}
+
+// Returns the number of bytes of the serialized scalar at 'data'.
+int32_t serializedScalarSize(TypeKind kind, const char* data) {
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+      return 1;
+    case TypeKind::SMALLINT:
+      return 2;
+    case TypeKind::INTEGER:
+    case TypeKind::REAL:
+      return 4;
+    case TypeKind::BIGINT:
+    case TypeKind::DOUBLE:
+      return 8;
+    case TypeKind::HUGEINT:
+    case TypeKind::TIMESTAMP:
+      return 16;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return serializedStringSize(data);
+    default:
+      VELOX_UNSUPPORTED(
+          "Unsupported type in ByteComparableSerde: {}",
+          mapTypeKindToName(kind));
+  }
+}
+
+// Copy from vector to string.
+void serializeSwitch(
+    const BaseVector& source,
+    vector_size_t index,
+    std::string& out);
+
+template <TypeKind Kind>
+void serializeOne(
+    const BaseVector& vector,
+    vector_size_t index,
+    std::string& out) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  auto value = vector.asUnchecked<SimpleVector<T>>()->valueAt(index);
+  if constexpr (std::is_same_v<T, StringView>) {
+    serializeString(value, out);
+  } else {
+    serializeScalar<T>(value, out);
+  }
+}
+
+template <>
+void serializeOne<TypeKind::ROW>(
+    const BaseVector& vector,
+    vector_size_t index,
+    std::string& out) {
+  auto row = vector.wrappedVector()->asUnchecked<RowVector>();
+  auto wrappedIndex = vector.wrappedIndex(index);
+  // The layout is given by the type, not the instance. Missing children come
+  // out as null in deserialization.
+  auto childrenSize = row->type()->size();
+  const auto& children = row->children();
+  for (auto i = 0; i < childrenSize; ++i) {
+    if (i >= children.size() || !children[i] ||
+        children[i]->isNullAt(wrappedIndex)) {
+      out.push_back(kNull);
+    } else {
+      out.push_back(kValue);
+      serializeSwitch(*children[i], wrappedIndex, out);
+    }
+  }
+}
+
+void serializeElement(
+    const BaseVector& elements,
+    vector_size_t index,
+    std::string& out) {
+  if (elements.isNullAt(index)) {
+    out.push_back(kNull);
+  } else {
+    out.push_back(kValue);
+    serializeSwitch(elements, index, out);
+  }
+}
+
+void serializeArray(
+    const BaseVector& elements,
+    vector_size_t offset,
+    vector_size_t size,
+    std::string& out) {
+  for (auto i = 0; i < size; ++i) {
+    serializeElement(elements, offset + i, out);
+  }
+  out.push_back(kEnd);
+}
+
+void serializeArray(
+    const BaseVector& elements,
+    folly::Range<const vector_size_t*> indices,
+    std::string& out) {
+  for (auto index : indices) {
+    serializeElement(elements, index, out);
+  }
+  out.push_back(kEnd);
+}
+
+template <>
+void serializeOne<TypeKind::ARRAY>(
+    const BaseVector& vector,
+    vector_size_t index,
+    std::string& out) {
+  auto array = vector.wrappedVector()->asUnchecked<ArrayVector>();
+  auto wrappedIndex = vector.wrappedIndex(index);
+  serializeArray(
+      *array->elements(),
+      array->offsetAt(wrappedIndex),
+      array->sizeAt(wrappedIndex),
+      out);
+}
+
+template <>
+void serializeOne<TypeKind::MAP>(
+    const BaseVector& vector,
+    vector_size_t index,
+    std::string& out) {
+  auto map = vector.wrappedVector()->asUnchecked<MapVector>();
+  auto wrappedIndex = vector.wrappedIndex(index);
+  auto indices = map->sortedKeyIndices(wrappedIndex);
+  folly::Range<const vector_size_t*> range(indices.data(), indices.size());
+  serializeArray(*map->mapKeys(), range, out);
+  serializeArray(*map->mapValues(), range, out);
+}
+
+void serializeSwitch(
+    const BaseVector& source,
+    vector_size_t index,
+    std::string& out) {
+  VELOX_DYNAMIC_TYPE_DISPATCH(
+      serializeOne, source.typeKind(), source, index, out);
+}
+
+// Advances 'data' past the serialized value of 'type'.
+void skipValue(const char*& data, const Type* type) {
+  switch (type->kind()) {
+    case TypeKind::ROW:
+      for (auto i = 0; i < type->size(); ++i) {
+        if (*data++ == kValue) {
+          skipValue(data, type->childAt(i).get());
+        }
+      }
+      return;
+    case TypeKind::ARRAY:
+    case TypeKind::MAP:
+      for (auto i = 0; i < type->size(); ++i) {
+        for (auto marker = *data++; marker != kEnd; marker = *data++) {
+          if (marker == kValue) {
+            skipValue(data, type->childAt(i).get());
+          }
+        }
+      }
+      return;
+    default:
+      data += serializedScalarSize(type->kind(), data);
+  }
+}
+
+// Returns the number of elements of the serialized array at 'data'.
+vector_size_t countElements(const char* data, const Type* elementType) {
+  vector_size_t count = 0;
+  for (auto marker = *data++; marker != kEnd; marker = *data++) {
+    if (marker == kValue) {
+      skipValue(data, elementType);
+    }
+    ++count;
+  }
+  return count;
+}
+
+// Copy from string to vector.
+void deserializeSwitch(
+    const char*& data,
+    vector_size_t index,
+    BaseVector& result);
+
+template <TypeKind Kind>
+void deserializeOne(
+    const char*& data,
+    vector_size_t index,
+    BaseVector& result) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  // Check that the vector is writable. This is faster than dynamic_cast.
+  VELOX_CHECK_EQ(result.encoding(), VectorEncoding::Simple::FLAT);
+  result.asUnchecked<FlatVector<T>>()->set(index, deserializeScalar<T>(data));
+}
+
+void deserializeString(
+    const char*& data,
+    vector_size_t index,
+    BaseVector& result) {
+  VELOX_CHECK_EQ(result.encoding(), VectorEncoding::Simple::FLAT);
+  auto values = result.asUnchecked<FlatVector<StringView>>();
+  // The serialization is at least as long as the string.
+  auto maxSize = serializedStringSize(data);
+  auto buffer = values->getBufferWithSpace(maxSize);
+  auto start = buffer->asMutable<char>() + buffer->size();
+  int32_t size = 0;
+  for (;;) {
+    if (*data == 0) {
+      if (data[1] == kEnd) {
+        data += 2;
+        break;
+      }
+      start[size++] = 0;
+      data += 2;
+    } else {
+      start[size++] = *data++;
+    }
+  }
+  // If the string is not inlined in string view, we need to advance the buffer.
+  if (!StringView::isInline(size)) {
+    buffer->setSize(buffer->size() + size);
+  }
+  values->setNoCopy(index, StringView(start, size));
+}
+
+template <>
+void deserializeOne<TypeKind::VARCHAR>(
+    const char*& data,
+    vector_size_t index,
+    BaseVector& result) {
+  deserializeString(data, index, result);
+}
+
+template <>
+void deserializeOne<TypeKind::VARBINARY>(
+    const char*& data,
+    vector_size_t index,
+    BaseVector& result) {
+  deserializeString(data, index, result);
+}
+
+template <>
+void deserializeOne<TypeKind::ROW>(
+    const char*& data,
+    vector_size_t index,
+    BaseVector& result) {
+  VELOX_CHECK_EQ(result.encoding(), VectorEncoding::Simple::ROW);
+  auto row = result.asUnchecked<RowVector>();
+  auto childrenSize = row->type()->size();
+  VELOX_CHECK_EQ(childrenSize, row->childrenSize());
+  for (auto i = 0; i < childrenSize; ++i) {
+    auto& child = row->childAt(i);
+    if (child->size() <= index) {
+      child->resize(index + 1);
+    }
+    if (*data++ == kNull) {
+      child->setNull(index, true);
+    } else {
+      deserializeSwitch(data, index, *child);
+    }
+  }
+  result.setNull(index, false);
+}
+
+// Deserializes the array at 'data', appending to the end of 'elements'.
+// Returns the number of added elements and sets 'offset' to the index of the
+// first added element.
+vector_size_t deserializeArray(
+    const char*& data,
+    BaseVector& elements,
+    vector_size_t& offset) {
+  auto size = countElements(data, elements.type().get());
+  offset = elements.size();
+  elements.resize(offset + size);
+  for (auto i = 0; i < size; ++i) {
+    if (*data++ == kNull) {
+      elements.setNull(offset + i, true);
+    } else {
+      deserializeSwitch(data, offset + i, elements);
+    }
+  }
+  VELOX_DCHECK_EQ(*data, kEnd);
+  ++data;
+  return size;
+}
+
+template <>
+void deserializeOne<TypeKind::ARRAY>(
+    const char*& data,
+    vector_size_t index,
+    BaseVector& result) {
+  VELOX_CHECK_EQ(result.encoding(), VectorEncoding::Simple::ARRAY);
+  auto array = result.asUnchecked<ArrayVector>();
+  if (array->size() <= index) {
+    array->resize(index + 1);
+  }
+  vector_size_t offset;
+  auto size = deserializeArray(data, *array->elements(), offset);
+  array->setOffsetAndSize(index, offset, size);
+  result.setNull(index, false);
+}
+
+template <>
+void deserializeOne<TypeKind::MAP>(
+    const char*& data,
+    vector_size_t index,
+    BaseVector& result) {
+  VELOX_CHECK_EQ(result.encoding(), VectorEncoding::Simple::MAP);
+  auto map = result.asUnchecked<MapVector>();
+  if (map->size() <= index) {
+    map->resize(index + 1);
+  }
+  vector_size_t keyOffset;
+  auto keySize = deserializeArray(data, *map->mapKeys(), keyOffset);
+  vector_size_t valueOffset;
+  auto valueSize = deserializeArray(data, *map->mapValues(), valueOffset);
+  VELOX_CHECK_EQ(keySize, valueSize);
+  VELOX_CHECK_EQ(keyOffset, valueOffset);
+  map->setOffsetAndSize(index, keyOffset, keySize);
+  result.setNull(index, false);
+}
+
+void deserializeSwitch(
+    const char*& data,
+    vector_size_t index,
+    BaseVector& result) {
+  VELOX_DYNAMIC_TYPE_DISPATCH(
+      deserializeOne, result.typeKind(), data, index, result);
+}
+
+// Comparison of two serializations for the orders of nested nulls that
+// differ from the one of the serialization. Advances 'left' and 'right' past
+// the values if they are equal.
+int32_t compareSwitch(
+    const char*& left,
+    const char*& right,
+    const Type* type,
+    CompareFlags flags);
+
+// Compares the markers of a nested value and advances past them. Returns
+// std::nullopt if both are followed by a value.
+std::optional<int32_t>
+compareMarkers(const char*& left, const char*& right, CompareFlags flags) {
+  const auto leftMarker = *left++;
+  const auto rightMarker = *right++;
+  if (leftMarker == rightMarker) {
+    return leftMarker == kValue ? std::nullopt : std::optional<int32_t>(0);
+  }
+  if (leftMarker == kEnd || rightMarker == kEnd) {
+    // The shorter array is less in ascending order.
+    return (leftMarker == kEnd) == flags.ascending ? -1 : 1;
+  }
+  // Exactly one is null.
+  return (leftMarker == kNull) == flags.nullsFirst ? -1 : 1;
+}
+
+int32_t compareArrays(
+    const char*& left,
+    const char*& right,
+    const Type* elementType,
+    CompareFlags flags) {
+  for (;;) {
+    if (*left == kEnd && *right == kEnd) {
+      ++left;
+      ++right;
+      return 0;
+    }
+    auto result = compareMarkers(left, right, flags);
+    if (result.has_value()) {
+      if (result.value() != 0) {
+        return result.value();
+      }
+      continue;
+    }
+    auto elementResult = compareSwitch(left, right, elementType, flags);
+    if (elementResult != 0) {
+      return elementResult;
+    }
+  }
+}
+
+int32_t compareSwitch(
+    const char*& left,
+    const char*& right,
+    const Type* type,
+    CompareFlags flags) {
+  switch (type->kind()) {
+    case TypeKind::ROW:
+      for (auto i = 0; i < type->size(); ++i) {
+        auto result = compareMarkers(left, right, flags);
+        if (result.has_value()) {
+          if (result.value() != 0) {
+            return result.value();
+          }
+          continue;
+        }
+        auto childResult =
+            compareSwitch(left, right, type->childAt(i).get(), flags);
+        if (childResult != 0) {
+          return childResult;
+        }
+      }
+      return 0;
+    case TypeKind::ARRAY:
+      return compareArrays(left, right, type->childAt(0).get(), flags);
+    case TypeKind::MAP: {
+      auto result = compareArrays(left, right, type->childAt(0).get(), flags);
+      if (result != 0) {
+        return result;
+      }
+      return compareArrays(left, right, type->childAt(1).get(), flags);
+    }
+    default: {
+      // Scalars compare as bytes in ascending order.
+      auto leftSize = serializedScalarSize(type->kind(), left);
+      auto rightSize = serializedScalarSize(type->kind(), right);
+      auto result = memcmp(left, right, std::min(leftSize, rightSize));
+      if (result == 0) {
+        result = leftSize - rightSize;
+      }
+      left += leftSize;
+      right += rightSize;
+      return flags.ascending ? result : -result;
+    }
+  }
+}
+
+} // namespace
+
+// static
+void ByteComparableSerde::serialize(
+    const BaseVector& source,
+    vector_size_t index,
+    std::string& out) {
+  VELOX_DCHECK(
+      !source.isNullAt(index), "Null top-level values are not supported");
+  serializeSwitch(source, index, out);
+}
+
+// static
+void ByteComparableSerde::deserialize(
+    StringView data,
+    vector_size_t index,
+    BaseVector* result) {
+  const auto* position = data.data();
+  deserializeSwitch(position, index, *result);
+  VELOX_DCHECK_EQ(position - data.data(), data.size());
+}
+
+// static
+int32_t ByteComparableSerde::compare(
+    StringView left,
+    StringView right,
+    const Type* type,
+    CompareFlags flags) {
+  VELOX_DCHECK(!flags.mayStopAtNull(), "not supported null handling mode");
+  if (flags.equalsOnly) {
+    return left == right ? 0 : 1;
+  }
+  if (flags.ascending != flags.nullsFirst) {
+    // Ascending with nulls last is the order of the serialization and
+    // descending with nulls first is its reverse.
+    const auto result = left.compare(right);
+    return flags.ascending ? result : -result;
+  }
+  const auto* leftData = left.data();
+  const auto* rightData = right.data();
+  return compareSwitch(leftData, rightData, type, flags);
+}
+
+} // namespace facebook::velox::exec
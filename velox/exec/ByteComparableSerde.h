@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <string>
+
+#include "velox/vector/BaseVector.h"
+
+namespace facebook::velox::exec {
+
+/// Serialization of complex type values, i.e. ARRAY, MAP and ROW, into byte
+/// strings that compare with memcmp() like the values compare in ascending
+/// order with nested nulls last. Equal values have equal serializations, so a
+/// serialization can be hashed and compared for equality as a string. Map
+/// entries are written in the order of their keys.
+///
+/// Used by RowContainer for columns of complex type so that grouping, join
+/// and sort keys of these types are hashed and compared without
+/// deserializing them.
+class ByteComparableSerde {
+ public:
+  /// Appends the serialization of source[index] to 'out'. The value must not
+  /// be null.
+  static void
+  serialize(const BaseVector& source, vector_size_t index, std::string& out);
+
+  /// Sets result[index] to the value serialized in 'data'.
+  static void
+  deserialize(StringView data, vector_size_t index, BaseVector* result);
+
+  /// Returns < 0 if 'left' is less than 'right', 0 if equal and > 0
+  /// otherwise. 'type' is the type of both values. flags.nullHandlingMode can
+  /// be only NoStop. Compares with memcmp() unless the order of nested nulls
+  /// is not the one of the serialization.
+  static int32_t compare(
+      StringView left,
+      StringView right,
+      const Type* type,
+      CompareFlags flags);
+};
+
+} // namespace facebook::velox::exec
@@ -43,6 +43,10 @@ class TypedDistinctAggregations : public DistinctAggregations {
         sizeof(AccumulatorType),
         false, // usesExternalMemory
         1, // alignment
+        ARRAY(inputType_),
+        [this](folly::Range<char**> groups, VectorPtr& result) {
+          extractForSpill(groups, result);
+        },
         [this](folly::Range<char**> groups) {
           for (auto* group : groups) {
             auto* accumulator =
@@ -99,6 +103,28 @@ class TypedDistinctAggregations : public DistinctAggregations {
     inputForAccumulator_.reset();
   }
 
+  void addSingleGroupSpillInput(
+      char* group,
+      const VectorPtr& input,
+      vector_size_t index) override {
+    DecodedVector decodedArray(*input);
+    if (decodedArray.isNullAt(index)) {
+      return;
+    }
+    const auto* arrayVector = decodedArray.base()->as<ArrayVector>();
+    VELOX_CHECK_NOT_NULL(arrayVector);
+    const auto arrayIndex = decodedArray.index(index);
+    const auto offset = arrayVector->offsetAt(arrayIndex);
+    const auto size = arrayVector->sizeAt(arrayIndex);
+    decodedInput_.decode(*arrayVector->elements());
+
+    auto* accumulator = reinterpret_cast<AccumulatorType*>(group + offset_);
+    RowSizeTracker<char, uint32_t> tracker(group[rowSizeOffset_], *allocator_);
+    for (auto i = offset; i < offset + size; ++i) {
+      accumulator->addValue(decodedInput_, i, allocator_);
+    }
+  }
+
   void extractValues(folly::Range<char**> groups, const RowVectorPtr& result)
       override {
     SelectivityVector rows;
@@ -135,6 +161,39 @@ class TypedDistinctAggregations : public DistinctAggregations {
   }
 
  private:
+  // Extracts the unique inputs of 'groups' into an array vector for spilling.
+  void extractForSpill(folly::Range<char**> groups, VectorPtr& result) const {
+    const auto numGroups = groups.size();
+    auto offsets = allocateOffsets(numGroups, pool_);
+    auto sizes = allocateSizes(numGroups, pool_);
+    auto* rawOffsets = offsets->asMutable<vector_size_t>();
+    auto* rawSizes = sizes->asMutable<vector_size_t>();
+
+    vector_size_t numValues = 0;
+    for (auto i = 0; i < numGroups; ++i) {
+      auto* accumulator =
+          reinterpret_cast<AccumulatorType*>(groups[i] + offset_);
+      rawOffsets[i] = numValues;
+      rawSizes[i] = accumulator->size();
+      numValues += accumulator->size();
+    }
+
+    auto elements = BaseVector::create(inputType_, numValues, pool_);
+    for (auto i = 0; i < numGroups; ++i) {
+      auto* accumulator =
+          reinterpret_cast<AccumulatorType*>(groups[i] + offset_);
+      if constexpr (std::is_same_v<T, ComplexType>) {
+        accumulator->extractValues(*elements, rawOffsets[i]);
+      } else {
+        accumulator->extractValues(
+            *(elements->template as<FlatVector<T>>()), rawOffsets[i]);
+      }
+    }
+
+    result = std::make_shared<ArrayVector>(
+        pool_, ARRAY(inputType_), nullptr, numGroups, offsets, sizes, elements);
+  }
+
   bool isSingleInputAggregate() const {
     return aggregates_[0]->inputs.size() == 1;
   }
@@ -39,6 +39,8 @@ class DistinctAggregations {
 
   virtual ~DistinctAggregations() = default;
 
+  /// Returns metadata about the accumulator used to store unique inputs. The
+  /// accumulator is spilled as an array of the unique inputs of each group.
   virtual Accumulator accumulator() const = 0;
 
   /// Aggregate-like APIs to aggregate input rows per group.
@@ -71,6 +73,13 @@ class DistinctAggregations {
       const RowVectorPtr& input,
       const SelectivityVector& rows) = 0;
 
+  /// Adds the distinct values of a group spilled by the accumulator. 'input'
+  /// is the spilled array vector and 'index' is the row of 'input' to add.
+  virtual void addSingleGroupSpillInput(
+      char* group,
+      const VectorPtr& input,
+      vector_size_t index) = 0;
+
   /// Computes aggregations and stores results in the specified 'result' vector.
   virtual void extractValues(
       folly::Range<char**> groups,
@@ -146,7 +146,8 @@ std::optional<common::SpillConfig> DriverCtx::makeSpillConfig(
       queryConfig.aggregationSpillAll(),
       queryConfig.maxSpillLevel(),
       queryConfig.testingSpillPct(),
-      queryConfig.spillCompressionKind());
+      queryConfig.spillCompressionKind(),
+      task->queryCtx()->spillWriteRateLimiter());
 }
 
 std::atomic_uint64_t BlockingState::numBlockedDrivers_{0};
@@ -184,6 +185,22 @@ void BlockingState::setResume(std::shared_ptr<BlockingState> state) {
           state->operator_->recordBlockingTime(
               state->sinceMicros_, state->reason_);
         }
+        if (task->traceRecorder() != nullptr) {
+          const auto blockedMicros =
+              std::chrono::duration_cast<std::chrono::microseconds>(
+                  std::chrono::high_resolution_clock::now()
+                      .time_since_epoch())
+                  .count() -
+              state->sinceMicros_;
+          driver->recordTrace(
+              "blocked",
+              fmt::format(
+                  "{} {}",
+                  blockingReasonToString(state->reason_),
+                  state->operator_->operatorType()),
+              getCurrentTimeMicro() - blockedMicros,
+              blockedMicros);
+        }
         VELOX_CHECK(!driver->state().isSuspended);
         VELOX_CHECK(driver->state().hasBlockingFuture);
         driver->state().hasBlockingFuture = false;
@@ -253,6 +270,8 @@ void Driver::init(
   operators_ = std::move(operators);
   curOpIndex_ = operators_.size() - 1;
   trackOperatorCpuUsage_ = ctx_->queryConfig().operatorTrackCpuUsage();
+  perfCounterSampleInterval_ =
+      ctx_->queryConfig().operatorPerfCounterSampleInterval();
 }
 
 void Driver::initializeOperators() {
@@ -402,15 +421,70 @@ CpuWallTiming Driver::processLazyTiming(
       timing.cpuNanos >= cpuDelta ? timing.cpuNanos - cpuDelta : 0};
 }
 
+PerfCounterSample::PerfCounterSample(
+    process::ThreadPerfCounters* counters,
+    Operator* op)
+    : counters_(counters), op_(op), start_(counters_->read()) {}
+
+PerfCounterSample::~PerfCounterSample() {
+  const auto delta = counters_->read() - start_;
+  op_->addRuntimeStat(kCpuCycles, RuntimeCounter(delta.cycles));
+  op_->addRuntimeStat(kInstructions, RuntimeCounter(delta.instructions));
+  op_->addRuntimeStat(kLlcMisses, RuntimeCounter(delta.llcMisses));
+  op_->addRuntimeStat(kBranchMisses, RuntimeCounter(delta.branchMisses));
+}
+
+std::unique_ptr<PerfCounterSample> Driver::samplePerfCounters(Operator* op) {
+  if (perfCounterSampleInterval_ == 0 ||
+      ++numCallsSincePerfSample_ < perfCounterSampleInterval_) {
+    return nullptr;
+  }
+  numCallsSincePerfSample_ = 0;
+  auto* counters = process::ThreadPerfCounters::get();
+  if (counters == nullptr) {
+    return nullptr;
+  }
+  return std::make_unique<PerfCounterSample>(counters, op);
+}
+
+void Driver::recordTrace(
+    const char* name,
+    std::string detail,
+    uint64_t startMicros,
+    uint64_t durationMicros) {
+  if (auto* recorder = task()->traceRecorder()) {
+    recorder->record(
+        {name,
+         std::move(detail),
+         static_cast<uint32_t>(ctx_->pipelineId),
+         static_cast<uint32_t>(ctx_->driverId),
+         startMicros,
+         durationMicros});
+  }
+}
+
+uint64_t Driver::timeSliceMicros() const {
+  const auto& config = ctx_->queryConfig();
+  const auto limitMs = config.driverCpuTimeSliceLimitMs();
+  if (limitMs == 0) {
+    return 0;
+  }
+  const auto shares = std::max<uint32_t>(1, config.queryCpuShares());
+  return std::max<uint64_t>(
+      1, limitMs * 1'000 * shares / core::QueryConfig::kDefaultQueryCpuShares);
+}
+
 StopReason Driver::runInternal(
     std::shared_ptr<Driver>& self,
     std::shared_ptr<BlockingState>& blockingState,
-    RowVectorPtr& result) {
+    RowVectorPtr& result,
+    uint64_t timeSliceMicros) {
   TestValue::adjust("facebook::velox::exec::Driver::runInternal", self.get());
   const auto now = getCurrentTimeMicro();
   const auto queuedTime = (now - queueTimeStartMicros_) * 1'000;
   // Update the next operator's queueTime.
-  auto stop = closed_ ? StopReason::kTerminate : task()->enter(state_, now);
+  auto stop = closed_ ? StopReason::kTerminate
+                      : task()->enter(state_, now, queuedTime);
   if (stop != StopReason::kNone) {
     if (stop == StopReason::kTerminate) {
       // ctx_ still has a reference to the Task. 'this' is not on
@@ -467,6 +541,14 @@ StopReason Driver::runInternal(
           guard.notThrown();
           return stop;
         }
+        if (timeSliceMicros != 0 &&
+            getCurrentTimeMicro() - now >= timeSliceMicros) {
+          // Used up the time slice. Go to the end of the executor queue so
+          // that Drivers of other queries get a turn.
+          task()->addDriverTimeSliceYield();
+          guard.notThrown();
+          return StopReason::kYield;
+        }
 
         auto op = operators_[i].get();
         VELOX_CHECK(op->isInitialized());
@@ -512,6 +594,7 @@ StopReason Driver::runInternal(
                     op->stats().wlock()->getOutputTiming.add(deltaTiming);
                   });
               RuntimeStatWriterScopeGuard statsWriterGuard(op);
+              auto perfSample = samplePerfCounters(op);
               TestValue::adjust(
                   "facebook::velox::exec::Driver::runInternal::getOutput", op);
               CALL_OPERATOR(
@@ -546,6 +629,7 @@ StopReason Driver::runInternal(
                     resultBytes, intermediateResult->size());
               }
               RuntimeStatWriterScopeGuard statsWriterGuard(nextOp);
+              auto perfSample = samplePerfCounters(nextOp);
               TestValue::adjust(
                   "facebook::velox::exec::Driver::runInternal::addInput",
                   nextOp);
@@ -585,6 +669,7 @@ StopReason Driver::runInternal(
                       op->stats().wlock()->finishTiming.add(timing);
                     });
                 RuntimeStatWriterScopeGuard statsWriterGuard(nextOp);
+                auto perfSample = samplePerfCounters(nextOp);
                 TestValue::adjust(
                     "facebook::velox::exec::Driver::runInternal::noMoreInput",
                     nextOp);
@@ -657,7 +742,21 @@ void Driver::run(std::shared_ptr<Driver> self) {
   ScopedDriverThreadContext scopedDriverThreadContext(*self->driverCtx());
   std::shared_ptr<BlockingState> blockingState;
   RowVectorPtr nullResult;
-  auto reason = self->runInternal(self, blockingState, nullResult);
+  const auto queuedSinceMicros = self->queueTimeStartMicros_;
+  const auto startMicros = getCurrentTimeMicro();
+  auto reason = self->runInternal(
+      self, blockingState, nullResult, self->timeSliceMicros());
+  if (self->task()->traceRecorder() != nullptr) {
+    if (queuedSinceMicros != 0 && queuedSinceMicros <= startMicros) {
+      self->recordTrace(
+          "queued", "", queuedSinceMicros, startMicros - queuedSinceMicros);
+    }
+    self->recordTrace(
+        "run",
+        stopReasonString(reason),
+        startMicros,
+        getCurrentTimeMicro() - startMicros);
+  }
 
   // When Driver runs on an executor, the last operator (sink) must not produce
   // any results.
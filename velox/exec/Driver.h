@@ -20,6 +20,7 @@
 #include <memory>
 
 #include "velox/common/future/VeloxPromise.h"
+#include "velox/common/process/PerfCounters.h"
 #include "velox/common/process/ThreadDebugInfo.h"
 #include "velox/common/time/CpuWallTimer.h"
 #include "velox/connectors/Connector.h"
@@ -145,6 +146,8 @@ enum class BlockingReason {
   /// Some operators can get blocked due to the producer(s) (they are
   /// currently waiting data from) not having anything produced. Used by
   /// LocalExchange, LocalMergeExchange, Exchange and MergeExchange operators.
+  /// Also used by a partitioned final aggregation waiting for its peers to
+  /// finish input.
   kWaitForProducer,
   kWaitForJoinBuild,
   /// For a build operator, it is blocked waiting for the probe operators to
@@ -166,6 +169,26 @@ enum class BlockingReason {
 
 std::string blockingReasonToString(BlockingReason reason);
 
+/// Adds the differences of the hardware counters of the calling thread
+/// between construction and destruction to the runtime stats of an operator.
+class PerfCounterSample {
+ public:
+  /// Names of the runtime stats.
+  static inline const std::string kCpuCycles = "cpuCycles";
+  static inline const std::string kInstructions = "instructions";
+  static inline const std::string kLlcMisses = "llcMisses";
+  static inline const std::string kBranchMisses = "branchMisses";
+
+  PerfCounterSample(process::ThreadPerfCounters* counters, Operator* op);
+
+  ~PerfCounterSample();
+
+ private:
+  process::ThreadPerfCounters* const counters_;
+  Operator* const op_;
+  const process::PerfCounterValues start_;
+};
+
 class BlockingState {
  public:
   BlockingState(
@@ -323,6 +346,14 @@ class Driver : public std::enable_shared_from_this<Driver> {
     return blockingReason_;
   }
 
+  /// Adds an event for 'this' to the trace of the Task if tracing is enabled.
+  /// See QueryConfig::kTaskTraceBufferSize.
+  void recordTrace(
+      const char* name,
+      std::string detail,
+      uint64_t startMicros,
+      uint64_t durationMicros);
+
   static std::shared_ptr<Driver> testingCreate(
       std::unique_ptr<DriverCtx> ctx = nullptr) {
     auto driver = new Driver();
@@ -344,10 +375,18 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   static void run(std::shared_ptr<Driver> self);
 
+  // Runs the pipeline until it blocks, finishes or is asked to stop. If
+  // 'timeSliceMicros' is non-zero, returns kYield once the Driver has been on
+  // thread for longer than that.
   StopReason runInternal(
       std::shared_ptr<Driver>& self,
       std::shared_ptr<BlockingState>& blockingState,
-      RowVectorPtr& result);
+      RowVectorPtr& result,
+      uint64_t timeSliceMicros = 0);
+
+  // Returns the time slice in microseconds for a Driver run on an executor
+  // thread. See QueryConfig::kDriverCpuTimeSliceLimitMs. 0 means no limit.
+  uint64_t timeSliceMicros() const;
 
   void close();
 
@@ -366,6 +405,11 @@ class Driver : public std::enable_shared_from_this<Driver> {
         : nullptr;
   }
 
+  // Returns an object that adds the hardware counter deltas until its
+  // destruction to the runtime stats of 'op' if this call is sampled. Returns
+  // null otherwise. See QueryConfig::kOperatorPerfCounterSampleInterval.
+  std::unique_ptr<PerfCounterSample> samplePerfCounters(Operator* op);
+
   // Adjusts 'timing' by removing the lazy load wall and CPU times
   // accrued since last time timing information was recorded for
   // 'op'. The accrued lazy load times are credited to the source
@@ -396,6 +440,11 @@ class Driver : public std::enable_shared_from_this<Driver> {
 
   bool trackOperatorCpuUsage_;
 
+  uint32_t perfCounterSampleInterval_{0};
+
+  // The number of operator calls since the last perf counter sample.
+  uint32_t numCallsSincePerfSample_{0};
+
   // Indicates that a DriverAdapter can rearrange Operators. Set to false at end
   // of DriverFactory::createDriver().
   bool isAdaptable_{true};
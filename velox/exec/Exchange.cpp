@@ -52,6 +52,15 @@ bool Exchange::getSplits(ContinueFuture* future) {
   }
 }
 
+// static
+serializer::presto::PrestoVectorSerde::PrestoOptions
+Exchange::makeSerdeOptions(const core::QueryConfig& config) {
+  serializer::presto::PrestoVectorSerde::PrestoOptions options{
+      false, common::stringToCompressionKind(config.shuffleCompressionKind())};
+  options.lazyColumns = config.exchangeLazyDeserialization();
+  return options;
+}
+
 BlockingReason Exchange::isBlocked(ContinueFuture* future) {
   if (currentPage_ || atEnd_) {
     return BlockingReason::kNotBlocked;
@@ -100,6 +109,15 @@ RowVectorPtr Exchange::getOutput() {
     return nullptr;
   }
 
+  if (auto vector = currentPage_->vector()) {
+    // A page handed over in process by a producer in the same process.
+    auto lockedStats = stats_.wlock();
+    lockedStats->rawInputBytes += currentPage_->size();
+    lockedStats->addInputVector(vector->estimateFlatSize(), vector->size());
+    currentPage_ = nullptr;
+    return vector;
+  }
+
   uint64_t rawInputBytes{0};
   if (!inputStream_) {
     inputStream_ = std::make_unique<ByteStream>();
@@ -108,7 +126,15 @@ RowVectorPtr Exchange::getOutput() {
   }
 
   getSerde()->deserialize(
-      inputStream_.get(), operatorCtx_->pool(), outputType_, &result_);
+      inputStream_.get(),
+      operatorCtx_->pool(),
+      outputType_,
+      &result_,
+      serdeOptions_.compressionKind ==
+                  common::CompressionKind::CompressionKind_NONE &&
+              !serdeOptions_.lazyColumns
+          ? nullptr
+          : &serdeOptions_);
 
   {
     auto lockedStats = stats_.wlock();
@@ -17,6 +17,7 @@
 
 #include "velox/exec/ExchangeClient.h"
 #include "velox/exec/Operator.h"
+#include "velox/serializers/PrestoSerializer.h"
 
 namespace facebook::velox::exec {
 
@@ -46,6 +47,7 @@ class Exchange : public SourceOperator {
             exchangeNode->id(),
             operatorType),
         processSplits_{operatorCtx_->driverCtx()->driverId == 0},
+        serdeOptions_{makeSerdeOptions(ctx->queryConfig())},
         exchangeClient_{std::move(exchangeClient)} {}
 
   ~Exchange() override {
@@ -73,6 +75,9 @@ class Exchange : public SourceOperator {
   /// exchangeClient_.
   bool getSplits(ContinueFuture* future);
 
+  static serializer::presto::PrestoVectorSerde::PrestoOptions
+  makeSerdeOptions(const core::QueryConfig& config);
+
   /// Fetches runtime stats from ExchangeClient and replaces these in this
   /// operator's stats.
   void recordExchangeClientStats();
@@ -86,6 +91,13 @@ class Exchange : public SourceOperator {
   /// there are more splits available or no-more-splits signal has arrived.
   ContinueFuture splitFuture_{ContinueFuture::makeEmpty()};
 
+  /// Options for deserializing the pages. The compression kind matches the one
+  /// of the PartitionedOutput that produced the pages. Each page is marked as
+  /// compressed or not, so pages sent uncompressed are not decompressed. The
+  /// columns of a page are deserialized on first access if
+  /// QueryConfig::exchangeLazyDeserialization() is set.
+  const serializer::presto::PrestoVectorSerde::PrestoOptions serdeOptions_;
+
   RowVectorPtr result_;
   std::shared_ptr<ExchangeClient> exchangeClient_;
   std::unique_ptr<SerializedPage> currentPage_;
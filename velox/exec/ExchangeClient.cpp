@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include "velox/exec/ExchangeClient.h"
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
+#include "velox/common/time/Timer.h"
 
 namespace facebook::velox::exec {
 
@@ -96,6 +99,23 @@ folly::F14FastMap<std::string, RuntimeMetric> ExchangeClient::stats() const {
     }
   }
 
+  for (const auto& [source, sourceStats] : sourceStats_) {
+    if (sourceStats.numRequests == 0) {
+      continue;
+    }
+    auto& latency = stats.try_emplace("sourceRequestWallNanos").first->second;
+    latency.unit = RuntimeCounter::Unit::kNanos;
+    latency.addValue(
+        sourceStats.requestWallUs * 1'000 / sourceStats.numRequests);
+    if (sourceStats.requestWallUs > 0 && sourceStats.receivedBytes > 0) {
+      auto& throughput =
+          stats.try_emplace("sourceReceivedBytesPerSec").first->second;
+      throughput.unit = RuntimeCounter::Unit::kBytes;
+      throughput.addValue(
+          sourceStats.receivedBytes * 1'000'000 / sourceStats.requestWallUs);
+    }
+  }
+
   stats["peakBytes"] =
       RuntimeMetric(queue_->peakBytes(), RuntimeCounter::Unit::kBytes);
   stats["numReceivedPages"] = RuntimeMetric(queue_->receivedPages());
@@ -133,16 +153,23 @@ std::unique_ptr<SerializedPage> ExchangeClient::next(
 void ExchangeClient::request(const RequestSpec& requestSpec) {
   auto& exec = folly::QueuedImmediateExecutor::instance();
   for (auto& source : requestSpec.sources) {
+    const auto requestStartUs = getCurrentTimeMicro();
     if (source->supportsFlowControlV2()) {
       auto future =
           source->request(requestSpec.maxBytes, kDefaultMaxWaitSeconds);
       VELOX_CHECK(future.valid());
       std::move(future)
           .via(&exec)
-          .thenValue([this, requestSource = source](auto&& response) {
+          .thenValue([this, requestSource = source, requestStartUs](
+                         auto&& response) {
+            REPORT_ADD_HISTOGRAM_VALUE(
+                kCounterExchangePageFetchLatencyMs,
+                (getCurrentTimeMicro() - requestStartUs) / 1'000);
             RequestSpec requestSpec;
             {
               std::lock_guard<std::mutex> l(queue_->mutex());
+              recordResponseLocked(
+                  requestSource.get(), requestStartUs, response.bytes);
               if (!response.atEnd) {
                 if (response.bytes > 0) {
                   producingSources_.push(requestSource);
@@ -162,10 +189,16 @@ void ExchangeClient::request(const RequestSpec& requestSpec) {
       VELOX_CHECK(future.valid());
       std::move(future)
           .via(&exec)
-          .thenValue([this, requestSource = source](auto&& /*unused*/) {
+          .thenValue([this, requestSource = source, requestStartUs](
+                         auto&& /*unused*/) {
+            REPORT_ADD_HISTOGRAM_VALUE(
+                kCounterExchangePageFetchLatencyMs,
+                (getCurrentTimeMicro() - requestStartUs) / 1'000);
             RequestSpec requestSpec;
             {
               std::lock_guard<std::mutex> l(queue_->mutex());
+              // The response size is not reported by this request API.
+              recordResponseLocked(requestSource.get(), requestStartUs, 0);
               emptySources_.push(requestSource);
               requestSpec = pickSourcesToRequestLocked();
             }
@@ -178,6 +211,16 @@ void ExchangeClient::request(const RequestSpec& requestSpec) {
   }
 }
 
+void ExchangeClient::recordResponseLocked(
+    const ExchangeSource* source,
+    uint64_t startUs,
+    int64_t bytes) {
+  auto& sourceStats = sourceStats_[source];
+  ++sourceStats.numRequests;
+  sourceStats.requestWallUs += getCurrentTimeMicro() - startUs;
+  sourceStats.receivedBytes += bytes;
+}
+
 int32_t ExchangeClient::countPendingSourcesLocked() {
   int32_t numPending = 0;
   for (auto& source : sources_) {
@@ -198,13 +241,13 @@ int64_t ExchangeClient::getAveragePageSize() {
   return averagePageSize;
 }
 
-int32_t ExchangeClient::getNumSourcesToRequestLocked(int64_t averagePageSize) {
-  // Figure out how many more 'averagePageSize' fit into 'maxQueuedBytes_'.
-  // Make sure to leave room for 'numPending' pages.
+int32_t ExchangeClient::getNumSourcesToRequestLocked(int64_t requestBytes) {
+  // Figure out how many more 'requestBytes' fit into 'maxQueuedBytes_'.
+  // Make sure to leave room for 'numPending' requests.
   const auto numPending = countPendingSourcesLocked();
 
   auto numToRequest = std::max<int32_t>(
-      1, (maxQueuedBytes_ - queue_->totalBytes()) / averagePageSize);
+      1, (maxQueuedBytes_ - queue_->totalBytes()) / requestBytes);
   if (numToRequest <= numPending) {
     return 0;
   }
@@ -230,15 +273,23 @@ ExchangeClient::RequestSpec ExchangeClient::pickSourcesToRequestLocked() {
     return {};
   }
 
+  // Ask each source for a window of 'requestWindowPages_' pages, as long as
+  // it fits into the free space of the queue. The free space is the credit
+  // shared by all the sources.
   const auto averagePageSize = getAveragePageSize();
-  const auto numToRequest = getNumSourcesToRequestLocked(averagePageSize);
+  const auto requestBytes = std::max<int64_t>(
+      averagePageSize,
+      std::min<int64_t>(
+          averagePageSize * requestWindowPages_,
+          maxQueuedBytes_ - queue_->totalBytes()));
+  const auto numToRequest = getNumSourcesToRequestLocked(requestBytes);
 
   if (numToRequest == 0) {
     return {};
   }
 
   RequestSpec requestSpec;
-  requestSpec.maxBytes = averagePageSize;
+  requestSpec.maxBytes = requestBytes;
 
   // Pick up to 'numToRequest' next sources to request data from. Prioritize
   // sources that return data.
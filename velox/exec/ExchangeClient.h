@@ -33,13 +33,16 @@ class ExchangeClient {
       std::string taskId,
       int destination,
       memory::MemoryPool* pool,
-      int64_t maxQueuedBytes)
+      int64_t maxQueuedBytes,
+      int32_t requestWindowPages = 1)
       : taskId_{std::move(taskId)},
         destination_(destination),
         maxQueuedBytes_{maxQueuedBytes},
+        requestWindowPages_{requestWindowPages},
         pool_(pool),
         queue_(std::make_shared<ExchangeQueue>()) {
     VELOX_CHECK_NOT_NULL(pool_);
+    VELOX_CHECK_GE(requestWindowPages_, 1);
     VELOX_CHECK_GE(
         destination, 0, "Exchange client destination must not be negative");
   }
@@ -63,7 +66,9 @@ class ExchangeClient {
 
   // Returns runtime statistics aggregated across all of the exchange sources.
   // ExchangeClient is expected to report background CPU time by including a
-  // runtime metric named ExchangeClient::kBackgroundCpuTimeMs.
+  // runtime metric named ExchangeClient::kBackgroundCpuTimeMs. The request
+  // latency and throughput metrics have one value per source so that their
+  // min and max show the slowest and fastest source.
   folly::F14FastMap<std::string, RuntimeMetric> stats() const;
 
   std::shared_ptr<ExchangeQueue> queue() const {
@@ -84,9 +89,22 @@ class ExchangeClient {
     int64_t maxBytes;
   };
 
+  // Request latency and throughput of one source.
+  struct SourceStats {
+    int64_t numRequests{0};
+    int64_t requestWallUs{0};
+    int64_t receivedBytes{0};
+  };
+
+  // Records a response from 'source' to a request issued at 'startUs'.
+  void recordResponseLocked(
+      const ExchangeSource* source,
+      uint64_t startUs,
+      int64_t bytes);
+
   int64_t getAveragePageSize();
 
-  int32_t getNumSourcesToRequestLocked(int64_t averagePageSize);
+  int32_t getNumSourcesToRequestLocked(int64_t requestBytes);
 
   RequestSpec pickSourcesToRequestLocked();
 
@@ -103,6 +121,8 @@ class ExchangeClient {
   const std::string taskId_;
   const int destination_;
   const int64_t maxQueuedBytes_;
+  // The number of average size pages to ask for in one request.
+  const int32_t requestWindowPages_;
   memory::MemoryPool* const pool_;
   std::shared_ptr<ExchangeQueue> queue_;
   std::unordered_set<std::string> taskIds_;
@@ -114,6 +134,8 @@ class ExchangeClient {
   std::queue<std::shared_ptr<ExchangeSource>> producingSources_;
   // A queue of sources that returned empty response from the latest request.
   std::queue<std::shared_ptr<ExchangeSource>> emptySources_;
+
+  folly::F14FastMap<const ExchangeSource*, SourceStats> sourceStats_;
 };
 
 } // namespace facebook::velox::exec
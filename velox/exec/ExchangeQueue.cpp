@@ -33,13 +33,52 @@ SerializedPage::SerializedPage(
   }
 }
 
+SerializedPage::SerializedPage(
+    RowVectorPtr vector,
+    uint64_t bytes,
+    std::function<void()> releaseFn)
+    : iobufBytes_(bytes),
+      vector_(std::move(vector)),
+      releaseFn_(std::move(releaseFn)) {
+  VELOX_CHECK_NOT_NULL(vector_);
+}
+
 SerializedPage::~SerializedPage() {
+  if (onDestructionCb_ && iobuf_) {
+    onDestructionCb_(*iobuf_.get());
+  }
+}
+
+void SerializedPage::spill(
+    std::shared_ptr<ReadFile> spillFile,
+    uint64_t offset) {
+  VELOX_CHECK_NOT_NULL(iobuf_);
+  VELOX_CHECK_NOT_NULL(spillFile);
   if (onDestructionCb_) {
     onDestructionCb_(*iobuf_.get());
+    onDestructionCb_ = nullptr;
+  }
+  iobuf_.reset();
+  ranges_.clear();
+  spillFile_ = std::move(spillFile);
+  spillOffset_ = offset;
+}
+
+std::unique_ptr<folly::IOBuf> SerializedPage::getIOBuf() const {
+  if (spillFile_ != nullptr) {
+    auto iobuf = folly::IOBuf::create(iobufBytes_);
+    spillFile_->pread(spillOffset_, iobufBytes_, iobuf->writableData());
+    iobuf->append(iobufBytes_);
+    return iobuf;
   }
+  VELOX_CHECK_NOT_NULL(
+      iobuf_, "A page holding a vector can only be consumed in process");
+  return iobuf_->clone();
 }
 
 void SerializedPage::prepareStreamForDeserialize(ByteStream* input) {
+  VELOX_CHECK_NULL(vector_, "A page holding a vector is not deserialized");
+  VELOX_CHECK(!isSpilled(), "A spilled page is not deserialized");
   input->resetInput(std::move(ranges_));
 }
 
@@ -15,7 +15,9 @@
  */
 #pragma once
 
+#include "velox/common/file/File.h"
 #include "velox/common/memory/ByteStream.h"
+#include "velox/vector/ComplexVector.h"
 
 namespace facebook::velox::exec {
 
@@ -28,6 +30,15 @@ class SerializedPage {
       std::unique_ptr<folly::IOBuf> iobuf,
       std::function<void(folly::IOBuf&)> onDestructionCb = nullptr);
 
+  // Construct from a vector that is handed over without serialization to a
+  // consumer in the same process. 'bytes' is the memory held by 'vector'.
+  // 'releaseFn' holds what keeps the memory of 'vector' valid, e.g. a
+  // reference on the producing task, and is destroyed with 'this'.
+  SerializedPage(
+      RowVectorPtr vector,
+      uint64_t bytes,
+      std::function<void()> releaseFn = nullptr);
+
   ~SerializedPage();
 
   // Returns the size of the serialized data in bytes.
@@ -35,13 +46,26 @@ class SerializedPage {
     return iobufBytes_;
   }
 
+  // Releases the memory of the data, which must have been written to
+  // 'spillFile' at 'offset'. getIOBuf() then reads the data back from
+  // 'spillFile'. Used by broadcast output buffers to keep the pages for slow
+  // consumers out of memory. Not thread-safe with getIOBuf().
+  void spill(std::shared_ptr<ReadFile> spillFile, uint64_t offset);
+
+  bool isSpilled() const {
+    return spillFile_ != nullptr;
+  }
+
+  // Returns the vector of a page made from a vector, nullptr otherwise.
+  const RowVectorPtr& vector() const {
+    return vector_;
+  }
+
   // Makes 'input' ready for deserializing 'this' with
   // VectorStreamGroup::read().
   void prepareStreamForDeserialize(ByteStream* input);
 
-  std::unique_ptr<folly::IOBuf> getIOBuf() const {
-    return iobuf_->clone();
-  }
+  std::unique_ptr<folly::IOBuf> getIOBuf() const;
 
  private:
   static int64_t chainBytes(folly::IOBuf& iobuf) {
@@ -58,9 +82,18 @@ class SerializedPage {
   // IOBuf holding the data in 'ranges_.
   std::unique_ptr<folly::IOBuf> iobuf_;
 
-  // Number of payload bytes in 'iobuf_'.
+  // Number of payload bytes in 'iobuf_' or of memory held by 'vector_'.
   const int64_t iobufBytes_;
 
+  // Vector held instead of 'iobuf_' for a page handed over in process.
+  const RowVectorPtr vector_;
+
+  const std::function<void()> releaseFn_;
+
+  // File and offset of the data after spill().
+  std::shared_ptr<ReadFile> spillFile_;
+  uint64_t spillOffset_{0};
+
   // Callback that will be called on destruction of the SerializedPage,
   // primarily used to free externally allocated memory backing folly::IOBuf
   // from caller. Caller is responsible to pass in proper cleanup logic to
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/FragmentResultCache.h"
+
+#include <folly/hash/SpookyHashV2.h>
+#include <folly/json.h>
+
+#include "velox/common/caching/FileIds.h"
+#include "velox/common/caching/SsdCache.h"
+#include "velox/vector/VectorStream.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+// Returns the serialized 'node' without its id. The assignments are sorted by
+// name so that equal scans serialize alike.
+std::string serializeFragment(const core::TableScanNode& node) {
+  auto obj = node.serialize();
+  obj.erase("id");
+  auto& assignments = obj["assignments"];
+  std::sort(
+      assignments.begin(),
+      assignments.end(),
+      [](const folly::dynamic& left, const folly::dynamic& right) {
+        return left["assign"].asString() < right["assign"].asString();
+      });
+  folly::json::serialization_opts opts;
+  opts.sort_keys = true;
+  return folly::json::serialize(obj, opts);
+}
+
+// Calls 'func(data, size)' for each contiguous range of the data of 'entry'.
+template <typename Func>
+void forEachRange(cache::AsyncDataCacheEntry& entry, Func func) {
+  if (entry.tinyData() != nullptr) {
+    func(entry.tinyData(), entry.size());
+    return;
+  }
+  auto& allocation = entry.data();
+  uint64_t offset = 0;
+  for (auto i = 0; i < allocation.numRuns() && offset < entry.size(); ++i) {
+    auto run = allocation.runAt(i);
+    const auto size = std::min<uint64_t>(run.numBytes(), entry.size() - offset);
+    func(run.data<char>(), size);
+    offset += size;
+  }
+}
+
+} // namespace
+
+FragmentResultCache::Reader::Reader(
+    cache::CachePin pin,
+    RowTypePtr type,
+    memory::MemoryPool* pool)
+    : pin_(std::move(pin)), type_(std::move(type)), pool_(pool) {
+  std::vector<ByteRange> ranges;
+  forEachRange(*pin_.checkedEntry(), [&](char* data, uint64_t size) {
+    ranges.push_back(ByteRange{
+        reinterpret_cast<uint8_t*>(data), static_cast<int32_t>(size), 0});
+  });
+  input_.resetInput(std::move(ranges));
+  numBatches_ = input_.read<int32_t>();
+}
+
+RowVectorPtr FragmentResultCache::Reader::next() {
+  if (numBatches_ == 0) {
+    return nullptr;
+  }
+  --numBatches_;
+  RowVectorPtr result;
+  VectorStreamGroup::read(&input_, pool_, type_, &result);
+  return result;
+}
+
+void FragmentResultCache::Writer::append(const RowVectorPtr& data) {
+  if (tooLarge_) {
+    return;
+  }
+  data->loadedVector();
+  result_.prependChain(
+      std::make_unique<folly::IOBuf>(rowVectorToIOBuf(data, *pool_)));
+  ++numBatches_;
+  if (result_.computeChainDataLength() + sizeof(int32_t) > kMaxEntryBytes) {
+    tooLarge_ = true;
+    result_ = folly::IOBuf();
+  }
+}
+
+FragmentResultCache::FragmentResultCache(
+    cache::AsyncDataCache* cache,
+    const core::TableScanNode& node)
+    : cache_(cache), fragment_(serializeFragment(node)) {}
+
+std::optional<std::string> FragmentResultCache::makeKey(
+    const connector::ConnectorSplit& split) const {
+  const auto splitKey = split.cacheKey();
+  if (splitKey.empty()) {
+    return std::nullopt;
+  }
+  folly::hash::SpookyHashV2 hasher;
+  hasher.Init(0, 0);
+  hasher.Update(fragment_.data(), fragment_.size());
+  hasher.Update("", 1);
+  hasher.Update(splitKey.data(), splitKey.size());
+  uint64_t hash1;
+  uint64_t hash2;
+  hasher.Final(&hash1, &hash2);
+  return fmt::format("fragment:{:016x}{:016x}", hash1, hash2);
+}
+
+std::unique_ptr<FragmentResultCache::Reader> FragmentResultCache::find(
+    const std::string& key,
+    const RowTypePtr& type,
+    memory::MemoryPool* pool) {
+  StringIdLease fileNum(fileIds(), key);
+  const cache::RawFileCacheKey rawKey{fileNum.id(), 0};
+  if (cache_->exists(rawKey)) {
+    // The entry may be evicted or being loaded by another scan after the
+    // check. Such a new or exclusive pin counts as a miss.
+    auto pin = cache_->findOrCreate(rawKey, 0);
+    if (!pin.empty() && pin.checkedEntry()->isShared()) {
+      return std::make_unique<Reader>(std::move(pin), type, pool);
+    }
+    return nullptr;
+  }
+
+  auto* ssdCache = cache_->ssdCache();
+  if (ssdCache == nullptr) {
+    return nullptr;
+  }
+  auto& ssdFile = ssdCache->file(fileNum.id());
+  auto ssdPin = ssdFile.find(rawKey);
+  if (ssdPin.empty()) {
+    return nullptr;
+  }
+  std::vector<cache::CachePin> pins;
+  pins.push_back(cache_->findOrCreate(rawKey, ssdPin.run().size()));
+  if (pins[0].empty() || !pins[0].checkedEntry()->isExclusive()) {
+    return nullptr;
+  }
+  std::vector<cache::SsdPin> ssdPins;
+  ssdPins.push_back(std::move(ssdPin));
+  ssdFile.load(ssdPins, pins);
+  pins[0].checkedEntry()->setExclusiveToShared();
+  return std::make_unique<Reader>(std::move(pins[0]), type, pool);
+}
+
+void FragmentResultCache::add(const Writer& writer) {
+  const auto* result = writer.result();
+  if (result == nullptr) {
+    return;
+  }
+  const auto size = result->computeChainDataLength() + sizeof(int32_t);
+  StringIdLease fileNum(fileIds(), writer.key());
+  auto pin =
+      cache_->findOrCreate(cache::RawFileCacheKey{fileNum.id(), 0}, size);
+  if (pin.empty() || !pin.checkedEntry()->isExclusive()) {
+    return;
+  }
+
+  // Copies the batch count and the serialized batches into the ranges of the
+  // entry.
+  const int32_t numBatches = writer.numBatches();
+  std::vector<folly::ByteRange> sources;
+  sources.emplace_back(
+      reinterpret_cast<const uint8_t*>(&numBatches), sizeof(numBatches));
+  for (const auto& range : *result) {
+    sources.push_back(range);
+  }
+  auto source = sources.begin();
+  uint64_t sourceOffset = 0;
+  forEachRange(*pin.checkedEntry(), [&](char* data, uint64_t size) {
+    uint64_t offset = 0;
+    while (offset < size) {
+      const auto bytes =
+          std::min<uint64_t>(size - offset, source->size() - sourceOffset);
+      ::memcpy(data + offset, source->data() + sourceOffset, bytes);
+      offset += bytes;
+      sourceOffset += bytes;
+      if (sourceOffset == source->size()) {
+        ++source;
+        sourceOffset = 0;
+      }
+    }
+  });
+  pin.checkedEntry()->setExclusiveToShared();
+}
+
+} // namespace facebook::velox::exec
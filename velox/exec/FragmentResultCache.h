@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <folly/io/IOBuf.h>
+
+#include "velox/common/caching/AsyncDataCache.h"
+#include "velox/common/memory/ByteStream.h"
+#include "velox/core/PlanNode.h"
+
+namespace facebook::velox::exec {
+
+/// Caches the output of a table scan per split. The output of a split is
+/// serialized into an entry of AsyncDataCache, from where it is saved to and
+/// loaded from SsdCache like the cached contents of files. A later scan with
+/// the same table handle, columns and filters replays the result of the split
+/// instead of reading it.
+///
+/// The key of a result is a hash of the serialized TableScanNode without its
+/// id and of ConnectorSplit::cacheKey(). Splits with an empty cacheKey() are
+/// not cached. Results are not cached while dynamic filters are pushed into
+/// the scan, since these depend on the other side of a join. Replaying an
+/// unfiltered result to a scan with dynamic filters is correct since the join
+/// applies the filters again.
+class FragmentResultCache {
+ public:
+  /// Serialized split results larger than this are not cached. An
+  /// AsyncDataCache entry must also fit in an SsdFile region.
+  static constexpr uint64_t kMaxEntryBytes = 8 << 20;
+
+  /// Replays a cached split result. Keeps the entry pinned until destruction.
+  class Reader {
+   public:
+    Reader(
+        cache::CachePin pin,
+        RowTypePtr type,
+        memory::MemoryPool* FOLLY_NONNULL pool);
+
+    /// Returns the next batch of the result or nullptr at the end.
+    RowVectorPtr next();
+
+   private:
+    const cache::CachePin pin_;
+    const RowTypePtr type_;
+    memory::MemoryPool* const pool_;
+    ByteStream input_;
+    int32_t numBatches_;
+  };
+
+  /// Collects the output of a split for adding it to the cache.
+  class Writer {
+   public:
+    Writer(std::string key, memory::MemoryPool* FOLLY_NONNULL pool)
+        : key_(std::move(key)), pool_(pool) {}
+
+    /// Loads the lazy vectors of 'data' and adds it to the result. Stops
+    /// collecting when the result exceeds kMaxEntryBytes.
+    void append(const RowVectorPtr& data);
+
+    const std::string& key() const {
+      return key_;
+    }
+
+    /// Returns the serialized batches or nullptr if the result is too large.
+    const folly::IOBuf* result() const {
+      return tooLarge_ ? nullptr : &result_;
+    }
+
+    int32_t numBatches() const {
+      return numBatches_;
+    }
+
+   private:
+    const std::string key_;
+    memory::MemoryPool* const pool_;
+    folly::IOBuf result_;
+    int32_t numBatches_{0};
+    bool tooLarge_{false};
+  };
+
+  FragmentResultCache(
+      cache::AsyncDataCache* FOLLY_NONNULL cache,
+      const core::TableScanNode& node);
+
+  /// Returns the key of the result of 'split' or std::nullopt if 'split' is
+  /// not cacheable.
+  std::optional<std::string> makeKey(
+      const connector::ConnectorSplit& split) const;
+
+  /// Returns a Reader of the result cached under 'key' or nullptr. Loads the
+  /// result from SSD if it is not in memory.
+  std::unique_ptr<Reader> find(
+      const std::string& key,
+      const RowTypePtr& type,
+      memory::MemoryPool* FOLLY_NONNULL pool);
+
+  /// Adds the result collected by 'writer' unless it is too large or another
+  /// scan is adding the same key.
+  void add(const Writer& writer);
+
+ private:
+  cache::AsyncDataCache* const cache_;
+  // The serialized TableScanNode without its id.
+  const std::string fragment_;
+};
+
+} // namespace facebook::velox::exec
@@ -22,6 +22,10 @@ using facebook::velox::common::testutil::TestValue;
 namespace facebook::velox::exec {
 
 namespace {
+// Largest array mode hash table whose slots are passed to aggregates as dense
+// group ids.
+constexpr uint64_t kMaxDenseGroupIds = 4096;
+
 bool allAreSinglyReferenced(
     const std::vector<column_index_t>& argList,
     const std::unordered_map<column_index_t, int>& channelUseCount) {
@@ -119,19 +123,93 @@ GroupingSet::GroupingSet(
         std::make_unique<SortedAggregations>(sortedAggs, inputType, &pool_);
   }
 
+  const bool hashDedup = queryConfig_->distinctAggregationHashDedupEnabled();
   for (auto& aggregate : aggregates_) {
     if (aggregate.distinct) {
       VELOX_USER_CHECK(
           !isPartial_,
           "Partial aggregations over distinct inputs are not supported");
-      distinctAggregations_.emplace_back(
-          DistinctAggregations::create({&aggregate}, inputType, &pool_));
+      if (hashDedup) {
+        distinctMarkers_.push_back(createDistinctMarker(aggregate, inputType));
+      } else {
+        distinctMarkers_.push_back(nullptr);
+      }
+      if (distinctMarkers_.back() != nullptr) {
+        distinctAggregations_.push_back(nullptr);
+      } else {
+        distinctAggregations_.emplace_back(
+            DistinctAggregations::create({&aggregate}, inputType, &pool_));
+      }
     } else {
+      distinctMarkers_.push_back(nullptr);
       distinctAggregations_.push_back(nullptr);
     }
   }
 }
 
+std::unique_ptr<GroupingSet::DistinctMarker> GroupingSet::createDistinctMarker(
+    const AggregateInfo& aggregate,
+    const RowTypePtr& inputType) const {
+  std::vector<std::unique_ptr<VectorHasher>> hashers;
+  for (auto channel : keyChannels_) {
+    hashers.push_back(
+        VectorHasher::create(inputType->childAt(channel), channel));
+  }
+  for (auto channel : aggregate.inputs) {
+    if (channel != kConstantChannel) {
+      hashers.push_back(
+          VectorHasher::create(inputType->childAt(channel), channel));
+    }
+  }
+  if (hashers.empty()) {
+    return nullptr;
+  }
+
+  auto marker = std::make_unique<DistinctMarker>();
+  marker->table = std::make_unique<HashTable<false>>(
+      std::move(hashers),
+      std::vector<Accumulator>{},
+      std::vector<TypePtr>{},
+      false, // allowDuplicates
+      false, // isJoinBuild
+      false, // hasProbedFlag
+      0, // minTableSizeForParallelJoinBuild
+      &pool_);
+  marker->lookup = std::make_unique<HashLookup>(marker->table->hashers());
+  return marker;
+}
+
+const SelectivityVector& GroupingSet::markDistinctRows(
+    int32_t aggregateIndex,
+    const RowVectorPtr& input,
+    const SelectivityVector& rows) {
+  auto& marker = *distinctMarkers_[aggregateIndex];
+  marker.rows = rows;
+  if (!rows.hasSelections()) {
+    return marker.rows;
+  }
+
+  marker.table->prepareForProbe(*marker.lookup, input, marker.rows, false);
+  marker.table->groupProbe(*marker.lookup);
+
+  // Only the first occurrence of each combination of grouping keys and
+  // aggregate inputs reaches the accumulator.
+  marker.rows.clearAll();
+  for (auto row : marker.lookup->newGroups) {
+    marker.rows.setValid(row, true);
+  }
+  marker.rows.updateBounds();
+  return marker.rows;
+}
+
+void GroupingSet::clearDistinctMarkers() {
+  for (auto& marker : distinctMarkers_) {
+    if (marker != nullptr) {
+      marker->table->clear();
+    }
+  }
+}
+
 GroupingSet::~GroupingSet() {
   if (isGlobal_) {
     destroyGlobalAggregations();
@@ -188,6 +266,10 @@ void GroupingSet::addInput(const RowVectorPtr& input, bool mayPushdown) {
     // Look for the last group of pre-grouped keys.
     for (auto i = input->size() - 2; i >= 0; --i) {
       if (!equalKeys(preGroupedKeyChannels_, input, i, i + 1)) {
+        if (aggregates_.empty()) {
+          addPreGroupedDistinctInput(input, i + 1, mayPushdown);
+          return;
+        }
         // Process that many rows, flush the accumulators and the hash
         // table, then add remaining rows.
         numRows = i + 1;
@@ -206,6 +288,28 @@ void GroupingSet::addInput(const RowVectorPtr& input, bool mayPushdown) {
   addInputForActiveRows(input, mayPushdown);
 }
 
+void GroupingSet::addPreGroupedDistinctInput(
+    const RowVectorPtr& input,
+    vector_size_t lastRunStart,
+    bool mayPushdown) {
+  // A distinct aggregation outputs the new groups of each input right away
+  // from hashLookup(). Holding back the rows of the last run would lose their
+  // new groups, so all rows are added at once.
+  activeRows_.resize(input->size());
+  activeRows_.setAll();
+  addInputForActiveRows(input, mayPushdown);
+
+  // The runs before 'lastRunStart' do not continue in the next input. Clear
+  // the table and add back the last run, whose groups are not new anymore.
+  auto newGroups = std::move(lookup_->newGroups);
+  table_->clear();
+  activeRows_.clearAll();
+  activeRows_.setValidRange(lastRunStart, input->size(), true);
+  activeRows_.updateBounds();
+  addInputForActiveRows(input, mayPushdown);
+  lookup_->newGroups = std::move(newGroups);
+}
+
 void GroupingSet::noMoreInput() {
   noMoreInput_ = true;
 
@@ -233,6 +337,14 @@ bool GroupingSet::hasSpilled() const {
   return spiller_ != nullptr;
 }
 
+int64_t GroupingSet::freeEmptyStringArenas() {
+  int64_t freedBytes = stringAllocator_.freeEmptyArenas();
+  if (table_ != nullptr) {
+    freedBytes += table_->rows()->stringAllocator().freeEmptyArenas();
+  }
+  return freedBytes;
+}
+
 bool GroupingSet::hasOutput() {
   return noMoreInput_ || remainingInput_;
 }
@@ -264,14 +376,25 @@ void GroupingSet::addInputForActiveRows(
   auto* groups = lookup_->hits.data();
   const auto& newGroups = lookup_->newGroups;
 
+  // In array mode the hash of each row is the index of its group in the
+  // table. If the table is small, these serve as dense group ids that let
+  // fixed-width accumulators reduce the batch before touching the groups.
+  const uint64_t* groupIds = nullptr;
+  if (table_->hashMode() == BaseHashTable::HashMode::kArray &&
+      table_->capacity() <= kMaxDenseGroupIds) {
+    groupIds = lookup_->hashes.data();
+  }
+
   for (auto i = 0; i < aggregates_.size(); ++i) {
     if (!aggregates_[i].sortingKeys.empty()) {
       continue;
     }
 
-    const auto& rows = getSelectivityVector(i);
+    const auto& rows = distinctMarkers_[i] != nullptr
+        ? markDistinctRows(i, input, getSelectivityVector(i))
+        : getSelectivityVector(i);
 
-    if (aggregates_[i].distinct) {
+    if (distinctAggregations_[i] != nullptr) {
       if (!newGroups.empty()) {
         distinctAggregations_[i]->initializeNewGroups(groups, newGroups);
       }
@@ -298,7 +421,16 @@ void GroupingSet::addInputForActiveRows(
     // this.
     const bool canPushdown = (&rows == &activeRows_) && mayPushdown &&
         mayPushdown_[i] && areAllLazyNotLoaded(tempVectors_);
-    if (isRawInput_) {
+    if (groupIds != nullptr && !canPushdown) {
+      const auto numGroupIds = static_cast<int32_t>(table_->capacity());
+      if (isRawInput_) {
+        function->addDenseRawInput(
+            groups, groupIds, numGroupIds, rows, tempVectors_);
+      } else {
+        function->addDenseIntermediateResults(
+            groups, groupIds, numGroupIds, rows, tempVectors_);
+      }
+    } else if (isRawInput_) {
       function->addRawInput(groups, rows, tempVectors_, canPushdown);
     } else {
       function->addIntermediateResults(groups, rows, tempVectors_, canPushdown);
@@ -356,7 +488,8 @@ std::vector<Accumulator> GroupingSet::accumulators(bool excludeToIntermediate) {
   for (auto& aggregate : aggregates_) {
     if (!excludeToIntermediate ||
         !aggregate.function->supportsToIntermediate()) {
-      accumulators.push_back(Accumulator{aggregate.function.get()});
+      accumulators.push_back(
+          Accumulator{aggregate.function.get(), aggregate.intermediateType});
     }
   }
 
@@ -383,7 +516,15 @@ void GroupingSet::createHashTable() {
 
   RowContainer& rows = *table_->rows();
   initializeAggregates(aggregates_, rows, false);
+  initializeSortedAndDistinctAggregations(rows);
+
+  lookup_ = std::make_unique<HashLookup>(table_->hashers());
+  if (!isAdaptive_ && table_->hashMode() != BaseHashTable::HashMode::kHash) {
+    table_->forceGenericHashMode();
+  }
+}
 
+void GroupingSet::initializeSortedAndDistinctAggregations(RowContainer& rows) {
   auto numColumns = rows.keyTypes().size() + aggregates_.size();
 
   if (sortedAggregations_) {
@@ -412,11 +553,6 @@ void GroupingSet::createHashTable() {
       ++numColumns;
     }
   }
-
-  lookup_ = std::make_unique<HashLookup>(table_->hashers());
-  if (!isAdaptive_ && table_->hashMode() != BaseHashTable::HashMode::kHash) {
-    table_->forceGenericHashMode();
-  }
 }
 
 void GroupingSet::initializeGlobalAggregation() {
@@ -535,14 +671,16 @@ void GroupingSet::addGlobalAggregationInput(
     if (!aggregates_[i].sortingKeys.empty()) {
       continue;
     }
-    const auto& rows = getSelectivityVector(i);
+    const auto& rows = distinctMarkers_[i] != nullptr
+        ? markDistinctRows(i, input, getSelectivityVector(i))
+        : getSelectivityVector(i);
 
     // Check is mask is false for all rows.
     if (!rows.hasSelections()) {
       continue;
     }
 
-    if (aggregates_[i].distinct) {
+    if (distinctAggregations_[i] != nullptr) {
       distinctAggregations_[i]->addSingleGroupInput(group, input, rows);
       continue;
     }
@@ -677,14 +815,39 @@ bool GroupingSet::getOutput(
     if (table_ != nullptr) {
       table_->clear();
     }
+    clearDistinctMarkers();
     return false;
   }
-  extractGroups(folly::Range<char**>(groups, numGroups), result);
+  extractGroups(folly::Range<char**>(groups, numGroups), isPartial_, result);
+  return true;
+}
+
+bool GroupingSet::getIntermediateOutput(
+    int32_t maxOutputRows,
+    int32_t maxOutputBytes,
+    RowContainerIterator& iterator,
+    RowVectorPtr& result) {
+  VELOX_CHECK(!isGlobal_);
+  VELOX_CHECK(!hasSpilled());
+  VELOX_CHECK_NULL(sortedAggregations_);
+  VELOX_CHECK(distinctAggregations_.empty());
+
+  // @lint-ignore CLANGTIDY
+  char* groups[maxOutputRows];
+  const int32_t numGroups = table_
+      ? table_->rows()->listRows(
+            &iterator, maxOutputRows, maxOutputBytes, groups)
+      : 0;
+  if (numGroups == 0) {
+    return false;
+  }
+  extractGroups(folly::Range<char**>(groups, numGroups), true, result);
   return true;
 }
 
 void GroupingSet::extractGroups(
     folly::Range<char**> groups,
+    bool isPartial,
     const RowVectorPtr& result) {
   result->resize(groups.size());
   if (groups.empty()) {
@@ -703,7 +866,7 @@ void GroupingSet::extractGroups(
 
     auto& function = aggregates_[i].function;
     auto& aggregateVector = result->childAt(i + totalKeys);
-    if (isPartial_) {
+    if (isPartial) {
       function->extractAccumulators(
           groups.data(), groups.size(), &aggregateVector);
     } else {
@@ -890,8 +1053,8 @@ void GroupingSet::spill(int64_t targetRows, int64_t targetBytes) {
   if (!hasSpilled()) {
     auto rows = table_->rows();
     auto types = rows->keyTypes();
-    for (const auto& aggregate : aggregates_) {
-      types.push_back(aggregate.intermediateType);
+    for (const auto& accumulator : rows->accumulators()) {
+      types.push_back(accumulator.spillType());
     }
     std::vector<std::string> names;
     for (auto i = 0; i < types.size(); ++i) {
@@ -915,7 +1078,8 @@ void GroupingSet::spill(int64_t targetRows, int64_t targetBytes) {
         spillConfig_->minSpillRunSize,
         spillConfig_->compressionKind,
         memory::spillMemoryPool(),
-        spillConfig_->executor);
+        spillConfig_->executor,
+        spillConfig_->writeRateLimiter);
   }
   ++(*numSpillRuns_);
   spiller_->spill(targetRows, targetBytes);
@@ -933,8 +1097,8 @@ void GroupingSet::spill(const RowContainerIterator& rowIterator) {
 
   auto* rows = table_->rows();
   auto types = rows->keyTypes();
-  for (const auto& aggregate : aggregates_) {
-    types.push_back(aggregate.intermediateType);
+  for (const auto& accumulator : rows->accumulators()) {
+    types.push_back(accumulator.spillType());
   }
   std::vector<std::string> names;
   for (auto i = 0; i < types.size(); ++i) {
@@ -950,7 +1114,8 @@ void GroupingSet::spill(const RowContainerIterator& rowIterator) {
       spillConfig_->writeBufferSize,
       spillConfig_->compressionKind,
       memory::spillMemoryPool(),
-      spillConfig_->executor);
+      spillConfig_->executor,
+      spillConfig_->writeRateLimiter);
 
   ++(*numSpillRuns_);
   spiller_->spill(rowIterator);
@@ -981,6 +1146,7 @@ bool GroupingSet::getOutputWithSpill(
         table_->rows()->stringAllocatorShared());
 
     initializeAggregates(aggregates_, *mergeRows_, false);
+    initializeSortedAndDistinctAggregations(*mergeRows_);
 
     // Take ownership of the rows and free the hash table. The table will not be
     // needed for producing spill output.
@@ -1002,6 +1168,7 @@ bool GroupingSet::getOutputWithSpill(
     extractGroups(
         folly::Range<char**>(
             nonSpilledRows_.value().data() + nonSpilledRowIndex_, numGroups),
+        isPartial_,
         result);
     nonSpilledRowIndex_ += numGroups;
     return true;
@@ -1073,9 +1240,22 @@ void GroupingSet::initializeRow(SpillMergeStream& keys, char* row) {
     mergeRows_->store(keys.decoded(i), keys.currentIndex(), mergeState_, i);
   }
   vector_size_t zero = 0;
-  for (auto& aggregate : aggregates_) {
-    aggregate.function->initializeNewGroups(
-        &row, folly::Range<const vector_size_t*>(&zero, 1));
+  const folly::Range<const vector_size_t*> newGroups(&zero, 1);
+  for (auto i = 0; i < aggregates_.size(); ++i) {
+    // The sorted and distinct aggregations initialize their aggregates below.
+    if (!aggregates_[i].sortingKeys.empty() ||
+        distinctAggregations_[i] != nullptr) {
+      continue;
+    }
+    aggregates_[i].function->initializeNewGroups(&row, newGroups);
+  }
+  if (sortedAggregations_) {
+    sortedAggregations_->initializeNewGroups(&row, newGroups);
+  }
+  for (const auto& aggregation : distinctAggregations_) {
+    if (aggregation != nullptr) {
+      aggregation->initializeNewGroups(&row, newGroups);
+    }
   }
 }
 
@@ -1086,7 +1266,8 @@ void GroupingSet::extractSpillResult(const RowVectorPtr& result) {
     mergeRows_->listRows(
         &iter, rows.size(), RowContainer::kUnlimited, rows.data());
   }
-  extractGroups(folly::Range<char**>(rows.data(), rows.size()), result);
+  extractGroups(
+      folly::Range<char**>(rows.data(), rows.size()), isPartial_, result);
   mergeRows_->clear();
 }
 
@@ -1098,11 +1279,31 @@ void GroupingSet::updateRow(SpillMergeStream& input, char* row) {
   mergeSelection_.setValid(input.currentIndex(), true);
   mergeSelection_.updateBounds();
   for (auto i = 0; i < aggregates_.size(); ++i) {
+    // The state of the sorted and distinct aggregations is merged from their
+    // own accumulators below.
+    if (!aggregates_[i].sortingKeys.empty() ||
+        distinctAggregations_[i] != nullptr) {
+      continue;
+    }
     mergeArgs_[0] = input.current().childAt(i + keyChannels_.size());
     aggregates_[i].function->addSingleGroupIntermediateResults(
         row, mergeSelection_, mergeArgs_, false);
   }
   mergeSelection_.setValid(input.currentIndex(), false);
+
+  // The accumulators of the sorted and distinct aggregations are spilled after
+  // the aggregates in the order of accumulators().
+  auto column = keyChannels_.size() + aggregates_.size();
+  if (sortedAggregations_) {
+    sortedAggregations_->addSingleGroupSpillInput(
+        row, input.current().childAt(column++), input.currentIndex());
+  }
+  for (const auto& aggregation : distinctAggregations_) {
+    if (aggregation != nullptr) {
+      aggregation->addSingleGroupSpillInput(
+          row, input.current().childAt(column++), input.currentIndex());
+    }
+  }
 }
 
 void GroupingSet::abandonPartialAggregation() {
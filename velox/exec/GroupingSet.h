@@ -72,6 +72,18 @@ class GroupingSet {
       RowContainerIterator& iterator,
       RowVectorPtr& result);
 
+  /// Same as getOutput() but always produces the intermediate results of the
+  /// aggregates, even if 'this' is not partial. 'result' has the grouping keys
+  /// followed by one intermediate type column per aggregate. Used to merge the
+  /// groups of 'this' into another GroupingSet of the same final aggregation.
+  /// Returns false when all groups have been produced. Not supported for global
+  /// aggregations, sorted or distinct aggregates and after spilling.
+  bool getIntermediateOutput(
+      int32_t maxOutputRows,
+      int32_t maxOutputBytes,
+      RowContainerIterator& iterator,
+      RowVectorPtr& result);
+
   uint64_t allocatedBytes() const;
 
   void resetPartial();
@@ -115,6 +127,10 @@ class GroupingSet {
   /// Returns true if spilling has triggered on this grouping set.
   bool hasSpilled() const;
 
+  /// Returns the fully free arenas of the variable width data allocators to
+  /// the memory pool. Returns the number of bytes freed.
+  int64_t freeEmptyStringArenas();
+
   /// Returns the hashtable stats.
   HashTableStats hashTableStats() const {
     return table_ ? table_->stats() : HashTableStats{};
@@ -145,6 +161,16 @@ class GroupingSet {
 
   void addRemainingInput();
 
+  // Adds 'input' of a distinct aggregation over pre-grouped keys where the
+  // last run of pre-grouped keys starts at 'lastRunStart'. The new groups of
+  // all rows are reported in hashLookup() since they are output right away.
+  // The groups of the runs that end in 'input' are then dropped from the
+  // table, so that memory is bounded by the largest run.
+  void addPreGroupedDistinctInput(
+      const RowVectorPtr& input,
+      vector_size_t lastRunStart,
+      bool mayPushdown);
+
   void initializeGlobalAggregation();
 
   void destroyGlobalAggregations();
@@ -159,6 +185,37 @@ class GroupingSet {
 
   void createHashTable();
 
+  // Sets the allocator and the offsets of the sorted and distinct aggregations
+  // for the accumulators of 'rows'.
+  void initializeSortedAndDistinctAggregations(RowContainer& rows);
+
+  // Hash table on the grouping keys and the inputs of a distinct aggregate.
+  // Used when 'distinct_aggregation_hash_dedup_enabled' is set to pass only the
+  // first occurrence of each value in a group to a regular accumulator.
+  struct DistinctMarker {
+    std::unique_ptr<BaseHashTable> table;
+    std::unique_ptr<HashLookup> lookup;
+    // The rows of the last input batch that are new in 'table'.
+    SelectivityVector rows;
+  };
+
+  // Returns nullptr if 'aggregate' has neither grouping keys nor non-constant
+  // inputs to deduplicate on.
+  std::unique_ptr<DistinctMarker> createDistinctMarker(
+      const AggregateInfo& aggregate,
+      const RowTypePtr& inputType) const;
+
+  // Adds the selected 'rows' of 'input' to the marker of the distinct
+  // aggregate at 'aggregateIndex' and returns the subset of 'rows' whose
+  // combination of grouping keys and aggregate inputs was not seen before.
+  const SelectivityVector& markDistinctRows(
+      int32_t aggregateIndex,
+      const RowVectorPtr& input,
+      const SelectivityVector& rows);
+
+  // Clears the markers when the groups they refer to have been produced.
+  void clearDistinctMarkers();
+
   void populateTempVectors(int32_t aggregateIndex, const RowVectorPtr& input);
 
   // If the given aggregation has mask, the method returns reference to the
@@ -176,9 +233,12 @@ class GroupingSet {
   void ensureOutputFits();
 
   // Copies the grouping keys and aggregates for 'groups' into 'result' If
-  // partial output, extracts the intermediate type for aggregates, final result
+  // 'isPartial', extracts the intermediate type for aggregates, final result
   // otherwise.
-  void extractGroups(folly::Range<char**> groups, const RowVectorPtr& result);
+  void extractGroups(
+      folly::Range<char**> groups,
+      bool isPartial,
+      const RowVectorPtr& result);
 
   // Produces output in if spilling has occurred. First produces data
   // from non-spilled partitions, then merges spill runs and unspilled data
@@ -249,6 +309,11 @@ class GroupingSet {
   AggregationMasks masks_;
   std::unique_ptr<SortedAggregations> sortedAggregations_;
   std::vector<std::unique_ptr<DistinctAggregations>> distinctAggregations_;
+  // 1:1 with 'aggregates_'. Non-null for the distinct aggregates that are
+  // deduplicated with a hash table. These are accumulated, spilled and merged
+  // as regular aggregates and have no entry in 'distinctAggregations_'. The
+  // markers are kept in memory when the groups are spilled.
+  std::vector<std::unique_ptr<DistinctMarker>> distinctMarkers_;
 
   const bool ignoreNullKeys_;
 
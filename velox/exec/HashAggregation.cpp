@@ -92,6 +92,37 @@ void verifyIntermediateInputs(
         name);
   }
 }
+
+// Returns true if 'aggregationNode' runs as a partitioned final aggregation.
+// This requires a final grouping aggregation whose aggregates each take a
+// single intermediate result column and have no mask, sorting keys or
+// distinct flag.
+bool isPartitionedFinalAggregation(
+    const core::AggregationNode& aggregationNode,
+    const core::QueryConfig& queryConfig) {
+  if (!queryConfig.partitionedFinalAggregationEnabled() ||
+      aggregationNode.step() != core::AggregationNode::Step::kFinal ||
+      aggregationNode.groupingKeys().empty() ||
+      aggregationNode.aggregates().empty() ||
+      !aggregationNode.preGroupedKeys().empty()) {
+    return false;
+  }
+  for (const auto& aggregate : aggregationNode.aggregates()) {
+    if (aggregate.distinct || aggregate.mask != nullptr ||
+        !aggregate.sortingKeys.empty() ||
+        aggregate.call->inputs().size() != 1 ||
+        dynamic_cast<const core::FieldAccessTypedExpr*>(
+            aggregate.call->inputs()[0].get()) == nullptr) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// First bit of the hash number range used for assigning groups to partitions
+// in a partitioned final aggregation. This is above the bits used for the
+// tags and the bucket offsets of the hash tables of the partitions.
+constexpr uint8_t kPartitionStartBit = 48;
 } // namespace
 
 HashAggregation::HashAggregation(
@@ -106,12 +137,18 @@ HashAggregation::HashAggregation(
           aggregationNode->step() == core::AggregationNode::Step::kPartial
               ? "PartialAggregation"
               : "Aggregation",
-          aggregationNode->canSpill(driverCtx->queryConfig())
+          aggregationNode->canSpill(driverCtx->queryConfig()) &&
+                  !isPartitionedFinalAggregation(
+                      *aggregationNode, driverCtx->queryConfig())
               ? driverCtx->makeSpillConfig(operatorId)
               : std::nullopt),
+      aggregationNode_(aggregationNode),
       isPartialOutput_(isPartialOutput(aggregationNode->step())),
       isGlobal_(aggregationNode->groupingKeys().empty()),
       isDistinct_(!isGlobal_ && aggregationNode->aggregates().empty()),
+      partitionedFinal_(isPartitionedFinalAggregation(
+          *aggregationNode,
+          driverCtx->queryConfig())),
       maxExtendedPartialAggregationMemoryUsage_(
           driverCtx->queryConfig().maxExtendedPartialAggregationMemoryUsage()),
       maxPartialAggregationMemoryUsage_(
@@ -119,30 +156,79 @@ HashAggregation::HashAggregation(
       abandonPartialAggregationMinRows_(
           driverCtx->queryConfig().abandonPartialAggregationMinRows()),
       abandonPartialAggregationMinPct_(
-          driverCtx->queryConfig().abandonPartialAggregationMinPct()) {
+          driverCtx->queryConfig().abandonPartialAggregationMinPct()),
+      partialAggregationReenableIntervalRows_(
+          driverCtx->queryConfig().partialAggregationReenableIntervalRows()) {
   VELOX_CHECK(pool()->trackUsage());
 
-  auto inputType = aggregationNode->sources()[0]->outputType();
+  const auto& inputType = aggregationNode->sources()[0]->outputType();
+
+  if (partialAggregationReenableIntervalRows_ > 0) {
+    for (const auto& key : aggregationNode->groupingKeys()) {
+      groupingKeyChannels_.push_back(exprToChannel(key.get(), inputType));
+    }
+  }
+
+  if (isDistinct_) {
+    for (auto i = 0; i < aggregationNode->groupingKeys().size(); ++i) {
+      identityProjections_.emplace_back(
+          exprToChannel(aggregationNode->groupingKeys()[i].get(), inputType),
+          i);
+    }
+  }
+
+  if (partitionedFinal_) {
+    // The grouping sets of the partitions are created on first input once the
+    // number of drivers is known.
+    for (const auto& key : aggregationNode->groupingKeys()) {
+      intermediateChannels_.push_back(exprToChannel(key.get(), inputType));
+    }
+    for (const auto& aggregate : aggregationNode->aggregates()) {
+      intermediateChannels_.push_back(
+          exprToChannel(aggregate.call->inputs()[0].get(), inputType));
+    }
+    std::vector<TypePtr> intermediateTypes;
+    intermediateTypes.reserve(intermediateChannels_.size());
+    for (auto channel : intermediateChannels_) {
+      intermediateTypes.push_back(inputType->childAt(channel));
+    }
+    intermediateType_ = ROW(std::move(intermediateTypes));
+  }
+}
+
+void HashAggregation::initialize() {
+  Operator::initialize();
+
+  // The grouping sets of a partitioned final aggregation are created on first
+  // input.
+  if (!partitionedFinal_) {
+    VELOX_CHECK_NULL(groupingSet_);
+    groupingSet_ = createGroupingSet();
+  }
+}
+
+std::unique_ptr<GroupingSet> HashAggregation::createGroupingSet() {
+  const auto& inputType = aggregationNode_->sources()[0]->outputType();
 
   auto hashers =
-      createVectorHashers(inputType, aggregationNode->groupingKeys());
+      createVectorHashers(inputType, aggregationNode_->groupingKeys());
   auto numHashers = hashers.size();
 
   std::vector<column_index_t> preGroupedChannels;
-  preGroupedChannels.reserve(aggregationNode->preGroupedKeys().size());
-  for (const auto& key : aggregationNode->preGroupedKeys()) {
+  preGroupedChannels.reserve(aggregationNode_->preGroupedKeys().size());
+  for (const auto& key : aggregationNode_->preGroupedKeys()) {
     auto channel = exprToChannel(key.get(), inputType);
     preGroupedChannels.push_back(channel);
   }
 
-  auto numAggregates = aggregationNode->aggregates().size();
+  auto numAggregates = aggregationNode_->aggregates().size();
   std::vector<AggregateInfo> aggregateInfos;
   aggregateInfos.reserve(numAggregates);
 
   std::shared_ptr<core::ExpressionEvaluator> expressionEvaluator;
 
   for (auto i = 0; i < numAggregates; i++) {
-    const auto& aggregate = aggregationNode->aggregates()[i];
+    const auto& aggregate = aggregationNode_->aggregates()[i];
 
     AggregateInfo info;
     info.distinct = aggregate.distinct;
@@ -162,12 +248,12 @@ HashAggregation::HashAggregation(
     const auto& resultType = outputType_->childAt(numHashers + i);
     info.function = Aggregate::create(
         aggregate.call->name(),
-        isPartialOutput(aggregationNode->step())
+        isPartialOutput(aggregationNode_->step())
             ? core::AggregationNode::Step::kPartial
             : core::AggregationNode::Step::kSingle,
         aggregate.rawInputTypes,
         resultType,
-        driverCtx->queryConfig());
+        operatorCtx_->driverCtx()->queryConfig());
 
     auto lambdas = extractLambdaInputs(aggregate);
     if (!lambdas.empty()) {
@@ -203,23 +289,17 @@ HashAggregation::HashAggregation(
         "Unexpected result type for an aggregation: {}, expected {}, step {}",
         aggResultType->toString(),
         expectedType->toString(),
-        core::AggregationNode::stepName(aggregationNode->step()));
+        core::AggregationNode::stepName(aggregationNode_->step()));
   }
 
-  if (isDistinct_) {
-    for (auto i = 0; i < hashers.size(); ++i) {
-      identityProjections_.emplace_back(hashers[i]->channel(), i);
-    }
-  }
-
-  groupingSet_ = std::make_unique<GroupingSet>(
+  return std::make_unique<GroupingSet>(
       inputType,
       std::move(hashers),
       std::move(preGroupedChannels),
       std::move(aggregateInfos),
-      aggregationNode->ignoreNullKeys(),
+      aggregationNode_->ignoreNullKeys(),
       isPartialOutput_,
-      isRawInput(aggregationNode->step()),
+      isRawInput(aggregationNode_->step()),
       spillConfig_.has_value() ? &spillConfig_.value() : nullptr,
       &numSpillRuns_,
       &nonReclaimableSection_,
@@ -237,7 +317,13 @@ void HashAggregation::addInput(RowVectorPtr input) {
     mayPushdown_ = operatorCtx_->driver()->mayPushdownAggregation(this);
     pushdownChecked_ = true;
   }
-  if (abandonedPartialAggregation_) {
+  if (partitionedFinal_) {
+    addPartitionedInput(input);
+    numInputRows_ += input->size();
+    return;
+  }
+  if (abandonedPartialAggregation_ &&
+      !maybeReenablePartialAggregation(input)) {
     input_ = input;
     numInputRows_ += input->size();
     return;
@@ -273,6 +359,52 @@ void HashAggregation::addInput(RowVectorPtr input) {
   }
 }
 
+bool HashAggregation::maybeReenablePartialAggregation(
+    const RowVectorPtr& input) {
+  VELOX_CHECK(abandonedPartialAggregation_);
+  if (partialAggregationReenableIntervalRows_ <= 0) {
+    return false;
+  }
+  numPassThroughRows_ += input->size();
+  if (numPassThroughRows_ < partialAggregationReenableIntervalRows_) {
+    return false;
+  }
+  numPassThroughRows_ = 0;
+
+  const auto pct = uniqueKeysPct(input);
+  addRuntimeStat("partialAggregationReenableProbes", RuntimeCounter(1));
+  if (pct >= abandonPartialAggregationMinPct_) {
+    return false;
+  }
+
+  // The grouping set gave up its hash table on abandonment. Start over with a
+  // new one and fresh reduction counters.
+  groupingSet_ = createGroupingSet();
+  abandonedPartialAggregation_ = false;
+  numInputRows_ = 0;
+  numOutputRows_ = 0;
+  addRuntimeStat("reenabledPartialAggregation", RuntimeCounter(1));
+  return true;
+}
+
+int32_t HashAggregation::uniqueKeysPct(const RowVectorPtr& input) {
+  const auto numRows = input->size();
+  if (numRows == 0) {
+    return 0;
+  }
+  keyHashes_.resize(numRows);
+  std::fill(keyHashes_.begin(), keyHashes_.end(), 0);
+  for (auto channel : groupingKeyChannels_) {
+    const auto& key = BaseVector::loadedVectorShared(input->childAt(channel));
+    for (auto row = 0; row < numRows; ++row) {
+      keyHashes_[row] = bits::hashMix(keyHashes_[row], key->hashValueAt(row));
+    }
+  }
+  uniqueKeyHashes_.clear();
+  uniqueKeyHashes_.insert(keyHashes_.begin(), keyHashes_.end());
+  return 100 * uniqueKeyHashes_.size() / numRows;
+}
+
 void HashAggregation::updateRuntimeStats() {
   // Report range sizes and number of distinct values for the group-by keys.
   const auto& hashers = groupingSet_->hashLookup().hashers;
@@ -373,12 +505,27 @@ void HashAggregation::maybeIncreasePartialAggregationMemoryUsage(
   const int64_t memoryToReserve = std::max<int64_t>(
       0,
       extendedPartialAggregationMemoryUsage - groupingSet_->allocatedBytes());
+  if (extendedReservation_ == nullptr) {
+    extendedReservation_ = std::make_shared<std::atomic_bool>(false);
+  }
+  memoryFuture_ = maybeReserveAsync(memoryToReserve, extendedReservation_);
+  if (memoryFuture_.valid()) {
+    // Waits in isBlocked() for the reservation to complete.
+    pendingPartialAggregationMemoryUsage_ =
+        extendedPartialAggregationMemoryUsage;
+    return;
+  }
   if (!pool()->maybeReserve(memoryToReserve)) {
     return;
   }
+  extendPartialAggregationMemoryUsage(extendedPartialAggregationMemoryUsage);
+}
+
+void HashAggregation::extendPartialAggregationMemoryUsage(
+    int64_t memoryUsage) {
   // Update the aggregation memory usage size limit on memory reservation
   // success.
-  maxPartialAggregationMemoryUsage_ = extendedPartialAggregationMemoryUsage;
+  maxPartialAggregationMemoryUsage_ = memoryUsage;
   addRuntimeStat(
       "maxExtendedPartialAggregationMemoryUsage",
       RuntimeCounter(
@@ -390,6 +537,9 @@ RowVectorPtr HashAggregation::getOutput() {
     input_ = nullptr;
     return nullptr;
   }
+  if (partitionedFinal_) {
+    return getPartitionedOutput();
+  }
   if (abandonedPartialAggregation_) {
     if (noMoreInput_) {
       finished_ = true;
@@ -464,6 +614,11 @@ RowVectorPtr HashAggregation::getOutput() {
 }
 
 void HashAggregation::noMoreInput() {
+  if (partitionedFinal_) {
+    Operator::noMoreInput();
+    finishPartitionedInput();
+    return;
+  }
   groupingSet_->noMoreInput();
   Operator::noMoreInput();
   recordSpillStats();
@@ -471,15 +626,255 @@ void HashAggregation::noMoreInput() {
   pool()->release();
 }
 
+BlockingReason HashAggregation::isBlocked(ContinueFuture* future) {
+  if (memoryFuture_.valid()) {
+    *future = std::move(memoryFuture_);
+    return BlockingReason::kWaitForMemory;
+  }
+  if (pendingPartialAggregationMemoryUsage_ != 0) {
+    if (*extendedReservation_) {
+      extendPartialAggregationMemoryUsage(
+          pendingPartialAggregationMemoryUsage_);
+    }
+    pendingPartialAggregationMemoryUsage_ = 0;
+  }
+  if (future_.valid()) {
+    VELOX_CHECK(partitionedFinal_);
+    *future = std::move(future_);
+    return BlockingReason::kWaitForProducer;
+  }
+  if (partitionedFinal_ && noMoreInput_) {
+    // The last peer to finish input has assigned the output partitions of all
+    // peers before fulfilling 'future_'.
+    peersFinished_ = true;
+  }
+  return BlockingReason::kNotBlocked;
+}
+
 bool HashAggregation::isFinished() {
   return finished_;
 }
 
+void HashAggregation::initializePartitions() {
+  if (!partitionGroupingSets_.empty()) {
+    return;
+  }
+  const auto numDrivers =
+      operatorCtx_->task()->numDrivers(operatorCtx_->driver());
+  const auto numPartitions = bits::nextPowerOfTwo(numDrivers);
+  const uint8_t numBits = __builtin_ctzll(numPartitions);
+  const std::vector<column_index_t> keyChannels(
+      intermediateChannels_.begin(),
+      intermediateChannels_.begin() + aggregationNode_->groupingKeys().size());
+  partitionFunction_ = std::make_unique<HashPartitionFunction>(
+      HashBitRange(kPartitionStartBit, kPartitionStartBit + numBits),
+      aggregationNode_->sources()[0]->outputType(),
+      keyChannels);
+  partitionGroupingSets_.reserve(numPartitions);
+  for (auto i = 0; i < numPartitions; ++i) {
+    partitionGroupingSets_.push_back(createGroupingSet());
+  }
+}
+
+void HashAggregation::addPartitionedInput(const RowVectorPtr& input) {
+  initializePartitions();
+  const auto numPartitions = partitionGroupingSets_.size();
+  if (numPartitions == 1) {
+    partitionGroupingSets_[0]->addInput(input, false);
+    return;
+  }
+
+  // Lazy vectors must be loaded before being wrapped in the per partition
+  // dictionaries.
+  for (auto& child : input->children()) {
+    child->loadedVector();
+  }
+  partitionFunction_->partition(*input, partitions_);
+
+  const auto numInput = input->size();
+  std::vector<BufferPtr> indices(numPartitions);
+  std::vector<vector_size_t*> rawIndices(numPartitions);
+  for (auto i = 0; i < numPartitions; ++i) {
+    indices[i] = allocateIndices(numInput, pool());
+    rawIndices[i] = indices[i]->asMutable<vector_size_t>();
+  }
+  std::vector<vector_size_t> partitionSizes(numPartitions, 0);
+  for (auto row = 0; row < numInput; ++row) {
+    const auto partition = partitions_[row];
+    rawIndices[partition][partitionSizes[partition]++] = row;
+  }
+
+  for (auto i = 0; i < numPartitions; ++i) {
+    const auto size = partitionSizes[i];
+    if (size == 0) {
+      continue;
+    }
+    if (size == numInput) {
+      partitionGroupingSets_[i]->addInput(input, false);
+      continue;
+    }
+    indices[i]->setSize(size * sizeof(vector_size_t));
+    partitionGroupingSets_[i]->addInput(
+        wrap(size, std::move(indices[i]), input), false);
+  }
+}
+
+void HashAggregation::finishPartitionedInput() {
+  initializePartitions();
+
+  {
+    int64_t numDistinct = 0;
+    for (const auto& groupingSet : partitionGroupingSets_) {
+      numDistinct += groupingSet->numDistinct();
+    }
+    auto lockedStats = stats_.wlock();
+    lockedStats->runtimeStats["hashtable.numDistinct"] =
+        RuntimeMetric(numDistinct);
+    lockedStats->runtimeStats["numPartitions"] =
+        RuntimeMetric(partitionGroupingSets_.size());
+  }
+
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  // The last driver to finish input assigns the partitions of all peers to
+  // the output partitions of the peers and continues the waiting peers. The
+  // other drivers wait in isBlocked() and must not touch their partitions
+  // until then.
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(), operatorCtx_->driver(), &future_, promises, peers)) {
+    return;
+  }
+
+  auto promisesGuard = folly::makeGuard([&]() {
+    // Realize the promises so that the other Drivers (which were not
+    // the last to finish) can continue from the barrier and produce output.
+    peers.clear();
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  });
+
+  std::vector<HashAggregation*> aggregations;
+  aggregations.reserve(peers.size() + 1);
+  aggregations.push_back(this);
+  for (auto& peer : peers) {
+    auto* aggregation =
+        dynamic_cast<HashAggregation*>(peer->findOperator(planNodeId()));
+    VELOX_CHECK_NOT_NULL(aggregation);
+    VELOX_CHECK_EQ(
+        aggregation->partitionGroupingSets_.size(),
+        partitionGroupingSets_.size());
+    aggregations.push_back(aggregation);
+  }
+
+  // Each partition is produced by one aggregation that merges the groups of
+  // the other aggregations for the same partition into its own.
+  for (auto partition = 0; partition < partitionGroupingSets_.size();
+       ++partition) {
+    auto* owner = aggregations[partition % aggregations.size()];
+    OutputPartition output;
+    for (auto* aggregation : aggregations) {
+      auto& groupingSet = aggregation->partitionGroupingSets_[partition];
+      if (aggregation == owner) {
+        output.groupingSet = std::move(groupingSet);
+      } else if (groupingSet->numDistinct() > 0) {
+        output.mergeSources.push_back(std::move(groupingSet));
+      }
+    }
+    owner->outputPartitions_.push_back(std::move(output));
+  }
+  for (auto* aggregation : aggregations) {
+    aggregation->partitionGroupingSets_.clear();
+  }
+  peersFinished_ = true;
+}
+
+RowVectorPtr HashAggregation::getPartitionedOutput() {
+  if (!noMoreInput_ || !peersFinished_) {
+    return nullptr;
+  }
+
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  const auto maxOutputRows = queryConfig.preferredOutputBatchRows();
+  for (;;) {
+    if (groupingSet_ == nullptr) {
+      if (nextOutputPartition_ == outputPartitions_.size()) {
+        outputPartitions_.clear();
+        finished_ = true;
+        return nullptr;
+      }
+      startOutputPartition(outputPartitions_[nextOutputPartition_++]);
+    }
+
+    prepareOutput(maxOutputRows);
+    if (groupingSet_->getOutput(
+            maxOutputRows,
+            queryConfig.preferredOutputBatchBytes(),
+            resultIterator_,
+            output_)) {
+      numOutputRows_ += output_->size();
+      return output_;
+    }
+    resultIterator_.reset();
+    groupingSet_.reset();
+  }
+}
+
+void HashAggregation::startOutputPartition(OutputPartition& partition) {
+  VELOX_CHECK_NULL(groupingSet_);
+  groupingSet_ = std::move(partition.groupingSet);
+
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  const auto maxRows = queryConfig.preferredOutputBatchRows();
+  const auto maxBytes = queryConfig.preferredOutputBatchBytes();
+  const auto& inputType = aggregationNode_->sources()[0]->outputType();
+  for (auto& source : partition.mergeSources) {
+    RowContainerIterator iterator;
+    for (;;) {
+      auto intermediate = std::static_pointer_cast<RowVector>(
+          BaseVector::create(intermediateType_, maxRows, pool()));
+      if (!source->getIntermediateOutput(
+              maxRows, maxBytes, iterator, intermediate)) {
+        break;
+      }
+      // Lay out the intermediate results as the input of 'this'. The input
+      // columns that are not grouping keys or aggregate inputs are left null.
+      const auto size = intermediate->size();
+      std::vector<VectorPtr> children(inputType->size());
+      for (auto i = 0; i < intermediateChannels_.size(); ++i) {
+        children[intermediateChannels_[i]] = intermediate->childAt(i);
+      }
+      for (auto i = 0; i < children.size(); ++i) {
+        if (children[i] == nullptr) {
+          children[i] = BaseVector::createNullConstant(
+              inputType->childAt(i), size, pool());
+        }
+      }
+      groupingSet_->addInput(
+          std::make_shared<RowVector>(
+              pool(), inputType, nullptr, size, std::move(children)),
+          false);
+    }
+    // Free the memory of the merged groups right away.
+    source.reset();
+  }
+  addRuntimeStat(
+      "numMergedPartitions", RuntimeCounter(partition.mergeSources.size()));
+  partition.mergeSources.clear();
+  groupingSet_->noMoreInput();
+}
+
 void HashAggregation::reclaim(
     uint64_t targetBytes,
     memory::MemoryReclaimer::Stats& stats) {
   VELOX_CHECK(canReclaim());
 
+  // The grouping set is created by initialize() on the driver thread and
+  // holds no memory before.
+  if (groupingSet_ == nullptr) {
+    return;
+  }
+
   // NOTE: an aggregation operator is reclaimable if it hasn't started output
   // processing and is not under non-reclaimable execution section.
   if (nonReclaimableSection_) {
@@ -505,6 +900,13 @@ void HashAggregation::reclaim(
     // record stats here.
     recordSpillStats();
   } else {
+    // Returning the fully free arenas of the accumulators is cheap and avoids
+    // the spill if it frees enough memory.
+    const auto freedBytes = groupingSet_->freeEmptyStringArenas();
+    if (targetBytes > 0 && freedBytes >= targetBytes) {
+      pool()->release();
+      return;
+    }
     // TODO: support fine-grain disk spilling based on 'targetBytes' after
     // having row container memory compaction support later.
     groupingSet_->spill(0, targetBytes);
@@ -520,6 +922,8 @@ void HashAggregation::close() {
 
   output_ = nullptr;
   groupingSet_.reset();
+  partitionGroupingSets_.clear();
+  outputPartitions_.clear();
 }
 
 void HashAggregation::abort() {
@@ -15,7 +15,10 @@
  */
 #pragma once
 
+#include <folly/container/F14Set.h>
+
 #include "velox/exec/GroupingSet.h"
+#include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/Operator.h"
 
 namespace facebook::velox::exec {
@@ -27,6 +30,8 @@ class HashAggregation : public Operator {
       DriverCtx* driverCtx,
       const std::shared_ptr<const core::AggregationNode>& aggregationNode);
 
+  void initialize() override;
+
   void addInput(RowVectorPtr input) override;
 
   RowVectorPtr getOutput() override;
@@ -37,9 +42,7 @@ class HashAggregation : public Operator {
 
   void noMoreInput() override;
 
-  BlockingReason isBlocked(ContinueFuture* /* unused */) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override;
 
@@ -51,6 +54,38 @@ class HashAggregation : public Operator {
   void abort() override;
 
  private:
+  // A partition of a partitioned final aggregation to produce output for.
+  struct OutputPartition {
+    // The groups of the partition added by this operator.
+    std::unique_ptr<GroupingSet> groupingSet;
+    // The groups of the partition added by the peer operators. These are
+    // merged into 'groupingSet' before producing output.
+    std::vector<std::unique_ptr<GroupingSet>> mergeSources;
+  };
+
+  // Creates a GroupingSet for the grouping keys and aggregates of
+  // 'aggregationNode_'.
+  std::unique_ptr<GroupingSet> createGroupingSet();
+
+  // Creates the grouping sets of a partitioned final aggregation with one
+  // partition per driver rounded up to a power of two. No-op if already
+  // created.
+  void initializePartitions();
+
+  // Adds 'input' to the grouping sets of the partitions of its groups.
+  void addPartitionedInput(const RowVectorPtr& input);
+
+  // Waits for all peers to finish input. The last peer to finish assigns each
+  // partition to one of the peers for producing output.
+  void finishPartitionedInput();
+
+  // Produces output for the partitions assigned to 'this' one by one.
+  RowVectorPtr getPartitionedOutput();
+
+  // Merges the peer groups of 'partition' into its own grouping set and makes
+  // it 'groupingSet_' for producing output.
+  void startOutputPartition(OutputPartition& partition);
+
   void updateRuntimeStats();
 
   void prepareOutput(vector_size_t size);
@@ -65,18 +100,38 @@ class HashAggregation : public Operator {
   // measure of the effectiveness of the partial aggregation.
   void maybeIncreasePartialAggregationMemoryUsage(double aggregationPct);
 
+  // Updates the partial aggregation memory limit to 'memoryUsage' after the
+  // memory reservation for it succeeds.
+  void extendPartialAggregationMemoryUsage(int64_t memoryUsage);
+
   // True if we have enough rows and not enough reduction, i.e. more than
   // 'abandonPartialAggregationMinRows_' rows and more than
   // 'abandonPartialAggregationMinPct_' % of rows are unique.
   bool abandonPartialAggregationEarly(int64_t numOutput) const;
 
+  // Called with each input batch after partial aggregation has been
+  // abandoned. Every 'partialAggregationReenableIntervalRows_' rows, checks
+  // the unique grouping keys of 'input' and, if fewer than
+  // 'abandonPartialAggregationMinPct_' % of its rows are unique, replaces
+  // 'groupingSet_' with a new one and returns true to aggregate 'input'.
+  bool maybeReenablePartialAggregation(const RowVectorPtr& input);
+
+  // Returns the percentage of rows in 'input' with unique grouping keys,
+  // estimated from the hashes of the keys.
+  int32_t uniqueKeysPct(const RowVectorPtr& input);
+
   // Invoked to record the spilling stats in operator stats after processing all
   // the inputs.
   void recordSpillStats();
 
+  const std::shared_ptr<const core::AggregationNode> aggregationNode_;
   const bool isPartialOutput_;
   const bool isGlobal_;
   const bool isDistinct_;
+  // True if this is a final aggregation that splits its groups into hash
+  // partitions which are finalized in parallel by all drivers of the
+  // pipeline. See QueryConfig::kPartitionedFinalAggregationEnabled.
+  const bool partitionedFinal_;
   const int64_t maxExtendedPartialAggregationMemoryUsage_;
 
   int64_t maxPartialAggregationMemoryUsage_;
@@ -96,6 +151,22 @@ class HashAggregation : public Operator {
   // are unique, the partial aggregation is not worthwhile.
   const int32_t abandonPartialAggregationMinPct_;
 
+  // Number of pass-through rows between checks of whether an abandoned
+  // partial aggregation should resume. 0 if it never resumes.
+  const int64_t partialAggregationReenableIntervalRows_;
+
+  // Input channels of the grouping keys. Set if
+  // 'partialAggregationReenableIntervalRows_' > 0.
+  std::vector<column_index_t> groupingKeyChannels_;
+
+  // Number of rows passed through since the abandonment or the last check of
+  // whether partial aggregation should resume.
+  int64_t numPassThroughRows_{0};
+
+  // Temporaries for uniqueKeysPct().
+  std::vector<uint64_t> keyHashes_;
+  folly::F14FastSet<uint64_t> uniqueKeyHashes_;
+
   RowContainerIterator resultIterator_;
   bool pushdownChecked_ = false;
   bool mayPushdown_ = false;
@@ -109,6 +180,45 @@ class HashAggregation : public Operator {
 
   // Possibly reusable output vector.
   RowVectorPtr output_;
+
+  // The input channels of the grouping keys followed by the input channels of
+  // the intermediate results of the aggregates. Set if 'partitionedFinal_'.
+  std::vector<column_index_t> intermediateChannels_;
+
+  // The types of 'intermediateChannels_'. Used for extracting the groups of
+  // the peers in partitioned final aggregation.
+  RowTypePtr intermediateType_;
+
+  // Assigns input rows to partitions in partitioned final aggregation.
+  std::unique_ptr<HashPartitionFunction> partitionFunction_;
+
+  // Partition number for each input row. Reused across input batches.
+  std::vector<uint32_t> partitions_;
+
+  // The grouping sets for the partitions while receiving input.
+  std::vector<std::unique_ptr<GroupingSet>> partitionGroupingSets_;
+
+  // The partitions assigned to 'this' for producing output. Set by the last
+  // peer to finish input.
+  std::vector<OutputPartition> outputPartitions_;
+
+  // Index of the next partition in 'outputPartitions_' to produce output for.
+  size_t nextOutputPartition_{0};
+
+  // Future for waiting for the peers to finish input in partitioned final
+  // aggregation.
+  ContinueFuture future_{ContinueFuture::makeEmpty()};
+
+  // Set while waiting for the memory reservation made on the arbitration
+  // executor to extend the partial aggregation memory limit. The reservation
+  // outcome is set in 'extendedReservation_' and the limit is updated to
+  // 'pendingPartialAggregationMemoryUsage_' on success.
+  ContinueFuture memoryFuture_{ContinueFuture::makeEmpty()};
+  std::shared_ptr<std::atomic_bool> extendedReservation_;
+  int64_t pendingPartialAggregationMemoryUsage_{0};
+
+  // True once all peers have finished input and 'outputPartitions_' is set.
+  bool peersFinished_{false};
 };
 
 } // namespace facebook::velox::exec
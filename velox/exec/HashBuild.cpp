@@ -36,6 +36,8 @@ BlockingReason fromStateToBlockingReason(HashBuild::State state) {
     case HashBuild::State::kWaitForBuild:
       return BlockingReason::kWaitForJoinBuild;
     case HashBuild::State::kWaitForProbe:
+      [[fallthrough]];
+    case HashBuild::State::kWaitForSwap:
       return BlockingReason::kWaitForJoinProbe;
     default:
       VELOX_UNREACHABLE(HashBuild::stateName(state));
@@ -114,6 +116,16 @@ HashBuild::HashBuild(
   }
 
   tableType_ = ROW(std::move(names), std::move(types));
+  setupCache();
+  // A cached table is built by another join or shared with other joins.
+  const auto& queryConfig = operatorCtx_->driverCtx()->queryConfig();
+  if (canSwapJoinSides(joinNode_, queryConfig) && !cachedTable_.has_value() &&
+      !cacheKey_.has_value()) {
+    joinBridge_->enableSwap(
+        queryConfig.hashJoinSwapSidesRatio(),
+        queryConfig.hashJoinSwapMaxProbeBytes());
+    swapState_ = HashJoinBridge::SwapState::kUndecided;
+  }
   setupTable();
   setupSpiller();
 
@@ -150,7 +162,7 @@ void HashBuild::setupTable() {
         operatorCtx_->driverCtx()
             ->queryConfig()
             .minTableRowsForParallelJoinBuild(),
-        pool());
+        tablePool());
   } else {
     // (Left) semi and anti join with no extra filter only needs to know whether
     // there is a match. Hence, no need to store entries with duplicate keys.
@@ -170,7 +182,7 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          tablePool());
     } else {
       // Ignore null keys
       table_ = HashTable<true>::createForJoin(
@@ -181,12 +193,50 @@ void HashBuild::setupTable() {
           operatorCtx_->driverCtx()
               ->queryConfig()
               .minTableRowsForParallelJoinBuild(),
-          pool());
+          tablePool());
     }
   }
   analyzeKeys_ = table_->hashMode() != BaseHashTable::HashMode::kHash;
 }
 
+std::optional<std::string> HashBuild::makeCacheKey() const {
+  const auto& buildCacheKey = joinNode_->buildCacheKey();
+  if (!buildCacheKey.has_value() || HashTableCache::getInstance() == nullptr) {
+    return std::nullopt;
+  }
+  // Probes of right and full joins and of right semi joins set the probed
+  // flags of the build rows. Spilled and grouped execution tables hold a
+  // part of the build side.
+  if (joinNode_->isRightJoin() || joinNode_->isFullJoin() ||
+      joinNode_->isRightSemiFilterJoin() ||
+      joinNode_->isRightSemiProjectJoin() || spillEnabled() ||
+      operatorCtx_->driverCtx()->splitGroupId != kUngroupedGroupId) {
+    return std::nullopt;
+  }
+  // The join type, the null awareness and the filter decide which build rows
+  // are kept and whether duplicate keys are.
+  return fmt::format(
+      "{}\n{}{}\n{}\n{}",
+      buildCacheKey.value(),
+      core::joinTypeName(joinType_),
+      nullAware_ ? " null aware" : "",
+      joinNode_->filter() ? joinNode_->filter()->toString() : "",
+      tableType_->toString());
+}
+
+void HashBuild::setupCache() {
+  auto key = makeCacheKey();
+  if (!key.has_value()) {
+    return;
+  }
+  auto* cache = HashTableCache::getInstance();
+  cachedTable_ = cache->find(key.value());
+  if (!cachedTable_.has_value()) {
+    cacheKey_ = std::move(key);
+    cachePools_.push_back(cache->makeBuildPool());
+  }
+}
+
 void HashBuild::setupSpiller(SpillPartition* spillPartition) {
   VELOX_CHECK_NULL(spiller_);
   VELOX_CHECK_NULL(spillInputReader_);
@@ -198,12 +248,15 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
   HashBitRange hashBits(
       spillConfig.startPartitionBit,
       spillConfig.startPartitionBit + spillConfig.joinPartitionBits);
+  uint64_t restoredPartitionBytes{0};
   if (spillPartition == nullptr) {
     spillGroup_->addOperator(
         *this,
         operatorCtx_->driver()->shared_from_this(),
         [&](const std::vector<Operator*>& operators) { runSpill(operators); });
   } else {
+    // Measure the partition before the reader takes over its spill files.
+    restoredPartitionBytes = spillPartition->size();
     spillInputReader_ = spillPartition->createReader();
 
     const auto startBit = spillPartition->id().partitionBitOffset() +
@@ -230,9 +283,25 @@ void HashBuild::setupSpiller(SpillPartition* spillPartition) {
       spillConfig.minSpillRunSize,
       spillConfig.compressionKind,
       Spiller::pool(),
-      spillConfig.executor);
+      spillConfig.executor,
+      spillConfig.writeRateLimiter);
 
   const int32_t numPartitions = spiller_->hashBits().numPartitions();
+  const auto repartitionBytes = operatorCtx_->driverCtx()
+                                    ->queryConfig()
+                                    .joinSpillRepartitionBytes();
+  if (repartitionBytes > 0 && restoredPartitionBytes > repartitionBytes) {
+    // The restored partition is too large to be built in memory, so route
+    // all its rows straight into the next level spill partitions.
+    SpillPartitionNumSet partitions;
+    for (auto partition = 0; partition < numPartitions; ++partition) {
+      partitions.insert(partition);
+    }
+    spiller_->setPartitionsSpilled(partitions);
+    stats_.wlock()->addRuntimeStat(
+        "spillRepartitionBytes",
+        RuntimeCounter(restoredPartitionBytes, RuntimeCounter::Unit::kBytes));
+  }
   spillInputIndicesBuffers_.resize(numPartitions);
   rawSpillInputIndicesBuffers_.resize(numPartitions);
   numSpillInputs_.resize(numPartitions, 0);
@@ -305,6 +374,11 @@ void HashBuild::removeInputRowsForAntiJoinFilter() {
 void HashBuild::addInput(RowVectorPtr input) {
   checkRunning();
 
+  if (swapState_ != HashJoinBridge::SwapState::kNoSwap) {
+    addSwapInput(std::move(input));
+    return;
+  }
+
   if (!ensureInputFits(input)) {
     VELOX_CHECK_NOT_NULL(input_);
     VELOX_CHECK(future_.valid());
@@ -403,6 +477,69 @@ void HashBuild::addInput(RowVectorPtr input) {
   });
 }
 
+void HashBuild::addSwapInput(RowVectorPtr input) {
+  // The source may reuse the memory of unloaded lazy vectors for its next
+  // output.
+  input->loadedVector();
+  if (swapState_ == HashJoinBridge::SwapState::kSwap) {
+    if (joinBridge_->addBuildInput(std::move(input), &future_)) {
+      setState(State::kWaitForSwap);
+    }
+    return;
+  }
+  const auto bytes = input->estimateFlatSize();
+  swapInputs_.push_back(std::move(input));
+  processSwapState(joinBridge_->addBuildInputBytes(bytes, &future_));
+}
+
+void HashBuild::processSwapState(HashJoinBridge::SwapState state) {
+  checkRunning();
+  swapState_ = state;
+  switch (state) {
+    case HashJoinBridge::SwapState::kUndecided:
+      if (future_.valid()) {
+        setState(State::kWaitForSwap);
+      }
+      return;
+    case HashJoinBridge::SwapState::kNoSwap: {
+      VELOX_CHECK(!future_.valid());
+      auto inputs = std::move(swapInputs_);
+      for (auto& input : inputs) {
+        addInput(std::move(input));
+      }
+      if (noMoreInput_) {
+        noMoreInputInternal();
+      }
+      return;
+    }
+    case HashJoinBridge::SwapState::kSwap: {
+      VELOX_CHECK(!future_.valid());
+      auto inputs = std::move(swapInputs_);
+      for (auto& input : inputs) {
+        // Waits for the last input only. The buffered input is in memory
+        // anyway.
+        ContinueFuture future{ContinueFuture::makeEmpty()};
+        if (joinBridge_->addBuildInput(std::move(input), &future)) {
+          future_ = std::move(future);
+        }
+      }
+      if (future_.valid()) {
+        setState(State::kWaitForSwap);
+      } else if (noMoreInput_) {
+        finishSwappedBuild();
+      }
+      return;
+    }
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+void HashBuild::finishSwappedBuild() {
+  joinBridge_->buildInputFinished();
+  setState(State::kFinish);
+}
+
 bool HashBuild::ensureInputFits(RowVectorPtr& input) {
   // NOTE: we don't need memory reservation if all the partitions are spilling
   // as we spill all the input rows to disk directly.
@@ -709,7 +846,16 @@ void HashBuild::noMoreInput() {
   }
   Operator::noMoreInput();
 
-  noMoreInputInternal();
+  switch (swapState_) {
+    case HashJoinBridge::SwapState::kUndecided:
+      processSwapState(joinBridge_->buildBufferingFinished(&future_));
+      return;
+    case HashJoinBridge::SwapState::kSwap:
+      finishSwappedBuild();
+      return;
+    default:
+      noMoreInputInternal();
+  }
 }
 
 void HashBuild::noMoreInputInternal() {
@@ -754,6 +900,13 @@ bool HashBuild::finishHashBuild() {
     }
   });
 
+  if (cachedTable_.has_value()) {
+    addRuntimeStat("hashTableCacheHits", RuntimeCounter(1));
+    joinBridge_->setHashTable(
+        cachedTable_->table, {}, cachedTable_->hasNullKeys);
+    return true;
+  }
+
   if (joinHasNullKeys_ && isAntiJoin(joinType_) && nullAware_ &&
       !joinNode_->filter()) {
     joinBridge_->setAntiJoinHasNullKeys();
@@ -787,6 +940,9 @@ bool HashBuild::finishHashBuild() {
   for (auto* build : otherBuilds) {
     VELOX_CHECK_NOT_NULL(build->table_);
     otherTables.push_back(std::move(build->table_));
+    if (cacheKey_.has_value()) {
+      cachePools_.push_back(std::move(build->cachePools_[0]));
+    }
     if (build->spiller_ != nullptr) {
       build->spiller_->finishSpill(spillPartitions);
       build->recordSpillStats();
@@ -817,9 +973,29 @@ bool HashBuild::finishHashBuild() {
       std::move(otherTables),
       allowParallelJoinBuild ? operatorCtx_->task()->queryCtx()->executor()
                              : nullptr);
+  if (spillPartitions.empty()) {
+    buildKeyBloomFilters();
+    // The probe of a semi or anti join without filter only checks whether a
+    // key has a match and does not access the build rows.
+    if (!joinNode_->filter() &&
+        (joinNode_->isLeftSemiFilterJoin() ||
+         joinNode_->isLeftSemiProjectJoin() || isAntiJoin(joinType_))) {
+      table_->enableMembershipProbe();
+    }
+  }
   addRuntimeStats();
-  if (joinBridge_->setHashTable(
-          std::move(table_), std::move(spillPartitions), joinHasNullKeys_)) {
+  if (cacheKey_.has_value()) {
+    VELOX_CHECK(spillPartitions.empty());
+    auto table = HashTableCache::getInstance()->add(
+        cacheKey_.value(),
+        std::move(table_),
+        joinHasNullKeys_,
+        std::move(cachePools_));
+    joinBridge_->setHashTable(std::move(table), {}, joinHasNullKeys_);
+  } else if (joinBridge_->setHashTable(
+                 std::move(table_),
+                 std::move(spillPartitions),
+                 joinHasNullKeys_)) {
     spillGroup_->restart();
   }
 
@@ -829,6 +1005,137 @@ bool HashBuild::finishHashBuild() {
   return true;
 }
 
+namespace {
+bool canUseBloomFilter(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return true;
+    default:
+      return false;
+  }
+}
+
+template <typename T>
+void addToBloomFilterTyped(
+    const BaseVector& keys,
+    vector_size_t numRows,
+    BloomFilter<>& bloomFilter) {
+  auto* values = keys.asUnchecked<FlatVector<T>>();
+  for (auto i = 0; i < numRows; ++i) {
+    if (values->isNullAt(i)) {
+      continue;
+    }
+    if constexpr (std::is_same_v<T, StringView>) {
+      const auto value = values->valueAt(i);
+      bloomFilter.insert(common::ValuesUsingBloomFilter::hashBytes(
+          value.data(), value.size()));
+    } else {
+      bloomFilter.insert(
+          common::ValuesUsingBloomFilter::hashInt64(values->valueAt(i)));
+    }
+  }
+}
+
+// Adds the non-null values of 'keys' extracted from the build side rows to
+// 'bloomFilter'. 'keys' is a flat vector of a type accepted by
+// canUseBloomFilter().
+void addToBloomFilter(
+    const BaseVector& keys,
+    vector_size_t numRows,
+    BloomFilter<>& bloomFilter) {
+  switch (keys.typeKind()) {
+    case TypeKind::TINYINT:
+      addToBloomFilterTyped<int8_t>(keys, numRows, bloomFilter);
+      break;
+    case TypeKind::SMALLINT:
+      addToBloomFilterTyped<int16_t>(keys, numRows, bloomFilter);
+      break;
+    case TypeKind::INTEGER:
+      addToBloomFilterTyped<int32_t>(keys, numRows, bloomFilter);
+      break;
+    case TypeKind::BIGINT:
+      addToBloomFilterTyped<int64_t>(keys, numRows, bloomFilter);
+      break;
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      addToBloomFilterTyped<StringView>(keys, numRows, bloomFilter);
+      break;
+    default:
+      VELOX_UNREACHABLE("{}", keys.type()->toString());
+  }
+}
+} // namespace
+
+void HashBuild::buildKeyBloomFilters() {
+  const auto maxSize = operatorCtx_->driverCtx()
+                           ->queryConfig()
+                           .hashProbeBloomFilterPushdownMaxSize();
+  if (maxSize == 0 || table_->numDistinct() == 0) {
+    return;
+  }
+  if (!isInnerJoin(joinType_) && !isLeftSemiFilterJoin(joinType_) &&
+      !isRightSemiFilterJoin(joinType_) && !isRightSemiProjectJoin(joinType_)) {
+    return;
+  }
+  // BloomFilter::reset() allocates 2 bytes per expected entry.
+  const uint64_t capacity = bits::nextPowerOfTwo(table_->numDistinct());
+  if (capacity * 2 > maxSize) {
+    return;
+  }
+
+  const auto& hashers = table_->hashers();
+  std::vector<std::shared_ptr<BloomFilter<>>> bloomFilters(hashers.size());
+  std::vector<VectorPtr> keys(hashers.size());
+  bool hasBloomFilter = false;
+  for (auto i = 0; i < hashers.size(); ++i) {
+    if (!canUseBloomFilter(hashers[i]->typeKind())) {
+      continue;
+    }
+    bloomFilters[i] = std::make_shared<BloomFilter<>>();
+    bloomFilters[i]->reset(capacity);
+    keys[i] = BaseVector::create(hashers[i]->type(), 0, pool());
+    hasBloomFilter = true;
+  }
+  if (!hasBloomFilter) {
+    return;
+  }
+
+  // Adds the keys of all the rows, including the ones in the tables merged
+  // from the other build drivers.
+  constexpr int32_t kBatchSize = 1'024;
+  std::vector<char*> rows(kBatchSize);
+  BaseHashTable::RowsIterator iter;
+  while (auto numRows = table_->listAllRows(
+             &iter, kBatchSize, RowContainer::kUnlimited, rows.data())) {
+    for (auto i = 0; i < hashers.size(); ++i) {
+      if (bloomFilters[i] == nullptr) {
+        continue;
+      }
+      table_->rows()->extractColumn(rows.data(), numRows, i, keys[i]);
+      addToBloomFilter(*keys[i], numRows, *bloomFilters[i]);
+    }
+  }
+
+  std::vector<std::shared_ptr<common::Filter>> keyBloomFilters(hashers.size());
+  uint64_t bloomFilterBytes{0};
+  for (auto i = 0; i < hashers.size(); ++i) {
+    if (bloomFilters[i] != nullptr) {
+      bloomFilterBytes += bloomFilters[i]->serializedSize();
+      keyBloomFilters[i] = std::make_shared<common::ValuesUsingBloomFilter>(
+          std::move(bloomFilters[i]), false);
+    }
+  }
+  table_->setKeyBloomFilters(std::move(keyBloomFilters));
+  stats_.wlock()->addRuntimeStat(
+      "bloomFilterBytes",
+      RuntimeCounter(bloomFilterBytes, RuntimeCounter::Unit::kBytes));
+}
+
 void HashBuild::recordSpillStats() {
   VELOX_CHECK_NOT_NULL(spiller_);
   const auto spillStats = spiller_->stats();
@@ -968,6 +1275,9 @@ BlockingReason HashBuild::isBlocked(ContinueFuture* future) {
     case State::kRunning:
       if (isInputFromSpill()) {
         processSpillInput();
+      } else if (cachedTable_.has_value() && !noMoreInput_) {
+        // The build side input is not needed with a cached table.
+        noMoreInput();
       }
       break;
     case State::kFinish:
@@ -987,6 +1297,16 @@ BlockingReason HashBuild::isBlocked(ContinueFuture* future) {
         postHashBuildProcess();
       }
       break;
+    case State::kWaitForSwap:
+      if (!future_.valid()) {
+        setRunning();
+        if (swapState_ == HashJoinBridge::SwapState::kUndecided) {
+          processSwapState(joinBridge_->swapStateOrFuture(&future_));
+        } else if (noMoreInput_) {
+          finishSwappedBuild();
+        }
+      }
+      break;
     default:
       VELOX_UNREACHABLE("Unexpected state: {}", stateName(state_));
       break;
@@ -1024,7 +1344,9 @@ void HashBuild::checkStateTransition(State state) {
   switch (state) {
     case State::kRunning:
       if (!spillEnabled()) {
-        VELOX_CHECK_EQ(state_, State::kWaitForBuild);
+        VELOX_CHECK(
+            state_ == State::kWaitForBuild || state_ == State::kWaitForSwap,
+            stateName(state_));
       } else {
         VELOX_CHECK_NE(state_, State::kFinish);
       }
@@ -1035,6 +1357,8 @@ void HashBuild::checkStateTransition(State state) {
       [[fallthrough]];
     case State::kWaitForProbe:
       [[fallthrough]];
+    case State::kWaitForSwap:
+      [[fallthrough]];
     case State::kFinish:
       VELOX_CHECK_EQ(state_, State::kRunning);
       break;
@@ -1056,6 +1380,8 @@ std::string HashBuild::stateName(State state) {
       return "WAIT_FOR_PROBE";
     case State::kFinish:
       return "FINISH";
+    case State::kWaitForSwap:
+      return "WAIT_FOR_SWAP";
     default:
       return fmt::format("UNKNOWN: {}", static_cast<int>(state));
   }
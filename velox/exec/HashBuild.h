@@ -17,6 +17,7 @@
 
 #include "velox/exec/HashJoinBridge.h"
 #include "velox/exec/HashTable.h"
+#include "velox/exec/HashTableCache.h"
 #include "velox/exec/Operator.h"
 #include "velox/exec/Spill.h"
 #include "velox/exec/SpillOperatorGroup.h"
@@ -53,6 +54,10 @@ class HashBuild final : public Operator {
     kWaitForProbe = 4,
     /// The finishing state.
     kFinish = 5,
+    /// The state that waits for the join to decide whether to swap its sides,
+    /// or for the probe side to take the input passed to it after the swap.
+    /// This state only applies if the join may swap its sides.
+    kWaitForSwap = 6,
   };
   static std::string stateName(State state);
 
@@ -113,6 +118,20 @@ class HashBuild final : public Operator {
     return spillConfig_.has_value();
   }
 
+  // Looks up the table in HashTableCache if the join opts into caching and
+  // its table can be shared. Sets 'cachedTable_' on a hit and 'cacheKey_' and
+  // 'cachePools_' on a miss.
+  void setupCache();
+
+  // Returns the key of the table in HashTableCache, or std::nullopt if the
+  // table is not to be cached.
+  std::optional<std::string> makeCacheKey() const;
+
+  // Returns the pool to build 'table_' in.
+  memory::MemoryPool* tablePool() const {
+    return cachePools_.empty() ? pool() : cachePools_[0].get();
+  }
+
   const common::SpillConfig* spillConfig() const {
     return spillConfig_.has_value() ? &spillConfig_.value() : nullptr;
   }
@@ -234,6 +253,28 @@ class HashBuild final : public Operator {
 
   void addRuntimeStats();
 
+  // Invoked by the last build driver after the join table has been built to
+  // create Bloom filters over the values of the join keys if enabled by
+  // 'hash_probe_bloom_filter_pushdown_max_size'. The filters are set on
+  // 'table_' for the hash probe to push down into the probe side table scan
+  // when the join keys have no exact value filter, e.g. with string keys or
+  // too many distinct values.
+  void buildKeyBloomFilters();
+
+  // Invoked instead of adding 'input' to the table if the join may swap its
+  // sides, see QueryConfig::kHashJoinSwapSidesRatio. Buffers 'input' in
+  // 'swapInputs_' while the swap is undecided and passes it to the probe side
+  // after the swap.
+  void addSwapInput(RowVectorPtr input);
+
+  // Invoked with the swap 'state' returned by 'joinBridge_'. Adds the
+  // buffered input to the table without a swap, or passes it to the probe
+  // side with a swap. Transitions to 'kWaitForSwap' state if 'future_' is set.
+  void processSwapState(HashJoinBridge::SwapState state);
+
+  // Invoked at the end of the input after the swap.
+  void finishSwappedBuild();
+
   // Invoked to check if it needs to trigger spilling for test purpose only.
   bool testingTriggerSpill();
 
@@ -256,6 +297,19 @@ class HashBuild final : public Operator {
   // The row type used for hash table build and disk spilling.
   RowTypePtr tableType_;
 
+  // Set if the table is found in HashTableCache. The operator then takes no
+  // input and hands the cached table to the probe side.
+  std::optional<HashTableCache::Entry> cachedTable_;
+
+  // Set if the table is to be added to HashTableCache after the build.
+  std::optional<std::string> cacheKey_;
+
+  // Pools of HashTableCache that hold the rows of 'table_' if 'cacheKey_' is
+  // set. The first one is the pool of this operator. The pools of the peers
+  // are added when their tables are merged into 'table_'. Declared before
+  // 'table_' to be freed after it.
+  std::vector<std::shared_ptr<memory::MemoryPool>> cachePools_;
+
   // Container for the rows being accumulated.
   std::unique_ptr<BaseHashTable> table_;
 
@@ -311,6 +365,13 @@ class HashBuild final : public Operator {
   // Indicates whether the filter is null-propagating.
   bool filterPropagatesNulls_{false};
 
+  // The swap state of the join last returned by 'joinBridge_'. Stays
+  // 'kNoSwap' if the join cannot swap its sides.
+  HashJoinBridge::SwapState swapState_{HashJoinBridge::SwapState::kNoSwap};
+
+  // The input buffered while the swap is undecided.
+  std::vector<RowVectorPtr> swapInputs_;
+
   // Indices of key columns used by the filter in build side table.
   std::vector<column_index_t> keyFilterChannels_;
   // Indices of dependent columns used by the filter in 'decoders_'.
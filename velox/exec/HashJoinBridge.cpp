@@ -30,6 +30,9 @@ void HashJoinBridge::start() {
   std::lock_guard<std::mutex> l(mutex_);
   started_ = true;
   VELOX_CHECK_GT(numBuilders_, 0);
+  if (!swapDisabled_ && numSwapBuilders_ == numBuilders_ && numProbers_ > 0) {
+    swapState_ = SwapState::kUndecided;
+  }
 }
 
 void HashJoinBridge::addBuilder() {
@@ -39,7 +42,7 @@ void HashJoinBridge::addBuilder() {
 }
 
 bool HashJoinBridge::setHashTable(
-    std::unique_ptr<BaseHashTable> table,
+    std::shared_ptr<BaseHashTable> table,
     SpillPartitionSet spillPartitionSet,
     bool hasNullKeys) {
   VELOX_CHECK_NOT_NULL(table, "setHashTable called with null table");
@@ -172,6 +175,255 @@ std::optional<HashJoinBridge::SpillInput> HashJoinBridge::spillInputOrFuture(
   return SpillInput(std::move(spillShard));
 }
 
+void HashJoinBridge::addProber() {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!started_);
+  ++numProbers_;
+}
+
+void HashJoinBridge::enableSwap(double ratio, uint64_t maxProbeBytes) {
+  VELOX_CHECK_GT(ratio, 0);
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!started_);
+  ++numSwapBuilders_;
+  swapRatio_ = ratio;
+  swapMaxProbeBytes_ = maxProbeBytes;
+}
+
+void HashJoinBridge::disableSwap() {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    swapDisabled_ = true;
+    VELOX_CHECK(swapState_ != SwapState::kSwap);
+    if (swapState_ == SwapState::kUndecided) {
+      swapState_ = SwapState::kNoSwap;
+      promises = std::move(promises_);
+    }
+  }
+  notify(std::move(promises));
+}
+
+HashJoinBridge::SwapState HashJoinBridge::swapState() {
+  std::lock_guard<std::mutex> l(mutex_);
+  return swapState_;
+}
+
+HashJoinBridge::SwapState HashJoinBridge::swapStateOrFuture(
+    ContinueFuture* future) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!cancelled_, "Getting swap state after join is aborted");
+  if (swapState_ == SwapState::kUndecided) {
+    waitLocked("HashJoinBridge::swapStateOrFuture", future);
+  }
+  return swapState_;
+}
+
+std::vector<ContinuePromise> HashJoinBridge::maybeDecideSwapLocked() {
+  if (swapState_ != SwapState::kUndecided) {
+    return {};
+  }
+  const double swapBuildBytes =
+      swapRatio_ * std::max<uint64_t>(probeBytes_, 1);
+  if (probeBytes_ > swapMaxProbeBytes_) {
+    swapState_ = SwapState::kNoSwap;
+  } else if (
+      numProbersFinished_ == numProbers_ && buildBytes_ > swapBuildBytes) {
+    swapState_ = SwapState::kSwap;
+  } else if (
+      numBuildersFinished_ == numBuilders_ && buildBytes_ <= swapBuildBytes) {
+    // The probe side can only grow.
+    swapState_ = SwapState::kNoSwap;
+  } else {
+    return {};
+  }
+  return std::move(promises_);
+}
+
+void HashJoinBridge::waitLocked(const char* context, ContinueFuture* future) {
+  promises_.emplace_back(context);
+  *future = promises_.back().getSemiFuture();
+}
+
+void HashJoinBridge::addProbeInput(RowVectorPtr input) {
+  const auto bytes = input->estimateFlatSize();
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(started_);
+    // The swap is decided after the whole probe side input is buffered.
+    VELOX_CHECK(swapState_ != SwapState::kSwap);
+    probeInputs_.push_back(std::move(input));
+    probeBytes_ += bytes;
+    promises = maybeDecideSwapLocked();
+  }
+  notify(std::move(promises));
+}
+
+void HashJoinBridge::probeInputFinished() {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(started_);
+    VELOX_CHECK_LT(numProbersFinished_, numProbers_);
+    ++numProbersFinished_;
+    promises = maybeDecideSwapLocked();
+  }
+  notify(std::move(promises));
+}
+
+RowVectorPtr HashJoinBridge::takeProbeInput() {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(swapState_ == SwapState::kNoSwap);
+  if (probeInputs_.empty()) {
+    return nullptr;
+  }
+  auto input = std::move(probeInputs_.back());
+  probeInputs_.pop_back();
+  return input;
+}
+
+HashJoinBridge::SwapState HashJoinBridge::addBuildInputBytes(
+    uint64_t bytes,
+    ContinueFuture* future) {
+  std::vector<ContinuePromise> promises;
+  SwapState state;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(started_);
+    VELOX_CHECK(!cancelled_, "Adding build input after join is aborted");
+    buildBytes_ += bytes;
+    promises = maybeDecideSwapLocked();
+    // The probe side input is at most 'swapMaxProbeBytes_' if the sides are
+    // swapped, so there is no need to buffer more build side input.
+    if (swapState_ == SwapState::kUndecided &&
+        buildBytes_ > swapRatio_ * swapMaxProbeBytes_) {
+      waitLocked("HashJoinBridge::addBuildInputBytes", future);
+    }
+    state = swapState_;
+  }
+  notify(std::move(promises));
+  return state;
+}
+
+HashJoinBridge::SwapState HashJoinBridge::buildBufferingFinished(
+    ContinueFuture* future) {
+  std::vector<ContinuePromise> promises;
+  SwapState state;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(started_);
+    VELOX_CHECK(!cancelled_, "Finishing build input after join is aborted");
+    VELOX_CHECK_LT(numBuildersFinished_, numBuilders_);
+    ++numBuildersFinished_;
+    promises = maybeDecideSwapLocked();
+    if (swapState_ == SwapState::kUndecided) {
+      waitLocked("HashJoinBridge::buildBufferingFinished", future);
+    }
+    state = swapState_;
+  }
+  notify(std::move(promises));
+  return state;
+}
+
+bool HashJoinBridge::addBuildInput(RowVectorPtr input, ContinueFuture* future) {
+  const auto bytes = input->estimateFlatSize();
+  std::vector<ContinuePromise> promises;
+  bool wait = false;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(!cancelled_, "Adding build input after join is aborted");
+    VELOX_CHECK(swapState_ == SwapState::kSwap);
+    buildInputs_.push_back(std::move(input));
+    buildInputBytes_ += bytes;
+    promises = std::move(promises_);
+    if (buildInputBytes_ > kMaxBuildInputBytes) {
+      waitLocked("HashJoinBridge::addBuildInput", future);
+      wait = true;
+    }
+  }
+  notify(std::move(promises));
+  return wait;
+}
+
+void HashJoinBridge::buildInputFinished() {
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(swapState_ == SwapState::kSwap);
+    VELOX_CHECK_LT(numBuildInputsFinished_, numBuilders_);
+    if (++numBuildInputsFinished_ == numBuilders_) {
+      promises = std::move(promises_);
+    }
+  }
+  notify(std::move(promises));
+}
+
+std::shared_ptr<BaseHashTable> HashJoinBridge::swappedTableOrFuture(
+    ContinueFuture* future,
+    std::vector<RowVectorPtr>& probeInputs) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK(!cancelled_, "Getting swapped table after join is aborted");
+  VELOX_CHECK(swapState_ == SwapState::kSwap);
+  if (swappedTable_ != nullptr) {
+    return swappedTable_;
+  }
+  if (!buildingSwappedTable_) {
+    buildingSwappedTable_ = true;
+    probeInputs = std::move(probeInputs_);
+    probeInputs_.clear();
+    return nullptr;
+  }
+  waitLocked("HashJoinBridge::swappedTableOrFuture", future);
+  return nullptr;
+}
+
+void HashJoinBridge::setSwappedTable(std::shared_ptr<BaseHashTable> table) {
+  VELOX_CHECK_NOT_NULL(table);
+  std::vector<ContinuePromise> promises;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(buildingSwappedTable_);
+    VELOX_CHECK_NULL(swappedTable_);
+    swappedTable_ = std::move(table);
+    promises = std::move(promises_);
+  }
+  notify(std::move(promises));
+}
+
+RowVectorPtr HashJoinBridge::nextBuildInput(ContinueFuture* future) {
+  std::vector<ContinuePromise> promises;
+  RowVectorPtr input;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    VELOX_CHECK(!cancelled_, "Getting build input after join is aborted");
+    VELOX_CHECK(swapState_ == SwapState::kSwap);
+    if (buildInputs_.empty()) {
+      if (numBuildInputsFinished_ < numBuilders_) {
+        waitLocked("HashJoinBridge::nextBuildInput", future);
+      }
+      return nullptr;
+    }
+    input = std::move(buildInputs_.front());
+    buildInputs_.pop_front();
+    const bool full = buildInputBytes_ > kMaxBuildInputBytes;
+    buildInputBytes_ -= input->estimateFlatSize();
+    // Wakes up the HashBuild operators waiting for the queue to drain.
+    if (full && buildInputBytes_ <= kMaxBuildInputBytes) {
+      promises = std::move(promises_);
+    }
+  }
+  notify(std::move(promises));
+  return input;
+}
+
+bool canSwapJoinSides(
+    const std::shared_ptr<const core::HashJoinNode>& joinNode,
+    const core::QueryConfig& queryConfig) {
+  return queryConfig.hashJoinSwapSidesRatio() > 0 && joinNode->isInnerJoin() &&
+      joinNode->filter() == nullptr && !joinNode->canSpill(queryConfig);
+}
+
 bool isLeftNullAwareJoinWithFilter(
     const std::shared_ptr<const core::HashJoinNode>& joinNode) {
   return (joinNode->isAntiJoin() || joinNode->isLeftSemiProjectJoin() ||
@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <deque>
+
 #include "velox/exec/HashTable.h"
 #include "velox/exec/JoinBridge.h"
 #include "velox/exec/MemoryReclaimer.h"
@@ -40,7 +42,7 @@ class HashJoinBridge : public JoinBridge {
   /// after HashProbe operators process 'table', otherwise false. This only
   /// applies if the disk spilling is enabled.
   bool setHashTable(
-      std::unique_ptr<BaseHashTable> table,
+      std::shared_ptr<BaseHashTable> table,
       SpillPartitionSet spillPartitionSet,
       bool hasNullKeys);
 
@@ -105,7 +107,100 @@ class HashJoinBridge : public JoinBridge {
   std::optional<SpillInput> spillInputOrFuture(
       ContinueFuture* FOLLY_NONNULL future);
 
+  /// The following support swapping the build and probe sides of the join,
+  /// see QueryConfig::kHashJoinSwapSidesRatio. The HashProbe operators buffer
+  /// their input here and the HashBuild operators buffer theirs until the
+  /// swap is decided. After a swap, one HashProbe operator builds a table
+  /// from the buffered probe side input and the HashBuild operators pass
+  /// their input through the bridge to the HashProbe operators which probe
+  /// it against that table. Without a swap, the HashBuild operators build the
+  /// table from their buffered input and the HashProbe operators probe it
+  /// with the buffered probe side input first.
+  enum class SwapState {
+    /// Both sides buffer their input.
+    kUndecided,
+    /// The join runs with the sides of the plan.
+    kNoSwap,
+    /// The build side input is probed against a table of the probe side.
+    kSwap,
+  };
+
+  /// Invoked by HashProbe operator ctor to add to this bridge by incrementing
+  /// 'numProbers_'.
+  void addProber();
+
+  /// Invoked by HashBuild operator ctor if the join may swap its sides. The
+  /// sides are swapped only if all HashBuild operators enable the swap and no
+  /// operator disables it.
+  void enableSwap(double ratio, uint64_t maxProbeBytes);
+
+  /// Decides not to swap the sides. Invoked by HashProbe operator if it
+  /// cannot buffer its input, e.g. to push down dynamic filters.
+  void disableSwap();
+
+  SwapState swapState();
+
+  /// Returns the swap state. Sets 'future' to wait for the swap to be decided
+  /// if it is still undecided.
+  SwapState swapStateOrFuture(ContinueFuture* future);
+
+  /// Invoked by HashProbe operator to buffer 'input' while the swap is
+  /// undecided. Lazy vectors in 'input' must be loaded.
+  void addProbeInput(RowVectorPtr input);
+
+  /// Invoked by HashProbe operator at the end of its input while the swap is
+  /// undecided.
+  void probeInputFinished();
+
+  /// Invoked by HashProbe operator without a swap to take one of the probe
+  /// inputs buffered while the swap was undecided. Returns null if there is
+  /// none left.
+  RowVectorPtr takeProbeInput();
+
+  /// Invoked by HashBuild operator to account for 'bytes' of input it
+  /// buffers while the swap is undecided. Returns the swap state. Sets
+  /// 'future' to wait for the swap to be decided if the build side buffers
+  /// enough input to swap the sides whatever the size of the probe side.
+  SwapState addBuildInputBytes(uint64_t bytes, ContinueFuture* future);
+
+  /// Invoked by HashBuild operator at the end of its input while the swap is
+  /// undecided. Returns the swap state. Sets 'future' to wait for the swap to
+  /// be decided if it is still undecided.
+  SwapState buildBufferingFinished(ContinueFuture* future);
+
+  /// Invoked by HashBuild operator after the swap to pass 'input' to the
+  /// HashProbe operators. Returns true and sets 'future' if HashBuild
+  /// operator should wait for the HashProbe operators to take some input.
+  bool addBuildInput(RowVectorPtr input, ContinueFuture* future);
+
+  /// Invoked by HashBuild operator after the swap at the end of its input.
+  void buildInputFinished();
+
+  /// Invoked by HashProbe operator after the swap to get the table of the
+  /// probe side input. Returns the table if it is built. Otherwise, sets
+  /// 'future' to wait if another HashProbe operator builds the table, or
+  /// moves the buffered probe side input to 'probeInputs' for the caller to
+  /// build the table and pass it to setSwappedTable().
+  std::shared_ptr<BaseHashTable> swappedTableOrFuture(
+      ContinueFuture* future,
+      std::vector<RowVectorPtr>& probeInputs);
+
+  void setSwappedTable(std::shared_ptr<BaseHashTable> table);
+
+  /// Invoked by HashProbe operator after the swap to get the next build side
+  /// input to probe against the swapped table. Returns null and sets 'future'
+  /// to wait for more input, or returns null without 'future' at the end of
+  /// the build side input.
+  RowVectorPtr nextBuildInput(ContinueFuture* future);
+
  private:
+  // Decides whether to swap the sides from the inputs buffered so far.
+  // Returns the promises to notify if decided.
+  std::vector<ContinuePromise> maybeDecideSwapLocked();
+
+  // Makes 'future' wait on a promise in 'promises_'.
+  void waitLocked(const char* context, ContinueFuture* future);
+
   uint32_t numBuilders_{0};
 
   std::optional<HashBuildResult> buildResult_;
@@ -129,8 +224,52 @@ class HashJoinBridge : public JoinBridge {
   // This set can grow if HashBuild operator cannot load full partition in
   // memory and engages in recursive spilling.
   SpillPartitionSet spillPartitionSets_;
+
+  // The bytes of build side input passed through the bridge after the swap
+  // that make HashBuild operators wait for HashProbe operators to take some.
+  static constexpr uint64_t kMaxBuildInputBytes = 32 << 20;
+
+  uint32_t numProbers_{0};
+
+  SwapState swapState_{SwapState::kNoSwap};
+
+  // Number of HashBuild operators that enabled the swap.
+  uint32_t numSwapBuilders_{0};
+
+  // True if an operator disabled the swap.
+  bool swapDisabled_{false};
+
+  // See QueryConfig::kHashJoinSwapSidesRatio and kHashJoinSwapMaxProbeBytes.
+  double swapRatio_{0};
+  uint64_t swapMaxProbeBytes_{0};
+
+  // The probe side input buffered while the swap is undecided and its size.
+  std::vector<RowVectorPtr> probeInputs_;
+  uint64_t probeBytes_{0};
+  uint32_t numProbersFinished_{0};
+
+  // The size of the build side input buffered while the swap is undecided.
+  uint64_t buildBytes_{0};
+  uint32_t numBuildersFinished_{0};
+
+  // The table of the probe side input after the swap. 'buildingSwappedTable_'
+  // is true while one HashProbe operator builds it.
+  std::shared_ptr<BaseHashTable> swappedTable_;
+  bool buildingSwappedTable_{false};
+
+  // The build side input passed to the HashProbe operators after the swap and
+  // its size.
+  std::deque<RowVectorPtr> buildInputs_;
+  uint64_t buildInputBytes_{0};
+  uint32_t numBuildInputsFinished_{0};
 };
 
+// Indicates if the sides of 'joinNode' may be swapped, see
+// QueryConfig::kHashJoinSwapSidesRatio.
+bool canSwapJoinSides(
+    const std::shared_ptr<const core::HashJoinNode>& joinNode,
+    const core::QueryConfig& queryConfig);
+
 // Indicates if 'joinNode' is null-aware anti or left semi project join type and
 // has filter set.
 bool isLeftNullAwareJoinWithFilter(
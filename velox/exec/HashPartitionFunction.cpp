@@ -21,9 +21,14 @@ HashPartitionFunction::HashPartitionFunction(
     int numPartitions,
     const RowTypePtr& inputType,
     const std::vector<column_index_t>& keyChannels,
-    const std::vector<VectorPtr>& constValues)
+    const std::vector<VectorPtr>& constValues,
+    const std::optional<SkewedKeys>& skewedKeys)
     : numPartitions_{numPartitions} {
   init(inputType, keyChannels, constValues);
+  if (skewedKeys.has_value() && !hashers_.empty()) {
+    skewMode_ = skewedKeys->mode;
+    skewedHashes_.insert(skewedKeys->hashes.begin(), skewedKeys->hashes.end());
+  }
 }
 
 HashPartitionFunction::HashPartitionFunction(
@@ -78,6 +83,10 @@ std::optional<uint32_t> HashPartitionFunction::partition(
     }
   }
 
+  if (sampleInterval_ > 0) {
+    sampleHashes(size);
+  }
+
   partitions.resize(size);
   if (hashBitRange_.has_value()) {
     for (auto i = 0; i < size; ++i) {
@@ -89,13 +98,86 @@ std::optional<uint32_t> HashPartitionFunction::partition(
     }
   }
 
+  if (skewMode_.has_value()) {
+    assignSkewedRows(size, partitions);
+  }
+
   return std::nullopt;
 }
 
+void HashPartitionFunction::assignSkewedRows(
+    vector_size_t size,
+    std::vector<uint32_t>& partitions) {
+  for (auto i = 0; i < size; ++i) {
+    if (!skewedHashes_.contains(hashes_[i])) {
+      continue;
+    }
+    if (skewMode_ == SkewedKeys::Mode::kReplicate) {
+      partitions[i] = core::PartitionFunction::kAllPartitions;
+    } else {
+      partitions[i] = nextRoundRobinPartition_;
+      nextRoundRobinPartition_ =
+          (nextRoundRobinPartition_ + 1) % numPartitions_;
+    }
+  }
+}
+
+void HashPartitionFunction::enableSkewSampling(uint32_t sampleInterval) {
+  VELOX_CHECK_GT(sampleInterval, 0);
+  VELOX_CHECK(!hashers_.empty());
+  sampleInterval_ = sampleInterval;
+}
+
+void HashPartitionFunction::sampleHashes(vector_size_t size) {
+  auto row = nextSampleRow_;
+  for (; row < size; row += sampleInterval_) {
+    ++numSampledRows_;
+    const auto hash = hashes_[row];
+    auto it = skewCounters_.find(hash);
+    if (it != skewCounters_.end()) {
+      ++it->second;
+      continue;
+    }
+    if (skewCounters_.size() < kMaxSkewCounters) {
+      skewCounters_.emplace(hash, 1);
+      continue;
+    }
+    // Misra-Gries: a new key decrements all the counters. This undercounts by
+    // at most numSampledRows_ / (kMaxSkewCounters + 1).
+    for (auto counter = skewCounters_.begin();
+         counter != skewCounters_.end();) {
+      if (--counter->second == 0) {
+        counter = skewCounters_.erase(counter);
+      } else {
+        ++counter;
+      }
+    }
+  }
+  nextSampleRow_ = row - size;
+}
+
+std::vector<uint64_t> HashPartitionFunction::heavyHitters(
+    double minFraction) const {
+  VELOX_CHECK_GT(sampleInterval_, 0, "Skew sampling is not enabled");
+  std::vector<uint64_t> hashes;
+  if (numSampledRows_ == 0) {
+    return hashes;
+  }
+  const double maxUndercount = numSampledRows_ / (kMaxSkewCounters + 1.0);
+  const double minCount = minFraction * numSampledRows_;
+  for (const auto& [hash, count] : skewCounters_) {
+    if (count + maxUndercount >= minCount) {
+      hashes.push_back(hash);
+    }
+  }
+  std::sort(hashes.begin(), hashes.end());
+  return hashes;
+}
+
 std::unique_ptr<core::PartitionFunction> HashPartitionFunctionSpec::create(
     int numPartitions) const {
   return std::make_unique<exec::HashPartitionFunction>(
-      numPartitions, inputType_, keyChannels_, constValues_);
+      numPartitions, inputType_, keyChannels_, constValues_, skewedKeys_);
 }
 
 std::string HashPartitionFunctionSpec::toString() const {
@@ -113,6 +195,14 @@ std::string HashPartitionFunctionSpec::toString() const {
     }
   }
 
+  if (skewedKeys_.has_value()) {
+    return fmt::format(
+        "HASH({}) {} {} skewed keys",
+        keys.str(),
+        skewedKeys_->mode == SkewedKeys::Mode::kReplicate ? "replicating"
+                                                          : "round-robin",
+        skewedKeys_->hashes.size());
+  }
   return fmt::format("HASH({})", keys.str());
 }
 
@@ -128,6 +218,18 @@ folly::dynamic HashPartitionFunctionSpec::serialize() const {
     constValues.emplace_back(value);
   }
   obj["constants"] = ISerializable::serialize(constValues);
+  if (skewedKeys_.has_value()) {
+    folly::dynamic skewedKeys = folly::dynamic::object;
+    skewedKeys["mode"] = skewedKeys_->mode == SkewedKeys::Mode::kReplicate
+        ? "REPLICATE"
+        : "ROUND_ROBIN";
+    folly::dynamic hashes = folly::dynamic::array;
+    for (auto hash : skewedKeys_->hashes) {
+      hashes.push_back(static_cast<int64_t>(hash));
+    }
+    skewedKeys["hashes"] = std::move(hashes);
+    obj["skewedKeys"] = std::move(skewedKeys);
+  }
   return obj;
 }
 
@@ -147,7 +249,22 @@ core::PartitionFunctionSpecPtr HashPartitionFunctionSpec::deserialize(
   for (const auto& value : constTypeExprs) {
     constValues.emplace_back(value->toConstantVector(pool));
   }
+  std::optional<SkewedKeys> skewedKeys;
+  if (obj.count("skewedKeys")) {
+    const auto& skewedKeysObj = obj["skewedKeys"];
+    skewedKeys = SkewedKeys{
+        skewedKeysObj["mode"].asString() == "REPLICATE"
+            ? SkewedKeys::Mode::kReplicate
+            : SkewedKeys::Mode::kRoundRobin,
+        {}};
+    for (const auto& hash : skewedKeysObj["hashes"]) {
+      skewedKeys->hashes.push_back(static_cast<uint64_t>(hash.asInt()));
+    }
+  }
   return std::make_shared<HashPartitionFunctionSpec>(
-      ISerializable::deserialize<RowType>(obj["inputType"]), keys, constValues);
+      ISerializable::deserialize<RowType>(obj["inputType"]),
+      keys,
+      constValues,
+      std::move(skewedKeys));
 }
 } // namespace facebook::velox::exec
@@ -15,12 +15,39 @@
  */
 #pragma once
 
+#include <folly/container/F14Map.h>
+#include <folly/container/F14Set.h>
+
 #include <velox/exec/HashBitRange.h>
 #include <velox/exec/VectorHasher.h>
 #include "velox/core/PlanNode.h"
 
 namespace facebook::velox::exec {
 
+/// Join keys that are frequent enough to overload a single partition. The keys
+/// are identified by the hash of the partition keys, so that the build and the
+/// probe side of a hash join classify the same rows as skewed. A row whose keys
+/// collide with a skewed hash is treated as skewed on both sides.
+///
+/// Replicating the build side rows and distributing the probe side rows of the
+/// skewed keys produces each match exactly once if each partition is joined
+/// separately, e.g. the partitions of a PartitionedOutput shuffled to the tasks
+/// of the next stage. It is not for a LocalPartition in front of a HashBuild,
+/// whose drivers merge their rows into one table. This is only correct for
+/// joins that do not track build side matches, i.e. inner, left, left semi and
+/// anti joins.
+struct SkewedKeys {
+  enum class Mode {
+    /// The rows are sent to all partitions. Used for the build side.
+    kReplicate,
+    /// The rows are distributed round-robin. Used for the probe side.
+    kRoundRobin,
+  };
+
+  Mode mode;
+  std::vector<uint64_t> hashes;
+};
+
 /// Calculates partition number for each row of the specified vector using a
 /// hash function. The constructor with hashBitRange parameter requires both
 /// hashBitRange and keyChannels to be non-empty. The constructor with
@@ -33,7 +60,8 @@ class HashPartitionFunction : public core::PartitionFunction {
       int numPartitions,
       const RowTypePtr& inputType,
       const std::vector<column_index_t>& keyChannels,
-      const std::vector<VectorPtr>& constValues = {});
+      const std::vector<VectorPtr>& constValues = {},
+      const std::optional<SkewedKeys>& skewedKeys = std::nullopt);
 
   HashPartitionFunction(
       const HashBitRange& hashBitRange,
@@ -51,16 +79,49 @@ class HashPartitionFunction : public core::PartitionFunction {
     return numPartitions_;
   }
 
+  /// Starts sampling the key hashes of every 'sampleInterval'th input row to
+  /// find the heavy hitters.
+  void enableSkewSampling(uint32_t sampleInterval);
+
+  /// Returns the hashes of the keys which make up at least 'minFraction' of
+  /// the sampled rows. The frequencies are estimated with a bounded number of
+  /// counters, so the result may also contain keys slightly below the
+  /// threshold. Requires enableSkewSampling().
+  std::vector<uint64_t> heavyHitters(double minFraction) const;
+
  private:
+  // Number of counters for the heavy-hitter sampling. Every key that makes up
+  // more than 1 / kMaxSkewCounters of the sampled rows has a counter.
+  static constexpr int32_t kMaxSkewCounters = 64;
+
   void init(
       const RowTypePtr& inputType,
       const std::vector<column_index_t>& keyChannels,
       const std::vector<VectorPtr>& constValues);
 
+  // Adds the hashes of the sampled rows of the last input to 'skewCounters_'.
+  void sampleHashes(vector_size_t size);
+
+  // Reassigns the rows with skewed keys according to 'skewedKeys_'.
+  void assignSkewedRows(vector_size_t size, std::vector<uint32_t>& partitions);
+
   const int numPartitions_;
   const std::optional<HashBitRange> hashBitRange_ = std::nullopt;
   std::vector<std::unique_ptr<VectorHasher>> hashers_;
 
+  std::optional<SkewedKeys::Mode> skewMode_;
+  folly::F14FastSet<uint64_t> skewedHashes_;
+  // The next partition for a round-robin distributed row.
+  uint32_t nextRoundRobinPartition_{0};
+
+  // Heavy-hitter sampling state. 0 if sampling is disabled.
+  uint32_t sampleInterval_{0};
+  // Position of the next sampled row relative to the start of the next input.
+  uint64_t nextSampleRow_{0};
+  uint64_t numSampledRows_{0};
+  // Misra-Gries summary of the sampled key hashes.
+  folly::F14FastMap<uint64_t, uint64_t> skewCounters_;
+
   // Reusable memory.
   SelectivityVector rows_;
   raw_vector<uint64_t> hashes_;
@@ -76,10 +137,12 @@ class HashPartitionFunctionSpec : public core::PartitionFunctionSpec {
   HashPartitionFunctionSpec(
       RowTypePtr inputType,
       std::vector<column_index_t> keyChannels,
-      std::vector<VectorPtr> constValues = {})
+      std::vector<VectorPtr> constValues = {},
+      std::optional<SkewedKeys> skewedKeys = std::nullopt)
       : inputType_{std::move(inputType)},
         keyChannels_{std::move(keyChannels)},
-        constValues_{std::move(constValues)} {}
+        constValues_{std::move(constValues)},
+        skewedKeys_{std::move(skewedKeys)} {}
 
   std::unique_ptr<core::PartitionFunction> create(
       int numPartitions) const override;
@@ -96,5 +159,6 @@ class HashPartitionFunctionSpec : public core::PartitionFunctionSpec {
   const RowTypePtr inputType_;
   const std::vector<column_index_t> keyChannels_;
   const std::vector<VectorPtr> constValues_;
+  const std::optional<SkewedKeys> skewedKeys_;
 };
 } // namespace facebook::velox::exec
@@ -78,6 +78,73 @@ void extractColumns(
   }
 }
 
+// Extracts a build side column of the joined rows of an output batch on first
+// access, only for the rows that are accessed. Holds a reference to the table,
+// so the rows stay valid after the probe moves on.
+class BuildColumnLoader : public VectorLoader {
+ public:
+  BuildColumnLoader(
+      std::shared_ptr<BaseHashTable> table,
+      std::shared_ptr<const std::vector<char*>> rows,
+      column_index_t column,
+      TypePtr type,
+      memory::MemoryPool* pool)
+      : table_(std::move(table)),
+        rows_(std::move(rows)),
+        column_(column),
+        type_(std::move(type)),
+        pool_(pool) {}
+
+ protected:
+  void loadInternal(
+      RowSet rows,
+      ValueHook* hook,
+      vector_size_t resultSize,
+      VectorPtr* result) override {
+    VELOX_CHECK_LE(resultSize, rows_->size());
+    // Rows that are not accessed are extracted as nulls.
+    std::vector<char*> accessedRows(resultSize, nullptr);
+    for (auto row : rows) {
+      accessedRows[row] = (*rows_)[row];
+    }
+    auto column = BaseVector::create(type_, resultSize, pool_);
+    table_->rows()->extractColumn(
+        accessedRows.data(), resultSize, column_, column);
+
+    if (hook != nullptr) {
+      VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          applyHook, type_->kind(), column, rows, hook);
+      return;
+    }
+    *result = std::move(column);
+  }
+
+ private:
+  template <TypeKind Kind>
+  static void
+  applyHook(const VectorPtr& column, RowSet rows, ValueHook* hook) {
+    using T = typename TypeTraits<Kind>::NativeType;
+    DecodedVector decoded(*column);
+    const bool acceptsNulls = hook->acceptsNulls();
+    for (auto row : rows) {
+      if (decoded.isNullAt(row)) {
+        if (acceptsNulls) {
+          hook->addNull(row);
+        }
+      } else {
+        T value = decoded.valueAt<T>(row);
+        hook->addValue(row, &value);
+      }
+    }
+  }
+
+  const std::shared_ptr<BaseHashTable> table_;
+  const std::shared_ptr<const std::vector<char*>> rows_;
+  const column_index_t column_;
+  const TypePtr type_;
+  memory::MemoryPool* const pool_;
+};
+
 BlockingReason fromStateToBlockingReason(ProbeOperatorState state) {
   switch (state) {
     case ProbeOperatorState::kRunning:
@@ -129,6 +196,7 @@ HashProbe::HashProbe(
       filterResult_(1),
       outputTableRows_(outputBatchSize_) {
   VELOX_CHECK_NOT_NULL(joinBridge_);
+  joinBridge_->addProber();
 }
 
 void HashProbe::initialize() {
@@ -178,6 +246,27 @@ void HashProbe::initialize() {
   if (nullAware_) {
     filterTableResult_.resize(1);
   }
+
+  // The probe clears the table between spill partitions while the lazy
+  // vectors may not be loaded yet.
+  lazyBuildColumns_ =
+      operatorCtx_->driverCtx()->queryConfig().hashProbeLazyBuildColumns() &&
+      !spillEnabled();
+  minOutputBatchRows_ = std::min(
+      operatorCtx_->driverCtx()->queryConfig().hashProbeMinOutputBatchRows(),
+      outputBatchSize_);
+
+  maySwapSides_ =
+      canSwapJoinSides(joinNode_, operatorCtx_->driverCtx()->queryConfig());
+  // The probe side input is not buffered if dynamic filters on the join keys
+  // can be pushed down into it.
+  if (maySwapSides_ &&
+      !operatorCtx_->driverCtx()
+           ->driver->canPushdownFilters(this, keyChannels_)
+           .empty()) {
+    joinBridge_->disableSwap();
+    maySwapSides_ = false;
+  }
 }
 
 void HashProbe::initializeFilter(
@@ -260,7 +349,8 @@ void HashProbe::maybeSetupSpillInput(
       spillConfig.minSpillRunSize,
       spillConfig.compressionKind,
       Spiller::pool(),
-      spillConfig.executor);
+      spillConfig.executor,
+      spillConfig.writeRateLimiter);
   // Set the spill partitions to the corresponding ones at the build side. The
   // hash probe operator itself won't trigger any spilling.
   spiller_->setPartitionsSpilled(toPartitionNumSet(spillInputPartitionIds_));
@@ -318,26 +408,289 @@ void HashProbe::asyncWaitForHashTable() {
   } else if (
       (isInnerJoin(joinType_) || isLeftSemiFilterJoin(joinType_) ||
        isRightSemiFilterJoin(joinType_) || isRightSemiProjectJoin(joinType_)) &&
-      table_->hashMode() != BaseHashTable::HashMode::kHash && !isSpillInput() &&
-      !hasMoreSpillData()) {
+      (table_->hashMode() != BaseHashTable::HashMode::kHash ||
+       !table_->keyBloomFilters().empty()) &&
+      !isSpillInput() && !hasMoreSpillData()) {
     // Find out whether there are any upstream operators that can accept
     // dynamic filters on all or a subset of the join keys. Create dynamic
-    // filters to push down.
+    // filters to push down. Prefers the exact value filters from the build
+    // side hashers and falls back to the build side Bloom filters if any.
     //
     // NOTE: this optimization is not applied in the following cases: (1) if the
     // probe input is read from spilled data and there is no upstream operators
     // involved; (2) if there is spill data to restore, then we can't filter
     // probe inputs solely based on the current table's join keys.
     const auto& buildHashers = table_->hashers();
+    const auto& keyBloomFilters = table_->keyBloomFilters();
     auto channels = operatorCtx_->driverCtx()->driver->canPushdownFilters(
         this, keyChannels_);
     for (auto i = 0; i < keyChannels_.size(); i++) {
-      if (channels.find(keyChannels_[i]) != channels.end()) {
-        if (auto filter = buildHashers[i]->getFilter(false)) {
-          dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
+      if (channels.find(keyChannels_[i]) == channels.end()) {
+        continue;
+      }
+      std::unique_ptr<common::Filter> filter;
+      if (table_->hashMode() != BaseHashTable::HashMode::kHash) {
+        filter = buildHashers[i]->getFilter(false);
+      }
+      if (filter != nullptr) {
+        dynamicFilters_.emplace(keyChannels_[i], std::move(filter));
+      } else if (!keyBloomFilters.empty() && keyBloomFilters[i] != nullptr) {
+        dynamicFilters_.emplace(keyChannels_[i], keyBloomFilters[i]);
+        ++numDynamicBloomFilters_;
+      }
+    }
+  }
+}
+
+void HashProbe::processSwap() {
+  checkRunning();
+  VELOX_CHECK_NULL(table_);
+
+  if (swappedTable_ != nullptr) {
+    addSwappedInput();
+    return;
+  }
+  const auto swapState = noMoreInput_
+      ? joinBridge_->swapStateOrFuture(&future_)
+      : joinBridge_->swapState();
+  switch (swapState) {
+    case HashJoinBridge::SwapState::kUndecided:
+      // Buffers the input or waits for the swap to be decided at the end of
+      // the input.
+      if (future_.valid()) {
+        setState(ProbeOperatorState::kWaitForBuild);
+      }
+      return;
+    case HashJoinBridge::SwapState::kSwap:
+      asyncWaitForSwappedTable();
+      return;
+    case HashJoinBridge::SwapState::kNoSwap:
+      hasBufferedProbeInput_ = true;
+      asyncWaitForHashTable();
+      return;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
+void HashProbe::asyncWaitForSwappedTable() {
+  checkRunning();
+
+  std::vector<RowVectorPtr> probeInputs;
+  auto table = joinBridge_->swappedTableOrFuture(&future_, probeInputs);
+  if (table == nullptr) {
+    if (future_.valid()) {
+      setState(ProbeOperatorState::kWaitForBuild);
+      return;
+    }
+    table = makeSwappedTable(std::move(probeInputs));
+    addRuntimeStat("joinSidesSwapped", RuntimeCounter(1));
+    joinBridge_->setSwappedTable(table);
+  }
+  swappedTable_ = std::move(table);
+
+  const auto& buildType = joinNode_->sources()[1]->outputType();
+  buildHashers_ = createVectorHashers(buildType, joinNode_->rightKeys());
+  swappedLookup_ = std::make_unique<HashLookup>(buildHashers_);
+  const auto swappedTableType =
+      makeTableType(probeType_.get(), joinNode_->leftKeys());
+  for (column_index_t i = 0; i < outputType_->size(); ++i) {
+    const auto& name = outputType_->nameOf(i);
+    auto tableChannel = swappedTableType->getChildIdxIfExists(name);
+    if (tableChannel.has_value()) {
+      swappedTableProjections_.emplace_back(tableChannel.value(), i);
+    } else {
+      buildInputProjections_.emplace_back(buildType->getChildIdx(name), i);
+    }
+  }
+  addSwappedInput();
+}
+
+std::shared_ptr<BaseHashTable> HashProbe::makeSwappedTable(
+    std::vector<RowVectorPtr> inputs) {
+  std::vector<column_index_t> dependentChannels;
+  std::vector<TypePtr> dependentTypes;
+  for (column_index_t i = 0; i < probeType_->size(); ++i) {
+    if (std::find(keyChannels_.begin(), keyChannels_.end(), i) ==
+        keyChannels_.end()) {
+      dependentChannels.push_back(i);
+      dependentTypes.push_back(probeType_->childAt(i));
+    }
+  }
+  std::shared_ptr<BaseHashTable> table = HashTable<true>::createForJoin(
+      createVectorHashers(probeType_, joinNode_->leftKeys()),
+      dependentTypes,
+      true, // allowDuplicates
+      false, // hasProbedFlag
+      operatorCtx_->driverCtx()->queryConfig().minTableRowsForParallelJoinBuild(),
+      pool());
+
+  // Stores the rows like HashBuild::addInput().
+  const auto& hashers = table->hashers();
+  auto* rows = table->rows();
+  const auto nextOffset = rows->nextOffset();
+  bool analyzeKeys = table->hashMode() != BaseHashTable::HashMode::kHash;
+  raw_vector<uint64_t> hashes;
+  std::vector<DecodedVector> decoders(dependentChannels.size());
+  SelectivityVector activeRows;
+  for (auto& input : inputs) {
+    activeRows.resize(input->size());
+    activeRows.setAll();
+    for (auto& hasher : hashers) {
+      hasher->decode(
+          *input->childAt(hasher->channel())->loadedVector(), activeRows);
+    }
+    deselectRowsWithNulls(hashers, activeRows);
+    if (!activeRows.hasSelections()) {
+      input = nullptr;
+      continue;
+    }
+    for (auto i = 0; i < dependentChannels.size(); ++i) {
+      decoders[i].decode(
+          *input->childAt(dependentChannels[i])->loadedVector(), activeRows);
+    }
+    if (analyzeKeys) {
+      hashes.resize(activeRows.end());
+      for (auto& hasher : hashers) {
+        hasher->computeValueIds(activeRows, hashes);
+        analyzeKeys = hasher->mayUseValueIds();
+        if (!analyzeKeys) {
+          break;
+        }
+      }
+    }
+    activeRows.applyToSelected([&](auto row) {
+      char* newRow = rows->newRow();
+      if (nextOffset) {
+        *reinterpret_cast<char**>(newRow + nextOffset) = nullptr;
+      }
+      for (auto i = 0; i < hashers.size(); ++i) {
+        rows->store(hashers[i]->decodedVector(), row, newRow, i);
+      }
+      for (auto i = 0; i < decoders.size(); ++i) {
+        rows->store(decoders[i], row, newRow, i + hashers.size());
+      }
+    });
+    input = nullptr;
+  }
+  table->prepareJoinTable({});
+  return table;
+}
+
+void HashProbe::addBufferedProbeInput() {
+  checkRunning();
+
+  if (input_ != nullptr) {
+    return;
+  }
+  // An inner join has no output with an empty build side.
+  if (table_->numDistinct() == 0) {
+    while (joinBridge_->takeProbeInput() != nullptr) {
+    }
+    hasBufferedProbeInput_ = false;
+    return;
+  }
+  auto input = joinBridge_->takeProbeInput();
+  if (input == nullptr) {
+    hasBufferedProbeInput_ = false;
+    return;
+  }
+  addInput(std::move(input));
+}
+
+void HashProbe::addSwappedInput() {
+  checkRunning();
+
+  if (buildInput_ != nullptr || noMoreBuildInput_) {
+    return;
+  }
+  const auto& tableHashers = swappedTable_->hashers();
+  const auto mode = swappedTable_->hashMode();
+  auto& lookup = *swappedLookup_;
+  for (;;) {
+    auto input = joinBridge_->nextBuildInput(&future_);
+    if (input == nullptr) {
+      if (future_.valid()) {
+        setState(ProbeOperatorState::kWaitForBuild);
+      } else {
+        noMoreBuildInput_ = true;
+      }
+      return;
+    }
+
+    // Probes like addInput() for an inner join.
+    activeRows_.resize(input->size());
+    activeRows_.setAll();
+    for (auto& hasher : buildHashers_) {
+      hasher->decode(
+          *input->childAt(hasher->channel())->loadedVector(), activeRows_);
+    }
+    deselectRowsWithNulls(buildHashers_, activeRows_);
+    lookup.hashes.resize(input->size());
+    for (auto i = 0; i < buildHashers_.size(); ++i) {
+      if (mode != BaseHashTable::HashMode::kHash) {
+        tableHashers[i]->lookupValueIds(
+            *input->childAt(buildHashers_[i]->channel()),
+            activeRows_,
+            scratchMemory_,
+            lookup.hashes);
+      } else {
+        buildHashers_[i]->hash(activeRows_, i > 0, lookup.hashes);
+      }
+    }
+    lookup.rows.clear();
+    activeRows_.applyToSelected([&](auto row) { lookup.rows.push_back(row); });
+    if (lookup.rows.empty()) {
+      continue;
+    }
+    lookup.hits.resize(lookup.rows.back() + 1);
+    swappedTable_->joinProbe(lookup);
+    results_.reset(lookup);
+    buildInput_ = std::move(input);
+    return;
+  }
+}
+
+RowVectorPtr HashProbe::getSwappedOutput() {
+  for (;;) {
+    if (buildInput_ == nullptr) {
+      addSwappedInput();
+      if (buildInput_ == nullptr) {
+        if (noMoreBuildInput_) {
+          setState(ProbeOperatorState::kFinish);
         }
+        return nullptr;
       }
     }
+
+    auto mapping =
+        initializeRowNumberMapping(outputRowMapping_, outputBatchSize_, pool());
+    outputTableRows_.resize(outputBatchSize_);
+    const auto numOut = swappedTable_->listJoinResults(
+        results_,
+        false,
+        mapping,
+        folly::Range(outputTableRows_.data(), outputTableRows_.size()));
+    if (numOut == 0) {
+      buildInput_ = nullptr;
+      continue;
+    }
+
+    auto output = BaseVector::create<RowVector>(outputType_, numOut, pool());
+    for (const auto& projection : buildInputProjections_) {
+      output->childAt(projection.outputChannel) = wrapChild(
+          numOut,
+          outputRowMapping_,
+          buildInput_->childAt(projection.inputChannel));
+    }
+    extractColumns(
+        swappedTable_.get(),
+        folly::Range<char**>(outputTableRows_.data(), numOut),
+        swappedTableProjections_,
+        pool(),
+        outputType_->children(),
+        output->children());
+    return output;
   }
 }
 
@@ -461,13 +814,23 @@ BlockingReason HashProbe::isBlocked(ContinueFuture* future) {
       VELOX_CHECK_NULL(table_);
       if (!future_.valid()) {
         setRunning();
-        asyncWaitForHashTable();
+        if (maySwapSides_) {
+          processSwap();
+        } else {
+          asyncWaitForHashTable();
+        }
       }
       break;
     case ProbeOperatorState::kRunning:
+      if (maySwapSides_ && table_ == nullptr) {
+        processSwap();
+        break;
+      }
       VELOX_CHECK_NOT_NULL(table_);
       if (spillInputReader_ != nullptr) {
         addSpillInput();
+      } else if (hasBufferedProbeInput_) {
+        addBufferedProbeInput();
       }
       break;
     case ProbeOperatorState::kWaitForPeers:
@@ -497,11 +860,17 @@ void HashProbe::clearDynamicFilters() {
   // The join can be completely replaced with a pushed down
   // filter when the following conditions are met:
   //  * hash table has a single key with unique values,
-  //  * build side has no dependent columns.
+  //  * build side has no dependent columns,
+  //  * the pushed down filter is exact, e.g. not a Bloom filter.
   if (keyChannels_.size() == 1 && !table_->hasDuplicateKeys() &&
-      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty()) {
+      tableOutputProjections_.empty() && !filter_ && !dynamicFilters_.empty() &&
+      numDynamicBloomFilters_ == 0) {
     canReplaceWithDynamicFilter_ = true;
   }
+  if (numDynamicBloomFilters_ > 0) {
+    addRuntimeStat(
+        "dynamicBloomFiltersProduced", RuntimeCounter(numDynamicBloomFilters_));
+  }
 
   Operator::clearDynamicFilters();
 }
@@ -523,6 +892,15 @@ void HashProbe::decodeAndDetectNonNullKeys() {
 }
 
 void HashProbe::addInput(RowVectorPtr input) {
+  if (table_ == nullptr) {
+    VELOX_CHECK(maySwapSides_);
+    // The upstream operator may reuse the memory of unloaded lazy vectors for
+    // its next output.
+    input->loadedVector();
+    joinBridge_->addProbeInput(std::move(input));
+    return;
+  }
+
   if (skipInput_) {
     VELOX_CHECK_NULL(input_);
     return;
@@ -614,6 +992,7 @@ void HashProbe::addInput(RowVectorPtr input) {
     std::fill(hits.data(), hits.data() + numInput, nullptr);
     if (!lookup_->rows.empty()) {
       table_->joinProbe(*lookup_);
+      recordProbeLoads();
     }
 
     // Update lookup_->rows to include all input rows, not just
@@ -628,10 +1007,26 @@ void HashProbe::addInput(RowVectorPtr input) {
     }
     lookup_->hits.resize(lookup_->rows.back() + 1);
     table_->joinProbe(*lookup_);
+    recordProbeLoads();
   }
   results_.reset(*lookup_);
 }
 
+void HashProbe::recordProbeLoads() {
+  if (lookup_->numTagLoads == 0 && lookup_->numRowLoads == 0) {
+    return;
+  }
+  {
+    auto lockedStats = stats_.wlock();
+    lockedStats->addRuntimeStat(
+        "hashtable.numTagLoads", RuntimeCounter(lookup_->numTagLoads));
+    lockedStats->addRuntimeStat(
+        "hashtable.numRowLoads", RuntimeCounter(lookup_->numRowLoads));
+  }
+  lookup_->numTagLoads = 0;
+  lookup_->numRowLoads = 0;
+}
+
 void HashProbe::prepareOutput(vector_size_t size) {
   // Try to re-use memory for the output vectors that contain build-side data.
   // We expect output vectors containing probe-side data to be null (reset in
@@ -700,18 +1095,45 @@ void HashProbe::fillLeftSemiProjectMatchColumn(vector_size_t size) {
 void HashProbe::fillOutput(vector_size_t size) {
   prepareOutput(size);
 
+  // If each input row produces one output row in input order, the probe side
+  // columns are passed through without wrapping them in dictionaries.
+  bool identityMapping = size == input_->size();
+  if (identityMapping) {
+    const auto* rawMapping = outputRowMapping_->as<vector_size_t>();
+    for (auto i = 0; i < size; ++i) {
+      if (rawMapping[i] != i) {
+        identityMapping = false;
+        break;
+      }
+    }
+  }
+
   for (auto projection : identityProjections_) {
     // Load input vector if it is being split into multiple batches. It is not
     // safe to wrap unloaded LazyVector into two different dictionaries.
     ensureLoadedIfNotAtEnd(projection.inputChannel);
     auto inputChild = input_->childAt(projection.inputChannel);
 
-    output_->childAt(projection.outputChannel) =
-        wrapChild(size, outputRowMapping_, inputChild);
+    output_->childAt(projection.outputChannel) = identityMapping
+        ? inputChild
+        : wrapChild(size, outputRowMapping_, inputChild);
   }
 
   if (isLeftSemiProjectJoin(joinType_)) {
     fillLeftSemiProjectMatchColumn(size);
+  } else if (lazyBuildColumns_) {
+    auto rows = std::make_shared<const std::vector<char*>>(
+        outputTableRows_.begin(), outputTableRows_.begin() + size);
+    for (auto projection : tableOutputProjections_) {
+      const auto& type = outputType_->childAt(projection.outputChannel);
+      output_->childAt(projection.outputChannel) =
+          std::make_shared<LazyVector>(
+              pool(),
+              type,
+              size,
+              std::make_unique<BuildColumnLoader>(
+                  table_, rows, projection.inputChannel, type, pool()));
+    }
   } else {
     extractColumns(
         table_.get(),
@@ -723,6 +1145,26 @@ void HashProbe::fillOutput(vector_size_t size) {
   }
 }
 
+bool HashProbe::coalesceOutput(vector_size_t size) {
+  if (minOutputBatchRows_ == 0 ||
+      (coalescedOutput_ == nullptr && size >= minOutputBatchRows_)) {
+    return false;
+  }
+  if (coalescedOutput_ == nullptr) {
+    coalescedOutput_ = BaseVector::create<RowVector>(outputType_, 0, pool());
+  }
+  const auto offset = coalescedOutput_->size();
+  coalescedOutput_->resize(offset + size);
+  coalescedOutput_->copy(output_.get(), offset, 0, size);
+  // Releases the references to 'input_'.
+  clearIdentityProjectedOutput();
+  if (coalescedOutput_->size() < minOutputBatchRows_) {
+    return true;
+  }
+  output_ = std::move(coalescedOutput_);
+  return false;
+}
+
 RowVectorPtr HashProbe::getBuildSideOutput() {
   outputTableRows_.resize(outputBatchSize_);
   int32_t numOut;
@@ -859,9 +1301,16 @@ RowVectorPtr HashProbe::getOutput() {
   }
   checkRunning();
 
+  if (maySwapSides_ && table_ == nullptr) {
+    return swappedTable_ != nullptr ? getSwappedOutput() : nullptr;
+  }
+
   clearIdentityProjectedOutput();
   if (!input_) {
     if (!hasMoreInput()) {
+      if (coalescedOutput_ != nullptr) {
+        return std::move(coalescedOutput_);
+      }
       if (needLastProbe() && lastProber_) {
         auto output = getBuildSideOutput();
         if (output != nullptr) {
@@ -977,6 +1426,12 @@ RowVectorPtr HashProbe::getOutput() {
     if (isLeftSemiOrAntiJoinNoFilter || emptyBuildSide) {
       input_ = nullptr;
     }
+    if (coalesceOutput(numOut)) {
+      if (input_ == nullptr) {
+        return nullptr;
+      }
+      continue;
+    }
     return output_;
   }
 }
@@ -1363,11 +1818,15 @@ void HashProbe::ensureLoadedIfNotAtEnd(column_index_t channel) {
 
 void HashProbe::noMoreInput() {
   Operator::noMoreInput();
+  if (maySwapSides_ && table_ == nullptr) {
+    joinBridge_->probeInputFinished();
+  }
   noMoreInputInternal();
 }
 
 bool HashProbe::hasMoreInput() const {
-  return !noMoreInput_ || (spillInputReader_ != nullptr && !noMoreSpillInput_);
+  return !noMoreInput_ || (spillInputReader_ != nullptr && !noMoreSpillInput_) ||
+      hasBufferedProbeInput_;
 }
 
 void HashProbe::noMoreInputInternal() {
@@ -1444,6 +1903,8 @@ void HashProbe::abort() {
   joinBridge_.reset();
   spiller_.reset();
   table_.reset();
+  swappedTable_.reset();
+  buildInput_.reset();
   outputRowMapping_.reset();
   output_.reset();
   nonSpillInputIndicesBuffer_.reset();
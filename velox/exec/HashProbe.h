@@ -39,7 +39,7 @@ class HashProbe : public Operator {
         noMoreSpillInput_ || input_ != nullptr) {
       return false;
     }
-    if (table_) {
+    if (table_ || maySwapSides_) {
       return true;
     }
     // NOTE: if we can't apply dynamic filtering, then we can start early to
@@ -82,6 +82,32 @@ class HashProbe : public Operator {
   // asynchronously.
   void asyncWaitForHashTable();
 
+  // Invoked without 'table_' if the join may swap its sides, see
+  // QueryConfig::kHashJoinSwapSidesRatio. Lets the input be buffered in
+  // 'joinBridge_' until the swap is decided. Then waits for 'table_' without
+  // a swap, or for 'swappedTable_' and the build side input with a swap.
+  void processSwap();
+
+  // Invoked after the swap to get 'swappedTable_' from 'joinBridge_'. The
+  // first operator to ask builds it from the buffered probe side input.
+  void asyncWaitForSwappedTable();
+
+  // Returns a table of the probe side 'inputs' to probe the build side input
+  // against after the swap.
+  std::shared_ptr<BaseHashTable> makeSwappedTable(
+      std::vector<RowVectorPtr> inputs);
+
+  // Invoked without a swap to probe the input buffered in 'joinBridge_' while
+  // the swap was undecided.
+  void addBufferedProbeInput();
+
+  // Invoked after the swap to take the next build side input from
+  // 'joinBridge_' and probe it against 'swappedTable_'.
+  void addSwappedInput();
+
+  // Returns the next batch of join results of 'buildInput_'.
+  RowVectorPtr getSwappedOutput();
+
   // Invoked to set up spilling related input processing. The function sets up a
   // reader to read probe inputs from spilled data on disk if
   // 'restoredSpillPartitionId' is not null. If 'spillPartitionIds' is not
@@ -98,12 +124,22 @@ class HashProbe : public Operator {
       const RowTypePtr& probeType,
       const RowTypePtr& tableType);
 
+  // Adds the hash table tag and row loads of the last join probe of 'lookup_'
+  // to the runtime stats and resets the counters of 'lookup_'.
+  void recordProbeLoads();
+
   // Check if output_ can be re-used and if not make a new one.
   void prepareOutput(vector_size_t size);
 
   // Populate output columns.
   void fillOutput(vector_size_t size);
 
+  // Appends the first 'size' rows of 'output_' to 'coalescedOutput_' if the
+  // output is below 'minOutputBatchRows_' or a coalesced batch is pending.
+  // Returns true if the rows were appended and the coalesced batch is not yet
+  // full. Otherwise, 'output_' is the batch to return.
+  bool coalesceOutput(vector_size_t size);
+
   // Populate 'match' output column for the left semi join project,
   void fillLeftSemiProjectMatchColumn(vector_size_t size);
 
@@ -285,6 +321,11 @@ class HashProbe : public Operator {
   // Channel of probe keys in 'input_'.
   std::vector<column_index_t> keyChannels_;
 
+  // Number of the dynamic filters on join keys which are Bloom filters built
+  // by the hash build. These are approximate, so the join cannot be replaced
+  // with them.
+  int32_t numDynamicBloomFilters_{0};
+
   // True if the join can become a no-op starting with the next batch of input.
   bool canReplaceWithDynamicFilter_{false};
 
@@ -369,6 +410,17 @@ class HashProbe : public Operator {
   // Rows of table found by join probe, later filtered by 'filter_'.
   std::vector<char*> outputTableRows_;
 
+  // If true, the build side columns of the probe output are LazyVectors that
+  // extract the values from the table on first access. See
+  // QueryConfig::kHashProbeLazyBuildColumns.
+  bool lazyBuildColumns_{false};
+
+  // See QueryConfig::kHashProbeMinOutputBatchRows.
+  uint32_t minOutputBatchRows_{0};
+
+  // Output rows of previous input batches waiting to be returned together.
+  RowVectorPtr coalescedOutput_;
+
   // Indicates probe-side rows which should produce a NULL in left semi project
   // with filter.
   SelectivityVector leftSemiProjectIsNull_;
@@ -616,6 +668,37 @@ class HashProbe : public Operator {
 
   // The spilled probe partitions remaining to restore.
   SpillPartitionSet spillPartitionSet_;
+
+  // True if the join may swap its sides, see
+  // QueryConfig::kHashJoinSwapSidesRatio. The input is then buffered in
+  // 'joinBridge_' while 'table_' is not set.
+  bool maySwapSides_{false};
+
+  // True if 'joinBridge_' may have probe input buffered while the swap was
+  // undecided that is not yet probed.
+  bool hasBufferedProbeInput_{false};
+
+  // The following are set after the swap. 'swappedTable_' is the table of
+  // the probe side input shared with the peer operators. The build side
+  // input from 'joinBridge_' is probed against it.
+  std::shared_ptr<BaseHashTable> swappedTable_;
+
+  // Hashers of the join keys of the build side input.
+  std::vector<std::unique_ptr<VectorHasher>> buildHashers_;
+
+  std::unique_ptr<HashLookup> swappedLookup_;
+
+  // Maps from column index in 'swappedTable_' to channel in 'output_'.
+  std::vector<IdentityProjection> swappedTableProjections_;
+
+  // Maps from build side input channel to channel in 'output_'.
+  std::vector<IdentityProjection> buildInputProjections_;
+
+  // The build side input being probed.
+  RowVectorPtr buildInput_;
+
+  // True after the last build side input is taken from 'joinBridge_'.
+  bool noMoreBuildInput_{false};
 };
 
 inline std::ostream& operator<<(std::ostream& os, ProbeOperatorState state) {
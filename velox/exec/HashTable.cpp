@@ -60,6 +60,9 @@ HashTable<ignoreNullKeys>::HashTable(
     if (!VectorHasher::typeKindSupportsValueIds(hasher->typeKind())) {
       hashMode_ = HashMode::kHash;
     }
+    if (!hasher->type()->isFixedWidth()) {
+      hasKeyFingerprints_ = true;
+    }
   }
 
   rows_ = std::make_unique<RowContainer>(
@@ -70,7 +73,7 @@ HashTable<ignoreNullKeys>::HashTable(
       allowDuplicates,
       isJoinBuild,
       hasProbedFlag,
-      hashMode_ != HashMode::kHash,
+      hashMode_ != HashMode::kHash || hasKeyFingerprints_,
       pool);
   nextOffset_ = rows_->nextOffset();
 }
@@ -95,6 +98,16 @@ class ProbeState {
     return row_;
   }
 
+  // Number of words of 16 tags loaded by 'this' since construction.
+  int64_t numTagLoads() const {
+    return numTagLoads_;
+  }
+
+  // Number of rows of payload loaded by 'this' since construction.
+  int64_t numRowLoads() const {
+    return numRowLoads_;
+  }
+
   // Use one instruction to make 16 copies of the tag being searched for
   template <typename Table>
   inline void preProbe(const Table& table, uint64_t hash, int32_t row) {
@@ -116,6 +129,7 @@ class ProbeState {
     tagsInTable_ = BaseHashTable::loadTags(
         reinterpret_cast<uint8_t*>(table.table_), bucketOffset_);
     table.incrementTagLoads();
+    ++numTagLoads_;
     hits_ = simd::toBitMask(tagsInTable_ == wantedTags_);
     if (hits_) {
       loadNextHit<op>(table, firstKey);
@@ -198,6 +212,7 @@ class ProbeState {
       }
       bucketOffset_ = table.nextBucketOffset(bucketOffset_);
       tagsInTable_ = table.loadTags(bucketOffset_);
+      ++numTagLoads_;
       hits_ = simd::toBitMask(tagsInTable_ == wantedTags_);
     }
   }
@@ -228,6 +243,7 @@ class ProbeState {
       bucketOffset_ = table.nextBucketOffset(bucketOffset_);
       tagsInTable_ = BaseHashTable::loadTags(
           reinterpret_cast<uint8_t*>(table.table_), bucketOffset_);
+      ++numTagLoads_;
       hits_ = simd::toBitMask(tagsInTable_ == wantedTags_) & kFullMask;
     }
   }
@@ -245,6 +261,7 @@ class ProbeState {
     group_ = table.row(bucketOffset_, hit);
     __builtin_prefetch(group_ + firstKey);
     table.incrementRowLoads();
+    ++numRowLoads_;
   }
 
   template <typename Table>
@@ -274,8 +291,21 @@ class ProbeState {
   // empty and thus determining that the item being inserted is not in
   // the table.
   uint8_t indexInTags_ = kNotSet;
+
+  int64_t numTagLoads_{0};
+  int64_t numRowLoads_{0};
 };
 
+namespace {
+// Adds the tag and row loads of 'states' to the counters of 'lookup'.
+void addLoads(HashLookup& lookup, folly::Range<const ProbeState*> states) {
+  for (const auto& state : states) {
+    lookup.numTagLoads += state.numTagLoads();
+    lookup.numRowLoads += state.numRowLoads();
+  }
+}
+} // namespace
+
 template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::storeKeys(
     HashLookup& lookup,
@@ -316,6 +346,8 @@ char* HashTable<ignoreNullKeys>::insertEntry(
     // the word below the row. Space was reserved in the allocation
     // unless we have given up on normalized keys.
     RowContainer::normalizedKey(group) = lookup.normalizedKeys[row]; // NOLINT
+  } else if (hashMode_ == HashMode::kHash && hasKeyFingerprints_) {
+    RowContainer::normalizedKey(group) = lookup.hashes[row]; // NOLINT
   }
   ++numDistinct_;
   lookup.newGroups.push_back(row);
@@ -348,7 +380,7 @@ bool HashTable<ignoreNullKeys>::compareKeys(
   auto numKeys = hashers_.size();
   int32_t i = 0;
   do {
-    if (rows_->compare(group, inserted, i, CompareFlags{true, true})) {
+    if (rows_->compare(group, inserted, i, CompareFlags{true, true, true})) {
       return false;
     }
   } while (++i < numKeys);
@@ -383,7 +415,13 @@ FOLLY_ALWAYS_INLINE void HashTable<ignoreNullKeys>::fullProbe(
   lookup.hits[state.row()] = state.fullProbe<op>(
       *this,
       0,
-      [&](char* group, int32_t row) { return compareKeys(group, lookup, row); },
+      [&](char* group, int32_t row) {
+        if (hasKeyFingerprints_ &&
+            RowContainer::normalizedKey(group) != lookup.hashes[row]) {
+          return false;
+        }
+        return compareKeys(group, lookup, row);
+      },
       [&](int32_t index, int32_t row) {
         return isJoin ? nullptr : insertEntry(lookup, row, index);
       },
@@ -565,7 +603,11 @@ template <bool ignoreNullKeys>
 void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
   incrementProbes(lookup.rows.size());
   if (hashMode_ == HashMode::kArray) {
-    arrayJoinProbe(lookup);
+    if (membership_ != nullptr) {
+      membershipJoinProbe(lookup);
+    } else {
+      arrayJoinProbe(lookup);
+    }
     return;
   }
   if (hashMode_ == HashMode::kNormalizedKey) {
@@ -573,13 +615,19 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
     joinNormalizedKeyProbe(lookup);
     return;
   }
+  if (capacity_ * tableSlotSize() >= kJoinProbePrefetchMinTableBytes &&
+      lookup.rows.size() > 2 * kJoinProbePrefetchDistance) {
+    prefetchJoinProbe(lookup);
+    return;
+  }
   int32_t probeIndex = 0;
   int32_t numProbes = lookup.rows.size();
   const vector_size_t* rows = lookup.rows.data();
-  ProbeState state1;
-  ProbeState state2;
-  ProbeState state3;
-  ProbeState state4;
+  ProbeState states[4];
+  auto& state1 = states[0];
+  auto& state2 = states[1];
+  auto& state3 = states[2];
+  auto& state4 = states[3];
   for (; probeIndex + 4 <= numProbes; probeIndex += 4) {
     int32_t row = rows[probeIndex];
     state1.preProbe(*this, lookup.hashes[row], row);
@@ -604,6 +652,65 @@ void HashTable<ignoreNullKeys>::joinProbe(HashLookup& lookup) {
     state1.firstProbe(*this, 0);
     fullProbe<true>(lookup, state1, false);
   }
+  addLoads(lookup, folly::Range<const ProbeState*>(states, 4));
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::prefetchJoinProbe(HashLookup& lookup) {
+  // The probe of a row goes through three stages which are
+  // kJoinProbePrefetchDistance rows apart: preProbe() prefetches the tags,
+  // firstProbe() loads the tags and prefetches the first matching row and
+  // fullProbe() compares the keys. The state of row i is at i % kNumStates.
+  // The full probe of row i - kNumStates is done before the state is reused
+  // for row i.
+  constexpr int32_t kNumStates = 2 * kJoinProbePrefetchDistance;
+  static_assert((kNumStates & (kNumStates - 1)) == 0);
+  ProbeState states[kNumStates];
+  const int32_t numProbes = lookup.rows.size();
+  const vector_size_t* rows = lookup.rows.data();
+  for (int32_t i = 0; i < numProbes + kNumStates; ++i) {
+    if (i >= kNumStates) {
+      fullProbe<true>(
+          lookup, states[(i - kNumStates) & (kNumStates - 1)], false);
+    }
+    const int32_t firstProbeIndex = i - kJoinProbePrefetchDistance;
+    if (firstProbeIndex >= 0 && firstProbeIndex < numProbes) {
+      states[firstProbeIndex & (kNumStates - 1)].firstProbe(*this, 0);
+    }
+    if (i < numProbes) {
+      const int32_t row = rows[i];
+      states[i & (kNumStates - 1)].preProbe(*this, lookup.hashes[row], row);
+    }
+  }
+  addLoads(lookup, folly::Range<const ProbeState*>(states, kNumStates));
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::enableMembershipProbe() {
+  if (hashMode_ != HashMode::kArray || hasDuplicates_) {
+    return;
+  }
+  membership_ = AlignedBuffer::allocate<bool>(capacity_, rows_->pool(), false);
+  auto* rawMembership = membership_->asMutable<uint64_t>();
+  for (int64_t i = 0; i < capacity_; ++i) {
+    if (table_[i] != nullptr) {
+      bits::setBit(rawMembership, i);
+    }
+  }
+}
+
+template <bool ignoreNullKeys>
+void HashTable<ignoreNullKeys>::membershipJoinProbe(HashLookup& lookup) {
+  // Any non-null pointer. Hits are not dereferenced by the joins that use the
+  // membership probe.
+  static char kMatch;
+  const auto* rawMembership = membership_->as<uint64_t>();
+  const auto* hashes = lookup.hashes.data();
+  auto* hits = lookup.hits.data();
+  for (auto row : lookup.rows) {
+    VELOX_DCHECK_LT(hashes[row], capacity_);
+    hits[row] = bits::isBitSet(rawMembership, hashes[row]) ? &kMatch : nullptr;
+  }
 }
 
 template <bool ignoreNullKeys>
@@ -678,6 +785,7 @@ void HashTable<ignoreNullKeys>::joinNormalizedKeyProbe(HashLookup& lookup) {
     states[0].firstProbe(*this, 0);
     hits[row] = states[0].joinNormalizedKeyFullProbe(*this, keys);
   }
+  addLoads(lookup, folly::Range<const ProbeState*>(states, groupSize));
 }
 
 template <bool ignoreNullKeys>
@@ -706,6 +814,7 @@ void HashTable<ignoreNullKeys>::clear() {
     // All modes have 8 bytes per slot.
     memset(table_, 0, capacity_ * sizeof(char*));
   }
+  membership_.reset();
   numDistinct_ = 0;
   numTombstones_ = 0;
 }
@@ -786,6 +895,12 @@ bool HashTable<ignoreNullKeys>::hashRows(
       RowContainer::normalizedKey(rows[i]) = hashes[i];
       hashes[i] = mixNormalizedKey(hashes[i], sizeBits_);
     }
+  } else if (hashMode_ == HashMode::kHash && hasKeyFingerprints_) {
+    // Rows that were added in another mode or by a join build hold no
+    // fingerprint yet.
+    for (auto i = 0; i < rows.size(); ++i) {
+      RowContainer::normalizedKey(rows[i]) = hashes[i];
+    }
   }
   return true;
 }
@@ -1140,6 +1255,10 @@ FOLLY_ALWAYS_INLINE void HashTable<ignoreNullKeys>::buildFullProbe(
         *this,
         0,
         [&](char* group, int32_t /*row*/) {
+          if (hasKeyFingerprints_ &&
+              RowContainer::normalizedKey(group) != hash) {
+            return false;
+          }
           if (compareKeys(group, inserted)) {
             if (nextOffset_) {
               pushNext(group, inserted);
@@ -1237,7 +1356,9 @@ void HashTable<ignoreNullKeys>::setHashMode(HashMode mode, int32_t numNew) {
     for (auto& hasher : hashers_) {
       hasher->resetStats();
     }
-    rows_->disableNormalizedKeys();
+    if (!hasKeyFingerprints_) {
+      rows_->disableNormalizedKeys();
+    }
     capacity_ = 0;
     // Makes tables of the right size and rehashes.
     checkSize(numNew, true);
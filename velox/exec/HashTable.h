@@ -47,6 +47,11 @@ struct HashLookup {
   raw_vector<char*> hits;
   // Indices of newly inserted rows (not found during probe).
   std::vector<vector_size_t> newGroups;
+  // Number of times a word of 16 tags and a row of payload were accessed by
+  // joinProbe() calls with 'this'. These approximate the cache misses of the
+  // probe. Accumulated across calls and reset by the caller.
+  int64_t numTagLoads{0};
+  int64_t numRowLoads{0};
 };
 
 struct HashTableStats {
@@ -183,6 +188,16 @@ class BaseHashTable {
       std::vector<std::unique_ptr<BaseHashTable>> tables,
       folly::Executor* executor = nullptr) = 0;
 
+  /// Makes joinProbe() of a kArray mode table test a bitmap of the occupied
+  /// slots instead of loading the rows from the array. The bitmap has a bit
+  /// per slot instead of a pointer, so that it stays in cache for key ranges
+  /// where the array does not. The hits of matches are then a non-null
+  /// pointer that is not a row. For semi and anti joins without filter, which
+  /// only check whether a probe key has a match. Does nothing in other modes
+  /// or if the table has duplicate keys. Must be called after
+  /// prepareJoinTable().
+  virtual void enableMembershipProbe() = 0;
+
   /// Returns the memory footprint in bytes for any data structures
   /// owned by 'this'.
   virtual int64_t allocatedBytes() const = 0;
@@ -256,6 +271,20 @@ class BaseHashTable {
     return rows_.get();
   }
 
+  /// Sets the Bloom filters over the values of the join keys. Has one entry
+  /// per key in the order of hashers(). An entry is null if no filter could be
+  /// built for the corresponding key. Set by the hash join build and shared by
+  /// all hash probe operators that push these down as dynamic filters.
+  void setKeyBloomFilters(
+      std::vector<std::shared_ptr<common::Filter>> keyBloomFilters) {
+    keyBloomFilters_ = std::move(keyBloomFilters);
+  }
+
+  /// Returns the Bloom filters set by setKeyBloomFilters(). Empty if none.
+  const std::vector<std::shared_ptr<common::Filter>>& keyBloomFilters() const {
+    return keyBloomFilters_;
+  }
+
   std::unique_ptr<RowContainer> moveRows() {
     return std::move(rows_);
   }
@@ -300,6 +329,7 @@ class BaseHashTable {
 
   std::vector<std::unique_ptr<VectorHasher>> hashers_;
   std::unique_ptr<RowContainer> rows_;
+  std::vector<std::shared_ptr<common::Filter>> keyBloomFilters_;
 };
 
 FOLLY_ALWAYS_INLINE std::ostream& operator<<(
@@ -368,6 +398,8 @@ class HashTable : public BaseHashTable {
 
   void joinProbe(HashLookup& lookup) override;
 
+  void enableMembershipProbe() override;
+
   int32_t listJoinResults(
       JoinResultIterator& iter,
       bool includeMisses,
@@ -402,7 +434,8 @@ class HashTable : public BaseHashTable {
   int64_t allocatedBytes() const override {
     // For each row: sizeof(char*) per table entry + memory
     // allocated with MemoryAllocator for fixed-width rows and strings.
-    return sizeof(char*) * capacity_ + rows_->allocatedBytes();
+    return sizeof(char*) * capacity_ + rows_->allocatedBytes() +
+        (membership_ ? membership_->capacity() : 0);
   }
 
   HashStringAllocator* stringAllocator() override {
@@ -715,9 +748,18 @@ class HashTable : public BaseHashTable {
   // Array probe with SIMD.
   void arrayJoinProbe(HashLookup& lookup);
 
+  // Probe of 'membership_'. See enableMembershipProbe().
+  void membershipJoinProbe(HashLookup& lookup);
+
   // Shortcut for probe with normalized keys.
   void joinNormalizedKeyProbe(HashLookup& lookup);
 
+  // Join probe in kHash mode for tables that do not fit in cache. Keeps
+  // 2 * kJoinProbePrefetchDistance probes in flight: while the keys of row i
+  // are compared, the first matching row of row i + kJoinProbePrefetchDistance
+  // and the tags of row i + 2 * kJoinProbePrefetchDistance are prefetched.
+  void prefetchJoinProbe(HashLookup& lookup);
+
   // Adds a row to a hash join table in kArray hash mode. Returns true
   // if a new entry was made and false if the row was added to an
   // existing set of rows with the same key.
@@ -802,12 +844,26 @@ class HashTable : public BaseHashTable {
     }
   }
 
+  // Number of rows ahead of the row being compared for which the tags and
+  // the first matching row are prefetched in prefetchJoinProbe().
+  static constexpr int32_t kJoinProbePrefetchDistance = 8;
+
+  // The min size in bytes of the table in kHash mode for joinProbe() to use
+  // prefetchJoinProbe(). Smaller tables are expected to mostly stay in cache.
+  static constexpr uint64_t kJoinProbePrefetchMinTableBytes = 8 << 20;
+
   // The min table size in row to trigger parallel join table build.
   const uint32_t minTableSizeForParallelJoinBuild_;
 
   int8_t sizeBits_;
   bool isJoinBuild_ = false;
 
+  // True if some key is of a variable width type. The full 64 bit hash of
+  // the keys is then kept in the word below each row in kHash mode and is
+  // compared before the keys, so that most collisions are rejected without
+  // following pointers to string or complex type bodies.
+  bool hasKeyFingerprints_ = false;
+
   // Set at join build time if the table has duplicates, meaning that
   // the join can be cardinality increasing. Atomic for tsan because
   // many threads can set this.
@@ -819,6 +875,10 @@ class HashTable : public BaseHashTable {
   char** table_ = nullptr;
   memory::ContiguousAllocation tableAllocation_;
 
+  // Bit per slot of 'table_' that is set if the slot has a row. Set by
+  // enableMembershipProbe().
+  BufferPtr membership_;
+
   // Number of slots across all buckets.
   int64_t capacity_{0};
 
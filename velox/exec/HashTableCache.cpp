@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/HashTableCache.h"
+
+namespace facebook::velox::exec {
+namespace {
+
+HashTableCache** instancePtr() {
+  static HashTableCache* instance{nullptr};
+  return &instance;
+}
+
+} // namespace
+
+HashTableCache::HashTableCache(uint64_t maxBytes)
+    : maxBytes_(maxBytes),
+      pool_(memory::defaultMemoryManager().addRootPool("HashTableCache")) {}
+
+// static
+HashTableCache* HashTableCache::getInstance() {
+  return *instancePtr();
+}
+
+// static
+void HashTableCache::setInstance(HashTableCache* cache) {
+  *instancePtr() = cache;
+}
+
+std::optional<HashTableCache::Entry> HashTableCache::find(
+    const std::string& key) {
+  std::lock_guard<std::mutex> l(mutex_);
+  ++numLookups_;
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    return std::nullopt;
+  }
+  ++numHits_;
+  lru_.splice(lru_.end(), lru_, it->second.lruPosition);
+  return it->second.entry;
+}
+
+std::shared_ptr<memory::MemoryPool> HashTableCache::makeBuildPool() {
+  std::lock_guard<std::mutex> l(mutex_);
+  return pool_->addLeafChild(fmt::format("build.{}", numBuildPools_++));
+}
+
+std::shared_ptr<BaseHashTable> HashTableCache::add(
+    const std::string& key,
+    std::unique_ptr<BaseHashTable> table,
+    bool hasNullKeys,
+    std::vector<std::shared_ptr<memory::MemoryPool>> pools) {
+  uint64_t bytes = 0;
+  for (const auto& pool : pools) {
+    bytes += pool->currentBytes();
+  }
+  // The pools are freed after the table.
+  std::shared_ptr<BaseHashTable> sharedTable(
+      table.release(), [pools = std::move(pools)](BaseHashTable* table) {
+        delete table;
+      });
+  if (bytes > maxBytes_) {
+    return sharedTable;
+  }
+
+  std::lock_guard<std::mutex> l(mutex_);
+  if (entries_.count(key) != 0) {
+    return sharedTable;
+  }
+  lru_.push_back(key);
+  entries_.emplace(
+      key,
+      CacheEntry{
+          Entry{sharedTable, hasNullKeys}, bytes, std::prev(lru_.end())});
+  bytes_ += bytes;
+  evictLocked();
+  return sharedTable;
+}
+
+void HashTableCache::evictLocked() {
+  while (bytes_ > maxBytes_ && !lru_.empty()) {
+    auto it = entries_.find(lru_.front());
+    VELOX_CHECK(it != entries_.end());
+    bytes_ -= it->second.bytes;
+    entries_.erase(it);
+    lru_.pop_front();
+    ++numEvictions_;
+  }
+}
+
+void HashTableCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  entries_.clear();
+  lru_.clear();
+  bytes_ = 0;
+}
+
+HashTableCache::Stats HashTableCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  Stats stats;
+  stats.numLookups = numLookups_;
+  stats.numHits = numHits_;
+  stats.numEntries = entries_.size();
+  stats.bytes = bytes_;
+  stats.numEvictions = numEvictions_;
+  return stats;
+}
+
+} // namespace facebook::velox::exec
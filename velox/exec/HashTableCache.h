@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <list>
+#include <mutex>
+
+#include <folly/container/F14Map.h>
+
+#include "velox/exec/HashTable.h"
+
+namespace facebook::velox::exec {
+
+/// Keeps the hash tables built for joins that set
+/// core::HashJoinNode::buildCacheKey() so that later tasks with the same key
+/// probe the existing table instead of building a new one. The tables are
+/// built in leaf pools of the cache's own root pool, so they outlive the
+/// queries that built them. Cached tables are immutable. Joins that mark
+/// probed build rows, that spill or that run in grouped execution are not
+/// cached.
+///
+/// Tables are evicted in LRU order when the total memory of the cached
+/// tables exceeds 'maxBytes'. A table that is still probed stays alive after
+/// eviction until its last prober finishes.
+///
+/// The process-wide instance is installed with setInstance(). There is no
+/// caching without one.
+class HashTableCache {
+ public:
+  explicit HashTableCache(uint64_t maxBytes);
+
+  static HashTableCache* getInstance();
+
+  /// Sets the process-wide instance. The caller owns 'cache' and must keep it
+  /// alive until it resets the instance.
+  static void setInstance(HashTableCache* cache);
+
+  struct Entry {
+    std::shared_ptr<BaseHashTable> table;
+    bool hasNullKeys;
+  };
+
+  /// Returns the table cached under 'key' or std::nullopt.
+  std::optional<Entry> find(const std::string& key);
+
+  /// Returns a new leaf pool for building a table to add to the cache.
+  std::shared_ptr<memory::MemoryPool> makeBuildPool();
+
+  /// Adds 'table' built in 'pools' under 'key'. Keeps the existing entry if
+  /// another task added one first. Does not cache tables larger than
+  /// 'maxBytes'. Returns the table to probe, which owns 'pools'.
+  std::shared_ptr<BaseHashTable> add(
+      const std::string& key,
+      std::unique_ptr<BaseHashTable> table,
+      bool hasNullKeys,
+      std::vector<std::shared_ptr<memory::MemoryPool>> pools);
+
+  void clear();
+
+  struct Stats {
+    uint64_t numLookups{0};
+    uint64_t numHits{0};
+    uint64_t numEntries{0};
+    uint64_t bytes{0};
+    uint64_t numEvictions{0};
+  };
+
+  Stats stats() const;
+
+ private:
+  struct CacheEntry {
+    Entry entry;
+    uint64_t bytes;
+    // Position in 'lru_'.
+    std::list<std::string>::iterator lruPosition;
+  };
+
+  // Evicts the least recently used tables until 'bytes_' is at most
+  // 'maxBytes_'.
+  void evictLocked();
+
+  const uint64_t maxBytes_;
+  const std::shared_ptr<memory::MemoryPool> pool_;
+
+  mutable std::mutex mutex_;
+  folly::F14FastMap<std::string, CacheEntry> entries_;
+  // Keys of 'entries_', least recently used first.
+  std::list<std::string> lru_;
+  uint64_t bytes_{0};
+  uint64_t numLookups_{0};
+  uint64_t numHits_{0};
+  uint64_t numEvictions_{0};
+  uint64_t numBuildPools_{0};
+};
+
+} // namespace facebook::velox::exec
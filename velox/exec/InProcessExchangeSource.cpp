@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/InProcessExchangeSource.h"
+
+namespace facebook::velox::exec {
+
+// static
+std::unique_ptr<ExchangeSource> InProcessExchangeSource::create(
+    const std::string& taskId,
+    int destination,
+    std::shared_ptr<ExchangeQueue> queue,
+    memory::MemoryPool* pool) {
+  auto buffers = PartitionedOutputBufferManager::getInstance().lock();
+  if (buffers == nullptr || !buffers->hasTask(taskId)) {
+    return nullptr;
+  }
+  return std::make_unique<InProcessExchangeSource>(
+      taskId, destination, std::move(queue), pool);
+}
+
+bool InProcessExchangeSource::shouldRequestLocked() {
+  if (atEnd_) {
+    return false;
+  }
+  return !requestPending_.exchange(true);
+}
+
+folly::SemiFuture<ExchangeSource::Response> InProcessExchangeSource::request(
+    uint32_t maxBytes,
+    uint32_t /*maxWaitSeconds*/) {
+  auto promise = VeloxPromise<Response>("InProcessExchangeSource::request");
+  auto future = promise.getSemiFuture();
+  promise_ = std::move(promise);
+
+  auto buffers = PartitionedOutputBufferManager::getInstance().lock();
+  VELOX_CHECK_NOT_NULL(buffers, "invalid PartitionedOutputBufferManager");
+  VELOX_CHECK(requestPending_);
+  const auto requestedSequence = sequence_;
+  auto self = shared_from_this();
+  const bool found = buffers->getPages(
+      taskId_,
+      destination_,
+      maxBytes,
+      requestedSequence,
+      // Since this lambda may outlive 'this', we need to capture a
+      // shared_ptr to the current object (self).
+      [self, requestedSequence, buffers, this](
+          std::vector<std::shared_ptr<SerializedPage>> pages,
+          int64_t sequence) {
+        processPages(std::move(pages), requestedSequence, sequence, buffers);
+      });
+  if (!found) {
+    queue_->setError(
+        fmt::format("Output buffer of task {} is not found", taskId_));
+    checkSetRequestPromise();
+  }
+  return future;
+}
+
+void InProcessExchangeSource::processPages(
+    std::vector<std::shared_ptr<SerializedPage>> pages,
+    int64_t requestedSequence,
+    int64_t sequence,
+    const std::shared_ptr<PartitionedOutputBufferManager>& buffers) {
+  if (requestedSequence > sequence) {
+    const int64_t numExtra = requestedSequence - sequence;
+    VELOX_CHECK_LT(numExtra, pages.size());
+    pages.erase(pages.begin(), pages.begin() + numExtra);
+    sequence = requestedSequence;
+  }
+
+  std::vector<std::unique_ptr<SerializedPage>> received;
+  bool atEnd = false;
+  int64_t totalBytes = 0;
+  try {
+    for (auto& page : pages) {
+      if (page == nullptr) {
+        atEnd = true;
+        // Keep looping, there could be extra end markers.
+        continue;
+      }
+      totalBytes += page->size();
+      if (const auto& vector = page->vector()) {
+        auto copy = BaseVector::create<RowVector>(
+            vector->type(), vector->size(), pool_.get());
+        copy->copy(vector.get(), 0, 0, vector->size());
+        const auto bytes = copy->retainedSize();
+        received.push_back(
+            std::make_unique<SerializedPage>(std::move(copy), bytes));
+        ++numVectorPages_;
+      } else {
+        auto iobuf = page->getIOBuf();
+        iobuf->unshare();
+        received.push_back(std::make_unique<SerializedPage>(std::move(iobuf)));
+      }
+    }
+  } catch (const std::exception& e) {
+    queue_->setError(e.what());
+    checkSetRequestPromise();
+    return;
+  }
+  // Drops the references on the producer's pages before acknowledging them.
+  pages.clear();
+  numPages_ += received.size();
+  totalBytes_ += totalBytes;
+
+  int64_t ackSequence;
+  VeloxPromise<Response> requestPromise;
+  {
+    std::vector<ContinuePromise> queuePromises;
+    {
+      std::lock_guard<std::mutex> l(queue_->mutex());
+      requestPending_ = false;
+      requestPromise = std::move(promise_);
+      for (auto& page : received) {
+        queue_->enqueueLocked(std::move(page), queuePromises);
+      }
+      if (atEnd) {
+        queue_->enqueueLocked(nullptr, queuePromises);
+        atEnd_ = true;
+      }
+      ackSequence = sequence_ = sequence + received.size();
+    }
+    for (auto& promise : queuePromises) {
+      promise.setValue();
+    }
+  }
+  // Outside of queue mutex.
+  if (atEnd) {
+    buffers->deleteResults(taskId_, destination_);
+  } else {
+    buffers->acknowledge(taskId_, destination_, ackSequence);
+  }
+
+  if (requestPromise.valid() && !requestPromise.isFulfilled()) {
+    requestPromise.setValue(Response{totalBytes, atEnd});
+  }
+}
+
+void InProcessExchangeSource::close() {
+  checkSetRequestPromise();
+  if (auto buffers = PartitionedOutputBufferManager::getInstance().lock()) {
+    buffers->deleteResults(taskId_, destination_);
+  }
+}
+
+folly::F14FastMap<std::string, int64_t> InProcessExchangeSource::stats()
+    const {
+  return {
+      {"inProcessExchangeSource.numPages", numPages_},
+      {"inProcessExchangeSource.numVectorPages", numVectorPages_},
+      {"inProcessExchangeSource.totalBytes", totalBytes_},
+  };
+}
+
+bool InProcessExchangeSource::checkSetRequestPromise() {
+  VeloxPromise<Response> promise;
+  {
+    std::lock_guard<std::mutex> l(queue_->mutex());
+    requestPending_ = false;
+    promise = std::move(promise_);
+  }
+  if (promise.valid() && !promise.isFulfilled()) {
+    promise.setValue(Response{0, false});
+    return true;
+  }
+  return false;
+}
+
+} // namespace facebook::velox::exec
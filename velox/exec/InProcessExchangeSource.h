@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/exec/ExchangeSource.h"
+#include "velox/exec/PartitionedOutputBufferManager.h"
+
+namespace facebook::velox::exec {
+
+/// ExchangeSource that fetches the pages of a producer task whose output
+/// buffer is in the same process directly from the
+/// PartitionedOutputBufferManager. Pages that hold vectors, see
+/// QueryConfig::kShuffleInProcessVectors, are copied into the memory pool of
+/// the consumer so that the memory is accounted to the consumer and the
+/// producer's buffer space is released on acknowledge. Serialized pages are
+/// passed on without copying the data.
+class InProcessExchangeSource : public ExchangeSource {
+ public:
+  InProcessExchangeSource(
+      const std::string& taskId,
+      int destination,
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool)
+      : ExchangeSource(taskId, destination, std::move(queue), pool) {}
+
+  /// Returns an InProcessExchangeSource if the output buffer of 'taskId' is in
+  /// this process, nullptr otherwise. Can be registered with
+  /// ExchangeSource::registerFactory() ahead of the factories for remote
+  /// sources. The producer task must be started before the split for it is
+  /// added to the consumer.
+  static std::unique_ptr<ExchangeSource> create(
+      const std::string& taskId,
+      int destination,
+      std::shared_ptr<ExchangeQueue> queue,
+      memory::MemoryPool* pool);
+
+  bool supportsFlowControlV2() const override {
+    return true;
+  }
+
+  bool shouldRequestLocked() override;
+
+  folly::SemiFuture<Response> request(
+      uint32_t maxBytes,
+      uint32_t maxWaitSeconds) override;
+
+  void close() override;
+
+  folly::F14FastMap<std::string, int64_t> stats() const override;
+
+ private:
+  // Enqueues 'pages' starting at 'sequence' and acknowledges them to the
+  // producer.
+  void processPages(
+      std::vector<std::shared_ptr<SerializedPage>> pages,
+      int64_t requestedSequence,
+      int64_t sequence,
+      const std::shared_ptr<PartitionedOutputBufferManager>& buffers);
+
+  // Sets 'promise_' to an empty response if it is pending. Returns true if
+  // the promise was pending.
+  bool checkSetRequestPromise();
+
+  VeloxPromise<Response> promise_{VeloxPromise<Response>::makeEmpty()};
+  std::atomic<int64_t> numPages_{0};
+  std::atomic<int64_t> numVectorPages_{0};
+  std::atomic<int64_t> totalBytes_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -29,32 +29,66 @@ void notify(std::vector<ContinuePromise>& promises) {
 bool LocalExchangeMemoryManager::increaseMemoryUsage(
     ContinueFuture* future,
     int64_t added) {
-  std::lock_guard<std::mutex> l(mutex_);
-  bufferedBytes_ += added;
-
-  if (bufferedBytes_ >= maxBufferSize_) {
-    promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
-    *future = promises_.back().getSemiFuture();
-    return true;
+  if ((bufferedBytes_ += added) < maxBufferSize_) {
+    return false;
   }
 
-  return false;
+  std::lock_guard<std::mutex> l(mutex_);
+  hasWaiters_ = true;
+  // Re-check after publishing 'hasWaiters_'. A consumer that brought the usage
+  // below the limit before this point is seen here, any later one will see
+  // 'hasWaiters_' and fulfill the promise.
+  if (bufferedBytes_ < maxBufferSize_) {
+    hasWaiters_ = !promises_.empty();
+    return false;
+  }
+  promises_.emplace_back("LocalExchangeMemoryManager::updateMemoryUsage");
+  *future = promises_.back().getSemiFuture();
+  return true;
 }
 
 std::vector<ContinuePromise> LocalExchangeMemoryManager::decreaseMemoryUsage(
     int64_t removed) {
   std::vector<ContinuePromise> promises;
-  {
-    std::lock_guard<std::mutex> l(mutex_);
-    bufferedBytes_ -= removed;
+  if ((bufferedBytes_ -= removed) >= maxBufferSize_ || !hasWaiters_) {
+    return promises;
+  }
 
-    if (bufferedBytes_ < maxBufferSize_) {
-      promises = std::move(promises_);
-    }
+  std::lock_guard<std::mutex> l(mutex_);
+  if (bufferedBytes_ < maxBufferSize_) {
+    promises = std::move(promises_);
+    hasWaiters_ = false;
   }
   return promises;
 }
 
+uint32_t ScaleWriterState::addProcessedBytes(uint64_t bytes, bool writersBusy) {
+  const auto processedBytes = processedBytes_ += bytes;
+  auto numActiveWriters = numActiveWriters_.load();
+  if (writersBusy && numActiveWriters < numWriters_ &&
+      processedBytes >= numActiveWriters * minProcessedBytes_) {
+    // Another producer may activate a writer at the same time. Only one of
+    // them wins, the others see the new count.
+    if (numActiveWriters_.compare_exchange_strong(
+            numActiveWriters, numActiveWriters + 1)) {
+      return numActiveWriters + 1;
+    }
+  }
+  return numActiveWriters;
+}
+
+folly::Synchronized<LocalExchangeQueue::Queue>::WLockedPtr
+LocalExchangeQueue::lockQueue(uint64_t* lockWaits) {
+  auto locked = queue_.tryWLock();
+  if (!locked) {
+    if (lockWaits != nullptr) {
+      ++*lockWaits;
+    }
+    locked = queue_.wlock();
+  }
+  return locked;
+}
+
 void LocalExchangeQueue::addProducer() {
   queue_.withWLock([&](auto& /*queue*/) {
     VELOX_CHECK(!noMoreProducers_, "addProducer called after noMoreProducers");
@@ -77,16 +111,18 @@ void LocalExchangeQueue::noMoreProducers() {
 
 BlockingReason LocalExchangeQueue::enqueue(
     RowVectorPtr input,
-    ContinueFuture* future) {
-  auto inputBytes = input->estimateFlatSize();
+    ContinueFuture* future,
+    uint64_t* lockWaits) {
+  const int64_t inputBytes = input->estimateFlatSize();
 
   std::vector<ContinuePromise> consumerPromises;
   bool blockedOnConsumer = false;
-  bool isClosed = queue_.withWLock([&](auto& queue) {
+  bool isClosed = [&]() {
+    auto queue = lockQueue(lockWaits);
     if (closed_) {
       return true;
     }
-    queue.push(std::move(input));
+    queue->push({std::move(input), inputBytes});
     consumerPromises = std::move(consumerPromises_);
 
     if (memoryManager_->increaseMemoryUsage(future, inputBytes)) {
@@ -94,7 +130,7 @@ BlockingReason LocalExchangeQueue::enqueue(
     }
 
     return false;
-  });
+  }();
 
   if (isClosed) {
     return BlockingReason::kNotBlocked;
@@ -124,12 +160,14 @@ void LocalExchangeQueue::noMoreData() {
 BlockingReason LocalExchangeQueue::next(
     ContinueFuture* future,
     memory::MemoryPool* pool,
-    RowVectorPtr* data) {
+    RowVectorPtr* data,
+    uint64_t* lockWaits) {
   std::vector<ContinuePromise> memoryPromises;
-  auto blockingReason = queue_.withWLock([&](auto& queue) {
+  auto blockingReason = [&]() {
+    auto queue = lockQueue(lockWaits);
     *data = nullptr;
-    if (queue.empty()) {
-      if (isFinishedLocked(queue)) {
+    if (queue->empty()) {
+      if (isFinishedLocked(*queue)) {
         return BlockingReason::kNotBlocked;
       }
 
@@ -139,20 +177,19 @@ BlockingReason LocalExchangeQueue::next(
       return BlockingReason::kWaitForProducer;
     }
 
-    *data = queue.front();
-    queue.pop();
+    *data = std::move(queue->front().data);
+    const auto bytes = queue->front().bytes;
+    queue->pop();
 
-    memoryPromises =
-        memoryManager_->decreaseMemoryUsage((*data)->estimateFlatSize());
+    memoryPromises = memoryManager_->decreaseMemoryUsage(bytes);
 
     return BlockingReason::kNotBlocked;
-  });
+  }();
   notify(memoryPromises);
   return blockingReason;
 }
 
-bool LocalExchangeQueue::isFinishedLocked(
-    const std::queue<RowVectorPtr>& queue) const {
+bool LocalExchangeQueue::isFinishedLocked(const Queue& queue) const {
   if (closed_) {
     return true;
   }
@@ -168,13 +205,17 @@ bool LocalExchangeQueue::isFinished() {
   return queue_.withWLock([&](auto& queue) { return isFinishedLocked(queue); });
 }
 
+bool LocalExchangeQueue::isClosed() {
+  return queue_.withWLock([&](auto& /*queue*/) { return closed_; });
+}
+
 void LocalExchangeQueue::close() {
   std::vector<ContinuePromise> consumerPromises;
   std::vector<ContinuePromise> memoryPromises;
   queue_.withWLock([&](auto& queue) {
     uint64_t freedBytes = 0;
     while (!queue.empty()) {
-      freedBytes += queue.front()->estimateFlatSize();
+      freedBytes += queue.front().bytes;
       queue.pop();
     }
 
@@ -220,7 +261,7 @@ BlockingReason LocalExchange::isBlocked(ContinueFuture* future) {
 
 RowVectorPtr LocalExchange::getOutput() {
   RowVectorPtr data;
-  blockingReason_ = queue_->next(&future_, pool(), &data);
+  blockingReason_ = queue_->next(&future_, pool(), &data, &numLockWaits_);
   if (blockingReason_ != BlockingReason::kNotBlocked) {
     return nullptr;
   }
@@ -235,6 +276,17 @@ bool LocalExchange::isFinished() {
   return queue_->isFinished();
 }
 
+void LocalExchange::close() {
+  if (numLockWaits_ > 0) {
+    addRuntimeStat(kQueueLockWaits, RuntimeCounter(numLockWaits_));
+    numLockWaits_ = 0;
+  }
+  Operator::close();
+  if (queue_) {
+    queue_->close();
+  }
+}
+
 LocalPartition::LocalPartition(
     int32_t operatorId,
     DriverCtx* ctx,
@@ -251,7 +303,14 @@ LocalPartition::LocalPartition(
       partitionFunction_(
           numPartitions_ == 1
               ? nullptr
-              : planNode->partitionFunctionSpec().create(numPartitions_)) {
+              : planNode->partitionFunctionSpec().create(numPartitions_)),
+      scaleWriterState_{
+          planNode->scaleWriter() && numPartitions_ > 1
+              ? ctx->task->getScaleWriterState(
+                    ctx->splitGroupId, planNode->id())
+              : nullptr},
+      memoryManager_{queues_[0]->memoryManager()},
+      nextWriter_{ctx->driverId} {
   VELOX_CHECK(numPartitions_ == 1 || partitionFunction_ != nullptr);
 
   for (auto& queue : queues_) {
@@ -309,9 +368,14 @@ void LocalPartition::addInput(RowVectorPtr input) {
 
   input_ = std::move(input);
 
+  if (scaleWriterState_ != nullptr) {
+    addScaleWriterInput();
+    return;
+  }
+
   if (numPartitions_ == 1) {
     ContinueFuture future;
-    auto blockingReason = queues_[0]->enqueue(input_, &future);
+    auto blockingReason = queues_[0]->enqueue(input_, &future, &numLockWaits_);
     if (blockingReason != BlockingReason::kNotBlocked) {
       blockingReasons_.push_back(blockingReason);
       futures_.push_back(std::move(future));
@@ -323,8 +387,8 @@ void LocalPartition::addInput(RowVectorPtr input) {
       partitionFunction_->partition(*input_, partitions_);
   if (singlePartition.has_value()) {
     ContinueFuture future;
-    auto blockingReason =
-        queues_[singlePartition.value()]->enqueue(input_, &future);
+    auto blockingReason = queues_[singlePartition.value()]->enqueue(
+        input_, &future, &numLockWaits_);
     if (blockingReason != BlockingReason::kNotBlocked) {
       blockingReasons_.push_back(blockingReason);
       futures_.push_back(std::move(future));
@@ -339,6 +403,13 @@ void LocalPartition::addInput(RowVectorPtr input) {
   std::vector<vector_size_t> maxIndex(numPartitions_, 0);
   for (auto i = 0; i < numInput; ++i) {
     auto partition = partitions_[i];
+    if (partition == core::PartitionFunction::kAllPartitions) {
+      for (auto j = 0; j < numPartitions_; ++j) {
+        rawIndices[j][maxIndex[j]] = i;
+        ++maxIndex[j];
+      }
+      continue;
+    }
     rawIndices[partition][maxIndex[partition]] = i;
     ++maxIndex[partition];
   }
@@ -354,7 +425,7 @@ void LocalPartition::addInput(RowVectorPtr input) {
         wrapChildren(input_, partitionSize, std::move(indexBuffers[i]));
 
     ContinueFuture future;
-    auto reason = queues_[i]->enqueue(partitionData, &future);
+    auto reason = queues_[i]->enqueue(partitionData, &future, &numLockWaits_);
     if (reason != BlockingReason::kNotBlocked) {
       blockingReasons_.push_back(reason);
       futures_.push_back(std::move(future));
@@ -362,6 +433,25 @@ void LocalPartition::addInput(RowVectorPtr input) {
   }
 }
 
+void LocalPartition::addScaleWriterInput() {
+  // The active writers do not keep up if the last input blocked on the full
+  // exchange buffer or if their queues hold at least half of it.
+  const bool writersBusy = blockedOnWriters_ ||
+      memoryManager_->bufferedBytes() >= memoryManager_->maxBufferSize() / 2;
+  const auto numActiveWriters = scaleWriterState_->addProcessedBytes(
+      input_->estimateFlatSize(), writersBusy);
+  const auto writer = nextWriter_++ % numActiveWriters;
+
+  ContinueFuture future;
+  auto blockingReason =
+      queues_[writer]->enqueue(input_, &future, &numLockWaits_);
+  blockedOnWriters_ = blockingReason != BlockingReason::kNotBlocked;
+  if (blockedOnWriters_) {
+    blockingReasons_.push_back(blockingReason);
+    futures_.push_back(std::move(future));
+  }
+}
+
 BlockingReason LocalPartition::isBlocked(ContinueFuture* future) {
   if (!futures_.empty()) {
     auto blockingReason = blockingReasons_.front();
@@ -381,11 +471,31 @@ void LocalPartition::noMoreInput() {
   }
 }
 
+void LocalPartition::close() {
+  if (numLockWaits_ > 0) {
+    addRuntimeStat(
+        LocalExchange::kQueueLockWaits, RuntimeCounter(numLockWaits_));
+    numLockWaits_ = 0;
+  }
+  if (scaleWriterState_ != nullptr) {
+    addRuntimeStat(
+        kScaledWriters, RuntimeCounter(scaleWriterState_->numActiveWriters()));
+  }
+  Operator::close();
+}
+
 bool LocalPartition::isFinished() {
-  if (!futures_.empty() || !noMoreInput_) {
+  if (!futures_.empty()) {
     return false;
   }
-
-  return true;
+  if (noMoreInput_) {
+    return true;
+  }
+  // Finishes early if no consumer needs more data, e.g. after a Limit got its
+  // rows. This closes the upstream operators of the pipeline, e.g. a
+  // TableScan.
+  return std::all_of(queues_.begin(), queues_.end(), [](const auto& queue) {
+    return queue->isClosed();
+  });
 }
 } // namespace facebook::velox::exec
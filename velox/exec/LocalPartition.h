@@ -21,7 +21,8 @@
 namespace facebook::velox::exec {
 
 /// Keeps track of the total size in bytes of the data buffered in all
-/// LocalExchangeQueues.
+/// LocalExchangeQueues. The usage is an atomic counter and the mutex is taken
+/// only when producers are blocked or about to block on the limit.
 class LocalExchangeMemoryManager {
  public:
   explicit LocalExchangeMemoryManager(int64_t maxBufferSize)
@@ -36,13 +37,49 @@ class LocalExchangeMemoryManager {
   /// caller to fulfill.
   std::vector<ContinuePromise> decreaseMemoryUsage(int64_t removed);
 
+  int64_t bufferedBytes() const {
+    return bufferedBytes_;
+  }
+
+  int64_t maxBufferSize() const {
+    return maxBufferSize_;
+  }
+
  private:
   const int64_t maxBufferSize_;
+  std::atomic<int64_t> bufferedBytes_{0};
+  // True if 'promises_' may be non-empty. Set under 'mutex_' before
+  // re-checking 'bufferedBytes_' so that a concurrent decrease below the limit
+  // either is seen by the producer or sees the flag and fulfills the promise.
+  std::atomic_bool hasWaiters_{false};
   std::mutex mutex_;
-  int64_t bufferedBytes_{0};
   std::vector<ContinuePromise> promises_;
 };
 
+/// Shared by the producers of a scale-writer local exchange. Tracks how many
+/// of the writer queues receive data. Writers are only activated, never
+/// deactivated, since an active writer already has open files.
+class ScaleWriterState {
+ public:
+  ScaleWriterState(uint32_t numWriters, uint64_t minProcessedBytes)
+      : numWriters_{numWriters}, minProcessedBytes_{minProcessedBytes} {}
+
+  uint32_t numActiveWriters() const {
+    return numActiveWriters_;
+  }
+
+  /// Adds 'bytes' to the bytes routed to the active writers. Activates another
+  /// writer if 'writersBusy' and the active writers have received at least
+  /// 'minProcessedBytes' each. Returns the number of active writers.
+  uint32_t addProcessedBytes(uint64_t bytes, bool writersBusy);
+
+ private:
+  const uint32_t numWriters_;
+  const uint64_t minProcessedBytes_;
+  std::atomic<uint32_t> numActiveWriters_{1};
+  std::atomic<uint64_t> processedBytes_{0};
+};
+
 /// Buffers data for a single partition produced by local exchange. Allows
 /// multiple producers to enqueue data and multiple consumers fetch data. Each
 /// producer must be registered with a call to 'addProducer'. 'noMoreProducers'
@@ -67,7 +104,13 @@ class LocalExchangeQueue {
   /// Used by a producer to add data. Returning kNotBlocked if can accept more
   /// data. Otherwise returns kWaitForConsumer and sets future that will be
   /// completed when ready to accept more data.
-  BlockingReason enqueue(RowVectorPtr input, ContinueFuture* future);
+  ///
+  /// If 'lockWaits' is not null, it is incremented when the queue lock was
+  /// held by another thread. The same applies to 'next'.
+  BlockingReason enqueue(
+      RowVectorPtr input,
+      ContinueFuture* future,
+      uint64_t* lockWaits = nullptr);
 
   /// Called by a producer to indicate that no more data will be added.
   void noMoreData();
@@ -79,21 +122,45 @@ class LocalExchangeQueue {
   /// once there is data to fetch or if all producers report completion.
   ///
   /// @param pool Memory pool used to copy the data before returning.
-  BlockingReason
-  next(ContinueFuture* future, memory::MemoryPool* pool, RowVectorPtr* data);
+  BlockingReason next(
+      ContinueFuture* future,
+      memory::MemoryPool* pool,
+      RowVectorPtr* data,
+      uint64_t* lockWaits = nullptr);
 
   bool isFinished();
 
+  /// Returns true after close(). Producers for a closed queue can stop, since
+  /// its consumer does not need more data.
+  bool isClosed();
+
+  const std::shared_ptr<LocalExchangeMemoryManager>& memoryManager() const {
+    return memoryManager_;
+  }
+
   /// Drop remaining data from the queue and notify consumers and producers if
   /// called before all the data has been processed. No-op otherwise.
   void close();
 
  private:
-  bool isFinishedLocked(const std::queue<RowVectorPtr>& queue) const;
+  // A buffered vector and its estimated size in bytes. The size is computed
+  // once by the producer, outside of the queue lock.
+  struct Entry {
+    RowVectorPtr data;
+    int64_t bytes;
+  };
+
+  using Queue = std::queue<Entry>;
+
+  // Returns the write-locked queue, incrementing '*lockWaits' if the lock was
+  // contended.
+  folly::Synchronized<Queue>::WLockedPtr lockQueue(uint64_t* lockWaits);
+
+  bool isFinishedLocked(const Queue& queue) const;
 
   std::shared_ptr<LocalExchangeMemoryManager> memoryManager_;
   const int partition_;
-  folly::Synchronized<std::queue<RowVectorPtr>> queue_;
+  folly::Synchronized<Queue> queue_;
   // Satisfied when data becomes available or all producers report that they
   // finished producing, e.g. queue_ is not empty or noMoreProducers_ is true
   // and pendingProducers_ is zero.
@@ -114,6 +181,10 @@ class LocalExchange : public SourceOperator {
       const std::string& planNodeId,
       int partition);
 
+  /// Runtime stat with the number of times an operator waited for the lock
+  /// of a LocalExchangeQueue that another driver was holding.
+  static inline const std::string kQueueLockWaits = "queueLockWaits";
+
   std::string toString() const override {
     return fmt::format("LocalExchange({})", partition_);
   }
@@ -126,17 +197,14 @@ class LocalExchange : public SourceOperator {
 
   /// Close exchange queue. If called before all data has been processed,
   /// notifies the producer that no more data is needed.
-  void close() override {
-    Operator::close();
-    if (queue_) {
-      queue_->close();
-    }
-  }
+  void close() override;
 
  private:
   const int partition_;
   const std::shared_ptr<LocalExchangeQueue> queue_{nullptr};
   ContinueFuture future_;
+  // The number of times fetching from 'queue_' waited for its lock.
+  uint64_t numLockWaits_{0};
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
 };
 
@@ -171,16 +239,36 @@ class LocalPartition : public Operator {
 
   bool isFinished() override;
 
+  void close() override;
+
+  /// Runtime stat with the number of writers a scale-writer exchange was
+  /// routing to when the operator closed.
+  static inline const std::string kScaledWriters = "scaledWriters";
+
  private:
+  // Enqueues 'input_' to the next active writer of a scale-writer exchange.
+  void addScaleWriterInput();
+
   const std::vector<std::shared_ptr<LocalExchangeQueue>> queues_;
   const size_t numPartitions_;
   std::unique_ptr<core::PartitionFunction> partitionFunction_;
+  // Set if the exchange is a scale-writer one with more than one writer.
+  const std::shared_ptr<ScaleWriterState> scaleWriterState_;
+  const std::shared_ptr<LocalExchangeMemoryManager> memoryManager_;
+  // Round-robin position over the active writers.
+  uint32_t nextWriter_{0};
+  // True if the last input of a scale-writer exchange blocked on the full
+  // exchange buffer.
+  bool blockedOnWriters_{false};
 
   std::vector<BlockingReason> blockingReasons_;
   std::vector<ContinueFuture> futures_;
 
   /// Reusable memory for hash calculation.
   std::vector<uint32_t> partitions_;
+
+  // The number of times enqueuing to 'queues_' waited for a queue lock.
+  uint64_t numLockWaits_{0};
 };
 
 } // namespace facebook::velox::exec
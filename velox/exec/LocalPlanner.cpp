@@ -202,8 +202,9 @@ uint32_t maxDrivers(
     } else if (
         auto orderBy =
             std::dynamic_pointer_cast<const core::OrderByNode>(node)) {
-      // final orderby must run single-threaded
-      if (!orderBy->isPartial()) {
+      // final orderby must run single-threaded unless the drivers merge their
+      // sorted rows.
+      if (!orderBy->isPartial() && !queryConfig.parallelOrderByEnabled()) {
         return 1;
       }
     } else if (
@@ -493,6 +494,12 @@ std::shared_ptr<Driver> DriverFactory::createDriver(
         auto limitNode =
             std::dynamic_pointer_cast<const core::LimitNode>(planNode)) {
       operators.push_back(std::make_unique<Limit>(id, ctx.get(), limitNode));
+      if (id > 0) {
+        if (auto* tableScan =
+                dynamic_cast<TableScan*>(operators[id - 1].get())) {
+          tableScan->setLimit(limitNode->offset() + limitNode->count());
+        }
+      }
     } else if (
         auto orderByNode =
             std::dynamic_pointer_cast<const core::OrderByNode>(planNode)) {
@@ -16,6 +16,7 @@
 
 #include "velox/exec/MarkDistinct.h"
 #include "velox/common/base/Range.h"
+#include "velox/exec/OperatorUtils.h"
 #include "velox/vector/FlatVector.h"
 
 #include <algorithm>
@@ -32,8 +33,12 @@ MarkDistinct::MarkDistinct(
           planNode->outputType(),
           operatorId,
           planNode->id(),
-          "MarkDistinct") {
-  const auto& inputType = planNode->sources()[0]->outputType();
+          "MarkDistinct",
+          planNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
+      inputType_{planNode->sources()[0]->outputType()} {
+  const auto& inputType = inputType_;
 
   // Set all input columns as identity projection.
   for (auto i = 0; i < inputType->size(); ++i) {
@@ -43,23 +48,62 @@ MarkDistinct::MarkDistinct(
   // We will use result[0] for distinct mask output.
   resultProjections_.emplace_back(0, inputType->size());
 
-  groupingSet_ = GroupingSet::createForMarkDistinct(
-      inputType,
+  table_ = std::make_unique<HashTable<false>>(
       createVectorHashers(inputType, planNode->distinctKeys()),
-      operatorCtx_.get(),
-      &nonReclaimableSection_);
+      std::vector<Accumulator>{},
+      std::vector<TypePtr>{},
+      false, // allowDuplicates
+      false, // isJoinBuild
+      false, // hasProbedFlag
+      0, // minTableSizeForParallelJoinBuild
+      pool());
+  lookup_ = std::make_unique<HashLookup>(table_->hashers());
+
+  if (spillEnabled()) {
+    std::vector<std::string> names;
+    std::vector<TypePtr> types;
+    for (const auto& hasher : table_->hashers()) {
+      names.push_back(inputType->nameOf(hasher->channel()));
+      types.push_back(hasher->type());
+    }
+    spillerStoreType_ = ROW(std::move(names), std::move(types));
+  }
 
   results_.resize(1);
 }
 
 void MarkDistinct::addInput(RowVectorPtr input) {
-  groupingSet_->addInput(input, false /*mayPushdown*/);
+  if (spillEnabled()) {
+    if (inputSpiller_ == nullptr) {
+      maybeTestSpill();
+    }
+    if (inputSpiller_ != nullptr) {
+      spillInput(input);
+      return;
+    }
+  }
+
+  {
+    // Prevents the memory arbitrator to reclaim memory from this operator
+    // while the hash table is being updated.
+    NonReclaimableSection guard(this);
+    probeTable(input);
+  }
 
   input_ = std::move(input);
 }
 
+void MarkDistinct::probeTable(const RowVectorPtr& input) {
+  SelectivityVector rows(input->size());
+  table_->prepareForProbe(*lookup_, input, rows, false);
+  table_->groupProbe(*lookup_);
+}
+
 RowVectorPtr MarkDistinct::getOutput() {
-  if (isFinished() || !input_) {
+  if (input_ == nullptr && noMoreInput_) {
+    addSpillInput();
+  }
+  if (input_ == nullptr) {
     return nullptr;
   }
 
@@ -79,7 +123,7 @@ RowVectorPtr MarkDistinct::getOutput() {
       results_[0]->as<FlatVector<bool>>()->mutableRawValues<uint64_t>();
 
   bits::fillBits(resultBits, 0, outputSize, false);
-  for (const auto i : groupingSet_->hashLookup().newGroups) {
+  for (const auto i : lookup_->newGroups) {
     bits::setBit(resultBits, i, true);
   }
   auto output = fillOutput(outputSize, nullptr);
@@ -91,7 +135,218 @@ RowVectorPtr MarkDistinct::getOutput() {
   return output;
 }
 
+void MarkDistinct::noMoreInput() {
+  Operator::noMoreInput();
+  if (inputSpiller_ == nullptr) {
+    return;
+  }
+
+  spiller_->finishSpill(spillTablePartitionSet_);
+  inputSpiller_->finishSpill(spillInputPartitionSet_);
+  recordSpillStats(spiller_->stats());
+  recordSpillStats(inputSpiller_->stats());
+
+  // A partition may have spilled hash table rows, spilled input or both.
+  std::set<SpillPartitionId> partitionIds;
+  for (const auto& [id, _] : spillTablePartitionSet_) {
+    partitionIds.insert(id);
+  }
+  for (const auto& [id, _] : spillInputPartitionSet_) {
+    partitionIds.insert(id);
+  }
+  spillPartitionIds_.assign(partitionIds.begin(), partitionIds.end());
+}
+
 bool MarkDistinct::isFinished() {
-  return noMoreInput_ && !input_;
+  return noMoreInput_ && !input_ && spillInputReader_ == nullptr &&
+      spillPartitionIds_.empty();
+}
+
+void MarkDistinct::reclaim(
+    uint64_t /*targetBytes*/,
+    memory::MemoryReclaimer::Stats& stats) {
+  VELOX_CHECK(canReclaim());
+
+  // NOTE: a mark distinct operator is reclaimable if it hasn't started
+  // restoring the spilled partitions and is not under non-reclaimable
+  // execution section.
+  if (noMoreInput_ || nonReclaimableSection_) {
+    ++stats.numNonReclaimableAttempts;
+    LOG(WARNING) << "Can't reclaim from mark distinct operator, noMoreInput_["
+                 << noMoreInput_ << "], nonReclaimableSection_["
+                 << nonReclaimableSection_ << "], " << pool()->name();
+    return;
+  }
+
+  // The hash table is spilled at most once. All the input after that goes to
+  // disk.
+  if (spiller_ != nullptr || table_->numDistinct() == 0) {
+    return;
+  }
+  spill();
+}
+
+void MarkDistinct::maybeTestSpill() {
+  if (spillConfig_->testSpillPct == 0 || table_->numDistinct() == 0) {
+    return;
+  }
+  if (folly::hasher<uint64_t>()(++spillTestCounter_) % 100 <=
+      spillConfig_->testSpillPct) {
+    spill();
+  }
+}
+
+void MarkDistinct::spill() {
+  VELOX_CHECK(spillEnabled());
+  VELOX_CHECK_NULL(spiller_);
+
+  const auto& spillConfig = spillConfig_.value();
+  // The hash table and the input are partitioned the same way as the build and
+  // probe sides of a hash join.
+  HashBitRange hashBits(
+      spillConfig.startPartitionBit,
+      spillConfig.startPartitionBit + spillConfig.joinPartitionBits);
+  spiller_ = std::make_unique<Spiller>(
+      Spiller::Type::kHashJoinBuild,
+      table_->rows(),
+      [&](folly::Range<char**> rows) { table_->rows()->eraseRows(rows); },
+      spillerStoreType_,
+      hashBits,
+      table_->hashers().size(),
+      std::vector<CompareFlags>(),
+      spillConfig.filePath,
+      spillConfig.maxFileSize,
+      spillConfig.writeBufferSize,
+      spillConfig.minSpillRunSize,
+      spillConfig.compressionKind,
+      Spiller::pool(),
+      spillConfig.executor,
+      spillConfig.writeRateLimiter);
+
+  std::vector<Spiller::SpillableStats> spillableStats;
+  spiller_->fillSpillRuns(spillableStats);
+  spiller_->spill();
+  table_->clear();
+  pool()->release();
+
+  inputSpiller_ = std::make_unique<Spiller>(
+      Spiller::Type::kHashJoinProbe,
+      inputType_,
+      hashBits,
+      spillConfig.filePath,
+      spillConfig.maxFileSize,
+      spillConfig.writeBufferSize,
+      spillConfig.minSpillRunSize,
+      spillConfig.compressionKind,
+      Spiller::pool(),
+      spillConfig.executor,
+      spillConfig.writeRateLimiter);
+  inputSpiller_->setPartitionsSpilled(spiller_->spilledPartitionSet());
+
+  std::vector<column_index_t> keyChannels;
+  for (const auto& hasher : table_->hashers()) {
+    keyChannels.push_back(hasher->channel());
+  }
+  spillHashFunction_ = std::make_unique<HashPartitionFunction>(
+      hashBits, inputType_, keyChannels);
+  spillInputIndicesBuffers_.resize(spillHashFunction_->numPartitions());
+  numSpillInputs_.resize(spillHashFunction_->numPartitions());
+
+  // NOTE: 'input_' is not spilled. Its distinct rows have already been
+  // recorded in 'lookup_->newGroups' and the rows it inserted into the hash
+  // table have been spilled above.
+}
+
+void MarkDistinct::spillInput(const RowVectorPtr& input) {
+  // Ensure vector are lazy loaded before spilling.
+  for (auto i = 0; i < input->childrenSize(); ++i) {
+    input->childAt(i)->loadedVector();
+  }
+
+  const auto singlePartition =
+      spillHashFunction_->partition(*input, spillPartitions_);
+  if (singlePartition.has_value()) {
+    inputSpiller_->spill(singlePartition.value(), input);
+    return;
+  }
+
+  const auto numInput = input->size();
+  const auto maxIndicesBufferBytes = numInput * sizeof(vector_size_t);
+  for (auto& buffer : spillInputIndicesBuffers_) {
+    if (buffer == nullptr || buffer->size() < maxIndicesBufferBytes) {
+      buffer = allocateIndices(numInput, pool());
+    }
+  }
+  std::fill(numSpillInputs_.begin(), numSpillInputs_.end(), 0);
+  for (auto row = 0; row < numInput; ++row) {
+    const auto partition = spillPartitions_[row];
+    spillInputIndicesBuffers_[partition]
+        ->asMutable<vector_size_t>()[numSpillInputs_[partition]++] = row;
+  }
+
+  for (auto partition = 0; partition < numSpillInputs_.size(); ++partition) {
+    const auto numSpillInputs = numSpillInputs_[partition];
+    if (numSpillInputs == 0) {
+      continue;
+    }
+    inputSpiller_->spill(
+        partition,
+        wrap(numSpillInputs, spillInputIndicesBuffers_[partition], input));
+  }
+}
+
+void MarkDistinct::addSpillInput() {
+  VELOX_CHECK_NULL(input_);
+  for (;;) {
+    if (spillInputReader_ != nullptr) {
+      RowVectorPtr input;
+      if (spillInputReader_->nextBatch(input)) {
+        probeTable(input);
+        input_ = std::move(input);
+        return;
+      }
+      spillInputReader_.reset();
+    }
+    if (spillPartitionIds_.empty()) {
+      return;
+    }
+    restoreNextSpillPartition();
+  }
+}
+
+void MarkDistinct::restoreNextSpillPartition() {
+  const auto id = spillPartitionIds_.front();
+  spillPartitionIds_.pop_front();
+  table_->clear();
+
+  auto tableIt = spillTablePartitionSet_.find(id);
+  if (tableIt != spillTablePartitionSet_.end()) {
+    auto reader = tableIt->second->createReader();
+    spillTablePartitionSet_.erase(tableIt);
+
+    const auto& hashers = table_->hashers();
+    RowVectorPtr data;
+    while (reader->nextBatch(data)) {
+      // Lay out the spilled distinct keys as in the input to insert them into
+      // the hash table. The other input columns are not accessed.
+      const auto numRows = data->size();
+      std::vector<VectorPtr> children(inputType_->size());
+      for (auto i = 0; i < inputType_->size(); ++i) {
+        children[i] = BaseVector::createNullConstant(
+            inputType_->childAt(i), numRows, pool());
+      }
+      for (auto i = 0; i < hashers.size(); ++i) {
+        children[hashers[i]->channel()] = data->childAt(i);
+      }
+      probeTable(std::make_shared<RowVector>(
+          pool(), inputType_, nullptr, numRows, std::move(children)));
+    }
+  }
+
+  auto inputIt = spillInputPartitionSet_.find(id);
+  if (inputIt != spillInputPartitionSet_.end()) {
+    spillInputReader_ = inputIt->second->createReader();
+    spillInputPartitionSet_.erase(inputIt);
+  }
 }
 } // namespace facebook::velox::exec
@@ -16,7 +16,8 @@
 
 #pragma once
 
-#include "velox/exec/GroupingSet.h"
+#include "velox/exec/HashPartitionFunction.h"
+#include "velox/exec/HashTable.h"
 #include "velox/exec/Operator.h"
 
 namespace facebook::velox::exec {
@@ -28,8 +29,10 @@ class MarkDistinct : public Operator {
       DriverCtx* driverCtx,
       const std::shared_ptr<const core::MarkDistinctNode>& planNode);
 
+  /// NOTE: the input spilled after the hash table has been spilled is marked
+  /// and returned after all the input has been received.
   bool preservesOrder() const override {
-    return true;
+    return !spillEnabled();
   }
 
   bool needsInput() const override {
@@ -44,10 +47,75 @@ class MarkDistinct : public Operator {
     return BlockingReason::kNotBlocked;
   }
 
+  void noMoreInput() override;
+
   bool isFinished() override;
 
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
  private:
-  // TODO: Document spilling configuration in spilling.rst.
-  std::unique_ptr<GroupingSet> groupingSet_;
+  bool spillEnabled() const {
+    return spillConfig_.has_value();
+  }
+
+  // Inserts the distinct keys of 'input' into the hash table. The new keys are
+  // returned in 'lookup_->newGroups'.
+  void probeTable(const RowVectorPtr& input);
+
+  // Spills the hash table if the test-only spill percentage triggers.
+  void maybeTestSpill();
+
+  // Spills all the partitions of the hash table to disk and clears the table.
+  // All the input received after that is spilled as well, including 'input_'
+  // if it has not been processed yet. The spilled partitions are restored one
+  // at a time after all the input has been received.
+  void spill();
+
+  // Appends the rows of 'input' to the spill files of their partitions.
+  void spillInput(const RowVectorPtr& input);
+
+  // Reads the next batch of spilled input into 'input_'. Restores the next
+  // spilled partition of the hash table when the input of the current one has
+  // been consumed. Leaves 'input_' null if there is no more spilled input.
+  void addSpillInput();
+
+  // Loads the distinct keys of the next spilled partition into 'table_' and
+  // sets 'spillInputReader_' to read the spilled input of the same partition.
+  void restoreNextSpillPartition();
+
+  const RowTypePtr inputType_;
+
+  // Hash table of the distinct keys seen so far.
+  std::unique_ptr<BaseHashTable> table_;
+  std::unique_ptr<HashLookup> lookup_;
+
+  // The row type of the spilled hash table rows, i.e. the distinct keys.
+  RowTypePtr spillerStoreType_;
+
+  // Spills the hash table rows.
+  std::unique_ptr<Spiller> spiller_;
+
+  // Spills the input received after the hash table has been spilled.
+  std::unique_ptr<Spiller> inputSpiller_;
+
+  // Assigns spill partitions to the input rows. Uses the same hash bits as
+  // 'spiller_' so that the spilled input rows and the hash table rows of the
+  // same distinct key land in the same spill partition.
+  std::unique_ptr<HashPartitionFunction> spillHashFunction_;
+  std::vector<uint32_t> spillPartitions_;
+  std::vector<BufferPtr> spillInputIndicesBuffers_;
+  std::vector<vector_size_t> numSpillInputs_;
+
+  SpillPartitionSet spillTablePartitionSet_;
+  SpillPartitionSet spillInputPartitionSet_;
+
+  // Ids of the spilled partitions which have not been restored yet.
+  std::deque<SpillPartitionId> spillPartitionIds_;
+
+  std::unique_ptr<UnorderedStreamReader<BatchStream>> spillInputReader_;
+
+  // Counts the input batches for the test-only spill path.
+  uint32_t spillTestCounter_{0};
 };
 } // namespace facebook::velox::exec
@@ -26,14 +26,23 @@ class MemoryReclaimer : public memory::MemoryReclaimer {
  public:
   virtual ~MemoryReclaimer() = default;
 
-  static std::unique_ptr<memory::MemoryReclaimer> create();
+  /// Creates a memory reclaimer with the arbitration 'priority' of the
+  /// associated memory pool. See memory::MemoryReclaimer::priority().
+  static std::unique_ptr<memory::MemoryReclaimer> create(int32_t priority = 0);
 
   void enterArbitration() override;
 
   void leaveArbitration() noexcept override;
 
+  int32_t priority() const override {
+    return priority_;
+  }
+
  protected:
-  MemoryReclaimer() = default;
+  explicit MemoryReclaimer(int32_t priority = 0) : priority_(priority) {}
+
+ private:
+  const int32_t priority_;
 };
 
 /// Callback used by memory arbitration to check if a driver thread under memory
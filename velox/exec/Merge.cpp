@@ -17,6 +17,7 @@
 #include "velox/exec/Merge.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/exec/Task.h"
+#include "velox/vector/DecodedVector.h"
 
 using facebook::velox::common::testutil::TestValue;
 
@@ -154,30 +155,39 @@ RowVectorPtr Merge::getOutput() {
       return std::move(output_);
     }
 
-    if (stream->setOutputRow(outputSize_)) {
-      // The stream is at end of input batch. Need to copy out the rows before
-      // fetching next batch in 'pop'.
-      stream->copyToOutput(output_);
-    }
+    // If 'stream' won again, take its rows up to the first row of the stream
+    // that would win next.
+    const bool inRun = stream == lastWinner_;
+    SourceStream* runnerUp = inRun ? treeOfLosers_->runnerUp() : nullptr;
+    lastWinner_ = stream;
+
+    do {
+      if (stream->setOutputRow(outputSize_)) {
+        // The stream is at end of input batch. Need to copy out the rows
+        // before fetching next batch in 'pop'.
+        stream->copyToOutput(output_);
+      }
 
-    ++outputSize_;
+      ++outputSize_;
 
-    // Advance the stream.
-    stream->pop(sourceBlockingFutures_);
+      // Advance the stream.
+      stream->pop(sourceBlockingFutures_);
 
-    if (outputSize_ == outputBatchSize_) {
-      // Copy out data from all sources.
-      for (auto& s : streams_) {
-        s->copyToOutput(output_);
-      }
+      if (outputSize_ == outputBatchSize_) {
+        // Copy out data from all sources.
+        for (auto& s : streams_) {
+          s->copyToOutput(output_);
+        }
 
-      outputSize_ = 0;
-      return std::move(output_);
-    }
+        outputSize_ = 0;
+        return std::move(output_);
+      }
 
-    if (!sourceBlockingFutures_.empty()) {
-      return nullptr;
-    }
+      if (!sourceBlockingFutures_.empty()) {
+        return nullptr;
+      }
+    } while (inRun && stream->hasData() &&
+             (runnerUp == nullptr || !(*runnerUp < *stream)));
   }
 }
 
@@ -189,6 +199,9 @@ void Merge::close() {
 
 bool SourceStream::operator<(const MergeStream& other) const {
   const auto& otherCursor = static_cast<const SourceStream&>(other);
+  if (!normalizedKeys_.empty() && !otherCursor.normalizedKeys_.empty()) {
+    return lessNormalized(otherCursor);
+  }
   for (auto i = 0; i < sortingKeys_.size(); ++i) {
     const auto& [_, compareFlags] = sortingKeys_[i];
     VELOX_DCHECK(
@@ -226,12 +239,22 @@ void SourceStream::copyToOutput(RowVectorPtr& output) {
   }
 
   vector_size_t sourceRow = firstSourceRow_;
-  outputRows_.applyToSelected(
-      [&](auto row) { sourceRows_[row] = sourceRow++; });
+  const auto numRows = outputRows_.end() - outputRows_.begin();
+  if (outputRows_.countSelected() == numRows) {
+    // A run of rows from 'this' goes to consecutive output rows.
+    for (auto i = 0; i < output->type()->size(); ++i) {
+      output->childAt(i)->copy(
+          data_->childAt(i).get(), outputRows_.begin(), sourceRow, numRows);
+    }
+    sourceRow += numRows;
+  } else {
+    outputRows_.applyToSelected(
+        [&](auto row) { sourceRows_[row] = sourceRow++; });
 
-  for (auto i = 0; i < output->type()->size(); ++i) {
-    output->childAt(i)->copy(
-        data_->childAt(i).get(), outputRows_, sourceRows_.data());
+    for (auto i = 0; i < output->type()->size(); ++i) {
+      output->childAt(i)->copy(
+          data_->childAt(i).get(), outputRows_, sourceRows_.data());
+    }
   }
 
   outputRows_.clearAll();
@@ -264,10 +287,62 @@ bool SourceStream::fetchMoreData(std::vector<ContinueFuture>& futures) {
     for (const auto& key : sortingKeys_) {
       keyColumns_.push_back(data_->childAt(key.first).get());
     }
+    normalizeKeys();
   }
   return false;
 }
 
+namespace {
+template <TypeKind Kind>
+bool normalizeIntegerKeys(
+    const BaseVector& keys,
+    std::vector<int64_t>& normalizedKeys) {
+  using T = typename TypeTraits<Kind>::NativeType;
+  SelectivityVector rows(keys.size());
+  DecodedVector decoded(keys, rows);
+  if (decoded.mayHaveNulls()) {
+    return false;
+  }
+  normalizedKeys.resize(keys.size());
+  for (auto i = 0; i < keys.size(); ++i) {
+    normalizedKeys[i] = decoded.valueAt<T>(i);
+  }
+  return true;
+}
+} // namespace
+
+void SourceStream::normalizeKeys() {
+  normalizedKeys_.clear();
+  if (keyColumns_.size() != 1) {
+    return;
+  }
+  const auto& keys = *keyColumns_[0];
+  bool normalized = false;
+  switch (keys.typeKind()) {
+    case TypeKind::TINYINT:
+      normalized =
+          normalizeIntegerKeys<TypeKind::TINYINT>(keys, normalizedKeys_);
+      break;
+    case TypeKind::SMALLINT:
+      normalized =
+          normalizeIntegerKeys<TypeKind::SMALLINT>(keys, normalizedKeys_);
+      break;
+    case TypeKind::INTEGER:
+      normalized =
+          normalizeIntegerKeys<TypeKind::INTEGER>(keys, normalizedKeys_);
+      break;
+    case TypeKind::BIGINT:
+      normalized =
+          normalizeIntegerKeys<TypeKind::BIGINT>(keys, normalizedKeys_);
+      break;
+    default:
+      break;
+  }
+  if (!normalized) {
+    normalizedKeys_.clear();
+  }
+}
+
 LocalMerge::LocalMerge(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -75,6 +75,12 @@ class Merge : public SourceOperator {
   /// Number of rows accumulated in 'output_' so far.
   vector_size_t outputSize_{0};
 
+  /// The stream that produced the last output row. A stream that wins twice
+  /// in a row is likely to have a run of rows that are less than the rows of
+  /// all other streams. These are then taken without going through
+  /// 'treeOfLosers_'.
+  SourceStream* lastWinner_{nullptr};
+
   bool finished_{false};
 
   /// A list of blocking futures for sources. These are populates when a given
@@ -130,12 +136,23 @@ class SourceStream final : public MergeStream {
 
   /// Called if either current row is the last row in the current batch or the
   /// caller accumulated enough output rows across all sources to produce an
-  /// output batch.
+  /// output batch. Consecutive output rows are copied as one range.
   void copyToOutput(RowVectorPtr& output);
 
  private:
   bool fetchMoreData(std::vector<ContinueFuture>& futures);
 
+  // Sets 'normalizedKeys_' if there is a single integer sorting key without
+  // nulls in 'data_'.
+  void normalizeKeys();
+
+  // Compares the current rows of 'this' and 'other' on 'normalizedKeys_'.
+  bool lessNormalized(const SourceStream& other) const {
+    const auto left = normalizedKeys_[currentSourceRow_];
+    const auto right = other.normalizedKeys_[other.currentSourceRow_];
+    return sortingKeys_[0].second.ascending ? left < right : right < left;
+  }
+
   MergeSource* source_;
 
   const std::vector<std::pair<column_index_t, CompareFlags>>& sortingKeys_;
@@ -150,6 +167,11 @@ class SourceStream final : public MergeStream {
   /// Index of the current row.
   vector_size_t currentSourceRow_{0};
 
+  /// The single integer sorting key of each row of 'data_' widened to
+  /// int64_t. Compared instead of 'keyColumns_' if both streams have it. Empty
+  /// if the key is not an integer or has nulls.
+  std::vector<int64_t> normalizedKeys_;
+
   /// True if source has been exhausted.
   bool atEnd_{false};
 
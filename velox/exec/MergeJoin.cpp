@@ -29,7 +29,10 @@ MergeJoin::MergeJoin(
           joinNode->outputType(),
           operatorId,
           joinNode->id(),
-          "MergeJoin"),
+          "MergeJoin",
+          joinNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
       outputBatchSize_{outputBatchRows()},
       joinType_{joinNode->joinType()},
       numKeys_{joinNode->leftKeys().size()},
@@ -228,6 +231,123 @@ bool MergeJoin::findEndOfMatch(
   return true;
 }
 
+void MergeJoin::close() {
+  if (rightSource_) {
+    rightSource_->close();
+  }
+  rightMatchSpillState_.reset();
+  rightMatchSpillFiles_.clear();
+  spilledRightBatch_ = nullptr;
+  if (noMoreInput_) {
+    recordSpillStats(spillStats_.copy());
+  }
+  Operator::close();
+}
+
+void MergeJoin::reclaim(
+    uint64_t /*targetBytes*/,
+    memory::MemoryReclaimer::Stats& stats) {
+  VELOX_CHECK(canReclaim());
+
+  // NOTE: only the batches of a right-side match which is still being
+  // collected are spilled. A complete match is being joined with the left
+  // side and is released right after.
+  if (!rightMatch_.has_value() || rightMatch_->complete ||
+      rightMatch_->inputs.size() < 2) {
+    ++stats.numNonReclaimableAttempts;
+    LOG(WARNING) << "Can't reclaim from merge join operator, no incomplete "
+                    "right-side match to spill, "
+                 << pool()->name();
+    return;
+  }
+  spillRightMatch();
+}
+
+void MergeJoin::maybeTestSpill() {
+  if (spillConfig_->testSpillPct == 0 || rightMatch_->inputs.size() < 2) {
+    return;
+  }
+  if (folly::hasher<uint64_t>()(++spillTestCounter_) % 100 <=
+      spillConfig_->testSpillPct) {
+    spillRightMatch();
+  }
+}
+
+void MergeJoin::spillRightMatch() {
+  VELOX_CHECK(spillEnabled());
+  VELOX_CHECK(rightMatch_.has_value() && !rightMatch_->complete);
+  const auto numSpillInputs = rightMatch_->inputs.size() - 1;
+  if (numSpillInputs == 0) {
+    return;
+  }
+
+  if (rightMatchSpillState_ == nullptr) {
+    const auto& spillConfig = spillConfig_.value();
+    rightMatchSpillState_ = std::make_unique<SpillState>(
+        spillConfig.filePath,
+        1,
+        0,
+        std::vector<CompareFlags>{},
+        spillConfig.maxFileSize,
+        spillConfig.writeBufferSize,
+        spillConfig.compressionKind,
+        memory::spillMemoryPool(),
+        &spillStats_);
+    rightMatchSpillState_->setPartitionSpilled(0);
+  }
+
+  auto& inputs = rightMatch_->inputs;
+  for (auto i = 0; i < numSpillInputs; ++i) {
+    auto input = inputs[i];
+    if (i == 0 && rightMatch_->startIndex > 0) {
+      input = std::static_pointer_cast<RowVector>(input->slice(
+          rightMatch_->startIndex, input->size() - rightMatch_->startIndex));
+    }
+    loadColumns(input, *operatorCtx_->execCtx());
+    rightMatchSpillState_->appendToPartition(0, input);
+  }
+  inputs.erase(inputs.begin(), inputs.begin() + numSpillInputs);
+  rightMatch_->startIndex = 0;
+}
+
+void MergeJoin::finishRightMatchSpill() {
+  VELOX_CHECK_NOT_NULL(rightMatchSpillState_);
+  VELOX_CHECK(rightMatchSpillFiles_.empty());
+  rightMatchSpillState_->finishWrite(0);
+  rightMatchSpillFiles_ = rightMatchSpillState_->files(0);
+  rightMatchSpillState_.reset();
+}
+
+void MergeJoin::startRightMatchSpillRead() {
+  if (spillFileOpen_) {
+    rightMatchSpillFiles_[spillFileIndex_]->finishRead();
+    spillFileOpen_ = false;
+  }
+  spillFileIndex_ = 0;
+  nextRightMatchSpillBatch();
+}
+
+void MergeJoin::nextRightMatchSpillBatch() {
+  spilledRightIndex_ = 0;
+  while (spillFileIndex_ < rightMatchSpillFiles_.size()) {
+    auto& file = rightMatchSpillFiles_[spillFileIndex_];
+    if (!spillFileOpen_) {
+      file->startRead();
+      spillFileOpen_ = true;
+    }
+    if (file->nextBatch(spilledRightBatch_)) {
+      if (spilledRightBatch_->size() > 0) {
+        return;
+      }
+      continue;
+    }
+    file->finishRead();
+    spillFileOpen_ = false;
+    ++spillFileIndex_;
+  }
+  spilledRightBatch_ = nullptr;
+}
+
 namespace {
 void copyRow(
     const RowVectorPtr& source,
@@ -359,6 +479,11 @@ bool MergeJoin::addToOutput() {
     leftStartIndex = leftMatch_->startIndex;
   }
 
+  if (rightMatchSpillState_ != nullptr) {
+    finishRightMatchSpill();
+  }
+  const size_t numSpilledRights = rightMatchSpillFiles_.empty() ? 0 : 1;
+
   size_t numLefts = leftMatch_->inputs.size();
   for (size_t l = firstLeftBatch; l < numLefts; ++l) {
     auto left = leftMatch_->inputs[l];
@@ -366,19 +491,36 @@ bool MergeJoin::addToOutput() {
     auto leftEnd = l == numLefts - 1 ? leftMatch_->endIndex : left->size();
 
     for (auto i = leftStart; i < leftEnd; ++i) {
-      auto firstRightBatch =
-          (l == firstLeftBatch && i == leftStart && rightMatch_->cursor)
-          ? rightMatch_->cursor->batchIndex
-          : 0;
-
+      const bool resume =
+          l == firstLeftBatch && i == leftStart && rightMatch_->cursor;
+      size_t firstRightBatch = resume ? rightMatch_->cursor->batchIndex : 0;
       auto rightStartIndex =
-          (l == firstLeftBatch && i == leftStart && rightMatch_->cursor)
-          ? rightMatch_->cursor->index
-          : rightMatch_->startIndex;
+          resume ? rightMatch_->cursor->index : rightMatch_->startIndex;
 
-      auto numRights = rightMatch_->inputs.size();
+      if (numSpilledRights > 0 && firstRightBatch == 0) {
+        // When resuming, the read is positioned at the row that did not fit in
+        // the previous output batch.
+        if (!resume) {
+          startRightMatchSpillRead();
+        }
+        while (spilledRightBatch_ != nullptr) {
+          if (outputSize_ == outputBatchSize_) {
+            leftMatch_->setCursor(l, i);
+            rightMatch_->setCursor(0, spilledRightIndex_);
+            return true;
+          }
+          addOutputRow(left, i, spilledRightBatch_, spilledRightIndex_);
+          if (++spilledRightIndex_ == spilledRightBatch_->size()) {
+            nextRightMatchSpillBatch();
+          }
+        }
+        firstRightBatch = 1;
+        rightStartIndex = rightMatch_->startIndex;
+      }
+
+      auto numRights = rightMatch_->inputs.size() + numSpilledRights;
       for (size_t r = firstRightBatch; r < numRights; ++r) {
-        auto right = rightMatch_->inputs[r];
+        auto right = rightMatch_->inputs[r - numSpilledRights];
         auto rightStart = r == firstRightBatch ? rightStartIndex : 0;
         auto rightEnd =
             r == numRights - 1 ? rightMatch_->endIndex : right->size();
@@ -397,6 +539,9 @@ bool MergeJoin::addToOutput() {
 
   leftMatch_.reset();
   rightMatch_.reset();
+  rightMatchSpillFiles_.clear();
+  spillFileOpen_ = false;
+  spilledRightBatch_ = nullptr;
 
   return outputSize_ == outputBatchSize_;
 }
@@ -522,6 +667,9 @@ RowVectorPtr MergeJoin::doGetOutput() {
       if (!findEndOfMatch(rightMatch_.value(), rightInput_, rightKeys_)) {
         // Continue looking for the end of the match.
         rightInput_ = nullptr;
+        if (spillEnabled()) {
+          maybeTestSpill();
+        }
         return nullptr;
       }
       if (rightMatch_->inputs.back() == rightInput_) {
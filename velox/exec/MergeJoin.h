@@ -18,6 +18,7 @@
 
 #include "velox/exec/MergeSource.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/Spill.h"
 
 namespace facebook::velox::exec {
 class MergeJoin : public Operator {
@@ -39,14 +40,35 @@ class MergeJoin : public Operator {
 
   bool isFinished() override;
 
-  void close() override {
-    if (rightSource_) {
-      rightSource_->close();
-    }
-    Operator::close();
-  }
+  void close() override;
+
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
 
  private:
+  bool spillEnabled() const {
+    return spillConfig_.has_value();
+  }
+
+  // Spills the right-side match if the test-only spill percentage triggers.
+  void maybeTestSpill();
+
+  // Writes all but the last batch of an incomplete 'rightMatch_' to disk. The
+  // last batch stays in memory as the reference for finding the end of the
+  // match. May be called repeatedly while the match grows.
+  void spillRightMatch();
+
+  // Finishes writing the spilled rows of 'rightMatch_' once the match is
+  // complete and moves the spill files to 'rightMatchSpillFiles_'.
+  void finishRightMatchSpill();
+
+  // Positions the read of the spilled right-side rows at the first row.
+  void startRightMatchSpillRead();
+
+  // Loads the next non-empty batch of spilled right-side rows into
+  // 'spilledRightBatch_'. Sets it to nullptr at the end of the spilled rows.
+  void nextRightMatchSpillBatch();
+
   // Sets up 'filter_' and related member variables.
   void initializeFilter(
       const core::TypedExprPtr& filter,
@@ -156,7 +178,10 @@ class MergeJoin : public Operator {
   void prepareOutput();
 
   // Appends a cartesian product of the current set of matching rows, leftMatch_
-  // x rightMatch_, to output_. Returns true if output_ is full. Sets
+  // x rightMatch_, to output_. If the leading rows of rightMatch_ were spilled,
+  // these are re-read for each left-side row before the batches still in
+  // rightMatch_ and 'cursor->batchIndex' 0 refers to the spilled rows. Returns
+  // true if output_ is full. Sets
   // leftMatchCursor_ and rightMatchCursor_ if output_ filled up before all the
   // rows were added. Fills up output starting from leftMatchCursor_ and
   // rightMatchCursor_ positions if these are set. Clears leftMatch_ and
@@ -408,5 +433,25 @@ class MergeJoin : public Operator {
 
   // True if all the right side data has been received.
   bool noMoreRightInput_{false};
+
+  // Counts input batches for the test-only spill trigger.
+  uint32_t spillTestCounter_{0};
+
+  folly::Synchronized<SpillStats> spillStats_;
+
+  // Spilled leading rows of 'rightMatch_' while the match is being collected.
+  std::unique_ptr<SpillState> rightMatchSpillState_;
+
+  // Spill files with the leading rows of a complete 'rightMatch_'. Empty if the
+  // match has not been spilled.
+  SpillFiles rightMatchSpillFiles_;
+
+  // Read position in 'rightMatchSpillFiles_'. 'spilledRightBatch_' is the
+  // current batch of spilled rows and 'spilledRightIndex_' the current row in
+  // it.
+  size_t spillFileIndex_{0};
+  bool spillFileOpen_{false};
+  RowVectorPtr spilledRightBatch_;
+  vector_size_t spilledRightIndex_{0};
 };
 } // namespace facebook::velox::exec
@@ -148,6 +148,15 @@ class MergeExchangeSource : public MergeSource {
         return BlockingReason::kWaitForProducer;
       }
     }
+    if (auto vector = currentPage_->vector()) {
+      // A page handed over in process by a producer in the same process.
+      auto lockedStats = mergeExchange_->stats().wlock();
+      lockedStats->rawInputBytes += currentPage_->size();
+      lockedStats->addInputVector(vector->estimateFlatSize(), vector->size());
+      data = vector;
+      currentPage_ = nullptr;
+      return BlockingReason::kNotBlocked;
+    }
     if (!inputStream_) {
       inputStream_ = std::make_unique<ByteStream>();
       mergeExchange_->stats().wlock()->rawInputBytes += currentPage_->size();
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/NestedLoopJoinProbe.h"
+#include <folly/container/F14Map.h>
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/Task.h"
 #include "velox/expression/FieldReference.h"
@@ -42,6 +43,31 @@ std::vector<IdentityProjection> extractProjections(
   }
   return projections;
 }
+
+// Returns the channel in 'type' of a top-level column referenced by 'expr'.
+std::optional<column_index_t> inputChannel(
+    const core::TypedExprPtr& expr,
+    const RowTypePtr& type) {
+  const auto* field =
+      dynamic_cast<const core::FieldAccessTypedExpr*>(expr.get());
+  if (field == nullptr || !field->isInputColumn()) {
+    return std::nullopt;
+  }
+  return type->getChildIdxIfExists(field->name());
+}
+
+void flattenConjuncts(
+    const core::TypedExprPtr& expr,
+    std::vector<core::TypedExprPtr>& conjuncts) {
+  const auto* call = dynamic_cast<const core::CallTypedExpr*>(expr.get());
+  if (call != nullptr && call->name() == "and") {
+    for (const auto& input : call->inputs()) {
+      flattenConjuncts(input, conjuncts);
+    }
+    return;
+  }
+  conjuncts.push_back(expr);
+}
 } // namespace
 
 NestedLoopJoinProbe::NestedLoopJoinProbe(
@@ -55,18 +81,96 @@ NestedLoopJoinProbe::NestedLoopJoinProbe(
           joinNode->id(),
           "NestedLoopJoinProbe"),
       outputBatchSize_{outputBatchRows()},
-      joinType_(joinNode->joinType()) {
+      joinType_(joinNode->joinType()),
+      joinNode_(joinNode) {
   auto probeType = joinNode->sources()[0]->outputType();
   auto buildType = joinNode->sources()[1]->outputType();
   identityProjections_ = extractProjections(probeType, outputType_);
   buildProjections_ = extractProjections(buildType, outputType_);
+}
+
+void NestedLoopJoinProbe::initialize() {
+  Operator::initialize();
+
+  VELOX_CHECK_NOT_NULL(joinNode_);
+  if (joinNode_->joinCondition() != nullptr) {
+    const auto& probeType = joinNode_->sources()[0]->outputType();
+    const auto& buildType = joinNode_->sources()[1]->outputType();
+    initializeFilter(joinNode_->joinCondition(), probeType, buildType);
+    bandJoinBounds_ =
+        extractBandJoinBounds(joinNode_->joinCondition(), probeType, buildType);
+  }
+  joinNode_.reset();
+}
+
+// static
+std::optional<NestedLoopJoinProbe::BandJoinBounds>
+NestedLoopJoinProbe::extractBandJoinBounds(
+    const core::TypedExprPtr& filter,
+    const RowTypePtr& probeType,
+    const RowTypePtr& buildType) {
+  auto isBound = [&](column_index_t probeChannel, column_index_t buildChannel) {
+    const auto& type = probeType->childAt(probeChannel);
+    return type->isOrderable() &&
+        type->equivalent(*buildType->childAt(buildChannel));
+  };
+
+  std::vector<core::TypedExprPtr> conjuncts;
+  flattenConjuncts(filter, conjuncts);
+
+  // Lower and upper bounds found for each probe side column.
+  folly::F14FastMap<column_index_t, column_index_t> lowerBounds;
+  folly::F14FastMap<column_index_t, column_index_t> upperBounds;
+  for (const auto& conjunct : conjuncts) {
+    const auto* call = dynamic_cast<const core::CallTypedExpr*>(conjunct.get());
+    if (call == nullptr) {
+      continue;
+    }
+    const auto& inputs = call->inputs();
+    if (call->name() == "between" && inputs.size() == 3) {
+      const auto probe = inputChannel(inputs[0], probeType);
+      const auto lower = inputChannel(inputs[1], buildType);
+      const auto upper = inputChannel(inputs[2], buildType);
+      if (probe.has_value() && lower.has_value() && upper.has_value() &&
+          isBound(probe.value(), lower.value()) &&
+          isBound(probe.value(), upper.value())) {
+        return BandJoinBounds{probe.value(), lower.value(), upper.value()};
+      }
+      continue;
+    }
+
+    const auto& name = call->name();
+    if (inputs.size() != 2 ||
+        (name != "gt" && name != "gte" && name != "lt" && name != "lte")) {
+      continue;
+    }
+    // Normalizes the comparison to 'probe <op> build'.
+    bool probeIsGreater = name == "gt" || name == "gte";
+    auto probe = inputChannel(inputs[0], probeType);
+    auto build = inputChannel(inputs[1], buildType);
+    if (!probe.has_value() || !build.has_value()) {
+      probe = inputChannel(inputs[1], probeType);
+      build = inputChannel(inputs[0], buildType);
+      probeIsGreater = !probeIsGreater;
+    }
+    if (!probe.has_value() || !build.has_value() ||
+        !isBound(probe.value(), build.value())) {
+      continue;
+    }
+    if (probeIsGreater) {
+      lowerBounds.emplace(probe.value(), build.value());
+    } else {
+      upperBounds.emplace(probe.value(), build.value());
+    }
+  }
 
-  if (joinNode->joinCondition() != nullptr) {
-    initializeFilter(
-        joinNode->joinCondition(),
-        joinNode->sources()[0]->outputType(),
-        joinNode->sources()[1]->outputType());
+  for (const auto& [probe, lower] : lowerBounds) {
+    auto it = upperBounds.find(probe);
+    if (it != upperBounds.end()) {
+      return BandJoinBounds{probe, lower, it->second};
+    }
   }
+  return std::nullopt;
 }
 
 BlockingReason NestedLoopJoinProbe::isBlocked(ContinueFuture* future) {
@@ -89,6 +193,10 @@ BlockingReason NestedLoopJoinProbe::isBlocked(ContinueFuture* future) {
       }
       VELOX_CHECK(buildVectors_.has_value());
 
+      if (bandJoinBounds_.has_value()) {
+        bandIndices_.resize(buildVectors_->size());
+      }
+
       if (needsBuildMismatch(joinType_)) {
         buildMatched_.resize(buildVectors_->size());
         for (auto i = 0; i < buildVectors_->size(); ++i) {
@@ -109,6 +217,7 @@ void NestedLoopJoinProbe::close() {
     joinCondition_->clear();
   }
   buildVectors_.reset();
+  bandIndices_.clear();
   Operator::close();
 }
 
@@ -170,7 +279,9 @@ RowVectorPtr NestedLoopJoinProbe::getOutput() {
       break;
     }
 
-    const vector_size_t probeCnt = getNumProbeRows();
+    const vector_size_t probeCnt = bandJoinBounds_.has_value()
+        ? getNumBandProbeRows()
+        : getNumProbeRows();
     output = doMatch(probeCnt);
     if (advanceProbeRows(probeCnt)) {
       if (!needsProbeMismatch(joinType_)) {
@@ -347,6 +458,129 @@ vector_size_t NestedLoopJoinProbe::getNumProbeRows() const {
   return numProbeRows;
 }
 
+const NestedLoopJoinProbe::BandIndex& NestedLoopJoinProbe::bandIndex() {
+  auto& index = bandIndices_[buildIndex_];
+  if (index.has_value()) {
+    return index.value();
+  }
+
+  const auto& build = buildVectors_.value()[buildIndex_];
+  const auto* lower = build->childAt(bandJoinBounds_->lowerChannel).get();
+  const auto* upper = build->childAt(bandJoinBounds_->upperChannel).get();
+
+  // Rows with a null bound do not satisfy the band condition.
+  index.emplace();
+  auto& sortedRows = index->sortedRows;
+  sortedRows.reserve(build->size());
+  for (auto row = 0; row < build->size(); ++row) {
+    if (!lower->isNullAt(row) && !upper->isNullAt(row)) {
+      sortedRows.push_back(row);
+    }
+  }
+  std::sort(
+      sortedRows.begin(),
+      sortedRows.end(),
+      [&](vector_size_t left, vector_size_t right) {
+        return lower->compare(lower, left, right) < 0;
+      });
+
+  auto& maxUpperRows = index->maxUpperRows;
+  maxUpperRows.reserve(sortedRows.size());
+  for (auto row : sortedRows) {
+    if (maxUpperRows.empty() ||
+        upper->compare(upper, row, maxUpperRows.back()) > 0) {
+      maxUpperRows.push_back(row);
+    } else {
+      maxUpperRows.push_back(maxUpperRows.back());
+    }
+  }
+  return index.value();
+}
+
+vector_size_t NestedLoopJoinProbe::getNumBandProbeRows() {
+  VELOX_CHECK_NOT_NULL(input_);
+  VELOX_CHECK(!hasProbedAllBuildData());
+
+  const auto& index = bandIndex();
+  const auto& build = buildVectors_.value()[buildIndex_];
+  const auto* lower = build->childAt(bandJoinBounds_->lowerChannel).get();
+  const auto* upper = build->childAt(bandJoinBounds_->upperChannel).get();
+  const auto* probe = input_->childAt(bandJoinBounds_->probeChannel).get();
+
+  bandRanges_.clear();
+  vector_size_t numCandidates{0};
+  auto row = probeRow_;
+  while (row < input_->size() && numCandidates < outputBatchSize_) {
+    vector_size_t begin{0};
+    vector_size_t end{0};
+    if (!probe->isNullAt(row)) {
+      // The build rows past 'end' have a lower bound greater than the probe
+      // value and the build rows before 'begin' have an upper bound less than
+      // the probe value.
+      end = std::upper_bound(
+                index.sortedRows.begin(),
+                index.sortedRows.end(),
+                row,
+                [&](vector_size_t probeRow, vector_size_t buildRow) {
+                  return probe->compare(lower, probeRow, buildRow) < 0;
+                }) -
+          index.sortedRows.begin();
+      begin = std::lower_bound(
+                  index.maxUpperRows.begin(),
+                  index.maxUpperRows.begin() + end,
+                  row,
+                  [&](vector_size_t buildRow, vector_size_t probeRow) {
+                    return upper->compare(probe, buildRow, probeRow) < 0;
+                  }) -
+          index.maxUpperRows.begin();
+    }
+    bandRanges_.emplace_back(begin, end);
+    numCandidates += end - begin;
+    ++row;
+  }
+  return row - probeRow_;
+}
+
+RowVectorPtr NestedLoopJoinProbe::getBandCandidates(vector_size_t probeCnt) {
+  VELOX_CHECK_EQ(probeCnt, bandRanges_.size());
+  // The build indices cached by getCrossProduct() are overwritten below.
+  numPrevProbedRows_ = 0;
+
+  vector_size_t numCandidates{0};
+  for (const auto& [begin, end] : bandRanges_) {
+    numCandidates += end - begin;
+  }
+  if (numCandidates == 0) {
+    return nullptr;
+  }
+
+  const auto& sortedRows = bandIndices_[buildIndex_]->sortedRows;
+  auto rawProbeIndices =
+      initializeRowNumberMapping(probeIndices_, numCandidates, pool());
+  auto rawBuildIndices =
+      initializeRowNumberMapping(buildIndices_, numCandidates, pool());
+  vector_size_t numRows{0};
+  for (auto i = 0; i < probeCnt; ++i) {
+    for (auto j = bandRanges_[i].first; j < bandRanges_[i].second; ++j) {
+      rawProbeIndices[numRows] = probeRow_ + i;
+      rawBuildIndices[numRows] = sortedRows[j];
+      ++numRows;
+    }
+  }
+
+  auto output =
+      BaseVector::create<RowVector>(filterInputType_, numCandidates, pool());
+  projectChildren(
+      output, input_, filterProbeProjections_, numCandidates, probeIndices_);
+  projectChildren(
+      output,
+      buildVectors_.value()[buildIndex_],
+      filterBuildProjections_,
+      numCandidates,
+      buildIndices_);
+  return output;
+}
+
 RowVectorPtr NestedLoopJoinProbe::getCrossProduct(
     vector_size_t probeCnt,
     const RowTypePtr& outputType,
@@ -416,11 +650,16 @@ RowVectorPtr NestedLoopJoinProbe::doMatch(vector_size_t probeCnt) {
         probeCnt, outputType_, identityProjections_, buildProjections_);
   }
 
-  auto filterInput = getCrossProduct(
-      probeCnt,
-      filterInputType_,
-      filterProbeProjections_,
-      filterBuildProjections_);
+  auto filterInput = bandJoinBounds_.has_value()
+      ? getBandCandidates(probeCnt)
+      : getCrossProduct(
+            probeCnt,
+            filterInputType_,
+            filterProbeProjections_,
+            filterBuildProjections_);
+  if (filterInput == nullptr) {
+    return nullptr;
+  }
 
   if (filterInputRows_.size() != filterInput->size()) {
     filterInputRows_.resizeFill(filterInput->size(), true);
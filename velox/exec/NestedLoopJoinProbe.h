@@ -27,6 +27,8 @@ class NestedLoopJoinProbe : public Operator {
       DriverCtx* driverCtx,
       const std::shared_ptr<const core::NestedLoopJoinNode>& joinNode);
 
+  void initialize() override;
+
   void addInput(RowVectorPtr input) override;
 
   RowVectorPtr getOutput() override;
@@ -54,6 +56,51 @@ class NestedLoopJoinProbe : public Operator {
       const RowTypePtr& leftType,
       const RowTypePtr& rightType);
 
+  // Bounds of a band join condition 'probe BETWEEN lower AND upper', which may
+  // also be written as a conjunction of comparisons. 'probeChannel' is a probe
+  // side column, 'lowerChannel' and 'upperChannel' are build side columns of
+  // the same type.
+  struct BandJoinBounds {
+    column_index_t probeChannel;
+    column_index_t lowerChannel;
+    column_index_t upperChannel;
+  };
+
+  // Returns the bounds of a band join if one of the conjuncts of 'filter', or
+  // a pair of them, restricts a probe side column to a range given by two build
+  // side columns.
+  static std::optional<BandJoinBounds> extractBandJoinBounds(
+      const core::TypedExprPtr& filter,
+      const RowTypePtr& probeType,
+      const RowTypePtr& buildType);
+
+  // Rows of a build side vector sorted on the lower bound of the band join.
+  struct BandIndex {
+    // Rows with non-null bounds in ascending order of the lower bound.
+    std::vector<vector_size_t> sortedRows;
+
+    // For each position in 'sortedRows', the row with the largest upper bound
+    // in 'sortedRows' up to and including that position. The upper bounds of
+    // these rows are non-decreasing.
+    std::vector<vector_size_t> maxUpperRows;
+  };
+
+  // Returns the band index of the build side vector at 'buildIndex_'. Builds
+  // the index on first use.
+  const BandIndex& bandIndex();
+
+  // Band join counterpart of getNumProbeRows(). Finds the candidate build rows
+  // for the probe rows starting at 'probeRow_' and stops after the first probe
+  // row at which the number of candidates reaches the output batch size. The
+  // candidates of each probe row are recorded in 'bandRanges_'.
+  vector_size_t getNumBandProbeRows();
+
+  // Returns the filter input for the candidate pairs of the next 'probeCnt'
+  // probe rows and the build side vector at 'buildIndex_'. Sets
+  // 'probeIndices_' and 'buildIndices_' like getCrossProduct(). Returns
+  // nullptr if there are no candidates.
+  RowVectorPtr getBandCandidates(vector_size_t probeCnt);
+
   bool getBuildData(ContinueFuture* future);
 
   // Calculates the number of probe rows to match with the build side vectors
@@ -123,11 +170,24 @@ class NestedLoopJoinProbe : public Operator {
   const uint32_t outputBatchSize_;
   const core::JoinType joinType_;
 
+  // Join node for initialize(). Reset after initialization.
+  std::shared_ptr<const core::NestedLoopJoinNode> joinNode_;
+
   ProbeOperatorState state_{ProbeOperatorState::kWaitForBuild};
   ContinueFuture future_{ContinueFuture::makeEmpty()};
 
   // Join condition-related state
   std::unique_ptr<ExprSet> joinCondition_;
+  // Set if the join condition restricts a probe column to a range of build
+  // columns. The join condition is then evaluated only on the pairs of rows
+  // that may satisfy the range, found by binary search in 'bandIndices_'.
+  std::optional<BandJoinBounds> bandJoinBounds_;
+  // One per build side vector.
+  std::vector<std::optional<BandIndex>> bandIndices_;
+  // [begin, end) positions in the BandIndex of the build side vector at
+  // 'buildIndex_' with the candidate rows for each probe row starting at
+  // 'probeRow_'.
+  std::vector<std::pair<vector_size_t, vector_size_t>> bandRanges_;
   RowTypePtr filterInputType_;
   SelectivityVector filterInputRows_;
 
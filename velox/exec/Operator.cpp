@@ -16,6 +16,7 @@
 #include "velox/exec/Operator.h"
 #include "velox/common/base/SuccinctPrinter.h"
 #include "velox/common/testutil/TestValue.h"
+#include "velox/common/time/Timer.h"
 #include "velox/exec/Driver.h"
 #include "velox/exec/HashJoinBridge.h"
 #include "velox/exec/OperatorUtils.h"
@@ -99,6 +100,38 @@ void Operator::maybeSetReclaimer() {
       Operator::MemoryReclaimer::create(operatorCtx_->driverCtx(), this));
 }
 
+ContinueFuture Operator::maybeReserveAsync(
+    uint64_t bytes,
+    const std::shared_ptr<std::atomic_bool>& reserved) {
+  auto* executor = operatorCtx_->task()->queryCtx()->arbitrationExecutor();
+  if (executor == nullptr) {
+    return ContinueFuture::makeEmpty();
+  }
+  *reserved = false;
+  auto [promise, future] = makeVeloxContinuePromiseContract(
+      fmt::format("Operator::maybeReserveAsync {}", pool()->name()));
+  executor->add([pool = pool()->shared_from_this(),
+                 bytes,
+                 reserved,
+                 promise = std::move(promise)]() mutable {
+    try {
+      *reserved = pool->maybeReserve(bytes);
+    } catch (const std::exception& e) {
+      // The query is aborted or fails on memory arbitration. We leave the
+      // error to be raised on the next allocation from the driver thread.
+      LOG(WARNING) << "Failed to reserve " << succinctBytes(bytes) << " in "
+                   << pool->name() << ": " << e.what();
+    }
+    // Releases the reservation if the operator has gone while waiting.
+    if (*reserved && reserved.use_count() == 1) {
+      pool->release();
+      *reserved = false;
+    }
+    promise.setValue();
+  });
+  return std::move(future);
+}
+
 std::vector<std::unique_ptr<Operator::PlanNodeTranslator>>&
 Operator::translators() {
   static std::vector<std::unique_ptr<PlanNodeTranslator>> translators;
@@ -239,28 +272,41 @@ OperatorStats Operator::stats(bool clear) {
   return ret;
 }
 
-uint32_t Operator::outputBatchRows(
-    std::optional<uint64_t> averageRowSize) const {
+uint32_t Operator::outputBatchRows(std::optional<uint64_t> averageRowSize) {
   const auto& queryConfig = operatorCtx_->task()->queryCtx()->queryConfig();
+  const bool adaptive = queryConfig.adaptiveOutputBatchRows();
+  if (adaptive && !averageRowSize.has_value()) {
+    auto lockedStats = stats_.rlock();
+    if (lockedStats->outputPositions > 0) {
+      averageRowSize = lockedStats->outputBytes / lockedStats->outputPositions;
+    }
+  }
 
+  uint32_t numRows;
   if (!averageRowSize.has_value()) {
-    return queryConfig.preferredOutputBatchRows();
+    numRows = queryConfig.preferredOutputBatchRows();
+  } else {
+    const uint64_t rowSize = averageRowSize.value();
+    VELOX_CHECK_GE(
+        rowSize,
+        0,
+        "The given average row size of {}.{} is negative.",
+        operatorType(),
+        operatorId());
+
+    if (rowSize * queryConfig.maxOutputBatchRows() <
+        queryConfig.preferredOutputBatchBytes()) {
+      numRows = queryConfig.maxOutputBatchRows();
+    } else {
+      numRows = std::max<uint32_t>(
+          queryConfig.preferredOutputBatchBytes() / rowSize, 1);
+    }
   }
 
-  const uint64_t rowSize = averageRowSize.value();
-  VELOX_CHECK_GE(
-      rowSize,
-      0,
-      "The given average row size of {}.{} is negative.",
-      operatorType(),
-      operatorId());
-
-  if (rowSize * queryConfig.maxOutputBatchRows() <
-      queryConfig.preferredOutputBatchBytes()) {
-    return queryConfig.maxOutputBatchRows();
+  if (adaptive) {
+    stats_.wlock()->addRuntimeStat(kOutputBatchRows, RuntimeCounter(numRows));
   }
-  return std::max<uint32_t>(
-      queryConfig.preferredOutputBatchBytes() / rowSize, 1);
+  return numRows;
 }
 
 void Operator::recordBlockingTime(uint64_t start, BlockingReason reason) {
@@ -280,6 +326,24 @@ void Operator::recordBlockingTime(uint64_t start, BlockingReason reason) {
       fmt::format("blocked{}Times", blockReason), RuntimeCounter(1));
 }
 
+void Operator::recordVectorPoolStats() {
+  const auto* vectorPool = operatorCtx_->vectorPool();
+  if (vectorPool == nullptr) {
+    return;
+  }
+  const auto vectorPoolStats = vectorPool->stats();
+  if (vectorPoolStats.numHits == 0 && vectorPoolStats.numMisses == 0) {
+    return;
+  }
+  auto lockedStats = stats_.wlock();
+  lockedStats->addRuntimeStat(
+      "vectorPoolHits",
+      RuntimeCounter{static_cast<int64_t>(vectorPoolStats.numHits)});
+  lockedStats->addRuntimeStat(
+      "vectorPoolMisses",
+      RuntimeCounter{static_cast<int64_t>(vectorPoolStats.numMisses)});
+}
+
 void Operator::recordSpillStats(const SpillStats& spillStats) {
   VELOX_CHECK(noMoreInput_);
   auto lockedStats = stats_.wlock();
@@ -576,8 +640,16 @@ uint64_t Operator::MemoryReclaimer::reclaim(
   TestValue::adjust(
       "facebook::velox::exec::Operator::MemoryReclaimer::reclaim", pool);
 
+  const auto startMicros = getCurrentTimeMicro();
   op_->reclaim(targetBytes, stats);
-  return pool->shrink(targetBytes);
+  const auto reclaimedBytes = pool->shrink(targetBytes);
+  driver->recordTrace(
+      "reclaim",
+      fmt::format(
+          "{} {}", op_->operatorType(), succinctBytes(reclaimedBytes)),
+      startMicros,
+      getCurrentTimeMicro() - startMicros);
+  return reclaimedBytes;
 }
 
 void Operator::MemoryReclaimer::abort(
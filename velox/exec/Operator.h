@@ -227,6 +227,12 @@ class OperatorCtx {
 
   core::ExecCtx* execCtx() const;
 
+  /// Returns the vector pool of the ExecCtx or null if the ExecCtx has not been
+  /// created or has no vector pool.
+  VectorPool* vectorPool() const {
+    return execCtx_ ? execCtx_->vectorPool() : nullptr;
+  }
+
   /// Makes an extract of QueryCtx for use in a connector. 'planNodeId'
   /// is the id of the calling TableScan. This and the task id identify the scan
   /// for column access tracking. 'connectorPool' is an aggregate memory pool
@@ -319,6 +325,10 @@ class Operator : public BaseRuntimeStatWriter {
 
   /// Does initialization work for this operator which requires memory
   /// allocation from memory pool that can't be done under operator constructor.
+  /// Costly setup such as compiling expressions or creating hash tables also
+  /// belongs here. Task::start() constructs the operators of all drivers on
+  /// one thread, while initialize() runs on the driver's own thread when the
+  /// driver first runs.
   ///
   /// NOTE: the default implementation set 'initialized_' to true to ensure we
   /// never call this more than once.
@@ -411,6 +421,7 @@ class Operator : public BaseRuntimeStatWriter {
   virtual void close() {
     input_ = nullptr;
     results_.clear();
+    recordVectorPoolStats();
     // Release the unused memory reservation on close.
     operatorCtx_->pool()->release();
   }
@@ -623,6 +634,18 @@ class Operator : public BaseRuntimeStatWriter {
     return spillConfig_.has_value();
   }
 
+  /// Reserves 'bytes' of memory in this operator's memory pool on the query's
+  /// arbitration executor so that the memory arbitration triggered by the
+  /// reservation doesn't hold the driver thread. Returns a future which is
+  /// fulfilled after the reservation completes with its outcome set in
+  /// 'reserved'. The operator is expected to return the future from
+  /// isBlocked() with BlockingReason::kWaitForMemory. Returns an invalid future
+  /// if the query has no arbitration executor, and the caller shall reserve
+  /// synchronously through MemoryPool::maybeReserve() instead.
+  ContinueFuture maybeReserveAsync(
+      uint64_t bytes,
+      const std::shared_ptr<std::atomic_bool>& reserved);
+
   /// Creates output vector from 'input_' and 'results_' according to
   /// 'identityProjections_' and 'resultProjections_'. If 'mapping' is set to
   /// nullptr, the children of the output vector will be identical to their
@@ -636,13 +659,23 @@ class Operator : public BaseRuntimeStatWriter {
   /// number of rows at 10K and returns at least one row. The averageRowSize
   /// must not be negative. If the averageRowSize is 0 which is not advised,
   /// returns maxOutputBatchRows. If the averageRowSize is not given, returns
-  /// preferredOutputBatchRows.
+  /// preferredOutputBatchRows, unless QueryConfig::kAdaptiveOutputBatchRows is
+  /// set and 'this' has produced output, in which case the average size of
+  /// the output rows so far is used as averageRowSize.
   uint32_t outputBatchRows(
-      std::optional<uint64_t> averageRowSize = std::nullopt) const;
+      std::optional<uint64_t> averageRowSize = std::nullopt);
+
+  /// Runtime stat with the batch sizes picked by outputBatchRows() when
+  /// QueryConfig::kAdaptiveOutputBatchRows is set.
+  static inline const std::string kOutputBatchRows = "outputBatchRows";
 
   /// Invoked to record spill stats in operator stats.
   void recordSpillStats(const SpillStats& spillStats);
 
+  /// Invoked on close to record the hit and miss counts of the vector pool in
+  /// operator stats.
+  void recordVectorPoolStats();
+
   const std::unique_ptr<OperatorCtx> operatorCtx_;
   const RowTypePtr outputType_;
   /// Contains the disk spilling related configs if spilling is enabled (e.g.
@@ -28,6 +28,12 @@ CompareFlags fromSortOrderToCompareFlags(const core::SortOrder& sortOrder) {
       false,
       CompareFlags::NullHandlingMode::NoStop};
 }
+
+bool isParallelOrderBy(
+    const core::OrderByNode& orderByNode,
+    const core::QueryConfig& queryConfig) {
+  return !orderByNode.isPartial() && queryConfig.parallelOrderByEnabled();
+}
 } // namespace
 
 OrderBy::OrderBy(
@@ -40,9 +46,11 @@ OrderBy::OrderBy(
           operatorId,
           orderByNode->id(),
           "OrderBy",
-          orderByNode->canSpill(driverCtx->queryConfig())
+          orderByNode->canSpill(driverCtx->queryConfig()) &&
+                  !isParallelOrderBy(*orderByNode, driverCtx->queryConfig())
               ? driverCtx->makeSpillConfig(operatorId)
-              : std::nullopt) {
+              : std::nullopt),
+      parallel_(isParallelOrderBy(*orderByNode, driverCtx->queryConfig())) {
   VELOX_CHECK(pool()->trackUsage());
   std::vector<column_index_t> sortColumnIndices;
   std::vector<CompareFlags> sortCompareFlags;
@@ -105,10 +113,65 @@ void OrderBy::noMoreInput() {
   sortBuffer_->noMoreInput();
 
   recordSpillStats();
+  if (parallel_) {
+    finishParallelInput();
+  }
+}
+
+void OrderBy::finishParallelInput() {
+  std::vector<ContinuePromise> promises;
+  std::vector<std::shared_ptr<Driver>> peers;
+  // Each driver has sorted its own input. The last driver to finish input
+  // takes over the sort buffers of all peers and merges them into its own.
+  // The other drivers wait in isBlocked() and finish without output.
+  if (!operatorCtx_->task()->allPeersFinished(
+          planNodeId(), operatorCtx_->driver(), &future_, promises, peers)) {
+    return;
+  }
+
+  auto promisesGuard = folly::makeGuard([&]() {
+    // Realize the promises so that the other Drivers (which were not
+    // the last to finish) can continue from the barrier and finish.
+    peers.clear();
+    for (auto& promise : promises) {
+      promise.setValue();
+    }
+  });
+
+  std::vector<std::unique_ptr<SortBuffer>> peerSortBuffers;
+  peerSortBuffers.reserve(peers.size());
+  for (auto& peer : peers) {
+    auto* orderBy = dynamic_cast<OrderBy*>(peer->findOperator(planNodeId()));
+    VELOX_CHECK_NOT_NULL(orderBy);
+    VELOX_CHECK_NOT_NULL(orderBy->sortBuffer_);
+    peerSortBuffers.push_back(std::move(orderBy->sortBuffer_));
+  }
+  {
+    auto lockedStats = stats_.wlock();
+    lockedStats->runtimeStats["mergedSortRuns"] =
+        RuntimeMetric(peerSortBuffers.size() + 1);
+  }
+  sortBuffer_->merge(std::move(peerSortBuffers));
+}
+
+BlockingReason OrderBy::isBlocked(ContinueFuture* future) {
+  if (future_.valid()) {
+    VELOX_CHECK(parallel_);
+    *future = std::move(future_);
+    return BlockingReason::kWaitForProducer;
+  }
+  return BlockingReason::kNotBlocked;
 }
 
 RowVectorPtr OrderBy::getOutput() {
-  if (finished_ || !noMoreInput_) {
+  if (finished_ || !noMoreInput_ || future_.valid()) {
+    return nullptr;
+  }
+  if (sortBuffer_ == nullptr) {
+    // The sort buffer of a parallel order by has been merged into the sort
+    // buffer of the last peer to finish, which produces the output.
+    VELOX_CHECK(parallel_);
+    finished_ = true;
     return nullptr;
   }
 
@@ -49,9 +49,7 @@ class OrderBy : public Operator {
 
   RowVectorPtr getOutput() override;
 
-  BlockingReason isBlocked(ContinueFuture* FOLLY_NULLABLE /*future*/) override {
-    return BlockingReason::kNotBlocked;
-  }
+  BlockingReason isBlocked(ContinueFuture* FOLLY_NULLABLE future) override;
 
   bool isFinished() override {
     return finished_;
@@ -67,7 +65,18 @@ class OrderBy : public Operator {
   // the inputs.
   void recordSpillStats();
 
+  // Waits for all peers of a parallel order by to finish input. The last peer
+  // to finish merges the sorted rows of all peers and produces the output.
+  void finishParallelInput();
+
+  // True if this is a final order by running on multiple drivers that merge
+  // their sorted rows. See QueryConfig::kParallelOrderByEnabled.
+  const bool parallel_;
+
   std::unique_ptr<SortBuffer> sortBuffer_;
   bool finished_ = false;
+
+  // Set while a parallel order by waits for its peers to finish input.
+  ContinueFuture future_{ContinueFuture::makeEmpty()};
 };
 } // namespace facebook::velox::exec
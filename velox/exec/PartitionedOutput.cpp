@@ -20,6 +20,22 @@
 
 namespace facebook::velox::exec {
 
+namespace {
+// Returns the target size of the serialized pages to each destination.
+uint64_t maxPageSize(uint64_t maxBufferedBytes, int numDestinations) {
+  // Limit serialized pages to 1MB.
+  static const uint64_t kMaxPageSize = 1 << 20;
+  return std::max<uint64_t>(
+      PartitionedOutput::kMinDestinationSize,
+      std::min<uint64_t>(kMaxPageSize, maxBufferedBytes / numDestinations));
+}
+
+bool useCompactBuffers(const core::QueryConfig& config, int numDestinations) {
+  const auto minDestinations = config.partitionedOutputCompactMinDestinations();
+  return minDestinations > 0 && numDestinations >= minDestinations;
+}
+} // namespace
+
 namespace detail {
 BlockingReason Destination::advance(
     uint64_t maxBytes,
@@ -65,6 +81,10 @@ void Destination::serialize(
     const RowVectorPtr& output,
     vector_size_t begin,
     vector_size_t end) {
+  if (vectorPages_) {
+    appendToVector(output, folly::Range(&ranges_[begin], end - begin));
+    return;
+  }
   if (!current_) {
     current_ = std::make_unique<VectorStreamGroup>(pool_);
     auto rowType = asRowType(output->type());
@@ -72,39 +92,121 @@ void Destination::serialize(
     for (vector_size_t i = begin; i < end; i++) {
       numRows += ranges_[i].size;
     }
-    current_->createStreamTree(rowType, numRows);
+    current_->createStreamTree(rowType, numRows, serdeOptions_.get());
   }
   current_->append(output, folly::Range(&ranges_[begin], end - begin));
 }
 
+void Destination::appendToVector(
+    const RowVectorPtr& input,
+    folly::Range<const IndexRange*> ranges) {
+  if (!currentVector_) {
+    currentVector_ = BaseVector::create<RowVector>(input->type(), 0, pool_);
+  }
+  std::vector<BaseVector::CopyRange> copyRanges;
+  copyRanges.reserve(ranges.size());
+  vector_size_t numRows = currentVector_->size();
+  for (const auto& range : ranges) {
+    copyRanges.push_back({range.begin, numRows, range.size});
+    numRows += range.size;
+  }
+  currentVector_->resize(numRows);
+  currentVector_->copyRanges(input.get(), copyRanges);
+}
+
 BlockingReason Destination::flush(
     PartitionedOutputBufferManager& bufferManager,
     const std::function<void()>& bufferReleaseFn,
     ContinueFuture* future) {
+  if (currentVector_) {
+    auto vector = std::move(currentVector_);
+    bytesInCurrent_ = 0;
+    setTargetSizePct();
+    const auto bytes = vector->retainedSize();
+    const bool blocked = bufferManager.enqueue(
+        taskId_,
+        destination_,
+        std::make_unique<SerializedPage>(
+            std::move(vector), bytes, bufferReleaseFn),
+        future);
+    return blocked ? BlockingReason::kWaitForConsumer
+                   : BlockingReason::kNotBlocked;
+  }
   if (!current_) {
     return BlockingReason::kNotBlocked;
   }
 
-  // Upper limit of message size with no columns.
-  constexpr int32_t kMinMessageSize = 128;
   auto listener = bufferManager.newListener();
-  IOBufOutputStream stream(
-      *current_->pool(),
-      listener.get(),
-      std::max<int64_t>(kMinMessageSize, current_->size()));
-  current_->flush(&stream);
-  current_.reset();
+  auto iobuf = VectorStreamGroup::flushToIOBuf(
+      std::move(current_), listener.get(), bufferReleaseFn);
   bytesInCurrent_ = 0;
   setTargetSizePct();
 
   bool blocked = bufferManager.enqueue(
       taskId_,
       destination_,
-      std::make_unique<SerializedPage>(stream.getIOBuf(bufferReleaseFn)),
+      std::make_unique<SerializedPage>(std::move(iobuf)),
       future);
   return blocked ? BlockingReason::kWaitForConsumer
                  : BlockingReason::kNotBlocked;
 }
+
+uint64_t Destination::bufferBatch(
+    int32_t batch,
+    const std::vector<vector_size_t>& sizes) {
+  uint64_t bytes = 0;
+  for (const auto& range : ranges_) {
+    for (vector_size_t i = 0; i < range.size; ++i) {
+      bytes += sizes[range.begin + i];
+    }
+  }
+  if (!ranges_.empty()) {
+    bufferedRanges_.insert(
+        bufferedRanges_.end(), ranges_.begin(), ranges_.end());
+    bufferedBatchEnds_.emplace_back(batch, bufferedRanges_.size());
+  }
+  beginBatch();
+  bytesInCurrent_ += bytes;
+  return bytes;
+}
+
+BlockingReason Destination::flushBuffered(
+    const std::vector<RowVectorPtr>& batches,
+    PartitionedOutputBufferManager& bufferManager,
+    const std::function<void()>& bufferReleaseFn,
+    ContinueFuture* future) {
+  if (bufferedBatchEnds_.empty()) {
+    return BlockingReason::kNotBlocked;
+  }
+  VELOX_CHECK_NULL(current_);
+  if (vectorPages_) {
+    size_t begin = 0;
+    for (const auto& [batch, end] : bufferedBatchEnds_) {
+      appendToVector(
+          batches[batch], folly::Range(&bufferedRanges_[begin], end - begin));
+      begin = end;
+    }
+    bufferedRanges_.clear();
+    bufferedBatchEnds_.clear();
+    return flush(bufferManager, bufferReleaseFn, future);
+  }
+  current_ = std::make_unique<VectorStreamGroup>(pool_);
+  vector_size_t numRows = 0;
+  for (const auto& range : bufferedRanges_) {
+    numRows += range.size;
+  }
+  current_->createStreamTree(
+      asRowType(batches[0]->type()), numRows, serdeOptions_.get());
+  size_t begin = 0;
+  for (const auto& [batch, end] : bufferedBatchEnds_) {
+    current_->append(
+        batches[batch], folly::Range(&bufferedRanges_[begin], end - begin));
+    begin = end;
+  }
+  bufferedRanges_.clear();
+  bufferedBatchEnds_.clear();
+  return flush(bufferManager, bufferReleaseFn, future);
+}
 } // namespace detail
 
 PartitionedOutput::PartitionedOutput(
@@ -136,7 +238,18 @@ PartitionedOutput::PartitionedOutput(
       bufferReleaseFn_([task = operatorCtx_->task()]() {}),
       maxBufferedBytes_(ctx->task->queryCtx()
                             ->queryConfig()
-                            .maxPartitionedOutputBufferSize()) {
+                            .maxPartitionedOutputBufferSize()),
+      compressionKind_(common::stringToCompressionKind(
+          ctx->task->queryCtx()->queryConfig().shuffleCompressionKind())),
+      vectorPages_(
+          ctx->task->queryCtx()->queryConfig().shuffleInProcessVectors()),
+      compactBuffers_(useCompactBuffers(
+          ctx->task->queryCtx()->queryConfig(),
+          numDestinations_)),
+      compactFlushBytes_(std::min<uint64_t>(
+          maxBufferedBytes_,
+          maxPageSize(maxBufferedBytes_, numDestinations_) *
+              numDestinations_)) {
   if (!planNode->isPartitioned()) {
     VELOX_USER_CHECK_EQ(numDestinations_, 1);
   }
@@ -178,7 +291,8 @@ void PartitionedOutput::initializeDestinations() {
     auto taskId = operatorCtx_->taskId();
     for (int i = 0; i < numDestinations_; ++i) {
       destinations_.push_back(
-          std::make_unique<detail::Destination>(taskId, i, pool()));
+          std::make_unique<detail::Destination>(
+              taskId, i, pool(), compressionKind_, vectorPages_));
     }
   }
 }
@@ -256,7 +370,7 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
           if (singlePartition.has_value()) {
             destinations_[singlePartition.value()]->addRow(i);
           } else {
-            destinations_[partitions_[i]]->addRow(i);
+            addRow(i);
           }
         }
       }
@@ -264,15 +378,68 @@ void PartitionedOutput::addInput(RowVectorPtr input) {
       if (singlePartition.has_value()) {
         destinations_[singlePartition.value()]->addRows(
             IndexRange{0, numInput});
+      } else if (compactBuffers_) {
+        scatterRows(numInput);
       } else {
         for (vector_size_t i = 0; i < numInput; ++i) {
-          destinations_[partitions_[i]]->addRow(i);
+          addRow(i);
         }
       }
     }
   }
 }
 
+void PartitionedOutput::addRow(vector_size_t row) {
+  const auto partition = partitions_[row];
+  if (partition == core::PartitionFunction::kAllPartitions) {
+    for (auto& destination : destinations_) {
+      destination->addRow(row);
+    }
+  } else {
+    destinations_[partition]->addRow(row);
+  }
+}
+
+void PartitionedOutput::scatterRows(vector_size_t numRows) {
+  // Counting sort of the row numbers by partition. Replicated rows go to all
+  // destinations directly.
+  partitionOffsets_.assign(numDestinations_ + 1, 0);
+  for (vector_size_t i = 0; i < numRows; ++i) {
+    const auto partition = partitions_[i];
+    if (partition == core::PartitionFunction::kAllPartitions) {
+      for (auto& destination : destinations_) {
+        destination->addRow(i);
+      }
+    } else {
+      ++partitionOffsets_[partition + 1];
+    }
+  }
+  for (auto i = 0; i < numDestinations_; ++i) {
+    partitionOffsets_[i + 1] += partitionOffsets_[i];
+  }
+  sortedRows_.resize(partitionOffsets_.back());
+  partitionCursors_ = partitionOffsets_;
+  for (vector_size_t i = 0; i < numRows; ++i) {
+    const auto partition = partitions_[i];
+    if (partition != core::PartitionFunction::kAllPartitions) {
+      sortedRows_[partitionCursors_[partition]++] = i;
+    }
+  }
+
+  for (auto partition = 0; partition < numDestinations_; ++partition) {
+    const auto end = partitionOffsets_[partition + 1];
+    auto i = partitionOffsets_[partition];
+    while (i < end) {
+      const auto first = i++;
+      while (i < end && sortedRows_[i] == sortedRows_[i - 1] + 1) {
+        ++i;
+      }
+      destinations_[partition]->addRows(
+          IndexRange{sortedRows_[first], i - first});
+    }
+  }
+}
+
 void PartitionedOutput::collectNullRows() {
   auto size = input_->size();
   rows_.resize(size);
@@ -307,11 +474,12 @@ RowVectorPtr PartitionedOutput::getOutput() {
   VELOX_CHECK_NOT_NULL(
       bufferManager, "PartitionedOutputBufferManager was already destructed");
 
-  // Limit serialized pages to 1MB.
-  static const uint64_t kMaxPageSize = 1 << 20;
-  const uint64_t maxPageSize = std::max<uint64_t>(
-      kMinDestinationSize,
-      std::min<uint64_t>(kMaxPageSize, maxBufferedBytes_ / numDestinations_));
+  if (compactBuffers_) {
+    getCompactOutput(*bufferManager);
+    return nullptr;
+  }
+
+  const uint64_t pageSize = maxPageSize(maxBufferedBytes_, numDestinations_);
 
   bool workLeft;
   do {
@@ -319,7 +487,7 @@ RowVectorPtr PartitionedOutput::getOutput() {
     for (auto& destination : destinations_) {
       bool atEnd = false;
       blockingReason_ = destination->advance(
-          maxPageSize,
+          pageSize,
           rowSize_,
           output_,
           *bufferManager,
@@ -374,8 +542,80 @@ RowVectorPtr PartitionedOutput::getOutput() {
   return nullptr;
 }
 
+void PartitionedOutput::getCompactOutput(
+    PartitionedOutputBufferManager& bufferManager) {
+  if (output_ != nullptr) {
+    const auto batch = compactBatches_.size();
+    compactBatches_.push_back(std::move(output_));
+    for (auto& destination : destinations_) {
+      compactBytes_ += destination->bufferBatch(batch, rowSize_);
+    }
+    input_ = nullptr;
+  }
+  if (compactFlushIdx_ == 0 && compactBytes_ < compactFlushBytes_ &&
+      !noMoreInput_) {
+    return;
+  }
+
+  // Cuts a page for each destination. If the consumer queue is full, the
+  // flush continues with the next destination when unblocked.
+  while (compactFlushIdx_ < destinations_.size()) {
+    blockingReason_ = destinations_[compactFlushIdx_++]->flushBuffered(
+        compactBatches_, bufferManager, bufferReleaseFn_, &future_);
+    if (blockingReason_ != BlockingReason::kNotBlocked) {
+      return;
+    }
+  }
+  compactFlushIdx_ = 0;
+  compactBatches_.clear();
+  compactBytes_ = 0;
+
+  if (noMoreInput_) {
+    for (auto& destination : destinations_) {
+      destination->setFinished();
+    }
+    bufferManager.noMoreData(operatorCtx_->task()->taskId());
+    finished_ = true;
+  }
+}
+
 bool PartitionedOutput::isFinished() {
   return finished_;
 }
 
+void PartitionedOutput::close() {
+  recordCompressionStats();
+  destinations_.clear();
+}
+
+void PartitionedOutput::recordCompressionStats() {
+  if (compressionKind_ == common::CompressionKind::CompressionKind_NONE) {
+    return;
+  }
+  serializer::presto::PrestoVectorSerde::CompressionStats total;
+  for (const auto& destination : destinations_) {
+    const auto& stats = destination->compressionStats();
+    total.numCompressedPages += stats.numCompressedPages;
+    total.numUncompressiblePages += stats.numUncompressiblePages;
+    total.numSkippedPages += stats.numSkippedPages;
+    total.compressionInputBytes += stats.compressionInputBytes;
+    total.compressedBytes += stats.compressedBytes;
+  }
+  if (total.compressionInputBytes == 0 && total.numSkippedPages == 0) {
+    return;
+  }
+  addRuntimeStat("compressedPages", RuntimeCounter(total.numCompressedPages));
+  addRuntimeStat(
+      "uncompressiblePages", RuntimeCounter(total.numUncompressiblePages));
+  addRuntimeStat(
+      "compressionSkippedPages", RuntimeCounter(total.numSkippedPages));
+  addRuntimeStat(
+      "compressionInputBytes",
+      RuntimeCounter(
+          total.compressionInputBytes, RuntimeCounter::Unit::kBytes));
+  addRuntimeStat(
+      "compressedBytes",
+      RuntimeCounter(total.compressedBytes, RuntimeCounter::Unit::kBytes));
+}
+
 } // namespace facebook::velox::exec
@@ -18,6 +18,7 @@
 #include <folly/Random.h>
 #include "velox/exec/Operator.h"
 #include "velox/exec/PartitionedOutputBufferManager.h"
+#include "velox/serializers/PrestoSerializer.h"
 #include "velox/vector/VectorStream.h"
 
 namespace facebook::velox::exec {
@@ -28,8 +29,20 @@ class Destination {
   Destination(
       const std::string& taskId,
       int destination,
-      memory::MemoryPool* pool)
-      : taskId_(taskId), destination_(destination), pool_(pool) {
+      memory::MemoryPool* pool,
+      common::CompressionKind compressionKind =
+          common::CompressionKind::CompressionKind_NONE,
+      bool vectorPages = false)
+      : taskId_(taskId),
+        destination_(destination),
+        pool_(pool),
+        vectorPages_(vectorPages) {
+    if (compressionKind != common::CompressionKind::CompressionKind_NONE) {
+      serdeOptions_ = std::make_unique<
+          serializer::presto::PrestoVectorSerde::PrestoOptions>(
+          false, compressionKind);
+      serdeOptions_->compressionStats = &compressionStats_;
+    }
     setTargetSizePct();
   }
 
@@ -61,6 +74,20 @@ class Destination {
       const std::function<void()>& bufferReleaseFn,
       ContinueFuture* future);
 
+  // Moves the ranges added since beginBatch() to the rows buffered for the
+  // compact mode of PartitionedOutput. 'batch' is the index of the current
+  // batch in the batches retained by PartitionedOutput. Returns the estimated
+  // serialized size of the moved rows.
+  uint64_t bufferBatch(int32_t batch, const std::vector<vector_size_t>& sizes);
+
+  // Serializes the rows buffered by bufferBatch() from 'batches' into a
+  // single page and enqueues it.
+  BlockingReason flushBuffered(
+      const std::vector<RowVectorPtr>& batches,
+      PartitionedOutputBufferManager& bufferManager,
+      const std::function<void()>& bufferReleaseFn,
+      ContinueFuture* future);
+
   bool isFinished() const {
     return finished_;
   }
@@ -73,10 +100,20 @@ class Destination {
     return bytesInCurrent_;
   }
 
+  const serializer::presto::PrestoVectorSerde::CompressionStats&
+  compressionStats() const {
+    return compressionStats_;
+  }
+
  private:
   void
   serialize(const RowVectorPtr& input, vector_size_t begin, vector_size_t end);
 
+  // Copies 'ranges' of 'input' to the end of 'currentVector_'.
+  void appendToVector(
+      const RowVectorPtr& input,
+      folly::Range<const IndexRange*> ranges);
+
   // Sets the next target size for flushing. This is called at the
   // start of each batch of output for the destination. The effect is
   // to make different destinations ready at slightly different times
@@ -93,14 +130,32 @@ class Destination {
   const std::string taskId_;
   const int destination_;
   memory::MemoryPool* const pool_;
+  // If true, the rows are copied into 'currentVector_' and enqueued as a page
+  // holding the vector instead of being serialized. See
+  // QueryConfig::kShuffleInProcessVectors.
+  const bool vectorPages_;
   uint64_t bytesInCurrent_{0};
   std::vector<IndexRange> ranges_;
 
   // First range index of 'ranges_' that is not appended to 'current_'.
   vector_size_t rangeIdx_{0};
   std::unique_ptr<VectorStreamGroup> current_;
+  RowVectorPtr currentVector_;
   bool finished_{false};
 
+  // Ranges of rows buffered by bufferBatch(). 'bufferedBatchEnds_' has the
+  // batch index and the end offset in 'bufferedRanges_' for each buffered
+  // batch.
+  std::vector<IndexRange> bufferedRanges_;
+  std::vector<std::pair<int32_t, size_t>> bufferedBatchEnds_;
+
+  // Options for serializing the pages. Null if the pages are not compressed.
+  // The compression outcome of the pages to this destination is accumulated in
+  // 'compressionStats_' to skip compressing after poorly compressible pages.
+  std::unique_ptr<serializer::presto::PrestoVectorSerde::PrestoOptions>
+      serdeOptions_;
+  serializer::presto::PrestoVectorSerde::CompressionStats compressionStats_;
+
   // Flush accumulated data to buffer manager after reaching this
   // percentage of target bytes or rows. This will make data for
   // different destinations ready at different times to flatten a
@@ -159,9 +214,7 @@ class PartitionedOutput : public Operator {
 
   bool isFinished() override;
 
-  void close() override {
-    destinations_.clear();
-  }
+  void close() override;
 
  private:
   void initializeInput(RowVectorPtr input);
@@ -175,6 +228,25 @@ class PartitionedOutput : public Operator {
   /// Collect all rows with null keys into nullRows_.
   void collectNullRows();
 
+  /// Adds 'row' to the destination given by 'partitions_', or to all the
+  /// destinations for a replicated row.
+  void addRow(vector_size_t row);
+
+  /// Adds the rows of the input to their destinations in compact mode. The
+  /// row numbers are scattered into 'sortedRows_' grouped by partition, so
+  /// that each destination gets maximal runs of consecutive rows.
+  void scatterRows(vector_size_t numRows);
+
+  /// getOutput() in compact mode. Retains the processed input in
+  /// 'compactBatches_' and cuts a page per destination once the estimated
+  /// size of the retained rows reaches 'compactFlushBytes_' or at the end of
+  /// input.
+  void getCompactOutput(PartitionedOutputBufferManager& bufferManager);
+
+  /// Adds the compression outcome of the pages sent to all destinations to the
+  /// runtime stats.
+  void recordCompressionStats();
+
   const std::vector<column_index_t> keyChannels_;
   const int numDestinations_;
   const bool replicateNullsAndAny_;
@@ -184,6 +256,16 @@ class PartitionedOutput : public Operator {
   const std::weak_ptr<exec::PartitionedOutputBufferManager> bufferManager_;
   const std::function<void()> bufferReleaseFn_;
   const int64_t maxBufferedBytes_;
+  const common::CompressionKind compressionKind_;
+  // See QueryConfig::kShuffleInProcessVectors.
+  const bool vectorPages_;
+  // True if the rows for all destinations are buffered in a shared arena of
+  // input batches instead of being serialized per destination as they arrive.
+  // See QueryConfig::kPartitionedOutputCompactMinDestinations.
+  const bool compactBuffers_;
+  // Estimated serialized size of the buffered rows that triggers cutting the
+  // pages for all destinations in compact mode.
+  const uint64_t compactFlushBytes_;
 
   BlockingReason blockingReason_{BlockingReason::kNotBlocked};
   ContinueFuture future_;
@@ -203,6 +285,17 @@ class PartitionedOutput : public Operator {
   SelectivityVector nullRows_;
   std::vector<uint32_t> partitions_;
   std::vector<DecodedVector> decodedVectors_;
+  std::vector<vector_size_t> sortedRows_;
+  std::vector<vector_size_t> partitionOffsets_;
+  std::vector<vector_size_t> partitionCursors_;
+
+  // State of the compact mode. 'compactBatches_' are the batches the
+  // destinations have buffered rows of and 'compactBytes_' is the estimated
+  // serialized size of these rows. 'compactFlushIdx_' is the next destination
+  // to flush if a flush is in progress, 0 otherwise.
+  std::vector<RowVectorPtr> compactBatches_;
+  uint64_t compactBytes_{0};
+  size_t compactFlushIdx_{0};
 };
 
 } // namespace facebook::velox::exec
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/PartitionedOutputBuffer.h"
+#include "velox/common/file/FileSystems.h"
 #include "velox/exec/Task.h"
 
 namespace facebook::velox::exec {
@@ -62,11 +63,41 @@ std::string ArbitraryBuffer::toString() const {
       hasNoMoreData());
 }
 
+namespace {
+std::vector<std::unique_ptr<folly::IOBuf>> toIOBufs(
+    const std::vector<std::shared_ptr<SerializedPage>>& pages) {
+  std::vector<std::unique_ptr<folly::IOBuf>> result;
+  result.reserve(pages.size());
+  for (const auto& page : pages) {
+    result.push_back(page == nullptr ? nullptr : page->getIOBuf());
+  }
+  return result;
+}
+
+PagesAvailableCallback toPagesCallback(DataAvailableCallback notify) {
+  if (notify == nullptr) {
+    return nullptr;
+  }
+  return [notify = std::move(notify)](
+             std::vector<std::shared_ptr<SerializedPage>> pages,
+             int64_t sequence) { notify(toIOBufs(pages), sequence); };
+}
+} // namespace
+
 std::vector<std::unique_ptr<folly::IOBuf>> DestinationBuffer::getData(
     uint64_t maxBytes,
     int64_t sequence,
     DataAvailableCallback notify,
     ArbitraryBuffer* arbitraryBuffer) {
+  return toIOBufs(getPages(
+      maxBytes, sequence, toPagesCallback(std::move(notify)), arbitraryBuffer));
+}
+
+std::vector<std::shared_ptr<SerializedPage>> DestinationBuffer::getPages(
+    uint64_t maxBytes,
+    int64_t sequence,
+    PagesAvailableCallback notify,
+    ArbitraryBuffer* arbitraryBuffer) {
   VELOX_CHECK_GE(
       sequence, sequence_, "Get received for an already acknowledged item");
   if (arbitraryBuffer != nullptr) {
@@ -89,7 +120,7 @@ std::vector<std::unique_ptr<folly::IOBuf>> DestinationBuffer::getData(
     return {};
   }
 
-  std::vector<std::unique_ptr<folly::IOBuf>> result;
+  std::vector<std::shared_ptr<SerializedPage>> result;
   uint64_t resultBytes = 0;
   for (auto i = sequence - sequence_; i < data_.size(); ++i) {
     // nullptr is used as end marker
@@ -98,7 +129,7 @@ std::vector<std::unique_ptr<folly::IOBuf>> DestinationBuffer::getData(
       result.push_back(nullptr);
       break;
     }
-    result.push_back(data_[i]->getIOBuf());
+    result.push_back(data_[i]);
     resultBytes += data_[i]->size();
     if (resultBytes >= maxBytes) {
       break;
@@ -123,7 +154,7 @@ DataAvailable DestinationBuffer::getAndClearNotify() {
   DataAvailable result;
   result.callback = notify_;
   result.sequence = notifySequence_;
-  result.data = getData(notifyMaxBytes_, notifySequence_, nullptr);
+  result.data = getPages(notifyMaxBytes_, notifySequence_, nullptr);
   notify_ = nullptr;
   notifySequence_ = 0;
   notifyMaxBytes_ = 0;
@@ -231,6 +262,10 @@ PartitionedOutputBuffer::PartitionedOutputBuffer(
       continueSize_((maxSize_ * kContinuePct) / 100),
       arbitraryBuffer_(
           isArbitrary() ? std::make_unique<ArbitraryBuffer>() : nullptr),
+      spillBroadcast_(
+          isBroadcast() && task_->queryCtx()->queryConfig().spillEnabled() &&
+          task_->queryCtx()->queryConfig().broadcastSpillEnabled() &&
+          !task_->spillDirectory().empty()),
       numDrivers_(numDrivers) {
   buffers_.reserve(numDestinations);
   for (int i = 0; i < numDestinations; i++) {
@@ -336,6 +371,10 @@ bool PartitionedOutputBuffer::enqueue(
         VELOX_UNREACHABLE(PartitionedOutputNode::kindString(kind_));
     }
 
+    if (totalSize_ > maxSize_ && spillBroadcast_) {
+      spillBroadcastLocked();
+    }
+
     if (totalSize_ > maxSize_ && future) {
       promises_.emplace_back("PartitionedOutputBuffer::enqueue");
       *future = promises_.back().getSemiFuture();
@@ -371,6 +410,68 @@ void PartitionedOutputBuffer::enqueueBroadcastOutputLocked(
   if (!noMoreBuffers_) {
     dataToBroadcast_.emplace_back(sharedData);
   }
+  if (spillBroadcast_) {
+    while (!broadcastPages_.empty() && broadcastPages_.front().expired()) {
+      broadcastPages_.pop_front();
+    }
+    broadcastPages_.emplace_back(sharedData);
+  }
+}
+
+void PartitionedOutputBuffer::spillBroadcastLocked() {
+  std::vector<std::shared_ptr<SerializedPage>> pages;
+  uint64_t bytes = 0;
+  while (!broadcastPages_.empty() && totalSize_ - bytes > continueSize_) {
+    auto page = broadcastPages_.front().lock();
+    broadcastPages_.pop_front();
+    // Pages holding vectors are for consumers in the same process and are not
+    // spilled.
+    if (page == nullptr || page->vector() != nullptr) {
+      continue;
+    }
+    bytes += page->size();
+    pages.push_back(std::move(page));
+  }
+  if (pages.empty()) {
+    return;
+  }
+
+  const auto& spillDirectory = task_->spillDirectory();
+  const auto path =
+      fmt::format("{}/broadcast-{}", spillDirectory, numSpillFiles_++);
+  auto fs = filesystems::getFileSystem(path, nullptr);
+  fs->mkdir(spillDirectory);
+  std::vector<uint64_t> offsets;
+  offsets.reserve(pages.size());
+  {
+    auto file = fs->openFileForWrite(path);
+    for (const auto& page : pages) {
+      offsets.push_back(file->size());
+      auto iobuf = page->getIOBuf();
+      for (const auto& range : *iobuf) {
+        file->append(std::string_view(
+            reinterpret_cast<const char*>(range.data()), range.size()));
+      }
+    }
+    file->close();
+  }
+  // The file is removed once all the pages spilled to it are freed.
+  std::shared_ptr<ReadFile> spillFile(
+      fs->openFileForRead(path).release(), [fs, path](ReadFile* file) {
+        delete file;
+        try {
+          fs->remove(path);
+        } catch (const std::exception& e) {
+          LOG(ERROR) << "Failed to remove broadcast spill file " << path
+                     << ": " << e.what();
+        }
+      });
+  for (auto i = 0; i < pages.size(); ++i) {
+    pages[i]->spill(spillFile, offsets[i]);
+  }
+  VELOX_CHECK_GE(totalSize_, bytes);
+  totalSize_ -= bytes;
+  spilledBytes_ += bytes;
 }
 
 void PartitionedOutputBuffer::enqueueArbitraryOutputLocked(
@@ -511,7 +612,8 @@ void PartitionedOutputBuffer::updateAfterAcknowledgeLocked(
     std::vector<ContinuePromise>& promises) {
   uint64_t totalFreed = 0;
   for (const auto& free : freed) {
-    if (free.unique()) {
+    // The size of spilled pages is already taken out of 'totalSize_'.
+    if (free.unique() && !free->isSpilled()) {
       totalFreed += free->size();
     }
   }
@@ -572,7 +674,15 @@ void PartitionedOutputBuffer::getData(
     uint64_t maxBytes,
     int64_t sequence,
     DataAvailableCallback notify) {
-  std::vector<std::unique_ptr<folly::IOBuf>> data;
+  getPages(destination, maxBytes, sequence, toPagesCallback(std::move(notify)));
+}
+
+void PartitionedOutputBuffer::getPages(
+    int destination,
+    uint64_t maxBytes,
+    int64_t sequence,
+    PagesAvailableCallback notify) {
+  std::vector<std::shared_ptr<SerializedPage>> data;
   std::vector<std::shared_ptr<SerializedPage>> freed;
   std::vector<ContinuePromise> promises;
   {
@@ -591,7 +701,7 @@ void PartitionedOutputBuffer::getData(
         sequence);
     freed = buffer->acknowledge(sequence, true);
     updateAfterAcknowledgeLocked(freed, promises);
-    data = buffer->getData(maxBytes, sequence, notify, arbitraryBuffer_.get());
+    data = buffer->getPages(maxBytes, sequence, notify, arbitraryBuffer_.get());
   }
   releaseAfterAcknowledge(freed, promises);
   if (!data.empty()) {
@@ -620,6 +730,7 @@ std::string PartitionedOutputBuffer::toString() {
 std::string PartitionedOutputBuffer::toStringLocked() const {
   std::stringstream out;
   out << "[PartitionedOutputBuffer[" << kind_ << "] totalSize_=" << totalSize_
+      << "b, spilledBytes_=" << spilledBytes_
       << "b, num producers blocked=" << promises_.size()
       << ", completed=" << numFinished_ << "/" << numDrivers_ << ", "
       << (atEnd_ ? "at end, " : "") << "destinations: " << std::endl;
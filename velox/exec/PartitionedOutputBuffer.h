@@ -27,10 +27,17 @@ namespace facebook::velox::exec {
 using DataAvailableCallback = std::function<
     void(std::vector<std::unique_ptr<folly::IOBuf>> pages, int64_t sequence)>;
 
+/// Same as DataAvailableCallback but receives the buffered pages themselves
+/// instead of copies of their serialized data. Used by consumers in the same
+/// process, which can also receive pages that hold a vector.
+using PagesAvailableCallback = std::function<void(
+    std::vector<std::shared_ptr<SerializedPage>> pages,
+    int64_t sequence)>;
+
 struct DataAvailable {
-  DataAvailableCallback callback;
+  PagesAvailableCallback callback;
   int64_t sequence;
-  std::vector<std::unique_ptr<folly::IOBuf>> data;
+  std::vector<std::shared_ptr<SerializedPage>> data;
 
   void notify() {
     if (callback) {
@@ -99,6 +106,13 @@ class DestinationBuffer {
       DataAvailableCallback notify,
       ArbitraryBuffer* arbitraryBuffer = nullptr);
 
+  // Same as getData() but returns the pages instead of copies of their data.
+  std::vector<std::shared_ptr<SerializedPage>> getPages(
+      uint64_t maxBytes,
+      int64_t sequence,
+      PagesAvailableCallback notify,
+      ArbitraryBuffer* arbitraryBuffer = nullptr);
+
   // Removes data from the queue and returns removed data. If 'fromGetData' we
   // do not give a warning for the case where no data is removed, otherwise we
   // expect that data does get freed. We cannot assert that data gets
@@ -120,7 +134,7 @@ class DestinationBuffer {
   std::vector<std::shared_ptr<SerializedPage>> data_;
   // The sequence number of the first in 'data_'.
   int64_t sequence_ = 0;
-  DataAvailableCallback notify_ = nullptr;
+  PagesAvailableCallback notify_ = nullptr;
   // The sequence number of the first item to pass to 'notify'.
   int64_t notifySequence_{0};
   uint64_t notifyMaxBytes_{0};
@@ -178,6 +192,14 @@ class PartitionedOutputBuffer {
       int64_t sequence,
       DataAvailableCallback notify);
 
+  // Same as getData() but passes the pages to 'notify' instead of copies of
+  // their data. Used by consumers in the same process.
+  void getPages(
+      int destination,
+      uint64_t maxSize,
+      int64_t sequence,
+      PagesAvailableCallback notify);
+
   // Continues any possibly waiting producers. Called when the
   // producer task has an error or cancellation.
   void terminate();
@@ -191,6 +213,11 @@ class PartitionedOutputBuffer {
   // producers.
   bool isOverutilized() const;
 
+  // Returns the total size of the broadcast pages written to disk.
+  uint64_t spilledBytes() const {
+    return spilledBytes_;
+  }
+
  private:
   // Percentage of maxSize below which a blocked producer should
   // be unblocked.
@@ -215,6 +242,11 @@ class PartitionedOutputBuffer {
       std::unique_ptr<SerializedPage> data,
       std::vector<DataAvailable>& dataAvailableCbs);
 
+  // Writes the oldest broadcast pages to a file until 'totalSize_' is below
+  // 'continueSize_'. The pages stay in the destination buffers but no longer
+  // hold their data in memory.
+  void spillBroadcastLocked();
+
   void enqueueArbitraryOutputLocked(
       std::unique_ptr<SerializedPage> data,
       std::vector<DataAvailable>& dataAvailableCbs);
@@ -247,6 +279,10 @@ class PartitionedOutputBuffer {
   // resumed.
   const uint64_t continueSize_;
   const std::unique_ptr<ArbitraryBuffer> arbitraryBuffer_;
+  // True if the pages of a broadcast output buffer are spilled instead of
+  // blocking the producers when the buffer is full. See
+  // QueryConfig::kBroadcastSpillEnabled.
+  const bool spillBroadcast_;
 
   // Total number of drivers expected to produce results. This number will
   // decrease in the end of grouped execution, when we understand the real
@@ -262,6 +298,12 @@ class PartitionedOutputBuffer {
   // after receiving no-more-broadcast-buffers signal.
   std::vector<std::shared_ptr<SerializedPage>> dataToBroadcast_;
 
+  // The broadcast pages in enqueue order if 'spillBroadcast_' is true. Pages
+  // are dropped from the front when spilled or freed.
+  std::deque<std::weak_ptr<SerializedPage>> broadcastPages_;
+  uint32_t numSpillFiles_{0};
+  uint64_t spilledBytes_{0};
+
   std::mutex mutex_;
   // Actual data size in 'buffers_'.
   uint64_t totalSize_ = 0;
@@ -103,6 +103,19 @@ bool PartitionedOutputBufferManager::getData(
   return false;
 }
 
+bool PartitionedOutputBufferManager::getPages(
+    const std::string& taskId,
+    int destination,
+    uint64_t maxBytes,
+    int64_t sequence,
+    PagesAvailableCallback notify) {
+  if (auto buffer = getBufferIfExists(taskId)) {
+    buffer->getPages(destination, maxBytes, sequence, notify);
+    return true;
+  }
+  return false;
+}
+
 void PartitionedOutputBufferManager::initializeTask(
     std::shared_ptr<Task> task,
     core::PartitionedOutputNode::Kind kind,
@@ -185,4 +198,13 @@ bool PartitionedOutputBufferManager::isOverutilized(const std::string& taskId) {
   return false;
 }
 
+uint64_t PartitionedOutputBufferManager::spilledBytes(
+    const std::string& taskId) {
+  auto buffer = getBufferIfExists(taskId);
+  if (buffer != nullptr) {
+    return buffer->spilledBytes();
+  }
+  return 0;
+}
+
 } // namespace facebook::velox::exec
@@ -80,6 +80,22 @@ class PartitionedOutputBufferManager {
       int64_t sequence,
       DataAvailableCallback notify);
 
+  // Same as getData() but passes the buffered pages to 'notify' instead of
+  // copies of their data. Pages produced with
+  // QueryConfig::shuffleInProcessVectors() hold vectors and can only be
+  // fetched this way.
+  bool getPages(
+      const std::string& taskId,
+      int destination,
+      uint64_t maxBytes,
+      int64_t sequence,
+      PagesAvailableCallback notify);
+
+  // Returns true if the output buffer of 'taskId' is in this process.
+  bool hasTask(const std::string& taskId) {
+    return getBufferIfExists(taskId) != nullptr;
+  }
+
   void removeTask(const std::string& taskId);
 
   static std::weak_ptr<PartitionedOutputBufferManager> getInstance();
@@ -108,6 +124,10 @@ class PartitionedOutputBufferManager {
   // producers. When the task of this taskId is not found, return false.
   bool isOverutilized(const std::string& taskId);
 
+  // Returns the bytes of broadcast pages spilled by the output buffer of
+  // 'taskId', 0 if the task is not found.
+  uint64_t spilledBytes(const std::string& taskId);
+
   // Retrieves the set of buffers for a query if exists.
   // Returns NULL if task not found.
   std::shared_ptr<PartitionedOutputBuffer> getBufferIfExists(
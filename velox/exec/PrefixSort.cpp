@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/PrefixSort.h"
+
+#include <folly/lang/Bits.h>
+
+namespace facebook::velox::exec {
+
+namespace {
+
+// Returns the bytes of the encoded value of a key of 'kind', 0 if keys of
+// 'kind' are not encoded in the prefix.
+int32_t encodedValueBytes(TypeKind kind) {
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+      return 1;
+    case TypeKind::SMALLINT:
+      return 2;
+    case TypeKind::INTEGER:
+    case TypeKind::REAL:
+      return 4;
+    case TypeKind::BIGINT:
+    case TypeKind::DOUBLE:
+      return 8;
+    case TypeKind::TIMESTAMP:
+      return 12;
+    case TypeKind::HUGEINT:
+      return 16;
+    default:
+      return 0;
+  }
+}
+
+// Returns the bytes of the prefix for the first 'numKeys' of 'keyTypes'.
+int32_t prefixBytes(const std::vector<TypePtr>& keyTypes, uint32_t numKeys) {
+  int32_t numBytes = 0;
+  for (auto i = 0; i < numKeys; ++i) {
+    numBytes += 1 + encodedValueBytes(keyTypes[i]->kind());
+  }
+  return numBytes;
+}
+
+// Writes the 'numBytes' low bytes of 'value', most significant first.
+template <typename U>
+void writeBigEndian(U value, int32_t numBytes, uint8_t* out) {
+  for (auto i = numBytes - 1; i >= 0; --i) {
+    out[i] = static_cast<uint8_t>(value);
+    value >>= 8;
+  }
+}
+
+// Flips the sign bit so that signed values compare as unsigned.
+template <typename T, typename U>
+void encodeSigned(const char* value, uint8_t* out) {
+  T signedValue;
+  memcpy(&signedValue, value, sizeof(T));
+  constexpr U kSignBit = static_cast<U>(1) << (sizeof(U) * 8 - 1);
+  writeBigEndian<U>(static_cast<U>(signedValue) ^ kSignBit, sizeof(T), out);
+}
+
+// Makes the bits of floating point values compare as unsigned in the order of
+// RowContainer::compare, i.e. NaNs are equal and above all other values and
+// -0.0 is equal to 0.0.
+template <typename T, typename U>
+void encodeFloatingPoint(const char* value, uint8_t* out) {
+  T floatValue;
+  memcpy(&floatValue, value, sizeof(T));
+  U bits;
+  if (std::isnan(floatValue)) {
+    bits = std::numeric_limits<U>::max();
+  } else {
+    if (floatValue == 0) {
+      floatValue = 0;
+    }
+    constexpr U kSignBit = static_cast<U>(1) << (sizeof(U) * 8 - 1);
+    memcpy(&bits, &floatValue, sizeof(T));
+    bits = (bits & kSignBit) ? ~bits : bits | kSignBit;
+  }
+  writeBigEndian<U>(bits, sizeof(T), out);
+}
+
+// Encodes the key of 'kind' at 'column' of 'row' into 1 + encodedValueBytes()
+// bytes at 'out'.
+void encodeKey(
+    TypeKind kind,
+    const char* row,
+    RowColumn column,
+    const CompareFlags& flags,
+    uint8_t* out) {
+  const auto numBytes = encodedValueBytes(kind);
+  const bool isNull =
+      RowContainer::isNullAt(row, column.nullByte(), column.nullMask());
+  out[0] = isNull != flags.nullsFirst ? 1 : 0;
+  ++out;
+  if (isNull) {
+    memset(out, 0, numBytes);
+    return;
+  }
+  const auto* value = row + column.offset();
+  switch (kind) {
+    case TypeKind::BOOLEAN:
+      out[0] = *reinterpret_cast<const bool*>(value) ? 1 : 0;
+      break;
+    case TypeKind::TINYINT:
+      encodeSigned<int8_t, uint8_t>(value, out);
+      break;
+    case TypeKind::SMALLINT:
+      encodeSigned<int16_t, uint16_t>(value, out);
+      break;
+    case TypeKind::INTEGER:
+      encodeSigned<int32_t, uint32_t>(value, out);
+      break;
+    case TypeKind::BIGINT:
+      encodeSigned<int64_t, uint64_t>(value, out);
+      break;
+    case TypeKind::HUGEINT:
+      encodeSigned<int128_t, uint128_t>(value, out);
+      break;
+    case TypeKind::REAL:
+      encodeFloatingPoint<float, uint32_t>(value, out);
+      break;
+    case TypeKind::DOUBLE:
+      encodeFloatingPoint<double, uint64_t>(value, out);
+      break;
+    case TypeKind::TIMESTAMP: {
+      Timestamp timestamp;
+      memcpy(&timestamp, value, sizeof(Timestamp));
+      const auto seconds = timestamp.getSeconds();
+      encodeSigned<int64_t, uint64_t>(
+          reinterpret_cast<const char*>(&seconds), out);
+      writeBigEndian<uint64_t>(timestamp.getNanos(), 4, out + 8);
+      break;
+    }
+    default:
+      VELOX_UNREACHABLE();
+  }
+  if (!flags.ascending) {
+    for (auto i = 0; i < numBytes; ++i) {
+      out[i] = ~out[i];
+    }
+  }
+}
+
+template <int32_t kNumWords>
+struct PrefixEntry {
+  // The prefix as words that compare in the order of the encoded bytes.
+  uint64_t words[kNumWords];
+  char* row;
+};
+
+template <int32_t kNumWords>
+void sortWithPrefix(
+    RowContainer& data,
+    const std::vector<CompareFlags>& compareFlags,
+    uint32_t numPrefixKeys,
+    std::vector<char*>& rows) {
+  const auto& keyTypes = data.keyTypes();
+  std::vector<PrefixEntry<kNumWords>> entries(rows.size());
+  uint8_t prefix[kNumWords * sizeof(uint64_t)];
+  for (auto i = 0; i < rows.size(); ++i) {
+    memset(prefix, 0, sizeof(prefix));
+    auto* out = prefix;
+    for (auto key = 0; key < numPrefixKeys; ++key) {
+      const auto kind = keyTypes[key]->kind();
+      encodeKey(kind, rows[i], data.columnAt(key), compareFlags[key], out);
+      out += 1 + encodedValueBytes(kind);
+    }
+    auto& entry = entries[i];
+    for (auto word = 0; word < kNumWords; ++word) {
+      uint64_t value;
+      memcpy(&value, prefix + word * sizeof(uint64_t), sizeof(uint64_t));
+      entry.words[word] = folly::Endian::big(value);
+    }
+    entry.row = rows[i];
+  }
+
+  std::sort(
+      entries.begin(),
+      entries.end(),
+      [&](const PrefixEntry<kNumWords>& left,
+          const PrefixEntry<kNumWords>& right) {
+        for (auto word = 0; word < kNumWords; ++word) {
+          if (left.words[word] != right.words[word]) {
+            return left.words[word] < right.words[word];
+          }
+        }
+        for (auto index = numPrefixKeys; index < compareFlags.size();
+             ++index) {
+          if (auto result = data.compare(
+                  left.row, right.row, index, compareFlags[index])) {
+            return result < 0;
+          }
+        }
+        return false;
+      });
+  for (auto i = 0; i < rows.size(); ++i) {
+    rows[i] = entries[i].row;
+  }
+}
+
+} // namespace
+
+// static
+uint32_t PrefixSort::numPrefixKeys(
+    const std::vector<TypePtr>& keyTypes,
+    const std::vector<CompareFlags>& compareFlags) {
+  VELOX_CHECK_LE(compareFlags.size(), keyTypes.size());
+  uint32_t numKeys = 0;
+  int32_t numBytes = 0;
+  for (auto i = 0; i < compareFlags.size(); ++i) {
+    if (compareFlags[i].nullHandlingMode !=
+        CompareFlags::NullHandlingMode::NoStop) {
+      break;
+    }
+    const auto valueBytes = encodedValueBytes(keyTypes[i]->kind());
+    if (valueBytes == 0 || numBytes + 1 + valueBytes > kMaxPrefixBytes) {
+      break;
+    }
+    numBytes += 1 + valueBytes;
+    ++numKeys;
+  }
+  return numKeys;
+}
+
+// static
+bool PrefixSort::sort(
+    RowContainer& data,
+    const std::vector<CompareFlags>& compareFlags,
+    std::vector<char*>& rows) {
+  const auto numKeys = numPrefixKeys(data.keyTypes(), compareFlags);
+  if (numKeys == 0) {
+    return false;
+  }
+  const auto numBytes = prefixBytes(data.keyTypes(), numKeys);
+  switch (bits::roundUp(numBytes, sizeof(uint64_t)) / sizeof(uint64_t)) {
+    case 1:
+      sortWithPrefix<1>(data, compareFlags, numKeys, rows);
+      break;
+    case 2:
+      sortWithPrefix<2>(data, compareFlags, numKeys, rows);
+      break;
+    case 3:
+      sortWithPrefix<3>(data, compareFlags, numKeys, rows);
+      break;
+    case 4:
+      sortWithPrefix<4>(data, compareFlags, numKeys, rows);
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+  return true;
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/exec/RowContainer.h"
+
+namespace facebook::velox::exec {
+
+/// Sorts rows of a RowContainer on a normalized key prefix. The leading fixed
+/// width sort keys of each row are encoded into an order preserving binary
+/// prefix stored next to the row pointer, so that most comparisons are a few
+/// word compares instead of a type dispatch and a pointer chase per key. Rows
+/// with equal prefixes are ordered by RowContainer::compare on the remaining
+/// keys.
+///
+/// Each encoded key takes one byte for the null flag and the width of its
+/// value. Integers, booleans, floating point numbers and timestamps are
+/// encoded. The prefix stops at the first key of another type or at
+/// kMaxPrefixBytes.
+class PrefixSort {
+ public:
+  static constexpr int32_t kMaxPrefixBytes = 32;
+
+  /// Returns the number of leading keys of 'keyTypes' ordered by
+  /// 'compareFlags' that are encoded in the prefix. 0 means that the prefix
+  /// sort does not apply.
+  static uint32_t numPrefixKeys(
+      const std::vector<TypePtr>& keyTypes,
+      const std::vector<CompareFlags>& compareFlags);
+
+  /// Sorts 'rows' of 'data' on the first compareFlags.size() key columns of
+  /// 'data' ordered by 'compareFlags'. Returns false without changing 'rows'
+  /// if no key can be encoded in the prefix.
+  static bool sort(
+      RowContainer& data,
+      const std::vector<CompareFlags>& compareFlags,
+      std::vector<char*>& rows);
+};
+
+} // namespace facebook::velox::exec
@@ -18,7 +18,6 @@
 
 #include "velox/common/base/RawVector.h"
 #include "velox/exec/Aggregate.h"
-#include "velox/exec/ContainerRowSerde.h"
 #include "velox/exec/Operator.h"
 
 namespace facebook::velox::exec {
@@ -48,16 +47,21 @@ setBit(char* bits, uint32_t idx) {
 }
 } // namespace
 
-Accumulator::Accumulator(Aggregate* aggregate)
+Accumulator::Accumulator(Aggregate* aggregate, TypePtr spillType)
     : isFixedSize_{aggregate->isFixedSize()},
       fixedSize_{aggregate->accumulatorFixedWidthSize()},
       usesExternalMemory_{aggregate->accumulatorUsesExternalMemory()},
       alignment_{aggregate->accumulatorAlignmentSize()},
+      spillType_{std::move(spillType)},
+      spillExtractFunction_{
+          [aggregate](folly::Range<char**> groups, VectorPtr& result) {
+            aggregate->extractAccumulators(
+                groups.data(), groups.size(), &result);
+          }},
       destroyFunction_{[aggregate](folly::Range<char**> groups) {
         aggregate->destroy(groups);
-      }},
-      aggregate_{aggregate} {
-  VELOX_CHECK_NOT_NULL(aggregate_);
+      }} {
+  VELOX_CHECK_NOT_NULL(aggregate);
 }
 
 Accumulator::Accumulator(
@@ -72,6 +76,22 @@ Accumulator::Accumulator(
       alignment_{alignment},
       destroyFunction_{destroyFunction} {}
 
+Accumulator::Accumulator(
+    bool isFixedSize,
+    int32_t fixedSize,
+    bool usesExternalMemory,
+    int32_t alignment,
+    TypePtr spillType,
+    SpillExtractFunction spillExtractFunction,
+    std::function<void(folly::Range<char**> groups)> destroyFunction)
+    : isFixedSize_{isFixedSize},
+      fixedSize_{fixedSize},
+      usesExternalMemory_{usesExternalMemory},
+      alignment_{alignment},
+      spillType_{std::move(spillType)},
+      spillExtractFunction_{std::move(spillExtractFunction)},
+      destroyFunction_{std::move(destroyFunction)} {}
+
 bool Accumulator::isFixedSize() const {
   return isFixedSize_;
 }
@@ -92,6 +112,18 @@ void Accumulator::destroy(folly::Range<char**> groups) {
   destroyFunction_(groups);
 }
 
+const TypePtr& Accumulator::spillType() const {
+  VELOX_CHECK_NOT_NULL(spillType_, "Accumulator doesn't support spilling");
+  return spillType_;
+}
+
+void Accumulator::extractForSpill(
+    folly::Range<char**> groups,
+    VectorPtr& result) const {
+  VELOX_CHECK(spillExtractFunction_ != nullptr);
+  spillExtractFunction_(groups, result);
+}
+
 // static
 int32_t RowContainer::combineAlignments(int32_t a, int32_t b) {
   VELOX_CHECK_EQ(__builtin_popcount(a), 1, "Alignment can only be power of 2");
@@ -429,24 +461,6 @@ void RowContainer::store(
   }
 }
 
-void RowContainer::prepareRead(
-    const char* row,
-    int32_t offset,
-    ByteStream& stream) {
-  auto view = reinterpret_cast<const StringView*>(row + offset);
-  if (view->isInline()) {
-    stream.setRange(ByteRange{
-        const_cast<uint8_t*>(reinterpret_cast<const uint8_t*>(view->data())),
-        static_cast<int32_t>(view->size()),
-        0});
-    return;
-  }
-  // We set 'stream' to range over the ranges that start at the Header
-  // immediately below the first character in the StringView.
-  HashStringAllocator::prepareRead(
-      HashStringAllocator::headerOf(view->data()), stream);
-}
-
 void RowContainer::extractString(
     StringView value,
     FlatVector<StringView>* values,
@@ -479,12 +493,12 @@ void RowContainer::storeComplexType(
     return;
   }
   RowSizeTracker tracker(row[rowSizeOffset_], *stringAllocator_);
-  ByteStream stream(stringAllocator_.get(), false, false);
-  auto position = stringAllocator_->newWrite(stream);
-  ContainerRowSerde::serialize(*decoded.base(), decoded.index(index), stream);
-  stringAllocator_->finishWrite(stream, 0);
-  valueAt<StringView>(row, offset) =
-      StringView(reinterpret_cast<char*>(position.position), stream.size());
+  std::string serialized;
+  ByteComparableSerde::serialize(
+      *decoded.base(), decoded.index(index), serialized);
+  // Stored like a string, so that it is hashed and freed like one.
+  valueAt<StringView>(row, offset) = StringView(serialized);
+  stringAllocator_->copyMultipart(row, offset);
 }
 
 //   static
@@ -506,9 +520,16 @@ int RowContainer::compareComplexType(
     CompareFlags flags) {
   VELOX_DCHECK(!flags.mayStopAtNull(), "not supported null handling mode");
 
-  ByteStream stream;
-  prepareRead(row, offset, stream);
-  return ContainerRowSerde::compare(stream, decoded, index, flags);
+  std::string storage;
+  std::string serialized;
+  ByteComparableSerde::serialize(
+      *decoded.base(), decoded.index(index), serialized);
+  return ByteComparableSerde::compare(
+      HashStringAllocator::contiguousString(
+          valueAt<StringView>(row, offset), storage),
+      StringView(serialized),
+      decoded.base()->type().get(),
+      flags);
 }
 
 int32_t RowContainer::compareStringAsc(StringView left, StringView right) {
@@ -527,11 +548,15 @@ int32_t RowContainer::compareComplexType(
     CompareFlags flags) {
   VELOX_DCHECK(!flags.mayStopAtNull(), "not supported null handling mode");
 
-  ByteStream leftStream;
-  ByteStream rightStream;
-  prepareRead(left, leftOffset, leftStream);
-  prepareRead(right, rightOffset, rightStream);
-  return ContainerRowSerde::compare(leftStream, rightStream, type, flags);
+  std::string leftStorage;
+  std::string rightStorage;
+  return ByteComparableSerde::compare(
+      HashStringAllocator::contiguousString(
+          valueAt<StringView>(left, leftOffset), leftStorage),
+      HashStringAllocator::contiguousString(
+          valueAt<StringView>(right, rightOffset), rightStorage),
+      type,
+      flags);
 }
 
 int32_t RowContainer::compareComplexType(
@@ -545,7 +570,7 @@ int32_t RowContainer::compareComplexType(
 
 template <TypeKind Kind>
 void RowContainer::hashTyped(
-    const Type* type,
+    const Type* /*type*/,
     RowColumn column,
     bool nullable,
     folly::Range<char**> rows,
@@ -564,16 +589,14 @@ void RowContainer::hashTyped(
                       : BaseVector::kNullHash;
     } else {
       uint64_t hash;
-      if (Kind == TypeKind::VARCHAR || Kind == TypeKind::VARBINARY) {
+      if (Kind == TypeKind::VARCHAR || Kind == TypeKind::VARBINARY ||
+          Kind == TypeKind::ROW || Kind == TypeKind::ARRAY ||
+          Kind == TypeKind::MAP) {
+        // Complex type values are hashed by their serialization, like
+        // VectorHasher does.
         hash =
             folly::hasher<StringView>()(HashStringAllocator::contiguousString(
                 valueAt<StringView>(row, offset), storage));
-      } else if (
-          Kind == TypeKind::ROW || Kind == TypeKind::ARRAY ||
-          Kind == TypeKind::MAP) {
-        ByteStream in;
-        prepareRead(row, offset, in);
-        hash = ContainerRowSerde::hash(in, type);
       } else {
         hash = folly::hasher<T>()(valueAt<T>(row, offset));
       }
@@ -18,7 +18,7 @@
 #include "velox/common/memory/HashStringAllocator.h"
 #include "velox/common/memory/MemoryAllocator.h"
 #include "velox/core/PlanNode.h"
-#include "velox/exec/ContainerRowSerde.h"
+#include "velox/exec/ByteComparableSerde.h"
 #include "velox/exec/Spill.h"
 #include "velox/vector/FlatVector.h"
 #include "velox/vector/VectorTypeUtils.h"
@@ -29,14 +29,32 @@ class Aggregate;
 
 class Accumulator {
  public:
+  using SpillExtractFunction =
+      std::function<void(folly::Range<char**> groups, VectorPtr& result)>;
+
+  Accumulator(
+      bool isFixedSize,
+      int32_t fixedSize,
+      bool usesExternalMemory,
+      int32_t alignment,
+      std::function<void(folly::Range<char**> groups)> destroyFunction);
+
+  /// Creates an accumulator that can be spilled. 'spillExtractFunction'
+  /// extracts the accumulators of the specified groups into a vector of
+  /// 'spillType'.
   Accumulator(
       bool isFixedSize,
       int32_t fixedSize,
       bool usesExternalMemory,
       int32_t alignment,
+      TypePtr spillType,
+      SpillExtractFunction spillExtractFunction,
       std::function<void(folly::Range<char**> groups)> destroyFunction);
 
-  explicit Accumulator(Aggregate* aggregate);
+  /// Creates an accumulator for 'aggregate'. 'spillType' is the intermediate
+  /// type of the aggregate. The accumulator can only be spilled if
+  /// 'spillType' is specified.
+  explicit Accumulator(Aggregate* aggregate, TypePtr spillType = nullptr);
 
   bool isFixedSize() const;
 
@@ -48,19 +66,22 @@ class Accumulator {
 
   void destroy(folly::Range<char**> groups);
 
-  /// Used only for spilling. Do not introduce other usages.
-  Aggregate* aggregateForSpill() const {
-    VELOX_CHECK_NOT_NULL(aggregate_);
-    return aggregate_;
-  }
+  /// Returns the type of the vector produced by extractForSpill(). Used only
+  /// for spilling.
+  const TypePtr& spillType() const;
+
+  /// Extracts the accumulators of 'groups' into 'result' for spilling. Used
+  /// only for spilling. Do not introduce other usages.
+  void extractForSpill(folly::Range<char**> groups, VectorPtr& result) const;
 
  private:
   const bool isFixedSize_;
   const int32_t fixedSize_;
   const bool usesExternalMemory_;
   const int32_t alignment_;
+  const TypePtr spillType_;
+  SpillExtractFunction spillExtractFunction_;
   std::function<void(folly::Range<char**> groups)> destroyFunction_;
-  Aggregate* aggregate_{nullptr};
 };
 
 using normalized_key_t = uint64_t;
@@ -204,8 +225,9 @@ class RowContainer {
   // join. 'hasNormalizedKey' specifies that an extra word is left
   // below each row for a normalized key that collapses all parts
   // into one word for faster comparison. The bulk allocation is done
-  // from 'allocator'. ContainerRowSerde is used for serializing complex
-  // type values into the container.
+  // from 'allocator'. ByteComparableSerde is used for serializing complex
+  // type values into the container, so that these hash and compare as
+  // strings.
   /// ''stringAllocator' allows sharing the variable length data arena with
   /// another RowContainer. this is
   // needed for spilling where the same aggregates are used for
@@ -552,7 +574,8 @@ class RowContainer {
 
   // Allows get/set of the normalized key. If normalized keys are
   // used, they are stored in the word immediately below the hash
-  // table row.
+  // table row. A hash table in kHash mode may keep the hash of the keys
+  // in the same word as a fingerprint.
   static inline normalized_key_t& normalizedKey(char* FOLLY_NONNULL group) {
     return reinterpret_cast<normalized_key_t*>(group)[-1];
   }
@@ -878,11 +901,6 @@ class RowContainer {
     }
   }
 
-  static void prepareRead(
-      const char* FOLLY_NONNULL row,
-      int32_t offset,
-      ByteStream& stream);
-
   template <TypeKind Kind>
   void hashTyped(
       const Type* FOLLY_NONNULL type,
@@ -908,7 +926,9 @@ class RowContainer {
     }
     if (Kind == TypeKind::ROW || Kind == TypeKind::ARRAY ||
         Kind == TypeKind::MAP) {
-      return compareComplexType(row, offset, decoded, index) == 0;
+      return compareComplexType(
+                 row, offset, decoded, index, CompareFlags{true, true, true}) ==
+          0;
     }
     if (Kind == TypeKind::VARCHAR || Kind == TypeKind::VARBINARY) {
       return compareStringAsc(
@@ -927,7 +947,9 @@ class RowContainer {
 
     if (Kind == TypeKind::ROW || Kind == TypeKind::ARRAY ||
         Kind == TypeKind::MAP) {
-      return compareComplexType(row, offset, decoded, index) == 0;
+      return compareComplexType(
+                 row, offset, decoded, index, CompareFlags{true, true, true}) ==
+          0;
     }
     if (Kind == TypeKind::VARCHAR || Kind == TypeKind::VARBINARY) {
       return compareStringAsc(
@@ -955,7 +977,7 @@ class RowContainer {
     }
     if (Kind == TypeKind::ROW || Kind == TypeKind::ARRAY ||
         Kind == TypeKind::MAP) {
-      return compareComplexType(row, column.offset(), decoded, index);
+      return compareComplexType(row, column.offset(), decoded, index, flags);
     }
     if (Kind == TypeKind::VARCHAR || Kind == TypeKind::VARBINARY) {
       auto result = compareStringAsc(
@@ -1049,7 +1071,7 @@ class RowContainer {
       RowColumn column,
       int32_t resultOffset,
       const VectorPtr& result) {
-    ByteStream stream;
+    std::string storage;
     auto nullByte = column.nullByte();
     auto nullMask = column.nullMask();
     auto offset = column.offset();
@@ -1067,8 +1089,11 @@ class RowContainer {
       if (!row || isNullAt(row, nullByte, nullMask)) {
         result->setNull(resultIndex, true);
       } else {
-        prepareRead(row, offset, stream);
-        ContainerRowSerde::deserialize(stream, resultIndex, result.get());
+        ByteComparableSerde::deserialize(
+            HashStringAllocator::contiguousString(
+                valueAt<StringView>(row, offset), storage),
+            resultIndex,
+            result.get());
       }
     }
   }
@@ -14,6 +14,7 @@
  * limitations under the License.
  */
 #include "velox/exec/RowNumber.h"
+#include "velox/exec/OperatorUtils.h"
 
 namespace facebook::velox::exec {
 
@@ -26,10 +27,14 @@ RowNumber::RowNumber(
           rowNumberNode->outputType(),
           operatorId,
           rowNumberNode->id(),
-          "RowNumber"),
+          "RowNumber",
+          rowNumberNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
       limit_{rowNumberNode->limit()},
-      generateRowNumber_{rowNumberNode->generateRowNumber()} {
-  const auto& inputType = rowNumberNode->sources()[0]->outputType();
+      generateRowNumber_{rowNumberNode->generateRowNumber()},
+      inputType_{rowNumberNode->sources()[0]->outputType()} {
+  const auto& inputType = inputType_;
   const auto& keys = rowNumberNode->partitionKeys();
   const auto numKeys = keys.size();
 
@@ -47,6 +52,18 @@ RowNumber::RowNumber(
 
     const auto numRowsColumn = table_->rows()->columnAt(numKeys);
     numRowsOffset_ = numRowsColumn.offset();
+
+    if (spillEnabled()) {
+      std::vector<std::string> names;
+      std::vector<TypePtr> types;
+      for (const auto& hasher : table_->hashers()) {
+        names.push_back(inputType->nameOf(hasher->channel()));
+        types.push_back(hasher->type());
+      }
+      names.push_back("numRows");
+      types.push_back(BIGINT());
+      spillerStoreType_ = ROW(std::move(names), std::move(types));
+    }
   }
 
   identityProjections_.reserve(inputType->size());
@@ -61,20 +78,252 @@ RowNumber::RowNumber(
 }
 
 void RowNumber::addInput(RowVectorPtr input) {
-  const auto numInput = input->size();
+  if (spillEnabled()) {
+    if (inputSpiller_ == nullptr) {
+      maybeTestSpill();
+    }
+    if (inputSpiller_ != nullptr) {
+      spillInput(input);
+      return;
+    }
+  }
 
   if (table_) {
-    SelectivityVector rows(numInput);
-    table_->prepareForProbe(*lookup_, input, rows, false);
-    table_->groupProbe(*lookup_);
+    // Prevents the memory arbitrator to reclaim memory from this operator
+    // while the hash table is being updated.
+    NonReclaimableSection guard(this);
+    probeTable(input);
+  }
+
+  input_ = std::move(input);
+}
+
+void RowNumber::probeTable(const RowVectorPtr& input) {
+  SelectivityVector rows(input->size());
+  table_->prepareForProbe(*lookup_, input, rows, false);
+  table_->groupProbe(*lookup_);
+
+  // Initialize new partitions with zeros.
+  for (auto i : lookup_->newGroups) {
+    setNumRows(lookup_->hits[i], 0);
+  }
+}
+
+void RowNumber::noMoreInput() {
+  Operator::noMoreInput();
+  if (inputSpiller_ == nullptr) {
+    return;
+  }
+
+  spiller_->finishSpill(spillTablePartitionSet_);
+  inputSpiller_->finishSpill(spillInputPartitionSet_);
+  recordSpillStats(spiller_->stats());
+  recordSpillStats(inputSpiller_->stats());
+
+  // A partition may have spilled hash table rows, spilled input or both.
+  std::set<SpillPartitionId> partitionIds;
+  for (const auto& [id, _] : spillTablePartitionSet_) {
+    partitionIds.insert(id);
+  }
+  for (const auto& [id, _] : spillInputPartitionSet_) {
+    partitionIds.insert(id);
+  }
+  spillPartitionIds_.assign(partitionIds.begin(), partitionIds.end());
+}
+
+void RowNumber::reclaim(
+    uint64_t /*targetBytes*/,
+    memory::MemoryReclaimer::Stats& stats) {
+  VELOX_CHECK(canReclaim());
+
+  // NOTE: a row number operator is reclaimable if it hasn't started restoring
+  // the spilled partitions and is not under non-reclaimable execution section.
+  if (noMoreInput_ || nonReclaimableSection_) {
+    ++stats.numNonReclaimableAttempts;
+    LOG(WARNING) << "Can't reclaim from row number operator, noMoreInput_["
+                 << noMoreInput_ << "], nonReclaimableSection_["
+                 << nonReclaimableSection_ << "], " << pool()->name();
+    return;
+  }
+
+  // The hash table is spilled at most once. All the input after that goes to
+  // disk.
+  if (spiller_ != nullptr || table_->numDistinct() == 0) {
+    return;
+  }
+  spill();
+}
+
+void RowNumber::maybeTestSpill() {
+  if (spillConfig_->testSpillPct == 0 || table_->numDistinct() == 0) {
+    return;
+  }
+  if (folly::hasher<uint64_t>()(++spillTestCounter_) % 100 <=
+      spillConfig_->testSpillPct) {
+    spill();
+  }
+}
+
+void RowNumber::spill() {
+  VELOX_CHECK(spillEnabled());
+  VELOX_CHECK_NULL(spiller_);
+
+  const auto& spillConfig = spillConfig_.value();
+  // The hash table and the input are partitioned the same way as the build and
+  // probe sides of a hash join.
+  HashBitRange hashBits(
+      spillConfig.startPartitionBit,
+      spillConfig.startPartitionBit + spillConfig.joinPartitionBits);
+  spiller_ = std::make_unique<Spiller>(
+      Spiller::Type::kHashJoinBuild,
+      table_->rows(),
+      [&](folly::Range<char**> rows) { table_->rows()->eraseRows(rows); },
+      spillerStoreType_,
+      hashBits,
+      table_->hashers().size(),
+      std::vector<CompareFlags>(),
+      spillConfig.filePath,
+      spillConfig.maxFileSize,
+      spillConfig.writeBufferSize,
+      spillConfig.minSpillRunSize,
+      spillConfig.compressionKind,
+      Spiller::pool(),
+      spillConfig.executor,
+      spillConfig.writeRateLimiter);
+
+  std::vector<Spiller::SpillableStats> spillableStats;
+  spiller_->fillSpillRuns(spillableStats);
+  spiller_->spill();
+  table_->clear();
+  pool()->release();
 
-    // Initialize new partitions with zeros.
-    for (auto i : lookup_->newGroups) {
-      setNumRows(lookup_->hits[i], 0);
+  inputSpiller_ = std::make_unique<Spiller>(
+      Spiller::Type::kHashJoinProbe,
+      inputType_,
+      hashBits,
+      spillConfig.filePath,
+      spillConfig.maxFileSize,
+      spillConfig.writeBufferSize,
+      spillConfig.minSpillRunSize,
+      spillConfig.compressionKind,
+      Spiller::pool(),
+      spillConfig.executor,
+      spillConfig.writeRateLimiter);
+  inputSpiller_->setPartitionsSpilled(spiller_->spilledPartitionSet());
+
+  std::vector<column_index_t> keyChannels;
+  for (const auto& hasher : table_->hashers()) {
+    keyChannels.push_back(hasher->channel());
+  }
+  spillHashFunction_ = std::make_unique<HashPartitionFunction>(
+      hashBits, inputType_, keyChannels);
+  spillInputIndicesBuffers_.resize(spillHashFunction_->numPartitions());
+  numSpillInputs_.resize(spillHashFunction_->numPartitions());
+
+  // 'input_' has been added to the hash table but not assigned row numbers
+  // yet. It is processed again after its partition is restored.
+  if (input_ != nullptr) {
+    spillInput(input_);
+    input_ = nullptr;
+  }
+}
+
+void RowNumber::spillInput(const RowVectorPtr& input) {
+  // Ensure vector are lazy loaded before spilling.
+  for (auto i = 0; i < input->childrenSize(); ++i) {
+    input->childAt(i)->loadedVector();
+  }
+
+  const auto singlePartition =
+      spillHashFunction_->partition(*input, spillPartitions_);
+  if (singlePartition.has_value()) {
+    inputSpiller_->spill(singlePartition.value(), input);
+    return;
+  }
+
+  const auto numInput = input->size();
+  const auto maxIndicesBufferBytes = numInput * sizeof(vector_size_t);
+  for (auto& buffer : spillInputIndicesBuffers_) {
+    if (buffer == nullptr || buffer->size() < maxIndicesBufferBytes) {
+      buffer = allocateIndices(numInput, pool());
     }
   }
+  std::fill(numSpillInputs_.begin(), numSpillInputs_.end(), 0);
+  for (auto row = 0; row < numInput; ++row) {
+    const auto partition = spillPartitions_[row];
+    spillInputIndicesBuffers_[partition]
+        ->asMutable<vector_size_t>()[numSpillInputs_[partition]++] = row;
+  }
 
-  input_ = std::move(input);
+  for (auto partition = 0; partition < numSpillInputs_.size(); ++partition) {
+    const auto numSpillInputs = numSpillInputs_[partition];
+    if (numSpillInputs == 0) {
+      continue;
+    }
+    inputSpiller_->spill(
+        partition,
+        wrap(numSpillInputs, spillInputIndicesBuffers_[partition], input));
+  }
+}
+
+void RowNumber::addSpillInput() {
+  VELOX_CHECK_NULL(input_);
+  for (;;) {
+    if (spillInputReader_ != nullptr) {
+      RowVectorPtr input;
+      if (spillInputReader_->nextBatch(input)) {
+        probeTable(input);
+        input_ = std::move(input);
+        return;
+      }
+      spillInputReader_.reset();
+    }
+    if (spillPartitionIds_.empty()) {
+      return;
+    }
+    restoreNextSpillPartition();
+  }
+}
+
+void RowNumber::restoreNextSpillPartition() {
+  const auto id = spillPartitionIds_.front();
+  spillPartitionIds_.pop_front();
+  table_->clear();
+
+  auto tableIt = spillTablePartitionSet_.find(id);
+  if (tableIt != spillTablePartitionSet_.end()) {
+    auto reader = tableIt->second->createReader();
+    spillTablePartitionSet_.erase(tableIt);
+
+    const auto& hashers = table_->hashers();
+    RowVectorPtr data;
+    while (reader->nextBatch(data)) {
+      // Lay out the spilled partitioning keys as in the input to insert them
+      // into the hash table. The other input columns are not accessed.
+      const auto numRows = data->size();
+      std::vector<VectorPtr> children(inputType_->size());
+      for (auto i = 0; i < inputType_->size(); ++i) {
+        children[i] = BaseVector::createNullConstant(
+            inputType_->childAt(i), numRows, pool());
+      }
+      for (auto i = 0; i < hashers.size(); ++i) {
+        children[hashers[i]->channel()] = data->childAt(i);
+      }
+      probeTable(std::make_shared<RowVector>(
+          pool(), inputType_, nullptr, numRows, std::move(children)));
+
+      DecodedVector numRowsDecoded(*data->childAt(hashers.size()));
+      for (auto i = 0; i < numRows; ++i) {
+        setNumRows(lookup_->hits[i], numRowsDecoded.valueAt<int64_t>(i));
+      }
+    }
+  }
+
+  auto inputIt = spillInputPartitionSet_.find(id);
+  if (inputIt != spillInputPartitionSet_.end()) {
+    spillInputReader_ = inputIt->second->createReader();
+    spillInputPartitionSet_.erase(inputIt);
+  }
 }
 
 FlatVector<int64_t>& RowNumber::getOrCreateRowNumberVector(vector_size_t size) {
@@ -88,6 +337,9 @@ FlatVector<int64_t>& RowNumber::getOrCreateRowNumberVector(vector_size_t size) {
 }
 
 RowVectorPtr RowNumber::getOutput() {
+  if (input_ == nullptr && noMoreInput_) {
+    addSpillInput();
+  }
   if (input_ == nullptr) {
     return nullptr;
   }
@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/exec/HashPartitionFunction.h"
 #include "velox/exec/HashTable.h"
 #include "velox/exec/Operator.h"
 
@@ -39,11 +40,46 @@ class RowNumber : public Operator {
     return BlockingReason::kNotBlocked;
   }
 
+  void noMoreInput() override;
+
   bool isFinished() override {
-    return (noMoreInput_ && input_ == nullptr) || finishedEarly_;
+    return (noMoreInput_ && input_ == nullptr && spillInputReader_ == nullptr &&
+            spillPartitionIds_.empty()) ||
+        finishedEarly_;
   }
 
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
  private:
+  bool spillEnabled() const {
+    return spillConfig_.has_value();
+  }
+
+  // Spills the hash table if the test-only spill percentage triggers.
+  void maybeTestSpill();
+
+  // Spills all the partitions of the hash table to disk and clears the table.
+  // All the input received after that is spilled as well, including 'input_'
+  // if it has not been processed yet. The spilled partitions are restored one
+  // at a time after all the input has been received.
+  void spill();
+
+  // Appends the rows of 'input' to the spill files of their partitions.
+  void spillInput(const RowVectorPtr& input);
+
+  // Probes the hash table with 'input' and initializes the new partitions.
+  void probeTable(const RowVectorPtr& input);
+
+  // Reads the next batch of spilled input into 'input_'. Restores the next
+  // spilled partition of the hash table when the input of the current one has
+  // been consumed. Leaves 'input_' null if there is no more spilled input.
+  void addSpillInput();
+
+  // Loads the hash table rows of the next spilled partition into 'table_' and
+  // sets 'spillInputReader_' to read the spilled input of the same partition.
+  void restoreNextSpillPartition();
+
   int64_t numRows(char* partition);
 
   void setNumRows(char* partition, int64_t numRows);
@@ -54,6 +90,7 @@ class RowNumber : public Operator {
 
   const std::optional<int32_t> limit_;
   const bool generateRowNumber_;
+  const RowTypePtr inputType_;
 
   /// Hash table to store number of rows seen so far per partition. Not used if
   /// there are no partitioning keys.
@@ -69,5 +106,34 @@ class RowNumber : public Operator {
   /// the input. This happens when there are no partitioning keys and the
   /// operator already received 'limit_' rows.
   bool finishedEarly_{false};
+
+  // The row type of the spilled hash table rows: the partitioning keys
+  // followed by the number of rows seen so far.
+  RowTypePtr spillerStoreType_;
+
+  // Spills the hash table rows.
+  std::unique_ptr<Spiller> spiller_;
+
+  // Spills the input received after the hash table has been spilled.
+  std::unique_ptr<Spiller> inputSpiller_;
+
+  // Assigns spill partitions to the input rows. Uses the same hash bits as
+  // 'spiller_' so that the spilled input rows and the hash table rows of the
+  // same partitioning key land in the same spill partition.
+  std::unique_ptr<HashPartitionFunction> spillHashFunction_;
+  std::vector<uint32_t> spillPartitions_;
+  std::vector<BufferPtr> spillInputIndicesBuffers_;
+  std::vector<vector_size_t> numSpillInputs_;
+
+  SpillPartitionSet spillTablePartitionSet_;
+  SpillPartitionSet spillInputPartitionSet_;
+
+  // Ids of the spilled partitions which have not been restored yet.
+  std::deque<SpillPartitionId> spillPartitionIds_;
+
+  std::unique_ptr<UnorderedStreamReader<BatchStream>> spillInputReader_;
+
+  // Counts the input batches for the test-only spill path.
+  uint32_t spillTestCounter_{0};
 };
 } // namespace facebook::velox::exec
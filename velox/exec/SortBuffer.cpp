@@ -15,10 +15,57 @@
  */
 
 #include "SortBuffer.h"
+#include "velox/exec/PrefixSort.h"
 #include "velox/vector/BaseVector.h"
 
 namespace facebook::velox::exec {
 
+namespace {
+// A sorted run of rows of a RowContainer to merge with the runs of other
+// sort buffers. The rows of all runs have the layout of 'data'.
+class SortedRowsStream : public MergeStream {
+ public:
+  SortedRowsStream(
+      RowContainer* data,
+      const std::vector<CompareFlags>& compareFlags,
+      std::vector<char*> rows)
+      : data_(data), compareFlags_(compareFlags), rows_(std::move(rows)) {}
+
+  bool hasData() const override {
+    return index_ < rows_.size();
+  }
+
+  bool operator<(const MergeStream& other) const override {
+    return compare(other) < 0;
+  }
+
+  int32_t compare(const MergeStream& other) const override {
+    const auto* otherRow = static_cast<const SortedRowsStream&>(other).row();
+    for (auto index = 0; index < compareFlags_.size(); ++index) {
+      if (auto result =
+              data_->compare(row(), otherRow, index, compareFlags_[index])) {
+        return result;
+      }
+    }
+    return 0;
+  }
+
+  char* row() const {
+    return rows_[index_];
+  }
+
+  void pop() {
+    ++index_;
+  }
+
+ private:
+  RowContainer* const data_;
+  const std::vector<CompareFlags>& compareFlags_;
+  const std::vector<char*> rows_;
+  size_t index_{0};
+};
+} // namespace
+
 SortBuffer::SortBuffer(
     const RowTypePtr& input,
     const std::vector<column_index_t>& sortColumnIndices,
@@ -125,19 +172,23 @@ void SortBuffer::noMoreInput() {
     sortedRows_.resize(numInputRows_);
     RowContainerIterator iter;
     data_->listRows(&iter, numInputRows_, sortedRows_.data());
-    std::sort(
-        sortedRows_.begin(),
-        sortedRows_.end(),
-        [this](const char* leftRow, const char* rightRow) {
-          for (vector_size_t index = 0; index < sortCompareFlags_.size();
-               ++index) {
-            if (auto result = data_->compare(
-                    leftRow, rightRow, index, sortCompareFlags_[index])) {
-              return result < 0;
+    // Sorts on a normalized prefix of the leading fixed width keys if there
+    // is one, otherwise compares the keys in the rows.
+    if (!PrefixSort::sort(*data_, sortCompareFlags_, sortedRows_)) {
+      std::sort(
+          sortedRows_.begin(),
+          sortedRows_.end(),
+          [this](const char* leftRow, const char* rightRow) {
+            for (vector_size_t index = 0; index < sortCompareFlags_.size();
+                 ++index) {
+              if (auto result = data_->compare(
+                      leftRow, rightRow, index, sortCompareFlags_[index])) {
+                return result < 0;
+              }
             }
-          }
-          return false;
-        });
+            return false;
+          });
+    }
   } else {
     // Finish spill, and we shouldn't get any rows from non-spilled partition as
     // there is only one hash partition for SortBuffer.
@@ -167,6 +218,46 @@ RowVectorPtr SortBuffer::getOutput() {
   return output_;
 }
 
+void SortBuffer::merge(std::vector<std::unique_ptr<SortBuffer>> others) {
+  VELOX_CHECK(noMoreInput_);
+  VELOX_CHECK_NULL(spiller_);
+  VELOX_CHECK_EQ(numOutputRows_, 0);
+  if (others.empty()) {
+    return;
+  }
+
+  std::vector<std::unique_ptr<SortedRowsStream>> streams;
+  streams.reserve(others.size() + 1);
+  if (!sortedRows_.empty()) {
+    streams.push_back(std::make_unique<SortedRowsStream>(
+        data_.get(), sortCompareFlags_, std::move(sortedRows_)));
+  }
+  for (auto& other : others) {
+    VELOX_CHECK(other->noMoreInput_);
+    VELOX_CHECK_NULL(other->spiller_);
+    VELOX_CHECK(other->input_->equivalent(*input_));
+    VELOX_CHECK_EQ(other->data_->keyTypes().size(), data_->keyTypes().size());
+    if (!other->sortedRows_.empty()) {
+      streams.push_back(std::make_unique<SortedRowsStream>(
+          data_.get(), sortCompareFlags_, std::move(other->sortedRows_)));
+    }
+    numInputRows_ += other->numInputRows_;
+    mergedBuffers_.push_back(std::move(other));
+  }
+
+  sortedRows_.clear();
+  if (streams.empty()) {
+    return;
+  }
+  sortedRows_.reserve(numInputRows_);
+  TreeOfLosers<SortedRowsStream> merger(std::move(streams));
+  while (auto* stream = merger.next()) {
+    sortedRows_.push_back(stream->row());
+    stream->pop();
+  }
+  VELOX_CHECK_EQ(sortedRows_.size(), numInputRows_);
+}
+
 void SortBuffer::spill(int64_t targetRows, int64_t targetBytes) {
   VELOX_CHECK_NOT_NULL(
       spillConfig_, "spill config is null when SortBuffer spill is called");
@@ -193,7 +284,8 @@ void SortBuffer::spill(int64_t targetRows, int64_t targetBytes) {
         spillConfig_->minSpillRunSize,
         spillConfig_->compressionKind,
         Spiller::pool(),
-        spillConfig_->executor);
+        spillConfig_->executor,
+        spillConfig_->writeRateLimiter);
     VELOX_CHECK_EQ(spiller_->state().maxPartitions(), 1);
   }
 
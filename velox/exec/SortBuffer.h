@@ -52,6 +52,13 @@ class SortBuffer {
   /// Returns the sorted output rows in batch.
   RowVectorPtr getOutput();
 
+  /// Merges the sorted rows of 'others' with the sorted rows of 'this' so that
+  /// getOutput() returns the rows of all of them in order. 'this' takes
+  /// ownership of 'others', which must be sort buffers of the same input type
+  /// and sort keys. All of them must have received noMoreInput() without
+  /// having spilled, and no output may have been returned yet.
+  void merge(std::vector<std::unique_ptr<SortBuffer>> others);
+
   /// Invoked to spill from 'data_' to disk with specified targets.
   ///
   /// NOTE: if either 'targetRows' or 'targetBytes' is zero, then we spill all
@@ -104,6 +111,9 @@ class SortBuffer {
   // Used to store the input data in row format.
   std::unique_ptr<RowContainer> data_;
   std::vector<char*> sortedRows_;
+  // The sort buffers merged into 'this' by merge(). 'sortedRows_' may point
+  // to rows in their RowContainers.
+  std::vector<std::unique_ptr<SortBuffer>> mergedBuffers_;
 
   // The data type of the rows stored in 'data_' and spilled on disk. The
   // sort key columns are stored first then the non-sorted data columns.
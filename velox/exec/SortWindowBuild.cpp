@@ -18,19 +18,69 @@
 
 namespace facebook::velox::exec {
 
+namespace {
+CompareFlags fromSortOrderToCompareFlags(const core::SortOrder& sortOrder) {
+  return {
+      sortOrder.isNullsFirst(),
+      sortOrder.isAscending(),
+      false,
+      CompareFlags::NullHandlingMode::NoStop};
+}
+} // namespace
+
 SortWindowBuild::SortWindowBuild(
     const std::shared_ptr<const core::WindowNode>& windowNode,
-    velox::memory::MemoryPool* pool)
-    : WindowBuild(windowNode, pool) {
+    velox::memory::MemoryPool* pool,
+    tsan_atomic<bool>* nonReclaimableSection,
+    uint32_t* numSpillRuns,
+    const common::SpillConfig* spillConfig,
+    uint64_t spillMemoryThreshold)
+    : WindowBuild(windowNode, pool),
+      pool_(pool),
+      nonReclaimableSection_(nonReclaimableSection),
+      numSpillRuns_(numSpillRuns),
+      spillConfig_(numKeyColumns_ > 0 ? spillConfig : nullptr),
+      spillMemoryThreshold_(spillMemoryThreshold) {
+  VELOX_CHECK_NOT_NULL(nonReclaimableSection_);
+  VELOX_CHECK_NOT_NULL(numSpillRuns_);
   allKeyInfo_.reserve(partitionKeyInfo_.size() + sortKeyInfo_.size());
   allKeyInfo_.insert(
       allKeyInfo_.cend(), partitionKeyInfo_.begin(), partitionKeyInfo_.end());
   allKeyInfo_.insert(
       allKeyInfo_.cend(), sortKeyInfo_.begin(), sortKeyInfo_.end());
   partitionStartRows_.resize(0);
+
+  // The key columns of 'data_' are numbered in the order of their first
+  // appearance in 'allKeyInfo_'. Later appearances of a column don't affect
+  // the ordering.
+  spillCompareFlags_.reserve(numKeyColumns_);
+  for (const auto& key : allKeyInfo_) {
+    if (key.first == spillCompareFlags_.size()) {
+      spillCompareFlags_.push_back(fromSortOrderToCompareFlags(key.second));
+    }
+  }
+  VELOX_CHECK_EQ(spillCompareFlags_.size(), numKeyColumns_);
+
+  const auto& inputType = windowNode->sources()[0]->outputType();
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  names.reserve(inputChannels_.size());
+  types.reserve(inputChannels_.size());
+  for (auto channel : inputChannels_) {
+    names.push_back(inputType->nameOf(channel));
+    types.push_back(inputType->childAt(channel));
+  }
+  spillerStoreType_ = ROW(std::move(names), std::move(types));
 }
 
 void SortWindowBuild::addInput(RowVectorPtr input) {
+  ensureInputFits(input);
+
+  // Prevents the memory arbitrator to reclaim memory from this build during
+  // the execution below.
+  auto guard = folly::makeGuard([this]() { *nonReclaimableSection_ = false; });
+  *nonReclaimableSection_ = true;
+
   for (auto col = 0; col < input->childrenSize(); ++col) {
     decodedInputVectors_[col].decode(*input->childAt(col));
   }
@@ -38,14 +88,134 @@ void SortWindowBuild::addInput(RowVectorPtr input) {
   // Add all the rows into the RowContainer.
   for (auto row = 0; row < input->size(); ++row) {
     char* newRow = data_->newRow();
-
-    for (auto col = 0; col < input->childrenSize(); ++col) {
-      data_->store(decodedInputVectors_[col], row, newRow, col);
-    }
+    storeRow(row, newRow);
   }
   numRows_ += input->size();
 }
 
+void SortWindowBuild::spill(int64_t targetRows, int64_t targetBytes) {
+  VELOX_CHECK_NOT_NULL(
+      spillConfig_, "spill config is null when SortWindowBuild spill is called");
+  VELOX_CHECK_GE(targetRows, 0);
+  VELOX_CHECK_GE(targetBytes, 0);
+
+  // Check if the build is empty or not, and skip spill if it is empty.
+  if (data_->numRows() == 0) {
+    return;
+  }
+
+  ++(*numSpillRuns_);
+  if (spiller_ == nullptr) {
+    spiller_ = std::make_unique<Spiller>(
+        Spiller::Type::kOrderBy,
+        data_.get(),
+        [&](folly::Range<char**> rows) { data_->eraseRows(rows); },
+        spillerStoreType_,
+        data_->keyTypes().size(),
+        spillCompareFlags_,
+        spillConfig_->filePath,
+        std::numeric_limits<uint64_t>::max(),
+        spillConfig_->writeBufferSize,
+        spillConfig_->minSpillRunSize,
+        spillConfig_->compressionKind,
+        Spiller::pool(),
+        spillConfig_->executor,
+        spillConfig_->writeRateLimiter);
+    VELOX_CHECK_EQ(spiller_->state().maxPartitions(), 1);
+  }
+
+  spiller_->spill(targetRows, targetBytes);
+
+  if (targetRows == 0 || targetBytes == 0) {
+    VELOX_CHECK_EQ(data_->numRows(), 0);
+  }
+  // NOTE: we only support releasing all the memory when we spill everything
+  // as for SortBuffer.
+  if (data_->numRows() == 0) {
+    data_->clear();
+  }
+}
+
+void SortWindowBuild::ensureInputFits(const RowVectorPtr& input) {
+  // Check if spilling is enabled or not.
+  if (spillConfig_ == nullptr) {
+    return;
+  }
+
+  const int64_t numRows = data_->numRows();
+  if (numRows == 0) {
+    // 'data_' is empty. Nothing to spill.
+    return;
+  }
+
+  auto [freeRows, outOfLineFreeBytes] = data_->freeSpace();
+  const auto outOfLineBytes =
+      data_->stringAllocator().retainedSize() - outOfLineFreeBytes;
+  const int64_t outOfLineBytesPerRow = outOfLineBytes / numRows;
+  const int64_t flatInputBytes = input->estimateFlatSize();
+
+  // Test-only spill path.
+  if (spillConfig_->testSpillPct &&
+      (folly::hasher<uint64_t>()(++spillTestCounter_)) % 100 <=
+          spillConfig_->testSpillPct) {
+    const int64_t rowsToSpill = std::max<int64_t>(1, numRows / 10);
+    spill(
+        numRows - rowsToSpill,
+        outOfLineBytes - (rowsToSpill * outOfLineBytesPerRow));
+    return;
+  }
+
+  // If current memory usage exceeds spilling threshold, trigger spilling.
+  const auto currentMemoryUsage = pool_->currentBytes();
+  if (spillMemoryThreshold_ != 0 &&
+      currentMemoryUsage > spillMemoryThreshold_) {
+    const int64_t bytesToSpill =
+        currentMemoryUsage * spillConfig_->spillableReservationGrowthPct / 100;
+    auto rowsToSpill = std::max<int64_t>(
+        1, bytesToSpill / (data_->fixedRowSize() + outOfLineBytesPerRow));
+    spill(
+        std::max<int64_t>(0, numRows - rowsToSpill),
+        std::max<int64_t>(
+            0, outOfLineBytes - (rowsToSpill * outOfLineBytesPerRow)));
+    return;
+  }
+
+  // If we have enough free rows for input rows and enough variable length
+  // free space for the vector's flat size, no need for spilling.
+  if (freeRows > input->size() &&
+      (outOfLineBytes == 0 || outOfLineFreeBytes >= flatInputBytes)) {
+    return;
+  }
+
+  // For variable length data, we take the flat size of the input as the cap.
+  const int64_t estimatedIncrementalBytes =
+      data_->sizeIncrement(input->size(), outOfLineBytes ? flatInputBytes : 0);
+
+  // If the current available reservation in memory pool is 2X the
+  // estimatedIncrementalBytes, no need to spill.
+  if (pool_->availableReservation() > 2 * estimatedIncrementalBytes) {
+    return;
+  }
+
+  // Try reserving targetIncrementBytes more in memory pool, if succeed, no
+  // need to spill.
+  const auto targetIncrementBytes = std::max<int64_t>(
+      estimatedIncrementalBytes * 2,
+      currentMemoryUsage * spillConfig_->spillableReservationGrowthPct / 100);
+  if (pool_->maybeReserve(targetIncrementBytes)) {
+    return;
+  }
+
+  // NOTE: disk spilling use the system disk spilling memory pool instead of
+  // the operator memory pool.
+  const int64_t rowsToSpill = std::max<int64_t>(
+      1, targetIncrementBytes / (data_->fixedRowSize() + outOfLineBytesPerRow));
+  spill(
+      std::max<int64_t>(0, numRows - rowsToSpill),
+      std::max<int64_t>(
+          0, outOfLineBytes - (rowsToSpill * outOfLineBytesPerRow)));
+}
+
 void SortWindowBuild::computePartitionStartRows() {
   partitionStartRows_.reserve(numRows_);
   auto partitionCompare = [&](const char* lhs, const char* rhs) -> bool {
@@ -94,6 +264,20 @@ void SortWindowBuild::noMoreInput() {
   if (numRows_ == 0) {
     return;
   }
+
+  if (spiller_ != nullptr) {
+    // Finish spill, and we shouldn't get any rows from non-spilled partition as
+    // there is only one hash partition for SortWindowBuild.
+    Spiller::SpillRows nonSpilledRows = spiller_->finishSpill();
+    VELOX_CHECK_LE(spiller_->stats().spilledPartitions, 1);
+    VELOX_CHECK(nonSpilledRows.empty());
+    data_->clear();
+
+    VELOX_CHECK_NULL(merge_);
+    merge_ = spiller_->startMerge(0);
+    nextStream_ = merge_->next();
+    return;
+  }
   // At this point we have seen all the input rows. The operator is
   // being prepared to output rows now.
   // To prepare the rows for output in SortWindowBuild they need to
@@ -102,7 +286,53 @@ void SortWindowBuild::noMoreInput() {
   sortPartitions();
 }
 
+void SortWindowBuild::loadNextPartitionFromSpill() {
+  sortedRows_.clear();
+  data_->clear();
+
+  for (;;) {
+    VELOX_CHECK_NOT_NULL(nextStream_);
+    char* newRow = data_->newRow();
+    for (auto i = 0; i < inputChannels_.size(); ++i) {
+      data_->store(
+          nextStream_->decoded(i), nextStream_->currentIndex(), newRow, i);
+    }
+    sortedRows_.push_back(newRow);
+    nextStream_->pop();
+
+    nextStream_ = merge_->next();
+    if (nextStream_ == nullptr) {
+      break;
+    }
+
+    bool newPartition = false;
+    for (auto i = 0; i < numPartitionKeyColumns_; ++i) {
+      if (!data_->equals<true>(
+              newRow,
+              data_->columnAt(i),
+              nextStream_->decoded(i),
+              nextStream_->currentIndex())) {
+        newPartition = true;
+        break;
+      }
+    }
+    if (newPartition) {
+      break;
+    }
+  }
+}
+
 std::unique_ptr<WindowPartition> SortWindowBuild::nextPartition() {
+  if (merge_ != nullptr) {
+    VELOX_CHECK_NOT_NULL(nextStream_, "All window partitions consumed");
+    loadNextPartitionFromSpill();
+    auto windowPartition = std::make_unique<WindowPartition>(
+        data_.get(), inputColumns_, sortKeyInfo_);
+    windowPartition->resetPartition(
+        folly::Range(sortedRows_.data(), sortedRows_.size()));
+    return windowPartition;
+  }
+
   VELOX_CHECK(partitionStartRows_.size() > 0, "No window partitions available")
 
   currentPartition_++;
@@ -124,6 +354,9 @@ std::unique_ptr<WindowPartition> SortWindowBuild::nextPartition() {
 }
 
 bool SortWindowBuild::hasNextPartition() {
+  if (merge_ != nullptr) {
+    return nextStream_ != nullptr;
+  }
   return partitionStartRows_.size() > 0 &&
       currentPartition_ < int(partitionStartRows_.size() - 2);
 }
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/exec/Spiller.h"
 #include "velox/exec/WindowBuild.h"
 
 namespace facebook::velox::exec {
@@ -23,11 +24,20 @@ namespace facebook::velox::exec {
 // Sorts input data of the Window by {partition keys, sort keys}
 // to identify window partitions. This sort fully orders
 // rows as needed for window function computation.
+//
+// If spilling is enabled, the input rows are spilled as sorted runs when
+// memory runs low. The spilled runs are then merged and the partitions are
+// loaded back into memory one at a time. A single partition must fit in
+// memory.
 class SortWindowBuild : public WindowBuild {
  public:
   SortWindowBuild(
       const std::shared_ptr<const core::WindowNode>& windowNode,
-      velox::memory::MemoryPool* pool);
+      velox::memory::MemoryPool* pool,
+      tsan_atomic<bool>* nonReclaimableSection,
+      uint32_t* numSpillRuns,
+      const common::SpillConfig* spillConfig = nullptr,
+      uint64_t spillMemoryThreshold = 0);
 
   bool needsInput() override {
     // No partitions are available yet, so can consume input rows.
@@ -42,7 +52,23 @@ class SortWindowBuild : public WindowBuild {
 
   std::unique_ptr<WindowPartition> nextPartition() override;
 
+  void spill(int64_t targetRows, int64_t targetBytes) override;
+
+  std::optional<SpillStats> spilledStats() const override {
+    if (spiller_ == nullptr) {
+      return std::nullopt;
+    }
+    return spiller_->stats();
+  }
+
  private:
+  // Ensures there is sufficient memory reserved to process 'input'.
+  void ensureInputFits(const RowVectorPtr& input);
+
+  // Loads the rows of the next partition from 'merge_' into 'data_' and
+  // 'sortedRows_'. The rows of the previous partition are freed.
+  void loadNextPartitionFromSpill();
+
   // Main sorting function loop done after all input rows are received
   // by WindowBuild.
   void sortPartitions();
@@ -73,6 +99,43 @@ class SortWindowBuild : public WindowBuild {
   // Current partition being output. Used to construct WindowPartitions
   // during resetPartition.
   vector_size_t currentPartition_ = -1;
+
+  velox::memory::MemoryPool* const pool_;
+
+  // The flag is passed from the Window operator to indicate if this build is
+  // under non-reclaimable execution section or not.
+  tsan_atomic<bool>* const nonReclaimableSection_;
+
+  // A recorder for number of spill runs passed in from the Window operator.
+  uint32_t* const numSpillRuns_;
+
+  // Null if spilling is disabled. Spilling is also disabled if there are no
+  // partition or sort keys as all input rows form a single partition.
+  const common::SpillConfig* const spillConfig_;
+
+  // The maximum size that the build can hold in memory before spilling. Zero
+  // indicates no limit.
+  const uint64_t spillMemoryThreshold_;
+
+  // The compare flags of the key columns of 'data_' used to sort the spilled
+  // runs.
+  std::vector<CompareFlags> spillCompareFlags_;
+
+  // The type of the rows spilled on disk. The columns are in the order of
+  // 'data_' columns.
+  RowTypePtr spillerStoreType_;
+
+  std::unique_ptr<Spiller> spiller_;
+
+  // Used to merge the sorted runs spilled on disk.
+  std::unique_ptr<TreeOfLosers<SpillMergeStream>> merge_;
+
+  // The stream positioned at the first row of the next partition to load from
+  // 'merge_'. Null if all the spilled rows have been loaded.
+  SpillMergeStream* nextStream_{nullptr};
+
+  // Counts input batches to trigger spilling for test.
+  uint64_t spillTestCounter_{0};
 };
 
 } // namespace facebook::velox::exec
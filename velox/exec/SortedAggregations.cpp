@@ -47,6 +47,7 @@ struct RowPointers {
       allocator.free(firstBlock);
       firstBlock = nullptr;
       currentBlock = {nullptr, nullptr};
+      size = 0;
     }
   }
 
@@ -100,6 +101,7 @@ SortedAggregations::SortedAggregations(
     inputs_.push_back(input);
   }
 
+  spillType_ = ARRAY(ROW(std::vector<TypePtr>(types)));
   inputData_ = std::make_unique<RowContainer>(types, pool);
   decodedInputs_.resize(inputs_.size());
 }
@@ -110,12 +112,56 @@ Accumulator SortedAggregations::accumulator() const {
       sizeof(RowPointers),
       false,
       1,
-      [this](folly::Range<char**> groups) {
-        for (auto* group : groups) {
-          auto* accumulator = reinterpret_cast<RowPointers*>(group + offset_);
-          accumulator->free(*allocator_);
-        }
-      }};
+      spillType_,
+      [this](folly::Range<char**> groups, VectorPtr& result) {
+        extractForSpill(groups, result);
+      },
+      [this](folly::Range<char**> groups) { destroyGroups(groups); }};
+}
+
+void SortedAggregations::destroyGroups(folly::Range<char**> groups) const {
+  for (auto* group : groups) {
+    auto* accumulator = reinterpret_cast<RowPointers*>(group + offset_);
+    if (accumulator->size > 0) {
+      // Erases the input rows of the group to allow the memory to be reused
+      // after the group is spilled.
+      auto rows = accumulator->read(*allocator_);
+      inputData_->eraseRows(folly::Range<char**>(rows.data(), rows.size()));
+    }
+    accumulator->free(*allocator_);
+  }
+}
+
+void SortedAggregations::extractForSpill(
+    folly::Range<char**> groups,
+    VectorPtr& result) const {
+  auto* pool = inputData_->pool();
+  const auto numGroups = groups.size();
+  auto offsets = allocateOffsets(numGroups, pool);
+  auto sizes = allocateSizes(numGroups, pool);
+  auto* rawOffsets = offsets->asMutable<vector_size_t>();
+  auto* rawSizes = sizes->asMutable<vector_size_t>();
+
+  std::vector<char*> groupRows;
+  for (auto i = 0; i < numGroups; ++i) {
+    auto* accumulator = reinterpret_cast<RowPointers*>(groups[i] + offset_);
+    rawOffsets[i] = groupRows.size();
+    rawSizes[i] = accumulator->size;
+    if (accumulator->size > 0) {
+      auto rows = accumulator->read(*allocator_);
+      groupRows.insert(groupRows.end(), rows.begin(), rows.end());
+    }
+  }
+
+  const auto& rowType = spillType_->asArray().elementType();
+  auto elements =
+      BaseVector::create<RowVector>(rowType, groupRows.size(), pool);
+  for (auto i = 0; i < inputs_.size(); ++i) {
+    inputData_->extractColumn(
+        groupRows.data(), groupRows.size(), i, elements->childAt(i));
+  }
+  result = std::make_shared<ArrayVector>(
+      pool, spillType_, nullptr, numGroups, offsets, sizes, elements);
 }
 
 void SortedAggregations::initializeNewGroups(
@@ -174,6 +220,37 @@ void SortedAggregations::addSingleGroupInput(
   }
 }
 
+void SortedAggregations::addSingleGroupSpillInput(
+    char* group,
+    const VectorPtr& input,
+    vector_size_t index) {
+  DecodedVector decodedArray(*input);
+  if (decodedArray.isNullAt(index)) {
+    return;
+  }
+  const auto* arrayVector = decodedArray.base()->as<ArrayVector>();
+  VELOX_CHECK_NOT_NULL(arrayVector);
+  const auto arrayIndex = decodedArray.index(index);
+  const auto offset = arrayVector->offsetAt(arrayIndex);
+  const auto size = arrayVector->sizeAt(arrayIndex);
+
+  const auto* elements = arrayVector->elements()->as<RowVector>();
+  VELOX_CHECK_NOT_NULL(elements);
+  for (auto i = 0; i < inputs_.size(); ++i) {
+    decodedInputs_[i].decode(*elements->childAt(i));
+  }
+
+  for (auto row = offset; row < offset + size; ++row) {
+    char* newRow = inputData_->newRow();
+
+    for (auto i = 0; i < inputs_.size(); ++i) {
+      inputData_->store(decodedInputs_[i], row, newRow, i);
+    }
+
+    addNewRow(group, newRow);
+  }
+}
+
 bool SortedAggregations::compareRowsWithKeys(
     const char* lhs,
     const char* rhs,
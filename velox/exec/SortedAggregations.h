@@ -36,6 +36,7 @@ class SortedAggregations {
       memory::MemoryPool* pool);
 
   /// Returns metadata about the accumulator used to store lists of input rows.
+  /// The accumulator is spilled as an array of the input rows of each group.
   Accumulator accumulator() const;
 
   /// Aggregate-like APIs to aggregate input rows per group.
@@ -62,6 +63,13 @@ class SortedAggregations {
 
   void addSingleGroupInput(char* group, const RowVectorPtr& input);
 
+  /// Adds the input rows of a group spilled by the accumulator. 'input' is the
+  /// spilled array vector and 'index' is the row of 'input' to add.
+  void addSingleGroupSpillInput(
+      char* group,
+      const VectorPtr& input,
+      vector_size_t index);
+
   void noMoreInput();
 
   /// Sorts input row for the specified groups, computes aggregations and stores
@@ -71,6 +79,13 @@ class SortedAggregations {
  private:
   void addNewRow(char* group, char* newRow);
 
+  /// Extracts the input rows of 'groups' into an array vector for spilling.
+  void extractForSpill(folly::Range<char**> groups, VectorPtr& result) const;
+
+  /// Frees the lists of input rows of 'groups' and erases the rows from
+  /// 'inputData_'.
+  void destroyGroups(folly::Range<char**> groups) const;
+
   bool compareRowsWithKeys(
       const char* lhs,
       const char* rhs,
@@ -93,6 +108,9 @@ class SortedAggregations {
   /// Mapping from the input column index to an index into 'inputs_'.
   std::vector<column_index_t> inputMapping_;
 
+  /// The type of the spilled accumulator: ARRAY(ROW(<input types>)).
+  TypePtr spillType_;
+
   std::vector<DecodedVector> decodedInputs_;
 
   HashStringAllocator* allocator_;
@@ -15,10 +15,19 @@
  */
 
 #include "velox/exec/Spill.h"
+#include "velox/common/base/Counters.h"
+#include "velox/common/base/StatsReporter.h"
+#include "velox/common/compression/ZstdDictionaryCodec.h"
 #include "velox/common/file/FileSystems.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/serializers/PrestoSerializer.h"
 
+DEFINE_bool(
+    velox_spill_zstd_dictionary,
+    false,
+    "If true, ZSTD compressed spill runs train a dictionary on their first "
+    "batches and compress the later batches with it");
+
 namespace facebook::velox::exec {
 namespace {
 // Spilling currently uses the default PrestoSerializer which by default
@@ -43,12 +52,57 @@ folly::Synchronized<SpillStats>& localSpillStats() {
 
 std::atomic<int32_t> SpillFile::ordinalCounter_;
 
-void SpillInput::next(bool /*throwIfPastEnd*/) {
-  int32_t readBytes = std::min(input_->size() - offset_, buffer_->capacity());
+SpillInput::~SpillInput() {
+  if (readAhead_ == nullptr) {
+    return;
+  }
+  // Waits for a read ahead in progress, which uses 'this'.
+  cancelled_ = true;
+  try {
+    readAhead_->move();
+  } catch (const std::exception& e) {
+    LOG(WARNING) << "Spill read ahead failed on close: " << e.what();
+  }
+}
+
+int32_t SpillInput::nextReadSize() {
+  const int32_t readBytes = std::min(size_ - offset_, buffer_->capacity());
   VELOX_CHECK_LT(0, readBytes, "Reading past end of spill file");
-  setRange({buffer_->asMutable<uint8_t>(), readBytes, 0});
-  input_->pread(offset_, readBytes, buffer_->asMutable<char>());
   offset_ += readBytes;
+  return readBytes;
+}
+
+void SpillInput::next(bool /*throwIfPastEnd*/) {
+  if (readAhead_ != nullptr) {
+    auto readBytes = readAhead_->move();
+    readAhead_ = nullptr;
+    VELOX_CHECK_NOT_NULL(readBytes);
+    std::swap(buffer_, readAheadBuffer_);
+    setRange({buffer_->asMutable<uint8_t>(), *readBytes, 0});
+  } else {
+    const auto readOffset = offset_;
+    const auto readBytes = nextReadSize();
+    setRange({buffer_->asMutable<uint8_t>(), readBytes, 0});
+    input_->pread(readOffset, readBytes, buffer_->asMutable<char>());
+  }
+  startReadAhead();
+}
+
+void SpillInput::startReadAhead() {
+  if (executor_ == nullptr || offset_ >= size_) {
+    return;
+  }
+  const auto readOffset = offset_;
+  const auto readBytes = nextReadSize();
+  readAhead_ = std::make_shared<AsyncSource<int32_t>>(
+      [this, readOffset, readBytes]() {
+        if (!cancelled_) {
+          input_->pread(
+              readOffset, readBytes, readAheadBuffer_->asMutable<char>());
+        }
+        return std::make_unique<int32_t>(readBytes);
+      });
+  executor_->add([readAhead = readAhead_]() { readAhead->prepare(); });
 }
 
 void SpillMergeStream::pop() {
@@ -98,14 +152,16 @@ SpillFile::SpillFile(
     const std::vector<CompareFlags>& sortCompareFlags,
     const std::string& path,
     common::CompressionKind compressionKind,
-    memory::MemoryPool* pool)
+    memory::MemoryPool* pool,
+    std::shared_ptr<folly::io::Codec> codec)
     : type_(std::move(type)),
       numSortingKeys_(numSortingKeys),
       sortCompareFlags_(sortCompareFlags),
       ordinal_(ordinalCounter_++),
       path_(fmt::format("{}-{}", path, ordinal_)),
       compressionKind_(compressionKind),
-      pool_(pool) {
+      pool_(pool),
+      codec_(std::move(codec)) {
   // NOTE: if the spilling operator has specified the sort comparison flags,
   // then it must match the number of sorting keys.
   VELOX_CHECK(
@@ -120,16 +176,55 @@ WriteFile& SpillFile::output() {
   return *output_;
 }
 
-void SpillFile::startRead() {
+void SpillFile::startRead(folly::Executor* readAheadExecutor) {
   constexpr uint64_t kMaxReadBufferSize =
       (1 << 20) - AlignedBuffer::kPaddedSize; // 1MB - padding.
   VELOX_CHECK(!output_);
   VELOX_CHECK(!input_);
   auto fs = filesystems::getFileSystem(path_, nullptr);
   auto file = fs->openFileForRead(path_);
-  auto buffer = AlignedBuffer::allocate<char>(
-      std::min<uint64_t>(fileSize_, kMaxReadBufferSize), pool_);
-  input_ = std::make_unique<SpillInput>(std::move(file), std::move(buffer));
+  const auto bufferSize = std::min<uint64_t>(fileSize_, kMaxReadBufferSize);
+  auto buffer = AlignedBuffer::allocate<char>(bufferSize, pool_);
+  BufferPtr readAheadBuffer;
+  if (readAheadExecutor != nullptr && fileSize_ > buffer->capacity()) {
+    readAheadBuffer = AlignedBuffer::allocate<char>(bufferSize, pool_);
+  } else {
+    readAheadExecutor = nullptr;
+  }
+  input_ = std::make_unique<SpillInput>(
+      std::move(file),
+      std::move(buffer),
+      std::move(readAheadBuffer),
+      readAheadExecutor);
+}
+
+void SpillFile::addSortKeyBounds(
+    std::vector<VectorPtr> firstKeys,
+    std::vector<VectorPtr> lastKeys) {
+  if (firstKeys_.empty()) {
+    firstKeys_ = std::move(firstKeys);
+  }
+  lastKeys_ = std::move(lastKeys);
+}
+
+bool SpillFile::precedes(const SpillFile& next) const {
+  if (lastKeys_.empty() || next.firstKeys_.empty()) {
+    return false;
+  }
+  VELOX_CHECK_EQ(lastKeys_.size(), next.firstKeys_.size());
+  for (size_t key = 0; key < lastKeys_.size(); ++key) {
+    const auto flags = sortCompareFlags_.empty() ? CompareFlags()
+                                                 : sortCompareFlags_[key];
+    const auto result =
+        lastKeys_[key]->compare(next.firstKeys_[key].get(), 0, 0, flags);
+    if (!result.has_value() || result.value() > 0) {
+      return false;
+    }
+    if (result.value() < 0) {
+      return true;
+    }
+  }
+  return true;
 }
 
 bool SpillFile::nextBatch(RowVectorPtr& rowVector) {
@@ -138,6 +233,7 @@ bool SpillFile::nextBatch(RowVectorPtr& rowVector) {
   }
   serializer::presto::PrestoVectorSerde::PrestoOptions options = {
       kDefaultUseLosslessTimestamp, compressionKind_};
+  options.codec = codec_;
   VectorStreamGroup::read(input_.get(), pool_, type_, &rowVector, &options);
   return true;
 }
@@ -151,7 +247,8 @@ SpillFileList::SpillFileList(
     uint64_t writeBufferSize,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Synchronized<SpillStats>* stats)
+    folly::Synchronized<SpillStats>* stats,
+    RateLimiter* writeRateLimiter)
     : type_(type),
       numSortingKeys_(numSortingKeys),
       sortCompareFlags_(sortCompareFlags),
@@ -159,8 +256,14 @@ SpillFileList::SpillFileList(
       targetFileSize_(targetFileSize),
       writeBufferSize_(writeBufferSize),
       compressionKind_(compressionKind),
+      codec_(
+          FLAGS_velox_spill_zstd_dictionary &&
+                  compressionKind_ == common::CompressionKind_ZSTD
+              ? std::make_shared<common::ZstdDictionaryCodec>()
+              : nullptr),
       pool_(pool),
-      stats_(stats) {
+      stats_(stats),
+      writeRateLimiter_(writeRateLimiter) {
   // NOTE: if the associated spilling operator has specified the sort
   // comparison flags, then it must match the number of sorting keys.
   VELOX_CHECK(
@@ -174,13 +277,15 @@ WriteFile& SpillFileList::currentOutput() {
       files_.back()->finishWrite();
       updateSpilledFiles(files_.back()->size());
     }
+    currentFilePath_ = SpillTiers::instance().filePath(path_);
     files_.push_back(std::make_unique<SpillFile>(
         type_,
         numSortingKeys_,
         sortCompareFlags_,
-        fmt::format("{}-{}", path_, files_.size()),
+        fmt::format("{}-{}", currentFilePath_, files_.size()),
         compressionKind_,
-        pool_));
+        pool_,
+        codec_));
   }
   return files_.back()->output();
 }
@@ -188,28 +293,32 @@ WriteFile& SpillFileList::currentOutput() {
 uint64_t SpillFileList::flush() {
   uint64_t writtenBytes = 0;
   if (batch_) {
-    IOBufOutputStream out(
-        *pool_, nullptr, std::max<int64_t>(64 * 1024, batch_->size()));
     uint64_t flushTimeUs{0};
+    std::unique_ptr<folly::IOBuf> iobuf;
     {
       MicrosecondTimer timer(&flushTimeUs);
-      batch_->flush(&out);
+      iobuf = VectorStreamGroup::flushToIOBuf(std::move(batch_));
     }
-
-    batch_.reset();
-    auto iobuf = out.getIOBuf();
+    const auto bytes = iobuf->computeChainDataLength();
     auto& file = currentOutput();
+    if (!batchFirstKeys_.empty()) {
+      files_.back()->addSortKeyBounds(
+          std::move(batchFirstKeys_), std::move(batchLastKeys_));
+      batchFirstKeys_.clear();
+      batchLastKeys_.clear();
+    }
+    if (writeRateLimiter_ != nullptr) {
+      writeRateLimiter_->acquire(bytes);
+    }
     uint64_t writeTimeUs{0};
-    uint32_t numDiskWrites{0};
+    const uint32_t numDiskWrites = 1;
     {
       MicrosecondTimer timer(&writeTimeUs);
-      for (auto& range : *iobuf) {
-        ++numDiskWrites;
-        file.append(std::string_view(
-            reinterpret_cast<const char*>(range.data()), range.size()));
-        writtenBytes += range.size();
-      }
+      file.appendv(*iobuf);
+      writtenBytes += bytes;
     }
+    REPORT_ADD_HISTOGRAM_VALUE(kCounterSpillWriteLatencyUs, writeTimeUs);
+    SpillTiers::instance().addSpilledBytes(currentFilePath_, writtenBytes);
     updateWriteStats(numDiskWrites, writtenBytes, flushTimeUs, writeTimeUs);
   }
   return writtenBytes;
@@ -224,6 +333,7 @@ uint64_t SpillFileList::write(
     if (batch_ == nullptr) {
       serializer::presto::PrestoVectorSerde::PrestoOptions options = {
           kDefaultUseLosslessTimestamp, compressionKind_};
+      options.codec = codec_;
       batch_ = std::make_unique<VectorStreamGroup>(pool_);
       batch_->createStreamTree(
           std::static_pointer_cast<const RowType>(rows->type()),
@@ -231,6 +341,9 @@ uint64_t SpillFileList::write(
           &options);
     }
     batch_->append(rows, indices);
+    if (numSortingKeys_ > 0) {
+      recordSortKeyBounds(rows, indices);
+    }
   }
   updateAppendStats(rows->size(), timeUs);
   if (batch_->size() < writeBufferSize_) {
@@ -239,6 +352,50 @@ uint64_t SpillFileList::write(
   return flush();
 }
 
+namespace {
+// Returns single row copies of the sort keys of 'rows' at 'index'.
+std::vector<VectorPtr> copySortKeys(
+    const RowVectorPtr& rows,
+    int32_t numSortingKeys,
+    vector_size_t index,
+    memory::MemoryPool* pool) {
+  std::vector<VectorPtr> keys;
+  keys.reserve(numSortingKeys);
+  for (auto key = 0; key < numSortingKeys; ++key) {
+    const auto& column = rows->childAt(key);
+    auto copy = BaseVector::create(column->type(), 1, pool);
+    copy->copy(column.get(), 0, index, 1);
+    keys.push_back(std::move(copy));
+  }
+  return keys;
+}
+} // namespace
+
+void SpillFileList::recordSortKeyBounds(
+    const RowVectorPtr& rows,
+    const folly::Range<IndexRange*>& indices) {
+  const IndexRange* first = nullptr;
+  const IndexRange* last = nullptr;
+  for (const auto& range : indices) {
+    if (range.size == 0) {
+      continue;
+    }
+    if (first == nullptr) {
+      first = &range;
+    }
+    last = &range;
+  }
+  if (first == nullptr) {
+    return;
+  }
+  if (batchFirstKeys_.empty()) {
+    batchFirstKeys_ =
+        copySortKeys(rows, numSortingKeys_, first->begin, pool_);
+  }
+  batchLastKeys_ = copySortKeys(
+      rows, numSortingKeys_, last->begin + last->size - 1, pool_);
+}
+
 void SpillFileList::updateAppendStats(
     uint64_t numRows,
     uint64_t serializationTimeUs) {
@@ -297,7 +454,8 @@ SpillState::SpillState(
     uint64_t writeBufferSize,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Synchronized<SpillStats>* stats)
+    folly::Synchronized<SpillStats>* stats,
+    RateLimiter* writeRateLimiter)
     : path_(path),
       maxPartitions_(maxPartitions),
       numSortingKeys_(numSortingKeys),
@@ -307,6 +465,7 @@ SpillState::SpillState(
       compressionKind_(compressionKind),
       pool_(pool),
       stats_(stats),
+      writeRateLimiter_(writeRateLimiter),
       files_(maxPartitions_) {}
 
 void SpillState::setPartitionSpilled(int32_t partition) {
@@ -340,7 +499,8 @@ uint64_t SpillState::appendToPartition(
         writeBufferSize_,
         compressionKind_,
         pool_,
-        stats_);
+        stats_,
+        writeRateLimiter_);
   }
   updateSpilledInputBytes(rows->estimateFlatSize());
 
@@ -350,13 +510,26 @@ uint64_t SpillState::appendToPartition(
 
 std::unique_ptr<TreeOfLosers<SpillMergeStream>> SpillState::startMerge(
     int32_t partition,
-    std::unique_ptr<SpillMergeStream>&& extra) {
+    std::unique_ptr<SpillMergeStream>&& extra,
+    folly::Executor* readAheadExecutor) {
   VELOX_CHECK_LT(partition, files_.size());
   std::vector<std::unique_ptr<SpillMergeStream>> result;
   auto list = std::move(files_[partition]);
   if (list != nullptr) {
+    // Files whose rows follow each other are read as one stream, so that the
+    // merge compares across fewer streams.
+    SpillFiles run;
     for (auto& file : list->files()) {
-      result.push_back(FileSpillMergeStream::create(std::move(file)));
+      if (!run.empty() && !run.back()->precedes(*file)) {
+        result.push_back(
+            FileSpillMergeStream::create(std::move(run), readAheadExecutor));
+        run.clear();
+      }
+      run.push_back(std::move(file));
+    }
+    if (!run.empty()) {
+      result.push_back(
+          FileSpillMergeStream::create(std::move(run), readAheadExecutor));
     }
   }
   VELOX_CHECK_EQ(!result.empty(), isPartitionSpilled(partition));
@@ -667,6 +840,129 @@ void incrementGlobalSpilledFiles() {
   ++localSpillStats().wlock()->spilledFiles;
 }
 
+// static
+SpillTiers& SpillTiers::instance() {
+  static SpillTiers tiers;
+  return tiers;
+}
+
+void SpillTiers::setOverflow(
+    const std::string& localDirectory,
+    uint64_t capacityBytes,
+    const std::string& overflowDirectory) {
+  VELOX_CHECK(!localDirectory.empty());
+  VELOX_CHECK(!overflowDirectory.empty());
+  VELOX_CHECK_NE(localDirectory, overflowDirectory);
+  std::lock_guard<std::mutex> l(mutex_);
+  if (auto* tier = findTierLocked(localDirectory)) {
+    if (tier->localDirectory == localDirectory) {
+      tier->capacityBytes = capacityBytes;
+      tier->overflowDirectory = overflowDirectory;
+      return;
+    }
+  }
+  tiers_.push_back({localDirectory, capacityBytes, overflowDirectory});
+}
+
+SpillTiers::Tier* SpillTiers::findTierLocked(const std::string& path) {
+  for (auto& tier : tiers_) {
+    const auto& dir = tier.localDirectory;
+    if (path.compare(0, dir.size(), dir) == 0 &&
+        (path.size() == dir.size() || path[dir.size()] == '/')) {
+      return &tier;
+    }
+  }
+  return nullptr;
+}
+
+std::string SpillTiers::filePath(const std::string& path) {
+  std::string overflowPath;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto* tier = findTierLocked(path);
+    if (tier == nullptr || tier->usedBytes < tier->capacityBytes) {
+      return path;
+    }
+    overflowPath =
+        tier->overflowDirectory + path.substr(tier->localDirectory.size());
+    if (!overflowPaths_.insert(path).second) {
+      return overflowPath;
+    }
+  }
+  // The first file of 'path' in the overflow directory. Creates its parent
+  // like the host creates the local spill directory of a Task.
+  const auto parent = overflowPath.substr(0, overflowPath.rfind('/'));
+  filesystems::getFileSystem(parent, nullptr)->mkdir(parent);
+  return overflowPath;
+}
+
+void SpillTiers::addSpilledBytes(const std::string& path, uint64_t bytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto* tier = findTierLocked(path);
+  if (tier == nullptr) {
+    return;
+  }
+  tier->usedBytes += bytes;
+  pathBytes_[path] += bytes;
+}
+
+void SpillTiers::removeDirectory(const std::string& directory) {
+  const auto isUnder = [&](const std::string& path) {
+    return path.compare(0, directory.size(), directory) == 0 &&
+        (path.size() == directory.size() || path[directory.size()] == '/');
+  };
+  std::string overflowDirectory;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    auto* tier = findTierLocked(directory);
+    if (tier == nullptr) {
+      return;
+    }
+    for (auto it = pathBytes_.begin(); it != pathBytes_.end();) {
+      if (isUnder(it->first)) {
+        VELOX_CHECK_GE(tier->usedBytes, it->second);
+        tier->usedBytes -= it->second;
+        it = pathBytes_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    bool hasOverflow = false;
+    for (auto it = overflowPaths_.begin(); it != overflowPaths_.end();) {
+      if (isUnder(*it)) {
+        hasOverflow = true;
+        it = overflowPaths_.erase(it);
+      } else {
+        ++it;
+      }
+    }
+    if (!hasOverflow) {
+      return;
+    }
+    overflowDirectory =
+        tier->overflowDirectory + directory.substr(tier->localDirectory.size());
+  }
+  auto fs = filesystems::getFileSystem(overflowDirectory, nullptr);
+  fs->rmdir(overflowDirectory);
+}
+
+uint64_t SpillTiers::usedBytes(const std::string& directory) const {
+  std::lock_guard<std::mutex> l(mutex_);
+  for (const auto& tier : tiers_) {
+    if (tier.localDirectory == directory) {
+      return tier.usedBytes;
+    }
+  }
+  return 0;
+}
+
+void SpillTiers::testingClear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  tiers_.clear();
+  pathBytes_.clear();
+  overflowPaths_.clear();
+}
+
 SpillStats globalSpillStats() {
   SpillStats gSpillStats;
   for (auto& spillStats : allSpillStats()) {
@@ -16,8 +16,14 @@
 
 #pragma once
 
+#include <folly/Executor.h>
 #include <folly/container/F14Set.h>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
+#include "velox/common/base/AsyncSource.h"
+#include "velox/common/base/RateLimiter.h"
 #include "velox/common/compression/Compression.h"
 #include "velox/common/file/File.h"
 #include "velox/exec/TreeOfLosers.h"
@@ -31,27 +37,54 @@ namespace facebook::velox::exec {
 // Input stream backed by spill file.
 class SpillInput : public ByteStream {
  public:
-  // Reads from 'input' using 'buffer' for buffering reads.
-  SpillInput(std::unique_ptr<ReadFile>&& input, BufferPtr buffer)
+  // Reads from 'input' using 'buffer' for buffering reads. If 'readAheadBuffer'
+  // is set, the next range of the file is read into it on 'executor' while
+  // 'buffer' is consumed. 'readAheadBuffer' must have the capacity of 'buffer'.
+  SpillInput(
+      std::unique_ptr<ReadFile>&& input,
+      BufferPtr buffer,
+      BufferPtr readAheadBuffer = nullptr,
+      folly::Executor* executor = nullptr)
       : input_(std::move(input)),
         buffer_(std::move(buffer)),
+        readAheadBuffer_(std::move(readAheadBuffer)),
+        executor_(executor),
         size_(input_->size()) {
+    VELOX_CHECK_EQ(readAheadBuffer_ == nullptr, executor_ == nullptr);
     next(true);
   }
 
+  ~SpillInput() override;
+
   void next(bool throwIfPastEnd) override;
 
   // True if all of the file has been read into vectors.
   bool atEnd() const {
-    return offset_ >= size_ && ranges()[0].position >= ranges()[0].size;
+    return offset_ >= size_ && readAhead_ == nullptr &&
+        ranges()[0].position >= ranges()[0].size;
   }
 
  private:
+  // Returns the number of bytes in the next read from 'offset_' and advances
+  // 'offset_' past them.
+  int32_t nextReadSize();
+
+  // Starts reading the next range of the file into 'readAheadBuffer_' on
+  // 'executor_' if there is one.
+  void startReadAhead();
+
   std::unique_ptr<ReadFile> input_;
   BufferPtr buffer_;
+  BufferPtr readAheadBuffer_;
+  folly::Executor* const executor_;
   const uint64_t size_;
-  // Offset of first byte not in 'buffer_'
+  // Offset of first byte not in 'buffer_' or in the read ahead.
   uint64_t offset_ = 0;
+  // Produces the number of bytes read into 'readAheadBuffer_'.
+  std::shared_ptr<AsyncSource<int32_t>> readAhead_;
+  // Set on destruction so that a read ahead which has not started yet skips
+  // the read.
+  std::atomic<bool> cancelled_{false};
 };
 
 /// Represents a spill file that is first in write mode and then
@@ -70,7 +103,8 @@ class SpillFile {
       const std::vector<CompareFlags>& sortCompareFlags,
       const std::string& path,
       common::CompressionKind compressionKind,
-      memory::MemoryPool* pool);
+      memory::MemoryPool* pool,
+      std::shared_ptr<folly::io::Codec> codec = nullptr);
 
   int32_t numSortingKeys() const {
     return numSortingKeys_;
@@ -99,11 +133,20 @@ class SpillFile {
   }
 
   /// Prepares 'this' for reading. Positions the read at the first row of
-  /// content. The caller must call output() and finishWrite() before this.
-  void startRead();
+  /// content. The caller must call output() and finishWrite() before this. If
+  /// 'readAheadExecutor' is set and the file does not fit in one read buffer,
+  /// the next buffer is read on 'readAheadExecutor' while the current one is
+  /// consumed. This doubles the read buffer memory of 'this'.
+  void startRead(folly::Executor* readAheadExecutor = nullptr);
 
   bool nextBatch(RowVectorPtr& rowVector);
 
+  /// Releases the read buffer. startRead() may be called again after this to
+  /// read the content from the first row.
+  void finishRead() {
+    input_.reset();
+  }
+
   /// Returns the file size in bytes. During the writing phase this is
   /// the current size of the file, during reading this is the final
   // size.
@@ -122,6 +165,18 @@ class SpillFile {
     return path_;
   }
 
+  /// Records the sort keys of the first and last rows of a batch appended to
+  /// 'this'. Keeps the first row of the first batch and the last row of the
+  /// last one.
+  void addSortKeyBounds(
+      std::vector<VectorPtr> firstKeys,
+      std::vector<VectorPtr> lastKeys);
+
+  /// Returns true if all rows of 'next' sort at or after the rows of 'this',
+  /// so that the two files can be read one after the other instead of being
+  /// merged. False if the bounds of either file are not known.
+  bool precedes(const SpillFile& next) const;
+
  private:
   static std::atomic<int32_t> ordinalCounter_;
 
@@ -134,11 +189,18 @@ class SpillFile {
   const std::string path_;
   const common::CompressionKind compressionKind_;
   memory::MemoryPool* const pool_;
+  // The codec that compressed the content if it is not a codec of
+  // 'compressionKind_'.
+  const std::shared_ptr<folly::io::Codec> codec_;
 
   // Byte size of the backing file. Set when finishing writing.
   uint64_t fileSize_ = 0;
   std::unique_ptr<WriteFile> output_;
   std::unique_ptr<SpillInput> input_;
+  // Single row vectors with the sort keys of the first and last rows. Empty
+  // if no sorted rows were recorded.
+  std::vector<VectorPtr> firstKeys_;
+  std::vector<VectorPtr> lastKeys_;
 };
 
 /// Provides the fine-grained spill execution stats.
@@ -236,7 +298,8 @@ class SpillFileList {
       uint64_t writeBufferSize,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Synchronized<SpillStats>* stats);
+      folly::Synchronized<SpillStats>* stats,
+      RateLimiter* writeRateLimiter = nullptr);
 
   /// Adds 'rows' for the positions in 'indices' into 'this'. The indices
   /// must produce a view where the rows are sorted if sorting is desired.
@@ -267,6 +330,12 @@ class SpillFileList {
   // written size.
   uint64_t flush();
 
+  // Records the sort keys of the first and last rows of 'indices' in
+  // 'batchFirstKeys_' and 'batchLastKeys_'.
+  void recordSortKeyBounds(
+      const RowVectorPtr& rows,
+      const folly::Range<IndexRange*>& indices);
+
   // Invoked to update the number of spilled rows.
   void updateAppendStats(uint64_t numRows, uint64_t serializationTimeUs);
   // Invoked to increment the number of spilled files and the file size.
@@ -285,10 +354,23 @@ class SpillFileList {
   const uint64_t targetFileSize_;
   const uint64_t writeBufferSize_;
   const common::CompressionKind compressionKind_;
+  // Shared by the files of 'this' if set. A ZSTD dictionary trained on the
+  // first batches compresses the later ones, see
+  // common::ZstdDictionaryCodec.
+  const std::shared_ptr<folly::io::Codec> codec_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<SpillStats>* const stats_;
+  // Throttles the file writes if not null.
+  RateLimiter* const writeRateLimiter_;
   std::unique_ptr<VectorStreamGroup> batch_;
+  // The sort keys of the first and last rows in 'batch_'. Set if there are
+  // sorting keys.
+  std::vector<VectorPtr> batchFirstKeys_;
+  std::vector<VectorPtr> batchLastKeys_;
   SpillFiles files_;
+  // The path prefix of the last file in 'files_'. Differs from 'path_' if
+  // the file went to an overflow directory. See SpillTiers.
+  std::string currentFilePath_;
 };
 
 // A source of sorted spilled RowVectors coming either from a file or memory.
@@ -383,41 +465,63 @@ class SpillMergeStream : public MergeStream {
   SelectivityVector rows_;
 };
 
-// A source of spilled RowVectors coming from a file.
+// A source of spilled RowVectors coming from a file or from a run of files
+// where each file precedes the next. See SpillFile::precedes().
 class FileSpillMergeStream : public SpillMergeStream {
  public:
   static std::unique_ptr<SpillMergeStream> create(
-      std::unique_ptr<SpillFile> spillFile) {
-    spillFile->startRead();
-    auto* spillStream = new FileSpillMergeStream(std::move(spillFile));
+      std::unique_ptr<SpillFile> spillFile,
+      folly::Executor* readAheadExecutor = nullptr) {
+    SpillFiles spillFiles;
+    spillFiles.push_back(std::move(spillFile));
+    return create(std::move(spillFiles), readAheadExecutor);
+  }
+
+  static std::unique_ptr<SpillMergeStream> create(
+      SpillFiles spillFiles,
+      folly::Executor* readAheadExecutor = nullptr) {
+    auto* spillStream =
+        new FileSpillMergeStream(std::move(spillFiles), readAheadExecutor);
+    spillStream->spillFiles_[0]->startRead(readAheadExecutor);
     spillStream->nextBatch();
     return std::unique_ptr<SpillMergeStream>(spillStream);
   }
 
  private:
-  explicit FileSpillMergeStream(std::unique_ptr<SpillFile> spillFile)
-      : spillFile_(std::move(spillFile)) {
-    VELOX_CHECK_NOT_NULL(spillFile_);
+  FileSpillMergeStream(
+      SpillFiles spillFiles,
+      folly::Executor* readAheadExecutor)
+      : spillFiles_(std::move(spillFiles)),
+        readAheadExecutor_(readAheadExecutor) {
+    VELOX_CHECK(!spillFiles_.empty());
   }
 
   int32_t numSortingKeys() const override {
-    return spillFile_->numSortingKeys();
+    return spillFiles_[fileIndex_]->numSortingKeys();
   }
 
   const std::vector<CompareFlags>& sortCompareFlags() const override {
-    return spillFile_->sortCompareFlags();
+    return spillFiles_[fileIndex_]->sortCompareFlags();
   }
 
   void nextBatch() override {
     index_ = 0;
-    if (!spillFile_->nextBatch(rowVector_)) {
-      size_ = 0;
-      return;
+    while (!spillFiles_[fileIndex_]->nextBatch(rowVector_)) {
+      if (fileIndex_ + 1 == spillFiles_.size()) {
+        size_ = 0;
+        return;
+      }
+      // Frees the read buffers of the finished file.
+      spillFiles_[fileIndex_]->finishRead();
+      spillFiles_[++fileIndex_]->startRead(readAheadExecutor_);
     }
     size_ = rowVector_->size();
   }
 
-  std::unique_ptr<SpillFile> spillFile_;
+  SpillFiles spillFiles_;
+  folly::Executor* const readAheadExecutor_;
+  // Index of the file in 'spillFiles_' being read.
+  size_t fileIndex_{0};
 };
 
 /// A source of spilled RowVectors coming from a file. The spill data might not
@@ -545,6 +649,15 @@ class SpillPartition {
     return files_.size();
   }
 
+  /// Returns the total size in bytes of the spill files in this partition.
+  uint64_t size() const {
+    uint64_t totalSize{0};
+    for (const auto& file : files_) {
+      totalSize += file->size();
+    }
+    return totalSize;
+  }
+
   /// Invoked to split this spill partition into 'numShards' to process in
   /// parallel.
   ///
@@ -583,7 +696,8 @@ class SpillState {
       uint64_t writeBufferSize,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Synchronized<SpillStats>* stats);
+      folly::Synchronized<SpillStats>* stats,
+      RateLimiter* writeRateLimiter = nullptr);
 
   /// Indicates if a given 'partition' has been spilled or not.
   bool isPartitionSpilled(int32_t partition) const {
@@ -641,10 +755,12 @@ class SpillState {
 
   /// Starts reading values for 'partition'. If 'extra' is non-null, it can be
   /// a stream of rows from a RowContainer so as to merge unspilled data with
-  /// spilled data.
+  /// spilled data. If 'readAheadExecutor' is set, each file reads ahead one
+  /// buffer on it. See SpillFile::startRead().
   std::unique_ptr<TreeOfLosers<SpillMergeStream>> startMerge(
       int32_t partition,
-      std::unique_ptr<SpillMergeStream>&& extra);
+      std::unique_ptr<SpillMergeStream>&& extra,
+      folly::Executor* readAheadExecutor = nullptr);
 
   bool hasFiles(int32_t partition) const {
     return partition < files_.size() && files_[partition];
@@ -671,6 +787,7 @@ class SpillState {
   const common::CompressionKind compressionKind_;
   memory::MemoryPool* const pool_;
   folly::Synchronized<SpillStats>* const stats_;
+  RateLimiter* const writeRateLimiter_;
 
   // A set of spilled partition numbers.
   SpillPartitionNumSet spilledPartitionSet_;
@@ -680,6 +797,62 @@ class SpillState {
   std::vector<std::unique_ptr<SpillFileList>> files_;
 };
 
+/// Process wide limits on the spill data kept in local spill directories. A
+/// local directory is registered with a capacity and an overflow directory,
+/// typically on a remote file system. Once the spill files under the local
+/// directory reach the capacity, new spill files go to the same relative path
+/// under the overflow directory instead. Files already started stay where they
+/// are. The usage of a directory is released by removeDirectory() when the
+/// spill directory of a Task is removed.
+class SpillTiers {
+ public:
+  static SpillTiers& instance();
+
+  /// Sends spill files under 'localDirectory' to 'overflowDirectory' while
+  /// 'localDirectory' holds 'capacityBytes' or more of spill data. Replaces a
+  /// previous registration for 'localDirectory'.
+  void setOverflow(
+      const std::string& localDirectory,
+      uint64_t capacityBytes,
+      const std::string& overflowDirectory);
+
+  /// Returns the path prefix for a new spill file whose path in the local tier
+  /// starts with 'path'. This is 'path' unless the local tier is full.
+  std::string filePath(const std::string& path);
+
+  /// Charges 'bytes' written to a file with 'path' prefix to the tier of
+  /// 'path'.
+  void addSpilledBytes(const std::string& path, uint64_t bytes);
+
+  /// Releases the usage of the spill files under 'directory' and removes the
+  /// overflow counterpart of 'directory' if there is one. The caller removes
+  /// 'directory' itself.
+  void removeDirectory(const std::string& directory);
+
+  /// Returns the bytes of spill data under the local directory 'directory'.
+  uint64_t usedBytes(const std::string& directory) const;
+
+  void testingClear();
+
+ private:
+  struct Tier {
+    std::string localDirectory;
+    uint64_t capacityBytes;
+    std::string overflowDirectory;
+    uint64_t usedBytes{0};
+  };
+
+  // Returns the tier whose local directory contains 'path' or nullptr.
+  Tier* findTierLocked(const std::string& path);
+
+  mutable std::mutex mutex_;
+  std::vector<Tier> tiers_;
+  // Bytes charged per spill file path prefix.
+  std::unordered_map<std::string, uint64_t> pathBytes_;
+  // Directories that have files in an overflow directory.
+  std::unordered_set<std::string> overflowPaths_;
+};
+
 /// Generate partition id set from given spill partition set.
 SpillPartitionIdSet toSpillPartitionIdSet(
     const SpillPartitionSet& partitionSet);
@@ -46,7 +46,8 @@ Spiller::Spiller(
     uint64_t minSpillRunSize,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    RateLimiter* writeRateLimiter)
     : Spiller(
           type,
           container,
@@ -61,7 +62,8 @@ Spiller::Spiller(
           minSpillRunSize,
           compressionKind,
           pool,
-          executor) {
+          executor,
+          writeRateLimiter) {
   VELOX_CHECK_EQ(type_, Type::kOrderBy);
 }
 
@@ -74,7 +76,8 @@ Spiller::Spiller(
     uint64_t writeBufferSize,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    RateLimiter* writeRateLimiter)
     : Spiller(
           type,
           container,
@@ -89,7 +92,8 @@ Spiller::Spiller(
           0,
           compressionKind,
           pool,
-          executor) {
+          executor,
+          writeRateLimiter) {
   VELOX_CHECK_EQ(type, Type::kAggregateOutput);
   VELOX_CHECK_EQ(state_.maxPartitions(), 1);
   VELOX_CHECK_EQ(state_.targetFileSize(), std::numeric_limits<uint64_t>::max());
@@ -105,7 +109,8 @@ Spiller::Spiller(
     uint64_t minSpillRunSize,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    RateLimiter* writeRateLimiter)
     : Spiller(
           type,
           nullptr,
@@ -120,7 +125,8 @@ Spiller::Spiller(
           minSpillRunSize,
           compressionKind,
           pool,
-          executor) {
+          executor,
+          writeRateLimiter) {
   VELOX_CHECK_EQ(type_, Type::kHashJoinProbe);
 }
 
@@ -138,7 +144,8 @@ Spiller::Spiller(
     uint64_t minSpillRunSize,
     common::CompressionKind compressionKind,
     memory::MemoryPool* pool,
-    folly::Executor* executor)
+    folly::Executor* executor,
+    RateLimiter* writeRateLimiter)
     : type_(type),
       container_(container),
       executor_(executor),
@@ -156,7 +163,8 @@ Spiller::Spiller(
           writeBufferSize,
           compressionKind,
           pool_,
-          &stats_) {
+          &stats_,
+          writeRateLimiter) {
   TestValue::adjust(
       "facebook::velox::exec::Spiller", const_cast<HashBitRange*>(&bits_));
 
@@ -188,8 +196,7 @@ void Spiller::extractSpill(folly::Range<char**> rows, RowVectorPtr& resultPtr) {
 
   auto numKeys = types.size();
   for (auto i = 0; i < accumulators.size(); ++i) {
-    accumulators[i].aggregateForSpill()->extractAccumulators(
-        rows.data(), rows.size(), &result->childAt(i + numKeys));
+    accumulators[i].extractForSpill(rows, result->childAt(i + numKeys));
   }
 }
 
@@ -638,8 +645,8 @@ std::unique_ptr<TreeOfLosers<SpillMergeStream>> Spiller::startMerge(
         needSort(), "Can't sort merge the unsorted spill data: {}", toString());
   }
 
-  auto merger =
-      state_.startMerge(partition, spillMergeStreamOverRows(partition));
+  auto merger = state_.startMerge(
+      partition, spillMergeStreamOverRows(partition), executor_);
   if (merger != nullptr && type_ == Type::kAggregateOutput) {
     VELOX_CHECK_EQ(
         merger->numStreams(),
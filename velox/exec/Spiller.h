@@ -58,7 +58,8 @@ class Spiller {
       uint64_t minSpillRunSize,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Executor* executor);
+      folly::Executor* executor,
+      RateLimiter* writeRateLimiter = nullptr);
 
   Spiller(
       Type type,
@@ -69,7 +70,8 @@ class Spiller {
       uint64_t writeBufferSize,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Executor* executor);
+      folly::Executor* executor,
+      RateLimiter* writeRateLimiter = nullptr);
 
   Spiller(
       Type type,
@@ -81,7 +83,8 @@ class Spiller {
       uint64_t minSpillRunSize,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Executor* executor);
+      folly::Executor* executor,
+      RateLimiter* writeRateLimiter = nullptr);
 
   Spiller(
       Type type,
@@ -97,7 +100,8 @@ class Spiller {
       uint64_t minSpillRunSize,
       common::CompressionKind compressionKind,
       memory::MemoryPool* pool,
-      folly::Executor* executor);
+      folly::Executor* executor,
+      RateLimiter* writeRateLimiter = nullptr);
 
   Type type() const {
     return type_;
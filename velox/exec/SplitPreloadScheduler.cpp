@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/SplitPreloadScheduler.h"
+
+#include <algorithm>
+
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::exec {
+
+bool SplitPreloadScheduler::tryReserve(uint64_t bytes) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (maxBytes_ > 0 && reservedBytes_ > 0 &&
+      reservedBytes_ + bytes > maxBytes_) {
+    ++stats_.numThrottled;
+    return false;
+  }
+  reservedBytes_ += bytes;
+  ++stats_.numPreloads;
+  stats_.peakBytes = std::max(stats_.peakBytes, reservedBytes_);
+  return true;
+}
+
+void SplitPreloadScheduler::release(uint64_t bytes, bool ready) {
+  std::lock_guard<std::mutex> l(mutex_);
+  VELOX_CHECK_GE(reservedBytes_, bytes);
+  reservedBytes_ -= bytes;
+  if (ready) {
+    ++stats_.numHits;
+  } else {
+    ++stats_.numMisses;
+  }
+}
+
+} // namespace facebook::velox::exec
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+
+namespace facebook::velox::exec {
+
+/// Budgets the split preloads of all drivers of a TableScan plan node of a
+/// Task. Each preload reserves its estimated bytes until a driver takes the
+/// split. A preload is started only while the reserved bytes are within
+/// 'maxBytes', so that the drivers do not together preload more than the
+/// budget. Also counts whether the preloaded splits were ready when taken.
+class SplitPreloadScheduler {
+ public:
+  struct Stats {
+    /// Number of preloads started.
+    uint64_t numPreloads{0};
+
+    /// Number of preloaded splits that were ready when taken by a driver.
+    uint64_t numHits{0};
+
+    /// Number of preloaded splits that a driver had to wait for.
+    uint64_t numMisses{0};
+
+    /// Number of times a preload was not started because of the budget.
+    uint64_t numThrottled{0};
+
+    /// Largest sum of the reserved bytes.
+    uint64_t peakBytes{0};
+  };
+
+  /// 'maxBytes' == 0 means no limit.
+  explicit SplitPreloadScheduler(uint64_t maxBytes) : maxBytes_(maxBytes) {}
+
+  /// Reserves 'bytes' for a preload. Returns false if this would exceed the
+  /// budget. A preload is always allowed if nothing is reserved so that a
+  /// split larger than the budget can still be preloaded.
+  bool tryReserve(uint64_t bytes);
+
+  /// Releases the reservation of a preloaded split of 'bytes' that a driver
+  /// takes. 'ready' is true if the preload had completed.
+  void release(uint64_t bytes, bool ready);
+
+  uint64_t reservedBytes() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return reservedBytes_;
+  }
+
+  Stats stats() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return stats_;
+  }
+
+ private:
+  const uint64_t maxBytes_;
+  mutable std::mutex mutex_;
+  uint64_t reservedBytes_{0};
+  Stats stats_;
+};
+
+} // namespace facebook::velox::exec
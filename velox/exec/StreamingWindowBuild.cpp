@@ -36,10 +36,7 @@ void StreamingWindowBuild::addInput(RowVectorPtr input) {
 
   for (auto row = 0; row < input->size(); ++row) {
     char* newRow = data_->newRow();
-
-    for (auto col = 0; col < input->childrenSize(); ++col) {
-      data_->store(decodedInputVectors_[col], row, newRow, col);
-    }
+    storeRow(row, newRow);
 
     if (previousRow_ != nullptr &&
         compareRowsWithKeys(previousRow_, newRow, partitionKeyInfo_)) {
@@ -48,8 +48,18 @@ TableScan::TableScan(
                          ->queryConfig()
                          .preferredOutputBatchRows()),
       maxReadBatchSize_(
-          driverCtx_->task->queryCtx()->queryConfig().maxOutputBatchRows()) {
+          driverCtx_->task->queryCtx()->queryConfig().maxOutputBatchRows()),
+      splitFileAffinity_(
+          driverCtx_->task->queryCtx()->queryConfig().splitFileAffinity()) {
   connector_ = connector::getConnector(tableHandle_->connectorId());
+  auto* cache = cache::AsyncDataCache::getInstance();
+  if (cache != nullptr &&
+      driverCtx_->task->queryCtx()
+          ->queryConfig()
+          .fragmentResultCacheEnabled()) {
+    resultCache_ =
+        std::make_unique<FragmentResultCache>(cache, *tableScanNode);
+  }
 }
 
 RowVectorPtr TableScan::getOutput() {
@@ -58,6 +68,14 @@ RowVectorPtr TableScan::getOutput() {
   }
 
   for (;;) {
+    if (needNewSplit_ && dataSource_ != nullptr && isCpuBound() &&
+        driverCtx_->task->tryRetireScanDriver(*driverCtx_)) {
+      // Leave the remaining splits to the other drivers of the pipeline.
+      noMoreSplits_ = true;
+      recordConnectorStats();
+      return nullptr;
+    }
+
     if (needNewSplit_) {
       exec::Split split;
       blockingReason_ = driverCtx_->task->getSplitOrFuture(
@@ -66,36 +84,23 @@ RowVectorPtr TableScan::getOutput() {
           split,
           blockingFuture_,
           maxPreloadedSplits_,
-          splitPreloader_);
+          splitPreloader_,
+          lastAffinityKey_);
       if (blockingReason_ != BlockingReason::kNotBlocked) {
         return nullptr;
       }
 
       if (!split.hasConnectorSplit()) {
         noMoreSplits_ = true;
-        if (dataSource_) {
-          auto connectorStats = dataSource_->runtimeStats();
-          auto lockedStats = stats_.wlock();
-          for (const auto& [name, counter] : connectorStats) {
-            if (name == "ioWaitNanos") {
-              ioWaitNanos_ += counter.value - lastIoWaitNanos_;
-              lastIoWaitNanos_ = counter.value;
-            }
-            if (UNLIKELY(lockedStats->runtimeStats.count(name) == 0)) {
-              lockedStats->runtimeStats.insert(
-                  std::make_pair(name, RuntimeMetric(counter.unit)));
-            } else {
-              VELOX_CHECK_EQ(
-                  lockedStats->runtimeStats.at(name).unit, counter.unit);
-            }
-            lockedStats->runtimeStats.at(name).addValue(counter.value);
-          }
-        }
+        recordConnectorStats();
         return nullptr;
       }
 
       const auto& connectorSplit = split.connectorSplit;
       needNewSplit_ = false;
+      if (splitFileAffinity_) {
+        lastAffinityKey_ = connectorSplit->affinityKey();
+      }
 
       VELOX_CHECK_EQ(
           connector_->connectorId(),
@@ -127,19 +132,26 @@ RowVectorPtr TableScan::getOutput() {
            },
            &debugString_});
 
+      startSplitResult(*connectorSplit);
+
       if (connectorSplit->dataSource) {
         ++numPreloadedSplits_;
         // The AsyncSource returns a unique_ptr to a shared_ptr. The
         // unique_ptr will be nullptr if there was a cancellation.
-        numReadyPreloadedSplits_ += connectorSplit->dataSource->hasValue();
+        const bool ready = connectorSplit->dataSource->hasValue();
+        numReadyPreloadedSplits_ += ready;
+        preloadScheduler().release(connectorSplit->preloadBytes, ready);
+        connectorSplit->preloadBytes = 0;
         auto preparedDataSource = connectorSplit->dataSource->move();
         if (!preparedDataSource) {
           // There must be a cancellation.
           VELOX_CHECK(operatorCtx_->task()->isCancelled());
           return nullptr;
         }
-        dataSource_->setFromDataSource(std::move(preparedDataSource));
-      } else {
+        if (cachedSplit_ == nullptr) {
+          dataSource_->setFromDataSource(std::move(preparedDataSource));
+        }
+      } else if (cachedSplit_ == nullptr) {
         dataSource_->addSplit(connectorSplit);
       }
       ++stats_.wlock()->numSplits;
@@ -151,6 +163,18 @@ RowVectorPtr TableScan::getOutput() {
           : outputBatchRows(estimatedRowSize);
     }
 
+    if (cachedSplit_ != nullptr) {
+      if (auto data = cachedSplit_->next()) {
+        stats_.wlock()->addInputVector(data->estimateFlatSize(), data->size());
+        consumeLimit(data->size());
+        return data;
+      }
+      cachedSplit_.reset();
+      driverCtx_->task->splitFinished();
+      needNewSplit_ = true;
+      continue;
+    }
+
     const auto ioTimeStartMicros = getCurrentTimeMicro();
     // Check for  cancellation since scans that filter everything out will not
     // hit the check in Driver.
@@ -164,6 +188,10 @@ RowVectorPtr TableScan::getOutput() {
          &debugString_});
 
     int readBatchSize = readBatchSize_;
+    if (remainingLimit_.has_value()) {
+      readBatchSize = std::max<int64_t>(
+          1, std::min<int64_t>(readBatchSize, remainingLimit_.value()));
+    }
     if (maxFilteringRatio_ > 0) {
       readBatchSize = std::min(
           maxReadBatchSize_,
@@ -196,6 +224,10 @@ RowVectorPtr TableScan::getOutput() {
               {maxFilteringRatio_,
                1.0 * data->size() / readBatchSize,
                1.0 / kMaxSelectiveBatchSizeMultiplier});
+          if (splitResult_ != nullptr) {
+            splitResult_->append(data);
+          }
+          consumeLimit(data->size());
           return data;
         }
         continue;
@@ -214,13 +246,42 @@ RowVectorPtr TableScan::getOutput() {
             "readyPreloadedSplits", RuntimeCounter(numReadyPreloadedSplits_));
         numReadyPreloadedSplits_ = 0;
       }
+      if (numThrottledPreloads_ > 0) {
+        lockedStats->addRuntimeStat(
+            "throttledPreloads", RuntimeCounter(numThrottledPreloads_));
+        numThrottledPreloads_ = 0;
+      }
     }
 
+    if (splitResult_ != nullptr) {
+      resultCache_->add(*splitResult_);
+      splitResult_.reset();
+    }
     driverCtx_->task->splitFinished();
     needNewSplit_ = true;
   }
 }
 
+void TableScan::startSplitResult(const connector::ConnectorSplit& split) {
+  if (resultCache_ == nullptr) {
+    return;
+  }
+  auto key = resultCache_->makeKey(split);
+  if (!key.has_value()) {
+    return;
+  }
+  cachedSplit_ = resultCache_->find(key.value(), outputType_, pool());
+  if (cachedSplit_ != nullptr) {
+    stats_.wlock()->addRuntimeStat(
+        "fragmentResultCacheHits", RuntimeCounter(1));
+    return;
+  }
+  if (!hasDynamicFilters_) {
+    splitResult_ = std::make_unique<FragmentResultCache::Writer>(
+        std::move(key.value()), pool());
+  }
+}
+
 void TableScan::preload(std::shared_ptr<connector::ConnectorSplit> split) {
   // The AsyncSource returns a unique_ptr to the shared_ptr of the
   // DataSource. The callback may outlive the Task, hence it captures
@@ -256,18 +317,39 @@ void TableScan::preload(std::shared_ptr<connector::ConnectorSplit> split) {
       });
 }
 
+void TableScan::consumeLimit(vector_size_t numRows) {
+  if (remainingLimit_.has_value()) {
+    const auto remaining = remainingLimit_.value();
+    remainingLimit_ = remaining - std::min<uint64_t>(numRows, remaining);
+  }
+}
+
 void TableScan::checkPreload() {
   auto executor = connector_->executor();
   if (FLAGS_split_preload_per_driver == 0 || !executor ||
       !connector_->supportsSplitPreload()) {
     return;
   }
+  if (remainingLimit_.has_value() &&
+      remainingLimit_.value() <= readBatchSize_) {
+    // The current split likely has the rows the Limit needs.
+    return;
+  }
   if (dataSource_->allPrefetchIssued()) {
     maxPreloadedSplits_ = driverCtx_->task->numDrivers(driverCtx_->driver) *
         FLAGS_split_preload_per_driver;
     if (!splitPreloader_) {
+      // The preloader runs under the Task mutex, so the scheduler is made
+      // here.
+      preloadScheduler();
       splitPreloader_ =
           [executor, this](std::shared_ptr<connector::ConnectorSplit> split) {
+            const auto bytes = estimatePreloadBytes(*split);
+            if (!preloadScheduler_->tryReserve(bytes)) {
+              ++numThrottledPreloads_;
+              return;
+            }
+            split->preloadBytes = bytes;
             preload(split);
 
             executor->add([taskHolder = operatorCtx_->task(), split]() mutable {
@@ -279,6 +361,62 @@ void TableScan::checkPreload() {
   }
 }
 
+SplitPreloadScheduler& TableScan::preloadScheduler() {
+  if (!preloadScheduler_) {
+    preloadScheduler_ = driverCtx_->task->splitPreloadScheduler(planNodeId());
+  }
+  return *preloadScheduler_;
+}
+
+uint64_t TableScan::estimatePreloadBytes(
+    const connector::ConnectorSplit& split) {
+  const auto size = split.size();
+  if (size == 0) {
+    return 0;
+  }
+  if (!scanTracker_) {
+    scanTracker_ =
+        connector::Connector::findTracker(connectorQueryCtx_->scanId());
+    if (!scanTracker_) {
+      return size;
+    }
+  }
+  const auto data = scanTracker_->totalTrackingData();
+  if (data.referencedBytes <= 0 || data.readBytes >= data.referencedBytes) {
+    return size;
+  }
+  return size * (static_cast<double>(data.readBytes) / data.referencedBytes);
+}
+
+void TableScan::recordConnectorStats() {
+  if (!dataSource_) {
+    return;
+  }
+  auto connectorStats = dataSource_->runtimeStats();
+  auto lockedStats = stats_.wlock();
+  for (const auto& [name, counter] : connectorStats) {
+    if (name == "ioWaitNanos") {
+      ioWaitNanos_ += counter.value - lastIoWaitNanos_;
+      lastIoWaitNanos_ = counter.value;
+    }
+    if (UNLIKELY(lockedStats->runtimeStats.count(name) == 0)) {
+      lockedStats->runtimeStats.insert(
+          std::make_pair(name, RuntimeMetric(counter.unit)));
+    } else {
+      VELOX_CHECK_EQ(lockedStats->runtimeStats.at(name).unit, counter.unit);
+    }
+    lockedStats->runtimeStats.at(name).addValue(counter.value);
+  }
+}
+
+bool TableScan::isCpuBound() const {
+  auto lockedStats = stats_.rlock();
+  const auto& timing = lockedStats->getOutputTiming;
+  // Time in getOutput() that is not CPU is synchronous IO wait. Blocked time
+  // is asynchronous IO and split wait.
+  return timing.cpuNanos * 2 > timing.wallNanos + lockedStats->blockedWallNanos;
+}
+
 bool TableScan::isFinished() {
   return noMoreSplits_;
 }
@@ -286,6 +424,9 @@ bool TableScan::isFinished() {
 void TableScan::addDynamicFilter(
     column_index_t outputChannel,
     const std::shared_ptr<common::Filter>& filter) {
+  // The output of the current split is no longer the unfiltered output.
+  hasDynamicFilters_ = true;
+  splitResult_.reset();
   if (dataSource_) {
     dataSource_->addDynamicFilter(outputChannel, filter);
   } else {
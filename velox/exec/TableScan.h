@@ -16,7 +16,9 @@
 #pragma once
 
 #include "velox/core/PlanNode.h"
+#include "velox/exec/FragmentResultCache.h"
 #include "velox/exec/Operator.h"
+#include "velox/exec/SplitPreloadScheduler.h"
 
 DECLARE_int32(split_preload_per_driver);
 
@@ -49,6 +51,14 @@ class TableScan : public SourceOperator {
       column_index_t outputChannel,
       const std::shared_ptr<common::Filter>& filter) override;
 
+  /// Sets the number of rows a Limit directly after 'this' needs. The reads
+  /// are then no larger than the remaining rows, so that the readers do not
+  /// decode a full batch for a few rows, and no splits are preloaded while
+  /// the remaining rows fit in a batch.
+  void setLimit(uint64_t numRows) {
+    remainingLimit_ = numRows;
+  }
+
   /// Returns process-wide cumulative IO wait time for all table
   /// scan. This is the blocked time. If running entirely from memory
   /// this would be 0.
@@ -63,12 +73,35 @@ class TableScan : public SourceOperator {
   // when getting splits.
   void checkPreload();
 
+  // Returns the scheduler shared by the drivers of the plan node.
+  SplitPreloadScheduler& preloadScheduler();
+
+  // Returns the estimated bytes a preload of 'split' reads. This is the size
+  // of 'split' scaled by the fraction of the referenced bytes that the scan
+  // has read according to its ScanTracker.
+  uint64_t estimatePreloadBytes(const connector::ConnectorSplit& split);
+
   // Sets 'split->dataSource' to be a Asyncsource that makes a
   // DataSource to read 'split'. This source will be prepared in the
   // background on the executor of the connector. If the DataSource is
   // needed before prepare is done, it will be made when needed.
   void preload(std::shared_ptr<connector::ConnectorSplit> split);
 
+  // Looks up the result of 'split' in 'resultCache_'. Sets 'cachedSplit_' on
+  // a hit. Sets 'splitResult_' on a miss if the result can be cached.
+  void startSplitResult(const connector::ConnectorSplit& split);
+
+  // Subtracts 'numRows' returned rows from 'remainingLimit_'.
+  void consumeLimit(vector_size_t numRows);
+
+  // Adds the runtime stats of 'dataSource_' to the stats of 'this'. Called
+  // once when 'this' takes no more splits.
+  void recordConnectorStats();
+
+  // Returns true if 'this' has spent more than half of its time on CPU, as
+  // opposed to waiting for IO or splits.
+  bool isCpuBound() const;
+
   // Process-wide IO wait time.
   static std::atomic<uint64_t> ioWaitNanos_;
 
@@ -105,10 +138,43 @@ class TableScan : public SourceOperator {
   // Count of splits that finished preloading before being read.
   int32_t numReadyPreloadedSplits_{0};
 
+  // Count of preloads not started because of the task-wide preload budget.
+  int32_t numThrottledPreloads_{0};
+
+  std::shared_ptr<SplitPreloadScheduler> preloadScheduler_;
+
+  // Tracker of the column reads of the scan. Set when the first preload is
+  // estimated after the DataSource has created the tracker.
+  std::shared_ptr<cache::ScanTracker> scanTracker_;
+
   int32_t readBatchSize_;
   int32_t maxReadBatchSize_;
+
+  // See QueryConfig::kSplitFileAffinity.
+  const bool splitFileAffinity_;
+
+  // ConnectorSplit::affinityKey() of the last split 'this' took. Empty if
+  // 'splitFileAffinity_' is false.
+  std::string lastAffinityKey_;
   double maxFilteringRatio_{0};
 
+  // The number of rows the Limit after 'this' still needs. See setLimit().
+  std::optional<uint64_t> remainingLimit_;
+
+  // Set if QueryConfig::kFragmentResultCacheEnabled and there is an
+  // AsyncDataCache.
+  std::unique_ptr<FragmentResultCache> resultCache_;
+
+  // Replays the cached result of the current split instead of 'dataSource_'.
+  std::unique_ptr<FragmentResultCache::Reader> cachedSplit_;
+
+  // Collects the output of the current split for 'resultCache_'.
+  std::unique_ptr<FragmentResultCache::Writer> splitResult_;
+
+  // True after the first dynamic filter was added. The output is then not
+  // cached.
+  bool hasDynamicFilters_{false};
+
   // String shown in ExceptionContext inside DataSource and LazyVector loading.
   std::string debugString_;
 
@@ -29,6 +29,7 @@
 #include "velox/exec/NestedLoopJoinBuild.h"
 #include "velox/exec/OperatorUtils.h"
 #include "velox/exec/PartitionedOutputBufferManager.h"
+#include "velox/exec/Spill.h"
 #include "velox/exec/Task.h"
 #if CODEGEN_ENABLED == 1
 #include "velox/experimental/codegen/CodegenLogger.h"
@@ -261,7 +262,12 @@ Task::Task(
       consumerSupplier_(std::move(consumerSupplier)),
       onError_(onError),
       splitsStates_(buildSplitStates(planFragment_.planNode)),
-      bufferManager_(PartitionedOutputBufferManager::getInstance()) {}
+      bufferManager_(PartitionedOutputBufferManager::getInstance()),
+      traceRecorder_(
+          queryCtx_->queryConfig().taskTraceBufferSize() > 0
+              ? std::make_unique<TaskTraceRecorder>(
+                    queryCtx_->queryConfig().taskTraceBufferSize())
+              : nullptr) {}
 
 Task::~Task() {
   TestValue::adjust("facebook::velox::exec::Task::~Task", this);
@@ -318,6 +324,13 @@ void Task::removeSpillDirectoryIfExists() {
       LOG(ERROR) << "Failed to remove spill directory '" << spillDirectory_
                  << "' for Task " << taskId() << ": " << e.what();
     }
+    try {
+      SpillTiers::instance().removeDirectory(spillDirectory_);
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Failed to remove overflow spill directory of '"
+                 << spillDirectory_ << "' for Task " << taskId() << ": "
+                 << e.what();
+    }
   }
 }
 
@@ -1008,6 +1021,15 @@ void Task::removeDriver(std::shared_ptr<Task> self, Driver* driver) {
   }
 }
 
+bool Task::hasMemoryForSplitGroupLocked() const {
+  const auto budget = queryCtx_->queryConfig().splitGroupMemoryBudget();
+  if (budget == 0 || numRunningSplitGroups_ == 0) {
+    return true;
+  }
+  const auto usedBytes = static_cast<uint64_t>(pool_->currentBytes());
+  return usedBytes + budget <= budget * concurrentSplitGroups_;
+}
+
 void Task::ensureSplitGroupsAreBeingProcessedLocked(
     std::shared_ptr<Task>& self) {
   // Only try creating more drivers if we are running.
@@ -1017,6 +1039,10 @@ void Task::ensureSplitGroupsAreBeingProcessedLocked(
 
   while (numRunningSplitGroups_ < concurrentSplitGroups_ and
          not queuedSplitGroups_.empty()) {
+    if (!hasMemoryForSplitGroupLocked()) {
+      ++taskStats_.numDeferredSplitGroups;
+      break;
+    }
     const uint32_t splitGroupId = queuedSplitGroups_.front();
     queuedSplitGroups_.pop();
 
@@ -1267,20 +1293,33 @@ bool Task::isAllSplitsFinishedLocked() {
       allNodesReceivedNoMoreSplitsMessageLocked();
 }
 
+std::shared_ptr<SplitPreloadScheduler> Task::splitPreloadScheduler(
+    const core::PlanNodeId& planNodeId) {
+  std::lock_guard<std::mutex> l(mutex_);
+  auto& splitsState = getPlanNodeSplitsStateLocked(planNodeId);
+  if (!splitsState.preloadScheduler) {
+    splitsState.preloadScheduler = std::make_shared<SplitPreloadScheduler>(
+        queryCtx_->queryConfig().maxSplitPreloadBytes());
+  }
+  return splitsState.preloadScheduler;
+}
+
 BlockingReason Task::getSplitOrFuture(
     uint32_t splitGroupId,
     const core::PlanNodeId& planNodeId,
     exec::Split& split,
     ContinueFuture& future,
     int32_t maxPreloadSplits,
-    std::function<void(std::shared_ptr<connector::ConnectorSplit>)> preload) {
+    std::function<void(std::shared_ptr<connector::ConnectorSplit>)> preload,
+    const std::string& affinityKey) {
   std::lock_guard<std::mutex> l(mutex_);
   return getSplitOrFutureLocked(
       getPlanNodeSplitsStateLocked(planNodeId).groupSplitsStores[splitGroupId],
       split,
       future,
       maxPreloadSplits,
-      preload);
+      preload,
+      affinityKey);
 }
 
 BlockingReason Task::getSplitOrFutureLocked(
@@ -1288,7 +1327,8 @@ BlockingReason Task::getSplitOrFutureLocked(
     exec::Split& split,
     ContinueFuture& future,
     int32_t maxPreloadSplits,
-    std::function<void(std::shared_ptr<connector::ConnectorSplit>)> preload) {
+    std::function<void(std::shared_ptr<connector::ConnectorSplit>)> preload,
+    const std::string& affinityKey) {
   if (splitsStore.splits.empty()) {
     if (splitsStore.noMoreSplits) {
       return BlockingReason::kNotBlocked;
@@ -1300,14 +1340,15 @@ BlockingReason Task::getSplitOrFutureLocked(
     return BlockingReason::kWaitForSplit;
   }
 
-  split = getSplitLocked(splitsStore, maxPreloadSplits, preload);
+  split = getSplitLocked(splitsStore, maxPreloadSplits, preload, affinityKey);
   return BlockingReason::kNotBlocked;
 }
 
 exec::Split Task::getSplitLocked(
     SplitsStore& splitsStore,
     int32_t maxPreloadSplits,
-    std::function<void(std::shared_ptr<connector::ConnectorSplit>)> preload) {
+    std::function<void(std::shared_ptr<connector::ConnectorSplit>)> preload,
+    const std::string& affinityKey) {
   int32_t readySplitIndex = -1;
   if (maxPreloadSplits) {
     for (auto i = 0; i < splitsStore.splits.size() && i < maxPreloadSplits;
@@ -1321,6 +1362,19 @@ exec::Split Task::getSplitLocked(
       }
     }
   }
+  if (readySplitIndex == -1 && !affinityKey.empty()) {
+    for (auto i = 0; i < splitsStore.splits.size() && i < kMaxAffinitySplits;
+         ++i) {
+      const auto& split = splitsStore.splits[i].connectorSplit;
+      if (split && split->affinityKey() == affinityKey) {
+        readySplitIndex = i;
+        if (i > 0) {
+          ++taskStats_.numAffinitySplits;
+        }
+        break;
+      }
+    }
+  }
   if (readySplitIndex == -1) {
     readySplitIndex = 0;
   }
@@ -1873,6 +1927,159 @@ TaskStats Task::taskStats() const {
   return taskStats;
 }
 
+namespace {
+
+// The counters of an operator reported by Task::progress(), summed over the
+// drivers of a pipeline.
+struct OperatorProgress {
+  core::PlanNodeId planNodeId;
+  std::string operatorType;
+  uint64_t inputPositions{0};
+  uint64_t outputPositions{0};
+  uint64_t blockedWallNanos{0};
+  uint64_t currentBytes{0};
+  uint64_t peakBytes{0};
+  uint64_t spilledBytes{0};
+  uint64_t spilledRows{0};
+  uint32_t spilledFiles{0};
+
+  void add(const OperatorStats& stats) {
+    if (operatorType.empty()) {
+      planNodeId = stats.planNodeId;
+      operatorType = stats.operatorType;
+    }
+    inputPositions += stats.inputPositions;
+    outputPositions += stats.outputPositions;
+    blockedWallNanos += stats.blockedWallNanos;
+    peakBytes =
+        std::max(peakBytes, stats.memoryStats.peakTotalMemoryReservation);
+    spilledBytes += stats.spilledBytes;
+    spilledRows += stats.spilledRows;
+    spilledFiles += stats.spilledFiles;
+  }
+
+  folly::dynamic toJson() const {
+    folly::dynamic obj = folly::dynamic::object;
+    obj["planNodeId"] = planNodeId;
+    obj["operatorType"] = operatorType;
+    obj["inputRows"] = inputPositions;
+    obj["outputRows"] = outputPositions;
+    obj["blockedWallNanos"] = blockedWallNanos;
+    obj["currentBytes"] = currentBytes;
+    obj["peakBytes"] = peakBytes;
+    obj["spilledBytes"] = spilledBytes;
+    obj["spilledRows"] = spilledRows;
+    obj["spilledFiles"] = spilledFiles;
+    return obj;
+  }
+};
+
+// The driver states of a pipeline reported by Task::progress().
+struct PipelineProgress {
+  std::vector<OperatorProgress> operators;
+  uint64_t numFinishedDrivers{0};
+  uint64_t numRunningDrivers{0};
+  uint64_t numTerminatedDrivers{0};
+  std::unordered_map<BlockingReason, uint64_t> numBlockedDrivers;
+};
+
+} // namespace
+
+folly::dynamic Task::progress() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  std::vector<PipelineProgress> pipelines(taskStats_.pipelineStats.size());
+  for (auto i = 0; i < pipelines.size(); ++i) {
+    const auto& operatorStats = taskStats_.pipelineStats[i].operatorStats;
+    pipelines[i].operators.resize(operatorStats.size());
+    for (auto j = 0; j < operatorStats.size(); ++j) {
+      pipelines[i].operators[j].add(operatorStats[j]);
+    }
+    // Each finished driver adds its stats with numDrivers 1 to the stats of
+    // its operators.
+    if (!operatorStats.empty()) {
+      pipelines[i].numFinishedDrivers = operatorStats[0].numDrivers;
+    }
+  }
+
+  for (const auto& driver : drivers_) {
+    if (driver == nullptr) {
+      continue;
+    }
+    auto& pipeline = pipelines[driver->driverCtx()->pipelineId];
+    for (auto* op : driver->operators()) {
+      OperatorProgress* opProgress;
+      {
+        auto lockedStats = op->stats().rlock();
+        opProgress = &pipeline.operators[lockedStats->operatorId];
+        opProgress->add(*lockedStats);
+      }
+      opProgress->currentBytes += op->pool()->currentBytes();
+      opProgress->peakBytes = std::max<uint64_t>(
+          opProgress->peakBytes, op->pool()->peakBytes());
+    }
+    if (driver->isOnThread()) {
+      ++pipeline.numRunningDrivers;
+    } else if (driver->isTerminated()) {
+      ++pipeline.numTerminatedDrivers;
+    } else {
+      ++pipeline.numBlockedDrivers[driver->blockingReason()];
+    }
+  }
+
+  folly::dynamic obj = folly::dynamic::object;
+  obj["taskId"] = taskId_;
+  obj["state"] = taskStateString(state_);
+  obj["elapsedMs"] = timeSinceStartMsLocked();
+  obj["numTotalSplits"] = taskStats_.numTotalSplits;
+  obj["numFinishedSplits"] = taskStats_.numFinishedSplits;
+  obj["numRunningSplits"] = taskStats_.numRunningSplits;
+  obj["numQueuedSplits"] = taskStats_.numQueuedSplits;
+  obj["currentBytes"] = pool_->currentBytes();
+  obj["reservedBytes"] = pool_->reservedBytes();
+  obj["peakBytes"] = pool_->peakBytes();
+
+  folly::dynamic pipelinesObj = folly::dynamic::array;
+  for (auto i = 0; i < pipelines.size(); ++i) {
+    const auto& pipeline = pipelines[i];
+    folly::dynamic pipelineObj = folly::dynamic::object;
+    pipelineObj["pipelineId"] = i;
+    pipelineObj["numFinishedDrivers"] = pipeline.numFinishedDrivers;
+    pipelineObj["numRunningDrivers"] = pipeline.numRunningDrivers;
+    pipelineObj["numTerminatedDrivers"] = pipeline.numTerminatedDrivers;
+    folly::dynamic blockedObj = folly::dynamic::object;
+    uint64_t numLiveDrivers =
+        pipeline.numRunningDrivers + pipeline.numTerminatedDrivers;
+    for (const auto& [reason, count] : pipeline.numBlockedDrivers) {
+      blockedObj[blockingReasonToString(reason)] = count;
+      numLiveDrivers += count;
+    }
+    pipelineObj["numBlockedDrivers"] = blockedObj;
+
+    // The share of finished drivers. The drivers of an input pipeline run
+    // until the splits run out, so the share of finished splits is a better
+    // estimate while they run.
+    const uint64_t numDrivers = pipeline.numFinishedDrivers + numLiveDrivers;
+    double completion =
+        numDrivers == 0 ? 0 : (double)pipeline.numFinishedDrivers / numDrivers;
+    if (taskStats_.pipelineStats[i].inputPipeline &&
+        taskStats_.numTotalSplits > 0 && numLiveDrivers > 0) {
+      completion = std::max(
+          completion,
+          (double)taskStats_.numFinishedSplits / taskStats_.numTotalSplits);
+    }
+    pipelineObj["estimatedCompletion"] = completion;
+
+    folly::dynamic operatorsObj = folly::dynamic::array;
+    for (const auto& opProgress : pipeline.operators) {
+      operatorsObj.push_back(opProgress.toJson());
+    }
+    pipelineObj["operators"] = std::move(operatorsObj);
+    pipelinesObj.push_back(std::move(pipelineObj));
+  }
+  obj["pipelines"] = std::move(pipelinesObj);
+  return obj;
+}
+
 uint64_t Task::timeSinceStartMs() const {
   std::lock_guard<std::mutex> l(mutex_);
   return timeSinceStartMsLocked();
@@ -2097,6 +2304,8 @@ void Task::createLocalExchangeQueuesLocked(
     exchange.queues.emplace_back(
         std::make_shared<LocalExchangeQueue>(exchange.memoryManager, i));
   }
+  exchange.scaleWriterState = std::make_shared<ScaleWriterState>(
+      numPartitions, queryCtx_->queryConfig().scaleWriterMinProcessedBytes());
 
   splitGroupState.localExchanges.insert({planNodeId, std::move(exchange)});
 }
@@ -2140,6 +2349,21 @@ Task::getLocalExchangeQueues(
   return it->second.queues;
 }
 
+std::shared_ptr<ScaleWriterState> Task::getScaleWriterState(
+    uint32_t splitGroupId,
+    const core::PlanNodeId& planNodeId) {
+  auto& splitGroupState = splitGroupStates_[splitGroupId];
+
+  auto it = splitGroupState.localExchanges.find(planNodeId);
+  VELOX_CHECK(
+      it != splitGroupState.localExchanges.end(),
+      "Incorrect local exchange ID {} for group {}, task {}",
+      planNodeId,
+      splitGroupId,
+      taskId());
+  return it->second.scaleWriterState;
+}
+
 void Task::setError(const std::exception_ptr& exception) {
   TestValue::adjust("facebook::velox::exec::Task::setError", this);
   {
@@ -2177,7 +2401,10 @@ std::string Task::errorMessage() const {
   return errorMessageLocked();
 }
 
-StopReason Task::enter(ThreadState& state, uint64_t nowMicros) {
+StopReason Task::enter(
+    ThreadState& state,
+    uint64_t nowMicros,
+    uint64_t queuedNanos) {
   std::lock_guard<std::mutex> l(mutex_);
   VELOX_CHECK(state.isEnqueued);
   state.isEnqueued = false;
@@ -2196,6 +2423,10 @@ StopReason Task::enter(ThreadState& state, uint64_t nowMicros) {
     if (numThreads_ == 1) {
       onThreadSince_ = nowMicros;
     }
+    ++taskStats_.numDriverRuns;
+    taskStats_.driverQueuedWallNanos += queuedNanos;
+    taskStats_.maxDriverQueuedWallNanos =
+        std::max(taskStats_.maxDriverQueuedWallNanos, queuedNanos);
     state.setThread();
     state.hasBlockingFuture = false;
   }
@@ -2337,6 +2568,33 @@ StopReason Task::shouldStop() {
   return StopReason::kNone;
 }
 
+std::string Task::toChromeTrace() const {
+  VELOX_USER_CHECK_NOT_NULL(
+      traceRecorder_,
+      "Tracing is disabled for task {}, set {} to enable it",
+      taskId_,
+      core::QueryConfig::kTaskTraceBufferSize);
+  return traceRecorder_->toChromeTrace();
+}
+
+bool Task::tryRetireScanDriver(const DriverCtx& driverCtx) {
+  const auto budget = queryCtx_->queryConfig().maxRunningDriversPerTask();
+  if (budget == 0 || driverCtx.splitGroupId != kUngroupedGroupId) {
+    return false;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  if (numThreads_ <= static_cast<int32_t>(budget) || terminateRequested_) {
+    return false;
+  }
+  auto& numRetired = numRetiredScanDrivers_[driverCtx.pipelineId];
+  if (numRetired + 1 >= driverFactories_[driverCtx.pipelineId]->numDrivers) {
+    return false;
+  }
+  ++numRetired;
+  ++taskStats_.numRetiredDrivers;
+  return true;
+}
+
 int32_t Task::yieldIfDue(uint64_t startTimeMicros) {
   if (onThreadSince_ < startTimeMicros) {
     std::lock_guard<std::mutex> l(mutex_);
@@ -2396,7 +2654,8 @@ void Task::createExchangeClient(
       taskId_,
       destination_,
       addExchangeClientPool(planNodeId, pipelineId),
-      queryCtx()->queryConfig().maxExchangeBufferSize());
+      queryCtx()->queryConfig().maxExchangeBufferSize(),
+      queryCtx()->queryConfig().exchangeRequestWindowPages());
   exchangeClientByPlanNode_.emplace(planNodeId, exchangeClients_[pipelineId]);
 }
 
@@ -23,6 +23,7 @@
 #include "velox/exec/Split.h"
 #include "velox/exec/TaskStats.h"
 #include "velox/exec/TaskStructs.h"
+#include "velox/exec/TaskTraceRecorder.h"
 #include "velox/vector/ComplexVector.h"
 
 namespace facebook::velox::exec {
@@ -253,6 +254,15 @@ class Task : public std::enable_shared_from_this<Task> {
   /// structure.
   TaskStats taskStats() const;
 
+  /// Returns a snapshot of the progress of a running task for monitoring,
+  /// e.g. polling every second. Lighter than taskStats(): copies only the
+  /// counters of the live operators and no runtime stats. The result has the
+  /// task state, splits and memory, and per pipeline the driver states, an
+  /// estimated completion ratio in [0, 1] and per operator the rows in and
+  /// out, the blocked time, the current and peak memory and the spill
+  /// progress.
+  folly::dynamic progress() const;
+
   /// Returns time (ms) since the task execution started or zero, if not
   /// started.
   uint64_t timeSinceStartMs() const;
@@ -328,7 +338,10 @@ class Task : public std::enable_shared_from_this<Task> {
   /// that will complete when split becomes available or no-more-splits
   /// signal is received. If 'maxPreloadSplits' is given, ensures that
   /// so many of splits at the head of the queue are preloading. If
-  /// they are not, calls preload on them to start preload.
+  /// they are not, calls preload on them to start preload. A split whose
+  /// preload is done is taken first. Otherwise, if 'affinityKey' is not empty,
+  /// the first split with that ConnectorSplit::affinityKey() among the next
+  /// kMaxAffinitySplits queued splits is taken, then the head of the queue.
   BlockingReason getSplitOrFuture(
       uint32_t splitGroupId,
       const core::PlanNodeId& planNodeId,
@@ -336,7 +349,18 @@ class Task : public std::enable_shared_from_this<Task> {
       ContinueFuture& future,
       int32_t maxPreloadSplits = 0,
       std::function<void(std::shared_ptr<connector::ConnectorSplit>)> preload =
-          nullptr);
+          nullptr,
+      const std::string& affinityKey = "");
+
+  /// The number of queued splits getSplitOrFuture() looks at for a split with
+  /// a matching affinity key.
+  static constexpr int32_t kMaxAffinitySplits = 64;
+
+  /// Returns the scheduler that budgets the split preloads of all drivers of
+  /// the plan node with specified ID. The budget is given by
+  /// QueryConfig::maxSplitPreloadBytes().
+  std::shared_ptr<SplitPreloadScheduler> splitPreloadScheduler(
+      const core::PlanNodeId& planNodeId);
 
   void splitFinished();
 
@@ -378,6 +402,10 @@ class Task : public std::enable_shared_from_this<Task> {
       uint32_t splitGroupId,
       const core::PlanNodeId& planNodeId);
 
+  std::shared_ptr<ScaleWriterState> getScaleWriterState(
+      uint32_t splitGroupId,
+      const core::PlanNodeId& planNodeId);
+
   void setError(const std::exception_ptr& exception);
 
   void setError(const std::string& message);
@@ -468,8 +496,12 @@ class Task : public std::enable_shared_from_this<Task> {
   /// incremented if kNone is returned. If something else is returned the
   /// calling thread should unwind and return itself to its pool. If 'this' goes
   /// from no threads running to one thread running, sets 'onThreadSince_' to
-  /// 'nowMicros'.
-  StopReason enter(ThreadState& state, uint64_t nowMicros = 0);
+  /// 'nowMicros'. 'queuedNanos' is the time the Driver spent in the executor
+  /// queue and is added to the scheduling stats in TaskStats.
+  StopReason enter(
+      ThreadState& state,
+      uint64_t nowMicros = 0,
+      uint64_t queuedNanos = 0);
 
   /// Sets the state to terminated. Returns kAlreadyOnThread if the
   /// Driver is running. In this case, the Driver will free resources
@@ -539,6 +571,19 @@ class Task : public std::enable_shared_from_this<Task> {
     toYield_ = numThreads_;
   }
 
+  /// Records that a Driver yielded after using up its time slice.
+  void addDriverTimeSliceYield() {
+    std::lock_guard<std::mutex> l(mutex_);
+    ++taskStats_.numDriverTimeSliceYields;
+  }
+
+  /// Returns true if the table scan Driver with 'driverCtx' should stop taking
+  /// splits because more Drivers of 'this' are on thread than
+  /// QueryConfig::kMaxRunningDriversPerTask allows. At least one Driver of each
+  /// pipeline is kept so that the remaining splits get read. Applies only to
+  /// ungrouped execution.
+  bool tryRetireScanDriver(const DriverCtx& driverCtx);
+
   /// Requests yield if 'this' is running and has had at least one Driver on
   /// thread since before 'startTimeMicros'. Returns the number of threads in
   /// 'this' at the time of requesting yield. Returns 0 if yield not requested.
@@ -574,6 +619,16 @@ class Task : public std::enable_shared_from_this<Task> {
     return spillDirectory_;
   }
 
+  /// Returns the trace recorder or nullptr if tracing is disabled. See
+  /// QueryConfig::kTaskTraceBufferSize.
+  TaskTraceRecorder* traceRecorder() const {
+    return traceRecorder_.get();
+  }
+
+  /// Returns the recorded trace events in the Chrome trace event JSON format.
+  /// Throws if tracing is disabled.
+  std::string toChromeTrace() const;
+
   /// True if produces output via PartitionedOutputBufferManager.
   bool hasPartitionedOutput() const {
     return numDriversInPartitionedOutput_ > 0;
@@ -722,14 +777,16 @@ class Task : public std::enable_shared_from_this<Task> {
       ContinueFuture& future,
       int32_t maxPreloadSplits = 0,
       std::function<void(std::shared_ptr<connector::ConnectorSplit>)> preload =
-          nullptr);
+          nullptr,
+      const std::string& affinityKey = "");
 
   /// Returns next split from the store. The caller must ensure the store is not
   /// empty.
   exec::Split getSplitLocked(
       SplitsStore& splitsStore,
       int32_t maxPreloadSplits,
-      std::function<void(std::shared_ptr<connector::ConnectorSplit>)> preload);
+      std::function<void(std::shared_ptr<connector::ConnectorSplit>)> preload,
+      const std::string& affinityKey = "");
 
   /// Creates for the given split group and fills up the 'SplitGroupState'
   /// structure, which stores inter-operator state (local exchange, bridges).
@@ -746,6 +803,10 @@ class Task : public std::enable_shared_from_this<Task> {
   /// processed. If yes, creates split group state and Drivers and runs them.
   void ensureSplitGroupsAreBeingProcessedLocked(std::shared_ptr<Task>& self);
 
+  // Returns true if the memory of the task leaves room for starting one more
+  // split group. See QueryConfig::kSplitGroupMemoryBudget.
+  bool hasMemoryForSplitGroupLocked() const;
+
   void driverClosedLocked();
 
   /// Returns true if Task is in kRunning state, but all output drivers finished
@@ -942,6 +1003,9 @@ class Task : public std::enable_shared_from_this<Task> {
   /// (in a single split group). We use it to recalculate the number of
   /// producing drivers at the end during the Grouped Execution mode.
   uint32_t numDriversInPartitionedOutput_{0};
+  /// The number of table scan drivers retired per pipeline. See
+  /// tryRetireScanDriver().
+  std::unordered_map<uint32_t, uint32_t> numRetiredScanDrivers_;
   /// True if the pipeline hosting the Partitioned Output runs in the Grouped
   /// Execution mode. In this case we will need to update the number of output
   /// drivers in the end. False otherwise.
@@ -1018,6 +1082,9 @@ class Task : public std::enable_shared_from_this<Task> {
 
   // Base spill directory for this task.
   std::string spillDirectory_;
+
+  // Set if QueryConfig::kTaskTraceBufferSize is non-zero.
+  const std::unique_ptr<TaskTraceRecorder> traceRecorder_;
 };
 
 /// Listener invoked on task completion.
@@ -86,6 +86,26 @@ struct TaskStats {
   /// Drivers blocked for various reasons. Based on enum BlockingReason.
   std::unordered_map<BlockingReason, uint64_t> numBlockedDrivers;
 
+  /// The number of times a driver got on thread after being enqueued on the
+  /// executor.
+  uint64_t numDriverRuns{0};
+  /// Total and max wall time drivers spent in the executor queue before
+  /// getting on thread.
+  uint64_t driverQueuedWallNanos{0};
+  uint64_t maxDriverQueuedWallNanos{0};
+  /// The number of times a driver yielded because it used up its time slice.
+  /// See QueryConfig::kDriverCpuTimeSliceLimitMs.
+  uint64_t numDriverTimeSliceYields{0};
+  /// The number of splits given to a driver because they had the same
+  /// affinity key as the driver's previous split, ahead of older splits.
+  uint64_t numAffinitySplits{0};
+  /// The number of table scan drivers that finished early to keep the task
+  /// within its thread budget. See QueryConfig::kMaxRunningDriversPerTask.
+  uint64_t numRetiredDrivers{0};
+  /// The number of times a queued split group was held back because the task
+  /// had no memory for it. See QueryConfig::kSplitGroupMemoryBudget.
+  uint64_t numDeferredSplitGroups{0};
+
   /// Output buffer's memory utilization ratio measured as
   /// current buffer usage / max buffer size
   double outputBufferUtilization{0};
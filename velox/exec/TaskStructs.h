@@ -19,6 +19,7 @@
 #include <vector>
 
 #include "velox/exec/SpillOperatorGroup.h"
+#include "velox/exec/SplitPreloadScheduler.h"
 
 namespace facebook::velox::exec {
 
@@ -27,6 +28,7 @@ class JoinBridge;
 class LocalExchangeMemoryManager;
 class MergeSource;
 class MergeJoinSource;
+class ScaleWriterState;
 class Split;
 class SpillOperatorGroup;
 
@@ -66,6 +68,10 @@ struct SplitsState {
   /// Map split group id -> split store.
   std::unordered_map<uint32_t, SplitsStore> groupSplitsStores;
 
+  /// Budgets the split preloads of all drivers of the plan node. Created on
+  /// first use.
+  std::shared_ptr<SplitPreloadScheduler> preloadScheduler;
+
   /// We need these due to having promises in the structure.
   SplitsState() = default;
   SplitsState(SplitsState const&) = delete;
@@ -76,6 +82,8 @@ struct SplitsState {
 struct LocalExchangeState {
   std::shared_ptr<LocalExchangeMemoryManager> memoryManager;
   std::vector<std::shared_ptr<LocalExchangeQueue>> queues;
+  /// Used by the producers if the exchange is a scale-writer one.
+  std::shared_ptr<ScaleWriterState> scaleWriterState;
 };
 
 /// Stores inter-operator state (exchange, bridges) for split groups.
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/TaskTraceRecorder.h"
+
+#include <folly/json.h>
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::exec {
+
+TaskTraceRecorder::TaskTraceRecorder(size_t capacity) : capacity_(capacity) {
+  VELOX_CHECK_GT(capacity_, 0);
+  events_.reserve(capacity_);
+}
+
+void TaskTraceRecorder::record(TaskTraceEvent event) {
+  std::lock_guard<std::mutex> l(mutex_);
+  if (events_.size() < capacity_) {
+    events_.push_back(std::move(event));
+    return;
+  }
+  events_[next_] = std::move(event);
+  next_ = (next_ + 1) % capacity_;
+  ++numDropped_;
+}
+
+std::vector<TaskTraceEvent> TaskTraceRecorder::events() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  std::vector<TaskTraceEvent> result;
+  result.reserve(events_.size());
+  for (size_t i = 0; i < events_.size(); ++i) {
+    result.push_back(events_[(next_ + i) % events_.size()]);
+  }
+  return result;
+}
+
+uint64_t TaskTraceRecorder::numDropped() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return numDropped_;
+}
+
+std::string TaskTraceRecorder::toChromeTrace() const {
+  folly::dynamic traceEvents = folly::dynamic::array;
+  for (const auto& event : events()) {
+    folly::dynamic obj = folly::dynamic::object;
+    obj["name"] = event.name;
+    obj["ph"] = "X";
+    obj["ts"] = event.startMicros;
+    obj["dur"] = event.durationMicros;
+    obj["pid"] = event.pipelineId;
+    obj["tid"] = event.driverId;
+    obj["args"] = folly::dynamic::object("detail", event.detail);
+    traceEvents.push_back(std::move(obj));
+  }
+  folly::dynamic trace = folly::dynamic::object;
+  trace["traceEvents"] = std::move(traceEvents);
+  trace["displayTimeUnit"] = "ms";
+  return folly::toJson(trace);
+}
+
+} // namespace facebook::velox::exec
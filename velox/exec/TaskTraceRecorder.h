@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace facebook::velox::exec {
+
+/// An interval in the life of a Driver, e.g. time on thread, in the executor
+/// queue or blocked.
+struct TaskTraceEvent {
+  /// Kind of the interval, e.g. "run", "queued", "blocked" or "reclaim". Must
+  /// be a string literal.
+  const char* name;
+
+  /// Free form detail, e.g. the stop or blocking reason and the operator.
+  std::string detail;
+
+  uint32_t pipelineId;
+  uint32_t driverId;
+  uint64_t startMicros;
+  uint64_t durationMicros;
+};
+
+/// Keeps the most recent 'capacity' TaskTraceEvents of a Task in a ring
+/// buffer. Thread-safe. Events are recorded at Driver transitions, i.e. at
+/// most a few per batch, so a mutex is cheap enough. See
+/// QueryConfig::kTaskTraceBufferSize.
+class TaskTraceRecorder {
+ public:
+  explicit TaskTraceRecorder(size_t capacity);
+
+  void record(TaskTraceEvent event);
+
+  /// Returns the retained events, oldest first.
+  std::vector<TaskTraceEvent> events() const;
+
+  /// Returns the number of events that were overwritten by newer ones.
+  uint64_t numDropped() const;
+
+  /// Returns the retained events in the Chrome trace event JSON format, which
+  /// chrome://tracing and Perfetto load. Pipelines show up as processes and
+  /// Drivers as threads.
+  std::string toChromeTrace() const;
+
+ private:
+  const size_t capacity_;
+  mutable std::mutex mutex_;
+  std::vector<TaskTraceEvent> events_;
+  // Position of the next write once 'events_' is full.
+  size_t next_{0};
+  uint64_t numDropped_{0};
+};
+
+} // namespace facebook::velox::exec
@@ -14,10 +14,98 @@
  * limitations under the License.
  */
 #include "velox/exec/TopN.h"
+#include "velox/common/base/SimdUtil.h"
 #include "velox/exec/ContainerRowSerde.h"
+#include "velox/exec/Driver.h"
 #include "velox/vector/FlatVector.h"
 
 namespace facebook::velox::exec {
+namespace {
+template <typename T>
+int32_t compareAsc(T left, T right) {
+  if constexpr (std::is_floating_point_v<T>) {
+    // NaN sorts after all other values.
+    const bool isLeftNan = std::isnan(left);
+    const bool isRightNan = std::isnan(right);
+    if (isLeftNan) {
+      return isRightNan ? 0 : 1;
+    }
+    if (isRightNan) {
+      return -1;
+    }
+  }
+  return left < right ? -1 : left == right ? 0 : 1;
+}
+
+// Sets the bits in 'candidates' for the first 'numRows' values in 'values'
+// that are <= 'bound' if 'kAscending' and >= 'bound' otherwise. 'candidates'
+// is expected to be all clear.
+template <typename T, bool kAscending>
+void markCandidatesSimd(
+    const T* values,
+    vector_size_t numRows,
+    T bound,
+    uint64_t* candidates) {
+  using Batch = xsimd::batch<T>;
+  constexpr int32_t kBatchSize = Batch::size;
+  static_assert(64 % kBatchSize == 0);
+  const auto boundBatch = Batch::broadcast(bound);
+  vector_size_t row = 0;
+  for (; row + kBatchSize <= numRows; row += kBatchSize) {
+    const auto batch = Batch::load_unaligned(values + row);
+    const uint64_t mask = static_cast<uint32_t>(simd::toBitMask(
+        kAscending ? batch <= boundBatch : batch >= boundBatch));
+    candidates[row / 64] |= mask << (row % 64);
+  }
+  for (; row < numRows; ++row) {
+    if (kAscending ? values[row] <= bound : values[row] >= bound) {
+      bits::setBit(candidates, row);
+    }
+  }
+}
+
+// Sets the bits in 'candidates' for the first 'numRows' rows of 'decoded'
+// that do not sort after 'bound'. Null rows are candidates only if nulls
+// sort first. 'candidates' is expected to be all clear.
+template <typename T>
+void markCandidates(
+    DecodedVector& decoded,
+    vector_size_t numRows,
+    T bound,
+    const core::SortOrder& sortOrder,
+    uint64_t* candidates) {
+  if constexpr (std::is_integral_v<T>) {
+    if (decoded.isIdentityMapping()) {
+      // Values at null positions are arbitrary. Their bits are reset below.
+      if (sortOrder.isAscending()) {
+        markCandidatesSimd<T, true>(
+            decoded.data<T>(), numRows, bound, candidates);
+      } else {
+        markCandidatesSimd<T, false>(
+            decoded.data<T>(), numRows, bound, candidates);
+      }
+      if (auto* nulls = decoded.nulls()) {
+        bits::andBits(candidates, nulls, 0, numRows);
+      }
+    }
+  }
+  if (!decoded.isIdentityMapping() || !std::is_integral_v<T>) {
+    for (auto row = 0; row < numRows; ++row) {
+      if (decoded.isNullAt(row)) {
+        continue;
+      }
+      const auto result = compareAsc(decoded.valueAt<T>(row), bound);
+      if (sortOrder.isAscending() ? result <= 0 : result >= 0) {
+        bits::setBit(candidates, row);
+      }
+    }
+  }
+  if (auto* nulls = decoded.nulls(); nulls && sortOrder.isNullsFirst()) {
+    bits::orWithNegatedBits(candidates, nulls, 0, numRows);
+  }
+}
+} // namespace
+
 TopN::TopN(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -36,15 +124,37 @@ TopN::TopN(
           topNNode->sortingOrders(),
           data_.get()),
       topRows_(comparator_),
-      decodedVectors_(outputType_->children().size()) {}
+      decodedVectors_(outputType_->children().size()),
+      leadingKeyOrder_(topNNode->sortingOrders()[0]) {
+  for (const auto& key : topNNode->sortingKeys()) {
+    keyChannels_.push_back(exprToChannel(key.get(), outputType_));
+  }
+}
 
 void TopN::addInput(RowVectorPtr input) {
-  // TODO Decode keys first, then decode the rest only for passing positions
+  const auto numInput = input->size();
+  for (auto channel : keyChannels_) {
+    decodedVectors_[channel].decode(*input->childAt(channel));
+  }
+
+  if (topRows_.size() < count_) {
+    candidateRows_.resizeFill(numInput, true);
+  } else {
+    markCandidateRows(numInput);
+    numPreFilteredRows_ += numInput - candidateRows_.countSelected();
+    if (!candidateRows_.hasSelections()) {
+      return;
+    }
+  }
+
   for (auto col = 0; col < input->childrenSize(); ++col) {
-    decodedVectors_[col].decode(*input->childAt(col));
+    if (std::find(keyChannels_.begin(), keyChannels_.end(), col) ==
+        keyChannels_.end()) {
+      decodedVectors_[col].decode(*input->childAt(col), candidateRows_);
+    }
   }
 
-  for (auto row = 0; row < input->size(); ++row) {
+  candidateRows_.applyToSelected([&](auto row) {
     char* newRow = nullptr;
     if (topRows_.size() < count_) {
       newRow = data_->newRow();
@@ -52,7 +162,7 @@ void TopN::addInput(RowVectorPtr input) {
       char* topRow = topRows_.top();
 
       if (!comparator_(decodedVectors_, row, topRow)) {
-        continue;
+        return;
       }
       topRows_.pop();
       // Reuse the topRow's memory.
@@ -64,7 +174,158 @@ void TopN::addInput(RowVectorPtr input) {
     }
 
     topRows_.push(newRow);
+  });
+
+  if (topRows_.size() == count_) {
+    updateDynamicFilter();
+  }
+}
+
+void TopN::markCandidateRows(vector_size_t numRows) {
+  const auto channel = keyChannels_[0];
+  const auto& column = data_->columnAt(channel);
+  const char* topRow = topRows_.top();
+  if (RowContainer::isNullAt(topRow, column.nullByte(), column.nullMask())) {
+    candidateRows_.resizeFill(numRows, true);
+    return;
+  }
+
+  candidateRows_.resizeFill(numRows, false);
+  auto* candidates = candidateRows_.asMutableRange().bits();
+  auto& decoded = decodedVectors_[channel];
+  const auto offset = column.offset();
+  switch (outputType_->childAt(channel)->kind()) {
+    case TypeKind::TINYINT:
+      markCandidates(
+          decoded,
+          numRows,
+          RowContainer::valueAt<int8_t>(topRow, offset),
+          leadingKeyOrder_,
+          candidates);
+      break;
+    case TypeKind::SMALLINT:
+      markCandidates(
+          decoded,
+          numRows,
+          RowContainer::valueAt<int16_t>(topRow, offset),
+          leadingKeyOrder_,
+          candidates);
+      break;
+    case TypeKind::INTEGER:
+      markCandidates(
+          decoded,
+          numRows,
+          RowContainer::valueAt<int32_t>(topRow, offset),
+          leadingKeyOrder_,
+          candidates);
+      break;
+    case TypeKind::BIGINT:
+      markCandidates(
+          decoded,
+          numRows,
+          RowContainer::valueAt<int64_t>(topRow, offset),
+          leadingKeyOrder_,
+          candidates);
+      break;
+    case TypeKind::REAL:
+      markCandidates(
+          decoded,
+          numRows,
+          RowContainer::valueAt<float>(topRow, offset),
+          leadingKeyOrder_,
+          candidates);
+      break;
+    case TypeKind::DOUBLE:
+      markCandidates(
+          decoded,
+          numRows,
+          RowContainer::valueAt<double>(topRow, offset),
+          leadingKeyOrder_,
+          candidates);
+      break;
+    case TypeKind::TIMESTAMP:
+      markCandidates(
+          decoded,
+          numRows,
+          RowContainer::valueAt<Timestamp>(topRow, offset),
+          leadingKeyOrder_,
+          candidates);
+      break;
+    default:
+      candidateRows_.setAll();
+      break;
   }
+  candidateRows_.updateBounds();
+}
+
+void TopN::updateDynamicFilter() {
+  const auto channel = keyChannels_[0];
+  const auto kind = outputType_->childAt(channel)->kind();
+  // Floating point keys are not pushed down since NaN sorts after all other
+  // values while range filters do not pass it.
+  if (kind != TypeKind::TINYINT && kind != TypeKind::SMALLINT &&
+      kind != TypeKind::INTEGER && kind != TypeKind::BIGINT &&
+      kind != TypeKind::TIMESTAMP) {
+    return;
+  }
+  if (outputType_->childAt(channel)->isDecimal()) {
+    return;
+  }
+  if (!canPushdownFilter_.has_value()) {
+    canPushdownFilter_ =
+        !operatorCtx_->driverCtx()
+             ->driver->canPushdownFilters(this, {channel})
+             .empty();
+  }
+  if (!canPushdownFilter_.value()) {
+    return;
+  }
+
+  const auto& column = data_->columnAt(channel);
+  const char* topRow = topRows_.top();
+  if (RowContainer::isNullAt(topRow, column.nullByte(), column.nullMask())) {
+    return;
+  }
+
+  const bool ascending = leadingKeyOrder_.isAscending();
+  const bool nullAllowed = leadingKeyOrder_.isNullsFirst();
+  const auto offset = column.offset();
+  if (kind == TypeKind::TIMESTAMP) {
+    const auto bound = RowContainer::valueAt<Timestamp>(topRow, offset);
+    if (pushedTimestampBound_ == bound) {
+      return;
+    }
+    pushedTimestampBound_ = bound;
+    dynamicFilters_[channel] = std::make_shared<common::TimestampRange>(
+        ascending ? Timestamp::min() : bound,
+        ascending ? bound : Timestamp::max(),
+        nullAllowed);
+    return;
+  }
+
+  int64_t bound;
+  switch (kind) {
+    case TypeKind::TINYINT:
+      bound = RowContainer::valueAt<int8_t>(topRow, offset);
+      break;
+    case TypeKind::SMALLINT:
+      bound = RowContainer::valueAt<int16_t>(topRow, offset);
+      break;
+    case TypeKind::INTEGER:
+      bound = RowContainer::valueAt<int32_t>(topRow, offset);
+      break;
+    default:
+      bound = RowContainer::valueAt<int64_t>(topRow, offset);
+      break;
+  }
+  if (pushedBigintBound_ == bound) {
+    return;
+  }
+  pushedBigintBound_ = bound;
+  dynamicFilters_[channel] = std::make_shared<common::BigintRange>(
+      ascending ? std::numeric_limits<int64_t>::min() : bound,
+      ascending ? bound : std::numeric_limits<int64_t>::max(),
+      nullAllowed);
 }
 
 RowVectorPtr TopN::getOutput() {
@@ -93,6 +354,9 @@ RowVectorPtr TopN::getOutput() {
 
 void TopN::noMoreInput() {
   Operator::noMoreInput();
+  if (numPreFilteredRows_ > 0) {
+    addRuntimeStat("preFilteredRows", RuntimeCounter(numPreFilteredRows_));
+  }
   if (topRows_.empty()) {
     finished_ = true;
     return;
@@ -44,6 +44,19 @@ class TopN : public Operator {
   bool isFinished() override;
 
  private:
+  // Clears the bits in 'candidateRows_' for the first 'numRows' rows of the
+  // input whose leading sorting key sorts after the leading key of the top
+  // row of a full 'topRows_'. Rows that tie on the leading key are kept and
+  // resolved by 'comparator_'. Leaves all rows selected if the leading key
+  // type is not supported.
+  void markCandidateRows(vector_size_t numRows);
+
+  // Produces a dynamic filter on the leading sorting key that passes only
+  // values that can still make it into the top rows. The filter is pushed
+  // down to the upstream TableScan by the Driver. Called after each input
+  // batch once 'topRows_' is full.
+  void updateDynamicFilter();
+
   const int32_t count_;
 
   bool finished_ = false;
@@ -65,5 +78,26 @@ class TopN : public Operator {
 
   std::vector<DecodedVector> decodedVectors_;
   vector_size_t outputBatchSize_;
+
+  // Input channels of the sorting keys. These are decoded for all input rows.
+  // The remaining columns are decoded only for 'candidateRows_'.
+  std::vector<column_index_t> keyChannels_;
+  core::SortOrder leadingKeyOrder_;
+
+  // Input rows which may sort before the top row in 'topRows_'.
+  SelectivityVector candidateRows_;
+
+  // Number of input rows discarded by comparing the leading sorting key
+  // against the top row in bulk.
+  uint64_t numPreFilteredRows_{0};
+
+  // Set on first use. True if a filter on the leading key can be pushed down
+  // to the upstream source operator.
+  std::optional<bool> canPushdownFilter_;
+
+  // Bound of the last produced dynamic filter. Only one of these is set
+  // depending on the type of the leading key.
+  std::optional<int64_t> pushedBigintBound_;
+  std::optional<Timestamp> pushedTimestampBound_;
 };
 } // namespace facebook::velox::exec
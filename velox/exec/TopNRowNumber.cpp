@@ -14,9 +14,63 @@
  * limitations under the License.
  */
 #include "velox/exec/TopNRowNumber.h"
+#include "velox/exec/OperatorUtils.h"
 
 namespace facebook::velox::exec {
 
+namespace {
+// Returns the input channels in the order they are stored in the row
+// container: partitioning keys, sorting keys and then the rest of the input
+// columns. A column that appears more than once is only stored once.
+std::vector<column_index_t> reorderInputChannels(
+    const RowTypePtr& inputType,
+    const std::vector<core::FieldAccessTypedExprPtr>& partitionKeys,
+    const std::vector<core::FieldAccessTypedExprPtr>& sortingKeys) {
+  const auto numInput = inputType->size();
+  std::vector<bool> added(numInput, false);
+  std::vector<column_index_t> channels;
+  channels.reserve(numInput);
+  auto addChannel = [&](column_index_t channel) {
+    if (!added[channel]) {
+      added[channel] = true;
+      channels.push_back(channel);
+    }
+  };
+  for (const auto& key : partitionKeys) {
+    addChannel(inputType->getChildIdx(key->name()));
+  }
+  for (const auto& key : sortingKeys) {
+    addChannel(inputType->getChildIdx(key->name()));
+  }
+  for (auto i = 0; i < numInput; ++i) {
+    addChannel(i);
+  }
+  return channels;
+}
+
+RowTypePtr makeStoreType(
+    const RowTypePtr& inputType,
+    const std::vector<column_index_t>& channels) {
+  std::vector<std::string> names;
+  std::vector<TypePtr> types;
+  names.reserve(channels.size());
+  types.reserve(channels.size());
+  for (auto channel : channels) {
+    names.push_back(inputType->nameOf(channel));
+    types.push_back(inputType->childAt(channel));
+  }
+  return ROW(std::move(names), std::move(types));
+}
+
+CompareFlags fromSortOrderToCompareFlags(const core::SortOrder& sortOrder) {
+  return {
+      sortOrder.isNullsFirst(),
+      sortOrder.isAscending(),
+      false,
+      CompareFlags::NullHandlingMode::NoStop};
+}
+} // namespace
+
 TopNRowNumber::TopNRowNumber(
     int32_t operatorId,
     DriverCtx* driverCtx,
@@ -26,13 +80,21 @@ TopNRowNumber::TopNRowNumber(
           node->outputType(),
           operatorId,
           node->id(),
-          "TopNRowNumber"),
+          "TopNRowNumber",
+          node->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
       limit_{node->limit()},
       generateRowNumber_{node->generateRowNumber()},
       inputType_{node->sources()[0]->outputType()},
-      data_(std::make_unique<RowContainer>(inputType_->children(), pool())),
-      comparator_(
+      inputChannels_{reorderInputChannels(
           inputType_,
+          node->partitionKeys(),
+          node->sortingKeys())},
+      storeType_{makeStoreType(inputType_, inputChannels_)},
+      data_(std::make_unique<RowContainer>(storeType_->children(), pool())),
+      comparator_(
+          storeType_,
           node->sortingKeys(),
           node->sortingOrders(),
           data_.get()),
@@ -40,6 +102,29 @@ TopNRowNumber::TopNRowNumber(
   const auto& keys = node->partitionKeys();
   const auto numKeys = keys.size();
 
+  // The partitioning keys are sorted in ascending order with nulls first. The
+  // order doesn't matter as long as the rows of a partition are adjacent.
+  const core::SortOrder partitionSortOrder(true, true);
+  for (const auto& key : keys) {
+    if (storeType_->getChildIdx(key->name()) == spillCompareFlags_.size()) {
+      spillCompareFlags_.push_back(
+          fromSortOrderToCompareFlags(partitionSortOrder));
+    }
+  }
+  numPartitionKeyColumns_ = spillCompareFlags_.size();
+  const auto& sortingKeys = node->sortingKeys();
+  for (auto i = 0; i < sortingKeys.size(); ++i) {
+    if (storeType_->getChildIdx(sortingKeys[i]->name()) ==
+        spillCompareFlags_.size()) {
+      spillCompareFlags_.push_back(
+          fromSortOrderToCompareFlags(node->sortingOrders()[i]));
+    }
+  }
+
+  for (auto i = 0; i < inputChannels_.size(); ++i) {
+    spillColumnMap_.emplace_back(i, inputChannels_[i]);
+  }
+
   if (numKeys > 0) {
     Accumulator accumulator{true, sizeof(TopRows), false, 1, [](auto) {}};
 
@@ -71,10 +156,18 @@ TopNRowNumber::TopNRowNumber(
 }
 
 void TopNRowNumber::addInput(RowVectorPtr input) {
+  if (spillEnabled()) {
+    maybeTestSpill();
+  }
+
+  // Prevents the memory arbitrator to reclaim memory from this operator while
+  // the partitions are being updated.
+  NonReclaimableSection guard(this);
+
   const auto numInput = input->size();
 
-  for (auto i = 0; i < inputType_->size(); ++i) {
-    decodedVectors_[i].decode(*input->childAt(i));
+  for (auto i = 0; i < inputChannels_.size(); ++i) {
+    decodedVectors_[i].decode(*input->childAt(inputChannels_[i]));
   }
 
   if (table_) {
@@ -147,6 +240,95 @@ void TopNRowNumber::noMoreInput() {
 
   outputBatchSize_ = outputBatchRows(rowSize);
   outputRows_.resize(outputBatchSize_);
+
+  if (spiller_ == nullptr) {
+    return;
+  }
+
+  // Spills the remaining rows and merges all the spilled runs.
+  spill();
+  // We shouldn't get any rows from non-spilled partition as there is only one
+  // hash partition for order by spiller.
+  Spiller::SpillRows nonSpilledRows = spiller_->finishSpill();
+  VELOX_CHECK_LE(spiller_->stats().spilledPartitions, 1);
+  VELOX_CHECK(nonSpilledRows.empty());
+  recordSpillStats(spiller_->stats());
+
+  VELOX_CHECK_NULL(merge_);
+  merge_ = spiller_->startMerge(0);
+  spillSources_.resize(outputBatchSize_);
+  spillSourceRows_.resize(outputBatchSize_);
+}
+
+void TopNRowNumber::reclaim(
+    uint64_t /*targetBytes*/,
+    memory::MemoryReclaimer::Stats& stats) {
+  VELOX_CHECK(canReclaim());
+
+  // NOTE: a top n row number operator is reclaimable if it hasn't started
+  // producing output and is not under non-reclaimable execution section.
+  if (noMoreInput_ || nonReclaimableSection_) {
+    ++stats.numNonReclaimableAttempts;
+    LOG(WARNING) << "Can't reclaim from top n row number operator, "
+                 << "noMoreInput_[" << noMoreInput_
+                 << "], nonReclaimableSection_[" << nonReclaimableSection_
+                 << "], " << pool()->name();
+    return;
+  }
+  spill();
+}
+
+void TopNRowNumber::maybeTestSpill() {
+  if (spillConfig_->testSpillPct == 0 || data_->numRows() == 0) {
+    return;
+  }
+  if (folly::hasher<uint64_t>()(++spillTestCounter_) % 100 <=
+      spillConfig_->testSpillPct) {
+    spill();
+  }
+}
+
+void TopNRowNumber::spill() {
+  VELOX_CHECK(spillEnabled());
+
+  // Check if there is any row to spill.
+  if (data_->numRows() == 0) {
+    return;
+  }
+
+  if (spiller_ == nullptr) {
+    const auto& spillConfig = spillConfig_.value();
+    spiller_ = std::make_unique<Spiller>(
+        Spiller::Type::kOrderBy,
+        data_.get(),
+        [&](folly::Range<char**> rows) { data_->eraseRows(rows); },
+        storeType_,
+        spillCompareFlags_.size(),
+        spillCompareFlags_,
+        spillConfig.filePath,
+        std::numeric_limits<uint64_t>::max(),
+        spillConfig.writeBufferSize,
+        spillConfig.minSpillRunSize,
+        spillConfig.compressionKind,
+        Spiller::pool(),
+        spillConfig.executor,
+        spillConfig.writeRateLimiter);
+    VELOX_CHECK_EQ(spiller_->state().maxPartitions(), 1);
+  }
+
+  spiller_->spill(0, 0);
+  VELOX_CHECK_EQ(data_->numRows(), 0);
+
+  // Each spilled run has at most 'limit' rows per partition. The partitions
+  // are started over for the following input.
+  destroyPartitions();
+  if (table_) {
+    table_->clear();
+  } else {
+    singlePartition_ = std::make_unique<TopRows>(allocator_.get(), comparator_);
+  }
+  data_->clear();
+  pool()->release();
 }
 
 TopNRowNumber::TopRows* TopNRowNumber::nextPartition() {
@@ -214,6 +396,10 @@ RowVectorPtr TopNRowNumber::getOutput() {
     return nullptr;
   }
 
+  if (merge_ != nullptr) {
+    return getOutputFromSpill();
+  }
+
   // Loop over partitions and emit sorted rows along with row numbers.
   auto output =
       BaseVector::create<RowVector>(outputType_, outputBatchSize_, pool());
@@ -267,10 +453,100 @@ RowVectorPtr TopNRowNumber::getOutput() {
   }
   output->resize(offset);
 
-  for (int i = 0; i < inputType_->size(); ++i) {
-    data_->extractColumn(outputRows_.data(), offset, i, output->childAt(i));
+  for (int i = 0; i < inputChannels_.size(); ++i) {
+    data_->extractColumn(
+        outputRows_.data(), offset, i, output->childAt(inputChannels_[i]));
+  }
+
+  return output;
+}
+
+RowVectorPtr TopNRowNumber::getOutputFromSpill() {
+  auto output =
+      BaseVector::create<RowVector>(outputType_, outputBatchSize_, pool());
+  FlatVector<int64_t>* rowNumbers = nullptr;
+  if (generateRowNumber_) {
+    rowNumbers = output->children().back()->as<FlatVector<int64_t>>();
+    rowNumbers->resize(outputBatchSize_);
+  }
+
+  // The merged rows are sorted by partitioning keys and then by sorting keys.
+  // Returns the first 'limit' rows of each partition.
+  vector_size_t outputRow = 0;
+  vector_size_t outputSize = 0;
+  bool isEndOfBatch = false;
+  while (outputRow + outputSize < outputBatchSize_) {
+    SpillMergeStream* stream = merge_->next();
+    if (stream == nullptr) {
+      break;
+    }
+
+    const auto& current = stream->current();
+    const auto index = stream->currentIndex(&isEndOfBatch);
+
+    bool newPartition = spillPartitionKeys_ == nullptr;
+    for (auto i = 0; !newPartition && i < numPartitionKeyColumns_; ++i) {
+      newPartition = !current.childAt(i)->equalValueAt(
+          spillPartitionKeys_->childAt(i).get(), index, 0);
+    }
+    if (newPartition) {
+      if (spillPartitionKeys_ == nullptr) {
+        spillPartitionKeys_ =
+            BaseVector::create<RowVector>(storeType_, 1, pool());
+      }
+      for (auto i = 0; i < numPartitionKeyColumns_; ++i) {
+        spillPartitionKeys_->childAt(i)->copy(
+            current.childAt(i).get(), 0, index, 1);
+      }
+      spillRowNumber_ = 0;
+    }
+
+    if (++spillRowNumber_ <= limit_) {
+      if (rowNumbers) {
+        rowNumbers->set(outputRow + outputSize, spillRowNumber_);
+      }
+      spillSources_[outputSize] = &current;
+      spillSourceRows_[outputSize] = index;
+      ++outputSize;
+    }
+
+    if (FOLLY_UNLIKELY(isEndOfBatch)) {
+      // The stream is at end of input batch. Need to copy out the rows before
+      // fetching next batch in 'pop'.
+      gatherCopy(
+          output.get(),
+          outputRow,
+          outputSize,
+          spillSources_,
+          spillSourceRows_,
+          spillColumnMap_);
+      outputRow += outputSize;
+      outputSize = 0;
+    }
+    // Advance the stream.
+    stream->pop();
   }
 
+  if (outputSize != 0) {
+    gatherCopy(
+        output.get(),
+        outputRow,
+        outputSize,
+        spillSources_,
+        spillSourceRows_,
+        spillColumnMap_);
+    outputRow += outputSize;
+  }
+
+  if (outputRow == 0) {
+    finished_ = true;
+    return nullptr;
+  }
+
+  if (rowNumbers) {
+    rowNumbers->resize(outputRow);
+  }
+  output->resize(outputRow);
   return output;
 }
 
@@ -279,6 +555,11 @@ bool TopNRowNumber::isFinished() {
 }
 
 void TopNRowNumber::close() {
+  destroyPartitions();
+  merge_.reset();
+}
+
+void TopNRowNumber::destroyPartitions() {
   if (table_) {
     partitionIt_.reset();
     partitions_.resize(1000);
@@ -292,6 +573,7 @@ void TopNRowNumber::close() {
             reinterpret_cast<TopRows*>(partitions_[i] + partitionOffset_));
       }
     }
+    partitionIt_.reset();
   }
 }
 
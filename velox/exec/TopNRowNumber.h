@@ -34,6 +34,11 @@ namespace facebook::velox::exec {
 ///
 /// This is an optimized version of a Window operator with a single row_number
 /// window function followed by a row_number <= N filter.
+///
+/// If spilling is enabled, the top rows of all the partitions accumulated so
+/// far are sorted by partitioning and sorting keys and spilled to disk when
+/// asked to reclaim memory. After all the input has been received, the spilled
+/// runs are merged and the first 'limit' rows of each partition are returned.
 class TopNRowNumber : public Operator {
  public:
   TopNRowNumber(
@@ -59,6 +64,9 @@ class TopNRowNumber : public Operator {
 
   void close() override;
 
+  void reclaim(uint64_t targetBytes, memory::MemoryReclaimer::Stats& stats)
+      override;
+
  private:
   /// A priority queue to keep track of top 'limit' rows for a given partition.
   struct TopRows {
@@ -77,8 +85,15 @@ class TopNRowNumber : public Operator {
         : rows{{comparator}, StlAllocator<char*>(allocator)} {}
   };
 
+  bool spillEnabled() const {
+    return spillConfig_.has_value();
+  }
+
   void initializeNewPartitions();
 
+  /// Destroys the TopRows structs of all the partitions.
+  void destroyPartitions();
+
   TopRows& partitionAt(char* group) {
     return *reinterpret_cast<TopRows*>(group + partitionOffset_);
   }
@@ -105,10 +120,29 @@ class TopNRowNumber : public Operator {
       vector_size_t outputOffset,
       FlatVector<int64_t>* rowNumbers);
 
+  /// Spills the accumulated rows if the test-only spill percentage triggers.
+  void maybeTestSpill();
+
+  /// Sorts and spills all the rows in 'data_' and clears the partitions.
+  void spill();
+
+  /// Returns the next output batch by merging the spilled runs. Skips the rows
+  /// of each partition past the first 'limit' ones.
+  RowVectorPtr getOutputFromSpill();
+
   const int32_t limit_;
   const bool generateRowNumber_;
   const RowTypePtr inputType_;
 
+  /// Input channels in the order the columns are stored in 'data_': the
+  /// partitioning keys first, then the sorting keys and then the rest of the
+  /// input columns. A column that appears more than once is only stored once.
+  /// The spiller sorts the rows on the leading key columns of 'data_'.
+  const std::vector<column_index_t> inputChannels_;
+
+  /// The type of the rows in 'data_'.
+  const RowTypePtr storeType_;
+
   /// Hash table to keep track of partitions. Not used if there are no
   /// partitioning keys. For each partition, stores an instance of TopRows
   /// struct.
@@ -143,5 +177,32 @@ class TopNRowNumber : public Operator {
   size_t numPartitions_{0};
   std::optional<int32_t> currentPartition_;
   vector_size_t remainingRowsInPartition_{0};
+
+  /// Number of distinct partitioning key columns in 'data_'.
+  column_index_t numPartitionKeyColumns_{0};
+
+  /// Compare flags of the partitioning and sorting key columns of 'data_'.
+  std::vector<CompareFlags> spillCompareFlags_;
+
+  std::unique_ptr<Spiller> spiller_;
+
+  /// Merges the spilled runs after all the input has been received.
+  std::unique_ptr<TreeOfLosers<SpillMergeStream>> merge_;
+
+  /// Source vectors and rows of the next output batch produced from spill.
+  std::vector<const RowVector*> spillSources_;
+  std::vector<vector_size_t> spillSourceRows_;
+
+  /// Maps the columns of the spilled rows to the output columns.
+  std::vector<IdentityProjection> spillColumnMap_;
+
+  /// The partitioning keys of the last row read from spill.
+  RowVectorPtr spillPartitionKeys_;
+
+  /// Row number of the last row read from spill within its partition.
+  int64_t spillRowNumber_{0};
+
+  /// Counts the input batches for the test-only spill path.
+  uint32_t spillTestCounter_{0};
 };
 } // namespace facebook::velox::exec
@@ -151,6 +151,31 @@ class TreeOfLosers {
         : std::make_pair(streams_[lastIndex_].get(), result.second);
   }
 
+  /// Returns the stream with the lowest first element other than the stream
+  /// returned by the last next(), or nullptr if there is no other stream with
+  /// data. This is the least of the streams that lost to the last winner on
+  /// its path to the root. The caller may pop elements off the last winner
+  /// while they are not greater than the first element of the returned stream
+  /// before calling next() again.
+  Stream* runnerUp() const {
+    if (lastIndex_ == kEmpty || values_.empty()) {
+      return nullptr;
+    }
+    TIndex best = kEmpty;
+    for (TIndex node = parent(firstStream_ + lastIndex_);;
+         node = parent(node)) {
+      const auto value = values_[node];
+      if (value != kEmpty &&
+          (best == kEmpty || *streams_[value] < *streams_[best])) {
+        best = value;
+      }
+      if (node == 0) {
+        break;
+      }
+    }
+    return best == kEmpty ? nullptr : streams_[best].get();
+  }
+
  private:
   static constexpr TIndex kEmpty = std::numeric_limits<TIndex>::max();
 
@@ -58,51 +58,40 @@ Unnest::Unnest(
 
 void Unnest::addInput(RowVectorPtr input) {
   input_ = std::move(input);
-}
-
-RowVectorPtr Unnest::getOutput() {
-  if (!input_) {
-    return nullptr;
-  }
+  nextInputRow_ = 0;
+  nextElement_ = 0;
 
-  auto size = input_->size();
+  const auto size = input_->size();
   inputRows_.resize(size);
 
-  // The max number of elements at each row across all unnested columns.
-  auto maxSizes = AlignedBuffer::allocate<int64_t>(size, pool(), 0);
-  auto rawMaxSizes = maxSizes->asMutable<int64_t>();
+  maxSizes_ = AlignedBuffer::allocate<int64_t>(size, pool(), 0);
+  auto rawMaxSizes = maxSizes_->asMutable<int64_t>();
 
-  std::vector<const vector_size_t*> rawSizes;
-  std::vector<const vector_size_t*> rawOffsets;
-  std::vector<const vector_size_t*> rawIndices;
-
-  rawSizes.resize(unnestChannels_.size());
-  rawOffsets.resize(unnestChannels_.size());
-  rawIndices.resize(unnestChannels_.size());
+  rawSizes_.resize(unnestChannels_.size());
+  rawOffsets_.resize(unnestChannels_.size());
+  rawIndices_.resize(unnestChannels_.size());
 
   for (auto channel = 0; channel < unnestChannels_.size(); ++channel) {
     const auto& unnestVector = input_->childAt(unnestChannels_[channel]);
     unnestDecoded_[channel].decode(*unnestVector, inputRows_);
 
     auto& currentDecoded = unnestDecoded_[channel];
-    rawIndices[channel] = currentDecoded.indices();
+    rawIndices_[channel] = currentDecoded.indices();
 
-    const ArrayVector* unnestBaseArray;
-    const MapVector* unnestBaseMap;
     if (unnestVector->typeKind() == TypeKind::ARRAY) {
-      unnestBaseArray = currentDecoded.base()->as<ArrayVector>();
-      rawSizes[channel] = unnestBaseArray->rawSizes();
-      rawOffsets[channel] = unnestBaseArray->rawOffsets();
+      auto unnestBaseArray = currentDecoded.base()->as<ArrayVector>();
+      rawSizes_[channel] = unnestBaseArray->rawSizes();
+      rawOffsets_[channel] = unnestBaseArray->rawOffsets();
     } else {
       VELOX_CHECK(unnestVector->typeKind() == TypeKind::MAP);
-      unnestBaseMap = currentDecoded.base()->as<MapVector>();
-      rawSizes[channel] = unnestBaseMap->rawSizes();
-      rawOffsets[channel] = unnestBaseMap->rawOffsets();
+      auto unnestBaseMap = currentDecoded.base()->as<MapVector>();
+      rawSizes_[channel] = unnestBaseMap->rawSizes();
+      rawOffsets_[channel] = unnestBaseMap->rawOffsets();
     }
 
     // Count max number of elements per row.
-    auto currentSizes = rawSizes[channel];
-    auto currentIndices = rawIndices[channel];
+    auto currentSizes = rawSizes_[channel];
+    auto currentIndices = rawIndices_[channel];
     for (auto row = 0; row < size; ++row) {
       if (!currentDecoded.isNullAt(row)) {
         auto unnestSize = currentSizes[currentIndices[row]];
@@ -112,26 +101,74 @@ RowVectorPtr Unnest::getOutput() {
       }
     }
   }
+}
 
-  // Calculate the number of rows in the unnest result.
-  int numElements = 0;
-  for (auto row = 0; row < size; ++row) {
-    numElements += rawMaxSizes[row];
+RowVectorPtr Unnest::getOutput() {
+  if (!input_) {
+    return nullptr;
   }
 
-  if (numElements == 0) {
-    // All arrays/maps are null or empty.
+  const auto size = input_->size();
+  const auto* rawMaxSizes = maxSizes_->as<int64_t>();
+  const auto maxOutputRows = outputBatchRows();
+
+  // Take the elements of the next rows up to the output batch size. The last
+  // row may have more elements, which the next batch returns.
+  const auto firstRow = nextInputRow_;
+  const auto firstRowStart = nextElement_;
+  vector_size_t lastRow = firstRow;
+  vector_size_t lastRowEnd = firstRowStart;
+  vector_size_t numElements = 0;
+  for (auto row = firstRow; row < size && numElements < maxOutputRows;
+       ++row) {
+    const vector_size_t start = row == firstRow ? firstRowStart : 0;
+    const auto count = std::min<int64_t>(
+        rawMaxSizes[row] - start, maxOutputRows - numElements);
+    numElements += count;
+    lastRow = row;
+    lastRowEnd = start + count;
+  }
+  if (lastRowEnd == rawMaxSizes[lastRow]) {
+    nextInputRow_ = lastRow + 1;
+    nextElement_ = 0;
+  } else {
+    nextInputRow_ = lastRow;
+    nextElement_ = lastRowEnd;
+  }
+
+  RowVectorPtr output;
+  if (numElements > 0) {
+    output = generateOutput(
+        firstRow, firstRowStart, lastRow, lastRowEnd, numElements);
+  }
+  if (nextInputRow_ == size) {
     input_ = nullptr;
-    return nullptr;
   }
+  return output;
+}
+
+RowVectorPtr Unnest::generateOutput(
+    vector_size_t firstRow,
+    vector_size_t firstRowStart,
+    vector_size_t lastRow,
+    vector_size_t lastRowEnd,
+    vector_size_t numElements) {
+  const auto* rawMaxSizes = maxSizes_->as<int64_t>();
+  // The elements [start, end) of 'row' are in the output.
+  auto rowStart = [&](vector_size_t row) -> vector_size_t {
+    return row == firstRow ? firstRowStart : 0;
+  };
+  auto rowEnd = [&](vector_size_t row) -> vector_size_t {
+    return row == lastRow ? lastRowEnd : rawMaxSizes[row];
+  };
 
   // Create "indices" buffer to repeat rows as many times as there are elements
   // in the array (or map) in unnestDecoded.
   auto repeatedIndices = allocateIndices(numElements, pool());
   auto* rawRepeatedIndices = repeatedIndices->asMutable<vector_size_t>();
   vector_size_t index = 0;
-  for (auto row = 0; row < size; ++row) {
-    for (auto i = 0; i < rawMaxSizes[row]; i++) {
+  for (auto row = firstRow; row <= lastRow; ++row) {
+    for (auto i = rowStart(row); i < rowEnd(row); ++i) {
       rawRepeatedIndices[index++] = row;
     }
   }
@@ -147,9 +184,9 @@ RowVectorPtr Unnest::getOutput() {
   vector_size_t outputsIndex = identityProjections_.size();
   for (auto channel = 0; channel < unnestChannels_.size(); ++channel) {
     auto& currentDecoded = unnestDecoded_[channel];
-    auto currentSizes = rawSizes[channel];
-    auto currentOffsets = rawOffsets[channel];
-    auto currentIndices = rawIndices[channel];
+    auto currentSizes = rawSizes_[channel];
+    auto currentOffsets = rawOffsets_[channel];
+    auto currentIndices = rawIndices_[channel];
 
     BufferPtr elementIndices = allocateIndices(numElements, pool());
     auto* rawElementIndices = elementIndices->asMutable<vector_size_t>();
@@ -159,58 +196,75 @@ RowVectorPtr Unnest::getOutput() {
     auto rawNulls = nulls->asMutable<uint64_t>();
 
     // Make dictionary index for elements column since they may be out of order.
+    // The elements are a slice of the base elements if they are consecutive
+    // and have no nulls.
     index = 0;
-    bool identityMapping = true;
-    for (auto row = 0; row < size; ++row) {
-      auto maxSize = rawMaxSizes[row];
+    std::optional<vector_size_t> firstElement;
+    bool consecutive = true;
+    for (auto row = firstRow; row <= lastRow; ++row) {
+      const auto start = rowStart(row);
+      const auto end = rowEnd(row);
+      if (start == end) {
+        continue;
+      }
 
       if (!currentDecoded.isNullAt(row)) {
         auto offset = currentOffsets[currentIndices[row]];
         auto unnestSize = currentSizes[currentIndices[row]];
 
-        if (index != offset || unnestSize < maxSize) {
-          identityMapping = false;
+        if (!firstElement.has_value()) {
+          firstElement = offset + start;
+        }
+        if (offset + start != firstElement.value() + index ||
+            unnestSize < end) {
+          consecutive = false;
         }
 
-        for (auto i = 0; i < unnestSize; i++) {
+        for (auto i = start; i < std::min(unnestSize, end); ++i) {
           rawElementIndices[index++] = offset + i;
         }
 
-        for (auto i = unnestSize; i < maxSize; ++i) {
+        for (auto i = std::max(unnestSize, start); i < end; ++i) {
           bits::setNull(rawNulls, index++, true);
         }
-      } else if (maxSize > 0) {
-        identityMapping = false;
+      } else {
+        consecutive = false;
 
-        for (auto i = 0; i < maxSize; ++i) {
+        for (auto i = start; i < end; ++i) {
           bits::setNull(rawNulls, index++, true);
         }
       }
     }
+    if (!consecutive) {
+      firstElement.reset();
+    }
 
     if (currentDecoded.base()->typeKind() == TypeKind::ARRAY) {
       // Construct unnest column using Array elements wrapped using above
       // created dictionary.
       auto unnestBaseArray = currentDecoded.base()->as<ArrayVector>();
-      outputs[outputsIndex++] = identityMapping
-          ? unnestBaseArray->elements()
-          : wrapChild(
-                numElements,
-                elementIndices,
-                unnestBaseArray->elements(),
-                nulls);
+      outputs[outputsIndex++] = wrapElements(
+          numElements,
+          elementIndices,
+          nulls,
+          firstElement,
+          unnestBaseArray->elements());
     } else {
       // Construct two unnest columns for Map keys and values vectors wrapped
       // using above created dictionary.
       auto unnestBaseMap = currentDecoded.base()->as<MapVector>();
-      outputs[outputsIndex++] = identityMapping
-          ? unnestBaseMap->mapKeys()
-          : wrapChild(
-                numElements, elementIndices, unnestBaseMap->mapKeys(), nulls);
-      outputs[outputsIndex++] = identityMapping
-          ? unnestBaseMap->mapValues()
-          : wrapChild(
-                numElements, elementIndices, unnestBaseMap->mapValues(), nulls);
+      outputs[outputsIndex++] = wrapElements(
+          numElements,
+          elementIndices,
+          nulls,
+          firstElement,
+          unnestBaseMap->mapKeys());
+      outputs[outputsIndex++] = wrapElements(
+          numElements,
+          elementIndices,
+          nulls,
+          firstElement,
+          unnestBaseMap->mapValues());
     }
   }
 
@@ -221,21 +275,36 @@ RowVectorPtr Unnest::getOutput() {
     // Set the ordinality at each result row to be the index of the element in
     // the original array (or map) plus one.
     auto rawOrdinality = ordinalityVector->mutableRawValues();
-    for (auto row = 0; row < size; ++row) {
-      auto maxSize = rawMaxSizes[row];
-      std::iota(rawOrdinality, rawOrdinality + maxSize, 1);
-      rawOrdinality += maxSize;
+    for (auto row = firstRow; row <= lastRow; ++row) {
+      const auto start = rowStart(row);
+      const auto end = rowEnd(row);
+      std::iota(rawOrdinality, rawOrdinality + (end - start), start + 1);
+      rawOrdinality += end - start;
     }
 
     // Ordinality column is always at the end.
     outputs.back() = std::move(ordinalityVector);
   }
 
-  input_ = nullptr;
   return std::make_shared<RowVector>(
       pool(), outputType_, BufferPtr(nullptr), numElements, std::move(outputs));
 }
 
+VectorPtr Unnest::wrapElements(
+    vector_size_t numElements,
+    const BufferPtr& elementIndices,
+    const BufferPtr& nulls,
+    std::optional<vector_size_t> firstElement,
+    const VectorPtr& elements) const {
+  if (!firstElement.has_value()) {
+    return wrapChild(numElements, elementIndices, elements, nulls);
+  }
+  if (firstElement.value() == 0 && elements->size() == numElements) {
+    return elements;
+  }
+  return elements->slice(firstElement.value(), numElements);
+}
+
 bool Unnest::isFinished() {
   return noMoreInput_ && input_ == nullptr;
 }
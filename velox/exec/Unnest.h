@@ -29,7 +29,7 @@ class Unnest : public Operator {
   }
 
   bool needsInput() const override {
-    return true;
+    return input_ == nullptr;
   }
 
   void addInput(RowVectorPtr input) override;
@@ -39,11 +39,46 @@ class Unnest : public Operator {
   bool isFinished() override;
 
  private:
+  // Returns the unnested elements [firstRowStart, lastRowEnd) of the input
+  // rows [firstRow, lastRow], where firstRowStart applies to 'firstRow' and
+  // lastRowEnd to 'lastRow'. The other rows have all their elements.
+  RowVectorPtr generateOutput(
+      vector_size_t firstRow,
+      vector_size_t firstRowStart,
+      vector_size_t lastRow,
+      vector_size_t lastRowEnd,
+      vector_size_t numElements);
+
+  // Returns the unnested 'elements' of the output rows. Returns a slice of
+  // 'elements' starting at 'firstElement' if set, i.e. if the elements are
+  // consecutive and not null. Otherwise returns a dictionary over 'elements'
+  // with 'elementIndices' and 'nulls'.
+  VectorPtr wrapElements(
+      vector_size_t numElements,
+      const BufferPtr& elementIndices,
+      const BufferPtr& nulls,
+      std::optional<vector_size_t> firstElement,
+      const VectorPtr& elements) const;
+
   std::vector<column_index_t> unnestChannels_;
 
   SelectivityVector inputRows_;
   std::vector<DecodedVector> unnestDecoded_;
 
+  // Sizes, offsets and indices of the arrays or maps in 'unnestDecoded_'.
+  std::vector<const vector_size_t*> rawSizes_;
+  std::vector<const vector_size_t*> rawOffsets_;
+  std::vector<const vector_size_t*> rawIndices_;
+
+  // The max number of elements at each row of 'input_' across all unnested
+  // columns.
+  BufferPtr maxSizes_;
+
+  // The next row of 'input_' to unnest and the number of its elements that
+  // previous batches already returned. Large arrays are split across batches.
+  vector_size_t nextInputRow_{0};
+  vector_size_t nextElement_{0};
+
   const bool withOrdinality_;
 };
 } // namespace facebook::velox::exec
@@ -21,6 +21,10 @@ bool VectorHasher::tryMapToRangeSimd(
     const SelectivityVector& rows,
     uint64_t* result) {
   bool inRange = true;
+  // With a single key the ids are stored while checking the range. Otherwise
+  // they are combined with the ids of the other keys once all values are
+  // known to be in range.
+  const bool storeIds = sizeof(T) == sizeof(uint64_t) && multiplier_ == 1;
   auto allLow = xsimd::broadcast<T>(min_);
   auto allHigh = xsimd::broadcast<T>(max_);
   auto allOne = xsimd::broadcast<T>(1);
@@ -32,7 +36,7 @@ bool VectorHasher::tryMapToRangeSimd(
     int32_t ltMin = simd::toBitMask(data < allLow);
     // value - (low - 1) doesn't work when low is the lowest possible (e.g.
     // std::numeric_limits<int64_t>::min())
-    if constexpr (sizeof(T) == sizeof(uint64_t)) {
+    if (storeIds) {
       (data - allLow + allOne).store_unaligned(result + row);
     }
     if ((gtMax | ltMin) != 0) {
@@ -48,14 +52,23 @@ bool VectorHasher::tryMapToRangeSimd(
         inRange = false;
         break;
       }
-      if constexpr (sizeof(T) == sizeof(uint64_t)) {
+      if (storeIds) {
         result[row] = value - min_ + 1;
       }
     }
-    if constexpr (sizeof(T) != sizeof(uint64_t)) {
+    if (!inRange || storeIds) {
+      return inRange;
+    }
+    // Branch-free loops over consecutive rows so that the compiler can
+    // vectorize the widening and the multiply-add.
+    if (multiplier_ == 1) {
       for (row = rows.begin(); row < rows.end(); row++) {
         result[row] = values[row] - min_ + 1;
       }
+    } else {
+      for (row = rows.begin(); row < rows.end(); row++) {
+        result[row] += multiplier_ * (values[row] - min_ + 1);
+      }
     }
   }
   return inRange;
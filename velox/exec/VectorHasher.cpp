@@ -19,6 +19,7 @@
 #include "velox/common/base/Portability.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/memory/HashStringAllocator.h"
+#include "velox/exec/ByteComparableSerde.h"
 
 namespace facebook::velox::exec {
 
@@ -55,8 +56,12 @@ template <TypeKind Kind>
 uint64_t hashOne(DecodedVector& decoded, vector_size_t index) {
   if (Kind == TypeKind::ROW || Kind == TypeKind::ARRAY ||
       Kind == TypeKind::MAP) {
-    // Virtual function call for complex type.
-    return decoded.base()->hashValueAt(decoded.index(index));
+    // Complex type values are hashed by their serialization in a
+    // RowContainer so that the hashes of stored and probed keys match.
+    std::string serialized;
+    ByteComparableSerde::serialize(
+        *decoded.base(), decoded.index(index), serialized);
+    return folly::hasher<StringView>()(StringView(serialized));
   }
   // Inlined for scalars.
   using T = typename KindToFlatVector<Kind>::HashRowType;
@@ -78,6 +83,15 @@ void VectorHasher::hashValues(
       result[row] = mix ? bits::hashMix(result[row], hash) : hash;
     });
   } else if (decoded_.isIdentityMapping()) {
+    using HashT = typename KindToFlatVector<Kind>::HashRowType;
+    if constexpr (
+        (std::is_arithmetic_v<HashT> && !std::is_same_v<HashT, bool>) ||
+        std::is_same_v<HashT, int128_t>) {
+      if (rows.isAllSelected() && decoded_.data<HashT>() != nullptr) {
+        hashFlatFixedWidth<HashT>(rows, mix, result);
+        return;
+      }
+    }
     rows.applyToSelected([&](vector_size_t row) {
       if (decoded_.isNullAt(row)) {
         result[row] = mix ? bits::hashMix(result[row], kNullHash) : kNullHash;
@@ -86,6 +100,15 @@ void VectorHasher::hashValues(
       auto hash = hashOne<Kind>(decoded_, row);
       result[row] = mix ? bits::hashMix(result[row], hash) : hash;
     });
+  } else if (decoded_.base()->size() > rows.end()) {
+    // A dictionary over a larger base, e.g. one partition of a batch after a
+    // local exchange. Base values are rarely repeated, so hashing them
+    // directly is cheaper than resetting a cache of the size of the base.
+    rows.applyToSelected([&](vector_size_t row) {
+      const auto hash =
+          decoded_.isNullAt(row) ? kNullHash : hashOne<Kind>(decoded_, row);
+      result[row] = mix ? bits::hashMix(result[row], hash) : hash;
+    });
   } else {
     cachedHashes_.resize(decoded_.base()->size());
     std::fill(cachedHashes_.begin(), cachedHashes_.end(), kNullHash);
@@ -105,6 +128,33 @@ void VectorHasher::hashValues(
   }
 }
 
+template <typename T>
+void VectorHasher::hashFlatFixedWidth(
+    const SelectivityVector& rows,
+    bool mix,
+    uint64_t* result) {
+  VELOX_DCHECK(rows.isAllSelected());
+  const auto numRows = rows.end();
+  const auto* values = decoded_.data<T>();
+  uint64_t* hashes = result;
+  if (mix) {
+    cachedHashes_.resize(numRows);
+    hashes = cachedHashes_.data();
+  }
+  for (auto row = 0; row < numRows; ++row) {
+    hashes[row] = folly::hasher<T>()(values[row]);
+  }
+  if (decoded_.mayHaveNulls()) {
+    bits::forEachUnsetBit(
+        decoded_.nulls(), 0, numRows, [&](vector_size_t row) {
+          hashes[row] = kNullHash;
+        });
+  }
+  if (mix) {
+    bits::hashMix(result, hashes, numRows);
+  }
+}
+
 template <TypeKind Kind>
 bool VectorHasher::makeValueIds(
     const SelectivityVector& rows,
@@ -240,8 +290,15 @@ template <typename T, bool mayHaveNulls>
 bool VectorHasher::makeValueIdsDecoded(
     const SelectivityVector& rows,
     uint64_t* result) {
-  cachedHashes_.resize(decoded_.base()->size());
-  std::fill(cachedHashes_.begin(), cachedHashes_.end(), 0);
+  // Ids of distinct values stay valid across batches, ids from a range do not.
+  const bool useBaseIds = std::is_same_v<T, StringView> && !isRange_ &&
+      dictionaryBase_.get() == decoded_.base();
+  raw_vector<uint64_t>& cachedIds =
+      useBaseIds ? dictionaryBaseIds_ : cachedHashes_;
+  if (!useBaseIds) {
+    cachedHashes_.resize(decoded_.base()->size());
+    std::fill(cachedHashes_.begin(), cachedHashes_.end(), 0);
+  }
 
   auto indices = decoded_.indices();
   auto values = decoded_.data<T>();
@@ -259,7 +316,7 @@ bool VectorHasher::makeValueIdsDecoded(
     }
 
     auto baseIndex = indices[row];
-    uint64_t& id = cachedHashes_[baseIndex];
+    uint64_t& id = cachedIds[baseIndex];
 
     if (success) {
       if (id == 0) {
@@ -280,9 +337,14 @@ bool VectorHasher::makeValueIdsDecoded(
       }
     }
 
-    return success || numCachedHashes < cachedHashes_.size();
+    return success || numCachedHashes < cachedIds.size();
   });
 
+  if (!success && useBaseIds) {
+    // Values that did not fit are marked kUnmappable but get ids after the
+    // next enableValueIds().
+    clearDictionaryBaseIds();
+  }
   return success;
 }
 
@@ -626,6 +688,20 @@ void VectorHasher::setDistinctOverflow() {
   uniqueValues_.clear();
   uniqueValuesStorage_.clear();
   distinctStringsBytes_ = 0;
+  clearDictionaryBaseIds();
+}
+
+void VectorHasher::setDictionaryBase(const BaseVector& vector) {
+  if (vector.encoding() != VectorEncoding::Simple::DICTIONARY) {
+    return;
+  }
+  const auto& base = vector.valueVector();
+  if (base == dictionaryBase_ || base.get() != decoded_.base()) {
+    return;
+  }
+  dictionaryBase_ = base;
+  dictionaryBaseIds_.resize(base->size());
+  clearDictionaryBaseIds();
 }
 
 void VectorHasher::setRangeOverflow() {
@@ -813,6 +889,7 @@ void VectorHasher::copyStatsFrom(const VectorHasher& other) {
   min_ = other.min_;
   max_ = other.max_;
   uniqueValues_ = other.uniqueValues_;
+  clearDictionaryBaseIds();
 }
 
 void VectorHasher::merge(const VectorHasher& other) {
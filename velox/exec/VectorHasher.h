@@ -171,6 +171,9 @@ class VectorHasher {
         type_->toString(),
         vector.type()->toString());
     decoded_.decode(vector, rows);
+    if (typeKind_ == TypeKind::VARCHAR || typeKind_ == TypeKind::VARBINARY) {
+      setDictionaryBase(vector);
+    }
   }
 
   DecodedVector& decodedVector() {
@@ -248,6 +251,7 @@ class VectorHasher {
   void resetStats() {
     uniqueValues_.clear();
     uniqueValuesStorage_.clear();
+    clearDictionaryBaseIds();
   }
 
   // Sets 'this' to range mode and adds 'reservePct' values to the
@@ -444,7 +448,7 @@ class VectorHasher {
     if constexpr (
         std::is_same_v<T, std::int64_t> || std::is_same_v<T, std::int32_t> ||
         std::is_same_v<T, std::int16_t>) {
-      if (rows.isAllSelected() && multiplier_ == 1) {
+      if (rows.isAllSelected()) {
         return tryMapToRangeSimd(values, rows, result);
       }
     }
@@ -536,6 +540,24 @@ class VectorHasher {
   template <TypeKind Kind>
   void hashValues(const SelectivityVector& rows, bool mix, uint64_t* result);
 
+  // Hashes all rows of a flat vector of fixed-width values. Hashes are
+  // computed for every row in one branch-free pass, null rows are then
+  // overwritten with kNullHash and, if 'mix' is true, combined with 'result'
+  // in a second pass. Requires 'rows' to be all selected.
+  template <typename T>
+  void hashFlatFixedWidth(
+      const SelectivityVector& rows,
+      bool mix,
+      uint64_t* result);
+
+  // Keeps the ids of the values of the base of 'vector' across calls to
+  // computeValueIds() if 'vector' is a dictionary over a flat vector.
+  void setDictionaryBase(const BaseVector& vector);
+
+  void clearDictionaryBaseIds() {
+    std::fill(dictionaryBaseIds_.begin(), dictionaryBaseIds_.end(), 0);
+  }
+
   const column_index_t channel_;
   const TypePtr type_;
   const TypeKind typeKind_;
@@ -543,6 +565,17 @@ class VectorHasher {
   DecodedVector decoded_;
   raw_vector<uint64_t> cachedHashes_;
 
+  // The flat base of the last dictionary encoded string input. Readers
+  // produce consecutive batches over the same dictionary, so the ids of its
+  // strings are kept in 'dictionaryBaseIds_' instead of being looked up in
+  // 'uniqueValues_' for each batch. Referencing the base keeps it from being
+  // reused for other values.
+  VectorPtr dictionaryBase_;
+
+  // The id of each value of 'dictionaryBase_' in distinct mode or 0 if not
+  // known. Valid as long as 'uniqueValues_' is not cleared.
+  raw_vector<uint64_t> dictionaryBaseIds_;
+
   // Single precomputed hash for constant partition keys.
   uint64_t precomputedHash_{0};
 
@@ -30,7 +30,10 @@ Window::Window(
           windowNode->outputType(),
           operatorId,
           windowNode->id(),
-          "Window"),
+          "Window",
+          windowNode->canSpill(driverCtx->queryConfig())
+              ? driverCtx->makeSpillConfig(operatorId)
+              : std::nullopt),
       numInputColumns_(windowNode->sources()[0]->outputType()->size()),
       windowNode_(windowNode),
       currentPartition_(nullptr),
@@ -38,7 +41,13 @@ Window::Window(
   if (windowNode->inputsSorted()) {
     windowBuild_ = std::make_unique<StreamingWindowBuild>(windowNode, pool());
   } else {
-    windowBuild_ = std::make_unique<SortWindowBuild>(windowNode, pool());
+    windowBuild_ = std::make_unique<SortWindowBuild>(
+        windowNode,
+        pool(),
+        &nonReclaimableSection_,
+        &numSpillRuns_,
+        spillConfig_.has_value() ? &(spillConfig_.value()) : nullptr,
+        driverCtx->queryConfig().windowSpillMemoryThreshold());
   }
 }
 
@@ -167,9 +176,34 @@ void Window::createPeerAndFrameBuffers() {
   }
 }
 
+void Window::reclaim(
+    uint64_t targetBytes,
+    memory::MemoryReclaimer::Stats& stats) {
+  VELOX_CHECK(canReclaim());
+
+  // NOTE: a window operator is reclaimable if it hasn't started output
+  // processing and is not under non-reclaimable execution section.
+  if (noMoreInput_ || nonReclaimableSection_) {
+    ++stats.numNonReclaimableAttempts;
+    LOG(WARNING) << "Can't reclaim from window operator, noMoreInput_["
+                 << noMoreInput_ << "], nonReclaimableSection_["
+                 << nonReclaimableSection_ << "], " << pool()->name();
+    return;
+  }
+
+  windowBuild_->spill(0, targetBytes);
+  // Release the minimum reserved memory.
+  pool()->release();
+}
+
 void Window::noMoreInput() {
   Operator::noMoreInput();
   windowBuild_->noMoreInput();
+
+  const auto spillStats = windowBuild_->spilledStats();
+  if (spillStats.has_value()) {
+    recordSpillStats(spillStats.value());
+  }
 }
 
 void Window::callResetPartition() {
@@ -47,21 +47,66 @@ WindowBuild::WindowBuild(
     const std::shared_ptr<const core::WindowNode>& windowNode,
     velox::memory::MemoryPool* pool)
     : numInputColumns_(windowNode->sources()[0]->outputType()->size()),
-      data_(std::make_unique<RowContainer>(
-          windowNode->sources()[0]->outputType()->children(),
-          pool)),
       decodedInputVectors_(windowNode->sources()[0]->outputType()->size()) {
   auto inputType = windowNode->sources()[0]->outputType();
-  for (int i = 0; i < inputType->children().size(); i++) {
-    inputColumns_.push_back(data_->columnAt(i));
-  }
-
   initKeyInfo(inputType, windowNode->partitionKeys(), {}, partitionKeyInfo_);
   initKeyInfo(
       inputType,
       windowNode->sortingKeys(),
       windowNode->sortingOrders(),
       sortKeyInfo_);
+
+  // Stores the partition keys first, then the sort keys and then the rest of
+  // the input columns in 'data_'. A column that appears more than once in the
+  // keys is only stored once.
+  std::vector<column_index_t> inputToContainer(
+      numInputColumns_, kConstantChannel);
+  auto addColumn = [&](column_index_t channel) {
+    if (inputToContainer[channel] == kConstantChannel) {
+      inputToContainer[channel] = inputChannels_.size();
+      inputChannels_.push_back(channel);
+    }
+  };
+  for (const auto& key : partitionKeyInfo_) {
+    addColumn(key.first);
+  }
+  numPartitionKeyColumns_ = inputChannels_.size();
+  for (const auto& key : sortKeyInfo_) {
+    addColumn(key.first);
+  }
+  numKeyColumns_ = inputChannels_.size();
+  for (auto i = 0; i < numInputColumns_; ++i) {
+    addColumn(i);
+  }
+
+  std::vector<TypePtr> keyTypes;
+  std::vector<TypePtr> dependentTypes;
+  for (auto i = 0; i < inputChannels_.size(); ++i) {
+    if (i < numKeyColumns_) {
+      keyTypes.push_back(inputType->childAt(inputChannels_[i]));
+    } else {
+      dependentTypes.push_back(inputType->childAt(inputChannels_[i]));
+    }
+  }
+  data_ = std::make_unique<RowContainer>(keyTypes, dependentTypes, pool);
+
+  for (auto i = 0; i < numInputColumns_; ++i) {
+    inputColumns_.push_back(data_->columnAt(inputToContainer[i]));
+  }
+
+  // Refers to the keys by their column indices in 'data_' from now on.
+  for (auto& key : partitionKeyInfo_) {
+    key.first = inputToContainer[key.first];
+  }
+  for (auto& key : sortKeyInfo_) {
+    key.first = inputToContainer[key.first];
+  }
+}
+
+void WindowBuild::storeRow(vector_size_t index, char* row) {
+  for (auto i = 0; i < inputChannels_.size(); ++i) {
+    data_->store(decodedInputVectors_[inputChannels_[i]], index, row, i);
+  }
 }
 
 bool WindowBuild::compareRowsWithKeys(
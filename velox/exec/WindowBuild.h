@@ -16,6 +16,7 @@
 #pragma once
 
 #include "velox/exec/RowContainer.h"
+#include "velox/exec/Spill.h"
 #include "velox/exec/WindowPartition.h"
 
 namespace facebook::velox::exec {
@@ -62,6 +63,18 @@ class WindowBuild {
   // if called when no partition is available.
   virtual std::unique_ptr<WindowPartition> nextPartition() = 0;
 
+  // Spills the input rows to disk with the specified targets. If either
+  // 'targetRows' or 'targetBytes' is zero, then all the rows are spilled. Only
+  // supported by a WindowBuild with spilling enabled.
+  virtual void spill(int64_t /*targetRows*/, int64_t /*targetBytes*/) {
+    VELOX_UNSUPPORTED("Window build doesn't support spilling");
+  }
+
+  // Returns the spiller stats including total bytes and rows spilled so far.
+  virtual std::optional<SpillStats> spilledStats() const {
+    return std::nullopt;
+  }
+
   // Returns the average size of input rows in bytes stored in the
   // data container of the WindowBuild.
   std::optional<int64_t> estimateRowSize() {
@@ -69,14 +82,17 @@ class WindowBuild {
   }
 
  protected:
+  // Stores the row at 'index' of 'decodedInputVectors_' into 'row' of 'data_'.
+  void storeRow(vector_size_t index, char* row);
+
   bool compareRowsWithKeys(
       const char* lhs,
       const char* rhs,
       const std::vector<std::pair<column_index_t, core::SortOrder>>& keys);
 
-  // The below 2 vectors represent the ChannelIndex of the partition keys
-  // and the order by keys. These keyInfo are used for sorting by those
-  // key combinations during the processing.
+  // The below 2 vectors represent the column indices in 'data_' of the
+  // partition keys and the order by keys. These keyInfo are used for sorting
+  // by those key combinations during the processing.
   // partitionKeyInfo_ is used to separate partitions in the rows.
   // sortKeyInfo_ is used to identify peer rows in a partition.
   std::vector<std::pair<column_index_t, core::SortOrder>> partitionKeyInfo_;
@@ -84,6 +100,18 @@ class WindowBuild {
 
   const vector_size_t numInputColumns_;
 
+  // The input channel of each column in 'data_'. The partition keys are
+  // stored first, followed by the sort keys and the rest of the input
+  // columns.
+  std::vector<column_index_t> inputChannels_;
+
+  // Number of distinct partition key columns at the start of 'data_'.
+  column_index_t numPartitionKeyColumns_;
+
+  // Number of distinct partition and sort key columns at the start of 'data_'.
+  // These are the key columns of 'data_'.
+  column_index_t numKeyColumns_;
+
   // The RowContainer holds all the input rows in WindowBuild.
   std::unique_ptr<RowContainer> data_;
 
@@ -91,7 +119,8 @@ class WindowBuild {
   // the partition and sort keys for the above RowContainer.
   std::vector<DecodedVector> decodedInputVectors_;
 
-  // RowColumns for window build used to construct WindowPartition.
+  // RowColumns for window build used to construct WindowPartition. Indexed by
+  // input channel.
   std::vector<exec::RowColumn> inputColumns_;
 
   // Number of input rows.
@@ -20,7 +20,8 @@
 
 /// Simple WindowPartition that builds over the RowContainer used for storing
 /// the input rows in the Window Operator. This works completely in-memory.
-/// TODO: This implementation will be revised for Spill to disk semantics.
+/// If the Window operator spills, its partitions are loaded back from disk one
+/// at a time before a WindowPartition is built over them.
 
 namespace facebook::velox::exec {
 class WindowPartition {
@@ -0,0 +1,475 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/common/base/SelectivityInfo.h"
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/memory/MmapAllocator.h"
+#include "velox/common/time/Timer.h"
+#include "velox/exec/HashTable.h"
+#include "velox/exec/VectorHasher.h"
+#include "velox/vector/tests/utils/VectorMaker.h"
+
+#include <folly/Random.h>
+#include <folly/String.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/init/Init.h>
+
+DEFINE_string(
+    build_sizes,
+    "1MB,16MB,256MB,2GB",
+    "Comma separated sizes of the build side. Takes KB, MB and GB suffixes, "
+    "e.g. 32GB");
+DEFINE_string(
+    key_types,
+    "bigint,varchar,bigint2",
+    "Comma separated key types. 'bigint2' is a key of two BIGINT columns");
+DEFINE_string(
+    duplicates,
+    "1,4",
+    "Comma separated numbers of build rows for each distinct key");
+DEFINE_string(
+    hit_rates,
+    "5,50,100",
+    "Comma separated percentages of probe rows that have a match");
+DEFINE_string(
+    hash_modes,
+    "array,normalized,hash",
+    "Comma separated hash modes. A mode is skipped for build sides it can "
+    "not represent, e.g. array mode beyond 2M distinct keys");
+DEFINE_string(
+    parallel_build,
+    "false,true",
+    "Comma separated settings of parallel join build");
+DEFINE_int32(
+    build_threads,
+    8,
+    "Number of build side tables, one per build driver, and of threads for "
+    "parallel join build");
+DEFINE_int64(probe_rows, 4'000'000, "Number of probe rows in each run");
+DEFINE_int32(batch_size, 1024, "Number of rows per build and probe batch");
+DEFINE_int64(memory_capacity_gb, 64, "Capacity of the memory allocator");
+
+/// Builds join hash tables from --build_sizes of data and probes them with
+/// random keys. Sweeps key types, duplicate keys, probe hit rates, the three
+/// hash modes and serial vs. parallel join build. Reports the build time and
+/// the clocks per probe row spent hashing the probe keys, in joinProbe() and
+/// in listJoinResults(). Build sides beyond the last level cache show the
+/// cost of the cache and TLB misses of the probe, which is what prefetching,
+/// huge pages and NUMA placement are meant to reduce.
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+namespace {
+
+int64_t parseBytes(folly::StringPiece text) {
+  static const std::vector<std::pair<std::string, int64_t>> kUnits = {
+      {"KB", 1L << 10}, {"MB", 1L << 20}, {"GB", 1L << 30}};
+  for (const auto& [suffix, multiplier] : kUnits) {
+    if (text.endsWith(suffix)) {
+      text.removeSuffix(suffix);
+      return folly::to<int64_t>(text) * multiplier;
+    }
+  }
+  return folly::to<int64_t>(text);
+}
+
+BaseHashTable::HashMode parseHashMode(const std::string& name) {
+  if (name == "array") {
+    return BaseHashTable::HashMode::kArray;
+  }
+  if (name == "normalized") {
+    return BaseHashTable::HashMode::kNormalizedKey;
+  }
+  if (name == "hash") {
+    return BaseHashTable::HashMode::kHash;
+  }
+  VELOX_USER_FAIL("Unknown hash mode: {}", name);
+}
+
+template <typename T>
+std::vector<T> parseList(const std::string& flag) {
+  std::vector<std::string> items;
+  folly::split(',', flag, items, true);
+  std::vector<T> result;
+  for (const auto& item : items) {
+    result.push_back(folly::to<T>(item));
+  }
+  return result;
+}
+
+struct JoinBenchmarkParams {
+  std::string keyType;
+  int64_t buildBytes;
+  int32_t duplicates;
+  BaseHashTable::HashMode mode;
+  bool parallelBuild;
+
+  std::string toString() const {
+    return fmt::format(
+        "{} {} dup={} {} {}",
+        keyType,
+        succinctBytes(buildBytes),
+        duplicates,
+        BaseHashTable::modeString(mode),
+        parallelBuild ? "parallel" : "serial");
+  }
+};
+
+struct JoinBenchmarkRun {
+  int32_t hitRate;
+  int64_t numResults;
+  // Clocks per probe row.
+  float hashClocks;
+  float probeClocks;
+  float listClocks;
+  // Tag and row accesses of joinProbe() per probe row.
+  float tagLoads;
+  float rowLoads;
+
+  std::string toString() const {
+    return fmt::format(
+        "  hit={}% results={} clocks/row: hash={:.1f} probe={:.1f} "
+        "list={:.1f} total={:.1f} loads/row: tags={:.2f} rows={:.2f}",
+        hitRate,
+        numResults,
+        hashClocks,
+        probeClocks,
+        listClocks,
+        hashClocks + probeClocks + listClocks,
+        tagLoads,
+        rowLoads);
+  }
+};
+
+class HashJoinBenchmark {
+ public:
+  HashJoinBenchmark()
+      : executor_(std::make_unique<folly::CPUThreadPoolExecutor>(
+            FLAGS_build_threads)) {}
+
+  // Builds the table for 'params'. Returns false if the table can not be
+  // built in the requested hash mode.
+  bool build(const JoinBenchmarkParams& params) {
+    table_.reset();
+    params_ = params;
+    keyType_ = makeKeyType(params.keyType);
+
+    const auto bytesPerRow = estimateRowBytes();
+    numRows_ = std::max<int64_t>(1, params.buildBytes / bytesPerRow);
+    numDistinct_ = std::max<int64_t>(1, numRows_ / params.duplicates);
+
+    std::vector<std::unique_ptr<HashTable<true>>> tables;
+    for (auto i = 0; i < FLAGS_build_threads; ++i) {
+      tables.push_back(makeTable());
+      if (params.mode == BaseHashTable::HashMode::kHash) {
+        tables.back()->forceGenericHashMode();
+      }
+    }
+    for (int64_t offset = 0, batch = 0; offset < numRows_;
+         offset += FLAGS_batch_size, ++batch) {
+      const auto size = std::min<int64_t>(FLAGS_batch_size, numRows_ - offset);
+      auto input = makeBuildBatch(offset, size);
+      addToTable(*input, *tables[batch % tables.size()]);
+    }
+
+    table_ = std::move(tables[0]);
+    std::vector<std::unique_ptr<BaseHashTable>> otherTables;
+    for (auto i = 1; i < tables.size(); ++i) {
+      otherTables.push_back(std::move(tables[i]));
+    }
+    auto* executor = params.parallelBuild ? executor_.get() : nullptr;
+    buildMicros_ = 0;
+    {
+      MicrosecondTimer timer(&buildMicros_);
+      table_->prepareJoinTable(std::move(otherTables), executor);
+    }
+    if (table_->hashMode() == params.mode) {
+      return true;
+    }
+    // A table whose keys have value ids can be switched from array to
+    // normalized key mode. The other modes are decided by the keys.
+    if (table_->hashMode() != BaseHashTable::HashMode::kArray ||
+        params.mode != BaseHashTable::HashMode::kNormalizedKey) {
+      LOG(INFO) << params.toString() << ": the keys give "
+                << BaseHashTable::modeString(table_->hashMode())
+                << " mode, skipping";
+      table_.reset();
+      return false;
+    }
+    buildMicros_ = 0;
+    MicrosecondTimer timer(&buildMicros_);
+    table_->testingSetHashMode(params.mode, 0);
+    return true;
+  }
+
+  void printBuild() const {
+    std::cout << fmt::format(
+                     "{}: rows={} distinct={} table={} capacity={} build={} "
+                     "({:.1f} ns/row)",
+                     params_.toString(),
+                     numRows_,
+                     numDistinct_,
+                     succinctBytes(table_->allocatedBytes()),
+                     table_->capacity(),
+                     succinctMicros(buildMicros_),
+                     buildMicros_ * 1000.0 / numRows_)
+              << std::endl;
+  }
+
+  JoinBenchmarkRun probe(int32_t hitRate) {
+    // Probe keys are drawn uniformly from a domain where 'hitRate' percent
+    // of the keys are in the table, so that consecutive probes touch
+    // unrelated cache lines.
+    const auto domain = numDistinct_ * 100 / hitRate;
+    folly::Random::DefaultGenerator rng;
+    rng.seed(1);
+    std::vector<RowVectorPtr> batches;
+    int64_t expectedResults = 0;
+    for (int64_t offset = 0; offset < FLAGS_probe_rows;
+         offset += FLAGS_batch_size) {
+      const auto size =
+          std::min<int64_t>(FLAGS_batch_size, FLAGS_probe_rows - offset);
+      std::vector<int64_t> keys(size);
+      for (auto& key : keys) {
+        key = folly::Random::rand64(domain, rng);
+        if (key < numDistinct_) {
+          expectedResults += numRowsOfKey(key);
+        }
+      }
+      batches.push_back(makeBatch(keys));
+    }
+
+    auto& hashers = table_->hashers();
+    const auto mode = table_->hashMode();
+    HashLookup lookup(hashers);
+    BaseHashTable::JoinResultIterator iter;
+    VectorHasher::ScratchMemory scratchMemory;
+    std::vector<vector_size_t> resultRows(FLAGS_batch_size);
+    std::vector<char*> resultHits(FLAGS_batch_size);
+    SelectivityVector rows;
+    SelectivityInfo hashTime;
+    SelectivityInfo probeTime;
+    SelectivityInfo listTime;
+    int64_t numResults = 0;
+    for (const auto& batch : batches) {
+      lookup.reset(batch->size());
+      rows.resize(batch->size());
+      rows.setAll();
+      {
+        SelectivityTimer timer(hashTime, 0);
+        for (auto i = 0; i < hashers.size(); ++i) {
+          auto key = batch->childAt(i);
+          if (mode != BaseHashTable::HashMode::kHash) {
+            hashers[i]->lookupValueIds(
+                *key, rows, scratchMemory, lookup.hashes);
+          } else {
+            hashers[i]->decode(*key, rows);
+            hashers[i]->hash(rows, i > 0, lookup.hashes);
+          }
+        }
+        lookup.rows.clear();
+        rows.applyToSelected([&](auto row) { lookup.rows.push_back(row); });
+      }
+      if (!lookup.rows.empty()) {
+        SelectivityTimer timer(probeTime, 0);
+        table_->joinProbe(lookup);
+      }
+      {
+        SelectivityTimer timer(listTime, 0);
+        iter.reset(lookup);
+        while (!iter.atEnd()) {
+          numResults += table_->listJoinResults(
+              iter,
+              false,
+              folly::Range<vector_size_t*>(
+                  resultRows.data(), resultRows.size()),
+              folly::Range<char**>(resultHits.data(), resultHits.size()));
+        }
+      }
+    }
+    VELOX_CHECK_EQ(numResults, expectedResults);
+
+    JoinBenchmarkRun run;
+    run.hitRate = hitRate;
+    run.numResults = numResults;
+    run.hashClocks = hashTime.timeToDropValue() / FLAGS_probe_rows;
+    run.probeClocks = probeTime.timeToDropValue() / FLAGS_probe_rows;
+    run.listClocks = listTime.timeToDropValue() / FLAGS_probe_rows;
+    run.tagLoads = static_cast<float>(lookup.numTagLoads) / FLAGS_probe_rows;
+    run.rowLoads = static_cast<float>(lookup.numRowLoads) / FLAGS_probe_rows;
+    return run;
+  }
+
+ private:
+  static RowTypePtr makeKeyType(const std::string& name) {
+    if (name == "bigint") {
+      return ROW({"k0"}, {BIGINT()});
+    }
+    if (name == "varchar") {
+      return ROW({"k0"}, {VARCHAR()});
+    }
+    if (name == "bigint2") {
+      return ROW({"k0", "k1"}, {BIGINT(), BIGINT()});
+    }
+    VELOX_USER_FAIL("Unknown key type: {}", name);
+  }
+
+  std::unique_ptr<HashTable<true>> makeTable() {
+    std::vector<std::unique_ptr<VectorHasher>> hashers;
+    for (auto i = 0; i < keyType_->size(); ++i) {
+      hashers.push_back(
+          std::make_unique<VectorHasher>(keyType_->childAt(i), i));
+    }
+    return HashTable<true>::createForJoin(
+        std::move(hashers), {}, params_.duplicates > 1, false, 1'000, pool());
+  }
+
+  // Row container bytes plus about two table slots of 8 bytes per row.
+  int64_t estimateRowBytes() {
+    auto table = makeTable();
+    return table->rows()->fixedRowSize() + sizeof(normalized_key_t) + 16;
+  }
+
+  int32_t numRowsOfKey(int64_t key) const {
+    return numRows_ / numDistinct_ + (key < numRows_ % numDistinct_ ? 1 : 0);
+  }
+
+  // Rows 'offset' to 'offset + size' of the build side. Row i has key
+  // i % numDistinct_, so duplicates of a key are in different batches.
+  RowVectorPtr makeBuildBatch(int64_t offset, int64_t size) {
+    std::vector<int64_t> keys(size);
+    for (auto i = 0; i < size; ++i) {
+      keys[i] = (offset + i) % numDistinct_;
+    }
+    return makeBatch(keys);
+  }
+
+  RowVectorPtr makeBatch(const std::vector<int64_t>& keys) {
+    const vector_size_t size = keys.size();
+    std::vector<VectorPtr> children;
+    if (params_.keyType == "bigint") {
+      children.push_back(vectorMaker_.flatVector<int64_t>(
+          size, [&](auto row) { return keys[row]; }));
+    } else if (params_.keyType == "varchar") {
+      // 12 digits are inlined in the StringView.
+      children.push_back(vectorMaker_.flatVector<StringView>(
+          size, [&](auto row) {
+            return StringView(fmt::format("{:012}", keys[row]));
+          }));
+    } else {
+      // Spreads the key over two columns of 1K and numDistinct_ / 1K values.
+      children.push_back(vectorMaker_.flatVector<int64_t>(
+          size, [&](auto row) { return keys[row] % 1024; }));
+      children.push_back(vectorMaker_.flatVector<int64_t>(
+          size, [&](auto row) { return keys[row] / 1024; }));
+    }
+    return vectorMaker_.rowVector(keyType_->names(), children);
+  }
+
+  // Stores 'input' in the RowContainer of 'table' and updates its
+  // VectorHashers, like a build driver does before the tables are merged.
+  void addToTable(const RowVector& input, HashTable<true>& table) {
+    const SelectivityVector rows(input.size());
+    raw_vector<uint64_t> valueIds(input.size());
+    auto& hashers = table.hashers();
+    std::vector<DecodedVector> decoded(hashers.size());
+    for (auto i = 0; i < hashers.size(); ++i) {
+      decoded[i].decode(*input.childAt(i), rows);
+      hashers[i]->decode(*input.childAt(i), rows);
+      if (table.hashMode() != BaseHashTable::HashMode::kHash &&
+          hashers[i]->mayUseValueIds()) {
+        hashers[i]->computeValueIds(rows, valueIds);
+      }
+    }
+    auto* rowContainer = table.rows();
+    const auto nextOffset = rowContainer->nextOffset();
+    for (auto row = 0; row < input.size(); ++row) {
+      char* newRow = rowContainer->newRow();
+      if (nextOffset) {
+        *reinterpret_cast<char**>(newRow + nextOffset) = nullptr;
+      }
+      for (auto i = 0; i < hashers.size(); ++i) {
+        rowContainer->store(decoded[i], row, newRow, i);
+      }
+    }
+  }
+
+  memory::MemoryPool* pool() {
+    return pool_.get();
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_{memory::addDefaultLeafMemoryPool()};
+  test::VectorMaker vectorMaker_{pool_.get()};
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
+
+  JoinBenchmarkParams params_;
+  RowTypePtr keyType_;
+  int64_t numRows_{0};
+  int64_t numDistinct_{0};
+  std::unique_ptr<HashTable<true>> table_;
+  uint64_t buildMicros_{0};
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  memory::MmapAllocator::Options options;
+  options.capacity = FLAGS_memory_capacity_gb << 30;
+  options.useMmapArena = true;
+  options.mmapArenaCapacityRatio = 1;
+
+  auto allocator = std::make_shared<memory::MmapAllocator>(options);
+  memory::MemoryAllocator::setDefaultInstance(allocator.get());
+  memory::MemoryManager::getInstance(memory::MemoryManagerOptions{
+      .capacity = static_cast<int64_t>(options.capacity),
+      .allocator = allocator.get()});
+
+  std::vector<std::string> sizes;
+  folly::split(',', FLAGS_build_sizes, sizes, true);
+  const auto keyTypes = parseList<std::string>(FLAGS_key_types);
+  const auto duplicates = parseList<int32_t>(FLAGS_duplicates);
+  const auto hitRates = parseList<int32_t>(FLAGS_hit_rates);
+  const auto modes = parseList<std::string>(FLAGS_hash_modes);
+  const auto parallelBuilds = parseList<bool>(FLAGS_parallel_build);
+
+  HashJoinBenchmark benchmark;
+  for (const auto& size : sizes) {
+    for (const auto& keyType : keyTypes) {
+      for (auto duplicate : duplicates) {
+        for (const auto& mode : modes) {
+          for (auto parallelBuild : parallelBuilds) {
+            JoinBenchmarkParams params{
+                keyType,
+                parseBytes(size),
+                duplicate,
+                parseHashMode(mode),
+                parallelBuild};
+            if (!benchmark.build(params)) {
+              continue;
+            }
+            benchmark.printBuild();
+            for (auto hitRate : hitRates) {
+              std::cout << benchmark.probe(hitRate).toString() << std::endl;
+            }
+          }
+        }
+      }
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <folly/String.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/init/Init.h>
+#include <gflags/gflags.h>
+
+#include "velox/common/base/SuccinctPrinter.h"
+#include "velox/common/file/FileSystems.h"
+#include "velox/common/memory/MallocAllocator.h"
+#include "velox/common/memory/Memory.h"
+#include "velox/common/time/Timer.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
+#include "velox/functions/prestosql/aggregates/RegisterAggregateFunctions.h"
+#include "velox/functions/prestosql/registration/RegistrationFunctions.h"
+#include "velox/parse/TypeResolver.h"
+#include "velox/serializers/PrestoSerializer.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+
+DEFINE_int32(num_threads, 8, "Number of queries running at the same time");
+DEFINE_int32(queries_per_thread, 4, "Number of queries each thread runs");
+DEFINE_string(
+    query_mix,
+    "agg,join,orderby",
+    "Comma separated query kinds the threads take turns running. Each of "
+    "'agg', 'join' and 'orderby' keeps all of its input in memory unless it "
+    "spills");
+DEFINE_int32(num_drivers, 2, "Number of drivers per query");
+DEFINE_int32(num_vectors, 64, "Number of input vectors per query");
+DEFINE_int32(vector_size, 8'192, "Number of rows per input vector");
+DEFINE_int32(string_length, 64, "Length of the payload strings");
+DEFINE_int64(memory_capacity_mb, 512, "Capacity of the memory manager");
+DEFINE_int64(
+    memory_pool_init_capacity_mb,
+    16,
+    "Initial capacity of each query's memory pool");
+DEFINE_int64(
+    memory_pool_transfer_capacity_mb,
+    8,
+    "Minimum capacity the arbitrator grows a query's memory pool by");
+DEFINE_int32(
+    spill_executor_threads,
+    0,
+    "Threads for parallel spilling. 0 spills on the driver thread");
+
+/// Runs --num_threads concurrent aggregation, join and order by queries under
+/// a memory manager with the shared arbitrator and spilling enabled. Reports
+/// query throughput and latency percentiles, the arbitrator's request, queue
+/// and reclaim counters and the bytes spilled by the operators. Use it to
+/// compare memory capacities, pool init and transfer capacities and spill
+/// settings under contention.
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+namespace {
+
+struct QueryResult {
+  uint64_t micros{0};
+  uint64_t spilledBytes{0};
+  uint64_t spilledRows{0};
+  bool failed{false};
+};
+
+class SpillArbitrationBenchmark {
+ public:
+  void setUp() {
+    allocator_ = std::make_shared<memory::MallocAllocator>(
+        FLAGS_memory_capacity_mb << 20);
+    memory::MemoryManagerOptions options;
+    options.allocator = allocator_.get();
+    options.capacity = allocator_->capacity();
+    options.arbitratorKind = "SHARED";
+    options.memoryPoolInitCapacity = FLAGS_memory_pool_init_capacity_mb << 20;
+    options.memoryPoolTransferCapacity = FLAGS_memory_pool_transfer_capacity_mb
+        << 20;
+    memoryManager_ = std::make_unique<memory::MemoryManager>(options);
+
+    executor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        FLAGS_num_threads * FLAGS_num_drivers);
+    if (FLAGS_spill_executor_threads > 0) {
+      spillExecutor_ = std::make_shared<folly::CPUThreadPoolExecutor>(
+          FLAGS_spill_executor_threads);
+    }
+    spillDirectory_ = TempDirectoryPath::create();
+
+    // The input is shared by all queries and allocated outside of the memory
+    // manager under test.
+    pool_ = memory::addDefaultLeafMemoryPool();
+    VectorFuzzer::Options fuzzerOptions;
+    fuzzerOptions.vectorSize = FLAGS_vector_size;
+    fuzzerOptions.nullRatio = 0;
+    fuzzerOptions.stringLength = FLAGS_string_length;
+    fuzzerOptions.stringVariableLength = true;
+    VectorFuzzer fuzzer(fuzzerOptions, pool_.get());
+    const auto rowType =
+        ROW({"c0", "c1", "c2"}, {BIGINT(), BIGINT(), VARCHAR()});
+    for (auto i = 0; i < FLAGS_num_vectors; ++i) {
+      input_.push_back(fuzzer.fuzzInputRow(rowType));
+    }
+
+    std::vector<std::string> kinds;
+    folly::split(',', FLAGS_query_mix, kinds, true);
+    for (const auto& kind : kinds) {
+      plans_.push_back(makePlan(kind));
+    }
+    VELOX_CHECK(!plans_.empty(), "--query_mix has no queries");
+  }
+
+  void run() {
+    results_.resize(FLAGS_num_threads * FLAGS_queries_per_thread);
+    std::vector<std::thread> threads;
+    threads.reserve(FLAGS_num_threads);
+    {
+      MicrosecondTimer timer(&wallMicros_);
+      for (auto i = 0; i < FLAGS_num_threads; ++i) {
+        threads.emplace_back([&, i]() {
+          for (auto j = 0; j < FLAGS_queries_per_thread; ++j) {
+            results_[i * FLAGS_queries_per_thread + j] =
+                runQuery(plans_[(i + j) % plans_.size()]);
+          }
+        });
+      }
+      for (auto& thread : threads) {
+        thread.join();
+      }
+    }
+  }
+
+  void printStats() const {
+    std::vector<uint64_t> latencies;
+    uint64_t spilledBytes = 0;
+    uint64_t spilledRows = 0;
+    int32_t numFailed = 0;
+    for (const auto& result : results_) {
+      if (result.failed) {
+        ++numFailed;
+        continue;
+      }
+      latencies.push_back(result.micros);
+      spilledBytes += result.spilledBytes;
+      spilledRows += result.spilledRows;
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double pct) -> uint64_t {
+      if (latencies.empty()) {
+        return 0;
+      }
+      return latencies[std::min<size_t>(
+          latencies.size() - 1, latencies.size() * pct / 100)];
+    };
+
+    const auto stats = memoryManager_->arbitrator()->stats();
+    std::cout << fmt::format(
+                     "{} queries in {}: {:.2f} queries/s, {} failed",
+                     results_.size(),
+                     succinctMicros(wallMicros_),
+                     latencies.size() / (wallMicros_ / 1'000'000.0),
+                     numFailed)
+              << std::endl
+              << fmt::format(
+                     "Latency p50 {} p90 {} p99 {} max {}",
+                     succinctMicros(percentile(50)),
+                     succinctMicros(percentile(90)),
+                     succinctMicros(percentile(99)),
+                     succinctMicros(percentile(100)))
+              << std::endl
+              << fmt::format(
+                     "Spilled {} in {} rows",
+                     succinctBytes(spilledBytes),
+                     spilledRows)
+              << std::endl
+              << fmt::format(
+                     "Arbitration: {} requests, {} aborted, {} failed, "
+                     "queue time {}, arbitration time {}, reclaim time {}, "
+                     "shrunk {}, reclaimed {}",
+                     stats.numRequests,
+                     stats.numAborted,
+                     stats.numFailures,
+                     succinctMicros(stats.queueTimeUs),
+                     succinctMicros(stats.arbitrationTimeUs),
+                     succinctMicros(stats.reclaimTimeUs),
+                     succinctBytes(stats.numShrunkBytes),
+                     succinctBytes(stats.numReclaimedBytes))
+              << std::endl;
+  }
+
+  void cleanup() {
+    waitForAllTasksToBeDeleted();
+    plans_.clear();
+    input_.clear();
+  }
+
+ private:
+  core::PlanNodePtr makePlan(const std::string& kind) {
+    if (kind == "agg") {
+      return PlanBuilder()
+          .values(input_)
+          .singleAggregation({"c0"}, {"sum(c1)", "max(c2)"})
+          .singleAggregation({}, {"count(1)"})
+          .planNode();
+    }
+    if (kind == "join") {
+      auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+      return PlanBuilder(planNodeIdGenerator)
+          .values(input_)
+          .project({"c0 AS t0", "c1 AS t1"})
+          .hashJoin(
+              {"t0"},
+              {"c0"},
+              PlanBuilder(planNodeIdGenerator).values(input_).planNode(),
+              "",
+              {"t1", "c2"})
+          .singleAggregation({}, {"count(1)"})
+          .planNode();
+    }
+    if (kind == "orderby") {
+      return PlanBuilder()
+          .values(input_)
+          .orderBy({"c0"}, false)
+          .singleAggregation({}, {"count(1)"})
+          .planNode();
+    }
+    VELOX_USER_FAIL("Unknown query kind in --query_mix: {}", kind);
+  }
+
+  QueryResult runQuery(const core::PlanNodePtr& plan) {
+    static std::atomic<int32_t> queryId{0};
+    CursorParameters params;
+    params.planNode = plan;
+    params.maxDrivers = FLAGS_num_drivers;
+    params.spillDirectory = spillDirectory_->path;
+    params.queryCtx = std::make_shared<core::QueryCtx>(
+        executor_.get(),
+        core::QueryConfig({{core::QueryConfig::kSpillEnabled, "true"}}),
+        std::unordered_map<std::string, std::shared_ptr<Config>>{},
+        cache::AsyncDataCache::getInstance(),
+        memoryManager_->addRootPool(
+            fmt::format("query_{}", queryId++),
+            memory::kMaxMemory,
+            memory::MemoryReclaimer::create()),
+        spillExecutor_);
+
+    QueryResult result;
+    try {
+      MicrosecondTimer timer(&result.micros);
+      auto cursor = readCursor(params, [](Task*) {}, 60'000'000).first;
+      for (const auto& pipeline : cursor->task()->taskStats().pipelineStats) {
+        for (const auto& op : pipeline.operatorStats) {
+          result.spilledBytes += op.spilledBytes;
+          result.spilledRows += op.spilledRows;
+        }
+      }
+    } catch (const std::exception& e) {
+      LOG(ERROR) << "Query failed: " << e.what();
+      result.failed = true;
+    }
+    return result;
+  }
+
+  std::shared_ptr<memory::MemoryAllocator> allocator_;
+  std::unique_ptr<memory::MemoryManager> memoryManager_;
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor_;
+  std::shared_ptr<folly::Executor> spillExecutor_;
+  std::shared_ptr<TempDirectoryPath> spillDirectory_;
+  std::shared_ptr<memory::MemoryPool> pool_;
+  std::vector<RowVectorPtr> input_;
+  std::vector<core::PlanNodePtr> plans_;
+  std::vector<QueryResult> results_;
+  uint64_t wallMicros_{0};
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  functions::prestosql::registerAllScalarFunctions();
+  aggregate::prestosql::registerAllAggregateFunctions();
+  parse::registerTypeResolver();
+  filesystems::registerLocalFileSystem();
+  serializer::presto::PrestoVectorSerde::registerVectorSerde();
+
+  SpillArbitrationBenchmark benchmark;
+  benchmark.setUp();
+  benchmark.run();
+  benchmark.printStats();
+  benchmark.cleanup();
+  return 0;
+}
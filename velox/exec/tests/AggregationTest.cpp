@@ -848,6 +848,54 @@ TEST_F(AggregationTest, partialDistinctWithAbandon) {
              .assertResults("SELECT distinct c0, sum(c0) FROM tmp group by c0");
 }
 
+TEST_F(AggregationTest, reenablePartialAggregation) {
+  // The first two batches have unique keys and make the partial aggregation
+  // abandon itself. The batches after that are clustered on the key and have
+  // two unique keys each.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 2; ++i) {
+    vectors.push_back(makeRowVector({makeFlatVector<int32_t>(
+        200, [i](auto row) { return 1'000'000 + i * 200 + row; })}));
+  }
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({makeFlatVector<int32_t>(
+        1'000, [i](auto row) { return i * 2 + row / 500; })}));
+  }
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId partialAggId;
+  const auto plan = PlanBuilder()
+                        .values(vectors)
+                        .partialAggregation({"c0"}, {"count(1)"})
+                        .capturePlanNodeId(partialAggId)
+                        .finalAggregation()
+                        .planNode();
+
+  for (const auto intervalRows : {0, 1'000}) {
+    SCOPED_TRACE(fmt::format("intervalRows: {}", intervalRows));
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .config(QueryConfig::kAbandonPartialAggregationMinRows, "100")
+            .config(QueryConfig::kAbandonPartialAggregationMinPct, "50")
+            .config(
+                QueryConfig::kPartialAggregationReenableIntervalRows,
+                std::to_string(intervalRows))
+            .config("max_drivers_per_task", "1")
+            .plan(plan)
+            .assertResults("SELECT c0, count(1) FROM tmp GROUP BY 1");
+
+    const auto runtimeStats =
+        toPlanStats(task->taskStats()).at(partialAggId).customStats;
+    EXPECT_EQ(1, runtimeStats.at("abandonedPartialAggregation").sum);
+    if (intervalRows == 0) {
+      EXPECT_EQ(0, runtimeStats.count("reenabledPartialAggregation"));
+    } else {
+      EXPECT_EQ(1, runtimeStats.at("reenabledPartialAggregation").sum);
+      EXPECT_LT(0, runtimeStats.at("partialAggregationReenableProbes").sum);
+    }
+  }
+}
+
 TEST_F(AggregationTest, largeValueRangeArray) {
   // We have keys that map to integer range. The keys are
   // a little under max array hash table size apart. This wastes 16MB of
@@ -977,6 +1025,53 @@ TEST_F(AggregationTest, partialAggregationMemoryLimitIncrease) {
   }
 }
 
+TEST_F(AggregationTest, partialAggregationMemoryLimitIncreaseAsync) {
+  constexpr int64_t kGB = 1 << 30;
+  auto vectors = {
+      makeRowVector({makeFlatVector<int32_t>(
+          100, [](auto row) { return row; }, nullEvery(5))}),
+      makeRowVector({makeFlatVector<int32_t>(
+          110, [](auto row) { return row + 29; }, nullEvery(7))}),
+      makeRowVector({makeFlatVector<int32_t>(
+          90, [](auto row) { return row - 71; }, nullEvery(7))}),
+  };
+  createDuckDbTable(vectors);
+
+  // The memory reservations to extend the partial aggregation memory limit run
+  // on the arbitration executor while the driver waits for memory.
+  auto arbitrationExecutor = std::make_shared<folly::CPUThreadPoolExecutor>(1);
+  CursorParameters params;
+  params.queryCtx = std::make_shared<core::QueryCtx>(
+      executor_.get(),
+      core::QueryConfig({
+          {QueryConfig::kMaxPartialAggregationMemory, "100"},
+          {QueryConfig::kMaxExtendedPartialAggregationMemory,
+           std::to_string(kGB)},
+      }),
+      std::unordered_map<std::string, std::shared_ptr<Config>>{},
+      cache::AsyncDataCache::getInstance(),
+      nullptr,
+      nullptr,
+      "",
+      arbitrationExecutor);
+  ASSERT_EQ(params.queryCtx->arbitrationExecutor(), arbitrationExecutor.get());
+  core::PlanNodeId aggNodeId;
+  params.planNode = PlanBuilder()
+                        .values(vectors)
+                        .partialAggregation({"c0"}, {})
+                        .capturePlanNodeId(aggNodeId)
+                        .finalAggregation()
+                        .planNode();
+  auto task = assertQuery(params, "SELECT distinct c0 FROM tmp");
+  const auto runtimeStats =
+      toPlanStats(task->taskStats()).at(aggNodeId).customStats;
+  EXPECT_LT(0, runtimeStats.at("flushRowCount").count);
+  const auto& extendedMemoryUsage =
+      runtimeStats.at("maxExtendedPartialAggregationMemoryUsage");
+  EXPECT_LT(100, extendedMemoryUsage.max);
+  EXPECT_GE(kGB, extendedMemoryUsage.max);
+}
+
 TEST_F(AggregationTest, partialAggregationMaybeReservationReleaseCheck) {
   auto vectors = {
       makeRowVector({makeFlatVector<int32_t>(
@@ -1533,6 +1628,66 @@ TEST_F(AggregationTest, groupingSets) {
       "SELECT k1, k2, count(1), sum(a), max(b) FROM tmp GROUP BY ROLLUP (k1, k2)");
 }
 
+TEST_F(AggregationTest, groupingSetsAggregation) {
+  vector_size_t size = 1'000;
+  auto data = makeRowVector(
+      {"k1", "k2", "k3", "a", "b"},
+      {
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 11; }),
+          makeFlatVector<int64_t>(
+              size, [](auto row) { return row % 17; }, nullEvery(13)),
+          makeFlatVector<int64_t>(size, [](auto row) { return row % 3; }),
+          makeFlatVector<int64_t>(size, [](auto row) { return row; }),
+          makeFlatVector<std::string>(
+              size, [](auto row) { return std::string(row % 12, 'x'); }),
+      });
+
+  createDuckDbTable({data, data});
+
+  auto makePlan = [&](const std::vector<std::vector<std::string>>& sets) {
+    return PlanBuilder()
+        .values({data, data})
+        .groupingSetsAggregation(
+            sets,
+            {"count(1) as count_1",
+             "sum(a) as sum_a",
+             "max(b) as max_b",
+             "avg(a) as avg_a"})
+        .project({"k1", "k2", "k3", "count_1", "sum_a", "max_b", "avg_a"})
+        .planNode();
+  };
+
+  const std::string aggregates = "count(1), sum(a), max(b), avg(a)";
+  assertQuery(
+      makePlan({{"k1", "k2", "k3"}, {"k1", "k2"}, {"k1"}, {}}),
+      "SELECT k1, k2, k3, " + aggregates +
+          " FROM tmp GROUP BY ROLLUP (k1, k2, k3)");
+
+  assertQuery(
+      makePlan(
+          {{"k1", "k2"}, {"k1", "k3"}, {"k2", "k3"}, {"k1"}, {"k2"}, {}}),
+      "SELECT k1, k2, k3, " + aggregates +
+          " FROM tmp GROUP BY GROUPING SETS ((k1, k2), (k1, k3), (k2, k3), "
+          "(k1), (k2), ())");
+
+  // The raw input is aggregated once on all keys. Only the partial
+  // aggregation sees the input rows.
+  auto plan = PlanBuilder()
+                  .values({data})
+                  .groupingSetsAggregation(
+                      {{"k1", "k2"}, {"k1"}, {"k2"}, {}}, {"sum(a) as sum_a"})
+                  .planNode();
+  auto partialAggNode = std::dynamic_pointer_cast<const core::AggregationNode>(
+      plan->sources()[0]->sources()[0]);
+  ASSERT_NE(partialAggNode, nullptr);
+  ASSERT_EQ(partialAggNode->step(), core::AggregationNode::Step::kPartial);
+  ASSERT_EQ(partialAggNode->groupingKeys().size(), 2);
+  assertQuery(
+      plan,
+      "SELECT k1, k2, grouping(k1, k2), sum(a) FROM tmp "
+      "GROUP BY CUBE (k1, k2)");
+}
+
 TEST_F(AggregationTest, groupingSetsOutput) {
   vector_size_t size = 1'000;
   auto data = makeRowVector(
@@ -1915,6 +2070,110 @@ TEST_F(AggregationTest, distinctWithSpilling) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(AggregationTest, distinctAndSortedAggregationsWithSpilling) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(100, [&](auto row) { return (row + i) % 17; }),
+        makeFlatVector<int64_t>(
+            100, [&](auto row) { return row % 23; }, nullEvery(19)),
+        makeFlatVector<int64_t>(100, [&](auto row) { return i * 100 + row; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  core::PlanNodeId aggrNodeId;
+  auto task =
+      AssertQueryBuilder(duckDbQueryRunner_)
+          .spillDirectory(spillDirectory->path)
+          .config(QueryConfig::kSpillEnabled, "true")
+          .config(QueryConfig::kAggregationSpillEnabled, "true")
+          .config(QueryConfig::kTestingSpillPct, "100")
+          .plan(PlanBuilder()
+                    .values(vectors)
+                    .singleAggregation(
+                        {"c0"},
+                        {"count(distinct c1)",
+                         "array_agg(c1 ORDER BY c2 DESC)",
+                         "sum(c1)"})
+                    .capturePlanNodeId(aggrNodeId)
+                    .planNode())
+          .assertResults(
+              "SELECT c0, count(distinct c1), array_agg(c1 ORDER BY c2 DESC), "
+              "sum(c1) FROM tmp GROUP BY 1");
+  // Verify that the distinct and sorted aggregations have been spilled.
+  ASSERT_GT(toPlanStats(task->taskStats()).at(aggrNodeId).spilledBytes, 0);
+  OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+}
+
+TEST_F(AggregationTest, distinctAggregationsWithHashDedup) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector({
+        makeFlatVector<int32_t>(100, [&](auto row) { return (row + i) % 17; }),
+        makeFlatVector<int64_t>(
+            100, [&](auto row) { return row % 23; }, nullEvery(19)),
+        makeFlatVector<bool>(100, [&](auto row) { return row % 3 == 0; }),
+    }));
+  }
+  createDuckDbTable(vectors);
+
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .singleAggregation(
+                      {"c0"},
+                      {"count(distinct c1)", "sum(distinct c1)", "sum(c1)"})
+                  .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(QueryConfig::kDistinctAggregationHashDedupEnabled, "true")
+      .assertResults(
+          "SELECT c0, count(distinct c1), sum(distinct c1), sum(c1) "
+          "FROM tmp GROUP BY 1");
+
+  // Masked distinct aggregates.
+  plan = PlanBuilder()
+             .values(vectors)
+             .singleAggregation(
+                 {"c0"}, {"count(distinct c1)", "count(c1)"}, {"c2", ""})
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(QueryConfig::kDistinctAggregationHashDedupEnabled, "true")
+      .assertResults(
+          "SELECT c0, count(distinct c1) FILTER (WHERE c2), count(c1) "
+          "FROM tmp GROUP BY 1");
+
+  // Global aggregation.
+  plan = PlanBuilder()
+             .values(vectors)
+             .singleAggregation({}, {"count(distinct c1)", "sum(distinct c0)"})
+             .planNode();
+  AssertQueryBuilder(plan, duckDbQueryRunner_)
+      .config(QueryConfig::kDistinctAggregationHashDedupEnabled, "true")
+      .assertResults("SELECT count(distinct c1), sum(distinct c0) FROM tmp");
+
+  // The deduplicated aggregates are spilled as regular accumulators.
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  core::PlanNodeId aggrNodeId;
+  auto task =
+      AssertQueryBuilder(duckDbQueryRunner_)
+          .spillDirectory(spillDirectory->path)
+          .config(QueryConfig::kSpillEnabled, "true")
+          .config(QueryConfig::kAggregationSpillEnabled, "true")
+          .config(QueryConfig::kTestingSpillPct, "100")
+          .config(QueryConfig::kDistinctAggregationHashDedupEnabled, "true")
+          .plan(PlanBuilder()
+                    .values(vectors)
+                    .singleAggregation(
+                        {"c0"}, {"count(distinct c1)", "sum(distinct c1)"})
+                    .capturePlanNodeId(aggrNodeId)
+                    .planNode())
+          .assertResults(
+              "SELECT c0, count(distinct c1), sum(distinct c1) "
+              "FROM tmp GROUP BY 1");
+  ASSERT_GT(toPlanStats(task->taskStats()).at(aggrNodeId).spilledBytes, 0);
+  OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+}
+
 TEST_F(AggregationTest, preGroupedAggregationWithSpilling) {
   std::vector<RowVectorPtr> vectors;
   int64_t val = 0;
@@ -1954,6 +2213,39 @@ TEST_F(AggregationTest, preGroupedAggregationWithSpilling) {
   OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
 }
 
+TEST_F(AggregationTest, preGroupedDistinct) {
+  // Runs of the pre-grouped key span input batches.
+  std::vector<RowVectorPtr> vectors;
+  int64_t val = 0;
+  for (int32_t i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(10, [&](auto /*row*/) { return val++ / 7; }),
+         makeFlatVector<int64_t>(10, [](auto row) { return row % 3; })}));
+  }
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId aggrNodeId;
+  auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                  .config("max_drivers_per_task", "1")
+                  .plan(PlanBuilder()
+                            .values(vectors)
+                            .aggregation(
+                                {"c0", "c1"},
+                                {"c0"},
+                                {},
+                                {},
+                                core::AggregationNode::Step::kSingle,
+                                false)
+                            .capturePlanNodeId(aggrNodeId)
+                            .planNode())
+                  .assertResults("SELECT DISTINCT c0, c1 FROM tmp");
+
+  // Only the groups of the last run stay in the hash table.
+  const auto runtimeStats =
+      toPlanStats(task->taskStats()).at(aggrNodeId).customStats;
+  EXPECT_GE(3, runtimeStats.at("hashtable.numDistinct").max);
+}
+
 TEST_F(AggregationTest, adaptiveOutputBatchRows) {
   int32_t defaultOutputBatchRows = 10;
   vector_size_t size = defaultOutputBatchRows * 5;
@@ -2002,6 +2294,47 @@ TEST_F(AggregationTest, adaptiveOutputBatchRows) {
   }
 }
 
+TEST_F(AggregationTest, partitionedFinalAggregation) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector(
+        {"c0", "c1", "c2"},
+        {makeFlatVector<int64_t>(1'000, [&](auto row) { return row % 997; }),
+         makeFlatVector<StringView>(
+             1'000,
+             [&](auto row) {
+               return StringView::makeInline(fmt::format("k{}", row % 7));
+             }),
+         makeFlatVector<int32_t>(1'000, [&](auto row) { return row + i; })}));
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto numDrivers : {1, 3, 4}) {
+    SCOPED_TRACE(fmt::format("numDrivers: {}", numDrivers));
+    core::PlanNodeId finalAggNodeId;
+    // The final aggregation runs in the same pipeline as the partial
+    // aggregation without a local exchange on the grouping keys.
+    auto plan = PlanBuilder()
+                    .values(vectors, true)
+                    .partialAggregation({"c0", "c1"}, {"sum(c2)", "max(c2)"})
+                    .finalAggregation()
+                    .capturePlanNodeId(finalAggNodeId)
+                    .planNode();
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .maxDrivers(numDrivers)
+            .config(QueryConfig::kPartitionedFinalAggregationEnabled, "true")
+            .config(QueryConfig::kPreferredOutputBatchRows, "17")
+            .assertResults(
+                "SELECT c0, c1, sum(c2), max(c2) FROM tmp GROUP BY c0, c1");
+    const auto runtimeStats =
+        toPlanStats(task->taskStats()).at(finalAggNodeId).customStats;
+    ASSERT_EQ(
+        runtimeStats.at("numPartitions").sum,
+        numDrivers * static_cast<int64_t>(bits::nextPowerOfTwo(numDrivers)));
+  }
+}
+
 DEBUG_ONLY_TEST_F(AggregationTest, reclaimDuringInputProcessing) {
   constexpr int64_t kMaxBytes = 1LL << 30; // 1GB
   auto rowType = ROW({"c0", "c1", "c2"}, {INTEGER(), INTEGER(), VARCHAR()});
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/ArrowStreamSink.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/QueryAssertions.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+class ArrowStreamSinkTest : public OperatorTestBase {
+ protected:
+  void SetUp() override {
+    OperatorTestBase::SetUp();
+    for (auto i = 0; i < 4; ++i) {
+      vectors_.push_back(makeRowVector({
+          makeFlatVector<int64_t>(100, [&](auto row) { return i * 100 + row; }),
+          makeFlatVector<std::string>(
+              100,
+              [&](auto row) {
+                return fmt::format("a string that is not inlined {}", row);
+              }),
+      }));
+    }
+  }
+
+  // Starts a task that returns 'vectors_' 'repeatTimes' times into 'sink'.
+  std::shared_ptr<Task> startTask(
+      const std::shared_ptr<ArrowStreamSink>& sink,
+      int32_t repeatTimes = 1) {
+    auto plan = PlanBuilder().values(vectors_, false, repeatTimes).planNode();
+    auto task = Task::create(
+        "task-0",
+        core::PlanFragment{plan},
+        0,
+        std::make_shared<core::QueryCtx>(driverExecutor_.get()),
+        sink->consumer());
+    Task::start(task, 1);
+    sink->setTask(task, task->numOutputDrivers());
+    return task;
+  }
+
+  // Reads 'stream' to the end, importing each array.
+  std::vector<RowVectorPtr> readAll(ArrowArrayStream& stream) {
+    std::vector<RowVectorPtr> results;
+    for (;;) {
+      ArrowArray array;
+      VELOX_CHECK_EQ(stream.get_next(&stream, &array), 0);
+      if (array.release == nullptr) {
+        return results;
+      }
+      ArrowSchema schema;
+      VELOX_CHECK_EQ(stream.get_schema(&stream, &schema), 0);
+      results.push_back(std::dynamic_pointer_cast<RowVector>(
+          importFromArrowAsOwner(schema, array, pool())));
+    }
+  }
+
+  std::vector<RowVectorPtr> vectors_;
+};
+
+TEST_F(ArrowStreamSinkTest, basic) {
+  auto sink = std::make_shared<ArrowStreamSink>(asRowType(vectors_[0]->type()));
+  auto task = startTask(sink);
+  ArrowArrayStream stream;
+  ArrowStreamSink::exportToArrow(sink, stream);
+  sink.reset();
+
+  auto results = readAll(stream);
+  stream.release(&stream);
+  ASSERT_EQ(stream.release, nullptr);
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+  assertEqualResults(vectors_, results);
+}
+
+TEST_F(ArrowStreamSinkTest, stringView) {
+  ArrowOptions options;
+  options.exportToStringView = true;
+  auto sink = std::make_shared<ArrowStreamSink>(
+      asRowType(vectors_[0]->type()), 32 << 20, options);
+  auto task = startTask(sink);
+  ArrowArrayStream stream;
+  ArrowStreamSink::exportToArrow(sink, stream);
+
+  ArrowSchema schema;
+  ASSERT_EQ(stream.get_schema(&stream, &schema), 0);
+  ASSERT_EQ(schema.n_children, 2);
+  EXPECT_STREQ(schema.children[1]->format, "vu");
+  schema.release(&schema);
+
+  auto results = readAll(stream);
+  stream.release(&stream);
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+  assertEqualResults(vectors_, results);
+}
+
+TEST_F(ArrowStreamSinkTest, backpressure) {
+  // Any batch fills the buffer, so the producer waits for the consumer after
+  // each one.
+  auto sink =
+      std::make_shared<ArrowStreamSink>(asRowType(vectors_[0]->type()), 1);
+  auto task = startTask(sink, 10);
+  ArrowArrayStream stream;
+  ArrowStreamSink::exportToArrow(sink, stream);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  ASSERT_TRUE(task->isRunning());
+
+  auto results = readAll(stream);
+  stream.release(&stream);
+  ASSERT_EQ(results.size(), 10 * vectors_.size());
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+}
+
+TEST_F(ArrowStreamSinkTest, releaseBeforeEnd) {
+  auto sink =
+      std::make_shared<ArrowStreamSink>(asRowType(vectors_[0]->type()), 1);
+  auto task = startTask(sink, 10);
+  ArrowArrayStream stream;
+  ArrowStreamSink::exportToArrow(sink, stream);
+  sink.reset();
+
+  ArrowArray array;
+  ASSERT_EQ(stream.get_next(&stream, &array), 0);
+  ASSERT_NE(array.release, nullptr);
+  stream.release(&stream);
+  ASSERT_TRUE(waitForTaskCancelled(task.get()));
+
+  // The array stays valid after the stream and the task are gone.
+  task.reset();
+  ArrowSchema schema;
+  exportToArrow(vectors_[0], schema);
+  auto imported = importFromArrowAsOwner(schema, array, pool());
+  assertEqualVectors(vectors_[0], imported);
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/ByteComparableSerde.h"
+#include <gtest/gtest.h>
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::exec {
+
+namespace {
+
+int32_t sign(int32_t value) {
+  return value < 0 ? -1 : value > 0 ? 1 : 0;
+}
+
+class ByteComparableSerdeTest : public testing::Test,
+                                public velox::test::VectorTestBase {
+ protected:
+  std::vector<std::string> serialize(const VectorPtr& data) {
+    std::vector<std::string> serialized(data->size());
+    for (auto i = 0; i < data->size(); ++i) {
+      if (!data->isNullAt(i)) {
+        ByteComparableSerde::serialize(*data, i, serialized[i]);
+      }
+    }
+    return serialized;
+  }
+
+  void testRoundTrip(const VectorPtr& data) {
+    auto serialized = serialize(data);
+    auto copy = BaseVector::create(data->type(), data->size(), pool());
+    for (auto i = 0; i < data->size(); ++i) {
+      if (data->isNullAt(i)) {
+        copy->setNull(i, true);
+      } else {
+        ByteComparableSerde::deserialize(
+            StringView(serialized[i]), i, copy.get());
+      }
+    }
+    test::assertEqualVectors(data, copy);
+  }
+
+  // Checks that the serializations of all pairs of non-null values compare
+  // like the values for all orders.
+  void testCompare(const VectorPtr& data) {
+    auto serialized = serialize(data);
+    for (auto ascending : {true, false}) {
+      for (auto nullsFirst : {true, false}) {
+        CompareFlags flags{nullsFirst, ascending, false};
+        for (auto i = 0; i < data->size(); ++i) {
+          for (auto j = 0; j < data->size(); ++j) {
+            if (data->isNullAt(i) || data->isNullAt(j)) {
+              continue;
+            }
+            auto expected = data->compare(data.get(), i, j, flags).value();
+            ASSERT_EQ(
+                sign(expected),
+                sign(ByteComparableSerde::compare(
+                    StringView(serialized[i]),
+                    StringView(serialized[j]),
+                    data->type().get(),
+                    flags)))
+                << "at " << i << ", " << j << " " << flags.toString() << ": "
+                << data->toString(i) << " vs " << data->toString(j);
+          }
+        }
+      }
+    }
+  }
+};
+
+TEST_F(ByteComparableSerdeTest, roundTrip) {
+  testRoundTrip(makeArrayVector<int64_t>({{1, -2, 3}, {}, {-4}}));
+  testRoundTrip(makeNullableArrayVector<double>(
+      {{{{1.5, std::nullopt, -2.25}}}, {{{-0.5, 1e300}}}, std::nullopt}));
+  testRoundTrip(makeNullableArrayVector<std::string>(
+      {{{{"a", std::nullopt, std::string("b\0c", 3)}}},
+       {{{"Longer than the inline size of a string view"}}},
+       {{{""}}}}));
+  testRoundTrip(makeRowVector(
+      {makeNullableFlatVector<int32_t>({1, std::nullopt, -3}),
+       makeFlatVector<bool>({true, false, true}),
+       makeFlatVector<Timestamp>(
+           {Timestamp(-1, 10), Timestamp(0, 0), Timestamp(100, 5)}),
+       makeArrayVector<int16_t>({{1}, {}, {-1, 2}})}));
+  testRoundTrip(makeMapVector<std::string, int64_t>(
+      {{{"b", 2}, {"a", 1}}, {}, {{"c", -3}}}));
+}
+
+TEST_F(ByteComparableSerdeTest, equalValues) {
+  // Maps with the same entries in different orders, -0.0 and 0.0, and NaNs
+  // with different bits have equal serializations.
+  auto maps = makeMapVector<int64_t, int64_t>(
+      {{{1, 10}, {2, 20}, {3, 30}}, {{3, 30}, {1, 10}, {2, 20}}});
+  auto serialized = serialize(maps);
+  EXPECT_EQ(serialized[0], serialized[1]);
+
+  auto doubles = makeArrayVector<double>(
+      {{0.0, std::nan("1")}, {-0.0, -std::numeric_limits<double>::quiet_NaN()}});
+  serialized = serialize(doubles);
+  EXPECT_EQ(serialized[0], serialized[1]);
+
+  auto strings = makeArrayVector<std::string>(
+      {{std::string("a\0", 2)}, {"a"}, {std::string("a\0b", 3)}});
+  serialized = serialize(strings);
+  EXPECT_NE(serialized[0], serialized[1]);
+  EXPECT_LT(serialized[1], serialized[0]);
+  EXPECT_LT(serialized[0], serialized[2]);
+}
+
+TEST_F(ByteComparableSerdeTest, compare) {
+  testCompare(makeNullableArrayVector<int64_t>({
+      {{{1, 2}}},
+      {{{1, 5}}},
+      {{{1, 3, 5}}},
+      {{{1, 2, 3, 4}}},
+      {{{1, 2, std::nullopt, 4}}},
+      {{{1, std::nullopt, 5}}},
+      {{{std::nullopt, -1}}},
+      {{{-1}}},
+      {{std::vector<std::optional<int64_t>>({})}},
+  }));
+
+  testCompare(makeNullableArrayVector<std::string>({
+      {{{"a"}}},
+      {{{std::string("a\0", 2)}}},
+      {{{"ab"}}},
+      {{{"", "b"}}},
+      {{{std::nullopt, "b"}}},
+      {{{"Longer than the inline size of a string view"}}},
+  }));
+
+  testCompare(makeMapVector<int64_t, int64_t>({
+      {{1, 10}, {2, 20}},
+      {{2, 20}, {1, 11}},
+      {{1, 10}},
+      {{-1, 10}, {1, 10}},
+      {},
+  }));
+}
+
+TEST_F(ByteComparableSerdeTest, fuzzCompare) {
+  VectorFuzzer::Options opts;
+  opts.vectorSize = 100;
+  opts.nullRatio = 0.2;
+  opts.containerLength = 3;
+  opts.stringLength = 3;
+
+  VectorFuzzer fuzzer(opts, pool_.get());
+  for (auto i = 0; i < 20; ++i) {
+    auto seed = folly::Random::rand32();
+    fuzzer.reSeed(seed);
+    for (const auto& type : std::vector<TypePtr>{
+             ARRAY(BIGINT()),
+             ARRAY(VARCHAR()),
+             ROW({INTEGER(), ARRAY(SMALLINT())}),
+             ARRAY(ROW({VARCHAR(), TINYINT()}))}) {
+      SCOPED_TRACE(fmt::format("seed: {}, {}", seed, type->toString()));
+      auto data = fuzzer.fuzz(type);
+      testRoundTrip(data);
+      testCompare(data);
+    }
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::exec
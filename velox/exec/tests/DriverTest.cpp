@@ -605,6 +605,37 @@ TEST_F(DriverTest, yield) {
   }
 }
 
+TEST_F(DriverTest, timeSliceYield) {
+  CursorParameters params;
+  int32_t hits;
+  params.planNode = makeValuesFilterProject(
+      rowType_,
+      "m1 % 10 > 0",
+      "m1 % 3 + m2 % 5 + m3 % 7 + m4 % 11 + m5 % 13 + m6 % 17 + m7 % 19",
+      200,
+      2'000,
+      [](int64_t num) { return num % 10 > 0; },
+      &hits);
+  params.maxDrivers = 4;
+  // A 1ms slice scaled down by 1/100 shares gives each Driver 10us per turn.
+  std::unordered_map<std::string, std::string> queryConfig{
+      {core::QueryConfig::kDriverCpuTimeSliceLimitMs, "1"},
+      {core::QueryConfig::kQueryCpuShares, "1"}};
+  params.queryCtx = std::make_shared<core::QueryCtx>(
+      executor_.get(), core::QueryConfig(std::move(queryConfig)));
+  int32_t numRead = 0;
+  readResults(params, ResultOperation::kRead, 1'000'000, &numRead);
+  EXPECT_EQ(numRead, 4 * hits);
+  auto& executor = folly::QueuedImmediateExecutor::instance();
+  auto future = tasks_[0]->taskCompletionFuture(1'000'000).via(&executor);
+  future.wait();
+  const auto taskStats = tasks_[0]->taskStats();
+  EXPECT_GT(taskStats.numDriverTimeSliceYields, 0);
+  EXPECT_GT(taskStats.numDriverRuns, 4);
+  EXPECT_GE(
+      taskStats.driverQueuedWallNanos, taskStats.maxDriverQueuedWallNanos);
+}
+
 // A testing Operator that periodically does one of the following:
 //
 // 1. Blocks and registers a resume that continues the Driver after a timed
@@ -16,6 +16,7 @@
 #include <gtest/gtest.h>
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/exec/Exchange.h"
+#include "velox/exec/InProcessExchangeSource.h"
 #include "velox/exec/PartitionedOutputBufferManager.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/LocalExchangeSource.h"
@@ -197,5 +198,104 @@ TEST_F(ExchangeClientTest, flowControl) {
   }
 }
 
+// Verify that a client asking for a window of pages per request receives all
+// the data and reports the request latency of each source.
+TEST_F(ExchangeClientTest, requestWindow) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(10'000, [](auto row) { return row; }),
+  });
+
+  auto page = toSerializedPage(data);
+
+  ExchangeClient client("request.window", 17, pool(), page->size() * 20, 4);
+
+  auto plan = test::PlanBuilder()
+                  .values({data})
+                  .partitionedOutput({"c0"}, 100)
+                  .planNode();
+  std::vector<std::shared_ptr<Task>> tasks;
+  for (auto i = 0; i < 3; ++i) {
+    auto taskId = fmt::format("local://w{}", i);
+    auto task = makeTask(taskId, plan, 17);
+
+    bufferManager_->initializeTask(
+        task, core::PartitionedOutputNode::Kind::kPartitioned, 100, 16);
+
+    for (auto j = 0; j < 3; ++j) {
+      enqueue(taskId, 17, data);
+    }
+
+    tasks.push_back(task);
+    client.addRemoteTaskId(taskId);
+  }
+
+  fetchPages(client, 3 * tasks.size());
+
+  auto stats = client.stats();
+  EXPECT_EQ(9, stats.at("numReceivedPages").sum);
+  EXPECT_LE(stats.at("peakBytes").sum, page->size() * 20);
+  const auto& latency = stats.at("sourceRequestWallNanos");
+  EXPECT_EQ(tasks.size(), latency.count);
+  EXPECT_EQ(RuntimeCounter::Unit::kNanos, latency.unit);
+
+  for (auto& task : tasks) {
+    task->requestCancel();
+    bufferManager_->removeTask(task->taskId());
+  }
+}
+
+// Verify that a source in the same process receives both serialized pages and
+// pages holding vectors, and that the vectors are copied to the consumer.
+TEST_F(ExchangeClientTest, inProcessSource) {
+  ExchangeSource::factories().clear();
+  ExchangeSource::registerFactory(InProcessExchangeSource::create);
+
+  auto data = makeRowVector({
+      makeFlatVector<int32_t>({1, 2, 3}),
+      makeFlatVector<std::string>({"a", "b", "c"}),
+  });
+  auto plan = test::PlanBuilder()
+                  .values({data})
+                  .partitionedOutput({"c0"}, 100)
+                  .planNode();
+  auto taskId = "in.process.t1";
+  auto task = makeTask(taskId, plan, 17);
+  bufferManager_->initializeTask(
+      task, core::PartitionedOutputNode::Kind::kPartitioned, 100, 16);
+
+  enqueue(taskId, 17, data);
+  ContinueFuture unused;
+  ASSERT_FALSE(bufferManager_->enqueue(
+      taskId,
+      17,
+      std::make_unique<SerializedPage>(data, data->retainedSize()),
+      &unused));
+
+  ExchangeClient client(
+      "t", 17, pool(), ExchangeClient::kDefaultMaxQueuedBytes);
+  VELOX_ASSERT_THROW(
+      client.addRemoteTaskId("remote.t2"), "No ExchangeSource factory");
+  client.addRemoteTaskId(taskId);
+
+  bool atEnd;
+  ContinueFuture future;
+  auto page = client.next(&atEnd, &future);
+  ASSERT_TRUE(page != nullptr);
+  ASSERT_TRUE(page->vector() == nullptr);
+
+  page = client.next(&atEnd, &future);
+  ASSERT_TRUE(page != nullptr);
+  ASSERT_TRUE(page->vector() != nullptr);
+  ASSERT_NE(page->vector().get(), data.get());
+  velox::test::assertEqualVectors(data, page->vector());
+
+  auto stats = client.stats();
+  EXPECT_EQ(2, stats.at("inProcessExchangeSource.numPages").sum);
+  EXPECT_EQ(1, stats.at("inProcessExchangeSource.numVectorPages").sum);
+
+  task->requestCancel();
+  bufferManager_->removeTask(taskId);
+}
+
 } // namespace
 } // namespace facebook::velox::exec
@@ -515,4 +515,60 @@ TEST_F(GroupedExecutionTest, groupedExecution) {
   EXPECT_EQ(numRead, numSplits * 10'000);
 }
 
+TEST_F(GroupedExecutionTest, splitGroupMemoryBudget) {
+  constexpr int64_t kBudget = 8 << 20;
+  auto vectors = makeVectors(10, 1'000);
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+
+  CursorParameters params;
+  params.planNode = tableScanNode(ROW({}, {}));
+  params.maxDrivers = 2;
+  params.executionStrategy = core::ExecutionStrategy::kGrouped;
+  params.groupedExecutionLeafNodeIds.emplace(params.planNode->id());
+  params.numSplitGroups = 2;
+  params.numConcurrentSplitGroups = 2;
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(4);
+  params.queryCtx = std::make_shared<core::QueryCtx>(
+      executor.get(),
+      core::QueryConfig({
+          {core::QueryConfig::kSplitGroupMemoryBudget,
+           std::to_string(kBudget)},
+      }));
+
+  auto cursor = std::make_unique<TaskCursor>(params);
+  auto task = cursor->task();
+  cursor->start();
+
+  // Make the task use more memory than the budget of the one split group
+  // that can run next to the first.
+  auto leafPool = task->pool()->addLeafChild("splitGroupMemoryBudget");
+  void* buffer = leafPool->allocate(2 * kBudget);
+
+  task->addSplit("0", makeHiveSplitWithGroup(filePath->path, 1));
+  task->addSplit("0", makeHiveSplitWithGroup(filePath->path, 5));
+
+  // Only the first split group runs, the second one waits for memory.
+  EXPECT_EQ(2, task->numRunningDrivers());
+  EXPECT_GT(task->taskStats().numDeferredSplitGroups, 0);
+
+  leafPool->free(buffer, 2 * kBudget);
+  leafPool.reset();
+
+  // The second split group starts once the first one finishes.
+  task->noMoreSplitsForGroup("0", 1);
+  waitForFinishedDrivers(task, 2);
+  EXPECT_EQ(2, task->numRunningDrivers());
+
+  task->noMoreSplitsForGroup("0", 5);
+  task->noMoreSplits("0");
+  int32_t numRead = 0;
+  while (cursor->moveNext()) {
+    numRead += cursor->current()->size();
+  }
+  EXPECT_EQ(exec::TaskState::kFinished, task->state());
+  EXPECT_EQ(std::unordered_set<int32_t>({1, 5}), getCompletedSplitGroups(task));
+  EXPECT_EQ(numRead, 2 * 10'000);
+}
+
 } // namespace facebook::velox::exec::test
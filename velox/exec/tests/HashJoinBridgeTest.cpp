@@ -486,6 +486,114 @@ TEST_P(HashJoinBridgeTest, multiThreading) {
   }
 }
 
+TEST_P(HashJoinBridgeTest, swapSides) {
+  using SwapState = HashJoinBridge::SwapState;
+  auto makeBridge = [&](int32_t numSwapBuilders) {
+    auto joinBridge = createJoinBridge();
+    for (int32_t i = 0; i < numBuilders_; ++i) {
+      joinBridge->addBuilder();
+      if (i < numSwapBuilders) {
+        joinBridge->enableSwap(10, 1 << 20);
+      }
+    }
+    for (int32_t i = 0; i < numProbers_; ++i) {
+      joinBridge->addProber();
+    }
+    joinBridge->start();
+    return joinBridge;
+  };
+  auto input = BaseVector::create<RowVector>(rowType_, 10, pool_.get());
+  const auto probeBytes = numProbers_ * input->estimateFlatSize();
+
+  // The swap needs all builders to enable it.
+  ASSERT_EQ(makeBridge(numBuilders_ - 1)->swapState(), SwapState::kNoSwap);
+  auto joinBridge = makeBridge(numBuilders_);
+  joinBridge->disableSwap();
+  ASSERT_EQ(joinBridge->swapState(), SwapState::kNoSwap);
+
+  {
+    // The build side is more than 10 times larger than the whole probe side.
+    joinBridge = makeBridge(numBuilders_);
+    auto future = ContinueFuture::makeEmpty();
+    ASSERT_EQ(joinBridge->addBuildInputBytes(1, &future), SwapState::kUndecided);
+    ASSERT_FALSE(future.valid());
+    for (int32_t i = 0; i < numProbers_; ++i) {
+      joinBridge->addProbeInput(input);
+      joinBridge->probeInputFinished();
+    }
+    ASSERT_EQ(joinBridge->swapState(), SwapState::kUndecided);
+    ASSERT_EQ(
+        joinBridge->addBuildInputBytes(probeBytes * 10, &future),
+        SwapState::kSwap);
+    ASSERT_FALSE(future.valid());
+
+    // The first prober builds the swapped table from the probe side input.
+    std::vector<RowVectorPtr> probeInputs;
+    ASSERT_EQ(joinBridge->swappedTableOrFuture(&future, probeInputs), nullptr);
+    ASSERT_FALSE(future.valid());
+    ASSERT_EQ(probeInputs.size(), numProbers_);
+    std::vector<RowVectorPtr> otherInputs;
+    ASSERT_EQ(joinBridge->swappedTableOrFuture(&future, otherInputs), nullptr);
+    ASSERT_TRUE(future.valid());
+    ASSERT_TRUE(otherInputs.empty());
+    std::shared_ptr<BaseHashTable> table = createFakeHashTable();
+    joinBridge->setSwappedTable(table);
+    ASSERT_TRUE(future.isReady());
+    future = ContinueFuture::makeEmpty();
+    ASSERT_EQ(joinBridge->swappedTableOrFuture(&future, otherInputs), table);
+
+    // The build side input passes through the bridge.
+    ASSERT_EQ(joinBridge->nextBuildInput(&future), nullptr);
+    ASSERT_TRUE(future.valid());
+    ASSERT_FALSE(joinBridge->addBuildInput(input, &future));
+    ASSERT_TRUE(future.isReady());
+    future = ContinueFuture::makeEmpty();
+    ASSERT_EQ(joinBridge->nextBuildInput(&future), input);
+    ASSERT_EQ(joinBridge->nextBuildInput(&future), nullptr);
+    ASSERT_TRUE(future.valid());
+    for (int32_t i = 0; i < numBuilders_; ++i) {
+      ASSERT_FALSE(future.isReady());
+      joinBridge->buildInputFinished();
+    }
+    ASSERT_TRUE(future.isReady());
+    future = ContinueFuture::makeEmpty();
+    ASSERT_EQ(joinBridge->nextBuildInput(&future), nullptr);
+    ASSERT_FALSE(future.valid());
+  }
+
+  {
+    // The whole build side is not 10 times larger than the probe side seen so
+    // far.
+    joinBridge = makeBridge(numBuilders_);
+    joinBridge->addProbeInput(input);
+    auto futures = createEmptyFutures(numBuilders_);
+    for (int32_t i = 0; i < numBuilders_; ++i) {
+      ASSERT_EQ(
+          joinBridge->addBuildInputBytes(
+              input->estimateFlatSize() / numBuilders_, &futures[i]),
+          SwapState::kUndecided);
+      ASSERT_FALSE(futures[i].valid());
+    }
+    for (int32_t i = 0; i < numBuilders_ - 1; ++i) {
+      ASSERT_EQ(
+          joinBridge->buildBufferingFinished(&futures[i]),
+          SwapState::kUndecided);
+      ASSERT_TRUE(futures[i].valid());
+    }
+    ASSERT_EQ(
+        joinBridge->buildBufferingFinished(&futures.back()),
+        SwapState::kNoSwap);
+    for (int32_t i = 0; i < numBuilders_ - 1; ++i) {
+      ASSERT_TRUE(futures[i].isReady());
+    }
+    // The probers probe the buffered input without a swap.
+    joinBridge->addProbeInput(input);
+    ASSERT_EQ(joinBridge->takeProbeInput(), input);
+    ASSERT_EQ(joinBridge->takeProbeInput(), input);
+    ASSERT_EQ(joinBridge->takeProbeInput(), nullptr);
+  }
+}
+
 VELOX_INSTANTIATE_TEST_SUITE_P(
     HashJoinBridgeTest,
     HashJoinBridgeTest,
@@ -16,12 +16,14 @@
 
 #include <re2/re2.h>
 
+#include <folly/ScopeGuard.h>
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/common/testutil/TestValue.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/HashBuild.h"
 #include "velox/exec/HashJoinBridge.h"
+#include "velox/exec/HashTableCache.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/Cursor.h"
@@ -3118,6 +3120,41 @@ TEST_P(MultiThreadedHashJoinTest, noSpillLevelLimit) {
       .run();
 }
 
+TEST_P(MultiThreadedHashJoinTest, spillRepartition) {
+  HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+      .numDrivers(numDrivers_)
+      .keyTypes({INTEGER()})
+      .probeVectors(1600, 5)
+      .buildVectors(1500, 5)
+      .referenceQuery(
+          "SELECT t_k0, t_data, u_k0, u_data FROM t, u WHERE t.t_k0 = u.u_k0")
+      .maxSpillLevel(2)
+      .config(core::QueryConfig::kSpillStartPartitionBit, "48")
+      .config(core::QueryConfig::kJoinSpillPartitionBits, "3")
+      .config(core::QueryConfig::kJoinSpillRepartitionBytes, "1")
+      .checkSpillStats(false)
+      .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+        if (!hasSpill) {
+          return;
+        }
+        ASSERT_EQ(maxHashBuildSpillLevel(*task), 2);
+        uint64_t numRepartitions{0};
+        for (const auto& pipeline : task->taskStats().pipelineStats) {
+          for (const auto& op : pipeline.operatorStats) {
+            if (op.operatorType != "HashBuild") {
+              continue;
+            }
+            auto it = op.runtimeStats.find("spillRepartitionBytes");
+            if (it != op.runtimeStats.end()) {
+              numRepartitions += it->second.count;
+            }
+          }
+        }
+        ASSERT_GT(numRepartitions, 0);
+      })
+      .run();
+}
+
 TEST_F(HashJoinTest, duplicateJoinKeys) {
   auto leftVectors = makeBatches(3, [&](int32_t /*unused*/) {
     return makeRowVector({
@@ -4431,6 +4468,129 @@ TEST_F(HashJoinTest, dynamicFilters) {
   }
 }
 
+TEST_F(HashJoinTest, bloomFilterDynamicFilters) {
+  const int32_t numSplits = 5;
+  const int32_t numRowsProbe = 1'000;
+  const int32_t numRowsBuild = 100;
+
+  // String keys have no exact dynamic filter, so only the Bloom filter from the
+  // build side can be pushed down.
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<std::shared_ptr<TempFilePath>> tempFiles;
+  for (int32_t i = 0; i < numSplits; ++i) {
+    auto rowVector = makeRowVector({
+        makeFlatVector<StringView>(
+            numRowsProbe,
+            [&](auto row) {
+              return StringView(fmt::format("key-{}", row + i * numRowsProbe));
+            }),
+        makeFlatVector<int64_t>(numRowsProbe, [](auto row) { return row; }),
+    });
+    probeVectors.push_back(rowVector);
+    tempFiles.push_back(TempFilePath::create());
+    writeToFile(tempFiles.back()->path, rowVector);
+  }
+  auto makeInputSplits = [&](const core::PlanNodeId& nodeId) {
+    return [&] {
+      std::vector<exec::Split> probeSplits;
+      for (auto& file : tempFiles) {
+        probeSplits.push_back(exec::Split(makeHiveConnectorSplit(file->path)));
+      }
+      SplitInput splits;
+      splits.emplace(nodeId, probeSplits);
+      return splits;
+    };
+  };
+
+  std::vector<RowVectorPtr> buildVectors;
+  buildVectors.push_back(makeRowVector({
+      makeFlatVector<StringView>(
+          numRowsBuild,
+          [](auto row) { return StringView(fmt::format("key-{}", row * 7)); }),
+      makeFlatVector<int64_t>(numRowsBuild, [](auto row) { return row; }),
+  }));
+
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+  auto buildSide = PlanBuilder(planNodeIdGenerator, pool_.get())
+                       .values(buildVectors)
+                       .project({"c0 AS u_c0", "c1 AS u_c1"})
+                       .planNode();
+
+  for (const auto joinType :
+       {core::JoinType::kInner, core::JoinType::kLeftSemiFilter}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    core::PlanNodeId probeScanId;
+    auto op = PlanBuilder(planNodeIdGenerator, pool_.get())
+                  .tableScan(ROW({"c0", "c1"}, {VARCHAR(), BIGINT()}))
+                  .capturePlanNodeId(probeScanId)
+                  .hashJoin(
+                      {"c0"},
+                      {"u_c0"},
+                      buildSide,
+                      "",
+                      {"c0", "c1"},
+                      joinType)
+                  .planNode();
+
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(std::move(op))
+        .config(core::QueryConfig::kHashProbeBloomFilterPushdownMaxSize, "1024")
+        .makeInputSplits(makeInputSplits(probeScanId))
+        .referenceQuery(
+            joinType == core::JoinType::kInner
+                ? "SELECT t.c0, t.c1 FROM t, u WHERE t.c0 = u.c0"
+                : "SELECT t.c0, t.c1 FROM t WHERE t.c0 IN (SELECT c0 FROM u)")
+        .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+          SCOPED_TRACE(fmt::format("hasSpill:{}", hasSpill));
+          if (hasSpill) {
+            ASSERT_EQ(0, getFiltersProduced(task, 1).sum);
+            ASSERT_EQ(getInputPositions(task, 1), numRowsProbe * numSplits);
+          } else {
+            ASSERT_EQ(1, getFiltersProduced(task, 1).sum);
+            ASSERT_EQ(1, getFiltersAccepted(task, 0).sum);
+            ASSERT_EQ(
+                1,
+                getOperatorRuntimeStats(task, 1, "dynamicBloomFiltersProduced")
+                    .sum);
+            // The Bloom filter is approximate, so the join is not replaced.
+            ASSERT_EQ(0, getReplacedWithFilterRows(task, 1).sum);
+            ASSERT_LT(getInputPositions(task, 1), numRowsProbe * numSplits);
+          }
+        })
+        .run();
+  }
+
+  // The Bloom filter is not built if it exceeds the max size.
+  {
+    core::PlanNodeId probeScanId;
+    auto op = PlanBuilder(planNodeIdGenerator, pool_.get())
+                  .tableScan(ROW({"c0", "c1"}, {VARCHAR(), BIGINT()}))
+                  .capturePlanNodeId(probeScanId)
+                  .hashJoin(
+                      {"c0"},
+                      {"u_c0"},
+                      buildSide,
+                      "",
+                      {"c0", "c1"},
+                      core::JoinType::kInner)
+                  .planNode();
+
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(std::move(op))
+        .config(core::QueryConfig::kHashProbeBloomFilterPushdownMaxSize, "16")
+        .makeInputSplits(makeInputSplits(probeScanId))
+        .referenceQuery("SELECT t.c0, t.c1 FROM t, u WHERE t.c0 = u.c0")
+        .verifier([&](const std::shared_ptr<Task>& task, bool /*hasSpill*/) {
+          ASSERT_EQ(0, getFiltersProduced(task, 1).sum);
+          ASSERT_EQ(getInputPositions(task, 1), numRowsProbe * numSplits);
+        })
+        .run();
+  }
+}
+
 TEST_F(HashJoinTest, dynamicFiltersWithSkippedSplits) {
   const int32_t numSplits = 20;
   const int32_t numNonSkippedSplits = 10;
@@ -4754,6 +4914,337 @@ TEST_F(HashJoinTest, smallOutputBatchSize) {
       .run();
 }
 
+TEST_F(HashJoinTest, lazyBuildColumns) {
+  auto probeVectors = makeBatches(3, [&](int32_t batch) {
+    return makeRowVector({
+        makeFlatVector<int32_t>(1'000, [](auto row) { return row % 97; }),
+        makeFlatVector<int64_t>(
+            1'000, [batch](auto row) { return batch * 1'000 + row; }),
+    });
+  });
+  auto buildVectors = makeBatches(2, [&](int32_t batch) {
+    return makeRowVector(
+        {"u_c0", "u_c1", "u_c2"},
+        {
+            makeFlatVector<int32_t>(
+                100, [batch](auto row) { return batch * 50 + row; }),
+            makeFlatVector<int64_t>(100, [](auto row) { return row * 10; }),
+            makeFlatVector<StringView>(
+                100,
+                [](auto row) {
+                  return StringView::makeInline(
+                      fmt::format("payload {}", row % 7));
+                },
+                nullEvery(11)),
+        });
+  });
+
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  for (auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors)
+                    .hashJoin(
+                        {"c0"},
+                        {"u_c0"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors)
+                            .planNode(),
+                        "",
+                        {"c0", "c1", "u_c1", "u_c2"},
+                        joinType)
+                    .filter("u_c1 % 3 = 0")
+                    .planNode();
+
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(std::move(plan))
+        .config(core::QueryConfig::kHashProbeLazyBuildColumns, "true")
+        .referenceQuery(fmt::format(
+            "SELECT c0, c1, u_c1, u_c2 FROM t {} JOIN u ON c0 = u_c0 "
+            "WHERE u_c1 % 3 = 0",
+            joinType == core::JoinType::kInner ? "INNER" : "LEFT"))
+        .run();
+  }
+}
+
+TEST_F(HashJoinTest, membershipProbe) {
+  // Dense build keys with gaps and duplicates make an array mode table that
+  // semi and anti joins probe by membership.
+  auto probeVectors = makeBatches(3, [&](int32_t batch) {
+    return makeRowVector({
+        makeFlatVector<int32_t>(
+            1'000, [batch](auto row) { return (batch * 1'000 + row) % 1'200; }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+    });
+  });
+  auto buildVectors = makeBatches(2, [&](int32_t /*unused*/) {
+    return makeRowVector(
+        {"u_c0", "u_c1"},
+        {
+            makeFlatVector<int32_t>(500, [](auto row) { return row * 2; }),
+            makeFlatVector<int64_t>(500, [](auto row) { return row; }),
+        });
+  });
+
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  struct {
+    core::JoinType joinType;
+    std::vector<std::string> outputLayout;
+    std::string referenceQuery;
+  } testSettings[] = {
+      {core::JoinType::kLeftSemiFilter,
+       {"c0", "c1"},
+       "SELECT c0, c1 FROM t WHERE c0 IN (SELECT u_c0 FROM u)"},
+      {core::JoinType::kLeftSemiProject,
+       {"c0", "c1", "match"},
+       "SELECT c0, c1, EXISTS (SELECT * FROM u WHERE c0 = u_c0) FROM t"},
+      {core::JoinType::kAnti,
+       {"c0", "c1"},
+       "SELECT c0, c1 FROM t WHERE NOT EXISTS "
+       "(SELECT * FROM u WHERE c0 = u_c0)"},
+  };
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(core::joinTypeName(testData.joinType));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors)
+                    .hashJoin(
+                        {"c0"},
+                        {"u_c0"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors)
+                            .planNode(),
+                        "",
+                        testData.outputLayout,
+                        testData.joinType)
+                    .planNode();
+
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(std::move(plan))
+        .referenceQuery(testData.referenceQuery)
+        .run();
+  }
+}
+
+TEST_F(HashJoinTest, coalesceOutput) {
+  auto probeVectors = makeBatches(10, [&](int32_t batch) {
+    return makeRowVector({
+        makeFlatVector<int32_t>(
+            1'000, [batch](auto row) { return batch * 1'000 + row; }),
+        makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+    });
+  });
+  // Each probe batch matches 10 build rows.
+  auto buildVectors = makeBatches(1, [&](int32_t /*unused*/) {
+    return makeRowVector(
+        {"u_c0", "u_c1"},
+        {
+            makeFlatVector<int32_t>(100, [](auto row) { return row * 100; }),
+            makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+        });
+  });
+
+  createDuckDbTable("t", probeVectors);
+  createDuckDbTable("u", buildVectors);
+
+  for (auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+    SCOPED_TRACE(core::joinTypeName(joinType));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors)
+                    .hashJoin(
+                        {"c0"},
+                        {"u_c0"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors)
+                            .planNode(),
+                        "",
+                        {"c0", "c1", "u_c1"},
+                        joinType)
+                    .planNode();
+
+    const bool selective = joinType == core::JoinType::kInner;
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .planNode(std::move(plan))
+        .config(core::QueryConfig::kHashProbeMinOutputBatchRows, "50")
+        .referenceQuery(fmt::format(
+            "SELECT c0, c1, u_c1 FROM t {} JOIN u ON c0 = u_c0",
+            selective ? "INNER" : "LEFT"))
+        .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+          if (!selective || hasSpill) {
+            return;
+          }
+          // The 10 matches of each probe batch are returned in batches of at
+          // least 50 rows, except for the last.
+          for (const auto& pipelineStat : task->taskStats().pipelineStats) {
+            for (const auto& operatorStat : pipelineStat.operatorStats) {
+              if (operatorStat.operatorType == "HashProbe") {
+                ASSERT_LE(
+                    operatorStat.outputVectors,
+                    operatorStat.outputPositions / 50 + 1);
+              }
+            }
+          }
+        })
+        .run();
+  }
+}
+
+TEST_F(HashJoinTest, swapSides) {
+  // The build side input is about 100 times larger than the probe side input.
+  // Both sides have duplicate and null keys.
+  auto probeVectors = makeBatches(2, [&](int32_t /*unused*/) {
+    return makeRowVector({
+        makeFlatVector<int32_t>(
+            50, [](auto row) { return row % 30 * 7; }, nullEvery(11)),
+        makeFlatVector<int64_t>(50, [](auto row) { return row; }),
+    });
+  });
+  auto buildVectors = makeBatches(20, [&](int32_t batch) {
+    return makeRowVector(
+        {"u_c0", "u_c1"},
+        {
+            makeFlatVector<int32_t>(
+                500,
+                [batch](auto row) { return (batch * 500 + row) % 1'000; },
+                nullEvery(13)),
+            makeFlatVector<int64_t>(500, [batch](auto row) { return batch; }),
+        });
+  });
+
+  // Each driver produces all the input.
+  std::vector<RowVectorPtr> allProbeVectors;
+  std::vector<RowVectorPtr> allBuildVectors;
+  for (auto i = 0; i < numDrivers_; ++i) {
+    allProbeVectors.insert(
+        allProbeVectors.end(), probeVectors.begin(), probeVectors.end());
+    allBuildVectors.insert(
+        allBuildVectors.end(), buildVectors.begin(), buildVectors.end());
+  }
+  createDuckDbTable("t", allProbeVectors);
+  createDuckDbTable("u", allBuildVectors);
+
+  struct {
+    core::JoinType joinType;
+    std::string ratio;
+    bool swapped;
+  } testSettings[] = {
+      {core::JoinType::kInner, "10", true},
+      {core::JoinType::kInner, "1000", false},
+      {core::JoinType::kLeft, "10", false},
+  };
+  for (const auto& testData : testSettings) {
+    SCOPED_TRACE(fmt::format(
+        "{} ratio: {}", core::joinTypeName(testData.joinType), testData.ratio));
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(probeVectors, true)
+                    .hashJoin(
+                        {"c0"},
+                        {"u_c0"},
+                        PlanBuilder(planNodeIdGenerator)
+                            .values(buildVectors, true)
+                            .planNode(),
+                        "",
+                        {"c0", "c1", "u_c1"},
+                        testData.joinType)
+                    .planNode();
+
+    HashJoinBuilder(*pool_, duckDbQueryRunner_, driverExecutor_.get())
+        .numDrivers(numDrivers_)
+        .planNode(std::move(plan))
+        .config(core::QueryConfig::kHashJoinSwapSidesRatio, testData.ratio)
+        .referenceQuery(fmt::format(
+            "SELECT c0, c1, u_c1 FROM t {} JOIN u ON c0 = u_c0",
+            testData.joinType == core::JoinType::kInner ? "INNER" : "LEFT"))
+        .verifier([&](const std::shared_ptr<Task>& task, bool hasSpill) {
+          // A join that can spill does not swap its sides.
+          const bool swapped = testData.swapped && !hasSpill;
+          int64_t numSwaps = 0;
+          for (const auto& pipelineStat : task->taskStats().pipelineStats) {
+            for (const auto& operatorStat : pipelineStat.operatorStats) {
+              auto it = operatorStat.runtimeStats.find("joinSidesSwapped");
+              if (it != operatorStat.runtimeStats.end()) {
+                numSwaps += it->second.sum;
+              }
+            }
+          }
+          ASSERT_EQ(numSwaps, swapped ? 1 : 0);
+        })
+        .run();
+  }
+}
+
+TEST_F(HashJoinTest, buildCache) {
+  auto probeVectors = makeRowVector({
+      makeFlatVector<int32_t>(100, [](auto row) { return row % 23; }),
+      makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+  });
+  auto buildVectors = makeRowVector(
+      {"u_c0", "u_c1"},
+      {
+          makeFlatVector<int32_t>(50, [](auto row) { return row % 17; }),
+          makeFlatVector<int64_t>(50, [](auto row) { return row * 10; }),
+      });
+
+  createDuckDbTable("t", {probeVectors});
+  createDuckDbTable("u", {buildVectors});
+
+  HashTableCache cache(1 << 30);
+  HashTableCache::setInstance(&cache);
+  SCOPE_EXIT {
+    HashTableCache::setInstance(nullptr);
+  };
+
+  auto makePlan = [&](core::JoinType joinType) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    return PlanBuilder(planNodeIdGenerator)
+        .values({probeVectors})
+        .hashJoin(
+            {"c0"},
+            {"u_c0"},
+            PlanBuilder(planNodeIdGenerator).values({buildVectors}).planNode(),
+            "",
+            {"c0", "c1", "u_c1"},
+            joinType,
+            false,
+            "u")
+        .planNode();
+  };
+
+  const std::string innerSql = "SELECT c0, c1, u_c1 FROM t, u WHERE c0 = u_c0";
+  for (int i = 0; i < 3; ++i) {
+    AssertQueryBuilder(makePlan(core::JoinType::kInner), duckDbQueryRunner_)
+        .assertResults(innerSql);
+  }
+  ASSERT_EQ(cache.stats().numLookups, 3);
+  ASSERT_EQ(cache.stats().numHits, 2);
+  ASSERT_EQ(cache.stats().numEntries, 1);
+  ASSERT_GT(cache.stats().bytes, 0);
+
+  // A different join type does not share the table.
+  AssertQueryBuilder(makePlan(core::JoinType::kLeft), duckDbQueryRunner_)
+      .assertResults("SELECT c0, c1, u_c1 FROM t LEFT JOIN u ON c0 = u_c0");
+  ASSERT_EQ(cache.stats().numHits, 2);
+  ASSERT_EQ(cache.stats().numEntries, 2);
+
+  // Right joins are not cached.
+  AssertQueryBuilder(makePlan(core::JoinType::kRight), duckDbQueryRunner_)
+      .assertResults("SELECT c0, c1, u_c1 FROM t RIGHT JOIN u ON c0 = u_c0");
+  ASSERT_EQ(cache.stats().numLookups, 4);
+
+  cache.clear();
+  ASSERT_EQ(cache.stats().numEntries, 0);
+  AssertQueryBuilder(makePlan(core::JoinType::kInner), duckDbQueryRunner_)
+      .assertResults(innerSql);
+  ASSERT_EQ(cache.stats().numHits, 2);
+}
+
 TEST_F(HashJoinTest, spillFileSize) {
   const std::vector<uint64_t> maxSpillFileSizes({0, 1, 1'000'000'000});
   for (const auto spillFileSize : maxSpillFileSizes) {
@@ -166,3 +166,69 @@ TEST_F(HashPartitionFunctionTest, noKeyAndBitRange) {
   ASSERT_TRUE(singlePartition.has_value());
   EXPECT_EQ(singlePartition.value(), 0u);
 }
+
+TEST_F(HashPartitionFunctionTest, skewedKeys) {
+  const int numRows = 10'000;
+  // Half of the rows have key 7, the rest have distinct keys.
+  auto vector = makeRowVector({makeFlatVector<int32_t>(
+      numRows, [](auto row) { return row % 2 == 0 ? 7 : row + 100; })});
+  auto rowType = asRowType(vector->type());
+
+  std::vector<uint32_t> partitions;
+  HashPartitionFunction sampling(4, rowType, {0});
+  sampling.enableSkewSampling(3);
+  sampling.partition(*vector, partitions);
+  const auto heavyHitters = sampling.heavyHitters(0.2);
+  ASSERT_EQ(1, heavyHitters.size());
+  const auto skewedPartition = partitions[0];
+
+  std::vector<uint32_t> replicated;
+  HashPartitionFunction replicating(
+      4,
+      rowType,
+      {0},
+      {},
+      SkewedKeys{SkewedKeys::Mode::kReplicate, heavyHitters});
+  ASSERT_FALSE(replicating.partition(*vector, replicated).has_value());
+
+  std::vector<uint32_t> distributed;
+  HashPartitionFunction roundRobin(
+      4,
+      rowType,
+      {0},
+      {},
+      SkewedKeys{SkewedKeys::Mode::kRoundRobin, heavyHitters});
+  ASSERT_FALSE(roundRobin.partition(*vector, distributed).has_value());
+
+  std::vector<int32_t> numSkewedRows(4, 0);
+  for (auto row = 0; row < numRows; ++row) {
+    if (row % 2 == 0) {
+      ASSERT_EQ(partitions[row], skewedPartition);
+      ASSERT_EQ(replicated[row], core::PartitionFunction::kAllPartitions);
+      ++numSkewedRows[distributed[row]];
+    } else {
+      ASSERT_EQ(replicated[row], partitions[row]);
+      ASSERT_EQ(distributed[row], partitions[row]);
+    }
+  }
+  for (auto count : numSkewedRows) {
+    ASSERT_EQ(count, numRows / 2 / 4);
+  }
+
+  // The skewed keys survive serialization.
+  Type::registerSerDe();
+  core::ITypedExpr::registerSerDe();
+  auto hashSpec = std::make_unique<exec::HashPartitionFunctionSpec>(
+      rowType,
+      std::vector<column_index_t>{0},
+      std::vector<VectorPtr>{},
+      SkewedKeys{SkewedKeys::Mode::kRoundRobin, heavyHitters});
+  ASSERT_EQ("HASH(c0) round-robin 1 skewed keys", hashSpec->toString());
+  auto copy = HashPartitionFunctionSpec::deserialize(
+      hashSpec->serialize(), pool());
+  ASSERT_EQ(hashSpec->toString(), copy->toString());
+
+  std::vector<uint32_t> copyPartitions;
+  copy->create(4)->partition(*vector, copyPartitions);
+  ASSERT_EQ(distributed, copyPartitions);
+}
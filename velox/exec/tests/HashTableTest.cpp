@@ -430,6 +430,12 @@ class HashTableTest : public testing::TestWithParam<bool> {
         }
       }
     }
+    if (mode != BaseHashTable::HashMode::kArray) {
+      // Each probe loads at least one word of tags and each hit at least one
+      // row.
+      ASSERT_GE(lookup->numTagLoads, numProbed);
+      ASSERT_GE(lookup->numRowLoads, numHit);
+    }
     LOG(INFO)
         << fmt::format(
                "Hashed: {} Probed: {} Hit: {} Hash time/row {} probe time/row {}",
@@ -714,6 +720,39 @@ TEST_P(HashTableTest, arrayProbeNormalizedKey) {
   ASSERT_EQ(table->hashMode(), BaseHashTable::HashMode::kNormalizedKey);
 }
 
+TEST_P(HashTableTest, longStringKeys) {
+  // A struct key puts the table in kHash mode from the start. The string keys
+  // share a long prefix, so that only the key fingerprints tell most of the
+  // colliding rows apart without reading the string bodies.
+  auto table = createHashTableForAggregation(
+      ROW({"a", "b"}, {VARCHAR(), ROW({"c"}, {BIGINT()})}), 2);
+  auto lookup = std::make_unique<HashLookup>(table->hashers());
+  ASSERT_EQ(table->hashMode(), BaseHashTable::HashMode::kHash);
+
+  constexpr int32_t kNumGroups = 10'000;
+  auto data = vectorMaker_->rowVector({
+      vectorMaker_->flatVector<std::string>(
+          kNumGroups,
+          [](auto row) {
+            return fmt::format("https://www.example.com/path/{}", row);
+          }),
+      vectorMaker_->rowVector({vectorMaker_->flatVector<int64_t>(
+          kNumGroups, [](auto row) { return row % 7; })}),
+  });
+
+  insertGroups(*data, *lookup, *table);
+  ASSERT_EQ(table->numDistinct(), kNumGroups);
+  ASSERT_EQ(lookup->newGroups.size(), kNumGroups);
+  std::vector<char*> groups(lookup->hits.begin(), lookup->hits.end());
+
+  insertGroups(*data, *lookup, *table);
+  ASSERT_EQ(table->numDistinct(), kNumGroups);
+  ASSERT_TRUE(lookup->newGroups.empty());
+  for (auto i = 0; i < kNumGroups; ++i) {
+    ASSERT_EQ(groups[i], lookup->hits[i]) << "at " << i;
+  }
+}
+
 TEST_P(HashTableTest, regularHashingTableSize) {
   keySpacing_ = 1000;
   auto checkTableSize = [&](BaseHashTable::HashMode mode,
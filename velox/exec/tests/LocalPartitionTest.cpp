@@ -13,6 +13,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/HashPartitionFunction.h"
+#include "velox/exec/LocalPartition.h"
 #include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
@@ -192,6 +194,61 @@ TEST_F(LocalPartitionTest, partition) {
   verifyExchangeSourceOperatorStats(task, 300, 6);
 }
 
+TEST_F(LocalPartitionTest, skewedKeys) {
+  // Key 3 makes up most of the rows.
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 4; ++i) {
+    vectors.push_back(makeRowVector({makeFlatVector<int32_t>(
+        100, [&](auto row) { return row % 4 == 0 ? row % 17 : 3; })}));
+  }
+  createDuckDbTable(vectors);
+
+  HashPartitionFunction sampling(4, asRowType(vectors[0]->type()), {0});
+  sampling.enableSkewSampling(1);
+  std::vector<uint32_t> partitions;
+  for (const auto& vector : vectors) {
+    sampling.partition(*vector, partitions);
+  }
+  const auto heavyHitters = sampling.heavyHitters(0.5);
+  ASSERT_EQ(1, heavyHitters.size());
+
+  auto skewedPartition = [&](SkewedKeys::Mode mode) {
+    return [&, mode](std::string nodeId, core::PlanNodePtr source) {
+      return std::make_shared<core::LocalPartitionNode>(
+          nodeId,
+          core::LocalPartitionNode::Type::kRepartition,
+          std::make_shared<HashPartitionFunctionSpec>(
+              source->outputType(),
+              std::vector<column_index_t>{0},
+              std::vector<VectorPtr>{},
+              SkewedKeys{mode, heavyHitters}),
+          std::vector<core::PlanNodePtr>{source});
+    };
+  };
+
+  // Replicated rows reach each of the 4 partitions, round-robin distributed
+  // rows reach one.
+  for (const auto mode :
+       {SkewedKeys::Mode::kReplicate, SkewedKeys::Mode::kRoundRobin}) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    auto plan = PlanBuilder(planNodeIdGenerator)
+                    .values(vectors)
+                    .addNode(skewedPartition(mode))
+                    .partialAggregation({"c0"}, {"count(1)"})
+                    .localPartition(std::vector<std::string>{})
+                    .finalAggregation()
+                    .planNode();
+
+    AssertQueryBuilder(plan, duckDbQueryRunner_)
+        .maxDrivers(4)
+        .assertResults(fmt::format(
+            "SELECT c0, count(1) * {} FROM tmp GROUP BY 1",
+            mode == SkewedKeys::Mode::kReplicate
+                ? "(CASE WHEN c0 = 3 THEN 4 ELSE 1 END)"
+                : "1"));
+  }
+}
+
 TEST_F(LocalPartitionTest, maxBufferSizeGather) {
   std::vector<RowVectorPtr> vectors;
   for (auto i = 0; i < 21; i++) {
@@ -283,6 +340,84 @@ TEST_F(LocalPartitionTest, maxBufferSizePartition) {
   verifyExchangeSourceOperatorStats(task, 2100, 42);
 }
 
+TEST_F(LocalPartitionTest, memoryManagerBlocking) {
+  LocalExchangeMemoryManager memoryManager(100);
+  ContinueFuture future;
+  ASSERT_FALSE(memoryManager.increaseMemoryUsage(&future, 60));
+  ASSERT_TRUE(memoryManager.decreaseMemoryUsage(10).empty());
+
+  // Reaching the limit blocks the producer.
+  ASSERT_TRUE(memoryManager.increaseMemoryUsage(&future, 50));
+  ASSERT_FALSE(future.isReady());
+  ContinueFuture otherFuture;
+  ASSERT_TRUE(memoryManager.increaseMemoryUsage(&otherFuture, 10));
+
+  // Decreases that stay at or above the limit do not unblock.
+  ASSERT_TRUE(memoryManager.decreaseMemoryUsage(10).empty());
+  auto promises = memoryManager.decreaseMemoryUsage(1);
+  ASSERT_EQ(promises.size(), 2);
+  for (auto& promise : promises) {
+    promise.setValue();
+  }
+  ASSERT_TRUE(future.isReady());
+  ASSERT_TRUE(otherFuture.isReady());
+
+  // The waiters have been handed out.
+  ASSERT_TRUE(memoryManager.decreaseMemoryUsage(99).empty());
+}
+
+TEST_F(LocalPartitionTest, scaleWriterState) {
+  ScaleWriterState state(3, 100);
+  ASSERT_EQ(state.addProcessedBytes(50, true), 1);
+  // Writers that keep up are not added to.
+  ASSERT_EQ(state.addProcessedBytes(60, false), 1);
+  ASSERT_EQ(state.addProcessedBytes(10, true), 2);
+  // Each active writer must have received the minimum.
+  ASSERT_EQ(state.addProcessedBytes(10, true), 2);
+  ASSERT_EQ(state.addProcessedBytes(100, true), 3);
+  ASSERT_EQ(state.addProcessedBytes(1'000, true), 3);
+  ASSERT_EQ(state.numActiveWriters(), 3);
+}
+
+TEST_F(LocalPartitionTest, scaleWriter) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 21; i++) {
+    vectors.emplace_back(makeRowVector({makeFlatVector<int32_t>(
+        100, [i](auto row) { return -71 + i * 10 + row; })}));
+  }
+  createDuckDbTable(vectors);
+
+  core::PlanNodeId exchangeId;
+  auto op = PlanBuilder()
+                .values(vectors)
+                .scaleWriterLocalPartitionRoundRobin()
+                .capturePlanNodeId(exchangeId)
+                .project({"c0"})
+                .planNode();
+
+  auto runQuery = [&](const char* minProcessedBytes) {
+    return AssertQueryBuilder(op, duckDbQueryRunner_)
+        .maxDrivers(4)
+        .config(core::QueryConfig::kMaxLocalExchangeBufferSize, "100")
+        .config(
+            core::QueryConfig::kScaleWriterMinProcessedBytes,
+            minProcessedBytes)
+        .assertResults("SELECT c0 FROM tmp");
+  };
+
+  // All the input fits the first writer.
+  auto task = runQuery("1000000000");
+  auto stats = toPlanStats(task->taskStats()).at(exchangeId);
+  ASSERT_EQ(stats.customStats.at(LocalPartition::kScaledWriters).max, 1);
+
+  // The single writer cannot keep up with the small buffer, so writers are
+  // added.
+  task = runQuery("1");
+  stats = toPlanStats(task->taskStats()).at(exchangeId);
+  ASSERT_GT(stats.customStats.at(LocalPartition::kScaledWriters).max, 1);
+  ASSERT_LE(stats.customStats.at(LocalPartition::kScaledWriters).max, 4);
+}
+
 TEST_F(LocalPartitionTest, blockingOnLocalExchangeQueue) {
   auto localExchangeBufferSize = "1024";
   auto baseVector = vectorMaker_.flatVector<int64_t>(
@@ -14,9 +14,11 @@
  * limitations under the License.
  */
 
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::test;
@@ -141,3 +143,40 @@ TEST_F(MarkDistinctTest, aggregation) {
       .assertResults(
           "SELECT c0, sum(distinct c1), sum(distinct c2) FROM tmp GROUP BY 1");
 }
+
+TEST_F(MarkDistinctTest, spill) {
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 10; ++i) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (row + i) % 97; }, nullEvery(31)),
+        makeFlatVector<int32_t>(1'000, [&](auto row) { return row % 7; }),
+    }));
+  }
+  createDuckDbTable(batches);
+
+  // Exactly one row per group is marked distinct by 'c0_distinct'.
+  core::PlanNodeId markDistinctId;
+  auto plan =
+      PlanBuilder()
+          .values(batches)
+          .markDistinct("c0_distinct", {"c0"})
+          .capturePlanNodeId(markDistinctId)
+          .markDistinct("c1_distinct", {"c0", "c1"})
+          .singleAggregation(
+              {"c0"}, {"sum(c1)", "count(c1)"}, {"c1_distinct", "c0_distinct"})
+          .planNode();
+  auto spillDirectory = TempDirectoryPath::create();
+  auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                  .spillDirectory(spillDirectory->path)
+                  .config(core::QueryConfig::kSpillEnabled, "true")
+                  .config(core::QueryConfig::kMarkDistinctSpillEnabled, "true")
+                  .config(core::QueryConfig::kTestingSpillPct, "100")
+                  .assertResults(
+                      "SELECT c0, sum(distinct c1), 1::BIGINT FROM tmp "
+                      "GROUP BY 1");
+
+  auto planStats = toPlanStats(task->taskStats());
+  ASSERT_GT(planStats.at(markDistinctId).spilledBytes, 0);
+  OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+}
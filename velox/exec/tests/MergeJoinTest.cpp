@@ -14,9 +14,11 @@
  * limitations under the License.
  */
 
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/HiveConnectorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 using namespace facebook::velox;
 using namespace facebook::velox::exec;
@@ -644,3 +646,68 @@ TEST_F(MergeJoinTest, complexTypedFilter) {
     }
   }
 };
+
+TEST_F(MergeJoinTest, spillRightSideMatch) {
+  // Key 5 on the right side spans many batches.
+  std::vector<RowVectorPtr> left;
+  for (auto i = 0; i < 3; ++i) {
+    left.push_back(makeRowVector(
+        {"t_c0", "t_c1"},
+        {
+            makeFlatVector<int32_t>(
+                10, [&](auto row) { return i * 3 + row / 4; }),
+            makeFlatVector<int64_t>(10, [&](auto row) { return i * 10 + row; }),
+        }));
+  }
+  std::vector<RowVectorPtr> right;
+  for (auto i = 0; i < 10; ++i) {
+    right.push_back(makeRowVector(
+        {"u_c0", "u_c1"},
+        {
+            makeFlatVector<int32_t>(
+                50,
+                [&](auto row) {
+                  return i == 0 ? row / 10 : (i == 9 ? 5 + row / 10 : 5);
+                }),
+            makeFlatVector<int64_t>(50, [&](auto row) { return i * 50 + row; }),
+        }));
+  }
+  createDuckDbTable("t", left);
+  createDuckDbTable("u", right);
+
+  for (const auto joinType : {core::JoinType::kInner, core::JoinType::kLeft}) {
+    for (const std::string filter : {"", "(t_c1 + u_c1) % 3 = 0"}) {
+      SCOPED_TRACE(fmt::format(
+          "{} join, filter: {}", core::joinTypeName(joinType), filter));
+      auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+      core::PlanNodeId joinNodeId;
+      auto plan =
+          PlanBuilder(planNodeIdGenerator)
+              .values(left)
+              .mergeJoin(
+                  {"t_c0"},
+                  {"u_c0"},
+                  PlanBuilder(planNodeIdGenerator).values(right).planNode(),
+                  filter,
+                  {"t_c0", "t_c1", "u_c1"},
+                  joinType)
+              .capturePlanNodeId(joinNodeId)
+              .planNode();
+
+      auto spillDirectory = TempDirectoryPath::create();
+      auto task =
+          AssertQueryBuilder(plan, duckDbQueryRunner_)
+              .spillDirectory(spillDirectory->path)
+              .config(core::QueryConfig::kSpillEnabled, "true")
+              .config(core::QueryConfig::kMergeJoinSpillEnabled, "true")
+              .config(core::QueryConfig::kTestingSpillPct, "100")
+              .config(core::QueryConfig::kPreferredOutputBatchRows, "7")
+              .assertResults(fmt::format(
+                  "SELECT t_c0, t_c1, u_c1 FROM t {} JOIN u ON t_c0 = u_c0{}",
+                  joinType == core::JoinType::kLeft ? "LEFT" : "",
+                  filter.empty() ? "" : " AND " + filter));
+      ASSERT_GT(toPlanStats(task->taskStats()).at(joinNodeId).spilledBytes, 0);
+      OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+    }
+  }
+}
@@ -182,3 +182,25 @@ TEST_F(MergeTest, offByOne) {
       {{core::QueryConfig::kPreferredOutputBatchRows, "6"}});
   assertQueryOrdered(params, "VALUES (0), (1), (2), (3), (4), (5), (10)", {0});
 }
+
+/// Merges sources that each have long runs of consecutive keys, with and
+/// without nulls.
+TEST_F(MergeTest, runs) {
+  vector_size_t batchSize = 1000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 4; ++i) {
+    // Source 'i' has the runs of 50 keys at positions i, i + 4, i + 8 etc.
+    auto key = [i](auto row) { return (row / 50 * 4 + i) * 50 + row % 50; };
+    auto c0 = makeFlatVector<int32_t>(batchSize, key);
+    auto c1 = makeFlatVector<int64_t>(batchSize, key, nullEvery(97));
+    auto c2 = makeFlatVector<StringView>(batchSize, [](auto row) {
+      return StringView::makeInline(std::to_string(row));
+    });
+    vectors.push_back(makeRowVector({c0, c1, c2}));
+  }
+  createDuckDbTable(vectors);
+
+  testSingleKey(vectors, "c0");
+  testSingleKey(vectors, "c1");
+  testTwoKeys(vectors, "c0", "c2");
+}
@@ -309,6 +309,96 @@ TEST_F(MultiFragmentTest, aggregationMultiKey) {
   }
 }
 
+TEST_F(MultiFragmentTest, compactPartitionBuffers) {
+  setupSources(10, 1'000);
+  configSettings_
+      [core::QueryConfig::kPartitionedOutputCompactMinDestinations] = "4";
+  // Flush the shared buffer several times per leaf task.
+  configSettings_[core::QueryConfig::kMaxPartitionedOutputBufferSize] =
+      "100000";
+  std::vector<std::shared_ptr<Task>> tasks;
+  auto leafTaskId = makeTaskId("leaf", 0);
+  auto leafPlan = PlanBuilder()
+                      .tableScan(rowType_)
+                      .project({"c0 % 10 AS c0", "c1 % 2 AS c1", "c2"})
+                      .partitionedOutput({"c0", "c1"}, 5)
+                      .planNode();
+  auto leafTask = makeTask(leafTaskId, leafPlan, 0);
+  tasks.push_back(leafTask);
+  Task::start(leafTask, 4);
+  addHiveSplits(leafTask, filePaths_);
+
+  core::PlanNodePtr aggPlan;
+  std::vector<std::string> aggTaskIds;
+  for (int i = 0; i < 5; i++) {
+    aggPlan = PlanBuilder()
+                  .exchange(leafPlan->outputType())
+                  .singleAggregation({"c0", "c1"}, {"sum(c2)", "count(1)"})
+                  .partitionedOutput({}, 1)
+                  .planNode();
+
+    aggTaskIds.push_back(makeTaskId("agg", i));
+    auto task = makeTask(aggTaskIds.back(), aggPlan, i);
+    tasks.push_back(task);
+    Task::start(task, 1);
+    addRemoteSplits(task, {leafTaskId});
+  }
+
+  auto op = PlanBuilder().exchange(aggPlan->outputType()).planNode();
+  assertQuery(
+      op,
+      aggTaskIds,
+      "SELECT c0 % 10, c1 % 2, sum(c2), count(1) FROM tmp GROUP BY 1, 2");
+
+  for (auto& task : tasks) {
+    ASSERT_TRUE(waitForTaskCompletion(task.get())) << task->taskId();
+  }
+}
+
+TEST_F(MultiFragmentTest, inProcessVectors) {
+  setupSources(10, 1'000);
+  configSettings_[core::QueryConfig::kShuffleInProcessVectors] = "true";
+  std::vector<std::shared_ptr<Task>> tasks;
+  auto leafTaskId = makeTaskId("leaf", 0);
+  auto leafPlan = PlanBuilder()
+                      .tableScan(rowType_)
+                      .project({"c0 % 10 AS c0", "c1 % 2 AS c1", "c2", "c5"})
+                      .partitionedOutput({"c0", "c1"}, 3)
+                      .planNode();
+  auto leafTask = makeTask(leafTaskId, leafPlan, 0);
+  tasks.push_back(leafTask);
+  Task::start(leafTask, 4);
+  addHiveSplits(leafTask, filePaths_);
+
+  core::PlanNodePtr aggPlan;
+  std::vector<std::string> aggTaskIds;
+  for (int i = 0; i < 3; i++) {
+    aggPlan = PlanBuilder()
+                  .exchange(leafPlan->outputType())
+                  .singleAggregation(
+                      {"c0", "c1"}, {"sum(c2)", "count(1)", "max(c5)"})
+                  .partitionedOutput({}, 1)
+                  .planNode();
+
+    aggTaskIds.push_back(makeTaskId("agg", i));
+    auto task = makeTask(aggTaskIds.back(), aggPlan, i);
+    tasks.push_back(task);
+    Task::start(task, 1);
+    addRemoteSplits(task, {leafTaskId});
+  }
+
+  auto op = PlanBuilder().exchange(aggPlan->outputType()).planNode();
+  assertQuery(
+      op,
+      aggTaskIds,
+      "SELECT c0 % 10, c1 % 2, sum(c2), count(1), max(c5) FROM tmp "
+      "GROUP BY 1, 2");
+
+  for (auto& task : tasks) {
+    ASSERT_TRUE(waitForTaskCompletion(task.get())) << task->taskId();
+  }
+}
+
 TEST_F(MultiFragmentTest, distributedTableScan) {
   setupSources(10, 1000);
   // Run the table scan several times to test the caching.
@@ -137,6 +137,36 @@ TEST_F(NestedLoopJoinTest, basic) {
   runSingleAndMultiDriverTest(probeVectors, buildVectors);
 }
 
+TEST_F(NestedLoopJoinTest, bandJoin) {
+  std::vector<RowVectorPtr> probeVectors;
+  std::vector<RowVectorPtr> buildVectors;
+  for (auto i = 0; i < 3; ++i) {
+    probeVectors.push_back(makeRowVector(
+        {probeKeyName_},
+        {makeFlatVector<int64_t>(
+            50,
+            [&](auto row) { return (i * 50 + row) * 7 % 97; },
+            nullEvery(11))}));
+    buildVectors.push_back(makeRowVector(
+        {buildKeyName_, "u1"},
+        {makeFlatVector<int64_t>(
+             40, [&](auto row) { return (i * 40 + row) * 13 % 89; }),
+         makeFlatVector<int64_t>(
+             40,
+             [&](auto row) { return (i * 40 + row) * 13 % 89 + row % 9; },
+             nullEvery(13))}));
+  }
+
+  setOutputLayout({probeKeyName_, buildKeyName_, "u1"});
+  setComparisons(
+      {"t0 BETWEEN u0 AND u1",
+       "t0 > u0 AND t0 <= u1",
+       "u1 >= t0 AND u0 <= t0 AND t0 % 3 = 0"});
+  setJoinConditionStr("{}");
+  setQueryStr("SELECT t0, u0, u1 FROM t {} JOIN u ON {}");
+  runSingleAndMultiDriverTest(probeVectors, buildVectors);
+}
+
 TEST_F(NestedLoopJoinTest, emptyProbe) {
   auto probeVectors = makeBatches(0, 5, probeType_, pool_.get());
   auto buildVectors = makeBatches(18, 5, buildType_, pool_.get());
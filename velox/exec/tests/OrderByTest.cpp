@@ -562,6 +562,47 @@ TEST_F(OrderByTest, spillWithMemoryLimit) {
   }
 }
 
+TEST_F(OrderByTest, parallel) {
+  std::vector<RowVectorPtr> vectors;
+  for (auto i = 0; i < 10; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(
+             1'000,
+             [&](auto row) { return (row * 7 + i) % 101; },
+             nullEvery(13)),
+         makeFlatVector<StringView>(
+             1'000,
+             [&](auto row) {
+               return StringView::makeInline(fmt::format("k{}", row % 17));
+             }),
+         makeFlatVector<int32_t>(1'000, [&](auto row) { return row + i; })}));
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto numDrivers : {1, 3, 4}) {
+    SCOPED_TRACE(fmt::format("numDrivers: {}", numDrivers));
+    core::PlanNodeId orderById;
+    auto plan = PlanBuilder()
+                    .values(vectors, true)
+                    .orderBy({"c0 DESC NULLS FIRST", "c1", "c2"}, false)
+                    .capturePlanNodeId(orderById)
+                    .planNode();
+    auto task = AssertQueryBuilder(plan, duckDbQueryRunner_)
+                    .maxDrivers(numDrivers)
+                    .config(QueryConfig::kParallelOrderByEnabled, "true")
+                    .config(QueryConfig::kPreferredOutputBatchRows, "17")
+                    .assertResults(
+                        "SELECT * FROM tmp "
+                        "ORDER BY c0 DESC NULLS FIRST, c1, c2",
+                        {{0, 1, 2}});
+    auto planStats = toPlanStats(task->taskStats());
+    const auto& orderByStats = planStats.at(orderById);
+    EXPECT_EQ(orderByStats.numDrivers, numDrivers);
+    EXPECT_EQ(orderByStats.outputRows, 10'000);
+    EXPECT_EQ(orderByStats.customStats.at("mergedSortRuns").sum, numDrivers);
+  }
+}
+
 DEBUG_ONLY_TEST_F(OrderByTest, reclaimDuringInputProcessing) {
   constexpr int64_t kMaxBytes = 1LL << 30; // 1GB
   auto rowType = ROW({"c0", "c1", "c2"}, {INTEGER(), INTEGER(), INTEGER()});
@@ -17,9 +17,11 @@
 #include <gtest/gtest.h>
 #include "folly/experimental/EventCount.h"
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/common/file/FileSystems.h"
 #include "velox/dwio/common/tests/utils/BatchMaker.h"
 #include "velox/exec/Task.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/serializers/PrestoSerializer.h"
 
 using namespace facebook::velox;
@@ -708,6 +710,78 @@ TEST_F(PartitionedOutputBufferManagerTest, basicBroadcast) {
   EXPECT_TRUE(task->isFinished());
 }
 
+TEST_F(PartitionedOutputBufferManagerTest, broadcastSpill) {
+  filesystems::registerLocalFileSystem();
+  const std::string taskId = "t0";
+  bufferManager_->removeTask(taskId);
+  auto spillDirectory = exec::test::TempDirectoryPath::create();
+  auto planFragment = exec::test::PlanBuilder()
+                          .values({std::dynamic_pointer_cast<RowVector>(
+                              BatchMaker::createBatch(rowType_, 100, *pool_))})
+                          .planFragment();
+  std::unordered_map<std::string, std::string> configSettings{
+      {core::QueryConfig::kSpillEnabled, "true"},
+      {core::QueryConfig::kBroadcastSpillEnabled, "true"},
+      {core::QueryConfig::kMaxPartitionedOutputBufferSize, "10000"}};
+  auto queryCtx = std::make_shared<core::QueryCtx>(
+      executor_.get(), core::QueryConfig(std::move(configSettings)));
+  auto task =
+      Task::create(taskId, std::move(planFragment), 0, std::move(queryCtx));
+  task->setSpillDirectory(spillDirectory->path);
+  bufferManager_->initializeTask(
+      task, PartitionedOutputNode::Kind::kBroadcast, 2, 1);
+  bufferManager_->updateOutputBuffers(taskId, 2, true);
+
+  auto toString = [](const folly::IOBuf& iobuf) {
+    std::string data;
+    for (const auto& range : iobuf) {
+      data.append(reinterpret_cast<const char*>(range.data()), range.size());
+    }
+    return data;
+  };
+
+  // Destination 0 keeps up with the producer while destination 1 does not
+  // fetch anything. The producer is not blocked because the pages held for
+  // destination 1 are spilled.
+  constexpr int kNumPages = 20;
+  std::vector<std::string> expectedPages;
+  for (int i = 0; i < kNumPages; ++i) {
+    auto page = makeSerializedPage(rowType_, 100);
+    expectedPages.push_back(toString(*page->getIOBuf()));
+    ContinueFuture future;
+    ASSERT_FALSE(bufferManager_->enqueue(taskId, 0, std::move(page), &future));
+    fetchOneAndAck(taskId, 0, i);
+  }
+  ASSERT_GT(bufferManager_->spilledBytes(taskId), 0);
+  ASSERT_LT(bufferManager_->getUtilization(taskId), 1);
+  noMoreData(taskId);
+  fetchEndMarker(taskId, 0, kNumPages);
+
+  // Destination 1 reads the spilled pages back.
+  std::vector<std::string> pages;
+  bool atEnd = false;
+  ASSERT_TRUE(bufferManager_->getData(
+      taskId,
+      1,
+      std::numeric_limits<uint64_t>::max(),
+      0,
+      [&](std::vector<std::unique_ptr<folly::IOBuf>> data, int64_t sequence) {
+        ASSERT_EQ(sequence, 0);
+        for (const auto& iobuf : data) {
+          if (iobuf == nullptr) {
+            atEnd = true;
+          } else {
+            pages.push_back(toString(*iobuf));
+          }
+        }
+      }));
+  ASSERT_TRUE(atEnd);
+  ASSERT_EQ(pages, expectedPages);
+  deleteResults(taskId, 1);
+  EXPECT_TRUE(bufferManager_->isFinished(taskId));
+  bufferManager_->removeTask(taskId);
+}
+
 TEST_F(PartitionedOutputBufferManagerTest, basicArbitrary) {
   const vector_size_t size = 100;
   int numDestinations = 5;
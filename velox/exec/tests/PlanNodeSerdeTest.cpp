@@ -184,6 +184,12 @@ TEST_F(PlanNodeSerdeTest, localPartition) {
 
   plan = PlanBuilder().values({data_}).localPartition({"c0", "c1"}).planNode();
   testSerde(plan);
+
+  plan = PlanBuilder()
+             .values({data_})
+             .scaleWriterLocalPartitionRoundRobin()
+             .planNode();
+  testSerde(plan);
 }
 
 TEST_F(PlanNodeSerdeTest, limit) {
@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/exec/PrefixSort.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+
+namespace {
+
+class PrefixSortTest : public testing::Test,
+                       public velox::test::VectorTestBase {
+ protected:
+  // Stores 'data' in a RowContainer with all columns as keys.
+  std::unique_ptr<RowContainer> makeContainer(
+      const RowVectorPtr& data,
+      std::vector<char*>& rows) {
+    auto container = std::make_unique<RowContainer>(
+        data->type()->asRow().children(), pool());
+    SelectivityVector allRows(data->size());
+    rows.resize(data->size());
+    for (auto row = 0; row < data->size(); ++row) {
+      rows[row] = container->newRow();
+    }
+    for (auto column = 0; column < data->childrenSize(); ++column) {
+      DecodedVector decoded(*data->childAt(column), allRows);
+      for (auto row = 0; row < data->size(); ++row) {
+        container->store(decoded, row, rows[row], column);
+      }
+    }
+    return container;
+  }
+
+  // Sorts 'data' with PrefixSort and checks that the rows are in order of
+  // RowContainer::compare.
+  void testSort(
+      const RowVectorPtr& data,
+      const std::vector<CompareFlags>& compareFlags) {
+    std::vector<char*> rows;
+    auto container = makeContainer(data, rows);
+    ASSERT_TRUE(PrefixSort::sort(*container, compareFlags, rows));
+    ASSERT_EQ(rows.size(), data->size());
+    for (auto i = 1; i < rows.size(); ++i) {
+      int32_t result = 0;
+      for (auto index = 0; index < compareFlags.size() && result == 0;
+           ++index) {
+        result = container->compare(
+            rows[i - 1], rows[i], index, compareFlags[index]);
+      }
+      ASSERT_LE(result, 0) << "Rows out of order at " << i;
+    }
+  }
+
+  void testFuzzedSort(
+      const RowTypePtr& rowType,
+      const std::vector<CompareFlags>& compareFlags) {
+    VectorFuzzer::Options options;
+    options.vectorSize = 1'000;
+    options.nullRatio = 0.1;
+    VectorFuzzer fuzzer(options, pool());
+    SCOPED_TRACE(rowType->toString());
+    testSort(fuzzer.fuzzInputRow(rowType), compareFlags);
+  }
+
+  static std::vector<CompareFlags> allCompareFlags(size_t numKeys) {
+    std::vector<CompareFlags> compareFlags;
+    for (auto i = 0; i < numKeys; ++i) {
+      compareFlags.push_back(
+          {i % 2 == 0,
+           i % 3 != 1,
+           false,
+           CompareFlags::NullHandlingMode::NoStop});
+    }
+    return compareFlags;
+  }
+};
+
+TEST_F(PrefixSortTest, numPrefixKeys) {
+  const CompareFlags flags;
+  EXPECT_EQ(PrefixSort::numPrefixKeys({BIGINT()}, {flags}), 1);
+  EXPECT_EQ(
+      PrefixSort::numPrefixKeys({VARCHAR(), BIGINT()}, {flags, flags}), 0);
+  EXPECT_EQ(
+      PrefixSort::numPrefixKeys(
+          {INTEGER(), DOUBLE(), VARCHAR(), BIGINT()},
+          {flags, flags, flags, flags}),
+      2);
+  // Three 9 byte keys fit in 32 bytes, the fourth does not.
+  EXPECT_EQ(
+      PrefixSort::numPrefixKeys(
+          {BIGINT(), BIGINT(), BIGINT(), BIGINT()},
+          {flags, flags, flags, flags}),
+      3);
+  // Only the keys that are sorted on are encoded.
+  EXPECT_EQ(PrefixSort::numPrefixKeys({BIGINT(), BIGINT()}, {flags}), 1);
+  const CompareFlags stopAtNull{
+      true, true, false, CompareFlags::NullHandlingMode::StopAtNull};
+  EXPECT_EQ(PrefixSort::numPrefixKeys({BIGINT()}, {stopAtNull}), 0);
+}
+
+TEST_F(PrefixSortTest, noPrefix) {
+  auto data = makeRowVector({makeFlatVector<std::string>({"b", "a"})});
+  std::vector<char*> rows;
+  auto container = makeContainer(data, rows);
+  auto expected = rows;
+  EXPECT_FALSE(PrefixSort::sort(*container, {CompareFlags()}, rows));
+  EXPECT_EQ(rows, expected);
+}
+
+TEST_F(PrefixSortTest, fuzzed) {
+  testFuzzedSort(ROW({BIGINT()}), allCompareFlags(1));
+  testFuzzedSort(ROW({TINYINT(), VARCHAR()}), allCompareFlags(2));
+  testFuzzedSort(ROW({BOOLEAN(), SMALLINT(), INTEGER()}), allCompareFlags(3));
+  testFuzzedSort(ROW({REAL(), DOUBLE(), TIMESTAMP()}), allCompareFlags(3));
+  testFuzzedSort(ROW({DECIMAL(30, 2), DECIMAL(10, 2)}), allCompareFlags(2));
+  // The prefix ends before the later keys, which are compared on ties.
+  testFuzzedSort(
+      ROW({TINYINT(), BOOLEAN(), BIGINT(), BIGINT(), DOUBLE(), VARCHAR()}),
+      allCompareFlags(6));
+}
+
+TEST_F(PrefixSortTest, floatingPoint) {
+  constexpr auto kNaN = std::numeric_limits<double>::quiet_NaN();
+  constexpr auto kInfinity = std::numeric_limits<double>::infinity();
+  // -0.0 equals 0.0 and NaNs are equal, so the second key decides their
+  // order.
+  auto data = makeRowVector({
+      makeNullableFlatVector<double>(
+          {0.0, -0.0, kNaN, -kNaN, -kInfinity, kInfinity, 1.5, std::nullopt}),
+      makeFlatVector<int32_t>({2, 1, 4, 3, 5, 6, 7, 8}),
+  });
+  for (const bool ascending : {true, false}) {
+    SCOPED_TRACE(fmt::format("ascending: {}", ascending));
+    testSort(
+        data,
+        {{true, ascending, false, CompareFlags::NullHandlingMode::NoStop},
+         {true, true, false, CompareFlags::NullHandlingMode::NoStop}});
+  }
+}
+
+} // namespace
@@ -587,7 +587,11 @@ TEST_F(RowContainerTest, types) {
       }
       EXPECT_TRUE(source->equalValueAt(extracted.get(), i, i));
       EXPECT_EQ(source->compare(extracted.get(), i, i), 0);
-      EXPECT_EQ(source->hashValueAt(i), hashes[i]);
+      if (columnType->isPrimitiveType()) {
+        // Complex type values are hashed by their ByteComparableSerde
+        // serialization.
+        EXPECT_EQ(source->hashValueAt(i), hashes[i]);
+      }
       // Test non-null and nullable variants of equals.
       if (column < keys.size()) {
         EXPECT_TRUE(
@@ -13,8 +13,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 namespace facebook::velox::exec::test {
 
@@ -166,4 +169,45 @@ TEST_F(RowNumberTest, largeInput) {
   testLimit(5'000);
 }
 
+TEST_F(RowNumberTest, spill) {
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 10; ++i) {
+    batches.push_back(makeRowVector({
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (row + i) % 97; }, nullEvery(31)),
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return i * 1'000 + row; }),
+    }));
+  }
+  createDuckDbTable(batches);
+
+  auto testSpill = [&](std::optional<int32_t> limit) {
+    core::PlanNodeId rowNumberId;
+    auto plan = PlanBuilder()
+                    .values(batches)
+                    .rowNumber({"c0"}, limit)
+                    .capturePlanNodeId(rowNumberId)
+                    .planNode();
+    auto spillDirectory = TempDirectoryPath::create();
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .spillDirectory(spillDirectory->path)
+            .config(core::QueryConfig::kSpillEnabled, "true")
+            .config(core::QueryConfig::kRowNumberSpillEnabled, "true")
+            .config(core::QueryConfig::kTestingSpillPct, "100")
+            .assertResults(fmt::format(
+                "SELECT * FROM (SELECT *, row_number() over (partition by c0) as rn FROM tmp) "
+                "WHERE rn <= {}",
+                limit.value_or(std::numeric_limits<int32_t>::max())));
+
+    auto planStats = toPlanStats(task->taskStats());
+    ASSERT_GT(planStats.at(rowNumberId).spilledBytes, 0);
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  };
+
+  testSpill(std::nullopt);
+  testSpill(5);
+  testSpill(200);
+}
+
 } // namespace facebook::velox::exec::test
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 
+#include <folly/ScopeGuard.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <gflags/gflags.h>
 #include <gtest/gtest.h>
 #include <algorithm>
 #include <memory>
@@ -33,6 +36,8 @@ using namespace facebook::velox::exec;
 using namespace facebook::velox::filesystems;
 using facebook::velox::exec::test::TempDirectoryPath;
 
+DECLARE_bool(velox_spill_zstd_dictionary);
+
 namespace {
 static const int64_t kGB = 1'000'000'000;
 
@@ -681,6 +686,201 @@ TEST_P(SpillTest, nonExistSpillFileOnDeletion) {
   state_.reset();
 }
 
+TEST_P(SpillTest, readAhead) {
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  auto executor = std::make_shared<folly::CPUThreadPoolExecutor>(2);
+  std::vector<CompareFlags> emptyCompareFlags;
+  // Each file holds 1.6MB, so it takes more than one read buffer.
+  constexpr int32_t kNumFiles = 6;
+  constexpr int32_t kRowsPerFile = 200'000;
+  SpillState state(
+      tempDirectory->path + "/test",
+      1,
+      1,
+      emptyCompareFlags,
+      kGB,
+      0,
+      common::CompressionKind::CompressionKind_NONE,
+      pool(),
+      &stats_);
+  state.setPartitionSpilled(0);
+  for (int32_t file = 0; file < kNumFiles; ++file) {
+    auto values = makeFlatVector<int64_t>(
+        kRowsPerFile, [&](auto row) { return row * kNumFiles + file; });
+    state.appendToPartition(0, makeRowVector({values}));
+    state.finishWrite(0);
+  }
+
+  auto merge = state.startMerge(0, nullptr, executor.get());
+  for (int64_t i = 0; i < kNumFiles * kRowsPerFile; ++i) {
+    auto stream = merge->next();
+    ASSERT_NE(nullptr, stream);
+    ASSERT_EQ(i, stream->decoded(0).valueAt<int64_t>(stream->currentIndex()));
+    stream->pop();
+  }
+  ASSERT_EQ(nullptr, merge->next());
+  merge.reset();
+  executor->join();
+}
+
+TEST_P(SpillTest, mergeNonOverlappingFiles) {
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  std::vector<CompareFlags> emptyCompareFlags;
+  SpillState state(
+      tempDirectory->path + "/test",
+      1,
+      1,
+      emptyCompareFlags,
+      kGB,
+      0,
+      compressionKind_,
+      pool(),
+      &stats_);
+  state.setPartitionSpilled(0);
+  const auto writeRun = [&](int64_t begin, int64_t end) {
+    state.appendToPartition(
+        0,
+        makeRowVector({makeFlatVector<int64_t>(
+            end - begin, [&](auto row) { return begin + row; })}));
+    state.finishWrite(0);
+  };
+
+  // Three runs of which the first two follow each other.
+  writeRun(0, 10);
+  writeRun(10, 20);
+  writeRun(5, 15);
+  ASSERT_EQ(state.testingSpilledFilePaths().size(), 3);
+
+  auto merge = state.startMerge(0, nullptr);
+  ASSERT_EQ(merge->numStreams(), 2);
+  std::vector<int64_t> values;
+  while (auto stream = merge->next()) {
+    values.push_back(
+        stream->decoded(0).valueAt<int64_t>(stream->currentIndex()));
+    stream->pop();
+  }
+  ASSERT_EQ(values.size(), 30);
+  ASSERT_TRUE(std::is_sorted(values.begin(), values.end()));
+}
+
+TEST_P(SpillTest, spillOverflowDirectory) {
+  auto localDir = exec::test::TempDirectoryPath::create();
+  auto overflowDir = exec::test::TempDirectoryPath::create();
+  const std::string taskDir = localDir->path + "/task";
+  // The local directory is full after the first file.
+  SpillTiers::instance().setOverflow(localDir->path, 1, overflowDir->path);
+
+  std::vector<CompareFlags> emptyCompareFlags;
+  SpillState state(
+      taskDir + "/0_0_0",
+      1,
+      1,
+      emptyCompareFlags,
+      1,
+      0,
+      compressionKind_,
+      pool(),
+      &stats_);
+  state.setPartitionSpilled(0);
+  std::vector<int64_t> values;
+  for (int i = 0; i < 3; ++i) {
+    values.push_back(i);
+    state.appendToPartition(0, makeRowVector({makeFlatVector<int64_t>({i})}));
+    state.finishWrite(0);
+  }
+  ASSERT_GT(SpillTiers::instance().usedBytes(localDir->path), 0);
+
+  const auto files = state.testingSpilledFilePaths();
+  ASSERT_EQ(files.size(), 3);
+  ASSERT_EQ(files[0].find(taskDir), 0);
+  for (size_t i = 1; i < files.size(); ++i) {
+    ASSERT_EQ(files[i].find(overflowDir->path + "/task/0_0_0"), 0);
+  }
+
+  // The spilled data reads back from both directories.
+  auto merge = state.startMerge(0, nullptr);
+  for (auto value : values) {
+    auto stream = merge->next();
+    ASSERT_NE(nullptr, stream);
+    ASSERT_EQ(
+        value, stream->decoded(0).valueAt<int64_t>(stream->currentIndex()));
+    stream->pop();
+  }
+  ASSERT_EQ(nullptr, merge->next());
+
+  auto fs = filesystems::getFileSystem(overflowDir->path, nullptr);
+  ASSERT_TRUE(fs->exists(overflowDir->path + "/task"));
+  SpillTiers::instance().removeDirectory(taskDir);
+  ASSERT_EQ(SpillTiers::instance().usedBytes(localDir->path), 0);
+  ASSERT_FALSE(fs->exists(overflowDir->path + "/task"));
+  SpillTiers::instance().testingClear();
+}
+
+TEST_P(SpillTest, writeRateLimiter) {
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  std::vector<CompareFlags> emptyCompareFlags;
+  // A burst of one byte so that every flush after the first one is throttled.
+  RateLimiter rateLimiter(1 << 20, 1);
+  SpillState state(
+      tempDirectory->path + "/test",
+      1,
+      1,
+      emptyCompareFlags,
+      1,
+      0,
+      compressionKind_,
+      pool(),
+      &stats_,
+      &rateLimiter);
+  state.setPartitionSpilled(0);
+  for (int i = 0; i < 3; ++i) {
+    state.appendToPartition(
+        0, makeRowVector({makeFlatVector<int64_t>(1'000, folly::identity)}));
+    state.finishWrite(0);
+  }
+  ASSERT_GT(rateLimiter.totalWaitUs(), 0);
+  ASSERT_EQ(state.testingSpilledFilePaths().size(), 3);
+}
+
+TEST_P(SpillTest, zstdDictionary) {
+  FLAGS_velox_spill_zstd_dictionary = true;
+  SCOPE_EXIT {
+    FLAGS_velox_spill_zstd_dictionary = false;
+  };
+  auto tempDirectory = exec::test::TempDirectoryPath::create();
+  std::vector<CompareFlags> emptyCompareFlags;
+  SpillState state(
+      tempDirectory->path + "/test",
+      1,
+      1,
+      emptyCompareFlags,
+      kGB,
+      0,
+      compressionKind_,
+      pool(),
+      &stats_);
+  state.setPartitionSpilled(0);
+  // A run of small batches that spans the training of the dictionary.
+  constexpr int32_t kNumBatches = 256;
+  constexpr int32_t kBatchSize = 1'000;
+  for (int32_t batch = 0; batch < kNumBatches; ++batch) {
+    state.appendToPartition(
+        0, makeRowVector({makeFlatVector<int64_t>(kBatchSize, [&](auto row) {
+          return batch * kBatchSize + row;
+        })}));
+  }
+  state.finishWrite(0);
+
+  auto merge = state.startMerge(0, nullptr);
+  for (int64_t i = 0; i < kNumBatches * kBatchSize; ++i) {
+    auto stream = merge->next();
+    ASSERT_NE(nullptr, stream);
+    ASSERT_EQ(i, stream->decoded(0).valueAt<int64_t>(stream->currentIndex()));
+    stream->pop();
+  }
+  ASSERT_EQ(nullptr, merge->next());
+}
+
 INSTANTIATE_TEST_SUITE_P(
     SpillTestSuite,
     SpillTest,
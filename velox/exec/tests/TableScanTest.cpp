@@ -290,6 +290,46 @@ TEST_F(TableScanTest, partitionKeyAlias) {
   assertQuery(op, split, "SELECT c0, '2021-12-02' FROM tmp");
 }
 
+TEST_F(TableScanTest, deletedRows) {
+  std::vector<RowVectorPtr> vectors = {makeRowVector(
+      {makeFlatVector<int64_t>(10'000, [](auto row) { return row; })})};
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+  createDuckDbTable(vectors);
+
+  auto deletedRows = std::make_shared<std::vector<int64_t>>();
+  for (int64_t row = 0; row < 10'000; ++row) {
+    if (row % 3 == 0 || (row >= 5'000 && row < 6'000)) {
+      deletedRows->push_back(row);
+    }
+  }
+  auto split = HiveConnectorSplitBuilder(filePath->path)
+                   .deletedRows(std::move(deletedRows))
+                   .build();
+  auto rowType = ROW({"c0"}, {BIGINT()});
+  assertQuery(
+      tableScanNode(rowType),
+      split,
+      "SELECT c0 FROM tmp WHERE c0 % 3 <> 0 AND (c0 < 5000 OR c0 >= 6000)");
+
+  // Filters apply to the rows that are not deleted.
+  auto plan = PlanBuilder(pool_.get())
+                  .tableScan(rowType, {"c0 < 7000"}, "")
+                  .planNode();
+  assertQuery(
+      plan,
+      split,
+      "SELECT c0 FROM tmp WHERE c0 % 3 <> 0 AND (c0 < 5000 OR c0 >= 6000) "
+      "AND c0 < 7000");
+
+  // count(*) reads no columns.
+  plan = PlanBuilder(pool_.get())
+             .tableScan(ROW({}, {}))
+             .singleAggregation({}, {"count(1)"})
+             .planNode();
+  assertQuery(plan, split, "SELECT 5999");
+}
+
 TEST_F(TableScanTest, columnPruning) {
   auto vectors = makeVectors(10, 1'000);
   auto filePath = TempFilePath::create();
@@ -1172,6 +1212,203 @@ TEST_F(TableScanTest, multipleSplits) {
   }
 }
 
+TEST_F(TableScanTest, splitPreloadBudget) {
+  auto filePaths = makeFilePaths(20);
+  auto vectors = makeVectors(20, 100);
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+  uint64_t maxSplitSize = 0;
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->path, vectors[i]);
+    const auto size = fs::file_size(filePaths[i]->path);
+    maxSplitSize = std::max<uint64_t>(maxSplitSize, size);
+    splits.push_back(makeHiveConnectorSplit(filePaths[i]->path, 0, size));
+  }
+  createDuckDbTable(vectors);
+
+  // A budget of 1 byte allows a single split to preload at a time.
+  core::PlanNodeId scanNodeId;
+  auto plan = PlanBuilder()
+                  .tableScan(rowType_)
+                  .capturePlanNodeId(scanNodeId)
+                  .planNode();
+  auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                  .plan(plan)
+                  .splits(splits)
+                  .config(QueryConfig::kMaxSplitPreloadBytes, "1")
+                  .assertResults("SELECT * FROM tmp");
+  auto stats = getTableScanRuntimeStats(task);
+  ASSERT_GT(stats.at("preloadedSplits").sum, 0);
+  ASSERT_GT(stats.at("throttledPreloads").sum, 0);
+
+  const auto schedulerStats =
+      task->splitPreloadScheduler(scanNodeId)->stats();
+  ASSERT_EQ(schedulerStats.numPreloads, stats.at("preloadedSplits").sum);
+  ASSERT_EQ(
+      schedulerStats.numHits + schedulerStats.numMisses,
+      schedulerStats.numPreloads);
+  ASSERT_GT(schedulerStats.numThrottled, 0);
+  ASSERT_LE(schedulerStats.peakBytes, maxSplitSize);
+  ASSERT_EQ(task->splitPreloadScheduler(scanNodeId)->reservedBytes(), 0);
+}
+
+TEST_F(TableScanTest, retireScanDrivers) {
+  auto filePaths = makeFilePaths(40);
+  auto vectors = makeVectors(40, 1'000);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->path, vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  // With a budget of 1 thread, drivers retire whenever several are on thread.
+  // All rows must still be read and one driver must not retire.
+  auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                  .plan(tableScanNode())
+                  .splits(makeHiveConnectorSplits(filePaths))
+                  .maxDrivers(4)
+                  .config(QueryConfig::kMaxRunningDriversPerTask, "1")
+                  .assertResults("SELECT * FROM tmp");
+  ASSERT_LE(task->taskStats().numRetiredDrivers, 3);
+}
+
+TEST_F(TableScanTest, splitFileAffinity) {
+  auto filePaths = makeFilePaths(2);
+  auto vectors = makeVectors(2, 1'000);
+  std::vector<std::vector<std::shared_ptr<connector::ConnectorSplit>>>
+      fileSplits(filePaths.size());
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->path, vectors[i]);
+    for (auto& split : makeHiveConnectorSplits(
+             filePaths[i]->path, 2, dwio::common::FileFormat::DWRF)) {
+      fileSplits[i].push_back(split);
+    }
+  }
+  createDuckDbTable(vectors);
+
+  // Interleave the ranges of the two files: A1, B1, A2, B2.
+  std::vector<std::shared_ptr<connector::ConnectorSplit>> splits;
+  for (int32_t i = 0; i < 2; ++i) {
+    splits.push_back(fileSplits[0][i]);
+    splits.push_back(fileSplits[1][i]);
+  }
+
+  // Disable preload so that the order only depends on the affinity.
+  auto oldSplitPreload = FLAGS_split_preload_per_driver;
+  FLAGS_split_preload_per_driver = 0;
+  for (const auto affinity : {false, true}) {
+    SCOPED_TRACE(fmt::format("affinity: {}", affinity));
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .plan(tableScanNode())
+            .splits(splits)
+            .config(
+                QueryConfig::kSplitFileAffinity, affinity ? "true" : "false")
+            .assertResults("SELECT * FROM tmp");
+    // With affinity, the single driver takes A2 ahead of B1.
+    EXPECT_EQ(task->taskStats().numAffinitySplits, affinity ? 1 : 0);
+  }
+  FLAGS_split_preload_per_driver = oldSplitPreload;
+}
+
+TEST_F(TableScanTest, fragmentResultCache) {
+  auto filePaths = makeFilePaths(3);
+  auto vectors = makeVectors(3, 1'000);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->path, vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  auto numHits = [&](const std::shared_ptr<Task>& task) {
+    auto stats = getTableScanRuntimeStats(task);
+    auto it = stats.find("fragmentResultCacheHits");
+    return it == stats.end() ? 0 : it->second.sum;
+  };
+  auto scan = [&](const core::PlanNodePtr& plan, const std::string& sql) {
+    return AssertQueryBuilder(duckDbQueryRunner_)
+        .plan(plan)
+        .splits(makeHiveConnectorSplits(filePaths))
+        .config(QueryConfig::kFragmentResultCacheEnabled, "true")
+        .assertResults(sql);
+  };
+
+  auto plan = tableScanNode();
+  ASSERT_EQ(numHits(scan(plan, "SELECT * FROM tmp")), 0);
+  ASSERT_EQ(numHits(scan(plan, "SELECT * FROM tmp")), filePaths.size());
+
+  // A scan with a filter has other results.
+  auto filtered = PlanBuilder(pool_.get())
+                      .tableScan(rowType_, {"c0 > 0"})
+                      .planNode();
+  ASSERT_EQ(numHits(scan(filtered, "SELECT * FROM tmp WHERE c0 > 0")), 0);
+  ASSERT_EQ(
+      numHits(scan(filtered, "SELECT * FROM tmp WHERE c0 > 0")),
+      filePaths.size());
+
+  // Without the config the cached results are not used.
+  auto task = AssertQueryBuilder(duckDbQueryRunner_)
+                  .plan(plan)
+                  .splits(makeHiveConnectorSplits(filePaths))
+                  .assertResults("SELECT * FROM tmp");
+  ASSERT_EQ(numHits(task), 0);
+}
+
+TEST_F(TableScanTest, limitPushdown) {
+  auto filePaths = makeFilePaths(3);
+  auto vectors = makeVectors(3, 1'000);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->path, vectors[i]);
+  }
+
+  // The scan reads only the rows the Limit needs.
+  auto plan = PlanBuilder()
+                  .tableScan(rowType_)
+                  .limit(5, 10, false)
+                  .planNode();
+  auto task = AssertQueryBuilder(plan)
+                  .splits(makeHiveConnectorSplits(filePaths))
+                  .assertTypeAndNumRows(rowType_, 10);
+  ASSERT_EQ(getTableScanStats(task).outputRows, 15);
+
+  // A filter between the scan and the Limit reads full batches.
+  plan = PlanBuilder()
+             .tableScan(rowType_)
+             .filter("c1 is null or c1 < 1000000000")
+             .limit(0, 10, false)
+             .planNode();
+  task = AssertQueryBuilder(plan)
+             .splits(makeHiveConnectorSplits(filePaths))
+             .assertTypeAndNumRows(rowType_, 10);
+  ASSERT_GT(getTableScanStats(task).outputRows, 10);
+}
+
+TEST_F(TableScanTest, adaptiveOutputBatchRows) {
+  auto filePaths = makeFilePaths(5);
+  auto vectors = makeVectors(5, 1'000);
+  for (int32_t i = 0; i < vectors.size(); i++) {
+    writeToFile(filePaths[i]->path, vectors[i]);
+  }
+  createDuckDbTable(vectors);
+
+  for (const auto adaptive : {false, true}) {
+    SCOPED_TRACE(fmt::format("adaptive: {}", adaptive));
+    auto task =
+        AssertQueryBuilder(duckDbQueryRunner_)
+            .plan(tableScanNode())
+            .splits(makeHiveConnectorSplits(filePaths))
+            .config(
+                QueryConfig::kAdaptiveOutputBatchRows,
+                adaptive ? "true" : "false")
+            .assertResults("SELECT * FROM tmp");
+    auto stats = getTableScanRuntimeStats(task);
+    if (adaptive) {
+      // The batch size is picked once per split.
+      ASSERT_EQ(stats.at(Operator::kOutputBatchRows).count, filePaths.size());
+      ASSERT_GT(stats.at(Operator::kOutputBatchRows).min, 0);
+    } else {
+      ASSERT_EQ(stats.count(Operator::kOutputBatchRows), 0);
+    }
+  }
+}
+
 TEST_F(TableScanTest, waitForSplit) {
   auto filePaths = makeFilePaths(10);
   auto vectors = makeVectors(10, 1'000);
@@ -1403,6 +1640,44 @@ TEST_F(TableScanTest, statsBasedSkippingDouble) {
   EXPECT_EQ(3, getSkippedStridesStat(task));
 }
 
+TEST_F(TableScanTest, fileStatisticsIndex) {
+  resetHiveConnector(std::make_shared<core::MemConfig>(
+      std::unordered_map<std::string, std::string>{
+          {connector::hive::HiveConfig::kNumIndexedFileStatistics, "10"}}));
+  auto filePaths = makeFilePaths(1);
+  auto rowVector = makeRowVector(
+      {makeFlatVector<int64_t>(1'000, [](auto row) { return row; })});
+  writeToFile(filePaths[0]->path, rowVector);
+  createDuckDbTable({rowVector});
+
+  auto assertQuery = [&](const std::string& filter) {
+    return TableScanTest::assertQuery(
+        PlanBuilder(pool_.get())
+            .tableScan(ROW({"c0"}, {BIGINT()}), {filter})
+            .planNode(),
+        filePaths,
+        "SELECT c0 FROM tmp WHERE " + filter);
+  };
+
+  // The first scan opens the file and indexes its statistics.
+  auto task = assertQuery("c0 >= 500");
+  EXPECT_EQ(0, getSkippedSplitsStat(task));
+  auto* index = std::dynamic_pointer_cast<connector::hive::HiveConnector>(
+                    connector::getConnector(kHiveConnectorId))
+                    ->fileStatisticsIndex();
+  ASSERT_NE(index, nullptr);
+  auto statistics = index->find(filePaths[0]->path);
+  ASSERT_NE(statistics, nullptr);
+  EXPECT_EQ(statistics->numRows, 1'000);
+
+  // The split is skipped from the index without opening the file, which no
+  // longer exists.
+  fs::remove(filePaths[0]->path);
+  task = assertQuery("c0 < 0");
+  EXPECT_EQ(1, getSkippedSplitsStat(task));
+  EXPECT_EQ(0, getTableScanStats(task).rawInputRows);
+}
+
 TEST_F(TableScanTest, statsBasedSkippingFloat) {
   auto filePaths = makeFilePaths(1);
   auto size = 31'234;
@@ -2311,6 +2586,36 @@ TEST_F(TableScanTest, mapIsNullFilter) {
       "SELECT * FROM tmp WHERE c0 is null");
 }
 
+TEST_F(TableScanTest, topNDynamicFilter) {
+  auto rowType = ROW({"c0", "c1"}, {BIGINT(), DOUBLE()});
+  auto filePaths = makeFilePaths(5);
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < filePaths.size(); ++i) {
+    // Files have decreasing values of c0. Once the first file has filled up
+    // the top rows, the remaining files do not have qualifying rows.
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int64_t>(
+             1'000, [&](auto row) { return (4 - i) * 1'000 + row; }),
+         makeFlatVector<double>(1'000, [](auto row) { return row * 0.1; })}));
+    writeToFile(filePaths[i]->path, vectors.back());
+  }
+  createDuckDbTable(vectors);
+
+  auto plan = PlanBuilder()
+                  .tableScan(rowType)
+                  .topN({"c0 DESC"}, 10, false)
+                  .planNode();
+  auto task = assertQueryOrdered(
+      plan,
+      makeHiveConnectorSplits(filePaths),
+      "SELECT * FROM tmp ORDER BY c0 DESC LIMIT 10",
+      {0});
+
+  auto stats = getTableScanRuntimeStats(task);
+  ASSERT_GT(stats.at("dynamicFiltersAccepted").sum, 0);
+  ASSERT_EQ(getTableScanStats(task).outputRows, 1'000);
+}
+
 TEST_F(TableScanTest, remainingFilter) {
   auto rowType = ROW(
       {"c0", "c1", "c2", "c3"}, {INTEGER(), INTEGER(), DOUBLE(), BOOLEAN()});
@@ -2383,6 +2688,27 @@ TEST_F(TableScanTest, remainingFilter) {
       "SELECT * FROM tmp WHERE not (c0 > 0 or c1 > c0)");
 }
 
+// The remaining filter fails on the rows dropped by the range filter. The
+// reader may first run it ahead of the range filter, after which it must fall
+// back to running it after the range filter instead of failing the query.
+TEST_F(TableScanTest, remainingFilterAfterFailure) {
+  constexpr vector_size_t kSize = 10'000;
+  std::vector<RowVectorPtr> vectors = {makeRowVector(
+      {makeFlatVector<int32_t>(kSize, [](auto row) { return row % 7; }),
+       makeFlatVector<int32_t>(kSize, [](auto row) { return row; })})};
+  auto filePath = TempFilePath::create();
+  writeToFile(filePath->path, vectors);
+  createDuckDbTable(vectors);
+
+  auto rowType = asRowType(vectors[0]->type());
+  assertQuery(
+      PlanBuilder(pool_.get())
+          .tableScan(rowType, {"c0 > 0::INTEGER"}, "c1 / c0 > 100")
+          .planNode(),
+      {filePath},
+      "SELECT * FROM tmp WHERE c0 > 0 AND c1 / c0 > 100");
+}
+
 TEST_F(TableScanTest, remainingFilterSkippedStrides) {
   auto rowType = ROW({{"c0", BIGINT()}, {"c1", BIGINT()}});
   std::vector<RowVectorPtr> vectors(3);
@@ -904,6 +904,48 @@ TEST_F(TaskTest, singleThreadedExecutionExternalBlockable) {
   EXPECT_EQ(3, results.size());
 }
 
+TEST_F(TaskTest, progress) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(1'000, [](auto row) { return row; }),
+  });
+  auto plan = PlanBuilder()
+                  .values({data, data, data})
+                  .filter("c0 < 100")
+                  .project({"c0 + 5"})
+                  .planFragment();
+  auto task = Task::create(
+      "single.execution.task.0", plan, 0, std::make_shared<core::QueryCtx>());
+
+  ASSERT_NE(task->next(), nullptr);
+  auto progress = task->progress();
+  ASSERT_EQ(progress["state"].asString(), "Running");
+  ASSERT_EQ(progress["pipelines"].size(), 1);
+  auto pipeline = progress["pipelines"][0];
+  ASSERT_EQ(pipeline["numFinishedDrivers"].asInt(), 0);
+  ASSERT_EQ(pipeline["estimatedCompletion"].asDouble(), 0);
+  // Values and FilterProject.
+  ASSERT_EQ(pipeline["operators"].size(), 2);
+  auto values = pipeline["operators"][0];
+  ASSERT_EQ(values["operatorType"].asString(), "Values");
+  ASSERT_EQ(values["outputRows"].asInt(), 1'000);
+  auto filterProject = pipeline["operators"][1];
+  ASSERT_EQ(filterProject["operatorType"].asString(), "FilterProject");
+  ASSERT_EQ(filterProject["inputRows"].asInt(), 1'000);
+  ASSERT_EQ(filterProject["outputRows"].asInt(), 100);
+
+  while (task->next() != nullptr) {
+  }
+  ASSERT_TRUE(waitForTaskCompletion(task.get()));
+  progress = task->progress();
+  ASSERT_EQ(progress["state"].asString(), "Finished");
+  pipeline = progress["pipelines"][0];
+  ASSERT_EQ(pipeline["numFinishedDrivers"].asInt(), 1);
+  ASSERT_EQ(pipeline["estimatedCompletion"].asDouble(), 1);
+  ASSERT_EQ(pipeline["operators"][0]["outputRows"].asInt(), 3'000);
+  ASSERT_EQ(pipeline["operators"][1]["outputRows"].asInt(), 300);
+  ASSERT_EQ(pipeline["operators"][1]["currentBytes"].asInt(), 0);
+}
+
 TEST_F(TaskTest, supportsSingleThreadedExecution) {
   auto plan = PlanBuilder()
                   .tableScan(ROW({"c0"}, {BIGINT()}))
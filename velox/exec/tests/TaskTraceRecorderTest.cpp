@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/exec/TaskTraceRecorder.h"
+
+#include <folly/json.h>
+#include <gtest/gtest.h>
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::exec;
+using namespace facebook::velox::exec::test;
+
+class TaskTraceRecorderTest : public OperatorTestBase {};
+
+TEST_F(TaskTraceRecorderTest, ringBuffer) {
+  TaskTraceRecorder recorder(3);
+  for (uint64_t i = 0; i < 5; ++i) {
+    recorder.record({"run", fmt::format("{}", i), 1, 2, i * 10, 5});
+  }
+  ASSERT_EQ(recorder.numDropped(), 2);
+
+  const auto events = recorder.events();
+  ASSERT_EQ(events.size(), 3);
+  for (size_t i = 0; i < events.size(); ++i) {
+    ASSERT_EQ(events[i].detail, fmt::format("{}", i + 2));
+    ASSERT_EQ(events[i].startMicros, (i + 2) * 10);
+  }
+
+  const auto trace = folly::parseJson(recorder.toChromeTrace());
+  const auto& traceEvents = trace["traceEvents"];
+  ASSERT_EQ(traceEvents.size(), 3);
+  ASSERT_EQ(traceEvents[0]["name"].asString(), "run");
+  ASSERT_EQ(traceEvents[0]["ph"].asString(), "X");
+  ASSERT_EQ(traceEvents[0]["ts"].asInt(), 20);
+  ASSERT_EQ(traceEvents[0]["dur"].asInt(), 5);
+  ASSERT_EQ(traceEvents[0]["pid"].asInt(), 1);
+  ASSERT_EQ(traceEvents[0]["tid"].asInt(), 2);
+  ASSERT_EQ(traceEvents[0]["args"]["detail"].asString(), "2");
+}
+
+TEST_F(TaskTraceRecorderTest, task) {
+  auto data = makeRowVector({makeFlatVector<int64_t>(1'000, folly::identity)});
+  auto plan = PlanBuilder()
+                  .values({data, data})
+                  .filter("c0 % 2 = 0")
+                  .planNode();
+  auto expected =
+      makeRowVector({makeFlatVector<int64_t>(1'000, [](auto row) {
+        return (row % 500) * 2;
+      })});
+
+  // Tracing is off by default.
+  auto task = AssertQueryBuilder(plan).assertResults(expected);
+  ASSERT_EQ(task->traceRecorder(), nullptr);
+  VELOX_ASSERT_THROW(task->toChromeTrace(), "Tracing is disabled for task");
+
+  task = AssertQueryBuilder(plan)
+             .config(core::QueryConfig::kTaskTraceBufferSize, "1000")
+             .assertResults(expected);
+  ASSERT_NE(task->traceRecorder(), nullptr);
+  const auto events = task->traceRecorder()->events();
+  ASSERT_FALSE(events.empty());
+  bool hasRun = false;
+  for (const auto& event : events) {
+    if (std::string(event.name) == "run") {
+      hasRun = true;
+    }
+    ASSERT_EQ(event.pipelineId, 0);
+  }
+  ASSERT_TRUE(hasRun);
+  ASSERT_FALSE(folly::parseJson(task->toChromeTrace())["traceEvents"].empty());
+}
@@ -13,9 +13,11 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 
 using namespace facebook::velox::exec::test;
 
@@ -166,5 +168,57 @@ TEST_F(TopNRowNumberTest, manyPartitions) {
   testLimit(100);
 }
 
+TEST_F(TopNRowNumberTest, spill) {
+  std::vector<RowVectorPtr> batches;
+  for (auto i = 0; i < 10; ++i) {
+    batches.push_back(makeRowVector({
+        // Partitioning key.
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (row + i) % 97; }, nullEvery(31)),
+        // Sorting key. Unique to make the row numbers deterministic.
+        makeFlatVector<int64_t>(
+            1'000, [&](auto row) { return (10 - i) * 1'000 - row; }),
+        // Data.
+        makeFlatVector<StringView>(
+            1'000,
+            [&](auto row) {
+              return StringView::makeInline(fmt::format("{}", row % 17));
+            }),
+    }));
+  }
+  createDuckDbTable(batches);
+
+  auto testSpill = [&](const std::vector<std::string>& partitionKeys,
+                       int32_t limit) {
+    core::PlanNodeId topNRowNumberId;
+    auto plan = PlanBuilder()
+                    .values(batches)
+                    .topNRowNumber(partitionKeys, {"c1"}, limit, true)
+                    .capturePlanNodeId(topNRowNumberId)
+                    .planNode();
+    auto spillDirectory = TempDirectoryPath::create();
+    auto task =
+        AssertQueryBuilder(plan, duckDbQueryRunner_)
+            .spillDirectory(spillDirectory->path)
+            .config(core::QueryConfig::kSpillEnabled, "true")
+            .config(core::QueryConfig::kTopNRowNumberSpillEnabled, "true")
+            .config(core::QueryConfig::kTestingSpillPct, "100")
+            .assertResults(fmt::format(
+                "SELECT * FROM (SELECT *, row_number() over ({} order by c1) as rn FROM tmp) "
+                " WHERE rn <= {}",
+                partitionKeys.empty() ? "" : "partition by c0",
+                limit));
+
+    auto planStats = toPlanStats(task->taskStats());
+    ASSERT_GT(planStats.at(topNRowNumberId).spilledBytes, 0);
+    OperatorTestBase::deleteTaskAndCheckSpillDirectory(task);
+  };
+
+  testSpill({"c0"}, 1);
+  testSpill({"c0"}, 10);
+  testSpill({"c0"}, 500);
+  testSpill({}, 100);
+}
+
 } // namespace
 } // namespace facebook::velox::exec
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/PlanNodeStats.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
@@ -261,3 +262,51 @@ TEST_F(TopNTest, lowCardinality) {
 
   testTwoKeys(vectors, "c0", "c1", 200);
 }
+
+TEST_F(TopNTest, preFilter) {
+  vector_size_t batchSize = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    auto c0 = makeFlatVector<int64_t>(
+        batchSize,
+        [&](vector_size_t row) { return (4 - i) * 1'000 + row * 7 % 1'000; },
+        nullEvery(11));
+    auto c1 = makeFlatVector<double>(
+        batchSize,
+        [&](vector_size_t row) { return (row * 5 + i) * 0.1; },
+        nullEvery(7));
+    auto c2 = makeFlatVector<Timestamp>(
+        batchSize,
+        [&](vector_size_t row) {
+          return Timestamp((row * 5 + i) % 1'500, row * 1'000'000);
+        },
+        nullEvery(13));
+    auto c3 = wrapInDictionary(
+        makeIndicesInReverse(batchSize),
+        batchSize,
+        makeFlatVector<int32_t>(
+            batchSize, [&](vector_size_t row) { return row * 5 + i; }));
+    vectors.push_back(makeRowVector({c0, c1, c2, c3}));
+  }
+  createDuckDbTable(vectors);
+
+  // Use a limit greater than the number of nulls in any column to make the
+  // queries deterministic.
+  testSingleKey(vectors, "c0", 800);
+  testSingleKey(vectors, "c1", 800);
+  testSingleKey(vectors, "c2", 800);
+  testSingleKey(vectors, "c3", 800);
+
+  // The first batch fills up the top rows. All rows of the following batches
+  // sort after these and are discarded before being compared one by one.
+  core::PlanNodeId topNId;
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .topN({"c0 DESC"}, 800, false)
+                  .capturePlanNodeId(topNId)
+                  .planNode();
+  auto task = assertQueryOrdered(
+      plan, "SELECT * FROM tmp ORDER BY c0 DESC LIMIT 800", {0});
+  auto planStats = exec::toPlanStats(task->taskStats());
+  ASSERT_EQ(4'000, planStats.at(topNId).customStats.at("preFilteredRows").sum);
+}
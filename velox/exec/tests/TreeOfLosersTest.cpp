@@ -252,3 +252,39 @@ TEST_F(TreeOfLosersTest, randomWithDuplicates) {
     }
   }
 }
+
+TEST_F(TreeOfLosersTest, runnerUp) {
+  rng_.seed(1);
+  for (const int numStreams : {1, 2, 7, 32}) {
+    SCOPED_TRACE(fmt::format("numStreams: {}", numStreams));
+    // Runs of consecutive numbers of random length go to random streams.
+    constexpr int kNumCount = 100'000;
+    std::vector<std::vector<uint32_t>> streamNumVectors(numStreams);
+    for (int i = 0; i < kNumCount;) {
+      const int streamIndex = folly::Random::rand32(numStreams, rng_);
+      const int runLength = 1 + folly::Random::rand32(100, rng_);
+      for (auto j = 0; j < runLength && i < kNumCount; ++j, ++i) {
+        streamNumVectors[streamIndex].push_back(i);
+      }
+    }
+    std::vector<std::unique_ptr<TestingStream>> mergeStreams;
+    for (auto& numbers : streamNumVectors) {
+      std::reverse(numbers.begin(), numbers.end());
+      mergeStreams.push_back(
+          std::make_unique<TestingStream>(std::move(numbers)));
+    }
+    TreeOfLosers<TestingStream> merge(std::move(mergeStreams));
+
+    // Takes the rows of each winner up to the first row of the runner-up.
+    uint32_t expected = 0;
+    while (auto* stream = merge.next()) {
+      auto* runnerUp = merge.runnerUp();
+      do {
+        ASSERT_EQ(stream->current()->value(), expected++);
+        stream->pop();
+      } while (stream->hasData() &&
+               (runnerUp == nullptr || !(*runnerUp < *stream)));
+    }
+    ASSERT_EQ(expected, kNumCount);
+  }
+}
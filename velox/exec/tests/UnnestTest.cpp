@@ -13,6 +13,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
 #include "velox/exec/tests/utils/OperatorTestBase.h"
 #include "velox/exec/tests/utils/PlanBuilder.h"
 
@@ -403,3 +405,43 @@ TEST_F(UnnestTest, allEmptyOrNullMaps) {
            .planNode();
   assertQueryReturnsEmptyResult(op);
 }
+
+TEST_F(UnnestTest, outputBatchSize) {
+  // Arrays of up to 1'000 elements, some empty and some null.
+  auto vector = makeRowVector({
+      makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+      makeArrayVector<int32_t>(
+          100,
+          [](auto row) { return row % 3 == 0 ? 0 : row * 10; },
+          [](auto row, auto index) { return row + index; },
+          nullEvery(7)),
+      makeArrayVector<int32_t>(
+          100,
+          [](auto row) { return row * 5; },
+          [](auto row, auto index) { return row - index; }),
+  });
+
+  auto plan = PlanBuilder()
+                  .values({vector})
+                  .unnest({"c0"}, {"c1", "c2"}, "ordinal")
+                  .planNode();
+  auto expected = AssertQueryBuilder(plan).copyResults(pool());
+  ASSERT_GT(expected->size(), 1'000);
+
+  for (const auto batchRows : {1, 7, 100, 1'000}) {
+    SCOPED_TRACE(fmt::format("batchRows: {}", batchRows));
+    auto task =
+        AssertQueryBuilder(plan)
+            .config(
+                core::QueryConfig::kPreferredOutputBatchRows,
+                std::to_string(batchRows))
+            .assertResults(expected);
+    // All batches but the last are full.
+    auto stats = exec::toPlanStats(task->taskStats());
+    const auto& unnestStats = stats.at(plan->id());
+    ASSERT_EQ(unnestStats.outputRows, expected->size());
+    ASSERT_EQ(
+        unnestStats.outputVectors,
+        bits::roundUp(expected->size(), batchRows) / batchRows);
+  }
+}
@@ -330,6 +330,33 @@ TEST_F(VectorHasherTest, dictionary) {
   for (int32_t i = 0; i < 100; i++) {
     EXPECT_EQ(hashes[i], folly::hasher<int64_t>()(i % 10 + 3)) << "at " << i;
   }
+
+  // A dictionary selecting every third row of a larger base, like one
+  // partition of a local exchange, with a null among the selected rows.
+  for (int32_t i = 0; i < 100; i++) {
+    flatVector->set(i, i);
+  }
+  flatVector->setNull(30, true);
+  constexpr int32_t kNumPartitionRows = 33;
+  BufferPtr partitionIndices =
+      AlignedBuffer::allocate<vector_size_t>(kNumPartitionRows, pool_.get());
+  auto rawPartitionIndices = partitionIndices->asMutable<vector_size_t>();
+  for (int32_t i = 0; i < kNumPartitionRows; i++) {
+    rawPartitionIndices[i] = i * 3;
+  }
+  auto partition = BaseVector::wrapInDictionary(
+      BufferPtr(nullptr), partitionIndices, kNumPartitionRows, vector);
+  SelectivityVector partitionRows(kNumPartitionRows);
+  hasher->decode(*partition, partitionRows);
+  hasher->hash(partitionRows, true, hashes);
+  for (int32_t i = 0; i < kNumPartitionRows; i++) {
+    auto expected = i == 10 ? exec::VectorHasher::kNullHash
+                            : folly::hasher<int64_t>()(i * 3);
+    EXPECT_EQ(
+        hashes[i],
+        bits::hashMix(folly::hasher<int64_t>()(i % 10 + 3), expected))
+        << "at " << i;
+  }
 }
 
 // Tests how strings are mapped to uint64_t (if they fit) and to
@@ -454,6 +481,52 @@ TEST_F(VectorHasherTest, stringDistinctOverflow) {
   }
 }
 
+TEST_F(VectorHasherTest, stringDictionaryIds) {
+  auto hasher = exec::VectorHasher::create(VARCHAR(), 1);
+  std::vector<std::string> strings;
+  for (auto i = 0; i < 10; ++i) {
+    strings.push_back(fmt::format("longer than a range {}", i));
+  }
+  auto base = vectorMaker_->flatVector(strings);
+  // Two batches over the same dictionary, like from a reader.
+  auto first = makeDictionary(100, base);
+  auto second = BaseVector::wrapInDictionary(
+      BufferPtr(nullptr),
+      makeIndices(100, [](vector_size_t row) { return 9 - row % 10; }),
+      100,
+      base);
+
+  raw_vector<uint64_t> ids(100);
+  hasher->decode(*first, allRows_);
+  EXPECT_FALSE(hasher->computeValueIds(allRows_, ids));
+  hasher->enableValueIds(1, 50);
+
+  SelectivityVector baseRows(base->size());
+  raw_vector<uint64_t> baseIds(base->size());
+  hasher->decode(*base, baseRows);
+  ASSERT_TRUE(hasher->computeValueIds(baseRows, baseIds));
+
+  for (const auto& batch : {first, second, first}) {
+    hasher->decode(*batch, allRows_);
+    ASSERT_TRUE(hasher->computeValueIds(allRows_, ids));
+    DecodedVector decoded(*batch, allRows_);
+    for (auto i = 0; i < batch->size(); ++i) {
+      EXPECT_EQ(ids[i], baseIds[decoded.index(i)]) << "at " << i;
+    }
+  }
+
+  // Ids are reassigned after the unique values are cleared.
+  hasher->resetStats();
+  hasher->decode(*second, allRows_);
+  EXPECT_FALSE(hasher->computeValueIds(allRows_, ids));
+  hasher->enableValueIds(1, 50);
+  hasher->decode(*second, allRows_);
+  ASSERT_TRUE(hasher->computeValueIds(allRows_, ids));
+  for (auto i = 0; i < 10; ++i) {
+    EXPECT_EQ(ids[i], i + 1) << "at " << i;
+  }
+}
+
 TEST_F(VectorHasherTest, integerIds) {
   auto vector = BaseVector::create(BIGINT(), 100, pool_.get());
   auto ints = vector->as<FlatVector<int64_t>>();
@@ -1014,6 +1087,78 @@ TEST_F(VectorHasherTest, simdRange) {
   }
 }
 
+TEST_F(VectorHasherTest, multiColumnFixedWidth) {
+  // Hashes and value ids for all rows of a multi-column key go through the
+  // batched paths. Checks them against the per-row definitions.
+  constexpr int32_t kNumRows = 1001;
+  using exec::VectorHasher;
+
+  auto intValues = vectorMaker_->flatVector<int32_t>(
+      kNumRows, [](auto i) { return i % 17; }, test::VectorMaker::nullEvery(7));
+  auto doubleValues = vectorMaker_->flatVector<double>(
+      kNumRows, [](auto i) { return i * 1.5; });
+  auto int64Values = vectorMaker_->flatVector<int64_t>(
+      kNumRows,
+      [](auto i) { return i % 100; },
+      test::VectorMaker::nullEvery(5));
+
+  auto intHasher = VectorHasher::create(INTEGER(), 0);
+  auto doubleHasher = VectorHasher::create(DOUBLE(), 1);
+  auto int64Hasher = VectorHasher::create(BIGINT(), 2);
+
+  SelectivityVector rows(kNumRows);
+  raw_vector<uint64_t> hashes(kNumRows);
+  intHasher->decode(*intValues, rows);
+  intHasher->hash(rows, false, hashes);
+  doubleHasher->decode(*doubleValues, rows);
+  doubleHasher->hash(rows, true, hashes);
+  int64Hasher->decode(*int64Values, rows);
+  int64Hasher->hash(rows, true, hashes);
+
+  auto hashOrNull = [](const auto& vector, auto row, auto hash) {
+    return vector->isNullAt(row) ? VectorHasher::kNullHash : hash;
+  };
+  for (auto i = 0; i < kNumRows; ++i) {
+    auto expected = hashOrNull(
+        intValues, i, folly::hasher<int32_t>()(intValues->valueAt(i)));
+    expected = bits::hashMix(
+        expected, folly::hasher<double>()(doubleValues->valueAt(i)));
+    expected = bits::hashMix(
+        expected,
+        hashOrNull(
+            int64Values, i, folly::hasher<int64_t>()(int64Values->valueAt(i))));
+    ASSERT_EQ(expected, hashes[i]) << "at " << i;
+  }
+
+  // Map the non-null integer keys to ranges and combine their ids.
+  auto smallValues = vectorMaker_->flatVector<int16_t>(
+      kNumRows, [](auto i) { return i % 17; });
+  auto bigValues = vectorMaker_->flatVector<int64_t>(
+      kNumRows, [](auto i) { return 1'000 + i % 100; });
+  auto smallHasher = VectorHasher::create(SMALLINT(), 0);
+  auto bigHasher = VectorHasher::create(BIGINT(), 1);
+
+  raw_vector<uint64_t> result(kNumRows);
+  smallHasher->decode(*smallValues, rows);
+  smallHasher->computeValueIds(rows, result);
+  bigHasher->decode(*bigValues, rows);
+  bigHasher->computeValueIds(rows, result);
+  auto multiplier = smallHasher->enableValueRange(1, 0);
+  bigHasher->enableValueRange(multiplier, 0);
+
+  smallHasher->decode(*smallValues, rows);
+  ASSERT_TRUE(smallHasher->computeValueIds(rows, result));
+  bigHasher->decode(*bigValues, rows);
+  ASSERT_TRUE(bigHasher->computeValueIds(rows, result));
+  for (auto i = 0; i < kNumRows; ++i) {
+    ASSERT_EQ(
+        smallValues->valueAt(i) + 1 +
+            (bigValues->valueAt(i) - 1'000 + 1) * multiplier,
+        result[i])
+        << "at " << i;
+  }
+}
+
 TEST_F(VectorHasherTest, typeMismatch) {
   auto hasher = VectorHasher::create(BIGINT(), 0);
 
@@ -219,8 +219,14 @@ class HiveConnectorSplitBuilder {
     return *this;
   }
 
+  HiveConnectorSplitBuilder& deletedRows(
+      std::shared_ptr<const std::vector<int64_t>> rows) {
+    deletedRows_ = std::move(rows);
+    return *this;
+  }
+
   std::shared_ptr<connector::hive::HiveConnectorSplit> build() const {
-    return std::make_shared<connector::hive::HiveConnectorSplit>(
+    auto split = std::make_shared<connector::hive::HiveConnectorSplit>(
         kHiveConnectorId,
         filePath_.find("/") == 0 ? "file:" + filePath_ : filePath_,
         fileFormat_,
@@ -228,6 +234,8 @@ class HiveConnectorSplitBuilder {
         length_,
         partitionKeys_,
         tableBucketNumber_);
+    split->deletedRows = deletedRows_;
+    return split;
   }
 
  private:
@@ -237,6 +245,7 @@ class HiveConnectorSplitBuilder {
   uint64_t length_{std::numeric_limits<uint64_t>::max()};
   std::unordered_map<std::string, std::optional<std::string>> partitionKeys_;
   std::optional<int32_t> tableBucketNumber_;
+  std::shared_ptr<const std::vector<int64_t>> deletedRows_;
 };
 
 } // namespace facebook::velox::exec::test
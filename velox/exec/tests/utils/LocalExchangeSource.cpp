@@ -65,7 +65,7 @@ class LocalExchangeSource : public exec::ExchangeSource {
     VELOX_CHECK(requestPending_);
     auto requestedSequence = sequence_;
     auto self = shared_from_this();
-    buffers->getData(
+    buffers->getPages(
         taskId_,
         destination_,
         maxBytes,
@@ -73,7 +73,8 @@ class LocalExchangeSource : public exec::ExchangeSource {
         // Since this lambda may outlive 'this', we need to capture a
         // shared_ptr to the current object (self).
         [self, requestedSequence, buffers, this](
-            std::vector<std::unique_ptr<folly::IOBuf>> data, int64_t sequence) {
+            std::vector<std::shared_ptr<SerializedPage>> data,
+            int64_t sequence) {
           if (requestedSequence > sequence) {
             VLOG(2) << "Receives earlier sequence than requested: task "
                     << taskId_ << ", destination " << destination_
@@ -93,10 +94,16 @@ class LocalExchangeSource : public exec::ExchangeSource {
               // Keep looping, there could be extra end markers.
               continue;
             }
-            totalBytes += inputPage->length();
-            inputPage->unshare();
-            pages.push_back(
-                std::make_unique<SerializedPage>(std::move(inputPage)));
+            totalBytes += inputPage->size();
+            if (inputPage->vector() != nullptr) {
+              pages.push_back(std::make_unique<SerializedPage>(
+                  inputPage->vector(), inputPage->size()));
+            } else {
+              auto iobuf = inputPage->getIOBuf();
+              iobuf->unshare();
+              pages.push_back(
+                  std::make_unique<SerializedPage>(std::move(iobuf)));
+            }
             inputPage = nullptr;
           }
           numPages_ += pages.size();
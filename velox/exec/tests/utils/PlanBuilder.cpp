@@ -605,6 +605,66 @@ PlanBuilder& PlanBuilder::finalAggregation() {
   return *this;
 }
 
+PlanBuilder& PlanBuilder::groupingSetsAggregation(
+    const std::vector<std::vector<std::string>>& groupingSets,
+    const std::vector<std::string>& aggregates,
+    const std::string& groupIdName) {
+  // The finest grouping is on the union of the keys of all grouping sets.
+  std::vector<std::string> groupingKeys;
+  for (const auto& groupingSet : groupingSets) {
+    for (const auto& key : groupingSet) {
+      if (std::find(groupingKeys.begin(), groupingKeys.end(), key) ==
+          groupingKeys.end()) {
+        groupingKeys.push_back(key);
+      }
+    }
+  }
+
+  partialAggregation(groupingKeys, aggregates);
+  const auto partialAggNode =
+      std::dynamic_pointer_cast<const core::AggregationNode>(planNode_);
+  const auto& aggregateNames = partialAggNode->aggregateNames();
+
+  // Replicates the partially aggregated groups, not the input rows, once per
+  // grouping set.
+  groupId(groupingKeys, groupingSets, aggregateNames, groupIdName);
+
+  std::vector<core::AggregationNode::Aggregate> finalAggregates;
+  finalAggregates.reserve(aggregateNames.size());
+  for (auto i = 0; i < aggregateNames.size(); ++i) {
+    const auto& partialAggregate = partialAggNode->aggregates()[i];
+    const auto& name = partialAggregate.call->name();
+
+    core::AggregationNode::Aggregate aggregate;
+    for (const auto& rawInput : partialAggregate.call->inputs()) {
+      aggregate.rawInputTypes.push_back(rawInput->type());
+    }
+    auto type = resolveAggregateType(
+        name,
+        core::AggregationNode::Step::kFinal,
+        aggregate.rawInputTypes,
+        false);
+    aggregate.call = std::make_shared<core::CallTypedExpr>(
+        type,
+        std::vector<core::TypedExprPtr>{field(aggregateNames[i])},
+        name);
+    finalAggregates.emplace_back(std::move(aggregate));
+  }
+
+  auto finalGroupingKeys = groupingKeys;
+  finalGroupingKeys.push_back(groupIdName);
+  planNode_ = std::make_shared<core::AggregationNode>(
+      nextPlanNodeId(),
+      core::AggregationNode::Step::kFinal,
+      fields(finalGroupingKeys),
+      std::vector<core::FieldAccessTypedExprPtr>{},
+      aggregateNames,
+      finalAggregates,
+      false,
+      planNode_);
+  return *this;
+}
+
 PlanBuilder::AggregatesAndNames PlanBuilder::createAggregateExpressionsAndNames(
     const std::vector<std::string>& aggregates,
     const std::vector<std::string>& masks,
@@ -1025,12 +1085,14 @@ PlanBuilder& PlanBuilder::localPartitionByBucket(
 namespace {
 core::PlanNodePtr createLocalPartitionRoundRobinNode(
     const core::PlanNodeId& planNodeId,
-    const std::vector<core::PlanNodePtr>& sources) {
+    const std::vector<core::PlanNodePtr>& sources,
+    bool scaleWriter = false) {
   return std::make_shared<core::LocalPartitionNode>(
       planNodeId,
       core::LocalPartitionNode::Type::kRepartition,
       std::make_shared<RoundRobinPartitionFunctionSpec>(),
-      sources);
+      sources,
+      scaleWriter);
 }
 } // namespace
 
@@ -1047,6 +1109,12 @@ PlanBuilder& PlanBuilder::localPartitionRoundRobin() {
   return *this;
 }
 
+PlanBuilder& PlanBuilder::scaleWriterLocalPartitionRoundRobin() {
+  planNode_ = createLocalPartitionRoundRobinNode(
+      nextPlanNodeId(), {planNode_}, true);
+  return *this;
+}
+
 namespace {
 class RoundRobinRowPartitionFunction : public core::PartitionFunction {
  public:
@@ -1111,7 +1179,8 @@ PlanBuilder& PlanBuilder::hashJoin(
     const std::string& filter,
     const std::vector<std::string>& outputLayout,
     core::JoinType joinType,
-    bool nullAware) {
+    bool nullAware,
+    std::optional<std::string> buildCacheKey) {
   VELOX_CHECK_EQ(leftKeys.size(), rightKeys.size());
 
   auto leftType = planNode_->outputType();
@@ -1151,7 +1220,8 @@ PlanBuilder& PlanBuilder::hashJoin(
       std::move(filterExpr),
       std::move(planNode_),
       build,
-      outputType);
+      outputType,
+      std::move(buildCacheKey));
   return *this;
 }
 
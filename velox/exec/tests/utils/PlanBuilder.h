@@ -462,6 +462,24 @@ class PlanBuilder {
       const std::vector<std::string>& aggregationInputs,
       std::string groupIdName = "group_id");
 
+  /// Add a grouping sets aggregation that aggregates the raw input only once,
+  /// on the union of the keys of all 'groupingSets', and derives each
+  /// grouping set by re-aggregating those partial results. Produces a partial
+  /// aggregation, a GroupIdNode over its intermediate results and a final
+  /// aggregation. Output columns are the grouping keys in order of first
+  /// appearance in 'groupingSets', then 'groupIdName', then the aggregates.
+  /// Compared to groupId() followed by singleAggregation(), the raw input is
+  /// hashed once instead of once per grouping set.
+  ///
+  /// @param groupingSets Grouping sets as lists of input column names, e.g.
+  /// {{"k1", "k2"}, {"k1"}, {}} for ROLLUP(k1, k2).
+  /// @param aggregates Aggregate expressions with optional aliases, e.g.
+  /// {"sum(a) as s"}. Masks and distinct aggregates are not supported.
+  PlanBuilder& groupingSetsAggregation(
+      const std::vector<std::vector<std::string>>& groupingSets,
+      const std::vector<std::string>& aggregates,
+      const std::string& groupIdName = "group_id");
+
   /// Add a LocalMergeNode using specified ORDER BY clauses.
   ///
   /// For example,
@@ -602,6 +620,11 @@ class PlanBuilder {
   /// current plan node).
   PlanBuilder& localPartitionRoundRobin();
 
+  /// Add a scale-writer LocalPartitionNode that feeds table writers. Routes
+  /// the input round-robin to a number of writers that grows with the input.
+  /// See core::LocalPartitionNode::scaleWriter().
+  PlanBuilder& scaleWriterLocalPartitionRoundRobin();
+
   /// Add a LocalPartitionNode to partition the input using row-wise
   /// round-robin. Number of partitions is determined at runtime based on
   /// parallelism of the downstream pipeline.
@@ -624,6 +647,8 @@ class PlanBuilder {
   /// @param joinType Type of the join: inner, left, right, full, semi, or anti.
   /// @param nullAware Applies to semi and anti joins. Indicates whether the
   /// join follows IN (null-aware) or EXISTS (regular) semantic.
+  /// @param buildCacheKey Optional key for sharing the hash table with other
+  /// tasks. See core::HashJoinNode.
   PlanBuilder& hashJoin(
       const std::vector<std::string>& leftKeys,
       const std::vector<std::string>& rightKeys,
@@ -631,7 +656,8 @@ class PlanBuilder {
       const std::string& filter,
       const std::vector<std::string>& outputLayout,
       core::JoinType joinType = core::JoinType::kInner,
-      bool nullAware = false);
+      bool nullAware = false,
+      std::optional<std::string> buildCacheKey = std::nullopt);
 
   /// Add a MergeJoinNode to join two inputs using one or more join keys and an
   /// optional filter. The caller is responsible to ensure that inputs are
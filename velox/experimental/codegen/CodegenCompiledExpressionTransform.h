@@ -18,6 +18,7 @@
 // This file defines the tranasformation that replaces velox expressions with
 // codegen compiled expressions
 
+#include <folly/Synchronized.h>
 #include <functional>
 #include <optional>
 #include "velox/core/PlanNode.h"
@@ -137,6 +138,40 @@ class CompiledExpressionTransformVisitor {
     return it->second;
   }
 
+  /// Compiles and links 'source' into a shared object. The shared objects are
+  /// cached process-wide keyed on the compilation arguments and the generated
+  /// source, so that plans repeating the same filter and projections, e.g. the
+  /// tasks of one query or the same query shape run again, do not invoke the
+  /// compiler again.
+  std::filesystem::path compileAndLink(const std::string& source) {
+    auto& compiler = codeManager_.compiler();
+    const auto key = fmt::format(
+        "{}\n{}\n{}",
+        fmt::join(compiler.defaultCompilationArgs(), " "),
+        fmt::join(compiler.defaultLinkingArgs(), " "),
+        source);
+    {
+      auto cache = compiledObjectCache().rlock();
+      auto it = cache->find(key);
+      if (it != cache->end() && std::filesystem::exists(it->second)) {
+        return it->second;
+      }
+    }
+    auto compiledObject = compiler.compileString({}, source);
+    auto dynamicObject = compiler.link({}, {compiledObject});
+    compiledObjectCache().wlock()->insert_or_assign(key, dynamicObject);
+    return dynamicObject;
+  }
+
+  static folly::Synchronized<
+      std::unordered_map<std::string, std::filesystem::path>>&
+  compiledObjectCache() {
+    static folly::Synchronized<
+        std::unordered_map<std::string, std::filesystem::path>>
+        cache;
+    return cache;
+  }
+
   const std::string& fileFormat() {
     // TODO: Move this into a file
     static const std::string fileFormat_ = R"(
@@ -437,15 +472,18 @@ class CompiledExpressionTransformVisitor {
       const core::FilterNode& filter,
       const Children& children) {
     std::vector<std::pair<size_t, GeneratedExpressionStruct>> generatedColumns;
-    generatedColumns.push_back({0, getGeneratedCode(filter.filter()).value()});
-    if (generatedColumns[0].second.inputRowType().size() == 0) {
-      // it's a constant expression, don't compile it
+    auto filterCode = getGeneratedCode(filter.filter());
+    if (!filterCode.has_value() ||
+        filterCode.value().get().inputRowType().size() == 0) {
+      // The filter uses functions without generated code, evaluate it with
+      // the interpreter. If it's a constant expression, don't compile it.
       return utils::adapter::FilterCopy::copyWith(
           filter,
           std::placeholders::_1,
           std::placeholders::_1,
           *ranges::begin(children));
     }
+    generatedColumns.push_back({0, filterCode.value()});
 
     VELOX_CHECK_EQ(filter.sources().size(), 1);
 
@@ -489,8 +527,7 @@ class CompiledExpressionTransformVisitor {
             fmt::arg(
                 "isDefaultNullStrict",
                 isDefaultNullStrict(filter.id()) ? "true" : "false")));
-    auto compiledObject = codeManager_.compiler().compileString({}, fileString);
-    auto dynamicObject = codeManager_.compiler().link({}, {compiledObject});
+    auto dynamicObject = compileAndLink(fileString);
 
     // Extract the row input expression from the current filter
     const auto inputType = filter.sources()[0]->outputType();
@@ -534,6 +571,17 @@ class CompiledExpressionTransformVisitor {
 
     VELOX_CHECK_EQ(projection.sources().size(), 1);
 
+    if (generatedColumns.empty()) {
+      // No projection has generated code. Evaluate the projections, and the
+      // filter if any, with the interpreter.
+      return utils::adapter::ProjectCopy::copyWith(
+          projection,
+          std::placeholders::_1,
+          std::placeholders::_1,
+          std::placeholders::_1,
+          *ranges::begin(children));
+    }
+
     const auto& outputType = *projection.outputType().get();
 
     std::shared_ptr<RowType> concatInputType;
@@ -588,8 +636,7 @@ class CompiledExpressionTransformVisitor {
                 "isDefaultNullStrict",
                 isDefaultNullStrict ? "true" : "false")));
 
-    auto compiledObject = codeManager_.compiler().compileString({}, fileString);
-    auto dynamicObject = codeManager_.compiler().link({}, {compiledObject});
+    auto dynamicObject = compileAndLink(fileString);
     std::vector<std::shared_ptr<const ITypedExpr>> newProjections;
 
     // Extract the row input expression from the current projection
@@ -30,6 +30,15 @@ TEST_F(CodegenTest, simpleProjectionDefaultNull) {
       {"a + b", "a - b"}, inputRowType, 10, 100);
 };
 
+TEST_F(CodegenTest, repeatedProjection) {
+  // The second run reuses the shared object compiled for the first.
+  auto inputRowType = ROW({"a", "b"}, std::vector<TypePtr>{DOUBLE(), DOUBLE()});
+  for (auto i = 0; i < 2; ++i) {
+    testExpressions<DoubleType, DoubleType>(
+        {"a * b + a", "a / b - b"}, inputRowType, 10, 100);
+  }
+};
+
 TEST_F(CodegenTest, simpleProjectionNotDefaultNull) {
   auto inputRowType = ROW({"a", "b"}, std::vector<TypePtr>{DOUBLE(), DOUBLE()});
   testExpressions<DoubleType, DoubleType>({"a", "b"}, inputRowType, 10, 100);
@@ -88,7 +88,12 @@ GpuAllocator* getHostAllocator(Device* /*device*/) {
 
 // Always returns device 0.
 Device* getDevice(int32_t /*preferredDevice*/) {
-  static Device device(0);
+  static Device device = [] {
+    Device device(0);
+    CUDA_CHECK(cudaDeviceGetAttribute(
+        &device.numSMs, cudaDevAttrMultiProcessorCount, device.deviceId));
+    return device;
+  }();
   return &device;
 }
 
@@ -27,6 +27,9 @@ struct Device {
   explicit Device(int32_t id) : deviceId(id) {}
 
   int32_t deviceId;
+
+  // Number of streaming multiprocessors.
+  int32_t numSMs{0};
 };
 
 /// Checks that the machine has the right capability and returns a Device
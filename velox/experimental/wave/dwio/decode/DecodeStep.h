@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+/// Descriptions of decoding work done on the device. These are plain structs
+/// that are filled in on the host in unified memory and read by the kernels
+/// in GpuDecoder.cuh.
+
+namespace facebook::velox::wave {
+
+enum class DecodeStep {
+  /// Copies values of 'dataBytes' bytes.
+  kTrivial,
+  /// Unpacks bit-packed values and adds a baseline. If there is a
+  /// dictionary, the unpacked values are indices into it.
+  kDictionaryOnBitpack,
+  /// Expands runs of repeated values.
+  kRle,
+  /// Lists the rows of 64 bit values that fall in a range.
+  kBigintRange,
+};
+
+/// One unit of decoding work. All of a GpuDecode is done by one thread block.
+struct GpuDecode {
+  DecodeStep step;
+
+  /// Number of result rows.
+  int32_t numRows;
+
+  /// Width of a result value: 1, 2, 4 or 8.
+  int32_t dataBytes;
+
+  /// Result values, 'numRows' values of 'dataBytes' each. For kBigintRange,
+  /// the passing row numbers as int32_t.
+  void* result;
+
+  struct Trivial {
+    const void* input;
+  };
+
+  /// Values are packed least significant bit first, as in Parquet. 'packed'
+  /// must be readable for 8 bytes past the last packed value.
+  struct DictionaryOnBitpack {
+    const uint64_t* packed;
+    int32_t bitWidth;
+    int64_t baseline;
+    /// Values of 'dataBytes' each, or nullptr if the unpacked values plus
+    /// 'baseline' are the result.
+    const void* dictionary;
+  };
+
+  struct Rle {
+    int32_t numRuns;
+    /// One value of 'dataBytes' per run.
+    const void* values;
+    /// Row number one past the last row of each run, ascending.
+    const int32_t* runEnds;
+  };
+
+  /// 'numRows' values are tested against ['lower', 'upper'].
+  struct BigintRange {
+    const int64_t* input;
+    int64_t lower;
+    int64_t upper;
+    /// Receives the number of passing rows.
+    int32_t* numPassed;
+  };
+
+  union {
+    Trivial trivial;
+    DictionaryOnBitpack dictionaryOnBitpack;
+    Rle rle;
+    BigintRange bigintRange;
+  } data;
+};
+
+} // namespace facebook::velox::wave
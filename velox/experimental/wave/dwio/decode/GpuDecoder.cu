@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/dwio/decode/GpuDecoder.cuh"
+#include "velox/experimental/wave/dwio/decode/GpuDecoder.h"
+
+namespace facebook::velox::wave {
+
+namespace {
+
+constexpr int32_t kDecodeBlockSize = 256;
+
+__global__ void decodeKernel(GpuDecode* ops) {
+  decodeGlobal<kDecodeBlockSize>(ops);
+}
+
+} // namespace
+
+void decodeGlobal(Stream& stream, GpuDecode* ops, int32_t numOps) {
+  if (numOps == 0) {
+    return;
+  }
+  decodeKernel<<<
+      numOps,
+      kDecodeBlockSize,
+      decodeSharedSize<kDecodeBlockSize>(),
+      stream.stream()->stream>>>(ops);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/experimental/wave/common/Block.cuh"
+#include "velox/experimental/wave/common/CudaUtil.cuh"
+#include "velox/experimental/wave/dwio/decode/DecodeStep.h"
+
+namespace facebook::velox::wave {
+
+namespace detail {
+
+template <typename T>
+__device__ inline T loadValue(const void* values, int32_t index) {
+  return reinterpret_cast<const T*>(values)[index];
+}
+
+template <typename T>
+__device__ inline void storeValue(void* values, int32_t index, T value) {
+  reinterpret_cast<T*>(values)[index] = value;
+}
+
+// Returns the 'bitWidth' bits at 'bit' of 'words'. 'bitWidth' is at most 64.
+__device__ inline uint64_t
+loadBits(const uint64_t* words, uint64_t bit, int32_t bitWidth) {
+  auto index = bit / 64;
+  auto shift = bit % 64;
+  uint64_t bits = words[index] >> shift;
+  if (shift + bitWidth > 64) {
+    bits |= words[index + 1] << (64 - shift);
+  }
+  return bitWidth == 64 ? bits : bits & ((1UL << bitWidth) - 1);
+}
+
+template <typename T>
+__device__ void decodeTrivial(GpuDecode& op) {
+  auto& trivial = op.data.trivial;
+  for (auto row = threadIdx.x; row < op.numRows; row += blockDim.x) {
+    storeValue<T>(op.result, row, loadValue<T>(trivial.input, row));
+  }
+}
+
+template <typename T>
+__device__ void decodeDictionaryOnBitpack(GpuDecode& op) {
+  auto& params = op.data.dictionaryOnBitpack;
+  for (auto row = threadIdx.x; row < op.numRows; row += blockDim.x) {
+    auto index = params.baseline +
+        static_cast<int64_t>(loadBits(
+            params.packed,
+            static_cast<uint64_t>(row) * params.bitWidth,
+            params.bitWidth));
+    T value = params.dictionary ? loadValue<T>(params.dictionary, index)
+                                : static_cast<T>(index);
+    storeValue<T>(op.result, row, value);
+  }
+}
+
+template <typename T>
+__device__ void decodeRle(GpuDecode& op) {
+  auto& rle = op.data.rle;
+  for (auto row = threadIdx.x; row < op.numRows; row += blockDim.x) {
+    // First run that ends after 'row'.
+    int32_t low = 0;
+    int32_t high = rle.numRuns;
+    while (low < high) {
+      auto middle = (low + high) / 2;
+      if (rle.runEnds[middle] <= row) {
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+    storeValue<T>(op.result, row, loadValue<T>(rle.values, low));
+  }
+}
+
+template <int32_t kBlockSize>
+__device__ void decodeBigintRange(GpuDecode& op, void* shmem) {
+  auto& range = op.data.bigintRange;
+  auto* rows = reinterpret_cast<int32_t*>(op.result);
+  __shared__ int32_t numPassed;
+  __shared__ int32_t chunkPassed;
+  if (threadIdx.x == 0) {
+    numPassed = 0;
+  }
+  __syncthreads();
+  for (int32_t start = 0; start < op.numRows; start += kBlockSize) {
+    boolBlockToIndices<kBlockSize>(
+        [&]() -> uint8_t {
+          auto row = start + threadIdx.x;
+          if (row >= op.numRows) {
+            return 0;
+          }
+          auto value = range.input[row];
+          return value >= range.lower && value <= range.upper;
+        },
+        start,
+        rows + numPassed,
+        shmem,
+        chunkPassed);
+    __syncthreads();
+    if (threadIdx.x == 0) {
+      numPassed += chunkPassed;
+    }
+    __syncthreads();
+  }
+  if (threadIdx.x == 0) {
+    *range.numPassed = numPassed;
+  }
+}
+
+template <typename T>
+__device__ void decodeStep(GpuDecode& op) {
+  switch (op.step) {
+    case DecodeStep::kTrivial:
+      decodeTrivial<T>(op);
+      break;
+    case DecodeStep::kDictionaryOnBitpack:
+      decodeDictionaryOnBitpack<T>(op);
+      break;
+    case DecodeStep::kRle:
+      decodeRle<T>(op);
+      break;
+    default:
+      break;
+  }
+}
+
+} // namespace detail
+
+/// Runs the GpuDecode at blockIdx.x of 'ops'. Needs dynamic shared memory of
+/// decodeSharedSize<kBlockSize>() bytes.
+template <int32_t kBlockSize>
+__device__ void decodeGlobal(GpuDecode* ops) {
+  extern __shared__ __align__(16) char shmem[];
+  auto& op = ops[blockIdx.x];
+  if (op.step == DecodeStep::kBigintRange) {
+    detail::decodeBigintRange<kBlockSize>(op, shmem);
+    return;
+  }
+  switch (op.dataBytes) {
+    case 1:
+      detail::decodeStep<uint8_t>(op);
+      break;
+    case 2:
+      detail::decodeStep<uint16_t>(op);
+      break;
+    case 4:
+      detail::decodeStep<uint32_t>(op);
+      break;
+    case 8:
+      detail::decodeStep<uint64_t>(op);
+      break;
+  }
+}
+
+template <int32_t kBlockSize>
+constexpr int32_t decodeSharedSize() {
+  return sizeof(typename cub::BlockScan<int, kBlockSize>::TempStorage);
+}
+
+} // namespace facebook::velox::wave
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/experimental/wave/common/GpuArena.h"
+#include "velox/experimental/wave/dwio/decode/GpuDecoder.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::wave;
+
+class GpuDecoderTest : public testing::Test {
+ protected:
+  void SetUp() override {
+    device_ = getDevice();
+    setDevice(device_);
+    allocator_ = getAllocator(device_);
+    arena_ = std::make_unique<GpuArena>(1 << 28, allocator_);
+  }
+
+  // Packs 'values' least significant bit first in 'bitWidth' bits each, with
+  // a word of padding at the end.
+  WaveBufferPtr pack(const std::vector<uint64_t>& values, int32_t bitWidth) {
+    auto numWords = (values.size() * bitWidth + 63) / 64 + 1;
+    auto buffer = arena_->allocate<uint64_t>(numWords);
+    auto* words = buffer->as<uint64_t>();
+    std::fill(words, words + numWords, 0);
+    for (auto i = 0; i < values.size(); ++i) {
+      uint64_t bit = i * bitWidth;
+      words[bit / 64] |= values[i] << (bit % 64);
+      if (bit % 64 + bitWidth > 64) {
+        words[bit / 64 + 1] |= values[i] >> (64 - bit % 64);
+      }
+    }
+    return buffer;
+  }
+
+  Device* device_;
+  GpuAllocator* allocator_;
+  std::unique_ptr<GpuArena> arena_;
+};
+
+TEST_F(GpuDecoderTest, dictionaryOnBitpack) {
+  constexpr int32_t kNumRows = 10'000;
+  for (auto bitWidth : {1, 7, 13, 32, 53}) {
+    SCOPED_TRACE(bitWidth);
+    std::vector<uint64_t> values(kNumRows);
+    for (auto i = 0; i < kNumRows; ++i) {
+      values[i] = (i * 0x9E3779B97F4A7C15UL) >> (64 - bitWidth);
+    }
+    auto packed = pack(values, bitWidth);
+    auto result = arena_->allocate<int64_t>(kNumRows);
+    auto opBuffer = arena_->allocate<GpuDecode>(1);
+    auto* op = opBuffer->as<GpuDecode>();
+    op->step = DecodeStep::kDictionaryOnBitpack;
+    op->numRows = kNumRows;
+    op->dataBytes = sizeof(int64_t);
+    op->result = result->as<int64_t>();
+    op->data.dictionaryOnBitpack.packed = packed->as<uint64_t>();
+    op->data.dictionaryOnBitpack.bitWidth = bitWidth;
+    op->data.dictionaryOnBitpack.baseline = -100;
+    op->data.dictionaryOnBitpack.dictionary = nullptr;
+    Stream stream;
+    decodeGlobal(stream, op, 1);
+    stream.wait();
+    for (auto i = 0; i < kNumRows; ++i) {
+      ASSERT_EQ(values[i] - 100, result->as<int64_t>()[i]) << i;
+    }
+  }
+}
+
+TEST_F(GpuDecoderTest, dictionary) {
+  constexpr int32_t kNumRows = 5'000;
+  constexpr int32_t kDictionarySize = 100;
+  auto dictionary = arena_->allocate<int32_t>(kDictionarySize);
+  for (auto i = 0; i < kDictionarySize; ++i) {
+    dictionary->as<int32_t>()[i] = i * 1'000 + 7;
+  }
+  std::vector<uint64_t> indices(kNumRows);
+  for (auto i = 0; i < kNumRows; ++i) {
+    indices[i] = (i * 31) % kDictionarySize;
+  }
+  auto packed = pack(indices, 7);
+  auto result = arena_->allocate<int32_t>(kNumRows);
+  auto opBuffer = arena_->allocate<GpuDecode>(1);
+  auto* op = opBuffer->as<GpuDecode>();
+  op->step = DecodeStep::kDictionaryOnBitpack;
+  op->numRows = kNumRows;
+  op->dataBytes = sizeof(int32_t);
+  op->result = result->as<int32_t>();
+  op->data.dictionaryOnBitpack.packed = packed->as<uint64_t>();
+  op->data.dictionaryOnBitpack.bitWidth = 7;
+  op->data.dictionaryOnBitpack.baseline = 0;
+  op->data.dictionaryOnBitpack.dictionary = dictionary->as<int32_t>();
+  Stream stream;
+  decodeGlobal(stream, op, 1);
+  stream.wait();
+  for (auto i = 0; i < kNumRows; ++i) {
+    ASSERT_EQ(indices[i] * 1'000 + 7, result->as<int32_t>()[i]) << i;
+  }
+}
+
+TEST_F(GpuDecoderTest, rleAndTrivial) {
+  // Runs of length 1, 2, 3... with value equal to the length.
+  constexpr int32_t kNumRuns = 100;
+  auto values = arena_->allocate<int16_t>(kNumRuns);
+  auto runEnds = arena_->allocate<int32_t>(kNumRuns);
+  std::vector<int16_t> expected;
+  for (auto i = 0; i < kNumRuns; ++i) {
+    values->as<int16_t>()[i] = i + 1;
+    expected.insert(expected.end(), i + 1, i + 1);
+    runEnds->as<int32_t>()[i] = expected.size();
+  }
+  const int32_t numRows = expected.size();
+  auto rleResult = arena_->allocate<int16_t>(numRows);
+  auto trivialResult = arena_->allocate<int16_t>(numRows);
+  auto opBuffer = arena_->allocate<GpuDecode>(2);
+  auto* ops = opBuffer->as<GpuDecode>();
+  ops[0].step = DecodeStep::kRle;
+  ops[0].numRows = numRows;
+  ops[0].dataBytes = sizeof(int16_t);
+  ops[0].result = rleResult->as<int16_t>();
+  ops[0].data.rle.numRuns = kNumRuns;
+  ops[0].data.rle.values = values->as<int16_t>();
+  ops[0].data.rle.runEnds = runEnds->as<int32_t>();
+  ops[1].step = DecodeStep::kTrivial;
+  ops[1].numRows = numRows;
+  ops[1].dataBytes = sizeof(int16_t);
+  ops[1].result = trivialResult->as<int16_t>();
+  auto input = arena_->allocate<int16_t>(numRows);
+  std::copy(expected.begin(), expected.end(), input->as<int16_t>());
+  ops[1].data.trivial.input = input->as<int16_t>();
+  Stream stream;
+  decodeGlobal(stream, ops, 2);
+  stream.wait();
+  for (auto i = 0; i < numRows; ++i) {
+    ASSERT_EQ(expected[i], rleResult->as<int16_t>()[i]) << i;
+    ASSERT_EQ(expected[i], trivialResult->as<int16_t>()[i]) << i;
+  }
+}
+
+TEST_F(GpuDecoderTest, bigintRange) {
+  constexpr int32_t kNumRows = 3'000;
+  auto input = arena_->allocate<int64_t>(kNumRows);
+  std::vector<int32_t> expected;
+  for (auto i = 0; i < kNumRows; ++i) {
+    input->as<int64_t>()[i] = (i * 7919) % 1'000;
+    if (input->as<int64_t>()[i] >= 100 && input->as<int64_t>()[i] <= 300) {
+      expected.push_back(i);
+    }
+  }
+  auto rows = arena_->allocate<int32_t>(kNumRows);
+  auto numPassed = arena_->allocate<int32_t>(1);
+  auto opBuffer = arena_->allocate<GpuDecode>(1);
+  auto* op = opBuffer->as<GpuDecode>();
+  op->step = DecodeStep::kBigintRange;
+  op->numRows = kNumRows;
+  op->dataBytes = sizeof(int64_t);
+  op->result = rows->as<int32_t>();
+  op->data.bigintRange.input = input->as<int64_t>();
+  op->data.bigintRange.lower = 100;
+  op->data.bigintRange.upper = 300;
+  op->data.bigintRange.numPassed = numPassed->as<int32_t>();
+  Stream stream;
+  decodeGlobal(stream, op, 1);
+  stream.wait();
+  ASSERT_EQ(expected.size(), *numPassed->as<int32_t>());
+  for (auto i = 0; i < expected.size(); ++i) {
+    ASSERT_EQ(expected[i], rows->as<int32_t>()[i]) << i;
+  }
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/exec/CostModel.h"
+
+#include <folly/container/F14Map.h>
+#include <glog/logging.h>
+#include <gflags/gflags.h>
+#include <algorithm>
+#include <mutex>
+
+#include "velox/experimental/wave/common/Cuda.h"
+#include "velox/experimental/wave/vector/Operand.h"
+
+DEFINE_bool(
+    velox_wave_cost_model,
+    true,
+    "Run a Driver segment in Wave only if it is estimated to be faster");
+
+DEFINE_double(
+    velox_wave_cpu_row_op_nanos,
+    1.0,
+    "Estimated CPU time for one expression node or operator on one row");
+
+DEFINE_double(
+    velox_wave_gpu_row_op_nanos,
+    0.02,
+    "Estimated GPU time for one expression node or operator on one row with "
+    "the device fully occupied");
+
+DEFINE_double(
+    velox_wave_launch_micros,
+    10,
+    "Estimated fixed cost of a kernel launch or transfer");
+
+DEFINE_double(
+    velox_wave_transfer_gb_per_second,
+    10,
+    "Estimated host to device transfer bandwidth");
+
+namespace facebook::velox::wave {
+
+namespace {
+
+struct History {
+  int64_t numRows{0};
+  uint64_t micros{0};
+};
+
+std::mutex& historyMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+folly::F14FastMap<std::string, History>& history() {
+  static auto* history = new folly::F14FastMap<std::string, History>();
+  return *history;
+}
+
+int64_t workPerRow(const SegmentCost& segment) {
+  return segment.numExprNodes + segment.numOperators;
+}
+
+} // namespace
+
+// static
+double WaveCostModel::cpuMicros(const SegmentCost& segment) {
+  return segment.numRows * workPerRow(segment) *
+      FLAGS_velox_wave_cpu_row_op_nanos / 1000;
+}
+
+// static
+double WaveCostModel::gpuMicros(const SegmentCost& segment) {
+  auto numLaunches = segment.numBatches * std::max(1, segment.numOperators);
+  // A batch with fewer thread blocks than the device has multiprocessors
+  // leaves the rest of the device idle.
+  double occupancy = 1;
+  if (segment.numBatches > 0) {
+    auto blocksPerBatch =
+        static_cast<double>(segment.numRows) / segment.numBatches / kBlockSize;
+    occupancy = std::clamp(
+        blocksPerBatch / std::max(1, getDevice()->numSMs), 0.01, 1.0);
+  }
+  // GB/s is bytes per ns.
+  auto transferMicros =
+      segment.transferBytes / FLAGS_velox_wave_transfer_gb_per_second / 1000;
+  auto computeMicros = segment.numRows * workPerRow(segment) *
+      FLAGS_velox_wave_gpu_row_op_nanos / occupancy / 1000;
+  return numLaunches * FLAGS_velox_wave_launch_micros + transferMicros +
+      computeMicros;
+}
+
+// static
+bool WaveCostModel::shouldOffload(
+    const std::string& key,
+    const SegmentCost& segment) {
+  if (!FLAGS_velox_wave_cost_model) {
+    return true;
+  }
+  auto gpu = gpuMicros(segment);
+  {
+    std::lock_guard<std::mutex> l(historyMutex());
+    auto it = history().find(key);
+    if (it != history().end() && it->second.numRows > 0) {
+      gpu = static_cast<double>(it->second.micros) / it->second.numRows *
+          segment.numRows;
+    }
+  }
+  auto cpu = cpuMicros(segment);
+  VLOG(1) << "Wave segment estimate: CPU " << cpu << "us, GPU " << gpu
+          << "us";
+  return gpu < cpu;
+}
+
+// static
+void WaveCostModel::recordRun(
+    const std::string& key,
+    int64_t numRows,
+    uint64_t micros) {
+  std::lock_guard<std::mutex> l(historyMutex());
+  auto& entry = history()[key];
+  entry.numRows += numRows;
+  entry.micros += micros;
+}
+
+// static
+void WaveCostModel::clearHistory() {
+  std::lock_guard<std::mutex> l(historyMutex());
+  history().clear();
+}
+
+} // namespace facebook::velox::wave
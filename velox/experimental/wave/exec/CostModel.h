@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <gflags/gflags.h>
+#include <cstdint>
+#include <string>
+
+DECLARE_bool(velox_wave_cost_model);
+
+namespace facebook::velox::wave {
+
+/// The work of a sequence of Operators of a Driver considered for running in
+/// Wave.
+struct SegmentCost {
+  /// Rows produced by the source of the segment.
+  int64_t numRows{0};
+  /// Batches produced by the source. Each is a separate kernel launch per
+  /// Operator.
+  int64_t numBatches{0};
+  /// Bytes transferred to the device and back.
+  int64_t transferBytes{0};
+  /// Expression nodes evaluated per row.
+  int32_t numExprNodes{0};
+  int32_t numOperators{0};
+};
+
+/// Decides between CPU and GPU for a segment. The CPU time is estimated from
+/// the per row work. The GPU time is estimated from kernel launches,
+/// transfers and per row work scaled by the fraction of the device a batch
+/// occupies. Once runs of the same segment have completed on the GPU, their
+/// observed time per row replaces the GPU estimate, so that a segment that
+/// turns out slow on the GPU falls back to CPU in later Drivers.
+class WaveCostModel {
+ public:
+  /// True if 'segment' is expected to run faster on the GPU. 'key' identifies
+  /// the segment across Drivers.
+  static bool shouldOffload(const std::string& key, const SegmentCost& segment);
+
+  /// Records a GPU run of the segment 'key' over 'numRows' source rows.
+  static void
+  recordRun(const std::string& key, int64_t numRows, uint64_t micros);
+
+  static double cpuMicros(const SegmentCost& segment);
+
+  static double gpuMicros(const SegmentCost& segment);
+
+  /// Forgets recorded runs. Used in tests.
+  static void clearHistory();
+};
+
+} // namespace facebook::velox::wave
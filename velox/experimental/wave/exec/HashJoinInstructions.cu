@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/exec/HashJoinInstructions.h"
+
+#include "velox/experimental/wave/common/CudaUtil.cuh"
+#include "velox/experimental/wave/common/Hash.h"
+#include "velox/experimental/wave/exec/WaveCore.cuh"
+
+namespace facebook::velox::wave::hashjoin {
+
+namespace {
+
+struct BlockInfo {
+  int base;
+};
+
+struct Word16 {
+  int64_t low;
+  int64_t high;
+};
+
+__device__ inline bool isNullAt(const Operand* op, int32_t row) {
+  return op->nulls != nullptr && op->nulls[row] == kNull;
+}
+
+__device__ inline int64_t keyAt(
+    PhysicalType::Kind kind,
+    Operand* key,
+    int32_t blockBase) {
+  if (kind == PhysicalType::kInt32) {
+    return value<int32_t>(key, blockBase, nullptr);
+  }
+  return value<int64_t>(key, blockBase, nullptr);
+}
+
+__device__ inline uint32_t hashKey(int64_t key) {
+  return IntHasher32<int64_t>()(key);
+}
+
+// Waits for a slot claimed by another thread to get its key. Kept out of the
+// branch that claims slots, see IdMap::ensureIdReady().
+__device__ void ensureSlotReady(volatile const int32_t* state) {
+  if (*state != JoinTable::kClaimedSlot) {
+    return;
+  }
+  auto t0 = clock64();
+  while (*state == JoinTable::kClaimedSlot) {
+    assert(clock64() - t0 < 1'000'000);
+  }
+}
+
+__device__ ErrorCode run(BlockInfo* block, BuildInsert* insert) {
+  auto row = block->base + threadIdx.x;
+  if (row >= insert->key->size) {
+    return ErrorCode::kOk;
+  }
+  auto* table = insert->table;
+  // Null keys never match.
+  if (isNullAt(insert->key, row)) {
+    table->next[row] = -1;
+    return ErrorCode::kOk;
+  }
+  auto key = keyAt(insert->keyKind, insert->key, block->base);
+  auto mask = table->capacity - 1;
+  for (auto i = hashKey(key) & mask;; i = (i + 1) & mask) {
+    if (table->states[i] == JoinTable::kEmptySlot &&
+        atomicCAS(
+            &table->states[i],
+            JoinTable::kEmptySlot,
+            JoinTable::kClaimedSlot) == JoinTable::kEmptySlot) {
+      table->keys[i] = key;
+      __threadfence();
+      atomicExch(&table->states[i], JoinTable::kReadySlot);
+    }
+    ensureSlotReady(&table->states[i]);
+    if (table->keys[i] == key) {
+      table->next[row] = atomicExch(&table->heads[i], row);
+      return ErrorCode::kOk;
+    }
+  }
+}
+
+__device__ ErrorCode run(BlockInfo* block, Probe* probe) {
+  auto row = block->base + threadIdx.x;
+  if (row >= probe->key->size || isNullAt(probe->key, row)) {
+    return ErrorCode::kOk;
+  }
+  auto* table = probe->table;
+  auto key = keyAt(probe->keyKind, probe->key, block->base);
+  auto mask = table->capacity - 1;
+  for (auto i = hashKey(key) & mask;; i = (i + 1) & mask) {
+    if (table->states[i] == JoinTable::kEmptySlot) {
+      return ErrorCode::kOk;
+    }
+    if (table->keys[i] != key) {
+      continue;
+    }
+    for (auto buildRow = table->heads[i]; buildRow != -1;
+         buildRow = table->next[buildRow]) {
+      auto resultRow = atomicAdd(probe->numResults, 1);
+      if (resultRow < probe->capacity) {
+        probe->probeRows[resultRow] = row;
+        probe->buildRows[resultRow] = buildRow;
+      }
+    }
+    return ErrorCode::kOk;
+  }
+}
+
+template <typename T>
+__device__ void gatherValue(Gather* gather, int32_t resultRow) {
+  auto row = gather->rows[resultRow];
+  reinterpret_cast<T*>(gather->result->base)[resultRow] =
+      value<T>(gather->input, row);
+}
+
+__device__ ErrorCode run(BlockInfo* block, Gather* gather) {
+  auto resultRow = block->base + threadIdx.x;
+  if (resultRow >= gather->numRows) {
+    return ErrorCode::kOk;
+  }
+  switch (gather->elementSize) {
+    case 1:
+      gatherValue<int8_t>(gather, resultRow);
+      break;
+    case 2:
+      gatherValue<int16_t>(gather, resultRow);
+      break;
+    case 4:
+      gatherValue<int32_t>(gather, resultRow);
+      break;
+    case 8:
+      gatherValue<int64_t>(gather, resultRow);
+      break;
+    case 16:
+      gatherValue<Word16>(gather, resultRow);
+      break;
+    default:
+      return ErrorCode::kError;
+  }
+  if (gather->result->nulls) {
+    gather->result->nulls[resultRow] =
+        isNullAt(gather->input, gather->rows[resultRow]) ? kNull : kNotNull;
+  }
+  return ErrorCode::kOk;
+}
+
+__global__ void runPrograms(
+    ThreadBlockProgram* programs,
+    int32_t* baseIndices,
+    BlockStatus* blockStatusArray) {
+  int baseIndex = baseIndices ? baseIndices[blockIdx.x] : 0;
+  BlockInfo block = {
+      .base = (int)(blockDim.x * (blockIdx.x - baseIndex)),
+  };
+  auto& status = blockStatusArray[blockIdx.x];
+  auto& program = programs[blockIdx.x];
+  for (auto i = 0; i < program.numInstructions; ++i) {
+    if (status.errors[threadIdx.x] != ErrorCode::kOk) {
+      break;
+    }
+    auto& instruction = program.instructions[i];
+    switch (instruction.opCode) {
+      case OpCode::kBuildInsert:
+        status.errors[threadIdx.x] = run(&block, &instruction._.buildInsert);
+        break;
+      case OpCode::kProbe:
+        status.errors[threadIdx.x] = run(&block, &instruction._.probe);
+        break;
+      case OpCode::kGather:
+        status.errors[threadIdx.x] = run(&block, &instruction._.gather);
+        break;
+      default:
+        status.errors[threadIdx.x] = ErrorCode::kError;
+    }
+  }
+  assert(status.errors[threadIdx.x] == ErrorCode::kOk);
+}
+
+} // namespace
+
+void call(
+    Stream& stream,
+    int numBlocks,
+    ThreadBlockProgram* programs,
+    int32_t* baseIndices,
+    BlockStatus* status) {
+  runPrograms<<<numBlocks, kBlockSize, 0, stream.stream()->stream>>>(
+      programs, baseIndices, status);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+} // namespace facebook::velox::wave::hashjoin
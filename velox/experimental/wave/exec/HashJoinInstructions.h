@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/experimental/wave/common/Cuda.h"
+#include "velox/experimental/wave/common/Type.h"
+#include "velox/experimental/wave/exec/ErrorCode.h"
+#include "velox/experimental/wave/vector/Operand.h"
+
+namespace facebook::velox::wave::hashjoin {
+
+/// Open addressing table over the build side of a join on one integer key.
+/// Keys are widened to int64_t. Build rows with equal keys are chained
+/// through 'next', starting at 'heads' of the slot of the key.
+struct JoinTable {
+  static constexpr int32_t kEmptySlot = 0;
+  static constexpr int32_t kClaimedSlot = 1;
+  static constexpr int32_t kReadySlot = 2;
+
+  // Number of slots. Power of two.
+  int32_t capacity;
+  // State of each slot, one of the k*Slot constants.
+  int32_t* states;
+  int64_t* keys;
+  // First build row of each slot, -1 if none.
+  int32_t* heads;
+  // Next build row with the same key, -1 at the end of the chain. One entry
+  // per build row.
+  int32_t* next;
+  int32_t numBuildRows;
+};
+
+/// Inserts the rows of 'key' into 'table'. Row i of 'key' is build row i.
+struct BuildInsert {
+  JoinTable* table;
+  PhysicalType::Kind keyKind;
+  Operand* key;
+};
+
+/// Lists the matches of the rows of 'key' in 'table' as pairs of probe and
+/// build rows. Matches past 'capacity' are counted in 'numResults' but not
+/// written, so that the caller can retry with enough space.
+struct Probe {
+  JoinTable* table;
+  PhysicalType::Kind keyKind;
+  Operand* key;
+  int32_t capacity;
+  int32_t* numResults;
+  int32_t* probeRows;
+  int32_t* buildRows;
+};
+
+/// Copies the values of 'input' at 'rows' to 'result'. Values are moved as
+/// 'elementSize' byte words.
+struct Gather {
+  int32_t numRows;
+  int32_t* rows;
+  int32_t elementSize;
+  Operand* input;
+  Operand* result;
+};
+
+enum class OpCode {
+  kBuildInsert,
+  kProbe,
+  kGather,
+};
+
+struct Instruction {
+  OpCode opCode;
+  union {
+    BuildInsert buildInsert;
+    Probe probe;
+    Gather gather;
+  } _;
+};
+
+struct ThreadBlockProgram {
+  int32_t numInstructions;
+  Instruction* instructions;
+};
+
+/// Runs 'programs' with one thread per row. 'baseIndices' gives for each
+/// thread block the index of the first block running the same program, as
+/// in aggregation::call().
+void call(
+    Stream& stream,
+    int numBlocks,
+    ThreadBlockProgram* programs,
+    int32_t* baseIndices,
+    BlockStatus* status);
+
+} // namespace facebook::velox::wave::hashjoin
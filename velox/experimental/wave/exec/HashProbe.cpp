@@ -0,0 +1,407 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/exec/HashProbe.h"
+
+#include "velox/exec/Operator.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+#include "velox/experimental/wave/exec/Vectors.h"
+#include "velox/experimental/wave/exec/WaveDriver.h"
+
+namespace facebook::velox::wave {
+
+namespace {
+
+constexpr int32_t kMinTableCapacity = 16;
+constexpr int32_t kListRowsBatch = 1024;
+
+bool isJoinKeyType(const Type& type) {
+  return type.kind() == TypeKind::INTEGER || type.kind() == TypeKind::BIGINT;
+}
+
+// True if the values of 'type' can be gathered as fixed size words.
+bool isGatherable(const Type& type) {
+  return type.isPrimitiveType() && type.isFixedWidth() &&
+      type.kind() != TypeKind::BOOLEAN;
+}
+
+int32_t numBlocksFor(int32_t numRows) {
+  return (numRows + kBlockSize - 1) / kBlockSize;
+}
+
+} // namespace
+
+HashProbe::HashProbe(
+    CompileState& state,
+    const core::HashJoinNode& node,
+    std::shared_ptr<exec::HashJoinBridge> joinBridge)
+    : WaveOperator(state, node.outputType()),
+      arena_(&state.arena()),
+      joinBridge_(std::move(joinBridge)) {
+  VELOX_CHECK(canRun(node));
+  auto& probeType = node.sources()[0]->outputType();
+  auto& buildType = node.sources()[1]->outputType();
+  probeKeyChannel_ = exec::exprToChannel(node.leftKeys()[0].get(), probeType);
+  VELOX_CHECK_NE(probeKeyChannel_, kConstantChannel);
+  keyKind_ = fromCpuType(*probeType->childAt(probeKeyChannel_)).kind;
+
+  // Same column order as the RowContainer of the table made by HashBuild.
+  auto buildKeyChannel =
+      exec::exprToChannel(node.rightKeys()[0].get(), buildType);
+  VELOX_CHECK_NE(buildKeyChannel, kConstantChannel);
+  std::vector<std::string> names{buildType->nameOf(buildKeyChannel)};
+  std::vector<TypePtr> types{buildType->childAt(buildKeyChannel)};
+  for (auto i = 0; i < buildType->size(); ++i) {
+    if (i != buildKeyChannel) {
+      names.push_back(buildType->nameOf(i));
+      types.push_back(buildType->childAt(i));
+    }
+  }
+  buildTableType_ = ROW(std::move(names), std::move(types));
+
+  for (auto i = 0; i < outputType_->size(); ++i) {
+    auto& name = outputType_->nameOf(i);
+    if (auto channel = probeType->getChildIdxIfExists(name)) {
+      outputColumns_.push_back({false, static_cast<int32_t>(channel.value())});
+    } else {
+      outputColumns_.push_back(
+          {true, static_cast<int32_t>(buildTableType_->getChildIdx(name))});
+    }
+  }
+}
+
+HashProbe::~HashProbe() {
+  if (flushStream_) {
+    WaveStream::releaseStream(std::move(flushStream_));
+  }
+}
+
+// static
+bool HashProbe::canRun(const core::HashJoinNode& node) {
+  if (!node.isInnerJoin() || node.filter() || node.leftKeys().size() != 1) {
+    return false;
+  }
+  auto& probeKeyType = node.leftKeys()[0]->type();
+  auto& buildKeyType = node.rightKeys()[0]->type();
+  if (!isJoinKeyType(*probeKeyType) ||
+      !probeKeyType->equivalent(*buildKeyType)) {
+    return false;
+  }
+  // The build side is copied row by row from the CPU table and all output is
+  // gathered, so all columns must be fixed width.
+  for (auto& type : node.sources()[1]->outputType()->children()) {
+    if (!isGatherable(*type)) {
+      return false;
+    }
+  }
+  for (auto& type : node.outputType()->children()) {
+    if (!isGatherable(*type)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+exec::BlockingReason HashProbe::isBlocked(ContinueFuture* future) {
+  if (tableLoaded_) {
+    return exec::BlockingReason::kNotBlocked;
+  }
+  auto buildResult = joinBridge_->tableOrFuture(future);
+  if (!buildResult.has_value()) {
+    return exec::BlockingReason::kWaitForJoinBuild;
+  }
+  VELOX_CHECK(
+      !buildResult->restoredPartitionId.has_value(),
+      "Wave HashProbe does not support spilled builds");
+  VELOX_CHECK_NOT_NULL(buildResult->table);
+  loadTable(*buildResult->table);
+  tableLoaded_ = true;
+  return exec::BlockingReason::kNotBlocked;
+}
+
+void HashProbe::loadTable(exec::BaseHashTable& table) {
+  std::vector<char*> rows;
+  exec::BaseHashTable::RowsIterator iter;
+  for (;;) {
+    auto numListed = rows.size();
+    rows.resize(numListed + kListRowsBatch);
+    auto numRows = table.listAllRows(
+        &iter,
+        kListRowsBatch,
+        std::numeric_limits<uint64_t>::max(),
+        rows.data() + numListed);
+    rows.resize(numListed + numRows);
+    if (numRows == 0) {
+      break;
+    }
+  }
+  const int32_t numRows = rows.size();
+
+  buildColumns_.resize(buildTableType_->size());
+  for (auto i = 0; i < buildTableType_->size(); ++i) {
+    auto& type = buildTableType_->childAt(i);
+    auto vector = BaseVector::create(type, numRows, driver_->pool());
+    table.rows()->extractColumn(rows.data(), numRows, i, vector);
+    auto& column = buildColumns_[i];
+    ensureWaveVector(column, type, numRows, vector->mayHaveNulls(), *arena_);
+    if (numRows == 0) {
+      continue;
+    }
+    memcpy(
+        column->values<char>(),
+        vector->values()->as<char>(),
+        numRows * type->cppSizeInBytes());
+    if (auto* nulls = column->nulls()) {
+      for (auto row = 0; row < numRows; ++row) {
+        nulls[row] = vector->isNullAt(row) ? kNull : kNotNull;
+      }
+    }
+  }
+
+  auto capacity = std::max<int32_t>(
+      bits::nextPowerOfTwo(2 * numRows), kMinTableCapacity);
+  table_ = arena_->allocate<hashjoin::JoinTable>(
+      1, tableBuffers_.emplace_back());
+  table_->capacity = capacity;
+  table_->states =
+      arena_->allocate<int32_t>(capacity, tableBuffers_.emplace_back());
+  memset(table_->states, 0, capacity * sizeof(int32_t));
+  table_->keys =
+      arena_->allocate<int64_t>(capacity, tableBuffers_.emplace_back());
+  table_->heads =
+      arena_->allocate<int32_t>(capacity, tableBuffers_.emplace_back());
+  // All bits set is -1, the empty chain.
+  memset(table_->heads, 0xff, capacity * sizeof(int32_t));
+  table_->next = arena_->allocate<int32_t>(
+      std::max<int32_t>(numRows, 1), tableBuffers_.emplace_back());
+  table_->numBuildRows = numRows;
+  if (numRows == 0) {
+    return;
+  }
+
+  std::vector<WaveBufferPtr> buffers;
+  auto* instruction =
+      arena_->allocate<hashjoin::Instruction>(1, buffers.emplace_back());
+  instruction->opCode = hashjoin::OpCode::kBuildInsert;
+  auto& insert = instruction->_.buildInsert;
+  insert.table = table_;
+  insert.keyKind = keyKind_;
+  insert.key = arena_->allocate<Operand>(1, buffers.emplace_back());
+  buildColumns_[0]->toOperand(insert.key);
+  auto numBlocks = numBlocksFor(numRows);
+  auto* programs = arena_->allocate<hashjoin::ThreadBlockProgram>(
+      numBlocks, buffers.emplace_back());
+  for (auto i = 0; i < numBlocks; ++i) {
+    programs[i].numInstructions = 1;
+    programs[i].instructions = instruction;
+  }
+  auto* status =
+      arena_->allocate<BlockStatus>(numBlocks, buffers.emplace_back());
+  bzero(status, numBlocks * sizeof(BlockStatus));
+  Stream stream;
+  hashjoin::call(stream, numBlocks, programs, nullptr, status);
+  stream.wait();
+}
+
+void HashProbe::prepareBatch(Batch& batch, int32_t capacity) {
+  batch.capacity = capacity;
+  *arena_->allocate<int32_t>(1, batch.numResults) = 0;
+  arena_->allocate<int32_t>(capacity, batch.probeRows);
+  arena_->allocate<int32_t>(capacity, batch.buildRows);
+}
+
+void HashProbe::probe(folly::Range<Batch*> batches) {
+  int32_t numBlocks = 0;
+  for (auto& batch : batches) {
+    numBlocks += numBlocksFor(batch.input->size());
+  }
+  if (numBlocks == 0) {
+    return;
+  }
+  auto* programs = arena_->allocate<hashjoin::ThreadBlockProgram>(
+      numBlocks, flushBuffers_.emplace_back());
+  auto* baseIndices =
+      arena_->allocate<int32_t>(numBlocks, flushBuffers_.emplace_back());
+  auto* instructions = arena_->allocate<hashjoin::Instruction>(
+      batches.size(), flushBuffers_.emplace_back());
+  auto* status =
+      arena_->allocate<BlockStatus>(numBlocks, flushBuffers_.emplace_back());
+  bzero(status, numBlocks * sizeof(BlockStatus));
+  int32_t block = 0;
+  for (auto i = 0; i < batches.size(); ++i) {
+    auto& batch = batches[i];
+    instructions[i].opCode = hashjoin::OpCode::kProbe;
+    auto& probe = instructions[i]._.probe;
+    probe.table = table_;
+    probe.keyKind = keyKind_;
+    probe.key = arena_->allocate<Operand>(1, batch.key);
+    batch.input->childAt(probeKeyChannel_).toOperand(probe.key);
+    probe.capacity = batch.capacity;
+    probe.numResults = batch.numResults->as<int32_t>();
+    probe.probeRows = batch.probeRows->as<int32_t>();
+    probe.buildRows = batch.buildRows->as<int32_t>();
+    auto batchBlocks = numBlocksFor(batch.input->size());
+    for (auto j = 0; j < batchBlocks; ++j) {
+      programs[block + j].numInstructions = 1;
+      programs[block + j].instructions = &instructions[i];
+      baseIndices[block + j] = block;
+    }
+    block += batchBlocks;
+  }
+  hashjoin::call(*flushStream_, numBlocks, programs, baseIndices, status);
+}
+
+void HashProbe::waitProbeDone() {
+  flushDone_.wait();
+  std::vector<Batch> retry;
+  for (auto& batch : inputs_) {
+    auto numResults = batch.numResultRows();
+    if (numResults > batch.capacity) {
+      prepareBatch(batch, numResults);
+      retry.push_back(std::move(batch));
+    } else if (numResults > 0) {
+      ready_.push_back(std::move(batch));
+    }
+  }
+  inputs_.clear();
+  if (!retry.empty()) {
+    VLOG(1) << "Probe again " << retry.size() << " batches";
+    probe(folly::Range(retry.data(), retry.size()));
+    flushDone_.record(*flushStream_);
+    flushDone_.wait();
+    for (auto& batch : retry) {
+      VELOX_CHECK_LE(batch.numResultRows(), batch.capacity);
+      ready_.push_back(std::move(batch));
+    }
+  }
+  flushBuffers_.clear();
+}
+
+void HashProbe::flush(bool noMoreInput) {
+  if (noMoreInput) {
+    noMoreInput_ = true;
+  } else {
+    VELOX_CHECK(!noMoreInput_);
+  }
+  VELOX_CHECK(tableLoaded_);
+  if (!inputs_.empty()) {
+    VELOX_CHECK(flushStream_);
+    if (!noMoreInput && !flushDone_.query()) {
+      return;
+    }
+    waitProbeDone();
+  }
+  if (buffered_.empty()) {
+    return;
+  }
+  if (!flushStream_) {
+    flushStream_ = WaveStream::streamFromReserve();
+  }
+  VLOG(1) << "Probe " << buffered_.size() << " batches";
+  for (auto& input : buffered_) {
+    Batch batch;
+    batch.input = std::move(input);
+    // An inner join on a unique build key has at most one match per row.
+    prepareBatch(batch, std::max<int32_t>(batch.input->size(), 1));
+    inputs_.push_back(std::move(batch));
+  }
+  buffered_.clear();
+  probe(folly::Range(inputs_.data(), inputs_.size()));
+  flushDone_.record(*flushStream_);
+  if (noMoreInput) {
+    waitProbeDone();
+  }
+}
+
+int32_t HashProbe::canAdvance() {
+  if (!inputs_.empty() && (noMoreInput_ || flushDone_.query())) {
+    waitProbeDone();
+  }
+  return ready_.empty() ? 0 : ready_.front().numResultRows();
+}
+
+void HashProbe::schedule(WaveStream& waveStream, int32_t maxRows) {
+  VELOX_CHECK(!ready_.empty());
+  auto batch = std::move(ready_.front());
+  ready_.pop_front();
+  const auto numRows = batch.numResultRows();
+  const int32_t numColumns = outputColumns_.size();
+  const auto blocksPerColumn = numBlocksFor(numRows);
+  const auto numBlocks = numColumns * blocksPerColumn;
+  auto exec = std::make_unique<Executable>();
+  auto* programs = arena_->allocate<hashjoin::ThreadBlockProgram>(
+      numBlocks, exec->deviceData.emplace_back());
+  auto* baseIndices =
+      arena_->allocate<int32_t>(numBlocks, exec->deviceData.emplace_back());
+  auto* instructions = arena_->allocate<hashjoin::Instruction>(
+      numColumns, exec->deviceData.emplace_back());
+  auto* status =
+      arena_->allocate<BlockStatus>(numBlocks, exec->deviceData.emplace_back());
+  bzero(status, numBlocks * sizeof(BlockStatus));
+  auto* inputOperands =
+      arena_->allocate<Operand>(numColumns, exec->deviceData.emplace_back());
+  exec->operands =
+      arena_->allocate<Operand>(numColumns, exec->deviceData.emplace_back());
+  exec->outputOperands = outputIds_;
+  exec->output.resize(numColumns);
+  for (auto i = 0; i < numColumns; ++i) {
+    auto& column = outputColumns_[i];
+    auto& source = column.fromBuild ? *buildColumns_[column.channel]
+                                    : batch.input->childAt(column.channel);
+    auto& type = outputType_->childAt(i);
+    auto ordinal = outputIds_.ordinal(defines(Value(subfields_[i]))->id);
+    auto result = WaveVector::create(type, *arena_);
+    result->resize(numRows, source.mayHaveNulls());
+    source.toOperand(&inputOperands[i]);
+    result->toOperand(&exec->operands[ordinal]);
+    instructions[i].opCode = hashjoin::OpCode::kGather;
+    auto& gather = instructions[i]._.gather;
+    gather.numRows = numRows;
+    gather.rows = column.fromBuild ? batch.buildRows->as<int32_t>()
+                                   : batch.probeRows->as<int32_t>();
+    gather.elementSize = type->cppSizeInBytes();
+    gather.input = &inputOperands[i];
+    gather.result = &exec->operands[ordinal];
+    for (auto j = 0; j < blocksPerColumn; ++j) {
+      auto block = i * blocksPerColumn + j;
+      programs[block].numInstructions = 1;
+      programs[block].instructions = &instructions[i];
+      baseIndices[block] = i * blocksPerColumn;
+    }
+    exec->output[ordinal] = std::move(result);
+  }
+  // The probe input and the match lists are read by the gathers.
+  exec->deviceData.push_back(std::move(batch.numResults));
+  exec->deviceData.push_back(std::move(batch.probeRows));
+  exec->deviceData.push_back(std::move(batch.buildRows));
+  exec->deviceData.push_back(std::move(batch.key));
+  exec->intermediates.push_back(std::move(batch.input));
+  waveStream.installExecutables(
+      folly::Range(&exec, 1),
+      [&](Stream* stream, folly::Range<Executable**> exes) {
+        hashjoin::call(*stream, numBlocks, programs, baseIndices, status);
+        waveStream.markLaunch(*stream, *exes[0]);
+      });
+  outputSizes_[&waveStream] = numRows;
+}
+
+vector_size_t HashProbe::outputSize(WaveStream& stream) const {
+  auto it = outputSizes_.find(&stream);
+  VELOX_CHECK(it != outputSizes_.end());
+  return it->second;
+}
+
+} // namespace facebook::velox::wave
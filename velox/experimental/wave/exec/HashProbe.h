@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <deque>
+
+#include "velox/core/PlanNode.h"
+#include "velox/exec/HashJoinBridge.h"
+#include "velox/experimental/wave/exec/HashJoinInstructions.h"
+#include "velox/experimental/wave/exec/WaveOperator.h"
+
+namespace facebook::velox::wave {
+
+/// Inner hash join on one INTEGER or BIGINT key. The build side is the
+/// HashTable built by the CPU HashBuild operators of the join, received through
+/// the HashJoinBridge of the join. Its rows are copied to the arena and a
+/// device side join table is built over them. Probe batches are buffered like
+/// the input of Aggregation, probed in one kernel launch per flush and the
+/// matches of each batch are produced as one output batch.
+class HashProbe : public WaveOperator {
+ public:
+  HashProbe(
+      CompileState& state,
+      const core::HashJoinNode& node,
+      std::shared_ptr<exec::HashJoinBridge> joinBridge);
+
+  ~HashProbe() override;
+
+  /// True if 'node' is a join that HashProbe can run.
+  static bool canRun(const core::HashJoinNode& node);
+
+  bool isStreaming() const override {
+    return false;
+  }
+
+  exec::BlockingReason isBlocked(ContinueFuture* future) override;
+
+  void enqueue(WaveVectorPtr input) override {
+    VELOX_CHECK(!noMoreInput_);
+    buffered_.push_back(std::move(input));
+  }
+
+  void flush(bool noMoreInput) override;
+
+  int32_t canAdvance() override;
+
+  void schedule(WaveStream& stream, int32_t maxRows) override;
+
+  bool isFinished() const override {
+    return noMoreInput_ && buffered_.empty() && inputs_.empty() &&
+        ready_.empty();
+  }
+
+  vector_size_t outputSize(WaveStream& stream) const override;
+
+  std::string toString() const override {
+    return "HashProbe";
+  }
+
+ private:
+  // Source of an output column.
+  struct OutputColumn {
+    bool fromBuild;
+    // Channel of the probe input or column of the build side table.
+    int32_t channel;
+  };
+
+  // A probe batch and its matches.
+  struct Batch {
+    WaveVectorPtr input;
+    int32_t capacity{0};
+    WaveBufferPtr numResults;
+    WaveBufferPtr probeRows;
+    WaveBufferPtr buildRows;
+    WaveBufferPtr key;
+
+    int32_t numResultRows() const {
+      return *numResults->as<int32_t>();
+    }
+  };
+
+  // Copies the rows of the CPU built 'table' to the arena and builds the
+  // device side join table over them.
+  void loadTable(exec::BaseHashTable& table);
+
+  // Sizes the result buffers of 'batch' for 'capacity' matches.
+  void prepareBatch(Batch& batch, int32_t capacity);
+
+  // Launches the probe of 'batches' on 'flushStream_'.
+  void probe(folly::Range<Batch*> batches);
+
+  // Waits for the probe launched by flush(). Probes again the batches that
+  // had more matches than space and moves the batches with matches to
+  // 'ready_'.
+  void waitProbeDone();
+
+  GpuArena* arena_;
+  const std::shared_ptr<exec::HashJoinBridge> joinBridge_;
+
+  PhysicalType::Kind keyKind_;
+  int32_t probeKeyChannel_;
+  std::vector<OutputColumn> outputColumns_;
+
+  // Types of the columns of the build side table: the key, then the other
+  // columns of the build input.
+  RowTypePtr buildTableType_;
+
+  bool tableLoaded_{false};
+  hashjoin::JoinTable* table_{nullptr};
+  std::vector<WaveBufferPtr> tableBuffers_;
+  // Build side columns, indexed like 'buildTableType_'.
+  std::vector<WaveVectorPtr> buildColumns_;
+
+  std::vector<WaveVectorPtr> buffered_;
+  std::vector<Batch> inputs_;
+  std::deque<Batch> ready_;
+  folly::F14FastMap<WaveStream*, vector_size_t> outputSizes_;
+
+  std::unique_ptr<Stream> flushStream_;
+  Event flushDone_;
+  std::vector<WaveBufferPtr> flushBuffers_;
+
+  bool noMoreInput_{false};
+};
+
+} // namespace facebook::velox::wave
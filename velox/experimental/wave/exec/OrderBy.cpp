@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/exec/OrderBy.h"
+
+#include "velox/exec/Operator.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+
+namespace facebook::velox::wave {
+
+namespace {
+
+bool isSortKeyType(const Type& type) {
+  switch (type.kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// True if the values of 'type' can be gathered as fixed size words.
+bool isGatherable(const Type& type) {
+  return type.isPrimitiveType() && type.isFixedWidth() &&
+      type.kind() != TypeKind::BOOLEAN;
+}
+
+} // namespace
+
+OrderBy::OrderBy(CompileState& state, const core::OrderByNode& node)
+    : OrderBy(
+          state,
+          node,
+          node.sortingKeys(),
+          node.sortingOrders(),
+          std::nullopt) {}
+
+OrderBy::OrderBy(CompileState& state, const core::TopNNode& node)
+    : OrderBy(
+          state,
+          node,
+          node.sortingKeys(),
+          node.sortingOrders(),
+          node.count()) {}
+
+OrderBy::OrderBy(
+    CompileState& state,
+    const core::PlanNode& node,
+    const std::vector<core::FieldAccessTypedExprPtr>& sortingKeys,
+    const std::vector<core::SortOrder>& sortingOrders,
+    std::optional<int32_t> limit)
+    : WaveOperator(state, node.outputType()),
+      arena_(&state.arena()),
+      limit_(limit) {
+  VELOX_CHECK(canRun(node));
+  auto& inputType = node.sources()[0]->outputType();
+  for (auto i = 0; i < sortingKeys.size(); ++i) {
+    auto channel = exec::exprToChannel(sortingKeys[i].get(), inputType);
+    VELOX_CHECK_NE(channel, kConstantChannel);
+    keyChannels_.push_back(channel);
+    keys_.push_back(
+        {fromCpuType(*inputType->childAt(channel)).kind,
+         sortingOrders[i].isAscending(),
+         sortingOrders[i].isNullsFirst()});
+  }
+}
+
+OrderBy::~OrderBy() {
+  if (sortStream_) {
+    WaveStream::releaseStream(std::move(sortStream_));
+  }
+}
+
+// static
+bool OrderBy::canRun(const core::PlanNode& node) {
+  const std::vector<core::FieldAccessTypedExprPtr>* sortingKeys;
+  if (auto* orderBy = dynamic_cast<const core::OrderByNode*>(&node)) {
+    sortingKeys = &orderBy->sortingKeys();
+  } else if (auto* topN = dynamic_cast<const core::TopNNode*>(&node)) {
+    sortingKeys = &topN->sortingKeys();
+  } else {
+    return false;
+  }
+  for (auto& key : *sortingKeys) {
+    if (!isSortKeyType(*key->type())) {
+      return false;
+    }
+  }
+  for (auto& type : node.outputType()->children()) {
+    if (!isGatherable(*type)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void OrderBy::flush(bool noMoreInput) {
+  if (noMoreInput) {
+    noMoreInput_ = true;
+  } else {
+    VELOX_CHECK(!noMoreInput_);
+  }
+}
+
+int32_t OrderBy::canAdvance() {
+  if (!noMoreInput_ || finished_) {
+    return 0;
+  }
+  if (!sorted_) {
+    sort();
+  }
+  if (numOutputRows_ == 0) {
+    finished_ = true;
+  }
+  return numOutputRows_;
+}
+
+Operand** OrderBy::columnOperands(int32_t channel) {
+  auto numBatches = inputs_.size();
+  auto* operands =
+      arena_->allocate<Operand>(numBatches, sortBuffers_.emplace_back());
+  auto* pointers =
+      arena_->allocate<Operand*>(numBatches, sortBuffers_.emplace_back());
+  for (auto i = 0; i < numBatches; ++i) {
+    inputs_[i]->childAt(channel).toOperand(&operands[i]);
+    pointers[i] = &operands[i];
+  }
+  return pointers;
+}
+
+void OrderBy::sort() {
+  sorted_ = true;
+  const int32_t numBatches = inputs_.size();
+  auto* batchStarts =
+      arena_->allocate<int32_t>(numBatches + 1, sortBuffers_.emplace_back());
+  int32_t numRows = 0;
+  for (auto i = 0; i < numBatches; ++i) {
+    batchStarts[i] = numRows;
+    numRows += inputs_[i]->size();
+  }
+  batchStarts[numBatches] = numRows;
+  batches_ = {numBatches, batchStarts};
+  numOutputRows_ = limit_.has_value() ? std::min(limit_.value(), numRows)
+                                      : numRows;
+  if (numRows == 0) {
+    return;
+  }
+  if (!sortStream_) {
+    sortStream_ = WaveStream::streamFromReserve();
+  }
+  auto& stream = *sortStream_;
+  int32_t* rows[2];
+  uint64_t* keys[2];
+  for (auto i = 0; i < 2; ++i) {
+    rows[i] = arena_->allocate<int32_t>(numRows, sortBuffers_.emplace_back());
+    keys[i] =
+        arena_->allocate<uint64_t>(numRows, sortBuffers_.emplace_back());
+  }
+  auto tempBytes = sort::sortTempBytes(numRows);
+  auto* temp = arena_->allocate<char>(
+      std::max<size_t>(tempBytes, 1), sortBuffers_.emplace_back());
+  sort::initRows(stream, numRows, rows[0]);
+  int32_t current = 0;
+  auto sortPass = [&](int32_t key, bool nullFlags) {
+    sort::normalizeKeys(
+        stream,
+        keys_[key],
+        nullFlags,
+        batches_,
+        columnOperands(keyChannels_[key]),
+        numRows,
+        rows[current],
+        keys[0]);
+    sort::sortPairs(
+        stream,
+        temp,
+        tempBytes,
+        keys[0],
+        keys[1],
+        rows[current],
+        rows[1 - current],
+        numRows,
+        nullFlags ? 1 : 64);
+    current = 1 - current;
+  };
+  // The passes are stable, so sorting by the least significant key first
+  // leaves rows with equal keys in the order of the less significant keys.
+  for (int32_t i = keys_.size() - 1; i >= 0; --i) {
+    sortPass(i, false);
+    bool mayHaveNulls = false;
+    for (auto& input : inputs_) {
+      mayHaveNulls |= input->childAt(keyChannels_[i]).mayHaveNulls();
+    }
+    if (mayHaveNulls) {
+      sortPass(i, true);
+    }
+  }
+  stream.wait();
+  sortedRows_ = rows[current];
+}
+
+void OrderBy::schedule(WaveStream& waveStream, int32_t maxRows) {
+  VELOX_CHECK(sorted_);
+  VELOX_CHECK_LE(numOutputRows_, maxRows);
+  const int32_t numColumns = outputType_->size();
+  auto exec = std::make_unique<Executable>();
+  exec->operands =
+      arena_->allocate<Operand>(numColumns, exec->deviceData.emplace_back());
+  exec->outputOperands = outputIds_;
+  exec->output.resize(numColumns);
+  std::vector<Operand**> columns(numColumns);
+  std::vector<int32_t> ordinals(numColumns);
+  for (auto i = 0; i < numColumns; ++i) {
+    bool mayHaveNulls = false;
+    for (auto& input : inputs_) {
+      mayHaveNulls |= input->childAt(i).mayHaveNulls();
+    }
+    ordinals[i] = outputIds_.ordinal(defines(Value(subfields_[i]))->id);
+    auto result = WaveVector::create(outputType_->childAt(i), *arena_);
+    result->resize(numOutputRows_, mayHaveNulls);
+    result->toOperand(&exec->operands[ordinals[i]]);
+    exec->output[ordinals[i]] = std::move(result);
+    columns[i] = columnOperands(i);
+  }
+  // The gathers read the inputs and the sorted rows.
+  for (auto& buffer : sortBuffers_) {
+    exec->deviceData.push_back(std::move(buffer));
+  }
+  sortBuffers_.clear();
+  exec->intermediates = std::move(inputs_);
+  waveStream.installExecutables(
+      folly::Range(&exec, 1),
+      [&](Stream* stream, folly::Range<Executable**> exes) {
+        for (auto i = 0; i < numColumns; ++i) {
+          sort::gather(
+              *stream,
+              batches_,
+              columns[i],
+              outputType_->childAt(i)->cppSizeInBytes(),
+              numOutputRows_,
+              sortedRows_,
+              &exes[0]->operands[ordinals[i]]);
+        }
+        waveStream.markLaunch(*stream, *exes[0]);
+      });
+  finished_ = true;
+}
+
+} // namespace facebook::velox::wave
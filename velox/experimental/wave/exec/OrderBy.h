@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/core/PlanNode.h"
+#include "velox/experimental/wave/exec/SortInstructions.h"
+#include "velox/experimental/wave/exec/WaveOperator.h"
+
+namespace facebook::velox::wave {
+
+/// OrderBy and TopN. All input is buffered on the device and its rows are
+/// sorted by radix sort over normalized keys when there is no more input. The
+/// first 'limit' rows of the order are produced as one batch.
+class OrderBy : public WaveOperator {
+ public:
+  OrderBy(CompileState& state, const core::OrderByNode& node);
+
+  OrderBy(CompileState& state, const core::TopNNode& node);
+
+  ~OrderBy() override;
+
+  /// True if the sorting keys and the columns of 'node' are supported.
+  static bool canRun(const core::PlanNode& node);
+
+  bool isStreaming() const override {
+    return false;
+  }
+
+  void enqueue(WaveVectorPtr input) override {
+    VELOX_CHECK(!noMoreInput_);
+    if (input->size() > 0) {
+      inputs_.push_back(std::move(input));
+    }
+  }
+
+  void flush(bool noMoreInput) override;
+
+  int32_t canAdvance() override;
+
+  void schedule(WaveStream& stream, int32_t maxRows) override;
+
+  bool isFinished() const override {
+    return finished_;
+  }
+
+  vector_size_t outputSize(WaveStream&) const override {
+    return numOutputRows_;
+  }
+
+  std::string toString() const override {
+    return limit_.has_value() ? "TopN" : "OrderBy";
+  }
+
+ private:
+  OrderBy(
+      CompileState& state,
+      const core::PlanNode& node,
+      const std::vector<core::FieldAccessTypedExprPtr>& sortingKeys,
+      const std::vector<core::SortOrder>& sortingOrders,
+      std::optional<int32_t> limit);
+
+  // Returns the device array of the Operands of 'channel' in each input batch.
+  Operand** columnOperands(int32_t channel);
+
+  // Sorts the rows of 'inputs_' into 'sortedRows_'.
+  void sort();
+
+  GpuArena* arena_;
+  std::vector<int32_t> keyChannels_;
+  std::vector<sort::SortKey> keys_;
+  const std::optional<int32_t> limit_;
+
+  std::vector<WaveVectorPtr> inputs_;
+  sort::BatchRows batches_{};
+  // Memory for the sort and the Operands of the inputs.
+  std::vector<WaveBufferPtr> sortBuffers_;
+  int32_t* sortedRows_{nullptr};
+  int32_t numOutputRows_{0};
+  std::unique_ptr<Stream> sortStream_;
+
+  bool noMoreInput_{false};
+  bool sorted_{false};
+  bool finished_{false};
+};
+
+} // namespace facebook::velox::wave
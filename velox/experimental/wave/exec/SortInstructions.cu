@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/experimental/wave/exec/SortInstructions.h"
+
+#include <cub/device/device_radix_sort.cuh>
+
+#include "velox/experimental/wave/common/CudaUtil.cuh"
+#include "velox/experimental/wave/exec/WaveCore.cuh"
+
+namespace facebook::velox::wave::sort {
+
+namespace {
+
+constexpr uint64_t kSignBit = 1UL << 63;
+
+struct Word16 {
+  int64_t low;
+  int64_t high;
+};
+
+int32_t numBlocksFor(int32_t numRows) {
+  return (numRows + kBlockSize - 1) / kBlockSize;
+}
+
+// Returns the batch of 'row' and sets 'row' to the row in the batch.
+__device__ inline int32_t findBatch(BatchRows batches, int32_t& row) {
+  int32_t low = 0;
+  int32_t high = batches.numBatches;
+  while (high - low > 1) {
+    auto middle = (low + high) / 2;
+    if (batches.batchStarts[middle] <= row) {
+      low = middle;
+    } else {
+      high = middle;
+    }
+  }
+  row -= batches.batchStarts[low];
+  return low;
+}
+
+__device__ inline uint64_t normalizeInteger(int64_t value) {
+  return static_cast<uint64_t>(value) ^ kSignBit;
+}
+
+// NaN is larger than all other values and -0.0 is equal to 0.0, as in the
+// CPU comparisons.
+__device__ inline uint64_t normalizeDouble(double value) {
+  if (isnan(value)) {
+    return ~0UL;
+  }
+  if (value == 0) {
+    value = 0;
+  }
+  uint64_t bits = __double_as_longlong(value);
+  return (bits & kSignBit) ? ~bits : bits | kSignBit;
+}
+
+__device__ inline uint64_t
+normalizeValue(PhysicalType::Kind kind, Operand* op, int32_t row) {
+  switch (kind) {
+    case PhysicalType::kInt8:
+      return normalizeInteger(value<int8_t>(op, row));
+    case PhysicalType::kInt16:
+      return normalizeInteger(value<int16_t>(op, row));
+    case PhysicalType::kInt32:
+      return normalizeInteger(value<int32_t>(op, row));
+    case PhysicalType::kInt64:
+      return normalizeInteger(value<int64_t>(op, row));
+    case PhysicalType::kFloat32:
+      return normalizeDouble(value<float>(op, row));
+    case PhysicalType::kFloat64:
+      return normalizeDouble(value<double>(op, row));
+    default:
+      return 0;
+  }
+}
+
+__global__ void initRowsKernel(int32_t numRows, int32_t* rows) {
+  auto i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i < numRows) {
+    rows[i] = i;
+  }
+}
+
+__global__ void normalizeKeysKernel(
+    SortKey key,
+    bool nullFlags,
+    BatchRows batches,
+    Operand** column,
+    int32_t numRows,
+    const int32_t* rows,
+    uint64_t* keys) {
+  auto i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i >= numRows) {
+    return;
+  }
+  auto row = rows[i];
+  auto* op = column[findBatch(batches, row)];
+  bool isNull = op->nulls != nullptr && op->nulls[row] == kNull;
+  if (nullFlags) {
+    keys[i] = isNull == key.nullsFirst ? 0 : 1;
+    return;
+  }
+  // Nulls are ordered by the null flag pass that follows this one.
+  auto normalized = isNull ? 0 : normalizeValue(key.kind, op, row);
+  keys[i] = key.ascending ? normalized : ~normalized;
+}
+
+template <typename T>
+__device__ inline void
+gatherValue(Operand* input, int32_t row, Operand* result, int32_t resultRow) {
+  reinterpret_cast<T*>(result->base)[resultRow] = value<T>(input, row);
+}
+
+__global__ void gatherKernel(
+    BatchRows batches,
+    Operand** column,
+    int32_t elementSize,
+    int32_t numRows,
+    const int32_t* rows,
+    Operand* result) {
+  auto i = blockIdx.x * blockDim.x + threadIdx.x;
+  if (i >= numRows) {
+    return;
+  }
+  auto row = rows[i];
+  auto* op = column[findBatch(batches, row)];
+  switch (elementSize) {
+    case 1:
+      gatherValue<int8_t>(op, row, result, i);
+      break;
+    case 2:
+      gatherValue<int16_t>(op, row, result, i);
+      break;
+    case 4:
+      gatherValue<int32_t>(op, row, result, i);
+      break;
+    case 8:
+      gatherValue<int64_t>(op, row, result, i);
+      break;
+    case 16:
+      gatherValue<Word16>(op, row, result, i);
+      break;
+  }
+  if (result->nulls) {
+    result->nulls[i] =
+        op->nulls != nullptr && op->nulls[row] == kNull ? kNull : kNotNull;
+  }
+}
+
+} // namespace
+
+void initRows(Stream& stream, int32_t numRows, int32_t* rows) {
+  initRowsKernel<<<
+      numBlocksFor(numRows),
+      kBlockSize,
+      0,
+      stream.stream()->stream>>>(numRows, rows);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+void normalizeKeys(
+    Stream& stream,
+    SortKey key,
+    bool nullFlags,
+    BatchRows batches,
+    Operand** column,
+    int32_t numRows,
+    const int32_t* rows,
+    uint64_t* keys) {
+  normalizeKeysKernel<<<
+      numBlocksFor(numRows),
+      kBlockSize,
+      0,
+      stream.stream()->stream>>>(
+      key, nullFlags, batches, column, numRows, rows, keys);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+size_t sortTempBytes(int32_t numRows) {
+  size_t bytes = 0;
+  CUDA_CHECK(cub::DeviceRadixSort::SortPairs(
+      nullptr,
+      bytes,
+      static_cast<const uint64_t*>(nullptr),
+      static_cast<uint64_t*>(nullptr),
+      static_cast<const int32_t*>(nullptr),
+      static_cast<int32_t*>(nullptr),
+      numRows));
+  return bytes;
+}
+
+void sortPairs(
+    Stream& stream,
+    void* temp,
+    size_t tempBytes,
+    const uint64_t* keysIn,
+    uint64_t* keysOut,
+    const int32_t* rowsIn,
+    int32_t* rowsOut,
+    int32_t numRows,
+    int32_t numBits) {
+  CUDA_CHECK(cub::DeviceRadixSort::SortPairs(
+      temp,
+      tempBytes,
+      keysIn,
+      keysOut,
+      rowsIn,
+      rowsOut,
+      numRows,
+      0,
+      numBits,
+      stream.stream()->stream));
+}
+
+void gather(
+    Stream& stream,
+    BatchRows batches,
+    Operand** column,
+    int32_t elementSize,
+    int32_t numRows,
+    const int32_t* rows,
+    Operand* result) {
+  gatherKernel<<<
+      numBlocksFor(numRows),
+      kBlockSize,
+      0,
+      stream.stream()->stream>>>(
+      batches, column, elementSize, numRows, rows, result);
+  CUDA_CHECK(cudaGetLastError());
+}
+
+} // namespace facebook::velox::wave::sort
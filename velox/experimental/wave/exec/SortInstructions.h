@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/experimental/wave/common/Cuda.h"
+#include "velox/experimental/wave/common/Type.h"
+#include "velox/experimental/wave/vector/Operand.h"
+
+/// Device side sorting of the rows of a set of batches. Rows are sorted by
+/// stable radix sort passes over 64 bit normalized keys, from the least to
+/// the most significant sorting key. A normalized key compares as unsigned in
+/// the order of the SortOrder of its sorting key.
+namespace facebook::velox::wave::sort {
+
+struct SortKey {
+  PhysicalType::Kind kind;
+  bool ascending;
+  bool nullsFirst;
+};
+
+/// Rows of consecutive batches, numbered from 0. Batch b has rows
+/// batchStarts[b] to batchStarts[b + 1] - 1. A column of the batches is an
+/// array of one Operand per batch.
+struct BatchRows {
+  int32_t numBatches;
+  int32_t* batchStarts;
+};
+
+/// Sets 'rows' to 0, 1, ... 'numRows' - 1.
+void initRows(Stream& stream, int32_t numRows, int32_t* rows);
+
+/// Sets 'keys[i]' to the normalized key of row 'rows[i]' of 'column'. If
+/// 'nullFlags', the key orders only by null and is 0 or 1.
+void normalizeKeys(
+    Stream& stream,
+    SortKey key,
+    bool nullFlags,
+    BatchRows batches,
+    Operand** column,
+    int32_t numRows,
+    const int32_t* rows,
+    uint64_t* keys);
+
+/// Returns the bytes of temporary device memory for sortPairs() of
+/// 'numRows'.
+size_t sortTempBytes(int32_t numRows);
+
+/// Stably sorts 'rowsIn' by 'keysIn' into 'rowsOut'. Only the low 'numBits'
+/// of the keys are compared.
+void sortPairs(
+    Stream& stream,
+    void* temp,
+    size_t tempBytes,
+    const uint64_t* keysIn,
+    uint64_t* keysOut,
+    const int32_t* rowsIn,
+    int32_t* rowsOut,
+    int32_t numRows,
+    int32_t numBits);
+
+/// Copies the values of 'column' at 'rows' to 'result'. Values are moved as
+/// 'elementSize' byte words.
+void gather(
+    Stream& stream,
+    BatchRows batches,
+    Operand** column,
+    int32_t elementSize,
+    int32_t numRows,
+    const int32_t* rows,
+    Operand* result);
+
+} // namespace facebook::velox::wave::sort
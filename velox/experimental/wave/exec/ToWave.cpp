@@ -17,6 +17,8 @@
 #include "velox/experimental/wave/exec/ToWave.h"
 #include "velox/exec/FilterProject.h"
 #include "velox/experimental/wave/exec/Aggregation.h"
+#include "velox/experimental/wave/exec/HashProbe.h"
+#include "velox/experimental/wave/exec/OrderBy.h"
 #include "velox/experimental/wave/exec/Project.h"
 #include "velox/experimental/wave/exec/Values.h"
 #include "velox/experimental/wave/exec/WaveDriver.h"
@@ -326,6 +328,30 @@ bool CompileState::addOperator(
     operators_.push_back(std::make_unique<Aggregation>(
         *this, *node, aggregateFunctionRegistry()));
     outputType = node->outputType();
+  } else if (name == "OrderBy" || name == "TopN") {
+    auto& node = driverFactory_.planNodes[nodeIndex];
+    if (!OrderBy::canRun(*node) || !reserveMemory()) {
+      return false;
+    }
+    if (auto* orderBy = dynamic_cast<const core::OrderByNode*>(node.get())) {
+      operators_.push_back(std::make_unique<OrderBy>(*this, *orderBy));
+    } else {
+      operators_.push_back(std::make_unique<OrderBy>(
+          *this, *dynamic_cast<const core::TopNNode*>(node.get())));
+    }
+    outputType = node->outputType();
+  } else if (name == "HashProbe") {
+    auto* node = dynamic_cast<const core::HashJoinNode*>(
+        driverFactory_.planNodes[nodeIndex].get());
+    VELOX_CHECK_NOT_NULL(node);
+    if (!HashProbe::canRun(*node) || !reserveMemory()) {
+      return false;
+    }
+    auto joinBridge = driver_.task()->getHashJoinBridgeLocked(
+        driver_.driverCtx()->splitGroupId, node->id());
+    operators_.push_back(
+        std::make_unique<HashProbe>(*this, *node, std::move(joinBridge)));
+    outputType = node->outputType();
   } else {
     return false;
   }
@@ -343,6 +369,51 @@ bool isProjectedThrough(
   return false;
 }
 
+int32_t countExprNodes(const exec::Expr& expr) {
+  int32_t count = 1;
+  for (auto& input : expr.inputs()) {
+    count += countExprNodes(*input);
+  }
+  return count;
+}
+
+int64_t rowBytes(const RowType& type) {
+  int64_t bytes = 0;
+  for (auto& child : type.children()) {
+    bytes += child->isFixedWidth() ? child->cppSizeInBytes() : 16;
+  }
+  return bytes;
+}
+
+std::optional<SegmentCost> CompileState::segmentCost(
+    const std::vector<exec::Operator*>& operators,
+    int32_t numOperators,
+    const RowTypePtr& outputType) const {
+  auto* values =
+      dynamic_cast<const core::ValuesNode*>(driverFactory_.planNodes[0].get());
+  if (!values) {
+    return std::nullopt;
+  }
+  SegmentCost cost;
+  for (auto& vector : values->values()) {
+    cost.numRows += vector->size();
+  }
+  cost.numRows *= values->repeatTimes();
+  cost.numBatches = values->values().size() * values->repeatTimes();
+  cost.transferBytes = cost.numRows *
+      (rowBytes(*values->outputType()) + rowBytes(*outputType));
+  cost.numOperators = numOperators;
+  for (auto i = 0; i < numOperators; ++i) {
+    if (auto* filterProject =
+            dynamic_cast<const exec::FilterProject*>(operators[i])) {
+      for (auto& expr : filterProject->exprsAndProjection().exprs->exprs()) {
+        cost.numExprNodes += countExprNodes(*expr);
+      }
+    }
+  }
+  return cost;
+}
+
 bool CompileState::compile() {
   auto operators = driver_.operators();
   auto& nodes = driverFactory_.planNodes;
@@ -372,6 +443,14 @@ bool CompileState::compile() {
   if (operators_.empty()) {
     return false;
   }
+  // Identifies the segment in the cost history: the plan of the last node,
+  // which includes the plans of the replaced nodes before it.
+  auto costKey = nodes[nodeIndex - 1]->toString(true, true);
+  if (auto cost = segmentCost(operators, operatorIndex, outputType)) {
+    if (!WaveCostModel::shouldOffload(costKey, cost.value())) {
+      return false;
+    }
+  }
   for (auto& op : operators_) {
     op->finalize(*this);
   }
@@ -391,6 +470,7 @@ bool CompileState::compile() {
       std::move(subfields_),
       std::move(operands_));
   auto waveOp = waveOpUnique.get();
+  waveOp->setCostKey(std::move(costKey));
   waveOp->initialize();
   std::vector<std::unique_ptr<exec::Operator>> added;
   added.push_back(std::move(waveOpUnique));
@@ -18,6 +18,7 @@
 
 #include "velox/exec/Operator.h"
 #include "velox/experimental/wave/exec/AggregateFunctionRegistry.h"
+#include "velox/experimental/wave/exec/CostModel.h"
 #include "velox/experimental/wave/exec/WaveOperator.h"
 #include "velox/expression/Expr.h"
 
@@ -85,6 +86,14 @@ class CompileState {
 
   bool reserveMemory();
 
+  // Returns the estimated work of running the first 'numOperators' Operators
+  // of the Driver in Wave, or std::nullopt if the size of the input is not
+  // known at plan time.
+  std::optional<SegmentCost> segmentCost(
+      const std::vector<exec::Operator*>& operators,
+      int32_t numOperators,
+      const RowTypePtr& outputType) const;
+
   // Adds 'instruction' to the suitable program and records the result
   // of the instruction to the right program. The set of programs
   // 'instruction's operands depend is in 'programs'. If 'instruction'
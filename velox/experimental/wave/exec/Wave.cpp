@@ -128,6 +128,32 @@ void Executable::startTransfer(
   exe->deviceData.push_back(operands);
   exe->operands = operands->as<Operand>();
   exe->outputOperands = outputOperands;
+  if (auto* hostArena = waveStream.hostArena()) {
+    // Copy to pinned staging memory, from where the copy to device is a DMA
+    // that does not hold up the host or the other streams.
+    size_t totalBytes = 0;
+    for (auto& transfer : exe->transfers) {
+      totalBytes += bits::roundUp(transfer.size, 8);
+    }
+    auto staging = hostArena->allocateBytes(std::max<size_t>(totalBytes, 8));
+    auto* from = staging->as<char>();
+    for (auto& transfer : exe->transfers) {
+      ::memcpy(from, transfer.from, transfer.size);
+      transfer.from = from;
+      from += bits::roundUp(transfer.size, 8);
+    }
+    exe->deviceData.push_back(std::move(staging));
+    waveStream.installExecutables(
+        folly::Range(&exe, 1),
+        [&](Stream* stream, folly::Range<Executable**> executables) {
+          for (auto& transfer : executables[0]->transfers) {
+            stream->hostToDeviceAsync(
+                transfer.to, transfer.from, transfer.size);
+          }
+          waveStream.markLaunch(*stream, *executables[0]);
+        });
+    return;
+  }
   copyData(exe->transfers);
   auto* device = waveStream.device();
   waveStream.installExecutables(
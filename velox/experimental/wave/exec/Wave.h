@@ -242,7 +242,11 @@ struct LaunchControl;
 /// Represents consecutive data dependent kernel launches.
 class WaveStream {
  public:
-  WaveStream(GpuArena& arena) : arena_(arena) {}
+  /// 'hostArena', if given, provides pinned host memory for staging host to
+  /// device transfers. With staging, transfers are asynchronous copies on the
+  /// stream of the transfer and overlap with the work of other streams.
+  WaveStream(GpuArena& arena, GpuArena* hostArena = nullptr)
+      : arena_(arena), hostArena_(hostArena) {}
 
   ~WaveStream();
 
@@ -257,6 +261,10 @@ class WaveStream {
     return arena_;
   }
 
+  GpuArena* hostArena() const {
+    return hostArena_;
+  }
+
   Executable* operandExecutable(OperandId id) {
     auto it = operandToExecutable_.find(id);
     if (it == operandToExecutable_.end()) {
@@ -351,6 +359,7 @@ class WaveStream {
   static void clearReusable();
 
   GpuArena& arena_;
+  GpuArena* const hostArena_;
   folly::F14FastMap<OperandId, Executable*> operandToExecutable_;
   std::vector<std::unique_ptr<Executable>> executables_;
 
@@ -15,9 +15,22 @@
  */
 
 #include "velox/experimental/wave/exec/WaveDriver.h"
+#include "velox/common/time/Timer.h"
+#include "velox/experimental/wave/exec/CostModel.h"
 #include "velox/experimental/wave/exec/Instruction.h"
 #include "velox/experimental/wave/exec/WaveOperator.h"
 
+DEFINE_int32(
+    velox_wave_max_streams,
+    4,
+    "Maximum number of batches in flight in a Wave pipeline. Transfers and "
+    "kernels of different batches run on different streams and overlap");
+
+DEFINE_int64(
+    velox_wave_staging_unit_size,
+    64 << 20,
+    "Per Driver pinned host memory for staging transfers to GPU");
+
 namespace facebook::velox::wave {
 
 WaveDriver::WaveDriver(
@@ -37,6 +50,9 @@ WaveDriver::WaveDriver(
           planNodeId,
           "Wave"),
       arena_(std::move(arena)),
+      hostArena_(std::make_unique<GpuArena>(
+          FLAGS_velox_wave_staging_unit_size,
+          getHostAllocator(getDevice()))),
       resultOrder_(std::move(resultOrder)),
       subfields_(std::move(subfields)),
       operands_(std::move(operands)) {
@@ -51,8 +67,27 @@ WaveDriver::WaveDriver(
   }
 }
 
+exec::BlockingReason WaveDriver::isBlocked(ContinueFuture* future) {
+  if (blockingFuture_.valid()) {
+    *future = std::move(blockingFuture_);
+    return blockingReason_;
+  }
+  for (auto& pipeline : pipelines_) {
+    for (auto& op : pipeline.operators) {
+      auto reason = op->isBlocked(future);
+      if (reason != exec::BlockingReason::kNotBlocked) {
+        return reason;
+      }
+    }
+  }
+  return exec::BlockingReason::kNotBlocked;
+}
+
 RowVectorPtr WaveDriver::getOutput() {
   VLOG(1) << "Getting output";
+  if (startMicros_ == 0) {
+    startMicros_ = getCurrentTimeMicro();
+  }
   for (;;) {
     startMore();
     bool running = false;
@@ -98,6 +133,10 @@ RowVectorPtr WaveDriver::getOutput() {
     if (!running) {
       VLOG(1) << "No more output";
       finished_ = true;
+      if (!costKey_.empty()) {
+        WaveCostModel::recordRun(
+            costKey_, numSourceRows_, getCurrentTimeMicro() - startMicros_);
+      }
       return nullptr;
     }
   }
@@ -148,23 +187,47 @@ RowVectorPtr WaveDriver::makeResult(
 void WaveDriver::startMore() {
   for (int i = 0; i < pipelines_.size(); ++i) {
     auto& ops = pipelines_[i].operators;
-    if (auto rows = ops[0]->canAdvance()) {
+    auto& streams = pipelines_[i].streams;
+    bool started = false;
+    // Each batch gets its own WaveStream, so that the transfer of one batch
+    // overlaps with the kernels of the previous ones.
+    while (streams.size() <
+           static_cast<size_t>(std::max(1, FLAGS_velox_wave_max_streams))) {
+      auto rows = ops[0]->canAdvance();
+      if (!rows) {
+        break;
+      }
       VLOG(1) << "Advance " << rows << " rows in pipeline " << i;
-      auto stream = std::make_unique<WaveStream>(*arena_);
+      if (i == 0) {
+        numSourceRows_ += rows;
+      }
+      auto stream = std::make_unique<WaveStream>(*arena_, hostArena_.get());
       for (auto& op : ops) {
         op->schedule(*stream, rows);
       }
       if (i == pipelines_.size() - 1) {
         prefetchReturn(*stream);
       }
-      pipelines_[i].streams.push_back(std::move(stream));
+      streams.push_back(std::move(stream));
+      started = true;
+    }
+    if (started) {
       break;
     }
   }
 }
 
 void WaveDriver::prefetchReturn(WaveStream& stream) {
-  // Schedule return buffers from last op to be on host side.
+  for (auto id : resultOrder_) {
+    auto* exe = stream.operandExecutable(id);
+    if (!exe || !exe->stream) {
+      continue;
+    }
+    auto ordinal = exe->outputOperands.ordinal(id);
+    if (auto& vector = exe->output[ordinal]) {
+      vector->prefetchToHost(*exe->stream);
+    }
+  }
 }
 
 LaunchControl* WaveDriver::inputControl(
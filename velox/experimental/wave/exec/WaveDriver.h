@@ -39,13 +39,7 @@ class WaveDriver : public exec::SourceOperator {
 
   RowVectorPtr getOutput() override;
 
-  exec::BlockingReason isBlocked(ContinueFuture* future) override {
-    if (blockingFuture_.valid()) {
-      *future = std::move(blockingFuture_);
-      return blockingReason_;
-    }
-    return exec::BlockingReason::kNotBlocked;
-  }
+  exec::BlockingReason isBlocked(ContinueFuture* future) override;
 
   bool isFinished() override {
     return finished_;
@@ -55,6 +49,12 @@ class WaveDriver : public exec::SourceOperator {
     cpuOperators_ = std::move(original);
   }
 
+  /// Sets the key under which the run time of 'this' is recorded in
+  /// WaveCostModel.
+  void setCostKey(std::string key) {
+    costKey_ = std::move(key);
+  }
+
   GpuArena& arena() const {
     return *arena_;
   }
@@ -92,6 +92,9 @@ class WaveDriver : public exec::SourceOperator {
 
   std::unique_ptr<GpuArena> arena_;
 
+  // Pinned host memory for staging transfers to device.
+  std::unique_ptr<GpuArena> hostArena_;
+
   ContinueFuture blockingFuture_{ContinueFuture::makeEmpty()};
   exec::BlockingReason blockingReason_;
 
@@ -114,6 +117,14 @@ class WaveDriver : public exec::SourceOperator {
   // The replaced Operators from the Driver. Can be used for a CPU fallback.
   std::vector<std::unique_ptr<exec::Operator>> cpuOperators_;
 
+  // Key of the replaced segment in WaveCostModel.
+  std::string costKey_;
+
+  // Time of the first getOutput() and the number of rows from the source, for
+  // recording the throughput of 'this'.
+  uint64_t startMicros_{0};
+  int64_t numSourceRows_{0};
+
   // Top level column order in getOutput result.
   std::vector<OperandId> resultOrder_;
 
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/exec/Driver.h"
 #include "velox/experimental/wave/exec/Wave.h"
 #include "velox/experimental/wave/vector/WaveVector.h"
 
@@ -46,6 +47,12 @@ class WaveOperator {
 
   virtual bool isStreaming() const = 0;
 
+  /// Returns the reason for not being able to run, e.g. waiting for the build
+  /// side of a join in another Driver. Sets 'future' if blocked.
+  virtual exec::BlockingReason isBlocked(ContinueFuture* /*future*/) {
+    return exec::BlockingReason::kNotBlocked;
+  }
+
   virtual void enqueue(WaveVectorPtr) {
     VELOX_FAIL("Override for blocking operator");
   }
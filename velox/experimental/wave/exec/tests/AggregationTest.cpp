@@ -52,6 +52,8 @@ class AggregationTest : public OperatorTestBase {
     if (int device; cudaGetDevice(&device) != cudaSuccess) {
       GTEST_SKIP() << "No CUDA detected, skipping all tests";
     }
+    // Run the small test queries in Wave.
+    FLAGS_velox_wave_cost_model = false;
   }
 };
 
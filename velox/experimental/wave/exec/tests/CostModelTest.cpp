@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cuda_runtime.h> // @manual
+#include <gtest/gtest.h>
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/experimental/wave/exec/CostModel.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+
+namespace facebook::velox::wave {
+namespace {
+
+using namespace exec::test;
+
+class CostModelTest : public OperatorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    OperatorTestBase::SetUpTestCase();
+    wave::registerWave();
+  }
+
+  void SetUp() override {
+    if (int device; cudaGetDevice(&device) != cudaSuccess) {
+      GTEST_SKIP() << "No CUDA detected, skipping all tests";
+    }
+    FLAGS_velox_wave_cost_model = true;
+    WaveCostModel::clearHistory();
+  }
+};
+
+TEST_F(CostModelTest, estimates) {
+  SegmentCost small{
+      .numRows = 100,
+      .numBatches = 1,
+      .transferBytes = 1'600,
+      .numExprNodes = 3,
+      .numOperators = 2};
+  EXPECT_FALSE(WaveCostModel::shouldOffload("small", small));
+
+  SegmentCost large{
+      .numRows = 100'000'000,
+      .numBatches = 100,
+      .transferBytes = 1'600'000'000,
+      .numExprNodes = 30,
+      .numOperators = 2};
+  EXPECT_TRUE(WaveCostModel::shouldOffload("large", large));
+
+  // Observed GPU runs override the estimate.
+  WaveCostModel::recordRun("large", 1'000, 1'000'000);
+  EXPECT_FALSE(WaveCostModel::shouldOffload("large", large));
+}
+
+TEST_F(CostModelTest, smallQueryStaysOnCpu) {
+  auto vector = makeRowVector({makeFlatVector<int64_t>(10, folly::identity)});
+  auto plan =
+      PlanBuilder().values({vector}).project({"c0 + 1 AS c1"}).planNode();
+  auto task = AssertQueryBuilder(plan).assertResults(makeRowVector(
+      {"c1"}, {makeFlatVector<int64_t>(10, [](auto row) { return row + 1; })}));
+  auto stats = task->taskStats();
+  for (auto& pipeline : stats.pipelineStats) {
+    for (auto& op : pipeline.operatorStats) {
+      EXPECT_NE(op.operatorType, "Wave");
+    }
+  }
+}
+
+} // namespace
+} // namespace facebook::velox::wave
@@ -34,6 +34,8 @@ class FilterProjectTest : public OperatorTestBase {
       GTEST_SKIP() << "No CUDA detected, skipping all tests";
     }
     wave::registerWave();
+    // Run the small test queries in Wave.
+    FLAGS_velox_wave_cost_model = false;
   }
 
   void assertFilter(
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cuda_runtime.h> // @manual
+#include <gtest/gtest.h>
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+
+namespace facebook::velox::wave {
+namespace {
+
+using namespace exec::test;
+
+class HashJoinTest : public OperatorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    OperatorTestBase::SetUpTestCase();
+    wave::registerWave();
+  }
+
+  void SetUp() override {
+    if (int device; cudaGetDevice(&device) != cudaSuccess) {
+      GTEST_SKIP() << "No CUDA detected, skipping all tests";
+    }
+    // Run the small test queries in Wave.
+    FLAGS_velox_wave_cost_model = false;
+  }
+
+  core::PlanNodePtr makePlan(
+      const std::vector<RowVectorPtr>& probe,
+      const std::vector<RowVectorPtr>& build,
+      const std::vector<std::string>& output) {
+    auto planNodeIdGenerator = std::make_shared<core::PlanNodeIdGenerator>();
+    return PlanBuilder(planNodeIdGenerator)
+        .values(probe)
+        .hashJoin(
+            {"c0"},
+            {"u0"},
+            PlanBuilder(planNodeIdGenerator).values(build).planNode(),
+            "",
+            output)
+        .planNode();
+  }
+};
+
+TEST_F(HashJoinTest, uniqueKeys) {
+  constexpr int kSize = 1000;
+  auto probe = makeRowVector({
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row % 300; }),
+      makeFlatVector<int64_t>(kSize, folly::identity),
+  });
+  auto build = makeRowVector(
+      {"u0", "u1"},
+      {
+          makeFlatVector<int64_t>(100, [](auto row) { return row * 2; }),
+          makeFlatVector<double>(100, [](auto row) { return row * 0.5; }),
+      });
+  createDuckDbTable("t", {probe});
+  createDuckDbTable("u", {build});
+  AssertQueryBuilder(
+      makePlan({probe, probe}, {build}, {"c1", "u1"}), duckDbQueryRunner_)
+      .assertResults(
+          "SELECT c1, u1 FROM (SELECT * FROM t UNION ALL SELECT * FROM t), u "
+          "WHERE c0 = u0");
+}
+
+TEST_F(HashJoinTest, duplicateKeysAndNulls) {
+  // Each probe row matches several build rows, so that the first probe of a
+  // batch runs out of space for the matches.
+  auto probe = makeRowVector({
+      makeFlatVector<int32_t>(
+          500, [](auto row) { return row % 10; }, nullEvery(7)),
+      makeFlatVector<int32_t>(500, folly::identity),
+  });
+  auto build = makeRowVector(
+      {"u0", "u1"},
+      {
+          makeFlatVector<int32_t>(
+              100, [](auto row) { return row % 5; }, nullEvery(11)),
+          makeFlatVector<int64_t>(
+              100, [](auto row) { return row; }, nullEvery(3)),
+      });
+  createDuckDbTable("t", {probe});
+  createDuckDbTable("u", {build});
+  AssertQueryBuilder(
+      makePlan({probe}, {build}, {"c0", "c1", "u1"}), duckDbQueryRunner_)
+      .assertResults("SELECT c0, c1, u1 FROM t, u WHERE c0 = u0");
+}
+
+TEST_F(HashJoinTest, emptyBuild) {
+  auto probe = makeRowVector({
+      makeFlatVector<int64_t>(100, folly::identity),
+  });
+  auto build = makeRowVector(
+      {"u0"},
+      {makeFlatVector<int64_t>(
+          100, [](auto row) { return row; }, [](auto) { return true; })});
+  AssertQueryBuilder(makePlan({probe}, {build}, {"c0"}))
+      .assertResults(BaseVector::create<RowVector>(
+          ROW({"c0"}, {BIGINT()}), 0, pool()));
+}
+
+} // namespace
+} // namespace facebook::velox::wave
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cuda_runtime.h> // @manual
+#include <gtest/gtest.h>
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/OperatorTestBase.h"
+#include "velox/exec/tests/utils/PlanBuilder.h"
+#include "velox/experimental/wave/exec/ToWave.h"
+
+namespace facebook::velox::wave {
+namespace {
+
+using namespace exec::test;
+
+class OrderByTest : public OperatorTestBase {
+ protected:
+  static void SetUpTestCase() {
+    OperatorTestBase::SetUpTestCase();
+    wave::registerWave();
+  }
+
+  void SetUp() override {
+    if (int device; cudaGetDevice(&device) != cudaSuccess) {
+      GTEST_SKIP() << "No CUDA detected, skipping all tests";
+    }
+    // Run the small test queries in Wave.
+    FLAGS_velox_wave_cost_model = false;
+  }
+
+  std::vector<RowVectorPtr> makeVectors() {
+    std::vector<RowVectorPtr> vectors;
+    for (auto i = 0; i < 3; ++i) {
+      vectors.push_back(makeRowVector({
+          makeFlatVector<int32_t>(
+              1'000,
+              [&](auto row) { return (row * 7 + i) % 13; },
+              nullEvery(17)),
+          makeFlatVector<double>(
+              1'000,
+              [&](auto row) { return (row * 31 + i * 5) % 101 - 50.5; },
+              nullEvery(23)),
+          makeFlatVector<int64_t>(
+              1'000, [&](auto row) { return i * 1'000 + row; }),
+      }));
+    }
+    return vectors;
+  }
+};
+
+TEST_F(OrderByTest, orderBy) {
+  auto vectors = makeVectors();
+  createDuckDbTable(vectors);
+  for (auto& keys :
+       std::vector<std::vector<std::string>>{
+           {"c0 ASC NULLS LAST", "c2"},
+           {"c1 DESC NULLS FIRST", "c2 DESC"},
+           {"c0 DESC NULLS LAST", "c1 ASC NULLS FIRST", "c2"}}) {
+    auto plan = PlanBuilder().values(vectors).orderBy(keys, false).planNode();
+    assertQueryOrdered(
+        plan,
+        fmt::format("SELECT * FROM tmp ORDER BY {}", folly::join(", ", keys)),
+        {0, 1, 2});
+  }
+}
+
+TEST_F(OrderByTest, topN) {
+  auto vectors = makeVectors();
+  createDuckDbTable(vectors);
+  auto plan = PlanBuilder()
+                  .values(vectors)
+                  .topN({"c1 DESC NULLS LAST", "c2"}, 100, false)
+                  .planNode();
+  assertQueryOrdered(
+      plan,
+      "SELECT * FROM tmp ORDER BY c1 DESC NULLS LAST, c2 LIMIT 100",
+      {1, 2});
+}
+
+} // namespace
+} // namespace facebook::velox::wave
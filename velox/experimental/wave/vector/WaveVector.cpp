@@ -69,6 +69,15 @@ void WaveVector::resize(vector_size_t size, bool nullable) {
   }
 }
 
+void WaveVector::prefetchToHost(Stream& stream) const {
+  if (values_) {
+    stream.prefetch(nullptr, values_->as<char>(), values_->capacity());
+  }
+  if (nulls_) {
+    stream.prefetch(nullptr, nulls_->as<char>(), nulls_->capacity());
+  }
+}
+
 void WaveVector::toOperand(Operand* operand) const {
   operand->size = size_;
   operand->nulls = nulls_ ? nulls_->as<uint8_t>() : nullptr;
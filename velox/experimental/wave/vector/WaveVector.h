@@ -108,6 +108,10 @@ class WaveVector {
   /// Sets 'operand' to point to the buffers of 'this'.
   void toOperand(Operand* operand) const;
 
+  /// Enqueues on 'stream' a prefetch of the values and nulls of 'this' to host
+  /// memory.
+  void prefetchToHost(Stream& stream) const;
+
   std::string toString() const;
 
  private:
@@ -162,27 +162,13 @@ void CastExpr::applyToSelectedNoThrowLocal(
     VectorPtr& result,
     Func&& func) {
   if (setNullInResultAtError()) {
-    rows.template applyToSelected([&](auto row) INLINE_LAMBDA {
-      try {
-        func(row);
-      } catch (...) {
-        result->setNull(row, true);
-      }
-    });
+    rows.template applyToSelectedNoThrow(
+        [&](auto row) INLINE_LAMBDA { func(row); },
+        [&](auto row) { result->setNull(row, true); });
   } else {
-    rows.template applyToSelected([&](auto row) INLINE_LAMBDA {
-      try {
-        func(row);
-      } catch (const VeloxException& e) {
-        if (!e.isUserError()) {
-          throw;
-        }
-        // Avoid double throwing.
-        context.setVeloxExceptionError(row, std::current_exception());
-      } catch (const std::exception& e) {
-        context.setError(row, std::current_exception());
-      }
-    });
+    rows.template applyToSelectedNoThrow(
+        [&](auto row) INLINE_LAMBDA { func(row); },
+        [&](auto row) { context.setErrorFromCurrentException(row); });
   }
 }
 
@@ -220,6 +206,52 @@ void CastExpr::applyCastKernel(
     }
   }
 
+  if constexpr (
+      (ToKind == TypeKind::VARCHAR || ToKind == TypeKind::VARBINARY) &&
+      (FromKind == TypeKind::TINYINT || FromKind == TypeKind::SMALLINT ||
+       FromKind == TypeKind::INTEGER || FromKind == TypeKind::BIGINT)) {
+    // Formats straight into the result without the std::string that the
+    // Converter returns. The output is the same as folly::to<std::string>.
+    char buffer[24];
+    auto [end, error] =
+        std::to_chars(buffer, buffer + sizeof(buffer), inputRowValue);
+    VELOX_DCHECK(error == std::errc());
+    auto writer = exec::StringWriter<>(result, row);
+    writer.copy_from(std::string_view(buffer, end - buffer));
+    writer.finalize();
+    return;
+  }
+
+  if constexpr (
+      (FromKind == TypeKind::VARCHAR || FromKind == TypeKind::VARBINARY) &&
+      ((!Truncate &&
+        (ToKind == TypeKind::TINYINT || ToKind == TypeKind::SMALLINT ||
+         ToKind == TypeKind::INTEGER || ToKind == TypeKind::BIGINT)) ||
+       ToKind == TypeKind::REAL || ToKind == TypeKind::DOUBLE)) {
+    // Records malformed strings as errors without throwing. Dirty input under
+    // TRY would otherwise unwind an exception per bad row.
+    const folly::StringPiece inputString(inputRowValue);
+    auto output = util::Converter<ToKind, void, Truncate>::tryCastPlainString(
+        inputString);
+    if (UNLIKELY(output.hasError())) {
+      if (setNullInResultAtError()) {
+        result->setNull(row, true);
+      } else {
+        context.setVeloxExceptionError(
+            row,
+            makeBadCastException(
+                result->type(),
+                *input,
+                row,
+                folly::makeConversionError(output.error(), inputString)
+                    .what()));
+      }
+      return;
+    }
+    result->set(row, output.value());
+    return;
+  }
+
   auto output = util::Converter<ToKind, void, Truncate>::cast(inputRowValue);
 
   if constexpr (ToKind == TypeKind::VARCHAR || ToKind == TypeKind::VARBINARY) {
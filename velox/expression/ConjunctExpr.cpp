@@ -190,6 +190,7 @@ void ConjunctExpr::maybeReorderInputs() {
           return selectivity_[left].timeToDropValue() <
               selectivity_[right].timeToDropValue();
         });
+    ++stats_.numInputReorders;
   }
 }
 
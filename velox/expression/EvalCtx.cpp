@@ -32,7 +32,8 @@ EvalCtx::EvalCtx(core::ExecCtx* execCtx, ExprSet* exprSet, const RowVector* row)
     : execCtx_(execCtx),
       exprSet_(exprSet),
       row_(row),
-      cacheEnabled_(execCtx->exprEvalCacheEnabled()) {
+      cacheEnabled_(execCtx->exprEvalCacheEnabled()),
+      scratchMark_(execCtx->scratchArena().mark()) {
   // TODO Change the API to replace raw pointers with non-const references.
   // Sanity check inputs to prevent crashes.
   VELOX_CHECK_NOT_NULL(execCtx);
@@ -53,10 +54,15 @@ EvalCtx::EvalCtx(core::ExecCtx* execCtx)
     : execCtx_(execCtx),
       exprSet_(nullptr),
       row_(nullptr),
-      cacheEnabled_(execCtx->exprEvalCacheEnabled()) {
+      cacheEnabled_(execCtx->exprEvalCacheEnabled()),
+      scratchMark_(execCtx->scratchArena().mark()) {
   VELOX_CHECK_NOT_NULL(execCtx);
 }
 
+EvalCtx::~EvalCtx() {
+  execCtx_->scratchArena().rewind(scratchMark_);
+}
+
 void EvalCtx::saveAndReset(
     ScopedContextSaver& saver,
     const SelectivityVector& rows) {
@@ -197,6 +203,26 @@ void EvalCtx::setErrors(
       [&](auto row) { addError(row, veloxException, errors_); });
 }
 
+void EvalCtx::setStatus(vector_size_t index, const Status& status) {
+  VELOX_DCHECK(!status.ok());
+  if (throwOnError_) {
+    VELOX_USER_FAIL("{}", status.message());
+  }
+
+  addError(
+      index,
+      std::make_exception_ptr(VeloxUserError(
+          __FILE__,
+          __LINE__,
+          __FUNCTION__,
+          "",
+          status.message(),
+          error_source::kErrorSourceUser,
+          error_code::kInvalidArgument,
+          false)),
+      errors_);
+}
+
 void EvalCtx::addElementErrorsToTopLevel(
     const SelectivityVector& elementRows,
     const BufferPtr& elementToTopLevelRows,
@@ -19,6 +19,7 @@
 #include <functional>
 
 #include "velox/common/base/Portability.h"
+#include "velox/common/base/Status.h"
 #include "velox/core/QueryCtx.h"
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/FlatVector.h"
@@ -44,6 +45,8 @@ class EvalCtx {
   /// For testing only.
   explicit EvalCtx(core::ExecCtx* FOLLY_NONNULL execCtx);
 
+  ~EvalCtx();
+
   const RowVector* FOLLY_NONNULL row() const {
     return row_;
   }
@@ -93,24 +96,36 @@ class EvalCtx {
       const SelectivityVector& rows,
       const std::exception_ptr& exceptionPtr);
 
+  /// Records the user error in the failed 'status' as the error of 'index'.
+  /// Throws it if errors are not captured. Unlike setError() there is no
+  /// exception to unwind while errors are captured, e.g. under TRY.
+  void setStatus(vector_size_t index, const Status& status);
+
   /// Invokes a function on each selected row. Records per-row exceptions by
   /// calling 'setError'. The function must take a single "row" argument of type
   /// vector_size_t and return void.
   template <typename Callable>
   void applyToSelectedNoThrow(const SelectivityVector& rows, Callable func) {
-    rows.template applyToSelected([&](auto row) INLINE_LAMBDA {
-      try {
-        func(row);
-      } catch (const VeloxException& e) {
-        if (!e.isUserError()) {
-          throw;
-        }
-        // Avoid double throwing.
-        setVeloxExceptionError(row, std::current_exception());
-      } catch (const std::exception& e) {
-        setError(row, std::current_exception());
+    rows.template applyToSelectedNoThrow(
+        [&](auto row) INLINE_LAMBDA { func(row); },
+        [&](auto row) { setErrorFromCurrentException(row); });
+  }
+
+  /// Records the exception being handled as the error of 'row'. Rethrows it
+  /// if it is a VeloxException that is not a user error or if it is not a
+  /// std::exception. Must be called from within a catch block.
+  void setErrorFromCurrentException(vector_size_t row) {
+    try {
+      throw;
+    } catch (const VeloxException& e) {
+      if (!e.isUserError()) {
+        throw;
       }
-    });
+      // Avoid double throwing.
+      setVeloxExceptionError(row, std::current_exception());
+    } catch (const std::exception& e) {
+      setError(row, std::current_exception());
+    }
   }
 
   // Sets the error at 'index' in '*errorPtr' if the value is
@@ -302,6 +317,16 @@ class EvalCtx {
     return execCtx_->releaseVectors(vectors);
   }
 
+  /// Returns uninitialized temporary space for 'numElements' of T from the
+  /// scratch arena of 'execCtx_'. The space is not tracked per allocation and
+  /// stays valid until the most recently created EvalCtx on 'execCtx_' is
+  /// destroyed. Use this for index arrays, flags and other buffers that do not
+  /// outlive the evaluation of the current batch, not for vector buffers.
+  template <typename T>
+  T* FOLLY_NONNULL allocateScratch(vector_size_t numElements) {
+    return execCtx_->scratchArena().allocate<T>(numElements);
+  }
+
   /// Makes 'result' writable for 'rows'. Allocates or reuses a vector from the
   /// pool of 'execCtx_' if needed.
   void ensureWritable(
@@ -330,6 +355,8 @@ class EvalCtx {
   ExprSet* FOLLY_NULLABLE const exprSet_;
   const RowVector* FOLLY_NULLABLE row_;
   const bool cacheEnabled_;
+  // Position of the scratch arena of 'execCtx_' to rewind to on destruction.
+  const memory::ScratchArena::Mark scratchMark_;
   bool inputFlatNoNulls_;
 
   // Corresponds 1:1 to children of 'row_'. Set to an inner vector
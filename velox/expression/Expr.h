@@ -59,18 +59,26 @@ struct ExprStats {
   /// size.
   uint64_t numProcessedVectors{0};
 
+  /// Number of times AND / OR changed the order in which it evaluates its
+  /// inputs based on their measured cost per dropped row. Requires
+  /// QueryConfig.adaptiveFilterReorderingEnabled() to be 'true'.
+  uint64_t numInputReorders{0};
+
   void add(const ExprStats& other) {
     timing.add(other.timing);
     numProcessedRows += other.numProcessedRows;
     numProcessedVectors += other.numProcessedVectors;
+    numInputReorders += other.numInputReorders;
   }
 
   std::string toString() const {
     return fmt::format(
-        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}",
+        "timing: {}, numProcessedRows: {}, numProcessedVectors: {}, "
+        "numInputReorders: {}",
         timing.toString(),
         numProcessedRows,
-        numProcessedVectors);
+        numProcessedVectors,
+        numInputReorders);
   }
 };
 
@@ -401,6 +401,27 @@ std::unique_ptr<common::Filter> makeInFilter(
   }
 }
 
+// Returns a filter for Spark's might_contain('bloomExpr', field). The Bloom
+// filter of might_contain hashes the values like ValuesUsingBloomFilter.
+std::unique_ptr<common::Filter> makeMightContainFilter(
+    const core::TypedExprPtr& bloomExpr,
+    core::ExpressionEvaluator* evaluator) {
+  auto vector = toConstant(bloomExpr, evaluator);
+  if (!(vector && vector->type()->kind() == TypeKind::VARBINARY)) {
+    return nullptr;
+  }
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  if (!vector->isNullAt(0)) {
+    bloomFilter->merge(singleValue<StringView>(vector).data());
+  }
+  // might_contain is false for all values if there is no Bloom filter.
+  if (!bloomFilter->isSet()) {
+    return std::make_unique<common::AlwaysFalse>();
+  }
+  return std::make_unique<common::ValuesUsingBloomFilter>(
+      std::move(bloomFilter), false);
+}
+
 std::unique_ptr<common::Filter> makeBetweenFilter(
     const core::TypedExprPtr& lowerExpr,
     const core::TypedExprPtr& upperExpr,
@@ -506,6 +527,13 @@ std::unique_ptr<common::Filter> leafCallToSubfieldFilter(
     if (toSubfield(leftSide, subfield)) {
       return makeInFilter(call.inputs()[1], evaluator, negated);
     }
+  } else if (call.name() == "might_contain") {
+    // The Bloom filter is the first argument. A Bloom filter cannot be
+    // negated.
+    if (!negated && call.inputs().size() == 2 &&
+        toSubfield(call.inputs()[1].get(), subfield)) {
+      return makeMightContainFilter(call.inputs()[0], evaluator);
+    }
   } else if (call.name() == "is_null") {
     if (toSubfield(leftSide, subfield)) {
       if (negated) {
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <mutex>
+
+#include "velox/common/caching/SimpleLRUCache.h"
+#include "velox/type/Type.h"
+
+namespace facebook::velox::exec {
+
+/// Caches the resolutions of function calls by function name and argument
+/// types. Resolving a call binds the argument types to each signature of the
+/// function. Every driver compiles its own expressions, so a query with many
+/// drivers resolves the same calls many times over.
+///
+/// The owner of the cache must clear it after changing the functions it
+/// resolves. A resolution that started before the clear is not cached.
+///
+/// Thread-safe.
+template <typename Value>
+class FunctionResolutionCache {
+ public:
+  /// Number of cached resolutions of each cache.
+  static constexpr size_t kDefaultMaxEntries = 10'000;
+
+  explicit FunctionResolutionCache(size_t maxEntries = kDefaultMaxEntries)
+      : cache_(maxEntries) {}
+
+  /// Returns the cached resolution of 'name' for 'argTypes'. Calls 'resolve'
+  /// and caches its result if there is none.
+  template <typename Resolve>
+  Value get(
+      const std::string& name,
+      const std::vector<TypePtr>& argTypes,
+      Resolve resolve) {
+    auto key = makeKey(name, argTypes);
+    uint64_t generation;
+    {
+      std::lock_guard<std::mutex> l(mutex_);
+      if (auto value = cache_.get(key)) {
+        return std::move(value.value());
+      }
+      generation = generation_;
+    }
+
+    auto value = resolve();
+    std::lock_guard<std::mutex> l(mutex_);
+    if (generation == generation_) {
+      cache_.add(key, value);
+    }
+    return value;
+  }
+
+  void clear() {
+    std::lock_guard<std::mutex> l(mutex_);
+    ++generation_;
+    cache_.clear();
+  }
+
+  SimpleLRUCacheStats stats() const {
+    std::lock_guard<std::mutex> l(mutex_);
+    return cache_.getStats();
+  }
+
+ private:
+  static std::string makeKey(
+      const std::string& name,
+      const std::vector<TypePtr>& argTypes) {
+    std::string key = name;
+    for (const auto& type : argTypes) {
+      key.push_back('\0');
+      key.append(type->toString());
+    }
+    return key;
+  }
+
+  mutable std::mutex mutex_;
+  // Incremented by clear().
+  uint64_t generation_{0};
+  SimpleLRUCache<std::string, Value> cache_;
+};
+
+} // namespace facebook::velox::exec
@@ -72,6 +72,14 @@ class ExprCallable : public Callable {
     lambdaCtx.swapErrors(elementErrors);
   }
 
+  const RowTypePtr* signature() const override {
+    return &signature_;
+  }
+
+  const Expr* body() const override {
+    return body_.get();
+  }
+
  private:
   EvalCtx createLambdaCtx(
       EvalCtx* context,
@@ -333,7 +333,9 @@ class SimpleFunctionAdapter : public VectorFunction {
     }
 
     std::vector<std::optional<LocalDecodedVector>> decoded;
-    if (allPrimitiveArgsFlatConstant(args)) {
+    if (tryCallBatch(applyContext, args)) {
+      // All rows are computed by the batch flavor of the function.
+    } else if (allPrimitiveArgsFlatConstant(args)) {
       if constexpr (
           allArgsFlatConstantFastPathEligible() && specializeForAllEncodings) {
         unpackSpecializeForAllEncodings<0>(applyContext, args);
@@ -432,6 +434,69 @@ class SimpleFunctionAdapter : public VectorFunction {
   }
 
  private:
+  // Computes the result with FUNC::callBatch() if the function provides it,
+  // all rows are selected and all arguments are flat or constant without
+  // nulls. Returns false if the result is not computed.
+  bool tryCallBatch(
+      ApplyContext& applyContext,
+      const std::vector<VectorPtr>& args) const {
+    if constexpr (
+        FUNC::udf_has_callBatch && fastPathIteration &&
+        return_type_traits::typeKind != TypeKind::BOOLEAN) {
+      if (!applyContext.rows->isAllSelected()) {
+        return false;
+      }
+      for (const auto& arg : args) {
+        if (!(arg->isFlatEncoding() || arg->isConstantEncoding()) ||
+            arg->mayHaveNulls()) {
+          return false;
+        }
+      }
+      callBatch(
+          applyContext, args, std::make_index_sequence<FUNC::num_args>{});
+      return true;
+    }
+    return false;
+  }
+
+  template <size_t... Is>
+  void callBatch(
+      ApplyContext& applyContext,
+      const std::vector<VectorPtr>& args,
+      std::index_sequence<Is...>) const {
+    // Number of rows passed to one FUNC::callBatch(). Constant arguments are
+    // broadcast to this many values.
+    constexpr vector_size_t kBatchSize = 1'024;
+    const auto numRows = applyContext.rows->end();
+    const auto broadcastSize = std::min(numRows, kBatchSize);
+    std::tuple<std::vector<exec_arg_at<Is>>...> constantValues;
+    const std::tuple<const exec_arg_at<Is>*...> rawArgs{rawBatchArg<Is>(
+        *args[Is], std::get<Is>(constantValues), broadcastSize)...};
+    const std::array<bool, sizeof...(Is)> isConstant{
+        args[Is]->isConstantEncoding()...};
+    auto* rawResult = applyContext.resultWriter.data_;
+    for (vector_size_t begin = 0; begin < numRows; begin += kBatchSize) {
+      fn_->callBatch(
+          rawResult + begin,
+          (std::get<Is>(rawArgs) + (isConstant[Is] ? 0 : begin))...,
+          std::min(kBatchSize, numRows - begin));
+    }
+  }
+
+  template <size_t POSITION>
+  static const exec_arg_at<POSITION>* rawBatchArg(
+      const BaseVector& arg,
+      std::vector<exec_arg_at<POSITION>>& constantValues,
+      vector_size_t size) {
+    using TValue = exec_arg_at<POSITION>;
+    if (arg.isConstantEncoding()) {
+      constantValues.assign(
+          size, arg.asUnchecked<ConstantVector<TValue>>()->valueAt(0));
+      return constantValues.data();
+    }
+    return arg.asUnchecked<FlatVector<TValue>>()->rawValues();
+  }
+
   // This is called only when we know that all args are flat or constant and are
   // eligible for the optimization and the optimization is enabled.
   template <int32_t POSITION, typename... TReader>
@@ -557,7 +622,7 @@ class SimpleFunctionAdapter : public VectorFunction {
       };
 
       auto* data = getRawData();
-      auto writeResult = [&applyContext, &nullBuffer, &data](
+      auto writeResult = [this, &applyContext, &nullBuffer, &data](
                              auto row, bool notNull, auto out) INLINE_LAMBDA {
         // For fast path iteration, all active rows were already set as
         // non-null beforehand, so we only need to update the null buffer if
@@ -573,6 +638,7 @@ class SimpleFunctionAdapter : public VectorFunction {
             nullBuffer = applyContext.result->mutableRawNulls();
           }
           bits::setNull(nullBuffer, row);
+          setStatusIfError(applyContext, row);
         }
       };
       if (callNullFree) {
@@ -682,17 +748,36 @@ class SimpleFunctionAdapter : public VectorFunction {
         auto notNull = func(localWriter, row);
         currentWriter = localWriter;
         applyContext.resultWriter.commit(notNull);
+        if (!notNull) {
+          setStatusIfError(applyContext, row);
+        }
       });
       applyContext.resultWriter.finish();
     } else {
       applyContext.applyToSelectedNoThrow([&](auto row) INLINE_LAMBDA {
         applyContext.resultWriter.setOffset(row);
-        applyContext.resultWriter.commit(
-            func(applyContext.resultWriter.current(), row));
+        const bool notNull = func(applyContext.resultWriter.current(), row);
+        applyContext.resultWriter.commit(notNull);
+        if (!notNull) {
+          setStatusIfError(applyContext, row);
+        }
       });
     }
   }
 
+  // Records the error of 'row' if call() returned a failed Status for it.
+  // Called for the rows where the function returned null.
+  FOLLY_ALWAYS_INLINE void setStatusIfError(
+      ApplyContext& applyContext,
+      vector_size_t row) const {
+    if constexpr (FUNC::udf_has_call_return_status) {
+      auto status = fn_->takeStatus();
+      if (!status.ok()) {
+        applyContext.context.setStatus(row, status);
+      }
+    }
+  }
+
   // == NULLABLE VARIANTS ==
 
   // For default null behavior, assume everything is not null.
@@ -43,6 +43,7 @@ void SimpleFunctionRegistry::registerFunctionInternal(
     signatureMap[*metadata->signature()] =
         std::make_unique<const FunctionEntry>(metadata, factory);
   });
+  resolutions_.clear();
 }
 
 namespace {
@@ -76,6 +77,19 @@ std::optional<SimpleFunctionRegistry::ResolvedSimpleFunction>
 SimpleFunctionRegistry::resolveFunction(
     const std::string& name,
     const std::vector<TypePtr>& argTypes) const {
+  auto resolution = resolutions_.get(name, argTypes, [&]() {
+    return resolveFunctionUncached(name, argTypes);
+  });
+  return resolution.has_value()
+      ? std::optional<ResolvedSimpleFunction>(
+            ResolvedSimpleFunction(*resolution->entry, resolution->type))
+      : std::nullopt;
+}
+
+std::optional<SimpleFunctionRegistry::Resolution>
+SimpleFunctionRegistry::resolveFunctionUncached(
+    const std::string& name,
+    const std::vector<TypePtr>& argTypes) const {
   const FunctionEntry* selectedCandidate = nullptr;
   TypePtr selectedCandidateType = nullptr;
   registeredFunctions_.withRLock([&](const auto& map) {
@@ -98,8 +112,8 @@ SimpleFunctionRegistry::resolveFunction(
   VELOX_DCHECK(!selectedCandidate || selectedCandidateType);
 
   return selectedCandidate
-      ? std::optional<ResolvedSimpleFunction>(
-            ResolvedSimpleFunction(*selectedCandidate, selectedCandidateType))
+      ? std::optional<Resolution>(
+            Resolution{selectedCandidate, selectedCandidateType})
       : std::nullopt;
 }
 
@@ -17,6 +17,7 @@
 #pragma once
 
 #include "velox/core/SimpleFunctionMetadata.h"
+#include "velox/expression/FunctionResolutionCache.h"
 #include "velox/expression/SignatureBinder.h"
 #include "velox/expression/SimpleFunctionAdapter.h"
 #include "velox/type/Type.h"
@@ -86,6 +87,7 @@ class SimpleFunctionRegistry {
 
   void clearRegistry() {
     registeredFunctions_.withWLock([&](auto& map) { map.clear(); });
+    resolutions_.clear();
   }
 
   std::vector<const FunctionSignature*> getFunctionSignatures(
@@ -115,11 +117,27 @@ class SimpleFunctionRegistry {
     TypePtr type_;
   };
 
+  /// Returns the function with the signature that binds to 'argTypes' and
+  /// the highest priority. Resolutions are cached until the next
+  /// registration.
   std::optional<ResolvedSimpleFunction> resolveFunction(
       const std::string& name,
       const std::vector<TypePtr>& argTypes) const;
 
+  SimpleLRUCacheStats resolutionCacheStats() const {
+    return resolutions_.stats();
+  }
+
  private:
+  struct Resolution {
+    const FunctionEntry* entry;
+    TypePtr type;
+  };
+
+  std::optional<Resolution> resolveFunctionUncached(
+      const std::string& name,
+      const std::vector<TypePtr>& argTypes) const;
+
   template <typename T>
   static std::unique_ptr<T> CreateUdf() {
     return std::make_unique<T>();
@@ -131,6 +149,8 @@ class SimpleFunctionRegistry {
       const FunctionFactory& factory);
 
   folly::Synchronized<FunctionMap> registeredFunctions_;
+
+  mutable FunctionResolutionCache<std::optional<Resolution>> resolutions_;
 };
 
 const SimpleFunctionRegistry& simpleFunctions();
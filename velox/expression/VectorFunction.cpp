@@ -17,15 +17,34 @@
 #include <unordered_map>
 #include "folly/Singleton.h"
 #include "folly/Synchronized.h"
+#include "velox/expression/FunctionResolutionCache.h"
 #include "velox/expression/SignatureBinder.h"
 
 namespace facebook::velox::exec {
+namespace {
+
+// Return types of the vector function calls resolved so far, nullptr for the
+// calls that do not resolve.
+FunctionResolutionCache<TypePtr>& vectorFunctionResolutions() {
+  static FunctionResolutionCache<TypePtr> resolutions;
+  return resolutions;
+}
+
+} // namespace
 
 VectorFunctionMap& vectorFunctionFactories() {
   static VectorFunctionMap factories;
   return factories;
 }
 
+void clearVectorFunctionResolutions() {
+  vectorFunctionResolutions().clear();
+}
+
+SimpleLRUCacheStats vectorFunctionResolutionStats() {
+  return vectorFunctionResolutions().stats();
+}
+
 std::optional<std::vector<FunctionSignaturePtr>> getVectorFunctionSignatures(
     const std::string& name) {
   auto sanitizedName = sanitizeName(name);
@@ -41,17 +60,18 @@ std::optional<std::vector<FunctionSignaturePtr>> getVectorFunctionSignatures(
 std::shared_ptr<const Type> resolveVectorFunction(
     const std::string& functionName,
     const std::vector<TypePtr>& argTypes) {
-  if (auto vectorFunctionSignatures =
-          exec::getVectorFunctionSignatures(functionName)) {
-    for (const auto& signature : vectorFunctionSignatures.value()) {
-      exec::SignatureBinder binder(*signature, argTypes);
-      if (binder.tryBind()) {
-        return binder.tryResolveReturnType();
+  return vectorFunctionResolutions().get(functionName, argTypes, [&]() {
+    if (auto vectorFunctionSignatures =
+            exec::getVectorFunctionSignatures(functionName)) {
+      for (const auto& signature : vectorFunctionSignatures.value()) {
+        exec::SignatureBinder binder(*signature, argTypes);
+        if (binder.tryBind()) {
+          return binder.tryResolveReturnType();
+        }
       }
     }
-  }
-
-  return nullptr;
+    return TypePtr(nullptr);
+  });
 }
 
 std::shared_ptr<VectorFunction> getVectorFunction(
@@ -81,9 +101,13 @@ std::shared_ptr<VectorFunction> getVectorFunction(
       [&sanitizedName, &inputArgs, &config, &inputTypes](
           auto& functionMap) -> std::shared_ptr<VectorFunction> {
         if (resolveVectorFunction(sanitizedName, inputTypes)) {
+          // The resolution may be cached from before the function was
+          // removed by modifying vectorFunctionFactories() directly.
           auto functionIterator = functionMap.find(sanitizedName);
-          return functionIterator->second.factory(
-              sanitizedName, inputArgs, config);
+          if (functionIterator != functionMap.end()) {
+            return functionIterator->second.factory(
+                sanitizedName, inputArgs, config);
+          }
         }
         return nullptr;
       });
@@ -106,15 +130,21 @@ bool registerStatefulVectorFunction(
       functionMap[sanitizedName] = {
           std::move(signatures), std::move(factory), std::move(metadata)};
     });
+    clearVectorFunctionResolutions();
     return true;
   }
 
-  return vectorFunctionFactories().withWLock([&](auto& functionMap) {
-    auto [iterator, inserted] = functionMap.insert(
-        {sanitizedName,
-         {std::move(signatures), std::move(factory), std::move(metadata)}});
-    return inserted;
-  });
+  const bool inserted =
+      vectorFunctionFactories().withWLock([&](auto& functionMap) {
+        auto [iterator, inserted] = functionMap.insert(
+            {sanitizedName,
+             {std::move(signatures), std::move(factory), std::move(metadata)}});
+        return inserted;
+      });
+  if (inserted) {
+    clearVectorFunctionResolutions();
+  }
+  return inserted;
 }
 
 // Returns true iff an insertion actually happened
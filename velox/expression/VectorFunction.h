@@ -17,6 +17,7 @@
 #pragma once
 
 #include <vector>
+#include "velox/common/caching/SimpleLRUCache.h"
 #include "velox/core/Expressions.h"
 #include "velox/expression/EvalCtx.h"
 #include "velox/expression/FunctionSignature.h"
@@ -182,7 +183,8 @@ std::optional<std::vector<FunctionSignaturePtr>> getVectorFunctionSignatures(
 
 /// Given name of vector function and argument types, returns
 /// the return type if function exists and have a signature that binds to the
-/// input types otherwise returns nullptr.
+/// input types otherwise returns nullptr. The results are cached until the
+/// next registration.
 std::shared_ptr<const Type> resolveVectorFunction(
     const std::string& functionName,
     const std::vector<TypePtr>& argTypes);
@@ -251,6 +253,13 @@ using VectorFunctionMap =
 
 VectorFunctionMap& vectorFunctionFactories();
 
+/// Clears the cached results of resolveVectorFunction(). Must be called after
+/// modifying vectorFunctionFactories() directly. The register functions call
+/// it.
+void clearVectorFunctionResolutions();
+
+SimpleLRUCacheStats vectorFunctionResolutionStats();
+
 // A template to simplify making VectorFunctionFactory for a function that has a
 // constructor that takes inputTypes and constantInputs
 //
@@ -994,6 +994,48 @@ TEST_F(CastExprTest, primitiveValidCornerCases) {
   }
 }
 
+TEST_F(CastExprTest, stringToIntegerAndBack) {
+  setCastIntByTruncate(false);
+  // Plain decimals of up to 18 digits are parsed 8 digits at a time.
+  testCast<std::string, int64_t>(
+      "bigint",
+      {"0",
+       "-0",
+       "+7",
+       "12345678",
+       "-123456789",
+       "00000000000000001",
+       "999999999999999999",
+       "-999999999999999999",
+       "9223372036854775807",
+       "-9223372036854775808"},
+      {0,
+       0,
+       7,
+       12345678,
+       -123456789,
+       1,
+       999'999'999'999'999'999,
+       -999'999'999'999'999'999,
+       std::numeric_limits<int64_t>::max(),
+       std::numeric_limits<int64_t>::min()});
+  testCast<std::string, int32_t>(
+      "integer", {"2147483647", "-2147483648"}, {INT32_MAX, INT32_MIN});
+  testCast<std::string, int16_t>("smallint", {"-32768"}, {INT16_MIN});
+
+  // Out of range and malformed values fail as before.
+  testCast<std::string, int32_t>("integer", {"2147483648"}, {0}, true);
+  testCast<std::string, int16_t>("smallint", {"1234567a"}, {0}, true);
+  testCast<std::string, int64_t>("bigint", {"12345678.9"}, {0}, true);
+  testCast<std::string, int64_t>("bigint", {"-"}, {0}, true);
+
+  testCast<int64_t, std::string>(
+      "varchar",
+      {0, -1, 123456789012, std::numeric_limits<int64_t>::min()},
+      {"0", "-1", "123456789012", "-9223372036854775808"});
+  testCast<int8_t, std::string>("varchar", {-128, 127}, {"-128", "127"});
+}
+
 TEST_F(CastExprTest, truncateVsRound) {
   // Testing truncate vs round cast from double to int.
   setCastIntByTruncate(true);
@@ -16,6 +16,7 @@
 #include "gtest/gtest.h"
 #include "velox/common/base/tests/GTestUtils.h"
 #include "velox/expression/Expr.h"
+#include "velox/functions/Udf.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
 #include "velox/functions/prestosql/types/JsonType.h"
 #include "velox/parse/Expressions.h"
@@ -25,6 +26,24 @@
 
 namespace facebook::velox::exec::test {
 
+template <typename T>
+struct TestLengthFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  void call(int64_t& out, const arg_type<Varchar>& input) {
+    out = input.size();
+  }
+};
+
+template <typename T>
+struct TestIdentityFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  void call(int64_t& out, const int64_t& input) {
+    out = input;
+  }
+};
+
 class ExprCompilerTest : public testing::Test,
                          public velox::test::VectorTestBase {
  protected:
@@ -302,4 +321,36 @@ TEST_F(ExprCompilerTest, rewrites) {
       execCtx_.get()));
 }
 
+TEST_F(ExprCompilerTest, functionResolutionCache) {
+  auto rowType = ROW({"a"}, {BIGINT()});
+  auto field = makeField(rowType);
+  auto expression = call("plus", {field("a"), bigint(1)});
+
+  // Compilations after the first one reuse the resolution of plus.
+  compile(expression);
+  auto before = simpleFunctions().resolutionCacheStats();
+  compile(expression);
+  compile(expression);
+  auto after = simpleFunctions().resolutionCacheStats();
+  ASSERT_EQ(after.numLookups - before.numLookups, 2);
+  ASSERT_EQ(after.numHits - before.numHits, 2);
+
+  // Registering a function invalidates the resolutions cached before,
+  // including the ones that did not resolve.
+  registerFunction<TestIdentityFunction, int64_t, int64_t>(
+      {"resolution_cache_test"});
+  auto varcharCall = std::make_shared<core::CallTypedExpr>(
+      BIGINT(),
+      std::vector<core::TypedExprPtr>{varchar("abc")},
+      "resolution_cache_test");
+  VELOX_ASSERT_THROW(
+      compile(varcharCall),
+      "Scalar function resolution_cache_test not registered with arguments: "
+      "(VARCHAR).");
+
+  registerFunction<TestLengthFunction, int64_t, Varchar>(
+      {"resolution_cache_test"});
+  ASSERT_EQ("3:BIGINT", compile(varcharCall)->toString());
+}
+
 } // namespace facebook::velox::exec::test
@@ -473,6 +473,13 @@ TEST_P(ParameterizedExprTest, reorder) {
         condition->selectivityAt(i - 1).timeToDropValue(),
         condition->selectivityAt(i).timeToDropValue());
   }
+
+  // Each change of the evaluation order is counted in the stats.
+  const auto& inputOrder = condition->inputOrder();
+  ASSERT_EQ(inputOrder.size(), 2);
+  const uint64_t expectedReorders = inputOrder[0] == 0 ? 0 : 1;
+  EXPECT_EQ(condition->stats().numInputReorders, expectedReorders);
+  EXPECT_EQ(exprSet->stats().at("and").numInputReorders, expectedReorders);
 }
 
 TEST_P(ParameterizedExprTest, constant) {
@@ -230,6 +230,46 @@ TEST_F(ExprToSubfieldFilterTest, userError) {
   ASSERT_FALSE(filter);
 }
 
+TEST_F(ExprToSubfieldFilterTest, mightContain) {
+  BloomFilter<> bloomFilter;
+  bloomFilter.reset(100);
+  for (int64_t i = 0; i < 100; i += 2) {
+    bloomFilter.insert(folly::hasher<int64_t>()(i));
+  }
+  std::string serialized(bloomFilter.serializedSize(), '\0');
+  bloomFilter.serialize(serialized.data());
+  auto makeCall = [](variant bloom) {
+    return core::CallTypedExpr(
+        BOOLEAN(),
+        std::vector<core::TypedExprPtr>{
+            std::make_shared<core::ConstantTypedExpr>(
+                VARBINARY(), std::move(bloom)),
+            std::make_shared<core::FieldAccessTypedExpr>(BIGINT(), "a")},
+        "might_contain");
+  };
+
+  Subfield subfield;
+  auto filter = leafCallToSubfieldFilter(
+      makeCall(variant::binary(serialized)), subfield, evaluator());
+  ASSERT_TRUE(filter);
+  validateSubfield(subfield, {"a"});
+  ASSERT_EQ(filter->kind(), FilterKind::kBloomFilter);
+  ASSERT_FALSE(filter->testNull());
+  for (int64_t i = 0; i < 100; i += 2) {
+    ASSERT_TRUE(filter->testInt64(i));
+  }
+
+  // Negated might_contain is not converted.
+  ASSERT_FALSE(leafCallToSubfieldFilter(
+      makeCall(variant::binary(serialized)), subfield, evaluator(), true));
+
+  // A null Bloom filter passes no values.
+  filter = leafCallToSubfieldFilter(
+      makeCall(variant::null(TypeKind::VARBINARY)), subfield, evaluator());
+  ASSERT_TRUE(filter);
+  ASSERT_EQ(filter->kind(), FilterKind::kAlwaysFalse);
+}
+
 TEST_F(ExprToSubfieldFilterTest, dereferenceWithEmptyField) {
   auto call = std::make_shared<core::CallTypedExpr>(
       BOOLEAN(),
@@ -21,6 +21,7 @@
 #include <glog/logging.h>
 #include "folly/lang/Hint.h"
 #include "gtest/gtest.h"
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/expression/Expr.h"
 #include "velox/functions/Udf.h"
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
@@ -1131,6 +1132,107 @@ TEST_F(SimpleFunctionTest, testAllNotNull) {
   assertEqualVectors(expected, result);
 }
 
+// Function that provides a batch flavor of call() and counts the rows it
+// computes with each.
+template <typename T>
+struct BatchFunction {
+  static inline int64_t numBatchRows{0};
+  static inline int64_t numRows{0};
+
+  FOLLY_ALWAYS_INLINE void
+  call(int64_t& out, const int64_t& a, const int64_t& b) {
+    out = a * 2 + b;
+    ++numRows;
+  }
+
+  FOLLY_ALWAYS_INLINE void
+  callBatch(int64_t* out, const int64_t* a, const int64_t* b, int32_t size) {
+    for (auto i = 0; i < size; ++i) {
+      out[i] = a[i] * 2 + b[i];
+    }
+    numBatchRows += size;
+  }
+};
+
+TEST_F(SimpleFunctionTest, callBatch) {
+  registerFunction<BatchFunction, int64_t, int64_t, int64_t>({"batch_func"});
+  static_assert(core::UDFHolder<
+                BatchFunction<exec::VectorExec>,
+                exec::VectorExec,
+                int64_t,
+                int64_t,
+                int64_t>::udf_has_callBatch);
+
+  constexpr vector_size_t kSize = 3'000;
+  auto a = makeFlatVector<int64_t>(kSize, [](auto row) { return row; });
+  auto b = makeFlatVector<int64_t>(kSize, [](auto row) { return row % 7; });
+  auto data = makeRowVector({a, b});
+
+  // Flat and constant inputs without nulls use callBatch().
+  auto result = evaluate("batch_func(c0, c1)", data);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          kSize, [](auto row) { return row * 2 + row % 7; }),
+      result);
+  result = evaluate("batch_func(c0, 5)", data);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row * 2 + 5; }),
+      result);
+  EXPECT_EQ(BatchFunction<exec::VectorExec>::numBatchRows, 2 * kSize);
+  EXPECT_EQ(BatchFunction<exec::VectorExec>::numRows, 0);
+
+  // Inputs with nulls and partial row selections use call().
+  auto nullable = makeFlatVector<int64_t>(
+      kSize, [](auto row) { return row; }, nullEvery(5));
+  result = evaluate("batch_func(c0, c1)", makeRowVector({nullable, b}));
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          kSize, [](auto row) { return row * 2 + row % 7; }, nullEvery(5)),
+      result);
+  result = evaluate("if(c1 = 0, 0::BIGINT, batch_func(c0, c1))", data);
+  assertEqualVectors(
+      makeFlatVector<int64_t>(
+          kSize,
+          [](auto row) { return row % 7 == 0 ? 0 : row * 2 + row % 7; }),
+      result);
+  EXPECT_EQ(BatchFunction<exec::VectorExec>::numBatchRows, 2 * kSize);
+  EXPECT_GT(BatchFunction<exec::VectorExec>::numRows, 0);
+}
+
+// Function that reports negative inputs with a Status instead of throwing.
+template <typename T>
+struct StatusFunction {
+  FOLLY_ALWAYS_INLINE Status call(int64_t& out, const int64_t& input) {
+    if (input < 0) {
+      return Status::UserError(fmt::format("Negative input: {}", input));
+    }
+    out = input * 2;
+    return Status::OK();
+  }
+};
+
+TEST_F(SimpleFunctionTest, status) {
+  registerFunction<StatusFunction, int64_t, int64_t>({"status_func"});
+  auto data = makeRowVector({makeNullableFlatVector<int64_t>(
+      {1, -2, std::nullopt, 4, -5})});
+
+  auto result = evaluate("try(status_func(c0))", data);
+  assertEqualVectors(
+      makeNullableFlatVector<int64_t>(
+          {2, std::nullopt, std::nullopt, 8, std::nullopt}),
+      result);
+
+  VELOX_ASSERT_THROW(
+      evaluate("status_func(c0)", data), "Negative input: -2");
+
+  // The failed rows are null in a conditional under TRY as well.
+  result = evaluate("try(coalesce(status_func(c0), 0))", data);
+  assertEqualVectors(
+      makeNullableFlatVector<int64_t>(
+          {2, std::nullopt, 0, 8, std::nullopt}),
+      result);
+}
+
 // Test that SimpleFunctionRegistry does not crash in multithreaded environment.
 TEST_F(SimpleFunctionTest, simpleFunctionRegistryThreadSafe) {
   std::vector<std::thread> threads;
@@ -62,6 +62,8 @@ DEFINE_bool(avx2, true, "Enables use of AVX2 when available");
 
 DEFINE_bool(bmi2, true, "Enables use of BMI2 when available");
 
+DEFINE_bool(avx512, true, "Enables use of AVX-512 when available");
+
 // Used in exec/Expr.cpp
 
 DEFINE_string(
@@ -91,6 +93,19 @@ DEFINE_bool(
     false,
     "If true, 'MemoryPool' will be running in debug mode to track the allocation and free call sites to detect the source of memory leak for testing purpose");
 
+DEFINE_int64(
+    velox_memory_pool_reservation_slack_bytes,
+    0,
+    "Unused memory reservation in bytes that a leaf memory pool keeps on free "
+    "instead of returning it to its parent");
+
+DEFINE_uint64(
+    velox_memory_pool_allocation_sample_bytes,
+    0,
+    "If non-zero, 'MemoryPool' records the call stack of about one "
+    "allocation per this many allocated bytes to build a sampled allocation "
+    "profile");
+
 // TODO: deprecate this after solves all the use cases that can cause
 // significant performance regression by memory usage tracking.
 DEFINE_bool(
@@ -105,3 +120,10 @@ DEFINE_bool(
     "exception. This is only used by test to control the test error output size");
 
 DEFINE_bool(velox_memory_use_hugepages, true, "Use explicit huge pages");
+
+DEFINE_uint64(
+    velox_memory_hugepage_min_bytes,
+    2 << 20,
+    "Minimum size of a contiguous allocation for which transparent huge pages "
+    "are requested. Large allocations of at least this size are also mapped "
+    "at a huge page boundary so that khugepaged can collapse all of them");
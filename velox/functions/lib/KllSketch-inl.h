@@ -293,6 +293,49 @@ void KllSketch<T, A, C>::insert(T value) {
   doInsert(value);
 }
 
+template <typename T, typename A, typename C>
+void KllSketch<T, A, C>::insert(folly::Range<const T*> values) {
+  if (values.empty()) {
+    return;
+  }
+  auto [minIt, maxIt] = std::minmax_element(values.begin(), values.end(), C());
+  if (n_ == 0) {
+    minValue_ = *minIt;
+    maxValue_ = *maxIt;
+  } else {
+    minValue_ = std::min(minValue_, *minIt, C());
+    maxValue_ = std::max(maxValue_, *maxIt, C());
+  }
+  VELOX_DCHECK_GT(k_, 0);
+  VELOX_DCHECK_GE(levels_.size(), 2);
+  size_t i = 0;
+  while (i < values.size()) {
+    size_t count;
+    if (items_.size() < k_ && numLevels() == 1) {
+      count = std::min<size_t>(k_ - items_.size(), values.size() - i);
+      items_.insert(
+          items_.end(), values.begin() + i, values.begin() + i + count);
+      levels_[1] += count;
+    } else if (levels_[0] == 0) {
+      // Compacts to make room in level zero.
+      count = 1;
+      items_[insertPosition()] = values[i];
+    } else {
+      // Level zero grows downwards, fill the free slots in the same order as
+      // one insert() per value.
+      count = std::min<size_t>(levels_[0], values.size() - i);
+      levels_[0] -= count;
+      std::reverse_copy(
+          values.begin() + i,
+          values.begin() + i + count,
+          items_.begin() + levels_[0]);
+    }
+    i += count;
+    n_ += count;
+  }
+  isLevelZeroSorted_ = false;
+}
+
 template <typename T, typename A, typename C>
 void KllSketch<T, A, C>::doInsert(T value) {
   VELOX_DCHECK_GT(k_, 0);
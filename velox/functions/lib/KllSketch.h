@@ -60,6 +60,11 @@ struct KllSketch {
   /// Add one new value to the sketch.
   void insert(T value);
 
+  /// Add multiple new values to the sketch.  Equivalent to calling
+  /// insert(value) for each of them, but copies runs of values into
+  /// the free space of level zero at once.
+  void insert(folly::Range<const T*> values);
+
   /// Call this before serialization can optimize the space used.
   void compact();
 
@@ -16,10 +16,13 @@
 #include "velox/functions/lib/Re2Functions.h"
 
 #include <re2/re2.h>
+#include <xsimd/xsimd.hpp>
 #include <memory>
 #include <optional>
 #include <string>
 
+#include "velox/common/base/SimdUtil.h"
+#include "velox/core/Expressions.h"
 #include "velox/expression/VectorWriters.h"
 #include "velox/type/StringView.h"
 #include "velox/vector/BaseVector.h"
@@ -239,6 +242,58 @@ class Re2Match final : public VectorFunction {
   }
 };
 
+// Returns whether str has a substring matching any of the constant patterns.
+// Compiles all patterns into one RE2::Set, so each string is scanned once no
+// matter how many patterns there are.
+class Re2SearchAnyConstantPatterns final : public VectorFunction {
+ public:
+  explicit Re2SearchAnyConstantPatterns(
+      const std::vector<std::string>& patterns)
+      : set_(RE2::Options(RE2::Quiet), RE2::UNANCHORED) {
+    for (const auto& pattern : patterns) {
+      std::string error;
+      if (set_.Add(toStringPiece(pattern), &error) < 0) {
+        error_ = fmt::format("invalid regular expression:{}", error);
+        return;
+      }
+    }
+    if (!set_.Compile()) {
+      error_ = fmt::format(
+          "Failed to compile a set of {} regular expressions",
+          patterns.size());
+    }
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& /* outputType */,
+      EvalCtx& context,
+      VectorPtr& resultRef) const final {
+    VELOX_CHECK_GE(args.size(), 2);
+    if (error_.has_value()) {
+      try {
+        VELOX_USER_FAIL(error_.value());
+      } catch (const std::exception& e) {
+        context.setErrors(rows, std::current_exception());
+        return;
+      }
+    }
+
+    FlatVector<bool>& result = ensureWritableBool(rows, context, resultRef);
+    exec::LocalDecodedVector toSearch(context, *args[0], rows);
+    context.applyToSelectedNoThrow(rows, [&](vector_size_t i) {
+      result.set(
+          i,
+          set_.Match(toStringPiece(toSearch->valueAt<StringView>(i)), nullptr));
+    });
+  }
+
+ private:
+  RE2::Set set_;
+  std::optional<std::string> error_;
+};
+
 void checkForBadGroupId(int groupId, const RE2& re) {
   if (UNLIKELY(groupId < 0 || groupId > re.NumberOfCapturingGroups())) {
     VELOX_USER_FAIL("No group {} in regex '{}'", groupId, re.pattern());
@@ -479,6 +534,161 @@ class OptimizedLikeWithMemcmp final : public VectorFunction {
   vector_size_t reducedPatternLength_;
 };
 
+// Returns the position of the first occurrence of 'needle' in 'size' bytes
+// starting at 'haystack' or nullptr if there is none. Compares a batch of
+// candidate positions at a time against the first and the last byte of the
+// needle and runs memcmp only at positions where both match.
+const char*
+findSubstring(const char* haystack, size_t size, const std::string& needle) {
+  using Batch = xsimd::batch<uint8_t>;
+  constexpr int32_t kBatch = Batch::size;
+  const auto length = needle.size();
+  if (length > size) {
+    return nullptr;
+  }
+  const auto firstByte = Batch::broadcast(needle[0]);
+  const auto lastByte = Batch::broadcast(needle[length - 1]);
+  const auto data = reinterpret_cast<const uint8_t*>(haystack);
+  size_t i = 0;
+  for (; i + length - 1 + kBatch <= size; i += kBatch) {
+    uint32_t bits = simd::toBitMask(
+        firstByte == Batch::load_unaligned(data + i) &&
+        lastByte == Batch::load_unaligned(data + i + length - 1));
+    while (bits) {
+      const auto candidate = haystack + i + __builtin_ctz(bits);
+      if (std::memcmp(candidate, needle.data(), length) == 0) {
+        return candidate;
+      }
+      // Clear last set bit in 'bits'.
+      bits &= bits - 1;
+    }
+  }
+  for (; i + length <= size; ++i) {
+    if (std::memcmp(haystack + i, needle.data(), length) == 0) {
+      return haystack + i;
+    }
+  }
+  return nullptr;
+}
+
+// Used for constant patterns without escape character that consist of fixed
+// substrings separated by one or more '%', e.g. '%foo%bar%' or 'foo%bar'.
+// Matches the substrings left to right with a SIMD substring search instead of
+// running a regular expression.
+class LikeWithSubstrings final : public VectorFunction {
+ public:
+  LikeWithSubstrings(
+      std::vector<std::string> substrings,
+      bool anchoredStart,
+      bool anchoredEnd)
+      : substrings_{std::move(substrings)},
+        anchoredStart_{anchoredStart},
+        anchoredEnd_{anchoredEnd} {}
+
+  // Returns a function if 'pattern' has no '_' and is not a single fixed
+  // string. Returns nullptr otherwise.
+  static std::shared_ptr<VectorFunction> tryCreate(StringView pattern) {
+    std::vector<std::string> substrings;
+    std::string current;
+    for (size_t i = 0; i < pattern.size(); ++i) {
+      const char c = pattern.data()[i];
+      if (c == '_') {
+        return nullptr;
+      }
+      if (c == '%') {
+        if (!current.empty()) {
+          substrings.push_back(std::move(current));
+          current.clear();
+        }
+      } else {
+        current.push_back(c);
+      }
+    }
+    if (!current.empty()) {
+      substrings.push_back(std::move(current));
+    }
+    const bool anchoredStart = pattern.size() > 0 && pattern.data()[0] != '%';
+    const bool anchoredEnd =
+        pattern.size() > 0 && pattern.data()[pattern.size() - 1] != '%';
+    if (substrings.empty() ||
+        (substrings.size() == 1 && anchoredStart && anchoredEnd)) {
+      return nullptr;
+    }
+    return std::make_shared<LikeWithSubstrings>(
+        std::move(substrings), anchoredStart, anchoredEnd);
+  }
+
+  bool match(StringView input) const {
+    const char* begin = input.data();
+    const char* end = begin + input.size();
+    size_t first = 0;
+    size_t last = substrings_.size();
+    if (anchoredStart_) {
+      const auto& prefix = substrings_[0];
+      if (input.size() < prefix.size() ||
+          std::memcmp(begin, prefix.data(), prefix.size()) != 0) {
+        return false;
+      }
+      begin += prefix.size();
+      ++first;
+    }
+    if (anchoredEnd_) {
+      const auto& suffix = substrings_.back();
+      if (static_cast<size_t>(end - begin) < suffix.size() ||
+          std::memcmp(end - suffix.size(), suffix.data(), suffix.size()) !=
+              0) {
+        return false;
+      }
+      end -= suffix.size();
+      --last;
+    }
+    for (auto i = first; i < last; ++i) {
+      const auto& substring = substrings_[i];
+      auto position = findSubstring(begin, end - begin, substring);
+      if (position == nullptr) {
+        return false;
+      }
+      begin = position + substring.size();
+    }
+    return true;
+  }
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& /* outputType */,
+      EvalCtx& context,
+      VectorPtr& resultRef) const final {
+    VELOX_CHECK(args.size() == 2 || args.size() == 3);
+    FlatVector<bool>& result = ensureWritableBool(rows, context, resultRef);
+    exec::DecodedArgs decodedArgs(rows, args, context);
+    auto toSearch = decodedArgs.at(0);
+
+    if (toSearch->isIdentityMapping()) {
+      auto input = toSearch->data<StringView>();
+      context.applyToSelectedNoThrow(
+          rows, [&](vector_size_t i) { result.set(i, match(input[i])); });
+      return;
+    }
+    if (toSearch->isConstantMapping()) {
+      bool matchResult = match(toSearch->valueAt<StringView>(0));
+      context.applyToSelectedNoThrow(
+          rows, [&](vector_size_t i) { result.set(i, matchResult); });
+      return;
+    }
+
+    // Since the likePattern and escapeChar (2nd and 3rd args) are both
+    // constants, so the first arg is expected to be either of flat or constant
+    // vector only. This code path is unreachable.
+    VELOX_UNREACHABLE();
+  }
+
+ private:
+  const std::vector<std::string> substrings_;
+  const bool anchoredStart_;
+  const bool anchoredEnd_;
+};
+
 // This function is used when pattern and escape are constants. And there is not
 // fast path that avoids compiling the regular expression.
 class LikeWithRe2 final : public VectorFunction {
@@ -874,6 +1084,161 @@ std::vector<std::shared_ptr<exec::FunctionSignature>> re2SearchSignatures() {
               .build()};
 }
 
+std::shared_ptr<VectorFunction> makeRe2SearchAny(
+    const std::string& name,
+    const std::vector<VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& /*config*/) {
+  if (inputArgs.size() < 2) {
+    VELOX_UNSUPPORTED(
+        "{} expected at least two arguments but got ({})",
+        name,
+        printTypesCsv(inputArgs));
+  }
+  std::vector<std::string> patterns;
+  patterns.reserve(inputArgs.size() - 1);
+  for (auto i = 1; i < inputArgs.size(); ++i) {
+    BaseVector* constantPattern = inputArgs[i].constantValue.get();
+    VELOX_USER_CHECK(
+        constantPattern != nullptr && !constantPattern->isNullAt(0),
+        "{} requires non-null constant patterns",
+        name);
+    patterns.push_back(
+        constantPattern->as<ConstantVector<StringView>>()->valueAt(0).str());
+  }
+  return std::make_shared<Re2SearchAnyConstantPatterns>(patterns);
+}
+
+std::vector<std::shared_ptr<exec::FunctionSignature>>
+re2SearchAnySignatures() {
+  // varchar, varchar... -> boolean
+  return {exec::FunctionSignatureBuilder()
+              .returnType("boolean")
+              .argumentType("varchar")
+              .constantArgumentType("varchar")
+              .variableArity()
+              .build()};
+}
+
+namespace {
+
+// If 'expr' is a call to 'searchName' with a valid non-null constant pattern,
+// returns the pattern and sets 'input' to the searched expression.
+std::optional<std::string> asConstantPatternSearch(
+    const std::string& searchName,
+    const core::TypedExprPtr& expr,
+    core::TypedExprPtr& input) {
+  auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr);
+  if (call == nullptr || call->name() != searchName ||
+      call->inputs().size() != 2) {
+    return std::nullopt;
+  }
+  auto constant = std::dynamic_pointer_cast<const core::ConstantTypedExpr>(
+      call->inputs()[1]);
+  if (constant == nullptr || !constant->type()->isVarchar()) {
+    return std::nullopt;
+  }
+  std::string pattern;
+  if (constant->hasValueVector()) {
+    const auto& valueVector = constant->valueVector();
+    if (valueVector->isNullAt(0)) {
+      return std::nullopt;
+    }
+    pattern = valueVector->as<SimpleVector<StringView>>()->valueAt(0).str();
+  } else {
+    if (constant->value().isNull()) {
+      return std::nullopt;
+    }
+    pattern = constant->value().value<TypeKind::VARCHAR>();
+  }
+
+  // Leave invalid patterns alone so that their errors are reported the same
+  // way as before the rewrite.
+  RE2::Set set(RE2::Options(RE2::Quiet), RE2::UNANCHORED);
+  if (set.Add(toStringPiece(pattern), nullptr) < 0) {
+    return std::nullopt;
+  }
+  input = call->inputs()[0];
+  return pattern;
+}
+
+void flattenDisjunction(
+    const core::TypedExprPtr& expr,
+    std::vector<core::TypedExprPtr>& disjuncts) {
+  auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr);
+  if (call != nullptr && call->name() == "or") {
+    for (const auto& input : call->inputs()) {
+      flattenDisjunction(input, disjuncts);
+    }
+  } else {
+    disjuncts.push_back(expr);
+  }
+}
+
+} // namespace
+
+core::TypedExprPtr rewriteRe2SearchDisjunction(
+    const std::string& searchName,
+    const std::string& searchAnyName,
+    const core::TypedExprPtr& expr) {
+  auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr);
+  if (call == nullptr || call->name() != "or") {
+    return nullptr;
+  }
+
+  std::vector<core::TypedExprPtr> disjuncts;
+  flattenDisjunction(expr, disjuncts);
+
+  // Group searches with constant patterns by the searched expression.
+  struct Group {
+    core::TypedExprPtr input;
+    std::vector<core::TypedExprPtr> arguments;
+  };
+  std::vector<Group> groups;
+  std::vector<int32_t> disjunctGroups(disjuncts.size(), -1);
+  for (auto i = 0; i < disjuncts.size(); ++i) {
+    core::TypedExprPtr input;
+    auto pattern = asConstantPatternSearch(searchName, disjuncts[i], input);
+    if (!pattern.has_value()) {
+      continue;
+    }
+    auto it = std::find_if(groups.begin(), groups.end(), [&](const auto& g) {
+      return *g.input == *input;
+    });
+    if (it == groups.end()) {
+      groups.push_back({input, {input}});
+      it = groups.end() - 1;
+    }
+    it->arguments.push_back(disjuncts[i]->inputs()[1]);
+    disjunctGroups[i] = it - groups.begin();
+  }
+
+  bool rewritten = false;
+  std::vector<bool> emitted(groups.size(), false);
+  std::vector<core::TypedExprPtr> inputs;
+  for (auto i = 0; i < disjuncts.size(); ++i) {
+    const auto groupIndex = disjunctGroups[i];
+    if (groupIndex < 0 || groups[groupIndex].arguments.size() < 3) {
+      inputs.push_back(disjuncts[i]);
+      continue;
+    }
+    if (!emitted[groupIndex]) {
+      emitted[groupIndex] = true;
+      inputs.push_back(std::make_shared<core::CallTypedExpr>(
+          BOOLEAN(), std::move(groups[groupIndex].arguments), searchAnyName));
+      rewritten = true;
+    }
+  }
+
+  if (!rewritten) {
+    return nullptr;
+  }
+  if (inputs.size() == 1) {
+    return inputs[0];
+  }
+  return std::make_shared<core::CallTypedExpr>(
+      call->type(), std::move(inputs), call->name());
+}
+
 std::shared_ptr<VectorFunction> makeRe2Extract(
     const std::string& name,
     const std::vector<VectorFunctionArg>& inputArgs,
@@ -1091,7 +1456,10 @@ std::shared_ptr<exec::VectorFunction> makeLike(
         return std::make_shared<OptimizedLikeWithMemcmp<PatternKind::kSuffix>>(
             pattern, reducedLength);
       default:
-
+        if (auto likeWithSubstrings =
+                LikeWithSubstrings::tryCreate(pattern)) {
+          return likeWithSubstrings;
+        }
         return std::make_shared<LikeWithRe2>(pattern, escapeChar);
     }
   }
@@ -73,6 +73,30 @@ std::shared_ptr<exec::VectorFunction> makeRe2Search(
 
 std::vector<std::shared_ptr<exec::FunctionSignature>> re2SearchSignatures();
 
+/// re2SearchAny(string, pattern1, pattern2, ...) → bool
+///
+/// Returns whether str has a substr that matches any of the constant regex
+/// patterns. All patterns are compiled into a single RE2::Set so that each
+/// string is scanned once. If any pattern is invalid, throws an exception.
+std::shared_ptr<exec::VectorFunction> makeRe2SearchAny(
+    const std::string& name,
+    const std::vector<exec::VectorFunctionArg>& inputArgs,
+    const core::QueryConfig& config);
+
+std::vector<std::shared_ptr<exec::FunctionSignature>> re2SearchAnySignatures();
+
+/// Rewrites a disjunction of two or more 'searchName'(x, <constant pattern>)
+/// calls over the same x into a single 'searchAnyName'(x, pattern1, ...) call.
+/// For example, rewrites
+///    regexp_like(c0, 'a.c') OR regexp_like(c0, '^x') OR c1 > 10
+/// into
+///    regexp_like_any(c0, 'a.c', '^x') OR c1 > 10
+/// Returns new expression or nullptr if rewrite is not possible.
+core::TypedExprPtr rewriteRe2SearchDisjunction(
+    const std::string& searchName,
+    const std::string& searchAnyName,
+    const core::TypedExprPtr& expr);
+
 /// re2Extract(string, pattern, group_id) → string
 /// re2Extract(string, pattern) → string
 ///
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "velox/common/base/SimdUtil.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/type/Type.h"
@@ -345,6 +346,18 @@ class SubscriptImpl : public exec::Subscript {
     auto rawSizes = baseMap->rawSizes();
     auto rawOffsets = baseMap->rawOffsets();
 
+    // Keys of a map with sorted keys can be binary searched. Booleans are
+    // bit packed and floating point keys may have NaNs, which do not order.
+    constexpr bool kBinarySearchable =
+        !std::is_same_v<TKey, bool> && !std::is_floating_point_v<TKey>;
+    const TKey* sortedKeys = nullptr;
+    if constexpr (kBinarySearchable) {
+      if (baseMap->hasSortedKeys() && decodedMapKeys->isIdentityMapping() &&
+          !decodedMapKeys->mayHaveNulls()) {
+        sortedKeys = decodedMapKeys->data<TKey>();
+      }
+    }
+
     // Lambda that does the search for a key, for each row.
     auto processRow = [&](vector_size_t row, TKey searchKey) {
       size_t mapIndex = mapIndices[row];
@@ -352,6 +365,18 @@ class SubscriptImpl : public exec::Subscript {
       size_t offsetEnd = offsetStart + rawSizes[mapIndex];
       bool found = false;
 
+      if (sortedKeys != nullptr &&
+          offsetEnd - offsetStart >= kMinBinarySearchSize) {
+        auto it = std::lower_bound(
+            sortedKeys + offsetStart, sortedKeys + offsetEnd, searchKey);
+        if (it != sortedKeys + offsetEnd && *it == searchKey) {
+          rawIndices[row] = it - sortedKeys;
+        } else {
+          nullsBuilder.setNull(row);
+        }
+        return;
+      }
+
       // Sequentially check each key on this map for a match. We use a
       // sequential scan over the keys because it's easier to express (and
       // likely has good memory locality), but if we find that this is slow
@@ -377,8 +402,24 @@ class SubscriptImpl : public exec::Subscript {
     // When second argument ("at") is a constant.
     if (decodedIndices->isConstantMapping()) {
       auto searchKey = decodedIndices->valueAt<TKey>(0);
-      rows.applyToSelected(
-          [&](vector_size_t row) { processRow(row, searchKey); });
+      bool done = false;
+      if constexpr (kSimdComparable<TKey>) {
+        if (sortedKeys == nullptr && decodedMapKeys->isIdentityMapping()) {
+          done = findConstantKey(
+              rows,
+              mapIndices,
+              rawOffsets,
+              rawSizes,
+              decodedMapKeys->data<TKey>(),
+              searchKey,
+              rawIndices,
+              nullsBuilder);
+        }
+      }
+      if (!done) {
+        rows.applyToSelected(
+            [&](vector_size_t row) { processRow(row, searchKey); });
+      }
     }
     // When the second argument ("at") is also a variable vector.
     else {
@@ -399,6 +440,69 @@ class SubscriptImpl : public exec::Subscript {
         nullsBuilder.build(), indices, rows.end(), baseMap->mapValues());
   }
 
+  // Maps with at least this many keys are binary searched if the keys are
+  // sorted.
+  static constexpr size_t kMinBinarySearchSize = 16;
+
+  // Key types compared a SIMD batch at a time.
+  template <typename T>
+  static constexpr bool kSimdComparable =
+      (std::is_integral_v<T> && sizeof(T) <= 8 &&
+       !std::is_same_v<T, bool>) ||
+      std::is_floating_point_v<T>;
+
+  // Looks up 'searchKey' in the maps of 'rows' by comparing all their keys to
+  // it in one pass over 'rawKeys' and then taking the first match in the
+  // range of each map. Sets 'rawIndices' to the position of the match or a
+  // null in 'nullsBuilder'. Returns false without doing anything if the maps
+  // do not cover most of their range of keys, e.g. when few rows are
+  // selected.
+  template <typename TKey>
+  static bool findConstantKey(
+      const SelectivityVector& rows,
+      const vector_size_t* mapIndices,
+      const vector_size_t* rawOffsets,
+      const vector_size_t* rawSizes,
+      const TKey* rawKeys,
+      TKey searchKey,
+      vector_size_t* rawIndices,
+      NullsBuilder& nullsBuilder) {
+    vector_size_t begin = std::numeric_limits<vector_size_t>::max();
+    vector_size_t end = 0;
+    int64_t numKeys = 0;
+    rows.applyToSelected([&](vector_size_t row) {
+      const auto size = rawSizes[mapIndices[row]];
+      if (size > 0) {
+        const auto offset = rawOffsets[mapIndices[row]];
+        begin = std::min(begin, offset);
+        end = std::max(end, offset + size);
+        numKeys += size;
+      }
+    });
+    if (begin < end && numKeys * 2 < end - begin) {
+      return false;
+    }
+    std::vector<uint64_t> matches;
+    if (begin < end) {
+      matches.resize(bits::nwords(end - begin));
+      simd::setEqualBits(
+          rawKeys + begin, end - begin, searchKey, matches.data());
+    }
+    rows.applyToSelected([&](vector_size_t row) {
+      const auto size = rawSizes[mapIndices[row]];
+      const auto offset = rawOffsets[mapIndices[row]] - begin;
+      const auto match = size == 0
+          ? -1
+          : bits::findFirstBit(matches.data(), offset, offset + size);
+      if (match >= 0) {
+        rawIndices[row] = begin + match;
+      } else {
+        nullsBuilder.setNull(row);
+      }
+    });
+    return true;
+  }
+
   VectorPtr applyMapComplexType(
       const SelectivityVector& rows,
       const VectorPtr& mapArg,
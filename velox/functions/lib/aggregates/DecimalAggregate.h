@@ -150,10 +150,14 @@ class DecimalAggregate : public exec::Aggregate {
     } else if (!exec::Aggregate::numNulls_ && decodedRaw_.isIdentityMapping()) {
       const TInputType* data = decodedRaw_.data<TInputType>();
       LongDecimalWithOverflowState accumulator;
-      rows.applyToSelected([&](vector_size_t i) {
-        accumulator.overflow += DecimalUtil::addWithOverflow(
-            accumulator.sum, data[i], accumulator.sum);
-      });
+      if constexpr (std::is_same_v<TInputType, int64_t>) {
+        accumulator.sum = sumShortDecimals(data, rows);
+      } else {
+        rows.applyToSelected([&](vector_size_t i) {
+          accumulator.overflow += DecimalUtil::addWithOverflow(
+              accumulator.sum, data[i], accumulator.sum);
+        });
+      }
       accumulator.count = rows.countSelected();
       char rawData[LongDecimalWithOverflowState::serializedSize()];
       StringView serialized(
@@ -330,6 +334,23 @@ class DecimalAggregate : public exec::Aggregate {
   }
 
  private:
+  // Returns the sum of the selected short decimals in 'data'. The high and the
+  // low 32 bits of the values are summed separately in 64 bits, which cannot
+  // overflow for a vector of up to 2^31 rows and needs no check per row, so
+  // that the loop is vectorized. The 128-bit sum is formed once at the end.
+  static int128_t sumShortDecimals(
+      const int64_t* data,
+      const SelectivityVector& rows) {
+    int64_t highSum = 0;
+    uint64_t lowSum = 0;
+    rows.applyToSelected([&](vector_size_t i) {
+      highSum += data[i] >> 32;
+      lowSum += static_cast<uint32_t>(data[i]);
+    });
+    return static_cast<int128_t>(highSum) * (int128_t(1) << 32) +
+        static_cast<int128_t>(lowSum);
+  }
+
   inline LongDecimalWithOverflowState* decimalAccumulator(char* group) {
     return exec::Aggregate::value<LongDecimalWithOverflowState>(group);
   }
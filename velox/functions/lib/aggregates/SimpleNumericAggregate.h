@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include "velox/common/base/RawVector.h"
 #include "velox/exec/Aggregate.h"
 #include "velox/exec/AggregationHook.h"
 #include "velox/vector/DecodedVector.h"
@@ -141,6 +142,89 @@ class SimpleNumericAggregate : public exec::Aggregate {
     }
   }
 
+  // Same as updateGroups() but 'groupIds' gives a dense id in [0,
+  // 'numGroupIds') for the group of each row. Values are first reduced into a
+  // per-batch array indexed by group id using 'updateSingleValue', then each
+  // distinct group is updated once. 'updateSingleValue' must be associative.
+  template <
+      bool tableHasNulls,
+      typename TData = TResult,
+      typename TValue = TInput,
+      typename UpdateSingleValue>
+  void updateDenseGroups(
+      char** groups,
+      const uint64_t* groupIds,
+      int32_t numGroupIds,
+      const SelectivityVector& rows,
+      const VectorPtr& arg,
+      UpdateSingleValue updateSingleValue) {
+    DecodedVector decoded(*arg, rows);
+    if (decoded.isConstantMapping()) {
+      updateGroups<tableHasNulls, TData, TValue>(
+          groups, rows, arg, updateSingleValue, false);
+      return;
+    }
+
+    accumulateDense<tableHasNulls, TData>(
+        groups, numGroupIds, updateSingleValue, [&](auto addValue) {
+          if (decoded.mayHaveNulls()) {
+            rows.applyToSelected([&](vector_size_t i) {
+              if (!decoded.isNullAt(i)) {
+                addValue(i, groupIds[i], TData(decoded.valueAt<TValue>(i)));
+              }
+            });
+          } else if (
+              decoded.isIdentityMapping() && !std::is_same_v<TValue, bool>) {
+            auto data = decoded.data<TValue>();
+            rows.applyToSelected([&](vector_size_t i) {
+              addValue(i, groupIds[i], TData(data[i]));
+            });
+          } else {
+            rows.applyToSelected([&](vector_size_t i) {
+              addValue(i, groupIds[i], TData(decoded.valueAt<TValue>(i)));
+            });
+          }
+        });
+  }
+
+  // Reduces the values produced by 'forEachValue' into 'denseValues_' and
+  // applies the result to each touched group. 'forEachValue' is called with a
+  // function that takes the row number, its dense group id and the value.
+  template <
+      bool tableHasNulls,
+      typename TData,
+      typename UpdateSingleValue,
+      typename ForEachValue>
+  void accumulateDense(
+      char** groups,
+      int32_t numGroupIds,
+      UpdateSingleValue updateSingleValue,
+      ForEachValue forEachValue) {
+    if (denseGroups_.size() < static_cast<size_t>(numGroupIds)) {
+      denseGroups_.resize(numGroupIds, nullptr);
+    }
+    denseValues_.resize(numGroupIds * sizeof(TData));
+    auto* values = reinterpret_cast<TData*>(denseValues_.data());
+    denseIds_.clear();
+
+    forEachValue([&](vector_size_t row, uint64_t id, TData value) {
+      VELOX_DCHECK_LT(id, numGroupIds);
+      if (denseGroups_[id] == nullptr) {
+        denseGroups_[id] = groups[row];
+        values[id] = value;
+        denseIds_.push_back(id);
+      } else {
+        updateSingleValue(values[id], value);
+      }
+    });
+
+    for (auto id : denseIds_) {
+      updateNonNullValue<tableHasNulls, TData>(
+          denseGroups_[id], values[id], updateSingleValue);
+      denseGroups_[id] = nullptr;
+    }
+  }
+
   // TData is used to store the updated group state. It can be either
   // TAccumulator or TResult, which in most cases are the same, but for
   // sum(real) can differ. TValue is used to decode the update input 'args'.
@@ -239,6 +323,12 @@ class SimpleNumericAggregate : public exec::Aggregate {
     }
     updateValue(*exec::Aggregate::value<TDataType>(group), value);
   }
+
+  // Scratch state for accumulateDense(). 'denseGroups_' is all nullptr
+  // between calls.
+  std::vector<char*> denseGroups_;
+  raw_vector<char> denseValues_;
+  std::vector<uint64_t> denseIds_;
 };
 
 } // namespace facebook::velox::functions::aggregate
@@ -18,6 +18,7 @@
 #include <cstring>
 #include <string>
 #include <string_view>
+#include <xsimd/xsimd.hpp>
 #include "folly/CPortability.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/external/utf8proc/utf8procImpl.h"
@@ -48,7 +49,21 @@ namespace stringCore {
 static bool isAscii(const char* str, size_t length);
 
 FOLLY_ALWAYS_INLINE bool isAscii(const char* str, size_t length) {
-  for (auto i = 0; i < length; i++) {
+  using Batch = xsimd::batch<uint8_t>;
+  const auto* bytes = reinterpret_cast<const uint8_t*>(str);
+  size_t i = 0;
+  if (length >= Batch::size) {
+    // OR the bytes together a register at a time and test the high bits once.
+    auto highBits = Batch::broadcast(0);
+    for (; i + Batch::size <= length; i += Batch::size) {
+      highBits = highBits | Batch::load_unaligned(bytes + i);
+    }
+    const auto highBitMask = Batch::broadcast(0x80);
+    if (xsimd::any((highBits & highBitMask) != Batch::broadcast(0))) {
+      return false;
+    }
+  }
+  for (; i < length; i++) {
     if (str[i] & 0x80) {
       return false;
     }
@@ -144,6 +144,23 @@ TEST_F(StringImplTest, concatLazy) {
   ASSERT_EQ(StringView("aaBB"), output);
 }
 
+TEST_F(StringImplTest, isAscii) {
+  ASSERT_TRUE(isAscii("", 0));
+  // Cover lengths below, at and above multiples of the SIMD width, with a
+  // non-ASCII byte at each position.
+  for (auto length = 1; length < 100; ++length) {
+    std::string ascii(length, 'a');
+    ASSERT_TRUE(isAscii(ascii.data(), ascii.size())) << length;
+    for (auto i = 0; i < length; ++i) {
+      auto nonAscii = ascii;
+      nonAscii[i] = '\xC3';
+      ASSERT_FALSE(isAscii(nonAscii.data(), nonAscii.size()))
+          << length << " " << i;
+    }
+  }
+  ASSERT_FALSE(isAscii("\u4FE1\u5FF5 abc", 9));
+}
+
 TEST_F(StringImplTest, length) {
   auto lengthUtf8Ref = [](const char* inputBuffer, size_t bufferLength) {
     size_t size = 0;
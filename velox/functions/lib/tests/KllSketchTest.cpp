@@ -122,6 +122,37 @@ TEST(KllSketchTest, randomInput) {
   }
 }
 
+TEST(KllSketchTest, insertRange) {
+  constexpr int N = 1e5;
+  std::vector<double> values(N);
+  KllSketch<double> expected(kDefaultK, {}, 0);
+  insertRandomData(0, N, expected, values.data());
+
+  // Insert in batches of varying sizes, including empty ones. With the same
+  // seed the result must be identical to inserting one value at a time.
+  KllSketch<double> kll(kDefaultK, {}, 0);
+  int offset = 0;
+  for (int size = 0; offset < N; size = (size * 7 + 3) % 1000) {
+    auto count = std::min(size, N - offset);
+    kll.insert(folly::Range<const double*>(values.data() + offset, count));
+    offset += count;
+  }
+  EXPECT_EQ(kll.totalCount(), N);
+
+  auto expectedView = expected.toView();
+  auto view = kll.toView();
+  EXPECT_EQ(view.minValue, expectedView.minValue);
+  EXPECT_EQ(view.maxValue, expectedView.maxValue);
+  ASSERT_EQ(view.levels.size(), expectedView.levels.size());
+  for (int i = 0; i < view.levels.size(); ++i) {
+    EXPECT_EQ(view.levels[i], expectedView.levels[i]);
+  }
+  ASSERT_EQ(view.items.size(), expectedView.items.size());
+  for (int i = 0; i < view.items.size(); ++i) {
+    EXPECT_EQ(view.items[i], expectedView.items[i]);
+  }
+}
+
 TEST(KllSketchTest, merge) {
   constexpr int N = 1e4;
   constexpr int M = 1001;
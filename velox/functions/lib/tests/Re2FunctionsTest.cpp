@@ -52,6 +52,8 @@ class Re2FunctionsTest : public test::FunctionBaseTest {
         "re2_match", re2MatchSignatures(), makeRe2Match);
     exec::registerStatefulVectorFunction(
         "re2_search", re2SearchSignatures(), makeRe2Search);
+    exec::registerStatefulVectorFunction(
+        "re2_search_any", re2SearchAnySignatures(), makeRe2SearchAny);
     exec::registerStatefulVectorFunction(
         "re2_extract", re2ExtractSignatures(), makeRegexExtract);
     exec::registerStatefulVectorFunction(
@@ -335,6 +337,57 @@ TEST_F(Re2FunctionsTest, regexSearchBatch) {
   re2Search.testBatchAll();
 }
 
+TEST_F(Re2FunctionsTest, regexSearchAny) {
+  auto data = makeRowVector({
+      makeNullableFlatVector<std::string>(
+          {"abc", "xyz", "123", std::nullopt, "a1c"}),
+      makeFlatVector<int64_t>({0, 0, 20, 0, 0}),
+  });
+
+  auto result = evaluate("re2_search_any(c0, 'a.c', '^x')", data);
+  assertEqualVectors(
+      makeNullableFlatVector<bool>({true, true, false, std::nullopt, true}),
+      result);
+
+  VELOX_ASSERT_THROW(
+      evaluate("re2_search_any(c0, 'a.c', '*')", data),
+      "invalid regular expression");
+
+  auto rowType = asRowType(data->type());
+  auto rewrite = [&](const std::string& text) {
+    return rewriteRe2SearchDisjunction(
+        "regexp_like", "regexp_like_any", makeTypedExpr(text, rowType));
+  };
+
+  auto rewritten =
+      rewrite("regexp_like(c0, 'a.c') or c1 > 10 or regexp_like(c0, '^x')");
+  ASSERT_NE(rewritten, nullptr);
+  auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(rewritten);
+  ASSERT_NE(call, nullptr);
+  ASSERT_EQ(call->name(), "or");
+  ASSERT_EQ(call->inputs().size(), 2);
+  auto searchAny =
+      std::dynamic_pointer_cast<const core::CallTypedExpr>(call->inputs()[0]);
+  ASSERT_NE(searchAny, nullptr);
+  EXPECT_EQ(searchAny->name(), "regexp_like_any");
+  EXPECT_EQ(searchAny->inputs().size(), 3);
+
+  // A single search, searches over different inputs and invalid patterns are
+  // not rewritten.
+  EXPECT_EQ(rewrite("regexp_like(c0, 'a.c') or c1 > 10"), nullptr);
+  EXPECT_EQ(
+      rewrite("regexp_like(c0, 'a.c') or regexp_like(upper(c0), '^x')"),
+      nullptr);
+  EXPECT_EQ(rewrite("regexp_like(c0, 'a.c') or regexp_like(c0, '*')"), nullptr);
+
+  // The rewrite is registered with Presto functions and preserves results.
+  result = evaluate(
+      "regexp_like(c0, 'a.c') or c1 > 10 or regexp_like(c0, '^x')", data);
+  assertEqualVectors(
+      makeNullableFlatVector<bool>({true, true, true, std::nullopt, true}),
+      result);
+}
+
 template <typename F>
 void testRe2Extract(F&& regexExtract) {
   // Regex with no subgroup matches.
@@ -624,6 +677,36 @@ TEST_F(Re2FunctionsTest, likePatternSuffix) {
   testLike(input, generateString(kAnyWildcardCharacter) + input, true);
 }
 
+TEST_F(Re2FunctionsTest, likePatternSubstrings) {
+  testLike("abcde", "%bc%", true);
+  testLike("abcde", "%bd%", false);
+  testLike("abcde", "%b%d%", true);
+  testLike("abcde", "%d%b%", false);
+  testLike("abcde", "a%c%e", true);
+  testLike("abcde", "a%e", true);
+  testLike("abcde", "a%d", false);
+  testLike("abcde", "b%e", false);
+  testLike("abab", "ab%ab", true);
+  testLike("aba", "ab%ba", false);
+  testLike("abcabc", "abc%%abc%", true);
+  testLike("abc", "%abc%abc%", false);
+  testLike("\nabc\nde\n", "%c\n%\n", true);
+
+  // Substrings longer than a SIMD register and hits past the first one.
+  std::string input = generateString(kLikePatternCharacterSet, 66);
+  testLike(
+      input + input,
+      "%" + input.substr(10, 40) + "%" + input.substr(1, 60) + "%",
+      true);
+  testLike(
+      input,
+      "%" + input.substr(10, 40) + "%" + input.substr(1, 60) + "%",
+      false);
+  testLike(
+      std::string(100, 'a') + "ab" + std::string(100, 'a'), "%ab%", true);
+  testLike(std::string(200, 'a'), "%ab%", false);
+}
+
 TEST_F(Re2FunctionsTest, nullConstantPatternOrEscape) {
   // Test null pattern.
   ASSERT_TRUE(
@@ -25,6 +25,8 @@
 #include <limits>
 #include <system_error>
 
+#include <xsimd/xsimd.hpp>
+
 #include "folly/CPortability.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/functions/Macros.h"
@@ -42,6 +44,22 @@ inline constexpr char digits[36] = {
 
 namespace {
 
+// Computes 'size' results of the binary operator 'op' over 'a' and 'b' with
+// xsimd batches. 'op' is called with both batches and scalars.
+template <typename T, typename Op>
+FOLLY_ALWAYS_INLINE void
+binaryBatch(T* result, const T* a, const T* b, int32_t size, Op op) {
+  using Batch = xsimd::batch<T>;
+  int32_t i = 0;
+  for (; i + static_cast<int32_t>(Batch::size) <= size; i += Batch::size) {
+    op(Batch::load_unaligned(a + i), Batch::load_unaligned(b + i))
+        .store_unaligned(result + i);
+  }
+  for (; i < size; ++i) {
+    result[i] = op(a[i], b[i]);
+  }
+}
+
 template <typename T>
 struct PlusFunction {
   template <typename TInput>
@@ -49,6 +67,14 @@ struct PlusFunction {
   call(TInput& result, const TInput& a, const TInput& b) {
     result = plus(a, b);
   }
+
+  template <
+      typename TInput,
+      typename = std::enable_if_t<std::is_floating_point_v<TInput>>>
+  FOLLY_ALWAYS_INLINE void
+  callBatch(TInput* result, const TInput* a, const TInput* b, int32_t size) {
+    binaryBatch(result, a, b, size, [](auto x, auto y) { return x + y; });
+  }
 };
 
 template <typename T>
@@ -58,6 +84,14 @@ struct MinusFunction {
   call(TInput& result, const TInput& a, const TInput& b) {
     result = minus(a, b);
   }
+
+  template <
+      typename TInput,
+      typename = std::enable_if_t<std::is_floating_point_v<TInput>>>
+  FOLLY_ALWAYS_INLINE void
+  callBatch(TInput* result, const TInput* a, const TInput* b, int32_t size) {
+    binaryBatch(result, a, b, size, [](auto x, auto y) { return x - y; });
+  }
 };
 
 template <typename T>
@@ -67,6 +101,14 @@ struct MultiplyFunction {
   call(TInput& result, const TInput& a, const TInput& b) {
     result = multiply(a, b);
   }
+
+  template <
+      typename TInput,
+      typename = std::enable_if_t<std::is_floating_point_v<TInput>>>
+  FOLLY_ALWAYS_INLINE void
+  callBatch(TInput* result, const TInput* a, const TInput* b, int32_t size) {
+    binaryBatch(result, a, b, size, [](auto x, auto y) { return x * y; });
+  }
 };
 
 template <typename T>
@@ -83,6 +125,20 @@ struct DivideFunction {
   {
     result = a / b;
   }
+
+  template <
+      typename TInput,
+      typename = std::enable_if_t<std::is_floating_point_v<TInput>>>
+  FOLLY_ALWAYS_INLINE void
+  callBatch(TInput* result, const TInput* a, const TInput* b, int32_t size) {
+    binaryBatch(result, a, b, size, [](auto x, auto y) {
+      if constexpr (std::is_floating_point_v<decltype(x)>) {
+        return divide(x, y);
+      } else {
+        return x / y;
+      }
+    });
+  }
 };
 
 template <typename T>
@@ -77,7 +77,8 @@ class ArrayConstructor : public exec::VectorFunction {
         }
       } else {
         SelectivityVector targetRows(elementsResult->size(), false);
-        std::vector<vector_size_t> toSourceRow(elementsResult->size());
+        auto* toSourceRow =
+            context.allocateScratch<vector_size_t>(elementsResult->size());
 
         vector_size_t offset = baseOffset;
         rows.applyToSelected([&](vector_size_t row) {
@@ -90,7 +91,7 @@ class ArrayConstructor : public exec::VectorFunction {
           offset += numArgs;
         });
         targetRows.updateBounds();
-        elementsResult->copy(args[0].get(), targetRows, toSourceRow.data());
+        elementsResult->copy(args[0].get(), targetRows, toSourceRow);
 
         for (int i = 1; i < numArgs; i++) {
           targetRows.clearAll();
@@ -103,7 +104,7 @@ class ArrayConstructor : public exec::VectorFunction {
           });
 
           targetRows.updateBounds();
-          elementsResult->copy(args[i].get(), targetRows, toSourceRow.data());
+          elementsResult->copy(args[i].get(), targetRows, toSourceRow);
         }
       }
     }
@@ -13,12 +13,108 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <folly/container/F14Set.h>
+
+#include "velox/common/base/SimdUtil.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/vector/DecodedVector.h"
 
 namespace facebook::velox::functions {
 namespace {
 
+// Types compared a SIMD batch at a time.
+template <typename T>
+constexpr bool kSimdComparable =
+    (std::is_integral_v<T> && sizeof(T) <= 8 && !std::is_same_v<T, bool>) ||
+    std::is_floating_point_v<T>;
+
+// Types looked up in a hash set built from a constant array.
+template <typename T>
+constexpr bool kHashable =
+    (std::is_arithmetic_v<T> && !std::is_same_v<T, int128_t>) ||
+    std::is_same_v<T, StringView>;
+
+// A constant array with fewer elements is searched without building a set.
+constexpr vector_size_t kMinConstantSetSize = 8;
+
+// Sets 'flatResult' for 'rows' by comparing all the elements of the arrays to
+// a constant 'search' in one pass over the elements and then checking for a
+// match bit in the range of each array. Returns false without setting
+// 'flatResult' if the arrays do not cover most of their range of elements,
+// e.g. when few rows are selected.
+template <typename T>
+bool applyFlatElements(
+    const SelectivityVector& rows,
+    const vector_size_t* rawOffsets,
+    const vector_size_t* rawSizes,
+    const vector_size_t* indices,
+    const T* rawElements,
+    T search,
+    FlatVector<bool>& flatResult) {
+  vector_size_t begin = std::numeric_limits<vector_size_t>::max();
+  vector_size_t end = 0;
+  int64_t numElements = 0;
+  rows.applyToSelected([&](auto row) {
+    const auto size = rawSizes[indices[row]];
+    if (size > 0) {
+      const auto offset = rawOffsets[indices[row]];
+      begin = std::min(begin, offset);
+      end = std::max(end, offset + size);
+      numElements += size;
+    }
+  });
+  if (begin >= end) {
+    rows.applyToSelected([&](auto row) { flatResult.set(row, false); });
+    return true;
+  }
+  if (numElements * 2 < end - begin) {
+    return false;
+  }
+  std::vector<uint64_t> matches(bits::nwords(end - begin));
+  simd::setEqualBits(
+      rawElements + begin, end - begin, search, matches.data());
+  rows.applyToSelected([&](auto row) {
+    const auto offset = rawOffsets[indices[row]] - begin;
+    const auto size = rawSizes[indices[row]];
+    flatResult.set(
+        row,
+        size > 0 &&
+            bits::findFirstBit(matches.data(), offset, offset + size) >= 0);
+  });
+  return true;
+}
+
+// Sets 'flatResult' for 'rows' by looking up each search value in a hash set
+// of the elements of a single constant array.
+template <typename T>
+void applyConstantArray(
+    const SelectivityVector& rows,
+    vector_size_t offset,
+    vector_size_t size,
+    DecodedVector& elementsDecoded,
+    DecodedVector& searchDecoded,
+    FlatVector<bool>& flatResult) {
+  folly::F14FastSet<T> elements;
+  elements.reserve(size);
+  bool hasNull = false;
+  for (auto i = offset; i < offset + size; ++i) {
+    if (elementsDecoded.isNullAt(i)) {
+      hasNull = true;
+    } else {
+      elements.insert(elementsDecoded.valueAt<T>(i));
+    }
+  }
+  rows.applyToSelected([&](auto row) {
+    if (elements.contains(searchDecoded.valueAt<T>(row))) {
+      flatResult.set(row, true);
+    } else if (hasNull) {
+      flatResult.setNull(row, true);
+    } else {
+      flatResult.set(row, false);
+    }
+  });
+}
+
 template <TypeKind kind>
 void applyTyped(
     const SelectivityVector& rows,
@@ -40,6 +136,19 @@ void applyTyped(
     auto rawElements = elementsDecoded.data<T>();
     auto search = searchDecoded.valueAt<T>(0);
 
+    if constexpr (kSimdComparable<T>) {
+      if (applyFlatElements(
+              rows,
+              rawOffsets,
+              rawSizes,
+              indices,
+              rawElements,
+              search,
+              flatResult)) {
+        return;
+      }
+    }
+
     rows.applyToSelected([&](auto row) {
       auto size = rawSizes[indices[row]];
       auto offset = rawOffsets[indices[row]];
@@ -54,6 +163,21 @@ void applyTyped(
       flatResult.set(row, false);
     });
   } else {
+    if constexpr (kHashable<T> && !isBoolType) {
+      if (arrayDecoded.isConstantMapping() &&
+          !searchDecoded.isConstantMapping() && rows.countSelected() > 1 &&
+          rawSizes[indices[rows.begin()]] >= kMinConstantSetSize) {
+        applyConstantArray<T>(
+            rows,
+            rawOffsets[indices[rows.begin()]],
+            rawSizes[indices[rows.begin()]],
+            elementsDecoded,
+            searchDecoded,
+            flatResult);
+        return;
+      }
+    }
+
     rows.applyToSelected([&](auto row) {
       auto size = rawSizes[indices[row]];
       auto offset = rawOffsets[indices[row]];
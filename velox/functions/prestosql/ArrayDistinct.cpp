@@ -43,6 +43,11 @@ namespace {
 template <typename T>
 class ArrayDistinctFunction : public exec::VectorFunction {
  public:
+  // Arrays of up to this many elements are deduplicated without the hash set.
+  // Not used for floating point types, where == and the hash set may disagree
+  // on -0.0 and NaN.
+  static constexpr vector_size_t kMaxLinearSize = 8;
+
   void apply(
       const SelectivityVector& rows,
       std::vector<VectorPtr>& args,
@@ -104,6 +109,36 @@ class ArrayDistinctFunction : public exec::VectorFunction {
       auto offset = arrayVector->offsetAt(row);
 
       rawOffsets[row] = indicesCursor;
+      if (!std::is_floating_point_v<T> && size <= kMaxLinearSize) {
+        // Compares each element to the distinct elements before it. Cheaper
+        // than inserting into and clearing the set for short arrays.
+        bool hasNulls = false;
+        for (vector_size_t i = offset; i < offset + size; ++i) {
+          if (elements->isNullAt(i)) {
+            if (!hasNulls) {
+              hasNulls = true;
+              rawNewIndices[indicesCursor++] = i;
+            }
+            continue;
+          }
+          auto value = elements->valueAt<T>(i);
+          bool found = false;
+          for (auto j = rawOffsets[row]; j < indicesCursor; ++j) {
+            const auto index = rawNewIndices[j];
+            if (!elements->isNullAt(index) &&
+                elements->valueAt<T>(index) == value) {
+              found = true;
+              break;
+            }
+          }
+          if (!found) {
+            rawNewIndices[indicesCursor++] = i;
+          }
+        }
+        rawSizes[row] = indicesCursor - rawOffsets[row];
+        return;
+      }
+
       bool hasNulls = false;
       for (vector_size_t i = offset; i < offset + size; ++i) {
         if (elements->isNullAt(i)) {
@@ -106,6 +106,70 @@ class DecimalBaseFunction : public exec::VectorFunction {
   const uint8_t bRescale_;
 };
 
+// Arithmetic on short decimals whose result precision is at most 18, e.g.
+// DECIMAL(12, 2) + DECIMAL(15, 2). The precisions of the arguments then bound
+// the rescaled arguments and the result below 10^18, so the result cannot
+// overflow and is computed in 64 bits without checks. The loops over flat
+// arguments have no branches and are vectorized by the compiler.
+template <typename Operation /* Arithmetic operation */>
+class DecimalShortFunction : public exec::VectorFunction {
+ public:
+  DecimalShortFunction(uint8_t aRescale, uint8_t bRescale)
+      : aMultiplier_(DecimalUtil::kPowersOfTen[aRescale]),
+        bMultiplier_(DecimalUtil::kPowersOfTen[bRescale]) {}
+
+  void apply(
+      const SelectivityVector& rows,
+      std::vector<VectorPtr>& args,
+      const TypePtr& resultType,
+      exec::EvalCtx& context,
+      VectorPtr& result) const override {
+    context.ensureWritable(rows, resultType, result);
+    result->clearNulls(rows);
+    auto rawResults =
+        result->asUnchecked<FlatVector<int64_t>>()->mutableRawValues();
+    const auto aMultiplier = aMultiplier_;
+    const auto bMultiplier = bMultiplier_;
+    if (args[0]->isConstantEncoding() && args[1]->isFlatEncoding()) {
+      const auto a =
+          args[0]->asUnchecked<SimpleVector<int64_t>>()->valueAt(0) *
+          aMultiplier;
+      auto rawB = args[1]->asUnchecked<FlatVector<int64_t>>()->rawValues();
+      rows.applyToSelected([&](auto row) {
+        rawResults[row] = Operation::applyShort(a, rawB[row] * bMultiplier);
+      });
+    } else if (args[0]->isFlatEncoding() && args[1]->isConstantEncoding()) {
+      auto rawA = args[0]->asUnchecked<FlatVector<int64_t>>()->rawValues();
+      const auto b =
+          args[1]->asUnchecked<SimpleVector<int64_t>>()->valueAt(0) *
+          bMultiplier;
+      rows.applyToSelected([&](auto row) {
+        rawResults[row] = Operation::applyShort(rawA[row] * aMultiplier, b);
+      });
+    } else if (args[0]->isFlatEncoding() && args[1]->isFlatEncoding()) {
+      auto rawA = args[0]->asUnchecked<FlatVector<int64_t>>()->rawValues();
+      auto rawB = args[1]->asUnchecked<FlatVector<int64_t>>()->rawValues();
+      rows.applyToSelected([&](auto row) {
+        rawResults[row] = Operation::applyShort(
+            rawA[row] * aMultiplier, rawB[row] * bMultiplier);
+      });
+    } else {
+      exec::DecodedArgs decodedArgs(rows, args, context);
+      auto a = decodedArgs.at(0);
+      auto b = decodedArgs.at(1);
+      rows.applyToSelected([&](auto row) {
+        rawResults[row] = Operation::applyShort(
+            a->valueAt<int64_t>(row) * aMultiplier,
+            b->valueAt<int64_t>(row) * bMultiplier);
+      });
+    }
+  }
+
+ private:
+  const int64_t aMultiplier_;
+  const int64_t bMultiplier_;
+};
+
 template <
     typename R /* Result Type */,
     typename A /* Argument */,
@@ -292,6 +356,11 @@ class Addition {
     DecimalUtil::valueInRange(r);
   }
 
+  // Adds rescaled short decimals that are known not to overflow.
+  inline static int64_t applyShort(int64_t a, int64_t b) {
+    return a + b;
+  }
+
   inline static uint8_t
   computeRescaleFactor(uint8_t fromScale, uint8_t toScale, uint8_t rScale = 0) {
     return std::max(0, toScale - fromScale);
@@ -334,6 +403,10 @@ class Subtraction {
     DecimalUtil::valueInRange(r);
   }
 
+  inline static int64_t applyShort(int64_t a, int64_t b) {
+    return a - b;
+  }
+
   inline static uint8_t
   computeRescaleFactor(uint8_t fromScale, uint8_t toScale, uint8_t rScale = 0) {
     return std::max(0, toScale - fromScale);
@@ -360,6 +433,10 @@ class Multiply {
     DecimalUtil::valueInRange(r);
   }
 
+  inline static int64_t applyShort(int64_t a, int64_t b) {
+    return a * b;
+  }
+
   inline static uint8_t
   computeRescaleFactor(uint8_t fromScale, uint8_t toScale, uint8_t rScale = 0) {
     return 0;
@@ -637,6 +714,16 @@ std::shared_ptr<exec::VectorFunction> createDecimalUnary(
   VELOX_UNSUPPORTED();
 }
 
+// True if 'Operation' can be computed by DecimalShortFunction. Division is
+// not, as it checks for division by zero.
+template <typename Operation, typename = void>
+constexpr bool kHasShortPath = false;
+
+template <typename Operation>
+constexpr bool kHasShortPath<
+    Operation,
+    std::void_t<decltype(Operation::applyShort(int64_t(), int64_t()))>> = true;
+
 template <typename Operation>
 std::shared_ptr<exec::VectorFunction> createDecimalFunction(
     const std::string& name,
@@ -652,6 +739,12 @@ std::shared_ptr<exec::VectorFunction> createDecimalFunction(
   uint8_t bRescale = Operation::computeRescaleFactor(bScale, aScale, rScale);
   if (aType->isShortDecimal()) {
     if (bType->isShortDecimal()) {
+      if constexpr (kHasShortPath<Operation>) {
+        if (rPrecision <= ShortDecimalType::kMaxPrecision) {
+          return std::make_shared<DecimalShortFunction<Operation>>(
+              aRescale, bRescale);
+        }
+      }
       if (rPrecision > ShortDecimalType::kMaxPrecision) {
         // Arguments are short decimals and result is a long decimal.
         return std::make_shared<DecimalBaseFunction<
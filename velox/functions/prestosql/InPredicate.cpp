@@ -544,7 +544,9 @@ class InPredicate : public exec::VectorFunction {
           }
         }
       });
-    } else {
+    } else if (
+        !rows.isAllSelected() ||
+        !testBatch(flatArg, rows.end(), rawResults)) {
       rows.applyToSelected([&](auto row) {
         bool pass = testFunction(flatArg->valueAtFast(row));
         bits::setBit(rawResults, row, pass);
@@ -552,6 +554,39 @@ class InPredicate : public exec::VectorFunction {
     }
   }
 
+  // Sets the bits in 'rawResults' for the first 'size' rows of 'flatArg' using
+  // the batch methods of the filter. Returns false if there are none for 'T'.
+  template <typename T>
+  bool testBatch(
+      const FlatVector<T>* flatArg,
+      vector_size_t size,
+      uint64_t* rawResults) const {
+    const auto* values = flatArg->rawValues();
+    if constexpr (std::is_same_v<T, StringView>) {
+      bits::fillBits(rawResults, 0, size, true);
+      filter_->testStringViews(values, size, rawResults);
+      return true;
+    } else if constexpr (
+        std::is_same_v<T, int64_t> || std::is_same_v<T, int32_t> ||
+        std::is_same_v<T, int16_t>) {
+      constexpr int32_t kBatchSize = xsimd::batch<T>::size;
+      vector_size_t row = 0;
+      for (; row + kBatchSize <= size; row += kBatchSize) {
+        const auto passed = simd::toBitMask(
+            filter_->testValues(xsimd::batch<T>::load_unaligned(values + row)));
+        for (auto i = 0; i < kBatchSize; ++i) {
+          bits::setBit(rawResults, row + i, passed & (1UL << i));
+        }
+      }
+      for (; row < size; ++row) {
+        bits::setBit(rawResults, row, filter_->testInt64(values[row]));
+      }
+      return true;
+    } else {
+      return false;
+    }
+  }
+
   const std::unique_ptr<common::Filter> filter_;
   const bool alwaysNull_;
 };
@@ -13,7 +13,9 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/functions/prestosql/JsonFunctions.h"
 #include "velox/expression/VectorFunction.h"
+#include "velox/functions/prestosql/json/JsonPathTokenizer.h"
 #include "velox/functions/prestosql/types/JsonType.h"
 
 namespace facebook::velox::functions {
@@ -116,8 +118,81 @@ class JsonParseFunction : public exec::VectorFunction {
   }
 };
 
+// Returns the value of 'expr' if it is a non-null VARCHAR constant.
+std::optional<std::string> asConstantPath(const core::TypedExprPtr& expr) {
+  auto constant =
+      std::dynamic_pointer_cast<const core::ConstantTypedExpr>(expr);
+  if (constant == nullptr || !constant->type()->isVarchar()) {
+    return std::nullopt;
+  }
+  if (constant->hasValueVector()) {
+    const auto& valueVector = constant->valueVector();
+    if (valueVector->isNullAt(0)) {
+      return std::nullopt;
+    }
+    const auto path = valueVector->as<SimpleVector<StringView>>()->valueAt(0);
+    return folly::trimWhitespace(path).str();
+  }
+  if (constant->value().isNull()) {
+    return std::nullopt;
+  }
+  return folly::trimWhitespace(constant->value().value<TypeKind::VARCHAR>())
+      .str();
+}
+
+// Returns whether 'path' is a valid JSON path. If 'allowWildcard' is false,
+// also requires that 'path' has no wildcard.
+bool isValidPath(const std::string& path, bool allowWildcard) {
+  JsonPathTokenizer tokenizer;
+  if (!tokenizer.reset(path)) {
+    return false;
+  }
+  while (tokenizer.hasNext()) {
+    auto token = tokenizer.getNext();
+    if (!token || (!allowWildcard && token.value() == "*")) {
+      return false;
+    }
+  }
+  return true;
+}
+
 } // namespace
 
+core::TypedExprPtr rewriteJsonExtractCall(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr) {
+  const auto extractName = prefix + "json_extract";
+  const auto extractScalarName = prefix + "json_extract_scalar";
+
+  auto call = std::dynamic_pointer_cast<const core::CallTypedExpr>(expr);
+  core::TypedExprPtr rewritten;
+  while (call != nullptr && call->inputs().size() == 2 &&
+         (call->name() == extractName || call->name() == extractScalarName)) {
+    auto inner =
+        std::dynamic_pointer_cast<const core::CallTypedExpr>(call->inputs()[0]);
+    if (inner == nullptr || inner->name() != extractName ||
+        inner->inputs().size() != 2) {
+      break;
+    }
+    auto outerPath = asConstantPath(call->inputs()[1]);
+    auto innerPath = asConstantPath(inner->inputs()[1]);
+    // Invalid paths are left alone to report errors as before.
+    if (!outerPath.has_value() || !innerPath.has_value() ||
+        !isValidPath(*outerPath, true) || !isValidPath(*innerPath, false)) {
+      break;
+    }
+    call = std::make_shared<core::CallTypedExpr>(
+        call->type(),
+        std::vector<core::TypedExprPtr>{
+            inner->inputs()[0],
+            std::make_shared<core::ConstantTypedExpr>(
+                VARCHAR(), variant(*innerPath + outerPath->substr(1)))},
+        call->name());
+    rewritten = call;
+  }
+  return rewritten;
+}
+
 VELOX_DECLARE_VECTOR_FUNCTION(
     udf_json_format,
     JsonFormatFunction::signatures(),
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/core/Expressions.h"
 #include "velox/functions/Macros.h"
 #include "velox/functions/UDFOutputString.h"
 #include "velox/functions/prestosql/json/JsonExtractor.h"
@@ -163,4 +164,19 @@ struct JsonSizeFunction {
   }
 };
 
+/// Folds json_extract_scalar or json_extract over json_extract with constant
+/// paths into a single call, so the JSON is parsed once instead of once per
+/// nesting level.
+///
+/// For example, rewrites
+///     json_extract_scalar(json_extract(x, '$.a[0]'), '$.b')
+/// into
+///     json_extract_scalar(x, '$.a[0].b')
+///
+/// The inner path must not contain wildcards, so that it selects at most one
+/// value. Returns new expression or nullptr if rewrite is not possible.
+core::TypedExprPtr rewriteJsonExtractCall(
+    const std::string& prefix,
+    const core::TypedExprPtr& expr);
+
 } // namespace facebook::velox::functions
@@ -13,12 +13,126 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/expression/Expr.h"
+#include "velox/expression/FieldReference.h"
 #include "velox/expression/VectorFunction.h"
 #include "velox/functions/lib/LambdaFunctionUtil.h"
 
 namespace facebook::velox::functions {
 namespace {
 
+// Returns true if 'callable' is '(s, x) -> s + x' or '(s, x) -> x + s' with
+// Presto's plus over a numeric type and no captures.
+bool isPlusLambda(const exec::Callable& callable) {
+  const auto* signature = callable.signature();
+  const auto* body = callable.body();
+  if (signature == nullptr || body == nullptr || callable.hasCapture() ||
+      (*signature)->size() != 2 || body->isSpecialForm()) {
+    return false;
+  }
+  const auto& name = body->name();
+  if (name != "plus" && !folly::StringPiece(name).endsWith(".plus")) {
+    return false;
+  }
+  switch (body->type()->kind()) {
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::BIGINT:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+      break;
+    default:
+      return false;
+  }
+  if (body->inputs().size() != 2 || body->type()->isDecimal() ||
+      !(*signature)->childAt(0)->equivalent(*body->type()) ||
+      !(*signature)->childAt(1)->equivalent(*body->type())) {
+    return false;
+  }
+  std::vector<std::string> fields;
+  for (const auto& input : body->inputs()) {
+    auto* field = dynamic_cast<const exec::FieldReference*>(input.get());
+    if (field == nullptr || !field->inputs().empty()) {
+      return false;
+    }
+    fields.push_back(field->field());
+  }
+  const auto& state = (*signature)->nameOf(0);
+  const auto& element = (*signature)->nameOf(1);
+  return (fields[0] == state && fields[1] == element) ||
+      (fields[0] == element && fields[1] == state);
+}
+
+// Sets 'result' for 'rows' to the sum of 'initialState' and the elements of
+// the arrays, adding the elements in order like the lambda would. A null
+// element or initial state makes the result null. Returns false if an integer
+// sum overflows, leaving the error to be raised by evaluating the lambda.
+template <typename T>
+bool sumArraysTyped(
+    const SelectivityVector& rows,
+    const ArrayVector& arrays,
+    const DecodedVector& elements,
+    const DecodedVector& initialState,
+    BaseVector& result) {
+  auto& flatResult = *result.asFlatVector<T>();
+  auto* rawSizes = arrays.rawSizes();
+  auto* rawOffsets = arrays.rawOffsets();
+  return rows.testSelected([&](auto row) {
+    if (initialState.isNullAt(row)) {
+      flatResult.setNull(row, true);
+      return true;
+    }
+    T sum = initialState.valueAt<T>(row);
+    const auto end = rawOffsets[row] + rawSizes[row];
+    for (auto i = rawOffsets[row]; i < end; ++i) {
+      if (elements.isNullAt(i)) {
+        flatResult.setNull(row, true);
+        return true;
+      }
+      if constexpr (std::is_integral_v<T>) {
+        if (__builtin_add_overflow(sum, elements.valueAt<T>(i), &sum)) {
+          return false;
+        }
+      } else {
+        sum += elements.valueAt<T>(i);
+      }
+    }
+    flatResult.set(row, sum);
+    return true;
+  });
+}
+
+bool sumArrays(
+    const SelectivityVector& rows,
+    const ArrayVector& arrays,
+    const DecodedVector& elements,
+    const DecodedVector& initialState,
+    BaseVector& result) {
+  switch (result.typeKind()) {
+    case TypeKind::TINYINT:
+      return sumArraysTyped<int8_t>(
+          rows, arrays, elements, initialState, result);
+    case TypeKind::SMALLINT:
+      return sumArraysTyped<int16_t>(
+          rows, arrays, elements, initialState, result);
+    case TypeKind::INTEGER:
+      return sumArraysTyped<int32_t>(
+          rows, arrays, elements, initialState, result);
+    case TypeKind::BIGINT:
+      return sumArraysTyped<int64_t>(
+          rows, arrays, elements, initialState, result);
+    case TypeKind::REAL:
+      return sumArraysTyped<float>(
+          rows, arrays, elements, initialState, result);
+    case TypeKind::DOUBLE:
+      return sumArraysTyped<double>(
+          rows, arrays, elements, initialState, result);
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+
 /// Populates indices of the n-th elements of the arrays.
 /// Selects 'row' in 'arrayRows' if corresponding array has an n-th element.
 /// Sets elementIndices[row] to the index of the n-th element in the 'elements'
@@ -116,6 +230,25 @@ class ReduceFunction : public exec::VectorFunction {
     // At each step the number of arrays being processed will get smaller as
     // some arrays will run out of elements.
     while (auto entry = inputFuncIt.next()) {
+      if (isPlusLambda(*entry.callable)) {
+        // Sums the elements of each array without evaluating the lambda
+        // once per element position.
+        const auto& elements = flatArray->elements();
+        SelectivityVector elementRows(elements->size());
+        exec::LocalDecodedVector elementsDecoder(
+            context, *elements, elementRows);
+        exec::LocalDecodedVector stateDecoder(
+            context, *initialState, *entry.rows);
+        if (sumArrays(
+                *entry.rows,
+                *flatArray,
+                *elementsDecoder.get(),
+                *stateDecoder.get(),
+                *partialResult)) {
+          continue;
+        }
+      }
+
       VectorPtr state = initialState;
 
       vector_size_t n = 0;
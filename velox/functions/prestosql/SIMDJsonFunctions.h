@@ -163,6 +163,50 @@ struct SIMDJsonArrayLengthFunction {
   }
 };
 
+namespace detail {
+
+// Returns a consumer for simdJsonExtract() that sets 'resultStr' to the string
+// form of the extracted value if it is a single scalar and to std::nullopt
+// otherwise.
+inline auto makeScalarConsumer(
+    std::optional<std::string>& resultStr,
+    bool& resultPopulated) {
+  return [&resultStr, &resultPopulated](auto& v) {
+    if (resultPopulated) {
+      // We should just get a single value, if we see multiple, it's an error
+      // and we should return null.
+      resultStr = std::nullopt;
+      return true;
+    }
+
+    resultPopulated = true;
+
+    SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
+    switch (vtype) {
+      case simdjson::ondemand::json_type::boolean: {
+        SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
+        resultStr = vbool ? "true" : "false";
+        break;
+      }
+      case simdjson::ondemand::json_type::string: {
+        SIMDJSON_ASSIGN_OR_RAISE(resultStr, v.get_string());
+        break;
+      }
+      case simdjson::ondemand::json_type::object:
+      case simdjson::ondemand::json_type::array:
+      case simdjson::ondemand::json_type::null:
+        // Do nothing.
+        break;
+      default: {
+        SIMDJSON_ASSIGN_OR_RAISE(resultStr, simdjson::to_json_string(v));
+      }
+    }
+    return true;
+  };
+}
+
+} // namespace detail
+
 // jsonExtractScalar(json, json_path) -> varchar
 // Like jsonExtract(), but returns the result value as a string (as opposed
 // to being encoded as JSON). The value referenced by json_path must be a scalar
@@ -177,38 +221,7 @@ struct SIMDJsonExtractScalarFunction {
       const arg_type<Varchar>& jsonPath) {
     bool resultPopulated = false;
     std::optional<std::string> resultStr;
-    auto consumer = [&resultStr, &resultPopulated](auto& v) {
-      if (resultPopulated) {
-        // We should just get a single value, if we see multiple, it's an error
-        // and we should return null.
-        resultStr = std::nullopt;
-        return true;
-      }
-
-      resultPopulated = true;
-
-      SIMDJSON_ASSIGN_OR_RAISE(auto vtype, v.type());
-      switch (vtype) {
-        case simdjson::ondemand::json_type::boolean: {
-          SIMDJSON_ASSIGN_OR_RAISE(bool vbool, v.get_bool());
-          resultStr = vbool ? "true" : "false";
-          break;
-        }
-        case simdjson::ondemand::json_type::string: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, v.get_string());
-          break;
-        }
-        case simdjson::ondemand::json_type::object:
-        case simdjson::ondemand::json_type::array:
-        case simdjson::ondemand::json_type::null:
-          // Do nothing.
-          break;
-        default: {
-          SIMDJSON_ASSIGN_OR_RAISE(resultStr, simdjson::to_json_string(v));
-        }
-      }
-      return true;
-    };
+    auto consumer = detail::makeScalarConsumer(resultStr, resultPopulated);
 
     if (!simdJsonExtract(json, jsonPath, consumer)) {
       // If there's an error parsing the JSON, return null.
@@ -224,6 +237,40 @@ struct SIMDJsonExtractScalarFunction {
   }
 };
 
+// jsonExtractScalars(json, json_path1, json_path2, ...) -> array(varchar)
+// Returns an array with jsonExtractScalar(json, json_path_i) at position i.
+// Parses the JSON once for all paths instead of once per path, which makes
+// extracting many fields from the same document much cheaper than separate
+// jsonExtractScalar() calls.
+template <typename T>
+struct SIMDJsonExtractScalarsFunction {
+  VELOX_DEFINE_FUNCTION_TYPES(T);
+
+  FOLLY_ALWAYS_INLINE bool call(
+      out_type<Array<Varchar>>& result,
+      const arg_type<Json>& json,
+      const arg_type<Variadic<Varchar>>& jsonPaths) {
+    simdjson::padded_string paddedJson(json.data(), json.size());
+    auto jsonDoc = simdJsonParse(paddedJson);
+    const bool validDoc = jsonDoc.error() == simdjson::SUCCESS;
+    for (const auto& jsonPath : jsonPaths) {
+      bool resultPopulated = false;
+      std::optional<std::string> resultStr;
+      auto consumer = detail::makeScalarConsumer(resultStr, resultPopulated);
+      // An extraction error, like a parsing error, makes only the value for
+      // this path null.
+      if (!validDoc ||
+          !simdJsonExtract(jsonDoc.value_unsafe(), *jsonPath, consumer) ||
+          !resultStr.has_value()) {
+        result.add_null();
+      } else {
+        result.add_item().copy_from(*resultStr);
+      }
+    }
+    return true;
+  }
+};
+
 template <typename T>
 struct SIMDJsonExtractFunction {
   VELOX_DEFINE_FUNCTION_TYPES(T);
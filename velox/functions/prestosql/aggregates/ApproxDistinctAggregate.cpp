@@ -54,6 +54,22 @@ struct HllAccumulator {
     }
   }
 
+  void append(folly::Range<const uint64_t*> hashes) {
+    size_t i = 0;
+    if (isSparse_) {
+      while (i < hashes.size()) {
+        if (sparseHll_.insertHash(hashes[i++])) {
+          toDense();
+          break;
+        }
+      }
+      if (isSparse_) {
+        return;
+      }
+    }
+    denseHll_.insertHashes(hashes.subpiece(i));
+  }
+
   int64_t cardinality() const {
     return isSparse_ ? sparseHll_.cardinality() : denseHll_.cardinality();
   }
@@ -212,6 +228,7 @@ class ApproxDistinctAggregate : public exec::Aggregate {
       addIntermediateResults(groups, rows, args, false /*unused*/);
     } else {
       decodeArguments(rows, args);
+      computeHashes(rows);
 
       rows.applyToSelected([&](auto row) {
         if (decodedValue_.isNullAt(row)) {
@@ -223,9 +240,7 @@ class ApproxDistinctAggregate : public exec::Aggregate {
         auto accumulator = value<HllAccumulator>(group);
         clearNull(group);
         accumulator->setIndexBitLength(indexBitLength_);
-
-        auto hash = hashOne(decodedValue_.valueAt<T>(row));
-        accumulator->append(hash);
+        accumulator->append(hashes_[row]);
       });
     }
   }
@@ -264,18 +279,22 @@ class ApproxDistinctAggregate : public exec::Aggregate {
     } else {
       decodeArguments(rows, args);
 
+      // Hash the whole column, then add the hashes to the HLL in one batch.
+      hashes_.clear();
       rows.applyToSelected([&](auto row) {
-        if (decodedValue_.isNullAt(row)) {
-          return;
+        if (!decodedValue_.isNullAt(row)) {
+          hashes_.push_back(hashOne(decodedValue_.valueAt<T>(row)));
         }
-
-        auto accumulator = value<HllAccumulator>(group);
-        clearNull(group);
-        accumulator->setIndexBitLength(indexBitLength_);
-
-        auto hash = hashOne(decodedValue_.valueAt<T>(row));
-        accumulator->append(hash);
       });
+      if (hashes_.empty()) {
+        return;
+      }
+
+      auto accumulator = value<HllAccumulator>(group);
+      clearNull(group);
+      accumulator->setIndexBitLength(indexBitLength_);
+      accumulator->append(
+          folly::Range<const uint64_t*>(hashes_.data(), hashes_.size()));
     }
   }
 
@@ -352,6 +371,17 @@ class ApproxDistinctAggregate : public exec::Aggregate {
     }
   }
 
+  // Hashes the non-null values of 'decodedValue_' in 'rows' into 'hashes_'
+  // before any accumulator is touched.
+  void computeHashes(const SelectivityVector& rows) {
+    hashes_.resize(rows.end());
+    rows.applyToSelected([&](auto row) {
+      if (!decodedValue_.isNullAt(row)) {
+        hashes_[row] = hashOne(decodedValue_.valueAt<T>(row));
+      }
+    });
+  }
+
   void checkSetMaxStandardError() {
     VELOX_USER_CHECK(
         decodedMaxStandardError_.isConstantMapping(),
@@ -389,6 +419,8 @@ class ApproxDistinctAggregate : public exec::Aggregate {
   DecodedVector decodedValue_;
   DecodedVector decodedMaxStandardError_;
   DecodedVector decodedHll_;
+  // Hashes of the raw input values of the current batch.
+  std::vector<uint64_t> hashes_;
 };
 
 template <TypeKind kind>
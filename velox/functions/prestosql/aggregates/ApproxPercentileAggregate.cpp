@@ -52,6 +52,10 @@ struct KllSketchAccumulator {
     sketch_.insert(value);
   }
 
+  void append(folly::Range<const T*> values) {
+    sketch_.insert(values);
+  }
+
   void append(T value, int64_t count) {
     constexpr size_t kMaxBufferSize = 4096;
     constexpr int64_t kMinCountToBuffer = 512;
@@ -393,19 +397,21 @@ class ApproxPercentileAggregate : public exec::Aggregate {
         accumulator->append(value, weight);
       });
     } else {
+      // Collect the values first so that the sketch fills level zero in bulk.
+      values_.clear();
       if (decodedValue_.mayHaveNulls()) {
         rows.applyToSelected([&](auto row) {
-          if (decodedValue_.isNullAt(row)) {
-            return;
+          if (!decodedValue_.isNullAt(row)) {
+            values_.push_back(decodedValue_.valueAt<T>(row));
           }
-
-          accumulator->append(decodedValue_.valueAt<T>(row));
         });
       } else {
         rows.applyToSelected([&](auto row) {
-          accumulator->append(decodedValue_.valueAt<T>(row));
+          values_.push_back(decodedValue_.valueAt<T>(row));
         });
       }
+      accumulator->append(
+          folly::Range<const T*>(values_.data(), values_.size()));
     }
   }
 
@@ -612,6 +618,8 @@ class ApproxPercentileAggregate : public exec::Aggregate {
   DecodedVector decodedWeight_;
   DecodedVector decodedAccuracy_;
   DecodedVector decodedDigest_;
+  // Non-null raw input values of a single group, reused across batches.
+  std::vector<T> values_;
 
  private:
   template <bool kSingleGroup, bool checkIntermediateInputs>
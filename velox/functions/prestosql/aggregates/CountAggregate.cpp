@@ -87,6 +87,51 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
     });
   }
 
+  void addDenseRawInput(
+      char** groups,
+      const uint64_t* groupIds,
+      int32_t numGroupIds,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    if (args.empty()) {
+      accumulateDense<false, int64_t>(
+          groups, numGroupIds, &addCount, [&](auto addValue) {
+            rows.applyToSelected(
+                [&](vector_size_t i) { addValue(i, groupIds[i], 1); });
+          });
+      return;
+    }
+
+    DecodedVector decoded(*args[0], rows);
+    if (decoded.isConstantMapping() && decoded.isNullAt(0)) {
+      return;
+    }
+    accumulateDense<false, int64_t>(
+        groups, numGroupIds, &addCount, [&](auto addValue) {
+          rows.applyToSelected([&](vector_size_t i) {
+            if (!decoded.isNullAt(i)) {
+              addValue(i, groupIds[i], 1);
+            }
+          });
+        });
+  }
+
+  void addDenseIntermediateResults(
+      char** groups,
+      const uint64_t* groupIds,
+      int32_t numGroupIds,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    decodedIntermediate_.decode(*args[0], rows);
+    accumulateDense<false, int64_t>(
+        groups, numGroupIds, &addCount, [&](auto addValue) {
+          rows.applyToSelected([&](vector_size_t i) {
+            addValue(
+                i, groupIds[i], decodedIntermediate_.valueAt<int64_t>(i));
+          });
+        });
+  }
+
   void addSingleGroupRawInput(
       char* group,
       const SelectivityVector& rows,
@@ -143,6 +188,10 @@ class CountAggregate : public SimpleNumericAggregate<bool, int64_t, int64_t> {
     *value<int64_t>(group) += count;
   }
 
+  static void addCount(int64_t& result, int64_t count) {
+    result += count;
+  }
+
   DecodedVector decodedIntermediate_;
 };
 
@@ -163,6 +163,29 @@ class MaxAggregate : public MinMaxAggregate<T> {
     addRawInput(groups, rows, args, mayPushdown);
   }
 
+  void addDenseRawInput(
+      char** groups,
+      const uint64_t* groupIds,
+      int32_t numGroupIds,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    BaseAggregate::template updateDenseGroups<true, T>(
+        groups, groupIds, numGroupIds, rows, args[0], [](T& result, T value) {
+          if (result < value) {
+            result = value;
+          }
+        });
+  }
+
+  void addDenseIntermediateResults(
+      char** groups,
+      const uint64_t* groupIds,
+      int32_t numGroupIds,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    addDenseRawInput(groups, groupIds, numGroupIds, rows, args);
+  }
+
   void addSingleGroupRawInput(
       char* group,
       const SelectivityVector& rows,
@@ -248,6 +271,29 @@ class MinAggregate : public MinMaxAggregate<T> {
     addRawInput(groups, rows, args, mayPushdown);
   }
 
+  void addDenseRawInput(
+      char** groups,
+      const uint64_t* groupIds,
+      int32_t numGroupIds,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    BaseAggregate::template updateDenseGroups<true, T>(
+        groups, groupIds, numGroupIds, rows, args[0], [](T& result, T value) {
+          if (result > value) {
+            result = value;
+          }
+        });
+  }
+
+  void addDenseIntermediateResults(
+      char** groups,
+      const uint64_t* groupIds,
+      int32_t numGroupIds,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    addDenseRawInput(groups, groupIds, numGroupIds, rows, args);
+  }
+
   void addSingleGroupRawInput(
       char* group,
       const SelectivityVector& rows,
@@ -107,9 +107,8 @@ struct MultiMapAccumulator {
       mapValueArrays.setOffsetAndSize(keyOffset, valueOffset, numValues);
 
       aggregate::ValueListReader reader(entry.second);
-      for (auto i = 0; i < numValues; i++) {
-        reader.next(*mapValues, valueOffset++);
-      }
+      reader.readAll(*mapValues, valueOffset);
+      valueOffset += numValues;
 
       ++keyOffset;
     }
@@ -85,6 +85,26 @@ class SumAggregate
     updateInternal<TAccumulator, TAccumulator>(groups, rows, args, mayPushdown);
   }
 
+  void addDenseRawInput(
+      char** groups,
+      const uint64_t* groupIds,
+      int32_t numGroupIds,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    updateDenseInternal<TAccumulator>(
+        groups, groupIds, numGroupIds, rows, args);
+  }
+
+  void addDenseIntermediateResults(
+      char** groups,
+      const uint64_t* groupIds,
+      int32_t numGroupIds,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) override {
+    updateDenseInternal<TAccumulator, TAccumulator>(
+        groups, groupIds, numGroupIds, rows, args);
+  }
+
   void addSingleGroupRawInput(
       char* group,
       const SelectivityVector& rows,
@@ -144,6 +164,32 @@ class SumAggregate
     }
   }
 
+  template <typename TData, typename TValue = TInput>
+  void updateDenseInternal(
+      char** groups,
+      const uint64_t* groupIds,
+      int32_t numGroupIds,
+      const SelectivityVector& rows,
+      const std::vector<VectorPtr>& args) {
+    if (exec::Aggregate::numNulls_) {
+      BaseAggregate::template updateDenseGroups<true, TData, TValue>(
+          groups,
+          groupIds,
+          numGroupIds,
+          rows,
+          args[0],
+          &updateSingleValue<TData>);
+    } else {
+      BaseAggregate::template updateDenseGroups<false, TData, TValue>(
+          groups,
+          groupIds,
+          numGroupIds,
+          rows,
+          args[0],
+          &updateSingleValue<TData>);
+    }
+  }
+
  private:
   /// Update functions that check for overflows for integer types.
   /// For floating points, an overflow results in +/- infinity which is a
@@ -119,4 +119,85 @@ bool ValueListReader::next(BaseVector& output, vector_size_t outputIndex) {
   pos_++;
   return pos_ < size_;
 }
+
+void ValueListReader::readAll(BaseVector& output, vector_size_t outputIndex) {
+  if (output.encoding() == VectorEncoding::Simple::FLAT) {
+    // ContainerRowSerde serializes these types as their native fixed-width
+    // representation.
+    switch (output.typeKind()) {
+      case TypeKind::TINYINT:
+        readAllFixedWidth<TypeKind::TINYINT>(output, outputIndex);
+        return;
+      case TypeKind::SMALLINT:
+        readAllFixedWidth<TypeKind::SMALLINT>(output, outputIndex);
+        return;
+      case TypeKind::INTEGER:
+        readAllFixedWidth<TypeKind::INTEGER>(output, outputIndex);
+        return;
+      case TypeKind::BIGINT:
+        readAllFixedWidth<TypeKind::BIGINT>(output, outputIndex);
+        return;
+      case TypeKind::HUGEINT:
+        readAllFixedWidth<TypeKind::HUGEINT>(output, outputIndex);
+        return;
+      case TypeKind::REAL:
+        readAllFixedWidth<TypeKind::REAL>(output, outputIndex);
+        return;
+      case TypeKind::DOUBLE:
+        readAllFixedWidth<TypeKind::DOUBLE>(output, outputIndex);
+        return;
+      case TypeKind::TIMESTAMP:
+        readAllFixedWidth<TypeKind::TIMESTAMP>(output, outputIndex);
+        return;
+      default:
+        break;
+    }
+  }
+
+  const auto base = outputIndex - pos_;
+  while (pos_ < size_) {
+    next(output, base + pos_);
+  }
+}
+
+template <TypeKind kind>
+void ValueListReader::readAllFixedWidth(
+    BaseVector& output,
+    vector_size_t outputIndex) {
+  using T = typename TypeTraits<kind>::NativeType;
+  auto* flat = output.asUnchecked<FlatVector<T>>();
+  auto* rawValues = flat->mutableRawValues();
+  const auto base = outputIndex - pos_;
+  while (pos_ < size_) {
+    if (pos_ % 64 != 0) {
+      // Finish a partially read word of nulls one value at a time.
+      next(output, base + pos_);
+      continue;
+    }
+    nulls_ = pos_ == lastNullsStart_ ? lastNulls_
+                                     : nullsStream_.read<uint64_t>();
+    const auto end = std::min<vector_size_t>(size_, pos_ + 64);
+    const auto count = end - pos_;
+    const auto nulls = count == 64 ? nulls_ : nulls_ & bits::lowMask(count);
+    if (nulls == 0) {
+      // Non-null values are stored back to back.
+      dataStream_.readBytes(
+          reinterpret_cast<uint8_t*>(rawValues + base + pos_),
+          count * sizeof(T));
+      if (flat->rawNulls() != nullptr) {
+        bits::fillBits(
+            flat->mutableRawNulls(), base + pos_, base + end, bits::kNotNull);
+      }
+    } else {
+      for (auto i = pos_; i < end; ++i) {
+        if (nulls & (1UL << (i % 64))) {
+          flat->setNull(base + i, true);
+        } else {
+          flat->set(base + i, dataStream_.read<T>());
+        }
+      }
+    }
+    pos_ = end;
+  }
+}
 } // namespace facebook::velox::aggregate
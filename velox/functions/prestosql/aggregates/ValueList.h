@@ -119,7 +119,15 @@ class ValueListReader {
 
   bool next(BaseVector& output, vector_size_t outputIndex);
 
+  // Reads all remaining values into consecutive positions of 'output' starting
+  // at 'outputIndex'. Copies runs of non-null values in bulk if 'output' is a
+  // flat vector of a fixed-width type.
+  void readAll(BaseVector& output, vector_size_t outputIndex);
+
  private:
+  template <TypeKind kind>
+  void readAllFixedWidth(BaseVector& output, vector_size_t outputIndex);
+
   const vector_size_t size_;
   const vector_size_t lastNullsStart_;
   const uint64_t lastNulls_;
@@ -307,6 +307,27 @@ TEST_F(SumTest, sumDecimal) {
       /*testWithTableScan*/ false);
 }
 
+TEST_F(SumTest, sumShortDecimalNoNulls) {
+  // Large positive and negative values summed without nulls, which takes the
+  // path that sums the high and low halves of the values separately.
+  std::vector<int64_t> values;
+  for (int i = 0; i < 10'000; ++i) {
+    values.push_back(
+        i % 3 == 0 ? -DecimalUtil::kShortDecimalMax + i
+                   : DecimalUtil::kShortDecimalMax - i * 7);
+  }
+  auto input =
+      makeRowVector({makeFlatVector<int64_t>(values, DECIMAL(18, 2))});
+  createDuckDbTable({input});
+  testAggregations(
+      {input},
+      {},
+      {"sum(c0)"},
+      "SELECT sum(c0) FROM tmp",
+      /*config*/ {},
+      /*testWithTableScan*/ false);
+}
+
 TEST_F(SumTest, sumDecimalOverflow) {
   // Short decimals do not overflow easily.
   std::vector<int64_t> shortDecimalInput;
@@ -507,6 +528,29 @@ TEST_F(SumTest, boolKey) {
       vectors, {"c0"}, {"sum(c1)"}, "SELECT c0, sum(c1) FROM tmp GROUP BY 1");
 }
 
+// Small integer keys put the hash table in array mode, where fixed-width
+// aggregates receive dense group ids and reduce each batch before updating
+// the groups.
+TEST_F(SumTest, denseGroups) {
+  vector_size_t size = 1'000;
+  std::vector<RowVectorPtr> vectors;
+  for (int32_t i = 0; i < 5; ++i) {
+    vectors.push_back(makeRowVector(
+        {makeFlatVector<int32_t>(size, [](auto row) { return row % 7; }),
+         makeFlatVector<int64_t>(
+             size, [i](auto row) { return row * i - 300; }, nullEvery(5)),
+         makeFlatVector<double>(size, [](auto row) { return row * 0.5; })}));
+  }
+  createDuckDbTable(vectors);
+
+  testAggregations(
+      vectors,
+      {"c0"},
+      {"sum(c1)", "count(c1)", "min(c1)", "max(c1)", "sum(c2)", "count(1)"},
+      "SELECT c0, sum(c1), count(c1), min(c1), max(c1), sum(c2), count(1) "
+      "FROM tmp GROUP BY 1");
+}
+
 TEST_F(SumTest, emptyValues) {
   auto rowType = ROW({"c0", "c1"}, {INTEGER(), BIGINT()});
   auto vector = makeRowVector(
@@ -46,6 +46,26 @@ class ValueListTest : public functions::test::FunctionBaseTest {
     return result;
   }
 
+  // Reads the first 'numSingle' values with next() and the rest with
+  // readAll().
+  VectorPtr readAll(
+      aggregate::ValueList& values,
+      const TypePtr& type,
+      vector_size_t size,
+      vector_size_t numSingle) {
+    aggregate::ValueListReader reader(values);
+    auto result = BaseVector::create(type, size, pool());
+    for (auto i = 0; i < size; ++i) {
+      result->setNull(i, true);
+    }
+
+    for (auto i = 0; i < numSingle; i++) {
+      reader.next(*result, i);
+    }
+    reader.readAll(*result, numSingle);
+    return result;
+  }
+
   void testRoundTrip(const VectorPtr& data) {
     auto size = data->size();
 
@@ -73,6 +93,17 @@ class ValueListTest : public functions::test::FunctionBaseTest {
 
       assertEqualVectors(data, result);
     }
+
+    // Use ValueListReader::readAll from the start and from an unaligned
+    // position.
+    for (auto numSingle : {0, 3}) {
+      aggregate::ValueList values;
+      values.appendRange(data, 0, size, allocator());
+
+      auto result =
+          readAll(values, data->type(), size, std::min(numSingle, size));
+      assertEqualVectors(data, result);
+    }
   }
 
   HashStringAllocator* allocator() {
@@ -88,6 +88,15 @@ int main(int argc, char** argv) {
       .addExpression("vector", "contains(c0,  c1)")
       .addExpression("simple", "contains_alt(c0, c1)");
 
+  // Many short arrays searched for a constant, e.g. tags.
+  benchmarkBuilder
+      .addBenchmarkSet(
+          "contains_constant_key", ROW({"c0"}, {ARRAY(INTEGER())}))
+      .withFuzzerOptions(
+          {.vectorSize = 10'000, .nullRatio = 0, .containerLength = 4})
+      .addExpression("vector", "contains(c0, cast(1 as integer))")
+      .addExpression("simple", "contains_alt(c0, cast(1 as integer))");
+
   benchmarkBuilder.registerBenchmarks();
   // Make sure all expressions within benchmarkSets have the same results.
   benchmarkBuilder.testBenchmarks();
@@ -44,6 +44,12 @@ bool simdJsonExtract(
     const velox::StringView& path,
     TConsumer&& consumer);
 
+template <typename TConsumer>
+bool simdJsonExtract(
+    simdjson::ondemand::document& jsonDoc,
+    const velox::StringView& path,
+    TConsumer&& consumer);
+
 namespace detail {
 
 using JsonVector = std::vector<simdjson::ondemand::value>;
@@ -61,7 +67,7 @@ class SIMDJsonExtractor {
     return tokens_.empty();
   }
 
-  simdjson::simdjson_result<simdjson::ondemand::document> parse(
+  static simdjson::simdjson_result<simdjson::ondemand::document> parse(
       const simdjson::padded_string& json);
 
  private:
@@ -89,6 +95,12 @@ class SIMDJsonExtractor {
       const velox::StringView& json,
       const velox::StringView& path,
       TConsumer&& consumer);
+
+  template <typename TConsumer>
+  friend bool facebook::velox::functions::simdJsonExtract(
+      simdjson::ondemand::document& jsonDoc,
+      const velox::StringView& path,
+      TConsumer&& consumer);
 };
 
 bool extractObject(
@@ -152,6 +164,21 @@ bool SIMDJsonExtractor::extract(
 
   return consumer(input);
 }
+
+template <typename TConsumer>
+bool extractFromDocument(
+    SIMDJsonExtractor& extractor,
+    simdjson::ondemand::document& jsonDoc,
+    TConsumer&& consumer) {
+  if (extractor.isRootOnlyPath()) {
+    // If the path is just to return the original object, call consumer on the
+    // document.  Note, we cannot convert this to a value as this is not
+    // supported if the object is a scalar.
+    return consumer(jsonDoc);
+  }
+  SIMDJSON_ASSIGN_OR_RAISE(auto value, jsonDoc.get_value());
+  return extractor.extract(value, consumer);
+}
 } // namespace detail
 
 /**
@@ -183,15 +210,34 @@ bool simdJsonExtract(
   auto& extractor = detail::SIMDJsonExtractor::getInstance(path);
   simdjson::padded_string paddedJson(json.data(), json.size());
   SIMDJSON_ASSIGN_OR_RAISE(auto jsonDoc, extractor.parse(paddedJson));
+  return detail::extractFromDocument(
+      extractor, jsonDoc, std::forward<TConsumer>(consumer));
+}
 
-  if (extractor.isRootOnlyPath()) {
-    // If the path is just to return the original object, call consumer on the
-    // document.  Note, we cannot convert this to a value as this is not
-    // supported if the object is a scalar.
-    return consumer(jsonDoc);
-  }
-  SIMDJSON_ASSIGN_OR_RAISE(auto value, jsonDoc.get_value());
-  return extractor.extract(value, std::forward<TConsumer>(consumer));
+/**
+ * Parses 'json' with the thread's on-demand parser. The returned document
+ * refers to 'json', which must outlive it, and is only valid until the next
+ * call to simdJsonParse() or simdJsonExtract() on the same thread.
+ */
+inline simdjson::simdjson_result<simdjson::ondemand::document> simdJsonParse(
+    const simdjson::padded_string& json) {
+  return detail::SIMDJsonExtractor::parse(json);
+}
+
+/**
+ * Like simdJsonExtract() above, but extracts from a document returned by
+ * simdJsonParse(). The document is rewound first, so the same document can be
+ * used to extract several paths while indexing the JSON only once.
+ */
+template <typename TConsumer>
+bool simdJsonExtract(
+    simdjson::ondemand::document& jsonDoc,
+    const velox::StringView& path,
+    TConsumer&& consumer) {
+  auto& extractor = detail::SIMDJsonExtractor::getInstance(path);
+  jsonDoc.rewind();
+  return detail::extractFromDocument(
+      extractor, jsonDoc, std::forward<TConsumer>(consumer));
 }
 
 template <typename TConsumer>
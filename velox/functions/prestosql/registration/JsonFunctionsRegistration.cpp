@@ -31,6 +31,16 @@ void registerJsonFunctions(const std::string& prefix) {
       {prefix + "json_extract_scalar"});
   registerFunction<SIMDJsonExtractScalarFunction, Varchar, Varchar, Varchar>(
       {prefix + "json_extract_scalar"});
+  registerFunction<
+      SIMDJsonExtractScalarsFunction,
+      Array<Varchar>,
+      Json,
+      Variadic<Varchar>>({prefix + "json_extract_scalars"});
+  registerFunction<
+      SIMDJsonExtractScalarsFunction,
+      Array<Varchar>,
+      Varchar,
+      Variadic<Varchar>>({prefix + "json_extract_scalars"});
 
   registerFunction<SIMDJsonExtractFunction, Json, Json, Varchar>(
       {prefix + "json_extract"});
@@ -67,6 +77,10 @@ void registerJsonFunctions(const std::string& prefix) {
   VELOX_REGISTER_VECTOR_FUNCTION(udf_json_format, prefix + "json_format");
 
   VELOX_REGISTER_VECTOR_FUNCTION(udf_json_parse, prefix + "json_parse");
+
+  exec::registerExpressionRewrite([prefix](const auto& expr) {
+    return rewriteJsonExtractCall(prefix, expr);
+  });
 }
 
 } // namespace facebook::velox::functions
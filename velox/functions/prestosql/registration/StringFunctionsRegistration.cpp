@@ -114,6 +114,12 @@ void registerStringFunctions(const std::string& prefix) {
       makeRe2ExtractAll);
   exec::registerStatefulVectorFunction(
       prefix + "regexp_like", re2SearchSignatures(), makeRe2Search);
+  exec::registerStatefulVectorFunction(
+      prefix + "regexp_like_any", re2SearchAnySignatures(), makeRe2SearchAny);
+  exec::registerExpressionRewrite([prefix](const auto& expr) {
+    return rewriteRe2SearchDisjunction(
+        prefix + "regexp_like", prefix + "regexp_like_any", expr);
+  });
 
   registerFunction<StrLPosFunction, int64_t, Varchar, Varchar>(
       {prefix + "strpos"});
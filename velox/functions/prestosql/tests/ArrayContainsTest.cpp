@@ -316,4 +316,59 @@ TEST_F(ArrayContainsTest, dictionaryEncodingElements) {
   testContainsConstantKey(arrayVector, {3, 4, 5}, {true, true});
 }
 
+TEST_F(ArrayContainsTest, manyElements) {
+  // Arrays spanning several SIMD batches and words of the match bitmap.
+  auto testType = [&](auto value) {
+    using T = decltype(value);
+    auto arrayVector = makeArrayVector<T>(
+        50,
+        [](auto row) { return row % 7 == 0 ? 0 : row % 70; },
+        [](auto row, auto index) { return (row + index) % 100; });
+    for (T search : {0, 1, 30, 99}) {
+      std::vector<std::optional<bool>> expected;
+      for (auto row = 0; row < arrayVector->size(); ++row) {
+        const auto size = row % 7 == 0 ? 0 : row % 70;
+        bool found = false;
+        for (auto i = 0; i < size; ++i) {
+          found |= (row + i) % 100 == search;
+        }
+        expected.push_back(found);
+      }
+      testContains<T>(arrayVector, search, expected);
+    }
+  };
+  testType(int8_t());
+  testType(int32_t());
+  testType(int64_t());
+  testType(double());
+}
+
+TEST_F(ArrayContainsTest, constantArray) {
+  auto searchVector =
+      makeNullableFlatVector<int64_t>({1, 5, 11, std::nullopt, 10, 2});
+
+  auto arrayVector = BaseVector::wrapInConstant(
+      searchVector->size(),
+      0,
+      makeArrayVector<int64_t>({{10, 9, 8, 7, 6, 5, 4, 3, 2, 1}}));
+  auto result =
+      evaluate("contains(c0, c1)", makeRowVector({arrayVector, searchVector}));
+  assertEqualVectors(
+      makeNullableFlatVector<bool>(
+          {true, true, false, std::nullopt, true, true}),
+      result);
+
+  arrayVector = BaseVector::wrapInConstant(
+      searchVector->size(),
+      0,
+      makeNullableArrayVector<int64_t>(
+          {{10, 9, 8, 7, std::nullopt, 5, 4, 3, 2, 1}}));
+  result =
+      evaluate("contains(c0, c1)", makeRowVector({arrayVector, searchVector}));
+  assertEqualVectors(
+      makeNullableFlatVector<bool>(
+          {true, true, std::nullopt, std::nullopt, true, true}),
+      result);
+}
+
 } // namespace
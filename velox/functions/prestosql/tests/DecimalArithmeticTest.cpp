@@ -145,6 +145,28 @@ TEST_F(DecimalArithmeticTest, add) {
       "Decimal overflow: 1 + 99999999999999999999999999999999999999");
 }
 
+TEST_F(DecimalArithmeticTest, shortResult) {
+  // Arguments of different scales whose result is a short decimal.
+  auto a = makeFlatVector<int64_t>({12345, -99999, 0}, DECIMAL(10, 2));
+  auto b = makeFlatVector<int64_t>({10000, 5, -123456}, DECIMAL(8, 4));
+  testDecimalExpr<TypeKind::BIGINT>(
+      makeFlatVector<int64_t>({1244500, -9999895, -123456}, DECIMAL(13, 4)),
+      "c0 + c1",
+      {a, b});
+  testDecimalExpr<TypeKind::BIGINT>(
+      makeFlatVector<int64_t>({1224500, -9999905, 123456}, DECIMAL(13, 4)),
+      "c0 - c1",
+      {a, b});
+  testDecimalExpr<TypeKind::BIGINT>(
+      makeFlatVector<int64_t>({123450000, -499995, 0}, DECIMAL(18, 6)),
+      "c0 * c1",
+      {a, b});
+  testDecimalExpr<TypeKind::BIGINT>(
+      makeFlatVector<int64_t>({-990000, -999995, -1123456}, DECIMAL(9, 4)),
+      "c1 - 100.00",
+      {b});
+}
+
 TEST_F(DecimalArithmeticTest, subtract) {
   auto shortFlatA = makeFlatVector<int64_t>({1000, 2000}, DECIMAL(18, 3));
   // Subtract short and short, returning long.
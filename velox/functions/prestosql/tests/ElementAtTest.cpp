@@ -700,6 +700,61 @@ TEST_F(ElementAtTest, stringAsKey) {
           "element_at(C0, C1)", makeRowVector({mapVector, searchVector})));
 }
 
+// Wide maps, which are searched with one pass over the keys of the batch for
+// a constant key and binary searched if the keys are sorted.
+TEST_F(ElementAtTest, wideMaps) {
+  constexpr vector_size_t kSize = 100;
+  constexpr vector_size_t kWidth = 40;
+  auto sizeAt = [](vector_size_t row) { return row % 5 == 0 ? 0 : kWidth; };
+  auto keyAt = [](vector_size_t index) { return (index % kWidth) * 2; };
+  auto valueAt = [](vector_size_t index) { return index; };
+  auto mapVector =
+      makeMapVector<int64_t, int64_t>(kSize, sizeAt, keyAt, valueAt);
+  auto sortedMapVector = std::make_shared<MapVector>(
+      pool(),
+      mapVector->type(),
+      nullptr,
+      kSize,
+      mapVector->offsets(),
+      mapVector->sizes(),
+      mapVector->mapKeys(),
+      mapVector->mapValues(),
+      0,
+      true);
+
+  auto expectedAt = [&](int64_t key) {
+    return makeFlatVector<int64_t>(
+        kSize,
+        [&](auto row) {
+          return mapVector->offsetAt(row) + key / 2;
+        },
+        [&](auto row) {
+          return sizeAt(row) == 0 || key % 2 != 0 || key < 0 ||
+              key >= 2 * kWidth;
+        });
+  };
+  for (const auto& map : {mapVector, sortedMapVector}) {
+    for (int64_t key : {0, 2, 41, 78, 80}) {
+      SCOPED_TRACE(fmt::format("{} {}", map->hasSortedKeys(), key));
+      test::assertEqualVectors(
+          expectedAt(key),
+          evaluate(
+              fmt::format("element_at(c0, {})", key), makeRowVector({map})));
+    }
+  }
+
+  // Variable keys in sorted maps.
+  auto keys = makeFlatVector<int64_t>(kSize, [](auto row) { return row; });
+  test::assertEqualVectors(
+      makeFlatVector<int64_t>(
+          kSize,
+          [&](auto row) { return mapVector->offsetAt(row) + row / 2; },
+          [&](auto row) {
+            return sizeAt(row) == 0 || row % 2 != 0 || row >= 2 * kWidth;
+          }),
+      evaluate("element_at(c0, c1)", makeRowVector({sortedMapVector, keys})));
+}
+
 TEST_F(ElementAtTest, mapWithComplexTypeAsKey) {
   VectorPtr mapVector, keyVector, searchVector;
   const auto expected = makeNullableFlatVector<int64_t>({1, 3, std::nullopt});
@@ -183,6 +183,51 @@ TEST_F(JsonExtractScalarTest, overflow) {
       "184467440737095516151844674407370955161518446744073709551615");
 }
 
+TEST_F(JsonExtractScalarTest, multiplePaths) {
+  std::vector<std::optional<std::string>> json = {
+      R"({"a": 1, "b": {"c": "x"}, "d": [true, null]})",
+      R"({"a": "y", "d": [false]})",
+      R"({"a": 1, "b": )",
+      std::nullopt};
+  std::vector<std::string> paths = {"$.a", "$.b.c", "$.d[0]", "$.d[1]", "$.b"};
+
+  // Each element matches a separate json_extract_scalar call.
+  std::vector<std::optional<std::vector<std::optional<std::string>>>>
+      expected;
+  for (const auto& row : json) {
+    if (!row.has_value()) {
+      expected.push_back(std::nullopt);
+      continue;
+    }
+    std::vector<std::optional<std::string>> values;
+    for (const auto& path : paths) {
+      values.push_back(jsonExtractScalar(row, path));
+    }
+    expected.push_back(values);
+  }
+  ASSERT_EQ(
+      expected[0].value(),
+      (std::vector<std::optional<std::string>>{
+          "1", "x", "true", std::nullopt, std::nullopt}));
+
+  for (const auto& type : {JSON(), VARCHAR()}) {
+    auto data =
+        makeRowVector({makeNullableFlatVector<std::string>(json, type)});
+    velox::test::assertEqualVectors(
+        makeNullableArrayVector<std::string>(expected),
+        evaluate(
+            "json_extract_scalars("
+            "c0, '$.a', '$.b.c', '$.d[0]', '$.d[1]', '$.b')",
+            data));
+  }
+
+  EXPECT_THROW(
+      evaluate(
+          "json_extract_scalars(c0, '$.a', '$.k1.')",
+          makeRowVector({makeFlatVector<std::string>({R"({"a": 1})"})})),
+      VeloxUserError);
+}
+
 // TODO: When there is a wildcard in the json path, Presto's behavior is to
 // always extract an array of selected items, and hence json_extract_scalar()
 // always return NULL in this situation. But some internal customers are
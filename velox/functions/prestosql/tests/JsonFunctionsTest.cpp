@@ -15,6 +15,7 @@
  */
 
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/functions/prestosql/JsonFunctions.h"
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
 #include "velox/functions/prestosql/types/JsonType.h"
 
@@ -590,6 +591,47 @@ TEST_F(JsonFunctionsTest, jsonExtract) {
   VELOX_ASSERT_THROW(jsonExtract(kJson, "$.store.keys()"), "Invalid JSON path");
 }
 
+TEST_F(JsonFunctionsTest, nestedJsonExtract) {
+  auto rowType = ROW({"c0"}, {JSON()});
+  auto rewrite = [&](const std::string& text) {
+    return rewriteJsonExtractCall("", makeTypedExpr(text, rowType));
+  };
+  auto pathOf = [](const core::TypedExprPtr& expr) {
+    auto path = std::dynamic_pointer_cast<const core::ConstantTypedExpr>(
+        expr->inputs()[1]);
+    return path->value().value<TypeKind::VARCHAR>();
+  };
+
+  auto rewritten = rewrite(
+      "json_extract_scalar(json_extract(json_extract(c0, '$.store'), "
+      "' $.book[1]'), '$.author')");
+  ASSERT_NE(rewritten, nullptr);
+  ASSERT_TRUE(rewritten->inputs()[0]->type()->equivalent(*JSON()));
+  EXPECT_EQ(pathOf(rewritten), "$.store.book[1].author");
+
+  rewritten =
+      rewrite("json_extract(json_extract(c0, '$.store'), '$.book[*]')");
+  ASSERT_NE(rewritten, nullptr);
+  EXPECT_EQ(pathOf(rewritten), "$.store.book[*]");
+
+  // Wildcards in the inner path and invalid paths are not rewritten.
+  EXPECT_EQ(
+      rewrite("json_extract_scalar(json_extract(c0, '$.a[*]'), '$.b')"),
+      nullptr);
+  EXPECT_EQ(
+      rewrite("json_extract_scalar(json_extract(c0, '$.a'), '$..b')"),
+      nullptr);
+  EXPECT_EQ(rewrite("json_extract_scalar(c0, '$.a')"), nullptr);
+
+  auto data = makeRowVector({makeJsonVector(kJson)});
+  auto result = evaluate(
+      "json_extract_scalar(json_extract(json_extract(c0, '$.store'), "
+      "'$.book[1]'), '$.author')",
+      data);
+  velox::test::assertEqualVectors(
+      makeFlatVector<std::string>({"Evelyn Waugh"}), result);
+}
+
 } // namespace
 
 } // namespace facebook::velox::functions::prestosql
@@ -13,6 +13,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "velox/common/base/tests/GTestUtils.h"
 #include "velox/functions/prestosql/tests/utils/FunctionBaseTest.h"
 
 using namespace facebook::velox;
@@ -45,6 +46,38 @@ TEST_F(ReduceTest, basic) {
   assertEqualVectors(expectedResult, result);
 }
 
+// Sums are computed without evaluating the lambda per element position. Null
+// elements make the result null and overflow raises the same error as the
+// lambda.
+TEST_F(ReduceTest, sum) {
+  auto input = makeRowVector({
+      makeNullableArrayVector<int64_t>(
+          {{1, 2, 3}, {}, {4, std::nullopt, 5}, {10}, std::nullopt}),
+      makeNullableFlatVector<int64_t>({0, 7, 1, std::nullopt, 2}),
+  });
+  auto expected = makeNullableFlatVector<int64_t>(
+      {6, 7, std::nullopt, std::nullopt, std::nullopt});
+  assertEqualVectors(
+      expected, evaluate("reduce(c0, c1, (s, x) -> s + x, s -> s)", input));
+  assertEqualVectors(
+      expected, evaluate("reduce(c0, c1, (s, x) -> x + s, s -> s)", input));
+
+  auto doubles = makeRowVector({makeArrayVector<double>(
+      {{0.1, 0.2, 0.3}, {}, {1e20, 1, -1e20}})});
+  assertEqualVectors(
+      makeFlatVector<double>({0.1 + 0.2 + 0.3, 0, 1e20 + 1 - 1e20}),
+      evaluate("reduce(c0, 0.0, (s, x) -> s + x, s -> s)", doubles));
+
+  auto overflow = makeRowVector({makeArrayVector<int64_t>(
+      {{1, 2}, {std::numeric_limits<int64_t>::max(), 1}})});
+  VELOX_ASSERT_THROW(
+      evaluate("reduce(c0, 0, (s, x) -> s + x, s -> s)", overflow),
+      "overflow");
+  assertEqualVectors(
+      makeNullableFlatVector<int64_t>({3, std::nullopt}),
+      evaluate("try(reduce(c0, 0, (s, x) -> s + x, s -> s))", overflow));
+}
+
 // Types of array elements, intermediate results and final results are all
 // different: BIGINT vs. DOUBLE vs. BOOLEAN:
 //  reduce(a, 100, (s, x) -> s + x * 0.1, s -> s < 101)
@@ -1518,6 +1518,53 @@ TEST_F(StringFunctionsTest, ascinessOnDictionary) {
   ASSERT_EQ(ascii && ascii.value(), true);
 }
 
+TEST_F(StringFunctionsTest, dictionaryPreserving) {
+  // Strings are longer than StringView's inline size so that results which
+  // reference the input can be told apart from copies.
+  auto base = makeFlatVector<std::string>({
+      "  Apple pie with cream  ",
+      "  Banana split sundae  ",
+      "  Cherry tart and tea  ",
+  });
+  const vector_size_t size = 1'000;
+  auto indices = makeIndices(size, [](auto row) { return row % 3; });
+  auto data = makeRowVector({wrapInDictionary(indices, size, base)});
+  auto flatData = makeRowVector({makeFlatVector<std::string>(
+      size, [&](auto row) { return base->valueAt(row % 3).str(); })});
+
+  for (const auto& expression :
+       {"upper(c0)",
+        "lower(c0)",
+        "trim(c0)",
+        "ltrim(c0)",
+        "substr(c0, 3, 15)"}) {
+    SCOPED_TRACE(expression);
+    auto result = evaluate(expression, data);
+    assertEqualVectors(evaluate(expression, flatData), result);
+
+    // The function runs on the distinct base values only and the result keeps
+    // the input's indices.
+    ASSERT_EQ(result->encoding(), VectorEncoding::Simple::DICTIONARY);
+    ASSERT_EQ(result->valueVector()->size(), base->size());
+    for (auto row = 0; row < size; ++row) {
+      ASSERT_EQ(result->wrappedIndex(row), row % 3);
+    }
+  }
+
+  // trim and substr return views into the input strings instead of copies.
+  for (const auto& expression : {"trim(c0)", "substr(c0, 3, 15)"}) {
+    SCOPED_TRACE(expression);
+    auto result = evaluate(expression, data);
+    auto resultBase = result->valueVector()->asFlatVector<StringView>();
+    for (auto i = 0; i < base->size(); ++i) {
+      const auto input = base->valueAt(i);
+      const auto output = resultBase->valueAt(i);
+      ASSERT_GE(output.data(), input.data());
+      ASSERT_LE(output.data() + output.size(), input.data() + input.size());
+    }
+  }
+}
+
 TEST_F(StringFunctionsTest, vectorAccessCheck) {
   using S = StringView;
 
@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 #include "velox/common/base/tests/GTestUtils.h"
+#include "velox/exec/PlanNodeStats.h"
+#include "velox/exec/tests/utils/AssertQueryBuilder.h"
+#include "velox/exec/tests/utils/TempDirectoryPath.h"
 #include "velox/functions/lib/window/tests/WindowTestBase.h"
 #include "velox/functions/prestosql/window/WindowFunctionsRegistration.h"
 
@@ -103,5 +106,39 @@ VELOX_INSTANTIATE_TEST_SUITE_P(
     RankTest,
     testing::ValuesIn(getRankTestParams()));
 
+class RankSpillTest : public WindowTestBase {
+ protected:
+  void SetUp() override {
+    WindowTestBase::SetUp();
+    window::prestosql::registerAllWindowFunctions();
+  }
+};
+
+// Tests that a sort based window spills its input and produces the same
+// results when the partitions are loaded back from disk.
+TEST_F(RankSpillTest, spill) {
+  std::vector<RowVectorPtr> input;
+  for (auto i = 0; i < 10; ++i) {
+    input.push_back(makeSimpleVector(1'000));
+  }
+  createDuckDbTable(input);
+
+  for (const auto& overClause : kOverClauses) {
+    auto queryInfo = buildWindowQuery(input, "row_number()", overClause, "");
+    SCOPED_TRACE(queryInfo.functionSql);
+
+    auto spillDirectory = exec::test::TempDirectoryPath::create();
+    auto task = AssertQueryBuilder(queryInfo.planNode, duckDbQueryRunner_)
+                    .spillDirectory(spillDirectory->path)
+                    .config(core::QueryConfig::kSpillEnabled, "true")
+                    .config(core::QueryConfig::kWindowSpillEnabled, "true")
+                    .config(core::QueryConfig::kTestingSpillPct, "100")
+                    .assertResults(queryInfo.querySql);
+
+    auto planStats = exec::toPlanStats(task->taskStats());
+    ASSERT_GT(planStats.at(queryInfo.planNode->id()).spilledBytes, 0);
+  }
+}
+
 }; // namespace
 }; // namespace facebook::velox::window::test
@@ -106,6 +106,18 @@ TEST_P(SimpleAggregatesTest, randomInput) {
   testWindowFunction({makeRandomInputVector(25)});
 }
 
+// Tests function with frames large enough to be computed using the segment
+// tree of intermediate results.
+TEST_P(SimpleAggregatesTest, largeFrames) {
+  auto input = {makeSinglePartitionVector(500), makeSinglePartitionVector(400)};
+  testWindowFunction(
+      input,
+      {"rows between 100 preceding and current row",
+       "rows between 100 preceding and 100 following",
+       "rows between current row and unbounded following",
+       "rows between c2 preceding and 50 following"});
+}
+
 // Instantiate all the above tests for each combination of aggregate function
 // and over clause.
 VELOX_INSTANTIATE_TEST_SUITE_P(
@@ -16,9 +16,15 @@
 
 #include "velox/functions/remote/client/Remote.h"
 
+#include <folly/futures/Future.h>
 #include <folly/io/async/EventBase.h>
+#include <optional>
+#include <unordered_map>
+#include "velox/common/base/RuntimeMetrics.h"
+#include "velox/common/time/Timer.h"
 #include "velox/expression/Expr.h"
 #include "velox/expression/VectorFunction.h"
+#include "velox/functions/remote/client/SharedMemoryClient.h"
 #include "velox/functions/remote/client/ThriftClient.h"
 #include "velox/functions/remote/if/GetSerde.h"
 #include "velox/functions/remote/if/gen-cpp2/RemoteFunctionServiceAsyncClient.h"
@@ -41,9 +47,28 @@ class RemoteFunction : public exec::VectorFunction {
       const RemoteVectorFunctionMetadata& metadata)
       : functionName_(functionName),
         location_(metadata.location),
-        thriftClient_(getThriftClient(location_, &eventBase_)),
+        thriftClient_(
+            metadata.sharedMemoryName.empty()
+                ? getThriftClient(location_, &eventBase_)
+                : nullptr),
+        sharedMemoryClient_(
+            metadata.sharedMemoryName.empty()
+                ? nullptr
+                : std::make_unique<SharedMemoryClient>(
+                      metadata.sharedMemoryName,
+                      metadata.sharedMemoryChannels,
+                      std::chrono::milliseconds(
+                          metadata.sharedMemoryTimeoutMs))),
         serdeFormat_(metadata.serdeFormat),
-        serde_(getSerde(serdeFormat_)) {
+        serde_(getSerde(serdeFormat_)),
+        maxRowsPerRequest_(metadata.maxRowsPerRequest),
+        maxConcurrentRequests_(std::max(1, metadata.maxConcurrentRequests)),
+        maxRequestBytes_(metadata.maxRequestBytes),
+        deterministic_(metadata.deterministic),
+        resultCacheRows_(metadata.deterministic ? metadata.resultCacheRows : 0),
+        latencyStat_(fmt::format("remote.{}.latencyNanos", functionName)),
+        numRequestsStat_(fmt::format("remote.{}.numRequests", functionName)),
+        cacheHitsStat_(fmt::format("remote.{}.cacheHits", functionName)) {
     std::vector<TypePtr> types;
     types.reserve(inputArgs.size());
     serializedInputTypes_.reserve(inputArgs.size());
@@ -62,7 +87,11 @@ class RemoteFunction : public exec::VectorFunction {
       exec::EvalCtx& context,
       VectorPtr& result) const override {
     try {
-      applyRemote(rows, args, outputType, context, result);
+      if (resultCacheRows_ > 0) {
+        applyCached(rows, args, outputType, context, result);
+      } else {
+        result = invokeRemote(std::move(args), rows.end(), outputType, context);
+      }
     } catch (const VeloxRuntimeError&) {
       throw;
     } catch (const std::exception&) {
@@ -70,10 +99,8 @@ class RemoteFunction : public exec::VectorFunction {
     }
   }
 
-  // TODO: The values for these flags shold be obtained from the
-  // VectorFunctionMetadata object passed by clients.
   bool isDeterministic() const override {
-    return true;
+    return deterministic_;
   }
 
   bool isDefaultNullBehavior() const override {
@@ -81,22 +108,278 @@ class RemoteFunction : public exec::VectorFunction {
   }
 
  private:
-  void applyRemote(
+  // Looks up 'rows' in the result cache and sends only the rows that are not
+  // in the cache, once per distinct row.
+  void applyCached(
       const SelectivityVector& rows,
       std::vector<VectorPtr>& args,
       const TypePtr& outputType,
       exec::EvalCtx& context,
       VectorPtr& result) const {
-    // Create type and row vector for serialization.
-    auto remoteRowVector = std::make_shared<RowVector>(
-        context.pool(),
-        remoteInputType_,
-        BufferPtr{},
-        rows.end(),
-        std::move(args));
-
-    // Send to remote server.
-    remote::RemoteFunctionResponse remoteResponse;
+    if (!cachedResults_) {
+      for (const auto& arg : args) {
+        cachedArgs_.push_back(
+            BaseVector::create(arg->type(), resultCacheRows_, context.pool()));
+      }
+      cachedResults_ =
+          BaseVector::create(outputType, resultCacheRows_, context.pool());
+    }
+
+    const auto numRows = rows.end();
+    // For each row, the row of the cache or of the response with its result.
+    std::vector<vector_size_t> cacheRows(numRows);
+    std::vector<vector_size_t> missRows(numRows);
+    SelectivityVector hits(numRows, false);
+    SelectivityVector misses(numRows, false);
+    std::vector<uint64_t> hashes(numRows);
+    // Rows of 'args' that are sent, keyed on hash.
+    std::unordered_multimap<uint64_t, vector_size_t> sentRows;
+    auto missIndices = allocateIndices(numRows, context.pool());
+    auto* rawMissIndices = missIndices->asMutable<vector_size_t>();
+    vector_size_t numMisses = 0;
+    rows.applyToSelected([&](auto row) {
+      uint64_t hash = 0;
+      for (const auto& arg : args) {
+        hash = bits::hashMix(hash, arg->hashValueAt(row));
+      }
+      hashes[row] = hash;
+      auto cached = findRow(cacheIndex_, hash, cachedArgs_, args, row);
+      if (cached.has_value()) {
+        hits.setValid(row, true);
+        cacheRows[row] = cached.value();
+        return;
+      }
+      misses.setValid(row, true);
+      auto sent = findRow(sentRows, hash, args, args, row);
+      if (sent.has_value()) {
+        missRows[row] = missRows[sent.value()];
+        return;
+      }
+      sentRows.emplace(hash, row);
+      missRows[row] = numMisses;
+      rawMissIndices[numMisses++] = row;
+    });
+    hits.updateBounds();
+    misses.updateBounds();
+    addThreadLocalRuntimeStat(
+        cacheHitsStat_, RuntimeCounter(hits.countSelected()));
+
+    VectorPtr missResults;
+    if (numMisses > 0) {
+      std::vector<VectorPtr> missArgs;
+      missArgs.reserve(args.size());
+      for (const auto& arg : args) {
+        missArgs.push_back(
+            BaseVector::wrapInDictionary(nullptr, missIndices, numMisses, arg));
+      }
+      missResults =
+          invokeRemote(std::move(missArgs), numMisses, outputType, context);
+    }
+
+    auto output = BaseVector::create(outputType, numRows, context.pool());
+    if (hits.hasSelections()) {
+      output->copy(cachedResults_.get(), hits, cacheRows.data());
+    }
+    if (misses.hasSelections()) {
+      output->copy(missResults.get(), misses, missRows.data());
+      addToCache(args, rawMissIndices, numMisses, hashes, missResults);
+    }
+    result = std::move(output);
+  }
+
+  // Returns the row of 'vectors' that is equal to 'row' of 'args' among the
+  // rows with 'hash' in 'index'.
+  static std::optional<vector_size_t> findRow(
+      const std::unordered_multimap<uint64_t, vector_size_t>& index,
+      uint64_t hash,
+      const std::vector<VectorPtr>& vectors,
+      const std::vector<VectorPtr>& args,
+      vector_size_t row) {
+    auto [begin, end] = index.equal_range(hash);
+    for (auto it = begin; it != end; ++it) {
+      bool equal = true;
+      for (size_t i = 0; i < args.size(); ++i) {
+        if (!vectors[i]->equalValueAt(args[i].get(), it->second, row)) {
+          equal = false;
+          break;
+        }
+      }
+      if (equal) {
+        return it->second;
+      }
+    }
+    return std::nullopt;
+  }
+
+  // Adds the rows 'indices' of 'args' and their results in 'results' to the
+  // cache. The cache is emptied when full.
+  void addToCache(
+      const std::vector<VectorPtr>& args,
+      const vector_size_t* indices,
+      vector_size_t numRows,
+      const std::vector<uint64_t>& hashes,
+      const VectorPtr& results) const {
+    numRows = std::min(numRows, resultCacheRows_);
+    if (numCachedRows_ + numRows > resultCacheRows_) {
+      cacheIndex_.clear();
+      numCachedRows_ = 0;
+    }
+    std::vector<BaseVector::CopyRange> argRanges(numRows);
+    for (auto i = 0; i < numRows; ++i) {
+      argRanges[i] = {indices[i], numCachedRows_ + i, 1};
+      cacheIndex_.emplace(hashes[indices[i]], numCachedRows_ + i);
+    }
+    for (size_t i = 0; i < args.size(); ++i) {
+      cachedArgs_[i]->copyRanges(
+          args[i].get(), folly::Range(argRanges.data(), argRanges.size()));
+    }
+    cachedResults_->copy(results.get(), numCachedRows_, 0, numRows);
+    numCachedRows_ += numRows;
+  }
+
+  // Returns the results of the function for the 'numRows' first rows of
+  // 'args'. Sends requests of at most 'maxRowsPerRequest_' rows and
+  // 'maxRequestBytes_' bytes and keeps up to 'maxConcurrentRequests_' of them
+  // in flight, so that the round trips overlap instead of adding up.
+  VectorPtr invokeRemote(
+      std::vector<VectorPtr> args,
+      vector_size_t numRows,
+      const TypePtr& outputType,
+      exec::EvalCtx& context) const {
+    const auto rowsPerRequest = maxRowsInRequest(args, numRows);
+    if (numRows <= rowsPerRequest) {
+      // Create type and row vector for serialization.
+      auto remoteRowVector = std::make_shared<RowVector>(
+          context.pool(),
+          remoteInputType_,
+          BufferPtr{},
+          numRows,
+          std::move(args));
+
+      // Send to remote server.
+      remote::RemoteFunctionResponse remoteResponse;
+      auto request = makeRequest(remoteRowVector, outputType, context);
+      {
+        RequestStats stats(*this, 1);
+        try {
+          if (sharedMemoryClient_) {
+            remoteResponse = sharedMemoryClient_->invokeFunction(request);
+          } else {
+            thriftClient_->sync_invokeFunction(remoteResponse, request);
+          }
+        } catch (const std::exception& e) {
+          throwRemoteError(e.what());
+        }
+      }
+      return readResult(remoteResponse, outputType, context);
+    }
+
+    auto output = BaseVector::create(outputType, numRows, context.pool());
+    vector_size_t offset = 0;
+    while (offset < numRows) {
+      std::vector<remote::RemoteFunctionRequest> requests;
+      std::vector<vector_size_t> offsets;
+      while (offset < numRows && requests.size() < maxConcurrentRequests_) {
+        const auto size = std::min(rowsPerRequest, numRows - offset);
+        std::vector<VectorPtr> slices;
+        slices.reserve(args.size());
+        for (const auto& arg : args) {
+          slices.push_back(arg->slice(offset, size));
+        }
+        auto remoteRowVector = std::make_shared<RowVector>(
+            context.pool(),
+            remoteInputType_,
+            BufferPtr{},
+            size,
+            std::move(slices));
+        requests.push_back(makeRequest(remoteRowVector, outputType, context));
+        offsets.push_back(offset);
+        offset += size;
+      }
+
+      std::vector<folly::Try<remote::RemoteFunctionResponse>> tries;
+      {
+        RequestStats stats(*this, requests.size());
+        tries = sendRequests(requests);
+      }
+      for (size_t i = 0; i < tries.size(); ++i) {
+        if (tries[i].hasException()) {
+          throwRemoteError(tries[i].exception().what().toStdString());
+        }
+        auto part = readResult(tries[i].value(), outputType, context);
+        output->copy(part.get(), offsets[i], 0, part->size());
+      }
+    }
+    return output;
+  }
+
+  // Sends 'requests' at the same time over Thrift or one after the other over
+  // shared memory.
+  std::vector<folly::Try<remote::RemoteFunctionResponse>> sendRequests(
+      const std::vector<remote::RemoteFunctionRequest>& requests) const {
+    if (sharedMemoryClient_) {
+      std::vector<folly::Try<remote::RemoteFunctionResponse>> tries;
+      tries.reserve(requests.size());
+      for (const auto& request : requests) {
+        tries.push_back(folly::makeTryWith(
+            [&]() { return sharedMemoryClient_->invokeFunction(request); }));
+      }
+      return tries;
+    }
+    std::vector<folly::SemiFuture<remote::RemoteFunctionResponse>> responses;
+    responses.reserve(requests.size());
+    for (const auto& request : requests) {
+      responses.push_back(thriftClient_->semifuture_invokeFunction(request));
+    }
+    return folly::collectAll(std::move(responses)).getVia(&eventBase_);
+  }
+
+  // Returns the max number of rows of 'args' in one request.
+  vector_size_t maxRowsInRequest(
+      const std::vector<VectorPtr>& args,
+      vector_size_t numRows) const {
+    vector_size_t maxRows =
+        maxRowsPerRequest_ == 0 ? numRows : maxRowsPerRequest_;
+    if (maxRequestBytes_ > 0 && numRows > 0) {
+      uint64_t bytes = 0;
+      for (const auto& arg : args) {
+        bytes += arg->estimateFlatSize();
+      }
+      const auto bytesPerRow = std::max<uint64_t>(1, bytes / numRows);
+      maxRows = std::min<int64_t>(
+          maxRows, std::max<int64_t>(1, maxRequestBytes_ / bytesPerRow));
+    }
+    return std::max<vector_size_t>(1, maxRows);
+  }
+
+  // Records the wait for 'numRequests' in flight requests from construction
+  // to destruction.
+  class RequestStats {
+   public:
+    RequestStats(const RemoteFunction& function, int32_t numRequests)
+        : function_(function), numRequests_(numRequests), timer_(&nanos_) {}
+
+    ~RequestStats() {
+      // Stop the timer before reporting.
+      timer_.reset();
+      addThreadLocalRuntimeStat(
+          function_.latencyStat_,
+          RuntimeCounter(nanos_, RuntimeCounter::Unit::kNanos));
+      addThreadLocalRuntimeStat(
+          function_.numRequestsStat_, RuntimeCounter(numRequests_));
+    }
+
+   private:
+    const RemoteFunction& function_;
+    const int32_t numRequests_;
+    uint64_t nanos_{0};
+    std::optional<NanosecondTimer> timer_;
+  };
+
+  remote::RemoteFunctionRequest makeRequest(
+      const RowVectorPtr& remoteRowVector,
+      const TypePtr& outputType,
+      exec::EvalCtx& context) const {
     remote::RemoteFunctionRequest request;
     request.throwOnError_ref() = context.throwOnError();
 
@@ -111,33 +394,60 @@ class RemoteFunction : public exec::VectorFunction {
 
     // TODO: serialize only active rows.
     requestInputs->payload_ref() = rowVectorToIOBuf(
-        remoteRowVector, rows.end(), *context.pool(), serde_.get());
-
-    try {
-      thriftClient_->sync_invokeFunction(remoteResponse, request);
-    } catch (const std::exception& e) {
-      VELOX_FAIL(
-          "Error while executing remote function '{}' at '{}': {}",
-          functionName_,
-          location_.describe(),
-          e.what());
-    }
+        remoteRowVector,
+        remoteRowVector->size(),
+        *context.pool(),
+        serde_.get());
+    return request;
+  }
 
+  VectorPtr readResult(
+      const remote::RemoteFunctionResponse& remoteResponse,
+      const TypePtr& outputType,
+      exec::EvalCtx& context) const {
     auto outputRowVector = IOBufToRowVector(
         remoteResponse.get_result().get_payload(),
         ROW({outputType}),
         *context.pool(),
         serde_.get());
-    result = outputRowVector->childAt(0);
+    return outputRowVector->childAt(0);
+  }
+
+  [[noreturn]] void throwRemoteError(const std::string& error) const {
+    VELOX_FAIL(
+        "Error while executing remote function '{}' at '{}': {}",
+        functionName_,
+        location_.describe(),
+        error);
   }
 
   const std::string functionName_;
   folly::SocketAddress location_;
 
-  folly::EventBase eventBase_;
+  // Driven by the calling thread while waiting for concurrent requests.
+  mutable folly::EventBase eventBase_;
   std::unique_ptr<RemoteFunctionClient> thriftClient_;
+  // Used instead of 'thriftClient_' for a server on the same host.
+  std::unique_ptr<SharedMemoryClient> sharedMemoryClient_;
   remote::PageFormat serdeFormat_;
   std::unique_ptr<VectorSerde> serde_;
+  const vector_size_t maxRowsPerRequest_;
+  const size_t maxConcurrentRequests_;
+  const int64_t maxRequestBytes_;
+  const bool deterministic_;
+  const vector_size_t resultCacheRows_;
+  const std::string latencyStat_;
+  const std::string numRequestsStat_;
+  const std::string cacheHitsStat_;
+
+  // Arguments and results of up to 'resultCacheRows_' rows. Created on first
+  // use.
+  mutable std::vector<VectorPtr> cachedArgs_;
+  mutable VectorPtr cachedResults_;
+  mutable vector_size_t numCachedRows_{0};
+  // Maps the hash of the arguments of a cached row to its row in
+  // 'cachedArgs_'.
+  mutable std::unordered_multimap<uint64_t, vector_size_t> cacheIndex_;
 
   // Structures we construct once to cache:
   RowTypePtr remoteInputType_;
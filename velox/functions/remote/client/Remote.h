@@ -30,11 +30,50 @@ struct RemoteVectorFunctionMetadata : public exec::VectorFunctionMetadata {
 
   /// The serialization format to be used
   remote::PageFormat serdeFormat{remote::PageFormat::PRESTO_PAGE};
+
+  /// Max number of rows sent to the server in one request. Larger batches are
+  /// split into several requests that are in flight at the same time. 0 means
+  /// each batch is sent in a single request.
+  vector_size_t maxRowsPerRequest{0};
+
+  /// Max number of requests of one batch that are in flight at the same time.
+  int32_t maxConcurrentRequests{4};
+
+  /// Target size of the serialized arguments of one request. Batches with a
+  /// larger estimated size are split into several requests like with
+  /// 'maxRowsPerRequest'. 0 means no limit.
+  int64_t maxRequestBytes{0};
+
+  /// Whether the function returns the same result for the same arguments.
+  /// Only deterministic functions cache results.
+  bool deterministic{true};
+
+  /// Max number of distinct argument rows whose results are kept by each
+  /// instance of the function. Rows found in the cache and rows repeating
+  /// another row of the same batch are not sent to the server. 0 disables the
+  /// cache.
+  vector_size_t resultCacheRows{0};
+
+  /// If set, requests go to a SharedMemoryServer on the same host over the
+  /// shared memory channels '<sharedMemoryName>.<i>' instead of to
+  /// 'location'. Each instance of the function holds one channel, so there
+  /// must be at least as many channels as Drivers evaluating the function.
+  /// Requests of a batch are sent one after the other.
+  std::string sharedMemoryName;
+  int32_t sharedMemoryChannels{8};
+
+  /// Max wait for a response over shared memory.
+  int64_t sharedMemoryTimeoutMs{60'000};
 };
 
 /// Registers a new remote function. It will use the meatadata defined in
 /// `RemoteVectorFunctionMetadata` to control the serialization format and
 /// remote server address.
+///
+/// The time spent waiting for the server, the number of requests and the
+/// number of cache hits are reported as runtime stats of the calling Operator
+/// under 'remote.<name>.latencyNanos', 'remote.<name>.numRequests' and
+/// 'remote.<name>.cacheHits'.
 //
 /// Remote functions are registered as regular statufull functions (using the
 /// same internal catalog), and hence conflict if there already exists a
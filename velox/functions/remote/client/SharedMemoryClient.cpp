@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/remote/client/SharedMemoryClient.h"
+
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::functions {
+
+using Serializer = apache::thrift::CompactSerializer;
+
+SharedMemoryClient::SharedMemoryClient(
+    const std::string& name,
+    int32_t numChannels,
+    std::chrono::microseconds timeout)
+    : timeout_(timeout),
+      channel_(SharedMemoryChannel::claim(name, numChannels)) {}
+
+remote::RemoteFunctionResponse SharedMemoryClient::invokeFunction(
+    const remote::RemoteFunctionRequest& request) {
+  VELOX_CHECK_NOT_NULL(
+      channel_, "Shared memory channel is unusable after a timeout");
+  message_.clear();
+  Serializer::serialize(request, &message_);
+  channel_->writeMessage(message_);
+  if (!channel_->readMessage(message_, timeout_)) {
+    channel_.reset();
+    VELOX_FAIL("No response on shared memory channel");
+  }
+  VELOX_CHECK(!message_.empty());
+  if (message_[0] == SharedMemoryChannel::kResponseError) {
+    throw std::runtime_error(message_.substr(1));
+  }
+  return Serializer::deserialize<remote::RemoteFunctionResponse>(
+      folly::StringPiece(message_).subpiece(1));
+}
+
+} // namespace facebook::velox::functions
@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "velox/functions/remote/if/SharedMemoryChannel.h"
+#include "velox/functions/remote/if/gen-cpp2/RemoteFunction_types.h"
+
+namespace facebook::velox::functions {
+
+/// Sends remote function requests to a SharedMemoryServer on the same host.
+/// Holds one of the server's channels from construction to destruction.
+class SharedMemoryClient {
+ public:
+  SharedMemoryClient(
+      const std::string& name,
+      int32_t numChannels,
+      std::chrono::microseconds timeout);
+
+  /// Sends 'request' and waits for the response. Throws if the server
+  /// returns an error or does not respond within the timeout.
+  remote::RemoteFunctionResponse invokeFunction(
+      const remote::RemoteFunctionRequest& request);
+
+ private:
+  const std::chrono::microseconds timeout_;
+  std::unique_ptr<SharedMemoryChannel> channel_;
+  // Reused between requests.
+  std::string message_;
+};
+
+} // namespace facebook::velox::functions
@@ -30,6 +30,7 @@
 #include "velox/functions/remote/client/Remote.h"
 #include "velox/functions/remote/if/gen-cpp2/RemoteFunctionService.h"
 #include "velox/functions/remote/server/RemoteFunctionService.h"
+#include "velox/functions/remote/server/SharedMemoryServer.h"
 
 using ::apache::thrift::ThriftServer;
 using ::facebook::velox::test::assertEqualVectors;
@@ -62,6 +63,27 @@ class RemoteFunctionTest
                                .build()};
     registerRemoteFunction("remote_plus", plusSignatures, metadata);
 
+    RemoteVectorFunctionMetadata splitMetadata = metadata;
+    splitMetadata.maxRowsPerRequest = 3;
+    splitMetadata.maxConcurrentRequests = 2;
+    registerRemoteFunction("remote_plus_split", plusSignatures, splitMetadata);
+
+    RemoteVectorFunctionMetadata bytesMetadata = metadata;
+    bytesMetadata.maxRequestBytes = 40;
+    registerRemoteFunction("remote_plus_bytes", plusSignatures, bytesMetadata);
+
+    RemoteVectorFunctionMetadata cachedMetadata = metadata;
+    cachedMetadata.resultCacheRows = 4;
+    registerRemoteFunction(
+        "remote_plus_cached", plusSignatures, cachedMetadata);
+
+    RemoteVectorFunctionMetadata sharedMemoryMetadata = metadata;
+    sharedMemoryMetadata.sharedMemoryName = sharedMemoryName_;
+    sharedMemoryMetadata.sharedMemoryChannels = 2;
+    sharedMemoryMetadata.maxRowsPerRequest = 3;
+    registerRemoteFunction(
+        "remote_plus_shm", plusSignatures, sharedMemoryMetadata);
+
     RemoteVectorFunctionMetadata wrongMetadata = metadata;
     wrongMetadata.location = folly::SocketAddress(); // empty address.
     registerRemoteFunction("remote_wrong_port", plusSignatures, wrongMetadata);
@@ -84,6 +106,14 @@ class RemoteFunctionTest
     // needed for tests since the thrift service runs in the same process.
     registerFunction<PlusFunction, int64_t, int64_t, int64_t>(
         {remotePrefix_ + ".remote_plus"});
+    registerFunction<PlusFunction, int64_t, int64_t, int64_t>(
+        {remotePrefix_ + ".remote_plus_split"});
+    registerFunction<PlusFunction, int64_t, int64_t, int64_t>(
+        {remotePrefix_ + ".remote_plus_bytes"});
+    registerFunction<PlusFunction, int64_t, int64_t, int64_t>(
+        {remotePrefix_ + ".remote_plus_cached"});
+    registerFunction<PlusFunction, int64_t, int64_t, int64_t>(
+        {remotePrefix_ + ".remote_plus_shm"});
     registerFunction<CheckedDivideFunction, double, double, double>(
         {remotePrefix_ + ".remote_divide"});
     registerFunction<SubstrFunction, Varchar, Varchar, int32_t>(
@@ -100,9 +130,14 @@ class RemoteFunctionTest
     thread_ = std::make_unique<std::thread>([&] { server_->serve(); });
     VELOX_CHECK(waitForRunning(), "Unable to initialize thrift server.");
     LOG(INFO) << "Thrift server is up and running in local port " << location_;
+
+    sharedMemoryServer_ =
+        std::make_unique<SharedMemoryServer>(handler, sharedMemoryName_, 2);
+    sharedMemoryServer_->start();
   }
 
   ~RemoteFunctionTest() {
+    sharedMemoryServer_->stop();
     server_->stop();
     thread_->join();
     LOG(INFO) << "Thrift server stopped.";
@@ -122,6 +157,7 @@ class RemoteFunctionTest
 
   std::shared_ptr<apache::thrift::ThriftServer> server_;
   std::unique_ptr<std::thread> thread_;
+  std::unique_ptr<SharedMemoryServer> sharedMemoryServer_;
 
   // Creates a random temporary file name to use to communicate as a unix domain
   // socket.
@@ -129,6 +165,9 @@ class RemoteFunctionTest
       folly::SocketAddress::makeFromPath(std::tmpnam(nullptr))};
 
   const std::string remotePrefix_{"remote"};
+
+  const std::string sharedMemoryName_{
+      fmt::format("/velox_remote_function_test.{}", getpid())};
 };
 
 TEST_P(RemoteFunctionTest, simple) {
@@ -140,6 +179,75 @@ TEST_P(RemoteFunctionTest, simple) {
   assertEqualVectors(expected, results);
 }
 
+TEST_P(RemoteFunctionTest, splitRequests) {
+  // 10 rows are sent as 4 requests of at most 3 rows, 2 at a time.
+  auto inputVector = makeFlatVector<int64_t>(10, [](auto row) { return row; });
+  auto results = evaluate<SimpleVector<int64_t>>(
+      "remote_plus_split(c0, c0)", makeRowVector({inputVector}));
+
+  auto expected = makeFlatVector<int64_t>(10, [](auto row) { return row * 2; });
+  assertEqualVectors(expected, results);
+}
+
+TEST_P(RemoteFunctionTest, requestBytes) {
+  // Two bigint arguments are about 16 bytes per row, so each request has 2
+  // rows.
+  auto inputVector = makeFlatVector<int64_t>(10, [](auto row) { return row; });
+  auto results = evaluate<SimpleVector<int64_t>>(
+      "remote_plus_bytes(c0, c0)", makeRowVector({inputVector}));
+
+  auto expected = makeFlatVector<int64_t>(10, [](auto row) { return row * 2; });
+  assertEqualVectors(expected, results);
+}
+
+TEST_P(RemoteFunctionTest, resultCache) {
+  // Repeated rows, nulls and more distinct rows than fit in the cache.
+  auto inputVector = makeNullableFlatVector<int64_t>(
+      {1, 2, 1, std::nullopt, 3, 2, 1, 4, 5, 6, 1, 7, 7});
+  auto expected = makeNullableFlatVector<int64_t>(
+      {2, 4, 2, std::nullopt, 6, 4, 2, 8, 10, 12, 2, 14, 14});
+  auto data = makeRowVector({inputVector});
+  auto exprSet =
+      compileExpression("remote_plus_cached(c0, c0)", asRowType(data->type()));
+  for (auto i = 0; i < 3; ++i) {
+    assertEqualVectors(expected, evaluate(*exprSet, data));
+  }
+
+  // A dictionary over rows that are partly in the cache.
+  auto indices = makeIndices({7, 7, 0, 3, 12});
+  auto dictionary = makeRowVector(
+      {BaseVector::wrapInDictionary(nullptr, indices, 5, inputVector)});
+  assertEqualVectors(
+      makeNullableFlatVector<int64_t>({8, 8, 2, std::nullopt, 14}),
+      evaluate(*exprSet, dictionary));
+}
+
+TEST_P(RemoteFunctionTest, sharedMemory) {
+  // 10 rows are sent as 4 requests of at most 3 rows over one channel.
+  auto inputVector = makeFlatVector<int64_t>(10, [](auto row) { return row; });
+  auto data = makeRowVector({inputVector});
+  auto expected = makeFlatVector<int64_t>(10, [](auto row) { return row * 2; });
+  assertEqualVectors(
+      expected,
+      evaluate<SimpleVector<int64_t>>("remote_plus_shm(c0, c0)", data));
+
+  // Each expression holds a channel while it exists. A third one finds no
+  // free channel.
+  auto first =
+      compileExpression("remote_plus_shm(c0, c0)", asRowType(data->type()));
+  auto second =
+      compileExpression("remote_plus_shm(c0, c0)", asRowType(data->type()));
+  assertEqualVectors(expected, evaluate(*first, data));
+  assertEqualVectors(expected, evaluate(*second, data));
+  VELOX_ASSERT_THROW(
+      compileExpression("remote_plus_shm(c0, c0)", asRowType(data->type())),
+      "No free shared memory channel");
+  first.reset();
+  assertEqualVectors(
+      expected,
+      evaluate<SimpleVector<int64_t>>("remote_plus_shm(c0, c0)", data));
+}
+
 TEST_P(RemoteFunctionTest, string) {
   auto inputVector =
       makeFlatVector<StringView>({"hello", "my", "remote", "world"});
@@ -173,7 +281,8 @@ VELOX_INSTANTIATE_TEST_SUITE_P(
     RemoteFunctionTest,
     ::testing::Values(
         remote::PageFormat::PRESTO_PAGE,
-        remote::PageFormat::SPARK_UNSAFE_ROW));
+        remote::PageFormat::SPARK_UNSAFE_ROW,
+        remote::PageFormat::ARROW));
 
 } // namespace
 } // namespace facebook::velox::functions
@@ -25,6 +25,9 @@ typedef binary (cpp2.type = "folly::IOBuf") IOBuf
 enum PageFormat {
   PRESTO_PAGE = 1,
   SPARK_UNSAFE_ROW = 2,
+  /// Arrow columnar buffers, see ArrowVectorSerde. Avoids per-value encoding
+  /// for flat and dictionary encoded columns.
+  ARROW = 3,
 }
 
 /// Identifies the remote function being called.
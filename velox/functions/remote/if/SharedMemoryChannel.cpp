@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/remote/if/SharedMemoryChannel.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cstring>
+#include <thread>
+
+#include <fmt/format.h>
+#include <folly/String.h>
+#include <folly/portability/Asm.h>
+#include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Exceptions.h"
+
+namespace facebook::velox::functions {
+
+namespace {
+
+constexpr uint64_t kMagic = 0x5645'4c4f'5853'484d; // "VELOXSHM"
+
+// Spins before backing off to sleeps when waiting on the other side.
+constexpr int32_t kSpins = 20'000;
+constexpr std::chrono::microseconds kBackoff{20};
+
+// Returns true when 'ready' returns true, false after 'timeout'. A timeout of
+// microseconds::max() waits indefinitely.
+template <typename Ready>
+bool waitFor(Ready ready, std::chrono::microseconds timeout) {
+  for (auto i = 0; i < kSpins; ++i) {
+    if (ready()) {
+      return true;
+    }
+    folly::asm_volatile_pause();
+  }
+  const bool hasDeadline = timeout != std::chrono::microseconds::max();
+  const auto deadline =
+      hasDeadline ? std::chrono::steady_clock::now() + timeout
+                  : std::chrono::steady_clock::time_point::max();
+  while (!ready()) {
+    if (hasDeadline && std::chrono::steady_clock::now() >= deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(kBackoff);
+  }
+  return true;
+}
+
+std::string segmentPath(const std::string& name, int32_t index) {
+  return fmt::format("{}.{}", name, index);
+}
+
+} // namespace
+
+struct SharedMemoryChannel::Ring {
+  // Total bytes written and read. The readable bytes are the difference and
+  // the positions in the data are these modulo the capacity.
+  alignas(64) std::atomic<uint64_t> writeOffset{0};
+  alignas(64) std::atomic<uint64_t> readOffset{0};
+  // Offset of the data of the ring from the start of the segment.
+  uint64_t dataOffset{0};
+};
+
+struct SharedMemoryChannel::Header {
+  uint64_t magic{kMagic};
+  uint64_t capacity{0};
+  std::atomic<uint32_t> inUse{0};
+  std::atomic<bool> closed{false};
+  Ring requests;
+  Ring responses;
+};
+
+// static
+std::unique_ptr<SharedMemoryChannel> SharedMemoryChannel::create(
+    const std::string& name,
+    int32_t index,
+    uint64_t capacity) {
+  capacity = bits::nextPowerOfTwo(capacity);
+  const auto path = segmentPath(name, index);
+  const auto headerSize = bits::roundUp(sizeof(Header), 64);
+  const auto mappedSize = headerSize + 2 * capacity;
+  ::shm_unlink(path.c_str());
+  const auto fd = ::shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+  VELOX_CHECK_GE(
+      fd,
+      0,
+      "Cannot create shared memory {}: {}",
+      path,
+      folly::errnoStr(errno));
+  if (::ftruncate(fd, mappedSize) != 0) {
+    const auto error = errno;
+    ::close(fd);
+    ::shm_unlink(path.c_str());
+    VELOX_FAIL(
+        "Cannot size shared memory {}: {}", path, folly::errnoStr(error));
+  }
+  auto* memory =
+      ::mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (memory == MAP_FAILED) {
+    ::shm_unlink(path.c_str());
+    VELOX_FAIL("Cannot map shared memory {}: {}", path, folly::errnoStr(errno));
+  }
+  auto* header = new (memory) Header();
+  header->capacity = capacity;
+  header->requests.dataOffset = headerSize;
+  header->responses.dataOffset = headerSize + capacity;
+  return std::unique_ptr<SharedMemoryChannel>(
+      new SharedMemoryChannel(path, memory, mappedSize, true));
+}
+
+// static
+std::unique_ptr<SharedMemoryChannel> SharedMemoryChannel::claim(
+    const std::string& name,
+    int32_t numChannels) {
+  for (auto i = 0; i < numChannels; ++i) {
+    const auto path = segmentPath(name, i);
+    const auto fd = ::shm_open(path.c_str(), O_RDWR, 0600);
+    if (fd < 0) {
+      continue;
+    }
+    struct stat stats;
+    if (::fstat(fd, &stats) != 0 ||
+        stats.st_size < static_cast<off_t>(sizeof(Header))) {
+      ::close(fd);
+      continue;
+    }
+    const uint64_t mappedSize = stats.st_size;
+    auto* memory =
+        ::mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (memory == MAP_FAILED) {
+      continue;
+    }
+    auto* header = reinterpret_cast<Header*>(memory);
+    uint32_t expected = 0;
+    if (header->magic == kMagic && !header->closed &&
+        header->inUse.compare_exchange_strong(expected, 1)) {
+      return std::unique_ptr<SharedMemoryChannel>(
+          new SharedMemoryChannel(path, memory, mappedSize, false));
+    }
+    ::munmap(memory, mappedSize);
+  }
+  VELOX_FAIL(
+      "No free shared memory channel among {} channels named {}",
+      numChannels,
+      name);
+}
+
+SharedMemoryChannel::SharedMemoryChannel(
+    std::string path,
+    void* memory,
+    uint64_t mappedSize,
+    bool isServer)
+    : path_(std::move(path)),
+      memory_(memory),
+      mappedSize_(mappedSize),
+      isServer_(isServer),
+      header_(reinterpret_cast<Header*>(memory)) {}
+
+SharedMemoryChannel::~SharedMemoryChannel() {
+  if (isServer_) {
+    close();
+    ::munmap(memory_, mappedSize_);
+    ::shm_unlink(path_.c_str());
+    return;
+  }
+  if (!broken_) {
+    header_->inUse = 0;
+  }
+  ::munmap(memory_, mappedSize_);
+}
+
+SharedMemoryChannel::Ring& SharedMemoryChannel::writeRing() {
+  return isServer_ ? header_->responses : header_->requests;
+}
+
+SharedMemoryChannel::Ring& SharedMemoryChannel::readRing() {
+  return isServer_ ? header_->requests : header_->responses;
+}
+
+char* SharedMemoryChannel::ringData(const Ring& ring) {
+  return reinterpret_cast<char*>(memory_) + ring.dataOffset;
+}
+
+void SharedMemoryChannel::write(const void* data, uint64_t size) {
+  auto& ring = writeRing();
+  auto* ringBytes = ringData(ring);
+  const auto capacity = header_->capacity;
+  auto* bytes = reinterpret_cast<const char*>(data);
+  while (size > 0) {
+    const auto offset = ring.writeOffset.load(std::memory_order_relaxed);
+    uint64_t space = 0;
+    waitFor(
+        [&]() {
+          space = capacity -
+              (offset - ring.readOffset.load(std::memory_order_acquire));
+          return space > 0 || header_->closed;
+        },
+        std::chrono::microseconds::max());
+    VELOX_CHECK(!header_->closed, "Shared memory channel {} is closed", path_);
+    const auto numBytes = std::min(size, space);
+    const auto position = offset & (capacity - 1);
+    const auto firstBytes = std::min(numBytes, capacity - position);
+    ::memcpy(ringBytes + position, bytes, firstBytes);
+    ::memcpy(ringBytes, bytes + firstBytes, numBytes - firstBytes);
+    ring.writeOffset.store(offset + numBytes, std::memory_order_release);
+    bytes += numBytes;
+    size -= numBytes;
+  }
+}
+
+bool SharedMemoryChannel::read(
+    void* data,
+    uint64_t size,
+    std::chrono::microseconds timeout) {
+  auto& ring = readRing();
+  auto* ringBytes = ringData(ring);
+  const auto capacity = header_->capacity;
+  auto* bytes = reinterpret_cast<char*>(data);
+  bool started = false;
+  while (size > 0) {
+    const auto offset = ring.readOffset.load(std::memory_order_relaxed);
+    uint64_t available = 0;
+    const bool ready = waitFor(
+        [&]() {
+          available =
+              ring.writeOffset.load(std::memory_order_acquire) - offset;
+          return available > 0 || header_->closed;
+        },
+        timeout);
+    if (!ready || available == 0) {
+      broken_ |= started || !isServer_;
+      return false;
+    }
+    const auto numBytes = std::min(size, available);
+    const auto position = offset & (capacity - 1);
+    const auto firstBytes = std::min(numBytes, capacity - position);
+    ::memcpy(bytes, ringBytes + position, firstBytes);
+    ::memcpy(bytes + firstBytes, ringBytes, numBytes - firstBytes);
+    ring.readOffset.store(offset + numBytes, std::memory_order_release);
+    bytes += numBytes;
+    size -= numBytes;
+    started = true;
+  }
+  return true;
+}
+
+bool SharedMemoryChannel::waitForData(std::chrono::microseconds timeout) {
+  auto& ring = readRing();
+  return waitFor(
+             [&]() {
+               return ring.writeOffset.load(std::memory_order_acquire) !=
+                   ring.readOffset.load(std::memory_order_relaxed) ||
+                   header_->closed;
+             },
+             timeout) &&
+      !header_->closed;
+}
+
+void SharedMemoryChannel::writeMessage(const std::string& message) {
+  const uint64_t size = message.size();
+  write(&size, sizeof(size));
+  write(message.data(), size);
+}
+
+bool SharedMemoryChannel::readMessage(
+    std::string& message,
+    std::chrono::microseconds timeout) {
+  uint64_t size;
+  if (!read(&size, sizeof(size), timeout)) {
+    return false;
+  }
+  message.resize(size);
+  return read(message.data(), size, timeout);
+}
+
+void SharedMemoryChannel::close() {
+  header_->closed = true;
+}
+
+} // namespace facebook::velox::functions
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace facebook::velox::functions {
+
+/// Bidirectional byte stream between a remote function client and a server
+/// on the same host, over a POSIX shared memory segment. The segment holds
+/// two single producer, single consumer ring buffers, one for requests and
+/// one for responses. Writers and readers spin on the ring offsets and back
+/// off to short sleeps when idle, so a round trip takes a few microseconds
+/// and no system call when both sides are busy.
+///
+/// A server creates 'numChannels' segments named '<name>.<i>'. A client
+/// claims the first segment that is not in use and releases it when
+/// destroyed.
+class SharedMemoryChannel {
+ public:
+  /// Creates the segment '<name>.<index>' with rings of 'capacity' bytes,
+  /// which is rounded up to a power of 2. Replaces an existing segment of the
+  /// same name. The segment is removed when the returned channel is
+  /// destroyed.
+  static std::unique_ptr<SharedMemoryChannel>
+  create(const std::string& name, int32_t index, uint64_t capacity);
+
+  /// Claims the first unused segment among '<name>.<i>' for i in [0,
+  /// 'numChannels'). Throws if all are in use or none exists.
+  static std::unique_ptr<SharedMemoryChannel> claim(
+      const std::string& name,
+      int32_t numChannels);
+
+  ~SharedMemoryChannel();
+
+  /// Writes 'size' bytes to the request ring if this is a client or to the
+  /// response ring if this is a server. Waits for the reader to free space
+  /// as needed.
+  void write(const void* data, uint64_t size);
+
+  /// Reads 'size' bytes from the response ring if this is a client or from
+  /// the request ring if this is a server. Waits up to 'timeout' for each
+  /// part of the data to arrive and returns false on timeout or if the
+  /// channel is closed. A client channel that timed out in the middle of an
+  /// exchange is not released for reuse, since a late response would be read
+  /// by the next client.
+  bool read(void* data, uint64_t size, std::chrono::microseconds timeout);
+
+  /// Waits up to 'timeout' for data to read. Returns false on timeout or if
+  /// the channel is closed.
+  bool waitForData(std::chrono::microseconds timeout);
+
+  /// Writes 'message' preceded by its size.
+  void writeMessage(const std::string& message);
+
+  /// Reads a message written by writeMessage() into 'message'. Returns false
+  /// on timeout or if the channel is closed.
+  bool readMessage(std::string& message, std::chrono::microseconds timeout);
+
+  /// First byte of a response message from the server, followed by the
+  /// serialized response or by an error message.
+  static constexpr char kResponseOk = 0;
+  static constexpr char kResponseError = 1;
+
+  /// Marks the channel as closed, which makes pending and later reads on
+  /// both sides return false.
+  void close();
+
+  const std::string& path() const {
+    return path_;
+  }
+
+ private:
+  struct Ring;
+  struct Header;
+
+  SharedMemoryChannel(
+      std::string path,
+      void* memory,
+      uint64_t mappedSize,
+      bool isServer);
+
+  Ring& writeRing();
+
+  Ring& readRing();
+
+  char* ringData(const Ring& ring);
+
+  const std::string path_;
+  void* const memory_;
+  const uint64_t mappedSize_;
+  const bool isServer_;
+  Header* const header_;
+  bool broken_{false};
+};
+
+} // namespace facebook::velox::functions
@@ -20,6 +20,7 @@
 #include <thrift/lib/cpp2/server/ThriftServer.h>
 #include "velox/functions/prestosql/registration/RegistrationFunctions.h"
 #include "velox/functions/remote/server/RemoteFunctionService.h"
+#include "velox/functions/remote/server/SharedMemoryServer.h"
 
 /// This file generates a binary only meant for testing. It instantiates a
 /// remote function server able to serve all Presto functions, and is used
@@ -27,13 +28,25 @@
 /// as expected.
 ///
 /// It currently listens on a local unix domain socket controleed by the flag
-/// below.
+/// below, and optionally on shared memory channels for clients on the same
+/// host.
 
 DEFINE_string(
     uds_path,
     "/tmp/remote.socket",
     "Unix domain socket used by the thrift server.");
 
+DEFINE_string(
+    shm_name,
+    "",
+    "If set, also serves clients on the same host over shared memory segments "
+    "named <shm_name>.<i>, e.g. /velox_remote");
+
+DEFINE_int32(
+    shm_channels,
+    8,
+    "Number of shared memory channels, i.e. clients served at the same time");
+
 DEFINE_string(
     function_prefix,
     "json.test_schema.",
@@ -56,6 +69,15 @@ int main(int argc, char* argv[]) {
 
   LOG(INFO) << "Initializing thrift server";
   auto handler = std::make_shared<functions::RemoteFunctionServiceHandler>();
+  std::unique_ptr<functions::SharedMemoryServer> sharedMemoryServer;
+  if (!FLAGS_shm_name.empty()) {
+    LOG(INFO) << "Serving " << FLAGS_shm_channels
+              << " shared memory channels named " << FLAGS_shm_name;
+    sharedMemoryServer = std::make_unique<functions::SharedMemoryServer>(
+        handler, FLAGS_shm_name, FLAGS_shm_channels);
+    sharedMemoryServer->start();
+  }
+
   auto server = std::make_shared<ThriftServer>();
   server->setInterface(handler);
   server->setAddress(location);
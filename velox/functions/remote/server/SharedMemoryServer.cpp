@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/functions/remote/server/SharedMemoryServer.h"
+
+#include <glog/logging.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+namespace facebook::velox::functions {
+namespace {
+
+using Serializer = apache::thrift::CompactSerializer;
+
+// Time between checks for stop() while a channel is idle.
+constexpr std::chrono::microseconds kIdleWait{100'000};
+
+// Max wait for the rest of a request once its first bytes have arrived.
+constexpr std::chrono::microseconds kRequestTimeout{10'000'000};
+
+} // namespace
+
+SharedMemoryServer::SharedMemoryServer(
+    std::shared_ptr<RemoteFunctionServiceHandler> handler,
+    std::string name,
+    int32_t numChannels,
+    uint64_t capacity)
+    : handler_(std::move(handler)),
+      name_(std::move(name)),
+      numChannels_(numChannels),
+      capacity_(capacity) {}
+
+SharedMemoryServer::~SharedMemoryServer() {
+  stop();
+}
+
+void SharedMemoryServer::start() {
+  VELOX_CHECK(channels_.empty(), "SharedMemoryServer is already started");
+  for (auto i = 0; i < numChannels_; ++i) {
+    channels_.push_back(SharedMemoryChannel::create(name_, i, capacity_));
+  }
+  for (auto& channel : channels_) {
+    threads_.emplace_back([this, channel = channel.get()]() {
+      serve(*channel);
+    });
+  }
+}
+
+void SharedMemoryServer::stop() {
+  if (stopped_.exchange(true)) {
+    return;
+  }
+  for (auto& channel : channels_) {
+    channel->close();
+  }
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+  threads_.clear();
+  channels_.clear();
+}
+
+void SharedMemoryServer::serve(SharedMemoryChannel& channel) {
+  std::string message;
+  while (!stopped_) {
+    if (!channel.waitForData(kIdleWait)) {
+      continue;
+    }
+    if (!channel.readMessage(message, kRequestTimeout)) {
+      LOG(ERROR) << "Incomplete request on shared memory channel "
+                 << channel.path() << ", no longer serving it";
+      return;
+    }
+    std::string reply;
+    try {
+      auto request = std::make_unique<remote::RemoteFunctionRequest>(
+          Serializer::deserialize<remote::RemoteFunctionRequest>(message));
+      remote::RemoteFunctionResponse response;
+      handler_->invokeFunction(response, std::move(request));
+      reply.push_back(SharedMemoryChannel::kResponseOk);
+      Serializer::serialize(response, &reply);
+    } catch (const std::exception& e) {
+      reply.clear();
+      reply.push_back(SharedMemoryChannel::kResponseError);
+      reply.append(e.what());
+    }
+    channel.writeMessage(reply);
+  }
+}
+
+} // namespace facebook::velox::functions
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include "velox/functions/remote/if/SharedMemoryChannel.h"
+#include "velox/functions/remote/server/RemoteFunctionService.h"
+
+namespace facebook::velox::functions {
+
+/// Serves remote function requests from clients on the same host over shared
+/// memory channels instead of a socket. Requests and responses are the
+/// Thrift structs of the socket protocol in compact serialization, passed
+/// through the rings of a SharedMemoryChannel. Each channel is served by its
+/// own thread, so up to 'numChannels' clients are served at the same time.
+class SharedMemoryServer {
+ public:
+  SharedMemoryServer(
+      std::shared_ptr<RemoteFunctionServiceHandler> handler,
+      std::string name,
+      int32_t numChannels,
+      uint64_t capacity = 16 << 20);
+
+  ~SharedMemoryServer();
+
+  /// Creates the channels and starts serving them.
+  void start();
+
+  /// Closes the channels and waits for the serving threads to finish.
+  void stop();
+
+ private:
+  void serve(SharedMemoryChannel& channel);
+
+  const std::shared_ptr<RemoteFunctionServiceHandler> handler_;
+  const std::string name_;
+  const int32_t numChannels_;
+  const uint64_t capacity_;
+  std::atomic<bool> stopped_{false};
+  std::vector<std::unique_ptr<SharedMemoryChannel>> channels_;
+  std::vector<std::thread> threads_;
+};
+
+} // namespace facebook::velox::functions
@@ -18,6 +18,7 @@
 #include <folly/CPortability.h>
 
 #include "velox/common/base/BitUtil.h"
+#include "velox/common/base/Portability.h"
 #include "velox/expression/DecodedArgs.h"
 #include "velox/vector/FlatVector.h"
 
@@ -26,6 +27,37 @@ namespace {
 
 const int32_t kDefaultSeed = 42;
 
+// Hashes the values of 'decoded' in 'selected' rows into 'hashes', using the
+// previous hash of each row as seed. Flat columns are read and hashed in a
+// tight loop over the raw values, which the compiler vectorizes for the
+// fixed-width hashes.
+template <typename InputType, typename ReturnType, typename HashFn>
+void hashColumn(
+    const DecodedVector& decoded,
+    const SelectivityVector& selected,
+    ReturnType* hashes,
+    HashFn hashFn) {
+  if constexpr (!std::is_same_v<InputType, bool>) {
+    if (decoded.isIdentityMapping()) {
+      const auto* values = decoded.data<InputType>();
+      if (selected.isAllSelected()) {
+        const vector_size_t numRows = selected.end();
+        for (vector_size_t row = 0; row < numRows; ++row) {
+          hashes[row] = hashFn(values[row], hashes[row]);
+        }
+      } else {
+        selected.applyToSelected([&](auto row) INLINE_LAMBDA {
+          hashes[row] = hashFn(values[row], hashes[row]);
+        });
+      }
+      return;
+    }
+  }
+  selected.applyToSelected([&](auto row) INLINE_LAMBDA {
+    hashes[row] = hashFn(decoded.valueAt<InputType>(row), hashes[row]);
+  });
+}
+
 // ReturnType can be either int32_t or int64_t
 // HashClass contains the function like hashInt32
 template <typename ReturnType, typename HashClass, typename SeedType>
@@ -41,6 +73,7 @@ void applyWithType(
 
   auto& result = *resultRef->as<FlatVector<ReturnType>>();
   rows.applyToSelected([&](int row) { result.set(row, hashSeed); });
+  auto* hashes = result.mutableRawValues();
 
   exec::LocalSelectivityVector selectedMinusNulls(context);
 
@@ -57,12 +90,12 @@ void applyWithType(
     switch (args[i]->type()->kind()) {
 // Derived from InterpretedHashFunction.hash:
 // https://github.com/apache/spark/blob/382b66e/sql/catalyst/src/main/scala/org/apache/spark/sql/catalyst/expressions/hash.scala#L532
-#define CASE(typeEnum, hashFn, inputType)                                      \
-  case TypeKind::typeEnum:                                                     \
-    selected->applyToSelected([&](int row) {                                   \
-      result.set(                                                              \
-          row, hashFn(decoded->valueAt<inputType>(row), result.valueAt(row))); \
-    });                                                                        \
+#define CASE(typeEnum, hashFn, inputType)                           \
+  case TypeKind::typeEnum:                                          \
+    hashColumn<inputType>(                                          \
+        *decoded, *selected, hashes, [&](auto value, auto current) { \
+          return hashFn(value, current);                            \
+        });                                                         \
     break;
       CASE(BOOLEAN, hash.hashInt32, bool);
       CASE(TINYINT, hash.hashInt32, int8_t);
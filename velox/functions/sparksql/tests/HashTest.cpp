@@ -128,5 +128,34 @@ TEST_F(HashTest, Float) {
   EXPECT_EQ(hash<float>(-limits::infinity()), 427440766);
 }
 
+TEST_F(HashTest, columns) {
+  constexpr vector_size_t kSize = 1'000;
+  auto ints = makeFlatVector<int32_t>(
+      kSize, [](auto row) { return row * 7; }, nullEvery(5));
+  auto bigints = wrapInDictionary(
+      makeIndicesInReverse(kSize),
+      makeFlatVector<int64_t>(kSize, [](auto row) { return row * 11; }));
+  auto strings = makeFlatVector<std::string>(kSize, [](auto row) {
+    return std::string(row % 40, 'a' + row % 26);
+  });
+  auto data = makeRowVector({ints, bigints, strings});
+
+  std::vector<int32_t> expected;
+  expected.reserve(kSize);
+  for (auto row = 0; row < kSize; ++row) {
+    expected.push_back(
+        evaluateOnce<int32_t>(
+            "hash(c0, c1, c2)",
+            ints->isNullAt(row) ? std::nullopt
+                                : std::optional(ints->valueAt(row)),
+            std::optional((kSize - 1 - row) * 11L),
+            std::optional(strings->valueAt(row).str()))
+            .value());
+  }
+
+  auto result = evaluate<SimpleVector<int32_t>>("hash(c0, c1, c2)", data);
+  assertEqualVectors(makeFlatVector<int32_t>(expected), result);
+}
+
 } // namespace
 } // namespace facebook::velox::functions::sparksql::test
@@ -420,6 +420,62 @@ int32_t CompactRow::serialize(vector_size_t index, char* buffer) {
   return serializeRow(index, buffer);
 }
 
+void CompactRow::rowSizes(
+    folly::Range<const vector_size_t*> rows,
+    int32_t* sizes) {
+  int32_t fixedSize = rowNullBytes_;
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      fixedSize += children_[i].valueBytes_;
+    }
+  }
+  std::fill(sizes, sizes + rows.size(), fixedSize);
+
+  for (auto i = 0; i < children_.size(); ++i) {
+    if (childIsFixedWidth_[i]) {
+      continue;
+    }
+    auto& child = children_[i];
+    for (auto row = 0; row < rows.size(); ++row) {
+      const auto childIndex = decoded_.index(rows[row]);
+      if (!child.isNullAt(childIndex)) {
+        sizes[row] += child.variableWidthRowSize(childIndex);
+      }
+    }
+  }
+}
+
+void CompactRow::serialize(
+    folly::Range<const vector_size_t*> rows,
+    char* const* buffers) {
+  const auto numRows = rows.size();
+  std::vector<vector_size_t> childIndices(numRows);
+  for (auto row = 0; row < numRows; ++row) {
+    childIndices[row] = decoded_.index(rows[row]);
+  }
+  std::vector<int32_t> valuesOffsets(numRows, rowNullBytes_);
+
+  for (auto i = 0; i < children_.size(); ++i) {
+    auto& child = children_[i];
+    if (childIsFixedWidth_[i]) {
+      child.serializeFixedWidth(
+          folly::Range<const vector_size_t*>(childIndices.data(), numRows),
+          i,
+          buffers,
+          valuesOffsets.data());
+      continue;
+    }
+    for (auto row = 0; row < numRows; ++row) {
+      if (child.isNullAt(childIndices[row])) {
+        bits::setBit(reinterpret_cast<uint8_t*>(buffers[row]), i, true);
+        continue;
+      }
+      valuesOffsets[row] += child.serializeVariableWidth(
+          childIndices[row], buffers[row] + valuesOffsets[row]);
+    }
+  }
+}
+
 void CompactRow::serializeFixedWidth(vector_size_t index, char* buffer) {
   VELOX_DCHECK(fixedWidthTypeKind_);
   switch (typeKind_) {
@@ -439,6 +495,47 @@ void CompactRow::serializeFixedWidth(vector_size_t index, char* buffer) {
   }
 }
 
+void CompactRow::serializeFixedWidth(
+    folly::Range<const vector_size_t*> indices,
+    int32_t nullIndex,
+    char* const* buffers,
+    int32_t* offsets) {
+  VELOX_DCHECK(fixedWidthTypeKind_);
+  // Dispatches on the type once per column rather than once per value.
+  auto forEachValue = [&](auto writeValue) {
+    for (auto row = 0; row < indices.size(); ++row) {
+      if (isNullAt(indices[row])) {
+        bits::setBit(
+            reinterpret_cast<uint8_t*>(buffers[row]), nullIndex, true);
+      } else if (valueBytes_ > 0) {
+        writeValue(indices[row], buffers[row] + offsets[row]);
+      }
+      offsets[row] += valueBytes_;
+    }
+  };
+
+  switch (typeKind_) {
+    case TypeKind::BOOLEAN:
+      forEachValue([&](vector_size_t index, char* buffer) {
+        *reinterpret_cast<bool*>(buffer) = decoded_.valueAt<bool>(index);
+      });
+      break;
+    case TypeKind::TIMESTAMP:
+      forEachValue([&](vector_size_t index, char* buffer) {
+        auto micros = decoded_.valueAt<Timestamp>(index).toMicros();
+        memcpy(buffer, &micros, sizeof(int64_t));
+      });
+      break;
+    default: {
+      const auto* data = decoded_.data<char>();
+      forEachValue([&](vector_size_t index, char* buffer) {
+        memcpy(
+            buffer, data + decoded_.index(index) * valueBytes_, valueBytes_);
+      });
+    }
+  }
+}
+
 void CompactRow::serializeFixedWidth(
     vector_size_t offset,
     vector_size_t size,
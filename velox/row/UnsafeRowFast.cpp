@@ -155,6 +155,69 @@ int32_t UnsafeRowFast::serialize(vector_size_t index, char* buffer) {
   return serializeRow(index, buffer);
 }
 
+void UnsafeRowFast::rowSizes(
+    folly::Range<const vector_size_t*> rows,
+    int32_t* sizes) {
+  const auto numFields = children_.size();
+  const int32_t fixedSize = rowNullBytes_ + numFields * kFieldWidth;
+  std::fill(sizes, sizes + rows.size(), fixedSize);
+
+  for (auto i = 0; i < numFields; ++i) {
+    if (childIsFixedWidth_[i]) {
+      continue;
+    }
+    auto& child = children_[i];
+    for (auto row = 0; row < rows.size(); ++row) {
+      const auto childIndex = decoded_.index(rows[row]);
+      if (!child.isNullAt(childIndex)) {
+        sizes[row] += alignBytes(child.variableWidthRowSize(childIndex));
+      }
+    }
+  }
+}
+
+void UnsafeRowFast::serialize(
+    folly::Range<const vector_size_t*> rows,
+    char* const* buffers) {
+  const auto numRows = rows.size();
+  std::vector<vector_size_t> childIndices(numRows);
+  for (auto row = 0; row < numRows; ++row) {
+    childIndices[row] = decoded_.index(rows[row]);
+  }
+  std::vector<int64_t> variableWidthOffsets(
+      numRows, rowNullBytes_ + kFieldWidth * children_.size());
+
+  for (auto i = 0; i < children_.size(); ++i) {
+    auto& child = children_[i];
+    // Fixed-width values and variable-width sizes and offsets are at the
+    // same position in every row.
+    const int32_t fieldOffset = rowNullBytes_ + i * kFieldWidth;
+    if (childIsFixedWidth_[i]) {
+      child.serializeFixedWidth(
+          folly::Range<const vector_size_t*>(childIndices.data(), numRows),
+          i,
+          buffers,
+          fieldOffset);
+      continue;
+    }
+    for (auto row = 0; row < numRows; ++row) {
+      auto* buffer = buffers[row];
+      if (child.isNullAt(childIndices[row])) {
+        bits::setBit(buffer, i, true);
+        continue;
+      }
+      auto& variableWidthOffset = variableWidthOffsets[row];
+      auto size = child.serializeVariableWidth(
+          childIndices[row], buffer + variableWidthOffset);
+      // Write size and offset.
+      uint64_t sizeAndOffset = variableWidthOffset << 32 | size;
+      *reinterpret_cast<uint64_t*>(buffer + fieldOffset) = sizeAndOffset;
+
+      variableWidthOffset += alignBytes(size);
+    }
+  }
+}
+
 void UnsafeRowFast::serializeFixedWidth(vector_size_t index, char* buffer) {
   VELOX_DCHECK(fixedWidthTypeKind_);
   switch (typeKind_) {
@@ -173,6 +236,45 @@ void UnsafeRowFast::serializeFixedWidth(vector_size_t index, char* buffer) {
   }
 }
 
+void UnsafeRowFast::serializeFixedWidth(
+    folly::Range<const vector_size_t*> indices,
+    int32_t nullIndex,
+    char* const* buffers,
+    int32_t offset) {
+  VELOX_DCHECK(fixedWidthTypeKind_);
+  // Dispatches on the type once per column rather than once per value.
+  auto forEachValue = [&](auto writeValue) {
+    for (auto row = 0; row < indices.size(); ++row) {
+      if (isNullAt(indices[row])) {
+        bits::setBit(buffers[row], nullIndex, true);
+      } else {
+        writeValue(indices[row], buffers[row] + offset);
+      }
+    }
+  };
+
+  switch (typeKind_) {
+    case TypeKind::BOOLEAN:
+      forEachValue([&](vector_size_t index, char* buffer) {
+        *reinterpret_cast<bool*>(buffer) = decoded_.valueAt<bool>(index);
+      });
+      break;
+    case TypeKind::TIMESTAMP:
+      forEachValue([&](vector_size_t index, char* buffer) {
+        *reinterpret_cast<int64_t*>(buffer) =
+            decoded_.valueAt<Timestamp>(index).toMicros();
+      });
+      break;
+    default: {
+      const auto* data = decoded_.data<char>();
+      forEachValue([&](vector_size_t index, char* buffer) {
+        memcpy(
+            buffer, data + decoded_.index(index) * valueBytes_, valueBytes_);
+      });
+    }
+  }
+}
+
 void UnsafeRowFast::serializeFixedWidth(
     vector_size_t offset,
     vector_size_t size,
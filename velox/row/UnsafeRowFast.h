@@ -15,6 +15,8 @@
  */
 #pragma once
 
+#include <folly/Range.h>
+
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/DecodedVector.h"
 
@@ -36,6 +38,19 @@ class UnsafeRowFast {
   /// 'buffer' must have sufficient capacity and set to all zeros.
   int32_t serialize(vector_size_t index, char* buffer);
 
+  /// Writes the serialized sizes of the rows at 'rows' into 'sizes', which
+  /// must have room for 'rows.size()' entries. Works a column at a time so
+  /// that fixed-width columns are added without per-row dispatch.
+  void rowSizes(folly::Range<const vector_size_t*> rows, int32_t* sizes);
+
+  /// Serializes the rows at 'rows' one column at a time. 'buffers[i]' is the
+  /// destination of 'rows[i]' and must have the capacity returned by
+  /// rowSizes() and be set to all zeros. Produces the same bytes as calling
+  /// serialize() for each row.
+  void serialize(
+      folly::Range<const vector_size_t*> rows,
+      char* const* buffers);
+
  protected:
   explicit UnsafeRowFast(const VectorPtr& vector);
 
@@ -57,6 +72,15 @@ class UnsafeRowFast {
   void
   serializeFixedWidth(vector_size_t offset, vector_size_t size, char* buffer);
 
+  /// Writes the fixed-width values at 'indices' into 'buffers' at 'offset'.
+  /// Sets bit 'nullIndex' in the null flags at the start of 'buffers' for
+  /// null values.
+  void serializeFixedWidth(
+      folly::Range<const vector_size_t*> indices,
+      int32_t nullIndex,
+      char* const* buffers,
+      int32_t offset);
+
   /// Returns serialized size of variable-width row.
   int32_t variableWidthRowSize(vector_size_t index);
 
@@ -16,6 +16,8 @@
 
 #include <gtest/gtest.h>
 
+#include <numeric>
+
 #include "velox/row/CompactRow.h"
 #include "velox/vector/fuzzer/VectorFuzzer.h"
 #include "velox/vector/tests/utils/VectorTestBase.h"
@@ -72,6 +74,25 @@ class CompactRowTest : public ::testing::Test, public VectorTestBase {
 
     VELOX_CHECK_EQ(offset, totalSize);
 
+    // The batched API produces the same bytes.
+    std::vector<vector_size_t> rows(numRows);
+    std::iota(rows.begin(), rows.end(), 0);
+    const folly::Range<const vector_size_t*> rowRange(rows.data(), numRows);
+    std::vector<int32_t> rowSizes(numRows);
+    row.rowSizes(rowRange, rowSizes.data());
+    std::vector<std::string> batchBuffers;
+    std::vector<char*> rowBuffers;
+    for (auto i = 0; i < numRows; ++i) {
+      batchBuffers.emplace_back(rowSizes[i], '\0');
+    }
+    for (auto& batchBuffer : batchBuffers) {
+      rowBuffers.push_back(batchBuffer.data());
+    }
+    row.serialize(rowRange, rowBuffers.data());
+    for (auto i = 0; i < numRows; ++i) {
+      ASSERT_EQ(batchBuffers[i], serialized[i]) << i;
+    }
+
     auto copy = CompactRow::deserialize(serialized, rowType, pool());
     assertEqualVectors(data, copy);
   }
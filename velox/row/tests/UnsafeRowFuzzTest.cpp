@@ -16,6 +16,8 @@
 
 #include <gtest/gtest.h>
 
+#include <numeric>
+
 #include <folly/Random.h>
 #include <folly/init/Init.h>
 
@@ -172,6 +174,25 @@ TEST_F(UnsafeRowFuzzTests, fast) {
 
       serialized.push_back(std::string_view(buffers_[i], rowSize));
     }
+
+    // The batched API produces the same bytes.
+    std::vector<vector_size_t> rows(data->size());
+    std::iota(rows.begin(), rows.end(), 0);
+    const folly::Range<const vector_size_t*> rowRange(rows.data(), rows.size());
+    std::vector<int32_t> rowSizes(rows.size());
+    fast.rowSizes(rowRange, rowSizes.data());
+    std::vector<std::string> batchBuffers;
+    std::vector<char*> rowBuffers;
+    for (auto i = 0; i < rows.size(); ++i) {
+      batchBuffers.emplace_back(rowSizes[i], '\0');
+    }
+    for (auto& batchBuffer : batchBuffers) {
+      rowBuffers.push_back(batchBuffer.data());
+    }
+    fast.serialize(rowRange, rowBuffers.data());
+    for (auto i = 0; i < rows.size(); ++i) {
+      EXPECT_EQ(batchBuffers[i], serialized[i].value()) << i;
+    }
     return serialized;
   });
 }
@@ -0,0 +1,572 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/serializers/ArrowSerializer.h"
+
+#include <deque>
+
+#include "velox/common/base/BitUtil.h"
+#include "velox/serializers/PrestoSerializer.h"
+#include "velox/vector/arrow/Abi.h"
+#include "velox/vector/arrow/Bridge.h"
+
+namespace facebook::velox::serializer {
+
+namespace {
+// The buffers and node headers in the page body start at multiples of this
+// from the start of the body, so that 128 bit values are aligned.
+constexpr int64_t kAlignment = 16;
+
+// numRows(4) | bodySize(8)
+constexpr int64_t kPageHeaderSize = 4 + 8;
+
+// length(8) | nullCount(8) | numBuffers(4) | numChildren(4) |
+// hasDictionary(4) | formatSize(4) | format, padded to kAlignment
+constexpr int64_t kNodeHeaderSize = 8 + 8 + 4 + 4 + 4 + 4;
+
+// size(8) | unused(8) | bytes, padded to kAlignment
+constexpr int64_t kBufferHeaderSize = 16;
+
+// Size written for a buffer that is not present, e.g. the nulls of a vector
+// without nulls.
+constexpr int64_t kAbsentBuffer = -1;
+
+int64_t padded(int64_t size) {
+  return bits::roundUp(size, kAlignment);
+}
+
+void checkSupportedType(const TypePtr& type) {
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::SMALLINT:
+    case TypeKind::INTEGER:
+    case TypeKind::REAL:
+    case TypeKind::DOUBLE:
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+    case TypeKind::HUGEINT:
+      return;
+    case TypeKind::BIGINT:
+      // Short decimals are exported to Arrow as 128 bit values but imported
+      // back as 64 bit values.
+      if (type->isShortDecimal()) {
+        VELOX_UNSUPPORTED(
+            "Type {} is not supported by ArrowVectorSerde", type->toString());
+      }
+      return;
+    case TypeKind::ARRAY:
+    case TypeKind::MAP:
+    case TypeKind::ROW:
+      for (auto i = 0; i < type->size(); ++i) {
+        checkSupportedType(type->childAt(i));
+      }
+      return;
+    default:
+      VELOX_UNSUPPORTED(
+          "Type {} is not supported by ArrowVectorSerde", type->toString());
+  }
+}
+
+// Returns true if 'vector' can be exported to Arrow as is.
+bool canExportDirectly(const BaseVector& vector) {
+  switch (vector.encoding()) {
+    case VectorEncoding::Simple::FLAT:
+      return vector.values() != nullptr;
+    case VectorEncoding::Simple::DICTIONARY:
+      return canExportDirectly(*vector.valueVector());
+    case VectorEncoding::Simple::ROW: {
+      const auto& row = *vector.asUnchecked<RowVector>();
+      for (const auto& child : row.children()) {
+        if (child == nullptr || !canExportDirectly(*child)) {
+          return false;
+        }
+      }
+      return true;
+    }
+    case VectorEncoding::Simple::ARRAY:
+      return canExportDirectly(
+          *vector.asUnchecked<ArrayVector>()->elements());
+    case VectorEncoding::Simple::MAP: {
+      const auto& map = *vector.asUnchecked<MapVector>();
+      return canExportDirectly(*map.mapKeys()) &&
+          canExportDirectly(*map.mapValues());
+    }
+    default:
+      return false;
+  }
+}
+
+// Returns the sizes of the buffers of 'array' as defined by the Arrow columnar
+// format for the type in 'schema'.
+std::vector<int64_t> bufferSizes(
+    const ArrowSchema& schema,
+    const ArrowArray& array) {
+  VELOX_CHECK_EQ(array.offset, 0);
+  std::vector<int64_t> sizes(array.n_buffers, 0);
+  const int64_t length = array.length;
+  if (array.n_buffers > 0 && array.buffers[0] != nullptr) {
+    sizes[0] = bits::nbytes(length);
+  }
+  const char* format = schema.format;
+  switch (format[0]) {
+    case 'b':
+      sizes[1] = bits::nbytes(length);
+      break;
+    case 'c':
+      sizes[1] = length;
+      break;
+    case 's':
+      sizes[1] = length * sizeof(int16_t);
+      break;
+    case 'i':
+      // Also the indices of a dictionary.
+      sizes[1] = length * sizeof(int32_t);
+      break;
+    case 'l':
+      sizes[1] = length * sizeof(int64_t);
+      break;
+    case 'f':
+      sizes[1] = length * sizeof(float);
+      break;
+    case 'g':
+      sizes[1] = length * sizeof(double);
+      break;
+    case 't':
+      VELOX_CHECK_EQ(std::string_view(format), "tdD");
+      sizes[1] = length * sizeof(int32_t);
+      break;
+    case 'd':
+      sizes[1] = length * sizeof(int128_t);
+      break;
+    case 'u':
+    case 'z':
+      sizes[1] = (length + 1) * sizeof(int32_t);
+      sizes[2] = static_cast<const int32_t*>(array.buffers[1])[length];
+      break;
+    case '+':
+      if (format[1] == 'l' || format[1] == 'm') {
+        sizes[1] = (length + 1) * sizeof(int32_t);
+      } else {
+        VELOX_CHECK_EQ(format[1], 's');
+      }
+      break;
+    default:
+      VELOX_NYI("Arrow format {} is not supported", format);
+  }
+  return sizes;
+}
+
+// Returns the serialized size of 'array' and its children and dictionary.
+int64_t nodeSize(const ArrowSchema& schema, const ArrowArray& array) {
+  int64_t size = kNodeHeaderSize + padded(strlen(schema.format));
+  const auto sizes = bufferSizes(schema, array);
+  for (auto i = 0; i < sizes.size(); ++i) {
+    size += kBufferHeaderSize;
+    if (array.buffers[i] != nullptr) {
+      size += padded(sizes[i]);
+    }
+  }
+  for (auto i = 0; i < array.n_children; ++i) {
+    size += nodeSize(*schema.children[i], *array.children[i]);
+  }
+  if (array.dictionary != nullptr) {
+    size += nodeSize(*schema.dictionary, *array.dictionary);
+  }
+  return size;
+}
+
+template <typename T>
+void write(T value, OutputStream* out) {
+  out->write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void writeZeros(int64_t size, OutputStream* out) {
+  static const char kZeros[kAlignment] = {};
+  out->write(kZeros, size);
+}
+
+void writePadded(const void* data, int64_t size, OutputStream* out) {
+  out->write(static_cast<const char*>(data), size);
+  writeZeros(padded(size) - size, out);
+}
+
+void writeBufferHeader(int64_t size, OutputStream* out) {
+  write<int64_t>(size, out);
+  writeZeros(kBufferHeaderSize - sizeof(int64_t), out);
+}
+
+void writeNode(
+    const ArrowSchema& schema,
+    const ArrowArray& array,
+    OutputStream* out) {
+  const int32_t formatSize = strlen(schema.format);
+  write<int64_t>(array.length, out);
+  write<int64_t>(array.null_count, out);
+  write<int32_t>(array.n_buffers, out);
+  write<int32_t>(array.n_children, out);
+  write<int32_t>(array.dictionary != nullptr, out);
+  write<int32_t>(formatSize, out);
+  writePadded(schema.format, formatSize, out);
+  const auto sizes = bufferSizes(schema, array);
+  for (auto i = 0; i < sizes.size(); ++i) {
+    if (array.buffers[i] == nullptr) {
+      writeBufferHeader(kAbsentBuffer, out);
+      continue;
+    }
+    writeBufferHeader(sizes[i], out);
+    writePadded(array.buffers[i], sizes[i], out);
+  }
+  for (auto i = 0; i < array.n_children; ++i) {
+    writeNode(*schema.children[i], *array.children[i], out);
+  }
+  if (array.dictionary != nullptr) {
+    writeNode(*schema.dictionary, *array.dictionary, out);
+  }
+}
+
+class ArrowVectorSerializer : public VectorSerializer {
+ public:
+  ArrowVectorSerializer(RowTypePtr type, StreamArena* streamArena)
+      : type_(std::move(type)), pool_(streamArena->pool()) {
+    checkSupportedType(type_);
+  }
+
+  ~ArrowVectorSerializer() override {
+    releaseExported();
+  }
+
+  void append(
+      const RowVectorPtr& vector,
+      const folly::Range<const IndexRange*>& ranges) override {
+    vector_size_t newRows = 0;
+    for (const auto& range : ranges) {
+      newRows += range.size;
+    }
+    if (newRows == 0) {
+      return;
+    }
+    releaseExported();
+    if (numRows_ == 0 && ranges.size() == 1 && ranges[0].begin == 0 &&
+        ranges[0].size == vector->size() && canExportDirectly(*vector)) {
+      // A whole vector is exported as is, keeping its encodings, unless more
+      // rows are appended.
+      direct_ = vector;
+      numRows_ = newRows;
+      return;
+    }
+    if (data_ == nullptr) {
+      data_ = BaseVector::create<RowVector>(type_, numRows_, pool_);
+      if (direct_ != nullptr) {
+        data_->copy(direct_.get(), 0, 0, numRows_);
+        direct_ = nullptr;
+      }
+    }
+    std::vector<BaseVector::CopyRange> copyRanges;
+    copyRanges.reserve(ranges.size());
+    auto targetIndex = numRows_;
+    for (const auto& range : ranges) {
+      copyRanges.push_back({range.begin, targetIndex, range.size});
+      targetIndex += range.size;
+    }
+    data_->resize(targetIndex);
+    data_->copyRanges(vector.get(), copyRanges);
+    numRows_ = targetIndex;
+  }
+
+  size_t maxSerializedSize() const override {
+    exportData();
+    return kPageHeaderSize + nodeSize(schema_, array_);
+  }
+
+  void flush(OutputStream* out) override {
+    exportData();
+    write<int32_t>(numRows_, out);
+    write<int64_t>(nodeSize(schema_, array_), out);
+    writeNode(schema_, array_, out);
+  }
+
+ private:
+  // Exports the appended rows to 'array_' and 'schema_' if not yet exported.
+  void exportData() const {
+    if (exported_) {
+      return;
+    }
+    VectorPtr data = direct_ != nullptr ? direct_ : data_;
+    if (data == nullptr) {
+      data = BaseVector::create<RowVector>(type_, 0, pool_);
+    }
+    exportToArrow(data, array_, pool_);
+    try {
+      exportToArrow(data, schema_);
+    } catch (const std::exception&) {
+      array_.release(&array_);
+      throw;
+    }
+    exported_ = true;
+  }
+
+  void releaseExported() {
+    if (!exported_) {
+      return;
+    }
+    array_.release(&array_);
+    schema_.release(&schema_);
+    exported_ = false;
+  }
+
+  const RowTypePtr type_;
+  memory::MemoryPool* const pool_;
+  vector_size_t numRows_{0};
+
+  // The appended vector if a single whole vector has been appended. Holds a
+  // reference to the vector, not a copy.
+  RowVectorPtr direct_;
+
+  // The copy of the appended rows otherwise.
+  RowVectorPtr data_;
+
+  // The export of the appended rows. The export is done for
+  // maxSerializedSize() or flush() and references the buffers of 'direct_' or
+  // 'data_'.
+  mutable ArrowArray array_;
+  mutable ArrowSchema schema_;
+  mutable bool exported_{false};
+};
+
+// Owns the buffer holding a received page and the ArrowArray structures over
+// it. Owned by the top level ArrowArray of the page.
+struct ImportedArrays {
+  BufferPtr page;
+  std::deque<ArrowArray> arrays;
+  std::deque<std::vector<const void*>> buffers;
+  std::deque<std::vector<ArrowArray*>> children;
+};
+
+// Owns the ArrowSchema structures of a received page. Owned by the top level
+// ArrowSchema of the page.
+struct ImportedSchemas {
+  std::deque<ArrowSchema> schemas;
+  std::deque<std::vector<ArrowSchema*>> children;
+  std::deque<std::string> strings;
+};
+
+void releaseImportedArrays(ArrowArray* array) {
+  delete static_cast<ImportedArrays*>(array->private_data);
+  array->private_data = nullptr;
+  array->release = nullptr;
+}
+
+void releaseImportedSchemas(ArrowSchema* schema) {
+  delete static_cast<ImportedSchemas*>(schema->private_data);
+  schema->private_data = nullptr;
+  schema->release = nullptr;
+}
+
+// The nested structures are owned by the top level ones.
+void releaseNestedArray(ArrowArray* array) {
+  array->release = nullptr;
+}
+
+void releaseNestedSchema(ArrowSchema* schema) {
+  schema->release = nullptr;
+}
+
+// Reads the nodes of a page body into Arrow structures that reference the
+// buffers in the body.
+class PageReader {
+ public:
+  PageReader(
+      const char* body,
+      int64_t size,
+      ImportedArrays& arrays,
+      ImportedSchemas& schemas)
+      : body_(body), size_(size), arrays_(arrays), schemas_(schemas) {}
+
+  // Reads a node of 'type' into 'array' and 'schema'.
+  void readNode(
+      const TypePtr& type,
+      const std::string& name,
+      ArrowArray& array,
+      ArrowSchema& schema) {
+    array.length = read<int64_t>();
+    array.null_count = read<int64_t>();
+    array.offset = 0;
+    array.n_buffers = read<int32_t>();
+    array.n_children = read<int32_t>();
+    const bool hasDictionary = read<int32_t>() != 0;
+    const auto formatSize = read<int32_t>();
+    VELOX_CHECK_GE(array.length, 0);
+    VELOX_CHECK_GE(array.n_buffers, 0);
+
+    schema.format = schemas_.strings.emplace_back(next(formatSize), formatSize)
+                        .c_str();
+    schema.name = schemas_.strings.emplace_back(name).c_str();
+    schema.metadata = nullptr;
+    schema.flags = ARROW_FLAG_NULLABLE;
+    schema.dictionary = nullptr;
+    schema.private_data = nullptr;
+    schema.release = releaseNestedSchema;
+
+    auto& buffers = arrays_.buffers.emplace_back(array.n_buffers);
+    for (auto i = 0; i < array.n_buffers; ++i) {
+      const auto size = read<int64_t>();
+      next(kBufferHeaderSize - sizeof(int64_t), false);
+      if (size == kAbsentBuffer) {
+        buffers[i] = nullptr;
+        continue;
+      }
+      VELOX_CHECK_GE(size, 0);
+      buffers[i] = next(size);
+    }
+    array.buffers = buffers.data();
+    array.dictionary = nullptr;
+    array.private_data = nullptr;
+    array.release = releaseNestedArray;
+
+    std::vector<std::pair<TypePtr, std::string>> childTypes;
+    if (!hasDictionary) {
+      switch (type->kind()) {
+        case TypeKind::ROW: {
+          const auto& rowType = type->asRow();
+          for (auto i = 0; i < rowType.size(); ++i) {
+            childTypes.emplace_back(rowType.childAt(i), rowType.nameOf(i));
+          }
+          break;
+        }
+        case TypeKind::ARRAY:
+          childTypes.emplace_back(type->childAt(0), "item");
+          break;
+        case TypeKind::MAP:
+          // Arrow wraps the keys and values in a struct.
+          childTypes.emplace_back(
+              ROW({"key", "value"}, {type->childAt(0), type->childAt(1)}),
+              "entries");
+          break;
+        default:
+          break;
+      }
+    }
+    VELOX_CHECK_EQ(
+        array.n_children,
+        childTypes.size(),
+        "Unexpected number of children for type {}",
+        type->toString());
+    auto& childArrays = arrays_.children.emplace_back(array.n_children);
+    auto& childSchemas = schemas_.children.emplace_back(array.n_children);
+    for (auto i = 0; i < array.n_children; ++i) {
+      childArrays[i] = &arrays_.arrays.emplace_back();
+      childSchemas[i] = &schemas_.schemas.emplace_back();
+      readNode(
+          childTypes[i].first,
+          childTypes[i].second,
+          *childArrays[i],
+          *childSchemas[i]);
+    }
+    array.children = childArrays.data();
+    schema.n_children = array.n_children;
+    schema.children = childSchemas.data();
+
+    if (hasDictionary) {
+      array.dictionary = &arrays_.arrays.emplace_back();
+      schema.dictionary = &schemas_.schemas.emplace_back();
+      readNode(type, "", *array.dictionary, *schema.dictionary);
+    }
+  }
+
+  bool atEnd() const {
+    return offset_ == size_;
+  }
+
+ private:
+  template <typename T>
+  T read() {
+    T value;
+    memcpy(&value, next(sizeof(T), false), sizeof(T));
+    return value;
+  }
+
+  // Returns the next 'size' bytes and skips them and their padding if
+  // 'isPadded' is true.
+  const char* next(int64_t size, bool isPadded = true) {
+    const auto totalSize = isPadded ? padded(size) : size;
+    VELOX_CHECK_LE(offset_ + totalSize, size_, "Truncated Arrow page");
+    const char* data = body_ + offset_;
+    offset_ += totalSize;
+    return data;
+  }
+
+  const char* const body_;
+  const int64_t size_;
+  ImportedArrays& arrays_;
+  ImportedSchemas& schemas_;
+  int64_t offset_{0};
+};
+} // namespace
+
+void ArrowVectorSerde::estimateSerializedSize(
+    VectorPtr vector,
+    const folly::Range<const IndexRange*>& ranges,
+    vector_size_t** sizes) {
+  static presto::PrestoVectorSerde prestoSerde;
+  prestoSerde.estimateSerializedSize(std::move(vector), ranges, sizes);
+}
+
+std::unique_ptr<VectorSerializer> ArrowVectorSerde::createSerializer(
+    RowTypePtr type,
+    int32_t /* numRows */,
+    StreamArena* streamArena,
+    const Options* /* options */) {
+  return std::make_unique<ArrowVectorSerializer>(std::move(type), streamArena);
+}
+
+void ArrowVectorSerde::deserialize(
+    ByteStream* source,
+    velox::memory::MemoryPool* pool,
+    RowTypePtr type,
+    RowVectorPtr* result,
+    const Options* /* options */) {
+  const auto numRows = source->read<int32_t>();
+  const auto bodySize = source->read<int64_t>();
+  VELOX_CHECK_GE(bodySize, 0);
+
+  auto arrays = std::make_unique<ImportedArrays>();
+  auto schemas = std::make_unique<ImportedSchemas>();
+  // The page is read into one buffer which the imported vectors reference.
+  arrays->page = AlignedBuffer::allocate<char>(bodySize, pool);
+  source->readBytes(arrays->page->asMutable<uint8_t>(), bodySize);
+
+  ArrowArray array;
+  ArrowSchema schema;
+  PageReader reader(arrays->page->as<char>(), bodySize, *arrays, *schemas);
+  reader.readNode(type, "", array, schema);
+  VELOX_CHECK(reader.atEnd(), "Unexpected data after Arrow page");
+  VELOX_CHECK_EQ(array.length, numRows);
+
+  array.private_data = arrays.release();
+  array.release = releaseImportedArrays;
+  schema.private_data = schemas.release();
+  schema.release = releaseImportedSchemas;
+  auto imported = importFromArrowAsOwner(schema, array, pool);
+  *result = std::dynamic_pointer_cast<RowVector>(imported);
+  VELOX_CHECK_NOT_NULL(*result);
+}
+
+// static
+void ArrowVectorSerde::registerVectorSerde() {
+  velox::registerVectorSerde(std::make_unique<ArrowVectorSerde>());
+}
+
+} // namespace facebook::velox::serializer
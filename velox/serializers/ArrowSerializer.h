@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/VectorStream.h"
+
+namespace facebook::velox::serializer {
+
+/// Columnar serde for exchanges between Velox workers. The vectors are
+/// exported with the Arrow C data interface bridge and each page carries the
+/// Arrow buffers of the columns as they are, laid out like the body of an
+/// Arrow IPC record batch: a pre-order list of the array nodes, each with its
+/// length, null count, Arrow format string and 8 byte aligned buffers. Flat
+/// and dictionary encoded columns are written without going through
+/// per-value encoding. On the receiving side the page is read into one buffer
+/// and the vectors are imported over it as buffer views, without decoding or
+/// copying the values.
+///
+/// The types are limited to these supported by the Arrow bridge. TIMESTAMP and
+/// short DECIMAL columns are not supported.
+///
+/// The page layout is:
+/// numRows(4) | bodySize(8) | body
+class ArrowVectorSerde : public VectorSerde {
+ public:
+  ArrowVectorSerde() = default;
+
+  /// Estimates the sizes with the PrestoVectorSerde estimate, which is close to
+  /// the size of the Arrow buffers of the rows.
+  void estimateSerializedSize(
+      VectorPtr vector,
+      const folly::Range<const IndexRange*>& ranges,
+      vector_size_t** sizes) override;
+
+  std::unique_ptr<VectorSerializer> createSerializer(
+      RowTypePtr type,
+      int32_t numRows,
+      StreamArena* streamArena,
+      const Options* options) override;
+
+  /// Reads one page from 'source'. The vectors in 'result' reference a buffer
+  /// holding the page, so 'source' does not need to outlive them.
+  void deserialize(
+      ByteStream* source,
+      velox::memory::MemoryPool* pool,
+      RowTypePtr type,
+      RowVectorPtr* result,
+      const Options* options) override;
+
+  static void registerVectorSerde();
+};
+
+} // namespace facebook::velox::serializer
@@ -20,8 +20,10 @@
 #include "velox/functions/prestosql/types/TimestampWithTimeZoneType.h"
 #include "velox/vector/BiasVector.h"
 #include "velox/vector/ComplexVector.h"
+#include "velox/vector/DecodedVector.h"
 #include "velox/vector/DictionaryVector.h"
 #include "velox/vector/FlatVector.h"
+#include "velox/vector/LazyVector.h"
 #include "velox/vector/VectorTypeUtils.h"
 
 namespace facebook::velox::serializer::presto {
@@ -144,6 +146,14 @@ PrestoVectorSerde::PrestoOptions toPrestoOptions(
   return *(static_cast<const PrestoVectorSerde::PrestoOptions*>(options));
 }
 
+std::shared_ptr<folly::io::Codec> makeCodec(
+    const PrestoVectorSerde::PrestoOptions& options) {
+  if (options.codec != nullptr) {
+    return options.codec;
+  }
+  return common::compressionKindToCodec(options.compressionKind);
+}
+
 FOLLY_ALWAYS_INLINE bool needCompression(const folly::io::Codec& codec) {
   return codec.type() != folly::io::CodecType::NO_COMPRESSION;
 }
@@ -889,6 +899,228 @@ void readColumns(
   }
 }
 
+// Skips the nulls of a column of 'size' rows and returns the number of nulls.
+vector_size_t skipNulls(ByteStream* source, vector_size_t size) {
+  if (source->readByte() == 0) {
+    return 0;
+  }
+  const auto numBytes = BaseVector::byteSize<bool>(size);
+  raw_vector<uint64_t> nulls(bits::nwords(size));
+  auto* rawNulls = reinterpret_cast<uint8_t*>(nulls.data());
+  source->readBytes(rawNulls, numBytes);
+  bits::reverseBits(rawNulls, numBytes);
+  bits::negate(reinterpret_cast<char*>(rawNulls), numBytes * 8);
+  return bits::countNulls(nulls.data(), 0, size);
+}
+
+// Returns the serialized size of a non-null value of a fixed-width 'type'.
+int32_t fixedWidthValueBytes(const TypePtr& type, bool useLosslessTimestamp) {
+  switch (type->kind()) {
+    case TypeKind::BOOLEAN:
+    case TypeKind::TINYINT:
+    case TypeKind::UNKNOWN:
+      return 1;
+    case TypeKind::SMALLINT:
+      return sizeof(int16_t);
+    case TypeKind::INTEGER:
+    case TypeKind::REAL:
+      return sizeof(int32_t);
+    case TypeKind::BIGINT:
+    case TypeKind::DOUBLE:
+      return sizeof(int64_t);
+    case TypeKind::HUGEINT:
+      return 2 * sizeof(int64_t);
+    case TypeKind::TIMESTAMP:
+      return useLosslessTimestamp ? 2 * sizeof(int64_t) : sizeof(int64_t);
+    default:
+      VELOX_UNREACHABLE("Not a fixed-width type: {}", type->toString());
+  }
+}
+
+// Advances 'source' past a serialized column of 'type' without materializing
+// it. Mirrors readColumns().
+void skipColumn(
+    ByteStream* source,
+    const TypePtr& type,
+    bool useLosslessTimestamp) {
+  const auto encoding = readLengthPrefixedString(source);
+  if (encoding == kRLE) {
+    source->read<int32_t>();
+    skipColumn(source, type, useLosslessTimestamp);
+    return;
+  }
+  if (encoding == kDictionary) {
+    const auto size = source->read<int32_t>();
+    skipColumn(source, type, useLosslessTimestamp);
+    // Indices and 'instance id'.
+    source->skip(size * sizeof(int32_t) + 24);
+    return;
+  }
+  checkTypeEncoding(encoding, type);
+
+  // Skips the row count, the offsets and the nulls of a nested type.
+  auto skipOffsetsAndNulls = [&]() {
+    const auto size = source->read<int32_t>();
+    source->skip((size + 1) * sizeof(int32_t));
+    skipNulls(source, size);
+  };
+  if (isTimestampWithTimeZoneType(type)) {
+    const auto size = source->read<int32_t>();
+    const auto numNulls = skipNulls(source, size);
+    source->skip((size - numNulls) * sizeof(int64_t));
+    return;
+  }
+  switch (type->kind()) {
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY: {
+      const auto size = source->read<int32_t>();
+      source->skip(size * sizeof(int32_t));
+      skipNulls(source, size);
+      source->skip(source->read<int32_t>());
+      return;
+    }
+    case TypeKind::ARRAY:
+      skipColumn(source, type->childAt(0), useLosslessTimestamp);
+      skipOffsetsAndNulls();
+      return;
+    case TypeKind::MAP: {
+      skipColumn(source, type->childAt(0), useLosslessTimestamp);
+      skipColumn(source, type->childAt(1), useLosslessTimestamp);
+      const auto hashTableSize = source->read<int32_t>();
+      if (hashTableSize != -1) {
+        source->skip(hashTableSize * sizeof(int32_t));
+      }
+      skipOffsetsAndNulls();
+      return;
+    }
+    case TypeKind::ROW:
+      source->read<int32_t>();
+      for (const auto& childType : type->asRow().children()) {
+        skipColumn(source, childType, useLosslessTimestamp);
+      }
+      skipOffsetsAndNulls();
+      return;
+    default: {
+      const auto size = source->read<int32_t>();
+      const auto numNulls = skipNulls(source, size);
+      source->skip(
+          (size - numNulls) * fixedWidthValueBytes(type, useLosslessTimestamp));
+    }
+  }
+}
+
+// Deserializes one column of a page on first access. The page is shared by
+// the loaders of all its columns.
+class PrestoColumnLoader : public VectorLoader {
+ public:
+  PrestoColumnLoader(
+      std::shared_ptr<folly::IOBuf> page,
+      int32_t offset,
+      int32_t size,
+      TypePtr type,
+      vector_size_t numRows,
+      bool useLosslessTimestamp,
+      memory::MemoryPool* pool)
+      : page_(std::move(page)),
+        offset_(offset),
+        size_(size),
+        type_(std::move(type)),
+        numRows_(numRows),
+        useLosslessTimestamp_(useLosslessTimestamp),
+        pool_(pool) {}
+
+ protected:
+  void loadInternal(
+      RowSet rows,
+      ValueHook* hook,
+      vector_size_t resultSize,
+      VectorPtr* result) override {
+    ByteStream source;
+    source.resetInput({ByteRange{page_->writableData() + offset_, size_, 0}});
+    std::vector<VectorPtr> columns{BaseVector::create(type_, 0, pool_)};
+    readColumns(&source, pool_, {type_}, columns, useLosslessTimestamp_);
+    auto& column = columns[0];
+    // Same as the top level scatterStructNulls() of an eagerly deserialized
+    // page, which has no nulls of its own.
+    if (column->encoding() == VectorEncoding::Simple::ROW) {
+      scatterStructNulls(
+          numRows_, 0, nullptr, nullptr, *column->asUnchecked<RowVector>());
+    } else {
+      scatterVector(numRows_, 0, nullptr, nullptr, column);
+    }
+    // The page is no longer needed once all its columns are loaded.
+    page_.reset();
+
+    if (hook != nullptr) {
+      VELOX_DYNAMIC_SCALAR_TYPE_DISPATCH(
+          applyHook, type_->kind(), column, rows, hook);
+      return;
+    }
+    VELOX_CHECK_GE(column->size(), resultSize);
+    *result = std::move(column);
+  }
+
+ private:
+  template <TypeKind Kind>
+  static void
+  applyHook(const VectorPtr& column, RowSet rows, ValueHook* hook) {
+    using T = typename TypeTraits<Kind>::NativeType;
+    DecodedVector decoded(*column);
+    const bool acceptsNulls = hook->acceptsNulls();
+    for (auto row : rows) {
+      if (decoded.isNullAt(row)) {
+        if (acceptsNulls) {
+          hook->addNull(row);
+        }
+      } else {
+        T value = decoded.valueAt<T>(row);
+        hook->addValue(row, &value);
+      }
+    }
+  }
+
+  std::shared_ptr<folly::IOBuf> page_;
+  const int32_t offset_;
+  const int32_t size_;
+  const TypePtr type_;
+  const vector_size_t numRows_;
+  const bool useLosslessTimestamp_;
+  memory::MemoryPool* const pool_;
+};
+
+// Sets the children of 'result' to LazyVectors over the columns serialized in
+// 'page', which starts with the number of columns.
+void readLazyColumns(
+    std::shared_ptr<folly::IOBuf> page,
+    velox::memory::MemoryPool* pool,
+    const RowTypePtr& type,
+    vector_size_t numRows,
+    bool useLosslessTimestamp,
+    RowVector& result) {
+  ByteStream source;
+  source.resetInput(
+      {ByteRange{page->writableData(), (int32_t)page->length(), 0}});
+  const auto numColumns = source.read<int32_t>();
+  VELOX_CHECK_EQ(numColumns, type->size());
+  auto& children = result.children();
+  for (auto i = 0; i < numColumns; ++i) {
+    const int32_t offset = source.tellp();
+    skipColumn(&source, type->childAt(i), useLosslessTimestamp);
+    children[i] = std::make_shared<LazyVector>(
+        pool,
+        type->childAt(i),
+        numRows,
+        std::make_unique<PrestoColumnLoader>(
+            page,
+            offset,
+            (int32_t)source.tellp() - offset,
+            type->childAt(i),
+            numRows,
+            useLosslessTimestamp,
+            pool));
+  }
+}
+
 void writeInt32(OutputStream* out, int32_t value) {
   out->write(reinterpret_cast<char*>(&value), sizeof(value));
 }
@@ -1912,9 +2144,13 @@ class PrestoVectorSerializer : public VectorSerializer {
       int32_t numRows,
       StreamArena* streamArena,
       bool useLosslessTimestamp,
-      common::CompressionKind compressionKind)
+      std::shared_ptr<folly::io::Codec> codec,
+      float minCompressionRatio,
+      PrestoVectorSerde::CompressionStats* compressionStats)
       : streamArena_(streamArena),
-        codec_(common::compressionKindToCodec(compressionKind)) {
+        codec_(std::move(codec)),
+        minCompressionRatio_(minCompressionRatio),
+        compressionStats_(compressionStats) {
     auto types = rowType->children();
     auto numTypes = types.size();
     streams_.resize(numTypes);
@@ -2036,26 +2272,16 @@ class PrestoVectorSerializer : public VectorSerializer {
     out->seekp(offset + size);
   }
 
+  // Compresses the page and writes it compressed if it compresses below
+  // 'minCompressionRatio_' and uncompressed otherwise.
   void flushCompressed(
       int32_t numRows,
       OutputStream* output,
       PrestoOutputStreamListener* listener) {
-    const int32_t offset = output->tellp();
-    char codec = kCompressedBitMask;
-    if (listener) {
-      codec |= kCheckSumBitMask;
-    }
-
-    // Pause CRC computation
-    if (listener) {
-      listener->pause();
-    }
-
-    writeInt32(output, numRows);
-    output->write(&codec, 1);
-
-    IOBufOutputStream out(
-        *(streamArena_->pool()), nullptr, streamArena_->size());
+    // The streams stay alive while compressing, so their ranges are
+    // referenced instead of copied.
+    IOBufOutputStream out(*(streamArena_->pool()));
+    out.referenceStableWrites(nullptr);
     writeInt32(&out, streams_.size());
 
     for (auto& stream : streams_) {
@@ -2067,19 +2293,39 @@ class PrestoVectorSerializer : public VectorSerializer {
         uncompressedSize,
         codec_->maxUncompressedLength(),
         "UncompressedSize exceeds limit");
-    auto compressed = codec_->compress(out.getIOBuf().get());
-    const int32_t compressedSize = compressed->length();
+    auto uncompressed = out.getIOBuf();
+    auto compressed = codec_->compress(uncompressed.get());
+    const int32_t compressedSize = compressed->computeChainDataLength();
+    const bool sendCompressed =
+        compressedSize <= uncompressedSize * minCompressionRatio_;
+    updateCompressionStats(uncompressedSize, compressedSize, sendCompressed);
+
+    const auto& page = sendCompressed ? compressed : uncompressed;
+    const int32_t sizeInBytes =
+        sendCompressed ? compressedSize : uncompressedSize;
+    char codec = sendCompressed ? kCompressedBitMask : 0;
+    if (listener) {
+      codec |= kCheckSumBitMask;
+    }
+
+    // Pause CRC computation
+    if (listener) {
+      listener->pause();
+    }
+
+    writeInt32(output, numRows);
+    output->write(&codec, 1);
     writeInt32(output, uncompressedSize);
-    writeInt32(output, compressedSize);
+    writeInt32(output, sizeInBytes);
     const int32_t crcOffset = output->tellp();
     writeInt64(output, 0); // Write zero checksum
     // Number of columns and stream content. Unpause CRC.
     if (listener) {
       listener->resume();
     }
-    output->write(
-        reinterpret_cast<const char*>(compressed->writableData()),
-        compressed->length());
+    for (const auto& range : *page) {
+      output->write(reinterpret_cast<const char*>(range.data()), range.size());
+    }
     // Pause CRC computation
     if (listener) {
       listener->pause();
@@ -2088,13 +2334,44 @@ class PrestoVectorSerializer : public VectorSerializer {
     // Fill in crc
     int64_t crc = 0;
     if (listener) {
-      crc = computeChecksum(listener, codec, numRows, compressedSize);
+      crc = computeChecksum(listener, codec, numRows, sizeInBytes);
     }
     output->seekp(crcOffset);
     writeInt64(output, crc);
     output->seekp(endSize);
   }
 
+  void updateCompressionStats(
+      int32_t uncompressedSize,
+      int32_t compressedSize,
+      bool sendCompressed) {
+    if (compressionStats_ == nullptr) {
+      return;
+    }
+    compressionStats_->compressionInputBytes += uncompressedSize;
+    compressionStats_->compressedBytes += compressedSize;
+    if (sendCompressed) {
+      ++compressionStats_->numCompressedPages;
+      compressionStats_->nextPagesToSkip = 1;
+      return;
+    }
+    ++compressionStats_->numUncompressiblePages;
+    compressionStats_->pagesToSkip = compressionStats_->nextPagesToSkip;
+    compressionStats_->nextPagesToSkip = std::min(
+        compressionStats_->nextPagesToSkip * 2, kMaxCompressionPagesToSkip);
+  }
+
+  // Returns true if the page should be sent uncompressed without trying to
+  // compress it because the previous pages did not compress well.
+  bool skipCompression() {
+    if (compressionStats_ == nullptr || compressionStats_->pagesToSkip == 0) {
+      return false;
+    }
+    --compressionStats_->pagesToSkip;
+    ++compressionStats_->numSkippedPages;
+    return true;
+  }
+
   // Writes the contents to 'stream' in wire format
   void flushInternal(int32_t numRows, OutputStream* out) {
     auto listener = dynamic_cast<PrestoOutputStreamListener*>(out->listener());
@@ -2103,7 +2380,7 @@ class PrestoVectorSerializer : public VectorSerializer {
       listener->reset();
     }
 
-    if (!needCompression(*codec_)) {
+    if (!needCompression(*codec_) || skipCompression()) {
       flushUncompressed(numRows, out, listener);
     } else {
       flushCompressed(numRows, out, listener);
@@ -2112,9 +2389,14 @@ class PrestoVectorSerializer : public VectorSerializer {
 
   static const int32_t kSizeInBytesOffset{4 + 1};
   static const int32_t kHeaderSize{kSizeInBytesOffset + 4 + 4 + 8};
+  // Upper bound on the number of pages sent uncompressed without trying after
+  // a poorly compressible page.
+  static const int32_t kMaxCompressionPagesToSkip{64};
 
   StreamArena* const streamArena_;
-  const std::unique_ptr<folly::io::Codec> codec_;
+  const std::shared_ptr<folly::io::Codec> codec_;
+  const float minCompressionRatio_;
+  PrestoVectorSerde::CompressionStats* const compressionStats_;
   int32_t numRows_{0};
   std::vector<std::unique_ptr<VectorStream>> streams_;
 };
@@ -2139,7 +2421,9 @@ std::unique_ptr<VectorSerializer> PrestoVectorSerde::createSerializer(
       numRows,
       streamArena,
       prestoOptions.useLosslessTimestamp,
-      prestoOptions.compressionKind);
+      makeCodec(prestoOptions),
+      prestoOptions.minCompressionRatio,
+      prestoOptions.compressionStats);
 }
 
 void PrestoVectorSerde::serializeEncoded(
@@ -2162,10 +2446,12 @@ void PrestoVectorSerde::deserialize(
     const Options* options) {
   auto prestoOptions = toPrestoOptions(options);
   const bool useLosslessTimestamp = prestoOptions.useLosslessTimestamp;
-  auto codec = common::compressionKindToCodec(prestoOptions.compressionKind);
+  auto codec = makeCodec(prestoOptions);
   auto numRows = source->read<int32_t>();
 
-  if (*result && result->unique()) {
+  // The children of a lazily deserialized page are replaced with LazyVectors,
+  // so the previous result is not reused.
+  if (*result && result->unique() && !prestoOptions.lazyColumns) {
     VELOX_CHECK(
         *(*result)->type() == *type,
         "Unexpected type: {} vs. {}",
@@ -2192,16 +2478,35 @@ void PrestoVectorSerde::deserialize(
   VELOX_CHECK_EQ(
       checksum, actualCheckSum, "Received corrupted serialized page.");
 
-  VELOX_CHECK_EQ(
-      needCompression(*codec),
-      isCompressedBitSet(pageCodecMarker),
+  // A page is sent uncompressed if it does not compress well, so the marker
+  // and not the compression kind decides whether to decompress.
+  VELOX_CHECK(
+      needCompression(*codec) || !isCompressedBitSet(pageCodecMarker),
       "Compression kind {} should align with codec marker.",
       common::compressionKindToString(
           common::codecTypeToCompressionKind(codec->type())));
 
+  if (prestoOptions.lazyColumns) {
+    std::shared_ptr<folly::IOBuf> page;
+    if (!isCompressedBitSet(pageCodecMarker)) {
+      page = folly::IOBuf::create(uncompressedSize);
+      source->readBytes(page->writableData(), uncompressedSize);
+      page->append(uncompressedSize);
+    } else {
+      auto compressBuf = folly::IOBuf::create(compressedSize);
+      source->readBytes(compressBuf->writableData(), compressedSize);
+      compressBuf->append(compressedSize);
+      page = codec->uncompress(compressBuf.get(), uncompressedSize);
+      page->coalesce();
+    }
+    readLazyColumns(
+        std::move(page), pool, type, numRows, useLosslessTimestamp, **result);
+    return;
+  }
+
   auto& children = (*result)->children();
   const auto& childTypes = type->asRow().children();
-  if (!needCompression(*codec)) {
+  if (!isCompressedBitSet(pageCodecMarker)) {
     auto numColumns = source->read<int32_t>();
     readColumns(source, pool, childTypes, children, useLosslessTimestamp);
   } else {
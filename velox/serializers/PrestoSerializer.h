@@ -22,6 +22,28 @@ namespace facebook::velox::serializer::presto {
 class PrestoVectorSerde : public VectorSerde {
  public:
   // Input options that the serializer recognizes.
+  /// Outcome of compressing the pages serialized with the same options, e.g.
+  /// the pages sent to one destination of an exchange. A page that does not
+  /// compress below 'minCompressionRatio' is sent uncompressed and the next
+  /// pages are then sent uncompressed without trying, for a number of pages
+  /// that doubles with each consecutive poorly compressible page.
+  struct CompressionStats {
+    // Number of pages sent compressed.
+    int64_t numCompressedPages{0};
+    // Number of pages that were compressed but sent uncompressed because of a
+    // poor compression ratio.
+    int64_t numUncompressiblePages{0};
+    // Number of pages sent uncompressed without trying to compress.
+    int64_t numSkippedPages{0};
+    // Uncompressed and compressed bytes of the pages that were compressed.
+    int64_t compressionInputBytes{0};
+    int64_t compressedBytes{0};
+    // Number of next pages to send uncompressed without trying.
+    int32_t pagesToSkip{0};
+    // Value of 'pagesToSkip' after the next poorly compressible page.
+    int32_t nextPagesToSkip{1};
+  };
+
   struct PrestoOptions : VectorSerde::Options {
     PrestoOptions() = default;
 
@@ -38,7 +60,25 @@ class PrestoVectorSerde : public VectorSerde {
     bool useLosslessTimestamp{false};
     common::CompressionKind compressionKind{
         common::CompressionKind::CompressionKind_NONE};
+    // A compressed page larger than this fraction of its uncompressed size is
+    // sent uncompressed. The page header marks whether a page is compressed so
+    // the reader skips decompression for such pages.
+    float minCompressionRatio{0.8};
+    // If set, skips compressing the pages after poorly compressible ones and
+    // records the outcome. Not owned. Must outlive the serializers created
+    // with these options and must not be shared between threads.
+    CompressionStats* compressionStats{nullptr};
+    // If true, deserialize() only locates the columns of a page and returns
+    // them as LazyVectors that deserialize a column on first access. Columns
+    // that are never accessed, e.g. because a later filter or join drops all
+    // their rows, are then never materialized.
+    bool lazyColumns{false};
     std::vector<VectorEncoding::Simple> encodings;
+    // If set, compresses and decompresses the pages with 'codec' instead of a
+    // new codec of 'compressionKind'. Lets a stateful codec, e.g.
+    // common::ZstdDictionaryCodec, span the pages of a stream. The pages must
+    // then be deserialized with the same 'codec'.
+    std::shared_ptr<folly::io::Codec> codec;
   };
 
   void estimateSerializedSize(
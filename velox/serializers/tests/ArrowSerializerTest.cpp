@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/serializers/ArrowSerializer.h"
+#include <gtest/gtest.h>
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/vector/fuzzer/VectorFuzzer.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox::serializer {
+namespace {
+
+class ArrowSerializerTest : public ::testing::Test,
+                            public test::VectorTestBase {
+ protected:
+  void SetUp() override {
+    serde_ = std::make_unique<serializer::ArrowVectorSerde>();
+  }
+
+  // Serializes 'rowVector' one row at a time if 'byRow' is true and as a
+  // whole otherwise.
+  std::string serialize(const RowVectorPtr& rowVector, bool byRow) {
+    const auto numRows = rowVector->size();
+    std::vector<IndexRange> rows;
+    if (byRow) {
+      for (int i = 0; i < numRows; i++) {
+        rows.push_back(IndexRange{i, 1});
+      }
+    } else {
+      rows.push_back(IndexRange{0, numRows});
+    }
+
+    auto arena = std::make_unique<StreamArena>(pool());
+    auto rowType = asRowType(rowVector->type());
+    auto serializer = serde_->createSerializer(rowType, numRows, arena.get());
+
+    serializer->append(rowVector, folly::Range(rows.data(), rows.size()));
+    auto size = serializer->maxSerializedSize();
+    std::ostringstream output;
+    OStreamOutputStream out(&output);
+    serializer->flush(&out);
+    EXPECT_EQ(size, output.tellp());
+    return output.str();
+  }
+
+  RowVectorPtr deserialize(const RowTypePtr& rowType, std::string input) {
+    auto byteStream = std::make_unique<ByteStream>();
+    ByteRange byteRange{
+        reinterpret_cast<uint8_t*>(input.data()), (int32_t)input.length(), 0};
+    byteStream->resetInput({byteRange});
+
+    RowVectorPtr result;
+    serde_->deserialize(byteStream.get(), pool(), rowType, &result);
+    EXPECT_TRUE(byteStream->atEnd());
+    // The result must not reference 'input'.
+    std::fill(input.begin(), input.end(), 0);
+    return result;
+  }
+
+  void testRoundTrip(const RowVectorPtr& rowVector, bool byRow) {
+    auto rowType = asRowType(rowVector->type());
+    auto deserialized = deserialize(rowType, serialize(rowVector, byRow));
+    test::assertEqualVectors(rowVector, deserialized);
+  }
+
+  std::unique_ptr<VectorSerde> serde_;
+};
+
+TEST_F(ArrowSerializerTest, fuzz) {
+  auto rowType = ROW({
+      BOOLEAN(),
+      TINYINT(),
+      SMALLINT(),
+      INTEGER(),
+      BIGINT(),
+      REAL(),
+      DOUBLE(),
+      VARCHAR(),
+      VARBINARY(),
+      DATE(),
+      DECIMAL(20, 2),
+      ROW({VARCHAR(), INTEGER()}),
+      ARRAY(INTEGER()),
+      MAP(VARCHAR(), ARRAY(BIGINT())),
+  });
+
+  VectorFuzzer::Options opts;
+  opts.vectorSize = 100;
+  opts.nullRatio = 0.1;
+  opts.stringVariableLength = true;
+  opts.stringLength = 20;
+  opts.containerLength = 10;
+
+  auto seed = folly::Random::rand32();
+  LOG(INFO) << "Seed: " << seed;
+  SCOPED_TRACE(fmt::format("seed: {}", seed));
+  VectorFuzzer fuzzer(opts, pool(), seed);
+
+  for (auto i = 0; i < 10; ++i) {
+    auto data = fuzzer.fuzzInputRow(rowType);
+    testRoundTrip(data, true);
+    testRoundTrip(data, false);
+  }
+}
+
+TEST_F(ArrowSerializerTest, dictionary) {
+  auto base = makeFlatVector<std::string>(
+      {"a long string to reference", "short", "another long string to see"});
+  auto indices = makeIndices(100, [](auto row) { return row % 3; });
+  auto data = makeRowVector({
+      wrapInDictionary(indices, 100, base),
+      makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+  });
+
+  // A whole vector keeps its encodings.
+  auto rowType = asRowType(data->type());
+  auto deserialized = deserialize(rowType, serialize(data, false));
+  test::assertEqualVectors(data, deserialized);
+  ASSERT_EQ(
+      deserialized->childAt(0)->encoding(), VectorEncoding::Simple::DICTIONARY);
+  ASSERT_EQ(deserialized->childAt(1)->encoding(), VectorEncoding::Simple::FLAT);
+
+  // Rows appended one by one are copied and sent flat.
+  deserialized = deserialize(rowType, serialize(data, true));
+  test::assertEqualVectors(data, deserialized);
+  ASSERT_EQ(deserialized->childAt(0)->encoding(), VectorEncoding::Simple::FLAT);
+}
+
+TEST_F(ArrowSerializerTest, constant) {
+  auto data = makeRowVector({
+      makeConstant<int32_t>(7, 10),
+      makeNullConstant(TypeKind::VARCHAR, 10),
+  });
+  testRoundTrip(data, false);
+}
+
+TEST_F(ArrowSerializerTest, emptyPage) {
+  auto data = makeRowVector(
+      {makeFlatVector<int64_t>({}), makeFlatVector<std::string>({})});
+  testRoundTrip(data, false);
+}
+
+TEST_F(ArrowSerializerTest, unsupportedType) {
+  StreamArena arena(pool());
+  VELOX_ASSERT_THROW(
+      serde_->createSerializer(ROW({"t"}, {TIMESTAMP()}), 10, &arena),
+      "Type TIMESTAMP is not supported by ArrowVectorSerde");
+  VELOX_ASSERT_THROW(
+      serde_->createSerializer(ROW({"d"}, {DECIMAL(10, 2)}), 10, &arena),
+      "Type DECIMAL(10, 2) is not supported by ArrowVectorSerde");
+}
+
+} // namespace
+} // namespace facebook::velox::serializer
@@ -466,6 +466,41 @@ TEST_P(PrestoSerializerTest, lazy) {
   testRoundTrip(lazyVector);
 }
 
+TEST_P(PrestoSerializerTest, lazyColumns) {
+  VectorFuzzer::Options opts;
+  opts.timestampPrecision =
+      VectorFuzzer::Options::TimestampPrecision::kMilliSeconds;
+  opts.nullRatio = 0.1;
+  VectorFuzzer fuzzer(opts, pool_.get());
+  auto rowType = ROW(
+      {{"a", BIGINT()},
+       {"b", VARCHAR()},
+       {"c", ARRAY(INTEGER())},
+       {"d", MAP(VARCHAR(), DOUBLE())},
+       {"e", ROW({{"e1", BOOLEAN()}, {"e2", TIMESTAMP()}})},
+       {"f", DECIMAL(20, 2)}});
+  auto data = fuzzer.fuzzInputRow(rowType);
+  std::ostringstream out;
+  serialize(data, &out, nullptr);
+
+  serializer::presto::PrestoVectorSerde::PrestoOptions lazyOptions{
+      false, GetParam()};
+  lazyOptions.lazyColumns = true;
+  auto byteStream = toByteStream(out.str());
+  RowVectorPtr result;
+  serde_->deserialize(
+      byteStream.get(), pool_.get(), rowType, &result, &lazyOptions);
+  ASSERT_TRUE(byteStream->atEnd());
+  for (const auto& child : result->children()) {
+    ASSERT_TRUE(isLazyNotLoaded(*child));
+  }
+
+  // Loading one column leaves the others unloaded.
+  assertEqualVectors(data->childAt(3), result->childAt(3));
+  ASSERT_TRUE(isLazyNotLoaded(*result->childAt(0)));
+  assertEqualVectors(data, result);
+}
+
 TEST_P(PrestoSerializerTest, ioBufRoundTrip) {
   VectorFuzzer::Options opts;
   opts.timestampPrecision =
@@ -485,6 +520,81 @@ TEST_P(PrestoSerializerTest, ioBufRoundTrip) {
   }
 }
 
+TEST_P(PrestoSerializerTest, adaptiveCompression) {
+  if (GetParam() == common::CompressionKind::CompressionKind_NONE) {
+    return;
+  }
+  constexpr vector_size_t kSize = 1'000;
+  auto compressible =
+      vectorMaker_->rowVector({vectorMaker_->flatVector<int64_t>(
+          kSize, [](vector_size_t row) { return row % 3; })});
+  auto incompressible =
+      vectorMaker_->rowVector({vectorMaker_->flatVector<int64_t>(
+          kSize, [](vector_size_t /*row*/) {
+            return folly::Random::rand64();
+          })});
+
+  serializer::presto::PrestoVectorSerde::CompressionStats stats;
+  serializer::presto::PrestoVectorSerde::PrestoOptions options{
+      false, GetParam()};
+  options.compressionStats = &stats;
+
+  // Serializes 'data' as one page and returns true if the page is marked
+  // compressed. Checks that the page reads back.
+  auto roundTrip = [&](const RowVectorPtr& data) {
+    std::ostringstream output;
+    auto arena = std::make_unique<StreamArena>(pool_.get());
+    auto serializer = serde_->createSerializer(
+        asRowType(data->type()), kSize, arena.get(), &options);
+    serializer->append(data);
+    serializer::presto::PrestoOutputStreamListener listener;
+    OStreamOutputStream out(&output, &listener);
+    serializer->flush(&out);
+
+    const auto page = output.str();
+    auto byteStream = toByteStream(page);
+    RowVectorPtr result;
+    serde_->deserialize(
+        byteStream.get(),
+        pool_.get(),
+        asRowType(data->type()),
+        &result,
+        &options);
+    assertEqualVectors(data, result);
+    // The codec marker follows the number of rows.
+    return (page[4] & 1) != 0;
+  };
+
+  ASSERT_TRUE(roundTrip(compressible));
+  ASSERT_EQ(stats.numCompressedPages, 1);
+
+  // A poorly compressible page is sent uncompressed and the next page is sent
+  // uncompressed without trying.
+  ASSERT_FALSE(roundTrip(incompressible));
+  ASSERT_EQ(stats.numUncompressiblePages, 1);
+  ASSERT_FALSE(roundTrip(compressible));
+  ASSERT_EQ(stats.numSkippedPages, 1);
+  ASSERT_EQ(stats.numCompressedPages, 1);
+
+  // The number of skipped pages doubles after each poorly compressible page.
+  ASSERT_FALSE(roundTrip(incompressible));
+  ASSERT_EQ(stats.numUncompressiblePages, 2);
+  ASSERT_FALSE(roundTrip(compressible));
+  ASSERT_FALSE(roundTrip(compressible));
+  ASSERT_EQ(stats.numSkippedPages, 3);
+
+  // A well compressible page resets the backoff.
+  ASSERT_TRUE(roundTrip(compressible));
+  ASSERT_EQ(stats.numCompressedPages, 2);
+  ASSERT_EQ(stats.nextPagesToSkip, 1);
+  ASSERT_LT(stats.compressedBytes, stats.compressionInputBytes);
+
+  // Without compression stats every page is tried.
+  options.compressionStats = nullptr;
+  ASSERT_FALSE(roundTrip(incompressible));
+  ASSERT_TRUE(roundTrip(compressible));
+}
+
 INSTANTIATE_TEST_SUITE_P(
     PrestoSerializerTest,
     PrestoSerializerTest,
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/substrait/SubstraitPlanCache.h"
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+
+namespace facebook::velox::substrait {
+namespace {
+
+// Returns the input of 'rel' for the Rels with a single input that the plan
+// converter supports, nullptr otherwise.
+const ::substrait::Rel* singleInput(const ::substrait::Rel& rel) {
+  if (rel.has_aggregate() && rel.aggregate().has_input()) {
+    return &rel.aggregate().input();
+  }
+  if (rel.has_project() && rel.project().has_input()) {
+    return &rel.project().input();
+  }
+  if (rel.has_filter() && rel.filter().has_input()) {
+    return &rel.filter().input();
+  }
+  if (rel.has_fetch() && rel.fetch().has_input()) {
+    return &rel.fetch().input();
+  }
+  if (rel.has_sort() && rel.sort().has_input()) {
+    return &rel.sort().input();
+  }
+  return nullptr;
+}
+
+// Returns the ReadRel at the bottom of 'substraitPlan', nullptr if there is
+// none.
+const ::substrait::ReadRel* findReadRel(
+    const ::substrait::Plan& substraitPlan) {
+  if (substraitPlan.relations_size() != 1) {
+    return nullptr;
+  }
+  const auto& planRel = substraitPlan.relations(0);
+  const ::substrait::Rel* rel = nullptr;
+  if (planRel.has_root() && planRel.root().has_input()) {
+    rel = &planRel.root().input();
+  } else if (planRel.has_rel()) {
+    rel = &planRel.rel();
+  }
+  while (rel != nullptr && !rel->has_read()) {
+    rel = singleInput(*rel);
+  }
+  return rel == nullptr ? nullptr : &rel->read();
+}
+
+} // namespace
+
+SubstraitPlanCache::Plan SubstraitPlanCache::toVeloxPlan(
+    const ::substrait::Plan& substraitPlan) {
+  const auto key = cacheKey(substraitPlan);
+  std::optional<Entry> entry;
+  {
+    std::lock_guard<std::mutex> l(mutex_);
+    entry = cache_.get(key);
+  }
+  if (entry.has_value()) {
+    Plan plan{entry->planNode, {}};
+    if (entry->readNodeId.has_value()) {
+      const auto* readRel = findReadRel(substraitPlan);
+      VELOX_CHECK_NOT_NULL(readRel);
+      plan.splitInfos[entry->readNodeId.value()] =
+          SubstraitVeloxPlanConverter::toSplitInfo(*readRel);
+    }
+    return plan;
+  }
+
+  // Converts outside of the lock. Concurrent misses on the same plan convert
+  // it more than once and the first one is kept.
+  SubstraitVeloxPlanConverter converter(pool_);
+  Plan plan{converter.toVeloxPlan(substraitPlan), converter.splitInfos()};
+  Entry newEntry{plan.planNode, std::nullopt};
+  VELOX_CHECK_LE(plan.splitInfos.size(), 1);
+  if (!plan.splitInfos.empty()) {
+    newEntry.readNodeId = plan.splitInfos.begin()->first;
+  }
+  std::lock_guard<std::mutex> l(mutex_);
+  cache_.add(key, newEntry);
+  return plan;
+}
+
+SimpleLRUCacheStats SubstraitPlanCache::stats() const {
+  std::lock_guard<std::mutex> l(mutex_);
+  return cache_.getStats();
+}
+
+void SubstraitPlanCache::clear() {
+  std::lock_guard<std::mutex> l(mutex_);
+  cache_.clear();
+}
+
+// static
+std::string SubstraitPlanCache::cacheKey(
+    const ::substrait::Plan& substraitPlan) {
+  const ::substrait::Plan* keyPlan = &substraitPlan;
+  ::substrait::Plan withoutFiles;
+  const auto* readRel = findReadRel(substraitPlan);
+  if (readRel != nullptr && readRel->has_local_files()) {
+    withoutFiles = substraitPlan;
+    // The ReadRel of the copy is owned by 'withoutFiles'.
+    const_cast<::substrait::ReadRel*>(findReadRel(withoutFiles))
+        ->clear_local_files();
+    keyPlan = &withoutFiles;
+  }
+
+  // Map fields are serialized in a fixed order so that equal plans have
+  // equal keys.
+  std::string key;
+  {
+    google::protobuf::io::StringOutputStream stream(&key);
+    google::protobuf::io::CodedOutputStream output(&stream);
+    output.SetSerializationDeterministic(true);
+    keyPlan->SerializeToCodedStream(&output);
+  }
+  return key;
+}
+
+} // namespace facebook::velox::substrait
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <mutex>
+
+#include "velox/common/caching/SimpleLRUCache.h"
+#include "velox/substrait/SubstraitToVeloxPlan.h"
+
+namespace facebook::velox::substrait {
+
+/// Caches the Velox plans converted from Substrait plans. The tasks of a
+/// query stage send the same Substrait plan with different files in its
+/// ReadRel. The cache is keyed by the plan without these files, so that the
+/// plan is converted once per stage and only the splits are taken from each
+/// request.
+///
+/// Literals are part of the key. Velox plans hold them as constants and in
+/// the subfield filters of table scans, so a plan converted with one set of
+/// literals can not be used with another.
+///
+/// Thread-safe. 'pool' must outlive the cache. It holds the vectors of the
+/// ValuesNodes of the cached plans.
+class SubstraitPlanCache {
+ public:
+  struct Plan {
+    core::PlanNodePtr planNode;
+
+    /// Splits of the leaf node, taken from the converted Substrait plan.
+    std::unordered_map<
+        core::PlanNodeId,
+        std::shared_ptr<SubstraitVeloxPlanConverter::SplitInfo>>
+        splitInfos;
+  };
+
+  SubstraitPlanCache(memory::MemoryPool* pool, size_t maxEntries)
+      : pool_(pool), cache_(maxEntries) {}
+
+  /// Returns the Velox plan for 'substraitPlan' and the splits of its
+  /// ReadRel. Converts the plan unless an equal plan with possibly other
+  /// files was converted before.
+  Plan toVeloxPlan(const ::substrait::Plan& substraitPlan);
+
+  SimpleLRUCacheStats stats() const;
+
+  void clear();
+
+ private:
+  struct Entry {
+    core::PlanNodePtr planNode;
+    // Id of the node converted from the ReadRel. Unset if the plan has no
+    // ReadRel.
+    std::optional<core::PlanNodeId> readNodeId;
+  };
+
+  // Returns the serialized 'substraitPlan' without the files of its ReadRel.
+  static std::string cacheKey(const ::substrait::Plan& substraitPlan);
+
+  memory::MemoryPool* const pool_;
+  mutable std::mutex mutex_;
+  SimpleLRUCache<std::string, Entry> cache_;
+};
+
+} // namespace facebook::velox::substrait
@@ -66,6 +66,11 @@ class SubstraitVeloxPlanConverter {
       const ::substrait::ReadRel& readRel,
       std::shared_ptr<SplitInfo>& splitInfo);
 
+  /// Returns the files read by 'readRel'. These differ between the tasks of a
+  /// query stage while the rest of the plan stays the same.
+  static std::shared_ptr<SplitInfo> toSplitInfo(
+      const ::substrait::ReadRel& readRel);
+
   /// Convert Substrait FetchRel into Velox LimitNode or TopNNode according the
   /// different input of fetchRel.
   core::PlanNodePtr toVeloxPlan(const ::substrait::FetchRel& fetchRel);
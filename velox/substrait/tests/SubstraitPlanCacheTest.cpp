@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "velox/substrait/tests/JsonToProtoConverter.h"
+
+#include "velox/common/base/tests/GTestUtils.h"
+#include "velox/dwio/common/tests/utils/DataFiles.h"
+#include "velox/substrait/SubstraitPlanCache.h"
+
+using namespace facebook::velox;
+using namespace facebook::velox::test;
+using namespace facebook::velox::substrait;
+
+class SubstraitPlanCacheTest : public ::testing::Test {
+ protected:
+  // Returns a plan that scans a BIGINT column named 'column' from 'path'.
+  static ::substrait::Plan makeScanPlan(
+      const std::string& path,
+      const std::string& column = "c0") {
+    ::substrait::Plan plan;
+    auto* read =
+        plan.add_relations()->mutable_root()->mutable_input()->mutable_read();
+    auto* schema = read->mutable_base_schema();
+    schema->add_names(column);
+    schema->mutable_struct_()->add_types()->mutable_i64()->set_nullability(
+        ::substrait::Type::NULLABILITY_NULLABLE);
+    auto* file = read->mutable_local_files()->add_items();
+    file->set_uri_file(path);
+    file->set_start(0);
+    file->set_length(100);
+    file->mutable_orc();
+    return plan;
+  }
+
+  static ::substrait::Plan readValuesPlan() {
+    ::substrait::Plan plan;
+    JsonToProtoConverter::readFromFile(
+        getDataFilePath(
+            "velox/substrait/tests", "data/substrait_virtualTable.json"),
+        plan);
+    return plan;
+  }
+
+  std::shared_ptr<memory::MemoryPool> pool_ =
+      memory::addDefaultLeafMemoryPool();
+};
+
+TEST_F(SubstraitPlanCacheTest, otherFiles) {
+  SubstraitPlanCache cache(pool_.get(), 10);
+  auto first = cache.toVeloxPlan(makeScanPlan("/a.orc"));
+  auto second = cache.toVeloxPlan(makeScanPlan("/b.orc"));
+  ASSERT_EQ(first.planNode, second.planNode);
+  ASSERT_EQ(cache.stats().numHits, 1);
+  ASSERT_EQ(cache.stats().numLookups, 2);
+
+  const auto& id = first.planNode->id();
+  ASSERT_EQ(first.splitInfos.size(), 1);
+  ASSERT_EQ(second.splitInfos.size(), 1);
+  ASSERT_EQ(first.splitInfos.at(id)->paths, std::vector<std::string>{"/a.orc"});
+  ASSERT_EQ(
+      second.splitInfos.at(id)->paths, std::vector<std::string>{"/b.orc"});
+  ASSERT_EQ(second.splitInfos.at(id)->lengths, std::vector<u_int64_t>{100});
+  ASSERT_EQ(second.splitInfos.at(id)->format, dwio::common::FileFormat::DWRF);
+}
+
+TEST_F(SubstraitPlanCacheTest, otherPlan) {
+  SubstraitPlanCache cache(pool_.get(), 10);
+  auto first = cache.toVeloxPlan(makeScanPlan("/a.orc", "c0"));
+  auto second = cache.toVeloxPlan(makeScanPlan("/a.orc", "c1"));
+  ASSERT_NE(first.planNode, second.planNode);
+  ASSERT_EQ(cache.stats().numHits, 0);
+  ASSERT_EQ(cache.stats().curSize, 2);
+}
+
+TEST_F(SubstraitPlanCacheTest, otherLiterals) {
+  SubstraitPlanCache cache(pool_.get(), 10);
+  auto substraitPlan = readValuesPlan();
+  auto first = cache.toVeloxPlan(substraitPlan);
+  ASSERT_EQ(cache.toVeloxPlan(substraitPlan).planNode, first.planNode);
+
+  substraitPlan.mutable_relations(0)
+      ->mutable_root()
+      ->mutable_input()
+      ->mutable_read()
+      ->mutable_virtual_table()
+      ->mutable_values(0)
+      ->mutable_fields(0)
+      ->set_i64(1);
+  auto second = cache.toVeloxPlan(substraitPlan);
+  ASSERT_NE(second.planNode, first.planNode);
+  ASSERT_EQ(cache.stats().numHits, 1);
+  ASSERT_EQ(cache.stats().numLookups, 3);
+
+  cache.clear();
+  ASSERT_EQ(cache.stats().curSize, 0);
+  ASSERT_NE(cache.toVeloxPlan(substraitPlan).planNode, second.planNode);
+}
@@ -18,6 +18,8 @@
 
 #include <folly/Conv.h>
 #include <cctype>
+#include <cstring>
+#include <optional>
 #include <string>
 #include <type_traits>
 #include "velox/common/base/Exceptions.h"
@@ -28,6 +30,60 @@ DECLARE_bool(experimental_enable_legacy_cast);
 
 namespace facebook::velox::util {
 
+namespace detail {
+// Returns true if all 8 bytes of 'chunk' are ASCII digits.
+inline bool isEightDigits(uint64_t chunk) {
+  return ((chunk & 0xF0F0F0F0F0F0F0F0) |
+          (((chunk + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) ==
+      0x3333333333333333;
+}
+
+// Returns the value of 8 ASCII digits loaded little-endian into 'chunk',
+// combining pairs, then quads, then halves of the word with multiplies
+// (SWAR).
+inline uint32_t parseEightDigits(uint64_t chunk) {
+  constexpr uint64_t kMask = 0x000000FF000000FF;
+  constexpr uint64_t kMul1 = 100 + (1000000ULL << 32);
+  constexpr uint64_t kMul2 = 1 + (10000ULL << 32);
+  chunk -= 0x3030303030303030;
+  chunk = (chunk * 10) + (chunk >> 8);
+  return static_cast<uint32_t>(
+      (((chunk & kMask) * kMul1) + (((chunk >> 16) & kMask) * kMul2)) >> 32);
+}
+
+// Parses an optional sign followed by 1 to 18 ASCII digits, which always fit
+// in an int64_t. Returns std::nullopt for anything else, e.g. whitespace or
+// longer numbers.
+inline std::optional<int64_t> parsePlainDecimal(const char* data, size_t size) {
+  bool negative = false;
+  if (size > 0 && (data[0] == '-' || data[0] == '+')) {
+    negative = data[0] == '-';
+    ++data;
+    --size;
+  }
+  if (size == 0 || size > 18) {
+    return std::nullopt;
+  }
+  int64_t result = 0;
+  for (; size >= 8; data += 8, size -= 8) {
+    uint64_t chunk;
+    memcpy(&chunk, data, 8);
+    if (!isEightDigits(chunk)) {
+      return std::nullopt;
+    }
+    result = result * 100'000'000 + parseEightDigits(chunk);
+  }
+  for (; size > 0; ++data, --size) {
+    const auto digit = static_cast<uint8_t>(*data - '0');
+    if (digit > 9) {
+      return std::nullopt;
+    }
+    result = result * 10 + digit;
+  }
+  return negative ? -result : result;
+}
+} // namespace detail
+
 template <TypeKind KIND, typename = void, bool TRUNCATE = false>
 struct Converter {
   template <typename T>
@@ -150,11 +206,42 @@ struct Converter<
     }
   }
 
+  // Parses plain decimal numbers without going through folly::to. Everything
+  // else, including out of range values, is left to folly::to, so that the
+  // accepted syntax and the errors do not change.
+  static T convertPlainStringToInt(folly::StringPiece v) {
+    if constexpr (std::is_same_v<T, bool> || std::is_same_v<T, int128_t>) {
+      return folly::to<T>(v);
+    } else {
+      const auto parsed = detail::parsePlainDecimal(v.data(), v.size());
+      if (parsed.has_value() && *parsed >= std::numeric_limits<T>::min() &&
+          *parsed <= std::numeric_limits<T>::max()) {
+        return static_cast<T>(*parsed);
+      }
+      return folly::to<T>(v);
+    }
+  }
+
+  // Like cast() of a string without truncation, but returns the error
+  // instead of throwing it. Casts of malformed strings under TRY then do not
+  // unwind an exception per row.
+  static folly::Expected<T, folly::ConversionCode> tryCastPlainString(
+      folly::StringPiece v) {
+    if constexpr (!std::is_same_v<T, bool> && !std::is_same_v<T, int128_t>) {
+      const auto parsed = detail::parsePlainDecimal(v.data(), v.size());
+      if (parsed.has_value() && *parsed >= std::numeric_limits<T>::min() &&
+          *parsed <= std::numeric_limits<T>::max()) {
+        return static_cast<T>(*parsed);
+      }
+    }
+    return folly::tryTo<T>(v);
+  }
+
   static T cast(folly::StringPiece v) {
     if constexpr (TRUNCATE) {
       return convertStringToInt(v);
     } else {
-      return folly::to<T>(v);
+      return convertPlainStringToInt(v);
     }
   }
 
@@ -162,7 +249,7 @@ struct Converter<
     if constexpr (TRUNCATE) {
       return convertStringToInt(folly::StringPiece(v));
     } else {
-      return folly::to<T>(folly::StringPiece(v));
+      return convertPlainStringToInt(folly::StringPiece(v));
     }
   }
 
@@ -170,7 +257,7 @@ struct Converter<
     if constexpr (TRUNCATE) {
       return convertStringToInt(v);
     } else {
-      return folly::to<T>(v);
+      return convertPlainStringToInt(v);
     }
   }
 
@@ -313,6 +400,12 @@ struct Converter<
     return folly::to<T>(v);
   }
 
+  // Like cast() of a string, but returns the error instead of throwing it.
+  static folly::Expected<T, folly::ConversionCode> tryCastPlainString(
+      folly::StringPiece v) {
+    return folly::tryTo<T>(v);
+  }
+
   static T cast(folly::StringPiece v) {
     return cast<folly::StringPiece>(v);
   }
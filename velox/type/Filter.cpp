@@ -20,7 +20,10 @@
 #include <set>
 #include <string>
 
+#include <folly/lang/Bits.h>
+
 #include "velox/common/base/Exceptions.h"
+#include "velox/common/encode/Base64.h"
 #include "velox/type/Filter.h"
 
 namespace facebook::velox::common {
@@ -94,6 +97,9 @@ std::string Filter::toString() const {
     case FilterKind::kHugeintValuesUsingHashTable:
       strKind = "HugeintValuesUsingHashTable";
       break;
+    case FilterKind::kBloomFilter:
+      strKind = "BloomFilter";
+      break;
   };
 
   return fmt::format(
@@ -131,6 +137,7 @@ std::unordered_map<FilterKind, std::string> filterKindNames() {
       {FilterKind::kTimestampRange, "kTimestampRange"},
       {FilterKind::kHugeintValuesUsingHashTable,
        "kHugeintValuesUsingHashTable"},
+      {FilterKind::kBloomFilter, "kBloomFilter"},
   };
 }
 
@@ -199,6 +206,7 @@ void Filter::registerSerDe() {
   registry.Register("NegatedBytesValues", NegatedBytesValues::create);
   registry.Register("MultiRange", MultiRange::create);
   registry.Register("TimestampRange", TimestampRange::create);
+  registry.Register("ValuesUsingBloomFilter", ValuesUsingBloomFilter::create);
 }
 
 folly::dynamic Filter::serializeBase(std::string_view name) const {
@@ -395,10 +403,8 @@ folly::dynamic BigintValuesUsingBitmask::serialize() const {
   obj["max"] = max_;
 
   folly::dynamic values = folly::dynamic::array;
-  for (size_t i = 0; i < bitmask_.size(); ++i) {
-    if (bitmask_[i]) {
-      values.push_back(i + min_);
-    }
+  for (auto value : this->values()) {
+    values.push_back(value);
   }
   obj["values"] = values;
 
@@ -420,19 +426,8 @@ bool BigintValuesUsingBitmask::testingEquals(const Filter& other) const {
       dynamic_cast<const BigintValuesUsingBitmask*>(&other);
   bool res = otherBigintValues != nullptr && Filter::testingBaseEquals(other) &&
       min_ == otherBigintValues->min_ && max_ == otherBigintValues->max_ &&
-      bitmask_.size() == otherBigintValues->bitmask_.size();
-
-  if (!res) {
-    return false;
-  }
-
-  for (size_t i = 0; i < bitmask_.size(); ++i) {
-    if (bitmask_.at(i) != otherBigintValues->bitmask_.at(i)) {
-      return false;
-    }
-  }
-
-  return true;
+      bitmask_ == otherBigintValues->bitmask_;
+  return res;
 }
 
 folly::dynamic NegatedBigintValuesUsingHashTable::serialize() const {
@@ -710,6 +705,49 @@ bool NegatedBytesValues::testingEquals(const Filter& other) const {
       nonNegated_->testingEquals((*(otherNegatedBytesValues->nonNegated_)));
 }
 
+folly::dynamic ValuesUsingBloomFilter::serialize() const {
+  auto obj = Filter::serializeBase("ValuesUsingBloomFilter");
+  std::string bits(bloomFilter_->serializedSize(), '\0');
+  bloomFilter_->serialize(bits.data());
+  obj["bloomFilter"] = encoding::Base64::encode(bits);
+  if (filter_) {
+    obj["filter"] = filter_->serialize();
+  }
+  return obj;
+}
+
+FilterPtr ValuesUsingBloomFilter::create(const folly::dynamic& obj) {
+  auto nullAllowed = deserializeNullAllowed(obj);
+  auto bits = encoding::Base64::decode(obj["bloomFilter"].asString());
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->merge(bits.data());
+  std::unique_ptr<Filter> filter;
+  if (obj.count("filter")) {
+    filter = ISerializable::deserialize<Filter>(obj["filter"]);
+  }
+  return std::make_unique<ValuesUsingBloomFilter>(
+      std::move(bloomFilter), nullAllowed, std::move(filter));
+}
+
+bool ValuesUsingBloomFilter::testingEquals(const Filter& other) const {
+  auto otherBloom = dynamic_cast<const ValuesUsingBloomFilter*>(&other);
+  if (otherBloom == nullptr || !Filter::testingBaseEquals(other)) {
+    return false;
+  }
+  if ((filter_ == nullptr) != (otherBloom->filter_ == nullptr) ||
+      (filter_ && !filter_->testingEquals(*otherBloom->filter_))) {
+    return false;
+  }
+  if (bloomFilter_ == otherBloom->bloomFilter_) {
+    return true;
+  }
+  std::string bits(bloomFilter_->serializedSize(), '\0');
+  bloomFilter_->serialize(bits.data());
+  std::string otherBits(otherBloom->bloomFilter_->serializedSize(), '\0');
+  otherBloom->bloomFilter_->serialize(otherBits.data());
+  return bits == otherBits;
+}
+
 folly::dynamic MultiRange::serialize() const {
   auto obj = Filter::serializeBase("MultiRange");
   obj["nanAllowed"] = nanAllowed_;
@@ -768,10 +806,10 @@ BigintValuesUsingBitmask::BigintValuesUsingBitmask(
   VELOX_CHECK(min < max, "min must be less than max");
   VELOX_CHECK(values.size() > 1, "values must contain at least 2 entries");
 
-  bitmask_.resize(max - min + 1);
+  bitmask_.resize(bits::nwords(max - min + 1));
 
   for (int64_t value : values) {
-    bitmask_[value - min] = true;
+    bits::setBit(bitmask_.data(), value - min);
   }
 }
 
@@ -779,16 +817,38 @@ bool BigintValuesUsingBitmask::testInt64(int64_t value) const {
   if (value < min_ || value > max_) {
     return false;
   }
-  return bitmask_[value - min_];
+  return isSet(value - min_);
+}
+
+xsimd::batch_bool<int64_t> BigintValuesUsingBitmask::testValues(
+    xsimd::batch<int64_t> x) const {
+  const auto min = xsimd::broadcast<int64_t>(min_);
+  const auto inRange = (x >= min) & (x <= xsimd::broadcast<int64_t>(max_));
+  if (simd::toBitMask(inRange) == 0) {
+    return inRange;
+  }
+  // Lanes out of range read the first word and are masked off below.
+  const auto offsets =
+      xsimd::select(inRange, x - min, xsimd::broadcast<int64_t>(0));
+  const auto words = simd::gather(
+      reinterpret_cast<const int64_t*>(bitmask_.data()), offsets >> 6);
+  const auto bits = (words >> (offsets & 63)) & 1;
+  return inRange & (bits != xsimd::broadcast<int64_t>(0));
+}
+
+xsimd::batch_bool<int32_t> BigintValuesUsingBitmask::testValues(
+    xsimd::batch<int32_t> x) const {
+  auto first = simd::toBitMask(testValues(simd::getHalf<int64_t, 0>(x)));
+  auto second = simd::toBitMask(testValues(simd::getHalf<int64_t, 1>(x)));
+  return simd::fromBitMask<int32_t>(
+      first | (second << xsimd::batch<int64_t>::size));
 }
 
 std::vector<int64_t> BigintValuesUsingBitmask::values() const {
   std::vector<int64_t> values;
-  for (int i = 0; i < bitmask_.size(); i++) {
-    if (bitmask_[i]) {
-      values.push_back(min_ + i);
-    }
-  }
+  bits::forEachSetBit(bitmask_.data(), 0, max_ - min_ + 1, [&](auto i) {
+    values.push_back(min_ + i);
+  });
   return values;
 }
 
@@ -1228,8 +1288,92 @@ int compareRanges(const char* lhs, size_t length, const std::string& rhs) {
   }
   return length - rhs.size();
 }
+
+// Calls 'testWord(begin, end, word)' for each run of up to 64 values that has
+// a bit set in 'passed'. 'word' is the word of 'passed' for the run, bit 0
+// being 'begin'. 'testWord' returns a mask with a bit set for each value in
+// [begin, end) that passes. Clears the bits of the values that fail.
+template <typename TestWord>
+void testStringViewWords(
+    int32_t numValues,
+    uint64_t* passed,
+    TestWord testWord) {
+  for (int32_t begin = 0; begin < numValues; begin += 64) {
+    auto& word = passed[begin / 64];
+    if (!word) {
+      continue;
+    }
+    const auto end = std::min(begin + 64, numValues);
+    auto mask = testWord(begin, end, word);
+    if (end - begin < 64) {
+      mask |= bits::highMask(64 - (end - begin));
+    }
+    word &= mask;
+  }
+}
+
+// Returns the prefix of 'value' as BytesRange::bigEndianPrefix() does without
+// accessing the out of line part of 'value'.
+inline uint32_t bigEndianPrefix(const StringView& value) {
+  return folly::Endian::big(
+      static_cast<uint32_t>(value.sizeAndPrefixAsInt64() >> 32));
+}
 } // namespace
 
+void Filter::testStringViews(
+    const StringView* values,
+    int32_t numValues,
+    uint64_t* passed) const {
+  bits::forEachSetBit(passed, 0, numValues, [&](auto i) {
+    if (!testBytes(values[i].data(), values[i].size())) {
+      bits::clearBit(passed, i);
+    }
+  });
+}
+
+// static
+uint32_t BytesRange::bigEndianPrefix(const std::string& value) {
+  uint32_t prefix = 0;
+  memcpy(&prefix, value.data(), std::min<size_t>(value.size(), 4));
+  return folly::Endian::big(prefix);
+}
+
+void BytesRange::testStringViews(
+    const StringView* values,
+    int32_t numValues,
+    uint64_t* passed) const {
+  testStringViewWords(
+      numValues, passed, [&](int32_t begin, int32_t end, uint64_t word) {
+        // A value whose zero padded prefix is strictly between the prefixes
+        // of the bounds passes and one whose prefix is strictly outside of
+        // them fails. Only values with the prefix of a bound need a full
+        // comparison. This loop does not branch and is vectorized.
+        uint64_t inside = 0;
+        uint64_t onBound = 0;
+        for (auto i = begin; i < end; ++i) {
+          const auto prefix = bigEndianPrefix(values[i]);
+          const bool aboveLower = lowerUnbounded_ || prefix > lowerPrefix_;
+          const bool belowUpper = upperUnbounded_ || prefix < upperPrefix_;
+          const bool atLower = !lowerUnbounded_ && prefix == lowerPrefix_;
+          const bool atUpper = !upperUnbounded_ && prefix == upperPrefix_;
+          inside |= static_cast<uint64_t>(aboveLower && belowUpper)
+              << (i - begin);
+          onBound |= static_cast<uint64_t>(
+                         (atLower && (belowUpper || atUpper)) ||
+                         (atUpper && aboveLower))
+              << (i - begin);
+        }
+        onBound &= word;
+        bits::forEachSetBit(&onBound, 0, end - begin, [&](auto i) {
+          const auto& value = values[begin + i];
+          if (testBytes(value.data(), value.size())) {
+            inside |= 1UL << i;
+          }
+        });
+        return inside;
+      });
+}
+
 bool BytesRange::testBytes(const char* value, int32_t length) const {
   if (length == 0) {
     // Empty string. value is null. This is the smallest possible string.
@@ -1360,6 +1504,68 @@ std::unique_ptr<Filter> NegatedBytesRange::toMultiRange() const {
   return std::make_unique<MultiRange>(std::move(accepted), nullAllowed_, false);
 }
 
+void BytesValues::initializeHeaders() {
+  if (values_.size() > kMaxLinearHeaders) {
+    for (const auto& value : values_) {
+      headerSet_.insert(StringView(value).sizeAndPrefixAsInt64());
+    }
+    return;
+  }
+  for (const auto& value : values_) {
+    headers_.push_back(StringView(value).sizeAndPrefixAsInt64());
+  }
+  constexpr auto kBatchSize = xsimd::batch<int64_t>::size;
+  headers_.resize(bits::roundUp(headers_.size(), kBatchSize), headers_[0]);
+}
+
+bool BytesValues::testHeader(int64_t header) const {
+  if (headers_.empty()) {
+    return headerSet_.contains(header);
+  }
+  const auto target = xsimd::broadcast<int64_t>(header);
+  for (size_t i = 0; i < headers_.size(); i += xsimd::batch<int64_t>::size) {
+    if (xsimd::any(
+            xsimd::batch<int64_t>::load_unaligned(headers_.data() + i) ==
+            target)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void BytesValues::testStringViews(
+    const StringView* values,
+    int32_t numValues,
+    uint64_t* passed) const {
+  testStringViewWords(
+      numValues, passed, [&](int32_t begin, int32_t end, uint64_t word) {
+        uint64_t result = 0;
+        bits::forEachSetBit(&word, 0, end - begin, [&](auto i) {
+          const auto& value = values[begin + i];
+          if (!testHeader(value.sizeAndPrefixAsInt64())) {
+            return;
+          }
+          // The header has the whole value if it is not longer than the
+          // prefix.
+          if (value.size() <= StringView::kPrefixSize ||
+              values_.contains(
+                  folly::StringPiece(value.data(), value.size()))) {
+            result |= 1UL << i;
+          }
+        });
+        return result;
+      });
+}
+
+void NegatedBytesValues::testStringViews(
+    const StringView* values,
+    int32_t numValues,
+    uint64_t* passed) const {
+  std::vector<uint64_t> inList(passed, passed + bits::nwords(numValues));
+  nonNegated_->testStringViews(values, numValues, inList.data());
+  bits::andWithNegatedBits(passed, inList.data(), 0, numValues);
+}
+
 bool NegatedBytesValues::testBytesRange(
     std::optional<std::string_view> min,
     std::optional<std::string_view> max,
@@ -1479,6 +1685,27 @@ bool MultiRange::testBytes(const char* value, int32_t length) const {
   return false;
 }
 
+void MultiRange::testStringViews(
+    const StringView* values,
+    int32_t numValues,
+    uint64_t* passed) const {
+  const auto numWords = bits::nwords(numValues);
+  // Values that no filter has passed so far.
+  std::vector<uint64_t> remaining(passed, passed + numWords);
+  std::vector<uint64_t> filterPassed(numWords);
+  bits::fillBits(passed, 0, numValues, false);
+  for (const auto& filter : filters_) {
+    std::copy(remaining.begin(), remaining.end(), filterPassed.begin());
+    filter->testStringViews(values, numValues, filterPassed.data());
+    bits::orBits(passed, filterPassed.data(), 0, numValues);
+    bits::andWithNegatedBits(
+        remaining.data(), filterPassed.data(), 0, numValues);
+    if (bits::isAllSet(remaining.data(), 0, numValues, false)) {
+      break;
+    }
+  }
+}
+
 bool MultiRange::testTimestamp(Timestamp timestamp) const {
   for (const auto& filter : filters_) {
     if (filter->testTimestamp(timestamp)) {
@@ -1541,6 +1768,7 @@ std::unique_ptr<Filter> MultiRange::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
     case FilterKind::kNegatedBytesRange:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
@@ -1651,6 +1879,7 @@ std::unique_ptr<Filter> BoolValue::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<BoolValue>(value_, false);
@@ -1820,6 +2049,7 @@ std::unique_ptr<Filter> BigintRange::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<BigintRange>(lower_, upper_, false);
@@ -1887,6 +2117,7 @@ std::unique_ptr<Filter> TimestampRange::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return this->clone(false);
@@ -1914,6 +2145,7 @@ std::unique_ptr<Filter> NegatedBigintRange::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return this->clone(false);
@@ -2007,6 +2239,7 @@ std::unique_ptr<Filter> BigintValuesUsingHashTable::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<BigintValuesUsingHashTable>(*this, false);
@@ -2098,6 +2331,7 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<BigintValuesUsingBitmask>(*this, false);
@@ -2133,7 +2367,7 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
         auto min = std::max(min_, range->lower());
         auto max = std::min(max_, range->upper());
         for (auto i = min; i <= max; ++i) {
-          if (bitmask_[i - min_] && range->testInt64(i)) {
+          if (isSet(i - min_) && range->testInt64(i)) {
             valuesToKeep.push_back(i);
           }
         }
@@ -2160,7 +2394,7 @@ std::unique_ptr<Filter> BigintValuesUsingBitmask::mergeWith(
 
   std::vector<int64_t> valuesToKeep;
   for (auto i = min; i <= max; ++i) {
-    if (bitmask_[i - min_] && other->testInt64(i)) {
+    if (isSet(i - min_) && other->testInt64(i)) {
       valuesToKeep.push_back(i);
     }
   }
@@ -2181,6 +2415,7 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingHashTable::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<NegatedBigintValuesUsingHashTable>(*this, false);
@@ -2220,6 +2455,7 @@ std::unique_ptr<Filter> NegatedBigintValuesUsingBitmask::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return std::make_unique<NegatedBigintValuesUsingBitmask>(*this, false);
@@ -2255,6 +2491,7 @@ std::unique_ptr<Filter> BigintMultiRange::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull: {
       std::vector<std::unique_ptr<BigintRange>> ranges;
@@ -2336,6 +2573,7 @@ std::unique_ptr<Filter> BytesRange::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return this->clone(false);
@@ -2415,6 +2653,7 @@ std::unique_ptr<Filter> NegatedBytesRange::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
       return this->clone(false);
@@ -2437,6 +2676,7 @@ std::unique_ptr<Filter> BytesValues::mergeWith(const Filter* other) const {
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
     case FilterKind::kMultiRange:
       return other->mergeWith(this);
     case FilterKind::kIsNotNull:
@@ -2549,6 +2789,7 @@ std::unique_ptr<Filter> NegatedBytesValues::mergeWith(
     case FilterKind::kAlwaysTrue:
     case FilterKind::kAlwaysFalse:
     case FilterKind::kIsNull:
+    case FilterKind::kBloomFilter:
     case FilterKind::kBytesValues:
     case FilterKind::kNegatedBytesRange:
     case FilterKind::kMultiRange:
@@ -2644,4 +2885,75 @@ std::unique_ptr<Filter> NegatedBytesValues::mergeWith(
       VELOX_UNREACHABLE();
   }
 }
+
+bool ValuesUsingBloomFilter::testInt64Range(
+    int64_t min,
+    int64_t max,
+    bool hasNull) const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+
+  if (filter_ && !filter_->testInt64Range(min, max, false)) {
+    return false;
+  }
+
+  if (min == max) {
+    return testInt64(min);
+  }
+
+  return true;
+}
+
+bool ValuesUsingBloomFilter::testBytesRange(
+    std::optional<std::string_view> min,
+    std::optional<std::string_view> max,
+    bool hasNull) const {
+  if (hasNull && nullAllowed_) {
+    return true;
+  }
+
+  if (filter_ && !filter_->testBytesRange(min, max, false)) {
+    return false;
+  }
+
+  if (min.has_value() && max.has_value() && min.value() == max.value()) {
+    return testBytes(min->data(), min->length());
+  }
+
+  return true;
+}
+
+std::unique_ptr<Filter> ValuesUsingBloomFilter::mergeWith(
+    const Filter* other) const {
+  switch (other->kind()) {
+    case FilterKind::kAlwaysTrue:
+    case FilterKind::kAlwaysFalse:
+    case FilterKind::kIsNull:
+      return other->mergeWith(this);
+    case FilterKind::kIsNotNull:
+      return this->clone(false);
+    default: {
+      // The Bloom filter cannot be combined with 'other' into a single exact
+      // filter. Keep it on top of the AND of 'filter_' and 'other'.
+      bool bothNullAllowed = nullAllowed_ && other->testNull();
+      auto merged = filter_ ? filter_->mergeWith(other) : other->clone();
+      if (merged->kind() == FilterKind::kAlwaysFalse ||
+          merged->kind() == FilterKind::kIsNull) {
+        return nullOrFalse(bothNullAllowed);
+      }
+      return std::make_unique<ValuesUsingBloomFilter>(
+          bloomFilter_, bothNullAllowed, std::move(merged));
+    }
+  }
+}
+
+std::string ValuesUsingBloomFilter::toString() const {
+  return fmt::format(
+      "ValuesUsingBloomFilter: [{} bytes{}{}] {}",
+      bloomFilter_->serializedSize(),
+      filter_ ? " AND " : "",
+      filter_ ? filter_->toString() : "",
+      nullAllowed_ ? "with nulls" : "no nulls");
+}
 } // namespace facebook::velox::common
@@ -24,7 +24,9 @@
 
 #include <folly/Range.h>
 #include <folly/container/F14Set.h>
+#include <folly/hash/Hash.h>
 
+#include "velox/common/base/BloomFilter.h"
 #include "velox/common/base/Exceptions.h"
 #include "velox/common/base/SimdUtil.h"
 #include "velox/common/serialization/Serializable.h"
@@ -56,6 +58,7 @@ enum class FilterKind {
   kHugeintRange,
   kTimestampRange,
   kHugeintValuesUsingHashTable,
+  kBloomFilter,
 };
 
 class Filter;
@@ -221,6 +224,15 @@ class Filter : public velox::ISerializable {
         lengths, [this](int32_t x) { return testLength(x); });
   }
 
+  /// Tests 'numValues' strings at a time. On input, 'passed' has a bit set
+  /// for each value to test. On return, the bits of the values that fail are
+  /// cleared. Bits past 'numValues' are not changed. The default
+  /// implementation calls testBytes() for each value.
+  virtual void testStringViews(
+      const StringView* values,
+      int32_t numValues,
+      uint64_t* passed) const;
+
   // Returns true if at least one value in the specified range can pass the
   // filter. The range is defined as all values between min and max inclusive
   // plus null if hasNull is true.
@@ -1060,6 +1072,16 @@ class BigintValuesUsingBitmask final : public Filter {
 
   bool testInt64(int64_t value) const final;
 
+  /// Tests the lanes with a gather of the bitmask words. Large IN lists over
+  /// a dense range are common in rewritten queries.
+  xsimd::batch_bool<int64_t> testValues(xsimd::batch<int64_t>) const final;
+
+  xsimd::batch_bool<int32_t> testValues(xsimd::batch<int32_t>) const final;
+
+  xsimd::batch_bool<int16_t> testValues(xsimd::batch<int16_t> x) const final {
+    return Filter::testValues(x);
+  }
+
   bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
 
   std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
@@ -1070,7 +1092,12 @@ class BigintValuesUsingBitmask final : public Filter {
   std::unique_ptr<Filter>
   mergeWith(int64_t min, int64_t max, const Filter* other) const;
 
-  std::vector<bool> bitmask_;
+  bool isSet(int64_t offset) const {
+    return bits::isBitSet(bitmask_.data(), offset);
+  }
+
+  // Bit i is set if min_ + i passes.
+  std::vector<uint64_t> bitmask_;
   const int64_t min_;
   const int64_t max_;
 };
@@ -1197,6 +1224,14 @@ class NegatedBigintValuesUsingBitmask final : public Filter {
     return !nonNegated_->testInt64(value);
   }
 
+  xsimd::batch_bool<int64_t> testValues(xsimd::batch<int64_t> x) const final {
+    return ~nonNegated_->testValues(x);
+  }
+
+  xsimd::batch_bool<int32_t> testValues(xsimd::batch<int32_t> x) const final {
+    return ~nonNegated_->testValues(x);
+  }
+
   bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
 
   std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
@@ -1570,7 +1605,9 @@ class BytesRange final : public AbstractRange {
         upper_(upper),
         singleValue_(
             !lowerExclusive_ && !upperExclusive_ && !lowerUnbounded_ &&
-            !upperUnbounded_ && lower_ == upper_) {
+            !upperUnbounded_ && lower_ == upper_),
+        lowerPrefix_(bigEndianPrefix(lower_)),
+        upperPrefix_(bigEndianPrefix(upper_)) {
     // Always-true filters should be specified using AlwaysTrue.
     VELOX_CHECK(!lowerUnbounded_ || !upperUnbounded_);
   }
@@ -1585,7 +1622,9 @@ class BytesRange final : public AbstractRange {
             FilterKind::kBytesRange),
         lower_(other.lower_),
         upper_(other.upper_),
-        singleValue_(other.singleValue_) {}
+        singleValue_(other.singleValue_),
+        lowerPrefix_(other.lowerPrefix_),
+        upperPrefix_(other.upperPrefix_) {}
 
   folly::dynamic serialize() const override;
 
@@ -1612,6 +1651,13 @@ class BytesRange final : public AbstractRange {
 
   bool testBytes(const char* value, int32_t length) const final;
 
+  /// Decides most values from the prefixes inlined in the StringViews and
+  /// only compares the full strings if a prefix equals a prefix of a bound.
+  void testStringViews(
+      const StringView* values,
+      int32_t numValues,
+      uint64_t* passed) const final;
+
   bool testBytesRange(
       std::optional<std::string_view> min,
       std::optional<std::string_view> max,
@@ -1656,9 +1702,16 @@ class BytesRange final : public AbstractRange {
   bool testingEquals(const Filter& other) const final;
 
  private:
+  // Returns the first 4 bytes of 'value' padded with zeros as a big-endian
+  // integer, so that comparing the integers orders the prefixes like the
+  // strings.
+  static uint32_t bigEndianPrefix(const std::string& value);
+
   const std::string lower_;
   const std::string upper_;
   const bool singleValue_;
+  const uint32_t lowerPrefix_;
+  const uint32_t upperPrefix_;
 };
 
 // Negated range filter for strings
@@ -1856,6 +1909,7 @@ class BytesValues final : public Filter {
 
     lower_ = *std::min_element(values_.begin(), values_.end());
     upper_ = *std::max_element(values_.begin(), values_.end());
+    initializeHeaders();
   }
 
   BytesValues(const BytesValues& other, bool nullAllowed)
@@ -1863,7 +1917,9 @@ class BytesValues final : public Filter {
         lower_(other.lower_),
         upper_(other.upper_),
         values_(other.values_),
-        lengths_(other.lengths_) {}
+        lengths_(other.lengths_),
+        headers_(other.headers_),
+        headerSet_(other.headerSet_) {}
 
   folly::dynamic serialize() const override;
 
@@ -1884,9 +1940,16 @@ class BytesValues final : public Filter {
 
   bool testBytes(const char* value, int32_t length) const final {
     return lengths_.contains(length) &&
-        values_.contains(std::string(value, length));
+        values_.contains(folly::StringPiece(value, length));
   }
 
+  /// Tests the size and prefix inlined in each StringView against those of
+  /// the values first, so that most misses do not touch the string bodies.
+  void testStringViews(
+      const StringView* values,
+      int32_t numValues,
+      uint64_t* passed) const final;
+
   bool testBytesRange(
       std::optional<std::string_view> min,
       std::optional<std::string_view> max,
@@ -1901,10 +1964,25 @@ class BytesValues final : public Filter {
   bool testingEquals(const Filter& other) const final;
 
  private:
+  // Up to this many values, headers are compared with SIMD instead of looked
+  // up in 'headerSet_'.
+  static constexpr int32_t kMaxLinearHeaders = 16;
+
+  void initializeHeaders();
+
+  // Returns true if a value in 'values_' has the size and prefix in 'header'.
+  bool testHeader(int64_t header) const;
+
   std::string lower_;
   std::string upper_;
   folly::F14FastSet<std::string> values_;
   folly::F14FastSet<uint32_t> lengths_;
+  // The first 8 bytes of a StringView of each of 'values_', i.e. size and
+  // prefix. Padded to a multiple of the SIMD width by repeating the first
+  // header. Empty if there are more than kMaxLinearHeaders values.
+  std::vector<int64_t> headers_;
+  // Same as 'headers_' if there are more than kMaxLinearHeaders values.
+  folly::F14FastSet<int64_t> headerSet_;
 };
 
 /// Represents a combination of two of more range filters on integral types with
@@ -1991,6 +2069,11 @@ class NegatedBytesValues final : public Filter {
     return !nonNegated_->testBytes(value, length);
   }
 
+  void testStringViews(
+      const StringView* values,
+      int32_t numValues,
+      uint64_t* passed) const final;
+
   bool testBytesRange(
       std::optional<std::string_view> min,
       std::optional<std::string_view> max,
@@ -2008,6 +2091,99 @@ class NegatedBytesValues final : public Filter {
   std::unique_ptr<BytesValues> nonNegated_;
 };
 
+/// Approximate IN-list filter for integral and string data types backed by a
+/// Bloom filter over the hashes of the values. Used for dynamic filters
+/// produced by hash join build sides with too many distinct keys for an exact
+/// IN-list. May pass values that are not in the set, never fails values that
+/// are. May be combined with an exact filter on the same column, e.g. a range
+/// from the query, in which case both must pass.
+class ValuesUsingBloomFilter final : public Filter {
+ public:
+  /// @param bloomFilter Bloom filter over hashInt64() or hashBytes() of the
+  /// values that pass the filter. Shared between the copies of 'this'.
+  /// @param nullAllowed Null values are passing the filter if true.
+  /// @param filter Optional exact filter which must also pass.
+  ValuesUsingBloomFilter(
+      std::shared_ptr<const BloomFilter<>> bloomFilter,
+      bool nullAllowed,
+      std::unique_ptr<Filter> filter = nullptr)
+      : Filter(true, nullAllowed, FilterKind::kBloomFilter),
+        bloomFilter_(std::move(bloomFilter)),
+        filter_(std::move(filter)) {
+    VELOX_CHECK_NOT_NULL(bloomFilter_);
+  }
+
+  ValuesUsingBloomFilter(const ValuesUsingBloomFilter& other, bool nullAllowed)
+      : Filter(true, nullAllowed, FilterKind::kBloomFilter),
+        bloomFilter_(other.bloomFilter_),
+        filter_(other.filter_ ? other.filter_->clone() : nullptr) {}
+
+  /// Hash functions to use for building the Bloom filter.
+  static uint64_t hashInt64(int64_t value) {
+    return folly::hasher<int64_t>()(value);
+  }
+
+  static uint64_t hashBytes(const char* value, int32_t length) {
+    return bits::hashBytes(kBytesSeed, value, length);
+  }
+
+  folly::dynamic serialize() const override;
+
+  static FilterPtr create(const folly::dynamic& obj);
+
+  std::unique_ptr<Filter> clone(
+      std::optional<bool> nullAllowed = std::nullopt) const final {
+    return std::make_unique<ValuesUsingBloomFilter>(
+        *this, nullAllowed.value_or(nullAllowed_));
+  }
+
+  bool testInt64(int64_t value) const final {
+    return (!filter_ || filter_->testInt64(value)) &&
+        bloomFilter_->mayContain(hashInt64(value));
+  }
+
+  bool testBytes(const char* value, int32_t length) const final {
+    return (!filter_ || filter_->testBytes(value, length)) &&
+        bloomFilter_->mayContain(hashBytes(value, length));
+  }
+
+  bool hasTestLength() const final {
+    return filter_ && filter_->hasTestLength();
+  }
+
+  bool testLength(int32_t length) const final {
+    return !hasTestLength() || filter_->testLength(length);
+  }
+
+  bool testInt64Range(int64_t min, int64_t max, bool hasNull) const final;
+
+  bool testBytesRange(
+      std::optional<std::string_view> min,
+      std::optional<std::string_view> max,
+      bool hasNull) const final;
+
+  std::unique_ptr<Filter> mergeWith(const Filter* other) const final;
+
+  const std::shared_ptr<const BloomFilter<>>& bloomFilter() const {
+    return bloomFilter_;
+  }
+
+  /// Returns the exact filter combined with 'this' or nullptr if none.
+  const Filter* filter() const {
+    return filter_.get();
+  }
+
+  std::string toString() const override;
+
+  bool testingEquals(const Filter& other) const final;
+
+ private:
+  static constexpr uint64_t kBytesSeed = 1;
+
+  const std::shared_ptr<const BloomFilter<>> bloomFilter_;
+  const std::unique_ptr<Filter> filter_;
+};
+
 /// Represents a combination of two of more filters with
 /// OR semantics. The filter passes if at least one of the contained filters
 /// passes.
@@ -2041,6 +2217,12 @@ class MultiRange final : public Filter {
 
   bool testBytes(const char* value, int32_t length) const final;
 
+  /// Tests each value only against the filters that have not passed it yet.
+  void testStringViews(
+      const StringView* values,
+      int32_t numValues,
+      uint64_t* passed) const final;
+
   bool testTimestamp(Timestamp value) const final;
 
   bool testLength(int32_t length) const final;
@@ -250,11 +250,15 @@ struct StringView {
       const int32_t* indices,
       int32_t numStrings);
 
- private:
+  /// Returns the size and the first 4 bytes of the string as one word. The
+  /// prefix is zero padded for strings shorter than 4, so that two strings
+  /// have the same word only if their sizes and prefixes are equal.
   inline int64_t sizeAndPrefixAsInt64() const {
     return reinterpret_cast<const int64_t*>(this)[0];
   }
 
+ private:
+
   inline int64_t inlinedAsInt64() const {
     return reinterpret_cast<const int64_t*>(this)[1];
   }
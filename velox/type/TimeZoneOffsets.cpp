@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/type/TimeZoneOffsets.h"
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <xsimd/xsimd.hpp>
+
+namespace facebook::velox {
+namespace {
+
+// UTC offsets of the tz database are well within a day, so the UTC time of a
+// local time is within a day of it.
+constexpr int64_t kMaxOffset = 86'400;
+
+date::sys_seconds toSys(int64_t seconds) {
+  return date::sys_seconds(std::chrono::seconds(seconds));
+}
+
+} // namespace
+
+TimeZoneOffsets::TimeZoneOffsets(const date::time_zone& zone) : zone_(zone) {
+  auto info = zone_.get_info(toSys(kMinSeconds));
+  begins_.push_back(kMinSeconds);
+  offsets_.push_back(info.offset.count());
+  while (info.end.time_since_epoch().count() < kMaxSeconds) {
+    const auto begin = info.end.time_since_epoch().count();
+    info = zone_.get_info(info.end);
+    // Transitions that only change the abbreviation or the DST flag do not
+    // start a new interval.
+    if (info.offset.count() != offsets_.back()) {
+      begins_.push_back(begin);
+      offsets_.push_back(info.offset.count());
+    }
+  }
+}
+
+// static
+const TimeZoneOffsets& TimeZoneOffsets::get(const date::time_zone& zone) {
+  thread_local const TimeZoneOffsets* lastUsed = nullptr;
+  if (lastUsed != nullptr && &lastUsed->zone_ == &zone) {
+    return *lastUsed;
+  }
+  static std::mutex mutex;
+  static auto* tables = new std::unordered_map<
+      const date::time_zone*,
+      std::unique_ptr<TimeZoneOffsets>>();
+  std::lock_guard<std::mutex> l(mutex);
+  auto& table = (*tables)[&zone];
+  if (!table) {
+    table = std::make_unique<TimeZoneOffsets>(zone);
+  }
+  lastUsed = table.get();
+  return *lastUsed;
+}
+
+int64_t TimeZoneOffsets::toUtc(int64_t localSeconds) const {
+  if (localSeconds >= kMinSeconds + kMaxOffset &&
+      localSeconds < kMaxSeconds - kMaxOffset) {
+    const auto first = intervalOf(localSeconds - kMaxOffset);
+    const auto last = intervalOf(localSeconds + kMaxOffset);
+    // Intervals are in time order, so the first match from the end is the
+    // latest instant.
+    for (auto i = last; i >= first; --i) {
+      const auto utcSeconds = localSeconds - offsets_[i];
+      if (utcSeconds >= begins_[i] && utcSeconds < intervalEnd(i)) {
+        return utcSeconds;
+      }
+    }
+    // 'localSeconds' falls in the gap left by a transition that moves the
+    // clock forward.
+    for (auto i = last; i > first; --i) {
+      if (localSeconds >= begins_[i] + offsets_[i - 1] &&
+          localSeconds < begins_[i] + offsets_[i]) {
+        return begins_[i];
+      }
+    }
+  }
+  return zone_
+      .to_sys(
+          date::local_seconds(std::chrono::seconds(localSeconds)),
+          date::choose::latest)
+      .time_since_epoch()
+      .count();
+}
+
+void TimeZoneOffsets::toLocal(
+    const int64_t* utcSeconds,
+    int32_t numValues,
+    int64_t* result) const {
+  using Batch = xsimd::batch<int64_t>;
+  int32_t row = 0;
+  while (row < numValues) {
+    const auto value = utcSeconds[row];
+    if (value < kMinSeconds || value >= kMaxSeconds) {
+      result[row++] = toLocal(value);
+      continue;
+    }
+    const auto interval = intervalOf(value);
+    const auto begin = begins_[interval];
+    const auto end = intervalEnd(interval);
+    const auto offset = offsets_[interval];
+    const auto beginBatch = xsimd::broadcast<int64_t>(begin);
+    const auto endBatch = xsimd::broadcast<int64_t>(end);
+    const auto offsetBatch = xsimd::broadcast<int64_t>(offset);
+    for (; row + Batch::size <= numValues; row += Batch::size) {
+      const auto values = Batch::load_unaligned(utcSeconds + row);
+      if (!xsimd::all((values >= beginBatch) & (values < endBatch))) {
+        break;
+      }
+      (values + offsetBatch).store_unaligned(result + row);
+    }
+    for (; row < numValues && utcSeconds[row] >= begin &&
+         utcSeconds[row] < end;
+         ++row) {
+      result[row] = utcSeconds[row] + offset;
+    }
+  }
+}
+
+} // namespace facebook::velox
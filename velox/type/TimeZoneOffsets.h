@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "velox/external/date/tz.h"
+
+namespace facebook::velox {
+
+/// Table of the UTC offsets of a time zone between kMinSeconds and
+/// kMaxSeconds. Converting a timestamp in this range is a binary search over
+/// the offset transitions instead of a walk over the rules of the tz
+/// database. Timestamps outside of the range are converted by the zone
+/// itself.
+class TimeZoneOffsets {
+ public:
+  /// 1900-01-01 00:00:00 UTC.
+  static constexpr int64_t kMinSeconds = -2'208'988'800;
+  /// 2100-01-01 00:00:00 UTC.
+  static constexpr int64_t kMaxSeconds = 4'102'444'800;
+
+  explicit TimeZoneOffsets(const date::time_zone& zone);
+
+  /// Returns the table for 'zone'. Tables are built on first use and live for
+  /// the life of the process. The last table used by the calling thread is
+  /// returned without locking.
+  static const TimeZoneOffsets& get(const date::time_zone& zone);
+
+  const date::time_zone& zone() const {
+    return zone_;
+  }
+
+  /// Returns the offset from UTC of the zone at 'utcSeconds', in seconds.
+  int64_t offsetAt(int64_t utcSeconds) const {
+    if (utcSeconds < kMinSeconds || utcSeconds >= kMaxSeconds) {
+      return zone_
+          .get_info(date::sys_seconds(std::chrono::seconds(utcSeconds)))
+          .offset.count();
+    }
+    return offsets_[intervalOf(utcSeconds)];
+  }
+
+  /// Returns the local time in the zone at 'utcSeconds'. Same as
+  /// date::time_zone::to_local().
+  int64_t toLocal(int64_t utcSeconds) const {
+    return utcSeconds + offsetAt(utcSeconds);
+  }
+
+  /// Returns the UTC time of the local time 'localSeconds' in the zone. Same
+  /// as date::time_zone::to_sys() with date::choose::latest: an ambiguous
+  /// local time resolves to the later instant and a local time skipped by a
+  /// transition resolves to the transition.
+  int64_t toUtc(int64_t localSeconds) const;
+
+  /// Batch version of toLocal(). Runs of values that fall between the same
+  /// two transitions are converted a SIMD batch at a time.
+  void toLocal(const int64_t* utcSeconds, int32_t numValues, int64_t* result)
+      const;
+
+ private:
+  // Returns the index of the interval that contains 'utcSeconds', which must
+  // be in [kMinSeconds, kMaxSeconds).
+  int32_t intervalOf(int64_t utcSeconds) const {
+    return std::upper_bound(begins_.begin(), begins_.end(), utcSeconds) -
+        begins_.begin() - 1;
+  }
+
+  int64_t intervalEnd(int32_t interval) const {
+    return interval + 1 < static_cast<int32_t>(begins_.size())
+        ? begins_[interval + 1]
+        : kMaxSeconds;
+  }
+
+  const date::time_zone& zone_;
+
+  // First second of each interval with a constant offset. begins_[0] is
+  // kMinSeconds and the last interval ends at kMaxSeconds.
+  std::vector<int64_t> begins_;
+
+  // Offset from UTC in seconds of each interval.
+  std::vector<int64_t> offsets_;
+};
+
+} // namespace facebook::velox
@@ -17,6 +17,7 @@
 #include <chrono>
 #include "velox/common/base/Exceptions.h"
 #include "velox/external/date/tz.h"
+#include "velox/type/TimeZoneOffsets.h"
 #include "velox/type/tz/TimeZoneMap.h"
 
 namespace facebook::velox {
@@ -51,11 +52,7 @@ void Timestamp::toGMT(const date::time_zone& zone) {
     VELOX_UNSUPPORTED(
         "Timestamp out of bound for time zone adjustment {} seconds", seconds_);
   }
-  date::local_time<std::chrono::seconds> localTime{
-      std::chrono::seconds(seconds_)};
-  std::chrono::time_point<std::chrono::system_clock, std::chrono::seconds>
-      sysTime = zone.to_sys(localTime, date::choose::latest);
-  seconds_ = sysTime.time_since_epoch().count();
+  seconds_ = TimeZoneOffsets::get(zone).toUtc(seconds_);
 }
 
 void Timestamp::toGMT(int16_t tzID) {
@@ -101,6 +98,11 @@ Timestamp::toTimePoint() const {
 }
 
 void Timestamp::toTimezone(const date::time_zone& zone) {
+  if (seconds_ >= TimeZoneOffsets::kMinSeconds &&
+      seconds_ < TimeZoneOffsets::kMaxSeconds) {
+    seconds_ = TimeZoneOffsets::get(zone).toLocal(seconds_);
+    return;
+  }
   auto tp = toTimePoint();
   auto epoch = zone.to_local(tp).time_since_epoch();
   // NOTE: Round down to get the seconds of the current time point.
@@ -156,6 +156,19 @@ TEST_F(FilterSerDeTest, multiFilter) {
   testSerde(multiRange);
 }
 
+TEST_F(FilterSerDeTest, bloomFilter) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(100);
+  for (int64_t i = 0; i < 100; i += 3) {
+    bloomFilter->insert(ValuesUsingBloomFilter::hashInt64(i));
+  }
+
+  testSerde(ValuesUsingBloomFilter(bloomFilter, false));
+  testSerde(ValuesUsingBloomFilter(bloomFilter, true));
+  testSerde(ValuesUsingBloomFilter(
+      bloomFilter, false, std::make_unique<BigintRange>(1, 10, false)));
+}
+
 TEST_F(FilterSerDeTest, timestampFilter) {
   Timestamp hi(100000, 2000);
   Timestamp lo(-123, 99999);
@@ -454,6 +454,36 @@ TEST(FilterTest, bigintValuesUsingBitmask) {
   EXPECT_FALSE(filter->testInt64Range(1234, 2000, false));
 }
 
+TEST(FilterTest, bigintValuesUsingBitmaskSimd) {
+  // A dense IN list with 10K values.
+  std::vector<int64_t> numbers;
+  for (auto i = 0; i < 10'000; ++i) {
+    numbers.push_back(1'000 + i * 3);
+  }
+  auto filter = createBigintValues(numbers, false);
+  ASSERT_TRUE(dynamic_cast<BigintValuesUsingBitmask*>(filter.get()));
+  auto verify = [&](int64_t x) { return filter->testInt64(x); };
+
+  // Include values below, above and at the ends of the range.
+  numbers.push_back(std::numeric_limits<int64_t>::min());
+  numbers.push_back(999);
+  numbers.push_back(1'000 + 10'000 * 3);
+  numbers.push_back(std::numeric_limits<int64_t>::max() - 1);
+  applySimdTestToVector(numbers, *filter, verify);
+
+  std::vector<int32_t> numbers32(numbers.begin(), numbers.end() - 1);
+  applySimdTestToVector(numbers32, *filter, verify);
+
+  auto negated = createNegatedBigintValues({1, 3, 5, 7, 9, 11}, false);
+  ASSERT_TRUE(dynamic_cast<NegatedBigintValuesUsingBitmask*>(negated.get()));
+  auto verifyNegated = [&](int64_t x) { return negated->testInt64(x); };
+  std::vector<int64_t> small;
+  for (auto i = -5; i < 20; ++i) {
+    small.push_back(i);
+  }
+  applySimdTestToVector(small, *negated, verifyNegated);
+}
+
 TEST(FilterTest, negatedBigintValuesUsingBitmask) {
   auto filter = createNegatedBigintValues({1, 6, 1000, 8, 9, 100, 10}, false);
   auto castedFilter =
@@ -1052,6 +1082,62 @@ TEST(FilterTest, multiRange) {
   EXPECT_TRUE(filter->testBytes("abc", 3));
 }
 
+TEST(FilterTest, testStringViews) {
+  std::vector<std::string> strings = {
+      "", "a", "ab", "abc", "abcd", "abcde", "abd", "b", "dragon",
+      "dragonfly", "drought", "z", std::string("ab\0", 3),
+      "a string that is not inlined", "a string that is not inlined either",
+  };
+  for (auto i = 0; i < 20; ++i) {
+    strings.push_back(fmt::format("value {}", i));
+  }
+  // Repeat so that the values span more than one word of bits.
+  std::vector<StringView> values;
+  for (auto i = 0; i < 5; ++i) {
+    for (const auto& string : strings) {
+      values.emplace_back(string);
+    }
+  }
+  const int32_t numValues = values.size();
+
+  std::vector<std::string> manyValues;
+  for (auto i = 0; i < 30; ++i) {
+    manyValues.push_back(fmt::format("value {}", i * 2));
+  }
+  manyValues.push_back("a string that is not inlined");
+
+  std::vector<std::unique_ptr<Filter>> filters;
+  filters.push_back(in({"abc", "dragon", "a string that is not inlined"}));
+  filters.push_back(in(manyValues));
+  filters.push_back(std::make_unique<NegatedBytesValues>(
+      std::vector<std::string>{"ab", "z"}, false));
+  filters.push_back(between("abc", "abcd"));
+  filters.push_back(betweenExclusive("ab", "dragon"));
+  filters.push_back(lessThan(""));
+  filters.push_back(lessThanOrEqual("ab"));
+  filters.push_back(greaterThan("dragon"));
+  filters.push_back(greaterThanOrEqual(""));
+  filters.push_back(between("a string", "a string that is not inlined"));
+  filters.push_back(
+      orFilter(between("abc", "abc"), greaterThanOrEqual("dragon")));
+  filters.push_back(orFilter(lessThan(""), greaterThan("")));
+
+  for (const auto& filter : filters) {
+    SCOPED_TRACE(filter->toString());
+    // Every third value is not tested and its bit must stay unset.
+    std::vector<uint64_t> passed(bits::nwords(numValues));
+    for (auto i = 0; i < numValues; ++i) {
+      bits::setBit(passed.data(), i, i % 3 != 0);
+    }
+    filter->testStringViews(values.data(), numValues, passed.data());
+    for (auto i = 0; i < numValues; ++i) {
+      const bool expected =
+          i % 3 != 0 && filter->testBytes(values[i].data(), values[i].size());
+      ASSERT_EQ(expected, bits::isBitSet(passed.data(), i)) << i;
+    }
+  }
+}
+
 TEST(FilterTest, multiRangeWithNaNs) {
   // x <> 1.2 with nanAllowed true
   auto filter =
@@ -1878,3 +1964,86 @@ TEST(FilterTest, timestampRange) {
   EXPECT_TRUE(filter->testTimestampRange(
       Timestamp(5, 123000000), Timestamp(30, 123000000), true));
 }
+
+TEST(FilterTest, valuesUsingBloomFilter) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(1'000);
+  for (int64_t i = 0; i < 1'000; i += 2) {
+    bloomFilter->insert(ValuesUsingBloomFilter::hashInt64(i));
+  }
+  std::vector<std::string> strings({"Igne", "natura", "renovitur integra."});
+  for (const auto& value : strings) {
+    bloomFilter->insert(
+        ValuesUsingBloomFilter::hashBytes(value.data(), value.size()));
+  }
+
+  ValuesUsingBloomFilter filter(bloomFilter, false);
+  EXPECT_EQ(FilterKind::kBloomFilter, filter.kind());
+  EXPECT_FALSE(filter.testNull());
+  int32_t numFalsePositives = 0;
+  for (int64_t i = 0; i < 1'000; ++i) {
+    if (i % 2 == 0) {
+      EXPECT_TRUE(filter.testInt64(i));
+    } else if (filter.testInt64(i)) {
+      ++numFalsePositives;
+    }
+  }
+  EXPECT_LT(numFalsePositives, 50);
+  for (const auto& value : strings) {
+    EXPECT_TRUE(filter.testBytes(value.data(), value.size()));
+  }
+  EXPECT_FALSE(filter.hasTestLength());
+
+  // Ranges cannot be decided by the Bloom filter unless they are single values.
+  EXPECT_TRUE(filter.testInt64Range(1, 10, false));
+  EXPECT_TRUE(filter.testInt64Range(2, 2, false));
+  EXPECT_TRUE(filter.testBytesRange("apple", "banana", false));
+  EXPECT_TRUE(filter.testBytesRange("natura", "natura", false));
+
+  auto withNulls = filter.clone(true);
+  EXPECT_TRUE(withNulls->testNull());
+  EXPECT_TRUE(withNulls->testInt64(100));
+  EXPECT_TRUE(withNulls->testInt64Range(1'001, 1'001, true));
+}
+
+TEST(FilterTest, mergeWithBloomFilter) {
+  auto bloomFilter = std::make_shared<BloomFilter<>>();
+  bloomFilter->reset(100);
+  for (int64_t i = 0; i < 100; ++i) {
+    bloomFilter->insert(ValuesUsingBloomFilter::hashInt64(i));
+  }
+  ValuesUsingBloomFilter filter(bloomFilter, true);
+
+  // Merging with an exact filter keeps the Bloom filter on top of it.
+  auto range = between(50, 200, false);
+  for (const auto& merged :
+       {filter.mergeWith(range.get()), range->mergeWith(&filter)}) {
+    ASSERT_EQ(FilterKind::kBloomFilter, merged->kind());
+    auto* bloom = static_cast<const ValuesUsingBloomFilter*>(merged.get());
+    ASSERT_NE(nullptr, bloom->filter());
+    EXPECT_EQ(FilterKind::kBigintRange, bloom->filter()->kind());
+    EXPECT_FALSE(merged->testNull());
+    EXPECT_FALSE(merged->testInt64(10));
+    EXPECT_TRUE(merged->testInt64(60));
+    EXPECT_FALSE(merged->testInt64Range(1, 20, false));
+    EXPECT_TRUE(merged->testInt64Range(1, 60, false));
+  }
+
+  // The exact filters are merged with each other.
+  auto disjoint = between(1'000, 2'000, false);
+  EXPECT_EQ(
+      FilterKind::kAlwaysFalse,
+      filter.mergeWith(range.get())->mergeWith(disjoint.get())->kind());
+
+  auto isNotNull = std::make_unique<IsNotNull>();
+  auto merged = isNotNull->mergeWith(&filter);
+  EXPECT_EQ(FilterKind::kBloomFilter, merged->kind());
+  EXPECT_FALSE(merged->testNull());
+
+  auto isNull = std::make_unique<IsNull>();
+  EXPECT_EQ(FilterKind::kIsNull, filter.mergeWith(isNull.get())->kind());
+
+  auto alwaysTrue = std::make_unique<AlwaysTrue>();
+  EXPECT_EQ(
+      FilterKind::kBloomFilter, alwaysTrue->mergeWith(&filter)->kind());
+}
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "velox/type/TimeZoneOffsets.h"
+
+namespace facebook::velox {
+namespace {
+
+int64_t expectedLocal(const date::time_zone& zone, int64_t seconds) {
+  return zone.to_local(date::sys_seconds(std::chrono::seconds(seconds)))
+      .time_since_epoch()
+      .count();
+}
+
+int64_t expectedUtc(const date::time_zone& zone, int64_t seconds) {
+  return zone
+      .to_sys(
+          date::local_seconds(std::chrono::seconds(seconds)),
+          date::choose::latest)
+      .time_since_epoch()
+      .count();
+}
+
+// Values every 15 minutes around the DST transitions of 2021 and the turn of
+// the cached range, plus a few far outside of it.
+std::vector<int64_t> testSeconds() {
+  std::vector<int64_t> seconds;
+  for (int64_t start :
+       {1'615'600'000L,
+        1'636'100'000L,
+        TimeZoneOffsets::kMinSeconds - 100'000,
+        TimeZoneOffsets::kMaxSeconds - 100'000}) {
+    for (auto i = 0; i < 4 * 60; ++i) {
+      seconds.push_back(start + i * 900);
+    }
+  }
+  seconds.push_back(-10'000'000'000L);
+  seconds.push_back(10'000'000'000L);
+  return seconds;
+}
+
+TEST(TimeZoneOffsetsTest, matchesTimeZone) {
+  for (const auto* name :
+       {"America/Los_Angeles",
+        "Europe/London",
+        "Asia/Kolkata",
+        "Australia/Lord_Howe",
+        "UTC"}) {
+    SCOPED_TRACE(name);
+    const auto* zone = date::locate_zone(name);
+    const auto& offsets = TimeZoneOffsets::get(*zone);
+    EXPECT_EQ(&offsets, &TimeZoneOffsets::get(*zone));
+    for (auto seconds : testSeconds()) {
+      ASSERT_EQ(expectedLocal(*zone, seconds), offsets.toLocal(seconds))
+          << seconds;
+      ASSERT_EQ(expectedUtc(*zone, seconds), offsets.toUtc(seconds))
+          << seconds;
+    }
+  }
+}
+
+TEST(TimeZoneOffsetsTest, batch) {
+  const auto* zone = date::locate_zone("America/New_York");
+  const auto& offsets = TimeZoneOffsets::get(*zone);
+  auto seconds = testSeconds();
+  // Unsorted values with short runs.
+  const auto numSorted = seconds.size();
+  for (size_t i = 0; i < numSorted; i += 7) {
+    seconds.push_back(seconds[i]);
+  }
+  std::vector<int64_t> result(seconds.size());
+  offsets.toLocal(seconds.data(), seconds.size(), result.data());
+  for (size_t i = 0; i < seconds.size(); ++i) {
+    ASSERT_EQ(expectedLocal(*zone, seconds[i]), result[i]) << seconds[i];
+  }
+}
+
+} // namespace
+} // namespace facebook::velox
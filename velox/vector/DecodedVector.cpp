@@ -17,6 +17,7 @@
 #include "velox/buffer/Buffer.h"
 #include "velox/common/base/BitUtil.h"
 #include "velox/vector/BaseVector.h"
+#include "velox/vector/BiasVector.h"
 #include "velox/vector/LazyVector.h"
 
 namespace facebook::velox {
@@ -31,6 +32,22 @@ std::vector<vector_size_t> makeConsecutiveIndices(size_t size) {
   }
   return consecutiveIndices;
 }
+
+// Sets the first 'size' elements of 'indices' to the number of the run of
+// 'sequence' that covers each row.
+void fillSequenceIndices(
+    const BaseVector& sequence,
+    vector_size_t size,
+    vector_size_t* indices) {
+  const auto* lengths = sequence.wrapInfo()->as<vector_size_t>();
+  const auto numRuns = sequence.valueVector()->size();
+  vector_size_t row = 0;
+  for (vector_size_t run = 0; run < numRuns && row < size; ++run) {
+    const auto end = std::min(size, row + lengths[run]);
+    std::fill(indices + row, indices + end, run);
+    row = end;
+  }
+}
 } // namespace
 
 const std::vector<vector_size_t>& DecodedVector::consecutiveIndices() {
@@ -146,6 +163,12 @@ void DecodedVector::combineWrappers(
       hasExtraNulls_ = true;
       mayHaveNulls_ = true;
     }
+  } else if (topEncoding == VectorEncoding::Simple::SEQUENCE) {
+    // Runs are expanded to indices. Sequences have no nulls of their own.
+    copiedIndices_.resize(size_ > 0 ? size_ : 1);
+    fillSequenceIndices(*vector, size_, copiedIndices_.data());
+    indices_ = copiedIndices_.data();
+    values = vector->valueVector().get();
   } else {
     VELOX_FAIL(
         "Unsupported wrapper encoding: {}",
@@ -180,6 +203,11 @@ void DecodedVector::combineWrappers(
         values = values->valueVector().get();
         break;
       }
+      case VectorEncoding::Simple::SEQUENCE: {
+        applySequenceWrapper(*values, rows);
+        values = values->valueVector().get();
+        break;
+      }
       default:
         VELOX_CHECK(false, "Unsupported vector encoding");
     }
@@ -225,6 +253,29 @@ void DecodedVector::applyDictionaryWrapper(
   });
 }
 
+void DecodedVector::applySequenceWrapper(
+    const BaseVector& sequenceVector,
+    const SelectivityVector* rows) {
+  if (size_ == 0 || (rows && !rows->hasSelections())) {
+    // No further processing is needed.
+    return;
+  }
+
+  std::vector<vector_size_t> runs(sequenceVector.size());
+  fillSequenceIndices(sequenceVector, runs.size(), runs.data());
+  auto currentIndices = indices_;
+  if (indicesNotCopied()) {
+    copiedIndices_.resize(size_);
+    indices_ = copiedIndices_.data();
+  }
+
+  applyToRows(rows, [&](vector_size_t row) {
+    if (!nulls_ || !bits::isBitNull(nulls_, row)) {
+      copiedIndices_[row] = runs[currentIndices[row]];
+    }
+  });
+}
+
 void DecodedVector::fillInIndices() {
   if (isConstantMapping_) {
     if (size_ > zeroIndices().size() || constantIndex_ != 0) {
@@ -307,11 +358,67 @@ void DecodedVector::setBaseData(
       setBaseDataForConstant(vector, rows);
       break;
     }
+    case VectorEncoding::Simple::BIASED: {
+      setBiasedData(vector);
+      setFlatNulls(vector, rows);
+      break;
+    }
     default:
       VELOX_UNREACHABLE();
   }
 }
 
+namespace {
+template <typename T, typename TDelta>
+void unbias(const BiasVector<T>& vector, T* values) {
+  const auto* deltas = vector.values()->template as<TDelta>();
+  const T bias = vector.bias();
+  // Simple enough for the compiler to vectorize.
+  for (vector_size_t i = 0; i < vector.size(); ++i) {
+    values[i] = bias + deltas[i];
+  }
+}
+
+template <typename T>
+void unbias(const BaseVector& vector, T* values) {
+  const auto& biased = *vector.asUnchecked<BiasVector<T>>();
+  switch (biased.valueType()) {
+    case TypeKind::TINYINT:
+      unbias<T, int8_t>(biased, values);
+      break;
+    case TypeKind::SMALLINT:
+      unbias<T, int16_t>(biased, values);
+      break;
+    case TypeKind::INTEGER:
+      unbias<T, int32_t>(biased, values);
+      break;
+    default:
+      VELOX_UNREACHABLE();
+  }
+}
+} // namespace
+
+void DecodedVector::setBiasedData(const BaseVector& vector) {
+  // All rows are decompressed since wrappers may refer to any of them.
+  unbiasedValues_.resize(bits::nwords(vector.size() * 64));
+  auto* values = unbiasedValues_.data();
+  switch (vector.typeKind()) {
+    case TypeKind::SMALLINT:
+      unbias(vector, reinterpret_cast<int16_t*>(values));
+      break;
+    case TypeKind::INTEGER:
+      unbias(vector, reinterpret_cast<int32_t*>(values));
+      break;
+    case TypeKind::BIGINT:
+      unbias(vector, reinterpret_cast<int64_t*>(values));
+      break;
+    default:
+      VELOX_UNREACHABLE(
+          "Unsupported type of BiasVector: {}", vector.type()->toString());
+  }
+  data_ = values;
+}
+
 void DecodedVector::setBaseDataForConstant(
     const BaseVector& vector,
     const SelectivityVector* rows) {
@@ -335,8 +335,15 @@ class DecodedVector {
       const BaseVector& dictionaryVector,
       const SelectivityVector* rows);
 
+  void applySequenceWrapper(
+      const BaseVector& sequenceVector,
+      const SelectivityVector* rows);
+
   void copyNulls(vector_size_t size);
 
+  // Decompresses the values of a BiasVector into 'unbiasedValues_'.
+  void setBiasedData(const BaseVector& vector);
+
   void fillInIndices();
 
   void setBaseData(const BaseVector& vector, const SelectivityVector* rows);
@@ -417,6 +424,9 @@ class DecodedVector {
   // dictionary and base values.
   std::vector<uint64_t> copiedNulls_;
 
+  // Used as backing for 'data_' when the base is a BiasVector.
+  std::vector<uint64_t> unbiasedValues_;
+
   // Used as 'nulls_' for a null constant vector.
   static uint64_t constantNullMask_;
 };
@@ -22,6 +22,7 @@ namespace facebook::velox {
 
 namespace exec {
 class EvalCtx;
+class Expr;
 } // namespace exec
 
 // Represents a function with possible captures.
@@ -69,6 +70,20 @@ class Callable {
       const std::vector<VectorPtr>& args,
       ErrorVectorPtr& elementErrors,
       VectorPtr* result) = 0;
+
+  /// Returns the names and types of the arguments of the lambda, or nullptr
+  /// if 'this' is not a lambda expression. Together with body(), lets a
+  /// function recognize a simple lambda, e.g. a sum in reduce(), and compute
+  /// it without evaluating the lambda.
+  virtual const RowTypePtr* signature() const {
+    return nullptr;
+  }
+
+  /// Returns the body of the lambda, or nullptr if 'this' is not a lambda
+  /// expression.
+  virtual const exec::Expr* body() const {
+    return nullptr;
+  }
 };
 
 // Represents a vector of functions. In most cases all the positions
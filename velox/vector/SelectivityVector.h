@@ -331,6 +331,16 @@ class SelectivityVector {
   template <typename Callable>
   void applyToSelected(Callable func) const;
 
+  /// Same as applyToSelected() but if 'func' throws for a row, calls
+  /// 'onError(row)' from inside the catch block and continues with the next
+  /// row. 'onError' may inspect the exception with std::current_exception()
+  /// or rethrow it. If all rows are selected, the rows are visited by a plain
+  /// loop inside a single try block, so that the loop body is free of
+  /// exception handling and the compiler can optimize it like a loop over a
+  /// range.
+  template <typename Callable, typename OnError>
+  void applyToSelectedNoThrow(Callable func, OnError onError) const;
+
   /// Invokes a function on each selected row sequentially in order starting
   /// from the lowest row number until a function returns 'false' or all
   /// selected rows have been processed. The function must take a single "row"
@@ -433,6 +443,33 @@ inline void SelectivityVector::applyToSelected(Callable func) const {
   }
 }
 
+template <typename Callable, typename OnError>
+inline void SelectivityVector::applyToSelectedNoThrow(
+    Callable func,
+    OnError onError) const {
+  if (isAllSelected()) {
+    vector_size_t row = begin_;
+    while (row < end_) {
+      try {
+        for (; row < end_; ++row) {
+          func(row);
+        }
+      } catch (...) {
+        onError(row);
+        ++row;
+      }
+    }
+    return;
+  }
+  bits::forEachSetBit(bits_.data(), begin_, end_, [&](vector_size_t row) {
+    try {
+      func(row);
+    } catch (...) {
+      onError(row);
+    }
+  });
+}
+
 template <typename Callable>
 inline bool SelectivityVector::testSelected(Callable func) const {
   if (isAllSelected()) {
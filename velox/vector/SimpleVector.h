@@ -261,12 +261,14 @@ class SimpleVector : public BaseVector {
     }
     ensureIsAsciiCapacity(rows.end());
     bool isAllAscii = true;
-    rows.template applyToSelected([&](auto row) {
+    rows.template testSelected([&](auto row) {
       if (!isNullAt(row)) {
         auto string = valueAt(row);
         isAllAscii &=
             functions::stringCore::isAscii(string.data(), string.size());
       }
+      // No need to look at the remaining strings after a non-ASCII one.
+      return isAllAscii;
     });
 
     // Set isAllAscii flag, it will unset if we encounter any utf.
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/vector/VectorCompression.h"
+
+#include <folly/container/F14Map.h>
+
+#include "velox/vector/BiasVector.h"
+#include "velox/vector/ComplexVector.h"
+#include "velox/vector/FlatVector.h"
+
+namespace facebook::velox {
+
+namespace {
+
+template <typename T, typename TDelta>
+VectorPtr makeBiased(
+    const FlatVector<T>& flat,
+    T bias,
+    TypeKind deltaKind,
+    memory::MemoryPool* pool) {
+  const auto size = flat.size();
+  auto deltas = AlignedBuffer::allocate<TDelta>(size, pool);
+  auto* rawDeltas = deltas->template asMutable<TDelta>();
+  const auto* rawValues = flat.rawValues();
+  // Null rows have arbitrary values and are set to 0 to stay in range.
+  const auto* rawNulls = flat.rawNulls();
+  for (vector_size_t i = 0; i < size; ++i) {
+    rawDeltas[i] = rawNulls && bits::isBitNull(rawNulls, i)
+        ? 0
+        : static_cast<TDelta>(rawValues[i] - bias);
+  }
+  return std::make_shared<BiasVector<T>>(
+      pool, flat.nulls(), size, deltaKind, std::move(deltas), bias);
+}
+
+template <typename T>
+VectorPtr compressIntegers(const VectorPtr& vector, memory::MemoryPool* pool) {
+  // Logical types like DATE or DECIMAL are kept as is, a BiasVector is always
+  // of the physical type.
+  if (!vector->type()->equivalent(*CppToType<T>::create())) {
+    return vector;
+  }
+  const auto& flat = *vector->asUnchecked<FlatVector<T>>();
+  const auto* rawValues = flat.rawValues();
+  const auto* rawNulls = flat.rawNulls();
+  std::optional<T> min;
+  std::optional<T> max;
+  for (vector_size_t i = 0; i < flat.size(); ++i) {
+    if (rawNulls && bits::isBitNull(rawNulls, i)) {
+      continue;
+    }
+    if (!min.has_value()) {
+      min = rawValues[i];
+      max = rawValues[i];
+    } else {
+      min = std::min(*min, rawValues[i]);
+      max = std::max(*max, rawValues[i]);
+    }
+  }
+  if (!min.has_value()) {
+    return vector;
+  }
+  // See BiasVector.h for the choice of bias.
+  const uint64_t delta =
+      static_cast<uint64_t>(*max) - static_cast<uint64_t>(*min);
+  const T bias = *min + static_cast<T>((delta + 1) / 2);
+  if (delta <= std::numeric_limits<uint8_t>::max()) {
+    return makeBiased<T, int8_t>(flat, bias, TypeKind::TINYINT, pool);
+  }
+  if (sizeof(T) > sizeof(int16_t) &&
+      delta <= std::numeric_limits<uint16_t>::max()) {
+    return makeBiased<T, int16_t>(flat, bias, TypeKind::SMALLINT, pool);
+  }
+  if (sizeof(T) > sizeof(int32_t) &&
+      delta <= std::numeric_limits<uint32_t>::max()) {
+    return makeBiased<T, int32_t>(flat, bias, TypeKind::INTEGER, pool);
+  }
+  return vector;
+}
+
+VectorPtr compressStrings(
+    const VectorPtr& vector,
+    memory::MemoryPool* pool,
+    const VectorCompressionOptions& options) {
+  const auto& flat = *vector->asUnchecked<FlatVector<StringView>>();
+  const auto size = flat.size();
+  const auto maxDistinct =
+      static_cast<size_t>(size * options.maxStringDistinctRatio);
+
+  folly::F14FastMap<StringView, vector_size_t> distinct;
+  auto indices = allocateIndices(size, pool);
+  auto* rawIndices = indices->asMutable<vector_size_t>();
+  std::vector<vector_size_t> distinctRows;
+  for (vector_size_t i = 0; i < size; ++i) {
+    if (flat.isNullAt(i)) {
+      rawIndices[i] = 0;
+      continue;
+    }
+    auto [it, inserted] =
+        distinct.emplace(flat.valueAtFast(i), distinctRows.size());
+    if (inserted) {
+      if (distinctRows.size() >= maxDistinct) {
+        return vector;
+      }
+      distinctRows.push_back(i);
+    }
+    rawIndices[i] = it->second;
+  }
+  if (distinctRows.empty()) {
+    return vector;
+  }
+
+  // Copies the distinct values so that the string buffers of 'vector' are
+  // not retained.
+  auto values = BaseVector::create<FlatVector<StringView>>(
+      vector->type(), distinctRows.size(), pool);
+  for (size_t i = 0; i < distinctRows.size(); ++i) {
+    values->set(i, flat.valueAtFast(distinctRows[i]));
+  }
+  return BaseVector::wrapInDictionary(
+      flat.nulls(), std::move(indices), size, std::move(values));
+}
+
+} // namespace
+
+VectorPtr compressVector(
+    const VectorPtr& vector,
+    memory::MemoryPool* pool,
+    const VectorCompressionOptions& options) {
+  if (vector->size() == 0) {
+    return vector;
+  }
+  if (vector->encoding() == VectorEncoding::Simple::ROW) {
+    auto* row = vector->asUnchecked<RowVector>();
+    std::vector<VectorPtr> children;
+    children.reserve(row->childrenSize());
+    for (const auto& child : row->children()) {
+      children.push_back(child ? compressVector(child, pool, options) : child);
+    }
+    return std::make_shared<RowVector>(
+        pool, row->type(), row->nulls(), row->size(), std::move(children));
+  }
+  if (vector->encoding() != VectorEncoding::Simple::FLAT) {
+    return vector;
+  }
+  switch (vector->typeKind()) {
+    case TypeKind::SMALLINT:
+      return compressIntegers<int16_t>(vector, pool);
+    case TypeKind::INTEGER:
+      return compressIntegers<int32_t>(vector, pool);
+    case TypeKind::BIGINT:
+      return compressIntegers<int64_t>(vector, pool);
+    case TypeKind::VARCHAR:
+    case TypeKind::VARBINARY:
+      return compressStrings(vector, pool, options);
+    default:
+      return vector;
+  }
+}
+
+} // namespace facebook::velox
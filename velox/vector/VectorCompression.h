@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#pragma once
+
+#include "velox/vector/BaseVector.h"
+
+namespace facebook::velox {
+
+struct VectorCompressionOptions {
+  /// A string column is dictionary encoded only if its number of distinct
+  /// values is at most this fraction of its size.
+  double maxStringDistinctRatio{0.5};
+};
+
+/// Returns a lighter weight representation of 'vector' for keeping
+/// intermediate results in memory, e.g. batches that are produced once and
+/// read many times. Flat BIGINT, INTEGER and SMALLINT vectors become
+/// BiasVectors with the narrowest delta type that holds their range. Flat
+/// VARCHAR and VARBINARY vectors with few distinct values become
+/// DictionaryVectors over the distinct values. Children of a RowVector are
+/// compressed recursively. Anything else is returned as is, as is a vector
+/// that would not get smaller.
+///
+/// The result is read like any other vector. DecodedVector decompresses a
+/// BiasVector into a flat array once per decode, so the per-row access cost
+/// is the same as for a flat vector.
+VectorPtr compressVector(
+    const VectorPtr& vector,
+    memory::MemoryPool* pool,
+    const VectorCompressionOptions& options = {});
+
+} // namespace facebook::velox
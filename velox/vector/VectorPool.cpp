@@ -52,7 +52,12 @@ FOLLY_ALWAYS_INLINE int32_t toCacheIndex(const TypePtr& type) {
 VectorPtr VectorPool::get(const TypePtr& type, vector_size_t size) {
   auto cacheIndex = toCacheIndex(type);
   if (cacheIndex >= 0 && size <= kMaxRecycleSize) {
-    return vectors_[cacheIndex].pop(type, size, *pool_);
+    auto& typePool = vectors_[cacheIndex];
+    if (typePool.size > 0) {
+      ++stats_.numHits;
+      return typePool.pop(size, retainedBytes_);
+    }
+    ++stats_.numMisses;
   }
   return BaseVector::create(type, size, pool_);
 }
@@ -69,7 +74,8 @@ bool VectorPool::release(VectorPtr& vector) {
   if (cacheIndex < 0) {
     return false;
   }
-  return vectors_[cacheIndex].maybePushBack(vector);
+  return vectors_[cacheIndex].maybePushBack(
+      vector, retainedBytes_, maxRetainedBytes_);
 }
 
 size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
@@ -84,7 +90,10 @@ size_t VectorPool::release(std::vector<VectorPtr>& vectors) {
   return numReleased;
 }
 
-bool VectorPool::TypePool::maybePushBack(VectorPtr& vector) {
+bool VectorPool::TypePool::maybePushBack(
+    VectorPtr& vector,
+    int64_t& retainedBytes,
+    int64_t maxRetainedBytes) {
   // Check that this is a Flat Vector with an initialized, unique, and mutable
   // values Buffer and an uninitialized or unique and mutable nulls Buffer.
   if (!vector->isWritable() || !vector->isFlatEncoding() || !vector->values()) {
@@ -94,37 +103,43 @@ bool VectorPool::TypePool::maybePushBack(VectorPtr& vector) {
     return false;
   }
 
+  // Checks the budget before prepareForReuse() which can only shrink the
+  // vector, as 'vector' stays with the caller if it is not cached.
+  if (retainedBytes + vector->retainedSize() > maxRetainedBytes) {
+    return false;
+  }
   vector->prepareForReuse();
+  const auto retainedSize = vector->retainedSize();
+  retainedBytes += retainedSize;
+  retainedSizes[size] = retainedSize;
   vectors[size++] = std::move(vector);
   return true;
 }
 
 VectorPtr VectorPool::TypePool::pop(
-    const TypePtr& type,
     vector_size_t vectorSize,
-    memory::MemoryPool& pool) {
-  if (size) {
-    auto result = std::move(vectors[--size]);
-    if (UNLIKELY(result->rawNulls() != nullptr)) {
-      // This is a recyclable vector, no need to check uniqueness.
-      simd::memset(
-          const_cast<uint64_t*>(result->rawNulls()),
-          bits::kNotNullByte,
-          bits::roundUp(std::min<int32_t>(vectorSize, result->size()), 64) / 8);
-    }
-    if (UNLIKELY(
-            result->typeKind() == TypeKind::VARCHAR ||
-            result->typeKind() == TypeKind::VARBINARY)) {
-      simd::memset(
-          const_cast<void*>(result->valuesAsVoid()),
-          0,
-          std::min<int32_t>(vectorSize, result->size()) * sizeof(StringView));
-    }
-    if (result->size() != vectorSize) {
-      result->resize(vectorSize);
-    }
-    return result;
+    int64_t& retainedBytes) {
+  VELOX_DCHECK_GT(size, 0);
+  auto result = std::move(vectors[--size]);
+  retainedBytes -= retainedSizes[size];
+  if (UNLIKELY(result->rawNulls() != nullptr)) {
+    // This is a recyclable vector, no need to check uniqueness.
+    simd::memset(
+        const_cast<uint64_t*>(result->rawNulls()),
+        bits::kNotNullByte,
+        bits::roundUp(std::min<int32_t>(vectorSize, result->size()), 64) / 8);
+  }
+  if (UNLIKELY(
+          result->typeKind() == TypeKind::VARCHAR ||
+          result->typeKind() == TypeKind::VARBINARY)) {
+    simd::memset(
+        const_cast<void*>(result->valuesAsVoid()),
+        0,
+        std::min<int32_t>(vectorSize, result->size()) * sizeof(StringView));
+  }
+  if (result->size() != vectorSize) {
+    result->resize(vectorSize);
   }
-  return BaseVector::create(type, vectorSize, &pool);
+  return result;
 }
 } // namespace facebook::velox
@@ -21,15 +21,27 @@
 namespace facebook::velox {
 
 /// A thread-level cache of pre-allocated flat vectors of different types.
-/// Keeps up to 10 recyclable vectors of each type. A vector is
-/// recyclable if it is flat and recursively singly-referenced.
+/// Keeps up to 10 recyclable vectors of each type and up to 'maxRetainedBytes'
+/// in total. A vector is recyclable if it is flat and recursively
+/// singly-referenced.
 /// Only singleton built-in types are supported. Decimal types, fixed-size array
 /// type, complex and custom types are not supported. Calling 'get' for an
 /// unsupported type already returns a newly allocated vector. Calling 'release'
 /// for an unsupported type is a no-op.
 class VectorPool {
  public:
-  explicit VectorPool(memory::MemoryPool* pool) : pool_{pool} {}
+  static constexpr int64_t kDefaultMaxRetainedBytes = 16 << 20;
+
+  /// Hit and miss counters of get() for the supported types.
+  struct Stats {
+    uint64_t numHits{0};
+    uint64_t numMisses{0};
+  };
+
+  explicit VectorPool(
+      memory::MemoryPool* pool,
+      int64_t maxRetainedBytes = kDefaultMaxRetainedBytes)
+      : pool_{pool}, maxRetainedBytes_{maxRetainedBytes} {}
 
   /// Gets a possibly recycled vector of 'type and 'size'. Allocates from
   /// 'pool_' if no pre-allocated vector or type is a complex type.
@@ -42,6 +54,15 @@ class VectorPool {
 
   size_t release(std::vector<VectorPtr>& vectors);
 
+  Stats stats() const {
+    return stats_;
+  }
+
+  /// Returns the memory held by the cached vectors.
+  int64_t retainedBytes() const {
+    return retainedBytes_;
+  }
+
  private:
   /// Max number of elements for a vector to be recyclable. The larger
   /// the batch the less the win from recycling.
@@ -51,16 +72,25 @@ class VectorPool {
   struct TypePool {
     int32_t size{0};
     std::array<VectorPtr, kNumPerType> vectors;
-
-    bool maybePushBack(VectorPtr& vector);
-
-    VectorPtr pop(
-        const TypePtr& type,
-        vector_size_t vectorSize,
-        memory::MemoryPool& pool);
+    std::array<int64_t, kNumPerType> retainedSizes;
+
+    // Adds the retained size of 'vector' to 'retainedBytes' if it is cached.
+    // Does not cache it if this would exceed 'maxRetainedBytes'.
+    bool maybePushBack(
+        VectorPtr& vector,
+        int64_t& retainedBytes,
+        int64_t maxRetainedBytes);
+
+    // Subtracts the retained size of the returned vector from
+    // 'retainedBytes'. Must not be called when empty.
+    VectorPtr pop(vector_size_t vectorSize, int64_t& retainedBytes);
   };
 
   memory::MemoryPool* const pool_;
+  const int64_t maxRetainedBytes_;
+
+  int64_t retainedBytes_{0};
+  Stats stats_;
 
   static constexpr int32_t kNumCachedVectorTypes =
       static_cast<int32_t>(TypeKind::HUGEINT) + 1;
@@ -14,6 +14,10 @@
  * limitations under the License.
  */
 #include "velox/vector/VectorSaver.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <fstream>
 #include "velox/vector/ComplexVector.h"
 #include "velox/vector/FlatVector.h"
@@ -102,8 +106,123 @@ Encoding readEncoding(std::istream& in) {
   }
 }
 
+// Marks the start of a file written by saveVectorToMappableFile(). Files in
+// the plain format start with the encoding, which is a small number.
+constexpr int32_t kMappableFileMagic = 0x564d4150;
+
+// Alignment of buffer payloads in a mappable file.
+constexpr int64_t kMappableBufferAlignment = 64;
+
+// Output file for saveVectorToMappableFile(). writeBuffer() pads the buffer
+// payloads written to it to kMappableBufferAlignment.
+class MappableOutputFile : public std::ofstream {
+ public:
+  explicit MappableOutputFile(const char* filePath)
+      : std::ofstream(filePath, std::ofstream::binary) {}
+};
+
+// Memory mapping of a file written by saveVectorToMappableFile(). The mapping
+// is private and writable so that string views can be pointed at the mapped
+// string payloads in place. Modified pages are copied on write.
+class MappedVectorFile {
+ public:
+  explicit MappedVectorFile(const char* filePath) {
+    const int fd = ::open(filePath, O_RDONLY);
+    VELOX_CHECK_GE(fd, 0, "Cannot open file: {}", filePath);
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+      ::close(fd);
+      VELOX_FAIL("Cannot stat file: {}", filePath);
+    }
+    size_ = st.st_size;
+    VELOX_CHECK_GT(size_, sizeof(int32_t), "Empty vector file: {}", filePath);
+    void* data = ::mmap(
+        nullptr, size_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    VELOX_CHECK(data != MAP_FAILED, "Cannot map file: {}", filePath);
+    data_ = reinterpret_cast<char*>(data);
+  }
+
+  ~MappedVectorFile() {
+    ::munmap(data_, size_);
+  }
+
+  char* data() const {
+    return data_;
+  }
+
+  size_t size() const {
+    return size_;
+  }
+
+ private:
+  char* data_;
+  size_t size_;
+};
+
+// Keeps the mapping alive for as long as a buffer view over it exists.
+class MappedVectorFileReleaser {
+ public:
+  explicit MappedVectorFileReleaser(std::shared_ptr<MappedVectorFile> file)
+      : file_(std::move(file)) {}
+
+  void addRef() const {}
+
+  void release() const {}
+
+ private:
+  const std::shared_ptr<MappedVectorFile> file_;
+};
+
+// Input stream over a mapped file. readBuffer() returns views over the mapped
+// buffer payloads instead of copying them.
+class MappedInputStream : public std::istream {
+ public:
+  explicit MappedInputStream(std::shared_ptr<MappedVectorFile> file)
+      : std::istream(nullptr), file_(std::move(file)), buffer_(file_.get()) {
+    rdbuf(&buffer_);
+  }
+
+  BufferPtr readBufferView(int32_t numBytes) {
+    const auto offset = buffer_.offset();
+    const auto start = bits::roundUp(offset, kMappableBufferAlignment);
+    VELOX_CHECK_LE(start + numBytes, file_->size(), "Truncated vector file");
+    buffer_.seek(start + numBytes);
+    return BufferView<MappedVectorFileReleaser>::create(
+        reinterpret_cast<const uint8_t*>(file_->data() + start),
+        numBytes,
+        MappedVectorFileReleaser(file_));
+  }
+
+ private:
+  class StreamBuffer : public std::streambuf {
+   public:
+    explicit StreamBuffer(MappedVectorFile* file) {
+      setg(file->data(), file->data(), file->data() + file->size());
+    }
+
+    int64_t offset() const {
+      return gptr() - eback();
+    }
+
+    void seek(int64_t offset) {
+      setg(eback(), eback() + offset, egptr());
+    }
+  };
+
+  const std::shared_ptr<MappedVectorFile> file_;
+  StreamBuffer buffer_;
+};
+
 void writeBuffer(const BufferPtr& buffer, std::ostream& out) {
   write<int32_t>(buffer->size(), out);
+  if (dynamic_cast<MappableOutputFile*>(&out) != nullptr) {
+    const int64_t offset = out.tellp();
+    const auto padding =
+        bits::roundUp(offset, kMappableBufferAlignment) - offset;
+    static const char kZeros[kMappableBufferAlignment] = {};
+    out.write(kZeros, padding);
+  }
   out.write(buffer->as<char>(), buffer->size());
 }
 
@@ -118,6 +237,9 @@ void writeOptionalBuffer(const BufferPtr& buffer, std::ostream& out) {
 
 BufferPtr readBuffer(std::istream& in, memory::MemoryPool* pool) {
   auto numBytes = read<int32_t>(in);
+  if (auto* mapped = dynamic_cast<MappedInputStream*>(&in)) {
+    return mapped->readBufferView(numBytes);
+  }
   auto buffer = AlignedBuffer::allocate<char>(numBytes, pool);
   auto rawBuffer = buffer->asMutable<char>();
   in.read(rawBuffer, numBytes);
@@ -218,7 +340,10 @@ void restoreVectorStringViews(
     const BufferPtr& strings,
     const std::vector<BufferPtr>& stringBuffers) {
   auto rawBytes = strings->as<char>();
-  auto rawValues = strings->asMutable<StringView>();
+  // A view over a mapped file is backed by a private writable mapping.
+  auto rawValues = strings->isView()
+      ? const_cast<StringView*>(strings->as<StringView>())
+      : strings->asMutable<StringView>();
   for (auto i = 0; i < size; ++i) {
     auto value = rawValues[i];
     if (!value.isInline()) {
@@ -634,6 +759,16 @@ void saveVectorToFile(
   outputFile.close();
 }
 
+void saveVectorToMappableFile(
+    const BaseVector* FOLLY_NONNULL vector,
+    const char* FOLLY_NONNULL filePath) {
+  MappableOutputFile outputFile(filePath);
+  write<int32_t>(kMappableFileMagic, outputFile);
+  saveVector(*vector, outputFile);
+  outputFile.close();
+  VELOX_CHECK(!outputFile.fail(), "Cannot write file: {}", filePath);
+}
+
 void saveStringToFile(
     const std::string& content,
     const char* FOLLY_NONNULL filePath) {
@@ -679,11 +814,28 @@ VectorPtr restoreVectorFromFile(
   std::ifstream inputFile(filePath, std::ifstream::binary);
   VELOX_CHECK(!inputFile.fail(), "Cannot open file: {}", filePath);
 
+  if (read<int32_t>(inputFile) == kMappableFileMagic) {
+    inputFile.close();
+    return restoreVectorFromMappedFile(filePath, pool);
+  }
+  inputFile.seekg(0);
   auto result = restoreVector(inputFile, pool);
   inputFile.close();
   return result;
 }
 
+VectorPtr restoreVectorFromMappedFile(
+    const char* FOLLY_NONNULL filePath,
+    memory::MemoryPool* FOLLY_NONNULL pool) {
+  MappedInputStream in(std::make_shared<MappedVectorFile>(filePath));
+  VELOX_CHECK_EQ(
+      read<int32_t>(in),
+      kMappableFileMagic,
+      "Not a mappable vector file: {}",
+      filePath);
+  return restoreVector(in, pool);
+}
+
 std::string restoreStringFromFile(const char* FOLLY_NONNULL filePath) {
   std::ifstream inputFile(filePath, std::ifstream::binary);
   VELOX_CHECK(!inputFile.fail(), "Cannot open file: {}", filePath);
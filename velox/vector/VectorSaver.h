@@ -41,6 +41,13 @@ void saveVectorToFile(
     const BaseVector* FOLLY_NONNULL vector,
     const char* FOLLY_NONNULL filePath);
 
+/// Serializes the vector like saveVectorToFile() but aligns the buffer
+/// payloads in the file so that restoreVectorFromMappedFile() can use them in
+/// place.
+void saveVectorToMappableFile(
+    const BaseVector* FOLLY_NONNULL vector,
+    const char* FOLLY_NONNULL filePath);
+
 /// Writes 'content' to a new file in 'filePath'. Exceptions will be thrown if
 /// any error occurs while writing.
 void saveStringToFile(
@@ -53,11 +60,21 @@ VectorPtr restoreVector(
     memory::MemoryPool* FOLLY_NONNULL pool);
 
 /// Reads and deserializes a vector from a file stored by saveVectorToFile()
-/// method call
+/// method call. Files stored by saveVectorToMappableFile() are restored with
+/// restoreVectorFromMappedFile().
 VectorPtr restoreVectorFromFile(
     const char* FOLLY_NONNULL filePath,
     memory::MemoryPool* FOLLY_NONNULL pool);
 
+/// Maps a file stored by saveVectorToMappableFile() in memory and returns a
+/// vector whose buffers are read-only views over the mapping, so that large
+/// inputs load without copying into 'pool'. The mapping stays alive as long as
+/// any buffer of the result does. 'pool' is used for the vector objects and
+/// non-inline scalar constants only.
+VectorPtr restoreVectorFromMappedFile(
+    const char* FOLLY_NONNULL filePath,
+    memory::MemoryPool* FOLLY_NONNULL pool);
+
 /// Reads a string from a file stored by saveStringToFile() method
 std::string restoreStringFromFile(const char* FOLLY_NONNULL filePath);
 
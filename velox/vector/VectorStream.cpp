@@ -114,6 +114,17 @@ void VectorStreamGroup::flush(OutputStream* out) {
   serializer_->flush(out);
 }
 
+// static
+std::unique_ptr<folly::IOBuf> VectorStreamGroup::flushToIOBuf(
+    std::shared_ptr<VectorStreamGroup> group,
+    OutputStreamListener* listener,
+    const std::function<void()>& releaseFn) {
+  IOBufOutputStream stream(*group->pool(), listener);
+  stream.referenceStableWrites(group);
+  group->flush(&stream);
+  return stream.getIOBuf(releaseFn);
+}
+
 // static
 void VectorStreamGroup::estimateSerializedSize(
     VectorPtr vector,
@@ -150,9 +161,8 @@ folly::IOBuf rowVectorToIOBuf(
   IndexRange range{0, rangeEnd};
   streamGroup->append(rowVector, folly::Range<IndexRange*>(&range, 1));
 
-  IOBufOutputStream stream(pool);
-  streamGroup->flush(&stream);
-  return std::move(*stream.getIOBuf());
+  return std::move(
+      *VectorStreamGroup::flushToIOBuf(std::move(streamGroup)));
 }
 
 RowVectorPtr IOBufToRowVector(
@@ -141,6 +141,15 @@ class VectorStreamGroup : public StreamArena {
   // Writes the contents to 'stream' in wire format.
   void flush(OutputStream* stream);
 
+  /// Returns the contents of 'group' in wire format. The IOBufs reference the
+  /// arena ranges of 'group' instead of copying them and keep 'group' alive.
+  /// 'group' must not be appended to afterwards. 'releaseFn' is executed on
+  /// the destruction of each IOBuf if not null.
+  static std::unique_ptr<folly::IOBuf> flushToIOBuf(
+      std::shared_ptr<VectorStreamGroup> group,
+      OutputStreamListener* listener = nullptr,
+      const std::function<void()>& releaseFn = nullptr);
+
   // Reads data in wire format. Returns the RowVector in 'result'.
   static void read(
       ByteStream* source,
@@ -16,6 +16,8 @@
 
 #include "velox/vector/arrow/Bridge.h"
 
+#include <numeric>
+
 #include "velox/buffer/Buffer.h"
 #include "velox/common/base/BitUtil.h"
 #include "velox/common/base/CheckedArithmetic.h"
@@ -28,18 +30,23 @@ namespace facebook::velox {
 
 namespace {
 
-// The supported conversions use one buffer for nulls (0), one for values (1),
-// and one for offsets (2).
+// Most supported conversions use one buffer for nulls (0), one for values (1),
+// and one for offsets (2). String views add one buffer per string buffer and
+// one for their sizes.
 static constexpr size_t kMaxBuffers{3};
 
 // Structure that will hold the buffers needed by ArrowArray. This is opaquely
 // carried by ArrowArray.private_data
 class VeloxToArrowBridgeHolder {
  public:
-  VeloxToArrowBridgeHolder() {
-    for (size_t i = 0; i < kMaxBuffers; ++i) {
-      buffers_[i] = nullptr;
-    }
+  VeloxToArrowBridgeHolder()
+      : buffers_(kMaxBuffers), bufferPtrs_(kMaxBuffers) {}
+
+  // Makes room for 'numBuffers' buffers. Invalidates the result of
+  // getArrowBuffers().
+  void resizeBuffers(size_t numBuffers) {
+    buffers_.resize(numBuffers);
+    bufferPtrs_.resize(numBuffers);
   }
 
   // Acquires a buffer at index `idx`.
@@ -56,7 +63,7 @@ class VeloxToArrowBridgeHolder {
   }
 
   const void** getArrowBuffers() {
-    return buffers_;
+    return buffers_.data();
   }
 
   // Allocates space for `numChildren` ArrowArray pointers.
@@ -87,11 +94,11 @@ class VeloxToArrowBridgeHolder {
 
  private:
   // Holds the pointers to the arrow buffers.
-  const void* buffers_[kMaxBuffers];
+  std::vector<const void*> buffers_;
 
   // Holds ownership over the Buffers being referenced by the buffers vector
   // above.
-  BufferPtr bufferPtrs_[kMaxBuffers];
+  std::vector<BufferPtr> bufferPtrs_;
 
   // Auxiliary buffers to hold ownership over ArrowArray children structures.
   std::vector<std::unique_ptr<ArrowArray>> childrenPtrs_;
@@ -209,6 +216,7 @@ static void releaseArrowSchema(ArrowSchema* arrowSchema) {
 // Returns the Arrow C data interface format type for a given Velox type.
 const char* exportArrowFormatStr(
     const TypePtr& type,
+    const ArrowOptions& options,
     std::string& formatBuffer) {
   if (type->isDecimal()) {
     // Decimal types encode the precision, scale values.
@@ -239,9 +247,9 @@ const char* exportArrowFormatStr(
     // We always map VARCHAR and VARBINARY to the "small" version (lower case
     // format string), which uses 32 bit offsets.
     case TypeKind::VARCHAR:
-      return "u"; // utf-8 string
+      return options.exportToStringView ? "vu" : "u"; // utf-8 string
     case TypeKind::VARBINARY:
-      return "z"; // binary
+      return options.exportToStringView ? "vz" : "z"; // binary
 
     case TypeKind::TIMESTAMP:
       // TODO: need to figure out how we'll map this since in Velox we currently
@@ -250,7 +258,7 @@ const char* exportArrowFormatStr(
     // Complex/nested types.
     case TypeKind::ARRAY:
       static_assert(sizeof(vector_size_t) == 4);
-      return "+l"; // list
+      return options.exportToListView ? "+vl" : "+l"; // list
     case TypeKind::MAP:
       return "+m"; // map
     case TypeKind::ROW:
@@ -412,11 +420,111 @@ void exportStrings(
   VELOX_DCHECK_EQ(bufSize, *rawOffsets);
 }
 
+// Arrow Utf8View/BinaryView element. Strings of up to 12 bytes are inlined
+// like in StringView. Longer strings keep a 4 byte prefix and refer to their
+// data by variadic buffer index and offset instead of a pointer.
+struct ArrowStringView {
+  int32_t size;
+  char prefix[4];
+  int32_t bufferIndex;
+  int32_t offset;
+};
+static_assert(sizeof(ArrowStringView) == sizeof(StringView));
+
+// Exports strings as Arrow string views. The string buffers of 'vec' become
+// the variadic buffers, so only the 16 byte views are written. Strings that are
+// not in a string buffer of 'vec' are copied to one extra variadic buffer.
+void exportStringViews(
+    const FlatVector<StringView>& vec,
+    const Selection& rows,
+    ArrowArray& out,
+    memory::MemoryPool* pool,
+    VeloxToArrowBridgeHolder& holder) {
+  const auto& stringBuffers = vec.stringBuffers();
+  const auto numStringBuffers = stringBuffers.size();
+
+  // Returns the index of the string buffer that holds 'data', or -1. Strings
+  // of consecutive rows are mostly in the same buffer.
+  int32_t lastIndex = 0;
+  auto findBuffer = [&](const char* data) -> int32_t {
+    for (size_t n = 0; n < numStringBuffers; ++n) {
+      const auto index = (lastIndex + n) % numStringBuffers;
+      const auto* begin = stringBuffers[index]->as<char>();
+      if (data >= begin && data < begin + stringBuffers[index]->size()) {
+        lastIndex = index;
+        return index;
+      }
+    }
+    return -1;
+  };
+
+  auto views = AlignedBuffer::allocate<ArrowStringView>(out.length, pool);
+  auto* rawViews = views->asMutable<ArrowStringView>();
+  std::vector<vector_size_t> copiedRows;
+  size_t copiedSize = 0;
+  vector_size_t j = 0;
+  rows.apply([&](vector_size_t i) {
+    auto& view = rawViews[j++];
+    if (vec.isNullAt(i)) {
+      memset(&view, 0, sizeof(view));
+      return;
+    }
+    const auto sv = vec.valueAtFast(i);
+    memcpy(&view, &sv, sizeof(view));
+    if (sv.isInline()) {
+      return;
+    }
+    const auto index = findBuffer(sv.data());
+    if (index < 0) {
+      copiedRows.push_back(j - 1);
+      copiedSize += sv.size();
+      return;
+    }
+    view.bufferIndex = index;
+    view.offset = sv.data() - stringBuffers[index]->as<char>();
+  });
+
+  BufferPtr copied;
+  if (!copiedRows.empty()) {
+    VELOX_CHECK_LT(copiedSize, std::numeric_limits<int32_t>::max());
+    copied = AlignedBuffer::allocate<char>(copiedSize, pool);
+    auto* rawCopied = copied->asMutable<char>();
+    int32_t offset = 0;
+    for (auto row : copiedRows) {
+      const auto* data =
+          reinterpret_cast<const StringView*>(&rawViews[row])->data();
+      memcpy(rawCopied + offset, data, rawViews[row].size);
+      rawViews[row].bufferIndex = numStringBuffers;
+      rawViews[row].offset = offset;
+      offset += rawViews[row].size;
+    }
+  }
+
+  // Nulls, views, the variadic buffers and their sizes.
+  const auto numVariadic = numStringBuffers + (copied ? 1 : 0);
+  out.n_buffers = 3 + numVariadic;
+  holder.resizeBuffers(out.n_buffers);
+  out.buffers = holder.getArrowBuffers();
+  holder.setBuffer(1, views);
+  auto sizes = AlignedBuffer::allocate<int64_t>(numVariadic, pool);
+  auto* rawSizes = sizes->asMutable<int64_t>();
+  for (size_t i = 0; i < numStringBuffers; ++i) {
+    holder.setBuffer(2 + i, stringBuffers[i]);
+    rawSizes[i] = stringBuffers[i]->size();
+  }
+  if (copied) {
+    holder.setBuffer(2 + numStringBuffers, copied);
+    rawSizes[numStringBuffers] = copied->size();
+  }
+  holder.setBuffer(2 + numVariadic, sizes);
+}
+
 void exportFlat(
     const BaseVector& vec,
     const Selection& rows,
     ArrowArray& out,
     memory::MemoryPool* pool,
+    const ArrowOptions& options,
     VeloxToArrowBridgeHolder& holder) {
   out.n_children = 0;
   out.children = nullptr;
@@ -433,8 +541,21 @@ void exportFlat(
       break;
     case TypeKind::VARCHAR:
     case TypeKind::VARBINARY:
-      exportStrings(
-          *vec.asUnchecked<FlatVector<StringView>>(), rows, out, pool, holder);
+      if (options.exportToStringView) {
+        exportStringViews(
+            *vec.asUnchecked<FlatVector<StringView>>(),
+            rows,
+            out,
+            pool,
+            holder);
+      } else {
+        exportStrings(
+            *vec.asUnchecked<FlatVector<StringView>>(),
+            rows,
+            out,
+            pool,
+            holder);
+      }
       break;
     default:
       VELOX_NYI(
@@ -447,13 +568,15 @@ void exportBase(
     const BaseVector&,
     const Selection&,
     ArrowArray&,
-    memory::MemoryPool*);
+    memory::MemoryPool*,
+    const ArrowOptions&);
 
 void exportRows(
     const RowVector& vec,
     const Selection& rows,
     ArrowArray& out,
     memory::MemoryPool* pool,
+    const ArrowOptions& options,
     VeloxToArrowBridgeHolder& holder) {
   out.n_buffers = 1;
   holder.resizeChildren(vec.childrenSize());
@@ -465,7 +588,8 @@ void exportRows(
           *vec.childAt(i)->loadedVector(),
           rows,
           *holder.allocateChild(i),
-          pool);
+          pool,
+          options);
     } catch (const VeloxException&) {
       for (column_index_t j = 0; j < i; ++j) {
         // When exception is thrown, i th child is guaranteed unset.
@@ -521,20 +645,62 @@ void exportOffsets(
   out.n_buffers = 2;
 }
 
+// Exports the offsets and sizes of 'vec' as an Arrow ListView. Elements are
+// not compacted, so the offsets and sizes of 'vec' are shared as is when all
+// rows are exported and there are no nulls.
+void exportArrayViews(
+    const ArrayVector& vec,
+    const Selection& rows,
+    ArrowArray& out,
+    memory::MemoryPool* pool,
+    VeloxToArrowBridgeHolder& holder) {
+  out.n_buffers = 3;
+  if (!rows.changed() && !vec.mayHaveNulls()) {
+    holder.setBuffer(1, vec.offsets());
+    holder.setBuffer(2, vec.sizes());
+    return;
+  }
+  // Null arrays get an empty view.
+  auto offsets = AlignedBuffer::allocate<vector_size_t>(out.length, pool);
+  auto sizes = AlignedBuffer::allocate<vector_size_t>(out.length, pool);
+  auto* rawOffsets = offsets->asMutable<vector_size_t>();
+  auto* rawSizes = sizes->asMutable<vector_size_t>();
+  vector_size_t j = 0;
+  rows.apply([&](vector_size_t i) {
+    if (vec.isNullAt(i)) {
+      rawOffsets[j] = 0;
+      rawSizes[j] = 0;
+    } else {
+      rawOffsets[j] = vec.offsetAt(i);
+      rawSizes[j] = vec.sizeAt(i);
+    }
+    ++j;
+  });
+  VELOX_DCHECK_EQ(j, out.length);
+  holder.setBuffer(1, offsets);
+  holder.setBuffer(2, sizes);
+}
+
 void exportArrays(
     const ArrayVector& vec,
     const Selection& rows,
     ArrowArray& out,
     memory::MemoryPool* pool,
+    const ArrowOptions& options,
     VeloxToArrowBridgeHolder& holder) {
   Selection childRows(vec.elements()->size());
-  exportOffsets(vec, rows, out, pool, holder, childRows);
+  if (options.exportToListView) {
+    exportArrayViews(vec, rows, out, pool, holder);
+  } else {
+    exportOffsets(vec, rows, out, pool, holder, childRows);
+  }
   holder.resizeChildren(1);
   exportBase(
       *vec.elements()->loadedVector(),
       childRows,
       *holder.allocateChild(0),
-      pool);
+      pool,
+      options);
   out.n_children = 1;
   out.children = holder.getChildrenArrays();
 }
@@ -544,6 +710,7 @@ void exportMaps(
     const Selection& rows,
     ArrowArray& out,
     memory::MemoryPool* pool,
+    const ArrowOptions& options,
     VeloxToArrowBridgeHolder& holder) {
   RowVector child(
       pool,
@@ -554,7 +721,7 @@ void exportMaps(
   Selection childRows(child.size());
   exportOffsets(vec, rows, out, pool, holder, childRows);
   holder.resizeChildren(1);
-  exportBase(child, childRows, *holder.allocateChild(0), pool);
+  exportBase(child, childRows, *holder.allocateChild(0), pool, options);
   out.n_children = 1;
   out.children = holder.getChildrenArrays();
 }
@@ -564,6 +731,7 @@ void exportDictionary(
     const Selection& rows,
     ArrowArray& out,
     memory::MemoryPool* pool,
+    const ArrowOptions& options,
     VeloxToArrowBridgeHolder& holder) {
   out.n_buffers = 2;
   out.n_children = 0;
@@ -576,14 +744,83 @@ void exportDictionary(
   }
   auto& values = *vec.valueVector()->loadedVector();
   out.dictionary = holder.allocateDictionary();
-  exportBase(values, Selection(values.size()), *out.dictionary, pool);
+  exportBase(values, Selection(values.size()), *out.dictionary, pool, options);
+}
+
+// Exports a sequence vector as an Arrow run-end encoded array. The runs of
+// 'vec' that cover 'rows' become the values child and the run ends are the
+// positions in 'rows' where each run ends.
+void exportSequence(
+    const BaseVector& vec,
+    const Selection& rows,
+    ArrowArray& out,
+    memory::MemoryPool* pool,
+    const ArrowOptions& options,
+    VeloxToArrowBridgeHolder& holder) {
+  const auto* lengths = vec.wrapInfo()->as<vector_size_t>();
+  const auto& values = *vec.valueVector()->loadedVector();
+  auto runEnds = AlignedBuffer::allocate<int32_t>(out.length, pool);
+  auto* rawRunEnds = runEnds->asMutable<int32_t>();
+  vector_size_t numRuns = 0;
+  Selection valueRows(values.size());
+  valueRows.clearAll();
+  if (!rows.changed()) {
+    vector_size_t end = 0;
+    for (vector_size_t run = 0; end < out.length; ++run) {
+      if (lengths[run] == 0) {
+        continue;
+      }
+      end = std::min<vector_size_t>(out.length, end + lengths[run]);
+      rawRunEnds[numRuns++] = end;
+      valueRows.addRange(run, 1);
+    }
+  } else {
+    // Rows that map to the same run as the previous row extend its run.
+    std::vector<vector_size_t> runEndRows(values.size());
+    std::partial_sum(lengths, lengths + values.size(), runEndRows.begin());
+    vector_size_t lastRun = -1;
+    vector_size_t numRows = 0;
+    rows.apply([&](vector_size_t row) {
+      const vector_size_t run =
+          std::upper_bound(runEndRows.begin(), runEndRows.end(), row) -
+          runEndRows.begin();
+      ++numRows;
+      if (run == lastRun) {
+        rawRunEnds[numRuns - 1] = numRows;
+      } else {
+        rawRunEnds[numRuns++] = numRows;
+        valueRows.addRange(run, 1);
+        lastRun = run;
+      }
+    });
+  }
+
+  out.n_buffers = 0;
+  holder.resizeChildren(2);
+  out.n_children = 2;
+  out.children = holder.getChildrenArrays();
+  FlatVector<int32_t> runEndsVector(
+      pool, INTEGER(), nullptr, numRuns, runEnds, std::vector<BufferPtr>{});
+  exportBase(
+      runEndsVector,
+      Selection(numRuns),
+      *holder.allocateChild(0),
+      pool,
+      options);
+  try {
+    exportBase(values, valueRows, *holder.allocateChild(1), pool, options);
+  } catch (const VeloxException&) {
+    out.children[0]->release(out.children[0]);
+    throw;
+  }
 }
 
 void exportBase(
     const BaseVector& vec,
     const Selection& rows,
     ArrowArray& out,
-    memory::MemoryPool* pool) {
+    memory::MemoryPool* pool,
+    const ArrowOptions& options) {
   auto holder = std::make_unique<VeloxToArrowBridgeHolder>();
   out.buffers = holder->getArrowBuffers();
   out.length = rows.count();
@@ -592,19 +829,25 @@ void exportBase(
   exportNulls(vec, rows, out, pool, *holder);
   switch (vec.encoding()) {
     case VectorEncoding::Simple::FLAT:
-      exportFlat(vec, rows, out, pool, *holder);
+      exportFlat(vec, rows, out, pool, options, *holder);
       break;
     case VectorEncoding::Simple::ROW:
-      exportRows(*vec.asUnchecked<RowVector>(), rows, out, pool, *holder);
+      exportRows(
+          *vec.asUnchecked<RowVector>(), rows, out, pool, options, *holder);
       break;
     case VectorEncoding::Simple::ARRAY:
-      exportArrays(*vec.asUnchecked<ArrayVector>(), rows, out, pool, *holder);
+      exportArrays(
+          *vec.asUnchecked<ArrayVector>(), rows, out, pool, options, *holder);
       break;
     case VectorEncoding::Simple::MAP:
-      exportMaps(*vec.asUnchecked<MapVector>(), rows, out, pool, *holder);
+      exportMaps(
+          *vec.asUnchecked<MapVector>(), rows, out, pool, options, *holder);
       break;
     case VectorEncoding::Simple::DICTIONARY:
-      exportDictionary(vec, rows, out, pool, *holder);
+      exportDictionary(vec, rows, out, pool, options, *holder);
+      break;
+    case VectorEncoding::Simple::SEQUENCE:
+      exportSequence(vec, rows, out, pool, options, *holder);
       break;
     default:
       VELOX_NYI("{} cannot be exported to Arrow yet.", vec.encoding());
@@ -618,11 +861,15 @@ void exportBase(
 void exportToArrow(
     const VectorPtr& vector,
     ArrowArray& arrowArray,
-    memory::MemoryPool* pool) {
-  exportBase(*vector, Selection(vector->size()), arrowArray, pool);
+    memory::MemoryPool* pool,
+    const ArrowOptions& options) {
+  exportBase(*vector, Selection(vector->size()), arrowArray, pool, options);
 }
 
-void exportToArrow(const VectorPtr& vec, ArrowSchema& arrowSchema) {
+void exportToArrow(
+    const VectorPtr& vec,
+    ArrowSchema& arrowSchema,
+    const ArrowOptions& options) {
   auto& type = vec->type();
 
   arrowSchema.name = nullptr;
@@ -642,10 +889,42 @@ void exportToArrow(const VectorPtr& vec, ArrowSchema& arrowSchema) {
     arrowSchema.format = "i";
     bridgeHolder->dictionary = std::make_unique<ArrowSchema>();
     arrowSchema.dictionary = bridgeHolder->dictionary.get();
-    exportToArrow(vec->valueVector(), *arrowSchema.dictionary);
+    exportToArrow(vec->valueVector(), *arrowSchema.dictionary, options);
+
+  } else if (vec->encoding() == VectorEncoding::Simple::SEQUENCE) {
+    // Run-end encoded: int32 run ends and the values of the runs.
+    arrowSchema.format = "+r";
+    arrowSchema.dictionary = nullptr;
+    bridgeHolder->childrenOwned.resize(2);
+    bridgeHolder->childrenRaw.resize(2);
+    auto& runEnds = bridgeHolder->childrenOwned[0];
+    runEnds = std::make_unique<ArrowSchema>();
+    runEnds->format = "i";
+    runEnds->name = "run_ends";
+    runEnds->metadata = nullptr;
+    runEnds->flags = 0;
+    runEnds->n_children = 0;
+    runEnds->children = nullptr;
+    runEnds->dictionary = nullptr;
+    runEnds->private_data = new VeloxToArrowSchemaBridgeHolder();
+    runEnds->release = releaseArrowSchema;
+    auto& values = bridgeHolder->childrenOwned[1];
+    values = std::make_unique<ArrowSchema>();
+    try {
+      exportToArrow(vec->valueVector(), *values, options);
+    } catch (const VeloxException&) {
+      runEnds->release(runEnds.get());
+      throw;
+    }
+    values->name = "values";
+    bridgeHolder->childrenRaw[0] = runEnds.get();
+    bridgeHolder->childrenRaw[1] = values.get();
+    arrowSchema.children = bridgeHolder->childrenRaw.data();
+    arrowSchema.n_children = 2;
 
   } else {
-    arrowSchema.format = exportArrowFormatStr(type, bridgeHolder->formatBuffer);
+    arrowSchema.format =
+        exportArrowFormatStr(type, options, bridgeHolder->formatBuffer);
     arrowSchema.dictionary = nullptr;
 
     if (type->kind() == TypeKind::MAP) {
@@ -660,14 +939,14 @@ void exportToArrow(const VectorPtr& vec, ArrowSchema& arrowSchema) {
           0,
           std::vector<VectorPtr>{maps.mapKeys(), maps.mapValues()},
           maps.getNullCount());
-      exportToArrow(rows, *child);
+      exportToArrow(rows, *child, options);
       child->name = "entries";
       setUniqueChild(std::move(child), *bridgeHolder, arrowSchema);
 
     } else if (type->kind() == TypeKind::ARRAY) {
       auto child = std::make_unique<ArrowSchema>();
       auto& arrays = *vec->asUnchecked<ArrayVector>();
-      exportToArrow(arrays.elements(), *child);
+      exportToArrow(arrays.elements(), *child, options);
       // Name is required, and "item" is the default name used in arrow itself.
       child->name = "item";
       setUniqueChild(std::move(child), *bridgeHolder, arrowSchema);
@@ -700,7 +979,7 @@ void exportToArrow(const VectorPtr& vec, ArrowSchema& arrowSchema) {
         try {
           auto& currentSchema = bridgeHolder->childrenOwned[i];
           currentSchema = std::make_unique<ArrowSchema>();
-          exportToArrow(rows.childAt(i), *currentSchema);
+          exportToArrow(rows.childAt(i), *currentSchema, options);
           currentSchema->name = bridgeHolder->rowType->nameOf(i).data();
           arrowSchema.children[i] = currentSchema.get();
         } catch (const VeloxException& e) {
@@ -755,6 +1034,16 @@ TypePtr importFromArrow(const ArrowSchema& arrowSchema) {
     case 'Z':
       return VARBINARY();
 
+    // String and binary views.
+    case 'v':
+      if (format[1] == 'u') {
+        return VARCHAR();
+      }
+      if (format[1] == 'z') {
+        return VARBINARY();
+      }
+      break;
+
     case 't': // temporal types.
       // Mapping it to ttn for now.
       if (format[1] == 't' && format[2] == 'n') {
@@ -789,6 +1078,15 @@ TypePtr importFromArrow(const ArrowSchema& arrowSchema) {
           VELOX_CHECK_NOT_NULL(arrowSchema.children[0]);
           return ARRAY(importFromArrow(*arrowSchema.children[0]));
 
+        // Array/list view.
+        case 'v':
+          if (format[2] != 'l') {
+            break;
+          }
+          VELOX_CHECK_EQ(arrowSchema.n_children, 1);
+          VELOX_CHECK_NOT_NULL(arrowSchema.children[0]);
+          return ARRAY(importFromArrow(*arrowSchema.children[0]));
+
         // Map.
         case 'm': {
           VELOX_CHECK_EQ(arrowSchema.n_children, 1);
@@ -803,6 +1101,12 @@ TypePtr importFromArrow(const ArrowSchema& arrowSchema) {
               importFromArrow(*child.children[1]));
         }
 
+        // Run-end encoded. The type is the type of the values.
+        case 'r':
+          VELOX_CHECK_EQ(arrowSchema.n_children, 2);
+          VELOX_CHECK_NOT_NULL(arrowSchema.children[1]);
+          return importFromArrow(*arrowSchema.children[1]);
+
         // Struct/rows.
         case 's': {
           // Loop collecting the child types and names.
@@ -945,6 +1249,61 @@ VectorPtr createStringFlatVector(
       optionalNullCount(nullCount));
 }
 
+// Imports Arrow string views. Only the 16 byte views are rewritten to point
+// into the variadic buffers, which the result acquires without copying.
+VectorPtr createStringViewFlatVector(
+    memory::MemoryPool* pool,
+    const TypePtr& type,
+    BufferPtr nulls,
+    const ArrowArray& arrowArray,
+    WrapInBufferViewFunc wrapInBufferView) {
+  VELOX_USER_CHECK_GE(
+      arrowArray.n_buffers,
+      3,
+      "Expecting at least three buffers as input for string views.");
+  const auto length = arrowArray.length;
+  const auto numVariadic = arrowArray.n_buffers - 3;
+  const auto* variadicSizes =
+      static_cast<const int64_t*>(arrowArray.buffers[arrowArray.n_buffers - 1]);
+  std::vector<BufferPtr> stringViewBuffers;
+  stringViewBuffers.reserve(numVariadic);
+  for (auto i = 0; i < numVariadic; ++i) {
+    stringViewBuffers.push_back(
+        wrapInBufferView(arrowArray.buffers[2 + i], variadicSizes[i]));
+  }
+
+  BufferPtr stringViews = AlignedBuffer::allocate<StringView>(length, pool);
+  auto* rawStringViews = stringViews->asMutable<StringView>();
+  const auto* arrowViews =
+      static_cast<const ArrowStringView*>(arrowArray.buffers[1]);
+  const auto* rawNulls = nulls ? nulls->as<uint64_t>() : nullptr;
+  for (auto i = 0; i < length; ++i) {
+    const auto& view = arrowViews[i];
+    if (rawNulls && bits::isBitNull(rawNulls, i)) {
+      rawStringViews[i] = StringView();
+    } else if (StringView::isInline(view.size)) {
+      memcpy(&rawStringViews[i], &view, sizeof(StringView));
+    } else {
+      VELOX_USER_CHECK_LT(view.bufferIndex, numVariadic);
+      rawStringViews[i] = StringView(
+          static_cast<const char*>(arrowArray.buffers[2 + view.bufferIndex]) +
+              view.offset,
+          view.size);
+    }
+  }
+
+  return std::make_shared<FlatVector<StringView>>(
+      pool,
+      type,
+      nulls,
+      length,
+      stringViews,
+      std::move(stringViewBuffers),
+      SimpleVectorStats<StringView>{},
+      std::nullopt,
+      optionalNullCount(arrowArray.null_count));
+}
+
 VectorPtr importFromArrowImpl(
     ArrowSchema& arrowSchema,
     ArrowArray& arrowArray,
@@ -1018,6 +1377,35 @@ ArrayVectorPtr createArrayVector(
       optionalNullCount(arrowArray.null_count));
 }
 
+// Imports an Arrow ListView. Its offsets and sizes are used without copying.
+ArrayVectorPtr createArrayViewVector(
+    memory::MemoryPool* pool,
+    const TypePtr& type,
+    BufferPtr nulls,
+    const ArrowSchema& arrowSchema,
+    const ArrowArray& arrowArray,
+    bool isViewer,
+    WrapInBufferViewFunc wrapInBufferView) {
+  static_assert(sizeof(vector_size_t) == sizeof(int32_t));
+  VELOX_CHECK_EQ(arrowArray.n_buffers, 3);
+  VELOX_CHECK_EQ(arrowArray.n_children, 1);
+  auto offsets = wrapInBufferView(
+      arrowArray.buffers[1], arrowArray.length * sizeof(vector_size_t));
+  auto sizes = wrapInBufferView(
+      arrowArray.buffers[2], arrowArray.length * sizeof(vector_size_t));
+  auto elements = importFromArrowImpl(
+      *arrowSchema.children[0], *arrowArray.children[0], pool, isViewer);
+  return std::make_shared<ArrayVector>(
+      pool,
+      type,
+      std::move(nulls),
+      arrowArray.length,
+      std::move(offsets),
+      std::move(sizes),
+      std::move(elements),
+      optionalNullCount(arrowArray.null_count));
+}
+
 MapVectorPtr createMapVector(
     memory::MemoryPool* pool,
     const TypePtr& type,
@@ -1077,6 +1465,43 @@ VectorPtr createDictionaryVector(
       std::move(wrapped));
 }
 
+VectorPtr createSequenceVector(
+    memory::MemoryPool* pool,
+    const ArrowSchema& arrowSchema,
+    const ArrowArray& arrowArray,
+    bool isViewer) {
+  VELOX_USER_CHECK_EQ(arrowArray.n_children, 2);
+  VELOX_USER_CHECK_EQ(
+      arrowArray.null_count, 0, "Run-end encoded arrays have no nulls.");
+  VELOX_USER_CHECK_EQ(
+      strcmp(arrowSchema.children[0]->format, "i"),
+      0,
+      "Only int32 run ends are supported for arrow conversion");
+  const auto& runEnds = *arrowArray.children[0];
+  VELOX_USER_CHECK_EQ(
+      runEnds.offset,
+      0,
+      "Offsets are not supported during arrow conversion yet.");
+  auto values = importFromArrowImpl(
+      *arrowSchema.children[1], *arrowArray.children[1], pool, isViewer);
+  const auto numRuns = runEnds.length;
+  VELOX_USER_CHECK_EQ(numRuns, values->size());
+  if (numRuns == 0) {
+    return values;
+  }
+  const auto* rawRunEnds = static_cast<const int32_t*>(runEnds.buffers[1]);
+  auto lengths = AlignedBuffer::allocate<vector_size_t>(numRuns, pool);
+  auto* rawLengths = lengths->asMutable<vector_size_t>();
+  vector_size_t start = 0;
+  for (auto i = 0; i < numRuns; ++i) {
+    const auto end = std::min<int64_t>(rawRunEnds[i], arrowArray.length);
+    rawLengths[i] = std::max<int64_t>(end - start, 0);
+    start += rawLengths[i];
+  }
+  return BaseVector::wrapInSequence(
+      std::move(lengths), arrowArray.length, std::move(values));
+}
+
 VectorPtr importFromArrowImpl(
     ArrowSchema& arrowSchema,
     ArrowArray& arrowArray,
@@ -1095,6 +1520,10 @@ VectorPtr importFromArrowImpl(
   // First parse and generate a Velox type.
   auto type = importFromArrow(arrowSchema);
 
+  if (strcmp(arrowSchema.format, "+r") == 0) {
+    return createSequenceVector(pool, arrowSchema, arrowArray, isViewer);
+  }
+
   // Wrap the nulls buffer into a Velox BufferView (zero-copy). Null buffer size
   // needs to be at least one bit per element.
   BufferPtr nulls = nullptr;
@@ -1118,6 +1547,10 @@ VectorPtr importFromArrowImpl(
   }
 
   // String data types (VARCHAR and VARBINARY).
+  if (arrowSchema.format[0] == 'v') {
+    return createStringViewFlatVector(
+        pool, type, nulls, arrowArray, wrapInBufferView);
+  }
   if (type->isVarchar() || type->isVarbinary()) {
     VELOX_USER_CHECK_EQ(
         arrowArray.n_buffers,
@@ -1143,6 +1576,10 @@ VectorPtr importFromArrowImpl(
         arrowArray,
         isViewer);
   }
+  if (type->isArray() && strcmp(arrowSchema.format, "+vl") == 0) {
+    return createArrayViewVector(
+        pool, type, nulls, arrowSchema, arrowArray, isViewer, wrapInBufferView);
+  }
   if (type->isArray()) {
     return createArrayVector(
         pool, type, nulls, arrowSchema, arrowArray, isViewer, wrapInBufferView);
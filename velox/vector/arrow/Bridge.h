@@ -27,6 +27,19 @@ struct ArrowSchema;
 
 namespace facebook::velox {
 
+/// Layout choices for exporting Velox vectors to Arrow. The same options must
+/// be used to export the ArrowArray and the ArrowSchema of a vector.
+struct ArrowOptions {
+  /// Export VARCHAR and VARBINARY as Arrow Utf8View/BinaryView ("vu"/"vz")
+  /// instead of Utf8/Binary. The string buffers of the vector are shared as
+  /// variadic buffers, so the string bytes are not copied.
+  bool exportToStringView{false};
+
+  /// Export ARRAY as Arrow ListView ("+vl") instead of List. The offsets and
+  /// sizes of the vector are shared and the elements are exported as is.
+  bool exportToListView{false};
+};
+
 /// Export a generic Velox Vector to an ArrowArray, as defined by Arrow's C data
 /// interface:
 ///
@@ -57,7 +70,8 @@ namespace facebook::velox {
 void exportToArrow(
     const VectorPtr& vector,
     ArrowArray& arrowArray,
-    memory::MemoryPool* pool);
+    memory::MemoryPool* pool,
+    const ArrowOptions& options = {});
 
 /// Export the type of a Velox vector to an ArrowSchema.
 ///
@@ -78,7 +92,10 @@ void exportToArrow(
 ///
 /// NOTE: Since Arrow couples type and encoding, we need both Velox type and
 /// actual data (containing encoding) to create an ArrowSchema.
-void exportToArrow(const VectorPtr&, ArrowSchema&);
+void exportToArrow(
+    const VectorPtr&,
+    ArrowSchema&,
+    const ArrowOptions& options = {});
 
 /// Import an ArrowSchema into a Velox Type object.
 ///
@@ -655,6 +655,103 @@ TEST_F(ArrowBridgeArrayExportTest, dictionaryNested) {
   EXPECT_EQ(values.Value(2), 3);
 }
 
+TEST_F(ArrowBridgeArrayExportTest, sequence) {
+  auto values = vectorMaker_.flatVector<int64_t>({1, 2, 3});
+  auto vec = BaseVector::wrapInSequence(
+      makeBuffer<vector_size_t>({3, 1, 2}), 6, values);
+  ArrowSchema arrowSchema;
+  ArrowArray arrowArray;
+  exportToArrow(vec, arrowSchema);
+  exportToArrow(vec, arrowArray, pool_.get());
+  EXPECT_STREQ(arrowSchema.format, "+r");
+  ASSERT_EQ(arrowSchema.n_children, 2);
+  EXPECT_STREQ(arrowSchema.children[0]->format, "i");
+  EXPECT_STREQ(arrowSchema.children[1]->format, "l");
+  ASSERT_EQ(arrowArray.length, 6);
+  ASSERT_EQ(arrowArray.n_children, 2);
+  const auto& runEnds = *arrowArray.children[0];
+  ASSERT_EQ(runEnds.length, 3);
+  const auto* rawRunEnds = static_cast<const int32_t*>(runEnds.buffers[1]);
+  EXPECT_EQ(rawRunEnds[0], 3);
+  EXPECT_EQ(rawRunEnds[1], 4);
+  EXPECT_EQ(rawRunEnds[2], 6);
+
+  auto imported =
+      importFromArrowAsOwner(arrowSchema, arrowArray, pool_.get());
+  ASSERT_EQ(imported->encoding(), VectorEncoding::Simple::SEQUENCE);
+  ASSERT_EQ(imported->size(), 6);
+  for (auto i = 0; i < vec->size(); ++i) {
+    EXPECT_TRUE(vec->equalValueAt(imported.get(), i, i)) << "at " << i;
+  }
+}
+
+TEST_F(ArrowBridgeArrayExportTest, stringView) {
+  auto vec = vectorMaker_.flatVectorNullable<std::string>({
+      "short",
+      std::nullopt,
+      "a string that is too long to be inlined",
+      "",
+      "another string that is too long to be inlined",
+  });
+  ArrowOptions options;
+  options.exportToStringView = true;
+  ArrowSchema arrowSchema;
+  ArrowArray arrowArray;
+  exportToArrow(vec, arrowSchema, options);
+  exportToArrow(vec, arrowArray, pool_.get(), options);
+  EXPECT_STREQ(arrowSchema.format, "vu");
+  ASSERT_EQ(arrowArray.length, 5);
+  EXPECT_EQ(arrowArray.null_count, 1);
+
+  // Nulls, views, one variadic buffer per string buffer and their sizes.
+  const auto& stringBuffers = vec->stringBuffers();
+  ASSERT_EQ(arrowArray.n_buffers, 3 + static_cast<int64_t>(stringBuffers.size()));
+  for (size_t i = 0; i < stringBuffers.size(); ++i) {
+    // String bytes are shared, not copied.
+    EXPECT_EQ(arrowArray.buffers[2 + i], stringBuffers[i]->as<void>());
+  }
+
+  auto imported = importFromArrowAsOwner(arrowSchema, arrowArray, pool_.get());
+  ASSERT_EQ(imported->size(), vec->size());
+  for (auto i = 0; i < vec->size(); ++i) {
+    EXPECT_TRUE(vec->equalValueAt(imported.get(), i, i)) << "at " << i;
+  }
+  const auto expected = vec->valueAt(2);
+  const auto actual = imported->asFlatVector<StringView>()->valueAt(2);
+  EXPECT_EQ(actual.data(), expected.data());
+}
+
+TEST_F(ArrowBridgeArrayExportTest, arrayView) {
+  auto vec = vectorMaker_.arrayVectorNullable<int64_t>({
+      {{1, 2, 3}},
+      std::nullopt,
+      std::vector<std::optional<int64_t>>{},
+      {{4, std::nullopt}},
+  });
+  ArrowOptions options;
+  options.exportToListView = true;
+  ArrowSchema arrowSchema;
+  ArrowArray arrowArray;
+  exportToArrow(vec, arrowSchema, options);
+  exportToArrow(vec, arrowArray, pool_.get(), options);
+  EXPECT_STREQ(arrowSchema.format, "+vl");
+  ASSERT_EQ(arrowArray.n_buffers, 3);
+  ASSERT_EQ(arrowArray.n_children, 1);
+  const auto* offsets = static_cast<const int32_t*>(arrowArray.buffers[1]);
+  const auto* sizes = static_cast<const int32_t*>(arrowArray.buffers[2]);
+  for (auto i : {0, 2, 3}) {
+    EXPECT_EQ(offsets[i], vec->offsetAt(i));
+    EXPECT_EQ(sizes[i], vec->sizeAt(i));
+  }
+  EXPECT_EQ(sizes[1], 0);
+
+  auto imported = importFromArrowAsOwner(arrowSchema, arrowArray, pool_.get());
+  ASSERT_EQ(imported->size(), vec->size());
+  for (auto i = 0; i < vec->size(); ++i) {
+    EXPECT_TRUE(vec->equalValueAt(imported.get(), i, i)) << "at " << i;
+  }
+}
+
 TEST_F(ArrowBridgeArrayExportTest, unsupported) {
   ArrowArray arrowArray;
   VectorPtr vector;
@@ -662,6 +662,40 @@ TEST_F(DecodedVectorTest, dictionaryOverConstant) {
   testDictionaryOverConstant(arrayVector, 5); // null
 }
 
+TEST_F(DecodedVectorTest, sequence) {
+  // Runs of 3, 0, 2 and 5 rows.
+  auto lengths = AlignedBuffer::allocate<vector_size_t>(4, pool_.get());
+  auto* rawLengths = lengths->asMutable<vector_size_t>();
+  rawLengths[0] = 3;
+  rawLengths[1] = 0;
+  rawLengths[2] = 2;
+  rawLengths[3] = 5;
+  auto values = vectorMaker_.flatVectorNullable<int64_t>(
+      {10, 20, std::nullopt, 40});
+  auto sequence = BaseVector::wrapInSequence(lengths, 10, values);
+  std::vector<vector_size_t> expectedIndices = {0, 0, 0, 2, 2, 3, 3, 3, 3, 3};
+
+  SelectivityVector rows(10);
+  DecodedVector decoded(*sequence, rows);
+  ASSERT_FALSE(decoded.isIdentityMapping());
+  ASSERT_FALSE(decoded.isConstantMapping());
+  ASSERT_EQ(decoded.base(), values.get());
+  for (auto i = 0; i < rows.size(); ++i) {
+    EXPECT_EQ(decoded.index(i), expectedIndices[i]) << "at " << i;
+    EXPECT_EQ(decoded.isNullAt(i), i == 3 || i == 4) << "at " << i;
+  }
+
+  // Dictionary over sequence.
+  auto indices = makeIndicesInReverse(10, pool_.get());
+  auto dictionary =
+      BaseVector::wrapInDictionary(nullptr, indices, 10, sequence);
+  decoded.decode(*dictionary, rows);
+  ASSERT_EQ(decoded.base(), values.get());
+  for (auto i = 0; i < rows.size(); ++i) {
+    EXPECT_EQ(decoded.index(i), expectedIndices[9 - i]) << "at " << i;
+  }
+}
+
 TEST_F(DecodedVectorTest, wrapOnDictionaryEncoding) {
   // This test exercises the use-case of unnesting the children of a rowVector
   // and making sure the wrap over the row vector is correctly applied on its
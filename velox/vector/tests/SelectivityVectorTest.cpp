@@ -477,6 +477,49 @@ TEST(SelectivityVectorTest, selectAndGrow) {
 
 // Sanity check for toString() method. Primarily to ensure the method doesn't
 // fail or crash.
+TEST(SelectivityVectorTest, applyToSelectedNoThrow) {
+  auto test = [](const SelectivityVector& rows) {
+    std::vector<vector_size_t> visited;
+    std::vector<vector_size_t> failed;
+    rows.applyToSelectedNoThrow(
+        [&](auto row) {
+          if (row % 10 == 3) {
+            VELOX_USER_FAIL("Row {}", row);
+          }
+          visited.push_back(row);
+        },
+        [&](auto row) {
+          try {
+            std::rethrow_exception(std::current_exception());
+          } catch (const VeloxUserError& e) {
+            ASSERT_EQ(e.message(), fmt::format("Row {}", row));
+          }
+          failed.push_back(row);
+        });
+    std::vector<vector_size_t> expectedVisited;
+    std::vector<vector_size_t> expectedFailed;
+    rows.applyToSelected([&](auto row) {
+      (row % 10 == 3 ? expectedFailed : expectedVisited).push_back(row);
+    });
+    ASSERT_EQ(visited, expectedVisited);
+    ASSERT_EQ(failed, expectedFailed);
+  };
+
+  // All selected, including a failure on the last row.
+  SelectivityVector rows(104);
+  test(rows);
+
+  rows.setValidRange(0, 50, false);
+  rows.updateBounds();
+  test(rows);
+
+  for (auto i = 50; i < rows.size(); i += 3) {
+    rows.setValid(i, false);
+  }
+  rows.updateBounds();
+  test(rows);
+}
+
 TEST(SelectivityVectorTest, toString) {
   SelectivityVector rows(1024);
 
@@ -0,0 +1,122 @@
+/*
+ * Copyright (c) Facebook, Inc. and its affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "velox/vector/VectorCompression.h"
+
+#include <gtest/gtest.h>
+
+#include "velox/vector/BiasVector.h"
+#include "velox/vector/DecodedVector.h"
+#include "velox/vector/tests/utils/VectorTestBase.h"
+
+namespace facebook::velox {
+namespace {
+
+class VectorCompressionTest : public testing::Test,
+                              public test::VectorTestBase {
+ protected:
+  // Checks that 'compressed' has the values of 'expected' both through the
+  // vector and through a DecodedVector.
+  template <typename T>
+  void assertDecoded(const VectorPtr& expected, const VectorPtr& compressed) {
+    test::assertEqualVectors(expected, compressed);
+    SelectivityVector rows(expected->size());
+    DecodedVector decoded(*compressed, rows);
+    auto* flat = expected->as<SimpleVector<T>>();
+    for (auto i = 0; i < expected->size(); ++i) {
+      ASSERT_EQ(flat->isNullAt(i), decoded.isNullAt(i)) << i;
+      if (!flat->isNullAt(i)) {
+        ASSERT_EQ(flat->valueAt(i), decoded.valueAt<T>(i)) << i;
+      }
+    }
+  }
+};
+
+TEST_F(VectorCompressionTest, bias) {
+  auto small = makeFlatVector<int64_t>(
+      1'000, [](auto row) { return 1'000'000'000'000 + row % 200; });
+  auto compressed = compressVector(small, pool());
+  ASSERT_EQ(compressed->encoding(), VectorEncoding::Simple::BIASED);
+  ASSERT_EQ(
+      compressed->as<BiasVector<int64_t>>()->valueType(), TypeKind::TINYINT);
+  ASSERT_LT(compressed->retainedSize(), small->retainedSize());
+  assertDecoded<int64_t>(small, compressed);
+
+  auto medium = makeFlatVector<int32_t>(
+      1'000, [](auto row) { return -100 + row * 50; }, nullEvery(7));
+  compressed = compressVector(medium, pool());
+  ASSERT_EQ(compressed->encoding(), VectorEncoding::Simple::BIASED);
+  ASSERT_EQ(
+      compressed->as<BiasVector<int32_t>>()->valueType(), TypeKind::SMALLINT);
+  assertDecoded<int32_t>(medium, compressed);
+
+  // The full range does not fit in a narrower type.
+  auto wide = makeFlatVector<int16_t>({
+      std::numeric_limits<int16_t>::min(),
+      std::numeric_limits<int16_t>::max(),
+  });
+  ASSERT_EQ(compressVector(wide, pool()), wide);
+
+  // Logical types are not biased.
+  auto dates = makeFlatVector<int32_t>({1, 2, 3}, DATE());
+  ASSERT_EQ(compressVector(dates, pool()), dates);
+}
+
+TEST_F(VectorCompressionTest, biasUnderDictionary) {
+  auto base = makeFlatVector<int64_t>(
+      100, [](auto row) { return 5'000 + row; }, nullEvery(11));
+  auto compressed = compressVector(base, pool());
+  ASSERT_EQ(compressed->encoding(), VectorEncoding::Simple::BIASED);
+  auto indices = makeIndicesInReverse(100);
+  assertDecoded<int64_t>(
+      wrapInDictionary(indices, base), wrapInDictionary(indices, compressed));
+}
+
+TEST_F(VectorCompressionTest, stringDictionary) {
+  auto strings = makeFlatVector<std::string>(
+      1'000,
+      [](auto row) {
+        return fmt::format("a string that is not inlined {}", row % 10);
+      },
+      nullEvery(13));
+  auto compressed = compressVector(strings, pool());
+  ASSERT_EQ(compressed->encoding(), VectorEncoding::Simple::DICTIONARY);
+  ASSERT_EQ(compressed->valueVector()->size(), 10);
+  ASSERT_LT(compressed->retainedSize(), strings->retainedSize());
+  assertDecoded<StringView>(strings, compressed);
+
+  // Mostly distinct strings are kept as is.
+  auto distinct = makeFlatVector<std::string>(
+      100, [](auto row) { return fmt::format("distinct string {}", row); });
+  ASSERT_EQ(compressVector(distinct, pool()), distinct);
+}
+
+TEST_F(VectorCompressionTest, row) {
+  auto data = makeRowVector({
+      makeFlatVector<int64_t>(100, [](auto row) { return row; }),
+      makeFlatVector<std::string>(
+          100, [](auto row) { return fmt::format("value {}", row % 3); }),
+      makeFlatVector<double>(100, [](auto row) { return row * 0.1; }),
+  });
+  auto compressed = compressVector(data, pool());
+  auto* row = compressed->as<RowVector>();
+  ASSERT_EQ(row->childAt(0)->encoding(), VectorEncoding::Simple::BIASED);
+  ASSERT_EQ(row->childAt(1)->encoding(), VectorEncoding::Simple::DICTIONARY);
+  ASSERT_EQ(row->childAt(2), data->childAt(2));
+  test::assertEqualVectors(data, compressed);
+}
+
+} // namespace
+} // namespace facebook::velox
@@ -99,6 +99,36 @@ TEST_F(VectorPoolTest, limit) {
   ASSERT_EQ(vectorPool.release(vectors), 10);
 }
 
+TEST_F(VectorPoolTest, bytesLimitAndStats) {
+  const auto vectorBytes =
+      BaseVector::create(BIGINT(), 1'000, pool())->retainedSize();
+  VectorPool vectorPool(pool(), 3 * vectorBytes);
+
+  std::vector<VectorPtr> vectors(5);
+  for (auto& vector : vectors) {
+    vector = vectorPool.get(BIGINT(), 1'000);
+  }
+  ASSERT_EQ(vectorPool.stats().numHits, 0);
+  ASSERT_EQ(vectorPool.stats().numMisses, 5);
+
+  // Only vectors within the byte budget are cached.
+  ASSERT_EQ(vectorPool.release(vectors), 3);
+  ASSERT_EQ(vectorPool.retainedBytes(), 3 * vectorBytes);
+  ASSERT_NE(vectors[3], nullptr);
+  ASSERT_NE(vectors[4], nullptr);
+
+  for (auto i = 0; i < 3; ++i) {
+    vectors[i] = vectorPool.get(BIGINT(), 1'000);
+  }
+  ASSERT_EQ(vectorPool.stats().numHits, 3);
+  ASSERT_EQ(vectorPool.stats().numMisses, 5);
+  ASSERT_EQ(vectorPool.retainedBytes(), 0);
+
+  // Unsupported types are not counted.
+  vectorPool.get(ARRAY(BIGINT()), 10);
+  ASSERT_EQ(vectorPool.stats().numMisses, 5);
+}
+
 TEST_F(VectorPoolTest, vectorRecycler) {
   VectorPool vectorPool(pool());
 
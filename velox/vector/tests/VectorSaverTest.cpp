@@ -612,6 +612,57 @@ TEST_F(VectorSaverTest, LazyVector) {
       fuzzer);
 }
 
+TEST_F(VectorSaverTest, mappedFile) {
+  VectorFuzzer fuzzer(fuzzerOptions(), pool(), seed_);
+  auto type = ROW({
+      BIGINT(),
+      VARCHAR(),
+      ARRAY(INTEGER()),
+      MAP(VARCHAR(), DOUBLE()),
+      ROW({BOOLEAN(), TIMESTAMP()}),
+  });
+  auto data = fuzzer.fuzzInputFlatRow(type);
+  data->childAt(0) = fuzzer.fuzzDictionary(data->childAt(0));
+
+  auto path = exec::test::TempFilePath::create();
+  saveVectorToMappableFile(data.get(), path->path.c_str());
+
+  const auto usedBytes = pool()->currentBytes();
+  auto copy = restoreVectorFromMappedFile(path->path.c_str(), pool());
+  assertEqualEncodings(data, copy);
+
+  // The buffers are views over the mapped file.
+  auto* row = copy->as<RowVector>();
+  ASSERT_TRUE(row->childAt(0)->wrapInfo()->isView());
+  ASSERT_TRUE(row->childAt(1)->values()->isView());
+  ASSERT_TRUE(row->childAt(1)
+                  ->asFlatVector<StringView>()
+                  ->stringBuffers()
+                  .front()
+                  ->isView());
+  ASSERT_TRUE(row->childAt(2)->as<ArrayVector>()->offsets()->isView());
+  ASSERT_LT(pool()->currentBytes() - usedBytes, 1 << 20);
+
+  // restoreVectorFromFile() detects mappable files.
+  assertEqualEncodings(
+      data, restoreVectorFromFile(path->path.c_str(), pool()));
+
+  // The mapping outlives the file and the returned vector's buffers keep it.
+  auto values = row->childAt(1);
+  copy.reset();
+  fs::remove(path->path);
+  assertEqualVectors(data->childAt(1), values);
+
+  // A file in the plain format is not mappable.
+  auto plainPath = exec::test::TempFilePath::create();
+  saveVectorToFile(data.get(), plainPath->path.c_str());
+  VELOX_ASSERT_THROW(
+      restoreVectorFromMappedFile(plainPath->path.c_str(), pool()),
+      "Not a mappable vector file");
+  assertEqualEncodings(
+      data, restoreVectorFromFile(plainPath->path.c_str(), pool()));
+}
+
 TEST_F(VectorSaverTest, stdVector) {
   std::vector<column_index_t> intVector = {1, 2, 3, 4, 5};
   auto path = exec::test::TempFilePath::create();